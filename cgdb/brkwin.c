@@ -0,0 +1,388 @@
+/* brkwin.c:
+ * ---------
+ *
+ * The breakpoints are kept in order of their numbers, which is the order
+ * gdb made them in, so a change finds its breakpoint with a binary search
+ * and a new one mostly goes at the end. The window lists them in that
+ * order, under a line naming the columns.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_CURSES_H
+#include <curses.h>
+#elif HAVE_NCURSES_CURSES_H
+#include <ncurses/curses.h>
+#endif /* HAVE_CURSES_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+/* Local Includes */
+#include "brkwin.h"
+#include "cgdb.h"
+#include "tgdb_types.h"
+#include "tgdb_list.h"
+#include "sys_util.h"
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+/* The breakpoints, the strings are copies */
+static struct tgdb_breakpoint *brkwin_breaks;
+static int brkwin_count, brkwin_size;
+
+/* The first breakpoint shown */
+static int brkwin_top;
+
+/* The breakpoints of a gdb whose tab isn't shown */
+struct brkwin_breaks {
+    struct tgdb_breakpoint *breaks;
+    int count, size, top;
+};
+
+static WINDOW *brkwin_win;
+static char **brkwin_drawn;     /* The text on each line of brkwin_win */
+static int brkwin_height, brkwin_width;
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* brkwin_search: Finds where a breakpoint is, or would go.
+ * --------------
+ *
+ *   number:  The number of the breakpoint
+ *
+ * Return Value: The index of the first breakpoint whose number isn't less
+ *               than number, brkwin_count if there's none.
+ */
+static int brkwin_search(int number)
+{
+    int low = 0, high = brkwin_count, middle;
+
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (brkwin_breaks[middle].number < number)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+/* brkwin_copy: Copies a breakpoint into the one at an index.
+ * ------------
+ *
+ * The file is interned, it's kept as it is.
+ */
+static void brkwin_copy(int i, const struct tgdb_breakpoint *tb)
+{
+    brkwin_breaks[i] = *tb;
+    brkwin_breaks[i].funcname =
+            tb->funcname ? cgdb_strdup(tb->funcname) : NULL;
+}
+
+/* brkwin_free: Frees the strings of the breakpoint at an index.
+ * ------------
+ */
+static void brkwin_free(int i)
+{
+    free(brkwin_breaks[i].funcname);
+}
+
+/* brkwin_grow: Makes room for another breakpoint.
+ * ------------
+ */
+static void brkwin_grow(void)
+{
+    if (brkwin_count < brkwin_size)
+        return;
+
+    brkwin_size = brkwin_size ? brkwin_size * 2 : 16;
+    brkwin_breaks = cgdb_realloc(brkwin_breaks,
+            sizeof (struct tgdb_breakpoint) * brkwin_size);
+}
+
+/* brkwin_compare: Orders breakpoints by number, for qsort.
+ * ---------------
+ */
+static int brkwin_compare(const void *a, const void *b)
+{
+    const struct tgdb_breakpoint *left = (const struct tgdb_breakpoint *) a;
+    const struct tgdb_breakpoint *right = (const struct tgdb_breakpoint *) b;
+
+    return left->number < right->number ? -1 : left->number > right->number;
+}
+
+/* brkwin_shown: Determines if a breakpoint is on the window, or one after
+ * -------------  it would be, if it was added or deleted.
+ *
+ *   i:  The index of the breakpoint
+ */
+static int brkwin_shown(int i)
+{
+    return brkwin_win != NULL && i < brkwin_top + brkwin_height - 1;
+}
+
+/* brkwin_line: Gets the text of a line of the window.
+ * ------------
+ *
+ * The first line names the columns, each line after it is a breakpoint.
+ *
+ *   line:  The line, 0 is the first one
+ *   text:  Set to the text, it's cut to the width of the window
+ */
+static void brkwin_line(int line, char *text, size_t size)
+{
+    int i = brkwin_top + line - 1;
+    const struct tgdb_breakpoint *tb;
+    int length;
+
+    if (size > (size_t) brkwin_width + 1)
+        size = brkwin_width + 1;
+    text[0] = '\0';
+
+    if (line == 0) {
+        snprintf(text, size, "Num  Enb Hits Where");
+        return;
+    }
+
+    if (brkwin_count == 0) {
+        if (line == 1)
+            snprintf(text, size, "No breakpoints");
+        return;
+    }
+
+    if (i >= brkwin_count)
+        return;
+
+    tb = &brkwin_breaks[i];
+    length = snprintf(text, size, "%-4d %-3s %-4d %s:%d", tb->number,
+            tb->enabled ? "y" : "n", tb->hits, tb->file ? tb->file : "??",
+            tb->line);
+
+    if (tb->funcname && length >= 0 && (size_t) length < size)
+        snprintf(text + length, size - length, " in %s", tb->funcname);
+}
+
+/* brkwin_forget_drawn: Forgets what's on the lines of the window.
+ * --------------------
+ */
+static void brkwin_forget_drawn(void)
+{
+    int i;
+
+    for (i = 0; brkwin_drawn && i < brkwin_height; i++)
+        free(brkwin_drawn[i]);
+    free(brkwin_drawn);
+    brkwin_drawn = NULL;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in brkwin.h for function descriptions. */
+
+void brkwin_move(int top, int left, int height, int width)
+{
+    brkwin_close();
+
+    if ((brkwin_win = newwin(height, width, top, left)) == NULL)
+        return;
+
+    brkwin_height = height;
+    brkwin_width = width;
+    brkwin_drawn = cgdb_calloc(height, sizeof (char *));
+}
+
+void brkwin_display(void)
+{
+    char text[MAXLINE];
+    int line;
+
+    if (!brkwin_win)
+        return;
+
+    /* Only the lines that changed are drawn */
+    for (line = 0; line < brkwin_height; line++) {
+        brkwin_line(line, text, sizeof (text));
+
+        if (brkwin_drawn[line] && strcmp(brkwin_drawn[line], text) == 0)
+            continue;
+
+        wmove(brkwin_win, line, 0);
+        waddstr(brkwin_win, text);
+        wclrtoeol(brkwin_win);
+
+        free(brkwin_drawn[line]);
+        brkwin_drawn[line] = cgdb_strdup(text);
+    }
+
+    wnoutrefresh(brkwin_win);
+}
+
+void brkwin_close(void)
+{
+    brkwin_forget_drawn();
+
+    if (brkwin_win)
+        delwin(brkwin_win);
+    brkwin_win = NULL;
+    brkwin_height = brkwin_width = 0;
+}
+
+int brkwin_scroll(int pages)
+{
+    int rows = brkwin_height > 2 ? brkwin_height - 2 : 1;
+    int distance = (pages < 0 ? -pages : pages) * rows;
+
+    if (pages < 0) {
+        if (brkwin_top == 0)
+            return -1;
+        brkwin_top = brkwin_top > distance ? brkwin_top - distance : 0;
+    } else {
+        if (brkwin_top + distance >= brkwin_count)
+            return -1;
+        brkwin_top += distance;
+    }
+
+    return 0;
+}
+
+int brkwin_set(struct tgdb_list *list)
+{
+    tgdb_list_iterator *iterator;
+    int i;
+
+    for (i = 0; i < brkwin_count; i++)
+        brkwin_free(i);
+    brkwin_count = 0;
+
+    for (iterator = tgdb_list_get_first(list); iterator;
+            iterator = tgdb_list_next(iterator)) {
+        brkwin_grow();
+        brkwin_copy(brkwin_count++,
+                (struct tgdb_breakpoint *) tgdb_list_get_item(iterator));
+    }
+
+    /* gdb lists them in order, this makes sure */
+    qsort(brkwin_breaks, brkwin_count, sizeof (struct tgdb_breakpoint),
+            brkwin_compare);
+
+    if (brkwin_top >= brkwin_count)
+        brkwin_top = 0;
+
+    return brkwin_win != NULL;
+}
+
+const struct tgdb_breakpoint *brkwin_find(int number)
+{
+    int i = brkwin_search(number);
+
+    if (i == brkwin_count || brkwin_breaks[i].number != number)
+        return NULL;
+
+    return &brkwin_breaks[i];
+}
+
+int brkwin_change(const struct tgdb_breakpoint_change *change)
+{
+    const struct tgdb_breakpoint *tb = &change->breakpoint;
+    int i = brkwin_search(tb->number);
+    int found = i < brkwin_count && brkwin_breaks[i].number == tb->number;
+
+    if (change->deleted) {
+        if (!found)
+            return 0;
+
+        brkwin_free(i);
+        memmove(brkwin_breaks + i, brkwin_breaks + i + 1,
+                sizeof (struct tgdb_breakpoint) * (brkwin_count - i - 1));
+        brkwin_count--;
+
+        if (brkwin_top > 0 && brkwin_top >= brkwin_count)
+            brkwin_top--;
+    } else if (found) {
+        brkwin_free(i);
+        brkwin_copy(i, tb);
+    } else {
+        brkwin_grow();
+        memmove(brkwin_breaks + i + 1, brkwin_breaks + i,
+                sizeof (struct tgdb_breakpoint) * (brkwin_count - i));
+        brkwin_count++;
+        brkwin_copy(i, tb);
+    }
+
+    return brkwin_shown(i);
+}
+
+void brkwin_clear(void)
+{
+    int i;
+
+    for (i = 0; i < brkwin_count; i++)
+        brkwin_free(i);
+    free(brkwin_breaks);
+    brkwin_breaks = NULL;
+    brkwin_count = brkwin_size = 0;
+    brkwin_top = 0;
+}
+
+struct brkwin_breaks *brkwin_swap(struct brkwin_breaks *breaks)
+{
+    struct brkwin_breaks *shown = cgdb_malloc(sizeof (struct brkwin_breaks));
+
+    shown->breaks = brkwin_breaks;
+    shown->count = brkwin_count;
+    shown->size = brkwin_size;
+    shown->top = brkwin_top;
+
+    if (breaks) {
+        brkwin_breaks = breaks->breaks;
+        brkwin_count = breaks->count;
+        brkwin_size = breaks->size;
+        brkwin_top = breaks->top;
+        free(breaks);
+    } else {
+        brkwin_breaks = NULL;
+        brkwin_count = brkwin_size = brkwin_top = 0;
+    }
+
+    return shown;
+}
+
+void brkwin_swap_free(struct brkwin_breaks *breaks)
+{
+    struct brkwin_breaks *shown;
+
+    if (!breaks)
+        return;
+
+    shown = brkwin_swap(breaks);
+    brkwin_clear();
+    free(brkwin_swap(shown));
+}
+
+const struct tgdb_breakpoint *brkwin_get(int *count)
+{
+    *count = brkwin_count;
+
+    return brkwin_breaks;
+}
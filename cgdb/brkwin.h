@@ -0,0 +1,111 @@
+#ifndef _BRKWIN_H_
+#define _BRKWIN_H_
+
+/* brkwin.h:
+ * ---------
+ *
+ * The breakpoint window. It lists the breakpoints, by number, with whether
+ * they're enabled, how many times the program stopped at them, and where
+ * they are. It keeps the breakpoints tgdb told about, and applies the ones
+ * that changed to them, so a stop at one of many breakpoints only touches
+ * that one.
+ *
+ */
+
+struct tgdb_list;
+struct tgdb_breakpoint;
+struct tgdb_breakpoint_change;
+struct brkwin_breaks;
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* brkwin_move: Puts the breakpoint window somewhere else on the screen.
+ * ------------
+ *
+ *   top, left:      The position of its upper left corner
+ *   height, width:  Its size
+ */
+void brkwin_move(int top, int left, int height, int width);
+
+/* brkwin_display: Draws the lines that changed since the last time.
+ * ---------------
+ *
+ * The terminal isn't refreshed, only the curses virtual screen.
+ */
+void brkwin_display(void);
+
+/* brkwin_close: Takes the breakpoint window off the screen.
+ * -------------
+ *
+ * The breakpoints are kept, they're shown again by brkwin_move.
+ */
+void brkwin_close(void);
+
+/* brkwin_scroll: Shows the breakpoints a window further down or up.
+ * --------------
+ *
+ *   pages:  How many windows full, negative to go up
+ *
+ * Return Value: 0 on success, -1 if there's no breakpoint that way.
+ */
+int brkwin_scroll(int pages);
+
+/* brkwin_set: Replaces the breakpoints with all of them.
+ * -----------
+ *
+ *   list:  The struct tgdb_breakpoint's, they are copied
+ *
+ * Return Value: 1 if what's shown changed, 0 otherwise.
+ */
+int brkwin_set(struct tgdb_list *list);
+
+/* brkwin_find: Gets a breakpoint by its number.
+ * ------------
+ *
+ *   number:  The number gdb gave it
+ *
+ * Return Value: The breakpoint, good until the breakpoints change, or NULL
+ *               if there's none.
+ */
+const struct tgdb_breakpoint *brkwin_find(int number);
+
+/* brkwin_change: Adds, changes or deletes a breakpoint.
+ * --------------
+ *
+ *   change:  What changed, it's copied
+ *
+ * Return Value: 1 if what's shown changed, 0 otherwise.
+ */
+int brkwin_change(const struct tgdb_breakpoint_change *change);
+
+/* brkwin_clear: Forgets the breakpoints, when cgdb shuts down.
+ * -------------
+ */
+void brkwin_clear(void);
+
+/* brkwin_swap: Trades the breakpoints for another gdb's, when the tab
+ * ------------ shown changes.
+ *
+ *   breaks:  The breakpoints to show, from brkwin_swap, NULL for none
+ *
+ * Return Value: The breakpoints that were shown, brkwin_swap_free frees them.
+ */
+struct brkwin_breaks *brkwin_swap(struct brkwin_breaks *breaks);
+
+/* brkwin_swap_free: Frees the breakpoints brkwin_swap gave.
+ * -----------------
+ */
+void brkwin_swap_free(struct brkwin_breaks *breaks);
+
+/* brkwin_get: Gets the breakpoints, in order of their numbers.
+ * -----------
+ *
+ *   count:  Set to the number of breakpoints
+ *
+ * Return Value: The breakpoints, good until they change.
+ */
+const struct tgdb_breakpoint *brkwin_get(int *count);
+
+#endif /* _BRKWIN_H_ */
@@ -0,0 +1,588 @@
+/* btwin.c:
+ * --------
+ *
+ * The frames are kept in order of their level, from the innermost one
+ * out, as far as gdb listed them. gdb is asked for BACKTRACE_CHUNK of
+ * them at a time, the ones after those it was asked for already, until
+ * an answer has fewer than that. Then the stack isn't any deeper.
+ *
+ * Each thread has its own stack, they're kept in order of the thread's
+ * number, 0 being the one gdb looks at when tgdb can't tell threads apart.
+ * The window shows one of them. Only the innermost frame of the others is
+ * asked for, when the thread window shows them, so a program with
+ * thousands of threads doesn't have each of them listed.
+ *
+ * Each stop of gdb is counted. gdb answers the requests in the order they
+ * were made, each with a TGDB_UPDATE_FRAMES. The requests waiting for an
+ * answer are kept in that order, with the thread and the stop they were
+ * made at, so an answer about the stacks before the program ran again is
+ * dropped.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_CURSES_H
+#include <curses.h>
+#elif HAVE_NCURSES_CURSES_H
+#include <ncurses/curses.h>
+#endif /* HAVE_CURSES_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+/* Local Includes */
+#include "btwin.h"
+#include "cgdb.h"
+#include "tgdb.h"
+#include "sys_util.h"
+#include "logger.h"
+
+extern struct tgdb *tgdb;
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The frames of a thread */
+struct btwin_stack {
+    int thread;                 /* The thread's number, 0 for gdb's one */
+
+    /* The frames gdb listed, the first one is level 0 */
+    struct tgdb_frame *frames;
+    int count, size;
+
+    /* The frames gdb was asked for, and 1 once the stack ended before them */
+    int asked;
+    int done;
+
+    /* 1 if all of them are asked for, see btwin_fetch_all */
+    int all;
+
+    /* Why gdb couldn't list them */
+    char *error;
+};
+
+/* A request waiting for gdb's answer */
+struct btwin_pending {
+    int thread;                 /* The thread it asked about */
+    int count;                  /* How many frames it asked for */
+    unsigned long stop;         /* The stop it was made at */
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+/* The stacks asked about, by thread */
+static struct btwin_stack *btwin_stacks;
+static int btwin_stacks_count, btwin_stacks_size;
+
+/* The thread whose stack is shown */
+static int btwin_thread;
+
+/* The stops of gdb */
+static unsigned long btwin_stop;
+
+static struct btwin_pending *btwin_pending;
+static int btwin_pending_head, btwin_pending_count, btwin_pending_size;
+
+/* The first frame shown, the one marked, and the one btwin_select waits
+ * for, -1 for none */
+static int btwin_top;
+static int btwin_selected;
+static int btwin_wanted = -1;
+
+static WINDOW *btwin_win;
+static char **btwin_drawn;      /* The text on each line of btwin_win */
+static int btwin_height, btwin_width;
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* btwin_search: Finds where a thread's stack is, or would go.
+ * -------------
+ *
+ *   thread:  The number of the thread
+ *
+ * Return Value: The index of the first stack whose thread isn't less than
+ *               thread, btwin_stacks_count if there's none.
+ */
+static int btwin_search(int thread)
+{
+    int low = 0, high = btwin_stacks_count, middle;
+
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (btwin_stacks[middle].thread < thread)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+/* btwin_find: Gets the stack of a thread.
+ * -----------
+ *
+ *   thread:  The number of the thread
+ *   add:     1 to add it if it's not there
+ *
+ * Return Value: The stack, good until a stack is added or forgotten, or
+ *               NULL if there's none.
+ */
+static struct btwin_stack *btwin_find(int thread, int add)
+{
+    int i = btwin_search(thread);
+
+    if (i < btwin_stacks_count && btwin_stacks[i].thread == thread)
+        return &btwin_stacks[i];
+
+    if (!add)
+        return NULL;
+
+    if (btwin_stacks_count == btwin_stacks_size) {
+        btwin_stacks_size = btwin_stacks_size ? btwin_stacks_size * 2 : 16;
+        btwin_stacks = cgdb_realloc(btwin_stacks,
+                sizeof (struct btwin_stack) * btwin_stacks_size);
+    }
+    memmove(btwin_stacks + i + 1, btwin_stacks + i,
+            sizeof (struct btwin_stack) * (btwin_stacks_count - i));
+    btwin_stacks_count++;
+
+    memset(&btwin_stacks[i], 0, sizeof (struct btwin_stack));
+    btwin_stacks[i].thread = thread;
+
+    return &btwin_stacks[i];
+}
+
+/* btwin_request: Asks gdb for the next frames of a stack it wasn't asked for.
+ * --------------
+ *
+ *   count:  How many frames
+ */
+static void btwin_request(struct btwin_stack *stack, int count)
+{
+    struct tgdb_request *request;
+    struct btwin_pending pending;
+
+    request = tgdb_request_frames(tgdb, stack->thread, stack->asked,
+            stack->asked + count - 1);
+    if (!request)
+        return;
+
+    stack->asked += count;
+
+    /* The answer can come before handle_request returns */
+    if (btwin_pending_count == btwin_pending_size) {
+        btwin_pending_size = btwin_pending_size ? btwin_pending_size * 2 : 16;
+        btwin_pending = cgdb_realloc(btwin_pending,
+                sizeof (struct btwin_pending) * btwin_pending_size);
+    }
+    pending.thread = stack->thread;
+    pending.count = count;
+    pending.stop = btwin_stop;
+    btwin_pending[btwin_pending_count++] = pending;
+
+    handle_request(tgdb, request);
+}
+
+/* btwin_fetch: Asks gdb for the frames of the shown stack up to a level.
+ * ------------
+ *
+ *   levels:  How many frames are needed, from the innermost one
+ */
+static void btwin_fetch(int levels)
+{
+    struct btwin_stack *stack = btwin_find(btwin_thread, 1);
+
+    /* The stack is looked up again, handle_request can add another */
+    while (!stack->done && stack->asked < levels) {
+        btwin_request(stack, BACKTRACE_CHUNK);
+        stack = btwin_find(btwin_thread, 1);
+    }
+}
+
+/* btwin_free: Frees the frames gdb listed of a stack.
+ * -----------
+ */
+static void btwin_free(struct btwin_stack *stack)
+{
+    int i;
+
+    /* The paths are interned */
+    for (i = 0; i < stack->count; i++)
+        free(stack->frames[i].function);
+    free(stack->frames);
+    free(stack->error);
+}
+
+/* btwin_forget: Frees the stacks of all the threads.
+ * -------------
+ */
+static void btwin_forget(void)
+{
+    int i;
+
+    for (i = 0; i < btwin_stacks_count; i++)
+        btwin_free(&btwin_stacks[i]);
+    btwin_stacks_count = 0;
+}
+
+/* btwin_add: Adds the frames gdb listed to a stack.
+ * ----------
+ *
+ *   frames:  What gdb listed
+ *   count:   How many frames it was asked for
+ */
+static void btwin_add(struct btwin_stack *stack,
+        const struct tgdb_frames *frames, int count)
+{
+    int i;
+
+    if (frames->error) {
+        stack->done = 1;
+        if (stack->count == 0)
+            stack->error = cgdb_strdup(frames->error);
+        return;
+    }
+
+    for (i = 0; i < frames->count; i++) {
+        const struct tgdb_frame *frame = &frames->frames[i];
+        struct tgdb_frame *copy;
+
+        /* Only the next one is kept, they're all in order */
+        if (frames->low + i != stack->count)
+            continue;
+
+        if (stack->count == stack->size) {
+            stack->size = stack->size ? stack->size * 2 : BACKTRACE_CHUNK;
+            stack->frames = cgdb_realloc(stack->frames,
+                    sizeof (struct tgdb_frame) * stack->size);
+        }
+
+        copy = &stack->frames[stack->count];
+        *copy = *frame;
+        copy->level = stack->count;
+        copy->function = frame->function ? cgdb_strdup(frame->function) : NULL;
+        stack->count++;
+    }
+
+    if (frames->count < count)
+        stack->done = 1;
+}
+
+/* btwin_line: Gets the text of a line of the window.
+ * -----------
+ *
+ * A line is a frame, its level, address, function, file and line.
+ *
+ *   line:  The line, 0 is the first one
+ *   text:  Set to the text, it's cut to the width of the window
+ */
+static void btwin_line(int line, char *text, size_t size)
+{
+    struct btwin_stack *stack = btwin_find(btwin_thread, 0);
+    int level = btwin_top + line;
+    const struct tgdb_frame *frame;
+    int length;
+
+    if (size > (size_t) btwin_width + 1)
+        size = btwin_width + 1;
+    text[0] = '\0';
+
+    if (!stack)
+        return;
+
+    if (stack->count == 0 && stack->done) {
+        if (line == 0)
+            snprintf(text, size, "%s", stack->error ? stack->error : "No stack");
+        return;
+    }
+
+    if (level >= stack->count)
+        return;
+
+    frame = &stack->frames[level];
+    length = snprintf(text, size, "%c#%-2d 0x%lx in %s",
+            level == btwin_selected ? '>' : ' ', level, frame->address,
+            frame->function ? frame->function : "??");
+
+    if (frame->relative_path && length >= 0 && (size_t) length < size)
+        snprintf(text + length, size - length, " at %s:%d",
+                frame->relative_path, frame->line_number);
+}
+
+/* btwin_forget_drawn: Forgets what's on the lines of the window.
+ * -------------------
+ */
+static void btwin_forget_drawn(void)
+{
+    int i;
+
+    for (i = 0; btwin_drawn && i < btwin_height; i++)
+        free(btwin_drawn[i]);
+    free(btwin_drawn);
+    btwin_drawn = NULL;
+}
+
+/* btwin_reset: Shows the innermost frame of the stack again, marked.
+ * ------------
+ */
+static void btwin_reset(void)
+{
+    btwin_top = 0;
+    btwin_selected = 0;
+    btwin_wanted = -1;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in btwin.h for function descriptions. */
+
+void btwin_move(int top, int left, int height, int width)
+{
+    btwin_close();
+
+    if ((btwin_win = newwin(height, width, top, left)) == NULL)
+        return;
+
+    btwin_height = height;
+    btwin_width = width;
+    btwin_drawn = cgdb_calloc(height, sizeof (char *));
+
+    btwin_fetch(btwin_top + btwin_height);
+}
+
+void btwin_display(void)
+{
+    char text[MAXLINE];
+    int line;
+
+    if (!btwin_win)
+        return;
+
+    /* Only the lines that changed are drawn */
+    for (line = 0; line < btwin_height; line++) {
+        btwin_line(line, text, sizeof (text));
+
+        if (btwin_drawn[line] && strcmp(btwin_drawn[line], text) == 0)
+            continue;
+
+        wmove(btwin_win, line, 0);
+        waddstr(btwin_win, text);
+        wclrtoeol(btwin_win);
+
+        free(btwin_drawn[line]);
+        btwin_drawn[line] = cgdb_strdup(text);
+    }
+
+    wnoutrefresh(btwin_win);
+}
+
+void btwin_close(void)
+{
+    btwin_forget_drawn();
+
+    if (btwin_win)
+        delwin(btwin_win);
+    btwin_win = NULL;
+    btwin_height = btwin_width = 0;
+}
+
+int btwin_scroll(int pages)
+{
+    struct btwin_stack *stack = btwin_find(btwin_thread, 1);
+    int distance = (pages < 0 ? -pages : pages) *
+            (btwin_height > 1 ? btwin_height - 1 : 1);
+
+    if (pages < 0) {
+        if (btwin_top == 0)
+            return -1;
+        btwin_top = btwin_top > distance ? btwin_top - distance : 0;
+    } else {
+        if (stack->done && btwin_top + distance >= stack->count)
+            return -1;
+        btwin_top += distance;
+    }
+
+    btwin_fetch(btwin_top + btwin_height);
+
+    return 0;
+}
+
+int btwin_select(int level, const struct tgdb_frame **frame)
+{
+    struct btwin_stack *stack = btwin_find(btwin_thread, 1);
+
+    if (level < 0)
+        return -1;
+
+    if (level < stack->count) {
+        btwin_selected = level;
+        btwin_wanted = -1;
+
+        /* It's scrolled to, when it's off the window */
+        if (level < btwin_top || level >= btwin_top + btwin_height)
+            btwin_top = level;
+
+        *frame = &stack->frames[level];
+        return 0;
+    }
+
+    if (stack->done)
+        return -1;
+
+    btwin_wanted = level;
+    btwin_fetch(level + 1);
+
+    return 1;
+}
+
+int btwin_set_thread(int thread)
+{
+    if (thread == btwin_thread)
+        return 0;
+
+    btwin_thread = thread;
+    btwin_reset();
+
+    return btwin_win != NULL;
+}
+
+const struct tgdb_frame *btwin_peek(int thread)
+{
+    struct btwin_stack *stack = btwin_find(thread, 0);
+
+    if (!stack || stack->count == 0)
+        return NULL;
+
+    return &stack->frames[0];
+}
+
+void btwin_prefetch(int thread)
+{
+    struct btwin_stack *stack = btwin_find(thread, 1);
+
+    if (stack->asked == 0)
+        btwin_request(stack, 1);
+}
+
+void btwin_forget_thread(int thread)
+{
+    int i = btwin_search(thread);
+
+    if (i == btwin_stacks_count || btwin_stacks[i].thread != thread)
+        return;
+
+    btwin_free(&btwin_stacks[i]);
+    memmove(btwin_stacks + i, btwin_stacks + i + 1,
+            sizeof (struct btwin_stack) * (btwin_stacks_count - i - 1));
+    btwin_stacks_count--;
+}
+
+void btwin_stopped(void)
+{
+    int thread = btwin_thread;
+
+    btwin_clear();
+    btwin_thread = thread;
+
+    if (btwin_win)
+        btwin_fetch(btwin_height);
+}
+
+int btwin_update(const struct tgdb_frames *frames,
+        const struct tgdb_frame **selected)
+{
+    struct btwin_pending pending;
+    struct btwin_stack *stack;
+
+    *selected = NULL;
+
+    if (btwin_pending_head == btwin_pending_count) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "frames answer without a request");
+        return 0;
+    }
+
+    pending = btwin_pending[btwin_pending_head++];
+    if (btwin_pending_head == btwin_pending_count)
+        btwin_pending_head = btwin_pending_count = 0;
+
+    /* The program ran since it was asked, or the thread exited */
+    stack = btwin_find(pending.thread, 0);
+    if (pending.stop != btwin_stop || !stack || stack->done)
+        return 0;
+
+    btwin_add(stack, frames, pending.count);
+
+    /* The next ones, once gdb answered for all it was asked */
+    if (stack->all && !stack->done && stack->asked == stack->count) {
+        btwin_request(stack, BACKTRACE_CHUNK);
+        if (!(stack = btwin_find(pending.thread, 0)))
+            return 0;
+    }
+
+    if (pending.thread != btwin_thread)
+        return 0;
+
+    /* The frame the user picked was listed, or the stack isn't that deep */
+    if (btwin_wanted != -1 && btwin_wanted < stack->count) {
+        btwin_select(btwin_wanted, selected);
+    } else if (btwin_wanted != -1 && stack->done)
+        btwin_wanted = -1;
+
+    return btwin_win != NULL;
+}
+
+void btwin_fetch_all(int thread)
+{
+    struct btwin_stack *stack = btwin_find(thread, 1);
+
+    stack->all = 1;
+
+    /* The answer to what it's asked for already asks for the rest */
+    if (!stack->done && stack->asked == stack->count)
+        btwin_request(stack, BACKTRACE_CHUNK);
+}
+
+void btwin_clear(void)
+{
+    btwin_forget();
+
+    /* The answers still coming are about the stacks that are gone */
+    btwin_stop++;
+    btwin_thread = 0;
+    btwin_reset();
+}
+
+int btwin_unanswered(void)
+{
+    return btwin_pending_count - btwin_pending_head;
+}
+
+int btwin_abandon(void)
+{
+    int count = btwin_unanswered();
+
+    btwin_pending_head = btwin_pending_count = 0;
+
+    return count;
+}
@@ -0,0 +1,161 @@
+#ifndef _BTWIN_H_
+#define _BTWIN_H_
+
+/* btwin.h:
+ * --------
+ *
+ * The backtrace window. It shows the frames of the stack, innermost
+ * first, with the one gdb looks at marked. gdb is only asked for the
+ * frames the window shows, a window full at a time, so a deep recursion
+ * doesn't have to be listed whole. The frames are kept until the program
+ * runs again, scrolling back to them doesn't ask gdb.
+ *
+ * It keeps the stack of each thread it was asked about, and shows the one
+ * of the thread gdb looks at. Of the other threads, only the innermost
+ * frame is listed, for the thread window.
+ *
+ */
+
+/* The frames gdb is asked for at a time */
+#define BACKTRACE_CHUNK 32
+
+struct tgdb_frame;
+struct tgdb_frames;
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* btwin_move: Puts the backtrace window somewhere else on the screen.
+ * -----------
+ *
+ *   top, left:      The position of its upper left corner
+ *   height, width:  Its size
+ */
+void btwin_move(int top, int left, int height, int width);
+
+/* btwin_display: Draws the lines that changed since the last time.
+ * --------------
+ *
+ * The terminal isn't refreshed, only the curses virtual screen.
+ */
+void btwin_display(void);
+
+/* btwin_close: Takes the backtrace window off the screen.
+ * ------------
+ *
+ * The frames are kept, they're shown again by btwin_move.
+ */
+void btwin_close(void);
+
+/* btwin_scroll: Shows the frames a window further out or back in.
+ * -------------
+ *
+ *   pages:  How many windows full, negative to go back
+ *
+ * Return Value: 0 on success, -1 if there's no frame that way.
+ */
+int btwin_scroll(int pages);
+
+/* btwin_select: Makes a frame the one that's marked.
+ * -------------
+ *
+ * gdb isn't told, only the window changes.
+ *
+ *   level:  The level of the frame, 0 is the innermost one
+ *   frame:  Set to the frame, when it was listed already
+ *
+ * Return Value: 0 if frame was set, 1 if gdb is asked for the frame first,
+ *               it's given by btwin_update, -1 if there's no such frame.
+ */
+int btwin_select(int level, const struct tgdb_frame **frame);
+
+/* btwin_set_thread: Shows the stack of another thread.
+ * -----------------
+ *
+ * Its innermost frame is marked. gdb isn't told, only the window changes,
+ * the frames are asked for by btwin_select or btwin_stopped.
+ *
+ *   thread:  The number of the thread
+ *
+ * Return Value: 1 if what's shown changed, 0 otherwise.
+ */
+int btwin_set_thread(int thread);
+
+/* btwin_peek: Gets the innermost frame of a thread, if it was listed.
+ * -----------
+ *
+ *   thread:  The number of the thread
+ *
+ * Return Value: The frame, good until the frames change, or NULL.
+ */
+const struct tgdb_frame *btwin_peek(int thread);
+
+/* btwin_prefetch: Asks gdb for the innermost frame of a thread.
+ * ---------------
+ *
+ * It's only asked once, until the frames are forgotten. The answer is given
+ * by btwin_update.
+ *
+ *   thread:  The number of the thread
+ */
+void btwin_prefetch(int thread);
+
+/* btwin_fetch_all: Asks gdb for the whole stack of a thread.
+ * ----------------
+ *
+ * A window full at a time, each answer asks for the next one, until the
+ * stack ends. The answers are given by btwin_update.
+ *
+ *   thread:  The number of the thread
+ */
+void btwin_fetch_all(int thread);
+
+/* btwin_forget_thread: Forgets the frames of a thread, once it exited.
+ * --------------------
+ *
+ *   thread:  The number of the thread
+ */
+void btwin_forget_thread(int thread);
+
+/* btwin_stopped: Forgets the frames, after gdb stopped somewhere else.
+ * --------------
+ *
+ * The innermost frame is marked again.
+ */
+void btwin_stopped(void);
+
+/* btwin_update: Takes the answer to a request for frames.
+ * -------------
+ *
+ *   frames:    What gdb listed
+ *   selected:  Set to the frame btwin_select waited for, when it's in the
+ *              answer, otherwise to NULL
+ *
+ * Return Value: 1 if what's shown changed, 0 otherwise.
+ */
+int btwin_update(const struct tgdb_frames *frames,
+        const struct tgdb_frame **selected);
+
+/* btwin_clear: Forgets the frames and the threads, when the program exits.
+ * ------------
+ */
+void btwin_clear(void);
+
+/* btwin_unanswered: The requests for frames gdb didn't answer yet.
+ * -----------------
+ *
+ * Return Value: How many answers btwin_update is waiting for.
+ */
+int btwin_unanswered(void);
+
+/* btwin_abandon: Stops waiting for gdb's answers, when another gdb is shown.
+ * --------------
+ *
+ * The gdb asked still answers, the caller drops those answers.
+ *
+ * Return Value: How many answers were waited for.
+ */
+int btwin_abandon(void);
+
+#endif /* _BTWIN_H_ */
@@ -0,0 +1,366 @@
+/* capture.c:
+ * ----------
+ *
+ * A chunk holds whole lines, one after the other, without their newlines.
+ * The index has where each line starts in its chunk, and each chunk has the
+ * index of its first line, so a line is found by a binary search of the
+ * chunks. A line ends where the next one in its chunk starts, or where the
+ * chunk's text ends. A line bigger than a chunk gets a chunk of its own.
+ *
+ * The filter keeps the lines that matched so far, in order. While there's
+ * a filter, the lines are looked at from the candidates, the matches of the
+ * filter it was typed from when it was only made longer, then from the
+ * lines that filter hadn't looked at yet, up to the last line.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_CTYPE_H
+#include <ctype.h>
+#endif /* HAVE_CTYPE_H */
+
+/* Local Includes */
+#include "capture.h"
+#include "ibuf.h"
+#include "sys_util.h"
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The bytes of lines a chunk holds */
+#define CAPTURE_CHUNK (64 * 1024)
+
+struct capture_chunk {
+    char *text;
+    unsigned int length;        /* The bytes used in text */
+    unsigned int size;          /* The bytes allocated for text */
+    int first;                  /* The index of its first line */
+};
+
+struct capture {
+    char *command;
+
+    struct capture_chunk *chunks;
+    int chunks_count, chunks_size;
+
+    unsigned int *starts;       /* Where each line starts in its chunk */
+    int lines, lines_size;
+    unsigned long bytes;
+
+    struct ibuf *partial;       /* The line that's not ended yet */
+
+    /* The filter, "" for none */
+    char *filter;
+    int icase;
+
+    int *matches;               /* The lines that matched so far */
+    int matches_count, matches_size;
+
+    int *candidates;            /* The matches of the filter it refines */
+    int candidates_count, candidate;
+
+    int next;                   /* The first line after the candidates that
+                                 * wasn't looked at */
+};
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* capture_append: Adds a whole line.
+ * ---------------
+ */
+static void capture_append(struct capture *capture, const char *text,
+        int length)
+{
+    struct capture_chunk *chunk = capture->chunks_count ?
+            &capture->chunks[capture->chunks_count - 1] : NULL;
+
+    if (length > 0 && text[length - 1] == '\r')
+        length--;
+
+    /* A new chunk, when the line doesn't fit in the last one */
+    if (!chunk || chunk->length + length > chunk->size) {
+        if (capture->chunks_count == capture->chunks_size) {
+            capture->chunks_size = capture->chunks_size ?
+                    capture->chunks_size * 2 : 16;
+            capture->chunks = cgdb_realloc(capture->chunks,
+                    sizeof (struct capture_chunk) * capture->chunks_size);
+        }
+
+        chunk = &capture->chunks[capture->chunks_count++];
+        chunk->size = length > CAPTURE_CHUNK ? length : CAPTURE_CHUNK;
+        chunk->text = cgdb_malloc(chunk->size);
+        chunk->length = 0;
+        chunk->first = capture->lines;
+    }
+
+    if (capture->lines == capture->lines_size) {
+        capture->lines_size = capture->lines_size ?
+                capture->lines_size * 2 : 1024;
+        capture->starts = cgdb_realloc(capture->starts,
+                sizeof (unsigned int) * capture->lines_size);
+    }
+
+    capture->starts[capture->lines++] = chunk->length;
+    memcpy(chunk->text + chunk->length, text, length);
+    chunk->length += length;
+    capture->bytes += length;
+}
+
+/* capture_keep: Adds a line to the ones that matched.
+ * -------------
+ */
+static void capture_keep(struct capture *capture, int line)
+{
+    if (capture->matches_count == capture->matches_size) {
+        capture->matches_size = capture->matches_size ?
+                capture->matches_size * 2 : 1024;
+        capture->matches = cgdb_realloc(capture->matches,
+                sizeof (int) * capture->matches_size);
+    }
+
+    capture->matches[capture->matches_count++] = line;
+}
+
+/* capture_matched: Determines if a line has the filter in it.
+ * ----------------
+ */
+static int capture_matched(struct capture *capture, int index)
+{
+    int length;
+    const char *line = capture_line(capture, index, &length);
+
+    return capture_find(line, length, capture->filter, capture->icase) != -1;
+}
+
+/* -------------------------------------- */
+/* Functions                              */
+/* -------------------------------------- */
+
+struct capture *capture_new(const char *command)
+{
+    struct capture *capture = cgdb_calloc(1, sizeof (struct capture));
+
+    capture->command = cgdb_strdup(command);
+    capture->partial = ibuf_init();
+    capture->filter = cgdb_strdup("");
+
+    return capture;
+}
+
+void capture_free(struct capture *capture)
+{
+    int i;
+
+    if (!capture)
+        return;
+
+    for (i = 0; i < capture->chunks_count; i++)
+        free(capture->chunks[i].text);
+    free(capture->chunks);
+    free(capture->starts);
+    ibuf_free(capture->partial);
+    free(capture->filter);
+    free(capture->matches);
+    free(capture->candidates);
+    free(capture->command);
+    free(capture);
+}
+
+const char *capture_command(struct capture *capture)
+{
+    return capture->command;
+}
+
+void capture_add(struct capture *capture, const char *text, int length)
+{
+    const char *end = text + length, *newline;
+
+    while (text < end) {
+        newline = memchr(text, '\n', end - text);
+        if (!newline) {
+            ibuf_addn(capture->partial, text, end - text);
+            return;
+        }
+
+        /* The start of the line came with the last output */
+        if (ibuf_length(capture->partial) > 0) {
+            ibuf_addn(capture->partial, text, newline - text);
+            capture_append(capture, ibuf_get(capture->partial),
+                    ibuf_length(capture->partial));
+            ibuf_clear(capture->partial);
+        } else
+            capture_append(capture, text, newline - text);
+
+        text = newline + 1;
+    }
+}
+
+void capture_end(struct capture *capture)
+{
+    if (ibuf_length(capture->partial) == 0)
+        return;
+
+    capture_append(capture, ibuf_get(capture->partial),
+            ibuf_length(capture->partial));
+    ibuf_clear(capture->partial);
+}
+
+int capture_lines(struct capture *capture)
+{
+    return capture->lines;
+}
+
+unsigned long capture_bytes(struct capture *capture)
+{
+    return capture->bytes;
+}
+
+const char *capture_line(struct capture *capture, int index, int *length)
+{
+    struct capture_chunk *chunk;
+    int low = 0, high = capture->chunks_count - 1, middle;
+    unsigned int end;
+
+    if (index < 0 || index >= capture->lines)
+        return NULL;
+
+    /* The last chunk whose first line isn't after it */
+    while (low < high) {
+        middle = (low + high + 1) / 2;
+        if (capture->chunks[middle].first <= index)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+    chunk = &capture->chunks[low];
+
+    if (low + 1 < capture->chunks_count &&
+            index + 1 == capture->chunks[low + 1].first)
+        end = chunk->length;
+    else if (index + 1 < capture->lines)
+        end = capture->starts[index + 1];
+    else
+        end = chunk->length;
+
+    *length = end - capture->starts[index];
+
+    return chunk->text + capture->starts[index];
+}
+
+int capture_find(const char *line, int length, const char *text, int icase)
+{
+    int size = strlen(text), i, j;
+    const char *first;
+
+    if (size == 0)
+        return 0;
+
+    for (i = 0; i + size <= length; i++) {
+        /* The first character is found fast, when the case matters */
+        if (!icase) {
+            if (!(first = memchr(line + i, text[0], length - size - i + 1)))
+                return -1;
+            i = first - line;
+        }
+
+        for (j = 0; j < size && (icase ?
+                        tolower((unsigned char) line[i + j]) ==
+                        tolower((unsigned char) text[j]) :
+                        line[i + j] == text[j]); j++)
+            ;
+
+        if (j == size)
+            return i;
+    }
+
+    return -1;
+}
+
+void capture_filter(struct capture *capture, const char *text, int icase)
+{
+    int refine = *capture->filter && icase == capture->icase &&
+            strncmp(text, capture->filter, strlen(capture->filter)) == 0;
+
+    if (strcmp(text, capture->filter) == 0 && icase == capture->icase)
+        return;
+
+    /* A line with the longer filter in it has the shorter one too, so only
+     * the lines the shorter one matched, or didn't get to, are looked at */
+    if (refine) {
+        int left = capture->candidates_count - capture->candidate;
+
+        capture->matches = cgdb_realloc(capture->matches,
+                sizeof (int) * (capture->matches_count + left + 1));
+        memcpy(capture->matches + capture->matches_count,
+                capture->candidates + capture->candidate, sizeof (int) * left);
+
+        free(capture->candidates);
+        capture->candidates = capture->matches;
+        capture->candidates_count = capture->matches_count + left;
+        capture->matches = NULL;
+        capture->matches_size = 0;
+    } else {
+        free(capture->candidates);
+        capture->candidates = NULL;
+        capture->candidates_count = 0;
+        capture->next = 0;
+    }
+    capture->candidate = 0;
+    capture->matches_count = 0;
+
+    free(capture->filter);
+    capture->filter = cgdb_strdup(text);
+    capture->icase = icase;
+}
+
+int capture_filter_step(struct capture *capture, int budget)
+{
+    int line;
+
+    if (!*capture->filter)
+        return 0;
+
+    for (; budget > 0 && capture->candidate < capture->candidates_count;
+            budget--) {
+        line = capture->candidates[capture->candidate++];
+        if (capture_matched(capture, line))
+            capture_keep(capture, line);
+    }
+
+    for (; budget > 0 && capture->next < capture->lines; budget--) {
+        line = capture->next++;
+        if (capture_matched(capture, line))
+            capture_keep(capture, line);
+    }
+
+    return capture->candidate < capture->candidates_count ||
+            capture->next < capture->lines;
+}
+
+int capture_matches(struct capture *capture)
+{
+    return *capture->filter ? capture->matches_count : capture->lines;
+}
+
+int capture_match(struct capture *capture, int index)
+{
+    if (index < 0 || index >= capture_matches(capture))
+        return -1;
+
+    return *capture->filter ? capture->matches[index] : index;
+}
@@ -0,0 +1,132 @@
+#ifndef _CAPTURE_H_
+#define _CAPTURE_H_
+
+/* capture.h:
+ * ----------
+ *
+ * The output of a gdb command, kept out of the GDB window. Commands like
+ * "info functions" or "maint print" can print hundreds of thousands of
+ * lines, which would push everything else out of the scrollback.
+ *
+ * The lines are stored in chunks of about CAPTURE_CHUNK bytes, with an
+ * index of where each one starts, so one is found without going through
+ * the others, and a big capture isn't copied as it grows.
+ *
+ * The lines can be filtered down to the ones with some text in them. The
+ * filtering is done a part at a time, by capture_filter_step, so it can be
+ * interleaved with the user typing the filter. Adding characters to the
+ * end of the filter only looks at the lines that matched before.
+ *
+ */
+
+/* The lines of a command, see capture.c */
+struct capture;
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* capture_new: Creates an empty capture.
+ * ------------
+ *
+ *   command:  The command whose output it is, it's copied
+ *
+ * Return Value: The capture.
+ */
+struct capture *capture_new(const char *command);
+
+/* capture_free: Frees a capture, and its lines.
+ * -------------
+ */
+void capture_free(struct capture *capture);
+
+/* capture_command: Gets the command whose output it is.
+ * ----------------
+ */
+const char *capture_command(struct capture *capture);
+
+/* capture_add: Adds output to a capture.
+ * ------------
+ *
+ * It's split into lines. What comes after the last newline is kept for
+ * the next call, or for capture_end.
+ *
+ *   text:    The output
+ *   length:  The length of text
+ */
+void capture_add(struct capture *capture, const char *text, int length);
+
+/* capture_end: Adds the last line, if the output didn't end with a newline.
+ * ------------
+ */
+void capture_end(struct capture *capture);
+
+/* capture_lines: Gets the number of lines.
+ * --------------
+ */
+int capture_lines(struct capture *capture);
+
+/* capture_bytes: Gets the size of the lines, without their newlines.
+ * --------------
+ */
+unsigned long capture_bytes(struct capture *capture);
+
+/* capture_line: Gets a line.
+ * -------------
+ *
+ *   index:   The line, 0 is the first one
+ *   length:  Set to its length
+ *
+ * Return Value: The line, it isn't terminated. NULL if there's no such line.
+ */
+const char *capture_line(struct capture *capture, int index, int *length);
+
+/* capture_find: Finds text in a line.
+ * -------------
+ *
+ *   line, length:   The line
+ *   text:           What to find, terminated
+ *   icase:          1 to ignore the case of letters
+ *
+ * Return Value: Where text starts in the line, or -1 if it's not in it.
+ */
+int capture_find(const char *line, int length, const char *text, int icase);
+
+/* capture_filter: Sets the text the lines shown have in them.
+ * ---------------
+ *
+ * Nothing is filtered yet, capture_filter_step does it.
+ *
+ *   text:   The text, "" shows every line
+ *   icase:  1 to ignore the case of letters
+ */
+void capture_filter(struct capture *capture, const char *text, int icase);
+
+/* capture_filter_step: Filters some more of the lines.
+ * --------------------
+ *
+ *   budget:  About how many lines to look at
+ *
+ * Return Value: 1 if there are lines left to look at, 0 otherwise.
+ */
+int capture_filter_step(struct capture *capture, int budget);
+
+/* capture_matches: Gets the number of lines shown.
+ * ----------------
+ *
+ * Return Value: The lines that matched the filter so far, every line
+ *               if there's none.
+ */
+int capture_matches(struct capture *capture);
+
+/* capture_match: Gets a line that's shown.
+ * --------------
+ *
+ *   index:  Which of the lines shown, 0 is the first one
+ *
+ * Return Value: The index of the line, for capture_line, or -1 if there's
+ *               no such line.
+ */
+int capture_match(struct capture *capture, int index);
+
+#endif /* _CAPTURE_H_ */
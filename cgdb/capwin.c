@@ -0,0 +1,435 @@
+/* capwin.c:
+ * ---------
+ *
+ * The filter is given to the capture as it's typed, and the first lines are
+ * filtered right away. The rest are filtered from a timer that fires the
+ * next time around the event loop, so the keys typed in between are read
+ * first. Adding to the filter makes the capture look only at the lines
+ * that matched, the window doesn't have to do anything for it.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_CURSES_H
+#include <curses.h>
+#elif HAVE_NCURSES_CURSES_H
+#include <ncurses/curses.h>
+#endif /* HAVE_CURSES_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#include "capwin.h"
+#include "capture.h"
+#include "cgdb.h"
+#include "cgdbrc.h"
+#include "interface.h"
+#include "highlight.h"
+#include "highlight_groups.h"
+#include "kui_term.h"
+#include "event_loop.h"
+#include "ibuf.h"
+#include "sys_util.h"
+
+struct capwin {
+    WINDOW *win;                /* Curses window */
+    struct capture *capture;    /* The capture shown, or NULL */
+    struct ibuf *text;          /* The line drawn, terminated */
+
+    int sel;                    /* The line selected, of the ones shown */
+    int top;                    /* The line shown at the top */
+    int col;                    /* The first column shown */
+
+    char filter[MAX_LINE];      /* The text the lines shown have in them */
+    int filter_pos;             /* The length of filter */
+    char kept[MAX_LINE];        /* The filter before it was edited */
+    int editing;                /* 1 while the filter is typed */
+
+    int timer;                  /* Filters the rest of the lines, or -1 */
+};
+
+/* print_in_middle: Prints the message 'string' centered at line in win
+ * ----------------
+ */
+static void print_in_middle(WINDOW * win, int line, int width,
+        const char *string)
+{
+    int length = strlen(string);
+    int x = length < width ? (width - length) / 2 : 0;
+    int j;
+
+    wmove(win, line, 0);
+    for (j = 0; j < width; j++)
+        waddch(win, ' ');
+
+    mvwaddnstr(win, line, x, string, width);
+}
+
+/* capwin_due: Filters some more of the lines, and shows what it found.
+ * -----------
+ */
+static void capwin_due(void *context);
+
+/* capwin_step: Filters some of the lines, the rest are filtered later.
+ * ------------
+ */
+static void capwin_step(struct capwin *cw)
+{
+    if (capture_filter_step(cw->capture, CAPWIN_STEP_LINES)) {
+        if (cw->timer == -1)
+            cw->timer = event_loop_add_timer(0, capwin_due, cw);
+    } else {
+        event_loop_remove_timer(cw->timer);
+        cw->timer = -1;
+    }
+}
+
+static void capwin_due(void *context)
+{
+    struct capwin *cw = (struct capwin *) context;
+
+    cw->timer = -1;
+    capwin_step(cw);
+
+    /* The filter goes on while it's hidden, it's shown done */
+    if (if_get_focus() == CAPTURE_DLG)
+        capwin_display(cw);
+}
+
+/* capwin_filter: Filters the lines with the text typed.
+ * --------------
+ */
+static void capwin_filter(struct capwin *cw)
+{
+    capture_filter(cw->capture, cw->filter,
+            cgdbrc_get(CGDBRC_IGNORECASE)->variant.int_val);
+    cw->sel = cw->top = 0;
+    capwin_step(cw);
+}
+
+static void capwin_vscroll(struct capwin *cw, int offset)
+{
+    cw->sel += offset;
+    if (cw->sel >= capture_matches(cw->capture))
+        cw->sel = capture_matches(cw->capture) - 1;
+    if (cw->sel < 0)
+        cw->sel = 0;
+}
+
+static void capwin_hscroll(struct capwin *cw, int offset)
+{
+    cw->col += offset;
+    if (cw->col < 0)
+        cw->col = 0;
+}
+
+/* capwin_label: Writes what's captured, and how many lines are shown.
+ * -------------
+ */
+static void capwin_label(struct capwin *cw, char *label, int size)
+{
+    struct capture *capture = cw->capture;
+
+    if (cw->filter_pos == 0)
+        snprintf(label, size, "%s: %d lines, %.1f MB",
+                capture_command(capture), capture_lines(capture),
+                capture_bytes(capture) / (1024.0 * 1024.0));
+    else
+        /* The filter can be as long as the label, it gets half of it */
+        snprintf(label, size, "%s: %d of %d lines match \"%.*s\"%s",
+                capture_command(capture), capture_matches(capture),
+                capture_lines(capture), size / 2, cw->filter,
+                cw->timer != -1 ? ", filtering..." : "");
+}
+
+/* capwin_line: Draws a line, with where it matches the filter highlighted.
+ * ------------
+ */
+static void capwin_line(struct capwin *cw, int index, int width, int tabstop)
+{
+    struct hl_run runs[2];
+    const char *line;
+    int length, start;
+
+    line = capture_line(cw->capture, index, &length);
+
+    /* The line isn't terminated in the capture */
+    ibuf_clear(cw->text);
+    ibuf_addn(cw->text, line, length);
+
+    memset(runs, 0, sizeof (runs));
+    if (cw->filter_pos > 0 && (start = capture_find(line, length, cw->filter,
+                            cgdbrc_get(CGDBRC_IGNORECASE)->variant.int_val))
+            != -1) {
+        runs[0].start = start;
+        runs[0].length = cw->filter_pos;
+        runs[0].group = HLG_SEARCH;
+    }
+
+    /* hl_wprintw remembers long lines by their address, which is the same
+     * for each of the lines copied */
+    hl_wprintw_forget();
+    hl_wprintw(cw->win, ibuf_get(cw->text), runs, width, cw->col, tabstop);
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+struct capwin *capwin_new(int pos_r, int pos_c, int height, int width)
+{
+    struct capwin *cw = cgdb_calloc(1, sizeof (struct capwin));
+
+    cw->win = newwin(height, width, pos_r, pos_c);
+    cw->text = ibuf_init();
+    cw->timer = -1;
+
+    return cw;
+}
+
+void capwin_free(struct capwin *cw)
+{
+    event_loop_remove_timer(cw->timer);
+    delwin(cw->win);
+    ibuf_free(cw->text);
+    free(cw);
+}
+
+void capwin_set(struct capwin *cw, struct capture *capture)
+{
+    event_loop_remove_timer(cw->timer);
+    cw->timer = -1;
+
+    cw->capture = capture;
+    cw->sel = cw->top = cw->col = 0;
+    cw->filter[0] = '\0';
+    cw->filter_pos = 0;
+    cw->editing = 0;
+
+    if (capture)
+        capture_filter(capture, "", 0);
+}
+
+struct capture *capwin_get(struct capwin *cw)
+{
+    return cw->capture;
+}
+
+int capwin_display(struct capwin *cw)
+{
+    char label[MAX_LINE];
+    int height, width, rows, count, lwidth, number;
+    int attr, i, j;
+    int tabstop = cgdbrc_get_snapshot()->tabstop;
+
+    curs_set(0);
+    getmaxyx(cw->win, height, width);
+
+    if (!cw->capture) {
+        werase(cw->win);
+        print_in_middle(cw->win, 0, width, "Nothing was captured");
+        wrefresh(cw->win);
+        return 0;
+    }
+
+    /* The label and the status bar take a line each */
+    rows = height - 2;
+    count = capture_matches(cw->capture);
+
+    if (cw->sel >= count)
+        cw->sel = count - 1;
+    if (cw->sel < 0)
+        cw->sel = 0;
+    if (cw->top > cw->sel)
+        cw->top = cw->sel;
+    else if (cw->top < cw->sel - rows + 1)
+        cw->top = cw->sel - rows + 1;
+
+    for (lwidth = 1, number = capture_lines(cw->capture); number >= 10;
+            number /= 10)
+        lwidth++;
+
+    capwin_label(cw, label, sizeof (label));
+    print_in_middle(cw->win, 0, width, label);
+
+    /* Only the lines on the screen are looked at */
+    for (i = 0; i < rows; i++) {
+        int index = capture_match(cw->capture, cw->top + i);
+
+        wmove(cw->win, i + 1, 0);
+
+        if (index == -1) {
+            for (j = 1; j < lwidth; j++)
+                waddch(cw->win, ' ');
+            waddch(cw->win, '~');
+            wattron(cw->win, A_BOLD);
+            waddch(cw->win, VERT_LINE);
+            wattroff(cw->win, A_BOLD);
+            wclrtoeol(cw->win);
+            continue;
+        }
+
+        /* Mark the selected line with an arrow */
+        if (cw->top + i == cw->sel) {
+            wattron(cw->win, A_BOLD);
+            wprintw(cw->win, "%*d", lwidth, index + 1);
+            wattroff(cw->win, A_BOLD);
+            if (hl_groups_get_attr(hl_groups_instance, HLG_ARROW,
+                            &attr) == -1)
+                return -1;
+            wattron(cw->win, attr);
+            waddch(cw->win, '-');
+            waddch(cw->win, '>');
+            wattroff(cw->win, attr);
+        } else {
+            wprintw(cw->win, "%*d", lwidth, index + 1);
+            wattron(cw->win, A_BOLD);
+            waddch(cw->win, VERT_LINE);
+            wattroff(cw->win, A_BOLD);
+            waddch(cw->win, ' ');
+        }
+
+        capwin_line(cw, index, width - lwidth - 2, tabstop);
+        wclrtoeol(cw->win);
+    }
+
+    /* Update status bar */
+    if (hl_groups_get_attr(hl_groups_instance, HLG_STATUS_BAR, &attr) == -1)
+        return -1;
+    wattron(cw->win, attr);
+
+    for (i = 0; i < width; i++)
+        mvwprintw(cw->win, height - 1, i, " ");
+
+    if (cw->editing)
+        mvwprintw(cw->win, height - 1, 0, "Filter:%s", cw->filter);
+    else if (cw->filter_pos > 0)
+        mvwprintw(cw->win, height - 1, 0,
+                "/ edits the filter, Esc clears it, q closes");
+    else
+        mvwprintw(cw->win, height - 1, 0, "/ filters the lines, q closes");
+
+    wattroff(cw->win, attr);
+    wrefresh(cw->win);
+
+    return 0;
+}
+
+int capwin_recv_char(struct capwin *cw, int key)
+{
+    /* A page is the lines between the label and the status bar */
+    int page = getmaxy(cw->win) - 3;
+
+    if (!cw->capture)
+        return -1;
+
+    if (cw->editing) {
+        switch (key) {
+            case CGDB_KEY_ESC:
+                /* The filter goes back to what it was */
+                strcpy(cw->filter, cw->kept);
+                cw->filter_pos = strlen(cw->filter);
+                cw->editing = 0;
+                capwin_filter(cw);
+                break;
+            case '\n':
+            case '\r':
+            case CGDB_KEY_CTRL_M:
+                cw->editing = 0;
+                break;
+            case CGDB_KEY_DOWN:
+            case CGDB_KEY_CTRL_N:
+                capwin_vscroll(cw, 1);
+                break;
+            case CGDB_KEY_UP:
+            case CGDB_KEY_CTRL_P:
+                capwin_vscroll(cw, -1);
+                break;
+            default:
+                if (CGDB_BACKSPACE_KEY(key)) {
+                    if (cw->filter_pos > 0) {
+                        cw->filter[--cw->filter_pos] = '\0';
+                        capwin_filter(cw);
+                    }
+                } else if (key >= ' ' && key < 127 &&
+                        cw->filter_pos < MAX_LINE - 1) {
+                    /* The lines that matched before are narrowed down */
+                    cw->filter[cw->filter_pos++] = key;
+                    cw->filter[cw->filter_pos] = '\0';
+                    capwin_filter(cw);
+                }
+                break;
+        }
+
+        capwin_display(cw);
+        return 0;
+    }
+
+    switch (key) {
+        case 'q':
+            return -1;
+            /* Vertical scrolling */
+        case CGDB_KEY_DOWN:
+        case 'j':
+            capwin_vscroll(cw, 1);
+            break;
+        case CGDB_KEY_NPAGE:
+        case CGDB_KEY_CTRL_F:  /* VI-style page down */
+            capwin_vscroll(cw, page);
+            break;
+        case CGDB_KEY_UP:
+        case 'k':
+            capwin_vscroll(cw, -1);
+            break;
+        case CGDB_KEY_PPAGE:
+        case CGDB_KEY_CTRL_B:  /* VI-style page up */
+            capwin_vscroll(cw, -page);
+            break;
+        case CGDB_KEY_HOME:
+        case 'g':
+            cw->sel = 0;
+            break;
+        case CGDB_KEY_END:
+        case 'G':
+            capwin_vscroll(cw, capture_matches(cw->capture));
+            break;
+            /* Horizontal scrolling */
+        case CGDB_KEY_RIGHT:
+        case 'l':
+            capwin_hscroll(cw, 1);
+            break;
+        case CGDB_KEY_LEFT:
+        case 'h':
+            capwin_hscroll(cw, -1);
+            break;
+        case '/':
+            strcpy(cw->kept, cw->filter);
+            cw->editing = 1;
+            break;
+        case CGDB_KEY_ESC:
+            if (cw->filter_pos > 0) {
+                cw->filter[0] = '\0';
+                cw->filter_pos = 0;
+                capwin_filter(cw);
+            }
+            break;
+        default:
+            break;
+    }
+
+    capwin_display(cw);
+
+    return 0;
+}
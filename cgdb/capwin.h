@@ -0,0 +1,73 @@
+#ifndef _CAPWIN_H_
+#define _CAPWIN_H_
+
+/* capwin.h:
+ * ---------
+ *
+ * The window that shows a capture, the output of a command kept out of the
+ * GDB window. It takes the whole screen, like the file dialog. Only the
+ * lines on the screen are looked at to draw it, so a capture of millions
+ * of lines is drawn as fast as a small one.
+ *
+ * Typing '/' edits a filter, the lines without it in them are hidden. The
+ * lines are filtered a part at a time, between keys, so typing isn't held
+ * up by a big capture, and the lines found so far are shown as they are.
+ *
+ */
+
+struct capture;
+
+/* The lines filtered between keys */
+#define CAPWIN_STEP_LINES 20000
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* capwin_new: Creates the window.
+ * -----------
+ *
+ *   pos_r:   position of the window (row)
+ *   pos_c:   position of the window (column)
+ *   height:  height (in lines) of the window
+ *   width:   width (in columns) of the window
+ *
+ * Return Value: The window, or NULL on error.
+ */
+struct capwin *capwin_new(int pos_r, int pos_c, int height, int width);
+
+/* capwin_free: Frees the window, not its capture.
+ * ------------
+ */
+void capwin_free(struct capwin *cw);
+
+/* capwin_set: Sets the capture shown, from its first line, unfiltered.
+ * -----------
+ *
+ *   capture:  The capture, or NULL for none. It's not copied, it must be
+ *             set to something else before it's freed.
+ */
+void capwin_set(struct capwin *cw, struct capture *capture);
+
+/* capwin_get: Gets the capture shown, or NULL if there's none.
+ * -----------
+ */
+struct capture *capwin_get(struct capwin *cw);
+
+/* capwin_display: Draws the window.
+ * ---------------
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+int capwin_display(struct capwin *cw);
+
+/* capwin_recv_char: Sends a key to the window.
+ * -----------------
+ *
+ *   key:  The key the user typed
+ *
+ * Return Value: -1 if the window should be closed, 0 otherwise.
+ */
+int capwin_recv_char(struct capwin *cw, int key);
+
+#endif /* _CAPWIN_H_ */
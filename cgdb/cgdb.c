@@ -60,6 +60,10 @@
 #include <getopt.h>
 #endif
 
+#if HAVE_LOCALE_H
+#include <locale.h>
+#endif
+
 #if HAVE_CTYPE_H
 #include <ctype.h>
 #endif
@@ -69,11 +73,20 @@
 #include "logger.h"
 #include "interface.h"
 #include "scroller.h"
+#include "brkwin.h"
 #include "sources.h"
+#include "highlight.h"
+#include "highlight_cache.h"
+#include "resume.h"
+#include "srclist.h"
+#include "grep.h"
+#include "loader.h"
 #include "tgdb.h"
 #include "kui.h"
 #include "kui_term.h"
 #include "fs_util.h"
+#include "fs_watch.h"
+#include "event_loop.h"
 #include "cgdbrc.h"
 #include "io.h"
 #include "tgdb_list.h"
@@ -84,6 +97,12 @@
 #include "ibuf.h"
 #include "usage.h"
 #include "sys_util.h"
+#include "stats.h"
+#include "tracer.h"
+#include "profile.h"
+#include "stacks.h"
+#include "capture.h"
+#include "termout.h"
 
 /* --------- */
 /* Constants */
@@ -95,7 +114,7 @@ const char *readline_history_filename = "readline_history.txt";
 /* Local Variables */
 /* --------------- */
 
-struct tgdb *tgdb;              /* The main TGDB context */
+struct tgdb *tgdb;              /* The TGDB context of the tab shown */
 struct tgdb_request *last_request = NULL;
 
 char cgdb_home_dir[MAXLINE];    /* Path to home directory with trailing slash */
@@ -105,10 +124,65 @@ char *readline_history_path;    /* After readline init is called, this will
 
 static int gdb_fd = -1;         /* File descriptor for GDB communication */
 
+/* A gdb cgdb runs. Each one is a tab, and only one is shown at a time. The
+ * others keep their output, their breakpoints and where they stopped, and
+ * are shown again with them. They all show their files in the one source
+ * window, so a file they share is read and highlighted once. */
+struct tab {
+    struct tgdb *tgdb;
+    int gdb_fd;
+    int tty_added;              /* The tty_fd the main loop waits on */
+    char *label;                /* The arguments gdb was started with */
+    char *sources;              /* What its source files are kept for */
+    char *prompt;               /* gdb's prompt, NULL until it tells */
+
+    /* Only kept while the tab isn't shown */
+    struct scroller *console;   /* Its GDB window */
+    struct brkwin_breaks *breaks;       /* Its breakpoints */
+
+    /* Where gdb last stopped, absolute_path is NULL until it does */
+    struct tgdb_file_position position;
+
+    int core;                   /* 1 while its gdb debugs a core dump */
+
+    /* gdb answers requests for frames in order. These are the answers
+     * that were for the backtrace window of another time it was shown */
+    int frames_stale;
+
+    /* Set while :tab stacks waits for its stack, after stack_before more
+     * answers for frames */
+    int stack_asked;
+    int stack_before;
+    int stack_slot;             /* Which of the tabs asked it is */
+};
+
+/* An MPI job is debugged with a tab for each of its ranks */
+#define TABS_MAX 64
+
+/* The frames of a stack :tab stacks compares */
+#define TABS_STACK_DEPTH 64
+
+static struct tab *tabs[TABS_MAX];
+static int tab_count;
+static int tab_current;         /* The tab shown, tgdb and gdb_fd are its */
+
+/* The output of the last command run with :capture, and its request while
+ * the output is still coming */
+static struct capture *capture_last;
+static struct tgdb_request *capture_request;
+
 /** Master/Slave PTY used to keep readline off of stdin/stdout. */
 static pty_pair_ptr pty_pair;
 
+/** The keys typed into the gdb window, waiting to be written to readline. */
+static struct io_writer *gdb_keys;
+
 static char *debugger_path = NULL;  /* Path to debugger to use */
+static int use_gdbmi = 0;       /* Talk to the debugger with GDB/MI */
+static char *session_path = NULL;       /* The session server's socket */
+static char *remote_command = NULL;     /* Connects to a headless cgdb */
+static int headless = 0;        /* Serve a remote cgdb, without a screen */
+static int resume = 0;          /* Start where the last cgdb on it was */
 
 struct kui_manager *kui_ctx = NULL; /* The key input package */
 
@@ -146,12 +220,9 @@ int kui_input_acceptable = 1;
  * is received it is written to this pipe to be processed in the main loop.
  * The main loop is more efficient if it only has to process the last
  * resize, since all the intermediate signals will be of no use. By creating
- * a separate pipe, the main loop can easily detect if more SIGWINCH signals
- * have been received and ignore them.
- *
- * I'm not sure if this optimization is still necessary as it was needed
- * around the year 2005. It may or may not still matter, but the logic
- * overhead isn't that complex anyways.
+ * a separate pipe, the main loop can easily read all the SIGWINCH signals
+ * that have been received at once. The resize is then applied once the
+ * signals stop coming for a moment, when the user is done resizing.
  */
 int resize_pipe[2] = { -1, -1 };
 
@@ -215,6 +286,8 @@ enum tab_completion_state {
     TAB_COMPLETION_COMPLETION_DISPLAY,
   /** Query the user to continue tab completion, and waiting for response */
     TAB_COMPLETION_QUERY_PAGER,
+  /** The user is typing the text to look for in the matches */
+    TAB_COMPLETION_QUERY_FILTER,
   /** All done */
     TAB_COMPLETION_DONE
 };
@@ -226,19 +299,23 @@ enum tab_completion_state {
  * the tab completion data can be interactive (and is by default). So, this 
  * context keeps track of what has been displayed to the user, and what needs
  * to be displayed while CGDB get's input from the user.
+ *
+ * The matches aren't copied, the context walks the cached matches and only
+ * formats the ones that are shown. The pager can jump to the first or the
+ * last page, and only show the matches that have some text in them.
  */
 typedef struct tab_completion_ctx {
-  /** All of the possible completion matches, valid from [0,num_matches]. */
-    char **matches;
+  /** All of the possible completion matches, they point into the cache. */
+    struct tgdb_list *matches;
   /** The number of completion matches in the 'matches' field. */
     int num_matches;
-  /** The longest line in the 'matches' field */
-    int max_length;
 
   /** These variables changed based on the state of this object */
 
-  /** Total number of lines printed so far. */
-    int total;
+  /** The next match to show, or NULL once they all were. */
+    tgdb_list_iterator *match;
+  /** Only matches with this text in them are shown, empty for all of them. */
+    struct ibuf *filter;
   /** Total number of lines printed so far since last pager. */
     int lines;
   /** The current tab completion state */
@@ -250,9 +327,57 @@ typedef struct tab_completion_ctx {
  * If non-null, currently doing a display */
 static tab_completion_ptr completion_ptr = NULL;
 
+/**
+ * The matches gdb gave the last time a line was completed. Completing the
+ * same line again, or a longer one, only needs the matches narrowed down, so
+ * it's done here instead of asking gdb, which can take seconds when there
+ * are a lot of symbols.
+ */
+static struct completion_cache {
+  /** The line gdb was asked to complete, or NULL if nothing is cached. */
+    char *line;
+  /** Set once gdb's matches for the line are in the arena. */
+    int ready;
+  /** Set if gdb stopped at max-completions and left some matches out. */
+    int truncated;
+  /** The matches, one after another, each ending in a NUL. */
+    char *arena;
+  /** The bytes the matches use, and the bytes the arena has room for. */
+    size_t length, size;
+  /** The matches given to readline, they point into the arena. */
+    struct tgdb_list *matches;
+} completion_cache;
+
 /* Original terminal attributes */
 static struct termios term_attributes;
 
+/**
+ * How far the file dialog got with the source files that come in batches,
+ * while gdb is still listing them.
+ */
+enum source_files_streamed_state {
+  /** No batch came in yet */
+    STREAMED_NONE,
+  /** The batches were added to the file dialog, but it isn't shown */
+    STREAMED_ADDED,
+  /** The file dialog was shown with the first batch */
+    STREAMED_SHOWN,
+  /** The file dialog shows the files listed before, gdb is listing them
+   *  again to bring it up to date */
+    STREAMED_REFRESH
+};
+
+static enum source_files_streamed_state source_files_streamed = STREAMED_NONE;
+
+static void process_commands(struct tgdb *tgdb);
+static void tab_close(struct tab *tab);
+static int tab_frames(struct tab *tab, const struct tgdb_frames *frames);
+static int tab_request(struct tab *tab, struct tgdb_request *request);
+static void completion_cache_clear(void);
+static tab_completion_ptr tab_completion_create(struct tgdb_list *matches);
+static int handle_tab_completion_request(tab_completion_ptr comptr, int key);
+int do_tab_completion(struct tgdb_list *list);
+
 /**
  * If the TGDB instance is not busy, it will run the requested command.
  * Otherwise, the command will get queued to run later.
@@ -282,6 +407,9 @@ int handle_request(struct tgdb *tgdb, struct tgdb_request *request)
     else {
         last_request = request;
         tgdb_process_command(tgdb, request);
+
+        /* tgdb may know the answer without asking gdb */
+        process_commands(tgdb);
     }
 
     return 0;
@@ -307,7 +435,9 @@ int run_shell_command(const char *command)
     printf("\n");
 
     /* Put the terminal in cooked mode and turn on echo */
+    if_bracketed_paste(0);
     endwin();
+    termout_send();
     tty_set_attributes(STDIN_FILENO, &term_attributes);
 
     /* NULL or empty string means invoke user's shell */
@@ -334,6 +464,8 @@ int run_shell_command(const char *command)
 
     /* Turn off echo and put the terminal back into raw mode */
     tty_cbreak(STDIN_FILENO, &term_attributes);
+    termout_resume();
+    if_bracketed_paste(1);
     if_draw();
 
     return rv;
@@ -406,17 +538,122 @@ void rlctx_send_user_command(char *line)
         logger_write_pos(logger, __FILE__, __LINE__,
                 "rlctx_send_user_command\n");
 
+    /* The command can load new symbols */
+    completion_cache_clear();
+
     /* Send this command to TGDB */
     handle_request(tgdb, request_ptr);
 
     ibuf_clear(current_line);
 }
 
+/* completion_cache_clear: Forgets the matches gdb gave last.
+ * ----------------------
+ */
+static void completion_cache_clear(void)
+{
+    free(completion_cache.line);
+    completion_cache.line = NULL;
+    completion_cache.ready = 0;
+    completion_cache.truncated = 0;
+    completion_cache.length = 0;
+
+    if (completion_cache.matches)
+        tgdb_list_clear(completion_cache.matches);
+}
+
+/* completion_cache_store: Keeps the matches gdb gave for the cached line.
+ * ----------------------
+ *
+ *   list:  The matches, they're copied into the arena
+ *
+ * Return Value: The matches, in the arena.
+ */
+static struct tgdb_list *completion_cache_store(struct tgdb_list *list)
+{
+    tgdb_list_iterator *i;
+    size_t length = 0, size;
+    char *match;
+
+    if (!completion_cache.matches)
+        completion_cache.matches = tgdb_list_init();
+    tgdb_list_clear(completion_cache.matches);
+    completion_cache.length = 0;
+
+    for (i = tgdb_list_get_first(list); i; i = tgdb_list_next(i))
+        length += strlen(tgdb_list_get_item(i)) + 1;
+
+    if (length > completion_cache.size) {
+        completion_cache.size = length;
+        completion_cache.arena = cgdb_realloc(completion_cache.arena, length);
+    }
+
+    for (i = tgdb_list_get_first(list); i; i = tgdb_list_next(i)) {
+        match = tgdb_list_get_item(i);
+        size = strlen(match) + 1;
+
+        /* Leaving some matches out means a longer line may have more */
+        if (strstr(match, "max-completions reached"))
+            completion_cache.truncated = 1;
+
+        memcpy(completion_cache.arena + completion_cache.length, match, size);
+        completion_cache.length += size;
+    }
+
+    /* The pointers are taken once the arena is done growing */
+    for (length = 0; length < completion_cache.length;
+            length += strlen(completion_cache.arena + length) + 1)
+        tgdb_list_append(completion_cache.matches,
+                completion_cache.arena + length);
+
+    /* Unless the cache was cleared while gdb was completing */
+    completion_cache.ready = completion_cache.line != NULL;
+
+    return completion_cache.matches;
+}
+
+/* completion_cache_narrow: Narrows the cached matches down to a line.
+ * -----------------------
+ *
+ *   line:  The line being completed
+ *
+ * Return Value: The matches for the line, or NULL if gdb has to be asked.
+ */
+static struct tgdb_list *completion_cache_narrow(const char *line)
+{
+    size_t prefix, length = strlen(line), offset;
+    char *match;
+
+    if (!completion_cache.ready || completion_cache.truncated)
+        return NULL;
+
+    /* Only more of the word that was completed can be typed, a new word
+     * has matches of its own */
+    prefix = strlen(completion_cache.line);
+    if (length < prefix || strncmp(line, completion_cache.line, prefix) != 0 ||
+            strpbrk(line + prefix, " \t'\",") != NULL)
+        return NULL;
+
+    if (!completion_cache.matches)
+        completion_cache.matches = tgdb_list_init();
+    tgdb_list_clear(completion_cache.matches);
+
+    for (offset = 0; offset < completion_cache.length;
+            offset += strlen(match) + 1) {
+        match = completion_cache.arena + offset;
+        if (strncmp(match, line, length) == 0)
+            tgdb_list_append(completion_cache.matches, match);
+    }
+
+    return completion_cache.matches;
+}
+
 static int tab_completion(int a, int b)
 {
     char *cur_line;
     int ret;
     tgdb_request_ptr request_ptr;
+    struct tgdb_list *matches;
 
     is_tab_completing = 1;
 
@@ -425,6 +662,22 @@ static int tab_completion(int a, int b)
         logger_write_pos(logger, __FILE__, __LINE__,
                 "rline_get_current_line error\n");
 
+    /* The matches gdb gave for the start of the line are enough */
+    if (ret != -1 && (matches = completion_cache_narrow(cur_line))) {
+        /* Readline would copy every match just to list them */
+        if (tgdb_list_size(matches) > 1 &&
+                rline_rl_completion_lists(rline) == 1) {
+            completion_ptr = tab_completion_create(matches);
+            handle_tab_completion_request(completion_ptr, -1);
+        } else
+            do_tab_completion(matches);
+        return 0;
+    }
+
+    completion_cache_clear();
+    if (ret != -1)
+        completion_cache.line = cgdb_strdup(cur_line);
+
     request_ptr = tgdb_request_complete(tgdb, cur_line);
     if (!request_ptr)
         logger_write_pos(logger, __FILE__, __LINE__,
@@ -439,32 +692,21 @@ static int tab_completion(int a, int b)
  *
  * \param matches
  * See tab_completion field documentation
- * 
- * \param num_matches
- * See tab_completion field documentation
- *
- * \param max_length
- * See tab_completion field documentation
  *
  * \return
  * The next context, or NULL on error.
  */
-static tab_completion_ptr
-tab_completion_create(char **matches, int num_matches, int max_length)
+static tab_completion_ptr tab_completion_create(struct tgdb_list *matches)
 {
-    int i;
     tab_completion_ptr comptr;
 
     comptr = (tab_completion_ptr) cgdb_malloc(sizeof (struct
                     tab_completion_ctx));
 
-    comptr->matches = cgdb_malloc(sizeof (char *) * (num_matches + 1));
-    for (i = 0; i <= num_matches; ++i)
-        comptr->matches[i] = cgdb_strdup(matches[i]);
-
-    comptr->num_matches = num_matches;
-    comptr->max_length = max_length;
-    comptr->total = 1;
+    comptr->matches = matches;
+    comptr->num_matches = tgdb_list_size(matches);
+    comptr->match = tgdb_list_get_first(matches);
+    comptr->filter = ibuf_init();
     comptr->lines = 0;
     comptr->state = TAB_COMPLETION_START;
 
@@ -479,24 +721,65 @@ tab_completion_create(char **matches, int num_matches, int max_length)
  */
 static void tab_completion_destroy(tab_completion_ptr comptr)
 {
-    int i;
-
     if (!comptr)
         return;
 
-    if (comptr->matches == 0)
-        return;
+    ibuf_free(comptr->filter);
+    free(comptr);
+}
 
-    for (i = 0; i <= comptr->num_matches; ++i) {
-        free(comptr->matches[i]);
-        comptr->matches[i] = NULL;
-    }
+/**
+ * Checks if a match is shown, with the filter the user gave.
+ *
+ * \param comptr
+ * The tab completion context.
+ *
+ * \param i
+ * The match to check.
+ *
+ * \return
+ * 1 if it's shown, 0 if not.
+ */
+static int tab_completion_shown(tab_completion_ptr comptr,
+        tgdb_list_iterator *i)
+{
+    if (ibuf_length(comptr->filter) == 0)
+        return 1;
 
-    free(comptr->matches);
-    comptr->matches = NULL;
+    return strstr(tgdb_list_get_item(i), ibuf_get(comptr->filter)) != NULL;
+}
 
-    free(comptr);
-    comptr = NULL;
+/**
+ * Moves to the last page of matches, only the matches that are skipped
+ * over are looked at.
+ *
+ * \param comptr
+ * The tab completion context.
+ *
+ * \param page
+ * The number of matches on a page.
+ */
+static void tab_completion_last_page(tab_completion_ptr comptr, int page)
+{
+    tgdb_list_iterator *i, *first = NULL;
+    int shown = 0;
+
+    /* The first match of the page trails the last one looked at */
+    for (i = comptr->match; i; i = tgdb_list_next(i)) {
+        if (!tab_completion_shown(comptr, i))
+            continue;
+
+        if (!first)
+            first = i;
+        else if (++shown >= page) {
+            do
+                first = tgdb_list_next(first);
+            while (!tab_completion_shown(comptr, first));
+        }
+    }
+
+    if (first)
+        comptr->match = first;
 }
 
 /**
@@ -585,11 +868,57 @@ static int handle_tab_completion_request(tab_completion_ptr comptr, int key)
             return 0;           /* stay at the same state */
     }
 
+    if (comptr->state == TAB_COMPLETION_QUERY_FILTER) {
+        if (key == '\r' || key == '\n' || key == CGDB_KEY_CTRL_M) {
+            /* Show the matches with the text in them from the start */
+            if_clear_line();
+            comptr->match = tgdb_list_get_first(comptr->matches);
+            comptr->lines = 0;
+            comptr->state = TAB_COMPLETION_COMPLETION_DISPLAY;
+        } else if (key == CGDB_KEY_CTRL_G || key == CGDB_KEY_ESC) {
+            ibuf_clear(comptr->filter);
+            if_clear_line();
+            if_print("--More--");
+            comptr->state = TAB_COMPLETION_QUERY_PAGER;
+            return 0;
+        } else {
+            if (key == 8 || key == 127)
+                ibuf_delchar(comptr->filter);
+            else if (key > 0 && key < 256 && isprint(key))
+                ibuf_addchar(comptr->filter, key);
+
+            if_clear_line();
+            if_print("/");
+            if_print(ibuf_get(comptr->filter));
+            return 0;
+        }
+    }
+
     if (comptr->state == TAB_COMPLETION_QUERY_PAGER) {
         int i = cgdb_get_y_or_n(key, 1);
 
+        if (key == '/') {
+            /* Ask for the text to look for */
+            ibuf_clear(comptr->filter);
+            if_clear_line();
+            if_print("/");
+            comptr->state = TAB_COMPLETION_QUERY_FILTER;
+            return 0;
+        }
+
+        if (i == -1 && key != 'g' && key != 'G')
+            return 0;           /* stay at the same state */
+
         if_clear_line();        /* Clear the --More-- */
-        if (i == 0)
+        if (key == 'g') {
+            comptr->match = tgdb_list_get_first(comptr->matches);
+            comptr->lines = 0;
+            comptr->state = TAB_COMPLETION_COMPLETION_DISPLAY;
+        } else if (key == 'G') {
+            tab_completion_last_page(comptr, gdb_window_size - 1);
+            comptr->lines = 0;
+            comptr->state = TAB_COMPLETION_COMPLETION_DISPLAY;
+        } else if (i == 0)
             comptr->state = TAB_COMPLETION_DONE;
         else if (i == 2) {
             comptr->lines--;
@@ -601,18 +930,20 @@ static int handle_tab_completion_request(tab_completion_ptr comptr, int key)
     }
 
     if (comptr->state == TAB_COMPLETION_COMPLETION_DISPLAY) {
-        for (; comptr->total <= comptr->num_matches; comptr->total++) {
-            if_print(comptr->matches[comptr->total]);
-            if_print("\n");
+        /* Only the matches that fit are formatted */
+        for (; comptr->match; comptr->match = tgdb_list_next(comptr->match)) {
+            if (!tab_completion_shown(comptr, comptr->match))
+                continue;
 
-            comptr->lines++;
-            if (comptr->lines >= (gdb_window_size - 1) &&
-                    comptr->total < comptr->num_matches) {
+            if (comptr->lines >= (gdb_window_size - 1)) {
                 if_print("--More--");
                 comptr->state = TAB_COMPLETION_QUERY_PAGER;
-                comptr->total++;
                 return 0;
             }
+
+            if_print(tgdb_list_get_item(comptr->match));
+            if_print("\n");
+            comptr->lines++;
         }
 
         comptr->state = TAB_COMPLETION_DONE;
@@ -631,13 +962,16 @@ static int handle_tab_completion_request(tab_completion_ptr comptr, int key)
 /**
  * This is the function responsible for display the readline completions when there
  * is more than 1 item to complete. Currently it prints 1 per line.
+ *
+ * The matches readline gives are the cached ones, which are shown instead,
+ * so they don't have to be copied.
  */
 static void
 readline_completion_display_func(char **matches, int num_matches,
         int max_length)
 {
     /* Create the tab completion item, and attempt to display it to the user */
-    completion_ptr = tab_completion_create(matches, num_matches, max_length);
+    completion_ptr = tab_completion_create(completion_cache.matches);
     if (!completion_ptr)
         logger_write_pos(logger, __FILE__, __LINE__,
                 "tab_completion_create error\n");
@@ -707,12 +1041,17 @@ static char *version_info(void)
 static void parse_long_options(int *argc, char ***argv)
 {
     int c, option_index = 0, n = 1;
-    const char *args = "d:hv";
+    const char *args = "d:hHmr:Rs:v";
 
 #ifdef HAVE_GETOPT_H
     static struct option long_options[] = {
         {"version", 0, 0, 0},
         {"help", 0, 0, 0},
+        {"gdbmi", 0, 0, 0},
+        {"session", 1, 0, 0},
+        {"remote", 1, 0, 0},
+        {"headless", 0, 0, 0},
+        {"resume", 0, 0, 0},
         {0, 0, 0, 0}
     };
 #endif
@@ -739,6 +1078,32 @@ static void parse_long_options(int *argc, char ***argv)
                     case 1:
                         usage();
                         exit(0);
+                    case 2:
+                        use_gdbmi = 1;
+                        n++;
+                        break;
+                    case 3:
+                        session_path = strdup(optarg);
+                        if (optarg == (*argv)[n + 1])
+                            n += 2;
+                        else
+                            n++;
+                        break;
+                    case 4:
+                        remote_command = strdup(optarg);
+                        if (optarg == (*argv)[n + 1])
+                            n += 2;
+                        else
+                            n++;
+                        break;
+                    case 5:
+                        headless = 1;
+                        n++;
+                        break;
+                    case 6:
+                        resume = 1;
+                        n++;
+                        break;
                     default:
                         break;
                 }
@@ -759,6 +1124,32 @@ static void parse_long_options(int *argc, char ***argv)
             case 'h':
                 usage();
                 exit(0);
+            case 'm':
+                use_gdbmi = 1;
+                n++;
+                break;
+            case 's':
+                session_path = strdup(optarg);
+                if (optarg == (*argv)[n + 1])
+                    n += 2;
+                else
+                    n++;
+                break;
+            case 'r':
+                remote_command = strdup(optarg);
+                if (optarg == (*argv)[n + 1])
+                    n += 2;
+                else
+                    n++;
+                break;
+            case 'H':
+                headless = 1;
+                n++;
+                break;
+            case 'R':
+                resume = 1;
+                n++;
+                break;
             default:
                 break;
         }
@@ -793,21 +1184,59 @@ static int init_home_dir(void)
     }
 
     fs_util_get_path(home_dir, cgdb_dir, cgdb_home_dir);
+    hl_cache_init(cgdb_home_dir);
 
     return 0;
 }
 
+/* tab_add: Makes a tab for a gdb that was started.
+ * --------
+ *
+ *   label:    What it was started with
+ *   sources:  From srclist_ident, the tab frees it
+ *
+ * Return Value: The tab.
+ */
+static struct tab *tab_add(struct tgdb *debugger, int fd, const char *label,
+        char *sources)
+{
+    struct tab *tab = cgdb_calloc(1, sizeof (struct tab));
+
+    tab->tgdb = debugger;
+    tab->gdb_fd = fd;
+    tab->tty_added = -1;
+    tab->label = cgdb_strdup(*label ? label : "gdb");
+    tab->sources = sources;
+    tabs[tab_count++] = tab;
+
+    return tab;
+}
+
 /* start_gdb: Starts up libtgdb
  *  Returns:  -1 on error, 0 on success
  */
 static int start_gdb(int argc, char *argv[])
 {
     tgdb_request_ptr request_ptr;
+    char label[MAXLINE];
+    size_t length = 0;
+    int i;
 
-    tgdb = tgdb_initialize(debugger_path, argc, argv, &gdb_fd);
+    /* The remote cgdb was given the debugger's arguments */
+    if (remote_command)
+        tgdb = tgdb_initialize_remote(remote_command, &gdb_fd);
+    else
+        tgdb = tgdb_initialize(debugger_path, argc, argv, &gdb_fd, use_gdbmi);
     if (tgdb == NULL)
         return -1;
 
+    label[0] = '\0';
+    for (i = 0; i < argc && length < sizeof (label); i++)
+        length += snprintf(label + length, sizeof (label) - length, "%s%s",
+                i ? " " : "", argv[i]);
+    tab_add(tgdb, gdb_fd, label,
+            remote_command ? NULL : srclist_ident(argc, argv));
+
     /* Run some initialize commands */
 
     /* gdb may already have some breakpoints when it starts. This could happen
@@ -818,6 +1247,9 @@ static int start_gdb(int argc, char *argv[])
   /**
    * Get the filename GDB defaults to. 
    */
+    if (resume)
+        return 0;
+
     request_ptr = tgdb_request_current_location(tgdb, 1);
     if (handle_request(tgdb, request_ptr) == -1)
         return -1;
@@ -825,21 +1257,49 @@ static int start_gdb(int argc, char *argv[])
     return 0;
 }
 
+/* The keys are written by flush_keys, once a batch of input is handled */
 static void send_key(int focus, char key)
 {
     if (focus == 1) {
-        int size;
-        int masterfd;
-
-        masterfd = pty_pair_get_masterfd(pty_pair);
-        if (masterfd == -1)
-            logger_write_pos(logger, __FILE__, __LINE__, "send_key error");
-        size = write(masterfd, &key, sizeof (char));
-        if (size != 1)
+        if (io_writer_put(gdb_keys, &key, 1) == -1)
             logger_write_pos(logger, __FILE__, __LINE__, "send_key error");
     } else if (focus == 2) {
-        tgdb_send_inferior_char(tgdb, key);
+        if (tgdb_send_inferior_data(tgdb, &key, 1) == -1)
+            logger_write_pos(logger, __FILE__, __LINE__, "send_key error");
+    }
+}
+
+/* How long the keys a program isn't reading wait before they're tried again */
+#define KEYS_RETRY_MS 10
+
+static int keys_timer = -1;     /* Writes the keys left over, -1 if none */
+
+static void keys_due(void *context);
+
+/* flush_keys: Writes the keys send_key queued, with one write for each of
+ * ----------- readline and the program being debugged.
+ */
+static void flush_keys(void)
+{
+    int masterfd = pty_pair_get_masterfd(pty_pair), gdb = 0, inferior;
+
+    if (masterfd != -1 && (gdb = io_writer_flush(gdb_keys, masterfd)) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__, "flush_keys error");
+        io_writer_clear(gdb_keys);
     }
+
+    inferior = tgdb_flush_inferior_data(tgdb);
+
+    /* A terminal that's full takes the rest once it's read some */
+    if ((gdb == 1 || inferior == 1) && keys_timer == -1)
+        keys_timer = event_loop_add_timer(KEYS_RETRY_MS, keys_due, NULL);
+}
+
+/* The keys left over are tried again */
+static void keys_due(void *context)
+{
+    keys_timer = -1;
+    flush_keys();
 }
 
 /* user_input: This function will get a key from the user and process it.
@@ -849,20 +1309,32 @@ static void send_key(int focus, char key)
 static int user_input(void)
 {
     static int key, val;
+    static struct kui_map_set *map_set;
+    struct kui_map_set *focus_map_set = NULL;
 
-    /* Clear the current map sets. Give the KUI the map sets 
-     * that should be used with the current focus.
+    /* Give the KUI the map sets that should be used with the current focus.
+     * The KUI compiles the maps again when they change, so only do it when
+     * the focus did.
      */
-    val = kui_manager_clear_map_sets(kui_ctx);
-    if (val == -1) {
-        logger_write_pos(logger, __FILE__, __LINE__, "user_input error");
-        return -1;
-    }
-
     if (if_get_focus() == CGDB)
-        val = kui_manager_add_map_set(kui_ctx, kui_map);
+        focus_map_set = kui_map;
     else if (if_get_focus() == GDB)
-        val = kui_manager_add_map_set(kui_ctx, kui_imap);
+        focus_map_set = kui_imap;
+
+    if (focus_map_set != map_set || !map_set) {
+        val = kui_manager_clear_map_sets(kui_ctx);
+        if (val == -1) {
+            logger_write_pos(logger, __FILE__, __LINE__, "user_input error");
+            return -1;
+        }
+
+        if (focus_map_set &&
+                kui_manager_add_map_set(kui_ctx, focus_map_set) == -1) {
+            logger_write_pos(logger, __FILE__, __LINE__, "user_input error");
+            return -1;
+        }
+        map_set = focus_map_set;
+    }
 
     key = kui_manager_getkey(kui_ctx);
     if (key == -1) {
@@ -871,6 +1343,14 @@ static int user_input(void)
         return -1;
     }
 
+    /* A map that's partly typed waits for the rest, see keys_wait */
+    if (key == -2)
+        return 0;
+
+    /* The keys between these are passed on without looking for maps */
+    if (key == CGDB_KEY_PASTE_START || key == CGDB_KEY_PASTE_END)
+        return 0;
+
     val = if_input(key);
 
     if (val == -1) {
@@ -932,23 +1412,192 @@ static int user_input_loop()
     return 0;
 }
 
+static int match_timer = -1;    /* Ends a map that's partly typed, or -1 */
+
+static void match_due(void *context);
+
+/* keys_wait: Waits for the rest of a map, or a terminal escape sequence,
+ * ---------- that's partly typed, without blocking the main loop.
+ *
+ * The wait only starts over for keys the user typed, not for ones the kui
+ * had put back.
+ *
+ *   restart:  1 if keys were just read
+ */
+static void keys_wait(int restart)
+{
+    int msecs = kui_manager_get_timeout(kui_ctx);
+
+    if (msecs == -1 || restart) {
+        event_loop_remove_timer(match_timer);
+        match_timer = -1;
+    }
+
+    if (msecs != -1 && match_timer == -1)
+        match_timer = event_loop_add_timer(msecs, match_due, NULL);
+}
+
+/* The keys of a map that's partly typed are handled as they are */
+static void match_due(void *context)
+{
+    match_timer = -1;
+
+    kui_manager_expire_timeout(kui_ctx);
+    if (kui_manager_cangetkey(kui_ctx) == 1) {
+        if (user_input_loop() == -1)
+            logger_write_pos(logger, __FILE__, __LINE__, "match_due error");
+        flush_keys();
+    }
+
+    /* The map a terminal escape sequence was in may be partly typed */
+    keys_wait(0);
+}
+
+/* add_source_files: Gives the file dialog a batch of source files at once.
+ * -----------------
+ *
+ *   list:  The source files gdb listed
+ */
+static void add_source_files(struct tgdb_list *list)
+{
+    char **files = cgdb_malloc(sizeof (char *) * (tgdb_list_size(list) + 1));
+    tgdb_list_iterator *i;
+    int count = 0;
+
+    for (i = tgdb_list_get_first(list); i; i = tgdb_list_next(i))
+        files[count++] = tgdb_list_get_item(i);
+
+    if_add_filedlg_choices(files, count);
+    free(files);
+}
+
+/* save_source_files: Keeps the files the file dialog has, for the next
+ * ------------------  cgdb on the program.
+ */
+static void save_source_files(void)
+{
+    const char *sources = tabs[tab_current]->sources;
+    char **files;
+    int count;
+
+    files = if_get_source_files(&count);
+    if (sources && count > 0)
+        srclist_save(sources, files, count);
+}
+
+/* refresh_source_files: Brings the files the file dialog shows up to date.
+ * ---------------------
+ *
+ * The files gdb didn't list before are added to the front, and the dialog
+ * is only filled in again if some of the ones it listed before are gone.
+ *
+ *   list:  All the source files gdb listed
+ */
+static void refresh_source_files(struct tgdb_list *list)
+{
+    int before, after;
+
+    if_get_source_files(&before);
+    add_source_files(list);
+    if_get_source_files(&after);
+
+    if (after != tgdb_list_size(list)) {
+        if_clear_filedlg();
+        add_source_files(list);
+    } else if (after == before)
+        return;
+
+    save_source_files();
+    if (if_get_focus() == FILE_DLG)
+        if_draw();
+}
+
+void request_source_files(void)
+{
+    const char *sources = tabs[tab_current]->sources;
+    char **files;
+    int count, i;
+
+    /* The files listed the last time are shown right away */
+    if_get_source_files(&count);
+    if (count == 0 && sources && (files = srclist_load(sources, &count))) {
+        if_add_filedlg_choices(files, count);
+        for (i = 0; i < count; i++)
+            free(files[i]);
+        free(files);
+        if_get_source_files(&count);
+    }
+
+    if (count > 0) {
+        source_files_streamed = STREAMED_REFRESH;
+        if_show_filedlg();
+    } else
+        kui_input_acceptable = 0;
+
+    handle_request(tgdb, tgdb_request_inferiors_source_files(tgdb));
+}
+
+/* show_position: Shows where gdb stopped, in all the windows.
+ * --------------
+ */
+static void show_position(const struct tgdb_file_position *tfp)
+{
+    /* Update the file */
+    source_reload(if_get_sview(), tfp->absolute_path, 0);
+
+    if_show_pc(tfp->address);
+    if_watch_stopped(tfp->function);
+    if_memory_stopped();
+    if_backtrace_stopped();
+    if_show_file(tfp->absolute_path, tfp->line_number);
+
+    source_set_relative_path(if_get_sview(),
+            tfp->absolute_path, tfp->relative_path);
+}
+
+/* tab_set_position: Keeps where a tab's gdb stopped, to show it again.
+ * -----------------
+ */
+static void tab_set_position(struct tab *tab,
+        const struct tgdb_file_position *tfp)
+{
+    struct tgdb_file_position *position = &tab->position;
+
+    free(position->function);
+
+    /* The paths are interned */
+    position->absolute_path = tfp->absolute_path;
+    position->relative_path = tfp->relative_path;
+    position->line_number = tfp->line_number;
+    position->address = tfp->address;
+    position->function = tfp->function ? cgdb_strdup(tfp->function) : NULL;
+}
+
 static void process_commands(struct tgdb *tgdb)
 {
+    static int processing;
     struct tgdb_response *item;
+    unsigned long long span;
+    int quit = 0;
 
-    while ((item = tgdb_get_response(tgdb)) != NULL) {
+    /* Responses to a request made while handling one come after it */
+    if (processing)
+        return;
+    processing = 1;
+    span = tracer_begin();
+
+    while (!quit && (item = tgdb_get_response(tgdb)) != NULL) {
         switch (item->header) {
                 /* This updates all the breakpoints */
             case TGDB_UPDATE_BREAKPOINTS:
             {
-                struct sviewer *sview = if_get_sview();
-                char *file;
                 struct tgdb_list *list =
                         item->choice.update_breakpoints.breakpoint_list;
                 tgdb_list_iterator *iterator;
                 struct tgdb_breakpoint *tb;
+                struct source_break *breaks = NULL;
+                int count = 0, size = 0;
 
-                source_clear_breaks(if_get_sview());
                 iterator = tgdb_list_get_first(list);
 
                 while (iterator) {
@@ -956,20 +1605,36 @@ static void process_commands(struct tgdb *tgdb)
                     tb = (struct tgdb_breakpoint *)
                             tgdb_list_get_item(iterator);
 
-                    file = tb->file;
+                    if (count == size) {
+                        size = size ? size * 2 : 16;
+                        breaks = cgdb_realloc(breaks,
+                                sizeof (struct source_break) * size);
+                    }
 
-                    if (tb->enabled)
-                        source_enable_break(sview, file, tb->line);
-                    else
-                        source_disable_break(sview, file, tb->line);
+                    breaks[count].path = tb->file;
+                    breaks[count].line = tb->line;
+                    breaks[count].enabled = tb->enabled;
+                    count++;
 
                     iterator = tgdb_list_next(iterator);
                 }
 
-                if_show_file(NULL, 0);
+                /* Only redraw if the file on screen has a change */
+                if (source_update_breaks(if_get_sview(), breaks, count))
+                    if_show_file(NULL, 0);
+
+                free(breaks);
+                if_prefetch_breaks();
+                if_breakpoints(list);
                 break;
             }
 
+                /* Only the breakpoints gdb told changed */
+            case TGDB_UPDATE_BREAKPOINT_CHANGES:
+                if_breakpoint_changes(item->choice.update_breakpoint_changes.
+                        changes);
+                break;
+
                 /* This means a source file or line number changed */
             case TGDB_UPDATE_FILE_POSITION:
             {
@@ -977,14 +1642,35 @@ static void process_commands(struct tgdb *tgdb)
 
                 tfp = item->choice.update_file_position.file_position;
 
-                /* Update the file */
-                source_reload(if_get_sview(), tfp->absolute_path, 0);
+                tab_set_position(tabs[tab_current], tfp);
+                show_position(tfp);
+                break;
+            }
+
+                /* Some of the source files, gdb is still listing them */
+            case TGDB_ADD_SOURCE_FILES:
+            {
+                struct tgdb_list *list =
+                        item->choice.update_source_files.source_files;
+                int first = (source_files_streamed == STREAMED_NONE);
+
+                /* They're all compared with what's shown at the end */
+                if (source_files_streamed == STREAMED_REFRESH)
+                    break;
 
-                if_show_file(tfp->absolute_path, tfp->line_number);
+                if (first)
+                    if_clear_filedlg();
 
-                source_set_relative_path(if_get_sview(),
-                        tfp->absolute_path, tfp->relative_path);
+                add_source_files(list);
 
+                if (first) {
+                    source_files_streamed = STREAMED_ADDED;
+                    if (if_show_filedlg_partial()) {
+                        source_files_streamed = STREAMED_SHOWN;
+                        kui_input_acceptable = 1;
+                    }
+                } else if (if_get_focus() == FILE_DLG)
+                    if_draw();
                 break;
             }
 
@@ -993,19 +1679,30 @@ static void process_commands(struct tgdb *tgdb)
             {
                 struct tgdb_list *list =
                         item->choice.update_source_files.source_files;
-                tgdb_list_iterator *i = tgdb_list_get_first(list);
-                char *s;
 
-                if_clear_filedlg();
+                if (source_files_streamed == STREAMED_REFRESH) {
+                    refresh_source_files(list);
+                    source_files_streamed = STREAMED_NONE;
+                    if_prefetch_breaks();
+                    break;
+                }
 
-                while (i) {
-                    s = tgdb_list_get_item(i);
-                    if_add_filedlg_choice(s);
-                    i = tgdb_list_next(i);
+                /* They were all added already if they came in batches */
+                if (source_files_streamed == STREAMED_NONE) {
+                    if_clear_filedlg();
+                    add_source_files(list);
                 }
+                save_source_files();
 
-                if_set_focus(FILE_DLG);
+                if (source_files_streamed != STREAMED_SHOWN)
+                    if_show_filedlg();
+                else if (if_get_focus() == FILE_DLG)
+                    if_draw();
+                source_files_streamed = STREAMED_NONE;
                 kui_input_acceptable = 1;
+
+                /* The files of the breakpoints can be found now */
+                if_prefetch_breaks();
                 break;
             }
 
@@ -1013,6 +1710,8 @@ static void process_commands(struct tgdb *tgdb)
                  * the debugged program but libtgdb is claiming that gdb knows
                  * none. */
             case TGDB_SOURCES_DENIED:
+                source_files_streamed = STREAMED_NONE;
+                if_no_source_files();
                 if_display_message("Error:", 0,
                         " No sources available! Was the program compiled with debug?");
                 kui_input_acceptable = 1;
@@ -1052,13 +1751,47 @@ static void process_commands(struct tgdb *tgdb)
                  */
 
                 /* Clear the cache */
+                if_clear_disassembly();
+                if_clear_watch();
+                if_clear_memory();
+                if_clear_backtrace();
+                if_clear_threads();
                 break;
             }
+            case TGDB_UPDATE_DISASSEMBLY:
+                if_disassembly(item->choice.update_disassembly.disassembly);
+                break;
+            case TGDB_UPDATE_VARIABLES:
+                if_watch_variables(item->choice.update_variables.variables);
+                break;
+            case TGDB_UPDATE_MEMORY:
+                if_memory(item->choice.update_memory.memory);
+                break;
+            case TGDB_UPDATE_FRAMES:
+                if (tab_frames(tabs[tab_current],
+                                item->choice.update_frames.frames))
+                    break;
+                if_backtrace(item->choice.update_frames.frames);
+                if_prefetch_frames(item->choice.update_frames.frames);
+                break;
+            case TGDB_UPDATE_THREADS:
+                if_thread_changes(item->choice.update_threads.changes);
+                break;
+            case TGDB_UPDATE_SAMPLE:
+                profile_sample(item->choice.update_sample.frames);
+                break;
+            case TGDB_UPDATE_LOG:
+                if_log(item->choice.update_log.text);
+                break;
+            case TGDB_CORE_FILE:
+                tabs[tab_current]->core = item->choice.core_file.core;
+                if_core_file(item->choice.core_file.core);
+                break;
             case TGDB_UPDATE_COMPLETIONS:
             {
                 struct tgdb_list *list =
                         item->choice.update_completions.completion_list;
-                do_tab_completion(list);
+                do_tab_completion(completion_cache_store(list));
                 break;
             }
             case TGDB_UPDATE_CONSOLE_PROMPT_VALUE:
@@ -1069,14 +1802,27 @@ static void process_commands(struct tgdb *tgdb)
                 break;
             }
             case TGDB_QUIT:
-                cleanup();
-                exit(0);
+                /* The other tabs go on without it */
+                if (tab_count == 1) {
+                    cleanup();
+                    exit(0);
+                }
+                quit = 1;
                 break;
                 /* Default */
             default:
                 break;
         }
     }
+
+    /* The requests submitted with a callback get their responses now */
+    if (quit)
+        tab_close(tabs[tab_current]);
+    else
+        tgdb_dispatch_responses(tgdb);
+
+    tracer_end("process_commands", span);
+    processing = 0;
 }
 
 /**
@@ -1109,10 +1855,17 @@ does_request_require_console_update(struct tgdb_request *request, int *update)
         case TGDB_REQUEST_INFO_SOURCES:
         case TGDB_REQUEST_FILENAME_PAIR:
         case TGDB_REQUEST_CURRENT_LOCATION:
+        case TGDB_REQUEST_DISASSEMBLE:
+        case TGDB_REQUEST_VARIABLE:
+        case TGDB_REQUEST_READ_MEMORY:
+        case TGDB_REQUEST_FRAMES:
+        case TGDB_REQUEST_SELECT_FRAME:
+        case TGDB_REQUEST_SELECT_THREAD:
             *update = 0;
             break;
         case TGDB_REQUEST_DEBUGGER_COMMAND:
         case TGDB_REQUEST_MODIFY_BREAKPOINT:
+        case TGDB_REQUEST_ADD_BREAKPOINTS:
         case TGDB_REQUEST_COMPLETE:
             *update = 1;
             break;
@@ -1123,23 +1876,65 @@ does_request_require_console_update(struct tgdb_request *request, int *update)
     return 0;
 }
 
-/* gdb_input: Recieves data from tgdb:
+/* run_headless: Runs gdb for a cgdb on another machine, that was started
+ * ------------  with --remote. It talks to it on stdin and stdout.
+ *
+ *  Returns:  -1 on error, 0 on success
+ */
+static int run_headless(int argc, char *argv[])
+{
+    int fd, ret;
+
+    tgdb = tgdb_initialize(debugger_path, argc, argv, &fd, use_gdbmi);
+    if (tgdb == NULL)
+        return -1;
+
+    ret = tgdb_serve(tgdb, fd, STDIN_FILENO, STDOUT_FILENO);
+    tgdb_shutdown(tgdb);
+
+    return ret;
+}
+
+/* capture_done: Shows the output of a command run with :capture.
+ * -------------
+ */
+static void capture_done(void)
+{
+    char text[MAXLINE];
+
+    capture_end(capture_last);
+    capture_request = NULL;
+
+    snprintf(text, sizeof (text),
+            "%d lines captured, :capture shows them again\n",
+            capture_lines(capture_last));
+    if_print(text);
+
+    if_set_capture(capture_last);
+    if_show_capture();
+}
+
+/* gdb_input: Recieves data from tgdb:
  *
  *  Returns:  -1 on error, 0 on success
  */
 static int gdb_input()
 {
-    char *buf = malloc(GDB_MAXBUF + 1);
+    static char buf[GDB_MAXBUF + 1];
+    static struct stats_histogram stats_process =
+            STATS_HISTOGRAM("tgdb_process");
+    unsigned long long start = stats_start();
+    struct tgdb *shown = tgdb;
     int size;
     int is_finished;
+    int capturing;
 
-    /* Read from GDB */
+    /* Read from GDB, everything that's ready at once */
     size = tgdb_process(tgdb, buf, GDB_MAXBUF, &is_finished);
+    stats_stop(&stats_process, start);
     if (size == -1) {
         logger_write_pos(logger, __FILE__, __LINE__,
                 "tgdb_recv_debugger_data error");
-        free(buf);
-        buf = NULL;
         return -1;
     }
 
@@ -1147,16 +1942,25 @@ static int gdb_input()
 
     process_commands(tgdb);
 
+    /* gdb quit, another tab is shown */
+    if (tgdb != shown)
+        return 0;
+
+    /* The output of a command run with :capture goes to its capture */
+    capturing = capture_request && last_request == capture_request;
+
     /* Display GDB output 
      * The strlen check is here so that if_print does not get called
      * when displaying the filedlg. If it does get called, then the 
      * gdb window gets displayed when the filedlg is up
      */
-    if (strlen(buf) > 0)
+    if (capturing)
+        capture_add(capture_last, buf, size);
+    else if (strlen(buf) > 0)
         if_print(buf);
 
-    free(buf);
-    buf = NULL;
+    if (is_finished && capturing)
+        capture_done();
 
     /* Check to see if GDB is ready to recieve another command. If it is, then
      * readline should redisplay what it currently contains. There are 2 special
@@ -1181,19 +1985,29 @@ static int gdb_input()
         tgdb_queue_size(tgdb, &size);
         /* This is the second case, this command was queued. */
         if (size > 0) {
-            struct tgdb_request *request = tgdb_queue_pop(tgdb);
-            char *prompt;
+            int is_busy = 0;
 
-            rline_get_prompt(rline, &prompt);
-            if_print(prompt);
+            /* A request tgdb answers without asking gdb leaves it ready
+             * for the next one, gdb won't say anything to get to it */
+            while (size > 0 && !is_busy) {
+                struct tgdb_request *request = tgdb_queue_pop(tgdb);
+                char *prompt;
 
-            if (request->header == TGDB_REQUEST_CONSOLE_COMMAND) {
-                if_print(request->choice.console_command.command);
-                if_print("\n");
-            }
+                rline_get_prompt(rline, &prompt);
+                if_print(prompt);
 
-            last_request = request;
-            tgdb_process_command(tgdb, request);
+                if (request->header == TGDB_REQUEST_CONSOLE_COMMAND) {
+                    if_print(request->choice.console_command.command);
+                    if_print("\n");
+                }
+
+                last_request = request;
+                tgdb_process_command(tgdb, request);
+                process_commands(tgdb);
+
+                tgdb_is_busy(tgdb, &is_busy);
+                tgdb_queue_size(tgdb, &size);
+            }
             /* This is the first case */
         }
       /** If the user is currently completing, do not update the prompt */
@@ -1255,58 +2069,72 @@ static int readline_input()
 }
 
 /* child_input: Recieves data from the child application:
+ *
+ *  The output of a tab that isn't shown goes to its GDB window.
  *
  *  Returns: -1 on error, 0 on EOF or number of bytes handled from child.
+ *           errno is EAGAIN when there was nothing to read.
  */
-static ssize_t child_input()
+static ssize_t child_input(struct tab *tab)
 {
-    char *buf = malloc(GDB_MAXBUF + 1);
+    static char buf[GDB_MAXBUF + 1];
     ssize_t size;
 
-    /* Read from GDB */
-    size = tgdb_recv_inferior_data(tgdb, buf, GDB_MAXBUF);
+    /* Read from the child, everything that's ready at once */
+    size = tgdb_recv_inferior_data(tab->tgdb, buf, GDB_MAXBUF);
     if (size == -1) {
-        logger_write_pos(logger, __FILE__, __LINE__,
-                "tgdb_recv_inferior_data error ");
-        free(buf);
-        buf = NULL;
+        if (errno != EAGAIN)
+            logger_write_pos(logger, __FILE__, __LINE__,
+                    "tgdb_recv_inferior_data error ");
         return -1;
     }
-    buf[size] = 0;
 
-    /* Display CHILD output */
-    if_tty_print(buf);
-    free(buf);
-    buf = NULL;
+    /* Display CHILD output, all of it even if it has NUL bytes */
+    if (tab != tabs[tab_current])
+        scr_add_length(tab->console, buf, size);
+    else
+        if_tty_print(buf, size);
     return size;
 }
 
-static int cgdb_resize_term(int fd)
+/* How long the terminal size has to stay the same before it's applied.
+ * Dragging the edge of a terminal sends a resize for every step. */
+#define RESIZE_QUIET_MS 50
+
+static int resize_timer = -1;   /* Applies the last resize, -1 if none */
+
+/* The terminal stopped changing size, lay the windows out for it */
+static void resize_due(void *context)
 {
-    int c, result;
+    resize_timer = -1;
 
-    if (read(fd, &c, sizeof (int)) < sizeof (int)) {
-        logger_write_pos(logger, __FILE__, __LINE__, "read from resize pipe");
-        return -1;
-    }
+    if (if_resize_term() == -1)
+        logger_write_pos(logger, __FILE__, __LINE__, "if_resize_term error");
+}
 
-    /* If there is more input in the pipe, that means another resize has
-     * been recieved, and we still have not handled this one. So, skip this
-     * one and only handle the next one.
-     */
-    result = io_data_ready(fd, 0);
-    if (result == -1) {
-        logger_write_pos(logger, __FILE__, __LINE__, "io_data_ready");
-        return -1;
-    }
+static int cgdb_resize_term(int fd)
+{
+    int signos[32], result;
 
-    if (result)
-        return 0;
+    /* Every resize that came in is read, only the size the terminal has
+     * now matters. */
+    do {
+        if (read(fd, signos, sizeof (signos)) < (ssize_t) sizeof (int)) {
+            logger_write_pos(logger, __FILE__, __LINE__,
+                    "read from resize pipe");
+            return -1;
+        }
 
-    if (if_resize_term() == -1) {
-        logger_write_pos(logger, __FILE__, __LINE__, "if_resize_term error");
-        return -1;
-    }
+        result = io_data_ready(fd, 0);
+        if (result == -1) {
+            logger_write_pos(logger, __FILE__, __LINE__, "io_data_ready");
+            return -1;
+        }
+    } while (result);
+
+    /* Wait for it to stop changing, starting over for each resize */
+    event_loop_remove_timer(resize_timer);
+    resize_timer = event_loop_add_timer(RESIZE_QUIET_MS, resize_due, NULL);
 
     return 0;
 }
@@ -1337,16 +2165,716 @@ static int cgdb_handle_signal_in_main_loop(int fd)
         rl_sigint_recved();
     }
 
-    tgdb_signal_notification(tgdb, signo);
+    /* Any of the gdbs may have exited, the rest is for the one shown */
+    if (signo == SIGCHLD) {
+        int i;
+
+        for (i = 0; i < tab_count; i++)
+            tgdb_signal_notification(tabs[i]->tgdb, signo);
+    } else
+        tgdb_signal_notification(tgdb, signo);
+
+    return 0;
+}
+
+/* The order the main loop handles descriptors that are ready at once in */
+enum main_loop_priority {
+    PRIORITY_HIGHLIGHT,
+    PRIORITY_WATCH,
+    PRIORITY_GREP,
+    PRIORITY_LOADER,
+    PRIORITY_SIGNAL,
+    PRIORITY_RESIZE,
+    PRIORITY_SLAVE,
+    PRIORITY_MASTER,
+    PRIORITY_STDIN,
+    PRIORITY_TTY,
+    PRIORITY_GDB
+};
+
+static int frame_timer = -1;    /* Draws what was printed, -1 if none */
+
+/* The highlighting worker finished a file */
+static int highlight_ready(int fd, void *context)
+{
+    if_highlighted();
+    return 0;
+}
+
+/* A source file changed on disk */
+static int watch_ready(int fd, void *context)
+{
+    if_files_changed();
+    return 0;
+}
+
+/* A project search found more matches */
+static int grep_ready(int fd, void *context)
+{
+    if_grep_results();
+    return 0;
+}
+
+/* A source file was read in the background */
+static int loader_ready(int fd, void *context)
+{
+    if_loaded();
+    return 0;
+}
+
+/* A signal occured (besides SIGWINCH) */
+static int signal_ready(int fd, void *context)
+{
+    return cgdb_handle_signal_in_main_loop(fd);
+}
+
+/* A resize signal occured */
+static int resize_ready(int fd, void *context)
+{
+    return cgdb_resize_term(fd);
+}
+
+/* Input received through the pty:  Handle it 
+ * Wrote to masterfd, now slavefd is ready, tell readline */
+static int slave_ready(int fd, void *context)
+{
+    rline_rl_callback_read_char(rline);
+    return 0;
+}
+
+/* Input received through the pty:  Handle it
+ * Readline read from slavefd, and it wrote to the masterfd. 
+ */
+static int master_ready(int fd, void *context)
+{
+    return readline_input();
+}
+
+/* Input received:  Handle it, on top of what's been printed */
+static int stdin_ready(int fd, void *context)
+{
+    int val;
+
+    if_frame_flush();
+    val = user_input_loop();
+    flush_keys();
+    keys_wait(1);
+
+    /* The below condition happens on cygwin when user types ctrl-z
+     * select returns (when it shouldn't) with the value of 1. the
+     * user input loop gets called, the kui gets called and does a
+     * non blocking read which returns EAGAIN. The kui then passes
+     * the -1 up the stack with out making any more system calls. */
+    if (val == -1 && errno == EAGAIN)
+        return 1;
+    else if (val == -1)
+        return -1;
+
+    return 0;
+}
+
+/* tab_show: Shows a tab, in place of the one shown.
+ * ---------
+ *
+ * The windows that only show what gdb was asked are emptied, they fill in
+ * again from the tab's gdb. The profiler is stopped, it samples the program
+ * of the tab it was started in.
+ *
+ *   index:  The tab's index in tabs
+ */
+static void tab_show(int index)
+{
+    struct tab *old = tabs[tab_current], *new = tabs[index];
+    struct scroller *console;
+    char *prompt;
+
+    if ((console = if_swap_gdb_window(new->console)) == NULL)
+        return;
+    old->console = console;
+    new->console = NULL;
+
+    old->breaks = if_swap_breakpoints(new->breaks);
+    new->breaks = NULL;
+
+    profile_stop();
+    last_request = NULL;
+
+    /* The rest of the output is printed in the old tab's GDB window */
+    capture_request = NULL;
+
+    /* What the backtrace window asked the old gdb is answered to its tab */
+    old->frames_stale += if_backtrace_abandon();
+
+    /* Nothing is waiting on the old gdb anymore, and its files are
+     * not the new one's */
+    source_files_streamed = STREAMED_NONE;
+    kui_input_acceptable = 1;
+    if_clear_filedlg();
+
+    rline_get_prompt(rline, &prompt);
+    free(old->prompt);
+    old->prompt = prompt ? cgdb_strdup(prompt) : NULL;
+    change_prompt(new->prompt ? new->prompt : "(gdb) ");
+
+    tab_current = index;
+    tgdb = new->tgdb;
+    gdb_fd = new->gdb_fd;
+
+    if_clear_disassembly();
+    if_clear_watch();
+    if_clear_memory();
+    if_clear_backtrace();
+    if_clear_threads();
+
+    if (new->position.absolute_path)
+        show_position(&new->position);
+
+    /* The stacks of its core dump are listed again */
+    if_core_file(new->core);
+
+    if_display_message("Tab", 0, " %d: %s", index + 1, new->label);
+    rline_rl_forced_update_display(rline);
+}
+
+/* tab_close: Shuts down a tab's gdb, and forgets the tab.
+ * ----------
+ *
+ * Another tab is shown if it was the one shown. There's always one left,
+ * cgdb exits when the last gdb does.
+ */
+static void tab_close(struct tab *tab)
+{
+    int i;
+
+    for (i = 0; tabs[i] != tab; i++)
+        ;
+
+    if (i == tab_current)
+        tab_show(i == 0 ? 1 : i - 1);
+
+    memmove(tabs + i, tabs + i + 1, sizeof (struct tab *) * (tab_count - i - 1));
+    tab_count--;
+    if (tab_current > i)
+        tab_current--;
+
+    event_loop_remove(tab->gdb_fd);
+    event_loop_remove(tab->tty_added);
+    tgdb_shutdown(tab->tgdb);
+
+    if (tab->stack_asked)
+        stacks_add(tab->stack_slot, tab->stack_slot + 1, NULL);
+
+    scr_free(tab->console);
+    brkwin_swap_free(tab->breaks);
+    free(tab->position.function);
+    free(tab->prompt);
+    free(tab->label);
+    free(tab->sources);
+    free(tab);
+}
+
+/* tab_frames: Takes gdb's answer to a request for frames, if it's the stack
+ * -----------  :tab stacks asked for, or an answer nothing waits for.
+ *
+ * Return Value: 1 if it was taken, 0 if it's the backtrace window's.
+ */
+static int tab_frames(struct tab *tab, const struct tgdb_frames *frames)
+{
+    if (tab->stack_asked && tab->stack_before == 0) {
+        tab->stack_asked = 0;
+        stacks_add(tab->stack_slot, tab->stack_slot + 1, frames);
+        return 1;
+    }
+
+    if (tab->stack_asked)
+        tab->stack_before--;
+
+    if (tab->frames_stale > 0) {
+        tab->frames_stale--;
+        return 1;
+    }
+
+    return 0;
+}
+
+/* tab_responses: Handles what a tab's gdb said, while it isn't shown.
+ * --------------
+ *
+ * Its breakpoints, where it stopped and its prompt are kept, for when it's
+ * shown, and what it logged goes to its GDB window. Everything else is
+ * about what it was asked, the windows ask again when it's shown.
+ *
+ * Return Value: 1 if its gdb quit, 0 otherwise.
+ */
+static int tab_responses(struct tab *tab)
+{
+    struct tgdb_response *item;
+    struct brkwin_breaks *shown;
+    const struct tgdb_breakpoint_changes *changes;
+    int i;
+
+    while ((item = tgdb_get_response(tab->tgdb)) != NULL) {
+        switch (item->header) {
+            case TGDB_UPDATE_BREAKPOINTS:
+                shown = brkwin_swap(tab->breaks);
+                brkwin_set(item->choice.update_breakpoints.breakpoint_list);
+                tab->breaks = brkwin_swap(shown);
+                break;
+            case TGDB_UPDATE_BREAKPOINT_CHANGES:
+                changes = item->choice.update_breakpoint_changes.changes;
+                shown = brkwin_swap(tab->breaks);
+                for (i = 0; i < changes->count; i++)
+                    brkwin_change(&changes->changes[i]);
+                tab->breaks = brkwin_swap(shown);
+                break;
+            case TGDB_UPDATE_FILE_POSITION:
+                tab_set_position(tab,
+                        item->choice.update_file_position.file_position);
+                break;
+            case TGDB_UPDATE_CONSOLE_PROMPT_VALUE:
+                free(tab->prompt);
+                tab->prompt = cgdb_strdup(item->choice.
+                        update_console_prompt_value.prompt_value);
+                break;
+            case TGDB_UPDATE_LOG:
+                /* The log window is the shown tab's */
+                scr_add(tab->console, item->choice.update_log.text);
+                break;
+            case TGDB_CORE_FILE:
+                tab->core = item->choice.core_file.core;
+                break;
+            case TGDB_UPDATE_FRAMES:
+                tab_frames(tab, item->choice.update_frames.frames);
+                break;
+            case TGDB_QUIT:
+                return 1;
+            default:
+                break;
+        }
+    }
+
+    return 0;
+}
+
+/* tab_input: Recieves data from the gdb of a tab that isn't shown.
+ * ----------
+ *
+ * The commands typed ahead before it was put aside are still sent.
+ *
+ *  Returns:  -1 on error, 0 on success
+ */
+static int tab_input(struct tab *tab)
+{
+    static char buf[GDB_MAXBUF + 1];
+    struct tgdb_request *request;
+    int size, is_finished, is_busy = 0;
+
+    size = tgdb_process(tab->tgdb, buf, GDB_MAXBUF, &is_finished);
+    if (size == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_recv_debugger_data error");
+        return -1;
+    }
+
+    scr_add_length(tab->console, buf, size);
+
+    if (tab_responses(tab)) {
+        tab_close(tab);
+        return 0;
+    }
+
+    if (!is_finished)
+        return 0;
+
+    tgdb_queue_size(tab->tgdb, &size);
+    while (size > 0 && !is_busy) {
+        request = tgdb_queue_pop(tab->tgdb);
+
+        scr_add(tab->console, tab->prompt ? tab->prompt : "(gdb) ");
+        if (request->header == TGDB_REQUEST_CONSOLE_COMMAND) {
+            scr_add(tab->console, request->choice.console_command.command);
+            scr_add(tab->console, "\n");
+        }
+
+        tgdb_process_command(tab->tgdb, request);
+        if (tab_responses(tab)) {
+            tab_close(tab);
+            return 0;
+        }
+
+        tgdb_is_busy(tab->tgdb, &is_busy);
+        tgdb_queue_size(tab->tgdb, &size);
+    }
+
+    return 0;
+}
+
+/**
+ * Handle the debugged programs standard output.
+ * (Otherwise known as the inferior)
+ * child's ouptut -> stdout
+ * 
+ * Returning 1 is important. It allows all of the child
+ * output to get written to stdout before tgdb's next command.
+ * This is because sometimes they are both ready.
+ *
+ * In the case that the tty_fd has been closed, do not return 1
+ * or an infinite loop will occur (as the event loop is always
+ * activated on EOF). Instead fall through and let the remaining
+ * file descriptors get handled.
+ */
+static int tty_ready(int fd, void *context)
+{
+    struct tab *tab = (struct tab *) context;
+    ssize_t result = child_input(tab);
+
+    /* Woken up for nothing, the output was read already */
+    if (result == -1 && errno == EAGAIN)
+        return 0;
+    else if (result == -1)
+        return -1;
+
+    /* A flood doesn't keep gdb's output waiting */
+    if (result > 0)
+        return if_flooded() ? 0 : 1;
+
+    if (tgdb_tty_new(tab->tgdb) == -1)
+        return -1;
+
+    /* The new descriptor may have the same number as the old one, so
+     * the main loop adds it again either way */
+    event_loop_remove(fd);
+    tab->tty_added = -1;
 
     return 0;
 }
 
+/* gdb's output -> stdout */
+static int gdb_ready(int fd, void *context)
+{
+    struct tab *tab = (struct tab *) context;
+
+    if (tab != tabs[tab_current])
+        return tab_input(tab);
+
+    if (gdb_input() == -1)
+        return -1;
+
+    /* When the file dialog is opened, the user input is blocked, 
+     * until GDB returns all the files that should be displayed,
+     * and the file dialog can open, and be prepared to receive 
+     * input. So, if we are in the file dialog, and are no longer
+     * waiting for the gdb command, then read the input.
+     */
+    if (kui_manager_cangetkey(kui_ctx)) {
+        user_input_loop();
+        flush_keys();
+        keys_wait(0);
+    }
+
+    return 0;
+}
+
+/* Draws the output that came in since the last frame */
+static void frame_due(void *context)
+{
+    frame_timer = -1;
+    if_frame_flush();
+}
+
+/* tab_start: Starts a gdb, in a tab of its own.
+ * ----------
+ *
+ *   argc, argv:  gdb's arguments
+ *   label:       What the tab is listed as
+ *   show:        1 to show the tab, 0 to leave it in the background
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+static int tab_start(int argc, char **argv, const char *label, int show)
+{
+    struct tgdb *debugger;
+    struct tab *tab;
+    int fd;
+
+    /* The remote cgdb only runs the one gdb */
+    if (remote_command || tab_count == TABS_MAX)
+        return -1;
+
+    debugger = tgdb_initialize(debugger_path, argc, argv, &fd, use_gdbmi);
+    if (debugger == NULL)
+        return -1;
+
+    tab = tab_add(debugger, fd, label, srclist_ident(argc, argv));
+    if (event_loop_add(fd, PRIORITY_GDB, gdb_ready, tab) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__, "event_loop_add error");
+        tab_close(tab);
+        return -1;
+    }
+
+    if (show) {
+        tab_show(tab_count - 1);
+        handle_request(tgdb, tgdb_request_current_location(tgdb, 1));
+    } else
+        tab_request(tab, tgdb_request_current_location(tab->tgdb, 1));
+
+    return 0;
+}
+
+/* tab_request: Sends a request to the gdb of a tab, shown or not.
+ * ------------
+ *
+ * A console command is printed in the tab's GDB window, after the prompt,
+ * as if it was typed there.
+ *
+ * Return Value: 0 on success, -1 on error or if the tab's gdb quit, the
+ *               tab is gone then.
+ */
+static int tab_request(struct tab *tab, struct tgdb_request *request)
+{
+    int is_busy;
+
+    if (!request)
+        return -1;
+
+    if (tab == tabs[tab_current]) {
+        tgdb_is_busy(tgdb, &is_busy);
+        if (!is_busy && request->header == TGDB_REQUEST_CONSOLE_COMMAND) {
+            char *prompt;
+
+            rline_get_prompt(rline, &prompt);
+            if_print(prompt ? prompt : "(gdb) ");
+            if_print(request->choice.console_command.command);
+            if_print("\n");
+        }
+
+        return handle_request(tgdb, request);
+    }
+
+    if (tgdb_is_busy(tab->tgdb, &is_busy) == -1)
+        return -1;
+
+    /* tab_input sends it once gdb is ready */
+    if (is_busy)
+        return tgdb_queue_append(tab->tgdb, request);
+
+    if (request->header == TGDB_REQUEST_CONSOLE_COMMAND) {
+        scr_add(tab->console, tab->prompt ? tab->prompt : "(gdb) ");
+        scr_add(tab->console, request->choice.console_command.command);
+        scr_add(tab->console, "\n");
+    }
+
+    tgdb_process_command(tab->tgdb, request);
+    if (tab_responses(tab)) {
+        tab_close(tab);
+        return -1;
+    }
+
+    return 0;
+}
+
+int tab_new(const char *args)
+{
+    char *copy, *arg, **argv;
+    int argc = 0, result;
+
+    while (isspace((unsigned char) *args))
+        args++;
+
+    copy = cgdb_strdup(args);
+    argv = cgdb_malloc(sizeof (char *) * (strlen(copy) / 2 + 2));
+    for (arg = strtok(copy, " \t"); arg; arg = strtok(NULL, " \t"))
+        argv[argc++] = arg;
+    argv[argc] = NULL;
+
+    result = tab_start(argc, argv, args, 1);
+
+    free(argv);
+    free(copy);
+
+    return result;
+}
+
+int tab_attach(const char *pids)
+{
+    char *copy, *pid, *end, link[64], path[FSUTIL_PATH_MAX];
+    char label[MAXLINE], *argv[4];
+    int argc, started = 0, failed = 0, first = tab_count;
+
+    copy = cgdb_strdup(pids);
+    for (pid = strtok(copy, " \t"); pid; pid = strtok(NULL, " \t")) {
+        if (strtol(pid, &end, 10) <= 0 || *end != '\0') {
+            failed++;
+            continue;
+        }
+
+        /* gdb is given the program as well, so the tabs of the ranks of
+         * a job share its list of source files */
+        argc = 0;
+        snprintf(link, sizeof (link), "/proc/%s/exe", pid);
+        if (realpath(link, path))
+            argv[argc++] = path;
+        argv[argc++] = "-p";
+        argv[argc++] = pid;
+        argv[argc] = NULL;
+
+        snprintf(label, sizeof (label), "-p %s", pid);
+        if (tab_start(argc, argv, label, 0) == -1)
+            failed++;
+        else
+            started++;
+    }
+    free(copy);
+
+    if (started)
+        tab_show(first);
+
+    return failed || !started ? -1 : 0;
+}
+
+int tab_remote(const char *targets)
+{
+    char *copy, *target, command[MAXLINE], *argv[3];
+    int started = 0, failed = 0, first = tab_count;
+
+    copy = cgdb_strdup(targets);
+    for (target = strtok(copy, " \t"); target;
+            target = strtok(NULL, " \t")) {
+        snprintf(command, sizeof (command), "target remote %s", target);
+        argv[0] = "-ex";
+        argv[1] = command;
+        argv[2] = NULL;
+
+        if (tab_start(2, argv, target, 0) == -1)
+            failed++;
+        else
+            started++;
+    }
+    free(copy);
+
+    if (started)
+        tab_show(first);
+
+    return failed || !started ? -1 : 0;
+}
+
+int tab_all(const char *command)
+{
+    struct tab *all[TABS_MAX];
+    int count = tab_count, failed = 0, i;
+
+    while (isspace((unsigned char) *command))
+        command++;
+
+    /* A tab whose gdb quits on the command is gone from tabs */
+    memcpy(all, tabs, sizeof (struct tab *) * count);
+
+    for (i = 0; i < count; i++) {
+        if (all[i] == tabs[tab_current])
+            completion_cache_clear();
+
+        if (tab_request(all[i], tgdb_request_run_console_command(all[i]->tgdb,
+                                command)) == -1)
+            failed++;
+    }
+
+    return failed ? -1 : 0;
+}
+
+int tab_stacks(void)
+{
+    struct tab *all[TABS_MAX];
+    struct tgdb_request *request;
+    struct tab *tab;
+    int count = tab_count, i;
+
+    if (stacks_start(count) == -1)
+        return -1;
+
+    memcpy(all, tabs, sizeof (struct tab *) * count);
+
+    for (i = 0; i < count; i++) {
+        tab = all[i];
+
+        request = tgdb_request_frames(tab->tgdb, 0, 0, TABS_STACK_DEPTH - 1);
+        if (!request) {
+            stacks_add(i, i + 1, NULL);
+            continue;
+        }
+
+        /* Its answer comes after the ones gdb still owes */
+        tab->stack_asked = 1;
+        tab->stack_slot = i;
+        tab->stack_before = tab->frames_stale;
+        if (tab == tabs[tab_current])
+            tab->stack_before += if_backtrace_unanswered();
+
+        /* A tab whose gdb quit answered when it was closed */
+        tab_request(tab, request);
+    }
+
+    return 0;
+}
+
+int tab_select(int number)
+{
+    if (number < 1 || number > tab_count)
+        return -1;
+
+    /* Something is still waiting on the gdb shown */
+    if (!kui_input_acceptable || is_tab_completing || completion_ptr)
+        return -1;
+
+    if (number - 1 != tab_current)
+        tab_show(number - 1);
+
+    return 0;
+}
+
+void tab_print(void)
+{
+    char text[MAXLINE];
+    int i;
+
+    if_print("\n");
+    for (i = 0; i < tab_count; i++) {
+        snprintf(text, sizeof (text), "%c %-3d %s\n",
+                i == tab_current ? '*' : ' ', i + 1, tabs[i]->label);
+        if_print(text);
+    }
+}
+
+int capture_run(const char *command)
+{
+    struct tgdb_request *request;
+
+    while (isspace((unsigned char) *command))
+        command++;
+
+    if (!*command)
+        return capture_last && !capture_request ? if_show_capture() : -1;
+
+    request = tgdb_request_run_console_command(tgdb, command);
+    if (!request)
+        return -1;
+
+    /* A capture that's still coming is printed in the GDB window instead */
+    if_set_capture(NULL);
+    capture_free(capture_last);
+    capture_last = capture_new(command);
+    capture_request = request;
+
+    completion_cache_clear();
+
+    return tab_request(tabs[tab_current], request);
+}
+
 static int main_loop(void)
 {
-    fd_set rset;
-    int max;
-    int masterfd, slavefd;
+    int ret, wait, i;
+    int masterfd, slavefd, tty_fd;
+    int readline_added = 0;
+    struct tab *tab;
 
     masterfd = pty_pair_get_masterfd(pty_pair);
     if (masterfd == -1) {
@@ -1362,6 +2890,34 @@ static int main_loop(void)
         return -1;
     }
 
+    if (event_loop_init() == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "event_loop_init error");
+        return -1;
+    }
+
+    /* The source files are highlighted in the background, the kernel
+     * reports when they change, and project searches read them in the
+     * background. Each of these is -1 when it's not available, which
+     * event_loop_add ignores. */
+    event_loop_add(if_highlight_fd(), PRIORITY_HIGHLIGHT,
+            highlight_ready, NULL);
+    event_loop_add(fs_watch_fd(), PRIORITY_WATCH, watch_ready, NULL);
+    event_loop_add(if_grep_fd(), PRIORITY_GREP, grep_ready, NULL);
+    event_loop_add(if_loader_fd(), PRIORITY_LOADER, loader_ready, NULL);
+
+    if (event_loop_add(signal_pipe[0], PRIORITY_SIGNAL,
+                    signal_ready, NULL) == -1 ||
+            event_loop_add(resize_pipe[0], PRIORITY_RESIZE,
+                    resize_ready, NULL) == -1 ||
+            event_loop_add(STDIN_FILENO, PRIORITY_STDIN,
+                    stdin_ready, NULL) == -1 ||
+            event_loop_add(gdb_fd, PRIORITY_GDB, gdb_ready,
+                    tabs[tab_current]) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "event_loop_add error");
+        return -1;
+    }
 
     /* Main (infinite) loop:
      *   Sits and waits for input on either stdin (user input) or the
@@ -1376,124 +2932,54 @@ static int main_loop(void)
          *
          * CGDB reallocates a new one in this situation, for the next run of
          * the inferior to have a place to send it's output.
-         *
-         * This varies the value of tty_fd, and forces us to compute the max
-         * each time in the loop.
          */
-        int tty_fd = tgdb_get_inferior_fd(tgdb);
-
-        max = (gdb_fd > STDIN_FILENO) ? gdb_fd : STDIN_FILENO;
-        max = (max > tty_fd) ? max : tty_fd;
-        max = (max > resize_pipe[0]) ? max : resize_pipe[0];
-        max = (max > signal_pipe[0]) ? max : signal_pipe[0];
-        max = (max > slavefd) ? max : slavefd;
-        max = (max > masterfd) ? max : masterfd;
-
-        /* Reset the fd_set, and watch for input from GDB or stdin */
-        FD_ZERO(&rset);
-        FD_SET(STDIN_FILENO, &rset);
-        FD_SET(gdb_fd, &rset);
-        FD_SET(tty_fd, &rset);
-        FD_SET(resize_pipe[0], &rset);
-        FD_SET(signal_pipe[0], &rset);
-
-        /* No readline activity allowed while displaying tab completion */
-        if (!is_tab_completing) {
-            FD_SET(slavefd, &rset);
-            FD_SET(masterfd, &rset);
+        for (i = 0; i < tab_count; i++) {
+            tab = tabs[i];
+            tty_fd = tgdb_get_inferior_fd(tab->tgdb);
+            if (tty_fd != tab->tty_added) {
+                event_loop_remove(tab->tty_added);
+                tab->tty_added = -1;
+                if (event_loop_add(tty_fd, PRIORITY_TTY, tty_ready, tab) == 0)
+                    tab->tty_added = tty_fd;
+            }
         }
 
-        /* Wait for input */
-        if (select(max + 1, &rset, NULL, NULL, NULL) == -1) {
-            if (errno == EINTR)
-                continue;
-            else {
+        /* No readline activity allowed while displaying tab completion */
+        if (is_tab_completing && readline_added) {
+            event_loop_remove(slavefd);
+            event_loop_remove(masterfd);
+            readline_added = 0;
+        } else if (!is_tab_completing && !readline_added) {
+            if (event_loop_add(slavefd, PRIORITY_SLAVE,
+                            slave_ready, NULL) == -1 ||
+                    event_loop_add(masterfd, PRIORITY_MASTER,
+                            master_ready, NULL) == -1) {
                 logger_write_pos(logger, __FILE__, __LINE__,
-                        "select failed: %s", strerror(errno));
+                        "event_loop_add error");
                 return -1;
             }
+            readline_added = 1;
         }
 
-        /* A signal occured (besides SIGWINCH) */
-        if (FD_ISSET(signal_pipe[0], &rset))
-            if (cgdb_handle_signal_in_main_loop(signal_pipe[0]) == -1)
-                return -1;
+        /* Draw the output that came in, when the next frame is due */
+        if (frame_timer == -1 && (wait = if_frame_wait()) != -1)
+            frame_timer = event_loop_add_timer(wait, frame_due, NULL);
 
-        /* A resize signal occured */
-        if (FD_ISSET(resize_pipe[0], &rset))
-            if (cgdb_resize_term(resize_pipe[0]) == -1)
-                return -1;
-
-        /* Input received through the pty:  Handle it 
-         * Wrote to masterfd, now slavefd is ready, tell readline */
-        if (FD_ISSET(slavefd, &rset))
-            rline_rl_callback_read_char(rline);
-
-        /* Input received through the pty:  Handle it
-         * Readline read from slavefd, and it wrote to the masterfd. 
-         */
-        if (FD_ISSET(masterfd, &rset))
-            if (readline_input() == -1)
-                return -1;
-
-        /* Input received:  Handle it */
-        if (FD_ISSET(STDIN_FILENO, &rset)) {
-            int val = user_input_loop();
-
-            /* The below condition happens on cygwin when user types ctrl-z
-             * select returns (when it shouldn't) with the value of 1. the
-             * user input loop gets called, the kui gets called and does a
-             * non blocking read which returns EAGAIN. The kui then passes
-             * the -1 up the stack with out making any more system calls. */
-            if (val == -1 && errno == EAGAIN)
-                continue;
-            else if (val == -1)
-                return -1;
-        }
+        /* What was drawn since the last time around is sent at once */
+        termout_send();
 
-        /**
-         * Handle the debugged programs standard output.
-         * (Otherwise known as the inferior)
-         * child's ouptut -> stdout
-         * 
-         * The continue is important. It allows all of the child
-         * output to get written to stdout before tgdb's next command.
-         * This is because sometimes they are both ready.
-         *
-         * In the case that the tty_fd has been closed, do not continue
-         * or an infinite loop will occur (as the select loop is always
-         * activated on EOF). Instead fall through and let the remaining
-         * file descriptors get handled.
-         */
-        if (FD_ISSET(tty_fd, &rset)) {
-            ssize_t result = child_input();
-            if (result == -1) {
-                return -1;
-            } else if (result == 0) {
-                if (tgdb_tty_new(tgdb) == -1) {
-                    return -1;
-                }
-            } else {
-                continue;
-            }
+        /* Only check for input while there are source files to load
+         * ahead of time */
+        ret = event_loop_run(if_prefetch_pending() ? 0 : -1);
+        if (ret == -1) {
+            logger_write_pos(logger, __FILE__, __LINE__,
+                    "event_loop_run failed: %s", strerror(errno));
+            return -1;
         }
 
-        /* gdb's output -> stdout */
-        if (FD_ISSET(gdb_fd, &rset)) {
-            if (gdb_input() == -1) {
-                return -1;
-            }
-
-            /* When the file dialog is opened, the user input is blocked, 
-             * until GDB returns all the files that should be displayed,
-             * and the file dialog can open, and be prepared to receive 
-             * input. So, if we are in the file dialog, and are no longer
-             * waiting for the gdb command, then read the input.
-             */
-            if (kui_manager_cangetkey(kui_ctx)) {
-                user_input_loop();
-            }
-        }
+        /* Nothing is ready, so there's time to load a file */
+        if (ret == 0 && if_prefetch_pending())
+            if_prefetch_next();
     }
     return 0;
 }
@@ -1507,15 +2993,20 @@ static int main_loop(void)
 void cleanup()
 {
     char *log_file, *tmp_log_file;
-    int has_recv_data;
+    int has_recv_data, i;
 
     ibuf_free(current_line);
 
+    grep_stop();
+
     /* Cleanly scroll the screen up for a prompt */
     scrl(1);
     move(LINES - 1, 0);
     printf("\n");
 
+    /* Only the commands of this session are added to the file */
+    rline_set_history_size(rline,
+            cgdbrc_get(CGDBRC_HISTORYSIZE)->variant.int_val);
     rline_write_history(rline, readline_history_path);
 
     /* The order of these is important. They each must restore the terminal
@@ -1523,6 +3014,9 @@ void cleanup()
      * started, is the reverse order in which they should be shutdown 
      */
 
+    /* The next cgdb on the program can start where this one is */
+    resume_save();
+
     /* Shut down interface */
     if_shutdown();
 
@@ -1539,7 +3033,10 @@ void cleanup()
     log_file = strdup(tmp_log_file);
     logger_has_recv_data(logger, &has_recv_data);
 
-    /* Shut down debugger */
+    /* Shut down debugger, the one shown last, it has the logger */
+    for (i = 0; i < tab_count; i++)
+        if (i != tab_current)
+            tgdb_shutdown(tabs[i]->tgdb);
     tgdb_shutdown(tgdb);
 
     if (tty_set_attributes(STDIN_FILENO, &term_attributes) == -1)
@@ -1598,10 +3095,23 @@ int init_readline(void)
             readline_history_path);
     rline = rline_initialize(slavefd, rlctx_send_user_command, tab_completion,
             "dumb");
-    rline_read_history(rline, readline_history_path);
     return 0;
 }
 
+/* init_readline_history: Reads the history of the commands sent to gdb.
+ * ---------------------  It isn't needed until the user types, so this
+ *                        is left until the screen has been drawn.
+ */
+static void init_readline_history(void)
+{
+    rline_set_history_size(rline,
+            cgdbrc_get(CGDBRC_HISTORYSIZE)->variant.int_val);
+
+    if (rline_read_history(rline, readline_history_path) == -1)
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "rline_read_history error");
+}
+
 int create_and_init_pair()
 {
     struct winsize size;
@@ -1613,6 +3123,12 @@ int create_and_init_pair()
         return -1;
     }
 
+    gdb_keys = io_writer_create();
+    if (!gdb_keys) {
+        logger_write_pos(logger, __FILE__, __LINE__, "io_writer_create error");
+        return -1;
+    }
+
     slavefd = pty_pair_get_slavefd(pty_pair);
     if (slavefd == -1) {
         logger_write_pos(logger, __FILE__, __LINE__,
@@ -1681,6 +3197,9 @@ int init_kui(void)
         exit(-1);
     }
 
+    /* gdb's output is shown while a map is partly typed, see keys_wait */
+    kui_manager_defer_timeouts(kui_ctx, 1);
+
     kui_map = kui_ms_create();
     if (!kui_map) {
         logger_write_pos(logger, __FILE__, __LINE__,
@@ -1744,8 +3263,21 @@ int main(int argc, char *argv[])
     read(0, &c, 1);
 #endif
 
+#if HAVE_LOCALE_H
+    /* Only the character set, so UTF-8 is drawn and measured as it is */
+    setlocale(LC_CTYPE, "");
+#endif
+
     parse_long_options(&argc, &argv);
 
+    /* gdb is kept running by a session server, between runs of cgdb */
+    if (session_path)
+        invoke_debugger_set_session(session_path);
+
+    /* There is no screen, stdin and stdout go to the remote cgdb */
+    if (headless)
+        exit(run_headless(argc, argv) == -1 ? -1 : 0);
+
     current_line = ibuf_init();
 
     cgdbrc_init();
@@ -1756,7 +3288,10 @@ int main(int argc, char *argv[])
         exit(-1);
     }
 
-    /* First create tgdb, because it has the error log */
+    /* First create tgdb, because it has the error log. gdb only has to be
+     * started here, nothing waits for it. It loads the program while the
+     * rest of cgdb is set up and the screen is drawn, and the source window
+     * is filled in when it answers the request for the current location. */
     if (start_gdb(argc, argv) == -1) {
         fprintf(stderr, "%s:%d Unable to invoke debugger: %s\n",
                 __FILE__, __LINE__, debugger_path ? debugger_path : "gdb");
@@ -1773,6 +3308,11 @@ int main(int argc, char *argv[])
         exit(-1);
     }
 
+    /* A remote cgdb's program is on the other machine */
+    if (!remote_command)
+        resume_init(cgdb_home_dir, argc, argv);
+    srclist_init(cgdb_home_dir);
+
     if (init_readline() == -1) {
         logger_write_pos(logger, __FILE__, __LINE__, "Unable to init readline");
         cleanup();
@@ -1829,6 +3369,24 @@ int main(int argc, char *argv[])
         exit(-1);
     }
 
+    /* Source files can still be highlighted without the worker thread */
+    if (highlight_init() == -1)
+        logger_write_pos(logger, __FILE__, __LINE__, "highlight_init error");
+
+    /* A key pressed during a long search stops it */
+    hl_regex_interrupt(STDIN_FILENO);
+
+    /* Without it, source files are stat'ed each time gdb stops */
+    if (fs_watch_init() == -1)
+        logger_write_pos(logger, __FILE__, __LINE__, "fs_watch_init error");
+
+    if (grep_init() == -1)
+        logger_write_pos(logger, __FILE__, __LINE__, "grep_init error");
+
+    /* Without it, a file on a slow filesystem stops cgdb while it's read */
+    if (loader_init() == -1)
+        logger_write_pos(logger, __FILE__, __LINE__, "loader_init error");
+
     {
         char config_file[FSUTIL_PATH_MAX];
         FILE *config;
@@ -1841,6 +3399,14 @@ int main(int argc, char *argv[])
         }
     }
 
+    /* The source window is filled in from the last cgdb on the program, if
+     * there was one, gdb is asked where it is only if there wasn't. gdb
+     * run by a session server still has the breakpoints. */
+    if (resume && resume_load(!session_path) == -1)
+        handle_request(tgdb, tgdb_request_current_location(tgdb, 1));
+
+    init_readline_history();
+
     /* Enter main loop */
     main_loop();
 
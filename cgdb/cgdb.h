@@ -11,7 +11,7 @@
 /* Definitions */
 /* ----------- */
 
-#define GDB_MAXBUF 4096         /* GDB input buffer size */
+#define GDB_MAXBUF 65536        /* Most read from GDB or the inferior at once */
 
 /* Special char to use for vertical line 
  * CYGWIN does not support this character 
@@ -29,6 +29,14 @@
 
 #define MAXLINE 4096
 
+/* How a window is put on the screen. WIN_REFRESH draws it right away.
+ * WIN_NO_REFRESH only copies it to the curses virtual screen, so a single
+ * doupdate can draw it along with the other windows of the frame. */
+enum win_refresh {
+    WIN_NO_REFRESH,
+    WIN_REFRESH
+};
+
 /* TODO: Remove the below 3 lines. This is a reorganization effort to allow 
  * TGDB to understand the new request/response mechanism that TGDB supports.
  */
@@ -43,4 +51,98 @@ void cleanup();
  */
 int run_shell_command(const char *command);
 
+/* request_source_files: Asks gdb for the source files, for the file dialog.
+ * ---------------------
+ *
+ * The files gdb listed the last time, in this cgdb or the one before on the
+ * same program, are shown right away, and brought up to date when gdb
+ * answers. Otherwise the keys wait for the answer.
+ */
+void request_source_files(void);
+
+/* tab_new: Starts another gdb, in a tab of its own, and shows it.
+ * --------
+ *
+ * The tabs share the source window, and the files read and highlighted.
+ *
+ *   args:  gdb's arguments, split at the spaces
+ *
+ * Return Value: 0 on success, -1 if gdb couldn't be started, there are too
+ *               many tabs or cgdb runs gdb remotely.
+ */
+int tab_new(const char *args);
+
+/* tab_select: Shows another tab.
+ * -----------
+ *
+ *   number:  The tab, 1 is the first one
+ *
+ * Return Value: 0 on success, -1 if there's no such tab, or the tab shown
+ *               is still waiting on its gdb.
+ */
+int tab_select(int number);
+
+/* tab_attach: Attaches a gdb to each of some processes, in tabs of their own.
+ * -----------
+ *
+ * It's how the ranks of an MPI job, or the workers of a program, are
+ * debugged in one cgdb. The first of the new tabs is shown.
+ *
+ *   pids:  The process ids, separated by spaces
+ *
+ * Return Value: 0 on success, -1 if a gdb couldn't be started.
+ */
+int tab_attach(const char *pids);
+
+/* tab_remote: Connects a gdb to each of some gdbservers, in tabs of their own.
+ * -----------
+ *
+ * The first of the new tabs is shown.
+ *
+ *   targets:  What "target remote" is given for each, as in host:port,
+ *             separated by spaces
+ *
+ * Return Value: 0 on success, -1 if a gdb couldn't be started.
+ */
+int tab_remote(const char *targets);
+
+/* tab_all: Sends a command to the gdb of every tab at once.
+ * --------
+ *
+ * Each gdb runs it as soon as it's ready, they don't wait for each other.
+ * It's printed in each tab's GDB window.
+ *
+ *   command:  The gdb command
+ *
+ * Return Value: 0 on success, -1 if a gdb couldn't be sent it.
+ */
+int tab_all(const char *command);
+
+/* tab_stacks: Asks the gdb of every tab for its stack, and prints them.
+ * -----------
+ *
+ * The tabs with the same stack are grouped, see stacks.h. They're printed
+ * in the GDB window once every gdb answered.
+ *
+ * Return Value: 0 on success, -1 if the last ones aren't all in yet.
+ */
+int tab_stacks(void);
+
+/* tab_print: Lists the tabs in the GDB window, the one shown is marked.
+ * ----------
+ */
+void tab_print(void);
+
+/* capture_run: Runs a gdb command, its output is shown in the capture
+ * ------------  dialog instead of the GDB window.
+ *
+ * The output is kept until the next command is captured, it can be looked
+ * through and filtered, see capture.h. It's shown once gdb is done.
+ *
+ *   command:  The gdb command, or "" to show the last output again
+ *
+ * Return Value: 0 on success, -1 on error or if there's nothing to show.
+ */
+int capture_run(const char *command);
+
 #endif
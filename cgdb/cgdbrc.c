@@ -14,6 +14,22 @@
 #include <stdlib.h>
 #endif /* HAVE_STDLIB_H */
 
+#if HAVE_CTYPE_H
+#include <ctype.h>
+#endif /* HAVE_CTYPE_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_LIMITS_H
+#include <limits.h>
+#endif /* HAVE_LIMITS_H */
+
+#if HAVE_TIME_H
+#include <time.h>
+#endif /* HAVE_TIME_H */
+
 #include "cgdbrc.h"
 #include "command_lexer.h"
 #include "tgdb.h"
@@ -24,8 +40,19 @@
 #include "sys_util.h"
 #include "std_list.h"
 #include "kui_term.h"
+#include "stats.h"
+#include "tracer.h"
+#include "watch.h"
+#include "memwin.h"
+#include "profile.h"
+#include "rx.h"
+#include "event_loop.h"
+#include "fs_util.h"
+#include "resume.h"
+#include "termout.h"
 
 extern struct tgdb *tgdb;
+extern char cgdb_home_dir[MAXLINE];
 
 /**
  * The general idea is that the configuration will read in the users ~/.cgdbrc
@@ -46,6 +73,8 @@ enum ConfigType {
 
 static int command_set_arrowstyle(const char *value);
 static int command_set_cgdb_mode_key(const char *value);
+static int command_set_condeval(const char *value);
+static int command_set_syncupdate(const char *value);
 static int command_set_winsplit(const char *value);
 static int command_set_timeout(int value);
 static int command_set_timeoutlen(int value);
@@ -54,6 +83,20 @@ static int command_set_ttimeoutlen(int value);
 static int command_set_winminheight(int value);
 static int command_set_syntax_type(const char *value);
 static int command_set_stc(int value);
+static int command_set_disasm(int value);
+static int command_set_watchwin(int value);
+static int command_set_memwin(int value);
+static int command_set_logwin(int value);
+static int command_set_nonstop(int value);
+static int command_set_backtracewin(int value);
+static int command_set_breakwin(int value);
+static int command_set_threadwin(int value);
+static int command_set_srcmem(int value);
+static int command_set_srcsplit(int value);
+static int command_set_hlsearch(int value);
+static int command_set_floodrate(int value);
+static int command_set_regexpengine(int value);
+static int command_set_floodlog(const char *value);
 static int cgdbrc_set_val(struct cgdbrc_config_option config_option);
 
 /**
@@ -65,20 +108,46 @@ static struct cgdbrc_config_option cgdbrc_config_options[CGDBRC_WRAPSCAN + 1] =
     {CGDBRC_ARROWSELECTEDLINE, {0}},
     {CGDBRC_ARROWSTYLE, {ARROWSTYLE_SHORT}},
     {CGDBRC_AUTOSOURCERELOAD, {1}},
+    {CGDBRC_BACKTRACEWIN, {0}},
+    {CGDBRC_BREAKWIN, {0}},
     {CGDBRC_CGDB_MODE_KEY, {CGDB_KEY_ESC}},
+    {CGDBRC_CONDEVAL, {TGDB_CONDITION_AUTO}},
+    {CGDBRC_DISASM, {0}},
+    {CGDBRC_FLOODRATE, {0}},
+    {CGDBRC_FRAMETIME, {16}},
+    {CGDBRC_HISTORYSIZE, {10000}},
+    {CGDBRC_HLCACHE, {0}},
+    {CGDBRC_HLSEARCH, {0}},
     {CGDBRC_IGNORECASE, {0}},
+    {CGDBRC_LOGWIN, {0}},
+    {CGDBRC_MEMWIN, {0}},
+    {CGDBRC_NONSTOP, {0}},
+    {CGDBRC_PARALLELSEARCH, {100000}},
+    {CGDBRC_PREFETCH, {1}},
+    {CGDBRC_PROFILERATE, {100}},
+    {CGDBRC_REGEXPENGINE, {RX_ENGINE_AUTO}},
+    {CGDBRC_SCROLLBACK, {10000}},
+    {CGDBRC_SCROLLSPILL, {0}},
     {CGDBRC_SHOWTGDBCOMMANDS, {0}},
+    {CGDBRC_SRCMEM, {0}},
+    {CGDBRC_SRCSPLIT, {0}},
+    {CGDBRC_SYNCUPDATE, {TERMOUT_SYNC_AUTO}},
     {CGDBRC_SYNTAX, {TOKENIZER_LANGUAGE_UNKNOWN}},
     {CGDBRC_TABSTOP, {8}},
+    {CGDBRC_THREADWIN, {0}},
     {CGDBRC_TIMEOUT, {1}},
     {CGDBRC_TIMEOUT_LEN, {1000}},
     {CGDBRC_TTIMEOUT, {1}},
     {CGDBRC_TTIMEOUT_LEN, {100}},
+    {CGDBRC_WATCHWIN, {0}},
     {CGDBRC_WINMINHEIGHT, {0}},
     {CGDBRC_WINSPLIT, {WIN_SPLIT_EVEN}},
     {CGDBRC_WRAPSCAN, {1}}
 };
 
+/* The options read while drawing, kept up to date by update_snapshot */
+static struct cgdbrc_snapshot snapshot;
+
 static struct std_list *cgdbrc_attach_list;
 static unsigned long cgdbrc_attach_handle = 1;
 struct cgdbrc_attach_item {
@@ -112,17 +181,91 @@ static struct ConfigVariable {
     "autosourcereload", "asr", CONFIG_TYPE_BOOL,
                 &cgdbrc_config_options[CGDBRC_AUTOSOURCERELOAD].variant.
                 int_val},
+            /* backtracewin */
+    {
+    "backtracewin", "btw", CONFIG_TYPE_FUNC_BOOL, &command_set_backtracewin},
+            /* breakwin */
+    {
+    "breakwin", "bpw", CONFIG_TYPE_FUNC_BOOL, &command_set_breakwin},
             /* cgdbmodekey */
     {
     "cgdbmodekey", "cgdbmodekey", CONFIG_TYPE_FUNC_STRING,
                 command_set_cgdb_mode_key},
+            /* condeval */
+    {
+    "condeval", "ce", CONFIG_TYPE_FUNC_STRING, command_set_condeval},
+            /* disasm */
+    {
+    "disasm", "dis", CONFIG_TYPE_FUNC_BOOL, &command_set_disasm},
+            /* floodlog */
+    {
+    "floodlog", "fl", CONFIG_TYPE_FUNC_STRING, command_set_floodlog},
+            /* floodrate */
+    {
+    "floodrate", "fr", CONFIG_TYPE_FUNC_INT, &command_set_floodrate},
+            /* frametime */
+    {
+    "frametime", "ft", CONFIG_TYPE_INT,
+                &cgdbrc_config_options[CGDBRC_FRAMETIME].variant.int_val},
+            /* historysize */
+    {
+    "historysize", "hs", CONFIG_TYPE_INT,
+                &cgdbrc_config_options[CGDBRC_HISTORYSIZE].variant.int_val},
+            /* hlcache */
+    {
+    "hlcache", "hlc", CONFIG_TYPE_BOOL,
+                &cgdbrc_config_options[CGDBRC_HLCACHE].variant.int_val},
+            /* hlsearch */
+    {
+    "hlsearch", "hls", CONFIG_TYPE_FUNC_BOOL, &command_set_hlsearch},
             /* ignorecase */
     {
     "ignorecase", "ic", CONFIG_TYPE_BOOL,
                 &cgdbrc_config_options[CGDBRC_IGNORECASE].variant.int_val},
+            /* logwin */
+    {
+    "logwin", "lw", CONFIG_TYPE_FUNC_BOOL, &command_set_logwin},
+            /* memwin */
+    {
+    "memwin", "mw", CONFIG_TYPE_FUNC_BOOL, &command_set_memwin},
+            /* nonstop */
+    {
+    "nonstop", "ns", CONFIG_TYPE_FUNC_BOOL, &command_set_nonstop},
+            /* parallelsearch */
+    {
+    "parallelsearch", "ps", CONFIG_TYPE_INT,
+                &cgdbrc_config_options[CGDBRC_PARALLELSEARCH].variant.int_val},
+            /* prefetch */
+    {
+    "prefetch", "pf", CONFIG_TYPE_BOOL,
+                &cgdbrc_config_options[CGDBRC_PREFETCH].variant.int_val},
+            /* profilerate */
+    {
+    "profilerate", "pr", CONFIG_TYPE_INT,
+                &cgdbrc_config_options[CGDBRC_PROFILERATE].variant.int_val},
+            /* regexpengine */
+    {
+    "regexpengine", "re", CONFIG_TYPE_FUNC_INT, &command_set_regexpengine},
+            /* scrollback */
+    {
+    "scrollback", "sb", CONFIG_TYPE_INT,
+                &cgdbrc_config_options[CGDBRC_SCROLLBACK].variant.int_val},
+            /* scrollspill */
+    {
+    "scrollspill", "ssp", CONFIG_TYPE_BOOL,
+                &cgdbrc_config_options[CGDBRC_SCROLLSPILL].variant.int_val},
             /* showtgdbcommands */
     {
     "showtgdbcommands", "stc", CONFIG_TYPE_FUNC_BOOL, &command_set_stc},
+            /* srcmem */
+    {
+    "srcmem", "srcmem", CONFIG_TYPE_FUNC_INT, &command_set_srcmem},
+            /* srcsplit */
+    {
+    "srcsplit", "srs", CONFIG_TYPE_FUNC_BOOL, &command_set_srcsplit},
+            /* syncupdate */
+    {
+    "syncupdate", "su", CONFIG_TYPE_FUNC_STRING, command_set_syncupdate},
             /* syntax */
     {
     "syntax", "syn", CONFIG_TYPE_FUNC_STRING, command_set_syntax_type},
@@ -130,6 +273,9 @@ static struct ConfigVariable {
     {
     "tabstop", "ts", CONFIG_TYPE_INT,
                 &cgdbrc_config_options[CGDBRC_TABSTOP].variant.int_val},
+            /* threadwin */
+    {
+    "threadwin", "thw", CONFIG_TYPE_FUNC_BOOL, &command_set_threadwin},
             /* timeout   */
     {
     "timeout", "to", CONFIG_TYPE_FUNC_BOOL, &command_set_timeout},
@@ -142,6 +288,9 @@ static struct ConfigVariable {
             /* ttimeoutlen   */
     {
     "ttimeoutlen", "ttm", CONFIG_TYPE_FUNC_INT, &command_set_ttimeoutlen},
+            /* watchwin */
+    {
+    "watchwin", "ww", CONFIG_TYPE_FUNC_BOOL, &command_set_watchwin},
             /* winminheight */
     {
     "winminheight", "wmh", CONFIG_TYPE_FUNC_INT, &command_set_winminheight},
@@ -160,10 +309,28 @@ static int command_focus_gdb(int param);
 static int command_focus_tty(int param);
 
 static int command_do_bang(int param);
+static int command_do_capture(int param);
 static int command_do_focus(int param);
+static int command_do_grep(int param);
 static int command_do_help(int param);
 static int command_do_quit(int param);
 static int command_do_shell(int param);
+static int command_do_scrollsearch(int param);
+static int command_do_stats(int param);
+static int command_do_tab(int param);
+static int command_do_trace(int param);
+static int command_do_expand(int param);
+static int command_do_memory(int param);
+static int command_do_profile(int param);
+static int command_do_tag(int param);
+static int command_do_backtrace(int param);
+static int command_do_breakpoints(int param);
+static int command_do_condition(int param);
+static int command_do_frame(int param);
+static int command_do_thread(int param);
+static int command_do_threads(int param);
+static int command_do_unwatch(int param);
+static int command_do_watch(int param);
 static int command_source_reload(int param);
 
 static int command_parse_syntax(int param);
@@ -181,10 +348,18 @@ typedef struct COMMANDS {
 } COMMANDS;
 
 COMMANDS commands[] = {
+    /* backtrace    */ {"backtrace", command_do_backtrace, 0},
     /* bang         */ {"bang", command_do_bang, 0},
+    /* breakpoints  */ {"breakpoints", command_do_breakpoints, 0},
+    /* capture      */ {"capture", command_do_capture, 0},
+    /* condition    */ {"condition", command_do_condition, 0},
     /* edit         */ {"edit", command_source_reload, 0},
     /* edit         */ {"e", command_source_reload, 0},
+    /* expand       */ {"expand", command_do_expand, 0},
     /* focus        */ {"focus", command_do_focus, 0},
+    /* frame        */ {"frame", command_do_frame, 0},
+    /* grep         */ {"grep", command_do_grep, 0},
+    /* grep         */ {"gr", command_do_grep, 0},
     /* help         */ {"help", command_do_help, 0},
     /* highlight            */ {"highlight", command_parse_highlight, 0},
     /* highlight            */ {"hi", command_parse_highlight, 0},
@@ -194,13 +369,26 @@ COMMANDS commands[] = {
     /* iunmap       */ {"iu", command_parse_unmap, 0},
     /* insert       */ {"insert", command_focus_gdb, 0},
     /* map          */ {"map", command_parse_map, 0},
+    /* memory       */ {"memory", command_do_memory, 0},
+    /* profile      */ {"profile", command_do_profile, 0},
     /* quit         */ {"quit", command_do_quit, 0},
     /* quit         */ {"q", command_do_quit, 0},
+    /* scrollsearch */ {"scrollsearch", command_do_scrollsearch, 0},
+    /* scrollsearch */ {"ss", command_do_scrollsearch, 0},
     /* shell        */ {"shell", command_do_shell, 0},
     /* shell        */ {"sh", command_do_shell, 0},
+    /* stats        */ {"stats", command_do_stats, 0},
     /* syntax       */ {"syntax", command_parse_syntax, 0},
+    /* tab          */ {"tab", command_do_tab, 0},
+    /* tag          */ {"tag", command_do_tag, 0},
+    /* tag          */ {"ta", command_do_tag, 0},
+    /* thread       */ {"thread", command_do_thread, 0},
+    /* threads      */ {"threads", command_do_threads, 0},
+    /* trace        */ {"trace", command_do_trace, 0},
     /* unmap        */ {"unmap", command_parse_unmap, 0},
     /* unmap        */ {"unm", command_parse_unmap, 0},
+    /* unwatch      */ {"unwatch", command_do_unwatch, 0},
+    /* watch        */ {"watch", command_do_watch, 0},
     /* continue     */ {"continue", command_do_tgdbcommand, TGDB_CONTINUE},
     /* continue     */ {"c", command_do_tgdbcommand, TGDB_CONTINUE},
     /* down             */ {"down", command_do_tgdbcommand, TGDB_DOWN},
@@ -231,9 +419,45 @@ int command_sort_find(const void *_left_cmd, const void *_right_cmd)
 #define COMMANDS_SIZE		(sizeof(COMMANDS))
 #define COMMANDS_COUNT		(sizeof(commands) / sizeof(COMMANDS))
 
+/* update_snapshot: Copies an option that was set into the snapshot. */
+static int update_snapshot(cgdbrc_config_option_ptr option)
+{
+    switch (option->option_kind) {
+        case CGDBRC_ANSI_CODES:
+            snapshot.ansi_codes = option->variant.int_val;
+            break;
+        case CGDBRC_ARROWSELECTEDLINE:
+            snapshot.arrow_selected_line = option->variant.int_val;
+            break;
+        case CGDBRC_ARROWSTYLE:
+            snapshot.arrow_style = option->variant.arrow_style;
+            break;
+        case CGDBRC_TABSTOP:
+            snapshot.tabstop = option->variant.int_val;
+            break;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
 void cgdbrc_init(void)
 {
+    static const enum cgdbrc_option_kind drawn[] = {
+        CGDBRC_ANSI_CODES,
+        CGDBRC_ARROWSELECTEDLINE,
+        CGDBRC_ARROWSTYLE,
+        CGDBRC_TABSTOP
+    };
+    int i;
+
     qsort((void *) commands, COMMANDS_COUNT, COMMANDS_SIZE, command_sort_find);
+
+    for (i = 0; i < sizeof (drawn) / sizeof (drawn[0]); i++) {
+        update_snapshot(&cgdbrc_config_options[drawn[i]]);
+        cgdbrc_attach(drawn[i], &update_snapshot, NULL);
+    }
 }
 
 COMMANDS *get_command(const char *cmd)
@@ -303,6 +527,43 @@ int command_set_cgdb_mode_key(const char *value)
     return cgdbrc_set_val(option);
 }
 
+int command_set_condeval(const char *value)
+{
+    struct cgdbrc_config_option option;
+
+    option.option_kind = CGDBRC_CONDEVAL;
+
+    /* These are gdb's names, gdb is told when a breakpoint is set */
+    if (strcasecmp(value, "auto") == 0)
+        option.variant.int_val = TGDB_CONDITION_AUTO;
+    else if (strcasecmp(value, "host") == 0)
+        option.variant.int_val = TGDB_CONDITION_HOST;
+    else if (strcasecmp(value, "target") == 0)
+        option.variant.int_val = TGDB_CONDITION_TARGET;
+    else
+        return 1;
+
+    return cgdbrc_set_val(option);
+}
+
+int command_set_syncupdate(const char *value)
+{
+    struct cgdbrc_config_option option;
+
+    option.option_kind = CGDBRC_SYNCUPDATE;
+
+    if (strcasecmp(value, "auto") == 0)
+        option.variant.int_val = TERMOUT_SYNC_AUTO;
+    else if (strcasecmp(value, "on") == 0)
+        option.variant.int_val = TERMOUT_SYNC_ON;
+    else if (strcasecmp(value, "off") == 0)
+        option.variant.int_val = TERMOUT_SYNC_OFF;
+    else
+        return 1;
+
+    return cgdbrc_set_val(option);
+}
+
 static int command_set_stc(int value)
 {
     if ((value == 0) || (value == 1)) {
@@ -314,204 +575,944 @@ static int command_set_stc(int value)
         if (cgdbrc_set_val(option))
             return 1;
 
-        /* TODO: Make this not a member function. */
-        tgdb_set_verbose_gui_command_output(tgdb, value);
-    } else
+        /* TODO: Make this not a member function. */
+        tgdb_set_verbose_gui_command_output(tgdb, value);
+    } else
+        return 1;
+
+    return 0;
+}
+
+static int command_set_disasm(int value)
+{
+    if ((value == 0) || (value == 1)) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_DISASM;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+
+        if_set_disasm(value);
+    } else
+        return 1;
+
+    return 0;
+}
+
+static int command_set_watchwin(int value)
+{
+    if ((value == 0) || (value == 1)) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_WATCHWIN;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+
+        if_set_watch(value);
+    } else
+        return 1;
+
+    return 0;
+}
+
+static int command_set_memwin(int value)
+{
+    if ((value == 0) || (value == 1)) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_MEMWIN;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+
+        if_set_memory(value);
+    } else
+        return 1;
+
+    return 0;
+}
+
+static int command_set_logwin(int value)
+{
+    if ((value == 0) || (value == 1)) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_LOGWIN;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+
+        if_set_logwin(value);
+    } else
+        return 1;
+
+    return 0;
+}
+
+static int command_set_nonstop(int value)
+{
+    if ((value == 0) || (value == 1)) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_NONSTOP;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+
+        /* gdb says so itself if the program runs already */
+        if (tgdb_set_non_stop(tgdb, value) == -1) {
+            if_display_message("Non-stop mode needs GDB/MI", 0, "");
+            return 1;
+        }
+    } else
+        return 1;
+
+    return 0;
+}
+
+static int command_set_backtracewin(int value)
+{
+    if ((value == 0) || (value == 1)) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_BACKTRACEWIN;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+
+        if_set_backtrace(value);
+    } else
+        return 1;
+
+    return 0;
+}
+
+static int command_set_breakwin(int value)
+{
+    if ((value == 0) || (value == 1)) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_BREAKWIN;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+
+        if_set_breakwin(value);
+    } else
+        return 1;
+
+    return 0;
+}
+
+static int command_set_threadwin(int value)
+{
+    if ((value == 0) || (value == 1)) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_THREADWIN;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+
+        if_set_threadwin(value);
+    } else
+        return 1;
+
+    return 0;
+}
+
+static int command_set_srcmem(int value)
+{
+    struct cgdbrc_config_option option;
+
+    /* The number of megabytes, 0 for no limit */
+    if (value < 0)
+        return 1;
+
+    option.option_kind = CGDBRC_SRCMEM;
+    option.variant.int_val = value;
+
+    return cgdbrc_set_val(option);
+}
+
+static int command_set_srcsplit(int value)
+{
+    if ((value == 0) || (value == 1)) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_SRCSPLIT;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+
+        if_set_srcsplit(value);
+    } else
+        return 1;
+
+    return 0;
+}
+
+static int command_set_hlsearch(int value)
+{
+    if ((value == 0) || (value == 1)) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_HLSEARCH;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+
+        if_set_hlsearch(value);
+    } else
+        return 1;
+
+    return 0;
+}
+
+static int command_set_regexpengine(int value)
+{
+    struct cgdbrc_config_option option;
+
+    if (value != RX_ENGINE_AUTO && value != RX_ENGINE_POSIX &&
+            value != RX_ENGINE_LINEAR)
+        return 1;
+
+    option.option_kind = CGDBRC_REGEXPENGINE;
+    option.variant.int_val = value;
+
+    return cgdbrc_set_val(option);
+}
+
+static int command_set_floodrate(int value)
+{
+    struct cgdbrc_config_option option;
+
+    /* The kilobytes a second, 0 to draw all the output */
+    if (value < 0)
+        return 1;
+
+    option.option_kind = CGDBRC_FLOODRATE;
+    option.variant.int_val = value;
+
+    return cgdbrc_set_val(option);
+}
+
+static int command_set_floodlog(const char *value)
+{
+    /* The file isn't an option of its own, the interface keeps it open */
+    return if_set_flood_log(value) == -1 ? 1 : 0;
+}
+
+int command_set_winsplit(const char *value)
+{
+    struct cgdbrc_config_option option;
+    WIN_SPLIT_TYPE split_type = WIN_SPLIT_EVEN;
+
+    option.option_kind = CGDBRC_WINSPLIT;
+
+    if (strcasecmp(value, "top_big") == 0)
+        split_type = WIN_SPLIT_TOP_BIG;
+    else if (strcasecmp(value, "top_full") == 0)
+        split_type = WIN_SPLIT_TOP_FULL;
+    else if (strcasecmp(value, "bottom_big") == 0)
+        split_type = WIN_SPLIT_BOTTOM_BIG;
+    else if (strcasecmp(value, "bottom_full") == 0)
+        split_type = WIN_SPLIT_BOTTOM_FULL;
+    else
+        split_type = WIN_SPLIT_EVEN;
+
+    option.variant.win_split_val = split_type;
+    if (cgdbrc_set_val(option))
+        return 1;
+    if_set_winsplit(split_type);
+
+    return 0;
+}
+
+static int command_set_winminheight(int value)
+{
+    struct cgdbrc_config_option option;
+
+    option.option_kind = CGDBRC_WINMINHEIGHT;
+
+    if (if_change_winminheight(value) == -1)
+        return 1;
+
+    option.variant.int_val = value;
+    return cgdbrc_set_val(option);
+}
+
+static int command_set_timeout(int value)
+{
+    struct cgdbrc_config_option option;
+
+    option.option_kind = CGDBRC_TIMEOUT;
+    option.variant.int_val = value;
+
+    if (cgdbrc_set_val(option))
+        return 1;
+
+    return 0;
+}
+
+static int command_set_timeoutlen(int value)
+{
+    if (value >= 0 && value <= 10000) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_TIMEOUT_LEN;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+    }
+
+    return 0;
+}
+
+static int command_set_ttimeout(int value)
+{
+    struct cgdbrc_config_option option;
+
+    option.option_kind = CGDBRC_TTIMEOUT;
+    option.variant.int_val = value;
+
+    if (cgdbrc_set_val(option))
+        return 1;
+
+    return 0;
+}
+
+static int command_set_ttimeoutlen(int value)
+{
+    if (value >= 0 && value <= 10000) {
+        struct cgdbrc_config_option option;
+
+        option.option_kind = CGDBRC_TTIMEOUT_LEN;
+        option.variant.int_val = value;
+
+        if (cgdbrc_set_val(option))
+            return 1;
+    }
+
+    return 0;
+}
+
+int command_set_syntax_type(const char *value)
+{
+    enum tokenizer_language_support lang;
+    struct cgdbrc_config_option option;
+
+    option.option_kind = CGDBRC_SYNTAX;
+
+    if (strcasecmp(value, "c") == 0)
+        lang = TOKENIZER_LANGUAGE_C;
+    else if (strcasecmp(value, "ada") == 0)
+        lang = TOKENIZER_LANGUAGE_ADA;
+    else if (strcasecmp(value, "off") == 0)
+        lang = TOKENIZER_LANGUAGE_UNKNOWN;
+
+    option.variant.language_support_val = lang;
+    if (cgdbrc_set_val(option))
+        return 1;
+    if_highlight_sviewer(lang);
+
+    return 0;
+}
+
+int command_focus_cgdb(int param)
+{
+    if_set_focus(CGDB);
+    return 0;
+}
+
+int command_focus_gdb(int param)
+{
+    if_set_focus(GDB);
+    return 0;
+}
+
+int command_focus_tty(int param)
+{
+    if_set_focus(TTY);
+    return 0;
+}
+
+int command_do_bang(int param)
+{
+    return 0;
+}
+
+int command_do_tgdbcommand(int param)
+{
+    tgdb_request_ptr request_ptr;
+
+    request_ptr = tgdb_request_run_debugger_command(tgdb, param);
+    if (!request_ptr)
+        return -1;
+    handle_request(tgdb, request_ptr);
+
+    return 0;
+}
+
+int command_do_focus(int param)
+{
+    int token = yylex();
+    const char *value;
+
+    if (token != IDENTIFIER)
+        return 1;
+    value = get_token();
+
+    if (strcasecmp(value, "cgdb") == 0)
+        command_focus_cgdb(0);
+    else if (strcasecmp(value, "gdb") == 0)
+        command_focus_gdb(0);
+    else if (strcasecmp(value, "tty") == 0)
+        command_focus_tty(0);
+    else
+        return 1;
+
+    return 0;
+}
+
+/* The command being parsed, for commands that take the rest of the line */
+static const char *command_line;
+
+/* command_argument: Returns everything after the command name. */
+static const char *command_argument(void)
+{
+    const char *arg = command_line;
+
+    while (isspace((unsigned char) *arg))
+        arg++;
+    while (*arg && !isspace((unsigned char) *arg))
+        arg++;
+    while (isspace((unsigned char) *arg))
+        arg++;
+
+    return arg;
+}
+
+/* command_copy_argument: Copies everything after the command name to arg,
+ * less the spaces at the end. Returns its length. */
+static size_t command_copy_argument(char *arg, size_t size)
+{
+    size_t length;
+
+    strncpy(arg, command_argument(), size - 1);
+    arg[size - 1] = '\0';
+
+    length = strlen(arg);
+    while (length > 0 && isspace((unsigned char) arg[length - 1]))
+        arg[--length] = '\0';
+
+    return length;
+}
+
+int command_do_grep(int param)
+{
+    /* The regular expression is everything after the command name */
+    if_grep(command_argument());
+
+    return 0;
+}
+
+int command_do_capture(int param)
+{
+    /* The gdb command is everything after the command name */
+    if (capture_run(command_argument()) == -1) {
+        if_display_message("Nothing was captured", 0, "");
+        return 1;
+    }
+
+    return 0;
+}
+
+int command_do_tag(int param)
+{
+    char name[MAXLINE];
+
+    command_copy_argument(name, sizeof (name));
+
+    return if_tag(name) == -1 ? 1 : 0;
+}
+
+int command_do_condition(int param)
+{
+    if (if_condition_breakpoint(command_argument()) == -1) {
+        if_display_message("No condition or source line", 0, "");
+        return 1;
+    }
+
+    return 0;
+}
+
+int command_do_watch(int param)
+{
+    char expression[MAXLINE];
+
+    command_copy_argument(expression, sizeof (expression));
+    if (watch_add(expression) == -1) {
+        if_display_message("Nothing to watch", 0, "");
         return 1;
+    }
+
+    if_draw();
 
     return 0;
 }
 
-int command_set_winsplit(const char *value)
+int command_do_unwatch(int param)
 {
-    struct cgdbrc_config_option option;
-    WIN_SPLIT_TYPE split_type = WIN_SPLIT_EVEN;
+    char what[MAXLINE];
 
-    option.option_kind = CGDBRC_WINSPLIT;
+    command_copy_argument(what, sizeof (what));
+    if (watch_remove(what) == -1) {
+        if_display_message("Not watched:", 0, " %s", what);
+        return 1;
+    }
 
-    if (strcasecmp(value, "top_big") == 0)
-        split_type = WIN_SPLIT_TOP_BIG;
-    else if (strcasecmp(value, "top_full") == 0)
-        split_type = WIN_SPLIT_TOP_FULL;
-    else if (strcasecmp(value, "bottom_big") == 0)
-        split_type = WIN_SPLIT_BOTTOM_BIG;
-    else if (strcasecmp(value, "bottom_full") == 0)
-        split_type = WIN_SPLIT_BOTTOM_FULL;
-    else
-        split_type = WIN_SPLIT_EVEN;
+    if_draw();
 
-    option.variant.win_split_val = split_type;
-    if (cgdbrc_set_val(option))
+    return 0;
+}
+
+int command_do_expand(int param)
+{
+    char row[MAXLINE];
+
+    command_copy_argument(row, sizeof (row));
+    if (watch_expand(atoi(row)) == -1) {
+        if_display_message("Nothing to expand at row", 0, " %s", row);
         return 1;
-    if_set_winsplit(split_type);
+    }
+
+    if_draw();
 
     return 0;
 }
 
-static int command_set_winminheight(int value)
+int command_do_memory(int param)
 {
-    struct cgdbrc_config_option option;
-
-    option.option_kind = CGDBRC_WINMINHEIGHT;
+    char what[MAXLINE];
 
-    if (if_change_winminheight(value) == -1)
+    /* A + or - goes a window on or back, anything else is an address */
+    command_copy_argument(what, sizeof (what));
+    if (strcmp(what, "+") == 0 || strcmp(what, "-") == 0) {
+        if (memwin_scroll(what[0] == '+' ? 1 : -1) == -1) {
+            if_display_message("No memory shown", 0, "");
+            return 1;
+        }
+    } else if (memwin_goto(what) == -1) {
+        if_display_message("No address", 0, "");
         return 1;
+    }
 
-    option.variant.int_val = value;
-    return cgdbrc_set_val(option);
+    if_draw();
+
+    return 0;
 }
 
-static int command_set_timeout(int value)
+int command_do_backtrace(int param)
 {
-    struct cgdbrc_config_option option;
+    char what[MAXLINE];
 
-    option.option_kind = CGDBRC_TIMEOUT;
-    option.variant.int_val = value;
+    /* A + goes out a window, a - back in */
+    command_copy_argument(what, sizeof (what));
+    if (strcmp(what, "+") != 0 && strcmp(what, "-") != 0) {
+        if_display_message("Usage: backtrace + or -", 0, "");
+        return 1;
+    }
 
-    if (cgdbrc_set_val(option))
+    if (if_scroll_backtrace(what[0] == '+' ? 1 : -1) == -1) {
+        if_display_message("No more frames", 0, "");
         return 1;
+    }
 
     return 0;
 }
 
-static int command_set_timeoutlen(int value)
+int command_do_breakpoints(int param)
 {
-    if (value >= 0 && value <= 10000) {
-        struct cgdbrc_config_option option;
+    char what[MAXLINE];
+    int count;
+
+    /* export and import take a file, the rest of the line */
+    command_copy_argument(what, sizeof (what));
+    if (strncmp(what, "export ", 7) == 0) {
+        if (resume_export_breaks(what + 7) == -1) {
+            if_display_message("Can't write", 0, " %s", what + 7);
+            return 1;
+        }
+        return 0;
+    } else if (strncmp(what, "import ", 7) == 0) {
+        if ((count = resume_import_breaks(what + 7)) == -1) {
+            if_display_message("No breakpoints in", 0, " %s", what + 7);
+            return 1;
+        }
+        if_display_message("Breakpoints imported:", 0, " %d", count);
+        return 0;
+    }
 
-        option.option_kind = CGDBRC_TIMEOUT_LEN;
-        option.variant.int_val = value;
+    /* A + goes down a window, a - back up */
+    if (strcmp(what, "+") != 0 && strcmp(what, "-") != 0) {
+        if_display_message("Usage: breakpoints + or -, or export or import "
+                "file", 0, "");
+        return 1;
+    }
 
-        if (cgdbrc_set_val(option))
-            return 1;
+    if (if_scroll_breakpoints(what[0] == '+' ? 1 : -1) == -1) {
+        if_display_message("No more breakpoints", 0, "");
+        return 1;
     }
 
     return 0;
 }
 
-static int command_set_ttimeout(int value)
+int command_do_frame(int param)
 {
-    struct cgdbrc_config_option option;
+    char what[MAXLINE], *end;
+    long level;
 
-    option.option_kind = CGDBRC_TTIMEOUT;
-    option.variant.int_val = value;
+    command_copy_argument(what, sizeof (what));
+    level = strtol(what, &end, 10);
+    if (end == what || *end != '\0' || level < 0) {
+        if_display_message("Usage: frame LEVEL", 0, "");
+        return 1;
+    }
 
-    if (cgdbrc_set_val(option))
+    if (if_select_frame((int) level) == -1) {
+        if_display_message("No frame", 0, " %ld", level);
         return 1;
+    }
 
     return 0;
 }
 
-static int command_set_ttimeoutlen(int value)
+int command_do_thread(int param)
 {
-    if (value >= 0 && value <= 10000) {
-        struct cgdbrc_config_option option;
+    char what[MAXLINE], *end;
+    long id;
 
-        option.option_kind = CGDBRC_TTIMEOUT_LEN;
-        option.variant.int_val = value;
+    command_copy_argument(what, sizeof (what));
+    id = strtol(what, &end, 10);
+    if (end == what || *end != '\0' || id <= 0 || id > INT_MAX) {
+        if_display_message("Usage: thread ID", 0, "");
+        return 1;
+    }
 
-        if (cgdbrc_set_val(option))
-            return 1;
+    if (if_select_thread((int) id) == -1) {
+        if_display_message("No thread", 0, " %ld", id);
+        return 1;
     }
 
     return 0;
 }
 
-int command_set_syntax_type(const char *value)
+int command_do_threads(int param)
 {
-    enum tokenizer_language_support lang;
-    struct cgdbrc_config_option option;
-
-    option.option_kind = CGDBRC_SYNTAX;
+    char what[MAXLINE];
 
-    if (strcasecmp(value, "c") == 0)
-        lang = TOKENIZER_LANGUAGE_C;
-    else if (strcasecmp(value, "ada") == 0)
-        lang = TOKENIZER_LANGUAGE_ADA;
-    else if (strcasecmp(value, "off") == 0)
-        lang = TOKENIZER_LANGUAGE_UNKNOWN;
+    /* A + goes down a window, a - back up */
+    command_copy_argument(what, sizeof (what));
+    if (strcmp(what, "+") != 0 && strcmp(what, "-") != 0) {
+        if_display_message("Usage: threads + or -", 0, "");
+        return 1;
+    }
 
-    option.variant.language_support_val = lang;
-    if (cgdbrc_set_val(option))
+    if (if_scroll_threads(what[0] == '+' ? 1 : -1) == -1) {
+        if_display_message("No more threads", 0, "");
         return 1;
-    if_highlight_sviewer(lang);
+    }
 
     return 0;
 }
 
-int command_focus_cgdb(int param)
+int command_do_scrollsearch(int param)
 {
-    if_set_focus(CGDB);
+    char regex[MAXLINE];
+
+    command_copy_argument(regex, sizeof (regex));
+    if_scroll_search(regex);
+
     return 0;
 }
 
-int command_focus_gdb(int param)
+int command_do_help(int param)
 {
-    if_set_focus(GDB);
+    if_display_help();
     return 0;
 }
 
-int command_focus_tty(int param)
+int command_do_quit(int param)
 {
-    if_set_focus(TTY);
+    /* FIXME: Test to see if debugged program is still running */
+    cleanup();
+    exit(0);
     return 0;
 }
 
-int command_do_bang(int param)
+int command_do_shell(int param)
 {
-    return 0;
+    return run_shell_command(NULL);
 }
 
-int command_do_tgdbcommand(int param)
+/* command_stats_print: Prints a line of the statistics to the gdb window. */
+static void command_stats_print(const char *line, void *context)
 {
-    tgdb_request_ptr request_ptr;
+    if_print(line);
+}
 
-    request_ptr = tgdb_request_run_debugger_command(tgdb, param);
-    if (!request_ptr)
-        return -1;
-    handle_request(tgdb, request_ptr);
+#ifdef CGDB_MEMSTATS
 
-    return 0;
+/* The file the memory report is appended to, in the config directory */
+#define MEMSTATS_FILE "memstats.txt"
+
+/* The timer that appends the memory report, and its seconds */
+static int memstats_timer = -1;
+static int memstats_seconds;
+
+/* command_memstats_write: Writes a line of the memory report to a file. */
+static void command_memstats_write(const char *line, void *context)
+{
+    fputs(line, (FILE *) context);
 }
 
-int command_do_focus(int param)
+/* command_memstats_due: Appends the memory report to its file, and waits
+ * for the next one. */
+static void command_memstats_due(void *context)
 {
-    int token = yylex();
-    const char *value;
+    char path[FSUTIL_PATH_MAX];
+    time_t now = time(NULL);
+    FILE *file;
+
+    fs_util_get_path(cgdb_home_dir, MEMSTATS_FILE, path);
+    if ((file = fopen(path, "a"))) {
+        fprintf(file, "\n%s", ctime(&now));
+        cgdb_mem_report(command_memstats_write, file);
+        fclose(file);
+    }
 
-    if (token != IDENTIFIER)
+    memstats_timer = event_loop_add_timer(memstats_seconds * 1000,
+            command_memstats_due, NULL);
+}
+
+#endif /* CGDB_MEMSTATS */
+
+/* command_do_memstats: Does :stats mem, with what's after mem as the
+ * argument, the seconds between the reports appended to a file. */
+static int command_do_memstats(const char *arg)
+{
+    char *end;
+    long seconds;
+
+    while (isspace((unsigned char) *arg))
+        arg++;
+
+    if (*arg == '\0') {
+        if_print("\n");
+        if (cgdb_mem_report(command_stats_print, NULL) == -1)
+            if_print("Memory isn't counted, cgdb has to be configured "
+                    "with --enable-memstats.\n");
+        return 0;
+    }
+
+    seconds = strtol(arg, &end, 10);
+    if (*end != '\0' || seconds < 0 || seconds > INT_MAX / 1000) {
+        if_display_message("Not a number of seconds:", 0, " %s", arg);
         return 1;
-    value = get_token();
+    }
 
-    if (strcasecmp(value, "cgdb") == 0)
-        command_focus_cgdb(0);
-    else if (strcasecmp(value, "gdb") == 0)
-        command_focus_gdb(0);
-    else if (strcasecmp(value, "tty") == 0)
-        command_focus_tty(0);
-    else
+#ifdef CGDB_MEMSTATS
+    event_loop_remove_timer(memstats_timer);
+    memstats_timer = -1;
+    memstats_seconds = (int) seconds;
+
+    if (memstats_seconds > 0) {
+        memstats_timer = event_loop_add_timer(memstats_seconds * 1000,
+                command_memstats_due, NULL);
+        if_display_message("Appending the memory report to:", 0,
+                " %s every %ds", MEMSTATS_FILE, memstats_seconds);
+    }
+
+    return 0;
+#else
+    if_display_message("Memory isn't counted,", 0,
+            " configure with --enable-memstats");
+    return 1;
+#endif /* CGDB_MEMSTATS */
+}
+
+int command_do_stats(int param)
+{
+    char path[MAXLINE];
+
+    if (command_copy_argument(path, sizeof (path)) == 0) {
+        if_print("\n");
+        stats_report(command_stats_print, NULL);
+        if (!stats_enabled)
+            if_print("Statistics are off, :stats on records them.\n");
+    } else if (strcmp(path, "on") == 0)
+        stats_enable(1);
+    else if (strcmp(path, "off") == 0)
+        stats_enable(0);
+    else if (strcmp(path, "reset") == 0)
+        stats_reset();
+    else if (strncmp(path, "mem", 3) == 0 &&
+            (path[3] == '\0' || isspace((unsigned char) path[3])))
+        return command_do_memstats(path + 3);
+    else if (stats_write(path) == -1) {
+        if_display_message("Could not write statistics to:", 0, " %s", path);
         return 1;
+    } else
+        if_display_message("Wrote statistics to:", 0, " %s", path);
 
     return 0;
 }
 
-int command_do_help(int param)
+int command_do_profile(int param)
 {
-    if_display_help();
+    char arg[MAXLINE];
+
+    if (command_copy_argument(arg, sizeof (arg)) == 0)
+        profile_report();
+    else if (strcmp(arg, "start") == 0)
+        profile_start();
+    else if (strcmp(arg, "stop") == 0)
+        profile_stop();
+    else if (strcmp(arg, "clear") == 0)
+        profile_clear();
+    else {
+        if_display_message("Usage:", 0, " profile start, stop or clear");
+        return 1;
+    }
+
     return 0;
 }
 
-int command_do_quit(int param)
+/* tab_argument: Gets what follows a word of :tab, as in "new" in :tab new.
+ * -------------
+ *
+ * Return Value: What follows the word, or NULL if what doesn't start with it.
+ */
+static const char *tab_argument(const char *what, const char *word)
 {
-    /* FIXME: Test to see if debugged program is still running */
-    cleanup();
-    exit(0);
+    size_t length = strlen(word);
+
+    if (strncmp(what, word, length) != 0 ||
+            (what[length] != '\0' && !isspace((unsigned char) what[length])))
+        return NULL;
+
+    return what + length;
+}
+
+int command_do_tab(int param)
+{
+    char what[MAXLINE], *end;
+    const char *argument;
+    long number;
+
+    /* Nothing lists the tabs, new starts another gdb */
+    if (command_copy_argument(what, sizeof (what)) == 0) {
+        tab_print();
+        return 0;
+    }
+
+    if ((argument = tab_argument(what, "new"))) {
+        if (tab_new(argument) == -1) {
+            if_display_message("Can't start another gdb", 0, "");
+            return 1;
+        }
+        return 0;
+    }
+
+    /* A tab for each rank of a job, by process id or gdbserver */
+    if ((argument = tab_argument(what, "attach"))) {
+        if (tab_attach(argument) == -1) {
+            if_display_message("Can't attach to each of", 0, "%s", argument);
+            return 1;
+        }
+        return 0;
+    }
+
+    if ((argument = tab_argument(what, "remote"))) {
+        if (tab_remote(argument) == -1) {
+            if_display_message("Can't connect to each of", 0, "%s", argument);
+            return 1;
+        }
+        return 0;
+    }
+
+    if ((argument = tab_argument(what, "all"))) {
+        if (tab_all(argument) == -1) {
+            if_display_message("Not every gdb was sent", 0, "%s", argument);
+            return 1;
+        }
+        return 0;
+    }
+
+    if (tab_argument(what, "stacks")) {
+        if (tab_stacks() == -1) {
+            if_display_message("Still waiting for the last stacks", 0, "");
+            return 1;
+        }
+        return 0;
+    }
+
+    number = strtol(what, &end, 10);
+    if (end == what || *end != '\0') {
+        if_display_message("Usage:", 0,
+                " tab, tab new ARGS, tab attach PIDS, tab remote TARGETS,"
+                " tab all COMMAND, tab stacks or tab NUMBER");
+        return 1;
+    }
+
+    if (tab_select((int) number) == -1) {
+        if_display_message("Can't show tab", 0, " %ld", number);
+        return 1;
+    }
+
     return 0;
 }
 
-int command_do_shell(int param)
+int command_do_trace(int param)
 {
-    return run_shell_command(NULL);
+    char path[MAXLINE];
+
+    if (command_copy_argument(path, sizeof (path)) == 0) {
+        if (tracer_enabled)
+            if_display_message("Tracing,", 0, " %d events kept",
+                    tracer_count());
+        else
+            if_display_message("Not tracing,", 0, " %d events kept",
+                    tracer_count());
+    } else if (strcmp(path, "on") == 0) {
+        if (tracer_enable(1) == -1) {
+            if_display_message("Could not start tracing", 0, "");
+            return 1;
+        }
+    } else if (strcmp(path, "off") == 0)
+        tracer_enable(0);
+    else if (tracer_write(path) == -1) {
+        if_display_message("Could not write the trace to:", 0, " %s", path);
+        return 1;
+    } else
+        if_display_message("Wrote the trace to:", 0, " %s", path);
+
+    return 0;
 }
 
 int command_source_reload(int param)
@@ -522,10 +1523,10 @@ int command_source_reload(int param)
         return -1;
 
     /* If there is no current source file, then there is nothing to reload. */
-    if (!sview->cur)
+    if (!sview->view->cur)
         return 0;
 
-    if (source_reload(sview, sview->cur->path, 1) == -1)
+    if (source_reload(sview, sview->view->cur->path, 1) == -1)
         return -1;
 
     return 0;
@@ -574,6 +1575,68 @@ static int command_parse_highlight(int param)
 
 extern struct kui_map_set *kui_map, *kui_imap;
 
+/* The maps of a map set read from a config file and not yet registered */
+struct cgdbrc_pending_maps {
+    char **keys;
+    char **values;
+    int count;
+    int size;
+};
+
+/* While a config file is parsed, its maps are registered together at the
+ * end, with kui_ms_register_maps, instead of one at a time */
+static int cgdbrc_batch_maps;
+static struct cgdbrc_pending_maps cgdbrc_pending_map, cgdbrc_pending_imap;
+
+static struct cgdbrc_pending_maps *cgdbrc_pending_maps(
+        struct kui_map_set *kui_map_choice)
+{
+    return kui_map_choice == kui_map ? &cgdbrc_pending_map :
+            &cgdbrc_pending_imap;
+}
+
+/* Registers the maps waiting for a map set, in the order they were read */
+static int cgdbrc_flush_maps(struct kui_map_set *kui_map_choice)
+{
+    struct cgdbrc_pending_maps *pending =
+            cgdbrc_pending_maps(kui_map_choice);
+    int i, val = 0;
+
+    if (pending->count == 0)
+        return 0;
+
+    val = kui_ms_register_maps(kui_map_choice,
+            (const char *const *) pending->keys,
+            (const char *const *) pending->values, pending->count);
+
+    for (i = 0; i < pending->count; i++) {
+        free(pending->keys[i]);
+        free(pending->values[i]);
+    }
+    pending->count = 0;
+
+    return val;
+}
+
+static void cgdbrc_pend_map(struct kui_map_set *kui_map_choice,
+        char *key, const char *value)
+{
+    struct cgdbrc_pending_maps *pending =
+            cgdbrc_pending_maps(kui_map_choice);
+
+    if (pending->count == pending->size) {
+        pending->size = pending->size ? pending->size * 2 : 64;
+        pending->keys = (char **) cgdb_realloc(pending->keys,
+                sizeof (char *) * pending->size);
+        pending->values = (char **) cgdb_realloc(pending->values,
+                sizeof (char *) * pending->size);
+    }
+
+    pending->keys[pending->count] = key;
+    pending->values[pending->count] = cgdb_strdup(value);
+    pending->count++;
+}
+
 static int command_parse_map(int param)
 {
     struct kui_map_set *kui_map_choice;
@@ -602,9 +1665,15 @@ static int command_parse_map(int param)
         return -1;
     }
 
+    if (cgdbrc_batch_maps) {
+        cgdbrc_pend_map(kui_map_choice, key_token, get_token());
+        enter_map_id = 0;
+        return 0;
+    }
+
     val = kui_ms_register_map(kui_map_choice, key_token, get_token());
+    free(key_token);
     if (val == -1) {
-        free(key_token);
         enter_map_id = 0;
         return -1;
     }
@@ -636,9 +1705,12 @@ static int command_parse_unmap(int param)
     }
     key_token = cgdb_strdup(get_token());
 
+    /* The maps read before it are what it removes from */
+    cgdbrc_flush_maps(kui_map_choice);
+
     val = kui_ms_deregister_map(kui_map_choice, key_token);
+    free(key_token);
     if (val == -1) {
-        free(key_token);
         enter_map_id = 0;
         return -1;
     }
@@ -803,6 +1875,8 @@ int command_parse_string(const char *buffer)
     int rv = 1;
     YY_BUFFER_STATE state = yy_scan_string((char *) buffer);
 
+    command_line = buffer;
+
     switch (yylex()) {
         case SET:
             /* get the next token */
@@ -863,7 +1937,9 @@ int command_parse_file(FILE * fp)
 {
     char buffer[4096];
     char *p = buffer;
-    int linenumber = 0;
+    int linenumber = 0, val;
+
+    cgdbrc_batch_maps = 1;
 
     while (linenumber++, fgets(p, sizeof (buffer) - (p - buffer), fp)) {
         int bufferlen = strlen(buffer);
@@ -884,6 +1960,11 @@ int command_parse_file(FILE * fp)
         p = buffer;
     }
 
+    cgdbrc_batch_maps = 0;
+    val = cgdbrc_flush_maps(kui_map);
+    if (cgdbrc_flush_maps(kui_imap) == -1 || val == -1)
+        if_print_message("Error adding the maps of the file\n");
+
     return 0;
 }
 
@@ -983,6 +2064,11 @@ cgdbrc_config_option_ptr cgdbrc_get(enum cgdbrc_option_kind option)
     return &cgdbrc_config_options[option];
 }
 
+const struct cgdbrc_snapshot *cgdbrc_get_snapshot(void)
+{
+    return &snapshot;
+}
+
 int cgdbrc_get_key_code_timeoutlen(void)
 {
     cgdbrc_config_option_ptr timeout_option_ptr = cgdbrc_get(CGDBRC_TIMEOUT);
@@ -105,15 +105,38 @@ enum cgdbrc_option_kind {
     CGDBRC_ARROWSELECTEDLINE,
     CGDBRC_ARROWSTYLE,
     CGDBRC_AUTOSOURCERELOAD,
+    CGDBRC_BACKTRACEWIN,
+    CGDBRC_BREAKWIN,
     CGDBRC_CGDB_MODE_KEY,
+    CGDBRC_CONDEVAL,
+    CGDBRC_DISASM,
+    CGDBRC_FLOODRATE,
+    CGDBRC_FRAMETIME,
+    CGDBRC_HISTORYSIZE,
+    CGDBRC_HLCACHE,
+    CGDBRC_HLSEARCH,
     CGDBRC_IGNORECASE,
+    CGDBRC_LOGWIN,
+    CGDBRC_MEMWIN,
+    CGDBRC_NONSTOP,
+    CGDBRC_PARALLELSEARCH,
+    CGDBRC_PREFETCH,
+    CGDBRC_PROFILERATE,
+    CGDBRC_REGEXPENGINE,
+    CGDBRC_SCROLLBACK,
+    CGDBRC_SCROLLSPILL,
     CGDBRC_SHOWTGDBCOMMANDS,
+    CGDBRC_SRCMEM,
+    CGDBRC_SRCSPLIT,
+    CGDBRC_SYNCUPDATE,
     CGDBRC_SYNTAX,
     CGDBRC_TABSTOP,
+    CGDBRC_THREADWIN,
     CGDBRC_TIMEOUT,
     CGDBRC_TIMEOUT_LEN,
     CGDBRC_TTIMEOUT,
     CGDBRC_TTIMEOUT_LEN,
+    CGDBRC_WATCHWIN,
     CGDBRC_WINMINHEIGHT,
     CGDBRC_WINSPLIT,
     CGDBRC_WRAPSCAN
@@ -126,14 +149,37 @@ struct cgdbrc_config_option {
         /* option_kind == CGDBRC_ARROWSTYLE */
         enum ArrowStyle arrow_style;
         /* option_kind == CGDBRC_AUTOSOURCERELOAD */
+        /* option_kind == CGDBRC_BACKTRACEWIN */
+        /* option_kind == CGDBRC_BREAKWIN */
         /* option_kind == CGDBRC_CGDB_MODE_KEY */
+        /* option_kind == CGDBRC_CONDEVAL, an enum tgdb_condition_evaluation */
+        /* option_kind == CGDBRC_DISASM */
+        /* option_kind == CGDBRC_FLOODRATE */
+        /* option_kind == CGDBRC_FRAMETIME */
+        /* option_kind == CGDBRC_HISTORYSIZE */
+        /* option_kind == CGDBRC_HLCACHE */
+        /* option_kind == CGDBRC_HLSEARCH */
         /* option_kind == CGDBRC_IGNORECASE */
+        /* option_kind == CGDBRC_LOGWIN */
+        /* option_kind == CGDBRC_MEMWIN */
+        /* option_kind == CGDBRC_NONSTOP */
+        /* option_kind == CGDBRC_PARALLELSEARCH */
+        /* option_kind == CGDBRC_PREFETCH */
+        /* option_kind == CGDBRC_PROFILERATE */
+        /* option_kind == CGDBRC_REGEXPENGINE, an enum rx_engine */
+        /* option_kind == CGDBRC_SCROLLBACK */
+        /* option_kind == CGDBRC_SCROLLSPILL */
         /* option_kind == CGDBRC_SHOWTGDBCOMMANDS */
+        /* option_kind == CGDBRC_SRCMEM */
+        /* option_kind == CGDBRC_SRCSPLIT */
+        /* option_kind == CGDBRC_SYNCUPDATE, an enum termout_sync */
         /* option_kind == CGDBRC_TABSTOP */
+        /* option_kind == CGDBRC_THREADWIN */
         /* option_kind == CGDBRC_TIMEOUT */
         /* option_kind == CGDBRC_TIMEOUTLEN */
         /* option_kind == CGDBRC_TTIMEOUT */
         /* option_kind == CGDBRC_TTIMEOUTLEN */
+        /* option_kind == CGDBRC_WATCHWIN */
         /* option_kind == CGDBRC_WINMINHEIGHT */
         /* option_kind == CGDBRC_WRAPSCAN */
         int int_val;
@@ -236,4 +282,34 @@ int cgdbrc_get_mapped_key_timeoutlen(void);
 
 /* }}} */
 
+/* Snapshot {{{ */
+
+/**
+ * The options that are read while drawing, as plain fields. cgdbrc keeps
+ * it up to date through cgdbrc_attach, so reading a field is all the
+ * drawing code does for each row. A copy is never changed, so it can be
+ * handed to another thread.
+ */
+struct cgdbrc_snapshot {
+    /* CGDBRC_ANSI_CODES */
+    int ansi_codes;
+    /* CGDBRC_ARROWSELECTEDLINE */
+    int arrow_selected_line;
+    /* CGDBRC_ARROWSTYLE */
+    enum ArrowStyle arrow_style;
+    /* CGDBRC_TABSTOP */
+    int tabstop;
+};
+
+/**
+ * Get the options that are read while drawing.
+ *
+ * \return
+ * This will never return NULL. It points to the values the options have
+ * now, and it's changed each time one of them is set.
+ */
+const struct cgdbrc_snapshot *cgdbrc_get_snapshot(void);
+
+/* }}} */
+
 #endif /* __CGDBRC_H__ */
@@ -543,6 +543,9 @@ const char * get_token( void )
 
 
 int enter_map_id = 0;
+
+/* Set when the last token was '=', a '#' after it is a color */
+static int after_equals = 0;
 /* An identifier used in a map like command */
 
 #line 549 "../../cgdb/cgdb/command_lexer.c"
@@ -733,8 +736,10 @@ YY_DECL
 	register char *yy_cp, *yy_bp;
 	register int yy_act;
     
-#line 26 "../../cgdb/cgdb/command_lexer.l"
+#line 29 "../../cgdb/cgdb/command_lexer.l"
+        int equals = after_equals;
 
+        after_equals = 0;
         if (enter_map_id)
                 BEGIN (MAP_ID);
         else
@@ -826,7 +831,14 @@ do_action:	/* This label is used only to access EOF actions. */
 case 1:
 YY_RULE_SETUP
 #line 34 "../../cgdb/cgdb/command_lexer.l"
-{ /* ignore comments */ }
+{
+        /* ignore comments, unless it's a color like #ff8000 */
+        if (equals && yyleng >= 7 &&
+                strspn(yytext + 1, "0123456789abcdefABCDEF") == 6) {
+            yyless(7);
+            return COLOR;
+        }
+    }
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
@@ -873,7 +885,7 @@ YY_RULE_SETUP
 case 10:
 YY_RULE_SETUP
 #line 45 "../../cgdb/cgdb/command_lexer.l"
-{ return '='; }
+{ after_equals = 1; return '='; }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
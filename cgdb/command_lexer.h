@@ -13,6 +13,7 @@
  *  COMMAND: a recognized command (for future expansion)
  *  STRING: a quoted-string.
  *  EOL: end of line
+ *  COLOR: a 24 bit color right after a '=', like #ff8000
  */
 enum TOKENS {
     SET = 255,
@@ -26,7 +27,8 @@ enum TOKENS {
     IDENTIFIER,
     COMMAND,
     STRING,
-    EOL
+    EOL,
+    COLOR
 };
 
 /* yylex: retreive the next token from the current scan buffer
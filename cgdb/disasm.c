@@ -0,0 +1,188 @@
+/* disasm.c:
+ * ---------
+ *
+ * A function gdb disassembled is a block of instructions, from the address
+ * of its first one to the address of its last one. The addresses are kept
+ * in order, so an instruction is found in its block by a binary search.
+ * There are few blocks, they're looked through one after the other.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+/* Local Includes */
+#include "disasm.h"
+#include "sources.h"
+#include "tgdb_types.h"
+#include "sys_util.h"
+#include "ibuf.h"
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* A function that was disassembled */
+struct disasm_block {
+    char *path;                 /* Its name in the source viewer */
+    unsigned long *addresses;   /* The address of each line, in order */
+    int count;                  /* The number of lines */
+    unsigned long used;         /* When it was last found, for eviction */
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+static struct disasm_block disasm_blocks[DISASM_BLOCKS];
+static int disasm_count;
+static unsigned long disasm_tick;
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* disasm_remove: Frees a block, and takes it out of the source viewer.
+ * --------------
+ *
+ *   index:  The block, the last block takes its place
+ */
+static void disasm_remove(struct sviewer *sview, int index)
+{
+    struct disasm_block *block = &disasm_blocks[index];
+
+    source_del(sview, block->path);
+    free(block->path);
+    free(block->addresses);
+
+    *block = disasm_blocks[--disasm_count];
+}
+
+/* disasm_line: Finds the line of an instruction in a block.
+ * ------------
+ *
+ * Return Value: The index of the line, or -1 if the block doesn't have it.
+ */
+static int disasm_line(const struct disasm_block *block,
+        unsigned long address)
+{
+    int low = 0, high = block->count - 1, mid;
+
+    if (address < block->addresses[0] || address > block->addresses[high])
+        return -1;
+
+    /* The last instruction that starts at or before the address */
+    while (low < high) {
+        mid = (low + high + 1) / 2;
+        if (block->addresses[mid] <= address)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    return low;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in disasm.h for function descriptions. */
+
+int disasm_add(struct sviewer *sview,
+        const struct tgdb_disassembly *disassembly)
+{
+    struct disasm_block *block = NULL;
+    struct ibuf *text;
+    char name[MAX_LINE], address[32];
+    int i, lru = 0;
+
+    if (disassembly->count == 0)
+        return -1;
+
+    snprintf(name, sizeof (name), "%s 0x%lx",
+            disassembly->function ? disassembly->function : "",
+            disassembly->instructions[0].address);
+
+    for (i = 0; i < disasm_count; i++) {
+        if (strcmp(disasm_blocks[i].path, name) == 0) {
+            disasm_remove(sview, i);
+            break;
+        }
+    }
+
+    /* The function used least recently makes room */
+    if (disasm_count == DISASM_BLOCKS) {
+        for (i = 1; i < disasm_count; i++)
+            if (disasm_blocks[i].used < disasm_blocks[lru].used)
+                lru = i;
+        disasm_remove(sview, lru);
+    }
+
+    block = &disasm_blocks[disasm_count];
+    block->path = cgdb_strdup(name);
+    block->count = disassembly->count;
+    block->addresses = cgdb_malloc(sizeof (unsigned long) * block->count);
+    block->used = ++disasm_tick;
+
+    text = ibuf_init();
+    for (i = 0; i < block->count; i++) {
+        const struct tgdb_instruction *instruction =
+                &disassembly->instructions[i];
+
+        block->addresses[i] = instruction->address;
+        snprintf(address, sizeof (address), "0x%lx  ", instruction->address);
+        ibuf_add(text, address);
+        ibuf_add(text, instruction->text ? instruction->text : "");
+        ibuf_addchar(text, '\n');
+    }
+
+    if (source_set_text(sview, block->path, ibuf_get(text),
+                    ibuf_length(text))) {
+        source_del(sview, block->path);
+        free(block->path);
+        free(block->addresses);
+        ibuf_free(text);
+        return -1;
+    }
+
+    ibuf_free(text);
+    disasm_count++;
+
+    return 0;
+}
+
+const char *disasm_find(unsigned long address, int *line)
+{
+    int i, index;
+
+    for (i = 0; i < disasm_count; i++) {
+        if ((index = disasm_line(&disasm_blocks[i], address)) != -1) {
+            disasm_blocks[i].used = ++disasm_tick;
+            *line = index + 1;
+            return disasm_blocks[i].path;
+        }
+    }
+
+    return NULL;
+}
+
+void disasm_clear(struct sviewer *sview)
+{
+    while (disasm_count > 0)
+        disasm_remove(sview, disasm_count - 1);
+}
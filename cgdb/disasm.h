@@ -0,0 +1,59 @@
+#ifndef _DISASM_H_
+#define _DISASM_H_
+
+/* disasm.h:
+ * ---------
+ *
+ * Keeps the functions gdb disassembled, so the disassembly window can
+ * follow the program as it steps without asking gdb each time. Each
+ * function is a file of its own in a source viewer, with a line for each
+ * instruction, and the functions used least recently are dropped once
+ * there are DISASM_BLOCKS of them.
+ *
+ * A function is known by the addresses of its instructions. There's no
+ * way to tell the program was rebuilt, so they're forgotten when it exits.
+ *
+ */
+
+/* The most functions kept */
+#define DISASM_BLOCKS 64
+
+struct sviewer;
+struct tgdb_disassembly;
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* disasm_add: Adds a function gdb disassembled.
+ * -----------
+ *
+ * A function that was already added has its lines replaced.
+ *
+ *   sview:        The source viewer the functions are shown in
+ *   disassembly:  The instructions gdb listed
+ *
+ * Return Value: 0 on success, -1 if gdb listed no instructions.
+ */
+int disasm_add(struct sviewer *sview,
+        const struct tgdb_disassembly *disassembly);
+
+/* disasm_find: Finds the function an instruction is in.
+ * ------------
+ *
+ *   address:  The address of the instruction
+ *   line:     Set to the line of the instruction, 1 is the first one
+ *
+ * Return Value: The path of the function in the source viewer, or NULL if
+ *               none of the functions has the instruction.
+ */
+const char *disasm_find(unsigned long address, int *line);
+
+/* disasm_clear: Forgets every function.
+ * -------------
+ *
+ *   sview:  The source viewer the functions are shown in
+ */
+void disasm_clear(struct sviewer *sview);
+
+#endif /* _DISASM_H_ */
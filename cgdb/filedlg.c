@@ -25,11 +25,14 @@
 #include "highlight.h"
 #include "kui_term.h"
 #include "highlight_groups.h"
+#include "cgdbrc.h"
+#include "std_intern.h"
+#include "termout.h"
 
 struct file_buffer {
     int length;                 /* Number of files in program */
-    char **files;               /* Array containing file */
-    char *cur_line;             /* cur line may have unique color */
+    const char **files;         /* The files, interned, or the labels */
+    struct hl_run *cur_line;    /* cur line may have unique color */
     int max_width;              /* Width of longest line in file */
 
     int sel_line;               /* Current line selected in file dialog */
@@ -40,9 +43,28 @@ struct file_buffer {
     int sel_rline;              /* Current line used by regex */
 };
 
+/* A file matching the fuzzy finder's query */
+struct file_match {
+    int file;                   /* Index of the file in the file buffer */
+    int score;                  /* How well it matches, higher is better */
+};
+
+/* The index the fuzzy finder searches, built the first time it's used */
+struct file_finder {
+    int length;                 /* Number of files indexed */
+    unsigned int *masks;        /* The characters in each file */
+    int *files;                 /* The files, those matching the query first */
+    int ends[MAX_LINE];         /* The first ends[i] files match i chars */
+    struct file_match *matches; /* The files that match, best first */
+    int matches_length;         /* Number of files that match */
+    int sel_line;               /* The selected line before finding */
+};
+
 struct filedlg {
     struct file_buffer *buf;    /* All of the widget's data ( files ) */
+    struct file_finder *finder; /* The fuzzy finder's index, or NULL */
     WINDOW *win;                /* Curses window */
+    char *label;                /* The line shown above the files */
 };
 
 static char regex_line[MAX_LINE];   /* The regex the user enters */
@@ -50,6 +72,10 @@ static int regex_line_pos;      /* The index into the current regex */
 static int regex_search;        /* Currently searching text ? */
 static int regex_direction;     /* Direction to search */
 
+static char find_line[MAX_LINE];    /* The fuzzy query the user enters */
+static int find_line_pos;       /* The index into the current query */
+static int find_search;         /* Currently finding files ? */
+
 /* print_in_middle: Prints the message 'string' centered at line in win 
  * ----------------
  *
@@ -89,6 +115,8 @@ struct filedlg *filedlg_new(int pos_r, int pos_c, int height, int width)
     /* Initialize the structure */
     fd->win = newwin(height, width, pos_r, pos_c);
     keypad(fd->win, TRUE);
+    fd->finder = NULL;
+    fd->label = strdup("Select a file or press q to cancel.");
 
     /* Initialize the buffer */
     if ((fd->buf = malloc(sizeof (struct file_buffer))) == NULL)
@@ -111,75 +139,377 @@ void filedlg_free(struct filedlg *fdlg)
 {
     filedlg_clear(fdlg);
     delwin(fdlg->win);
+    free(fdlg->label);
     free(fdlg->buf);
     free(fdlg);
 }
 
+/* filedlg_finder_free: Drops the fuzzy finder's index, once the files change.
+ * -------------------
+ */
+static void filedlg_finder_free(struct filedlg *fd)
+{
+    if (fd->finder == NULL)
+        return;
+
+    free(fd->finder->masks);
+    free(fd->finder->files);
+    free(fd->finder->matches);
+    free(fd->finder);
+    fd->finder = NULL;
+}
+
+/* finder_fold: Folds a character to lower case, so finding ignores case.
+ * ------------
+ */
+static int finder_fold(int c)
+{
+    return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+}
+
+/* finder_mask: Gets the set of characters in a string, as a bit mask.
+ * ------------
+ *
+ *  The letters get a bit each, the rest share a few. A file can only match
+ *  a query if it has all of the query's bits.
+ */
+static unsigned int finder_mask(const char *string, int length)
+{
+    unsigned int mask = 0;
+    int i, c;
+
+    for (i = 0; i < length && string[i]; i++) {
+        c = finder_fold((unsigned char) string[i]);
+
+        if (c >= 'a' && c <= 'z')
+            mask |= 1u << (c - 'a');
+        else if (c >= '0' && c <= '9')
+            mask |= 1u << 26;
+        else if (c == '.')
+            mask |= 1u << 27;
+        else if (c == '_')
+            mask |= 1u << 28;
+        else if (c == '/')
+            mask |= 1u << 29;
+        else
+            mask |= 1u << 30;
+    }
+
+    return mask;
+}
+
+/* finder_match: Scores query as a subsequence of the file, from start.
+ * -------------
+ *
+ *  file:   The file
+ *  start:  Where in the file to start matching
+ *  query:  The characters to find, in order
+ *  length: The length of query
+ *
+ *  Matches at the start of a word or right after the last match score
+ *  extra, gaps between matches cost a little.
+ *
+ * Return Value: The score, or -1 if the file doesn't match.
+ */
+static int finder_match(const char *file, const char *start,
+        const char *query, int length)
+{
+    const char *p = start, *last = NULL;
+    int score = length * 4, i;
+
+    for (i = 0; i < length; i++, p++) {
+        while (*p && finder_fold((unsigned char) *p) !=
+                finder_fold((unsigned char) query[i]))
+            p++;
+
+        if (*p == '\0')
+            return -1;
+
+        if (p == file || strchr("/_-. ", p[-1]))
+            score += 8;
+        else if (p[0] >= 'A' && p[0] <= 'Z' && p[-1] >= 'a' && p[-1] <= 'z')
+            score += 6;
+
+        if (last && p == last + 1)
+            score += 5;
+        else if (last)
+            score -= (p - last > 4) ? 3 : 1;
+
+        last = p;
+    }
+
+    return score;
+}
+
+/* finder_score: Scores the file for the query.
+ * -------------
+ *
+ * Return Value: The score, or -1 if the file doesn't match.
+ */
+static int finder_score(const char *file, const char *query, int length)
+{
+    const char *base = strrchr(file, '/');
+    int score = finder_match(file, file, query, length), base_score;
+
+    /* Matching only the base name is better */
+    if (base && (base_score = finder_match(file, base + 1, query,
+                            length)) >= 0 && base_score + 10 > score)
+        score = base_score + 10;
+
+    return score;
+}
+
+/* finder_cmp: Orders the matches best first, for qsort.
+ * -----------
+ *
+ *  Matches that score the same stay in the dialog's order.
+ */
+static int finder_cmp(const void *a, const void *b)
+{
+    const struct file_match *m1 = a, *m2 = b;
+
+    if (m1->score != m2->score)
+        return m2->score - m1->score;
+
+    return m1->file - m2->file;
+}
+
+/* filedlg_finder_new: Builds the fuzzy finder's index of the files.
+ * ------------------
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+static int filedlg_finder_new(struct filedlg *fd)
+{
+    struct file_finder *finder;
+    int i;
+
+    if (fd->finder)
+        return 0;
+
+    if ((finder = malloc(sizeof (struct file_finder))) == NULL)
+        return -1;
+
+    finder->length = fd->buf->length;
+    finder->masks = malloc(sizeof (unsigned int) * (finder->length + 1));
+    finder->files = malloc(sizeof (int) * (finder->length + 1));
+    finder->matches = malloc(sizeof (struct file_match) *
+            (finder->length + 1));
+
+    if (!finder->masks || !finder->files || !finder->matches) {
+        free(finder->masks);
+        free(finder->files);
+        free(finder->matches);
+        free(finder);
+        return -1;
+    }
+
+    for (i = 0; i < finder->length; i++) {
+        finder->masks[i] = finder_mask(fd->buf->files[i], MAX_LINE);
+        finder->files[i] = i;
+    }
+
+    finder->ends[0] = finder->length;
+    finder->matches_length = 0;
+    finder->sel_line = 0;
+    fd->finder = finder;
+
+    return 0;
+}
+
+/* filedlg_find: Finds the files matching the first length chars of query.
+ * -------------
+ *
+ *  fd:     The file dialog
+ *  query:  The characters to find
+ *  length: The length of query
+ *  narrow: 1 if a character was just added to query, otherwise 0
+ *
+ *  Each character only narrows the files that matched before it, so
+ *  typing gets faster as the query grows.
+ */
+static void filedlg_find(struct filedlg *fd, const char *query, int length,
+        int narrow)
+{
+    struct file_finder *finder = fd->finder;
+    unsigned int mask = finder_mask(query, length);
+    int count = narrow ? finder->ends[length - 1] : finder->ends[length];
+    int i, n, file, score;
+
+    for (i = n = 0; i < count; i++) {
+        file = finder->files[i];
+
+        if (length == 0)
+            score = 0;
+        else if ((finder->masks[file] & mask) != mask ||
+                (score = finder_score(fd->buf->files[file], query,
+                                length)) < 0)
+            continue;
+
+        /* Keep the files that match first, for the next character */
+        finder->files[i] = finder->files[n];
+        finder->files[n] = file;
+        finder->matches[n].file = file;
+        finder->matches[n].score = score;
+        n++;
+    }
+
+    finder->ends[length] = n;
+    finder->matches_length = n;
+
+    qsort(finder->matches, n, sizeof (struct file_match), finder_cmp);
+
+    /* The best match is selected */
+    fd->buf->sel_line = 0;
+}
+
+/* file_choice_rank: Files go first, then relative paths, then absolute ones.
+ * -----------------
+ */
+static int file_choice_rank(const char *choice)
+{
+    if (choice[0] == '/')
+        return 2;
+    else if (choice[0] == '.')
+        return 1;
+
+    return 0;
+}
+
+/* file_choice_cmp: Orders the file choices, for qsort.
+ * ----------------
+ */
+static int file_choice_cmp(const void *a, const void *b)
+{
+    const char *s1 = *(const char **) a, *s2 = *(const char **) b;
+    int rank;
+
+    /* The files are interned, a choice gdb listed twice is often the same */
+    if (s1 == s2)
+        return 0;
+
+    rank = file_choice_rank(s1) - file_choice_rank(s2);
+
+    return rank ? rank : strcmp(s1, s2);
+}
+
 int filedlg_add_file_choice(struct filedlg *fd, const char *file_choice)
 {
-    int length;
-    int index, i;
-    int equal = 1;              /* Not set to 0, because 0 *is* equal */
+    char *choice = (char *) file_choice;
+    int added;
 
     if (file_choice == NULL || *file_choice == '\0')
         return -1;
 
-    /* find index to insert by comparing:
-     * Absolute paths go to the end
-     * Relative paths go before the absolute paths 
-     */
-    for (i = 0; i < fd->buf->length; i++) {
-        /* Don't add duplicate entry's ... gdb outputs duplicates */
-        if ((equal = strcmp(fd->buf->files[i], file_choice)) == 0)
-            return -3;
-        else if (equal < 0) {
-            /* Inserting filename, stop before relative path */
-            if ((file_choice[0] != '.' && file_choice[0] != '/')
-                    && fd->buf->files[i][0] == '.')
-                break;
-
-            /* Inserting filename, stop before absolute path */
-            if (file_choice[0] != '/' && fd->buf->files[i][0] == '/')
-                break;
-
-        } else if (equal > 0) { /* Found ( file_choice is greater ) */
-            /* Inserting Absolute path, it goes to the end */
-            if (file_choice[0] == '/' && fd->buf->files[i][0] != '/')
-                continue;
-
-            /* Inserting relative path, continue until before absolute or relative path */
-            if (file_choice[0] == '.' && (fd->buf->files[i][0] != '.'
-                            && fd->buf->files[i][0] != '/'))
-                continue;
+    /* Don't add duplicate entry's ... gdb outputs duplicates */
+    if ((added = filedlg_add_file_choices(fd, &choice, 1)) == -1)
+        return -2;
 
-            break;
+    return added == 1 ? 0 : -3;
+}
+
+int filedlg_add_file_choices(struct filedlg *fd, char **choices, int count)
+{
+    const char **files;
+    int i, j, n, added, length, cmp;
+
+    /* Drop the empty choices, then sort the rest once */
+    for (i = n = 0; i < count; i++) {
+        if (choices[i] != NULL && *choices[i] != '\0')
+            choices[n++] = choices[i];
+    }
+
+    qsort(choices, n, sizeof (char *), file_choice_cmp);
+
+    files = malloc(sizeof (char *) * (fd->buf->length + n + 1));
+    if (!files)
+        return -1;
+
+    /* Merge them into the files, which are already in order. The ones that
+     * are new are moved to the front of choices. */
+    for (i = j = added = 0; i < fd->buf->length || j < n;) {
+        if (j == n)
+            cmp = -1;
+        else if (i == fd->buf->length)
+            cmp = 1;
+        else
+            cmp = file_choice_cmp(&fd->buf->files[i], &choices[j]);
+
+        if (cmp < 0) {
+            files[i + added] = fd->buf->files[i];
+            i++;
+            continue;
         }
+
+        /* Don't add duplicate entry's ... gdb outputs duplicates */
+        if (cmp == 0 || (added > 0 &&
+                        strcmp(files[i + added - 1], choices[j]) == 0)) {
+            j++;
+            continue;
+        }
+
+        files[i + added] = std_intern(choices[j]);
+
+        if ((length = strlen(choices[j])) > fd->buf->max_width)
+            fd->buf->max_width = length;
+
+        choices[added++] = choices[j++];
     }
 
-    index = i;
+    free(fd->buf->files);
+    fd->buf->files = files;
+    fd->buf->length += added;
+
+    if (added > 0)
+        filedlg_finder_free(fd);
 
-    fd->buf->length = fd->buf->length + 1;
-    fd->buf->files = realloc(fd->buf->files, sizeof (char *) * fd->buf->length);
+    return added;
+}
 
-    /* shift everything down and then insert into index */
-    for (i = fd->buf->length - 1; i > index; i--)
-        fd->buf->files[i] = fd->buf->files[i - 1];
+int filedlg_append_choice(struct filedlg *fd, const char *choice)
+{
+    int length;
 
-    if ((fd->buf->files[index] = strdup(file_choice)) == NULL)
+    if (choice == NULL || *choice == '\0')
+        return -1;
+
+    fd->buf->files = realloc(fd->buf->files,
+            sizeof (char *) * (fd->buf->length + 1));
+
+    if ((fd->buf->files[fd->buf->length] = strdup(choice)) == NULL)
         return -2;
 
-    if ((length = strlen(file_choice)) > fd->buf->max_width)
+    fd->buf->length++;
+    filedlg_finder_free(fd);
+
+    if ((length = strlen(choice)) > fd->buf->max_width)
         fd->buf->max_width = length;
 
     return 0;
 }
 
+void filedlg_set_label(struct filedlg *fd, const char *label)
+{
+    free(fd->label);
+    fd->label = strdup(label);
+}
+
+int filedlg_selected(struct filedlg *fd)
+{
+    return fd->buf->length > 0 ? fd->buf->sel_line : -1;
+}
+
 void filedlg_clear(struct filedlg *fd)
 {
     int i;
 
+    hl_wprintw_forget();
+    filedlg_finder_free(fd);
+
+    /* Only the labels are copies, the files are interned */
     for (i = 0; i < fd->buf->length; i++)
-        free(fd->buf->files[i]);
+        if (std_intern_lookup(fd->buf->files[i]) != fd->buf->files[i])
+            free((char *) fd->buf->files[i]);
 
     free(fd->buf->files);
     fd->buf->files = NULL;
@@ -196,15 +526,34 @@ void filedlg_clear(struct filedlg *fd)
     fd->buf->sel_rline = 0;
 }
 
+/* filedlg_length: The number of files shown, only the matches while finding.
+ * ---------------
+ */
+static int filedlg_length(struct filedlg *fd)
+{
+    return find_search ? fd->finder->matches_length : fd->buf->length;
+}
+
+/* filedlg_file: The file shown at line, the best matches first while finding.
+ * -------------
+ */
+static const char *filedlg_file(struct filedlg *fd, int line)
+{
+    if (find_search)
+        return fd->buf->files[fd->finder->matches[line].file];
+
+    return fd->buf->files[line];
+}
+
 static void filedlg_vscroll(struct filedlg *fd, int offset)
 {
     if (fd->buf) {
         fd->buf->sel_line += offset;
+        /* The display message and status bar takes a line */
+        if (fd->buf->sel_line >= filedlg_length(fd))
+            fd->buf->sel_line = filedlg_length(fd) - 1;
         if (fd->buf->sel_line < 0)
             fd->buf->sel_line = 0;
-        /* The display message and status bar takes a line */
-        if (fd->buf->sel_line >= fd->buf->length)
-            fd->buf->sel_line = fd->buf->length - 1;
     }
 }
 
@@ -230,6 +579,8 @@ static void filedlg_search_regex_init(struct filedlg *fd)
     if (fd == NULL || fd->buf == NULL)
         return;
 
+    hl_regex_reset();
+
     /* Start from beggining of line if not at same line */
     if (fd->buf->sel_rline != fd->buf->sel_line) {
         fd->buf->sel_col_rend = 0;
@@ -240,15 +591,27 @@ static void filedlg_search_regex_init(struct filedlg *fd)
     fd->buf->sel_rline = fd->buf->sel_line;
 }
 
+/* get_file: Gets a file name for hl_regex to search.
+ * ---------
+ */
+static const char *get_file(void *data, int line,
+        const struct hl_run **runs)
+{
+    struct file_buffer *buf = data;
+
+    if (runs)
+        *runs = NULL;
+
+    return buf->files[line];
+}
+
 static int filedlg_search_regex(struct filedlg *fd, const char *regex,
         int opt, int direction, int icase)
 {
     if (fd == NULL || fd->buf == NULL || regex == NULL || strlen(regex) == 0)
         return -1;
 
-    return hl_regex(regex,
-            (const char **) fd->buf->files,
-            (const char **) fd->buf->files,
+    return hl_regex(regex, get_file, fd->buf,
             fd->buf->length,
             &fd->buf->cur_line, &fd->buf->sel_line,
             &fd->buf->sel_rline, &fd->buf->sel_col_rbeg,
@@ -261,32 +624,36 @@ int filedlg_display(struct filedlg *fd)
     int width, height;
     int lwidth;
     int file;
+    int length;
     int i;
     int attr;
-    static char *label = "Select a file or press q to cancel.";
+    int tabstop = cgdbrc_get_snapshot()->tabstop;
 
     curs_set(0);
 
+    /* Initialize variables */
+    getmaxyx(fd->win, height, width);
+
     /* Check that a file is loaded */
-    if (fd == NULL || fd->buf == NULL || fd->buf->files == NULL) {
+    if (fd->buf == NULL || fd->buf->files == NULL) {
+        werase(fd->win);
+        print_in_middle(fd->win, 0, width, fd->label);
         wrefresh(fd->win);
         return 0;
     }
 
-    /* Initialize variables */
-    getmaxyx(fd->win, height, width);
-
     /* The status bar and display line 
      * Fake the display function to think the height is 2 lines less */
     height -= 2;
+    length = filedlg_length(fd);
 
     /* Set starting line number (center source file if it's small enough) */
-    if (fd->buf->length < height)
-        file = (fd->buf->length - height) / 2;
+    if (length < height)
+        file = (length - height) / 2;
     else {
         file = fd->buf->sel_line - height / 2;
-        if (file > fd->buf->length - height)
-            file = fd->buf->length - height;
+        if (file > length - height)
+            file = length - height;
         else if (file < 0)
             file = 0;
     }
@@ -295,14 +662,14 @@ int filedlg_display(struct filedlg *fd)
     lwidth = (int) log10(fd->buf->length) + 1;
     sprintf(fmt, "%%%dd", lwidth);
 
-    print_in_middle(fd->win, 0, width, label);
+    print_in_middle(fd->win, 0, width, fd->label);
     wmove(fd->win, 0, 0);
 
     for (i = 1; i < height + 1; i++, file++) {
         wmove(fd->win, i, 0);
         if (has_colors()) {
             /* Outside of filename, just finish drawing the vertical file */
-            if (file < 0 || file >= fd->buf->length) {
+            if (file < 0 || file >= length) {
                 int j;
 
                 for (j = 1; j < lwidth; j++)
@@ -326,12 +693,9 @@ int filedlg_display(struct filedlg *fd)
                 waddch(fd->win, '-');
                 waddch(fd->win, '>');
                 wattroff(fd->win, attr);
-                if (fd->buf->cur_line != NULL)
-                    hl_wprintw(fd->win, fd->buf->cur_line, width - lwidth - 2,
-                            fd->buf->sel_col);
-                else
-                    hl_wprintw(fd->win, fd->buf->files[file],
-                            width - lwidth - 2, fd->buf->sel_col);
+                hl_wprintw(fd->win, filedlg_file(fd, file),
+                        find_search ? NULL : fd->buf->cur_line,
+                        width - lwidth - 2, fd->buf->sel_col, tabstop);
             }
             /* Ordinary file */
             else {
@@ -342,15 +706,11 @@ int filedlg_display(struct filedlg *fd)
                 waddch(fd->win, ' ');
 
                 /* No special file information */
-                if (file == fd->buf->sel_line && fd->buf->cur_line != NULL)
-                    hl_wprintw(fd->win, fd->buf->cur_line, width - lwidth - 2,
-                            fd->buf->sel_col);
-                else
-                    hl_wprintw(fd->win, fd->buf->files[file],
-                            width - lwidth - 2, fd->buf->sel_col);
+                hl_wprintw(fd->win, filedlg_file(fd, file), NULL,
+                        width - lwidth - 2, fd->buf->sel_col, tabstop);
             }
-        } else {
-            wprintw(fd->win, "%s\n", fd->buf->files[file]);
+        } else if (file >= 0 && file < length) {
+            wprintw(fd->win, "%s\n", filedlg_file(fd, file));
         }
     }
 
@@ -372,6 +732,9 @@ int filedlg_display(struct filedlg *fd)
         mvwprintw(fd->win, height - 1, 0, "Search:%s", regex_line);
     else if (regex_search)
         mvwprintw(fd->win, height - 1, 0, "RSearch:%s", regex_line);
+    else if (find_search)
+        mvwprintw(fd->win, height - 1, 0, "Find:%s (%d/%d)", find_line,
+                length, fd->buf->length);
 
     wattroff(fd->win, attr);
 
@@ -423,6 +786,7 @@ static int capture_regex(struct filedlg *fd)
     filedlg_display(fd);
 
     do {
+        termout_send();
         c = kui_manager_getkey_blocking(kui_ctx);
 
         if (regex_line_pos == (MAX_LINE - 1) && !(c == CGDB_KEY_ESC || c == 8
@@ -470,6 +834,81 @@ static int capture_regex(struct filedlg *fd)
     return 0;
 }
 
+/* capture_find: Finds files as the user types a fuzzy query.
+ * -------------
+ *  Side Effect: 
+ *
+ *  find_line: The query the user has entered.
+ *  find_line_pos: The next available index into find_line.
+ *
+ *  The files that have the query's characters in order are shown, best
+ *  first. The selected file is kept when the user hits enter.
+ *
+ * Return Value: 0 if user picked a file, otherwise 1.
+ */
+static int capture_find(struct filedlg *fd)
+{
+    int c;
+    extern struct kui_manager *kui_ctx;
+
+    if (filedlg_finder_new(fd) == -1)
+        return 1;
+
+    /* Initialize the query, all of the files match it */
+    fd->finder->sel_line = fd->buf->sel_line;
+    find_search = 1;
+    find_line_pos = 0;
+    find_line[find_line_pos] = '\0';
+    filedlg_find(fd, find_line, find_line_pos, 0);
+    filedlg_display(fd);
+
+    do {
+        termout_send();
+        c = kui_manager_getkey_blocking(kui_ctx);
+
+        /* Quit finding if the user hit escape */
+        if (c == CGDB_KEY_ESC) {
+            find_search = 0;
+            fd->buf->sel_line = fd->finder->sel_line;
+            filedlg_display(fd);
+            return 1;
+        }
+
+        /* If the user hit enter, the selected file is picked */
+        if (c == '\r' || c == '\n' || c == CGDB_KEY_CTRL_M) {
+            find_search = 0;
+
+            if (fd->finder->matches_length == 0) {
+                fd->buf->sel_line = fd->finder->sel_line;
+                filedlg_display(fd);
+                return 1;
+            }
+
+            fd->buf->sel_line = fd->finder->matches[fd->buf->sel_line].file;
+            return 0;
+        }
+
+        if (c == CGDB_KEY_DOWN || c == CGDB_KEY_CTRL_N)
+            filedlg_vscroll(fd, 1);
+        else if (c == CGDB_KEY_UP || c == CGDB_KEY_CTRL_P)
+            filedlg_vscroll(fd, -1);
+        else if (CGDB_BACKSPACE_KEY(c)) {
+            /* The files that matched the shorter query are still there */
+            if (find_line_pos > 0) {
+                find_line[--find_line_pos] = '\0';
+                filedlg_find(fd, find_line, find_line_pos, 0);
+            }
+        } else if (c >= ' ' && c < 127 && find_line_pos < MAX_LINE - 1) {
+            /* Add a char, narrow down the files that matched before */
+            find_line[find_line_pos++] = c;
+            find_line[find_line_pos] = '\0';
+            filedlg_find(fd, find_line, find_line_pos, 1);
+        }
+
+        filedlg_display(fd);
+    } while (1);
+}
+
 int filedlg_recv_char(struct filedlg *fd, int key, char *file)
 {
     int height, width;
@@ -516,6 +955,13 @@ int filedlg_recv_char(struct filedlg *fd, int key, char *file)
             filedlg_search_regex_init(fd);
             capture_regex(fd);
             break;
+        case 'f':
+            /* Finding files, the one picked is opened */
+            if (capture_find(fd) == 0) {
+                strcpy(file, fd->buf->files[fd->buf->sel_line]);
+                return 1;
+            }
+            break;
         case 'n':
             filedlg_search_regex(fd, regex_line, 2, regex_direction, 1);
             break;
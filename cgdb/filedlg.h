@@ -31,6 +31,46 @@ void filedlg_free(struct filedlg *fdlg);
  */
 int filedlg_add_file_choice(struct filedlg *fd, const char *file_choice);
 
+/* filedlg_add_file_choices:  Add many files to the list of source files.
+ * ------------------------
+ *
+ * The choices are sorted once and merged in, it's much faster than adding
+ * them one at a time. Empty choices and duplicates are left out. The
+ * paths are kept interned, see std_intern.
+ *
+ * choices: The paths to add. They're reordered, the ones that were added
+ *          are moved to the front, in order.
+ * count:   The number of paths in choices
+ *
+ * Return Value:  The number of files added, or -1 on error.
+ */
+int filedlg_add_file_choices(struct filedlg *fd, char **choices, int count);
+
+/* filedlg_append_choice:  Add a choice to the end of the list.
+ * ----------------------
+ *
+ * Unlike filedlg_add_file_choice, the choices are kept in the order they
+ * are added, and duplicates are allowed. The text is copied.
+ *
+ * choice: The text of the choice.
+ *
+ * Return Value:  Zero on success, non-zero on error.
+ */
+int filedlg_append_choice(struct filedlg *fd, const char *choice);
+
+/* filedlg_set_label: Sets the line shown above the choices.
+ * __________________
+ */
+void filedlg_set_label(struct filedlg *fd, const char *label);
+
+/* filedlg_selected: Gets the choice that is selected.
+ * _________________
+ *
+ * Return Value:  The index of the choice, in the order they were added
+ *                with filedlg_append_choice, or -1 if there are none.
+ */
+int filedlg_selected(struct filedlg *fd);
+
 /* filedlg_clear: Clears all the file_choice's in the dialog.
  * ______________
  */
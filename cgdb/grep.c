@@ -0,0 +1,586 @@
+/* grep.c:
+ * -------
+ *
+ * Searches the source files of the debugged program.
+ *
+ * The files are handed out one at a time to GREP_THREADS reader threads,
+ * which read each file and search it line by line. Reading is what takes
+ * the time, so there are a few readers even on a single CPU. Each reader
+ * compiles its own copy of the regular expression, since only one thread
+ * at a time can match with each one. Matches are passed back on a
+ * list, and a byte is written down a pipe when the list stops being empty
+ * and when the last reader exits, so the main loop can pick them up.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_CTYPE_H
+#include <ctype.h>
+#endif /* HAVE_CTYPE_H */
+
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif /* HAVE_SYS_TYPES_H */
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif /* HAVE_SYS_STAT_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
+#if HAVE_SIGNAL_H
+#include <signal.h>
+#endif /* HAVE_SIGNAL_H */
+
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
+/* Local Includes */
+#include "grep.h"
+#include "highlight.h"
+#include "rx.h"
+#include "sys_util.h"
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The number of threads reading files */
+#define GREP_THREADS 4
+
+/* The number of lines between checks for a cancelled search */
+#define GREP_CANCEL_LINES 1000
+
+/* Files with a NUL in this many bytes are taken to be binary */
+#define GREP_BINARY_CHECK 1024
+
+/* The longest line kept in a match */
+#define GREP_TEXT_MAX 256
+
+/* A list of matches */
+struct grep_list {
+    struct grep_match *matches;
+    int count;
+    int size;
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+static pthread_mutex_t grep_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int grep_pipe[2] = { -1, -1 };
+
+/* The search. Everything but the members marked as locked is only
+ * changed by the main thread while no reader is running. */
+static struct grep_search {
+    char *regex;                /* The regular expression */
+    int cflags;                 /* The flags it's compiled with */
+    int engine;                 /* The engine it's compiled for */
+    char **files;               /* The files to search */
+    int count;                  /* The number of files */
+    char *loaded;               /* 1 for each file searched in memory */
+
+    pthread_t threads[GREP_THREADS];
+    int threads_count;          /* The readers to join */
+
+    int next;                   /* locked: The next file to read */
+    int running;                /* locked: The readers not done yet */
+    int cancelled;              /* locked: 1 if the readers should stop */
+    struct grep_list found;     /* locked: Matches not collected yet */
+
+    struct grep_list matches;   /* The matches collected by the main loop */
+} grep;
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* grep_notify: Wakes up the main loop.
+ * ------------
+ */
+static void grep_notify(void)
+{
+    char c = 0;
+
+    while (write(grep_pipe[1], &c, 1) == -1 && errno == EINTR)
+        ;
+}
+
+/* grep_cancelled: Determines if the readers should stop.
+ * ---------------
+ */
+static int grep_cancelled(void)
+{
+    int cancelled;
+
+    pthread_mutex_lock(&grep_mutex);
+    cancelled = grep.cancelled;
+    pthread_mutex_unlock(&grep_mutex);
+
+    return cancelled;
+}
+
+/* grep_list_add: Adds a match to a list.
+ * --------------
+ *
+ *   list:    The list
+ *   path:    The file the match is in
+ *   line:    The line number of the match
+ *   text:    The line, it doesn't have to be NUL terminated
+ *   length:  The length of the line
+ */
+static void grep_list_add(struct grep_list *list, const char *path,
+        int line, const char *text, size_t length)
+{
+    struct grep_match *match;
+
+    if (list->count == list->size) {
+        list->size = list->size ? list->size * 2 : 64;
+        list->matches = cgdb_realloc(list->matches,
+                sizeof (struct grep_match) * list->size);
+    }
+
+    while (length > 0 && isspace((unsigned char) *text)) {
+        text++;
+        length--;
+    }
+
+    while (length > 0 && isspace((unsigned char) text[length - 1]))
+        length--;
+
+    if (length > GREP_TEXT_MAX)
+        length = GREP_TEXT_MAX;
+
+    match = &list->matches[list->count++];
+    match->path = path;
+    match->line = line;
+    match->text = cgdb_malloc(length + 1);
+    memcpy(match->text, text, length);
+    match->text[length] = 0;
+}
+
+/* grep_list_move: Moves all the matches of a list to the end of another.
+ * ---------------
+ */
+static void grep_list_move(struct grep_list *to, struct grep_list *from)
+{
+    if (from->count == 0)
+        return;
+
+    if (to->count + from->count > to->size) {
+        to->size = to->count + from->count;
+        to->matches = cgdb_realloc(to->matches,
+                sizeof (struct grep_match) * to->size);
+    }
+
+    memcpy(to->matches + to->count, from->matches,
+            sizeof (struct grep_match) * from->count);
+    to->count += from->count;
+    from->count = 0;
+}
+
+/* grep_list_free: Frees the matches of a list.
+ * ---------------
+ */
+static void grep_list_free(struct grep_list *list)
+{
+    int i;
+
+    for (i = 0; i < list->count; i++)
+        free(list->matches[i].text);
+
+    free(list->matches);
+    list->matches = NULL;
+    list->count = list->size = 0;
+}
+
+/* grep_buffer: Searches a file that's loaded in the source viewer.
+ * ------------
+ *
+ *   regex:  The compiled regular expression
+ *   path:   The file
+ *   buf:    The original buffer of the file
+ *   list:   The list the matches are added to
+ */
+static void grep_buffer(struct rx *regex, const char *path,
+        const struct buffer *buf, struct grep_list *list)
+{
+    const char *text;
+    int i;
+
+    for (i = 0; i < buf->length; i++) {
+        if (!(text = buffer_get_line(buf, i)))
+            continue;
+
+        if (rx_exec(regex, text, 0, NULL, 0) == 0)
+            grep_list_add(list, path, i + 1, text, strlen(text));
+    }
+}
+
+/* grep_read: Reads a whole file.
+ * ----------
+ *
+ *   path:  The file
+ *   size:  Returns the number of bytes read
+ *
+ * Return Value: The contents, NUL terminated, or NULL if the file can't
+ *               be read or isn't a regular file.
+ */
+static char *grep_read(const char *path, size_t *size)
+{
+    struct stat st;
+    char *data;
+    size_t total = 0;
+    ssize_t n;
+    int fd;
+
+    if ((fd = open(path, O_RDONLY)) == -1)
+        return NULL;
+
+    if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode)) {
+        cgdb_close(fd);
+        return NULL;
+    }
+
+    data = cgdb_malloc(st.st_size + 1);
+    while (total < (size_t) st.st_size) {
+        n = read(fd, data + total, st.st_size - total);
+        if (n == -1 && errno == EINTR)
+            continue;
+
+        /* The file shrunk since it was stat'd */
+        if (n <= 0)
+            break;
+
+        total += n;
+    }
+
+    cgdb_close(fd);
+
+    data[total] = 0;
+    *size = total;
+
+    return data;
+}
+
+/* grep_file: Reads and searches a file.
+ * ----------
+ *
+ *   regex:  The reader's copy of the regular expression
+ *   path:   The file
+ *   list:   The list the matches are added to
+ */
+static void grep_file(struct rx *regex, const char *path,
+        struct grep_list *list)
+{
+    char *data, *line, *end;
+    size_t size;
+    int number;
+
+    if ((data = grep_read(path, &size)) == NULL)
+        return;
+
+    if (memchr(data, 0, size < GREP_BINARY_CHECK ? size :
+                    GREP_BINARY_CHECK)) {
+        free(data);
+        return;
+    }
+
+    for (line = data, number = 1; line < data + size; number++) {
+        if ((end = memchr(line, '\n', data + size - line)) == NULL)
+            end = data + size;
+        *end = 0;
+
+        if (rx_exec(regex, line, 0, NULL, 0) == 0)
+            grep_list_add(list, path, number, line, end - line);
+
+        if (number % GREP_CANCEL_LINES == 0 && grep_cancelled())
+            break;
+
+        line = end + 1;
+    }
+
+    free(data);
+}
+
+/* grep_reader: The body of a reader thread.
+ * ------------
+ *
+ * Takes files until there are none left or the search is cancelled, and
+ * hands the matches of each file over when it's done with it.
+ */
+static void *grep_reader(void *arg)
+{
+    struct grep_list list = { NULL, 0, 0 };
+    struct rx *regex;
+    int i;
+
+    regex = rx_compile(grep.regex, grep.cflags, grep.engine);
+
+    for (;;) {
+        pthread_mutex_lock(&grep_mutex);
+
+        if (list.count > 0) {
+            if (grep.found.count == 0)
+                grep_notify();
+            grep_list_move(&grep.found, &list);
+        }
+
+        while (grep.next < grep.count && grep.loaded[grep.next])
+            grep.next++;
+
+        if (regex && !grep.cancelled && grep.next < grep.count)
+            i = grep.next++;
+        else {
+            i = -1;
+            if (--grep.running == 0)
+                grep_notify();
+        }
+
+        pthread_mutex_unlock(&grep_mutex);
+
+        if (i == -1)
+            break;
+
+        grep_file(regex, grep.files[i], &list);
+    }
+
+    free(list.matches);
+    rx_free(regex);
+
+    return NULL;
+}
+
+/* grep_thread_create: Starts a reader.
+ * -------------------
+ *
+ * Signals are left to the main thread, the thread starts with them all
+ * blocked.
+ *
+ * Return Value: 0 on success, an error number otherwise.
+ */
+static int grep_thread_create(pthread_t * thread)
+{
+    sigset_t all, old;
+    int ret;
+
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    ret = pthread_create(thread, NULL, grep_reader, NULL);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    return ret;
+}
+
+/* grep_join: Waits for the readers to exit.
+ * ----------
+ */
+static void grep_join(void)
+{
+    int i;
+
+    for (i = 0; i < grep.threads_count; i++)
+        pthread_join(grep.threads[i], NULL);
+
+    grep.threads_count = 0;
+}
+
+/* grep_clear: Forgets the search and its matches.
+ * -----------
+ */
+static void grep_clear(void)
+{
+    int i;
+
+    for (i = 0; i < grep.count; i++)
+        free(grep.files[i]);
+
+    free(grep.files);
+    free(grep.loaded);
+    free(grep.regex);
+    grep.files = NULL;
+    grep.loaded = NULL;
+    grep.regex = NULL;
+    grep.count = 0;
+
+    grep_list_free(&grep.found);
+    grep_list_free(&grep.matches);
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in grep.h for function descriptions. */
+
+int grep_init(void)
+{
+    if (grep_pipe[0] != -1)
+        return 0;
+
+    if (pipe(grep_pipe) == -1)
+        return -1;
+
+    /* The main loop drains the pipe without waiting on it */
+    fcntl(grep_pipe[0], F_SETFL, fcntl(grep_pipe[0], F_GETFL) | O_NONBLOCK);
+
+    return 0;
+}
+
+int grep_fd(void)
+{
+    return grep_pipe[0];
+}
+
+int grep_start(const char *regex, int icase, int engine, char **files,
+        int count, struct sviewer *sview)
+{
+    const struct buffer *buf;
+    struct rx *compiled;
+    int cflags, readers, i;
+
+    if (grep_pipe[0] == -1)
+        return -1;
+
+    /* The last search's matches go, even if this pattern is invalid, so
+     * they aren't shown as its matches */
+    grep_stop();
+    grep_clear();
+
+    cflags = REG_NOSUB | hl_regex_cflags(icase);
+    if (!(compiled = rx_compile(regex, cflags, engine)))
+        return -1;
+
+    grep.regex = cgdb_strdup(regex);
+    grep.cflags = cflags;
+    grep.engine = engine;
+    grep.files = cgdb_malloc(sizeof (char *) * (count > 0 ? count : 1));
+    grep.loaded = cgdb_calloc(count > 0 ? count : 1, 1);
+    grep.count = count;
+
+    /* The files in memory are searched right away */
+    for (i = 0, readers = 0; i < count; i++) {
+        grep.files[i] = cgdb_strdup(files[i]);
+
+        if ((buf = source_get_buffer(sview, files[i])) != NULL) {
+            grep.loaded[i] = 1;
+            grep_buffer(compiled, grep.files[i], buf, &grep.matches);
+        } else
+            readers++;
+    }
+
+    rx_free(compiled);
+
+    if (readers > GREP_THREADS)
+        readers = GREP_THREADS;
+
+    grep.next = 0;
+    grep.cancelled = 0;
+    grep.running = readers;
+
+    for (i = 0; i < readers; i++)
+        if (grep_thread_create(&grep.threads[grep.threads_count]) == 0)
+            grep.threads_count++;
+
+    if (grep.threads_count < readers) {
+        pthread_mutex_lock(&grep_mutex);
+        grep.running -= readers - grep.threads_count;
+        if (grep.threads_count > 0 && grep.running == 0)
+            grep_notify();
+        pthread_mutex_unlock(&grep_mutex);
+
+        /* Threads can't be started, read the files here instead */
+        if (grep.threads_count == 0 && readers > 0) {
+            grep.running = 1;
+            grep_reader(NULL);
+        }
+    }
+
+    return 0;
+}
+
+int grep_collect(void)
+{
+    char c[64];
+    int running;
+
+    while (read(grep_pipe[0], c, sizeof (c)) > 0)
+        ;
+
+    pthread_mutex_lock(&grep_mutex);
+    grep_list_move(&grep.matches, &grep.found);
+    running = grep.running;
+    pthread_mutex_unlock(&grep_mutex);
+
+    if (running == 0)
+        grep_join();
+
+    return grep.matches.count;
+}
+
+struct grep_match *grep_get(int index)
+{
+    if (index < 0 || index >= grep.matches.count)
+        return NULL;
+
+    return &grep.matches.matches[index];
+}
+
+int grep_busy(void)
+{
+    int running;
+
+    pthread_mutex_lock(&grep_mutex);
+    running = grep.running;
+    pthread_mutex_unlock(&grep_mutex);
+
+    return running > 0;
+}
+
+int grep_files(void)
+{
+    return grep.count;
+}
+
+const char *grep_pattern(void)
+{
+    return grep.regex;
+}
+
+void grep_stop(void)
+{
+    pthread_mutex_lock(&grep_mutex);
+    grep.cancelled = 1;
+    pthread_mutex_unlock(&grep_mutex);
+
+    grep_join();
+
+    /* Nobody is left to hand matches over or to finish the search */
+    pthread_mutex_lock(&grep_mutex);
+    grep.running = 0;
+    pthread_mutex_unlock(&grep_mutex);
+}
@@ -0,0 +1,106 @@
+#ifndef _GREP_H_
+#define _GREP_H_
+
+/* grep.h:
+ * -------
+ *
+ * Searches every source file of the debugged program for a regular
+ * expression. The files are read and searched by a few threads at once,
+ * and the matches are collected by the main loop as they are found.
+ * Files already loaded in the source viewer are searched in memory.
+ *
+ */
+
+/* Local Includes */
+#include "sources.h"
+
+/* --------------- */
+/* Data Structures */
+/* --------------- */
+
+/* A line that matched */
+struct grep_match {
+    const char *path;           /* The file, as it was given to grep_start */
+    int line;                   /* The line number, starting at 1 */
+    char *text;                 /* The line, without its leading blanks */
+};
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* grep_init:  Sets up the pipe the main loop waits on.
+ * ----------
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+int grep_init(void);
+
+/* grep_fd:  Gets the file descriptor that becomes readable when there are
+ * --------  matches to collect, or when a search finishes.
+ *
+ * Return Value: The file descriptor, or -1 if grep_init failed.
+ */
+int grep_fd(void);
+
+/* grep_start:  Starts searching a list of files.
+ * -----------
+ *
+ * The search that was running is cancelled, and its matches are thrown
+ * away, even if the regular expression is invalid.
+ *
+ *   regex:   The regular expression to search for
+ *   icase:   If 1 ignore case
+ *   engine:  The regexpengine to search with, an enum rx_engine
+ *   files:   The files to search, they are copied
+ *   count:   The number of files
+ *   sview:   The source viewer, its loaded files are searched in memory
+ *
+ * Return Value: 0 on success, -1 if the regular expression is invalid.
+ */
+int grep_start(const char *regex, int icase, int engine, char **files,
+        int count, struct sviewer *sview);
+
+/* grep_collect:  Collects the matches found since the last call.
+ * -------------
+ *
+ * Call it when grep_fd is readable.
+ *
+ * Return Value: The total number of matches of the search so far.
+ */
+int grep_collect(void);
+
+/* grep_get:  Gets a match of the search.
+ * ---------
+ *
+ *   index:  The match, from 0 to the number grep_collect returned
+ *
+ * Return Value: The match, or NULL if index is out of range.
+ */
+struct grep_match *grep_get(int index);
+
+/* grep_busy:  Determines if files are still being searched.
+ * ----------
+ *
+ * Return Value: 1 while the search is running, 0 once it's done.
+ */
+int grep_busy(void);
+
+/* grep_files:  Gets the number of files the search is looking through.
+ * -----------
+ */
+int grep_files(void);
+
+/* grep_pattern:  Gets the regular expression of the search.
+ * -------------
+ *
+ * Return Value: The regular expression, or NULL if nothing was searched.
+ */
+const char *grep_pattern(void);
+
+/* grep_stop:  Cancels the search and waits for its threads to exit.
+ * ----------
+ */
+void grep_stop(void);
+
+#endif /* _GREP_H_ */
@@ -14,352 +14,2072 @@
 #include <ctype.h>
 #endif /* HAVE_CTYPE_H */
 
-#if HAVE_LIMITS_H
-#include <limits.h>             /* CHAR_MAX */
-#endif /* HAVE_LIMITS_H */
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif /* HAVE_SYS_TYPES_H */
+
+#if HAVE_REGEX_H
+#include <regex.h>
+#endif /* HAVE_REGEX_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
+#if HAVE_SIGNAL_H
+#include <signal.h>
+#endif /* HAVE_SIGNAL_H */
+
+#if HAVE_SYS_SELECT_H
+#include <sys/select.h>
+#endif /* HAVE_SYS_SELECT_H */
+
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
+/* Local Includes */
+#include "highlight.h"
+#include "highlight_cache.h"
+#include "highlight_groups.h"
+#include "sources.h"
+#include "cgdb.h"
+#include "tokenizer.h"
+#include "interface.h"
+#include "sys_util.h"
+#include "ibuf.h"
+#include "logger.h"
+#include "stats.h"
+#include "tracer.h"
+#include "utf8.h"
+#include "symbols.h"
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The number of compiled regular expressions kept around */
+#define HL_REGEX_CACHE 8
+
+/* The most threads that highlight files at the same time */
+#define HL_WORKER_THREADS 8
+
+/* The most threads a search is split up between */
+#define HL_SEARCH_THREADS 8
+
+/* The number of lines the search threads take at a time */
+#define HL_SEARCH_CHUNK 1024
+
+/* Lines at least this long get checkpoints for horizontal scrolling */
+#define HL_CHECKPOINT_LINE 1024
+
+/* The number of columns between checkpoints */
+#define HL_CHECKPOINT_STEP 256
+
+/* The number of long lines that keep their checkpoints */
+#define HL_CHECKPOINT_LINES 64
+
+/* How many lines the worker highlights between checks that its job is
+ * still wanted */
+#define HL_CANCEL_LINES 1000
+
+/* The number of lines between the tokenizer states that are kept */
+#define HL_STATE_LINES 256
+
+/* Longer identifiers aren't put in the symbol index */
+#define HL_SYMBOL_MAX 256
+
+/* A highlighted line being built */
+struct hl_line {
+    int col;                    /* Characters in the line so far */
+    struct hl_run *runs;        /* The runs found so far */
+    int count;                  /* Number of runs found */
+    int size;                   /* Number of runs allocated */
+};
+
+/* The highlighting of a file from before it was reloaded */
+struct hl_previous {
+    enum tokenizer_language_support language;
+    struct buffer orig;         /* The old lines, until they're compared */
+    struct buffer buf;          /* Their highlighting */
+    int length;                 /* The number of old lines */
+    struct hl_state *states;    /* The states at the start of some of them */
+    int state_count;
+    struct symbols *symbols;    /* Their symbol index, or NULL */
+};
+
+/* The symbol index being built from the tokens, see hl_symbols_token */
+struct hl_symbols {
+    struct symbols_builder *builder;    /* NULL if none is built */
+    enum tokenizer_language_support language;
+    int depth;                  /* The braces the tokens are in */
+    int names;                  /* Set after a keyword like func, the next
+                                 * identifier is defined there */
+    int tag;                    /* Set after struct, union, enum or class */
+
+    /* The last identifier, until the token after it tells if it's defined
+     * there */
+    char name[HL_SYMBOL_MAX];
+    int length;                 /* 0 if there's none */
+    int line, col;
+    int pending_tag;            /* Set if it came after tag */
+};
+
+/* A file being highlighted by a worker thread */
+struct hl_job {
+    struct list_node *node;     /* The node, NULL once it's cancelled */
+    enum tokenizer_language_support language;
+    char *text;                 /* A copy of the file's contents */
+    size_t size;                /* The number of bytes in text */
+    int length;                 /* The number of lines in the node */
+    struct buffer buf;          /* The highlighting, built by the worker */
+    int failed;                 /* Set if the file couldn't be tokenized */
+
+    /* Set if statistics were being recorded or the timeline kept when the
+     * job was made, and so when highlighting started and how long it took
+     * are kept */
+    int timed;
+    unsigned long long started;
+    unsigned long long usec;
+
+    /* The states recorded along the way, see HL_STATE_LINES */
+    struct hl_state *states;
+    int state_count;
+    int state_size;
+
+    /* The file before it was reloaded, or NULL. Only the lines from
+     * same_start to length - same_end changed. */
+    struct hl_previous *previous;
+    int same_start;
+    int same_end;
+
+    /* The symbol index, built along with the highlighting. It's NULL if
+     * the lines kept from before the reload had none. */
+    struct hl_symbols sym;
+    struct symbols *symbols;
+
+    struct hl_job *next;
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+/* The workers, one per processor. The lists of jobs, and the node of
+ * each job on them, are protected by hl_mutex. */
+static pthread_t hl_threads[HL_WORKER_THREADS];
+static int hl_worker_running;   /* The number of workers started */
+static pthread_mutex_t hl_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t hl_cond = PTHREAD_COND_INITIALIZER;  /* hl_todo grew */
+static int hl_pipe[2] = { -1, -1 };     /* A byte per finished job */
+
+static struct hl_job *hl_todo;  /* Jobs waiting for a worker, in order */
+static struct hl_job *hl_running;       /* Jobs the workers are on */
+static struct hl_job *hl_done;  /* Jobs waiting for the main loop */
+
+/* The compiled regular expressions, see hl_regex_compile */
+static struct hl_regex_entry {
+    char *regex;                /* The expression, NULL if unused */
+    int cflags;                 /* The flags it was compiled with */
+    int engine;                 /* The regexpengine it was compiled for */
+    struct rx *t;
+    unsigned long used;         /* When it was last used */
+} hl_regex_cache[HL_REGEX_CACHE];
+static unsigned long hl_regex_tick;
+
+/* The search pool, which splits up searches of big files. Everything in
+ * it is protected by hl_pool_mutex. */
+static pthread_mutex_t hl_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t hl_pool_cond = PTHREAD_COND_INITIALIZER;   /* search */
+static pthread_cond_t hl_pool_idle = PTHREAD_COND_INITIALIZER;   /* busy */
+static struct {
+    pthread_t threads[HL_SEARCH_THREADS];
+    int count;                  /* The number of threads started */
+    int pipe[2];                /* Written to when a search is done */
+    unsigned long search;       /* Bumped for each search handed out */
+
+    /* The search being done, see hl_search_parallel */
+    const char *regex;
+    int cflags, engine;
+    hl_get_line get_line;
+    void *data;
+    int length, start, col, direction, first;
+    int next;                   /* The next chunk to hand out */
+    int best;                   /* The nearest match so far, or total */
+    int busy;                   /* The threads still on the search */
+    int cancelled;              /* Set when a key is pressed */
+} hl_pool;
+
+/* Cancels a search split up between the pool when it's readable */
+static int hl_interrupt_fd = -1;
+
+/* The last incremental search. While more is typed, the search picks up
+ * at the line it got to. */
+static struct {
+    char *regex;                /* The expression, NULL if there's none */
+    void *data;                 /* What was searched */
+    int length, start, col, direction, icase;
+    int skip;                   /* Lines, in search order, with no match */
+} hl_search;
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+static struct hl_line *hl_line_new(void)
+{
+    return cgdb_calloc(1, sizeof (struct hl_line));
+}
+
+static void hl_line_free(struct hl_line *line)
+{
+    if (line) {
+        free(line->runs);
+        free(line);
+    }
+}
+
+/* hl_line_add: Adds a run to the end of a line.
+ * ------------
+ */
+static void hl_line_add(struct hl_line *line, int start, int length,
+        enum hl_group_kind group)
+{
+    if (line->count == line->size) {
+        line->size = line->size ? line->size * 2 : 16;
+        line->runs = cgdb_realloc(line->runs,
+                sizeof (struct hl_run) * line->size);
+    }
+
+    line->runs[line->count].start = start;
+    line->runs[line->count].length = length;
+    line->runs[line->count].group = group;
+    line->count++;
+}
+
+/* highlight_new_line: Starts building a new highlighted line.
+ * -------------------
+ */
+static void highlight_new_line(struct hl_line *line)
+{
+    line->col = 0;
+    line->count = 0;
+}
+
+/* hl_previous_free: Frees the highlighting from before a reload.
+ * -----------------
+ */
+static void hl_previous_free(struct hl_previous *previous)
+{
+    if (previous) {
+        free(previous->orig.lines);
+        free(previous->orig.bases);
+        free(previous->orig.text);
+        free(previous->buf.lines);
+        free(previous->buf.bases);
+        free(previous->buf.runs);
+        free(previous->states);
+        symbols_free(previous->symbols);
+        free(previous);
+    }
+}
+
+/* hl_job_add_state: Records the state the tokenizer starts a line in.
+ * -----------------
+ */
+static void hl_job_add_state(struct hl_job *job, int line, int state)
+{
+    if (job->state_count == job->state_size) {
+        job->state_size = job->state_size ? job->state_size * 2 : 16;
+        job->states = cgdb_realloc(job->states,
+                sizeof (struct hl_state) * job->state_size);
+    }
+
+    job->states[job->state_count].line = line;
+    job->states[job->state_count].state = state;
+    job->state_count++;
+}
+
+/* hl_copy_lines: Copies the runs of some lines from one buffer to another.
+ * --------------
+ *
+ *   to:     The buffer to copy to
+ *   line:   The line of to that gets the first one
+ *   from:   The buffer to copy from
+ *   start:  The first line to copy
+ *   end:    One past the last line to copy
+ */
+static void hl_copy_lines(struct buffer *to, int line,
+        const struct buffer *from, int start, int end)
+{
+    const struct hl_run *runs;
+    int count;
+
+    for (; start < end; start++, line++) {
+        if ((runs = buffer_get_runs(from, start))) {
+            for (count = 0; runs[count].length > 0; count++)
+                ;
+            buffer_set_runs(to, line, runs, count);
+        }
+    }
+}
+
+/* highlight_token: Adds the current token to the line being built.
+ * ----------------
+ *
+ *   t:     The tokenizer holding the token
+ *   line:  The line being built
+ *
+ * Return Value: 1 if the token ended the line, 0 if not, -1 on error.
+ */
+static int highlight_token(struct tokenizer *t, struct hl_line *line)
+{
+    enum tokenizer_type e = tokenizer_get_packet_type(t);
+    enum hl_group_kind group;
+    int length;
+
+    /*if_print_message  ( "TOKEN(%d:%s)\n", e, tokenizer_get_printable_enum ( e ) ); */
+
+    switch (e) {
+        case TOKENIZER_KEYWORD:
+            group = HLG_KEYWORD;
+            break;
+        case TOKENIZER_TYPE:
+            group = HLG_TYPE;
+            break;
+        case TOKENIZER_LITERAL:
+            group = HLG_LITERAL;
+            break;
+        case TOKENIZER_COMMENT:
+            group = HLG_COMMENT;
+            break;
+        case TOKENIZER_DIRECTIVE:
+            group = HLG_DIRECTIVE;
+            break;
+        case TOKENIZER_NUMBER:
+        case TOKENIZER_TEXT:
+        case TOKENIZER_ERROR:
+            line->col += tokenizer_get_length(t);
+            return 0;
+        case TOKENIZER_NEWLINE:
+            return 1;
+        default:
+            return -1;
+    }
+
+    length = tokenizer_get_length(t);
+    if (length > 0)
+        hl_line_add(line, line->col, length, group);
+    line->col += length;
+
+    return 0;
+}
+
+/* hl_symbols_flush: Adds the last identifier to the symbol index.
+ * -----------------
+ *
+ *   sym:         The index being built
+ *   definition:  1 if it's defined there, 0 otherwise
+ */
+static void hl_symbols_flush(struct hl_symbols *sym, int definition)
+{
+    if (sym->length > 0)
+        symbols_add(sym->builder, sym->name, sym->length, sym->line,
+                sym->col, definition);
+    sym->length = 0;
+}
+
+/* hl_symbols_keyword: Notes what a keyword says about the next identifier.
+ * -------------------
+ */
+static void hl_symbols_keyword(struct hl_symbols *sym, const char *word)
+{
+    static const char *tags[] = { "struct", "union", "enum", "class", NULL };
+    static const char *names[] = {
+        "#define", "func", "type", "subtype", "procedure", "function",
+        "package", "task", "protected", NULL
+    };
+    int i;
+
+    sym->tag = sym->names = 0;
+
+    for (i = 0; tags[i]; i++)
+        if (strcmp(word, tags[i]) == 0)
+            sym->tag = 1;
+
+    /* Ada doesn't care about the case of its keywords */
+    for (i = 0; names[i]; i++)
+        if (strcasecmp(word, names[i]) == 0)
+            sym->names = 1;
+}
+
+/* hl_symbols_token: Adds what the current token says to the symbol index.
+ * -----------------
+ *
+ * An identifier is added once the token after it is seen, which tells if
+ * it looks like where it's defined.
+ *
+ *   sym:   The index being built
+ *   t:     The tokenizer holding the token
+ *   line:  The line the token is on
+ *   col:   The byte of the line it starts at
+ */
+static void hl_symbols_token(struct hl_symbols *sym, struct tokenizer *t,
+        int line, int col)
+{
+    enum tokenizer_type e = tokenizer_get_packet_type(t);
+    const char *data = tokenizer_get_data(t);
+    unsigned char c = data ? data[0] : '\0';
+    int length;
+
+    if (!sym->builder || !data)
+        return;
+
+    switch (e) {
+        case TOKENIZER_TEXT:
+            if (isspace(c))
+                return;
+
+            if (isalpha(c) || c == '_') {
+                hl_symbols_flush(sym, 0);
+
+                length = tokenizer_get_length(t);
+                if (length >= HL_SYMBOL_MAX) {
+                    sym->tag = sym->names = 0;
+                    return;
+                }
+
+                memcpy(sym->name, data, length);
+                sym->length = length;
+                sym->line = line;
+                sym->col = col;
+                sym->pending_tag = sym->tag;
+
+                if (sym->names)
+                    hl_symbols_flush(sym, 1);
+                sym->tag = sym->names = 0;
+                return;
+            }
+
+            /* A name of a function outside of any braces is defined there,
+             * Ada calls look the same as its definitions */
+            hl_symbols_flush(sym, (c == '{' && sym->pending_tag) ||
+                    (c == '(' && sym->depth == 0 && !sym->pending_tag &&
+                            sym->language != TOKENIZER_LANGUAGE_ADA));
+
+            if (c == '{')
+                sym->depth++;
+            else if (c == '}' && sym->depth > 0)
+                sym->depth--;
+            sym->tag = sym->names = 0;
+            break;
+        case TOKENIZER_KEYWORD:
+        case TOKENIZER_TYPE:
+        case TOKENIZER_DIRECTIVE:
+            hl_symbols_flush(sym, 0);
+            hl_symbols_keyword(sym, data);
+            break;
+        case TOKENIZER_NEWLINE:
+            /* A #define ends with its line */
+            if (sym->names && sym->language != TOKENIZER_LANGUAGE_ADA)
+                sym->names = 0;
+            break;
+        default:
+            hl_symbols_flush(sym, 0);
+            sym->tag = sym->names = 0;
+            break;
+    }
+}
+
+/* highlight_share_lines: Makes every line of the node be drawn plain.
+ * ----------------------
+ */
+static void highlight_share_lines(struct list_node *node)
+{
+    free(node->buf.lines);
+    free(node->buf.bases);
+    free(node->buf.text);
+    free(node->buf.runs);
+    node->buf.lines = NULL;
+    node->buf.bases = NULL;
+    node->buf.text = NULL;
+    node->buf.runs = NULL;
+    node->buf.used = 0;
+    node->buf.size = 0;
+    node->buf.length = node->orig_buf.length;
+    node->buf.max_width = node->orig_buf.max_width;
+}
+
+/* highlight_join_lines: Rebuilds the text of some lines of the node.
+ * ---------------------
+ *
+ *   node:  The node containing the original lines
+ *   start: The first line to get
+ *   end:   One past the last line to get
+ *
+ * Return Value: The text, which must be freed with ibuf_free.
+ */
+static struct ibuf *highlight_join_lines(struct list_node *node,
+        int start, int end)
+{
+    struct ibuf *text = ibuf_init();
+    const char *line;
+    int i;
+
+    for (i = start; i < end; i++) {
+        line = buffer_get_line(&node->orig_buf, i);
+        ibuf_addn(text, line, strlen(line));
+        ibuf_addchar(text, '\n');
+    }
+
+    return text;
+}
+
+/* highlight_range: Highlights some lines of a node on their own.
+ * ----------------
+ *
+ * The lines get a tokenizer of their own, so this runs in the main thread
+ * while the workers have theirs. The scan starts with no context, so the
+ * lines may be highlighted wrong if they start inside of a comment, until
+ * the worker's highlighting of the whole file replaces them.
+ *
+ *   node:  The node to highlight
+ *   start: The first line to highlight
+ *   end:   One past the last line to highlight
+ */
+static void highlight_range(struct list_node *node, int start, int end)
+{
+    struct tokenizer *t;
+    struct hl_line *line;
+    struct ibuf *text;
+    int ret, line_no = start;
+
+    if (start < 0)
+        start = line_no = 0;
+    if (end > node->orig_buf.length)
+        end = node->orig_buf.length;
+    if (start >= end)
+        return;
+
+    buffer_set_length(&node->buf, node->orig_buf.length, 0);
+    node->buf.max_width = node->orig_buf.max_width;
+
+    text = highlight_join_lines(node, start, end);
+    t = tokenizer_init();
+    line = hl_line_new();
+
+    if (tokenizer_set_buffer(t, ibuf_get(text), ibuf_length(text),
+                    node->language) == 0) {
+        while (tokenizer_get_token(t) > 0 && line_no < end) {
+            if ((ret = highlight_token(t, line)) == -1)
+                break;
+
+            if (ret == 1) {
+                buffer_set_runs(&node->buf, line_no++, line->runs,
+                        line->count);
+                highlight_new_line(line);
+            }
+        }
+    }
+
+    tokenizer_destroy(t);
+    hl_line_free(line);
+    ibuf_free(text);
+}
+
+/* hl_thread_create: Starts a thread.
+ * -----------------
+ *
+ * Signals are left to the main thread, the thread starts with them all
+ * blocked.
+ *
+ * Return Value: 0 on success, an error number otherwise.
+ */
+static int hl_thread_create(pthread_t * thread, void *(*start) (void *))
+{
+    sigset_t all, old;
+    int ret;
+
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    ret = pthread_create(thread, NULL, start, NULL);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    return ret;
+}
+
+/* hl_job_new: Creates a job to highlight a node.
+ * -----------
+ *
+ * The job gets its own copy of the text, the worker never touches the
+ * node, since the node can be unloaded while the job runs.
+ *
+ *   node:  The node to highlight
+ *   data:  The contents of the file, or NULL to rebuild them from the lines
+ *   size:  The number of bytes in data
+ */
+static struct hl_job *hl_job_new(struct list_node *node, const char *data,
+        size_t size)
+{
+    struct hl_job *job = cgdb_calloc(1, sizeof (struct hl_job));
+    struct ibuf *text;
+
+    job->node = node;
+    job->language = node->language;
+    job->length = node->orig_buf.length;
+    job->timed = stats_enabled || tracer_enabled;
+
+    /* Only the lines that changed since the reload need tokenizing, and
+     * the lines around them until the tokenizer is back in step */
+    if (node->hl_previous && node->hl_previous->language == node->language) {
+        struct hl_previous *previous = node->hl_previous;
+        int same = previous->length < job->length ?
+                previous->length : job->length;
+        const char *a, *b;
+
+        while (job->same_start < same) {
+            a = buffer_get_line(&previous->orig, job->same_start);
+            b = buffer_get_line(&node->orig_buf, job->same_start);
+            if (!a || !b || strcmp(a, b) != 0)
+                break;
+            job->same_start++;
+        }
+
+        while (job->same_start + job->same_end < same) {
+            a = buffer_get_line(&previous->orig,
+                    previous->length - job->same_end - 1);
+            b = buffer_get_line(&node->orig_buf,
+                    job->length - job->same_end - 1);
+            if (!a || !b || strcmp(a, b) != 0)
+                break;
+            job->same_end++;
+        }
+
+        /* The worker doesn't need the old text */
+        free(previous->orig.lines);
+        free(previous->orig.bases);
+        free(previous->orig.text);
+        memset(&previous->orig, 0, sizeof (struct buffer));
+
+        job->previous = previous;
+        node->hl_previous = NULL;
+    }
+
+    /* The lines a reload didn't change keep their symbols, there's no
+     * index without them */
+    if (!job->previous || job->previous->symbols)
+        job->sym.builder = symbols_builder_new();
+    job->sym.language = job->language;
+
+    if (data) {
+        job->text = cgdb_malloc(size > 0 ? size : 1);
+        memcpy(job->text, data, size);
+        job->size = size;
+    } else {
+        text = highlight_join_lines(node, 0, node->orig_buf.length);
+        job->size = ibuf_length(text);
+        job->text = ibuf_steal(text);
+        ibuf_free(text);
+    }
+
+    return job;
+}
+
+static void hl_job_free(struct hl_job *job)
+{
+    hl_previous_free(job->previous);
+    symbols_builder_free(job->sym.builder);
+    symbols_free(job->symbols);
+    free(job->states);
+    free(job->text);
+    free(job->buf.lines);
+    free(job->buf.bases);
+    free(job->buf.text);
+    free(job->buf.runs);
+    free(job);
+}
+
+/* hl_job_append: Adds a job to the end of a list of jobs.
+ * --------------
+ */
+static void hl_job_append(struct hl_job **list, struct hl_job *job)
+{
+    while (*list)
+        list = &(*list)->next;
+
+    job->next = NULL;
+    *list = job;
+}
+
+/* hl_job_cancel: Drops the jobs in a list that belong to a node.
+ * --------------
+ */
+static void hl_job_cancel(struct hl_job **list, struct list_node *node)
+{
+    struct hl_job *job;
+
+    while (*list) {
+        if ((*list)->node == node) {
+            job = *list;
+            *list = job->next;
+            hl_job_free(job);
+        } else
+            list = &(*list)->next;
+    }
+}
+
+/* highlight_cancelled: Determines if a job's node still wants it.
+ * --------------------
+ */
+static int highlight_cancelled(struct hl_job *job)
+{
+    int cancelled;
+
+    pthread_mutex_lock(&hl_mutex);
+    cancelled = job->node == NULL;
+    pthread_mutex_unlock(&hl_mutex);
+
+    return cancelled;
+}
+
+/* highlight_resume: Keeps the highlighting of the lines at the top of the
+ * -----------------  file that a reload didn't change.
+ *
+ * The runs and states of the lines before the last state recorded ahead
+ * of the first change are copied.
+ *
+ *   job:    The job
+ *   state:  Set to the state the tokenizer starts over in
+ *
+ * Return Value: The line the tokenizer starts over at.
+ */
+static int highlight_resume(struct hl_job *job, int *state)
+{
+    struct hl_previous *previous = job->previous;
+    int i, k = -1;
+
+    *state = 0;
+    if (!previous)
+        return 0;
+
+    for (i = 0; i < previous->state_count &&
+            previous->states[i].line <= job->same_start; i++)
+        k = i;
+
+    if (k == -1)
+        return 0;
+
+    for (i = 0; i < k; i++)
+        hl_job_add_state(job, previous->states[i].line,
+                previous->states[i].state);
+
+    hl_copy_lines(&job->buf, 0, &previous->buf, 0, previous->states[k].line);
+    if (job->sym.builder)
+        symbols_copy(job->sym.builder, previous->symbols, 0,
+                previous->states[k].line, 0);
+    *state = previous->states[k].state;
+
+    return previous->states[k].line;
+}
+
+/* highlight_converge: Keeps the highlighting of the lines at the end of the
+ * -------------------  file that a reload didn't change.
+ *
+ * Once the tokenizer starts one of those lines in the state it started
+ * it in before, the rest of the file tokenizes like it did before, so
+ * the runs and states from there on are copied instead.
+ *
+ *   job:    The job
+ *   line:   The line the tokenizer is at the start of
+ *   state:  The state it's in
+ *   old:    The first state of the old file that may still match, it's
+ *           0 at first and kept from one call to the next
+ *
+ * Return Value: 1 if the rest of the file was copied, 0 otherwise.
+ */
+static int highlight_converge(struct hl_job *job, int line, int state,
+        int *old)
+{
+    struct hl_previous *previous = job->previous;
+    int delta, i;
+
+    if (!previous || line < job->length - job->same_end)
+        return 0;
+
+    /* The line was at line - delta before the file changed */
+    delta = job->length - previous->length;
+    while (*old < previous->state_count &&
+            previous->states[*old].line + delta < line)
+        (*old)++;
+
+    if (*old == previous->state_count ||
+            previous->states[*old].line + delta != line ||
+            previous->states[*old].state != state)
+        return 0;
+
+    hl_copy_lines(&job->buf, line, &previous->buf, line - delta,
+            previous->length);
+    if (job->sym.builder) {
+        hl_symbols_flush(&job->sym, 0);
+        symbols_copy(job->sym.builder, previous->symbols, line - delta,
+                previous->length, delta);
+    }
+    for (i = *old; i < previous->state_count; i++)
+        hl_job_add_state(job, previous->states[i].line + delta,
+                previous->states[i].state);
+
+    return 1;
+}
+
+/* highlight_work: Highlights the text of a job into the job's buffer.
+ * ---------------
+ *
+ * This runs in a worker thread, so it may only touch the job.
+ *
+ * Return Value: 0 on success, -1 on error or if the job was cancelled.
+ *               job->failed is set on error.
+ */
+static int highlight_work(struct hl_job *job)
+{
+    struct tokenizer *t = tokenizer_init();
+    struct hl_line *line = hl_line_new();
+    const char *text = job->text, *end = job->text + job->size;
+    int ret, line_no, state, last, old = 0, i;
+
+    buffer_set_length(&job->buf, job->length, 0);
+
+    /* Tokenizing starts at the top, or where a reload changed the file */
+    line_no = highlight_resume(job, &state);
+    for (i = 0; i < line_no && text < end; i++) {
+        text = memchr(text, '\n', end - text);
+        text = text ? text + 1 : end;
+    }
+
+    if (tokenizer_set_buffer(t, text, end - text, job->language) == -1 ||
+            tokenizer_set_state(t, state) == -1) {
+        job->failed = 1;
+        tokenizer_destroy(t);
+        hl_line_free(line);
+        return -1;
+    }
+
+    hl_job_add_state(job, line_no, state);
+    last = line_no;
+
+    while ((ret = tokenizer_get_token(t)) > 0) {
+        hl_symbols_token(&job->sym, t, line_no, line->col);
+
+        if ((ret = highlight_token(t, line)) == -1) {
+            job->failed = 1;
+            break;
+        }
+
+        if (ret == 1) {
+            buffer_set_runs(&job->buf, line_no++, line->runs, line->count);
+            highlight_new_line(line);
+
+            state = tokenizer_get_state(t);
+            if (highlight_converge(job, line_no, state, &old)) {
+                line->col = 0;
+                ret = 0;
+                break;
+            }
+
+            if (line_no - last >= HL_STATE_LINES) {
+                hl_job_add_state(job, line_no, state);
+                last = line_no;
+            }
+
+            /* Don't finish a file nobody is waiting for */
+            if (line_no % HL_CANCEL_LINES == 0 && highlight_cancelled(job)) {
+                ret = -1;
+                break;
+            }
+        }
+    }
+
+    /* The last line didn't end in a newline */
+    if (ret == 0 && line->col > 0)
+        buffer_set_runs(&job->buf, line_no, line->runs, line->count);
+
+    if (ret == 0 && job->sym.builder) {
+        hl_symbols_flush(&job->sym, 0);
+        job->symbols = symbols_finish(job->sym.builder);
+        job->sym.builder = NULL;
+    }
+
+    tokenizer_destroy(t);
+    hl_line_free(line);
+
+    return ret;
+}
+
+/* highlight_timed_work: Does highlight_work, timing it if the job is timed.
+ * ---------------------
+ */
+static int highlight_timed_work(struct hl_job *job)
+{
+    int ret;
+
+    if (job->timed)
+        job->started = stats_clock();
+
+    ret = highlight_work(job);
+
+    if (job->timed)
+        job->usec = stats_clock() - job->started;
+
+    return ret;
+}
+
+/* hl_job_remove: Takes a job off of a list of jobs.
+ * --------------
+ */
+static void hl_job_remove(struct hl_job **list, struct hl_job *job)
+{
+    while (*list && *list != job)
+        list = &(*list)->next;
+
+    if (*list)
+        *list = job->next;
+    job->next = NULL;
+}
+
+/* highlight_worker: A worker thread, highlights jobs as they come in.
+ * -----------------
+ *
+ * Each job gets a tokenizer of its own, so the workers highlight as
+ * many files at once as there are of them.
+ */
+static void *highlight_worker(void *arg)
+{
+    struct hl_job *job;
+    char c = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&hl_mutex);
+        while (!hl_todo)
+            pthread_cond_wait(&hl_cond, &hl_mutex);
+
+        job = hl_todo;
+        hl_todo = job->next;
+        job->next = hl_running;
+        hl_running = job;
+        pthread_mutex_unlock(&hl_mutex);
+
+        highlight_timed_work(job);
+
+        pthread_mutex_lock(&hl_mutex);
+        hl_job_remove(&hl_running, job);
+        if (job->node)
+            hl_job_append(&hl_done, job);
+        else
+            hl_job_free(job);
+        pthread_mutex_unlock(&hl_mutex);
+
+        /* Wake up the main loop */
+        while (write(hl_pipe[1], &c, 1) == -1 && errno == EINTR)
+            ;
+    }
+
+    return NULL;
+}
+
+/* highlight_install: Gives the node of a finished job its highlighting.
+ * ------------------
+ */
+static void highlight_install(struct hl_job *job)
+{
+    static struct stats_histogram stats_file =
+            STATS_HISTOGRAM("highlight file");
+    static struct stats_counter stats_bytes =
+            STATS_COUNTER("highlight bytes");
+    struct list_node *node = job->node;
+
+    node->hl_lazy = 0;
+
+    if (job->timed) {
+        stats_record(&stats_file, job->usec);
+        STATS_ADD(&stats_bytes, job->size);
+        tracer_span("highlight", TRACER_LANE_HIGHLIGHT, job->started,
+                job->usec, node->path);
+    }
+
+    if (job->failed) {
+        if_print_message("%s:%d could not highlight %s", __FILE__,
+                __LINE__, node->path);
+        return;
+    }
+
+    /* The node takes over the job's offsets and runs */
+    free(node->buf.lines);
+    free(node->buf.bases);
+    free(node->buf.text);
+    free(node->buf.runs);
+    node->buf.length = job->buf.length;
+    node->buf.lines = job->buf.lines;
+    node->buf.bases = job->buf.bases;
+    node->buf.text = NULL;
+    node->buf.runs = job->buf.runs;
+    node->buf.used = job->buf.used;
+    node->buf.size = job->buf.size;
+    node->buf.max_width = node->orig_buf.max_width;
+
+    job->buf.lines = NULL;
+    job->buf.bases = NULL;
+    job->buf.runs = NULL;
+
+    /* And the states, for the next time the file is reloaded */
+    free(node->hl_states);
+    node->hl_states = job->states;
+    node->hl_state_count = job->state_count;
+    job->states = NULL;
+    job->state_count = 0;
+
+    /* The symbol index, which highlight_symbols builds if there's none */
+    symbols_free(node->symbols);
+    node->symbols = job->symbols;
+    job->symbols = NULL;
+
+    hl_cache_save(node);
+}
+
+/* highlight_submit: Hands a node to the workers to be highlighted.
+ * -----------------
+ *
+ * The node is drawn plain until the job is done. Without workers the
+ * node is highlighted right away instead.
+ */
+static void highlight_submit(struct list_node *node, const char *data,
+        size_t size)
+{
+    struct hl_job *job;
+
+    highlight_stop(node);
+    job = hl_job_new(node, data, size);
+
+    if (!hl_worker_running) {
+        if (highlight_timed_work(job) == 0 || job->failed)
+            highlight_install(job);
+        hl_job_free(job);
+        return;
+    }
+
+    node->hl_lazy = 2;
+
+    pthread_mutex_lock(&hl_mutex);
+    hl_job_append(&hl_todo, job);
+    pthread_cond_signal(&hl_cond);
+    pthread_mutex_unlock(&hl_mutex);
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in highlight.h for function descriptions. */
+
+int highlight_init(void)
+{
+    long processors;
+    int i;
+
+    if (hl_worker_running)
+        return 0;
+
+    processors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (processors < 1)
+        processors = 1;
+    if (processors > HL_WORKER_THREADS)
+        processors = HL_WORKER_THREADS;
+
+    if (pipe(hl_pipe) == -1)
+        return -1;
+
+    /* The main loop drains the pipe without waiting on it */
+    fcntl(hl_pipe[0], F_SETFL, fcntl(hl_pipe[0], F_GETFL) | O_NONBLOCK);
+
+    for (i = 0; i < processors; i++)
+        if (hl_thread_create(&hl_threads[i], highlight_worker) != 0)
+            break;
+
+    if (i == 0) {
+        cgdb_close(hl_pipe[0]);
+        cgdb_close(hl_pipe[1]);
+        hl_pipe[0] = hl_pipe[1] = -1;
+        return -1;
+    }
+
+    hl_worker_running = i;
+
+    return 0;
+}
+
+int highlight_fd(void)
+{
+    return hl_pipe[0];
+}
+
+void highlight(struct list_node *node, const char *data, size_t size)
+{
+    /* Every line is drawn plain until the worker is done with them */
+    highlight_stop(node);
+    highlight_share_lines(node);
+    symbols_free(node->symbols);
+    node->symbols = NULL;
+    node->hl_lazy = 0;
+
+    /* Just use the lines from the original buffer if no highlighting 
+     * is possible */
+    if (node->language != TOKENIZER_LANGUAGE_UNKNOWN)
+        highlight_submit(node, data, size);
+}
+
+void highlight_lazy(struct list_node *node)
+{
+    if (node->language == TOKENIZER_LANGUAGE_UNKNOWN) {
+        highlight(node, NULL, 0);
+        return;
+    }
+
+    /* Every line starts out unhighlighted */
+    highlight_share_lines(node);
+    node->hl_lazy = 1;
+}
+
+void highlight_start(struct list_node *node, int start, int end)
+{
+    if (node->hl_lazy != 1)
+        return;
+
+    /* Get something on the screen before the worker gets to the file */
+    if (hl_worker_running)
+        highlight_range(node, start, end);
+
+    highlight_submit(node, NULL, 0);
+}
+
+int highlight_busy(void)
+{
+    int busy;
+
+    pthread_mutex_lock(&hl_mutex);
+    busy = hl_todo || hl_running || hl_done;
+    pthread_mutex_unlock(&hl_mutex);
+
+    return busy;
+}
+
+int highlight_idle(void)
+{
+    struct hl_job *job;
+    int jobs = 0;
+
+    pthread_mutex_lock(&hl_mutex);
+    for (job = hl_todo; job; job = job->next)
+        jobs++;
+    for (job = hl_running; job; job = job->next)
+        jobs++;
+    pthread_mutex_unlock(&hl_mutex);
+
+    return jobs < hl_worker_running;
+}
+
+struct list_node *highlight_finish(void)
+{
+    struct list_node *node;
+    struct hl_job *job;
+    char c[64];
+
+    if (!hl_worker_running)
+        return NULL;
+
+    /* One byte was written for each job, they're all read below */
+    while (read(hl_pipe[0], c, sizeof (c)) > 0)
+        ;
+
+    pthread_mutex_lock(&hl_mutex);
+    if ((job = hl_done))
+        hl_done = job->next;
+    pthread_mutex_unlock(&hl_mutex);
+
+    if (!job)
+        return NULL;
+
+    /* Jobs are only put on the done list while their nodes want them */
+    node = job->node;
+    highlight_install(job);
+    hl_job_free(job);
 
-#if HAVE_STRING_H
-#include <string.h>
-#endif /* HAVE_STRING_H */
+    return node;
+}
 
-#if HAVE_STDLIB_H
-#include <stdlib.h>
-#endif /* HAVE_STDLIB_H */
+void highlight_stop(struct list_node *node)
+{
+    struct hl_job *job;
 
-#ifdef HAVE_SYS_TYPES_H
-#include <sys/types.h>
-#endif /* HAVE_SYS_TYPES_H */
+    if (!node)
+        return;
 
-#if HAVE_REGEX_H
-#include <regex.h>
-#endif /* HAVE_REGEX_H */
+    pthread_mutex_lock(&hl_mutex);
+    hl_job_cancel(&hl_todo, node);
+    hl_job_cancel(&hl_done, node);
 
-/* Local Includes */
-#include "highlight.h"
-#include "highlight_groups.h"
-#include "sources.h"
-#include "cgdb.h"
-#include "tokenizer.h"
-#include "interface.h"
-#include "sys_util.h"
-#include "logger.h"
+    /* The worker notices and throws the job away */
+    for (job = hl_running; job; job = job->next)
+        if (job->node == node)
+            job->node = NULL;
+    pthread_mutex_unlock(&hl_mutex);
+}
 
-/* ----------- */
-/* Definitions */
-/* ----------- */
+struct hl_previous *highlight_keep(struct list_node *node)
+{
+    struct hl_previous *previous;
 
-#define HL_CHAR CHAR_MAX        /* Special marker character */
+    /* Only a finished highlighting has states to pick up from */
+    if (!node || node->hl_lazy != 0 || !node->buf.lines ||
+            !node->buf.runs || node->hl_state_count == 0)
+        return NULL;
 
-/* --------------- */
-/* Local Variables */
-/* --------------- */
+    previous = cgdb_calloc(1, sizeof (struct hl_previous));
+    previous->language = node->language;
+    previous->length = node->orig_buf.length;
+
+    previous->orig.length = node->orig_buf.length;
+    previous->orig.lines = node->orig_buf.lines;
+    previous->orig.bases = node->orig_buf.bases;
+    previous->orig.text = node->orig_buf.text;
+    node->orig_buf.lines = NULL;
+    node->orig_buf.bases = NULL;
+    node->orig_buf.text = NULL;
+
+    previous->buf.length = node->buf.length;
+    previous->buf.lines = node->buf.lines;
+    previous->buf.bases = node->buf.bases;
+    previous->buf.runs = node->buf.runs;
+    previous->buf.used = node->buf.used;
+    previous->buf.size = node->buf.size;
+    node->buf.lines = NULL;
+    node->buf.bases = NULL;
+    node->buf.runs = NULL;
+
+    previous->states = node->hl_states;
+    previous->state_count = node->hl_state_count;
+    node->hl_states = NULL;
+    node->hl_state_count = 0;
+
+    previous->symbols = node->symbols;
+    node->symbols = NULL;
+
+    return previous;
+}
 
-static int highlight_node(struct list_node *node)
+void highlight_reuse(struct list_node *node, struct hl_previous *previous)
 {
-    struct tokenizer *t = tokenizer_init();
-    int ret;
-    struct ibuf *ibuf = ibuf_init();
+    hl_previous_free(node->hl_previous);
+    node->hl_previous = previous;
+}
 
-    ibuf_addchar(ibuf, HL_CHAR);
-    ibuf_addchar(ibuf, HLG_TEXT);
+void highlight_forget(struct list_node *node)
+{
+    hl_previous_free(node->hl_previous);
+    node->hl_previous = NULL;
+    free(node->hl_states);
+    node->hl_states = NULL;
+    node->hl_state_count = 0;
+    symbols_free(node->symbols);
+    node->symbols = NULL;
+}
 
-    /* Initialize */
-    node->buf.length = 0;
-    node->buf.tlines = NULL;
-    node->buf.max_width = 0;
+struct symbols *highlight_symbols(struct list_node *node)
+{
+    struct tokenizer *t;
+    struct hl_symbols sym;
+    struct ibuf *text;
+    int line = 0, col = 0, ret;
 
-    if (tokenizer_set_file(t, node->path, node->language) == -1) {
-        if_print_message("%s:%d tokenizer_set_file error", __FILE__, __LINE__);
-        return -1;
-    }
+    if (!node || node->symbols || !node->orig_buf.lines)
+        return node ? node->symbols : NULL;
 
-    while ((ret = tokenizer_get_token(t)) > 0) {
-        enum tokenizer_type e = tokenizer_get_packet_type(t);
+    /* Files the tokenizer doesn't know have no identifiers to it */
+    if (node->language == TOKENIZER_LANGUAGE_UNKNOWN)
+        return NULL;
 
-        /*if_print_message  ( "TOKEN(%d:%s)\n", e, tokenizer_get_printable_enum ( e ) ); */
+    memset(&sym, 0, sizeof (struct hl_symbols));
+    sym.builder = symbols_builder_new();
+    sym.language = node->language;
 
-        switch (e) {
-            case TOKENIZER_KEYWORD:
-                ibuf_addchar(ibuf, HL_CHAR);
-                ibuf_addchar(ibuf, HLG_KEYWORD);
-                ibuf_add(ibuf, tokenizer_get_data(t));
-                ibuf_addchar(ibuf, HL_CHAR);
-                ibuf_addchar(ibuf, HLG_TEXT);
-                break;
-            case TOKENIZER_TYPE:
-                ibuf_addchar(ibuf, HL_CHAR);
-                ibuf_addchar(ibuf, HLG_TYPE);
-                ibuf_add(ibuf, tokenizer_get_data(t));
-                ibuf_addchar(ibuf, HL_CHAR);
-                ibuf_addchar(ibuf, HLG_TEXT);
-                break;
-            case TOKENIZER_LITERAL:
-                ibuf_addchar(ibuf, HL_CHAR);
-                ibuf_addchar(ibuf, HLG_LITERAL);
-                ibuf_add(ibuf, tokenizer_get_data(t));
-                ibuf_addchar(ibuf, HL_CHAR);
-                ibuf_addchar(ibuf, HLG_TEXT);
-                break;
-            case TOKENIZER_NUMBER:
-                ibuf_add(ibuf, tokenizer_get_data(t));
-                break;
-            case TOKENIZER_COMMENT:
-                ibuf_addchar(ibuf, HL_CHAR);
-                ibuf_addchar(ibuf, HLG_COMMENT);
-                ibuf_add(ibuf, tokenizer_get_data(t));
-                ibuf_addchar(ibuf, HL_CHAR);
-                ibuf_addchar(ibuf, HLG_TEXT);
-                break;
-            case TOKENIZER_DIRECTIVE:
-                ibuf_addchar(ibuf, HL_CHAR);
-                ibuf_addchar(ibuf, HLG_DIRECTIVE);
-                ibuf_add(ibuf, tokenizer_get_data(t));
-                ibuf_addchar(ibuf, HL_CHAR);
-                ibuf_addchar(ibuf, HLG_TEXT);
-                break;
-            case TOKENIZER_TEXT:
-                ibuf_add(ibuf, tokenizer_get_data(t));
-                break;
-            case TOKENIZER_NEWLINE:
-                node->buf.length++;
-                node->buf.tlines =
-                        realloc(node->buf.tlines,
-                        sizeof (char *) * node->buf.length);
-                node->buf.tlines[node->buf.length - 1] = strdup(ibuf_get(ibuf));
-
-                if (ibuf_length(ibuf) > node->buf.max_width)
-                    node->buf.max_width = ibuf_length(ibuf);
-
-                ibuf_clear(ibuf);
-                ibuf_addchar(ibuf, HL_CHAR);
-                ibuf_addchar(ibuf, HLG_TEXT);
-                break;
-            case TOKENIZER_ERROR:
-                ibuf_add(ibuf, tokenizer_get_data(t));
-                break;
-            default:
-                return -1;
-                break;
-        }
+    text = highlight_join_lines(node, 0, node->orig_buf.length);
+    t = tokenizer_init();
+
+    if (tokenizer_set_buffer(t, ibuf_get(text), ibuf_length(text),
+                    node->language) == -1) {
+        tokenizer_destroy(t);
+        ibuf_free(text);
+        symbols_builder_free(sym.builder);
+        return NULL;
     }
 
-    return 0;
-}
+    while ((ret = tokenizer_get_token(t)) > 0) {
+        hl_symbols_token(&sym, t, line, col);
 
-/* --------- */
-/* Functions */
-/* --------- */
+        if (tokenizer_get_packet_type(t) == TOKENIZER_NEWLINE) {
+            line++;
+            col = 0;
+        } else
+            col += tokenizer_get_length(t);
+    }
 
-/* See comments in highlight.h for function descriptions. */
+    hl_symbols_flush(&sym, 0);
+    node->symbols = symbols_finish(sym.builder);
 
-void highlight(struct list_node *node)
-{
-    if (node->language == TOKENIZER_LANGUAGE_UNKNOWN) {
-        /* Just copy the lines from the original buffer if no highlighting 
-         * is possible */
-        int i;
+    tokenizer_destroy(t);
+    ibuf_free(text);
 
-        node->buf.length = node->orig_buf.length;
-        node->buf.max_width = node->orig_buf.max_width;
-        node->buf.tlines = cgdb_malloc(sizeof (char *) * node->orig_buf.length);
-        for (i = 0; i < node->orig_buf.length; i++)
-            node->buf.tlines[i] = cgdb_strdup(node->orig_buf.tlines[i]);
-    } else
-        highlight_node(node);
+    return node->symbols;
 }
 
-/* highlight_line_segment: Creates a new line that is hightlighted.
+/* highlight_line_segment: Creates the runs to draw a search match with.
  * ------------------------
  *
- *  orig:   The line that needs to be highlighted.
+ *  runs:   The runs of the line that needs to be highlighted, or NULL.
  *  start:  The desired starting position of the highlighted portion.
  *          The start index *is* included in the highlighted segment.
  *  end:    The desired ending position of the highlighted portion.
  *          The end index *is not* include in the highlighted segment.
+ *  group:  The group to draw the segment with.
  *
- *  Return Value: Null on error. Or a pointer to a new line that
- *  has highlighting. The new line MUST BE FREED.
+ *  Return Value: Null on error. Or a pointer to new runs, with the
+ *  segment drawn as group on top of the line's runs. The new runs
+ *  MUST BE FREED.
  */
-/*#define HIGHLIGHT_DEBUG*/
-static char *highlight_line_segment(const char *orig, int start, int end)
+static struct hl_run *highlight_line_segment(const struct hl_run *runs,
+        int start, int end, enum hl_group_kind group)
 {
-    char *new_line = NULL;
-    int length = strlen(orig), j = 0, pos = 0;
-    int syn_search_recieved = 0, cur_color = HLG_TEXT;
+    struct hl_line line;
+    const struct hl_run *r;
+    int added;
 
     /* Cases not possible */
-    if (start > end || orig == NULL ||
-            start > length || start < 0 || end > length || end < 0)
+    if (start > end || start < 0 || end < 0)
         return NULL;
 
-    /* The 5 is: color start (2), color end (2) and EOL */
-    if ((new_line = (char *) malloc(sizeof (char) * (length + 5))) == NULL)
-        return NULL;
+    /* An empty match has nothing to draw */
+    added = start == end;
 
-#ifdef HIGHLIGHT_DEBUG
-    /*
-       for ( j = 0; j < strlen(orig); j++ ) {
-       char temp[100];
-       sprintf(temp, "(%d:%c)", orig[j], orig[j]);
-       scr_add(gdb_win, temp);
-       }
-       scr_add(gdb_win, "\r\n");
-       scr_refresh(gdb_win, 1);
-     */
-#endif
-
-    /* This traverses the input line. It creates a new line with the section
-     *     given highlighted.
-     * If a highlight symbol is encountered, the end and/or start position 
-     *     is incremented because the original match was against only the text,
-     *     not against the color embedded text :)
-     */
-    for (j = 0; j < length; j++) {
-        if (orig[j] == HL_CHAR) {
-            if (j <= start)
-                start += 2;
-
-            if (j <= end)
-                end += 2;
-
-            cur_color = orig[j + 1];
-        }
+    memset(&line, 0, sizeof (struct hl_line));
+
+    /* Keep the parts of the runs outside of the segment, and put the
+     * segment in between them */
+    for (r = runs; r && r->length > 0; r++) {
+        int rend = r->start + r->length;
 
-        /* Mark when the search is started and when it ends */
-        if (j == start) {
-            syn_search_recieved = 1;
-            new_line[pos++] = HL_CHAR;
-            new_line[pos++] = HLG_SEARCH;
-        } else if (j == end) {
-            syn_search_recieved = 0;
-            new_line[pos++] = HL_CHAR;
-            new_line[pos++] = cur_color;
+        if (r->start < start)
+            hl_line_add(&line, r->start,
+                    (rend < start ? rend : start) - r->start, r->group);
+
+        if (!added && rend > start) {
+            hl_line_add(&line, start, end - start, group);
+            added = 1;
         }
 
-        new_line[pos++] = orig[j];
+        if (rend > end)
+            hl_line_add(&line, r->start > end ? r->start : end,
+                    rend - (r->start > end ? r->start : end), r->group);
+    }
+
+    if (!added)
+        hl_line_add(&line, start, end - start, group);
+
+    /* End the runs */
+    hl_line_add(&line, 0, 0, HLG_TEXT);
+
+    return line.runs;
+}
+
+/* The checkpoints of a long line. Checkpoint k is where the walk to the
+ * character at column k * HL_CHECKPOINT_STEP stops, so hl_wprintw can
+ * start walking from there instead of from the start of the line. */
+struct hl_line_index {
+    const char *line;           /* The line, NULL if the slot is free */
+    int length;                 /* Its length */
+    int tabstop;                /* The tabstop the columns were counted with */
+    int *index;                 /* The character of each checkpoint */
+    int *column;                /* The column that character is at */
+    int count;                  /* The number of checkpoints */
+    unsigned long used;         /* When the line was last drawn */
+};
+
+static struct hl_line_index hl_line_index[HL_CHECKPOINT_LINES];
+static unsigned long hl_line_tick;
+
+/* hl_column_step: The column after the character at index i, at column j.
+ * ---------------
+ *
+ * i is moved past the character, which can be more than a byte.
+ */
+static int hl_column_step(const char *line, int length, int *i, int j,
+        int tabstop)
+{
+    if (line[*i] == '\t') {
+        (*i)++;
+        return j + tabstop - (j % tabstop);
+    }
+
+    return j + utf8_next(line, length, i);
+}
 
-        /* If the search has started, then make all the colors the 
-         * highlighted colors  */
-        if (syn_search_recieved && orig[j] == HL_CHAR) {
-            ++j;
-            new_line[pos++] = HLG_SEARCH;
+/* hl_line_index_get: Gets the checkpoints of a long line.
+ * ------------------
+ *
+ * The line is indexed the first time it's drawn. The least recently
+ * drawn line gives up its slot when they are all taken.
+ *
+ *   line:     The line
+ *   length:   Its length
+ *   tabstop:  The width of a tab
+ */
+static struct hl_line_index *hl_line_index_get(const char *line, int length,
+        int tabstop)
+{
+    struct hl_line_index *entry = &hl_line_index[0];
+    int i, j, k, size;
+
+    for (i = 0; i < HL_CHECKPOINT_LINES; i++) {
+        if (hl_line_index[i].line == line &&
+                hl_line_index[i].length == length &&
+                hl_line_index[i].tabstop == tabstop) {
+            hl_line_index[i].used = ++hl_line_tick;
+            return &hl_line_index[i];
         }
+
+        if (hl_line_index[i].used < entry->used)
+            entry = &hl_line_index[i];
     }
 
-    new_line[pos] = '\0';
+    /* Tabs push the columns past the characters, count the steps as it goes */
+    free(entry->index);
+    free(entry->column);
+    size = length / HL_CHECKPOINT_STEP + 2;
+    entry->index = cgdb_malloc(sizeof (int) * size);
+    entry->column = cgdb_malloc(sizeof (int) * size);
+    entry->count = 0;
+
+    for (i = 0, j = 0, k = 0;;) {
+        while (j >= k * HL_CHECKPOINT_STEP) {
+            if (entry->count == size) {
+                size *= 2;
+                entry->index = cgdb_realloc(entry->index, sizeof (int) * size);
+                entry->column = cgdb_realloc(entry->column,
+                        sizeof (int) * size);
+            }
+
+            entry->index[entry->count] = i;
+            entry->column[entry->count] = j;
+            entry->count++;
+            k++;
+        }
 
-#ifdef HIGHLIGHT_DEBUG
-    for (j = 0; j < strlen(new_line); j++) {
-        char temp[100];
+        if (i >= length)
+            break;
 
-        fprintf(stderr, "(%d:%c)\r\n", new_line[j], new_line[j]);
+        j = hl_column_step(line, length, &i, j, tabstop);
     }
-#endif
 
-    /* Now the line has new information in it.
-     * Lets traverse it again and correct the highlighting to be the 
-     * reverse.
-     */
+    entry->line = line;
+    entry->length = length;
+    entry->tabstop = tabstop;
+    entry->used = ++hl_line_tick;
+
+    return entry;
+}
 
-    return new_line;
+/* hl_waddbuf: Prints some characters built up by hl_wprintw.
+ * -----------
+ */
+static void hl_waddbuf(WINDOW * win, struct ibuf *text)
+{
+    if (ibuf_length(text) > 0)
+        waddnstr(win, ibuf_get(text), ibuf_length(text));
 }
 
-void hl_wprintw(WINDOW * win, const char *line, int width, int offset)
+void hl_wprintw(WINDOW * win, const char *line, const struct hl_run *runs,
+        int width, int offset, int tabstop)
 {
+    static struct ibuf *text = NULL;    /* Reused for each piece printed */
+    struct hl_line_index *index;    /* The checkpoints of a long line */
     int length;                 /* Length of the line passed in */
-    enum hl_group_kind color;   /* Color used to print current char */
+    enum hl_group_kind group;   /* Color of the piece being printed */
+    int end;                    /* One past the last char of the piece */
     int i;                      /* Loops through the line char by char */
     int j;                      /* General iterator */
+    int k;                      /* The checkpoint to start from */
     int p;                      /* Count of chars printed to screen */
     int pad;                    /* Used to pad partial tabs */
     int attr;                   /* A temp variable used for attributes */
-    int highlight_tabstop = cgdbrc_get(CGDBRC_TABSTOP)->variant.int_val;
+    const int *attrs = hl_groups_get_attrs(hl_groups_instance);
+
+    if (!text)
+        text = ibuf_init();
 
-    /* Jump ahead to the character at offset (process color commands too) */
+    /* Jump ahead to the character at offset */
     length = strlen(line);
-    color = HLG_TEXT;
-
-    for (i = 0, j = 0; i < length && j < offset; i++) {
-        if (line[i] == HL_CHAR && i + 1 < length) {
-            /* Even though we're not printing anything in this loop,
-             * the color attribute needs to be maintained for when we
-             * start printing in the loop below.  This way the text
-             * printed will be done in the correct color. */
-            color = (int) line[++i];
-        } else if (line[i] == '\t') {
-            /* Tab character, expand to size set by user */
-            j += highlight_tabstop - (j % highlight_tabstop);
+    i = j = 0;
+
+    /* Long lines start from the checkpoint closest to offset */
+    if (length >= HL_CHECKPOINT_LINE && offset >= HL_CHECKPOINT_STEP) {
+        index = hl_line_index_get(line, length, tabstop);
+        k = offset / HL_CHECKPOINT_STEP;
+        if (k >= index->count)
+            k = index->count - 1;
+        i = index->index[k];
+        j = index->column[k];
+    }
+
+    while (i < length && j < offset)
+        j = hl_column_step(line, length, &i, j, tabstop);
+    pad = j - offset;
+
+    /* Pad tab spaces, or a wide character split by offset */
+    ibuf_clear(text);
+    for (p = 0; p < pad && p < width; p++)
+        ibuf_addchar(text, ' ');
+    hl_waddbuf(win, text);
+
+    /* Print the line a piece at a time, each piece is a run of characters
+     * drawn in the same color */
+    while (i < length && p < width) {
+        /* Skip the runs before this character, runs are in order */
+        while (runs && runs->length > 0 && runs->start + runs->length <= i)
+            runs++;
+
+        if (runs && runs->length > 0 && runs->start <= i) {
+            group = runs->group;
+            end = runs->start + runs->length;
         } else {
-            /* Normal character, just increment counter by one */
-            j++;
+            group = HLG_TEXT;
+            end = runs && runs->length > 0 ? runs->start : length;
+        }
+
+        /* Expand the tabs in the piece, the characters between them go
+         * in at once */
+        ibuf_clear(text);
+        while (i < end && i < length && p < width) {
+            if (line[i] == '\t') {
+                do {
+                    ibuf_addchar(text, ' ');
+                    p++;
+                } while ((p + offset) % tabstop > 0 && p < width);
+                i++;
+            } else {
+                const char *tab;
+                int stop = end < length ? end : length, columns;
+
+                if ((tab = memchr(line + i, '\t', stop - i)))
+                    stop = tab - line;
+
+                /* A wide character that doesn't fit in the last column is
+                 * left out, with a space in its place */
+                j = utf8_column_bytes(line + i, stop - i, width - p, &columns);
+                if (j == 0) {
+                    ibuf_addchar(text, ' ');
+                    p = width;
+                    break;
+                }
+
+                ibuf_addn(text, line + i, j);
+                p += columns;
+                i += j;
+            }
         }
+
+        attr = attrs[group];
+        wattron(win, attr);
+        hl_waddbuf(win, text);
+        wattroff(win, attr);
     }
-    pad = j - offset;
 
-    /* Pad tab spaces if offset is less than the size of a tab */
-    for (j = 0, p = 0; j < pad && p < width; j++, p++)
-        wprintw(win, " ");
+    /* Blank out the rest of the line */
+    ibuf_clear(text);
+    for (; p < width; p++)
+        ibuf_addchar(text, ' ');
+    hl_waddbuf(win, text);
+}
+
+void hl_wprintw_forget(void)
+{
+    int i;
+
+    for (i = 0; i < HL_CHECKPOINT_LINES; i++) {
+        free(hl_line_index[i].index);
+        free(hl_line_index[i].column);
+        hl_line_index[i].line = NULL;
+        hl_line_index[i].index = NULL;
+        hl_line_index[i].column = NULL;
+        hl_line_index[i].count = 0;
+        hl_line_index[i].used = 0;
+    }
+}
+
+int hl_regex_cflags(int icase)
+{
+    return icase ? REG_ICASE : 0;
+}
 
-    /* Set the color appropriately */
-    if (hl_groups_get_attr(hl_groups_instance, color, &attr) == -1) {
-        logger_write_pos(logger, __FILE__, __LINE__,
-                "hl_groups_get_attr error");
-        return;
+struct rx *hl_regex_compile(const char *regex, int cflags)
+{
+    struct hl_regex_entry *entry = &hl_regex_cache[0];
+    int engine = cgdbrc_get(CGDBRC_REGEXPENGINE)->variant.int_val;
+    int i;
+
+    for (i = 0; i < HL_REGEX_CACHE; i++) {
+        if (hl_regex_cache[i].regex && hl_regex_cache[i].cflags == cflags &&
+                hl_regex_cache[i].engine == engine &&
+                strcmp(hl_regex_cache[i].regex, regex) == 0) {
+            hl_regex_cache[i].used = ++hl_regex_tick;
+            return hl_regex_cache[i].t;
+        }
+
+        /* Replace an empty entry, or else the least recently used */
+        if (!hl_regex_cache[i].regex ||
+                (entry->regex && hl_regex_cache[i].used < entry->used))
+            entry = &hl_regex_cache[i];
+    }
+
+    if (entry->regex) {
+        rx_free(entry->t);
+        free(entry->regex);
+        entry->regex = NULL;
     }
 
-    wattron(win, attr);
+    if (!(entry->t = rx_compile(regex, cflags, engine)))
+        return NULL;
 
-    /* Print string 1 char at a time */
-    for (; i < length && p < width; i++) {
-        if (line[i] == HL_CHAR) {
-            if (++i < length) {
-                wattroff(win, attr);
-                color = (int) line[i];
+    entry->regex = cgdb_strdup(regex);
+    entry->cflags = cflags;
+    entry->engine = engine;
+    entry->used = ++hl_regex_tick;
 
-                if (hl_groups_get_attr(hl_groups_instance, color, &attr) == -1) {
-                    logger_write_pos(logger, __FILE__, __LINE__,
-                            "hl_groups_get_attr error");
-                    return;
-                }
+    return entry->t;
+}
+
+struct hl_run *hl_regex_all(struct rx *t, const char *line,
+        const struct hl_run *runs)
+{
+    struct hl_run *all = NULL, *next;
+    regmatch_t match;
+    int offset = 0, length = strlen(line);
+    int start, end;
+
+    while (offset <= length && rx_exec(t, line + offset, 1, &match,
+                    offset > 0 ? REG_NOTBOL : 0) == 0) {
+        start = offset + match.rm_so;
+        end = offset + match.rm_eo;
+
+        /* An empty match has nothing to draw, the next one starts after it */
+        if (end > start) {
+            next = highlight_line_segment(all ? all : runs, start, end,
+                    HLG_HLSEARCH);
+            free(all);
+            all = next;
+            offset = end;
+        } else
+            offset = end + 1;
+    }
+
+    return all;
+}
+
+/* hl_regex_narrows: Determines if every match of a regular expression holds
+ * ----------------- a match of the one that was searched for before it.
+ *
+ * That's only known when the old one is plain text, and the new one adds
+ * to it without making any of it optional.
+ */
+static int hl_regex_narrows(const char *old, const char *regex)
+{
+    size_t length = strlen(old);
+
+    if (strncmp(old, regex, length) != 0)
+        return 0;
+
+    return old[strcspn(old, "\\.[]()*+?{}|^$")] == '\0' &&
+            regex[length + strcspn(regex + length, "\\*?{|")] == '\0';
+}
+
+/* hl_search_resume: Works out where an incremental search can pick up.
+ * -----------------
+ *
+ * Return Value: The number of lines, in search order, known not to match.
+ */
+static int hl_search_resume(const char *regex, void *data, int length,
+        int start, int col, int direction, int icase)
+{
+    if (!hl_search.regex || hl_search.data != data ||
+            hl_search.length != length || hl_search.start != start ||
+            hl_search.col != col || hl_search.direction != direction ||
+            hl_search.icase != icase ||
+            !hl_regex_narrows(hl_search.regex, regex))
+        return 0;
+
+    return hl_search.skip;
+}
+
+/* hl_search_save: Remembers an incremental search for hl_search_resume.
+ * ---------------
+ *
+ *   skip:  The number of lines, in search order, that didn't match.
+ */
+static void hl_search_save(const char *regex, void *data, int length,
+        int start, int col, int direction, int icase, int skip)
+{
+    if (!hl_search.regex || strcmp(hl_search.regex, regex) != 0) {
+        free(hl_search.regex);
+        hl_search.regex = cgdb_strdup(regex);
+    }
+
+    hl_search.data = data;
+    hl_search.length = length;
+    hl_search.start = start;
+    hl_search.col = col;
+    hl_search.direction = direction;
+    hl_search.icase = icase;
+    hl_search.skip = skip;
+}
+
+int hl_regex_line(struct rx *t, const char *line, int first, int col,
+        int direction, regmatch_t * match)
+{
+    int offset = 0, before;
+
+    if (direction) {
+        /* Add the position of the current line's last match */
+        if (first) {
+            if (col >= strlen(line))
+                return 0;
+            offset = col;
+        }
+
+        if (rx_exec(t, line + offset, 1, match, 0) != 0)
+            return 0;
+
+        match->rm_so += offset;
+        match->rm_eo += offset;
+        return 1;
+    }
+
+    if (*line == '\0')
+        return 0;
+
+    /* On the current line, the match must start before the last one */
+    before = strlen(line);
+    if (first && col < before)
+        before = col;
+
+    return rx_exec_last(t, line, before, match, 0) == 0;
+}
+
+/* hl_search_line: Gets the line searched at some point of a search.
+ * ---------------
+ *
+ * The lines are searched in order, starting at the current line and
+ * wrapping around at the end (or start) of the file.
+ *
+ *   start:      The line the search started on
+ *   k:          How far into the search
+ *   length:     The number of lines
+ *   direction:  1 if forward, 0 if reverse
+ */
+static int hl_search_line(int start, int k, int length, int direction)
+{
+    if (direction)
+        return (start + k) % length;
+
+    return (start - k + length) % length;
+}
+
+/* hl_search_thread: A thread of the search pool.
+ * -----------------
+ *
+ * Each thread takes chunks of the search, in order, until the search is
+ * cancelled or a match is found before the next chunk.
+ */
+static void *hl_search_thread(void *arg)
+{
+    unsigned long seen = 0;
+    char *regex = NULL;         /* The expression t was compiled from */
+    int cflags = 0, engine = 0;
+    struct rx *t = NULL;        /* This thread's own copy, only one thread
+                                 * at a time can use each one */
+    hl_get_line get_line;
+    regmatch_t match[1];
+    void *data;
+    int length, start, col, direction, first;
+    int k, end, found;
+    char c = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&hl_pool_mutex);
+        while (hl_pool.search == seen)
+            pthread_cond_wait(&hl_pool_cond, &hl_pool_mutex);
+        seen = hl_pool.search;
+
+        if (!regex || cflags != hl_pool.cflags ||
+                engine != hl_pool.engine ||
+                strcmp(regex, hl_pool.regex) != 0) {
+            rx_free(t);
+            free(regex);
+            regex = cgdb_strdup(hl_pool.regex);
+            cflags = hl_pool.cflags;
+            engine = hl_pool.engine;
+            t = rx_compile(regex, cflags, engine);
+        }
 
-                wattron(win, attr);
+        get_line = hl_pool.get_line;
+        data = hl_pool.data;
+        length = hl_pool.length;
+        start = hl_pool.start;
+        col = hl_pool.col;
+        direction = hl_pool.direction;
+        first = hl_pool.first;
+        pthread_mutex_unlock(&hl_pool_mutex);
+
+        for (;;) {
+            /* Take the next chunk, unless a match was found before it */
+            pthread_mutex_lock(&hl_pool_mutex);
+            k = first + hl_pool.next * HL_SEARCH_CHUNK;
+            if (!t || hl_pool.cancelled || k >= hl_pool.best) {
+                pthread_mutex_unlock(&hl_pool_mutex);
+                break;
             }
-        } else {
-            switch (line[i]) {
-                case '\t':
-                    do {
-                        wprintw(win, " ");
-                        p++;
-                    } while ((p + offset) % highlight_tabstop > 0 && p < width);
-                    break;
-                default:
-                    wprintw(win, "%c", line[i]);
-                    p++;
+            hl_pool.next++;
+            end = k + HL_SEARCH_CHUNK;
+            if (end > hl_pool.best)
+                end = hl_pool.best;
+            pthread_mutex_unlock(&hl_pool_mutex);
+
+            found = 0;
+            for (; k < end && !found; k++)
+                found = hl_regex_line(t, get_line(data,
+                                hl_search_line(start, k, length, direction),
+                                NULL), k == 0, col, direction, match);
+
+            if (found) {
+                pthread_mutex_lock(&hl_pool_mutex);
+                if (k - 1 < hl_pool.best)
+                    hl_pool.best = k - 1;
+                pthread_mutex_unlock(&hl_pool_mutex);
             }
         }
+
+        /* The last thread out wakes up hl_search_parallel. The byte is
+         * written before busy can be seen as 0, so it's always there to
+         * be read once the search is over. */
+        pthread_mutex_lock(&hl_pool_mutex);
+        if (--hl_pool.busy == 0) {
+            while (write(hl_pool.pipe[1], &c, 1) == -1 && errno == EINTR)
+                ;
+            pthread_cond_signal(&hl_pool_idle);
+        }
+        pthread_mutex_unlock(&hl_pool_mutex);
     }
 
-    /* Shut off color attribute */
-    wattroff(win, attr);
+    return NULL;
+}
+
+/* hl_pool_start: Starts the threads of the search pool.
+ * --------------
+ *
+ * Return Value: 0 on success, -1 if searches can't be split up.
+ */
+static int hl_pool_start(void)
+{
+    long processors;
+    int i;
+
+    if (hl_pool.count > 0)
+        return 0;
 
-    for (; p < width; p++)
-        wprintw(win, " ");
+    processors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (processors < 2)
+        return -1;
+    if (processors > HL_SEARCH_THREADS)
+        processors = HL_SEARCH_THREADS;
+
+    if (pipe(hl_pool.pipe) == -1)
+        return -1;
+
+    fcntl(hl_pool.pipe[0], F_SETFL,
+            fcntl(hl_pool.pipe[0], F_GETFL) | O_NONBLOCK);
+
+    for (i = 0; i < processors; i++)
+        if (hl_thread_create(&hl_pool.threads[i], hl_search_thread) != 0)
+            break;
+
+    if (i == 0) {
+        cgdb_close(hl_pool.pipe[0]);
+        cgdb_close(hl_pool.pipe[1]);
+        return -1;
+    }
+
+    hl_pool.count = i;
+
+    return 0;
+}
+
+/* hl_search_parallel: Splits a search up between the search pool.
+ * -------------------
+ *
+ * This waits for the search to finish, unless the interrupt descriptor
+ * becomes readable first, which cancels it.
+ *
+ *   first:      How far into the search to start
+ *   total:      How far into the search to stop
+ *   cancelled:  Returns 1 if the search was cancelled
+ *
+ * The rest are as for hl_regex.
+ *
+ * Return Value: How far into the search the nearest match is, total if
+ *               there's no match, or -1 if the pool couldn't be started.
+ */
+static int hl_search_parallel(const char *regex, int cflags,
+        hl_get_line get_line, void *data, int length, int start, int col,
+        int direction, int first, int total, int *cancelled)
+{
+    fd_set rset;
+    int max, interrupt = hl_interrupt_fd, best;
+    ssize_t n;
+    char c[64];
+
+    if (hl_pool_start() == -1)
+        return -1;
+
+    pthread_mutex_lock(&hl_pool_mutex);
+    hl_pool.regex = regex;
+    hl_pool.cflags = cflags;
+    hl_pool.engine = cgdbrc_get(CGDBRC_REGEXPENGINE)->variant.int_val;
+    hl_pool.get_line = get_line;
+    hl_pool.data = data;
+    hl_pool.length = length;
+    hl_pool.start = start;
+    hl_pool.col = col;
+    hl_pool.direction = direction;
+    hl_pool.first = first;
+    hl_pool.next = 0;
+    hl_pool.best = total;
+    hl_pool.busy = hl_pool.count;
+    hl_pool.cancelled = 0;
+    hl_pool.search++;
+    pthread_cond_broadcast(&hl_pool_cond);
+    pthread_mutex_unlock(&hl_pool_mutex);
+
+    for (;;) {
+        FD_ZERO(&rset);
+        FD_SET(hl_pool.pipe[0], &rset);
+        max = hl_pool.pipe[0];
+        if (interrupt != -1) {
+            FD_SET(interrupt, &rset);
+            max = (max > interrupt) ? max : interrupt;
+        }
+
+        if (select(max + 1, &rset, NULL, NULL, NULL) == -1) {
+            if (errno == EINTR)
+                continue;
+
+            /* Give up on the search */
+            pthread_mutex_lock(&hl_pool_mutex);
+            hl_pool.cancelled = 1;
+            pthread_mutex_unlock(&hl_pool_mutex);
+            break;
+        }
+
+        if (FD_ISSET(hl_pool.pipe[0], &rset))
+            break;
+
+        /* Stop the threads, and wait for them to notice */
+        if (interrupt != -1 && FD_ISSET(interrupt, &rset)) {
+            pthread_mutex_lock(&hl_pool_mutex);
+            hl_pool.cancelled = 1;
+            pthread_mutex_unlock(&hl_pool_mutex);
+            interrupt = -1;
+        }
+    }
+
+    /* The threads have to be done with the search before what they're
+     * searching can go away. The last one's byte is read, so the next
+     * search doesn't take it for its own. */
+    pthread_mutex_lock(&hl_pool_mutex);
+    while (hl_pool.busy > 0)
+        pthread_cond_wait(&hl_pool_idle, &hl_pool_mutex);
+    do
+        n = read(hl_pool.pipe[0], c, sizeof (c));
+    while (n > 0 || (n == -1 && errno == EINTR));
+
+    best = hl_pool.best;
+    *cancelled = hl_pool.cancelled;
+    hl_pool.regex = NULL;
+    pthread_mutex_unlock(&hl_pool_mutex);
+
+    return best;
+}
+
+void hl_regex_interrupt(int fd)
+{
+    hl_interrupt_fd = fd;
 }
 
-int hl_regex(const char *regex, const char **hl_lines, const char **tlines,
-        const int length, char **cur_line, int *sel_line,
+int hl_regex_interrupted(void)
+{
+    struct timeval timeout = { 0, 0 };
+    fd_set rset;
+
+    if (hl_interrupt_fd == -1)
+        return 0;
+
+    FD_ZERO(&rset);
+    FD_SET(hl_interrupt_fd, &rset);
+
+    return select(hl_interrupt_fd + 1, &rset, NULL, NULL, &timeout) > 0;
+}
+
+void hl_regex_reset(void)
+{
+    free(hl_search.regex);
+    hl_search.regex = NULL;
+    hl_search.data = NULL;
+}
+
+int hl_regex(const char *regex, hl_get_line get_line, void *data,
+        const int length, struct hl_run **cur_line, int *sel_line,
         int *sel_rline, int *sel_col_rbeg, int *sel_col_rend,
         int opt, int direction, int icase)
 {
-    regex_t t;                  /* Regular expression */
+    struct rx *t;               /* Regular expression */
     regmatch_t pmatch[1];       /* Indexes of matches */
-    int i = 0, result = 0;
-    char *local_cur_line;
+    int i = 0, k, total, start, col;
+    int threshold, found, cancelled;
+    int cflags = hl_regex_cflags(icase);
+    const struct hl_run *runs;
     int success = 0;
-    int offset = 0;
     int config_wrapscan = cgdbrc_get(CGDBRC_WRAPSCAN)->variant.int_val;
 
-    if (tlines == NULL || tlines[0] == NULL ||
+    if (get_line == NULL || length <= 0 ||
             cur_line == NULL || sel_line == NULL ||
             sel_rline == NULL || sel_col_rbeg == NULL || sel_col_rend == NULL)
         return -1;
@@ -372,105 +2092,78 @@ int hl_regex(const char *regex, const char **hl_lines, const char **tlines,
 
     /* If regex is empty, set current line to original line */
     if (regex == NULL || *regex == '\0') {
+        hl_regex_reset();
         *sel_line = *sel_rline;
         return -2;
     }
 
     /* Compile the regular expression */
-    if (regcomp(&t, regex, REG_EXTENDED & (icase) ? REG_ICASE : 0) != 0) {
-        regfree(&t);
+    if (!(t = hl_regex_compile(regex, cflags)))
         return -3;
-    }
-
-    /* Forward search */
-    if (direction) {
-        int start = *sel_rline;
-        int end = length;
-
-        offset = *sel_col_rend;
-        while (!success) {
-            for (i = start; i < end; i++) {
-                int local_cur_line_length;
-
-                local_cur_line = (char *) tlines[i];
-                local_cur_line_length = strlen(local_cur_line);
-
-                /* Add the position of the current line's last match */
-                if (i == *sel_rline) {
-                    if (offset >= local_cur_line_length)
-                        continue;
-                    local_cur_line += offset;
-                }
-
-                /* Found a match */
-                if ((result = regexec(&t, local_cur_line, 1, pmatch, 0)) == 0) {
-                    success = 1;
-                    break;
-                }
-            }
 
-            if (success || start == 0 || !config_wrapscan) {
-                break;
-            } else {
-                end = start;
-                start = 0;
-            }
+    start = *sel_rline;
+    if (start < 0)
+        start = 0;
+    if (start >= length)
+        start = length - 1;
+
+    /* Forward searches pick up after the last match, reverse searches
+     * before it */
+    col = direction ? *sel_col_rend : *sel_col_rbeg;
+
+    /* The lines are tried in order, starting at the current line and
+     * wrapping around at the end (or start) of the file */
+    if (config_wrapscan)
+        total = length;
+    else
+        total = direction ? length - start : start + 1;
+
+    /* Typing more of the pattern skips the lines that didn't match */
+    k = hl_search_resume(regex, data, length, start, col, direction, icase);
+
+    /* Big searches are split up between the processors */
+    threshold = cgdbrc_get(CGDBRC_PARALLELSEARCH)->variant.int_val;
+    if (threshold > 0 && total - k > threshold &&
+            (found = hl_search_parallel(regex, cflags, get_line, data, length,
+                            start, col, direction, k, total,
+                            &cancelled)) != -1) {
+        /* A key was pressed, it gets handled instead */
+        if (cancelled) {
+            hl_regex_reset();
+            *sel_line = *sel_rline;
+            return 0;
         }
 
-    } else {                    /* Reverse search */
-        int j, pos;
-        int start = *sel_rline;
-        int end = 0;
-
-        offset = *sel_col_rbeg;
-
-        /* Try each line */
-        while (!success) {
-            for (i = start; i >= end; i--) {
-                local_cur_line = (char *) tlines[i];
-                pos = strlen(local_cur_line) - 1;
-                if (pos < 0)
-                    continue;
-
-                if (i == *sel_rline)
-                    pos = offset - 1;
-
-                /* Try each line, char by char starting from the end */
-                for (j = pos; j >= 0; j--) {
-                    if ((result = regexec(&t, local_cur_line + j, 1, pmatch,
-                                            0)) == 0) {
-                        if (i == *sel_rline && pmatch[0].rm_so > pos - j)
-                            continue;
-                        /* Found a match */
-                        success = 1;
-                        offset = j;
-                        break;
-                    }
-                }
-
-                if (success)
-                    break;
-            }
+        /* Get the match itself */
+        k = found;
+        if (k < total) {
+            i = hl_search_line(start, k, length, direction);
+            success = hl_regex_line(t, get_line(data, i, NULL), k == 0, col,
+                    direction, pmatch);
+        }
+    } else {
+        for (; k < total; k++) {
+            i = hl_search_line(start, k, length, direction);
 
-            if (success || start == length - 1 || !config_wrapscan) {
+            /* Found a match */
+            if (hl_regex_line(t, get_line(data, i, NULL), k == 0, col,
+                            direction, pmatch)) {
+                success = 1;
                 break;
-            } else {
-                end = start;
-                start = length - 1;
             }
         }
-
     }
 
-    if (success) {
-        /* The offset is 0 if the line was not on the original line */
-        if (direction && *sel_rline != i)
-            offset = 0;
+    if (opt == 2)
+        hl_regex_reset();
+    else
+        hl_search_save(regex, data, length, start, col, direction, icase, k);
 
+    if (success) {
         /* If final match ( user hit enter ) make position perminant */
         if (opt == 2) {
-            *sel_col_rbeg = pmatch[0].rm_so + offset;
-            *sel_col_rend = pmatch[0].rm_eo + offset;
+            *sel_col_rbeg = pmatch[0].rm_so;
+            *sel_col_rend = pmatch[0].rm_eo;
             *sel_rline = i;
         }
 
@@ -478,16 +2171,15 @@ int hl_regex(const char *regex, const char **hl_lines, const char **tlines,
         *sel_line = i;
 
         /* If the match is not perminant then give cur_line highlighting */
-        if (opt != 2 && pmatch[0].rm_so != -1 && pmatch[0].rm_eo != -1)
-            *cur_line =
-                    highlight_line_segment(hl_lines[i],
-                    pmatch[0].rm_so + offset, pmatch[0].rm_eo + offset);
+        if (opt != 2 && pmatch[0].rm_so != -1 && pmatch[0].rm_eo != -1) {
+            get_line(data, i, &runs);
+            *cur_line = highlight_line_segment(runs,
+                    pmatch[0].rm_so, pmatch[0].rm_eo, HLG_SEARCH);
+        }
     } else {
         /* On failure, the current line goes to the original line */
         *sel_line = *sel_rline;
     }
 
-    regfree(&t);
-
     return success;
 }
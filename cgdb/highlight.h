@@ -18,37 +18,253 @@
 #include <ncurses/curses.h>
 #endif /* HAVE_CURSES_H */
 
+#if HAVE_REGEX_H
+#include <regex.h>
+#endif /* HAVE_REGEX_H */
+
 /* Local Includes */
 #include "sources.h"
+#include "rx.h"
 
 /* --------- */
 /* Functions */
 /* --------- */
 
-/* highlight:  Inserts the highlighting tags into the buffer.  Lines in
- * ----------  this file should be displayed with hl_wprintw from now on...
+/* highlight_init:  Starts the worker threads that highlight files, one
+ * ---------------  per processor, so several files are highlighted at once.
+ *
+ * Without the workers, files are highlighted as soon as they're asked for.
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+int highlight_init(void);
+
+/* highlight_fd:  Gets the file descriptor that becomes readable each time
+ * -------------  a worker finishes a file. highlight_finish should be
+ *                called when it does.
+ *
+ * Return Value: The file descriptor, or -1 if there are no workers.
+ */
+int highlight_fd(void);
+
+/* highlight:  Hands the file buffer of a node to be highlighted. Lines in
+ * ----------  this file should be displayed with hl_wprintw from now on,
+ *             they are drawn plain until highlight_finish returns the node.
  *
  *   node:  The node containing the file buffer to highlight.
+ *   data:  The contents of the file, as read by the loader. If NULL, the
+ *          contents are rebuilt from the node's original buffer.
+ *   size:  The number of bytes in data.
+ */
+void highlight(struct list_node *node, const char *data, size_t size);
+
+/* highlight_lazy:  Prepares a node to be highlighted once it's displayed,
+ * ---------------  for files too big to highlight just in case. Every line
+ *                  of the buffer starts out BUFFER_NO_LINE, meaning the
+ *                  line in the original buffer should be displayed instead.
+ *
+ *   node:  The node containing the file buffer to highlight.
+ */
+void highlight_lazy(struct list_node *node);
+
+/* highlight_start:  Hands a lazy node to be highlighted, it's about to be
+ * ----------------  displayed. The lines that will be seen are highlighted
+ *                   right away, on their own, and the rest are drawn plain
+ *                   until the worker is done with the file.
+ *
+ *   node:   The node that was passed to highlight_lazy.
+ *   start:  The first line that will be seen.
+ *   end:    One past the last line that will be seen, or start if the
+ *           file isn't being displayed.
+ */
+void highlight_start(struct list_node *node, int start, int end);
+
+/* highlight_busy:  Determines if any file is still being highlighted.
+ * ---------------
+ *
+ * Return Value: 1 if highlight_finish has work coming, 0 otherwise.
+ */
+int highlight_busy(void);
+
+/* highlight_idle:  Determines if a worker is free to take another file.
+ * ---------------
+ *
+ * Return Value: 1 if a file handed over now would be started right away,
+ *               0 otherwise.
+ */
+int highlight_idle(void);
+
+/* highlight_finish:  Gives the next file the worker finished its
+ * -----------------  highlighting. Call it until it returns NULL.
+ *
+ * Return Value: The node that is now highlighted, or NULL if there are no
+ *               more finished files.
  */
-void highlight(struct list_node *node);
+struct list_node *highlight_finish(void);
 
-/* hl_wprintw:  Prints a given line using the embedded highlighting commands
- * -----------  to dictate how to color the given line.
+/* highlight_stop:  Stops highlighting a node. This must be called before
+ * ---------------  the node's buffers are released.
+ *
+ *   node:  The node to stop working on.
+ */
+void highlight_stop(struct list_node *node);
+
+/* highlight_keep:  Takes the highlighting of a node that's about to be
+ * ---------------  reloaded, so the lines that don't change can keep it.
+ *
+ *   node:  The node, before its buffers are released.
+ *
+ * Return Value: The old highlighting, for highlight_reuse, or NULL if the
+ *               node isn't fully highlighted.
+ */
+struct hl_previous *highlight_keep(struct list_node *node);
+
+/* highlight_reuse:  Gives a node the highlighting it had before a reload.
+ * ----------------  The next time it's highlighted, only the lines that
+ *                   changed, and the ones after them until the tokenizer
+ *                   is back in step, are tokenized again.
+ *
+ *   node:      The node.
+ *   previous:  What highlight_keep returned, or NULL to drop it.
+ */
+void highlight_reuse(struct list_node *node, struct hl_previous *previous);
+
+/* highlight_forget:  Frees the tokenizer states, the symbol index and any
+ * -----------------  highlighting from before a reload that a node is
+ *                    holding on to.
+ *
+ *   node:  The node.
+ */
+void highlight_forget(struct list_node *node);
+
+/* highlight_symbols:  Gets the symbol index of a node.
+ * ------------------
+ *
+ *  The index is built along with the highlighting. A node whose
+ *  highlighting came from the cache, or isn't done yet, is tokenized for
+ *  its index here, once.
+ *
+ *   node:  The node, it must be loaded.
+ *
+ *  Return Value: The index, owned by the node, or NULL if the tokenizer
+ *                doesn't know the language of the file.
+ */
+struct symbols *highlight_symbols(struct list_node *node);
+
+/* hl_wprintw:  Prints a given line using its runs to dictate how to color
+ * -----------  the given line.
  *
  *   win:     The ncurses window to which the line will be written
  *   line:    The line to print
+ *   runs:    The runs of the line, or NULL to print it plain
  *   width:   The maximum width of a line
  *   offset:  Character (in line) to start at (0..length-1)
+ *   tabstop: The width of a tab
+ */
+void hl_wprintw(WINDOW * win, const char *line, const struct hl_run *runs,
+        int width, int offset, int tabstop);
+
+/* hl_wprintw_forget:  Forgets where hl_wprintw found the columns of long
+ * ------------------  lines. It remembers the lines by their address, so
+ *                     this must be called before the text of lines that
+ *                     were printed is freed or moved.
  */
-void hl_wprintw(WINDOW * win, const char *line, int width, int offset);
+void hl_wprintw_forget(void);
+
+/* hl_get_line: Gets a line of text for hl_regex.
+ * ------------
+ *
+ *  data:           The data passed to hl_regex.
+ *  line:           The index of the line.
+ *  runs:           If not NULL, returns the runs of the line, or NULL.
+ *
+ *  Return Value: The line, which hl_regex does not keep.
+ */
+typedef const char *(*hl_get_line) (void *data, int line,
+        const struct hl_run **runs);
+
+/* hl_regex_interrupt:  Sets the file descriptor that cancels a search split
+ * -------------------  up between processors when it becomes readable.
+ *
+ *   fd:  The descriptor, normally the terminal, or -1 for none.
+ */
+void hl_regex_interrupt(int fd);
+
+/* hl_regex_interrupted:  Determines if hl_regex_interrupt's descriptor is
+ * ---------------------  readable, for searches that check as they go.
+ *
+ *  Return Value: 1 if it is, 0 if not or if there's no descriptor.
+ */
+int hl_regex_interrupted(void);
+
+/* hl_regex_cflags: Gets the flags the searches compile with.
+ * ----------------
+ *
+ *  The searches of all the windows use the same, basic, syntax, so a
+ *  pattern means the same thing wherever it's typed.
+ *
+ *  icase:  1 if case is ignored
+ */
+int hl_regex_cflags(int icase);
+
+/* hl_regex_compile: Gets a regular expression compiled.
+ * -----------------
+ *
+ *  The last few expressions are kept compiled, since an incremental search
+ *  and 'n' run the same ones over and over. They're compiled for the
+ *  engine the regexpengine option picks.
+ *
+ *  regex:   The regular expression
+ *  cflags:  The flags to compile it with
+ *
+ *  Return Value: The compiled expression, owned by the cache, or NULL if
+ *                it doesn't compile.
+ */
+struct rx *hl_regex_compile(const char *regex, int cflags);
+
+/* hl_regex_all: Draws every match of a regular expression on a line, for
+ * -------------  the hlsearch option.
+ *
+ *  t:     The regular expression
+ *  line:  The line
+ *  runs:  The runs of the line, or NULL
+ *
+ *  Return Value: New runs with the matches drawn as HLG_HLSEARCH on top of
+ *                the line's runs, which MUST BE FREED, or NULL if nothing
+ *                matched.
+ */
+struct hl_run *hl_regex_all(struct rx *t, const char *line,
+        const struct hl_run *runs);
+
+/* hl_regex_line: Matches a regular expression to one line of a search.
+ * --------------
+ *
+ *  t:          The regular expression
+ *  line:       The line
+ *  first:      1 if this is the line the search started on
+ *  col:        On the first line, the column the last match left off at
+ *  direction:  1 if forward, 0 if reverse
+ *  match:      Returns the match, with columns from the start of the line
+ *
+ *  Return Value: 1 if there was a match, 0 if not.
+ */
+int hl_regex_line(struct rx *t, const char *line, int first, int col,
+        int direction, regmatch_t * match);
+
+/* hl_regex_reset: Forgets where the last incremental search got to. This
+ * ---------------  must be called when a new search starts, or the lines
+ *                  being searched change.
+ */
+void hl_regex_reset(void);
 
 /* hl_regex: Matches a regular expression to some lines.
  * ---------
  *
  *  regex:          The regular expression to match.
- *  tlines:         The lines of text to search.
+ *  get_line:       Gets the lines of text to search.
+ *  data:           Passed to get_line.
  *  length:         The number of lines.
- *  cur_line:       This line is returned with highlighting embedded into it.
+ *  cur_line:       Returns the runs to draw the matching line with.
  *  sel_line:       The current line the user is on.
  *  sel_rline:      The current line the regular expression is on.
  *  sel_col_rbeg:   The beggining index of the last match.
@@ -56,8 +272,12 @@ void hl_wprintw(WINDOW * win, const char *line, int width, int offset);
  *  opt:            1 -> incremental match, 2 -> perminant match
  *  direction:      1 if forward, 0 if reverse
  *  icase:          1 if case insensitive, 0 otherwise
+ *
+ *  Searches through more lines than the parallelsearch option are split
+ *  up between the processors, and treated as having no match if they're
+ *  cancelled by hl_regex_interrupt's descriptor.
  */
-int hl_regex(const char *regex, const char **highlighted_lines, const char **tlines, const int length, char **cur_line, /* Returns the correct highlighted line */
+int hl_regex(const char *regex, hl_get_line get_line, void *data, const int length, struct hl_run **cur_line, /* Returns the correct highlighted line */
         int *sel_line,          /* Returns new cur line if regex matches */
         int *sel_rline,         /* Used for internal purposes */
         int *sel_col_rbeg,
@@ -0,0 +1,320 @@
+/* highlight_cache.c:
+ * ------------------
+ *
+ * An on disk cache of the highlighting of source files.
+ *
+ * An entry is named after the hash of the path of its file, and holds a
+ * header, the path itself, the offset table of the highlighted buffer
+ * and then its block of runs. The blocks are read straight into the
+ * buffer's own arrays, so loading an entry is two reads past the header.
+ * Entries are written to a temporary file and renamed into place, so a
+ * cgdb that is killed while saving never leaves half an entry behind.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
+/* Local Includes */
+#include "highlight_cache.h"
+#include "cgdbrc.h"
+#include "fs_util.h"
+#include "std_hash.h"
+#include "sys_util.h"
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The name of the cache directory, in the config directory */
+#define HL_CACHE_DIR "hlcache"
+
+/* Change the version when the layout of an entry changes */
+#define HL_CACHE_MAGIC "cgdbhl1"
+
+/* The start of every entry */
+struct hl_cache_header {
+    char magic[8];              /* HL_CACHE_MAGIC */
+    uint32_t run_size;          /* sizeof (struct hl_run) when written */
+    uint32_t language;          /* The language the file was tokenized as */
+    int64_t size;               /* The size of the file */
+    int64_t mtime;              /* The timestamp of the file */
+    uint32_t path_length;       /* The length of the path that follows */
+    uint32_t lines;             /* The number of offsets that follow it */
+    uint32_t runs;              /* The number of runs that follow them */
+    uint32_t unused;
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+static char hl_cache_home[FSUTIL_PATH_MAX]; /* The config directory */
+static char hl_cache_dir[FSUTIL_PATH_MAX];  /* The cache directory */
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* hl_cache_enabled: Determines if the cache should be used.
+ * -----------------
+ */
+static int hl_cache_enabled(void)
+{
+    return hl_cache_dir[0] && cgdbrc_get(CGDBRC_HLCACHE)->variant.int_val;
+}
+
+/* read_all: Reads exactly length bytes from a file.
+ * ---------
+ *
+ * Return Value: 0 on success, -1 on error or a short file.
+ */
+static int read_all(int fd, void *data, size_t length)
+{
+    char *pos = data;
+    ssize_t n;
+
+    while (length > 0) {
+        if ((n = read(fd, pos, length)) <= 0)
+            return -1;
+
+        pos += n;
+        length -= n;
+    }
+
+    return 0;
+}
+
+/* write_all: Writes exactly length bytes to a file.
+ * ----------
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+static int write_all(FILE *file, const void *data, size_t length)
+{
+    return fwrite(data, 1, length, file) == length ? 0 : -1;
+}
+
+/* write_lines: Writes the offsets of a buffer's lines to a file.
+ * ------------
+ *
+ * The offsets are written from the start of the block they're in, rather
+ * than from the base of each line's block, a block of lines at a time.
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+static int write_lines(FILE *file, const struct buffer *buf)
+{
+    uint32_t lines[BUFFER_BLOCK];
+    int i, j, count;
+
+    for (i = 0; i < buf->length; i += BUFFER_BLOCK) {
+        count = buf->length - i < BUFFER_BLOCK ? buf->length - i :
+                BUFFER_BLOCK;
+
+        for (j = 0; j < count; j++)
+            lines[j] = buf->lines[i + j] == BUFFER_NO_LINE ? BUFFER_NO_LINE :
+                    buf->bases[i / BUFFER_BLOCK] + buf->lines[i + j];
+
+        if (write_all(file, lines, sizeof (uint32_t) * count) == -1)
+            return -1;
+    }
+
+    return 0;
+}
+
+/* hl_cache_read: Reads the entry of a node.
+ * --------------
+ *
+ * The entry is checked against the node, and its offsets and runs are
+ * checked so that a damaged entry can't send hl_wprintw past the end of
+ * the runs.
+ *
+ *   fd:      The entry
+ *   node:    The node the entry is for
+ *   header:  Returns the header of the entry
+ *   lines:   Returns the offsets, which must be freed even on error
+ *   runs:    Returns the runs, which must be freed even on error
+ *
+ * Return Value: 0 on success, -1 if the entry can't be used.
+ */
+static int hl_cache_read(int fd, struct list_node *node,
+        struct hl_cache_header *header, uint32_t ** lines,
+        struct hl_run **runs)
+{
+    char *path;
+    uint32_t i;
+    int ret;
+
+    *lines = NULL;
+    *runs = NULL;
+
+    if (read_all(fd, header, sizeof (struct hl_cache_header)) == -1)
+        return -1;
+
+    /* Make sure the entry is for this version of this file */
+    if (memcmp(header->magic, HL_CACHE_MAGIC, sizeof (header->magic)) != 0 ||
+            header->run_size != sizeof (struct hl_run) ||
+            header->language != node->language ||
+            header->size != (int64_t) node->file_size ||
+            header->mtime != (int64_t) node->last_modification ||
+            header->path_length != strlen(node->path) ||
+            header->lines != (uint32_t) node->orig_buf.length ||
+            header->runs >= BUFFER_NO_LINE)
+        return -1;
+
+    /* Two paths with the same hash share an entry */
+    path = cgdb_malloc(header->path_length + 1);
+    ret = read_all(fd, path, header->path_length);
+    path[header->path_length] = 0;
+    if (ret == 0 && strcmp(path, node->path) != 0)
+        ret = -1;
+    free(path);
+
+    if (ret == -1)
+        return -1;
+
+    *lines = cgdb_malloc(sizeof (uint32_t) *
+            (header->lines > 0 ? header->lines : 1));
+    if (read_all(fd, *lines, sizeof (uint32_t) * header->lines) == -1)
+        return -1;
+
+    if (header->runs > 0) {
+        *runs = cgdb_malloc(sizeof (struct hl_run) * header->runs);
+        if (read_all(fd, *runs, sizeof (struct hl_run) * header->runs) == -1)
+            return -1;
+
+        /* Every line's runs must end inside of the block */
+        if ((*runs)[header->runs - 1].length != 0)
+            return -1;
+    }
+
+    for (i = 0; i < header->lines; i++)
+        if ((*lines)[i] != BUFFER_NO_LINE && (*lines)[i] >= header->runs)
+            return -1;
+
+    return 0;
+}
+
+/* hl_cache_write: Writes the entry of a node, for fs_util_write_file.
+ * ---------------
+ */
+static int hl_cache_write(FILE *file, void *data)
+{
+    struct list_node *node = data;
+    struct hl_cache_header header;
+
+    memset(&header, 0, sizeof (header));
+    memcpy(header.magic, HL_CACHE_MAGIC, sizeof (header.magic));
+    header.run_size = sizeof (struct hl_run);
+    header.language = node->language;
+    header.size = node->file_size;
+    header.mtime = node->last_modification;
+    header.path_length = strlen(node->path);
+    header.lines = node->buf.length;
+    header.runs = node->buf.used;
+
+    if (write_all(file, &header, sizeof (header)) == -1 ||
+            write_all(file, node->path, header.path_length) == -1 ||
+            write_lines(file, &node->buf) == -1 ||
+            write_all(file, node->buf.runs,
+                    sizeof (struct hl_run) * header.runs) == -1)
+        return -1;
+
+    return 0;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in highlight_cache.h for function descriptions. */
+
+void hl_cache_init(const char *home_dir)
+{
+    strncpy(hl_cache_home, home_dir, FSUTIL_PATH_MAX - 1);
+    fs_util_get_path(hl_cache_home, HL_CACHE_DIR, hl_cache_dir);
+}
+
+int hl_cache_load(struct list_node *node)
+{
+    struct hl_cache_header header;
+    char entry[FSUTIL_PATH_MAX];
+    uint32_t *lines;
+    struct hl_run *runs;
+    int fd, ret;
+
+    if (!hl_cache_enabled())
+        return -1;
+
+    fs_util_get_hashed_path(hl_cache_dir, std_str_hash(node->path), entry);
+    if ((fd = open(entry, O_RDONLY)) == -1)
+        return -1;
+
+    ret = hl_cache_read(fd, node, &header, &lines, &runs);
+    cgdb_close(fd);
+
+    if (ret == -1) {
+        free(lines);
+        free(runs);
+        return -1;
+    }
+
+    /* The entry is good, it becomes the highlighted buffer. Its offsets
+     * are all from the start of the runs. */
+    free(node->buf.lines);
+    free(node->buf.bases);
+    free(node->buf.text);
+    free(node->buf.runs);
+    node->buf.length = header.lines;
+    node->buf.lines = lines;
+    node->buf.bases = cgdb_calloc(BUFFER_BLOCKS(header.lines),
+            sizeof (size_t));
+    node->buf.text = NULL;
+    node->buf.runs = runs;
+    node->buf.used = header.runs;
+    node->buf.size = header.runs;
+    node->buf.max_width = node->orig_buf.max_width;
+
+    return 0;
+}
+
+int hl_cache_save(struct list_node *node)
+{
+    char entry[FSUTIL_PATH_MAX];
+
+    /* Files that aren't highlighted have nothing to save, and the entry's
+     * offsets can't reach past 4GB of runs */
+    if (!hl_cache_enabled() || node->hl_lazy || !node->buf.lines ||
+            node->buf.used >= BUFFER_NO_LINE)
+        return -1;
+
+    if (!fs_util_create_dir_in_base(hl_cache_home, HL_CACHE_DIR))
+        return -1;
+
+    fs_util_get_hashed_path(hl_cache_dir, std_str_hash(node->path), entry);
+
+    return fs_util_write_file(entry, hl_cache_write, node);
+}
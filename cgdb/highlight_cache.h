@@ -0,0 +1,50 @@
+#ifndef _HIGHLIGHT_CACHE_H_
+#define _HIGHLIGHT_CACHE_H_
+
+/* highlight_cache.h:
+ * ------------------
+ *
+ * Keeps the highlighting of source files on disk, so the files don't have
+ * to be tokenized again the next time cgdb is run. Each file is cached in
+ * the hlcache directory of the config directory, and an entry is only
+ * used if the file's path, size, timestamp and language all still match.
+ * Nothing is read or written unless the hlcache option is on.
+ *
+ */
+
+/* Local Includes */
+#include "sources.h"
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* hl_cache_init:  Sets the directory the cache lives in.
+ * --------------
+ *
+ *   home_dir:  The config directory, the cache is kept in a directory
+ *              in it. It is created the first time an entry is saved.
+ */
+void hl_cache_init(const char *home_dir);
+
+/* hl_cache_load:  Fills in the highlighted buffer of a node from the cache.
+ * --------------
+ *
+ *   node:  The node, with its original buffer, language, file size and
+ *          timestamp already set.
+ *
+ * Return Value: 0 if the node was highlighted from the cache, -1 if
+ *               there was no usable entry for it.
+ */
+int hl_cache_load(struct list_node *node);
+
+/* hl_cache_save:  Saves the highlighted buffer of a node in the cache.
+ * --------------
+ *
+ *   node:  The node, which must be completely highlighted.
+ *
+ * Return Value: 0 on success, -1 on error or if the cache is off.
+ */
+int hl_cache_save(struct list_node *node);
+
+#endif /* _HIGHLIGHT_CACHE_H_ */
@@ -34,6 +34,19 @@ struct hl_group_info {
     int color_pair;
 };
 
+/** The most color pairs that are handed out, they're looked up one by one. */
+#define HL_COLOR_PAIRS_MAX 256
+
+/** A color pair that was set up with init_pair. */
+struct hl_color_pair {
+  /** The colors of the pair */
+    short fore_color, back_color;
+  /** The number of groups using it, a pair groups use is never reused. */
+    int groups;
+  /** When the pair was last asked for, the oldest one is reused first. */
+    unsigned long last_used;
+};
+
 /** The main context used to represent all of the highlighting groups. */
 struct hl_groups {
   /** If 0 then the terminal doesn't support colors, otherwise it does. */
@@ -42,6 +55,14 @@ struct hl_groups {
     int more_colors;
   /** This is the data for each highlighting group. */
     struct hl_group_info groups[HLG_LAST];
+  /** The attributes of each group, indexed by its kind. */
+    int attrs[HLG_LAST];
+  /** The color pairs handed out, pair n is at n - 1. */
+    struct hl_color_pair *pairs;
+  /** The number of pairs set up, and the most there can be. */
+    int pairs_count, pairs_size;
+  /** Incremented each time a pair is asked for. */
+    unsigned long tick;
 };
 
 static struct hl_group_info *lookup_group_info_by_key(struct hl_groups *groups,
@@ -59,6 +80,33 @@ static struct hl_group_info *lookup_group_info_by_key(struct hl_groups *groups,
     return NULL;
 }
 
+/**
+ * Works out the attributes of a group again, after it changed.
+ *
+ * \param hl_groups
+ * An instance of hl_groups to operate on.
+ *
+ * \param info
+ * The group that changed.
+ */
+static void update_attrs(hl_groups_ptr hl_groups, struct hl_group_info *info)
+{
+    int attr;
+
+    if (info->kind >= HLG_LAST)
+        return;
+
+    if (!hl_groups->in_color)
+        attr = info->mono_attrs;
+    else {
+        attr = info->color_attrs;
+        if (info->color_pair)
+            attr |= COLOR_PAIR(info->color_pair);
+    }
+
+    hl_groups->attrs[info->kind] = attr;
+}
+
 /** The global instance, this is used externally */
 hl_groups_ptr hl_groups_instance = NULL;
 
@@ -101,6 +149,11 @@ static const struct default_hl_group_info default_groups_for_curses[] = {
     {HLG_SELECTED_LINE_NUMBER, A_BOLD, A_BOLD, COLOR_WHITE, COLOR_BLACK},
     {HLG_ARROW_SEL, A_BOLD, A_BOLD, COLOR_WHITE, COLOR_BLACK},
     {HLG_LOGO, A_BOLD, A_BOLD, COLOR_BLUE, COLOR_BLACK},
+    {HLG_CHANGED, A_BOLD, A_BOLD, COLOR_RED, COLOR_BLACK},
+    {HLG_PROFILE_COOL, A_NORMAL, A_NORMAL, COLOR_BLUE, COLOR_BLACK},
+    {HLG_PROFILE_WARM, A_UNDERLINE, A_NORMAL, COLOR_YELLOW, COLOR_BLACK},
+    {HLG_PROFILE_HOT, A_REVERSE, A_BOLD, COLOR_BLACK, COLOR_RED},
+    {HLG_HLSEARCH, A_REVERSE, A_NORMAL, COLOR_BLACK, COLOR_YELLOW},
     {HLG_LAST, A_NORMAL, A_NORMAL, -1, -1}
 };
 
@@ -125,6 +178,11 @@ static const struct default_hl_group_info default_groups_for_background_dark[]
     {HLG_SELECTED_LINE_NUMBER, A_BOLD, A_BOLD, -1, -1},
     {HLG_ARROW_SEL, A_BOLD, A_BOLD, -1, -1},
     {HLG_LOGO, A_BOLD, A_BOLD, COLOR_BLUE, -1},
+    {HLG_CHANGED, A_BOLD, A_BOLD, COLOR_RED, -1},
+    {HLG_PROFILE_COOL, A_NORMAL, A_NORMAL, COLOR_BLUE, -1},
+    {HLG_PROFILE_WARM, A_UNDERLINE, A_NORMAL, COLOR_YELLOW, -1},
+    {HLG_PROFILE_HOT, A_REVERSE, A_BOLD, COLOR_BLACK, COLOR_RED},
+    {HLG_HLSEARCH, A_REVERSE, A_NORMAL, COLOR_BLACK, COLOR_YELLOW},
     {HLG_LAST, A_NORMAL, A_NORMAL, -1, -1}
 };
 
@@ -151,6 +209,11 @@ static struct hl_group_name hl_group_names[] = {
     {HLG_SELECTED_LINE_NUMBER, "SelectedLineNr"},
     {HLG_ARROW_SEL, "SelectedLineArrow"},
     {HLG_LOGO, "Logo"},
+    {HLG_CHANGED, "DiffChange"},
+    {HLG_PROFILE_COOL, "ProfileCool"},
+    {HLG_PROFILE_WARM, "ProfileWarm"},
+    {HLG_PROFILE_HOT, "ProfileHot"},
+    {HLG_HLSEARCH, "Search"},
     {HLG_LAST, NULL}
 };
 
@@ -272,6 +335,242 @@ static const struct color_info *color_spec_for_name(const char *name)
     return NULL;
 }
 
+/** The 16 ANSI colors as 0xRRGGBB, the way the VGA palette has them */
+static const int hl_ansi_rgb[16] = {
+    0x000000, 0xaa0000, 0x00aa00, 0xaa5500,
+    0x0000aa, 0xaa00aa, 0x00aaaa, 0xaaaaaa,
+    0x555555, 0xff5555, 0x55ff55, 0xffff55,
+    0x5555ff, 0xff55ff, 0x55ffff, 0xffffff
+};
+
+/** The levels of each part of the 6x6x6 color cube, colors 16 to 231 */
+static const int hl_cube_levels[6] = { 0, 95, 135, 175, 215, 255 };
+
+/**
+ * Gets what a color of the 256 color palette looks like.
+ *
+ * \param color
+ * The color, from 0 to 255.
+ *
+ * \return
+ * The color as 0xRRGGBB.
+ */
+static int palette_rgb(int color)
+{
+    int gray;
+
+    if (color < 16)
+        return hl_ansi_rgb[color];
+
+    if (color < 232) {
+        color -= 16;
+        return (hl_cube_levels[color / 36] << 16) |
+                (hl_cube_levels[color / 6 % 6] << 8) | hl_cube_levels[color % 6];
+    }
+
+    gray = 8 + (color - 232) * 10;
+    return (gray << 16) | (gray << 8) | gray;
+}
+
+/**
+ * Gets how far apart two colors look, roughly.
+ *
+ * \return
+ * The square of the distance between them, as 0xRRGGBB points.
+ */
+static int rgb_distance(int a, int b)
+{
+    int red = ((a >> 16) & 0xff) - ((b >> 16) & 0xff);
+    int green = ((a >> 8) & 0xff) - ((b >> 8) & 0xff);
+    int blue = (a & 0xff) - (b & 0xff);
+
+    return red * red + green * green + blue * blue;
+}
+
+/**
+ * Finds the ANSI color closest to a 24 bit color.
+ *
+ * \param rgb
+ * The color, as 0xRRGGBB.
+ *
+ * \param count
+ * The number of ANSI colors to pick from, 8 or 16.
+ *
+ * \return
+ * The closest color.
+ */
+static int nearest_ansi_color(int rgb, int count)
+{
+    int i, best = 0;
+
+    for (i = 1; i < count; i++)
+        if (rgb_distance(rgb, hl_ansi_rgb[i]) <
+                rgb_distance(rgb, hl_ansi_rgb[best]))
+            best = i;
+
+    return best;
+}
+
+/**
+ * Finds the color of the cube or of the gray ramp of the 256 color palette
+ * closest to a 24 bit color.
+ *
+ * \param rgb
+ * The color, as 0xRRGGBB.
+ *
+ * \return
+ * The closest color, from 16 to 255.
+ */
+static int nearest_palette_color(int rgb)
+{
+    int part[3], i, cube, gray, level;
+
+    part[0] = (rgb >> 16) & 0xff;
+    part[1] = (rgb >> 8) & 0xff;
+    part[2] = rgb & 0xff;
+
+    /* The cube levels are 40 apart, except for the first two */
+    for (i = 0; i < 3; i++)
+        part[i] = part[i] < 48 ? 0 : part[i] < 115 ? 1 : (part[i] - 35) / 40;
+    cube = 16 + part[0] * 36 + part[1] * 6 + part[2];
+
+    level = (((rgb >> 16) & 0xff) + ((rgb >> 8) & 0xff) + (rgb & 0xff)) / 3;
+    gray = level < 8 ? 232 : level > 238 ? 255 : 232 + (level - 3) / 10;
+
+    if (rgb_distance(rgb, palette_rgb(gray)) <
+            rgb_distance(rgb, palette_rgb(cube)))
+        return gray;
+
+    return cube;
+}
+
+/**
+ * Turns a color into one the terminal has. A 24 bit color is drawn with
+ * the closest color of the 256 color palette, and a color the terminal
+ * doesn't have with the closest of the ANSI colors it has.
+ *
+ * \param color
+ * The color number, -1 for the default, or HL_COLOR_RGB | 0xRRGGBB.
+ *
+ * \return
+ * The color number to pass to init_pair.
+ */
+static int terminal_color(int color)
+{
+    int ansi_colors = COLORS >= 16 ? 16 : 8;
+
+    if (color < 0)
+        return color;
+
+    if (color & HL_COLOR_RGB) {
+        color &= ~HL_COLOR_RGB;
+        if (COLORS >= 256)
+            return nearest_palette_color(color);
+        return nearest_ansi_color(color, ansi_colors);
+    }
+
+    if (color >= COLORS && color < 256)
+        return nearest_ansi_color(palette_rgb(color), ansi_colors);
+
+    return color;
+}
+
+/**
+ * Finds or sets up a color pair.
+ *
+ * The colors are turned into ones the terminal has first, with
+ * terminal_color. A pair with the same colors is shared. Once every pair has been set up,
+ * the one asked for least recently that no group uses is set up again
+ * with the new colors.
+ *
+ * \param hl_groups
+ * An instance of hl_groups to operate on.
+ *
+ * \param fore_color
+ * The foreground color
+ *
+ * \param back_color
+ * The backgroud color
+ *
+ * \param group
+ * 1 if a group will use the pair, it has to be released with
+ * release_color_pair when the group stops using it.
+ *
+ * \return
+ * The color pair, or 0 if none is free.
+ */
+static int
+get_color_pair(hl_groups_ptr hl_groups, int fore_color, int back_color,
+        int group)
+{
+    struct hl_color_pair *pair;
+    int i, lru = -1;
+
+    fore_color = terminal_color(fore_color);
+    back_color = terminal_color(back_color);
+
+    if (!hl_groups->pairs) {
+        hl_groups->pairs_size = COLOR_PAIRS - 1 < HL_COLOR_PAIRS_MAX ?
+                COLOR_PAIRS - 1 : HL_COLOR_PAIRS_MAX;
+        if (hl_groups->pairs_size <= 0)
+            return 0;
+        hl_groups->pairs = (struct hl_color_pair *)
+                malloc(sizeof (struct hl_color_pair) * hl_groups->pairs_size);
+        if (!hl_groups->pairs)
+            return 0;
+    }
+
+    for (i = 0; i < hl_groups->pairs_count; i++) {
+        pair = &hl_groups->pairs[i];
+
+        if (pair->fore_color == fore_color && pair->back_color == back_color) {
+            pair->last_used = ++hl_groups->tick;
+            pair->groups += group;
+            return i + 1;
+        }
+
+        if (pair->groups == 0 &&
+                (lru == -1 || pair->last_used < hl_groups->pairs[lru].last_used))
+            lru = i;
+    }
+
+    if (hl_groups->pairs_count < hl_groups->pairs_size)
+        i = hl_groups->pairs_count;
+    else if (lru != -1)
+        i = lru;
+    else
+        return 0;
+
+    if (init_pair(i + 1, fore_color, back_color) != OK)
+        return 0;
+
+    if (i == hl_groups->pairs_count)
+        hl_groups->pairs_count++;
+
+    pair = &hl_groups->pairs[i];
+    pair->fore_color = fore_color;
+    pair->back_color = back_color;
+    pair->groups = group;
+    pair->last_used = ++hl_groups->tick;
+
+    return i + 1;
+}
+
+/**
+ * Lets a color pair a group stopped using be reused.
+ *
+ * \param hl_groups
+ * An instance of hl_groups to operate on.
+ *
+ * \param color_pair
+ * The pair from get_color_pair, 0 is ignored.
+ */
+static void release_color_pair(hl_groups_ptr hl_groups, int color_pair)
+{
+    if (color_pair > 0 && color_pair <= hl_groups->pairs_count)
+        hl_groups->pairs[color_pair - 1].groups--;
+}
+
 /**
  * Set up a highlighting group to be displayed as the user wishes.
  *
@@ -297,9 +596,8 @@ static int
 setup_group(hl_groups_ptr hl_groups, enum hl_group_kind group,
         int mono_attrs, int color_attrs, int fore_color, int back_color)
 {
-  /** Starts creating new colors at 1, and then is incremented each time. */
-    static int next_color_pair = 1;
     struct hl_group_info *info;
+    int color_pair;
 
     if (!hl_groups)
         return -1;
@@ -313,6 +611,7 @@ setup_group(hl_groups_ptr hl_groups, enum hl_group_kind group,
         info->mono_attrs = mono_attrs;
     if (color_attrs != UNSPECIFIED_COLOR)
         info->color_attrs = color_attrs;
+    update_attrs(hl_groups, info);
 
     /* The rest of this function sets up the colors, so we can stop here
      * if color isn't used. */
@@ -348,19 +647,14 @@ setup_group(hl_groups_ptr hl_groups, enum hl_group_kind group,
     if (fore_color < 0 && back_color < 0 && info->color_pair == 0)
         return 0;
 
-    /* Allocate a new color pair if the group doesn't have one yet. */
-    if (info->color_pair == 0) {
-        info->color_pair = next_color_pair;
-        next_color_pair += 1;
-    }
-
-    /* Set up the color pair. */
-    if (info->color_pair < COLOR_PAIRS) {
-        if (init_pair(info->color_pair, fore_color, back_color) != OK)
-            return -1;
-    } else
+    /* Groups with the same colors share a pair. */
+    if ((color_pair = get_color_pair(hl_groups, fore_color, back_color, 1)) == 0)
         return -1;
 
+    release_color_pair(hl_groups, info->color_pair);
+    info->color_pair = color_pair;
+    update_attrs(hl_groups, info);
+
     return 0;
 }
 
@@ -380,6 +674,10 @@ hl_groups_ptr hl_groups_initialize(void)
 
     hl_groups->in_color = 0;
     hl_groups->more_colors = 0;
+    hl_groups->pairs = NULL;
+    hl_groups->pairs_count = 0;
+    hl_groups->pairs_size = 0;
+    hl_groups->tick = 0;
 
     for (i = 0; i < HLG_LAST; ++i) {
         struct hl_group_info *info;
@@ -387,16 +685,20 @@ hl_groups_ptr hl_groups_initialize(void)
         info = &hl_groups->groups[i];
         info->kind = i + 1;
         info->mono_attrs = 0;
-        info->mono_attrs = 0;
+        info->color_attrs = 0;
         info->color_pair = 0;
     }
 
+    for (i = 0; i < HLG_LAST; ++i)
+        hl_groups->attrs[i] = 0;
+
     return hl_groups;
 }
 
 int hl_groups_shutdown(hl_groups_ptr hl_groups)
 {
     if (hl_groups) {
+        free(hl_groups->pairs);
         free(hl_groups);
         hl_groups = NULL;
     }
@@ -442,34 +744,56 @@ int hl_groups_setup(hl_groups_ptr hl_groups)
         }
     }
 
+    /* in_color may have changed, so every group is worked out again */
+    for (i = 0; i < HLG_LAST - 1; ++i)
+        update_attrs(hl_groups, &hl_groups->groups[i]);
+
     return 0;
 }
 
 int
 hl_groups_get_attr(hl_groups_ptr hl_groups, enum hl_group_kind kind, int *attr)
 {
-    struct hl_group_info *info = lookup_group_info_by_key(hl_groups, kind);
-
-    if (!hl_groups || !info || !attr)
+    if (!hl_groups || kind < HLG_KEYWORD || kind >= HLG_LAST || !attr)
         return -1;
 
-    if (!hl_groups->in_color)
-        *attr = info->mono_attrs;
-    else {
-        *attr = info->color_attrs;
-        if (info->color_pair)
-            *attr |= COLOR_PAIR(info->color_pair);
-    }
+    *attr = hl_groups->attrs[kind];
 
     return 0;
 }
 
+const int *hl_groups_get_attrs(hl_groups_ptr hl_groups)
+{
+    return hl_groups->attrs;
+}
+
+int
+hl_groups_get_color_pair(hl_groups_ptr hl_groups, int fore_color,
+        int back_color)
+{
+    if (!hl_groups || !hl_groups->in_color)
+        return 0;
+
+    /* Don't allow -1 to be used in curses mode */
+#ifndef NCURSES_VERSION
+    if (fore_color < 0 || back_color < 0)
+        return 0;
+#else
+    /* The default colors don't need a pair */
+    if (fore_color < 0 && back_color < 0)
+        return 0;
+#endif
+
+    return get_color_pair(hl_groups, fore_color, back_color, 0);
+}
+
 int hl_groups_parse_config(hl_groups_ptr hl_groups)
 {
     int token, val;
     const char *name;
     int mono_attrs = UNSPECIFIED_COLOR, color_attrs = UNSPECIFIED_COLOR;
     int fg_color = UNSPECIFIED_COLOR, bg_color = UNSPECIFIED_COLOR;
+    int gui_fg_color = UNSPECIFIED_COLOR, gui_bg_color = UNSPECIFIED_COLOR;
     int key, attrs, color;
     const struct color_info *color_spec;
     enum hl_group_kind group_kind;
@@ -479,6 +803,8 @@ int hl_groups_parse_config(hl_groups_ptr hl_groups)
         CTERM,
         FG,
         BG,
+        GUIFG,
+        GUIBG,
         IGNORE
     };
 
@@ -537,6 +863,10 @@ int hl_groups_parse_config(hl_groups_ptr hl_groups)
             key = FG;
         else if (strcasecmp(name, "ctermbg") == 0)
             key = BG;
+        else if (strcasecmp(name, "guifg") == 0)
+            key = GUIFG;
+        else if (strcasecmp(name, "guibg") == 0)
+            key = GUIBG;
         else
             key = IGNORE;
 
@@ -604,12 +934,19 @@ int hl_groups_parse_config(hl_groups_ptr hl_groups)
 
             case FG:
             case BG:
+            case GUIFG:
+            case GUIBG:
                 attrs = 0;
                 switch (token) {
                     case NUMBER:
                         color = atoi(get_token());
                         break;
 
+                    case COLOR:
+                        color = HL_COLOR_RGB |
+                                (int) strtol(get_token() + 1, NULL, 16);
+                        break;
+
                     case IDENTIFIER:
                         name = get_token();
                         color_spec = color_spec_for_name(name);
@@ -642,8 +979,12 @@ int hl_groups_parse_config(hl_groups_ptr hl_groups)
                 }
                 if (key == FG)
                     fg_color = color;
-                else
+                else if (key == BG)
                     bg_color = color;
+                else if (key == GUIFG)
+                    gui_fg_color = color;
+                else
+                    gui_bg_color = color;
                 token = yylex();
                 break;
 
@@ -661,6 +1002,12 @@ int hl_groups_parse_config(hl_groups_ptr hl_groups)
         }
     }
 
+    /* The colors picked for terminals win over the 24 bit ones */
+    if (fg_color == UNSPECIFIED_COLOR)
+        fg_color = gui_fg_color;
+    if (bg_color == UNSPECIFIED_COLOR)
+        bg_color = gui_bg_color;
+
     val = setup_group(hl_groups, group_kind, mono_attrs, color_attrs, fg_color,
             bg_color);
     if (val == -1) {
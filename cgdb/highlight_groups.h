@@ -42,12 +42,23 @@ enum hl_group_kind {
     HLG_SELECTED_LINE_NUMBER,
     HLG_ARROW_SEL,
     HLG_LOGO,
+    HLG_CHANGED,
+    HLG_PROFILE_COOL,
+    HLG_PROFILE_WARM,
+    HLG_PROFILE_HOT,
+    HLG_HLSEARCH,
 
     HLG_LAST
 };
 
 /* }}}*/
 
+/**
+ * Marks a color as a 24 bit one, HL_COLOR_RGB | 0xRRGGBB, instead of a
+ * color number. It's drawn with the closest color the terminal has.
+ */
+#define HL_COLOR_RGB 0x1000000
+
 /* Createing and Destroying a hl_groups context. {{{*/
 /******************************************************************************/
 /**
@@ -138,6 +149,46 @@ int hl_groups_setup(hl_groups_ptr hl_groups);
 int hl_groups_get_attr(hl_groups_ptr hl_groups, enum hl_group_kind kind,
         int *attr);
 
+/**
+ * Get the attributes of every group at once, indexed by the group. They're
+ * the same as hl_groups_get_attr gets, but the table is only worked out
+ * again when a group changes, so drawing a group only costs reading it.
+ *
+ * \param hl_groups
+ * An instance of hl_groups to operate on.
+ *
+ * \return
+ * The table, with HLG_LAST entries. It's kept up to date until
+ * hl_groups_shutdown is called.
+ */
+const int *hl_groups_get_attrs(hl_groups_ptr hl_groups);
+
+/**
+ * Get a color pair for text that isn't drawn as one of the groups, such as
+ * the colors programs print with ANSI escape sequences.
+ *
+ * Pairs are shared with the groups, and the pairs no group uses are reused
+ * once they run out, the least recently asked for first. So the pair should
+ * be asked for each time the text is drawn.
+ *
+ * \param hl_groups
+ * An instance of hl_groups to operate on.
+ *
+ * The colors are color numbers, or 24 bit colors made with HL_COLOR_RGB.
+ * Colors the terminal doesn't have are drawn with the closest ones it has.
+ *
+ * \param fore_color
+ * The foreground color, -1 for the default.
+ *
+ * \param back_color
+ * The background color, -1 for the default.
+ *
+ * \return
+ * The color pair to pass to COLOR_PAIR, or 0 for the default colors.
+ */
+int hl_groups_get_color_pair(hl_groups_ptr hl_groups, int fore_color,
+        int back_color);
+
 /**
  * Parse a particular command. This may move into the cgdbrc file later on.
  *
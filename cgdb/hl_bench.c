@@ -0,0 +1,234 @@
+/* hl_bench.c:
+ * -----------
+ *
+ * Measures how many times a second the source viewer can redraw a whole
+ * window. The file given on the command line is loaded and highlighted,
+ * then the viewer is scrolled through it a line at a time, redrawing the
+ * window each time, as if the user was holding down 'j'.
+ *
+ * How long loading and highlighting the file took is printed too. Next
+ * to lib/tokenizer's "tokenizer_driver -b", it shows what building the
+ * runs costs on top of the lexer.
+ *
+ * Last, it times '?' searches on a long line that's one run of matches,
+ * each overlapping the next, which would be quadratic if the line was
+ * searched again from each match.
+ *
+ * Usage: hl_bench FILE [SECONDS]
+ *
+ * Run it in the biggest terminal you care about, the result is printed
+ * when it finishes.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_STDARG_H
+#include <stdarg.h>
+#endif /* HAVE_STDARG_H */
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif /* HAVE_SYS_TIME_H */
+
+#ifdef HAVE_SYS_SELECT_H
+#include <sys/select.h>
+#endif /* HAVE_SYS_SELECT_H */
+
+#if HAVE_CURSES_H
+#include <curses.h>
+#elif HAVE_NCURSES_CURSES_H
+#include <ncurses/curses.h>
+#endif /* HAVE_CURSES_H */
+
+/* Local Includes */
+#include "sources.h"
+#include "highlight.h"
+#include "highlight_groups.h"
+#include "cgdbrc.h"
+#include "interface.h"
+
+/* The length of the line searched, and the patterns searched for on it */
+#define BENCH_LINE 100000
+static const char *bench_patterns[] = { "a\\+", "a.*" };
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+/* The options the viewer asks for, with cgdb's default values */
+static struct cgdbrc_config_option options[CGDBRC_WRAPSCAN + 1];
+
+/* The options the viewer draws with, with cgdb's default values */
+static const struct cgdbrc_snapshot config = { 0, 0, ARROWSTYLE_SHORT, 8 };
+
+/* ------------------------------------ */
+/* What the viewer needs from the rest */
+/* ------------------------------------ */
+
+cgdbrc_config_option_ptr cgdbrc_get(enum cgdbrc_option_kind option)
+{
+    return &options[option];
+}
+
+void if_print_message(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+}
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* bench_search: Times searching backwards on a line of overlapping matches.
+ * -------------
+ */
+static void bench_search(double seconds)
+{
+    char *line = malloc(BENCH_LINE + 1);
+    double start, elapsed;
+    regmatch_t match;
+    struct rx *t;
+    int searches, i;
+
+    memset(line, 'a', BENCH_LINE);
+    line[BENCH_LINE] = '\0';
+
+    for (i = 0; i < sizeof (bench_patterns) / sizeof (bench_patterns[0]);
+            i++) {
+        if (!(t = hl_regex_compile(bench_patterns[i], hl_regex_cflags(0))))
+            continue;
+
+        searches = 0;
+        start = now();
+        do {
+            hl_regex_line(t, line, 1, BENCH_LINE, 0, &match);
+            searches++;
+        } while ((elapsed = now() - start) < seconds);
+
+        printf("%d searches for ?%s on a %d byte line in %.2f seconds: "
+                "%.3f ms each\n", searches, bench_patterns[i], BENCH_LINE,
+                elapsed, elapsed * 1000 / searches);
+    }
+
+    free(line);
+}
+
+static int init_curses(void)
+{
+    initscr();
+    cbreak();
+    noecho();
+
+    if (has_colors()) {
+        start_color();
+#ifdef NCURSES_VERSION
+        use_default_colors();
+#endif
+    }
+
+    hl_groups_instance = hl_groups_initialize();
+    if (!hl_groups_instance || hl_groups_setup(hl_groups_instance) == -1)
+        return -1;
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    struct sviewer *sview;
+    double seconds = 5, start, elapsed, loaded;
+    int frames = 0, line = 1, length, height, width;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s FILE [SECONDS]\n", argv[0]);
+        return 1;
+    }
+
+    if (argc > 2)
+        seconds = atof(argv[2]);
+
+    if (highlight_init() == -1) {
+        fprintf(stderr, "%s: could not start the highlighting worker\n",
+                argv[0]);
+        return 1;
+    }
+
+    if (init_curses() == -1) {
+        endwin();
+        fprintf(stderr, "%s: could not set up colors\n", argv[0]);
+        return 1;
+    }
+
+    getmaxyx(stdscr, height, width);
+    sview = source_new(0, 0, height, width);
+
+    start = now();
+    if (source_set_exec_line(sview, argv[1], 1) ||
+            (length = source_length(sview, argv[1])) <= 0) {
+        endwin();
+        fprintf(stderr, "%s: could not load %s\n", argv[0], argv[1]);
+        return 1;
+    }
+
+    /* Wait for the worker to finish highlighting the file first */
+    source_display(sview, 1, WIN_REFRESH, &config);
+    while (highlight_busy()) {
+        fd_set rset;
+
+        FD_ZERO(&rset);
+        FD_SET(highlight_fd(), &rset);
+        select(highlight_fd() + 1, &rset, NULL, NULL, NULL);
+        source_highlighted(sview);
+    }
+    loaded = now() - start;
+
+    start = now();
+    do {
+        source_set_exec_line(sview, NULL, line);
+        source_display(sview, 1, WIN_REFRESH, &config);
+        frames++;
+
+        if (++line > length)
+            line = 1;
+    } while ((elapsed = now() - start) < seconds);
+
+    endwin();
+    source_free(sview);
+
+    printf("%d lines loaded and highlighted in %.3f seconds\n", length,
+            loaded);
+    printf("%d redraws of a %dx%d window in %.2f seconds: %.1f redraws/s\n",
+            frames, width, height, elapsed, frames / elapsed);
+
+    bench_search(seconds / 5);
+
+    return 0;
+}
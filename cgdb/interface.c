@@ -48,6 +48,14 @@
 #include <ctype.h>
 #endif
 
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif /* HAVE_SYS_TIME_H */
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
 /* Local Includes */
 #include "assert.h"
 #include "cgdb.h"
@@ -59,10 +67,27 @@
 #include "sources.h"
 #include "tgdb.h"
 #include "filedlg.h"
+#include "grep.h"
+#include "capwin.h"
+#include "loader.h"
+#include "disasm.h"
+#include "watch.h"
+#include "memwin.h"
+#include "btwin.h"
+#include "brkwin.h"
+#include "thrwin.h"
+#include "logwin.h"
 #include "cgdbrc.h"
 #include "highlight.h"
 #include "highlight_groups.h"
 #include "fs_util.h"
+#include "sys_util.h"
+#include "ibuf.h"
+#include "io.h"
+#include "wm.h"
+#include "stats.h"
+#include "tracer.h"
+#include "termout.h"
 
 /* ----------- */
 /* Prototypes  */
@@ -107,12 +132,96 @@ static struct scroller *gdb_win = NULL; /* The GDB input/output window */
 static struct scroller *tty_win = NULL; /* The tty input/output window */
 static int tty_win_on = 0;      /* Flag: tty window being shown */
 static struct sviewer *src_win = NULL;  /* The source viewer window */
+static struct sviewer *asm_win = NULL;  /* The disassembly viewer window */
+static int disasm_on = 0;       /* Flag: disassembly window being shown */
+static int watch_on = 0;        /* Flag: watch window being shown */
+static int memory_on = 0;       /* Flag: memory window being shown */
+static int backtrace_on = 0;    /* Flag: backtrace window being shown */
+static int breakwin_on = 0;     /* Flag: breakpoint window being shown */
+static int threadwin_on = 0;    /* Flag: thread window being shown */
+static int logwin_on = 0;       /* Flag: log window being shown */
+static int core_on = 0;         /* Flag: gdb debugs a core dump */
 static WINDOW *status_win = NULL;   /* The status line */
 static WINDOW *tty_status_win = NULL;   /* The tty status line */
 static enum Focus focus = GDB;  /* Which pane is currently focused */
 static struct winsize screen_size;  /* Screen size */
 
+/* A pane of the screen, laid out by the window manager. Its widget keeps its
+ * own curses windows, they're moved to wherever the pane is put. */
+struct if_pane {
+    wm_window window;
+    enum Focus focus;           /* CGDB, TTY, DISASM, WATCH, MEMORY,
+                                 * BACKTRACE, BREAKPOINTS, THREADS, LOG or
+                                 * GDB, the widget in the pane */
+};
+
+static window_manager *wm = NULL;   /* Arranges the panes */
+static struct if_pane *src_pane;    /* The source window and its status bar */
+static struct if_pane *tty_pane;    /* The tty window, NULL when not shown */
+static struct if_pane *gdb_pane;    /* The GDB window */
+static struct if_pane *asm_pane;    /* The disassembly, NULL when not shown */
+static struct if_pane *watch_pane;  /* The watch window, NULL when not shown */
+static struct if_pane *memory_pane; /* The memory, NULL when not shown */
+static struct if_pane *backtrace_pane;  /* The frames, NULL when not shown */
+static struct if_pane *breakpoints_pane;    /* NULL when not shown */
+static struct if_pane *threads_pane;    /* NULL when not shown */
+static struct if_pane *log_pane;    /* The log window, NULL when not shown */
+
+/* The instruction gdb is at, and the one gdb was asked to disassemble the
+ * function of, or 0 for none. The function of asm_failed couldn't be. */
+static unsigned long asm_pc, asm_requested, asm_failed;
+
+/* The function gdb last stopped in, for the watch window once it's shown */
+static char *watch_stopped_in;
+
 struct filedlg *fd;             /* The file dialog structure */
+static struct filedlg *grep_dlg;    /* The matches of a project search */
+static int grep_dlg_count;      /* The number of matches in grep_dlg */
+static char *grep_pending;      /* The search waiting for the files */
+static struct capwin *capture_dlg;  /* The output of a command captured */
+
+/* The output in the scrollers and the log that's waiting to be drawn */
+static int frame_gdb, frame_tty, frame_log;
+static struct timeval frame_time;   /* When the scrollers were last drawn */
+
+/* The most output a flooded scroller holds on to between frames */
+#define FLOOD_TAIL (64 * 1024)
+
+/* A scroller getting more output a second than the floodrate option. Only
+ * the last of it is kept for each frame, what came before that is counted
+ * instead of being added to the scroller. */
+struct flood {
+    struct timeval start;       /* When the second being counted began */
+    size_t bytes;               /* The bytes printed since then */
+    int on;                     /* 1 while it's flooded */
+    size_t skipped;             /* The bytes left out since the last frame */
+    char tail[FLOOD_TAIL];      /* The last bytes printed, not drawn yet */
+    size_t tail_length;
+};
+
+static struct flood gdb_flood, tty_flood;
+static int flood_log = -1;      /* Gets all the program's output, or -1 */
+
+/* How long drawing takes, for the statistics */
+static struct stats_histogram stats_draw_source =
+        STATS_HISTOGRAM("draw source window");
+static struct stats_histogram stats_draw_tty =
+        STATS_HISTOGRAM("draw tty window");
+static struct stats_histogram stats_draw_gdb =
+        STATS_HISTOGRAM("draw gdb window");
+static struct stats_histogram stats_draw_frame =
+        STATS_HISTOGRAM("draw frame");
+
+/* When the oldest key that wasn't drawn yet was pressed, or 0. A key that
+ * isn't drawn within a second didn't change the screen, it's dropped. */
+#define KEY_STALE_USEC 1000000
+static struct stats_histogram stats_keypress =
+        STATS_HISTOGRAM("keypress to screen");
+static unsigned long long key_time;
+
+/* The source files of the program, as last given to the file dialog */
+static char **source_files;
+static int source_files_count;
 
 /* The regex the user is entering */
 static struct ibuf *regex_cur = NULL;
@@ -136,7 +245,9 @@ enum StatusBarCommandKind {
     /* This is represented by a : */
     SBC_NORMAL,
     /* This is set when a regular expression is being entered */
-    SBC_REGEX
+    SBC_REGEX,
+    /* The same, for the GDB window while it's scrolled back */
+    SBC_GDB_REGEX
 };
 
 static enum StatusBarCommandKind sbc_kind;
@@ -155,7 +266,9 @@ static int init_curses()
     if (putenv("ESCDELAY=0") == -1)
         fprintf(stderr, "(%s:%d) putenv failed\r\n", __FILE__, __LINE__);
 
-    initscr();                  /* Start curses mode */
+    /* Start curses mode, a frame at a time when it can be */
+    if (termout_start() == -1)
+        initscr();
 
     if ((curses_colors = has_colors())) {
         start_color();
@@ -169,180 +282,121 @@ static int init_curses()
 
     refresh();                  /* Refresh the initial window once */
     curses_initialized = 1;
+    if_bracketed_paste(1);
 
     return 0;
 }
 
-/* --------------------------------------
- * Theses get the position of each window
- * -------------------------------------- */
-
-/* These are for the source window */
-static int get_src_row(void)
-{
-    return 0;
-}
-
-static int get_src_col(void)
-{
-    return 0;
-}
+/* ---------------------------------------
+ * Theses get the height of each window, the
+ * window manager places them top to bottom
+ * --------------------------------------- */
 
+/* This is for the source window, without its status bar */
 static int get_src_height(void)
 {
     return ((int) (((screen_size.ws_row + 0.5) / 2) + window_height_shift));
 }
 
-static int get_src_width(void)
-{
-    return (screen_size.ws_col);
-}
-
-/* This is for the source window status bar */
-static int get_src_status_row(void)
-{
-    /* Usually would be 'get_src_row() + get_src_height()' but
-     * the row is 0 */
-    return get_src_height();
-}
-
-static int get_src_status_col(void)
-{
-    return 0;
-}
-
-static int get_src_status_height(void)
+/* This is for the tty I/O window, without its status bar */
+static int get_tty_height(void)
 {
-    return 1;
+    return TTY_WIN_OFFSET;
 }
 
-static int get_src_status_width(void)
+/* This is for the debugger window, it gets the rest of the screen */
+int get_gdb_height(void)
 {
-    return (screen_size.ws_col);
-}
+    int window_size = ((screen_size.ws_row / 2) - window_height_shift - 1);
+    int odd_screen_size = (screen_size.ws_row % 2);
 
-/* This is for the tty I/O window */
-static int get_tty_row(void)
-{
-    return get_src_status_row() + get_src_status_height();
-}
+    if (tty_win_on)
+        return window_size - TTY_WIN_OFFSET + odd_screen_size - 1;
 
-static int get_tty_col(void)
-{
-    return 0;
+    return window_size + odd_screen_size;
 }
 
-static int get_tty_height(void)
-{
-    return TTY_WIN_OFFSET;
-}
+/* ---------------------------------------
+ * Below is the core body of the interface
+ * --------------------------------------- */
 
-static int get_tty_width(void)
+/* draw_message: Puts a message on the status bar, without refreshing it.
+ * -------------
+ *
+ *  msg:   The start of the message, always shown
+ *  width: The width it's shown in, or 0 for the status bar's
+ *  text:  The rest of the message, only its end is shown if it's too long
+ */
+static void draw_message(const char *msg, int width, const char *text)
 {
-    return (screen_size.ws_col);
-}
+    char buf_display[MAXLINE];
+    int error_length, length;
+    int attr = hl_groups_get_attrs(hl_groups_instance)[HLG_STATUS_BAR];
 
-/* This is for the tty I/O status bar line */
-static int get_tty_status_row(void)
-{
-    return get_tty_row() + get_tty_height();
-}
+    curs_set(0);
 
-static int get_tty_status_col(void)
-{
-    return 0;
-}
+    if (!width)
+        width = WIDTH;
 
-static int get_tty_status_height(void)
-{
-    return 1;
-}
+    error_length = strlen(msg);
+    length = strlen(text);
 
-static int get_tty_status_width(void)
-{
-    return (screen_size.ws_col);
-}
+    if (error_length > width)
+        strcat(strncpy(buf_display, msg, width - 1), ">");
+    else if (error_length + length > width)
+        snprintf(buf_display, sizeof (buf_display), "%s>%s", msg,
+                text + (length - (width - error_length) + 1));
+    else
+        snprintf(buf_display, sizeof (buf_display), "%s%s", msg, text);
 
-/* This is for the debugger window */
-static int get_gdb_row(void)
-{
-    if (tty_win_on)
-        return get_tty_status_row() + get_tty_status_height();
+    /* Print white background */
+    mvwhline(status_win, 0, 0, ' ' | attr, WIDTH);
 
-    return get_src_status_row() + get_src_status_height();
+    wattron(status_win, attr);
+    mvwprintw(status_win, 0, 0, "%s", buf_display);
+    wattroff(status_win, attr);
 }
 
-static int get_gdb_col(void)
+/* Updates the tty status bar, without refreshing it */
+static void draw_tty_status(void)
 {
-    return 0;
-}
+    int attr = hl_groups_get_attrs(hl_groups_instance)[HLG_STATUS_BAR];
 
-int get_gdb_height(void)
-{
-    int window_size = ((screen_size.ws_row / 2) - window_height_shift - 1);
-    int odd_screen_size = (screen_size.ws_row % 2);
+    mvwhline(tty_status_win, 0, 0, ' ' | attr, WIDTH);
 
-    if (tty_win_on)
-        return window_size - TTY_WIN_OFFSET + odd_screen_size - 1;
+    wattron(tty_status_win, attr);
+    mvwprintw(tty_status_win, 0, 0, "%s", (char *) tgdb_tty_name(tgdb));
+    wattroff(tty_status_win, attr);
 
-    return window_size + odd_screen_size;
-}
+    /* Show the user if the tty window is focused */
+    if (focus == TTY)
+        mvwaddch(tty_status_win, 0, WIDTH - 1, '*' | attr);
 
-static int get_gdb_width(void)
-{
-    return (screen_size.ws_col);
+    wnoutrefresh(tty_status_win);
 }
 
-/* ---------------------------------------
- * Below is the core body of the interface
- * --------------------------------------- */
-
 /* Updates the status bar */
-static void update_status_win(void)
+static void update_status_win(enum win_refresh dorefresh)
 {
-    int pos;
     char filename[FSUTIL_PATH_MAX];
-    int attr;
-
-    if (hl_groups_get_attr(hl_groups_instance, HLG_STATUS_BAR, &attr) == -1)
-        return;
-
-    /* Update the tty status bar */
-    if (tty_win_on) {
-        wattron(tty_status_win, attr);
-        for (pos = 0; pos < WIDTH; pos++)
-            mvwprintw(tty_status_win, 0, pos, " ");
-
-        mvwprintw(tty_status_win, 0, 0, (char *) tgdb_tty_name(tgdb));
-        wattroff(tty_status_win, attr);
-    }
+    int attr = hl_groups_get_attrs(hl_groups_instance)[HLG_STATUS_BAR];
 
     /* Print white background */
-    wattron(status_win, attr);
-    for (pos = 0; pos < WIDTH; pos++)
-        mvwprintw(status_win, 0, pos, " ");
-    if (tty_win_on)
-        wattron(tty_status_win, attr);
-    /* Show the user which window is focused */
+    mvwhline(status_win, 0, 0, ' ' | attr, WIDTH);
+
+    /* Show the user if the gdb window is focused */
     if (focus == GDB)
-        mvwprintw(status_win, 0, WIDTH - 1, "*");
-    else if (focus == TTY && tty_win_on)
-        mvwprintw(tty_status_win, 0, WIDTH - 1, "*");
-    else if (focus == CGDB || focus == CGDB_STATUS_BAR)
-        mvwprintw(status_win, 0, WIDTH - 1, " ");
-    wattroff(status_win, attr);
-    if (tty_win_on)
-        wattroff(tty_status_win, attr);
+        mvwaddch(status_win, 0, WIDTH - 1, '*' | attr);
 
     /* Print the regex that the user is looking for Forward */
-    if (focus == CGDB_STATUS_BAR && sbc_kind == SBC_REGEX
+    if (focus == CGDB_STATUS_BAR && sbc_kind != SBC_NORMAL
             && regex_direction_cur) {
-        if_display_message("/", WIDTH - 1, "%s", ibuf_get(regex_cur));
+        draw_message("/", WIDTH - 1, ibuf_get(regex_cur));
         curs_set(1);
     }
     /* Regex backwards */
-    else if (focus == CGDB_STATUS_BAR && sbc_kind == SBC_REGEX) {
-        if_display_message("?", WIDTH - 1, "%s", ibuf_get(regex_cur));
+    else if (focus == CGDB_STATUS_BAR && sbc_kind != SBC_NORMAL) {
+        draw_message("?", WIDTH - 1, ibuf_get(regex_cur));
         curs_set(1);
     }
     /* A colon command typed at the status bar */
@@ -351,34 +405,26 @@ static void update_status_win(void)
 
         if (!command)
             command = "";
-        if_display_message(":", WIDTH - 1, "%s", command);
+        draw_message(":", WIDTH - 1, command);
         curs_set(1);
     }
     /* Default: Current Filename */
     else {
         /* Print filename */
         if (src_win != NULL && source_current_file(src_win, filename) != NULL)
-            if_display_message("", WIDTH - 1, "%s", filename);
+            draw_message("", WIDTH - 1, filename);
     }
 
-    wrefresh(status_win);
+    if (dorefresh == WIN_REFRESH)
+        wrefresh(status_win);
+    else
+        wnoutrefresh(status_win);
 }
 
 void if_display_message(const char *msg, int width, const char *fmt, ...)
 {
     va_list ap;
     char va_buf[MAXLINE];
-    char buf_display[MAXLINE];
-    int pos, error_length, length;
-    int attr;
-
-    if (hl_groups_get_attr(hl_groups_instance, HLG_STATUS_BAR, &attr) == -1)
-        return;
-
-    curs_set(0);
-
-    if (!width)
-        width = WIDTH;
 
     /* Get the buffer with format */
     va_start(ap, fmt);
@@ -389,165 +435,711 @@ void if_display_message(const char *msg, int width, const char *fmt, ...)
 #endif
     va_end(ap);
 
-    error_length = strlen(msg);
-    length = strlen(va_buf);
+    draw_message(msg, width, va_buf);
+    wrefresh(status_win);
+}
 
-    if (error_length > width)
-        strcat(strncpy(buf_display, msg, width - 1), ">");
-    else if (error_length + length > width)
-        sprintf(buf_display, "%s>%s", msg,
-                va_buf + (length - (width - error_length) + 1));
-    else
-        sprintf(buf_display, "%s%s", msg, va_buf);
+/* pane_layout: Moves the pane's widget to where the window manager put it.
+ * ------------
+ *
+ * The source and tty panes keep their status bar on their last row.
+ */
+static int pane_layout(wm_window *window)
+{
+    struct if_pane *pane = (struct if_pane *) window;
+    int top = window->top, left = window->left;
+    int height = window->height, width = window->width;
 
-    /* Print white background */
-    wattron(status_win, attr);
-    for (pos = 0; pos < WIDTH; pos++)
-        mvwprintw(status_win, 0, pos, " ");
+    /* Squeezed out, it's moved when it gets room again */
+    if (height <= 0 || width <= 0)
+        return 0;
 
-    mvwprintw(status_win, 0, 0, "%s", buf_display);
-    wattroff(status_win, attr);
-    wrefresh(status_win);
+    switch (pane->focus) {
+        case CGDB:
+            /* The views are side by side, over one status bar */
+            if (height > 1) {
+                int views = src_win->view_count, i;
+
+                for (i = 0; i < views; i++)
+                    source_view_move(src_win, i, top,
+                            left + width * i / views, height - 1,
+                            width * (i + 1) / views - width * i / views);
+            }
+
+            if (status_win != NULL)
+                delwin(status_win);
+            status_win = newwin(1, width, top + height - 1, left);
+            break;
+        case TTY:
+            if (height > 1)
+                scr_move(tty_win, top, left, height - 1, width);
+
+            if (tty_status_win != NULL)
+                delwin(tty_status_win);
+            tty_status_win = newwin(1, width, top + height - 1, left);
+            break;
+        case DISASM:
+            source_move(asm_win, top, left, height, width);
+            break;
+        case WATCH:
+            watch_move(top, left, height, width);
+            break;
+        case MEMORY:
+            memwin_move(top, left, height, width);
+            break;
+        case BACKTRACE:
+            btwin_move(top, left, height, width);
+            break;
+        case BREAKPOINTS:
+            brkwin_move(top, left, height, width);
+            break;
+        case THREADS:
+            thrwin_move(top, left, height, width);
+            break;
+        case LOG:
+            logwin_move(top, left, height, width);
+            break;
+        default:
+            scr_move(gdb_win, top, left, height, width);
+            break;
+    }
+
+    return 0;
 }
 
-/* if_draw: Draws the interface on the screen.
- * --------
+/* pane_redraw: Draws the pane's widget, without refreshing the terminal.
+ * ------------
  */
-void if_draw(void)
+static int pane_redraw(wm_window *window)
 {
-    /* Only redisplay the filedlg if it is up */
-    if (focus == FILE_DLG) {
-        filedlg_display(fd);
-        return;
+    struct if_pane *pane = (struct if_pane *) window;
+    const struct cgdbrc_snapshot *config = cgdbrc_get_snapshot();
+    unsigned long long start = stats_start(), span = tracer_begin();
+
+    switch (pane->focus) {
+        case CGDB:
+            update_status_win(WIN_NO_REFRESH);
+            if (window->height > 1) {
+                int view = source_get_view(src_win), i;
+
+                /* The view the user is in is drawn last, it gets the
+                 * cursor */
+                for (i = 0; i < src_win->view_count; i++)
+                    if (i != view)
+                        source_view_display(src_win, i, 0, WIN_NO_REFRESH,
+                                config);
+                source_view_display(src_win, view, focus == CGDB,
+                        WIN_NO_REFRESH, config);
+            }
+            stats_stop(&stats_draw_source, start);
+            tracer_end("draw source window", span);
+            break;
+        case TTY:
+            draw_tty_status();
+            if (window->height > 1)
+                scr_refresh(tty_win, focus == TTY, WIN_NO_REFRESH, config);
+            stats_stop(&stats_draw_tty, start);
+            tracer_end("draw tty window", span);
+            break;
+        case DISASM:
+            source_display(asm_win, 0, WIN_NO_REFRESH, config);
+            break;
+        case WATCH:
+            watch_display();
+            break;
+        case MEMORY:
+            memwin_display();
+            break;
+        case BACKTRACE:
+            btwin_display();
+            break;
+        case BREAKPOINTS:
+            brkwin_display();
+            break;
+        case THREADS:
+            thrwin_display();
+            break;
+        case LOG:
+            logwin_display();
+            break;
+        default:
+            scr_refresh(gdb_win, focus == GDB, WIN_NO_REFRESH, config);
+            stats_stop(&stats_draw_gdb, start);
+            tracer_end("draw gdb window", span);
+            break;
     }
 
-    update_status_win();
+    return 0;
+}
 
-    if (get_src_height() != 0 && get_gdb_height() != 0)
-        wrefresh(status_win);
+/* pane_place_cursor: Leaves the cursor in the focused pane's widget.
+ * ------------------
+ */
+static void pane_place_cursor(wm_window *window)
+{
+    struct if_pane *pane = (struct if_pane *) window;
 
-    if (tty_win_on)
-        wrefresh(tty_status_win);
+    switch (pane->focus) {
+        case CGDB:
+            /* The cursor would stay in the gdb window on cygwin */
+            if (focus == CGDB_STATUS_BAR) {
+                curs_set(1);
+                wnoutrefresh(status_win);
+            } else if (focus == CGDB && window->height > 1) {
+                curs_set(1);
+                wnoutrefresh(src_win->view->win);
+            }
+            break;
+        case TTY:
+            if (window->height > 1)
+                wnoutrefresh(tty_win->win);
+            break;
+        case DISASM:
+        case WATCH:
+        case MEMORY:
+        case BACKTRACE:
+        case BREAKPOINTS:
+        case THREADS:
+        case LOG:
+            break;
+        default:
+            wnoutrefresh(gdb_win->win);
+            break;
+    }
+}
+
+static void pane_minimum_size(wm_window *window, int *height, int *width)
+{
+    struct if_pane *pane = (struct if_pane *) window;
+
+    /* The gdb window can be squeezed out, the others keep a status bar */
+    *height = pane->focus == GDB ? 0 : 1;
+    *width = 1;
+}
+
+static int pane_destroy(wm_window *window)
+{
+    struct if_pane *pane = (struct if_pane *) window;
+
+    /* The widgets outlive their panes, the tty window is hidden and shown */
+    if (pane->focus == TTY && tty_status_win != NULL) {
+        delwin(tty_status_win);
+        tty_status_win = NULL;
+    }
+
+    if (pane->focus == WATCH)
+        watch_close();
+
+    if (pane->focus == MEMORY)
+        memwin_close();
 
-    if (get_src_height() > 0)
-        source_display(src_win, focus == CGDB);
+    if (pane->focus == BACKTRACE)
+        btwin_close();
 
-    if (tty_win_on && get_tty_height() > 0)
-        scr_refresh(tty_win, focus == TTY);
+    if (pane->focus == BREAKPOINTS)
+        brkwin_close();
 
-    if (get_gdb_height() > 0)
-        scr_refresh(gdb_win, focus == GDB);
+    if (pane->focus == THREADS)
+        thrwin_close();
 
-    /* This check is here so that the cursor goes to the 
-     * cgdb window. The cursor would stay in the gdb window 
-     * on cygwin */
-    if (get_src_height() > 0 && focus == CGDB)
-        wrefresh(src_win->win);
+    if (pane->focus == LOG)
+        logwin_close();
+
+    return 0;
 }
 
-/* validate_window_sizes:
- * ----------------------
+/* pane_new: Creates the pane for one of the widgets.
+ * ---------
  *
- * This will make sure that the gdb_window, status_bar and source window
- * have appropriate sizes. Each of the windows will not be able to grow
- * smaller than INTERFACE_WINMINHEIGHT in size. It will also restrict the
- * size of windows to being within the size of the terminal.
+ *  pane_focus: CGDB, TTY, DISASM, WATCH, MEMORY, BACKTRACE, BREAKPOINTS,
+ *              THREADS, LOG or GDB
  */
-static void validate_window_sizes(void)
+static struct if_pane *pane_new(enum Focus pane_focus)
 {
-    int tty_window_offset = (tty_win_on) ? TTY_WIN_OFFSET + 1 : 0;
-    int odd_height = (HEIGHT + 1) % 2;
-    int max_window_height_shift = (HEIGHT / 2) - tty_window_offset - odd_height;
-    int min_window_height_shift = -(HEIGHT / 2);
+    struct if_pane *pane =
+            (struct if_pane *) cgdb_malloc(sizeof (struct if_pane));
+
+    wm_window_init((wm_window *) pane);
+    wm_window_show_status_bar((wm_window *) pane, 0);
+    pane->window.layout = pane_layout;
+    pane->window.redraw = pane_redraw;
+    pane->window.place_cursor = pane_place_cursor;
+    pane->window.minimum_size = pane_minimum_size;
+    pane->window.destroy = pane_destroy;
+    pane->focus = pane_focus;
+
+    return pane;
+}
 
-    /* update max and min based off of users winminheight request */
-    min_window_height_shift += interface_winminheight;
-    max_window_height_shift -= interface_winminheight;
+/* focus_pane: The pane with the focus, or the one under the dialog that has it.
+ * -----------
+ */
+static struct if_pane *focus_pane(void)
+{
+    if (focus == GDB)
+        return gdb_pane;
 
-    /* Make sure that the windows offset is within its bounds: 
-     * This checks the window offset.
-     * */
-    if (window_height_shift > max_window_height_shift)
-        window_height_shift = max_window_height_shift;
-    else if (window_height_shift < min_window_height_shift)
-        window_height_shift = min_window_height_shift;
+    if (focus == TTY && tty_pane)
+        return tty_pane;
+
+    return src_pane;
 }
 
-/* if_layout: Update the layout of the screen based on current terminal size.
- * ----------
+/* flood_show: Adds the last screenful a flooded scroller was given to it.
+ * -----------
  *
- * Return Value: Zero on success, non-zero on failure.
+ * It comes after a line with how much was left out.
+ *
+ *   flood:  The flood
+ *   scr:    Its scroller
+ *
+ * Return Value: 1 if the scroller changed, 0 otherwise.
  */
-static int if_layout()
+static int flood_show(struct flood *flood, struct scroller *scr)
 {
-    /* Verify the window size is reasonable */
-    validate_window_sizes();
+    char marker[64];
+    size_t start = flood->tail_length;
+    int height = getmaxy(scr->win), lines = 0;
 
-    /* Initialize the GDB I/O window */
-    if (gdb_win == NULL) {
-        gdb_win =
-                scr_new(get_gdb_row(), get_gdb_col(), get_gdb_height(),
-                get_gdb_width());
-        if (gdb_win == NULL)
-            return 2;
-    } else {                    /* Resize the GDB I/O window */
-        if (get_gdb_height() > 0)
-            scr_move(gdb_win, get_gdb_row(), get_gdb_col(), get_gdb_height(),
-                    get_gdb_width());
-    }
-
-    /* Initialize TTY I/O window */
-    if (tty_win == NULL) {
-        tty_win =
-                scr_new(get_tty_row(), get_tty_col(), get_tty_height(),
-                get_tty_width());
-        if (tty_win == NULL)
-            return 2;
-    } else {                    /* Resize the GDB I/O window */
-        if (get_tty_height() > 0)
-            scr_move(tty_win, get_tty_row(), get_tty_col(), get_tty_height(),
-                    get_tty_width());
-    }
-
-    /* Initialize the source viewer window */
-    if (src_win == NULL) {
-        src_win =
-                source_new(get_src_row(), get_src_col(), get_src_height(),
-                get_src_width());
-        if (src_win == NULL)
-            return 3;
-    } else {                    /* Resize the source viewer window */
-        if (get_src_height() > 0)
-            source_move(src_win, get_src_row(), get_src_col(),
-                    get_src_height(), get_src_width());
-    }
+    if (flood->tail_length == 0 && flood->skipped == 0)
+        return 0;
 
-    /* Initialize the status bar window */
-    status_win = newwin(get_src_status_height(), get_src_status_width(),
-            get_src_status_row(), get_src_status_col());
+    /* The start of the last lines that fit, a last newline ends one */
+    if (start > 0 && flood->tail[start - 1] == '\n')
+        start--;
+    for (; start > 0; start--)
+        if (flood->tail[start - 1] == '\n' && ++lines == height)
+            break;
 
-    /* Initialize the tty status bar window */
-    if (tty_win_on)
-        tty_status_win =
-                newwin(get_tty_status_height(), get_tty_status_width(),
-                get_tty_status_row(), get_tty_status_col());
+    flood->skipped += start;
+    if (flood->skipped > 0) {
+        snprintf(marker, sizeof (marker), "%s[%.1f MB skipped]\n",
+                scr->current.pos > 0 ? "\n" : "",
+                flood->skipped / (1024.0 * 1024.0));
+        scr_add(scr, marker);
+    }
 
-    if_draw();
+    scr_add_length(scr, flood->tail + start, flood->tail_length - start);
+    flood->tail_length = 0;
+    flood->skipped = 0;
 
-    return 0;
+    return 1;
 }
 
-/* if_resize: Checks if a resize event occurred, and updates display if so.
- * ----------
+/* flood_print: Counts output given to a scroller, and holds on to it while
+ * ------------ it comes faster than the floodrate option.
  *
- * Return Value:  Zero on success, non-zero on failure.
+ *   flood:   The scroller's flood
+ *   scr:     The scroller
+ *   buf:     The output
+ *   length:  The number of bytes in buf
+ *
+ * Return Value: 1 if the output was kept for the next frame, 0 if it
+ *               should be added to the scroller.
  */
-void rl_resize(int rows, int cols);
-static int if_resize()
+static int flood_print(struct flood *flood, struct scroller *scr,
+        const char *buf, size_t length)
 {
-    if (ioctl(fileno(stdout), TIOCGWINSZ, &screen_size) != -1) {
-#ifdef NCURSES_VERSION
-        if (screen_size.ws_row != LINES || screen_size.ws_col != COLS) {
+    size_t rate = (size_t) cgdbrc_get(CGDBRC_FLOODRATE)->variant.int_val * 1024;
+    size_t drop;
+    struct timeval now;
+    long elapsed;
+
+    if (rate == 0 && !flood->on)
+        return 0;
+
+    gettimeofday(&now, NULL);
+    elapsed = (now.tv_sec - flood->start.tv_sec) * 1000 +
+            (now.tv_usec - flood->start.tv_usec) / 1000;
+
+    /* A second with less output than the rate ends the flood */
+    if (elapsed >= 1000 || elapsed < 0) {
+        if (flood->on && flood->bytes <= rate) {
+            flood_show(flood, scr);
+            flood->on = 0;
+        }
+
+        flood->start = now;
+        flood->bytes = 0;
+    }
+
+    flood->bytes += length;
+    if (rate > 0 && flood->bytes > rate)
+        flood->on = 1;
+    else if (rate == 0 && flood->on) {
+        flood_show(flood, scr);
+        flood->on = 0;
+    }
+
+    if (!flood->on)
+        return 0;
+
+    /* Only the end fits, the rest is skipped */
+    if (length >= FLOOD_TAIL) {
+        flood->skipped += flood->tail_length + length - FLOOD_TAIL / 2;
+        buf += length - FLOOD_TAIL / 2;
+        length = FLOOD_TAIL / 2;
+        flood->tail_length = 0;
+    }
+
+    /* The older half goes, up to the start of a line */
+    if (flood->tail_length + length > FLOOD_TAIL) {
+        drop = flood->tail_length / 2 + 1;
+        while (drop < flood->tail_length && flood->tail[drop - 1] != '\n')
+            drop++;
+
+        flood->skipped += drop;
+        flood->tail_length -= drop;
+        memmove(flood->tail, flood->tail + drop, flood->tail_length);
+
+        if (flood->tail_length + length > FLOOD_TAIL) {
+            flood->skipped += flood->tail_length;
+            flood->tail_length = 0;
+        }
+    }
+
+    memcpy(flood->tail + flood->tail_length, buf, length);
+    flood->tail_length += length;
+
+    return 1;
+}
+
+/* if_redraw: Draws the damaged panes, the terminal is updated once.
+ * ----------
+ */
+static void if_redraw(void)
+{
+    unsigned long long start = stats_start(), span = tracer_begin(), usec;
+
+    /* What the scrollers were flooded with since the last frame */
+    if (flood_show(&gdb_flood, gdb_win))
+        wm_window_damage((wm_window *) gdb_pane);
+    if (flood_show(&tty_flood, tty_win) && tty_pane)
+        wm_window_damage((wm_window *) tty_pane);
+
+    wm_focus(wm, (wm_window *) focus_pane());
+    wm_redraw(wm);
+
+    stats_stop(&stats_draw_frame, start);
+    tracer_end("if_draw", span);
+    if (key_time) {
+        usec = stats_clock() - key_time;
+        if (usec < KEY_STALE_USEC)
+            stats_record(&stats_keypress, usec);
+        key_time = 0;
+    }
+
+    frame_gdb = frame_tty = frame_log = 0;
+    gettimeofday(&frame_time, NULL);
+}
+
+/* dialog_shown: Determines if a dialog covers the whole screen.
+ * -------------
+ *
+ * Return Value: 1 if one does, the windows are drawn when it's gone.
+ */
+static int dialog_shown(void)
+{
+    return focus == FILE_DLG || focus == GREP_DLG || focus == CAPTURE_DLG;
+}
+
+/* if_draw: Draws the interface on the screen.
+ * --------
+ */
+void if_draw(void)
+{
+    /* Only redisplay the filedlg if it is up */
+    if (focus == FILE_DLG) {
+        filedlg_display(fd);
+        return;
+    }
+
+    if (focus == GREP_DLG) {
+        filedlg_display(grep_dlg);
+        return;
+    }
+
+    if (focus == CAPTURE_DLG) {
+        capwin_display(capture_dlg);
+        return;
+    }
+
+    wm_window_damage((wm_window *) src_pane);
+    if (asm_pane)
+        wm_window_damage((wm_window *) asm_pane);
+    if (tty_pane)
+        wm_window_damage((wm_window *) tty_pane);
+    wm_window_damage((wm_window *) gdb_pane);
+    if (watch_pane)
+        wm_window_damage((wm_window *) watch_pane);
+    if (memory_pane)
+        wm_window_damage((wm_window *) memory_pane);
+    if (backtrace_pane)
+        wm_window_damage((wm_window *) backtrace_pane);
+    if (breakpoints_pane)
+        wm_window_damage((wm_window *) breakpoints_pane);
+    if (threads_pane)
+        wm_window_damage((wm_window *) threads_pane);
+    if (log_pane)
+        wm_window_damage((wm_window *) log_pane);
+
+    if_redraw();
+}
+
+/* validate_window_sizes:
+ * ----------------------
+ *
+ * This will make sure that the gdb_window, status_bar and source window
+ * have appropriate sizes. Each of the windows will not be able to grow
+ * smaller than INTERFACE_WINMINHEIGHT in size. It will also restrict the
+ * size of windows to being within the size of the terminal.
+ */
+static void validate_window_sizes(void)
+{
+    int tty_window_offset = (tty_win_on) ? TTY_WIN_OFFSET + 1 : 0;
+    int odd_height = (HEIGHT + 1) % 2;
+    int max_window_height_shift = (HEIGHT / 2) - tty_window_offset - odd_height;
+    int min_window_height_shift = -(HEIGHT / 2);
+
+    /* update max and min based off of users winminheight request */
+    min_window_height_shift += interface_winminheight;
+    max_window_height_shift -= interface_winminheight;
+
+    /* Make sure that the windows offset is within its bounds: 
+     * This checks the window offset.
+     * */
+    if (window_height_shift > max_window_height_shift)
+        window_height_shift = max_window_height_shift;
+    else if (window_height_shift < min_window_height_shift)
+        window_height_shift = min_window_height_shift;
+}
+
+/* if_layout: Update the layout of the screen based on current terminal size.
+ * ----------
+ *
+ * Return Value: Zero on success, non-zero on failure.
+ */
+static int if_layout()
+{
+    /* Verify the window size is reasonable */
+    validate_window_sizes();
+
+    /* Initialize the windows, the panes move them into place */
+    if (gdb_win == NULL && (gdb_win = scr_new(0, 0, 1, 1)) == NULL)
+        return 2;
+
+    if (tty_win == NULL && (tty_win = scr_new(0, 0, 1, 1)) == NULL)
+        return 2;
+
+    if (src_win == NULL && (src_win = source_new(0, 0, 1, 1)) == NULL)
+        return 3;
+
+    if (disasm_on && asm_win == NULL &&
+            (asm_win = source_new(0, 0, 1, 1)) == NULL)
+        return 3;
+
+    /* The source window is on top, the gdb window below it */
+    if (wm == NULL) {
+        src_pane = pane_new(CGDB);
+        gdb_pane = pane_new(GDB);
+
+        if ((wm = wm_create((wm_window *) src_pane, NULL)) == NULL)
+            return 3;
+
+        wm_split(wm, (wm_window *) gdb_pane, WM_HORIZONTAL);
+    } else
+        wm_layout(wm);
+
+    /* It's split off again once the tty window is in place, so the tty
+     * window goes under both */
+    if (asm_pane && tty_win_on != (tty_pane != NULL)) {
+        wm_close(wm, (wm_window *) asm_pane);
+        asm_pane = NULL;
+    }
+
+    /* The tty window goes between them */
+    if (tty_win_on && tty_pane == NULL) {
+        tty_pane = pane_new(TTY);
+        wm_focus(wm, (wm_window *) src_pane);
+        wm_split(wm, (wm_window *) tty_pane, WM_HORIZONTAL);
+    } else if (!tty_win_on && tty_pane != NULL) {
+        wm_close(wm, (wm_window *) tty_pane);
+        tty_pane = NULL;
+    }
+
+    /* The disassembly goes to the right of the source window */
+    if (disasm_on && asm_pane == NULL) {
+        asm_pane = pane_new(DISASM);
+        wm_focus(wm, (wm_window *) src_pane);
+        wm_split(wm, (wm_window *) asm_pane, WM_VERTICAL);
+    } else if (!disasm_on && asm_pane != NULL) {
+        wm_close(wm, (wm_window *) asm_pane);
+        asm_pane = NULL;
+    }
+
+    /* They're split off again once the windows above them are in place, so
+     * each goes under the ones before it */
+    if (log_pane && (watch_on != (watch_pane != NULL) ||
+                    memory_on != (memory_pane != NULL) ||
+                    backtrace_on != (backtrace_pane != NULL) ||
+                    breakwin_on != (breakpoints_pane != NULL) ||
+                    threadwin_on != (threads_pane != NULL))) {
+        wm_close(wm, (wm_window *) log_pane);
+        log_pane = NULL;
+    }
+
+    if (threads_pane && (watch_on != (watch_pane != NULL) ||
+                    memory_on != (memory_pane != NULL) ||
+                    backtrace_on != (backtrace_pane != NULL) ||
+                    breakwin_on != (breakpoints_pane != NULL))) {
+        wm_close(wm, (wm_window *) threads_pane);
+        threads_pane = NULL;
+    }
+
+    if (breakpoints_pane && (watch_on != (watch_pane != NULL) ||
+                    memory_on != (memory_pane != NULL) ||
+                    backtrace_on != (backtrace_pane != NULL))) {
+        wm_close(wm, (wm_window *) breakpoints_pane);
+        breakpoints_pane = NULL;
+    }
+
+    if (backtrace_pane && (watch_on != (watch_pane != NULL) ||
+                    memory_on != (memory_pane != NULL))) {
+        wm_close(wm, (wm_window *) backtrace_pane);
+        backtrace_pane = NULL;
+    }
+
+    if (memory_pane && watch_on != (watch_pane != NULL)) {
+        wm_close(wm, (wm_window *) memory_pane);
+        memory_pane = NULL;
+    }
+
+    /* The watch window goes to the right of the gdb window */
+    if (watch_on && watch_pane == NULL) {
+        watch_pane = pane_new(WATCH);
+        wm_focus(wm, (wm_window *) gdb_pane);
+        wm_split(wm, (wm_window *) watch_pane, WM_VERTICAL);
+    } else if (!watch_on && watch_pane != NULL) {
+        wm_close(wm, (wm_window *) watch_pane);
+        watch_pane = NULL;
+    }
+
+    /* The memory window goes under the watch window, or to the right of the
+     * gdb window if there's none */
+    if (memory_on && memory_pane == NULL) {
+        memory_pane = pane_new(MEMORY);
+        if (watch_pane) {
+            wm_focus(wm, (wm_window *) watch_pane);
+            wm_split(wm, (wm_window *) memory_pane, WM_HORIZONTAL);
+        } else {
+            wm_focus(wm, (wm_window *) gdb_pane);
+            wm_split(wm, (wm_window *) memory_pane, WM_VERTICAL);
+        }
+    } else if (!memory_on && memory_pane != NULL) {
+        wm_close(wm, (wm_window *) memory_pane);
+        memory_pane = NULL;
+    }
+
+    /* The backtrace goes under the memory or watch window, or to the right
+     * of the gdb window if there's neither */
+    if (backtrace_on && backtrace_pane == NULL) {
+        struct if_pane *above = memory_pane ? memory_pane : watch_pane;
+
+        backtrace_pane = pane_new(BACKTRACE);
+        if (above) {
+            wm_focus(wm, (wm_window *) above);
+            wm_split(wm, (wm_window *) backtrace_pane, WM_HORIZONTAL);
+        } else {
+            wm_focus(wm, (wm_window *) gdb_pane);
+            wm_split(wm, (wm_window *) backtrace_pane, WM_VERTICAL);
+        }
+    } else if (!backtrace_on && backtrace_pane != NULL) {
+        wm_close(wm, (wm_window *) backtrace_pane);
+        backtrace_pane = NULL;
+    }
+
+    /* The breakpoints go under the last of those, or to the right of the
+     * gdb window if there's none */
+    if (breakwin_on && breakpoints_pane == NULL) {
+        struct if_pane *above = backtrace_pane ? backtrace_pane :
+                memory_pane ? memory_pane : watch_pane;
+
+        breakpoints_pane = pane_new(BREAKPOINTS);
+        if (above) {
+            wm_focus(wm, (wm_window *) above);
+            wm_split(wm, (wm_window *) breakpoints_pane, WM_HORIZONTAL);
+        } else {
+            wm_focus(wm, (wm_window *) gdb_pane);
+            wm_split(wm, (wm_window *) breakpoints_pane, WM_VERTICAL);
+        }
+    } else if (!breakwin_on && breakpoints_pane != NULL) {
+        wm_close(wm, (wm_window *) breakpoints_pane);
+        breakpoints_pane = NULL;
+    }
+
+    /* The threads go under the last of those, or to the right of the gdb
+     * window if there's none */
+    if (threadwin_on && threads_pane == NULL) {
+        struct if_pane *above = breakpoints_pane ? breakpoints_pane :
+                backtrace_pane ? backtrace_pane :
+                memory_pane ? memory_pane : watch_pane;
+
+        threads_pane = pane_new(THREADS);
+        if (above) {
+            wm_focus(wm, (wm_window *) above);
+            wm_split(wm, (wm_window *) threads_pane, WM_HORIZONTAL);
+        } else {
+            wm_focus(wm, (wm_window *) gdb_pane);
+            wm_split(wm, (wm_window *) threads_pane, WM_VERTICAL);
+        }
+    } else if (!threadwin_on && threads_pane != NULL) {
+        wm_close(wm, (wm_window *) threads_pane);
+        threads_pane = NULL;
+    }
+
+    /* The log goes under the last of those, or to the right of the gdb
+     * window if there's none */
+    if (logwin_on && log_pane == NULL) {
+        struct if_pane *above = threads_pane ? threads_pane :
+                breakpoints_pane ? breakpoints_pane :
+                backtrace_pane ? backtrace_pane :
+                memory_pane ? memory_pane : watch_pane;
+
+        log_pane = pane_new(LOG);
+        if (above) {
+            wm_focus(wm, (wm_window *) above);
+            wm_split(wm, (wm_window *) log_pane, WM_HORIZONTAL);
+        } else {
+            wm_focus(wm, (wm_window *) gdb_pane);
+            wm_split(wm, (wm_window *) log_pane, WM_VERTICAL);
+        }
+    } else if (!logwin_on && log_pane != NULL) {
+        wm_close(wm, (wm_window *) log_pane);
+        log_pane = NULL;
+    }
+
+    /* The gdb window gets what's left, with its status bar */
+    wm_resize(wm, (wm_window *) src_pane, WM_HORIZONTAL, get_src_height() + 1);
+    if (tty_pane)
+        wm_resize(wm, (wm_window *) tty_pane, WM_HORIZONTAL,
+                get_tty_height() + 1);
+
+    if_draw();
+
+    return 0;
+}
+
+/* if_resize: Checks if a resize event occurred, and updates display if so.
+ * ----------
+ *
+ * Return Value:  Zero on success, non-zero on failure.
+ */
+void rl_resize(int rows, int cols);
+static int if_resize()
+{
+    if (ioctl(fileno(stdout), TIOCGWINSZ, &screen_size) != -1) {
+#ifdef NCURSES_VERSION
+        if (screen_size.ws_row != LINES || screen_size.ws_col != COLS) {
             resizeterm(screen_size.ws_row, screen_size.ws_col);
             refresh();
             rl_resize(screen_size.ws_row, screen_size.ws_col);
@@ -738,9 +1330,12 @@ static void if_run_command(struct sviewer *sview, struct ibuf *ibuf_command)
     if (command_parse_string(command)) {
         if_display_message("Unknown command: ", 0, "%s", command);
     } else {
-        update_status_win();
+        update_status_win(WIN_REFRESH);
     }
 
+    /* Options and colors change how the source lines are drawn */
+    source_invalidate(sview);
+
     if_draw();
 }
 
@@ -789,6 +1384,34 @@ static int tty_input(int key)
  */
 static int gdb_input(int key)
 {
+    int regex_icase = cgdbrc_get(CGDBRC_IGNORECASE)->variant.int_val;
+
+    /* While the window is scrolled back, it can be searched like the
+     * source window */
+    if (scr_scrolled(gdb_win)) {
+        switch (key) {
+            case '/':
+            case '?':
+                regex_cur = ibuf_init();
+                regex_direction_cur = ('/' == key);
+                sbc_kind = SBC_GDB_REGEX;
+                scr_search_init(gdb_win);
+                if_set_focus(CGDB_STATUS_BAR);
+                if_draw();
+                return 0;
+            case 'n':
+            case 'N':
+                if (regex_last) {
+                    scr_search(gdb_win, ibuf_get(regex_last), 2,
+                            key == 'n' ? regex_direction_last :
+                            !regex_direction_last, regex_icase);
+                    wm_window_damage((wm_window *) gdb_pane);
+                    if_draw();
+                }
+                return 0;
+        }
+    }
+
     /* Handle special keys */
     switch (key) {
         case CGDB_KEY_PPAGE:
@@ -846,6 +1469,33 @@ static int gdb_input(int key)
     return 0;
 }
 
+/* regex_search: Searches the window the regex is being entered for.
+ * -------------
+ *
+ *  The arguments are as for source_search_regex.
+ */
+static void regex_search(struct sviewer *sview, const char *regex, int opt,
+        int direction, int icase)
+{
+    if (sbc_kind == SBC_GDB_REGEX) {
+        scr_search(gdb_win, regex, opt, direction, icase);
+        wm_window_damage((wm_window *) gdb_pane);
+    } else
+        source_search_regex(sview, regex, opt, direction, icase);
+}
+
+/* update_hlsearch: Draws every match of the last search, if hlsearch is on.
+ * ----------------
+ */
+static void update_hlsearch(void)
+{
+    if (cgdbrc_get(CGDBRC_HLSEARCH)->variant.int_val && regex_last)
+        source_set_hlsearch(ibuf_get(regex_last),
+                cgdbrc_get(CGDBRC_IGNORECASE)->variant.int_val);
+    else
+        source_set_hlsearch(NULL, 0);
+}
+
 /**
  * Capture a regular expression from the user, one key at a time.
  * This modifies the global variables regex_cur and regex_last.
@@ -874,8 +1524,9 @@ static int status_bar_regex_input(struct sviewer *sview, int key)
             }
             regex_last = ibuf_dup(regex_cur);
             regex_direction_last = regex_direction_cur;
-            source_search_regex(sview, ibuf_get(regex_last), 2,
+            regex_search(sview, ibuf_get(regex_last), 2,
                     regex_direction_last, regex_icase);
+            update_hlsearch();
             if_draw();
             done = 1;
             break;
@@ -886,10 +1537,10 @@ static int status_bar_regex_input(struct sviewer *sview, int key)
                 done = 1;
             } else {
                 ibuf_delchar(regex_cur);
-                source_search_regex(sview, ibuf_get(regex_cur), 1,
+                regex_search(sview, ibuf_get(regex_cur), 1,
                         regex_direction_cur, regex_icase);
                 if_draw();
-                update_status_win();
+                update_status_win(WIN_REFRESH);
             }
             break;
         default:
@@ -902,16 +1553,24 @@ static int status_bar_regex_input(struct sviewer *sview, int key)
             } else {
                 ibuf_addchar(regex_cur, key);
             }
-            source_search_regex(sview, ibuf_get(regex_cur), 1,
+            regex_search(sview, ibuf_get(regex_cur), 1,
                     regex_direction_cur, regex_icase);
             if_draw();
-            update_status_win();
+            update_status_win(WIN_REFRESH);
     };
 
     if (done) {
         ibuf_free(regex_cur);
         regex_cur = NULL;
-        if_set_focus(CGDB);
+
+        /* Backing out of the regex leaves the GDB window where it was */
+        if (sbc_kind == SBC_GDB_REGEX && gdb_win->search.active) {
+            scr_search(gdb_win, NULL, 2, regex_direction_cur, regex_icase);
+            wm_window_damage((wm_window *) gdb_pane);
+            if_draw();
+        }
+
+        if_set_focus(sbc_kind == SBC_GDB_REGEX ? GDB : CGDB);
     }
 
     return 0;
@@ -938,7 +1597,7 @@ static int status_bar_normal_input(int key)
                 done = 1;
             } else {
                 ibuf_delchar(cur_sbc);
-                update_status_win();
+                update_status_win(WIN_REFRESH);
             }
             break;
         default:
@@ -951,7 +1610,7 @@ static int status_bar_normal_input(int key)
             } else {
                 ibuf_addchar(cur_sbc, key);
             }
-            update_status_win();
+            update_status_win(WIN_REFRESH);
             break;
     };
 
@@ -970,6 +1629,7 @@ static int status_bar_input(struct sviewer *sview, int key)
         case SBC_NORMAL:
             return status_bar_normal_input(key);
         case SBC_REGEX:
+        case SBC_GDB_REGEX:
             return status_bar_regex_input(sview, key);
     };
 
@@ -985,31 +1645,42 @@ static int status_bar_input(struct sviewer *sview, int key)
  * \param t
  * The action to take
  *
+ * \param condition
+ * The condition of a breakpoint that's added, or NULL
+ *
  * \return
  * 0 on success, -1 on error.
  */
 static int
-toggle_breakpoint(struct sviewer *sview, enum tgdb_breakpoint_action t)
+toggle_breakpoint(struct sviewer *sview, enum tgdb_breakpoint_action t,
+        const char *condition)
 {
-    char *path;
+    const char *path;
     int line;
     tgdb_request_ptr request_ptr;
 
-    if (!sview || !sview->cur || !sview->cur->path)
+    if (!sview || !sview->view->cur || !sview->view->cur->path)
         return 0;
 
-    line = sview->cur->sel_line;
+    line = sview->view->sel_line;
 
     /* Get filename (strip path off -- GDB is dumb) */
-    path = strrchr(sview->cur->path, '/') + 1;
+    path = strrchr(sview->view->cur->path, '/') + 1;
     if (path == NULL + 1)
-        path = sview->cur->path;
+        path = sview->view->cur->path;
 
     /* delete an existing breakpoint */
-    if (sview->cur->buf.breakpts[line])
+    if (source_marks_get(&sview->view->cur->marks, line, SOURCE_MARK_BREAK))
         t = TGDB_BREAKPOINT_DELETE;
 
-    request_ptr = tgdb_request_modify_breakpoint(tgdb, path, line + 1, t);
+    /* gdb tests the condition where the user asked, in the target it
+     * doesn't stop the program at each hit */
+    if (condition && t != TGDB_BREAKPOINT_DELETE)
+        request_ptr = tgdb_request_condition_breakpoint(tgdb, path, line + 1,
+                condition, (enum tgdb_condition_evaluation)
+                cgdbrc_get(CGDBRC_CONDEVAL)->variant.int_val);
+    else
+        request_ptr = tgdb_request_modify_breakpoint(tgdb, path, line + 1, t);
     if (!request_ptr)
         return -1;
 
@@ -1061,6 +1732,16 @@ static void source_input(struct sviewer *sview, int key)
             if (last_key_pressed == 'g')
                 source_set_sel_line(sview, 1);
             break;
+        case 'd':              /* definition of the identifier at the cursor */
+            if (last_key_pressed == 'g' &&
+                    source_goto_definition(sview, NULL) < 0)
+                if_display_message("No definition found", 0, "");
+            break;
+        case '*':              /* next place of the identifier */
+        case '#':              /* the place before */
+            if (source_goto_occurrence(sview, key == '*') < 0)
+                if_display_message("No other place found", 0, "");
+            break;
         case 'G':              /* end of file */
             source_set_sel_line(sview, 10000000);
             break;
@@ -1082,28 +1763,20 @@ static void source_input(struct sviewer *sview, int key)
             break;
         case 'o':
             /* Causes file dialog to be opened */
-        {
-            extern int kui_input_acceptable;
-
-            kui_input_acceptable = 0;
-            tgdb_request_ptr request_ptr;
-
-            request_ptr = tgdb_request_inferiors_source_files(tgdb);
-            handle_request(tgdb, request_ptr);
-        }
+            request_source_files();
             break;
         case ' ':
         {
             enum tgdb_breakpoint_action t = TGDB_BREAKPOINT_ADD;
 
-            toggle_breakpoint(sview, t);
+            toggle_breakpoint(sview, t, NULL);
         }
             break;
         case 't':
         {
             enum tgdb_breakpoint_action t = TGDB_TBREAKPOINT_ADD;
 
-            toggle_breakpoint(sview, t);
+            toggle_breakpoint(sview, t, NULL);
         }
             break;
         default:
@@ -1111,7 +1784,11 @@ static void source_input(struct sviewer *sview, int key)
     }
 
     /* Some extended features that are set by :set sc */
-    if_draw();
+    if (focus == CGDB) {
+        wm_window_damage((wm_window *) src_pane);
+        if_redraw();
+    } else
+        if_draw();
 }
 
 /* Sets up the signal handler for SIGWINCH
@@ -1182,6 +1859,12 @@ int if_init(void)
     if ((fd = filedlg_new(0, 0, HEIGHT, WIDTH)) == NULL)
         return 5;
 
+    if ((grep_dlg = filedlg_new(0, 0, HEIGHT, WIDTH)) == NULL)
+        return 5;
+
+    if ((capture_dlg = capwin_new(0, 0, HEIGHT, WIDTH)) == NULL)
+        return 5;
+
     /* Set up window layout */
     window_height_shift = (int) ((HEIGHT / 2) * (cur_win_split / 2.0));
     switch (if_layout()) {
@@ -1209,10 +1892,15 @@ int internal_if_input(int key)
         } else if (focus == CGDB_STATUS_BAR && sbc_kind == SBC_REGEX) {
             ibuf_free(regex_cur);
             regex_cur = NULL;
-            free(src_win->cur->buf.cur_line);
-            src_win->cur->buf.cur_line = NULL;
-            src_win->cur->sel_rline = orig_line_regex;
-            src_win->cur->sel_line = orig_line_regex;
+            free(src_win->view->cur_line);
+            src_win->view->cur_line = NULL;
+            src_win->view->sel_rline = orig_line_regex;
+            src_win->view->sel_line = orig_line_regex;
+        } else if (focus == CGDB_STATUS_BAR && sbc_kind == SBC_GDB_REGEX) {
+            ibuf_free(regex_cur);
+            regex_cur = NULL;
+            scr_search(gdb_win, NULL, 2, regex_direction_cur, 0);
+            wm_window_damage((wm_window *) gdb_pane);
         }
         if_set_focus(CGDB);
         return 0;
@@ -1241,10 +1929,10 @@ int internal_if_input(int key)
                     return 0;
                 case '/':
                 case '?':
-                    if (src_win->cur != NULL) {
+                    if (src_win->view->cur != NULL) {
                         regex_cur = ibuf_init();
                         regex_direction_cur = ('/' == key);
-                        orig_line_regex = src_win->cur->sel_line;
+                        orig_line_regex = src_win->view->sel_line;
 
                         sbc_kind = SBC_REGEX;
                         if_set_focus(CGDB_STATUS_BAR);
@@ -1346,6 +2034,12 @@ int internal_if_input(int key)
                 case CGDB_KEY_CTRL_L:
                     if_layout();
                     return 0;
+                case CGDB_KEY_CTRL_W:
+                    /* Go to the other view, with srcsplit */
+                    source_set_view(src_win, (source_get_view(src_win) + 1) %
+                            src_win->view_count);
+                    if_draw();
+                    return 0;
             }
             source_input(src_win, key);
             return 0;
@@ -1377,8 +2071,42 @@ int internal_if_input(int key)
             }
         }
             return 0;
+        case GREP_DLG:
+        {
+            static char grep_choice[MAX_LINE];
+            int ret = filedlg_recv_char(grep_dlg, key, grep_choice);
+            struct grep_match *match;
+
+            if (ret == -1) {
+                if_set_focus(CGDB);
+                return 0;
+            } else if (ret == 1) {
+                match = grep_get(filedlg_selected(grep_dlg));
+
+                /* Show the match without moving the executing line */
+                if (match && source_set_exec_line(src_win, match->path, 0) == 0)
+                    source_set_sel_line(src_win, match->line);
+
+                if_set_focus(CGDB);
+                return 0;
+            }
+        }
+            return 0;
+        case CAPTURE_DLG:
+            if (capwin_recv_char(capture_dlg, key) == -1)
+                if_set_focus(CGDB);
+            return 0;
         case CGDB_STATUS_BAR:
             return status_bar_input(src_win, key);
+        case DISASM:
+        case WATCH:
+        case MEMORY:
+        case BACKTRACE:
+        case BREAKPOINTS:
+        case THREADS:
+        case LOG:
+            /* They're never focused */
+            break;
     }
 
     /* Never gets here */
@@ -1387,74 +2115,511 @@ int internal_if_input(int key)
 
 int if_input(int key)
 {
-    int result = internal_if_input(key);
+    int result;
+
+    if (!key_time)
+        key_time = stats_start();
+
+    result = internal_if_input(key);
 
     last_key_pressed = key;
     return result;
 }
 
-void if_tty_print(const char *buf)
+void if_tty_print(const char *buf, size_t length)
 {
-    /* If the tty I/O window is not open send output to gdb window */
-    if (!tty_win_on)
-        if_print(buf);
+    if (flood_log != -1 && io_writen(flood_log, buf, length) != (ssize_t) length) {
+        logger_write_pos(logger, __FILE__, __LINE__, "floodlog write failed");
+        cgdb_close(flood_log);
+        flood_log = -1;
+    }
 
-    /* Print it to the scroller */
-    scr_add(tty_win, buf);
+    /* If the tty I/O window is not open send output to gdb window */
+    if (!tty_win_on) {
+        if (!flood_print(&gdb_flood, gdb_win, buf, length))
+            scr_add_length(gdb_win, buf, length);
+        frame_gdb = 1;
+    }
 
-    /* Only need to redraw if tty_win is being displayed */
-    if (tty_win_on && get_gdb_height() > 0) {
-        scr_refresh(tty_win, focus == TTY);
+    /* Print it to the scroller, it's drawn with the next frame */
+    if (!flood_print(&tty_flood, tty_win, buf, length))
+        scr_add_length(tty_win, buf, length);
+    frame_tty = 1;
 
-        /* Make sure cursor reappears in source window if focus is there */
-        if (focus == CGDB)
-            wrefresh(src_win->win);
-    }
+    if (cgdbrc_get(CGDBRC_FRAMETIME)->variant.int_val <= 0)
+        if_frame_flush();
 }
 
 void if_print(const char *buf)
 {
-    /* Print it to the scroller */
-    scr_add(gdb_win, buf);
+    size_t length = strlen(buf);
 
-    if (get_gdb_height() > 0) {
-        scr_refresh(gdb_win, focus == GDB);
+    /* Print it to the scroller, it's drawn with the next frame */
+    if (!flood_print(&gdb_flood, gdb_win, buf, length))
+        scr_add_length(gdb_win, buf, length);
+    frame_gdb = 1;
 
-        /* Make sure cursor reappears in source window if focus is there */
-        if (focus == CGDB)
-            wrefresh(src_win->win);
-    }
+    if (cgdbrc_get(CGDBRC_FRAMETIME)->variant.int_val <= 0)
+        if_frame_flush();
 }
 
-void if_print_message(const char *fmt, ...)
+int if_flooded(void)
 {
-    va_list ap;
-    char va_buf[MAXLINE];
+    return gdb_flood.on || tty_flood.on;
+}
 
-    /* Get the buffer with format */
-    va_start(ap, fmt);
-#ifdef   HAVE_VSNPRINTF
-    vsnprintf(va_buf, sizeof (va_buf), fmt, ap);    /* this is safe */
-#else
-    vsprintf(va_buf, fmt, ap);  /* this is not safe */
-#endif
-    va_end(ap);
+int if_set_flood_log(const char *path)
+{
+    int fd = -1;
 
-    if_print(va_buf);
+    if (*path) {
+        fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1)
+            return -1;
+    }
+
+    if (flood_log != -1)
+        cgdb_close(flood_log);
+    flood_log = fd;
+
+    return 0;
 }
 
-void if_show_file(char *path, int line)
+int if_frame_pending(void)
 {
-    if (source_set_exec_line(src_win, path, line) == 0)
-        if_draw();
+    return frame_gdb || frame_tty || frame_log;
 }
 
-void if_display_help(void)
+int if_frame_wait(void)
 {
-    char cgdb_help_file[MAXLINE];
-    int ret_val = 0;
+    struct timeval now;
+    long elapsed;
+    int frametime = cgdbrc_get(CGDBRC_FRAMETIME)->variant.int_val;
 
-    fs_util_get_path(PKGDATADIR, "cgdb.txt", cgdb_help_file);
+    if (!if_frame_pending())
+        return -1;
+
+    gettimeofday(&now, NULL);
+    elapsed = (now.tv_sec - frame_time.tv_sec) * 1000 +
+            (now.tv_usec - frame_time.tv_usec) / 1000;
+
+    /* The clock was set back */
+    if (elapsed < 0)
+        return 0;
+
+    return elapsed >= frametime ? 0 : frametime - elapsed;
+}
+
+void if_frame_flush(void)
+{
+    if (!if_frame_pending())
+        return;
+
+    /* The dialogs are drawn over everything, the windows are drawn whole
+     * when they're gone */
+    if (dialog_shown()) {
+        frame_gdb = frame_tty = frame_log = 0;
+        return;
+    }
+
+    /* Only the scrollers that got output are drawn */
+    if (frame_tty && tty_pane)
+        wm_window_damage((wm_window *) tty_pane);
+
+    if (frame_gdb)
+        wm_window_damage((wm_window *) gdb_pane);
+
+    if (frame_log && log_pane)
+        wm_window_damage((wm_window *) log_pane);
+
+    if_redraw();
+}
+
+void if_print_message(const char *fmt, ...)
+{
+    va_list ap;
+    char va_buf[MAXLINE];
+
+    /* Get the buffer with format */
+    va_start(ap, fmt);
+#ifdef   HAVE_VSNPRINTF
+    vsnprintf(va_buf, sizeof (va_buf), fmt, ap);    /* this is safe */
+#else
+    vsprintf(va_buf, fmt, ap);  /* this is not safe */
+#endif
+    va_end(ap);
+
+    if_print(va_buf);
+}
+
+void if_show_file(const char *path, int line)
+{
+    if (source_set_exec_line(src_win, path, line) == 0)
+        if_draw();
+}
+
+void if_set_disasm(int value)
+{
+    disasm_on = value;
+    if_layout();
+
+    /* The function gdb is in, if it stopped while the window was hidden */
+    if (disasm_on) {
+        if_show_pc(asm_pc);
+        if_draw();
+    }
+}
+
+void if_set_watch(int value)
+{
+    watch_on = value;
+    if_layout();
+
+    /* What changed while the window was hidden */
+    if (watch_on && watch_stopped_in) {
+        watch_stopped(watch_stopped_in);
+        if_draw();
+    }
+}
+
+void if_watch_stopped(const char *function)
+{
+    free(watch_stopped_in);
+    watch_stopped_in = cgdb_strdup(function ? function : "");
+
+    if (watch_on)
+        watch_stopped(watch_stopped_in);
+}
+
+void if_watch_variables(const struct tgdb_variables *variables)
+{
+    /* The dialogs are drawn over everything, it's drawn when they're gone */
+    if (watch_variables(variables) && watch_pane && !dialog_shown()) {
+        wm_window_damage((wm_window *) watch_pane);
+        if_redraw();
+    }
+}
+
+void if_clear_watch(void)
+{
+    free(watch_stopped_in);
+    watch_stopped_in = NULL;
+    watch_clear();
+}
+
+void if_set_memory(int value)
+{
+    memory_on = value;
+    if_layout();
+}
+
+void if_memory_stopped(void)
+{
+    memwin_stopped();
+}
+
+void if_memory(const struct tgdb_memory *memory)
+{
+    /* The dialogs are drawn over everything, it's drawn when they're gone */
+    if (memwin_update(memory) && memory_pane && !dialog_shown()) {
+        wm_window_damage((wm_window *) memory_pane);
+        if_redraw();
+    }
+}
+
+void if_clear_memory(void)
+{
+    memwin_clear();
+}
+
+/* goto_frame: Makes gdb look at a frame, and shows where it is.
+ * -----------
+ *
+ *  The path of the file is the one gdb listed, or the one it gave for the
+ *  relative path before.
+ */
+static void goto_frame(const struct tgdb_frame *frame)
+{
+    const char *path = frame->absolute_path;
+
+    handle_request(tgdb, tgdb_request_select_frame(tgdb, frame->level));
+
+    if (!path)
+        path = source_absolute_path(src_win, frame->relative_path);
+
+    if_show_pc(frame->address);
+    if_watch_stopped(frame->function);
+
+    if (path)
+        if_show_file((char *) path, frame->line_number);
+    else
+        if_display_message("No source for frame", 0, " %d", frame->level);
+
+    if_draw();
+}
+
+void if_set_backtrace(int value)
+{
+    backtrace_on = value;
+    if_layout();
+}
+
+int if_scroll_backtrace(int pages)
+{
+    if (btwin_scroll(pages) == -1)
+        return -1;
+
+    if_draw();
+
+    return 0;
+}
+
+int if_select_frame(int level)
+{
+    const struct tgdb_frame *frame;
+    int result = btwin_select(level, &frame);
+
+    if (result == 0)
+        goto_frame(frame);
+
+    return result == -1 ? -1 : 0;
+}
+
+void if_backtrace_stopped(void)
+{
+    btwin_stopped();
+
+    /* The threads shown are where they stopped */
+    thrwin_fetch();
+}
+
+void if_backtrace(const struct tgdb_frames *frames)
+{
+    const struct tgdb_frame *selected;
+    int changed = btwin_update(frames, &selected);
+
+    /* The frame the user picked before gdb listed it */
+    if (selected) {
+        goto_frame(selected);
+        return;
+    }
+
+    /* The dialogs are drawn over everything, it's drawn when they're gone */
+    if (dialog_shown())
+        return;
+
+    if (changed && backtrace_pane)
+        wm_window_damage((wm_window *) backtrace_pane);
+
+    /* The innermost frame is where a thread is */
+    if (threads_pane && frames->low == 0)
+        wm_window_damage((wm_window *) threads_pane);
+
+    if ((changed && backtrace_pane) || (threads_pane && frames->low == 0))
+        if_redraw();
+}
+
+void if_clear_backtrace(void)
+{
+    btwin_clear();
+}
+
+int if_backtrace_unanswered(void)
+{
+    return btwin_unanswered();
+}
+
+int if_backtrace_abandon(void)
+{
+    return btwin_abandon();
+}
+
+void if_set_threadwin(int value)
+{
+    threadwin_on = value;
+    if_layout();
+}
+
+void if_set_logwin(int value)
+{
+    logwin_on = value;
+    if_layout();
+}
+
+void if_set_hlsearch(int value)
+{
+    update_hlsearch();
+    if_draw();
+}
+
+void if_set_srcsplit(int value)
+{
+    if (!src_win)
+        return;
+
+    source_set_views(src_win, value ? 2 : 1);
+    if_layout();
+}
+
+void if_log(const char *text)
+{
+    if (!logwin_on) {
+        if_print(text);
+        return;
+    }
+
+    /* Only whole lines are shown, it's drawn with the next frame */
+    if (logwin_add(text))
+        frame_log = 1;
+
+    if (frame_log && cgdbrc_get(CGDBRC_FRAMETIME)->variant.int_val <= 0)
+        if_frame_flush();
+}
+
+int if_scroll_threads(int pages)
+{
+    if (thrwin_scroll(pages) == -1)
+        return -1;
+
+    if_draw();
+
+    return 0;
+}
+
+/* redraw_threads: Draws the thread and backtrace windows again, if they're
+ * ---------------  shown and changed.
+ */
+static void redraw_threads(int threads, int backtrace)
+{
+    /* The dialogs are drawn over everything, it's drawn when they're gone */
+    if (dialog_shown())
+        return;
+
+    threads = threads && threads_pane;
+    backtrace = backtrace && backtrace_pane;
+
+    if (threads)
+        wm_window_damage((wm_window *) threads_pane);
+    if (backtrace)
+        wm_window_damage((wm_window *) backtrace_pane);
+    if (threads || backtrace)
+        if_redraw();
+}
+
+int if_select_thread(int id)
+{
+    const struct tgdb_frame *frame;
+    struct tgdb_request *request;
+    int threads, backtrace;
+
+    if (!thrwin_find(id))
+        return -1;
+
+    if (!(request = tgdb_request_select_thread(tgdb, id)))
+        return -1;
+    handle_request(tgdb, request);
+
+    threads = thrwin_select(id);
+    backtrace = btwin_set_thread(id);
+
+    /* Its innermost frame was likely listed for the thread window */
+    if (btwin_select(0, &frame) == 0)
+        goto_frame(frame);
+    else
+        redraw_threads(threads, backtrace);
+
+    return 0;
+}
+
+void if_thread_changes(const struct tgdb_thread_changes *changes)
+{
+    const struct tgdb_thread_change *change;
+    int i, threads = 0, backtrace = 0, stopped = 0;
+
+    for (i = 0; i < changes->count; i++) {
+        change = &changes->changes[i];
+
+        threads |= thrwin_change(change);
+
+        if (change->event == TGDB_THREAD_EXITED)
+            btwin_forget_thread(change->id);
+        else if (change->event == TGDB_THREAD_SELECTED)
+            backtrace |= btwin_set_thread(change->id);
+        else if (change->event == TGDB_THREAD_STOPPED && change->id > 0) {
+            /* In non-stop mode, only its stack is somewhere else */
+            btwin_forget_thread(change->id);
+            stopped = 1;
+        }
+    }
+
+    /* Where it stopped, if it's shown */
+    if (stopped)
+        thrwin_fetch();
+
+    redraw_threads(threads, backtrace);
+}
+
+void if_clear_threads(void)
+{
+    thrwin_clear();
+}
+
+void if_show_pc(unsigned long address)
+{
+    char text[32];
+    const char *path;
+    int line;
+
+    asm_pc = address;
+    if (!asm_win || address == 0)
+        return;
+
+    if ((path = disasm_find(address, &line))) {
+        source_set_exec_line(asm_win, path, line);
+        return;
+    }
+
+    /* A function gdb couldn't disassemble isn't asked for again and again */
+    source_show_none(asm_win);
+    if (!disasm_on || asm_requested || address == asm_failed)
+        return;
+
+    asm_requested = address;
+    snprintf(text, sizeof (text), "0x%lx", address);
+    handle_request(tgdb, tgdb_request_disassemble(tgdb, text));
+}
+
+void if_disassembly(const struct tgdb_disassembly *disassembly)
+{
+    int line;
+
+    if (!asm_win)
+        return;
+
+    if (disasm_add(asm_win, disassembly) == -1 ||
+            !disasm_find(asm_requested, &line))
+        asm_failed = asm_requested;
+    asm_requested = 0;
+
+    /* gdb may have moved on while it was disassembling */
+    if_show_pc(asm_pc);
+    if_draw();
+}
+
+void if_clear_disassembly(void)
+{
+    asm_pc = asm_requested = asm_failed = 0;
+
+    if (asm_win)
+        disasm_clear(asm_win);
+}
+
+void if_display_help(void)
+{
+    char cgdb_help_file[MAXLINE];
+    int ret_val = 0;
+
+    fs_util_get_path(PKGDATADIR, "cgdb.txt", cgdb_help_file);
     ret_val = source_set_exec_line(src_win, cgdb_help_file, 1);
     if (ret_val == 0)
         if_draw();
@@ -1469,12 +2634,179 @@ struct sviewer *if_get_sview()
 
 void if_clear_filedlg(void)
 {
+    int i;
+
     filedlg_clear(fd);
+
+    for (i = 0; i < source_files_count; i++)
+        free(source_files[i]);
+
+    free(source_files);
+    source_files = NULL;
+    source_files_count = 0;
+}
+
+void if_add_filedlg_choices(char **filenames, int count)
+{
+    int added, i;
+
+    /* The files that weren't there already are moved to the front */
+    if ((added = filedlg_add_file_choices(fd, filenames, count)) <= 0)
+        return;
+
+    source_files = cgdb_realloc(source_files,
+            sizeof (char *) * (source_files_count + added));
+    for (i = 0; i < added; i++)
+        source_files[source_files_count++] = cgdb_strdup(filenames[i]);
+}
+
+char **if_get_source_files(int *count)
+{
+    *count = source_files_count;
+    return source_files;
+}
+
+/* grep_source_files: Starts a project search of source_files.
+ * ------------------
+ */
+static void grep_source_files(const char *regex)
+{
+    int icase = cgdbrc_get(CGDBRC_IGNORECASE)->variant.int_val;
+    int engine = cgdbrc_get(CGDBRC_REGEXPENGINE)->variant.int_val;
+
+    filedlg_clear(grep_dlg);
+    grep_dlg_count = 0;
+
+    if (grep_start(regex, icase, engine, source_files, source_files_count,
+                    src_win) == -1) {
+        grep_stop();
+        filedlg_set_label(grep_dlg,
+                "Invalid regular expression, press q to cancel.");
+    } else
+        if_grep_results();
+
+    if_set_focus(GREP_DLG);
+}
+
+void if_show_filedlg(void)
+{
+    if (grep_pending) {
+        grep_source_files(grep_pending);
+        free(grep_pending);
+        grep_pending = NULL;
+    } else
+        if_set_focus(FILE_DLG);
+}
+
+int if_show_filedlg_partial(void)
+{
+    /* The search needs them all */
+    if (grep_pending)
+        return 0;
+
+    if_set_focus(FILE_DLG);
+
+    return 1;
+}
+
+void if_set_capture(struct capture *capture)
+{
+    capwin_set(capture_dlg, capture);
+
+    /* What it showed is gone */
+    if (focus == CAPTURE_DLG && !capture)
+        if_set_focus(CGDB);
+}
+
+int if_show_capture(void)
+{
+    if (!capwin_get(capture_dlg))
+        return -1;
+
+    if_set_focus(CAPTURE_DLG);
+
+    return 0;
+}
+
+void if_no_source_files(void)
+{
+    free(grep_pending);
+    grep_pending = NULL;
+}
+
+int if_condition_breakpoint(const char *condition)
+{
+    if (!condition || !*condition || !src_win || !src_win->view->cur)
+        return -1;
+
+    return toggle_breakpoint(src_win, TGDB_BREAKPOINT_ADD, condition);
 }
 
-void if_add_filedlg_choice(const char *filename)
+int if_tag(const char *name)
 {
-    filedlg_add_file_choice(fd, filename);
+    int ret;
+
+    if (!name || !*name || !src_win || !src_win->view->cur)
+        return -1;
+
+    if ((ret = source_goto_definition(src_win, name)) < 0) {
+        if_display_message("Tag not found:", 0, " %s", name);
+        return -1;
+    }
+
+    if_draw();
+
+    return ret;
+}
+
+void if_grep(const char *regex)
+{
+    if (!regex || !*regex) {
+        if (grep_pattern())
+            if_set_focus(GREP_DLG);
+        return;
+    }
+
+    if (source_files_count > 0) {
+        grep_source_files(regex);
+        return;
+    }
+
+    /* Ask gdb for the files, the search starts when they come in, or on
+     * the ones it listed the last time */
+    free(grep_pending);
+    grep_pending = cgdb_strdup(regex);
+
+    request_source_files();
+}
+
+void if_scroll_search(const char *regex)
+{
+    int found;
+
+    /* It's the pattern 'n' and 'N' repeat from now on */
+    if (*regex) {
+        if (!regex_last)
+            regex_last = ibuf_init();
+        ibuf_clear(regex_last);
+        ibuf_add(regex_last, regex);
+        regex_direction_last = 0;
+    } else if (!regex_last) {
+        if_display_message("No previous pattern", 0, "%s", "");
+        return;
+    }
+
+    found = scr_search(gdb_win, ibuf_get(regex_last), 2, 0,
+            cgdbrc_get(CGDBRC_IGNORECASE)->variant.int_val);
+    wm_window_damage((wm_window *) gdb_pane);
+
+    if (found == 1)
+        if_draw();
+    else if (found == 0)
+        if_display_message("Pattern not found: ", 0, "%s",
+                ibuf_get(regex_last));
+    else
+        if_display_message("Invalid pattern: ", 0, "%s", ibuf_get(regex_last));
 }
 
 void if_filedlg_display_message(char *message)
@@ -1482,26 +2814,47 @@ void if_filedlg_display_message(char *message)
     filedlg_display_message(fd, message);
 }
 
+void if_bracketed_paste(int enable)
+{
+    /* After what was drawn before it */
+    termout_send();
+    fputs(enable ? "\033[?2004h" : "\033[?2004l", stdout);
+    fflush(stdout);
+}
+
 void if_shutdown(void)
 {
     /* Shut down curses cleanly */
-    if (curses_initialized)
+    if (curses_initialized) {
+        if_bracketed_paste(0);
         endwin();
+        termout_send();
+    }
+
+    wm_destroy(wm);
 
     if (status_win != NULL)
         delwin(status_win);
 
-    if (tty_status_win != NULL)
-        delwin(tty_status_win);
-
     if (gdb_win != NULL)
         scr_free(gdb_win);
 
     if (tty_win != NULL)
         scr_free(tty_win);
 
+    if (flood_log != -1)
+        cgdb_close(flood_log);
+
     if (src_win != NULL)
         source_free(src_win);
+
+    if (asm_win != NULL) {
+        disasm_clear(asm_win);
+        source_free(asm_win);
+    }
+
+    brkwin_clear();
+    thrwin_clear();
 }
 
 void if_set_focus(Focus f)
@@ -1522,6 +2875,13 @@ void if_set_focus(Focus f)
             if_draw();
             break;
         case FILE_DLG:
+        case GREP_DLG:
+            focus = f;
+            if_draw();
+            break;
+        case CAPTURE_DLG:
+            if (!capwin_get(capture_dlg))
+                return;
             focus = f;
             if_draw();
             break;
@@ -1547,12 +2907,284 @@ void if_set_winsplit(WIN_SPLIT_TYPE new_split)
 
 void if_highlight_sviewer(enum tokenizer_language_support l)
 {
-    /* src_win->cur is NULL when reading cgdbrc */
-    if (src_win->cur) {
-        src_win->cur->language = l;
-        highlight(src_win->cur);
+    /* src_win->view->cur is NULL when reading cgdbrc */
+    if (src_win->view->cur) {
+        src_win->view->cur->language = l;
+        highlight(src_win->view->cur, NULL, 0);
+        source_invalidate(src_win);
+        if_draw();
+    }
+}
+
+int if_highlight_fd(void)
+{
+    return highlight_fd();
+}
+
+void if_highlighted(void)
+{
+    /* The file dialog covers the source window */
+    if (source_highlighted(src_win) && !dialog_shown())
+        if_draw();
+}
+
+int if_loader_fd(void)
+{
+    return loader_fd();
+}
+
+void if_loaded(void)
+{
+    /* The file dialog covers the source window */
+    if (source_loaded(src_win) && !dialog_shown())
         if_draw();
+}
+
+void if_files_changed(void)
+{
+    source_files_changed(src_win);
+}
+
+/* prefetch_file: Asks for a file gdb named to be loaded ahead of time.
+ * --------------
+ *
+ * A relative path is looked for at the end of the source files gdb listed.
+ */
+static void prefetch_file(const char *path)
+{
+    size_t length, plength = strlen(path);
+    int i;
+
+    if (source_prefetch(src_win, path) == 0)
+        return;
+
+    for (i = 0; i < source_files_count; i++) {
+        length = strlen(source_files[i]);
+        if (length > plength && source_files[i][length - plength - 1] == '/'
+                && strcmp(source_files[i] + length - plength, path) == 0) {
+            source_prefetch(src_win, source_files[i]);
+            return;
+        }
+    }
+}
+
+void if_prefetch_breaks(void)
+{
+    int i;
+
+    if (!src_win || !cgdbrc_get(CGDBRC_PREFETCH)->variant.int_val)
+        return;
+
+    /* The breakpoints are sorted by file */
+    for (i = 0; i < src_win->breaks_count; i++)
+        if (i == 0 || strcmp(src_win->breaks[i].path,
+                        src_win->breaks[i - 1].path) != 0)
+            prefetch_file(src_win->breaks[i].path);
+}
+
+void if_core_file(int core)
+{
+    core_on = core;
+
+    /* The stacks never change, they're all listed once */
+    if (core_on)
+        thrwin_fetch_all();
+}
+
+void if_prefetch_frames(const struct tgdb_frames *frames)
+{
+    const char *path, *last = NULL;
+    int i;
+
+    if (!core_on || !src_win || !cgdbrc_get(CGDBRC_PREFETCH)->variant.int_val)
+        return;
+
+    /* Recursion lists the same file over and over, the paths are interned */
+    for (i = 0; i < frames->count; i++) {
+        path = frames->frames[i].absolute_path;
+        if (!path)
+            path = frames->frames[i].relative_path;
+        if (path && path != last)
+            prefetch_file(path);
+        last = path;
+    }
+}
+
+void if_set_breakwin(int value)
+{
+    breakwin_on = value;
+    if_layout();
+}
+
+int if_scroll_breakpoints(int pages)
+{
+    if (brkwin_scroll(pages) == -1)
+        return -1;
+
+    if_draw();
+
+    return 0;
+}
+
+/* redraw_breakpoints: Draws the breakpoint window again, if it's shown.
+ * -------------------
+ */
+static void redraw_breakpoints(void)
+{
+    /* The dialogs are drawn over everything, it's drawn when they're gone */
+    if (breakpoints_pane && !dialog_shown()) {
+        wm_window_damage((wm_window *) breakpoints_pane);
+        if_redraw();
+    }
+}
+
+void if_breakpoints(struct tgdb_list *list)
+{
+    if (brkwin_set(list))
+        redraw_breakpoints();
+}
+
+void if_breakpoint_changes(const struct tgdb_breakpoint_changes *changes)
+{
+    const struct tgdb_breakpoint_change *change;
+    const struct tgdb_breakpoint *tb;
+    struct source_break old, new;
+    int i, file_changed = 0, shown_changed = 0;
+
+    for (i = 0; i < changes->count; i++) {
+        change = &changes->changes[i];
+
+        /* The source window has the lines of the one it was */
+        tb = brkwin_find(change->breakpoint.number);
+        if (tb) {
+            old.path = tb->file;
+            old.line = tb->line;
+            old.enabled = tb->enabled;
+        }
+
+        if (!change->deleted) {
+            new.path = change->breakpoint.file;
+            new.line = change->breakpoint.line;
+            new.enabled = change->breakpoint.enabled;
+        }
+
+        /* Only the hit count changed */
+        if (!tb || change->deleted || old.line != new.line ||
+                old.enabled != new.enabled || strcmp(old.path, new.path) != 0)
+            file_changed |= source_change_break(src_win, tb ? &old : NULL,
+                    change->deleted ? NULL : &new);
+
+        if (!change->deleted && src_win &&
+                cgdbrc_get(CGDBRC_PREFETCH)->variant.int_val &&
+                (!tb || strcmp(old.path, new.path) != 0))
+            prefetch_file(new.path);
+
+        shown_changed |= brkwin_change(change);
+    }
+
+    if (file_changed)
+        if_show_file(NULL, 0);
+
+    if (shown_changed)
+        redraw_breakpoints();
+}
+
+struct brkwin_breaks *if_swap_breakpoints(struct brkwin_breaks *breaks)
+{
+    struct brkwin_breaks *shown = brkwin_swap(breaks);
+    const struct tgdb_breakpoint *tb;
+    struct source_break *lines;
+    int count, i;
+
+    tb = brkwin_get(&count);
+    lines = cgdb_malloc(sizeof (struct source_break) * (count + 1));
+    for (i = 0; i < count; i++) {
+        lines[i].path = tb[i].file;
+        lines[i].line = tb[i].line;
+        lines[i].enabled = tb[i].enabled;
+    }
+
+    if (src_win && source_update_breaks(src_win, lines, count))
+        if_show_file(NULL, 0);
+    free(lines);
+
+    redraw_breakpoints();
+
+    return shown;
+}
+
+struct scroller *if_swap_gdb_window(struct scroller *scr)
+{
+    struct scroller *shown = gdb_win;
+    int top, left, height, width;
+
+    if (!shown || (!scr && (scr = scr_new(0, 0, 1, 1)) == NULL))
+        return NULL;
+
+    flood_show(&gdb_flood, shown);
+
+    getbegyx(shown->win, top, left);
+    getmaxyx(shown->win, height, width);
+    gdb_win = scr;
+    scr_move(gdb_win, top, left, height, width);
+
+    frame_gdb = 1;
+    if_draw();
+
+    return shown;
+}
+
+/* prefetch_sources: Determines if there's a source file to load ahead.
+ * -----------------
+ */
+static int prefetch_sources(void)
+{
+    /* Files are loaded while a worker is free to highlight them */
+    return src_win && cgdbrc_get(CGDBRC_PREFETCH)->variant.int_val &&
+            source_prefetch_pending(src_win) && highlight_idle();
+}
+
+int if_prefetch_pending(void)
+{
+    return prefetch_sources() || memwin_prefetch_pending();
+}
+
+void if_prefetch_next(void)
+{
+    if (prefetch_sources())
+        source_prefetch_next(src_win);
+    else
+        memwin_prefetch_next();
+}
+
+int if_grep_fd(void)
+{
+    return grep_fd();
+}
+
+void if_grep_results(void)
+{
+    char label[MAX_LINE];
+    struct grep_match *match;
+    int count = grep_collect();
+
+    for (; grep_dlg_count < count; grep_dlg_count++) {
+        match = grep_get(grep_dlg_count);
+        snprintf(label, sizeof (label), "%s:%d: %s", match->path,
+                match->line, match->text);
+        filedlg_append_choice(grep_dlg, label);
     }
+
+    if (grep_busy())
+        snprintf(label, sizeof (label), "Searching %d files, %d matches "
+                "so far. Select one or press q to cancel.", grep_files(), count);
+    else
+        snprintf(label, sizeof (label), "%d matches in %d files. "
+                "Select one or press q to cancel.", count, grep_files());
+    filedlg_set_label(grep_dlg, label);
+
+    if (focus == GREP_DLG)
+        filedlg_display(grep_dlg);
 }
 
 int if_change_winminheight(int value)
@@ -1572,7 +3204,7 @@ int if_change_winminheight(int value)
 
 int if_clear_line()
 {
-    int width = get_gdb_width();
+    int width = WIDTH;
     int i;
     char line[width + 3];
 
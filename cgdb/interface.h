@@ -11,6 +11,10 @@
 /* Local Includes */
 #include "sources.h"
 #include "cgdbrc.h"
+#include "tgdb_types.h"
+
+struct brkwin_breaks;
+struct scroller;
 
 /* --------- */
 /* Functions */
@@ -55,6 +59,46 @@ int if_input(int key);
  */
 void if_print(const char *buf);
 
+/* if_flooded: Determines if output comes faster than the floodrate option.
+ * -----------
+ *
+ * Return Value: 1 if the gdb or tty window only shows the end of it, 0
+ *               otherwise.
+ */
+int if_flooded(void);
+
+/* if_set_flood_log: Starts writing all the program's output to a file.
+ * -----------------
+ *
+ *   path:  The file, it's emptied first, or "" to stop writing
+ *
+ * Return Value: -1 if the file can't be opened, 0 otherwise.
+ */
+int if_set_flood_log(const char *path);
+
+/* if_frame_pending: Determines if there's printed data waiting to be drawn.
+ * -----------------
+ *
+ * Return Value: 1 if if_frame_flush has something to draw, 0 otherwise.
+ */
+int if_frame_pending(void);
+
+/* if_frame_wait: Works out when the printed data should be drawn.
+ * --------------
+ *
+ * The windows are drawn at most once every frametime milliseconds while
+ * data keeps coming.
+ *
+ * Return Value: The milliseconds until if_frame_flush should be called,
+ *               0 if it's late, or -1 if there's nothing to draw.
+ */
+int if_frame_wait(void);
+
+/* if_frame_flush: Draws the data printed to the windows since they were
+ * --------------- last drawn.
+ */
+void if_frame_flush(void);
+
 /* if_print_message: Prints data to the GDB input/output window.
  * -----------------
  *
@@ -65,9 +109,10 @@ void if_print_message(const char *fmt, ...);
 /* if_tty_print: Prints data to the tty input/output window.
  * -------------
  *
- *   buf:  NULL-terminated buffer to display.
+ *   buf:     Buffer to display, it may hold NUL bytes.
+ *   length:  The number of bytes in buf.
  */
-void if_tty_print(const char *buf);
+void if_tty_print(const char *buf, size_t length);
 
 /* if_show_file: Displays the requested file in the source display window.
  * -------------
@@ -75,7 +120,285 @@ void if_tty_print(const char *buf);
  *   path:  Full path to the file to display
  *   line:  Current line of the file being executed
  */
-void if_show_file(char *path, int line);
+void if_show_file(const char *path, int line);
+
+/* if_set_disasm: Shows or hides the disassembly window, to the right of
+ * --------------  the source window.
+ *
+ *   value:  1 to show it, 0 to hide it
+ */
+void if_set_disasm(int value);
+
+/* if_show_pc: Moves the disassembly window to the instruction gdb is at.
+ * -----------
+ *
+ *  A function that was disassembled before is shown as it was, only the
+ *  executing line moves. Otherwise gdb is asked to disassemble it. Call
+ *  if_draw after it.
+ *
+ *   address:  The address of the instruction, 0 if gdb didn't say
+ */
+void if_show_pc(unsigned long address);
+
+/* if_disassembly: Adds a function gdb disassembled, and shows it.
+ * ---------------
+ *
+ *   disassembly:  The instructions gdb listed
+ */
+void if_disassembly(const struct tgdb_disassembly *disassembly);
+
+/* if_clear_disassembly: Forgets the functions gdb disassembled.
+ * ---------------------
+ *
+ *  Call it when the program exits, it may be rebuilt before it's run again.
+ */
+void if_clear_disassembly(void);
+
+/* if_set_watch: Shows or hides the watch window, to the right of the gdb
+ * -------------  window.
+ *
+ *   value:  1 to show it, 0 to hide it
+ */
+void if_set_watch(int value);
+
+/* if_watch_stopped: Asks gdb what changed of what the watch window shows.
+ * -----------------
+ *
+ *  Call it each time gdb stops. Nothing is asked while the window is
+ *  hidden, it catches up when it's shown.
+ *
+ *   function:  The function gdb stopped in, NULL if gdb didn't say
+ */
+void if_watch_stopped(const char *function);
+
+/* if_watch_variables: Shows what gdb answered for the watch window.
+ * -------------------
+ *
+ *   variables:  The answer to a variable request
+ */
+void if_watch_variables(const struct tgdb_variables *variables);
+
+/* if_clear_watch: Forgets the locals, when the program exits.
+ * ---------------
+ */
+void if_clear_watch(void);
+
+/* if_set_memory: Shows or hides the memory window, to the right of the gdb
+ * --------------  window, or under the watch window when it's shown.
+ *
+ *   value:  1 to show it, 0 to hide it
+ */
+void if_set_memory(int value);
+
+/* if_memory_stopped: Reads the memory the memory window shows again.
+ * ------------------
+ *
+ *  Call it each time gdb stops.
+ */
+void if_memory_stopped(void);
+
+/* if_memory: Shows what gdb answered for the memory window.
+ * ----------
+ *
+ *   memory:  The answer to a request for memory
+ */
+void if_memory(const struct tgdb_memory *memory);
+
+/* if_clear_memory: Forgets the memory read, when the program exits.
+ * ----------------
+ */
+void if_clear_memory(void);
+
+/* if_set_backtrace: Shows or hides the backtrace window, under the watch
+ * -----------------  and memory windows, or to the right of the gdb window.
+ *
+ *   value:  1 to show it, 0 to hide it
+ */
+void if_set_backtrace(int value);
+
+/* if_scroll_backtrace: Shows the frames a window further out or back in.
+ * --------------------
+ *
+ *   pages:  How many windows full, negative to go back
+ *
+ * Return Value: 0 on success, -1 if there's no frame that way.
+ */
+int if_scroll_backtrace(int pages);
+
+/* if_select_frame: Makes gdb look at another frame, and shows where it is.
+ * ----------------
+ *
+ *  The source window goes to the frame from what the backtrace window
+ *  listed, gdb isn't asked where it is. A frame that wasn't listed yet is
+ *  gone to once gdb lists it.
+ *
+ *   level:  The level of the frame, 0 is the innermost one
+ *
+ * Return Value: 0 on success, -1 if the stack isn't that deep.
+ */
+int if_select_frame(int level);
+
+/* if_backtrace_stopped: Forgets the frames the backtrace window listed.
+ * ---------------------
+ *
+ *  Call it each time gdb stops.
+ */
+void if_backtrace_stopped(void);
+
+/* if_backtrace: Shows what gdb answered for the backtrace window.
+ * -------------
+ *
+ *   frames:  The answer to a request for frames
+ */
+void if_backtrace(const struct tgdb_frames *frames);
+
+/* if_clear_backtrace: Forgets the frames listed, when the program exits.
+ * -------------------
+ */
+void if_clear_backtrace(void);
+
+/* if_backtrace_unanswered: The requests for frames the backtrace window
+ * ------------------------  is waiting on gdb for.
+ *
+ * Return Value: How many answers are still due to if_backtrace.
+ */
+int if_backtrace_unanswered(void);
+
+/* if_backtrace_abandon: Stops waiting for the answers of the gdb shown,
+ * ---------------------  before another one is.
+ *
+ * Return Value: How many answers were due, the caller drops them.
+ */
+int if_backtrace_abandon(void);
+
+/* if_set_threadwin: Shows or hides the thread window, under the watch,
+ * -----------------  memory, backtrace and breakpoint windows, or to the
+ *                    right of the gdb window.
+ *
+ *   value:  1 to show it, 0 to hide it
+ */
+void if_set_threadwin(int value);
+
+/* if_set_logwin: Shows or hides the log window, under the other windows
+ * --------------  to the right of the gdb window, or to the right of it.
+ *
+ *   value:  1 to show it, 0 to hide it
+ */
+void if_set_logwin(int value);
+
+/* if_set_hlsearch: Draws every match of the last search in the source
+ * ----------------  window, or only the one the cursor goes to.
+ *
+ *   value:  1 to draw every match, 0 not to
+ */
+void if_set_hlsearch(int value);
+
+/* if_set_srcsplit: Shows the source files in two views side by side, or
+ * ----------------  in one.
+ *
+ *   value:  1 for two views, 0 for one
+ */
+void if_set_srcsplit(int value);
+
+/* if_log: Adds what gdb printed while the program ran to the log window.
+ * -------
+ *
+ *  It's drawn with the next frame. It goes to the gdb window instead
+ *  while the log window isn't shown.
+ *
+ *   text:  The text, a line can be split between two calls
+ */
+void if_log(const char *text);
+
+/* if_scroll_threads: Shows the threads a window further down or up.
+ * ------------------
+ *
+ *   pages:  How many windows full, negative to go up
+ *
+ * Return Value: 0 on success, -1 if there's no thread that way.
+ */
+int if_scroll_threads(int pages);
+
+/* if_select_thread: Makes gdb look at another thread, and shows where it is.
+ * -----------------
+ *
+ *  The backtrace window shows the thread's stack, and the source window
+ *  goes to its innermost frame, from what was listed for the thread window
+ *  when it was shown.
+ *
+ *   id:  The number of the thread
+ *
+ * Return Value: 0 on success, -1 if there's no such thread.
+ */
+int if_select_thread(int id);
+
+/* if_thread_changes: Applies the threads that started, exited or were
+ * ------------------  stopped in.
+ *
+ *   changes:  What gdb told changed since the last update
+ */
+void if_thread_changes(const struct tgdb_thread_changes *changes);
+
+/* if_clear_threads: Forgets the threads, when the program exits.
+ * -----------------
+ */
+void if_clear_threads(void);
+
+/* if_set_breakwin: Shows or hides the breakpoint window, under the watch,
+ * ----------------  memory and backtrace windows, or to the right of the
+ *                   gdb window.
+ *
+ *   value:  1 to show it, 0 to hide it
+ */
+void if_set_breakwin(int value);
+
+/* if_scroll_breakpoints: Shows the breakpoints a window further down or up.
+ * ----------------------
+ *
+ *   pages:  How many windows full, negative to go up
+ *
+ * Return Value: 0 on success, -1 if there's no breakpoint that way.
+ */
+int if_scroll_breakpoints(int pages);
+
+/* if_breakpoints: Takes all of the breakpoints, for the breakpoint window.
+ * ---------------
+ *
+ *  The source window is given them by source_update_breaks.
+ *
+ *   list:  The struct tgdb_breakpoint's
+ */
+void if_breakpoints(struct tgdb_list *list);
+
+/* if_breakpoint_changes: Applies the breakpoints that changed.
+ * ----------------------
+ *
+ *  Only the lines of the source window they're on, and the lines of the
+ *  breakpoint window they're listed on, are touched.
+ *
+ *   changes:  What gdb told changed since the last update
+ */
+void if_breakpoint_changes(const struct tgdb_breakpoint_changes *changes);
+
+/* if_swap_breakpoints: Shows another gdb's breakpoints, in the source and
+ * --------------------  breakpoint windows.
+ *
+ *   breaks:  The breakpoints to show, from if_swap_breakpoints, NULL for none
+ *
+ * Return Value: The breakpoints that were shown, brkwin_swap_free frees them.
+ */
+struct brkwin_breaks *if_swap_breakpoints(struct brkwin_breaks *breaks);
+
+/* if_swap_gdb_window: Shows another scroller as the gdb window.
+ * -------------------
+ *
+ *  The one shown is given the output it held back while it was flooded.
+ *
+ *   scr:  The scroller to show, from if_swap_gdb_window, NULL for a new one
+ *
+ * Return Value: The scroller that was shown, or NULL on error.
+ */
+struct scroller *if_swap_gdb_window(struct scroller *scr);
 
 /* if_get_sview: Return a pointer to the source viewer object.
  * -------------
@@ -102,12 +425,22 @@ void if_display_message(const char *msg, int width, const char *fmt, ...);
  */
 void if_clear_filedlg(void);
 
-/* if_add_fildlg_choice: adds the file filename to the choices the user gets.
- * ---------------------
+/* if_add_filedlg_choices: adds the files to the choices the user gets.
+ * ----------------------
+ *
+ *  filenames: files the user can choose to open, they're reordered.
+ *  count:     the number of files in filenames.
+ */
+void if_add_filedlg_choices(char **filenames, int count);
+
+/* if_get_source_files: Gets the files the file dialog has to show the user.
+ * --------------------
  *
- *  filename: a file the user can choose to open.
+ *  count:  Set to the number of files
+ *
+ *  Return Value: The files, good until the file dialog is cleared.
  */
-void if_add_filedlg_choice(const char *filename);
+char **if_get_source_files(int *count);
 
 /* if_filedlg_display_message: Displays a message on the filedlg window status bar.
  * ---------------------------
@@ -116,11 +449,105 @@ void if_add_filedlg_choice(const char *filename);
  */
 void if_filedlg_display_message(char *message);
 
+/* if_show_filedlg: Shows the file dialog, once all the choices are added.
+ * ----------------
+ *
+ *  If the list of files was asked for by if_grep, the search is started
+ *  instead.
+ */
+void if_show_filedlg(void);
+
+/* if_show_filedlg_partial: Shows the file dialog while choices are still
+ * ------------------------  being added.
+ *
+ *  Nothing is shown if the list of files was asked for by if_grep.
+ *
+ *  Return Value: 1 if the file dialog is shown, 0 otherwise.
+ */
+int if_show_filedlg_partial(void);
+
+/* if_set_capture: Sets the capture the capture dialog shows.
+ * ---------------
+ *
+ *  capture: The capture, or NULL for none. It's not copied, it must be
+ *           set to something else before it's freed.
+ */
+struct capture;
+void if_set_capture(struct capture *capture);
+
+/* if_show_capture: Shows the capture dialog.
+ * ----------------
+ *
+ *  Return Value: 0 on success, -1 if there's no capture to show.
+ */
+int if_show_capture(void);
+
+/* if_no_source_files: Drops the project search waiting for the list of
+ * -------------------  files, gdb doesn't know of any.
+ */
+void if_no_source_files(void);
+
+/* if_condition_breakpoint: Toggles a conditional breakpoint on the line
+ * ------------------------  selected in the source window.
+ *
+ *  gdb tests the condition where the condeval option says. A breakpoint
+ *  that's on the line already is deleted instead.
+ *
+ *  condition: The expression, in the language of the program.
+ *
+ *  Returns: 0 on success, -1 if there's no condition or no file shown.
+ */
+int if_condition_breakpoint(const char *condition);
+
+/* if_tag: Goes to where an identifier looks defined in the file shown.
+ * -------
+ *
+ *  name:  The identifier
+ *
+ *  Return Value: 1 if a definition was found, 0 if the identifier was only
+ *                found where it first is, -1 if it isn't in the file.
+ */
+int if_tag(const char *name);
+
+/* if_grep: Searches all the source files of the program.
+ * --------
+ *
+ *  The files are the ones last given to the file dialog. If there are
+ *  none yet, gdb is asked for them first. The matches are shown in a
+ *  list as they are found.
+ *
+ *  regex: The regular expression to search for, or NULL to go back to
+ *         the matches of the last search.
+ */
+void if_grep(const char *regex);
+
+/* if_scroll_search: Scrolls the GDB window back to a line that matches.
+ * -----------------
+ *
+ *  The search starts past the last match, or at the line above the one
+ *  at the bottom of the window, and goes back through the lines the
+ *  scrollspill option kept. regex becomes the pattern 'n' and 'N' repeat.
+ *
+ *  regex: The regular expression to search for, or "" to search for the
+ *         last one again.
+ */
+void if_scroll_search(const char *regex);
+
 /* if_shutdown: Cleans up, and restores the terminal (shuts off curses).
  * ------------
  */
 void if_shutdown(void);
 
+/* if_bracketed_paste: Turns the terminal's bracketed paste mode on or off.
+ * -------------------
+ *
+ *  While it's on, the terminal marks what's pasted, so it's passed on without
+ *  looking for maps in it.
+ *
+ *  enable: 1 to turn it on, 0 to turn it off.
+ */
+void if_bracketed_paste(int enable);
+
 /* enum Focus: An enumeration representing a focus state. 
  * ------------
  *  GDB: focus on the gdb i/o window
@@ -128,8 +555,19 @@ void if_shutdown(void);
  *  CGDB: focus on source window, accepts command input.
  *  CGDB_STATUS_BAR: focus on the status bar, accepts commands.
  *  FILE_DLG: focus on file dialog window
+ *  GREP_DLG: focus on the list of matches of a project search
+ *  CAPTURE_DLG: focus on the output of a command that was captured
+ *  DISASM: the disassembly window, it's never focused
+ *  WATCH: the watch window, it's never focused
+ *  MEMORY: the memory window, it's never focused
+ *  BACKTRACE: the backtrace window, it's never focused
+ *  BREAKPOINTS: the breakpoint window, it's never focused
+ *  THREADS: the thread window, it's never focused
+ *  LOG: the log window, it's never focused
  */
-typedef enum Focus { GDB, TTY, CGDB, CGDB_STATUS_BAR, FILE_DLG } Focus;
+typedef enum Focus { GDB, TTY, CGDB, CGDB_STATUS_BAR, FILE_DLG,
+    GREP_DLG, CAPTURE_DLG, DISASM, WATCH, MEMORY, BACKTRACE, BREAKPOINTS,
+    THREADS, LOG } Focus;
 
 /* if_set_focus: Sets the current input focus to a different window 
  * ------------
@@ -178,6 +616,117 @@ void if_set_winsplit(WIN_SPLIT_TYPE newSplit);
  */
 void if_highlight_sviewer(enum tokenizer_language_support l);
 
+/* if_highlight_fd:
+ * ----------------
+ *
+ *  Gets the file descriptor that is readable when the highlighting worker
+ *  has finished a source file.
+ *
+ *  Returns the file descriptor, or -1 if files are highlighted right away.
+ */
+int if_highlight_fd(void);
+
+/* if_highlighted:
+ * ---------------
+ *
+ *  Shows the source files the highlighting worker has finished. This
+ *  should be called when if_highlight_fd is readable.
+ */
+void if_highlighted(void);
+
+/* if_loader_fd:
+ * -------------
+ *
+ *  Gets the file descriptor that is readable when a source file was read
+ *  in the background, or more of a big one was.
+ *
+ *  Returns the file descriptor, or -1 if files are read right away.
+ */
+int if_loader_fd(void);
+
+/* if_loaded:
+ * ----------
+ *
+ *  Shows the source files that were read in the background, or how far
+ *  along the one gdb stopped in is. This should be called when
+ *  if_loader_fd is readable.
+ */
+void if_loaded(void);
+
+/* if_files_changed:
+ * -----------------
+ *
+ *  Takes note of the source files the kernel reported changes to. This
+ *  should be called when fs_watch_fd is readable.
+ */
+void if_files_changed(void);
+
+/* if_prefetch_breaks:
+ * -------------------
+ *
+ *  Asks for the source files with breakpoints in them to be loaded before
+ *  they're displayed. Call it when the breakpoints or the list of source
+ *  files change.
+ */
+void if_prefetch_breaks(void);
+
+/* if_core_file:
+ * -------------
+ *
+ *  Takes note that gdb started or stopped debugging a core dump. The
+ *  stack of each thread is listed whole then, and the source files of all
+ *  of its frames are loaded before they're displayed.
+ *
+ *  core: 1 if gdb debugs a core dump now, 0 otherwise
+ */
+void if_core_file(int core);
+
+/* if_prefetch_frames:
+ * -------------------
+ *
+ *  Asks for the source files of frames gdb listed to be loaded before
+ *  they're displayed, while a core dump is debugged. Call it with each
+ *  answer to a request for frames.
+ */
+void if_prefetch_frames(const struct tgdb_frames *frames);
+
+/* if_prefetch_pending:
+ * --------------------
+ *
+ *  Determines if there's a source file if_prefetch_next should load, or
+ *  memory next to what the memory window shows it should read.
+ *
+ *  Return Value: 1 if there is, 0 otherwise.
+ */
+int if_prefetch_pending(void);
+
+/* if_prefetch_next:
+ * -----------------
+ *
+ *  Loads and starts highlighting the next source file asked for, or asks
+ *  gdb for the next page of memory. This should be called when nothing
+ *  else needs doing.
+ */
+void if_prefetch_next(void);
+
+/* if_grep_fd:
+ * -----------
+ *
+ *  Gets the file descriptor that becomes readable when a project search
+ *  has found more matches, or finished.
+ *
+ *  Return Value: The file descriptor, or -1 if nothing can be searched.
+ */
+int if_grep_fd(void);
+
+/* if_grep_results:
+ * ----------------
+ *
+ *  Adds the matches found by a project search to its list. This should
+ *  be called when if_grep_fd is readable.
+ */
+void if_grep_results(void);
+
 /* if_change_winminheight:
  * -----------------------
  * 
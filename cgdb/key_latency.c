@@ -0,0 +1,591 @@
+/* key_latency.c:
+ * --------------
+ *
+ * Measures how long cgdb takes to update the screen after a key is pressed.
+ * cgdb is run on a pseudo terminal, with fake_gdb as its debugger, and the
+ * keys of a script are typed into it one step at a time. A step's latency
+ * is from when its keys are written to when the last of what cgdb drew for
+ * them is read back, once nothing more has come for SETTLE milliseconds.
+ *
+ * A script has one of these on each line, and # starts a comment,
+ *
+ *   rc LINE          LINE is put in the cgdbrc cgdb is started with
+ *   setup KEYS       types KEYS and waits for cgdb to draw them, without
+ *                    timing it
+ *   group NAME       the steps after it are reported as NAME
+ *   keys KEYS        types KEYS, written like the right side of a map,
+ *                    as in "keys /main<CR>"
+ *   repeat N KEYS    types KEYS N times, each is a step of its own
+ *
+ * A line of JSON is written for each group, and one for all the steps, with
+ * the 50th and 99th percentile and the worst latency in milliseconds. A
+ * step cgdb drew nothing for is counted as silent and isn't in them.
+ *
+ * Usage: key_latency [-c CGDB] [-d DEBUGGER] [-t TERM] [-s COLSxLINES]
+ *                    [-w SETTLE] [-p P50] [-q P99] SCRIPT
+ *
+ * The exit status is 1 if the 50th percentile of all the steps is over P50
+ * milliseconds, or the 99th is over P99, and 2 if cgdb couldn't be driven.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#if HAVE_SIGNAL_H
+#include <signal.h>
+#endif /* HAVE_SIGNAL_H */
+
+#if HAVE_DIRENT_H
+#include <dirent.h>
+#endif /* HAVE_DIRENT_H */
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif /* HAVE_SYS_STAT_H */
+
+#include <sys/wait.h>
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif /* HAVE_SYS_TIME_H */
+
+#ifdef HAVE_SYS_SELECT_H
+#include <sys/select.h>
+#endif /* HAVE_SYS_SELECT_H */
+
+/* Local Includes */
+#include "pseudo.h"
+#include "fs_util.h"
+#include "sys_util.h"
+#include "kui.h"
+#include "kui_term.h"
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The file fake_gdb says the program is stopped in, and its length */
+#define LATENCY_SOURCE "/tmp/fake_gdb.c"
+#define LATENCY_SOURCE_LINES 1000
+
+/* How long cgdb has to start, and to draw anything for a step */
+#define LATENCY_START_MS 10000
+#define LATENCY_STEP_MS 1000
+
+/* How long nothing has to come for cgdb to be done starting */
+#define LATENCY_IDLE_MS 500
+
+#define LATENCY_LINE 1024
+
+/* The latencies of a group of steps */
+struct latency_group {
+    char name[64];
+    double *ms;
+    int count, size;
+    int silent;
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+static struct latency_group *groups;
+static int group_count;
+
+/* The steps of all the groups */
+static struct latency_group all = { .name = "all" };
+
+static char buf[64 * 1024];
+
+static int master_fd = -1;
+static pid_t cgdb_pid = -1;
+
+/* How long nothing has to come for a step to be done */
+static double settle_ms = 50;
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+static void usage(const char *progname)
+{
+    printf("%s [-c cgdb] [-d debugger] [-t term] [-s COLSxLINES] "
+            "[-w settle] [-p p50] [-q p99] SCRIPT\n", progname);
+    printf("  -c  The cgdb to run, ./cgdb by default\n");
+    printf("  -d  The debugger it runs, "
+            "../lib/tgdb/tgdb-base/fake_gdb by default\n");
+    printf("  -t  The terminal type, xterm by default\n");
+    printf("  -s  The terminal size, 80x24 by default\n");
+    printf("  -w  The milliseconds without output that end a step, "
+            "50 by default\n");
+    printf("  -p  Fails if the 50th percentile is over this, in ms\n");
+    printf("  -q  Fails if the 99th percentile is over this, in ms\n");
+    exit(2);
+}
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+static void group_add(struct latency_group *group, double ms)
+{
+    if (group->count == group->size) {
+        group->size = group->size ? group->size * 2 : 64;
+        group->ms = cgdb_realloc(group->ms, sizeof (double) * group->size);
+    }
+    group->ms[group->count++] = ms;
+}
+
+static int compare_ms(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return x < y ? -1 : x > y;
+}
+
+/* percentile: The latency p percent of the steps of group are within.
+ * The latencies have to be sorted. */
+static double percentile(const struct latency_group *group, int p)
+{
+    int i;
+
+    if (group->count == 0)
+        return 0;
+
+    i = (group->count * p + 99) / 100 - 1;
+
+    return group->ms[i < 0 ? 0 : i];
+}
+
+static void report(struct latency_group *group)
+{
+    qsort(group->ms, group->count, sizeof (double), compare_ms);
+
+    printf("{\"group\": \"%s\", \"steps\": %d, \"silent\": %d, "
+            "\"p50_ms\": %.2f, \"p99_ms\": %.2f, \"max_ms\": %.2f}\n",
+            group->name, group->count, group->silent,
+            percentile(group, 50), percentile(group, 99),
+            group->count ? group->ms[group->count - 1] : 0);
+}
+
+/* remove_tree: Removes path, and what's in it if it's a directory. */
+static void remove_tree(const char *path)
+{
+    char child[FSUTIL_PATH_MAX];
+    struct dirent *entry;
+    struct stat st;
+    DIR *dir;
+
+    if (lstat(path, &st) == -1)
+        return;
+
+    if (S_ISDIR(st.st_mode) && (dir = opendir(path))) {
+        while ((entry = readdir(dir))) {
+            if (strcmp(entry->d_name, ".") == 0 ||
+                    strcmp(entry->d_name, "..") == 0)
+                continue;
+            fs_util_get_path(path, entry->d_name, child);
+            remove_tree(child);
+        }
+        closedir(dir);
+        rmdir(path);
+    } else
+        unlink(path);
+}
+
+/* write_source: Writes the file fake_gdb stops in, unless there is one. */
+static int write_source(void)
+{
+    FILE *file;
+    int i;
+
+    if (access(LATENCY_SOURCE, R_OK) == 0)
+        return 0;
+
+    if (!(file = fopen(LATENCY_SOURCE, "w")))
+        return -1;
+
+    fprintf(file, "int main(int argc, char *argv[])\n{\n");
+    for (i = 3; i < LATENCY_SOURCE_LINES; i++)
+        fprintf(file, "    argc = argc * %d + %d; /* line %d */\n",
+                i, i % 7, i);
+    fprintf(file, "}\n");
+
+    return fclose(file) == EOF ? -1 : 0;
+}
+
+/* write_rc: Writes the rc lines of script to home/.cgdb/cgdbrc. */
+static int write_rc(const char *script, const char *home)
+{
+    char line[LATENCY_LINE], path[FSUTIL_PATH_MAX];
+    FILE *in, *out;
+
+    if (!fs_util_create_dir_in_base(home, ".cgdb"))
+        return -1;
+
+    snprintf(path, sizeof (path), "%s/.cgdb/cgdbrc", home);
+    if (!(in = fopen(script, "r")))
+        return -1;
+    if (!(out = fopen(path, "w"))) {
+        fclose(in);
+        return -1;
+    }
+
+    while (fgets(line, sizeof (line), in))
+        if (strncmp(line, "rc ", 3) == 0)
+            fputs(line + 3, out);
+
+    fclose(in);
+
+    return fclose(out) == EOF ? -1 : 0;
+}
+
+static int start_cgdb(const char *cgdb, const char *debugger,
+        const char *term, int cols, int lines, const char *home)
+{
+    char slavename[SLAVE_SIZE];
+    struct winsize size;
+
+    memset(&size, 0, sizeof (size));
+    size.ws_col = cols;
+    size.ws_row = lines;
+
+    cgdb_pid = pty_fork(&master_fd, slavename, SLAVE_SIZE, NULL, &size);
+    if (cgdb_pid == -1)
+        return -1;
+
+    if (cgdb_pid == 0) {
+        setenv("TERM", term, 1);
+        setenv("HOME", home, 1);
+        execl(cgdb, cgdb, "-d", debugger, (char *) NULL);
+        fprintf(stderr, "Can't run %s\n", cgdb);
+        _exit(2);
+    }
+
+    return 0;
+}
+
+/* drain: Reads what cgdb draws until nothing has come for idle_ms, or
+ * until timeout_ms passed without anything coming at all.
+ *
+ * Returns the time the last of it came, 0 if nothing did, or -1 if cgdb
+ * went away. */
+static double drain(double idle_ms, double timeout_ms)
+{
+    double start = now(), last = 0, wait_ms;
+    struct timeval timeout;
+    fd_set rfds;
+    ssize_t n;
+    int ret;
+
+    for (;;) {
+        wait_ms = last ? last + idle_ms - now() : start + timeout_ms - now();
+        if (wait_ms <= 0)
+            return last;
+
+        FD_ZERO(&rfds);
+        FD_SET(master_fd, &rfds);
+        timeout.tv_sec = (long) wait_ms / 1000;
+        timeout.tv_usec = ((long) (wait_ms * 1000)) % 1000000;
+
+        ret = select(master_fd + 1, &rfds, NULL, NULL, &timeout);
+        if (ret == -1 && errno == EINTR)
+            continue;
+        else if (ret == -1)
+            return -1;
+        else if (ret == 0)
+            continue;
+
+        n = read(master_fd, buf, sizeof (buf));
+        if (n == -1 && errno == EINTR)
+            continue;
+        else if (n <= 0)
+            return -1;
+
+        last = now();
+    }
+}
+
+/* type_keys: Types keys into cgdb, they're sent all at once, so an escape
+ * sequence isn't split. */
+static int type_keys(const char *keys)
+{
+    char bytes[LATENCY_LINE * 8];
+    int *key_array, i;
+    size_t length = 0;
+    const char *seq;
+
+    if (kui_term_string_to_key_array(keys, &key_array) == -1)
+        return -1;
+
+    for (i = 0; key_array[i] != 0; i++) {
+        if (kui_term_is_cgdb_key(key_array[i]))
+            seq = kui_term_get_ascii_char_sequence_from_key(key_array[i]);
+        else {
+            bytes[length++] = (char) key_array[i];
+            continue;
+        }
+
+        if (!seq || length + strlen(seq) >= sizeof (bytes)) {
+            free(key_array);
+            return -1;
+        }
+        memcpy(bytes + length, seq, strlen(seq));
+        length += strlen(seq);
+    }
+
+    free(key_array);
+
+    return write(master_fd, bytes, length) == (ssize_t) length ? 0 : -1;
+}
+
+/* step: Types keys and counts how long cgdb took to draw them. */
+static int step(struct latency_group *group, const char *keys)
+{
+    double start, last;
+
+    start = now();
+    if (type_keys(keys) == -1) {
+        fprintf(stderr, "Can't type \"%s\"\n", keys);
+        return -1;
+    }
+
+    last = drain(settle_ms, LATENCY_STEP_MS);
+    if (last == -1) {
+        fprintf(stderr, "cgdb went away after \"%s\"\n", keys);
+        return -1;
+    }
+
+    if (last == 0) {
+        group->silent++;
+        all.silent++;
+    } else {
+        group_add(group, last - start);
+        group_add(&all, last - start);
+    }
+
+    return 0;
+}
+
+static struct latency_group *new_group(const char *name)
+{
+    struct latency_group *group;
+
+    groups = cgdb_realloc(groups, sizeof (*groups) * (group_count + 1));
+    group = &groups[group_count++];
+
+    memset(group, 0, sizeof (*group));
+    snprintf(group->name, sizeof (group->name), "%s", name);
+
+    return group;
+}
+
+/* run_script: Runs the steps of script, returns -1 if one couldn't be. */
+static int run_script(const char *script)
+{
+    struct latency_group *group = NULL;
+    char line[LATENCY_LINE], *keys;
+    int number = 0, count, i, ret = 0;
+    size_t length;
+    FILE *file;
+
+    if (!(file = fopen(script, "r")))
+        return -1;
+
+    while (ret == 0 && fgets(line, sizeof (line), file)) {
+        number++;
+
+        length = strlen(line);
+        while (length > 0 && (line[length - 1] == '\n' ||
+                line[length - 1] == '\r'))
+            line[--length] = '\0';
+
+        if (line[0] == '\0' || line[0] == '#' || strncmp(line, "rc ", 3) == 0)
+            continue;
+
+        if (strncmp(line, "group ", 6) == 0) {
+            group = new_group(line + 6);
+            continue;
+        }
+
+        if (strncmp(line, "setup ", 6) == 0) {
+            if (type_keys(line + 6) == -1 ||
+                    drain(settle_ms, LATENCY_STEP_MS) == -1) {
+                fprintf(stderr, "%s:%d: Can't type \"%s\"\n",
+                        script, number, line + 6);
+                ret = -1;
+            }
+            continue;
+        }
+
+        if (!group)
+            group = new_group("keys");
+
+        count = 1;
+        if (strncmp(line, "keys ", 5) == 0)
+            keys = line + 5;
+        else if (sscanf(line, "repeat %d", &count) == 1 && count > 0 &&
+                (keys = strchr(line + 7, ' ')))
+            keys++;
+        else {
+            fprintf(stderr, "%s:%d: Can't understand \"%s\"\n",
+                    script, number, line);
+            ret = -1;
+            break;
+        }
+
+        for (i = 0; ret == 0 && i < count; i++)
+            ret = step(group, keys);
+    }
+
+    fclose(file);
+
+    return ret;
+}
+
+static void stop_cgdb(void)
+{
+    int status, i;
+
+    if (cgdb_pid <= 0)
+        return;
+
+    /* Most of the time it's gone by the time it's asked again */
+    type_keys("<Esc>:quit<CR>");
+    for (i = 0; i < 100; i++) {
+        if (waitpid(cgdb_pid, &status, WNOHANG) == cgdb_pid)
+            return;
+        drain(10, 10);
+    }
+
+    kill(cgdb_pid, SIGKILL);
+    waitpid(cgdb_pid, &status, 0);
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+int main(int argc, char *argv[])
+{
+    const char *cgdb = "./cgdb";
+    const char *debugger = "../lib/tgdb/tgdb-base/fake_gdb";
+    const char *term = "xterm", *size = "80x24";
+    char home[] = "/tmp/key_latency.XXXXXX";
+    double p50_limit = 0, p99_limit = 0, p50, p99;
+    int opt, cols, lines, ret = 0;
+    struct kui_map_set *map_set;
+
+    while ((opt = getopt(argc, argv, "c:d:t:s:w:p:q:")) != -1) {
+        switch (opt) {
+            case 'c':
+                cgdb = optarg;
+                break;
+            case 'd':
+                debugger = optarg;
+                break;
+            case 't':
+                term = optarg;
+                break;
+            case 's':
+                size = optarg;
+                break;
+            case 'w':
+                settle_ms = atof(optarg);
+                break;
+            case 'p':
+                p50_limit = atof(optarg);
+                break;
+            case 'q':
+                p99_limit = atof(optarg);
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+
+    if (optind != argc - 1 || sscanf(size, "%dx%d", &cols, &lines) != 2 ||
+            cols <= 0 || lines <= 0 || settle_ms <= 0)
+        usage(argv[0]);
+
+    /* The keys are typed the way the terminal cgdb runs in sends them */
+    setenv("TERM", term, 1);
+    if (!(map_set = kui_term_get_terminal_mappings()))
+        return 2;
+
+    if (write_source() == -1) {
+        fprintf(stderr, "Can't write %s\n", LATENCY_SOURCE);
+        return 2;
+    }
+
+    /* cgdb gets a home of its own, without the user's cgdbrc */
+    if (!mkdtemp(home)) {
+        fprintf(stderr, "Can't make a home directory in /tmp\n");
+        return 2;
+    }
+
+    if (write_rc(argv[optind], home) == -1) {
+        fprintf(stderr, "Can't read %s\n", argv[optind]);
+        ret = 2;
+    } else if (start_cgdb(cgdb, debugger, term, cols, lines, home) == -1) {
+        fprintf(stderr, "Can't start %s\n", cgdb);
+        ret = 2;
+    } else if (drain(LATENCY_IDLE_MS, LATENCY_START_MS) <= 0) {
+        fprintf(stderr, "%s didn't start\n", cgdb);
+        ret = 2;
+    } else if (run_script(argv[optind]) == -1)
+        ret = 2;
+
+    stop_cgdb();
+    remove_tree(home);
+    kui_ms_destroy(map_set);
+
+    if (ret != 0)
+        return ret;
+
+    for (opt = 0; opt < group_count; opt++)
+        report(&groups[opt]);
+    report(&all);
+
+    p50 = percentile(&all, 50);
+    p99 = percentile(&all, 99);
+    if (p50_limit > 0 && p50 > p50_limit) {
+        fprintf(stderr, "The 50th percentile is %.2f ms, over %.2f ms\n",
+                p50, p50_limit);
+        ret = 1;
+    }
+    if (p99_limit > 0 && p99 > p99_limit) {
+        fprintf(stderr, "The 99th percentile is %.2f ms, over %.2f ms\n",
+                p99, p99_limit);
+        ret = 1;
+    }
+
+    return ret;
+}
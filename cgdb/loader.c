@@ -0,0 +1,395 @@
+/* loader.c:
+ * ---------
+ *
+ * Reads source files in the background.
+ *
+ * A single reader thread takes the files off a list one at a time and
+ * reads each into a heap buffer a chunk at a time, so that how far along
+ * it is can be shown. A byte is written down a pipe when a file is done,
+ * and every LOADER_PROGRESS bytes of a big one, so the main loop can pick
+ * the file up or draw the progress.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif /* HAVE_SYS_TYPES_H */
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif /* HAVE_SYS_STAT_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
+#if HAVE_SIGNAL_H
+#include <signal.h>
+#endif /* HAVE_SIGNAL_H */
+
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
+/* Local Includes */
+#include "loader.h"
+#include "sys_util.h"
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The most bytes read at once */
+#define LOADER_CHUNK (256 * 1024)
+
+/* The bytes read between wakeups of the main loop to draw the progress */
+#define LOADER_PROGRESS (1024 * 1024)
+
+/* A file waiting to be read, or being read */
+struct loader_job {
+    char *path;
+    struct loader_job *next;
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+/* Everything but the thread and the pipe is protected by loader_mutex */
+static pthread_mutex_t loader_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t loader_cond = PTHREAD_COND_INITIALIZER;  /* todo grew */
+static pthread_cond_t loader_done_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t loader_thread;
+static int loader_running;      /* 1 once the thread is started */
+static int loader_pipe[2] = { -1, -1 };
+
+static struct loader_job *loader_todo;  /* Files waiting, in order */
+static struct loader_job *loader_current;       /* The file being read */
+static size_t loader_done_bytes;        /* How much of it was read */
+static size_t loader_total_bytes;       /* Its size, 0 until it's opened */
+static struct loader_file *loader_done; /* Files for the main loop, in order */
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* loader_notify: Wakes up the main loop.
+ * --------------
+ */
+static void loader_notify(void)
+{
+    char c = 0;
+
+    while (write(loader_pipe[1], &c, 1) == -1 && errno == EINTR)
+        ;
+}
+
+/* loader_set_progress: Records how much of the current file was read.
+ * --------------------
+ */
+static void loader_set_progress(size_t done, size_t total)
+{
+    pthread_mutex_lock(&loader_mutex);
+    loader_done_bytes = done;
+    loader_total_bytes = total;
+    pthread_mutex_unlock(&loader_mutex);
+}
+
+/* loader_read: Reads a whole file.
+ * ------------
+ *
+ *   file:  The file to fill in, its path is set
+ */
+static void loader_read(struct loader_file *file)
+{
+    struct stat st;
+    size_t total = 0, size, notified = 0;
+    ssize_t n;
+    int fd;
+
+    if ((fd = open(file->path, O_RDONLY)) == -1)
+        return;
+
+    if (fstat(fd, &st) == -1 || (off_t) (size_t) st.st_size != st.st_size) {
+        cgdb_close(fd);
+        return;
+    }
+
+    size = st.st_size;
+    file->mtime = st.st_mtime;
+    file->data = cgdb_malloc(size > 0 ? size : 1);
+    loader_set_progress(0, size);
+
+    while (total < size) {
+        n = read(fd, file->data + total,
+                size - total < LOADER_CHUNK ? size - total : LOADER_CHUNK);
+        if (n == -1 && errno == EINTR)
+            continue;
+
+        if (n == -1) {
+            free(file->data);
+            file->data = NULL;
+            break;
+        }
+
+        /* The file shrunk since it was stat'd */
+        if (n == 0)
+            break;
+
+        total += n;
+        loader_set_progress(total, size);
+
+        if (total - notified >= LOADER_PROGRESS) {
+            notified = total;
+            loader_notify();
+        }
+    }
+
+    cgdb_close(fd);
+
+    file->size = total;
+}
+
+/* loader_reader: The body of the reader thread.
+ * --------------
+ */
+static void *loader_reader(void *arg)
+{
+    struct loader_file *file, **last;
+    struct loader_job *job;
+
+    for (;;) {
+        pthread_mutex_lock(&loader_mutex);
+        while (!loader_todo)
+            pthread_cond_wait(&loader_cond, &loader_mutex);
+
+        job = loader_todo;
+        loader_todo = job->next;
+        loader_current = job;
+        loader_done_bytes = loader_total_bytes = 0;
+        pthread_mutex_unlock(&loader_mutex);
+
+        file = cgdb_calloc(1, sizeof (struct loader_file));
+        file->path = job->path;
+        loader_read(file);
+        free(job);
+
+        pthread_mutex_lock(&loader_mutex);
+        loader_current = NULL;
+        for (last = &loader_done; *last; last = &(*last)->next)
+            ;
+        *last = file;
+        pthread_cond_broadcast(&loader_done_cond);
+        pthread_mutex_unlock(&loader_mutex);
+
+        loader_notify();
+    }
+
+    return NULL;
+}
+
+/* loader_find: Determines if a file is waiting to be read or being read.
+ * ------------
+ *
+ * loader_mutex must be held.
+ */
+static int loader_find(const char *path)
+{
+    struct loader_job *job;
+
+    if (loader_current && strcmp(loader_current->path, path) == 0)
+        return 1;
+
+    for (job = loader_todo; job; job = job->next)
+        if (strcmp(job->path, path) == 0)
+            return 1;
+
+    return 0;
+}
+
+/* loader_find_done: Determines if a file is done but not taken yet.
+ * -----------------
+ *
+ * loader_mutex must be held.
+ */
+static int loader_find_done(const char *path)
+{
+    struct loader_file *file;
+
+    for (file = loader_done; file; file = file->next)
+        if (strcmp(file->path, path) == 0)
+            return 1;
+
+    return 0;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in loader.h for function descriptions. */
+
+int loader_init(void)
+{
+    sigset_t all, old;
+    int ret;
+
+    if (loader_running)
+        return 0;
+
+    if (pipe(loader_pipe) == -1)
+        return -1;
+
+    /* The main loop drains the pipe without waiting on it */
+    fcntl(loader_pipe[0], F_SETFL, fcntl(loader_pipe[0], F_GETFL) | O_NONBLOCK);
+
+    /* Signals are left to the main thread */
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    ret = pthread_create(&loader_thread, NULL, loader_reader, NULL);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    if (ret != 0) {
+        cgdb_close(loader_pipe[0]);
+        cgdb_close(loader_pipe[1]);
+        loader_pipe[0] = loader_pipe[1] = -1;
+        return -1;
+    }
+
+    loader_running = 1;
+
+    return 0;
+}
+
+int loader_fd(void)
+{
+    return loader_pipe[0];
+}
+
+int loader_request(const char *path)
+{
+    struct loader_job *job, **last;
+
+    if (!loader_running)
+        return -1;
+
+    pthread_mutex_lock(&loader_mutex);
+
+    if (!loader_find(path) && !loader_find_done(path)) {
+        job = cgdb_malloc(sizeof (struct loader_job));
+        job->path = cgdb_strdup(path);
+        job->next = NULL;
+
+        for (last = &loader_todo; *last; last = &(*last)->next)
+            ;
+        *last = job;
+        pthread_cond_signal(&loader_cond);
+    }
+
+    pthread_mutex_unlock(&loader_mutex);
+
+    return 0;
+}
+
+int loader_wait(const char *path, int msec)
+{
+    struct timespec deadline;
+    int done;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += msec / 1000;
+    deadline.tv_nsec += (msec % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&loader_mutex);
+    while (!(done = loader_find_done(path)) && loader_find(path))
+        if (pthread_cond_timedwait(&loader_done_cond, &loader_mutex,
+                        &deadline) == ETIMEDOUT)
+            break;
+
+    if (!done)
+        done = loader_find_done(path);
+    pthread_mutex_unlock(&loader_mutex);
+
+    return done;
+}
+
+int loader_progress(const char *path, size_t *done, size_t *total)
+{
+    int found;
+
+    *done = *total = 0;
+
+    pthread_mutex_lock(&loader_mutex);
+    found = loader_find(path);
+    if (loader_current && strcmp(loader_current->path, path) == 0) {
+        *done = loader_done_bytes;
+        *total = loader_total_bytes;
+    }
+    pthread_mutex_unlock(&loader_mutex);
+
+    return found;
+}
+
+int loader_busy(void)
+{
+    int busy;
+
+    pthread_mutex_lock(&loader_mutex);
+    busy = loader_todo || loader_current || loader_done;
+    pthread_mutex_unlock(&loader_mutex);
+
+    return busy;
+}
+
+struct loader_file *loader_finish(void)
+{
+    struct loader_file *file;
+    char c[64];
+
+    if (!loader_running)
+        return NULL;
+
+    while (read(loader_pipe[0], c, sizeof (c)) > 0)
+        ;
+
+    pthread_mutex_lock(&loader_mutex);
+    if ((file = loader_done))
+        loader_done = file->next;
+    pthread_mutex_unlock(&loader_mutex);
+
+    return file;
+}
+
+void loader_file_free(struct loader_file *file)
+{
+    if (file) {
+        free(file->path);
+        free(file->data);
+        free(file);
+    }
+}
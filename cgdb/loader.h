@@ -0,0 +1,106 @@
+#ifndef _LOADER_H_
+#define _LOADER_H_
+
+/* loader.h:
+ * ---------
+ *
+ * Reads source files in a thread of its own, so a file on a slow network
+ * filesystem doesn't stop cgdb from drawing or reading keys while it
+ * arrives. The files are read one at a time, in the order they were asked
+ * for, and handed back to the main loop once each is in memory.
+ *
+ */
+
+/* System Includes */
+#if HAVE_TIME_H
+#include <time.h>
+#endif /* HAVE_TIME_H */
+
+/* --------------- */
+/* Data Structures */
+/* --------------- */
+
+/* A file the loader is done with */
+struct loader_file {
+    char *path;                 /* The path it was asked for by */
+    char *data;                 /* Its contents, NULL if it couldn't be read */
+    size_t size;                /* The number of bytes in data */
+    time_t mtime;               /* Its timestamp when it was opened */
+    struct loader_file *next;
+};
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* loader_init:  Starts the thread that reads the files.
+ * ------------
+ *
+ * Return Value: 0 on success, -1 if files have to be read by the caller.
+ */
+int loader_init(void);
+
+/* loader_fd:  Gets the file descriptor that becomes readable when a file is
+ * ----------  done, and as a big one is read.
+ *
+ * Return Value: The file descriptor, or -1 if loader_init failed.
+ */
+int loader_fd(void);
+
+/* loader_request:  Asks for a file to be read.
+ * ---------------
+ *
+ * Asking for a file that's already waiting to be read, or being read,
+ * does nothing.
+ *
+ *   path:  The file, it's copied
+ *
+ * Return Value: 0 on success, -1 if there's no thread to read it.
+ */
+int loader_request(const char *path);
+
+/* loader_wait:  Waits a little for a file to be read.
+ * ------------
+ *
+ *   path:  The file
+ *   msec:  The most time to wait, in milliseconds
+ *
+ * Return Value: 1 if the file is done, 0 if it's still being read.
+ */
+int loader_wait(const char *path, int msec);
+
+/* loader_progress:  Finds out how far along a file is.
+ * ----------------
+ *
+ *   path:   The file
+ *   done:   Set to the bytes read so far
+ *   total:  Set to the size of the file, 0 until it's opened
+ *
+ * Return Value: 1 if the file is waiting to be read or being read,
+ *               0 otherwise.
+ */
+int loader_progress(const char *path, size_t *done, size_t *total);
+
+/* loader_busy:  Determines if there are files being read.
+ * ------------
+ *
+ * Return Value: 1 if there are, 0 if not.
+ */
+int loader_busy(void);
+
+/* loader_finish:  Takes a file that's done from the loader.
+ * --------------
+ *
+ * Call it until it returns NULL when loader_fd is readable.
+ *
+ * Return Value: The file, to be freed with loader_file_free, or NULL if
+ *               there are no more.
+ */
+struct loader_file *loader_finish(void);
+
+/* loader_file_free:  Frees a file loader_finish returned.
+ * -----------------
+ */
+void loader_file_free(struct loader_file *file);
+
+#endif /* _LOADER_H_ */
@@ -0,0 +1,266 @@
+/* logwin.c:
+ * ---------
+ *
+ * The lines are kept in a ring of LOGWIN_LINES, the oldest one is written
+ * over when it's full, in the memory it had. A line longer than
+ * LOGWIN_LINE_MAX is cut, so a flood of output never takes more memory
+ * than the ring. The rate is the lines that came in the last whole second.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_CURSES_H
+#include <curses.h>
+#elif HAVE_NCURSES_CURSES_H
+#include <ncurses/curses.h>
+#endif /* HAVE_CURSES_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif /* HAVE_SYS_TIME_H */
+
+/* Local Includes */
+#include "logwin.h"
+#include "cgdb.h"
+#include "sys_util.h"
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+#define LOGWIN_LINES 10000      /* The lines kept */
+#define LOGWIN_LINE_MAX 512     /* The bytes kept of a line */
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+/* The lines, the oldest one first at logwin_first */
+static char *logwin_lines[LOGWIN_LINES];
+static int logwin_first, logwin_count;
+
+/* The line that's still coming */
+static char logwin_partial[LOGWIN_LINE_MAX];
+static int logwin_partial_length;
+
+/* The lines that came, and the ones written over */
+static unsigned long logwin_total, logwin_dropped;
+
+/* The lines that came since logwin_second, and in the second before */
+static struct timeval logwin_second;
+static unsigned long logwin_this_second, logwin_rate;
+
+static WINDOW *logwin_win;
+static char **logwin_drawn;     /* The text on each line of logwin_win */
+static int logwin_height, logwin_width;
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* logwin_elapsed: The milliseconds since logwin_second.
+ * ---------------
+ */
+static long logwin_elapsed(const struct timeval *now)
+{
+    return (now->tv_sec - logwin_second.tv_sec) * 1000 +
+            (now->tv_usec - logwin_second.tv_usec) / 1000;
+}
+
+/* logwin_count_line: Counts a line for the rate.
+ * ------------------
+ */
+static void logwin_count_line(void)
+{
+    struct timeval now;
+    long elapsed;
+
+    gettimeofday(&now, NULL);
+    elapsed = logwin_elapsed(&now);
+
+    /* A second without lines is a rate of 0, the clock could be set back */
+    if (elapsed >= 1000 || elapsed < 0) {
+        logwin_rate = elapsed < 2000 && elapsed > 0 ?
+                logwin_this_second * 1000 / elapsed : 0;
+        logwin_this_second = 0;
+        logwin_second = now;
+    }
+
+    logwin_this_second++;
+}
+
+/* logwin_push: Adds the partial line to the ring.
+ * ------------
+ */
+static void logwin_push(void)
+{
+    int i;
+
+    if (logwin_count == LOGWIN_LINES) {
+        i = logwin_first;
+        logwin_first = (logwin_first + 1) % LOGWIN_LINES;
+        logwin_dropped++;
+    } else
+        i = (logwin_first + logwin_count++) % LOGWIN_LINES;
+
+    logwin_lines[i] = cgdb_realloc(logwin_lines[i],
+            logwin_partial_length + 1);
+    memcpy(logwin_lines[i], logwin_partial, logwin_partial_length);
+    logwin_lines[i][logwin_partial_length] = '\0';
+
+    logwin_partial_length = 0;
+    logwin_total++;
+    logwin_count_line();
+}
+
+/* logwin_line: Gets the text of a line of the window.
+ * ------------
+ *
+ * The first line tells how many lines came and how fast, the last lines
+ * that came are under it, the newest one at the bottom.
+ *
+ *   line:  The line, 0 is the first one
+ *   text:  Set to the text, it's cut to the width of the window
+ */
+static void logwin_line(int line, char *text, size_t size)
+{
+    int shown = logwin_count < logwin_height - 1 ?
+            logwin_count : logwin_height - 1;
+    int i = logwin_count - shown + line - 1;
+    unsigned long rate = logwin_rate;
+    struct timeval now;
+
+    if (size > (size_t) logwin_width + 1)
+        size = logwin_width + 1;
+    text[0] = '\0';
+
+    if (line == 0) {
+        /* Nothing came in the last second */
+        gettimeofday(&now, NULL);
+        if (logwin_elapsed(&now) >= 2000)
+            rate = 0;
+
+        snprintf(text, size, "Log: %lu lines, %lu/s, %lu dropped",
+                logwin_total, rate, logwin_dropped);
+        return;
+    }
+
+    if (i >= logwin_count)
+        return;
+
+    snprintf(text, size, "%s", logwin_lines[(logwin_first + i) % LOGWIN_LINES]);
+}
+
+/* logwin_forget_drawn: Forgets what's on the lines of the window.
+ * --------------------
+ */
+static void logwin_forget_drawn(void)
+{
+    int i;
+
+    for (i = 0; logwin_drawn && i < logwin_height; i++)
+        free(logwin_drawn[i]);
+    free(logwin_drawn);
+    logwin_drawn = NULL;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in logwin.h for function descriptions. */
+
+void logwin_move(int top, int left, int height, int width)
+{
+    logwin_close();
+
+    if ((logwin_win = newwin(height, width, top, left)) == NULL)
+        return;
+
+    logwin_height = height;
+    logwin_width = width;
+    logwin_drawn = cgdb_calloc(height, sizeof (char *));
+}
+
+void logwin_display(void)
+{
+    char text[MAXLINE];
+    int line;
+
+    if (!logwin_win)
+        return;
+
+    /* Only the lines that changed are drawn */
+    for (line = 0; line < logwin_height; line++) {
+        logwin_line(line, text, sizeof (text));
+
+        if (logwin_drawn[line] && strcmp(logwin_drawn[line], text) == 0)
+            continue;
+
+        wmove(logwin_win, line, 0);
+        waddstr(logwin_win, text);
+        wclrtoeol(logwin_win);
+
+        free(logwin_drawn[line]);
+        logwin_drawn[line] = cgdb_strdup(text);
+    }
+
+    wnoutrefresh(logwin_win);
+}
+
+void logwin_close(void)
+{
+    logwin_forget_drawn();
+
+    if (logwin_win)
+        delwin(logwin_win);
+    logwin_win = NULL;
+    logwin_height = logwin_width = 0;
+}
+
+int logwin_add(const char *text)
+{
+    int completed = 0;
+
+    for (; *text; text++) {
+        if (*text == '\n') {
+            logwin_push();
+            completed = 1;
+        } else if (*text != '\r' &&
+                logwin_partial_length < LOGWIN_LINE_MAX - 1)
+            logwin_partial[logwin_partial_length++] = *text;
+    }
+
+    return completed;
+}
+
+void logwin_clear(void)
+{
+    int i;
+
+    for (i = 0; i < LOGWIN_LINES; i++) {
+        free(logwin_lines[i]);
+        logwin_lines[i] = NULL;
+    }
+
+    logwin_first = logwin_count = 0;
+    logwin_partial_length = 0;
+    logwin_total = logwin_dropped = 0;
+    logwin_this_second = logwin_rate = 0;
+}
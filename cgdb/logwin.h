@@ -0,0 +1,54 @@
+#ifndef _LOGWIN_H_
+#define _LOGWIN_H_
+
+/* logwin.h:
+ * ---------
+ *
+ * The log window. It shows what gdb printed while the program ran, like
+ * the output of dprintf, apart from the gdb window. Only the last lines
+ * are kept, with how many came and how fast, and adding one doesn't draw
+ * anything, the window is drawn with the next frame.
+ *
+ */
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* logwin_move: Puts the log window somewhere else on the screen.
+ * ------------
+ *
+ *   top, left:      The position of its upper left corner
+ *   height, width:  Its size
+ */
+void logwin_move(int top, int left, int height, int width);
+
+/* logwin_display: Draws the lines that changed since the last time.
+ * ---------------
+ *
+ * The terminal isn't refreshed, only the curses virtual screen.
+ */
+void logwin_display(void);
+
+/* logwin_close: Takes the log window off the screen.
+ * -------------
+ *
+ * The lines are kept, they're shown again by logwin_move.
+ */
+void logwin_close(void);
+
+/* logwin_add: Adds text to the log.
+ * -----------
+ *
+ *   text:  The text, a line can be split between two calls
+ *
+ * Return Value: 1 if a line was completed, 0 otherwise.
+ */
+int logwin_add(const char *text);
+
+/* logwin_clear: Forgets the lines and how many came.
+ * -------------
+ */
+void logwin_clear(void);
+
+#endif /* _LOGWIN_H_ */
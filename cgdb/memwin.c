@@ -0,0 +1,602 @@
+/* memwin.c:
+ * ---------
+ *
+ * The memory is kept in pages of MEMORY_PAGE bytes, each one read with a
+ * request of its own. There are few pages, they're looked through one
+ * after the other, and the one used least recently makes room for a new
+ * one.
+ *
+ * Each stop of gdb is counted. A page was read at one of them, and it's
+ * read again once it's shown after another one. The bytes it had before
+ * are kept, when they were read at the stop before, to see which changed.
+ *
+ * gdb answers the requests in the order they were made, each with a
+ * TGDB_UPDATE_MEMORY. The requests waiting for an answer are kept in that
+ * order, with the page they're for.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_CURSES_H
+#include <curses.h>
+#elif HAVE_NCURSES_CURSES_H
+#include <ncurses/curses.h>
+#endif /* HAVE_CURSES_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_CTYPE_H
+#include <ctype.h>
+#endif /* HAVE_CTYPE_H */
+
+/* Local Includes */
+#include "memwin.h"
+#include "cgdb.h"
+#include "tgdb.h"
+#include "highlight_groups.h"
+#include "sys_util.h"
+#include "logger.h"
+
+extern struct tgdb *tgdb;
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The window is this wide once a row of 16 bytes fits, otherwise it's 8 */
+#define MEMORY_WIDE 79
+
+/* A page of memory */
+struct memwin_page {
+    unsigned long address;      /* The first byte, a multiple of MEMORY_PAGE */
+    unsigned char bytes[MEMORY_PAGE];
+    unsigned char readable[MEMORY_PAGE];    /* 1 for each byte gdb read */
+    unsigned char old[MEMORY_PAGE];     /* The bytes at the stop before */
+    unsigned char old_readable[MEMORY_PAGE];
+    int loaded;                 /* 1 once gdb answered for it */
+    int has_old;                /* 1 if old was read at the stop before */
+    unsigned long read_at;      /* The stop the bytes were read at */
+    unsigned long asked_at;     /* The stop it was last asked for at */
+    unsigned long used;         /* When it was last shown, for eviction */
+};
+
+/* A request waiting for gdb's answer */
+struct memwin_pending {
+    unsigned long address;      /* The page it's for */
+    unsigned long stop;         /* The stop it was made at */
+    int jump;                   /* 1 if it's for the address of memwin_goto */
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+static struct memwin_page *memwin_pages[MEMORY_PAGES];
+static int memwin_count;
+static unsigned long memwin_tick;
+
+/* The stops of gdb, counted from 1 so a page that wasn't asked for is 0 */
+static unsigned long memwin_stop = 1;
+
+static struct memwin_pending *memwin_pending;
+static int memwin_pending_head, memwin_pending_count, memwin_pending_size;
+
+/* 1 once memwin_goto found an address, and the first byte shown */
+static int memwin_shown;
+static unsigned long memwin_top;
+
+/* What the user asked to see, and why gdb couldn't show it */
+static char *memwin_expression;
+static char *memwin_error;
+
+static WINDOW *memwin_win;
+static char **memwin_drawn;     /* The text on each line of memwin_win */
+static int memwin_height, memwin_width;
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* memwin_row_bytes: Gets how many bytes a line shows.
+ * -----------------
+ */
+static int memwin_row_bytes(void)
+{
+    return memwin_width >= MEMORY_WIDE ? 16 : 8;
+}
+
+/* memwin_last: Gets the last byte the window shows.
+ * ------------
+ *
+ * The last line can go past the end of memory, it stops there.
+ */
+static unsigned long memwin_last(void)
+{
+    unsigned long length = (unsigned long) memwin_height * memwin_row_bytes();
+
+    if (length == 0)
+        return memwin_top;
+
+    return memwin_top + (length - 1) < memwin_top ? (unsigned long) -1 :
+            memwin_top + (length - 1);
+}
+
+/* memwin_request: Asks gdb for bytes of memory.
+ * ---------------
+ *
+ *   address:  The expression of the first byte
+ *   length:   How many to read
+ *   pending:  What the answer is for
+ */
+static void memwin_request(const char *address, int length,
+        struct memwin_pending pending)
+{
+    struct tgdb_request *request =
+            tgdb_request_read_memory(tgdb, address, length);
+
+    if (!request)
+        return;
+
+    /* The answer can come before handle_request returns */
+    if (memwin_pending_count == memwin_pending_size) {
+        memwin_pending_size =
+                memwin_pending_size ? memwin_pending_size * 2 : 16;
+        memwin_pending = cgdb_realloc(memwin_pending,
+                sizeof (struct memwin_pending) * memwin_pending_size);
+    }
+    memwin_pending[memwin_pending_count++] = pending;
+
+    handle_request(tgdb, request);
+}
+
+/* page_find: Finds the page a byte is in.
+ * ----------
+ *
+ * Return Value: The page, or NULL if it isn't kept.
+ */
+static struct memwin_page *page_find(unsigned long address)
+{
+    int i;
+
+    address -= address % MEMORY_PAGE;
+    for (i = 0; i < memwin_count; i++)
+        if (memwin_pages[i]->address == address)
+            return memwin_pages[i];
+
+    return NULL;
+}
+
+/* page_get: Finds the page a byte is in, or makes room for it.
+ * ---------
+ */
+static struct memwin_page *page_get(unsigned long address)
+{
+    struct memwin_page *page = page_find(address);
+    int i, lru = 0;
+
+    if (page)
+        return page;
+
+    /* The page shown least recently makes room */
+    if (memwin_count == MEMORY_PAGES) {
+        for (i = 1; i < memwin_count; i++)
+            if (memwin_pages[i]->used < memwin_pages[lru]->used)
+                lru = i;
+        page = memwin_pages[lru];
+        memwin_pages[lru] = memwin_pages[--memwin_count];
+        memset(page, 0, sizeof (struct memwin_page));
+    } else
+        page = cgdb_calloc(1, sizeof (struct memwin_page));
+
+    page->address = address - address % MEMORY_PAGE;
+    page->used = ++memwin_tick;
+    memwin_pages[memwin_count++] = page;
+
+    return page;
+}
+
+/* page_request: Asks gdb for a page, unless it was since the last stop.
+ * -------------
+ */
+static void page_request(struct memwin_page *page)
+{
+    struct memwin_pending pending;
+    char address[32];
+
+    if (page->asked_at == memwin_stop)
+        return;
+    page->asked_at = memwin_stop;
+
+    pending.address = page->address;
+    pending.stop = memwin_stop;
+    pending.jump = 0;
+
+    snprintf(address, sizeof (address), "0x%lx", page->address);
+    memwin_request(address, MEMORY_PAGE, pending);
+}
+
+/* memwin_request_shown: Asks gdb for the pages the window shows.
+ * ---------------------
+ */
+static void memwin_request_shown(void)
+{
+    unsigned long address = memwin_top - memwin_top % MEMORY_PAGE;
+    unsigned long last = memwin_last();
+
+    if (!memwin_win || !memwin_shown)
+        return;
+
+    for (;; address += MEMORY_PAGE) {
+        page_request(page_get(address));
+        if (last - address < MEMORY_PAGE)
+            break;
+    }
+}
+
+/* memwin_neighbor: Finds a page next to the ones shown, to read ahead.
+ * ----------------
+ *
+ *   address:  Set to the address of the page
+ *
+ * Return Value: 1 if there's one, 0 if both were asked for since the stop.
+ */
+static int memwin_neighbor(unsigned long *address)
+{
+    unsigned long first = memwin_top - memwin_top % MEMORY_PAGE;
+    unsigned long after = memwin_last() - memwin_last() % MEMORY_PAGE +
+            MEMORY_PAGE;
+    struct memwin_page *page;
+
+    /* The one after is at the end of memory */
+    if (after != 0) {
+        page = page_find(after);
+        if (!page || page->asked_at != memwin_stop) {
+            *address = after;
+            return 1;
+        }
+    }
+
+    if (first >= MEMORY_PAGE) {
+        page = page_find(first - MEMORY_PAGE);
+        if (!page || page->asked_at != memwin_stop) {
+            *address = first - MEMORY_PAGE;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* memwin_line: Gets the text of a line of the window.
+ * ------------
+ *
+ * A line is the address, the bytes in hex, and the bytes as characters.
+ *
+ *   line:     The line, 0 is the first one
+ *   text:     Set to the text, it's cut to the width of the window
+ *   changed:  Set to 1 for each character of text that's highlighted
+ */
+static void memwin_line(int line, char *text, char *changed, size_t size)
+{
+    int bytes = memwin_row_bytes(), i, length, ascii;
+    unsigned long address = memwin_top + (unsigned long) line * bytes;
+    struct memwin_page *page = NULL;
+
+    if (size > (size_t) memwin_width + 1)
+        size = memwin_width + 1;
+    memset(changed, 0, size);
+    text[0] = '\0';
+
+    if (!memwin_shown) {
+        if (line == 0)
+            snprintf(text, size, "%s", memwin_error ? memwin_error :
+                    "No address, :memory EXPR shows one");
+        return;
+    }
+
+    /* Past the end of memory */
+    if (address < memwin_top || (line > 0 && address == 0))
+        return;
+
+    length = snprintf(text, size, "%012lx:", address);
+    ascii = length + bytes * 3 + 2;
+
+    for (i = 0; i < bytes && (size_t) length < size; i++) {
+        int offset = (int) ((address + i) % MEMORY_PAGE);
+
+        if (i == 0 || offset == 0) {
+            if ((page = page_find(address + i)))
+                page->used = ++memwin_tick;
+        }
+
+        if (!page || !page->loaded)
+            snprintf(text + length, size - length, "   ");
+        else if (!page->readable[offset])
+            snprintf(text + length, size - length, " ??");
+        else
+            snprintf(text + length, size - length, " %02x",
+                    page->bytes[offset]);
+
+        /* The bytes are compared once they're read at this stop */
+        if (page && page->loaded && page->read_at == memwin_stop &&
+                page->has_old && page->readable[offset] &&
+                page->old_readable[offset] &&
+                page->old[offset] != page->bytes[offset]) {
+            if ((size_t) length + 2 < size)
+                changed[length + 1] = changed[length + 2] = 1;
+            if ((size_t) ascii + i < size)
+                changed[ascii + i] = 1;
+        }
+        length += 3;
+
+        if ((size_t) ascii + i + 1 < size) {
+            if (!page || !page->loaded || !page->readable[offset])
+                text[ascii + i] = ' ';
+            else
+                text[ascii + i] = isprint(page->bytes[offset]) ?
+                        page->bytes[offset] : '.';
+        }
+    }
+
+    /* The gap between the hex and the characters */
+    if ((size_t) ascii + bytes + 1 <= size) {
+        text[length] = text[length + 1] = ' ';
+        text[ascii + bytes] = '\0';
+    } else if ((size_t) length < size) {
+        for (; (size_t) length + 1 < size && length < ascii; length++)
+            text[length] = ' ';
+        text[size - 1] = '\0';
+    }
+
+    /* The highlight is only where there's text */
+    for (i = strlen(text); (size_t) i < size; i++)
+        changed[i] = 0;
+}
+
+/* memwin_forget_drawn: Forgets what's on the lines of the window.
+ * --------------------
+ */
+static void memwin_forget_drawn(void)
+{
+    int i;
+
+    for (i = 0; memwin_drawn && i < memwin_height; i++)
+        free(memwin_drawn[i]);
+    free(memwin_drawn);
+    memwin_drawn = NULL;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in memwin.h for function descriptions. */
+
+void memwin_move(int top, int left, int height, int width)
+{
+    memwin_close();
+
+    if ((memwin_win = newwin(height, width, top, left)) == NULL)
+        return;
+
+    memwin_height = height;
+    memwin_width = width;
+    memwin_drawn = cgdb_calloc(height, sizeof (char *));
+
+    memwin_request_shown();
+}
+
+void memwin_display(void)
+{
+    char text[MAXLINE], changed[MAXLINE], drawn[MAXLINE * 2 + 1];
+    int line, i, attr = A_BOLD, on;
+
+    if (!memwin_win)
+        return;
+
+    hl_groups_get_attr(hl_groups_instance, HLG_CHANGED, &attr);
+
+    /* Only the lines that changed are drawn, the highlight is part of it */
+    for (line = 0; line < memwin_height; line++) {
+        memwin_line(line, text, changed, sizeof (text));
+        for (i = 0; text[i]; i++)
+            drawn[i] = changed[i] ? '1' : '0';
+        drawn[i] = '\0';
+        snprintf(drawn + i, sizeof (drawn) - i, "%s", text);
+
+        if (memwin_drawn[line] && strcmp(memwin_drawn[line], drawn) == 0)
+            continue;
+
+        wmove(memwin_win, line, 0);
+        for (i = 0, on = 0; text[i]; i++) {
+            if (changed[i] != on) {
+                on = changed[i];
+                if (on)
+                    wattron(memwin_win, attr);
+                else
+                    wattroff(memwin_win, attr);
+            }
+            waddch(memwin_win, (unsigned char) text[i]);
+        }
+        if (on)
+            wattroff(memwin_win, attr);
+        wclrtoeol(memwin_win);
+
+        free(memwin_drawn[line]);
+        memwin_drawn[line] = cgdb_strdup(drawn);
+    }
+
+    wnoutrefresh(memwin_win);
+}
+
+void memwin_close(void)
+{
+    memwin_forget_drawn();
+
+    if (memwin_win)
+        delwin(memwin_win);
+    memwin_win = NULL;
+    memwin_height = memwin_width = 0;
+}
+
+int memwin_goto(const char *expression)
+{
+    struct memwin_pending pending;
+
+    while (isspace((unsigned char) *expression))
+        expression++;
+    if (*expression == '\0')
+        return -1;
+
+    free(memwin_expression);
+    memwin_expression = cgdb_strdup(expression);
+
+    /* The answer has the address the expression is at */
+    pending.address = 0;
+    pending.stop = memwin_stop;
+    pending.jump = 1;
+    memwin_request(memwin_expression, 1, pending);
+
+    return 0;
+}
+
+int memwin_scroll(int pages)
+{
+    unsigned long distance;
+
+    if (!memwin_shown)
+        return -1;
+
+    distance = (unsigned long) (pages < 0 ? -pages : pages) *
+            (memwin_height > 1 ? memwin_height - 1 : 1) * memwin_row_bytes();
+
+    if (pages < 0)
+        memwin_top = memwin_top > distance ? memwin_top - distance : 0;
+    else if (memwin_top + distance > memwin_top)
+        memwin_top += distance;
+
+    memwin_request_shown();
+
+    return 0;
+}
+
+void memwin_stopped(void)
+{
+    int i;
+
+    /* The bytes read at this stop are the ones the next one is seen by */
+    for (i = 0; i < memwin_count; i++) {
+        struct memwin_page *page = memwin_pages[i];
+
+        page->has_old = page->loaded && page->read_at == memwin_stop;
+        if (page->has_old) {
+            memcpy(page->old, page->bytes, MEMORY_PAGE);
+            memcpy(page->old_readable, page->readable, MEMORY_PAGE);
+        }
+    }
+
+    memwin_stop++;
+    memwin_request_shown();
+}
+
+int memwin_update(const struct tgdb_memory *memory)
+{
+    struct memwin_pending pending;
+    struct memwin_page *page;
+    char error[MAXLINE];
+    int length, i;
+
+    if (memwin_pending_head == memwin_pending_count) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "memory answer without a request");
+        return 0;
+    }
+
+    pending = memwin_pending[memwin_pending_head++];
+    if (memwin_pending_head == memwin_pending_count)
+        memwin_pending_head = memwin_pending_count = 0;
+
+    if (pending.jump) {
+        /* The user asked for another address before the answer came */
+        for (i = memwin_pending_head; i < memwin_pending_count; i++)
+            if (memwin_pending[i].jump)
+                return 0;
+
+        if (memory->length < 1 || !memory->readable[0]) {
+            snprintf(error, sizeof (error), "%s: %s", memwin_expression,
+                    memory->error ? memory->error : "can't be read");
+            free(memwin_error);
+            memwin_error = cgdb_strdup(error);
+            memwin_shown = 0;
+            return 1;
+        }
+
+        free(memwin_error);
+        memwin_error = NULL;
+        memwin_shown = 1;
+        memwin_top = memory->address - memory->address % 16;
+        memwin_request_shown();
+        return 1;
+    }
+
+    /* It made room for another one while gdb was reading it */
+    if (!(page = page_find(pending.address)))
+        return 0;
+
+    length = memory->length < MEMORY_PAGE ? memory->length : MEMORY_PAGE;
+    memset(page->bytes, 0, MEMORY_PAGE);
+    memset(page->readable, 0, MEMORY_PAGE);
+    memcpy(page->bytes, memory->bytes, length);
+    memcpy(page->readable, memory->readable, length);
+    page->loaded = 1;
+    page->read_at = pending.stop;
+
+    return memwin_shown && page->address <= memwin_last() &&
+            page->address + (MEMORY_PAGE - 1) >= memwin_top;
+}
+
+int memwin_prefetch_pending(void)
+{
+    unsigned long address;
+    int busy = 1;
+
+    /* One at a time, and only while gdb has nothing else to do */
+    if (!memwin_win || !memwin_shown || memwin_pending_count > 0)
+        return 0;
+
+    if (tgdb_is_busy(tgdb, &busy) == -1 || busy)
+        return 0;
+
+    return memwin_neighbor(&address);
+}
+
+void memwin_prefetch_next(void)
+{
+    unsigned long address;
+
+    if (memwin_neighbor(&address))
+        page_request(page_get(address));
+}
+
+void memwin_clear(void)
+{
+    int i;
+
+    for (i = 0; i < memwin_count; i++)
+        free(memwin_pages[i]);
+    memwin_count = 0;
+}
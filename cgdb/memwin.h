@@ -0,0 +1,105 @@
+#ifndef _MEMWIN_H_
+#define _MEMWIN_H_
+
+/* memwin.h:
+ * ---------
+ *
+ * The memory window. It shows bytes of the memory of the program, in hex
+ * and as characters, from an address the user picks. gdb is only asked
+ * for the pages the window shows, and for the ones next to them while
+ * nothing else is going on, so a big buffer can be looked through without
+ * reading all of it.
+ *
+ * Each page keeps the bytes it had when gdb stopped the time before, and
+ * the bytes that changed since are highlighted.
+ *
+ */
+
+/* The bytes gdb is asked for at a time, the pages start at multiples */
+#define MEMORY_PAGE 256
+
+/* The most pages kept */
+#define MEMORY_PAGES 64
+
+struct tgdb_memory;
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* memwin_move: Puts the memory window somewhere else on the screen.
+ * ------------
+ *
+ *   top, left:      The position of its upper left corner
+ *   height, width:  Its size
+ */
+void memwin_move(int top, int left, int height, int width);
+
+/* memwin_display: Draws the lines that changed since the last time.
+ * ---------------
+ *
+ * The terminal isn't refreshed, only the curses virtual screen.
+ */
+void memwin_display(void);
+
+/* memwin_close: Takes the memory window off the screen.
+ * -------------
+ *
+ * The pages are kept, they're shown again by memwin_move.
+ */
+void memwin_close(void);
+
+/* memwin_goto: Shows the memory at an address.
+ * ------------
+ *
+ *   expression:  An expression gdb works the address out of
+ *
+ * Return Value: 0 on success, -1 if the expression is empty.
+ */
+int memwin_goto(const char *expression);
+
+/* memwin_scroll: Shows the memory a window further on or back.
+ * --------------
+ *
+ *   pages:  How many windows full, negative to go back
+ *
+ * Return Value: 0 on success, -1 if no address is shown.
+ */
+int memwin_scroll(int pages);
+
+/* memwin_stopped: Reads the memory shown again, after gdb stopped.
+ * ---------------
+ */
+void memwin_stopped(void);
+
+/* memwin_update: Takes the answer to a request for memory.
+ * --------------
+ *
+ *   memory:  What gdb read
+ *
+ * Return Value: 1 if what's shown changed, 0 otherwise.
+ */
+int memwin_update(const struct tgdb_memory *memory);
+
+/* memwin_prefetch_pending: Determines if there's a page to read ahead.
+ * ------------------------
+ *
+ * It's one next to the ones shown, and gdb isn't reading anything else.
+ *
+ * Return Value: 1 if memwin_prefetch_next should be called, 0 otherwise.
+ */
+int memwin_prefetch_pending(void);
+
+/* memwin_prefetch_next: Asks gdb for the next page to read ahead.
+ * ---------------------
+ */
+void memwin_prefetch_next(void);
+
+/* memwin_clear: Forgets the pages, when the program exits.
+ * -------------
+ *
+ * The address shown is kept, for the next time it runs.
+ */
+void memwin_clear(void);
+
+#endif /* _MEMWIN_H_ */
@@ -0,0 +1,416 @@
+/* profile.c:
+ * ----------
+ *
+ * A sample is taken by tgdb_sample, on a timer. Taking one costs a few
+ * round trips to gdb while the program is stopped, so a sample that's still
+ * being taken when the timer goes off again is let be, and that tick is
+ * skipped: the rate is what's asked for at most.
+ *
+ * The lines and the functions are counted in hash tables. The heat is only
+ * worked out again from the lines every PROFILE_HEAT_MS, a sample doesn't
+ * redraw the source window by itself.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+/* Local Includes */
+#include "profile.h"
+#include "interface.h"
+#include "sources.h"
+#include "cgdbrc.h"
+#include "tgdb.h"
+#include "event_loop.h"
+#include "std_ohash.h"
+#include "sys_util.h"
+
+extern struct tgdb *tgdb;
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+#define PROFILE_DEPTH 64        /* The frames a sample lists */
+#define PROFILE_HEAT_MS 250     /* How often the heat is shown again */
+#define PROFILE_REPORTED 10     /* The functions and lines profile_report prints */
+
+/* A line the program was seen in */
+struct profile_line {
+    char *path;                 /* The relative path to the file */
+    int line;                   /* The line number */
+    unsigned long hits;         /* The samples it was in */
+};
+
+/* A function the program was seen in, or in a function it called */
+struct profile_function {
+    char *name;
+    unsigned long self;         /* The samples it was the innermost in */
+    unsigned long total;        /* The samples it was on the stack in */
+    unsigned long seen;         /* The last sample it was counted for */
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+/* The lines, keyed by "LINE:PATH", and the functions, keyed by name */
+static struct std_ohashtable *profile_lines;
+static struct std_ohashtable *profile_functions;
+
+static unsigned long profile_samples;   /* The samples counted */
+static int profile_on;
+
+static int profile_timer = -1;  /* Takes the next sample */
+static int profile_heat_timer = -1;     /* Shows the heat of new samples */
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+static int profile_line_free(void *item)
+{
+    struct profile_line *line = (struct profile_line *) item;
+
+    free(line->path);
+    free(line);
+    return 0;
+}
+
+static int profile_function_free(void *item)
+{
+    struct profile_function *function = (struct profile_function *) item;
+
+    free(function->name);
+    free(function);
+    return 0;
+}
+
+static int profile_key_free(void *item)
+{
+    free(item);
+    return 0;
+}
+
+/* profile_tables: Makes the tables, the first time they're needed.
+ * ---------------
+ */
+static void profile_tables(void)
+{
+    if (profile_lines)
+        return;
+
+    profile_lines = std_ohash_table_new_full(std_str_hash, std_str_equal,
+            profile_key_free, profile_line_free);
+
+    /* The key is the name the function holds */
+    profile_functions = std_ohash_table_new_full(std_str_hash, std_str_equal,
+            NULL, profile_function_free);
+}
+
+/* profile_function: Gets a function, it's added if it wasn't seen before.
+ * -----------------
+ */
+static struct profile_function *profile_function(const char *name)
+{
+    struct profile_function *function =
+            std_ohash_table_lookup(profile_functions, name);
+
+    if (function)
+        return function;
+
+    function = cgdb_calloc(1, sizeof (struct profile_function));
+    function->name = cgdb_strdup(name);
+    std_ohash_table_insert(profile_functions, function->name, function);
+
+    return function;
+}
+
+/* profile_hit: Counts a sample in a line.
+ * ------------
+ */
+static void profile_hit(const char *path, int number)
+{
+    struct profile_line *line;
+    char *key;
+    size_t size = strlen(path) + 16;
+
+    key = cgdb_malloc(size);
+    snprintf(key, size, "%d:%s", number, path);
+
+    if ((line = std_ohash_table_lookup(profile_lines, key)) == NULL) {
+        line = cgdb_calloc(1, sizeof (struct profile_line));
+        line->path = cgdb_strdup(path);
+        line->line = number;
+        std_ohash_table_insert(profile_lines, key, line);
+    } else
+        free(key);
+
+    line->hits++;
+}
+
+/* The lines and the functions, gathered from a table to be sorted */
+struct profile_gather {
+    void **items;
+    int count;
+};
+
+static void profile_gather_item(void *key, void *value, void *user_data)
+{
+    struct profile_gather *gather = (struct profile_gather *) user_data;
+
+    gather->items[gather->count++] = value;
+}
+
+/* profile_gather: Gets the values of a table in an array.
+ * ---------------
+ *
+ * Return Value: The array, the caller frees it. count is set to its length.
+ */
+static void **profile_gather(struct std_ohashtable *table, int *count)
+{
+    struct profile_gather gather;
+
+    gather.items = cgdb_malloc(sizeof (void *) *
+            (std_ohash_table_size(table) + 1));
+    gather.count = 0;
+    std_ohash_table_foreach(table, profile_gather_item, &gather);
+
+    *count = gather.count;
+    return gather.items;
+}
+
+/* The lines seen the most first */
+static int profile_line_compare(const void *left, const void *right)
+{
+    const struct profile_line *l = *(const struct profile_line **) left;
+    const struct profile_line *r = *(const struct profile_line **) right;
+    int ret;
+
+    if (l->hits != r->hits)
+        return l->hits < r->hits ? 1 : -1;
+
+    if ((ret = strcmp(l->path, r->path)) != 0)
+        return ret;
+
+    return l->line - r->line;
+}
+
+/* The functions the program was in the most first, then the ones it was
+ * under the most */
+static int profile_function_compare(const void *left, const void *right)
+{
+    const struct profile_function *l =
+            *(const struct profile_function **) left;
+    const struct profile_function *r =
+            *(const struct profile_function **) right;
+
+    if (l->self != r->self)
+        return l->self < r->self ? 1 : -1;
+
+    if (l->total != r->total)
+        return l->total < r->total ? 1 : -1;
+
+    return strcmp(l->name, r->name);
+}
+
+/* profile_show_heat: Gives the source window the heat of the lines.
+ * ------------------
+ *
+ * A line is hot if it was seen at least half as often as the line seen
+ * the most, warm if it was seen an eighth as often, and cool otherwise.
+ */
+static void profile_show_heat(void)
+{
+    struct profile_line **lines;
+    struct source_heat *heat;
+    unsigned long most = 0;
+    int count = 0, i;
+
+    if (profile_lines) {
+        lines = (struct profile_line **) profile_gather(profile_lines,
+                &count);
+        for (i = 0; i < count; i++)
+            if (lines[i]->hits > most)
+                most = lines[i]->hits;
+    } else
+        lines = NULL;
+
+    heat = cgdb_malloc(sizeof (struct source_heat) * (count + 1));
+    for (i = 0; i < count; i++) {
+        heat[i].path = lines[i]->path;
+        heat[i].line = lines[i]->line;
+        if (lines[i]->hits * 2 >= most)
+            heat[i].level = 3;
+        else if (lines[i]->hits * 8 >= most)
+            heat[i].level = 2;
+        else
+            heat[i].level = 1;
+    }
+
+    if (source_update_heat(if_get_sview(), heat, count))
+        if_draw();
+
+    free(heat);
+    free(lines);
+}
+
+static void profile_heat_due(void *context)
+{
+    profile_heat_timer = -1;
+    profile_show_heat();
+}
+
+/* profile_due: Takes a sample, and waits for the next one.
+ * ------------
+ *
+ * Nothing is taken while the program is stopped, or while the sample
+ * before is being taken.
+ */
+static void profile_due(void *context)
+{
+    int rate = cgdbrc_get(CGDBRC_PROFILERATE)->variant.int_val;
+
+    if (rate < 1)
+        rate = 1;
+    else if (rate > 1000)
+        rate = 1000;
+
+    tgdb_sample(tgdb, PROFILE_DEPTH);
+
+    profile_timer = event_loop_add_timer(1000 / rate, profile_due, NULL);
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in profile.h for function descriptions. */
+
+void profile_start(void)
+{
+    if (profile_on)
+        return;
+
+    profile_tables();
+    profile_on = 1;
+    profile_due(NULL);
+}
+
+void profile_stop(void)
+{
+    profile_on = 0;
+    event_loop_remove_timer(profile_timer);
+    profile_timer = -1;
+}
+
+void profile_clear(void)
+{
+    if (profile_lines) {
+        std_ohash_table_destroy(profile_lines);
+        std_ohash_table_destroy(profile_functions);
+        profile_lines = profile_functions = NULL;
+    }
+    profile_samples = 0;
+
+    event_loop_remove_timer(profile_heat_timer);
+    profile_heat_timer = -1;
+    profile_show_heat();
+
+    if (profile_on)
+        profile_tables();
+}
+
+int profile_is_on(void)
+{
+    return profile_on;
+}
+
+void profile_sample(const struct tgdb_frames *frames)
+{
+    const struct tgdb_frame *frame;
+    struct profile_function *function;
+    int i;
+
+    /* One that was being taken when the profiler was stopped */
+    if (!profile_on || frames->error || frames->count == 0)
+        return;
+
+    profile_samples++;
+
+    /* A function that recursed is counted once for the sample */
+    for (i = 0; i < frames->count; i++) {
+        frame = &frames->frames[i];
+        function = profile_function(frame->function ? frame->function : "??");
+        if (i == 0)
+            function->self++;
+        if (function->seen != profile_samples) {
+            function->seen = profile_samples;
+            function->total++;
+        }
+    }
+
+    frame = &frames->frames[0];
+    if (frame->relative_path && frame->line_number > 0)
+        profile_hit(frame->relative_path, frame->line_number);
+
+    if (profile_heat_timer == -1)
+        profile_heat_timer = event_loop_add_timer(PROFILE_HEAT_MS,
+                profile_heat_due, NULL);
+}
+
+void profile_report(void)
+{
+    struct profile_function **functions;
+    struct profile_line **lines;
+    char text[MAXLINE];
+    int count, i;
+
+    if (profile_samples == 0) {
+        if_print(profile_on ? "\nNo samples yet, the program isn't running.\n"
+                : "\nNo samples, :profile start takes them.\n");
+        return;
+    }
+
+    snprintf(text, sizeof (text), "\n%lu samples, the profiler is %s\n"
+            "  Self  Total  Function\n", profile_samples,
+            profile_on ? "on" : "off");
+    if_print(text);
+
+    functions = (struct profile_function **)
+            profile_gather(profile_functions, &count);
+    qsort(functions, count, sizeof (void *), profile_function_compare);
+    for (i = 0; i < count && i < PROFILE_REPORTED; i++) {
+        snprintf(text, sizeof (text), "%5.1f%% %5.1f%%  %s\n",
+                100.0 * functions[i]->self / profile_samples,
+                100.0 * functions[i]->total / profile_samples,
+                functions[i]->name);
+        if_print(text);
+    }
+    free(functions);
+
+    if_print("  Self  Line\n");
+    lines = (struct profile_line **) profile_gather(profile_lines, &count);
+    qsort(lines, count, sizeof (void *), profile_line_compare);
+    for (i = 0; i < count && i < PROFILE_REPORTED; i++) {
+        snprintf(text, sizeof (text), "%5.1f%%  %s:%d\n",
+                100.0 * lines[i]->hits / profile_samples, lines[i]->path,
+                lines[i]->line);
+        if_print(text);
+    }
+    free(lines);
+}
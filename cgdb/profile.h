@@ -0,0 +1,66 @@
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+
+/* profile.h:
+ * ----------
+ *
+ * The sampling profiler. While it's on, the running program is interrupted
+ * profilerate times a second, and where it is is counted: the line and the
+ * function it's in, and the functions that called it. The program is
+ * continued right away, before any command that waits for it to stop. The
+ * lines it was seen in the most are shown with the ProfileHot group in the
+ * source window, the others with ProfileWarm and ProfileCool.
+ *
+ * It needs GDB/MI.
+ *
+ */
+
+struct tgdb_frames;
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* profile_start: Starts taking samples, when the program runs.
+ * --------------
+ *
+ * The samples taken before are kept, profile_clear forgets them.
+ */
+void profile_start(void);
+
+/* profile_stop: Stops taking samples.
+ * -------------
+ *
+ * The lines stay shown with their heat until profile_clear.
+ */
+void profile_stop(void);
+
+/* profile_clear: Forgets the samples, and takes the heat off the lines.
+ * --------------
+ */
+void profile_clear(void);
+
+/* profile_is_on: Determines if samples are being taken.
+ * --------------
+ *
+ * Return Value: 1 if they are, 0 otherwise.
+ */
+int profile_is_on(void);
+
+/* profile_sample: Counts a sample of the running program.
+ * ---------------
+ *
+ * The heat of the lines is shown again a little later, not for each sample.
+ *
+ *   frames:  The innermost frames of the program, from a TGDB_UPDATE_SAMPLE
+ */
+void profile_sample(const struct tgdb_frames *frames);
+
+/* profile_report: Prints the functions and the lines seen the most.
+ * ---------------
+ *
+ * It goes to the GDB window.
+ */
+void profile_report(void);
+
+#endif /* _PROFILE_H_ */
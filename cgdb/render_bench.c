@@ -0,0 +1,401 @@
+/* render_bench.c:
+ * ---------------
+ *
+ * Measures how fast the source viewer and the gdb window draw, and how
+ * much they write to the terminal doing it. Unlike hl_bench, it doesn't
+ * need a terminal of its own. curses draws to a file, as if it was a
+ * terminal of the type given, and the file's size is how much was written.
+ *
+ * Each of these draws the number of frames given, each one a repetition
+ * of the benchmark harness,
+ *
+ *   scroll      the selected line moves down FILE, as if 'j' was held
+ *   exe_line    the line gdb is stopped at moves down FILE, as if the user
+ *               was stepping
+ *   hscroll     the view moves right and back over lines four times as
+ *               long as FILE's
+ *   scroller    lines of colored output are added to the gdb window
+ *
+ * A line of JSON is written for each, with frames/s and the bytes written
+ * per frame.
+ *
+ * Usage: render_bench [-t TERM] [-s COLSxLINES] [-n FRAMES] FILE
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STDARG_H
+#include <stdarg.h>
+#endif /* HAVE_STDARG_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#ifdef HAVE_SYS_SELECT_H
+#include <sys/select.h>
+#endif /* HAVE_SYS_SELECT_H */
+
+#if HAVE_CURSES_H
+#include <curses.h>
+#elif HAVE_NCURSES_CURSES_H
+#include <ncurses/curses.h>
+#endif /* HAVE_CURSES_H */
+
+/* Local Includes */
+#include "sources.h"
+#include "scroller.h"
+#include "highlight.h"
+#include "highlight_groups.h"
+#include "cgdbrc.h"
+#include "interface.h"
+#include "bench.h"
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+/* The options the windows ask for, with cgdb's default values */
+static struct cgdbrc_config_option options[CGDBRC_WRAPSCAN + 1];
+
+/* The options the windows draw with, with ansicodes on */
+static const struct cgdbrc_snapshot config = { 1, 0, ARROWSTYLE_SHORT, 8 };
+
+/* What curses draws to */
+static FILE *screen_file;
+
+/* The frames each benchmark draws */
+static int repetitions = 500;
+
+/* ------------------------------------ */
+/* What the windows need from the rest */
+/* ------------------------------------ */
+
+cgdbrc_config_option_ptr cgdbrc_get(enum cgdbrc_option_kind option)
+{
+    return &options[option];
+}
+
+void if_print_message(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+}
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* written: The bytes curses wrote to the terminal since the last call. */
+static long written(void)
+{
+    long size;
+
+    fflush(screen_file);
+    size = (long) lseek(fileno(screen_file), 0, SEEK_CUR);
+
+    /* Start over, so the file doesn't grow */
+    ftruncate(fileno(screen_file), 0);
+    lseek(fileno(screen_file), 0, SEEK_SET);
+
+    return size;
+}
+
+static int init_curses(const char *term, const char *size)
+{
+    int cols, lines;
+    char value[32];
+    FILE *input;
+
+    /* curses takes the size from the environment, the file has none */
+    if (sscanf(size, "%dx%d", &cols, &lines) != 2 || cols <= 0 || lines <= 0)
+        return -1;
+    snprintf(value, sizeof (value), "%d", cols);
+    setenv("COLUMNS", value, 1);
+    snprintf(value, sizeof (value), "%d", lines);
+    setenv("LINES", value, 1);
+
+    screen_file = tmpfile();
+    input = fopen("/dev/null", "r");
+    if (!screen_file || !input)
+        return -1;
+
+    if (!newterm((char *) term, screen_file, input))
+        return -1;
+    cbreak();
+    noecho();
+
+    if (has_colors()) {
+        start_color();
+#ifdef NCURSES_VERSION
+        use_default_colors();
+#endif
+    }
+
+    hl_groups_instance = hl_groups_initialize();
+    if (!hl_groups_instance || hl_groups_setup(hl_groups_instance) == -1)
+        return -1;
+
+    return 0;
+}
+
+/* load: Loads and highlights path, and waits for the highlighting. */
+static int load(struct sviewer *sview, const char *path)
+{
+    if (source_set_exec_line(sview, path, 1) ||
+            source_length(sview, path) <= 0)
+        return -1;
+
+    source_display(sview, 1, WIN_REFRESH, &config);
+    while (highlight_busy()) {
+        fd_set rset;
+
+        FD_ZERO(&rset);
+        FD_SET(highlight_fd(), &rset);
+        select(highlight_fd() + 1, &rset, NULL, NULL, NULL);
+        source_highlighted(sview);
+    }
+    source_display(sview, 1, WIN_REFRESH, &config);
+
+    return 0;
+}
+
+/* long_lines: Writes a copy of path with each line four times as long, to
+ * a temporary file with the same extension, so it's highlighted the same.
+ * Returns the temporary file's path, or NULL on error. */
+static char *long_lines(const char *path)
+{
+    static char copy[256];
+    const char *ext = strrchr(path, '.');
+    char line[1024];
+    FILE *in, *out;
+    size_t n;
+
+    snprintf(copy, sizeof (copy), "/tmp/render_bench.%ld%s", (long) getpid(),
+            ext ? ext : "");
+
+    in = fopen(path, "r");
+    out = fopen(copy, "w");
+    if (!in || !out) {
+        if (in)
+            fclose(in);
+        if (out)
+            fclose(out);
+        return NULL;
+    }
+
+    while (fgets(line, sizeof (line), in)) {
+        n = strcspn(line, "\n");
+        line[n] = '\0';
+        fprintf(out, "%s    %s    %s    %s\n", line, line, line, line);
+    }
+
+    fclose(in);
+    fclose(out);
+
+    return copy;
+}
+
+/* What a benchmark draws, a frame at a time */
+struct render {
+    struct sviewer *sview;
+    struct scroller *scr;
+    int length;                 /* The lines of the file */
+    int frames;                 /* Drawn so far */
+    int line, col, step;
+};
+
+/* run_render: Runs a benchmark, and writes its line of JSON. */
+static void run_render(const char *name, int (*frame) (void *context),
+        struct render *render)
+{
+    struct bench bench;
+    long bytes;
+
+    bench_init(&bench, "render", repetitions, "%s %dx%d %s", name, COLS,
+            LINES, termname());
+    render->frames = 0;
+    written();
+
+    if (bench_run(&bench, frame, render) == -1)
+        return;
+
+    /* The warmups wrote as much as the others */
+    bytes = written();
+    bench_print(&bench, "\"frames_per_s\": %.1f, \"bytes_per_frame\": %.1f",
+            1e9 / (bench.wall_median ? bench.wall_median : 1),
+            render->frames ? (double) bytes / render->frames : 0);
+}
+
+static int frame_scroll(void *context)
+{
+    struct render *render = (struct render *) context;
+
+    source_vscroll(render->sview, 1);
+    if (render->frames % render->length == render->length - 1)
+        source_set_sel_line(render->sview, 1);
+    source_display(render->sview, 1, WIN_REFRESH, &config);
+    render->frames++;
+
+    return 0;
+}
+
+static int frame_exe_line(void *context)
+{
+    struct render *render = (struct render *) context;
+
+    source_set_exec_line(render->sview, NULL, render->line);
+    source_display(render->sview, 1, WIN_REFRESH, &config);
+    render->frames++;
+
+    if (++render->line > render->length)
+        render->line = 1;
+
+    return 0;
+}
+
+static int frame_hscroll(void *context)
+{
+    struct render *render = (struct render *) context;
+
+    source_hscroll(render->sview, render->step);
+    render->col += render->step;
+    if (render->col == 0 || render->col == COLS * 2)
+        render->step = -render->step;
+    source_display(render->sview, 1, WIN_REFRESH, &config);
+    render->frames++;
+
+    return 0;
+}
+
+static int frame_scroller(void *context)
+{
+    static const char *colors[] = { "31", "32", "33", "34", "1;35", "36" };
+    struct render *render = (struct render *) context;
+    int frames = render->frames;
+    char line[256];
+
+    snprintf(line, sizeof (line),
+            "\033[%sm%06d\033[0m output of the program, "
+            "\033[1mbold\033[0m and \033[%sm%s\033[0m\n",
+            colors[frames % 6], frames, colors[(frames + 3) % 6],
+            "colored, as from ls --color or a test runner");
+    scr_add(render->scr, line);
+    scr_refresh(render->scr, 1, WIN_REFRESH, &config);
+    render->frames++;
+
+    return 0;
+}
+
+static void usage(const char *progname)
+{
+    fprintf(stderr, "Usage: %s [-t TERM] [-s COLSxLINES] [-n FRAMES] "
+            "FILE\n", progname);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *term = getenv("TERM"), *size = "200x50";
+    struct sviewer *sview;
+    struct render render;
+    char *long_file;
+    int opt;
+
+    if (!term || !*term)
+        term = "xterm-256color";
+
+    while ((opt = getopt(argc, argv, "t:s:n:")) != -1) {
+        switch (opt) {
+            case 't':
+                term = optarg;
+                break;
+            case 's':
+                size = optarg;
+                break;
+            case 'n':
+                repetitions = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+
+    if (optind + 1 != argc || repetitions <= 0)
+        usage(argv[0]);
+
+    options[CGDBRC_SCROLLBACK].variant.int_val = 10000;
+
+    long_file = long_lines(argv[optind]);
+    if (!long_file) {
+        fprintf(stderr, "%s: could not read %s\n", argv[0], argv[optind]);
+        return 1;
+    }
+
+    if (highlight_init() == -1) {
+        fprintf(stderr, "%s: could not start the highlighting worker\n",
+                argv[0]);
+        unlink(long_file);
+        return 1;
+    }
+
+    if (init_curses(term, size) == -1) {
+        fprintf(stderr, "%s: could not start curses on a %s terminal\n",
+                argv[0], term);
+        unlink(long_file);
+        return 1;
+    }
+
+    sview = source_new(0, 0, LINES, COLS);
+
+    if (load(sview, argv[optind]) == -1 || load(sview, long_file) == -1) {
+        endwin();
+        fprintf(stderr, "%s: could not load %s\n", argv[0], argv[optind]);
+        unlink(long_file);
+        return 1;
+    }
+
+    memset(&render, 0, sizeof (struct render));
+    render.sview = sview;
+    render.length = source_length(sview, argv[optind]);
+
+    /* Somewhere in the middle, so there's something on every row */
+    source_set_sel_line(sview, render.length / 2);
+    render.step = 1;
+    run_render("hscroll", frame_hscroll, &render);
+
+    source_set_exec_line(sview, argv[optind], 1);
+    source_set_sel_line(sview, 1);
+    run_render("scroll", frame_scroll, &render);
+
+    render.line = 1;
+    run_render("exe_line", frame_exe_line, &render);
+
+    render.scr = scr_new(0, 0, LINES, COLS);
+    run_render("scroller", frame_scroller, &render);
+    scr_free(render.scr);
+
+    endwin();
+    source_free(sview);
+    unlink(long_file);
+
+    return 0;
+}
@@ -0,0 +1,528 @@
+/* resume.c:
+ * ---------
+ *
+ * A snapshot is a text file named after the hash of the path of its
+ * program. Each line is a keyword and what it's about, with a path always
+ * last on the line, so paths can have spaces. The first lines name the
+ * program and its timestamp, and the snapshot is dropped unless both
+ * still match. Like the highlight cache, a snapshot is written to a
+ * temporary file and renamed into place.
+ *
+ *   cgdbresume1
+ *   binary <path>
+ *   mtime <timestamp>
+ *   current <path>
+ *   file <selected line> <path>
+ *   break <line> <enabled> <path>
+ *   source <path>
+ *
+ * The open files are saved with the one used last first, so those are the
+ * first to be read again.
+ *
+ * The breakpoints exported on their own are a gdb script instead, so gdb
+ * can source it too. Each is set with a break command, with a disable
+ * command after it if it's disabled:
+ *
+ *   break "<path>":<line>
+ *   disable $bpnum
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif /* HAVE_SYS_STAT_H */
+
+/* Local Includes */
+#include "resume.h"
+#include "cgdb.h"
+#include "interface.h"
+#include "sources.h"
+#include "tgdb.h"
+#include "fs_util.h"
+#include "std_hash.h"
+#include "std_intern.h"
+#include "sys_util.h"
+#include "logger.h"
+
+extern struct tgdb *tgdb;
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The name of the snapshot directory, in the config directory */
+#define RESUME_DIR "resume"
+
+/* Change the version when the layout of a snapshot changes */
+#define RESUME_MAGIC "cgdbresume1"
+
+/* A line of a snapshot, the keyword, the numbers and a path */
+#define RESUME_LINE (FSUTIL_PATH_MAX + 64)
+
+/* The gdb options that take the argument after them */
+static const char *const resume_gdb_options[] = {
+    "b", "c", "cd", "command", "core", "d", "D", "data-directory",
+    "directory", "e", "eval-command", "ex", "exec", "iex", "init-command",
+    "init-eval-command", "ix", "l", "p", "pid", "s", "se", "symbols", "tty",
+    "x", NULL
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+static char resume_home[FSUTIL_PATH_MAX];   /* The config directory */
+static char resume_dir[FSUTIL_PATH_MAX];    /* The snapshot directory */
+
+/* The full path of the program, NULL if gdb wasn't given one */
+static char *resume_binary;
+static long long resume_mtime;
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* resume_compare: Orders files by when they were used, the last one first.
+ * ---------------
+ */
+static int resume_compare(const void *a, const void *b)
+{
+    const struct list_node *left = *(const struct list_node * const *) a;
+    const struct list_node *right = *(const struct list_node * const *) b;
+
+    if (left->last_used != right->last_used)
+        return left->last_used > right->last_used ? -1 : 1;
+
+    return 0;
+}
+
+/* resume_write: Writes the snapshot, for fs_util_write_file.
+ * -------------
+ *
+ * Paths with a newline in them are left out, they can't be read back.
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+static int resume_write(FILE *file, void *data)
+{
+    struct sviewer *sview = data;
+    struct list_node *node, **nodes = NULL;
+    char **sources;
+    int count = 0, size = 0, i;
+
+    fprintf(file, "%s\n", RESUME_MAGIC);
+    fprintf(file, "binary %s\n", resume_binary);
+    fprintf(file, "mtime %lld\n", resume_mtime);
+
+    if (sview->view->cur && !sview->view->cur->text &&
+            !strchr(sview->view->cur->path, '\n'))
+        fprintf(file, "current %s\n", sview->view->cur->path);
+
+    /* Only the files that were shown, not the ones read ahead of time */
+    for (node = sview->list_head; node; node = node->next) {
+        if (node->text || node->last_used == 0 || strchr(node->path, '\n'))
+            continue;
+
+        if (count == size) {
+            size = size ? size * 2 : 16;
+            nodes = cgdb_realloc(nodes, sizeof (struct list_node *) * size);
+        }
+        nodes[count++] = node;
+    }
+
+    qsort(nodes, count, sizeof (struct list_node *), resume_compare);
+
+    for (i = 0; i < count; i++)
+        fprintf(file, "file %d %s\n",
+                source_selected_line(sview, nodes[i]) + 1, nodes[i]->path);
+    free(nodes);
+
+    for (i = 0; i < sview->breaks_count; i++)
+        if (sview->breaks[i].path && !strchr(sview->breaks[i].path, '\n'))
+            fprintf(file, "break %d %d %s\n", sview->breaks[i].line,
+                    sview->breaks[i].enabled, sview->breaks[i].path);
+
+    sources = if_get_source_files(&count);
+    for (i = 0; i < count; i++)
+        if (!strchr(sources[i], '\n'))
+            fprintf(file, "source %s\n", sources[i]);
+
+    return ferror(file) ? -1 : 0;
+}
+
+/* resume_add_breaks: Sets breakpoints in gdb, with a single request.
+ * ------------------
+ *
+ *   breaks:  The breakpoints to set
+ *   count:   The number of breakpoints
+ */
+static void resume_add_breaks(const struct source_break *breaks, int count)
+{
+    struct tgdb_breakpoint *tb;
+    int i;
+
+    if (count == 0)
+        return;
+
+    tb = cgdb_calloc(count, sizeof (struct tgdb_breakpoint));
+    for (i = 0; i < count; i++) {
+        tb[i].file = breaks[i].path;
+        tb[i].line = breaks[i].line;
+        tb[i].enabled = breaks[i].enabled;
+    }
+
+    handle_request(tgdb, tgdb_request_add_breakpoints(tgdb, tb, count));
+    free(tb);
+}
+
+/* resume_break_location: Splits the location off a break command.
+ * ----------------------
+ *
+ *   text:  What's after "break ", a path, quoted as fs_util_quote_path
+ *          does or not, a colon and a line. The path is written over it.
+ *   line:  Set to the line
+ *
+ * Return Value: The path, or NULL if it isn't a location.
+ */
+static char *resume_break_location(char *text, int *line)
+{
+    char *colon, *end;
+    long number;
+
+    if (text[0] == '"') {
+        if (!(colon = fs_util_unquote_path(text)) || *colon != ':' ||
+                text[0] == '\0')
+            return NULL;
+    } else if (!(colon = strrchr(text, ':')) || colon == text)
+        return NULL;
+
+    number = strtol(colon + 1, &end, 10);
+    if (end == colon + 1 || *end != '\0' || number <= 0)
+        return NULL;
+
+    *colon = '\0';
+    *line = (int) number;
+
+    return text;
+}
+
+/* resume_field: Splits the number off the front of what's on a line.
+ * -------------
+ *
+ *   text:    Where the number is, moved past it and the space after it
+ *   number:  Set to the number
+ *
+ * Return Value: 0 on success, -1 if there's no number.
+ */
+static int resume_field(char **text, long long *number)
+{
+    char *end;
+
+    *number = strtoll(*text, &end, 10);
+    if (end == *text || *end != ' ')
+        return -1;
+
+    *text = end + 1;
+
+    return 0;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in resume.h for function descriptions. */
+
+const char *resume_program(int argc, char *argv[])
+{
+    const char *name;
+    int i, j;
+
+    for (i = 0; i < argc; i++) {
+        if (argv[i][0] != '-')
+            return argv[i];
+
+        /* Everything after the program is the program's */
+        if (strcmp(argv[i], "--args") == 0 || strcmp(argv[i], "-args") == 0)
+            return i + 1 < argc ? argv[i + 1] : NULL;
+
+        name = argv[i] + (argv[i][1] == '-' ? 2 : 1);
+        if (strchr(name, '='))
+            continue;
+
+        for (j = 0; resume_gdb_options[j]; j++) {
+            if (strcmp(name, resume_gdb_options[j]) == 0) {
+                i++;
+                break;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void resume_init(const char *home_dir, int argc, char *argv[])
+{
+    const char *program = resume_program(argc, argv);
+    char path[FSUTIL_PATH_MAX];
+    struct stat st;
+
+    strncpy(resume_home, home_dir, FSUTIL_PATH_MAX - 1);
+    fs_util_get_path(resume_home, RESUME_DIR, resume_dir);
+
+    /* gdb looks for a program without a slash in the current directory */
+    if (!program || strlen(program) >= FSUTIL_PATH_MAX ||
+            !realpath(program, path) || stat(path, &st) == -1)
+        return;
+
+    resume_binary = cgdb_strdup(path);
+    resume_mtime = st.st_mtime;
+}
+
+int resume_save(void)
+{
+    struct sviewer *sview = if_get_sview();
+    char entry[FSUTIL_PATH_MAX];
+
+    if (!resume_binary || !sview)
+        return -1;
+
+    if (!fs_util_create_dir_in_base(resume_home, RESUME_DIR))
+        return -1;
+
+    fs_util_get_hashed_path(resume_dir, std_str_hash(resume_binary), entry);
+
+    if (fs_util_write_file(entry, resume_write, sview) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "Unable to save the session of %s", resume_binary);
+        return -1;
+    }
+
+    return 0;
+}
+
+int resume_load(int breakpoints)
+{
+    struct sviewer *sview = if_get_sview();
+    char entry[FSUTIL_PATH_MAX], line[RESUME_LINE];
+    char *current = NULL, **sources = NULL, *text;
+    struct source_break *breaks = NULL;
+    int sources_count = 0, sources_size = 0;
+    int breaks_count = 0, breaks_size = 0;
+    int checked = 0, shown, i;
+    long long number, enabled;
+    size_t length;
+    FILE *file;
+
+    if (!resume_binary || !sview)
+        return -1;
+
+    fs_util_get_hashed_path(resume_dir, std_str_hash(resume_binary), entry);
+    if (!(file = fopen(entry, "r")))
+        return -1;
+
+    if (!fgets(line, sizeof (line), file) ||
+            strcmp(line, RESUME_MAGIC "\n") != 0) {
+        fclose(file);
+        return -1;
+    }
+
+    while (fgets(line, sizeof (line), file)) {
+        /* A line that doesn't fit is from some other snapshot */
+        length = strlen(line);
+        if (length == 0 || line[length - 1] != '\n')
+            break;
+        line[length - 1] = '\0';
+
+        if (!(text = strchr(line, ' ')))
+            break;
+        *text++ = '\0';
+
+        /* Nothing is used until both the program and its timestamp match */
+        if (checked < 2) {
+            if (strcmp(line, "binary") == 0 &&
+                    strcmp(text, resume_binary) == 0)
+                checked++;
+            else if (strcmp(line, "mtime") == 0 &&
+                    strtoll(text, NULL, 10) == resume_mtime)
+                checked++;
+            else
+                break;
+        } else if (strcmp(line, "current") == 0) {
+            free(current);
+            current = cgdb_strdup(text);
+        } else if (strcmp(line, "file") == 0) {
+            if (resume_field(&text, &number) == 0)
+                source_restore(sview, text, (int) number);
+        } else if (strcmp(line, "break") == 0) {
+            if (resume_field(&text, &number) == -1 ||
+                    resume_field(&text, &enabled) == -1)
+                continue;
+
+            if (breaks_count == breaks_size) {
+                breaks_size = breaks_size ? breaks_size * 2 : 16;
+                breaks = cgdb_realloc(breaks,
+                        sizeof (struct source_break) * breaks_size);
+            }
+            breaks[breaks_count].path = std_intern(text);
+            breaks[breaks_count].line = (int) number;
+            breaks[breaks_count].enabled = enabled != 0;
+            breaks_count++;
+        } else if (strcmp(line, "source") == 0) {
+            if (sources_count == sources_size) {
+                sources_size = sources_size ? sources_size * 2 : 64;
+                sources = cgdb_realloc(sources, sizeof (char *) * sources_size);
+            }
+            sources[sources_count++] = cgdb_strdup(text);
+        }
+    }
+
+    fclose(file);
+
+    if (checked == 2) {
+        /* The list gdb gives replaces it, when the user asks for it */
+        if (sources_count > 0)
+            if_add_filedlg_choices(sources, sources_count);
+
+        /* They're shown until gdb lists the breakpoints it set */
+        source_update_breaks(sview, breaks, breaks_count);
+
+        if (breakpoints)
+            resume_add_breaks(breaks, breaks_count);
+
+        if_prefetch_breaks();
+
+        if (current)
+            if_show_file(current, 0);
+    }
+
+    shown = checked == 2 && current && sview->view->cur &&
+            strcmp(sview->view->cur->path, current) == 0;
+
+    free(breaks);
+    for (i = 0; i < sources_count; i++)
+        free(sources[i]);
+    free(sources);
+    free(current);
+
+    return shown ? 0 : -1;
+}
+
+int resume_export_breaks(const char *path)
+{
+    struct sviewer *sview = if_get_sview();
+    char *quoted;
+    FILE *file;
+    int ret, i;
+
+    if (!sview || !(file = fopen(path, "w")))
+        return -1;
+
+    for (i = 0; i < sview->breaks_count; i++) {
+        if (!sview->breaks[i].path || strchr(sview->breaks[i].path, '\n'))
+            continue;
+
+        quoted = fs_util_quote_path(sview->breaks[i].path);
+        fprintf(file, "break %s:%d\n", quoted, sview->breaks[i].line);
+        free(quoted);
+        if (!sview->breaks[i].enabled)
+            fprintf(file, "disable $bpnum\n");
+    }
+
+    ret = ferror(file) ? -1 : 0;
+    if (fclose(file) == EOF)
+        ret = -1;
+
+    return ret;
+}
+
+int resume_import_breaks(const char *path)
+{
+    struct sviewer *sview = if_get_sview();
+    char line[RESUME_LINE], *text;
+    struct source_break *breaks = NULL;
+    int count = 0, size = 0, ret = 0, number, i;
+    size_t length;
+    FILE *file;
+
+    if (!sview || !(file = fopen(path, "r")))
+        return -1;
+
+    while (fgets(line, sizeof (line), file)) {
+        length = strlen(line);
+        if (length == 0 || line[length - 1] != '\n') {
+            ret = -1;
+            break;
+        }
+        line[length - 1] = '\0';
+
+        text = line + strspn(line, " \t");
+        if (*text == '\0' || *text == '#')
+            continue;
+
+        /* It's the breakpoint set on the line before */
+        if (strcmp(text, "disable $bpnum") == 0) {
+            if (count == 0) {
+                ret = -1;
+                break;
+            }
+            breaks[count - 1].enabled = 0;
+            continue;
+        }
+
+        if (strncmp(text, "break ", 6) != 0 ||
+                !(text = resume_break_location(text + 6, &number))) {
+            ret = -1;
+            break;
+        }
+
+        if (count == size) {
+            size = size ? size * 2 : 64;
+            breaks = cgdb_realloc(breaks, sizeof (struct source_break) * size);
+        }
+        breaks[count].path = std_intern(text);
+        breaks[count].line = number;
+        breaks[count].enabled = 1;
+        count++;
+    }
+
+    fclose(file);
+
+    /* Nothing is set from a file that isn't all breakpoints */
+    if (ret == 0) {
+        int kept = 0;
+
+        /* The ones gdb has already aren't set twice */
+        for (i = 0; i < count; i++)
+            if (!source_has_break(sview, breaks[i].path, breaks[i].line))
+                breaks[kept++] = breaks[i];
+
+        resume_add_breaks(breaks, kept);
+        ret = kept;
+    }
+
+    free(breaks);
+
+    return ret;
+}
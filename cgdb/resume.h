@@ -0,0 +1,93 @@
+#ifndef _RESUME_H_
+#define _RESUME_H_
+
+/* resume.h:
+ * ---------
+ *
+ * Snapshots of what cgdb showed when it exited, so the next cgdb on the
+ * same program can start where the last one was. A snapshot has the
+ * breakpoints, the files that were open with their selected lines, the
+ * file that was shown and the source files gdb listed. It's kept in the
+ * resume directory of the config directory, one for each program, and is
+ * only used while the program hasn't been built again since.
+ *
+ * The highlighting of the files isn't in it. The highlight cache already
+ * keeps it by the path of each file, so the files that are restored get
+ * it from there when they're read.
+ *
+ * The breakpoints can also be exported to a file of their own, and
+ * imported again into any session.
+ *
+ */
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* resume_init: Finds the program gdb debugs, that snapshots are kept for.
+ * ------------
+ *
+ *   home_dir:  The config directory, the snapshots are kept in a directory
+ *              in it. It is created the first time one is saved.
+ *   argc:      The number of arguments gdb is given
+ *   argv:      The arguments gdb is given, the program is the first one
+ *              that isn't an option
+ */
+void resume_init(const char *home_dir, int argc, char *argv[]);
+
+/* resume_program: Finds the program in gdb's arguments.
+ * ---------------
+ *
+ *   argc:  The number of arguments gdb is given
+ *   argv:  The arguments gdb is given
+ *
+ * Return Value: The argument naming the program, or NULL if there's none.
+ */
+const char *resume_program(int argc, char *argv[]);
+
+/* resume_save: Saves a snapshot of what cgdb shows, when it exits.
+ * ------------
+ *
+ * Return Value: 0 on success, -1 on error or if gdb wasn't given a program.
+ */
+int resume_save(void);
+
+/* resume_load: Shows what the last snapshot of the program had.
+ * ------------
+ *
+ * The breakpoints are set in gdb again. gdb is still loading the program,
+ * the requests wait for it, and the breakpoints are shown until gdb
+ * lists them itself.
+ *
+ *   breakpoints:  0 if gdb has the breakpoints already, and they're only
+ *                 shown, 1 to set them in gdb
+ *
+ * Return Value: 0 if the file that was shown is shown again, -1 if it
+ *               isn't, or there's no snapshot of the program as it is now.
+ *               Then gdb has to be asked where the program is.
+ */
+int resume_load(int breakpoints);
+
+/* resume_export_breaks: Writes the breakpoints to a file, as a gdb script.
+ * ---------------------
+ *
+ *   path:  The file, it's replaced
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+int resume_export_breaks(const char *path);
+
+/* resume_import_breaks: Sets the breakpoints a file has in gdb.
+ * ---------------------
+ *
+ * The file is one resume_export_breaks wrote. The breakpoints are all set
+ * with one request, and the ones that are set already are left out.
+ *
+ *   path:  The file
+ *
+ * Return Value: The number of breakpoints set, or -1 if the file can't be
+ *               read or has something other than breakpoints in it.
+ */
+int resume_import_breaks(const char *path);
+
+#endif /* _RESUME_H_ */
@@ -0,0 +1,1694 @@
+/* rx.c:
+ * -----
+ *
+ * A regular expression is parsed into a tree, and the tree into a program
+ * for a Thompson NFA: an instruction for each byte to match, with splits,
+ * jumps and assertions between them. Nothing is ever tried twice, each
+ * instruction is at most once in the set of the ones the text has reached.
+ *
+ * The text is matched twice. A DFA, with a state for each set of
+ * instructions and built a state at a time as the text needs them, tells
+ * if there's a match at all, at a table lookup per byte. Most lines don't
+ * match, and that's all they cost. Where one does, the NFA is run over it
+ * with each thread knowing where it started, which finds the leftmost of
+ * the longest matches, the one regexec finds.
+ *
+ * When the pattern starts with plain text, the text is looked for first,
+ * 16 or 32 bytes at a time, and matching starts where it is.
+ *
+ * The syntax is the C library's, basic or extended (with REG_EXTENDED),
+ * along with the GNU \w \W \s \S \b \B \< \> \` and \' and, in basic
+ * ones, \+ \? and \|.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_CTYPE_H
+#include <ctype.h>
+#endif /* HAVE_CTYPE_H */
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Local Includes */
+#include "rx.h"
+#include "sys_util.h"
+
+/* The most instructions a program can have, a{1000}{1000} doesn't compile */
+#define RX_PROGRAM_MAX 32768
+
+/* How deeply groups can nest */
+#define RX_DEPTH_MAX 256
+
+/* The most a count like {m,n} can be, RE_DUP_MAX */
+#define RX_DUP_MAX 0x7fff
+
+/* The DFA states kept, the DFA starts over when there are more */
+#define RX_DFA_STATES 64
+#define RX_DFA_TABLE (RX_DFA_STATES * 2)
+
+/* What a transition of the DFA can be, besides the next state */
+#define RX_DFA_UNKNOWN -1       /* Not worked out yet */
+#define RX_DFA_MATCHED -2       /* There's a match before the byte */
+
+/* What parsing can fail with */
+#define RX_ERROR 1              /* The pattern is wrong */
+#define RX_UNSUPPORTED 2        /* It needs the C library's engine */
+
+#define RX_SET_ADD(set, c) ((set)->bits[(c) >> 3] |= 1 << ((c) & 7))
+#define RX_SET_HAS(set, c) ((set)->bits[(c) >> 3] & (1 << ((c) & 7)))
+
+/* --------------- */
+/* Data Structures */
+/* --------------- */
+
+/* A set of bytes */
+struct rx_set {
+    unsigned char bits[32];
+};
+
+enum rx_node_type {
+    RX_NODE_EMPTY,              /* Matches nothing, always */
+    RX_NODE_SET,                /* A byte of the set a */
+    RX_NODE_CAT,                /* a then b */
+    RX_NODE_ALT,                /* a or b */
+    RX_NODE_REPEAT,             /* a, from min to max times (-1 for any) */
+    RX_NODE_ASSERT              /* The assertion a holds */
+};
+
+/* A node of the parsed expression */
+struct rx_node {
+    enum rx_node_type type;
+    int a, b;
+    int min, max;
+};
+
+enum rx_assertion {
+    RX_ASSERT_BOL,              /* ^ */
+    RX_ASSERT_EOL,              /* $ */
+    RX_ASSERT_BEGIN,            /* \` */
+    RX_ASSERT_END,              /* \' */
+    RX_ASSERT_BOUNDARY,         /* \b */
+    RX_ASSERT_INSIDE,           /* \B */
+    RX_ASSERT_WORD_BEGIN,       /* \< */
+    RX_ASSERT_WORD_END          /* \> */
+};
+
+/* The parser's state */
+struct rx_parser {
+    const char *p;              /* What's left of the pattern */
+    int extended;               /* 1 for an extended expression */
+    int icase;                  /* 1 to ignore case */
+    int utf8;                   /* 1 if the locale's encoding is UTF-8 */
+    int depth;                  /* How many groups p is in */
+    int error;                  /* RX_ERROR or RX_UNSUPPORTED */
+
+    struct rx_node *nodes;
+    int nodes_count;
+    int nodes_size;
+
+    struct rx_set *sets;
+    int sets_count;
+    int sets_size;
+
+    int multibyte;              /* A node matching a character that isn't
+                                 * ASCII, or -1 until one's needed */
+};
+
+enum rx_op {
+    RX_OP_SET,                  /* Matches a byte of the set x */
+    RX_OP_SPLIT,                /* Goes on at both x and y */
+    RX_OP_JMP,                  /* Goes on at x */
+    RX_OP_ASSERT,               /* Goes on if the assertion x holds */
+    RX_OP_MATCH                 /* The expression matched */
+};
+
+/* An instruction of the program */
+struct rx_inst {
+    enum rx_op op;
+    int x, y;
+};
+
+/* Where in the text the NFA is, for the assertions */
+struct rx_where {
+    int begin, end;             /* 1 at the start (or end) of the text */
+    int bol, eol;               /* 1 if ^ (or $) can match there */
+    int prev_word, cur_word;    /* 1 if the byte before (or at) is a letter,
+                                 * a digit or '_' */
+};
+
+/* A thread of the NFA, and where the match it's on started */
+struct rx_thread {
+    int pc;
+    int start;
+};
+
+/* What's before a DFA state's position, for the assertions */
+enum rx_context {
+    RX_CONTEXT_BOL,             /* The start of the text, ^ matches */
+    RX_CONTEXT_NOTBOL,          /* The start of the text, with REG_NOTBOL */
+    RX_CONTEXT_WORD,            /* A letter, a digit or '_' */
+    RX_CONTEXT_OTHER            /* Any other byte */
+};
+
+/* A state of the DFA, the instructions that consumed the byte before it,
+ * besides the start of the program, which every state has */
+struct rx_state {
+    int kernel;                 /* Where they are in rx->kernels */
+    int count;                  /* How many there are */
+    enum rx_context context;
+    int end[2];                 /* 1 if there's a match at the end of the
+                                 * text, by REG_NOTEOL, or -1 if unknown */
+    int next[256];              /* The state after each byte, or one of
+                                 * RX_DFA_UNKNOWN and RX_DFA_MATCHED */
+};
+
+struct rx {
+    int posix;                  /* 1 if the C library's engine is used */
+    regex_t t;                  /* Its expression */
+
+    int nosub;                  /* 1 if compiled with REG_NOSUB */
+    int utf8;
+
+    struct rx_inst *program;
+    int count;
+    struct rx_set *sets;
+
+    /* The plain text the pattern starts with, and if that's all it is */
+    char *literal;
+    int literal_length;
+    int literal_only;
+
+    /* What matching works with */
+    unsigned int *mark;         /* The generation each instruction was last
+                                 * added to a list in */
+    unsigned int generation;
+    int *stack;
+    struct rx_thread *list;
+    struct rx_thread *next_list;
+
+    struct rx_state *states;    /* The DFA, allocated when first used */
+    int states_count;
+    int *kernels;
+    int kernels_count;
+    int kernels_size;
+    int table[RX_DFA_TABLE];    /* Each state's index + 1, by hash */
+};
+
+/* ---------- */
+/* The parser */
+/* ---------- */
+
+/* rx_node: Adds a node to the tree.
+ * --------
+ *
+ * Return Value: Its index.
+ */
+static int rx_node(struct rx_parser *ps, enum rx_node_type type, int a, int b)
+{
+    struct rx_node *node;
+
+    if (ps->nodes_count == ps->nodes_size) {
+        ps->nodes_size = ps->nodes_size ? ps->nodes_size * 2 : 64;
+        ps->nodes = cgdb_realloc(ps->nodes,
+                sizeof (struct rx_node) * ps->nodes_size);
+    }
+
+    node = &ps->nodes[ps->nodes_count];
+    node->type = type;
+    node->a = a;
+    node->b = b;
+    node->min = 0;
+    node->max = 0;
+
+    return ps->nodes_count++;
+}
+
+/* rx_set_new: Adds an empty set of bytes.
+ * -----------
+ *
+ * Return Value: Its index.
+ */
+static int rx_set_new(struct rx_parser *ps)
+{
+    if (ps->sets_count == ps->sets_size) {
+        ps->sets_size = ps->sets_size ? ps->sets_size * 2 : 16;
+        ps->sets = cgdb_realloc(ps->sets,
+                sizeof (struct rx_set) * ps->sets_size);
+    }
+
+    memset(&ps->sets[ps->sets_count], 0, sizeof (struct rx_set));
+
+    return ps->sets_count++;
+}
+
+/* rx_byte: Gets a node matching a byte.
+ * --------
+ */
+static int rx_byte(struct rx_parser *ps, int c)
+{
+    int set = rx_set_new(ps);
+
+    RX_SET_ADD(&ps->sets[set], c);
+    if (ps->icase && c < 0x80 && isalpha(c)) {
+        RX_SET_ADD(&ps->sets[set], tolower(c));
+        RX_SET_ADD(&ps->sets[set], toupper(c));
+    }
+
+    return rx_node(ps, RX_NODE_SET, set, 0);
+}
+
+/* rx_range: Gets a node matching the bytes from first to last.
+ * ---------
+ */
+static int rx_range(struct rx_parser *ps, int first, int last)
+{
+    int set = rx_set_new(ps), c;
+
+    for (c = first; c <= last; c++)
+        RX_SET_ADD(&ps->sets[set], c);
+
+    return rx_node(ps, RX_NODE_SET, set, 0);
+}
+
+/* rx_multibyte: Gets a node matching a UTF-8 character that isn't ASCII.
+ * -------------
+ */
+static int rx_multibyte(struct rx_parser *ps)
+{
+    int next, two, three, four;
+
+    if (ps->multibyte == -1) {
+        next = rx_range(ps, 0x80, 0xBF);
+        two = rx_node(ps, RX_NODE_CAT, rx_range(ps, 0xC2, 0xDF), next);
+        three = rx_node(ps, RX_NODE_CAT, rx_range(ps, 0xE0, 0xEF), next);
+        three = rx_node(ps, RX_NODE_CAT, three, next);
+        four = rx_node(ps, RX_NODE_CAT, rx_range(ps, 0xF0, 0xF4), next);
+        four = rx_node(ps, RX_NODE_CAT, four, next);
+        four = rx_node(ps, RX_NODE_CAT, four, next);
+        ps->multibyte = rx_node(ps, RX_NODE_ALT, two,
+                rx_node(ps, RX_NODE_ALT, three, four));
+    }
+
+    return ps->multibyte;
+}
+
+/* rx_characters: Gets a node matching the characters of a set of bytes.
+ * --------------
+ *
+ *   set:     The set, of ASCII only in UTF-8
+ *   others:  1 if the characters that aren't ASCII match too, in UTF-8
+ */
+static int rx_characters(struct rx_parser *ps, int set, int others)
+{
+    int node = rx_node(ps, RX_NODE_SET, set, 0);
+
+    if (ps->utf8 && others)
+        node = rx_node(ps, RX_NODE_ALT, node, rx_multibyte(ps));
+
+    return node;
+}
+
+/* rx_is_word: Determines if a byte is a letter, a digit or '_'.
+ * -----------
+ *
+ * In UTF-8, the bytes of characters that aren't ASCII are taken as letters.
+ */
+static int rx_is_word(int c, int utf8)
+{
+    if (c >= 0x80)
+        return utf8;
+
+    return isalnum(c) || c == '_';
+}
+
+/* rx_class: Adds the bytes of a character class, like alpha, to a set.
+ * ---------
+ *
+ * Return Value: 0 on success, -1 if there's no such class.
+ */
+static int rx_class(struct rx_parser *ps, struct rx_set *set,
+        const char *name, int length)
+{
+    static const char *classes[] = {
+        "alpha", "digit", "alnum", "upper", "lower", "space", "blank",
+        "punct", "print", "graph", "cntrl", "xdigit", NULL
+    };
+    int class, c, in = 0;
+
+    for (class = 0; classes[class]; class++)
+        if (strlen(classes[class]) == length &&
+                strncmp(classes[class], name, length) == 0)
+            break;
+
+    if (!classes[class])
+        return -1;
+
+    for (c = 1; c < (ps->utf8 ? 0x80 : 0x100); c++) {
+        switch (class) {
+            case 0: in = isalpha(c); break;
+            case 1: in = isdigit(c); break;
+            case 2: in = isalnum(c); break;
+            case 3: in = isupper(c); break;
+            case 4: in = islower(c); break;
+            case 5: in = isspace(c); break;
+            case 6: in = c == ' ' || c == '\t'; break;
+            case 7: in = ispunct(c); break;
+            case 8: in = isprint(c); break;
+            case 9: in = isgraph(c); break;
+            case 10: in = iscntrl(c); break;
+            case 11: in = isxdigit(c); break;
+        }
+
+        if (in)
+            RX_SET_ADD(set, c);
+    }
+
+    return 0;
+}
+
+/* rx_bracket_char: Reads a character of a bracket expression, which can be
+ * ---------------- a collating element like [.-.] or [=a=].
+ *
+ * Return Value: The byte, or -1 if it can't be matched a byte at a time.
+ */
+static int rx_bracket_char(struct rx_parser *ps)
+{
+    const char *p = ps->p;
+    int c;
+
+    if (p[0] == '[' && (p[1] == '.' || p[1] == '=')) {
+        if (p[2] == '\0' || p[3] != p[1] || p[4] != ']')
+            return -1;
+        c = (unsigned char) p[2];
+        ps->p += 5;
+    } else {
+        c = (unsigned char) p[0];
+        ps->p++;
+    }
+
+    if (ps->utf8 && c >= 0x80)
+        return -1;
+
+    return c;
+}
+
+/* rx_bracket: Parses a bracket expression, ps->p is past the '['.
+ * -----------
+ */
+static int rx_bracket(struct rx_parser *ps)
+{
+    int set = rx_set_new(ps), negate = 0, first = 1, c, last, i;
+    const char *end;
+    struct rx_set *s;
+
+    if (*ps->p == '^') {
+        negate = 1;
+        ps->p++;
+    }
+
+    for (;;) {
+        s = &ps->sets[set];
+
+        if (*ps->p == '\0') {
+            ps->error = RX_ERROR;
+            return -1;
+        }
+
+        if (*ps->p == ']' && !first) {
+            ps->p++;
+            break;
+        }
+        first = 0;
+
+        if (ps->p[0] == '[' && ps->p[1] == ':') {
+            if (!(end = strstr(ps->p + 2, ":]")) ||
+                    rx_class(ps, s, ps->p + 2, end - (ps->p + 2)) == -1) {
+                ps->error = RX_ERROR;
+                return -1;
+            }
+            ps->p = end + 2;
+            continue;
+        }
+
+        if ((c = rx_bracket_char(ps)) == -1) {
+            ps->error = RX_UNSUPPORTED;
+            return -1;
+        }
+
+        last = c;
+        if (ps->p[0] == '-' && ps->p[1] != ']' && ps->p[1] != '\0') {
+            ps->p++;
+            if ((last = rx_bracket_char(ps)) == -1) {
+                ps->error = RX_UNSUPPORTED;
+                return -1;
+            }
+            if (last < c) {
+                ps->error = RX_ERROR;
+                return -1;
+            }
+        }
+
+        for (i = c; i <= last; i++)
+            RX_SET_ADD(s, i);
+    }
+
+    s = &ps->sets[set];
+    if (ps->icase)
+        for (c = 'A'; c <= 'Z'; c++)
+            if (RX_SET_HAS(s, c) || RX_SET_HAS(s, tolower(c))) {
+                RX_SET_ADD(s, c);
+                RX_SET_ADD(s, tolower(c));
+            }
+
+    if (negate) {
+        for (i = 0; i < 32; i++)
+            s->bits[i] = ~s->bits[i];
+        s->bits[0] &= ~1;
+        if (ps->utf8)
+            memset(s->bits + 16, 0, 16);
+    }
+
+    return rx_characters(ps, set, negate);
+}
+
+/* rx_escape: Parses what a '\' outside of brackets stands for, other than
+ * ---------- the operators of basic expressions.
+ */
+static int rx_escape(struct rx_parser *ps)
+{
+    int c = (unsigned char) *ps->p, set, i;
+    struct rx_set *s;
+
+    if (c == '\0') {
+        ps->error = RX_ERROR;
+        return -1;
+    }
+    ps->p++;
+
+    switch (c) {
+        case 'w':
+        case 'W':
+        case 's':
+        case 'S':
+            set = rx_set_new(ps);
+            s = &ps->sets[set];
+            for (i = 1; i < 0x80; i++)
+                if ((c == 'w' || c == 'W') ? rx_is_word(i, 0) : isspace(i))
+                    RX_SET_ADD(s, i);
+            if (isupper(c)) {
+                for (i = 0; i < 32; i++)
+                    s->bits[i] = ~s->bits[i];
+                s->bits[0] &= ~1;
+                if (ps->utf8)
+                    memset(s->bits + 16, 0, 16);
+            }
+            return rx_characters(ps, set, c != 's');
+        case 'b':
+            return rx_node(ps, RX_NODE_ASSERT, RX_ASSERT_BOUNDARY, 0);
+        case 'B':
+            return rx_node(ps, RX_NODE_ASSERT, RX_ASSERT_INSIDE, 0);
+        case '<':
+            return rx_node(ps, RX_NODE_ASSERT, RX_ASSERT_WORD_BEGIN, 0);
+        case '>':
+            return rx_node(ps, RX_NODE_ASSERT, RX_ASSERT_WORD_END, 0);
+        case '`':
+            return rx_node(ps, RX_NODE_ASSERT, RX_ASSERT_BEGIN, 0);
+        case '\'':
+            return rx_node(ps, RX_NODE_ASSERT, RX_ASSERT_END, 0);
+    }
+
+    /* Back references */
+    if (c >= '1' && c <= '9') {
+        ps->error = RX_UNSUPPORTED;
+        return -1;
+    }
+
+    return rx_byte(ps, c);
+}
+
+/* rx_literal: Parses a character that stands for itself.
+ * -----------
+ *
+ * A UTF-8 character is read whole, so that a '*' after it repeats all of it.
+ */
+static int rx_literal(struct rx_parser *ps)
+{
+    int c = (unsigned char) *ps->p++, node;
+
+    if (ps->utf8 && c >= 0x80 && ps->icase) {
+        ps->error = RX_UNSUPPORTED;
+        return -1;
+    }
+
+    node = rx_byte(ps, c);
+    if (ps->utf8 && c >= 0xC0)
+        while (((unsigned char) *ps->p & 0xC0) == 0x80)
+            node = rx_node(ps, RX_NODE_CAT, node,
+                    rx_byte(ps, (unsigned char) *ps->p++));
+
+    return node;
+}
+
+/* rx_is_op: Determines if ps->p is at an operator, '\' op in a basic
+ * --------- expression and op in an extended one.
+ */
+static int rx_is_op(struct rx_parser *ps, char op)
+{
+    if (ps->extended)
+        return ps->p[0] == op;
+
+    return ps->p[0] == '\\' && ps->p[1] == op;
+}
+
+/* rx_skip_op: Moves ps->p past the operator it's at.
+ * -----------
+ */
+static void rx_skip_op(struct rx_parser *ps)
+{
+    ps->p += ps->extended ? 1 : 2;
+}
+
+/* rx_number: Reads the number of a count, like {m,n}.
+ * ----------
+ *
+ * Return Value: The number, or -1 if there's none.
+ */
+static int rx_number(struct rx_parser *ps)
+{
+    int n = -1;
+
+    while (isdigit((unsigned char) *ps->p)) {
+        n = (n == -1 ? 0 : n * 10) + (*ps->p++ - '0');
+        if (n > RX_DUP_MAX)
+            n = RX_DUP_MAX + 1;
+    }
+
+    return n;
+}
+
+/* rx_interval: Parses a count, ps->p is past the '{'.
+ * ------------
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+static int rx_interval(struct rx_parser *ps, int *min, int *max)
+{
+    *min = rx_number(ps);
+    *max = *min;
+
+    if (*ps->p == ',') {
+        ps->p++;
+        *max = rx_number(ps);
+        if (*min == -1)
+            *min = 0;
+    } else if (*min == -1) {
+        ps->error = RX_ERROR;
+        return -1;
+    }
+
+    if (!rx_is_op(ps, '}') || *min > RX_DUP_MAX || *max > RX_DUP_MAX ||
+            (*max != -1 && *max < *min)) {
+        ps->error = RX_ERROR;
+        return -1;
+    }
+    rx_skip_op(ps);
+
+    return 0;
+}
+
+static int rx_parse_alt(struct rx_parser *ps);
+
+/* rx_parse_atom: Parses what a '*' after it would repeat.
+ * --------------
+ */
+static int rx_parse_atom(struct rx_parser *ps)
+{
+    int c = (unsigned char) *ps->p, node, set;
+
+    if (rx_is_op(ps, '(')) {
+        rx_skip_op(ps);
+        if (++ps->depth > RX_DEPTH_MAX) {
+            ps->error = RX_ERROR;
+            return -1;
+        }
+        if ((node = rx_parse_alt(ps)) == -1)
+            return -1;
+        if (!rx_is_op(ps, ')')) {
+            ps->error = RX_ERROR;
+            return -1;
+        }
+        rx_skip_op(ps);
+        ps->depth--;
+        return node;
+    }
+
+    /* A repeat with nothing to repeat, a basic expression's '*' only gets
+     * here at the start, where it stands for itself */
+    if (c == '*' || (ps->extended && (c == '+' || c == '?' || c == '{')) ||
+            (!ps->extended && rx_is_op(ps, '{'))) {
+        if (ps->extended || c != '*') {
+            ps->error = RX_ERROR;
+            return -1;
+        }
+        ps->p++;
+        return rx_byte(ps, c);
+    }
+
+    switch (c) {
+        case '.':
+            ps->p++;
+            set = rx_set_new(ps);
+            for (c = 1; c < (ps->utf8 ? 0x80 : 0x100); c++)
+                RX_SET_ADD(&ps->sets[set], c);
+            return rx_characters(ps, set, 1);
+        case '[':
+            ps->p++;
+            return rx_bracket(ps);
+        case '\\':
+            ps->p++;
+            return rx_escape(ps);
+    }
+
+    return rx_literal(ps);
+}
+
+/* rx_parse_item: Parses an atom and the repeats after it.
+ * --------------
+ */
+static int rx_parse_item(struct rx_parser *ps)
+{
+    int node, repeat, min, max, repeated = 0;
+
+    if ((node = rx_parse_atom(ps)) == -1)
+        return -1;
+
+    /* In a basic expression, a '*' after an assertion like \b stands for
+     * itself, as it would at the start */
+    if (!ps->extended && ps->nodes[node].type == RX_NODE_ASSERT)
+        return node;
+
+    for (;;) {
+        if (*ps->p == '*') {
+            ps->p++;
+            min = 0;
+            max = -1;
+        } else if (rx_is_op(ps, '+')) {
+            rx_skip_op(ps);
+            min = 1;
+            max = -1;
+        } else if (rx_is_op(ps, '?')) {
+            rx_skip_op(ps);
+            min = 0;
+            max = 1;
+        } else if (rx_is_op(ps, '{')) {
+            rx_skip_op(ps);
+            if (rx_interval(ps, &min, &max) == -1)
+                return -1;
+        } else
+            break;
+
+        /* Basic expressions can't repeat a repeat, extended ones can't
+         * repeat an assertion */
+        if ((repeated && !ps->extended) ||
+                ps->nodes[node].type == RX_NODE_ASSERT) {
+            ps->error = RX_ERROR;
+            return -1;
+        }
+        repeated = 1;
+
+        repeat = rx_node(ps, RX_NODE_REPEAT, node, 0);
+        ps->nodes[repeat].min = min;
+        ps->nodes[repeat].max = max;
+        node = repeat;
+    }
+
+    return node;
+}
+
+/* rx_at_end: Determines if ps->p is at the end of an alternative.
+ * ----------
+ */
+static int rx_at_end(struct rx_parser *ps)
+{
+    return *ps->p == '\0' || rx_is_op(ps, '|') ||
+            (rx_is_op(ps, ')') && (ps->depth > 0 || !ps->extended));
+}
+
+/* rx_is_eol: Determines if the '$' ps->p is at stands for the end of the
+ * ----------  line. In a basic expression, it only does at the end of an
+ *             alternative.
+ */
+static int rx_is_eol(struct rx_parser *ps)
+{
+    int eol;
+
+    if (ps->extended)
+        return 1;
+
+    ps->p++;
+    eol = rx_at_end(ps);
+    ps->p--;
+
+    return eol;
+}
+
+/* rx_parse_cat: Parses an alternative, the items one after the other.
+ * -------------
+ */
+static int rx_parse_cat(struct rx_parser *ps)
+{
+    int node = -1, item, start = 1;
+
+    while (!rx_at_end(ps)) {
+        if (*ps->p == '^' && (ps->extended || start)) {
+            ps->p++;
+            item = rx_node(ps, RX_NODE_ASSERT, RX_ASSERT_BOL, 0);
+            start = 0;
+
+            /* A '*' right after it would repeat nothing */
+            if (ps->extended && (*ps->p == '*' || *ps->p == '+' ||
+                            *ps->p == '?' || *ps->p == '{')) {
+                ps->error = RX_ERROR;
+                return -1;
+            }
+        } else if (*ps->p == '$' && rx_is_eol(ps)) {
+            ps->p++;
+            item = rx_node(ps, RX_NODE_ASSERT, RX_ASSERT_EOL, 0);
+            start = 0;
+        } else {
+            if ((item = rx_parse_item(ps)) == -1)
+                return -1;
+            start = 0;
+        }
+
+        node = node == -1 ? item : rx_node(ps, RX_NODE_CAT, node, item);
+    }
+
+    /* A basic expression's "\)" closes a group that isn't there */
+    if (!ps->extended && ps->depth == 0 && rx_is_op(ps, ')')) {
+        ps->error = RX_ERROR;
+        return -1;
+    }
+
+    return node == -1 ? rx_node(ps, RX_NODE_EMPTY, 0, 0) : node;
+}
+
+/* rx_parse_alt: Parses alternatives, split up by '|'.
+ * -------------
+ */
+static int rx_parse_alt(struct rx_parser *ps)
+{
+    int node, other;
+
+    if ((node = rx_parse_cat(ps)) == -1)
+        return -1;
+
+    while (rx_is_op(ps, '|')) {
+        rx_skip_op(ps);
+        if ((other = rx_parse_cat(ps)) == -1)
+            return -1;
+        node = rx_node(ps, RX_NODE_ALT, node, other);
+    }
+
+    return node;
+}
+
+/* ------------ */
+/* The compiler */
+/* ------------ */
+
+/* rx_size: Works out how many instructions a node compiles to.
+ * --------
+ *
+ * Return Value: The number, or RX_PROGRAM_MAX + 1 if it's more.
+ */
+static long rx_size(const struct rx_parser *ps, int n)
+{
+    const struct rx_node *node = &ps->nodes[n];
+    long long size = 0, one;
+
+    switch (node->type) {
+        case RX_NODE_EMPTY:
+            size = 0;
+            break;
+        case RX_NODE_SET:
+        case RX_NODE_ASSERT:
+            size = 1;
+            break;
+        case RX_NODE_CAT:
+            size = rx_size(ps, node->a) + rx_size(ps, node->b);
+            break;
+        case RX_NODE_ALT:
+            size = rx_size(ps, node->a) + rx_size(ps, node->b) + 2;
+            break;
+        case RX_NODE_REPEAT:
+            one = rx_size(ps, node->a);
+            if (node->max == -1)
+                size = node->min == 0 ? one + 2 : node->min * one + 1;
+            else
+                size = node->min * one + (node->max - node->min) * (one + 1);
+            break;
+    }
+
+    return size > RX_PROGRAM_MAX ? RX_PROGRAM_MAX + 1 : (long) size;
+}
+
+/* rx_inst: Adds an instruction to the program.
+ * --------
+ *
+ * Return Value: Where it is.
+ */
+static int rx_inst(struct rx *rx, enum rx_op op, int x, int y)
+{
+    struct rx_inst *inst = &rx->program[rx->count];
+
+    inst->op = op;
+    inst->x = x;
+    inst->y = y;
+
+    return rx->count++;
+}
+
+/* rx_emit: Compiles a node.
+ * --------
+ */
+static void rx_emit(struct rx *rx, const struct rx_parser *ps, int n)
+{
+    const struct rx_node *node = &ps->nodes[n];
+    int i, split, last = -1, next;
+
+    switch (node->type) {
+        case RX_NODE_EMPTY:
+            break;
+        case RX_NODE_SET:
+            rx_inst(rx, RX_OP_SET, node->a, 0);
+            break;
+        case RX_NODE_ASSERT:
+            rx_inst(rx, RX_OP_ASSERT, node->a, 0);
+            break;
+        case RX_NODE_CAT:
+            rx_emit(rx, ps, node->a);
+            rx_emit(rx, ps, node->b);
+            break;
+        case RX_NODE_ALT:
+            split = rx_inst(rx, RX_OP_SPLIT, rx->count + 1, 0);
+            rx_emit(rx, ps, node->a);
+            last = rx_inst(rx, RX_OP_JMP, 0, 0);
+            rx->program[split].y = rx->count;
+            rx_emit(rx, ps, node->b);
+            rx->program[last].x = rx->count;
+            break;
+        case RX_NODE_REPEAT:
+            if (node->max == -1) {
+                for (i = 1; i < node->min; i++)
+                    rx_emit(rx, ps, node->a);
+
+                if (node->min == 0) {
+                    split = rx_inst(rx, RX_OP_SPLIT, rx->count + 1, 0);
+                    rx_emit(rx, ps, node->a);
+                    rx_inst(rx, RX_OP_JMP, split, 0);
+                    rx->program[split].y = rx->count;
+                } else {
+                    split = rx->count;
+                    rx_emit(rx, ps, node->a);
+                    rx_inst(rx, RX_OP_SPLIT, split, rx->count + 1);
+                }
+                break;
+            }
+
+            for (i = 0; i < node->min; i++)
+                rx_emit(rx, ps, node->a);
+
+            /* The ones that can be left out are nested, like (a(a)?)?, so
+             * each split skips the rest. The splits are chained by y until
+             * where that is is known. */
+            for (i = node->min; i < node->max; i++) {
+                split = rx_inst(rx, RX_OP_SPLIT, rx->count + 1, last);
+                rx_emit(rx, ps, node->a);
+                last = split;
+            }
+
+            for (; last != -1; last = next) {
+                next = rx->program[last].y;
+                rx->program[last].y = rx->count;
+            }
+            break;
+    }
+}
+
+/* rx_prefix: Gets the plain text a node starts with.
+ * ----------
+ *
+ *   literal:  The text is appended to it
+ *   length:   Its length
+ *   only:     Cleared if there's more to the node than the text
+ *
+ * Return Value: 1 if what comes after the node can add to the text.
+ */
+static int rx_prefix(const struct rx_parser *ps, int n, char *literal,
+        int *length, int *only)
+{
+    const struct rx_node *node = &ps->nodes[n];
+    const struct rx_set *set;
+    int c, byte = -1;
+
+    switch (node->type) {
+        case RX_NODE_EMPTY:
+            return 1;
+        case RX_NODE_ASSERT:
+            /* It takes up no room, so the match still starts at the text */
+            *only = 0;
+            return 1;
+        case RX_NODE_CAT:
+            return rx_prefix(ps, node->a, literal, length, only) &&
+                    rx_prefix(ps, node->b, literal, length, only);
+        case RX_NODE_SET:
+            set = &ps->sets[node->a];
+            for (c = 0; c < 256; c++)
+                if (RX_SET_HAS(set, c)) {
+                    if (byte != -1)
+                        break;
+                    byte = c;
+                }
+            if (c == 256 && byte != -1) {
+                literal[(*length)++] = byte;
+                return 1;
+            }
+            break;
+        case RX_NODE_ALT:
+        case RX_NODE_REPEAT:
+            break;
+    }
+
+    *only = 0;
+    return 0;
+}
+
+/* -------- */
+/* The NFA */
+/* -------- */
+
+/* rx_holds: Determines if an assertion holds.
+ * ---------
+ */
+static int rx_holds(enum rx_assertion assertion, const struct rx_where *w)
+{
+    switch (assertion) {
+        case RX_ASSERT_BOL:
+            return w->begin && w->bol;
+        case RX_ASSERT_EOL:
+            return w->end && w->eol;
+        case RX_ASSERT_BEGIN:
+            return w->begin;
+        case RX_ASSERT_END:
+            return w->end;
+        case RX_ASSERT_BOUNDARY:
+            return w->prev_word != w->cur_word;
+        case RX_ASSERT_INSIDE:
+            return w->prev_word == w->cur_word;
+        case RX_ASSERT_WORD_BEGIN:
+            return !w->prev_word && w->cur_word;
+        case RX_ASSERT_WORD_END:
+            return w->prev_word && !w->cur_word;
+    }
+
+    return 0;
+}
+
+/* rx_where: Works out what the assertions see at a place in the text.
+ * ---------
+ */
+static void rx_where(const struct rx *rx, const unsigned char *s,
+        int length, int i, int eflags, struct rx_where *w)
+{
+    w->begin = i == 0;
+    w->end = i == length;
+    w->bol = !(eflags & REG_NOTBOL);
+    w->eol = !(eflags & REG_NOTEOL);
+    w->prev_word = i > 0 && rx_is_word(s[i - 1], rx->utf8);
+    w->cur_word = i < length && rx_is_word(s[i], rx->utf8);
+}
+
+/* rx_add: Adds a thread, and the ones it leads to without matching a byte,
+ * ------- to a list. An instruction already on the list isn't added again,
+ *         the thread there started before this one.
+ *
+ *   pc:     Where the thread is
+ *   start:  Where its match started
+ *   w:      What the assertions see
+ *   list:   The list
+ *   count:  How many threads are on it
+ *
+ * Return Value: How many threads are on it after.
+ */
+static int rx_add(struct rx *rx, int pc, int start,
+        const struct rx_where *w, struct rx_thread *list, int count)
+{
+    const struct rx_inst *inst;
+    int top = 0;
+
+#define RX_PUSH(target) \
+    do { \
+        if (rx->mark[target] != rx->generation) { \
+            rx->mark[target] = rx->generation; \
+            rx->stack[top++] = (target); \
+        } \
+    } while (0)
+
+    RX_PUSH(pc);
+    while (top > 0) {
+        pc = rx->stack[--top];
+        inst = &rx->program[pc];
+
+        switch (inst->op) {
+            case RX_OP_JMP:
+                RX_PUSH(inst->x);
+                break;
+            case RX_OP_SPLIT:
+                RX_PUSH(inst->y);
+                RX_PUSH(inst->x);
+                break;
+            case RX_OP_ASSERT:
+                if (rx_holds(inst->x, w))
+                    RX_PUSH(pc + 1);
+                break;
+            case RX_OP_SET:
+            case RX_OP_MATCH:
+                list[count].pc = pc;
+                list[count].start = start;
+                count++;
+                break;
+        }
+    }
+
+#undef RX_PUSH
+
+    return count;
+}
+
+/* rx_nfa: Finds the leftmost longest match, starting at a place.
+ * -------
+ *
+ * The threads are kept in the order their matches started, a match at
+ * each place in the text being started after the ones before it, so when
+ * two get to the same instruction, the one that started first is kept.
+ * Once a match is found, no more are started and the threads that started
+ * after it are dropped. The rest go on, for a longer match or one that
+ * started first, until there are none.
+ *
+ *   from:  Where to start matching
+ *   so:    Returns where the match starts
+ *   eo:    Returns where it ends
+ *
+ * Return Value: 1 if there's a match, 0 if not.
+ */
+static int rx_nfa(struct rx *rx, const unsigned char *s, int length,
+        int from, int eflags, int *so, int *eo)
+{
+    struct rx_thread *list = rx->list, *next = rx->next_list, *swap;
+    const struct rx_inst *inst;
+    struct rx_where w;
+    int count, next_count, i, k;
+
+    *so = -1;
+    *eo = -1;
+
+    rx_where(rx, s, length, from, eflags, &w);
+    rx->generation++;
+    count = rx_add(rx, 0, from, &w, list, 0);
+
+    for (i = from;; i++) {
+        if (i < length)
+            rx_where(rx, s, length, i + 1, eflags, &w);
+        rx->generation++;
+        next_count = 0;
+
+        for (k = 0; k < count; k++) {
+            if (*so != -1 && list[k].start > *so)
+                break;
+
+            inst = &rx->program[list[k].pc];
+            if (inst->op == RX_OP_MATCH) {
+                if (*so == -1 || list[k].start <= *so) {
+                    *so = list[k].start;
+                    *eo = i;
+                }
+            } else if (i < length && RX_SET_HAS(&rx->sets[inst->x], s[i]))
+                next_count = rx_add(rx, list[k].pc + 1, list[k].start, &w,
+                        next, next_count);
+        }
+
+        if (i == length)
+            break;
+
+        if (*so == -1)
+            next_count = rx_add(rx, 0, i + 1, &w, next, next_count);
+
+        swap = list;
+        list = next;
+        next = swap;
+        count = next_count;
+
+        if (count == 0 && *so != -1)
+            break;
+    }
+
+    return *so != -1;
+}
+
+/* rx_nfa_last: Finds where the last match starts, before a place.
+ * ------------
+ *
+ * Like rx_nfa, but a match is started at each place before the limit, and
+ * none of them stops the others. The threads are kept in the reverse
+ * order, the match started at a place going first, so when two get to the
+ * same instruction, the one that started last is kept: the other can only
+ * go on to the same matches, starting before its. Each byte is looked at
+ * once, however many of the matches overlap.
+ *
+ *   before:  Only matches that start before it count
+ *
+ * Return Value: Where the last match starts, or -1 if there's none.
+ */
+static int rx_nfa_last(struct rx *rx, const unsigned char *s, int length,
+        int before, int eflags)
+{
+    struct rx_thread *list = rx->list, *next = rx->next_list, *swap;
+    const struct rx_inst *inst;
+    struct rx_where w;
+    int last = -1, count, next_count, i, k;
+
+    rx_where(rx, s, length, 0, eflags, &w);
+    rx->generation++;
+    count = rx_add(rx, 0, 0, &w, list, 0);
+
+    for (i = 0;; i++) {
+        if (i < length)
+            rx_where(rx, s, length, i + 1, eflags, &w);
+        rx->generation++;
+        next_count = 0;
+
+        if (i < length && i + 1 < before)
+            next_count = rx_add(rx, 0, i + 1, &w, next, next_count);
+
+        for (k = 0; k < count; k++) {
+            /* The rest started before the last match found */
+            if (list[k].start <= last)
+                break;
+
+            inst = &rx->program[list[k].pc];
+            if (inst->op == RX_OP_MATCH)
+                last = list[k].start;
+            else if (i < length && RX_SET_HAS(&rx->sets[inst->x], s[i]))
+                next_count = rx_add(rx, list[k].pc + 1, list[k].start, &w,
+                        next, next_count);
+        }
+
+        if (i == length)
+            break;
+
+        swap = list;
+        list = next;
+        next = swap;
+        count = next_count;
+
+        if (count == 0 && i + 1 >= before)
+            break;
+    }
+
+    return last;
+}
+
+/* -------- */
+/* The DFA */
+/* -------- */
+
+/* rx_dfa_where: Works out what the assertions see in a DFA state.
+ * -------------
+ *
+ *   context:  The state's context
+ *   c:        The byte after, or -1 at the end of the text
+ */
+static void rx_dfa_where(const struct rx *rx, enum rx_context context,
+        int c, int eflags, struct rx_where *w)
+{
+    w->begin = context == RX_CONTEXT_BOL || context == RX_CONTEXT_NOTBOL;
+    w->end = c == -1;
+    w->bol = context == RX_CONTEXT_BOL;
+    w->eol = !(eflags & REG_NOTEOL);
+    w->prev_word = context == RX_CONTEXT_WORD;
+    w->cur_word = c != -1 && rx_is_word(c, rx->utf8);
+}
+
+/* rx_dfa_state: Gets the DFA state of some instructions.
+ * -------------
+ *
+ * When there are RX_DFA_STATES already, the DFA starts over, and the
+ * states gotten before are gone.
+ *
+ *   kernel:   The instructions, in order
+ *   count:    How many there are
+ *   context:  What's before the state
+ *   flushed:  Returns 1 if the DFA started over
+ *
+ * Return Value: The state's index.
+ */
+static int rx_dfa_state(struct rx *rx, const int *kernel, int count,
+        enum rx_context context, int *flushed)
+{
+    struct rx_state *state;
+    unsigned int hash = context;
+    int i, slot;
+
+    *flushed = 0;
+
+    for (i = 0; i < count; i++)
+        hash = (hash ^ kernel[i]) * 16777619;
+
+    for (slot = hash % RX_DFA_TABLE; rx->table[slot];
+            slot = (slot + 1) % RX_DFA_TABLE) {
+        state = &rx->states[rx->table[slot] - 1];
+        if (state->context == context && state->count == count &&
+                (count == 0 || memcmp(rx->kernels + state->kernel, kernel,
+                                sizeof (int) * count) == 0))
+            return rx->table[slot] - 1;
+    }
+
+    if (rx->states_count == RX_DFA_STATES) {
+        rx->states_count = 0;
+        rx->kernels_count = 0;
+        memset(rx->table, 0, sizeof (rx->table));
+        *flushed = 1;
+
+        for (slot = hash % RX_DFA_TABLE; rx->table[slot];
+                slot = (slot + 1) % RX_DFA_TABLE)
+            ;
+    }
+
+    if (rx->kernels_count + count > rx->kernels_size) {
+        rx->kernels_size = (rx->kernels_count + count) * 2;
+        rx->kernels = cgdb_realloc(rx->kernels,
+                sizeof (int) * rx->kernels_size);
+    }
+
+    state = &rx->states[rx->states_count];
+    state->kernel = rx->kernels_count;
+    state->count = count;
+    state->context = context;
+    state->end[0] = -1;
+    state->end[1] = -1;
+    for (i = 0; i < 256; i++)
+        state->next[i] = RX_DFA_UNKNOWN;
+
+    if (count > 0)
+        memcpy(rx->kernels + rx->kernels_count, kernel, sizeof (int) * count);
+    rx->kernels_count += count;
+    rx->table[slot] = rx->states_count + 1;
+
+    return rx->states_count++;
+}
+
+/* rx_dfa_close: Adds a DFA state's instructions, and the start of the
+ * ------------- program, to rx->list with what they lead to.
+ *
+ * Return Value: How many threads are on it.
+ */
+static int rx_dfa_close(struct rx *rx, int index, const struct rx_where *w)
+{
+    const struct rx_state *state = &rx->states[index];
+    int count = 0, i;
+
+    rx->generation++;
+    for (i = 0; i < state->count; i++)
+        count = rx_add(rx, rx->kernels[state->kernel + i], 0, w,
+                rx->list, count);
+
+    return rx_add(rx, 0, 0, w, rx->list, count);
+}
+
+static int rx_compare(const void *a, const void *b)
+{
+    return *(const int *) a - *(const int *) b;
+}
+
+/* rx_dfa_next: Works out the state after a byte.
+ * ------------
+ *
+ * Return Value: The state, or RX_DFA_MATCHED.
+ */
+static int rx_dfa_next(struct rx *rx, int index, int c)
+{
+    struct rx_where w;
+    int *kernel = rx->stack;
+    int count, size = 0, i, next, flushed;
+    const struct rx_inst *inst;
+
+    rx_dfa_where(rx, rx->states[index].context, c, 0, &w);
+    count = rx_dfa_close(rx, index, &w);
+
+    for (i = 0; i < count; i++) {
+        inst = &rx->program[rx->list[i].pc];
+        if (inst->op == RX_OP_MATCH) {
+            rx->states[index].next[c] = RX_DFA_MATCHED;
+            return RX_DFA_MATCHED;
+        }
+        if (RX_SET_HAS(&rx->sets[inst->x], c))
+            kernel[size++] = rx->list[i].pc + 1;
+    }
+
+    qsort(kernel, size, sizeof (int), rx_compare);
+    next = rx_dfa_state(rx, kernel, size, rx_is_word(c, rx->utf8) ?
+            RX_CONTEXT_WORD : RX_CONTEXT_OTHER, &flushed);
+
+    /* The state it comes from is gone if the DFA started over */
+    if (!flushed)
+        rx->states[index].next[c] = next;
+
+    return next;
+}
+
+/* rx_dfa_end: Determines if a DFA state matches at the end of the text.
+ * -----------
+ */
+static int rx_dfa_end(struct rx *rx, int index, int eflags)
+{
+    struct rx_state *state = &rx->states[index];
+    int noteol = (eflags & REG_NOTEOL) != 0, count, i;
+    struct rx_where w;
+
+    if (state->end[noteol] == -1) {
+        rx_dfa_where(rx, state->context, -1, eflags, &w);
+        count = rx_dfa_close(rx, index, &w);
+
+        state->end[noteol] = 0;
+        for (i = 0; i < count; i++)
+            if (rx->program[rx->list[i].pc].op == RX_OP_MATCH)
+                state->end[noteol] = 1;
+    }
+
+    return state->end[noteol];
+}
+
+/* rx_dfa: Determines if there's a match, starting at a place.
+ * -------
+ *
+ * Return Value: 1 if there is, 0 if not.
+ */
+static int rx_dfa(struct rx *rx, const unsigned char *s, int length,
+        int from, int eflags)
+{
+    enum rx_context context;
+    int index, next, flushed, i;
+
+    if (!rx->states)
+        rx->states = cgdb_malloc(sizeof (struct rx_state) * RX_DFA_STATES);
+
+    if (from == 0)
+        context = (eflags & REG_NOTBOL) ? RX_CONTEXT_NOTBOL : RX_CONTEXT_BOL;
+    else
+        context = rx_is_word(s[from - 1], rx->utf8) ?
+                RX_CONTEXT_WORD : RX_CONTEXT_OTHER;
+
+    index = rx_dfa_state(rx, NULL, 0, context, &flushed);
+
+    for (i = from; i < length; i++) {
+        if ((next = rx->states[index].next[s[i]]) == RX_DFA_UNKNOWN)
+            next = rx_dfa_next(rx, index, s[i]);
+        if (next == RX_DFA_MATCHED)
+            return 1;
+        index = next;
+    }
+
+    return rx_dfa_end(rx, index, eflags);
+}
+
+/* rx_find: Finds plain text in a string.
+ * --------
+ *
+ * The blocks of the string with the text's first and last bytes where they
+ * would be are found 32 or 16 bytes at a time, and only those are compared.
+ *
+ * Return Value: Where the text is, or -1 if it isn't.
+ */
+static int rx_find(const char *text, int length, const char *s, int size)
+{
+    const char *p;
+    unsigned int mask;
+    int i = 0, bit;
+
+    if (length == 1) {
+        p = memchr(s, text[0], size);
+        return p ? p - s : -1;
+    }
+
+#if defined(__AVX2__)
+    {
+        __m256i first = _mm256_set1_epi8(text[0]);
+        __m256i last = _mm256_set1_epi8(text[length - 1]);
+
+        for (; i + length - 1 + 32 <= size; i += 32) {
+            mask = _mm256_movemask_epi8(_mm256_and_si256(
+                            _mm256_cmpeq_epi8(first, _mm256_loadu_si256(
+                                            (const __m256i *) (s + i))),
+                            _mm256_cmpeq_epi8(last, _mm256_loadu_si256(
+                                            (const __m256i *) (s + i +
+                                                    length - 1)))));
+            for (bit = 0; mask; bit++, mask >>= 1)
+                if ((mask & 1) &&
+                        memcmp(s + i + bit + 1, text + 1, length - 2) == 0)
+                    return i + bit;
+        }
+    }
+#endif
+
+#if defined(__SSE2__)
+    {
+        __m128i first = _mm_set1_epi8(text[0]);
+        __m128i last = _mm_set1_epi8(text[length - 1]);
+
+        for (; i + length - 1 + 16 <= size; i += 16) {
+            mask = _mm_movemask_epi8(_mm_and_si128(
+                            _mm_cmpeq_epi8(first, _mm_loadu_si128(
+                                            (const __m128i *) (s + i))),
+                            _mm_cmpeq_epi8(last, _mm_loadu_si128(
+                                            (const __m128i *) (s + i +
+                                                    length - 1)))));
+            for (bit = 0; mask; bit++, mask >>= 1)
+                if ((mask & 1) &&
+                        memcmp(s + i + bit + 1, text + 1, length - 2) == 0)
+                    return i + bit;
+        }
+    }
+#endif
+
+    for (; i + length <= size; i++)
+        if (s[i] == text[0] && memcmp(s + i + 1, text + 1, length - 1) == 0)
+            return i;
+
+    return -1;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* rx_build: Compiles a parsed expression for the linear engine.
+ * ---------
+ *
+ * Return Value: 0 on success, -1 if the program would be too big.
+ */
+static int rx_build(struct rx *rx, struct rx_parser *ps, int root,
+        const char *pattern)
+{
+    long size = rx_size(ps, root);
+
+    if (size > RX_PROGRAM_MAX)
+        return -1;
+
+    rx->program = cgdb_malloc(sizeof (struct rx_inst) * (size + 1));
+    rx_emit(rx, ps, root);
+    rx_inst(rx, RX_OP_MATCH, 0, 0);
+
+    rx->literal = cgdb_malloc(strlen(pattern) + 1);
+    rx->literal_only = 1;
+    rx_prefix(ps, root, rx->literal, &rx->literal_length, &rx->literal_only);
+
+    rx->sets = ps->sets;
+    ps->sets = NULL;
+    rx->utf8 = ps->utf8;
+
+    rx->mark = cgdb_calloc(rx->count, sizeof (unsigned int));
+    rx->stack = cgdb_malloc(sizeof (int) * rx->count);
+    rx->list = cgdb_malloc(sizeof (struct rx_thread) * rx->count);
+    rx->next_list = cgdb_malloc(sizeof (struct rx_thread) * rx->count);
+
+    return 0;
+}
+
+struct rx *rx_compile(const char *pattern, int cflags, int engine)
+{
+    struct rx *rx = cgdb_calloc(1, sizeof (struct rx));
+    struct rx_parser ps;
+    int root;
+
+    rx->nosub = (cflags & REG_NOSUB) != 0;
+
+    if (engine != RX_ENGINE_POSIX) {
+        memset(&ps, 0, sizeof (ps));
+        ps.p = pattern;
+        ps.extended = (cflags & REG_EXTENDED) != 0;
+        ps.icase = (cflags & REG_ICASE) != 0;
+        ps.utf8 = MB_CUR_MAX > 1;
+        ps.multibyte = -1;
+
+        root = rx_parse_alt(&ps);
+        if (root != -1 && *ps.p == '\0' &&
+                rx_build(rx, &ps, root, pattern) == 0) {
+            free(ps.nodes);
+            return rx;
+        }
+
+        free(ps.nodes);
+        free(ps.sets);
+
+        if (engine == RX_ENGINE_LINEAR) {
+            rx_free(rx);
+            return NULL;
+        }
+
+        /* What it can't do is left to the C library */
+        free(rx->program);
+        rx->program = NULL;
+        rx->count = 0;
+    }
+
+    if (regcomp(&rx->t, pattern, cflags) != 0) {
+        regfree(&rx->t);
+        free(rx);
+        return NULL;
+    }
+    rx->posix = 1;
+
+    return rx;
+}
+
+int rx_exec(struct rx *rx, const char *string, size_t nmatch,
+        regmatch_t pmatch[], int eflags)
+{
+    const unsigned char *s = (const unsigned char *) string;
+    int length, from = 0, so, eo;
+    size_t i;
+
+    if (rx->posix)
+        return regexec(&rx->t, string, nmatch, pmatch, eflags);
+
+    length = strlen(string);
+
+    if (rx->literal_length > 0 && (from = rx_find(rx->literal,
+                            rx->literal_length, string, length)) == -1)
+        return REG_NOMATCH;
+
+    if (rx->literal_only) {
+        so = from;
+        eo = from + rx->literal_length;
+    } else {
+        if (!rx_dfa(rx, s, length, from, eflags))
+            return REG_NOMATCH;
+
+        if (rx->nosub || nmatch == 0)
+            return 0;
+
+        rx_nfa(rx, s, length, from, eflags, &so, &eo);
+    }
+
+    if (!rx->nosub && nmatch > 0) {
+        pmatch[0].rm_so = so;
+        pmatch[0].rm_eo = eo;
+        for (i = 1; i < nmatch; i++) {
+            pmatch[i].rm_so = -1;
+            pmatch[i].rm_eo = -1;
+        }
+    }
+
+    return 0;
+}
+
+int rx_exec_last(struct rx *rx, const char *string, int before,
+        regmatch_t * pmatch, int eflags)
+{
+    const unsigned char *s = (const unsigned char *) string;
+    regmatch_t m[1];
+    int length, pos, found = 0, so, eo;
+
+    /* Back references can't be matched in one pass, the C library's
+     * engine is started again just past each match */
+    if (rx->posix) {
+        for (pos = 0; pos < before &&
+                regexec(&rx->t, string + pos, 1, m,
+                        eflags | (pos ? REG_NOTBOL : 0)) == 0;
+                pos = pmatch->rm_so + 1) {
+            if (pos + m[0].rm_so >= before)
+                break;
+
+            pmatch->rm_so = pos + m[0].rm_so;
+            pmatch->rm_eo = pos + m[0].rm_eo;
+            found = 1;
+        }
+
+        return found ? 0 : REG_NOMATCH;
+    }
+
+    length = strlen(string);
+
+    /* Most lines don't match at all */
+    if (before <= 0 || (rx->literal_length > 0 && rx_find(rx->literal,
+                            rx->literal_length, string, length) == -1) ||
+            !rx_dfa(rx, s, length, 0, eflags))
+        return REG_NOMATCH;
+
+    if ((so = rx_nfa_last(rx, s, length, before, eflags)) == -1)
+        return REG_NOMATCH;
+
+    /* The longest of the matches that start there */
+    rx_nfa(rx, s, length, so, eflags, &so, &eo);
+    pmatch->rm_so = so;
+    pmatch->rm_eo = eo;
+
+    return 0;
+}
+
+void rx_free(struct rx *rx)
+{
+    if (!rx)
+        return;
+
+    if (rx->posix)
+        regfree(&rx->t);
+
+    free(rx->program);
+    free(rx->sets);
+    free(rx->literal);
+    free(rx->mark);
+    free(rx->stack);
+    free(rx->list);
+    free(rx->next_list);
+    free(rx->states);
+    free(rx->kernels);
+    free(rx);
+}
@@ -0,0 +1,101 @@
+#ifndef _RX_H_
+#define _RX_H_
+
+/* rx.h:
+ * -----
+ *
+ * The regular expressions cgdb searches with. They're compiled and
+ * matched like regcomp and regexec, with the same flags, but by default
+ * with an engine that only ever looks at each byte of the text a fixed
+ * number of times, however the pattern is written. A pattern like
+ * (a*)*b can't make it take longer than a plain one, and one starting
+ * with plain text is looked for with SIMD first.
+ *
+ * Only back references need backtracking, so in RX_ENGINE_AUTO a pattern
+ * with one is handed to the C library's regcomp instead.
+ *
+ * Matching changes the compiled expression, so like a regex_t, only one
+ * thread at a time can use each one.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif /* HAVE_SYS_TYPES_H */
+
+#if HAVE_REGEX_H
+#include <regex.h>
+#endif /* HAVE_REGEX_H */
+
+/* --------------- */
+/* Data Structures */
+/* --------------- */
+
+/* The engines, the values of the regexpengine option */
+enum rx_engine {
+    RX_ENGINE_AUTO = 0,         /* The linear one, unless it can't */
+    RX_ENGINE_POSIX = 1,        /* The C library's */
+    RX_ENGINE_LINEAR = 2        /* Only the linear one */
+};
+
+/* A compiled regular expression, see rx_compile */
+struct rx;
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* rx_compile: Compiles a regular expression.
+ * -----------
+ *
+ *   pattern:  The regular expression
+ *   cflags:   REG_EXTENDED, REG_ICASE and REG_NOSUB, as for regcomp
+ *   engine:   The engine to match it with, an enum rx_engine
+ *
+ * Return Value: The compiled expression, which must be freed with rx_free,
+ *               or NULL if it doesn't compile.
+ */
+struct rx *rx_compile(const char *pattern, int cflags, int engine);
+
+/* rx_exec: Matches a compiled regular expression to a string.
+ * --------
+ *
+ *   rx:      The expression
+ *   string:  The string
+ *   nmatch:  The size of pmatch
+ *   pmatch:  Returns the match, as for regexec. Only the match of the whole
+ *            expression is found, the ones of its groups are set to -1.
+ *   eflags:  REG_NOTBOL and REG_NOTEOL, as for regexec
+ *
+ * Return Value: 0 if it matched, REG_NOMATCH if not.
+ */
+int rx_exec(struct rx *rx, const char *string, size_t nmatch,
+        regmatch_t pmatch[], int eflags);
+
+/* rx_exec_last: Finds the last match in a string that starts before a
+ * ------------- place, for a search backwards.
+ *
+ *   rx:      The expression
+ *   string:  The string
+ *   before:  Only matches that start before this offset count
+ *   pmatch:  Returns the longest of the matches that start last
+ *   eflags:  REG_NOTBOL and REG_NOTEOL, as for regexec
+ *
+ *  The string is only looked at once, unless the C library's engine
+ *  matches the expression.
+ *
+ * Return Value: 0 if it matched, REG_NOMATCH if not.
+ */
+int rx_exec_last(struct rx *rx, const char *string, int before,
+        regmatch_t * pmatch, int eflags);
+
+/* rx_free: Frees a compiled regular expression.
+ * --------
+ */
+void rx_free(struct rx *rx);
+
+#endif /* _RX_H_ */
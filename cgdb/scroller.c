@@ -24,90 +24,540 @@
 #include <string.h>
 #endif /* HAVE_STRING_H */
 
+#if HAVE_LIMITS_H
+#include <limits.h>
+#endif /* HAVE_LIMITS_H */
+
+#if HAVE_REGEX_H
+#include <regex.h>
+#endif /* HAVE_REGEX_H */
+
 /* Local Includes */
 #include "cgdb.h"
 #include "cgdbrc.h"
 #include "scroller.h"
+#include "highlight.h"
+#include "highlight_groups.h"
+#include "sys_util.h"
+#include "utf8.h"
+#include "spill.h"
+
+/* The size of the chunks that hold the lines of the buffer */
+#define SCR_CHUNK_SIZE 65536
+
+/* The number of lines the buffer starts out with room for */
+#define SCR_INITIAL_LINES 64
+
+/* Rounds up an offset into a chunk, so runs can be stored at it */
+#define SCR_ALIGN(n) (((n) + sizeof (int) - 1) & ~(sizeof (int) - 1))
+
+/* A piece of a line drawn with the same colors. The ANSI escape sequences
+ * that set the colors are left in the line, to be shown when the ansicodes
+ * option is off, and the runs skip over them. */
+struct scroller_run {
+    int start;                  /* Index of the first byte to draw */
+    int length;                 /* Number of bytes */
+    int attrs;                  /* The attributes to draw them with */
+    int fore_color;             /* -1 for the default, or HL_COLOR_RGB | rgb */
+    int back_color;             /* -1 for the default, or HL_COLOR_RGB | rgb */
+};
+
+/* The most numbers an escape sequence can set the colors with */
+#define SCR_SGR_PARAMS 16
+
+/* The lines a search goes through between checks for a key */
+#define SCR_SEARCH_CHECK 4096
+
+/* The lines copied into a chunk follow it in memory, each one's runs and
+ * then its text */
+struct scroller_chunk {
+    int lines;                  /* The lines in the buffer that are in it */
+    size_t used;                /* Bytes used */
+    size_t size;                /* Bytes allocated */
+};
 
 /* --------------- */
 /* Local Functions */
 /* --------------- */
 
-/* count: Count the occurrences of a character c in a string s.
- * ------
+/* line: Gets a line of the buffer.
+ * -----
+ *
+ *   r:  The line, 0 is the oldest one kept
+ */
+static struct scroller_line *line(struct scroller *scr, int r)
+{
+    return &scr->lines[(scr->first + r) % scr->size];
+}
+
+/* spilled: Gets the number of lines the buffer dropped that are kept.
+ * --------
+ */
+static int spilled(struct scroller *scr)
+{
+    return scr->spill ? spill_count(scr->spill) : 0;
+}
+
+/* any_line: Gets a line of the buffer, or one that was spilled.
+ * ---------
  *
- *   s:  String to search
- *   c:  Character to search for
+ *   r:    The line, below 0 for one in the spill
+ *   tmp:  Filled in for a spilled line, which is valid until the next one
+ *         is read
+ */
+static struct scroller_line *any_line(struct scroller *scr, int r,
+        struct scroller_line *tmp)
+{
+    const char *text = NULL;
+    int length = 0;
+
+    if (r >= 0)
+        return line(scr, r);
+
+    if (scr->spill)
+        text = spill_get(scr->spill, spilled(scr) + r, &length);
+
+    tmp->text = (char *) (text ? text : "");
+    tmp->chunk = NULL;
+    tmp->runs = NULL;
+    tmp->nruns = 0;
+    tmp->length = text ? length : 0;
+    tmp->visible = tmp->columns = 0;
+
+    return tmp;
+}
+
+/* release_line: Frees the text of a line.
+ * -------------
  *
- * Return Value:  Number of occurrences of c in s.
+ * A chunk goes once no line is left in it, unless lines are still being
+ * copied into it.
  */
-static int count(const char *s, char c)
+static void release_line(struct scroller *scr, struct scroller_line *l)
 {
-    int rv = 0;
-    char *x = strchr(s, c);
+    if (!l->chunk)
+        free(l->text);
+    else if (--l->chunk->lines == 0 && l->chunk != scr->chunk)
+        free(l->chunk);
+
+    l->text = NULL;
+    l->chunk = NULL;
+    l->runs = NULL;
+    l->nruns = 0;
+}
 
-    while (x) {
-        rv++;
-        x = strchr(x + 1, c);
+/* sgr_color: Reads the color of a 38 or 48 code, 5;N for a color of the
+ * ---------- 256 color palette, or 2;R;G;B for a 24 bit one.
+ *
+ *   params:  The numbers after the 38 or 48
+ *   count:   How many there are
+ *   color:   Set to the color
+ *
+ * Return Value:  How many of the numbers it used.
+ */
+static int sgr_color(const int *params, int count, int *color)
+{
+    int i, rgb = 0;
+
+    if (count >= 2 && params[0] == 5) {
+        if (params[1] >= 0 && params[1] <= 255)
+            *color = params[1];
+        return 2;
     }
 
-    return rv;
+    if (count >= 4 && params[0] == 2) {
+        for (i = 1; i < 4; i++)
+            rgb = (rgb << 8) |
+                    (params[i] < 0 ? 0 : params[i] > 255 ? 255 : params[i]);
+        *color = HL_COLOR_RGB | rgb;
+        return 4;
+    }
+
+    return count;
+}
+
+/* apply_sgr: Sets up a run with the numbers of an escape sequence ending
+ * ---------- in 'm'.
+ *
+ *   run:     The run
+ *   params:  The numbers, separated by ';' in the sequence
+ *   count:   How many there are
+ */
+static void apply_sgr(struct scroller_run *run, const int *params, int count)
+{
+    int i, code;
+
+    for (i = 0; i < count; i++) {
+        code = params[i];
+
+        if (code == 0) {
+            run->attrs = A_NORMAL;
+            run->fore_color = run->back_color = -1;
+        } else if (code == 1)
+            run->attrs |= A_BOLD;
+        else if (code == 2)
+            run->attrs |= A_DIM;
+        else if (code == 4)
+            run->attrs |= A_UNDERLINE;
+        else if (code == 5)
+            run->attrs |= A_BLINK;
+        else if (code == 7)
+            run->attrs |= A_REVERSE;
+        else if (code >= 30 && code <= 37)
+            run->fore_color = code % 10;
+        else if (code == 38)
+            i += sgr_color(params + i + 1, count - i - 1, &run->fore_color);
+        else if (code == 39)
+            run->fore_color = -1;
+        else if (code >= 40 && code <= 47)
+            run->back_color = code % 10;
+        else if (code == 48)
+            i += sgr_color(params + i + 1, count - i - 1, &run->back_color);
+        else if (code == 49)
+            run->back_color = -1;
+        else if (code >= 90 && code <= 97) {
+            run->fore_color = code % 10;
+            run->attrs |= A_BOLD;
+        } else if (code >= 100 && code <= 107) {
+            run->back_color = code % 10;
+            run->attrs |= A_BOLD;
+        }
+    }
+}
+
+/* parse_runs: Splits a line into the runs its escape sequences set up.
+ * -----------
+ *
+ * A run starts at each '['. Those that start an escape sequence are drawn
+ * in the colors it sets, the rest in the default colors.
+ *
+ *   text:  The line
+ *   runs:  Filled in with the runs, there's at most one more than there
+ *          are '[' in text
+ *
+ * Return Value:  The number of runs, or 0 if the line has no escape
+ *                sequences and can be drawn as it is.
+ */
+static int parse_runs(const char *text, struct scroller_run *runs)
+{
+    const char *segment_start = text, *segment_end;
+    const char *line_end = text + strlen(text);
+    char *current_char;
+    int params[SCR_SGR_PARAMS];
+    int count = 0, colored = 0, nparams;
+
+    while (segment_start < line_end) {
+        segment_end = strchr(segment_start + 1, '[');
+        if (segment_end == NULL)
+            segment_end = line_end;
+
+        runs[count].attrs = A_NORMAL;
+        runs[count].fore_color = -1;
+        runs[count].back_color = -1;
+
+        current_char = (char *) segment_start;
+        if (*current_char == '[') {
+            current_char++;
+            nparams = 0;
+            while (nparams < SCR_SGR_PARAMS) {
+                params[nparams++] = strtol(current_char, &current_char, 10);
+                if (*current_char != ';')
+                    break;
+                current_char++;
+            }
+
+            /* We have a format sequence */
+            if (*current_char == 'm') {
+                apply_sgr(&runs[count], params, nparams);
+
+                segment_start = current_char + 1;
+                colored = 1;
+            }
+        }
+
+        runs[count].start = segment_start - text;
+        runs[count].length = segment_end - segment_start;
+        count++;
+
+        segment_start = segment_end;
+    }
+
+    return colored ? count : 0;
+}
+
+/* max_runs: Gets the most runs parse_runs can split a line into.
+ * ---------
+ */
+static int max_runs(const char *text)
+{
+    int count = 1;
+
+    while ((text = strchr(text, '[')) != NULL) {
+        count++;
+        text++;
+    }
+
+    return count;
+}
+
+/* runs_columns: Gets the columns the runs of a line take up.
+ * -------------
+ */
+static int runs_columns(const char *text, const struct scroller_run *runs,
+        int nruns)
+{
+    int columns = 0, i;
+
+    for (i = 0; i < nruns; i++)
+        columns += utf8_columns(text + runs[i].start, runs[i].length);
+
+    return columns;
+}
+
+/* line_columns: Gets the columns a line takes up, with its escape
+ * ------------- sequences shown.
+ */
+static int line_columns(struct scroller_line *l)
+{
+    /* Only the lines in a chunk are complete */
+    if (l->chunk)
+        return l->columns;
+
+    return utf8_columns(l->text, l->length);
+}
+
+/* archive_line: Copies the last line into a chunk, as it's complete.
+ * -------------
+ *
+ * The escape sequences in the line are parsed here once, instead of each
+ * time it's drawn.
+ */
+static void archive_line(struct scroller *scr)
+{
+    struct scroller_line *l = line(scr, scr->length - 1);
+    struct scroller_chunk *chunk = scr->chunk;
+    struct scroller_run *runs;
+    size_t length = l->length + 1;
+    size_t needed, size;
+    char *text;
+    int nruns;
+
+    runs = cgdb_malloc(sizeof (struct scroller_run) * max_runs(l->text));
+    nruns = parse_runs(l->text, runs);
+
+    /* The escape sequences take up no room */
+    l->columns = utf8_columns(l->text, l->length);
+    l->visible = nruns > 0 ? runs_columns(l->text, runs, nruns) : l->columns;
+    needed = SCR_ALIGN(chunk ? chunk->used : 0) - (chunk ? chunk->used : 0) +
+            sizeof (struct scroller_run) * nruns + length;
+
+    if (!chunk || chunk->size - chunk->used < needed) {
+        /* The old chunk is freed with its last line */
+        if (chunk && chunk->lines == 0)
+            free(chunk);
+
+        needed = sizeof (struct scroller_run) * nruns + length;
+        size = needed > SCR_CHUNK_SIZE ? needed : SCR_CHUNK_SIZE;
+        chunk = cgdb_malloc(sizeof (struct scroller_chunk) + size);
+        chunk->lines = 0;
+        chunk->used = 0;
+        chunk->size = size;
+        scr->chunk = chunk;
+    }
+
+    if (nruns > 0) {
+        chunk->used = SCR_ALIGN(chunk->used);
+        l->runs = (struct scroller_run *) ((char *) (chunk + 1) + chunk->used);
+        memcpy(l->runs, runs, sizeof (struct scroller_run) * nruns);
+        chunk->used += sizeof (struct scroller_run) * nruns;
+    }
+    l->nruns = nruns;
+    free(runs);
+
+    text = (char *) (chunk + 1) + chunk->used;
+    memcpy(text, l->text, length);
+    chunk->used += length;
+    chunk->lines++;
+
+    free(l->text);
+    l->text = text;
+    l->chunk = chunk;
+}
+
+/* drop_row: Moves a line number past the line drop_first dropped.
+ * ---------
+ *
+ *   r:  The line number, set to the oldest line if it was the one dropped
+ *
+ * Return Value: 0 if it was the line dropped, 1 otherwise.
+ */
+static int drop_row(struct scroller *scr, int *r)
+{
+    /* The spill was just forgotten */
+    if (*r < -spilled(scr)) {
+        *r = 0;
+        return 0;
+    }
+
+    if (*r > -spilled(scr)) {
+        (*r)--;
+        return 1;
+    }
+
+    return 0;
+}
+
+/* drop_first: Forgets the oldest line of the buffer.
+ * -----------
+ */
+static void drop_first(struct scroller *scr)
+{
+    struct scroller_line *l = line(scr, 0);
+
+    /* The line is kept in the spill, which is forgotten when it's off */
+    if (cgdbrc_get(CGDBRC_SCROLLSPILL)->variant.int_val) {
+        if (!scr->spill)
+            scr->spill = spill_new();
+
+        if (scr->spill && spill_add(scr->spill, l->text, l->length) == -1) {
+            spill_free(scr->spill);
+            scr->spill = NULL;
+        }
+    } else if (scr->spill) {
+        spill_free(scr->spill);
+        scr->spill = NULL;
+    }
+
+    release_line(scr, l);
+    scr->first = (scr->first + 1) % scr->size;
+    scr->length--;
+
+    /* Everything shown moves up a line */
+    if (!drop_row(scr, &scr->current.r))
+        scr->current.c = 0;
+    if (!drop_row(scr, &scr->match.r))
+        scr->match.on = 0;
+    if (!drop_row(scr, &scr->search.r)) {
+        scr->search.c = 0;
+        scr->search.start = 0;
+        scr->search.end = INT_MAX;
+    }
+}
+
+/* push_line: Adds a new last line to the buffer.
+ * ----------
+ *
+ * The oldest lines are dropped to stay within the scrollback option, 0
+ * keeps every line. The ring grows until it's that big.
+ *
+ *   text:  The line, the buffer takes it over
+ */
+static void push_line(struct scroller *scr, char *text)
+{
+    int capacity = cgdbrc_get(CGDBRC_SCROLLBACK)->variant.int_val;
+    struct scroller_line *lines;
+    int size, i;
+
+    if (capacity > 0) {
+        while (scr->length >= capacity)
+            drop_first(scr);
+    }
+
+    if (scr->length == scr->size) {
+        size = scr->size * 2;
+        if (capacity > 0 && size > capacity)
+            size = capacity;
+
+        /* Put the lines back in order at the start of the new ring */
+        lines = cgdb_malloc(sizeof (struct scroller_line) * size);
+        for (i = 0; i < scr->length; i++)
+            lines[i] = *line(scr, i);
+
+        free(scr->lines);
+        scr->lines = lines;
+        scr->size = size;
+        scr->first = 0;
+    }
+
+    scr->length++;
+    line(scr, scr->length - 1)->text = text;
+    line(scr, scr->length - 1)->chunk = NULL;
+    line(scr, scr->length - 1)->runs = NULL;
+    line(scr, scr->length - 1)->nruns = 0;
+    line(scr, scr->length - 1)->length = strlen(text);
+    line(scr, scr->length - 1)->visible = 0;
+    line(scr, scr->length - 1)->columns = 0;
+    scr->last_size = line(scr, scr->length - 1)->length + 1;
 }
 
-/* parse: Translates special characters in a string.  (i.e. backspace, tab...)
- * ------
+/* append: Adds text to the last line, translating special characters as it
+ * -------  goes.  (i.e. backspace, tab...)
  *
- *   buf:  The string to parse
+ * The last line grows by doubling, so a line written a bit at a time is
+ * only copied a few times.
  *
- * Return Value:  A newly allocated copy of buf, with modifications made.
+ *   buf:     The text to add
+ *   length:  The number of bytes of buf to add
  */
-static char *parse(struct scroller *scr, const char *orig, const char *buf)
+static void append(struct scroller *scr, const char *buf, int length)
 {
     const int tab_size = 8;
-    int length = strlen(orig) + strlen(buf) + (tab_size - 1) * count(buf, '\t');
-    char *rv = (char *) malloc(length + 1);
-    int i, j;
+    struct scroller_line *l = line(scr, scr->length - 1);
+    size_t needed = l->length + length + 1;
+    char *rv;
+    int i, j, column;
 
-    /* Zero out the string */
-    memset(rv, 0, length + 1);
-    strcpy(rv, orig);
+    for (j = 0; j < length; j++)
+        if (buf[j] == '\t')
+            needed += tab_size - 1;
+
+    if (needed > scr->last_size) {
+        scr->last_size = scr->last_size * 2 > needed ?
+                scr->last_size * 2 : needed;
+        l->text = cgdb_realloc(l->text, scr->last_size);
+    }
+
+    rv = l->text;
     i = scr->current.pos;
 
     /* Expand special characters */
-    for (j = 0; j < strlen(buf); j++) {
+    for (j = 0; j < length; j++) {
         switch (buf[j]) {
                 /* Backspace/Delete -> Erase last character */
             case 8:
             case 127:
-                if (i > 0)
-                    i--;
+                i = utf8_prev(rv, i);
                 break;
-                /* Tab -> Translating to spaces */
+                /* Tab -> Translating to spaces, up to the next tab stop */
             case '\t':
+                column = utf8_columns(rv, i);
                 do
                     rv[i++] = ' ';
-                while (i % tab_size != 0);
+                while (++column % tab_size != 0);
                 break;
                 /* Carriage return -> Move back to the beginning of the line */
             case '\r':
                 i = 0;
                 break;
-                /* Default case -> Only keep printable characters */
+                /* Default case -> Only keep printable characters, and
+                 * the bytes of UTF-8 characters */
             default:
-                if (isprint((int) buf[j])) {
+                if ((buf[j] & 0x80) || isprint((unsigned char) buf[j])) {
                     rv[i] = buf[j];
                     i++;
                 }
                 break;
         }
+
+        if (i > l->length)
+            l->length = i;
     }
 
     scr->current.pos = i;
     /* Remove trailing space from the line */
-    for (j = strlen(rv) - 1; j > i && isspace((int) rv[j]); j--);
-    rv[j + 1] = 0;
-
-    return realloc(rv, strlen(rv) + 1);
+    for (j = l->length - 1; j > i && isspace((unsigned char) rv[j]); j--);
+    l->length = j + 1;
+    rv[l->length] = 0;
 }
 
 /* ----------------- */
@@ -126,12 +576,18 @@ struct scroller *scr_new(int pos_r, int pos_c, int height, int width)
     rv->current.r = 0;
     rv->current.c = 0;
     rv->current.pos = 0;
+    rv->match.on = 0;
+    rv->search.active = 0;
     rv->win = newwin(height, width, pos_r, pos_c);
 
     /* Start with a single (blank) line */
-    rv->buffer = malloc(sizeof (char *));
-    rv->buffer[0] = strdup("");
-    rv->length = 1;
+    rv->lines = cgdb_malloc(sizeof (struct scroller_line) * SCR_INITIAL_LINES);
+    rv->size = SCR_INITIAL_LINES;
+    rv->first = 0;
+    rv->length = 0;
+    rv->chunk = NULL;
+    rv->spill = NULL;
+    push_line(rv, cgdb_strdup(""));
 
     return rv;
 }
@@ -141,11 +597,11 @@ void scr_free(struct scroller *scr)
     int i;
 
     /* Release the buffer */
-    if (scr->length) {
-        for (i = 0; i < scr->length; i++)
-            free(scr->buffer[i]);
-        free(scr->buffer);
-    }
+    for (i = 0; i < scr->length; i++)
+        release_line(scr, line(scr, i));
+    free(scr->chunk);
+    free(scr->lines);
+    spill_free(scr->spill);
     delwin(scr->win);
 
     /* Release the scroller object */
@@ -154,6 +610,7 @@ void scr_free(struct scroller *scr)
 
 void scr_up(struct scroller *scr, int nlines)
 {
+    struct scroller_line tmp;
     int height, width;
     int length;
     int i;
@@ -172,9 +629,10 @@ void scr_up(struct scroller *scr, int nlines)
 
         /* Else, decrease the current row number, and set column accordingly */
         else {
-            if (scr->current.r > 0) {
+            if (scr->current.r > -spilled(scr)) {
                 scr->current.r--;
-                if ((length = strlen(scr->buffer[scr->current.r])) > width)
+                if ((length = line_columns(any_line(scr, scr->current.r,
+                                        &tmp))) > width)
                     scr->current.c = ((length - 1) / width) * width;
             } else {
                 /* At top */
@@ -186,6 +644,7 @@ void scr_up(struct scroller *scr, int nlines)
 
 void scr_down(struct scroller *scr, int nlines)
 {
+    struct scroller_line tmp;
     int height, width;
     int length;
     int i;
@@ -199,7 +658,7 @@ void scr_down(struct scroller *scr, int nlines)
 
     for (i = 0; i < nlines; i++) {
         /* If the current line wraps to the next, then advance column number */
-        length = strlen(scr->buffer[scr->current.r]);
+        length = line_columns(any_line(scr, scr->current.r, &tmp));
         if (scr->current.c < length - width)
             scr->current.c += width;
 
@@ -218,10 +677,95 @@ void scr_down(struct scroller *scr, int nlines)
 
 void scr_home(struct scroller *scr)
 {
-    scr->current.r = 0;
+    scr->current.r = -spilled(scr);
     scr->current.c = 0;
 }
 
+void scr_search_init(struct scroller *scr)
+{
+    scr->search.active = 1;
+    scr->search.r = scr->current.r;
+    scr->search.c = scr->current.c;
+
+    /* A search that's not past a match skips the line it starts on */
+    if (scr->match.on && scr->match.r == scr->current.r) {
+        scr->search.start = scr->match.start;
+        scr->search.end = scr->match.end;
+    } else {
+        scr->search.start = 0;
+        scr->search.end = INT_MAX;
+    }
+}
+
+int scr_search(struct scroller *scr, const char *regex, int opt,
+        int direction, int icase)
+{
+    struct scroller_line tmp;
+    regmatch_t match[1];
+    struct rx *t;
+    int first = -spilled(scr), count = scr->length + spilled(scr);
+    int start, col, total, k, r = 0, found = 0;
+
+    if (!scr->search.active)
+        scr_search_init(scr);
+    if (opt == 2)
+        scr->search.active = 0;
+
+    /* Each search starts over from where the first one did */
+    scr->current.r = scr->search.r;
+    scr->current.c = scr->search.c;
+    scr->match.on = 0;
+
+    if (!regex || !*regex)
+        return 0;
+
+    if (!(t = hl_regex_compile(regex, hl_regex_cflags(icase))))
+        return -1;
+
+    start = scr->search.r - first;
+    col = direction ? scr->search.end : scr->search.start;
+
+    /* The lines are tried in order, wrapping around at the end (or start) */
+    if (cgdbrc_get(CGDBRC_WRAPSCAN)->variant.int_val)
+        total = count;
+    else
+        total = direction ? count - start : start + 1;
+
+    for (k = 0; k < total && !found; k++) {
+        /* A key pressed during a long search gets handled instead */
+        if (k > 0 && k % SCR_SEARCH_CHECK == 0 && hl_regex_interrupted())
+            return 0;
+
+        r = (direction ? (start + k) % count :
+                (start - k + count) % count) + first;
+        found = hl_regex_line(t, any_line(scr, r, &tmp)->text, k == 0, col,
+                direction, match);
+    }
+
+    if (!found)
+        return 0;
+
+    scr->current.r = r;
+    scr->current.c = 0;
+    scr->match.on = 1;
+    scr->match.r = r;
+    scr->match.start = match[0].rm_so;
+    scr->match.end = match[0].rm_eo;
+
+    return 1;
+}
+
+int scr_scrolled(struct scroller *scr)
+{
+    int height, width;
+
+    getmaxyx(scr->win, height, width);
+
+    return scr->current.r < scr->length - 1 ||
+            scr->current.c < (line_columns(line(scr, scr->current.r)) /
+            width) * width;
+}
+
 void scr_end(struct scroller *scr)
 {
     int height, width;
@@ -229,53 +773,35 @@ void scr_end(struct scroller *scr)
     getmaxyx(scr->win, height, width);
 
     scr->current.r = scr->length - 1;
-    scr->current.c = (strlen(scr->buffer[scr->current.r]) / width) * width;
+    scr->current.c = (line_columns(line(scr, scr->current.r)) / width) * width;
+    scr->match.on = 0;
 }
 
 void scr_add(struct scroller *scr, const char *buf)
 {
-    int distance;               /* Distance to next new line character */
-    int length;                 /* Length of the current line */
-    char *x;                    /* Pointer to next new line character */
-
-    /* Find next newline in the string */
-    x = strchr(buf, '\n');
-    length = strlen(scr->buffer[scr->length - 1]);
-    distance = x ? x - buf : strlen(buf);
-
-    /* Append to the last line in the buffer */
-    if (distance > 0) {
-        char *temp = scr->buffer[scr->length - 1];
-        char *buf2 = malloc(distance + 1);
-
-        strncpy(buf2, buf, distance);
-        buf2[distance] = 0;
-        scr->buffer[scr->length - 1] = parse(scr, temp, buf2);
-        free(temp);
-        free(buf2);
-    }
+    scr_add_length(scr, buf, strlen(buf));
+}
 
-    /* Create additional lines if buf contains newlines */
-    while (x != NULL) {
-        char *newbuf;
+void scr_add_length(struct scroller *scr, const char *buf, size_t length)
+{
+    const char *x;              /* Pointer to next new line character */
+    const char *end = buf + length;
 
-        buf = x + 1;
-        x = strchr(buf, '\n');
-        distance = x ? x - buf : strlen(buf);
+    for (;;) {
+        /* Append to the last line in the buffer, up to the next newline */
+        x = memchr(buf, '\n', end - buf);
+        append(scr, buf, (x ? x : end) - buf);
 
-        /* Create a new buffer that stops at the next newline */
-        newbuf = malloc(distance + 1);
-        memset(newbuf, 0, distance + 1);
-        strncpy(newbuf, buf, distance);
+        if (x == NULL)
+            break;
 
-        /* Expand the buffer */
-        scr->length++;
-        scr->buffer = realloc(scr->buffer, sizeof (char *) * scr->length);
+        /* The last line is complete */
+        archive_line(scr);
         scr->current.pos = 0;
 
         /* Add the new line */
-        scr->buffer[scr->length - 1] = parse(scr, "", newbuf);
-        free(newbuf);
+        push_line(scr, cgdb_strdup(""));
+        buf = x + 1;
     }
 
     scr_end(scr);
@@ -288,44 +814,123 @@ void scr_move(struct scroller *scr, int pos_r, int pos_c, int height, int width)
     wclear(scr->win);
 }
 
-int get_line_height(char* line, int width)
+/* draw_text: Draws part of some text.
+ * ----------
+ *
+ *   text:    The text
+ *   length:  Its length, in bytes
+ *   skip:    The number of columns to leave out at the start
+ *   count:   The most columns to draw after them
+ *
+ * Return Value:  The number of columns drawn.
+ */
+static int draw_text(WINDOW * win, const char *text, int length, int skip,
+        int count)
 {
-	char* current_char = line;
-	int length = 0;
-	while(*current_char!='\0')
-	{
-		if(cgdbrc_get(CGDBRC_ANSI_CODES)->variant.int_val && *current_char == '[')
-		{
-			char* escape_char = current_char + 1;
-			int i;
-			for(i=0; *current_char && i<2; ++i)
-			{
-				strtol(escape_char, &escape_char, 10);
-				if(*escape_char == ';')
-					escape_char++;
-			}
-			if(*escape_char == 'm') // We have a format sequence so don't include
-			{
-				current_char = escape_char + 1;
-				continue;
-			}
-		}
-		length++;
-		current_char++;
-	}
-	int height = 1;
-	while((length -= width) > 0)
-		++height;
-	return height;
+    int start, columns;
+
+    start = utf8_column_bytes(text, length, skip, NULL);
+    length = utf8_column_bytes(text + start, length - start, count, &columns);
+    waddnstr(win, text + start, length);
+
+    return columns;
 }
 
-void scr_refresh(struct scroller *scr, int focus)
+/* draw_line: Draws part of a line.
+ * ----------
+ *
+ *   text:   The line
+ *   runs:   The runs of the line, from parse_runs
+ *   nruns:  The number of runs, 0 to draw the line as it is
+ *   skip:   The number of columns to leave out at the start
+ *   count:  The most columns to draw after them
+ */
+static void draw_line(WINDOW * win, const char *text,
+        const struct scroller_run *runs, int nruns, int skip, int count)
+{
+    int attrs, columns, i;
+
+    if (nruns == 0) {
+        draw_text(win, text, strlen(text), skip, count);
+        return;
+    }
+
+    for (i = 0; i < nruns && count > 0; i++) {
+        columns = utf8_columns(text + runs[i].start, runs[i].length);
+        if (skip >= columns) {
+            skip -= columns;
+            continue;
+        }
+
+        attrs = COLOR_PAIR(hl_groups_get_color_pair(hl_groups_instance,
+                        runs[i].fore_color, runs[i].back_color)) | runs[i].attrs;
+
+        wattron(win, attrs);
+        count -= draw_text(win, text + runs[i].start, runs[i].length, skip,
+                count);
+        wattroff(win, attrs);
+
+        skip = 0;
+    }
+}
+
+/* byte_columns: Gets the columns drawn before a byte of a line.
+ * -------------
+ *
+ *   text:   The line
+ *   runs:   The runs of the line, from parse_runs
+ *   nruns:  The number of runs, 0 if the line is drawn as it is
+ *   bytes:  The byte
+ */
+static int byte_columns(const char *text, const struct scroller_run *runs,
+        int nruns, int bytes)
+{
+    int columns = 0, i;
+
+    if (nruns == 0)
+        return utf8_columns(text, bytes);
+
+    /* The escape sequences between the runs aren't drawn */
+    for (i = 0; i < nruns && runs[i].start < bytes; i++)
+        columns += utf8_columns(text + runs[i].start,
+                runs[i].start + runs[i].length < bytes ?
+                runs[i].length : bytes - runs[i].start);
+
+    return columns;
+}
+
+/* draw_match: Highlights the match of a search, over a line draw_line drew.
+ * -----------
+ *
+ *   top:         The row the line was drawn at
+ *   start, end:  The columns of the match
+ *   skip:        The columns draw_line left out at the start
+ *   count:       The most columns it drew after them
+ */
+static void draw_match(WINDOW * win, int top, int width, int start, int end,
+        int skip, int count)
+{
+    int attr = hl_groups_get_attrs(hl_groups_instance)[HLG_SEARCH];
+    int col, n;
+
+    start = start > skip ? start - skip : 0;
+    end = end - skip < count ? end - skip : count;
+
+    /* A match can wrap onto the rows below */
+    for (col = start; col < end; col += n) {
+        n = width - col % width < end - col ? width - col % width : end - col;
+        mvwchgat(win, top + col / width, col % width, n, attr & ~A_COLOR,
+                PAIR_NUMBER(attr), NULL);
+    }
+}
+
+void scr_refresh(struct scroller *scr, int focus, enum win_refresh dorefresh,
+        const struct cgdbrc_snapshot *config)
 {
 	int length;                 /* Length of current line */
 	int nlines;                 /* Number of lines written so far */
 	int row;                    /* Current row in scroller */
 	int width, height;          /* Width and height of window */
-	char *buffer;               /* Current line segment to print */
 
 	/* Sanity check */
 	getmaxyx(scr->win, height, width);
@@ -336,112 +941,85 @@ void scr_refresh(struct scroller *scr, int focus)
 	}
 	row = scr->current.r;
 	/* Start drawing at the bottom of the viewable space, and work our way up */
-	int pair_no = 100;
 	int cursor_col = 0;
 	nlines = 1;
 	while(nlines <= height)
 	{
-		if(row < 0)
+		if(row < -spilled(scr))
 		{
 			wmove(scr->win, height-nlines, 0);
 			wclrtoeol(scr->win);
 			nlines++;
 			continue;
 		}
-		int line_height = get_line_height(scr->buffer[row], width);
+		struct scroller_line tmp;
+		struct scroller_line *l = any_line(scr, row, &tmp);
+		struct scroller_run *runs = l->runs, *last_runs = NULL;
+		int nruns = l->nruns;
+		int visible = l->visible;
+
+		/* The last line can still change, it's parsed each time, and the
+		 * spilled lines are kept without their colors */
+		if ((row == scr->length - 1 || row < 0) && config->ansi_codes) {
+			last_runs = cgdb_malloc(sizeof (struct scroller_run) * max_runs(l->text));
+			runs = last_runs;
+			nruns = parse_runs(l->text, runs);
+			visible = nruns > 0 ? runs_columns(l->text, runs, nruns) :
+					line_columns(l);
+		}
+
+		/* The escape sequences are shown when ansicodes is off */
+		if (!config->ansi_codes) {
+			nruns = 0;
+			visible = line_columns(l);
+		}
+
+		/* Only the bottom of a line taller than the room left is drawn */
+		int line_height = visible <= width ? 1 : (visible + width - 1) / width;
+		int rows = line_height < height - nlines + 1 ? line_height : height - nlines + 1;
+		int top = height - nlines - rows + 1;
 		int clear_line;
-		for(clear_line = 0; clear_line < line_height; ++clear_line)
+		for(clear_line = rows - 1; clear_line >= 0; --clear_line)
 		{
-			wmove(scr->win, height-nlines-clear_line, 0);
+			wmove(scr->win, top + clear_line, 0);
 			wclrtoeol(scr->win);
 		}
-		int total_length = 0;
-		char* segment_start = scr->buffer[row];
-		char* segment_end;
-		char* line_end = segment_start + strlen(scr->buffer[row]);
-		while(segment_start < line_end)
-		{
-			char* pch=strchr(segment_start+1, '[');
-			if(pch==NULL)
-				segment_end = line_end;
-			else
-				segment_end = pch;
-
-			int attributes = A_NORMAL;
-			int foreground = -1;
-			int background = -1;
-			char* current_char = segment_start;
-			if(cgdbrc_get(CGDBRC_ANSI_CODES)->variant.int_val && *current_char == '[')
-			{
-				current_char++;
-				int color_code[] = {0, 0};
-				int i;
-				for(i=0; *current_char && i<2; ++i)
-				{
-					color_code[i] = strtol(current_char, &current_char, 10);
-					if(*current_char == ';')
-						current_char++;
-				}
-				if(*current_char == 'm') // We have a format sequence
-				{
-					for(i=0; i<2; ++i)
-					{
-						if(color_code[i] <= 8)
-							attributes |= color_code[i];
-						else if(color_code[i] >= 30 && color_code[i] <= 37)
-							foreground = color_code[i] % 10;
-						else if(color_code[i] >= 40 && color_code[i] <= 47)
-							background = color_code[i] % 10;
-						else if(color_code[i] >= 90 && color_code[i] <= 97)
-						{
-							foreground = color_code[i] % 10;
-							attributes |= A_BOLD;
-						}
-						else if(color_code[i] >= 100 && color_code[i] <= 107)
-						{
-							background = color_code[i] % 10;
-							attributes |= A_BOLD;
-						}
-					}
-					current_char++;
-					segment_start = current_char;
-				}
-			}
-
-			int segment_length = segment_end - segment_start;
-
-			buffer = malloc(segment_length+1);
-			buffer[segment_length] = 0;
-			memset(buffer, ' ', segment_length);
-			memcpy(buffer, segment_start, segment_length);
-
-			init_pair(++pair_no, foreground, background);
-			int attrs = COLOR_PAIR(pair_no) | attributes;
-
-			wattron(scr->win, attrs);
-			wprintw(scr->win, "%s", buffer);
-			wattroff(scr->win, attrs);
-
-			total_length += segment_length;
+		draw_line(scr->win, l->text, runs, nruns, (line_height - rows) * width,
+				rows * width);
+		if (scr->match.on && scr->match.r == row)
+			draw_match(scr->win, top, width,
+					byte_columns(l->text, runs, nruns, scr->match.start),
+					byte_columns(l->text, runs, nruns, scr->match.end),
+					(line_height - rows) * width, rows * width);
+		int total_length = visible;
+		if (*l->text)
 			scr->current.c = total_length;
-			segment_start = segment_end;
-			free(buffer);
-		}
+		free(last_runs);
 		if(nlines == 1)
 			cursor_col = total_length % width;
 		row--;
 		nlines += line_height;
 	}
 
-	length = strlen(scr->buffer[scr->current.r] + scr->current.c);
+	/* The column is left at the width of the last row drawn, which may
+	 * not be the current one */
+	struct scroller_line tmp;
+	length = line_columns(any_line(scr, scr->current.r, &tmp));
+	length = scr->current.c < length ? length - scr->current.c : 0;
 	if (focus && scr->current.r == scr->length - 1 && length <= width) {
 		/* We're on the last line, draw the cursor */
+		int pos = utf8_columns(line(scr, scr->current.r)->text,
+				scr->current.pos);
+
 		curs_set(1);
-		wmove(scr->win, height - 1, scr->current.pos<cursor_col?scr->current.pos:cursor_col);
+		wmove(scr->win, height - 1, pos < cursor_col ? pos : cursor_col);
 	} else {
 		/* Hide the cursor */
 		curs_set(0);
 	}
 
-	wrefresh(scr->win);
+	if (dorefresh == WIN_REFRESH)
+		wrefresh(scr->win);
+	else
+		wnoutrefresh(scr->win);
 }
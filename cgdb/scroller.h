@@ -20,18 +20,63 @@
 #include <ncurses/curses.h>
 #endif /* HAVE_CURSES_H */
 
+#include "cgdb.h"
+#include "cgdbrc.h"
+
 /* --------------- */
 /* Data Structures */
 /* --------------- */
 
+/* A block of memory that holds the text of many lines, see scroller.c */
+struct scroller_chunk;
+
+/* A piece of a line drawn with the same colors, see scroller.c */
+struct scroller_run;
+
+/* The lines dropped from the scrollback, see spill.h */
+struct spill;
+
+/* A line of the buffer */
+struct scroller_line {
+    char *text;                 /* The line, NUL terminated */
+    struct scroller_chunk *chunk;   /* Where text is, NULL if it's malloc'd */
+    struct scroller_run *runs;  /* The colors of the line, in chunk */
+    int nruns;                  /* 0 if it's drawn in the default colors */
+    int length;                 /* The length of text, in bytes */
+    int visible;                /* The columns drawn, without the escape
+                                 * sequences, unknown for the last line */
+    int columns;                /* The columns drawn with the escape
+                                 * sequences, unknown for the last line */
+};
+
+/* The buffer is a ring that keeps the last lines written to it, the
+ * scrollback option sets how many. Every line but the last one is copied
+ * into a chunk, as it can't change anymore. */
 struct scroller {
-    char **buffer;              /* The text buffer */
+    struct scroller_line *lines;    /* The text buffer */
+    int size;                   /* Number of entries allocated in lines */
+    int first;                  /* Index in lines of the oldest line */
     int length;                 /* Number of lines in buffer */
+    struct scroller_chunk *chunk;   /* The chunk lines are copied into */
+    size_t last_size;           /* Bytes allocated for the last line */
+    struct spill *spill;        /* The lines dropped from lines, NULL if
+                                 * the scrollspill option is off */
     struct {
-        int r;                  /* Current line (row) number */
+        int r;                  /* Current line (row) number, below 0
+                                 * for a line in spill */
         int c;                  /* Current column number */
         int pos;                /* Cursor position in last line */
     } current;
+    struct {
+        int on;                 /* 1 if a search matched */
+        int r;                  /* The line it matched */
+        int start, end;         /* Where in the line, in bytes */
+    } match;                    /* Highlighted until scr_end */
+    struct {
+        int active;             /* 1 while a search is being typed */
+        int r, c;               /* Where it started */
+        int start, end;         /* The match on line r it goes past */
+    } search;
     WINDOW *win;                /* The scoller's own window */
 };
 
@@ -96,6 +141,60 @@ void scr_end(struct scroller *scr);
  */
 void scr_add(struct scroller *scr, const char *buf);
 
+/* scr_add_length:  Append some bytes to the buffer.
+ * ---------------
+ *
+ *  Like scr_add, but buf doesn't need to be NUL terminated. A NUL byte in
+ *  it is dropped, like the other bytes that don't print, instead of
+ *  ending it.
+ *
+ *   scr:     Pointer to the scroller object
+ *   buf:     Buffer to append
+ *   length:  The number of bytes of buf to append
+ */
+void scr_add_length(struct scroller *scr, const char *buf, size_t length);
+
+/* scr_search_init: Starts a search that's typed a key at a time.
+ * ----------------
+ *
+ *  The searches scr_search makes until one is final start where the
+ *  window is now.
+ *
+ *   scr:  Pointer to the scroller object
+ */
+void scr_search_init(struct scroller *scr);
+
+/* scr_search: Scrolls to the next line that matches a regular expression.
+ * -----------
+ *
+ *  The search starts past the last match, or at the line after (or
+ *  before) the one at the bottom of the window if it's not on it. It goes
+ *  through the lines the scrollspill option kept too, and wraps around if
+ *  the wrapscan option is on. The match is highlighted. A key pressed
+ *  during a long search cancels it.
+ *
+ *   scr:        Pointer to the scroller object
+ *   regex:      The regular expression, NULL or "" to go back to where
+ *               the search started
+ *   opt:        1 for a search that's still being typed, 2 for a final one
+ *   direction:  1 to search forward, 0 to search backward
+ *   icase:      1 to ignore case
+ *
+ * Return Value: 1 if a line matched, 0 if none did or the search was
+ *               cancelled, -1 if regex isn't valid.
+ */
+int scr_search(struct scroller *scr, const char *regex, int opt,
+        int direction, int icase);
+
+/* scr_scrolled: Determines if the window is scrolled back from the end.
+ * -------------
+ *
+ *   scr:  Pointer to the scroller object
+ *
+ * Return Value: 1 if it is, 0 if the last line is shown.
+ */
+int scr_scrolled(struct scroller *scr);
+
 /* scr_move: Reposition the buffer on the screen
  * ---------
  *
@@ -114,7 +213,11 @@ void scr_move(struct scroller *scr,
  *
  *   scr:    Pointer to the scroller object
  *   focus:  If the window has focus
+ *   dorefresh: WIN_REFRESH to draw it now, WIN_NO_REFRESH to leave that to
+ *              the next doupdate
+ *   config: The options to draw with
  */
-void scr_refresh(struct scroller *scr, int focus);
+void scr_refresh(struct scroller *scr, int focus, enum win_refresh dorefresh,
+        const struct cgdbrc_snapshot *config);
 
 #endif
@@ -3,11 +3,9 @@
  * 
  * Source file management routines for the GUI.  Provides the ability to
  * add files to the list, load files, and display within a curses window.
- * Files are buffered in memory when they are displayed, and held in
- * memory for the duration of execution.  If memory consumption becomes a
- * problem, this can be optimized to unload files which have not been
- * displayed recently, or only load portions of large files at once. (May
- * affect syntax hilighting.)
+ * Files are buffered in memory when they are displayed.  If the srcmem
+ * option is set, the files which have not been displayed recently are
+ * unloaded to stay within it, and loaded again when they are needed.
  *
  */
 
@@ -32,6 +30,18 @@
 #include <string.h>
 #endif /* HAVE_STRING_H */
 
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#if HAVE_LIMITS_H
+#include <limits.h>
+#endif /* HAVE_LIMITS_H */
+
+#if HAVE_STDINT_H
+#include <stdint.h>
+#endif /* HAVE_STDINT_H */
+
 #ifdef HAVE_SYS_TIME_H
 #include <sys/time.h>
 #endif
@@ -44,39 +54,139 @@
 #include <unistd.h>
 #endif /* HAVE_UNISTD_H */
 
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
+#if HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif /* HAVE_SYS_MMAN_H */
+
 #if HAVE_CTYPE_H
 #include <ctype.h>
 #endif
 
 /* Local Includes */
 #include "highlight.h"
+#include "highlight_cache.h"
 #include "sources.h"
 #include "cgdb.h"
 #include "logo.h"
 #include "sys_util.h"
+#include "fs_watch.h"
 #include "cgdbrc.h"
 #include "highlight_groups.h"
+#include "std_ohash.h"
+#include "std_intern.h"
+#include "utf8.h"
+#include "stats.h"
+#include "loader.h"
+#include "symbols.h"
 
 int sources_syntax_on = 1;
 
+/* How a line is marked, for struct source_row */
+#define SOURCE_ROW_EXE      1   /* It's the executing line */
+#define SOURCE_ROW_SEL      2   /* It's the selected line */
+#define SOURCE_ROW_FOCUS    4   /* The window has focus */
+
+/* Incremented when lines may need drawing again, though what a row was
+ * drawn with didn't change */
+static unsigned long source_changes = 1;
+
+/* The pattern the hlsearch option draws every match of, NULL for none */
+static char *source_hlsearch;
+static int source_hlsearch_cflags;
+
+/* How long a file gdb stopped in is waited for before the source window
+ * shows that it's loading, in milliseconds */
+#define SOURCE_LOAD_WAIT 100
+
+/* How long what stat said about a path is trusted, in microseconds */
+#define SOURCE_STAT_TTL 5000000
+
+/* The most paths the stat cache holds before it starts over */
+#define SOURCE_STAT_PATHS 256
+
+/* What stat said about a path */
+struct source_stat {
+    char *path;                 /* The path, the key of the entry */
+    int exists;                 /* 1 if it exists, 0 if it doesn't */
+    unsigned long long checked; /* When stat was called, from stats_clock */
+};
+
 /* --------------- */
 /* Local Functions */
 /* --------------- */
 
+/* source_stat_free: Frees an entry of the stat cache.
+ * -----------------
+ */
+static int source_stat_free(void *data)
+{
+    struct source_stat *entry = data;
+
+    free(entry->path);
+    free(entry);
+
+    return 0;
+}
+
+/* source_stat_any: Matches every entry of the stat cache.
+ * ----------------
+ */
+static int source_stat_any(void *key, void *value, void *user_data)
+{
+    return 1;
+}
+
+/* source_stat_forget: Makes the stat cache forget every path.
+ * -------------------
+ */
+static void source_stat_forget(struct sviewer *sview)
+{
+    std_ohash_table_foreach_remove(sview->stat_cache, source_stat_any, NULL);
+}
+
 /* verify_file_exists: Checks to see if a file exists
  * -------------------
  *
+ * A file gdb stops in is asked about over and over, and stat can be slow
+ * on a network filesystem. A file that's watched is known to be there
+ * until the kernel says it's gone. Otherwise what stat said is kept for
+ * SOURCE_STAT_TTL, whether or not the file was there.
+ *
  * Return Value: 0 if does not exist, 1 if exists 
  */
-static int verify_file_exists(const char *path)
+static int verify_file_exists(struct sviewer *sview, const char *path)
 {
+    struct list_node *node = std_ohash_table_lookup(sview->path_index, path);
+    struct source_stat *entry;
+    unsigned long long now;
     struct stat st;
 
+    if (node && (node->watch != -1 || node->text))
+        return 1;
+
+    now = stats_clock();
+    entry = std_ohash_table_lookup(sview->stat_cache, path);
+    if (entry && now - entry->checked < SOURCE_STAT_TTL)
+        return entry->exists;
+
+    if (!entry) {
+        if (std_ohash_table_size(sview->stat_cache) >= SOURCE_STAT_PATHS)
+            source_stat_forget(sview);
+
+        entry = cgdb_malloc(sizeof (struct source_stat));
+        entry->path = cgdb_strdup(path);
+        std_ohash_table_insert(sview->stat_cache, entry->path, entry);
+    }
+
     /* Check for read permission of file, already exists */
-    if (stat(path, &st) == -1)
-        return 0;
+    entry->exists = stat(path, &st) == -1 ? 0 : 1;
+    entry->checked = now;
 
-    return 1;
+    return entry->exists;
 }
 
 /* get_relative_node:  Returns a pointer to the node that matches the 
@@ -89,15 +199,7 @@ static int verify_file_exists(const char *path)
 static struct list_node *get_relative_node(struct sviewer *sview,
         const char *lpath)
 {
-
-    struct list_node *cur;
-
-    for (cur = sview->list_head; cur != NULL; cur = cur->next)
-        if (cur->lpath)
-            if (strcmp(lpath, cur->lpath) == 0)
-                return cur;
-
-    return NULL;
+    return std_ohash_table_lookup(sview->lpath_index, lpath);
 }
 
 /* get_node:  Returns a pointer to the node that matches the given path.
@@ -109,14 +211,7 @@ static struct list_node *get_relative_node(struct sviewer *sview,
  */
 static struct list_node *get_node(struct sviewer *sview, const char *path)
 {
-    struct list_node *cur;
-
-    for (cur = sview->list_head; cur != NULL; cur = cur->next)
-        if (cur->path)
-            if (strcmp(path, cur->path) == 0)
-                return cur;
-
-    return NULL;
+    return std_ohash_table_lookup(sview->path_index, path);
 }
 
 /**
@@ -156,28 +251,38 @@ static int get_timestamp(const char *path, time_t * timestamp)
 
 static int release_file_buffer(struct buffer *buf)
 {
-    int i;
-
     /* Nothing to free */
     if (!buf)
         return 0;
 
-    for (i = 0; i < buf->length; ++i) {
-        free(buf->tlines[i]);
-        buf->tlines[i] = NULL;
-    }
-
-    free(buf->tlines);
-    buf->tlines = NULL;
+    hl_wprintw_forget();
+
+    free(buf->lines);
+    buf->lines = NULL;
+    free(buf->bases);
+    buf->bases = NULL;
+    free(buf->text);
+    buf->text = NULL;
+    free(buf->runs);
+    buf->runs = NULL;
+    buf->used = 0;
+    buf->size = 0;
     buf->length = 0;
-    buf->cur_line = NULL;
     buf->max_width = 0;
-    free(buf->breakpts);
-    buf->breakpts = NULL;
 
     return 0;
 }
 
+/* unwatch_file: Stops the kernel from watching a node's file.
+ * -------------
+ */
+static void unwatch_file(struct list_node *node)
+{
+    fs_watch_remove(node->watch);
+    node->watch = -1;
+    node->dirty = 0;
+}
+
 /** 
  * Remove's the memory related to a file.
  *
@@ -192,6 +297,16 @@ static int release_file_memory(struct list_node *node)
     if (!node)
         return -1;
 
+    highlight_stop(node);
+    highlight_forget(node);
+    node->hl_lazy = 0;
+
+    unwatch_file(node);
+
+    /* A search in progress can't skip the old lines anymore */
+    hl_regex_reset();
+    source_changes++;
+
     /* Free the buffer */
     if (release_file_buffer(&node->buf) == -1)
         return -1;
@@ -202,320 +317,1556 @@ static int release_file_memory(struct list_node *node)
     return 0;
 }
 
-/* load_file:  Loads the file in the list_node into its memory buffer.
- * ----------
+/* map_file: Gets the contents of a file into memory in one shot.
+ * ---------
  *
- *   node:  The list node to work on
+ * The file is mmap'd when possible, otherwise it is read into a single
+ * heap buffer. Either way, the caller must release it with unmap_file.
+ * A mapped file that is truncated while it's mapped raises SIGBUS when
+ * the missing part is touched, the data is only used right away.
  *
- * Return Value:  Zero on success, non-zero on error.
+ *   fd:     An open file descriptor of the file to map
+ *   size:   The size of the file, in bytes. Set to the bytes read, if
+ *           the file shrunk since it was stat'd.
+ *   mapped: Set to 1 if the data was mmap'd, 0 if it was read
+ *
+ * Return Value: The file contents, or NULL on error.
  */
-static int load_file(struct list_node *node)
+static char *map_file(int fd, size_t *size, int *mapped)
 {
-    FILE *file;
-    char line[MAX_LINE];
-    int i;
+    char *data;
+    size_t total = 0;
+    ssize_t n;
 
-    node->buf.length = 0;
-    node->buf.tlines = NULL;
-    node->buf.breakpts = NULL;
-    node->buf.cur_line = NULL;
-    node->buf.max_width = 0;
-
-    /* Open file and save in original buffer.
-     * I am not sure if this should be done this way in the future.
-     * Maybe this data should be recieved from flex.
-     */
-    node->orig_buf.length = 0;
-    node->orig_buf.tlines = NULL;
-    node->orig_buf.breakpts = NULL;
-    node->orig_buf.cur_line = NULL;
-    node->orig_buf.max_width = 0;
+    *mapped = 0;
 
-    /* Stat the file to get the timestamp */
-    if (get_timestamp(node->path, &(node->last_modification)) == -1)
-        return 2;
+#if HAVE_SYS_MMAN_H
+    data = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+        *mapped = 1;
+        return data;
+    }
+#endif /* HAVE_SYS_MMAN_H */
+
+    /* Not mappable (pipe, odd filesystem, ...), read it all instead */
+    data = cgdb_malloc(*size);
+    while (total < *size) {
+        n = read(fd, data + total, *size - total);
+        if (n == -1) {
+            if (errno == EINTR)
+                continue;
+
+            free(data);
+            return NULL;
+        }
 
-    if (!(file = fopen(node->path, "r")))
-        return 1;
+        /* The file shrunk since it was stat'd */
+        if (n == 0)
+            break;
 
-    while (!feof(file)) {
-        if (fgets(line, MAX_LINE, file)) {
-            int length = strlen(line);
+        total += n;
+    }
 
-            if (length > 0) {
-                if (line[length - 1] == '\n')
-                    line[length - 1] = 0;
-                if (line[length - 1] == '\r')
-                    line[length - 1] = 0;
-            }
-            if (strlen(line) > node->orig_buf.max_width)
-                node->orig_buf.max_width = strlen(line);
-
-            /* Inefficient - Reallocates memory at each line */
-            node->orig_buf.length++;
-            node->orig_buf.tlines = realloc(node->orig_buf.tlines,
-                    sizeof (char *) * node->orig_buf.length);
-            node->orig_buf.tlines[node->orig_buf.length - 1] = strdup(line);
-        }
+    *size = total;
+
+    return data;
+}
+
+/* unmap_file: Releases the memory returned from map_file.
+ * -----------
+ */
+static void unmap_file(char *data, size_t size, int mapped)
+{
+#if HAVE_SYS_MMAN_H
+    if (mapped) {
+        munmap(data, size);
+        return;
     }
+#endif /* HAVE_SYS_MMAN_H */
 
-    fclose(file);
+    free(data);
+}
 
-    node->language = tokenizer_get_default_file_type(strrchr(node->path, '.'));
+/* file_loaded: Determines if a node's file is in memory.
+ * ------------
+ */
+static int file_loaded(struct list_node *node)
+{
+    return node->orig_buf.lines != NULL;
+}
 
-    /* Add the highlighted lines */
-    if (has_colors()) {
-        highlight(node);
-    } else {
-        /* Just copy the lines from the original buffer if no highlighting 
-         * is possible */
-        int i;
+/* load_file_buf: Splits the contents of a file into the lines of a buffer.
+ * --------------
+ *
+ * A first pass counts the lines and a second pass copies each line out,
+ * so the offsets and the text are each allocated exactly once. The text
+ * can't be bigger than the file, plus a terminator for the last line.
+ * Lines are as long as they are, there's no limit but the width of an int.
+ *
+ *   buf:   The buffer to fill in
+ *   data:  The contents of the file
+ *   size:  The number of bytes in data
+ *
+ * Return Value: 0 on success, -1 if the file is too big to index.
+ */
+static int load_file_buf(struct buffer *buf, const char *data, size_t size)
+{
+    const char *pos, *end, *eol;
+    int nlines, i;
+
+    /* Count the lines, a final line without a newline still counts */
+    end = data + size;
+    nlines = 0;
+    for (pos = data; pos < end; pos = eol + 1) {
+        eol = memchr(pos, '\n', end - pos);
+        if (!eol)
+            eol = end;
+
+        /* The lines and the widest of them are counted in ints */
+        if (nlines == INT_MAX || eol - pos > INT_MAX)
+            return -1;
 
-        node->buf.length = node->orig_buf.length;
-        node->buf.max_width = node->orig_buf.max_width;
-        node->buf.tlines = cgdb_malloc(sizeof (char *) * node->orig_buf.length);
-        for (i = 0; i < node->orig_buf.length; i++)
-            node->buf.tlines[i] = cgdb_strdup(node->orig_buf.tlines[i]);
+        nlines++;
     }
 
-    /* Allocate the breakpoints array */
-    node->buf.breakpts = malloc(sizeof (char) * node->buf.length);
-    for (i = 0; i < node->buf.length; i++)
-        node->buf.breakpts[i] = 0;
+    hl_wprintw_forget();
+    buffer_set_length(buf, nlines, size + 1);
+
+    for (i = 0, pos = data; i < nlines; i++, pos = eol + 1) {
+        size_t length;
+
+        eol = memchr(pos, '\n', end - pos);
+        if (!eol)
+            eol = end;
+
+        length = eol - pos;
+
+        /* Strip dos line endings */
+        if (length > 0 && pos[length - 1] == '\r')
+            length--;
+
+        if (buffer_set_line(buf, i, pos, length) == -1)
+            return -1;
+
+        if (length > buf->max_width)
+            buf->max_width = length;
+    }
 
     return 0;
 }
 
-/* draw_current_line:  Draws the currently executing source line on the screen
- * ------------------  including the user-selected marker (arrow, highlight,
- *                     etc) indicating this is the executing line.
+/* update_mem: Works out how much memory the buffers of a node hold.
+ * -----------
  *
- *   sview:  The current source viewer
- *   line:   The line number
- *   lwidth: The width of the line number, used to limit printing to the width
- *           of the screen.  Kinda ugly.
+ * Files that are still being highlighted grow past this, they're counted
+ * again when the worker is done with them.
  */
-static void draw_current_line(struct sviewer *sview, int line, int lwidth, int arrow_attr)
+static void update_mem(struct list_node *node)
 {
+    node->mem = node->orig_buf.size + node->buf.size * sizeof (struct hl_run)
+            + node->orig_buf.length * (2 * sizeof (uint32_t) + 1)
+            + 2 * BUFFER_BLOCKS(node->orig_buf.length) * sizeof (size_t)
+            + symbols_size(node->symbols);
+}
 
-    int height = 0;             /* Height of curses window */
-    int width = 0;              /* Width of curses window */
-    int i = 0, j = 0;           /* Iterators */
-    struct buffer *buf = NULL;  /* Pointer to the source buffer */
-    char *text = NULL;          /* The current line (highlighted) */
-    char *otext = NULL;         /* The current line (unhighlighted) */
-    unsigned int length = 0;    /* Length of the line */
-    int column_offset = 0;      /* Text to skip due to arrow */
-    //int arrow_attr;
-    int highlight_attr;
-    enum ArrowStyle config_arrowstyle =
-            cgdbrc_get(CGDBRC_ARROWSTYLE)->variant.arrow_style;
-    int highlight_tabstop = cgdbrc_get(CGDBRC_TABSTOP)->variant.int_val;
+/* load_file_data:  Loads the contents of a file into a node's buffers.
+ * ---------------
+ *
+ * The same bytes are split into the original buffer and handed to the
+ * highlighter.
+ *
+ *   node:   The list node to work on
+ *   data:   The contents of the file
+ *   size:   The number of bytes in data
+ *   mtime:  The timestamp of the file
+ *
+ * Return Value:  Zero on success, non-zero on error.
+ */
+static int load_file_data(struct list_node *node, const char *data,
+        size_t size, time_t mtime)
+{
+    memset(&node->buf, 0, sizeof (struct buffer));
+    memset(&node->orig_buf, 0, sizeof (struct buffer));
 
-    if (hl_groups_get_attr(hl_groups_instance, HLG_LINE_HIGHLIGHT,
-                    &highlight_attr) == -1)
-        return;
+    node->last_modification = mtime;
+    node->file_size = size;
 
-    /* Initialize height and width */
-    getmaxyx(sview->win, height, width);
+    /* Save the file in the original buffer */
+    if (load_file_buf(&node->orig_buf, data ? data : "", size) == -1)
+        return 3;
 
-    /* If syntax highlighting is on, point to the colored buffer. */
-    if (sources_syntax_on) {
-        buf = &(sview->cur->buf);
-    } else {
-        buf = &(sview->cur->orig_buf);
-    }
+    node->language = tokenizer_get_default_file_type(strrchr(node->path, '.'));
 
-    /* If the current selected line is the line executing, use cur_line */
-    if (line == sview->cur->sel_line && buf->cur_line != NULL) {
-        text = buf->cur_line;
+    /* Add the highlighted lines, the cache may already have them */
+    if (has_colors()) {
+        if (hl_cache_load(node) == 0)
+            node->hl_lazy = 0;
+        else if (node->orig_buf.length > HL_LAZY_LINES)
+            highlight_lazy(node);
+        else
+            highlight(node, data ? data : "", size);
     } else {
-        text = buf->tlines[line];
+        /* No highlighting is possible, every line is drawn plain */
+        node->buf.length = node->orig_buf.length;
+        node->buf.max_width = node->orig_buf.max_width;
     }
-    otext = sview->cur->orig_buf.tlines[line];
-    length = strlen(otext);
 
-    /* Draw the appropriate arrow, if applicable */
-    switch (config_arrowstyle) {
+    /* Highlighting that started took what it needed from before a reload */
+    if (node->hl_lazy != 1)
+        highlight_reuse(node, NULL);
 
-        case ARROWSTYLE_SHORT:
+    /* A line selected before the file was read, or before it got shorter,
+     * is kept within it */
+    if (node->last_line >= node->buf.length)
+        node->last_line = node->buf.length > 0 ? node->buf.length - 1 : 0;
 
-            wattron(sview->win, arrow_attr);
-            waddch(sview->win, ACS_LTEE);
-            waddch(sview->win, '>');
-            wattroff(sview->win, arrow_attr);
-            break;
+    update_mem(node);
 
-        case ARROWSTYLE_LONG:
+    return 0;
+}
 
-            wattron(sview->win, arrow_attr);
-            waddch(sview->win, ACS_LTEE);
+/* load_file:  Loads the file in the list_node into its memory buffer.
+ * ----------
+ *
+ * The file is read from disk once, in this thread.
+ *
+ *   node:  The list node to work on
+ *
+ * Return Value:  Zero on success, non-zero on error.
+ */
+static int load_file(struct list_node *node)
+{
+    struct stat st;
+    char *data = NULL;
+    size_t size;
+    int fd, mapped = 0, ret;
 
-            /* Compute the length of the arrow, respecting tab stops, etc. */
-            for (i = 0; i < length - 1 && isspace(otext[i]); i++) {
+    if ((fd = open(node->path, O_RDONLY)) == -1)
+        return 1;
 
-                /* Oh so cryptic */
-                int offset = otext[i] != '\t' ? 1 :
-                        highlight_tabstop - (column_offset % highlight_tabstop);
+    /* Stat the file to get the timestamp */
+    if (fstat(fd, &st) == -1) {
+        cgdb_close(fd);
+        return 2;
+    }
 
-                if (!isspace(otext[i + 1])) {
-                    offset--;
-                }
+    /* Empty files have no lines, and can't be mapped. A file bigger than
+     * the address space can't be mapped either. */
+    size = st.st_size;
+    if ((off_t) size != st.st_size) {
+        cgdb_close(fd);
+        return 3;
+    }
 
-                column_offset += offset;
-            }
-            column_offset -= sview->cur->sel_col;
-            if (column_offset < 0) {
-                column_offset = 0;
-            }
+    if (size > 0) {
+        data = map_file(fd, &size, &mapped);
+        if (!data) {
+            cgdb_close(fd);
+            return 1;
+        }
+    }
 
-            /* Now actually draw the arrow */
-            for (j = 0; j < column_offset; j++) {
-                waddch(sview->win, ACS_HLINE);
-            }
+    cgdb_close(fd);
 
-            waddch(sview->win, '>');
-            wattroff(sview->win, arrow_attr);
-            break;
+    ret = load_file_data(node, data, size, st.st_mtime);
 
-        case ARROWSTYLE_HIGHLIGHT:
-            waddch(sview->win, VERT_LINE);
-            waddch(sview->win, ' ');
-
-            wattron(sview->win, highlight_attr);
-            for (i = 0; i < width - lwidth - 2; i++) {
-                if (i < length) {
-                    waddch(sview->win, otext[i]);
-                } else {
-                    waddch(sview->win, ' ');
-                }
-            }
-            wattroff(sview->win, highlight_attr);
+    if (data)
+        unmap_file(data, size, mapped);
 
-            return;
-    }
+    return ret;
+}
 
-    /* Finally, print the source line */
-    hl_wprintw(sview->win, text, width - lwidth - 2,
-            sview->cur->sel_col + column_offset);
+/* evict_file: Unloads a file to free up memory. The marks stay with the
+ * ----------- node, for when the file is loaded again.
+ *
+ *   node:  The list node to work on
+ */
+static void evict_file(struct list_node *node)
+{
+    release_file_memory(node);
+    node->mem = 0;
 }
 
-/* --------- */
-/* Functions */
-/* --------- */
+/* mem_used: Adds up the memory held by the files that are loaded.
+ * ---------
+ */
+static size_t mem_used(struct sviewer *sview)
+{
+    struct list_node *node;
+    size_t used = 0;
 
-/* Descriptive comments found in header file: sources.h */
+    for (node = sview->list_head; node != NULL; node = node->next)
+        if (file_loaded(node))
+            used += node->mem;
 
-struct sviewer *source_new(int pos_r, int pos_c, int height, int width)
+    return used;
+}
+
+/* enforce_srcmem: Evicts the least recently used files until the files in
+ * --------------- memory fit in the srcmem option.
+ *
+ *   sview:  The source viewer object
+ *   keep:   A node that must stay in memory, even if it's over the limit
+ */
+static void enforce_srcmem(struct sviewer *sview, struct list_node *keep)
 {
-    struct sviewer *rv;
+    size_t limit = (size_t) cgdbrc_get(CGDBRC_SRCMEM)->variant.int_val
+            * 1024 * 1024;
+    size_t used;
+    struct list_node *node, *lru;
 
-    /* Allocate a new structure */
-    if ((rv = malloc(sizeof (struct sviewer))) == NULL)
-        return NULL;
+    if (limit == 0)
+        return;
 
-    /* Initialize the structure */
-    rv->win = newwin(height, width, pos_r, pos_c);
-    rv->cur = NULL;
-    rv->list_head = NULL;
+    for (;;) {
+        used = 0;
+        lru = NULL;
 
-    return rv;
-}
+        for (node = sview->list_head; node != NULL; node = node->next) {
+            if (!file_loaded(node))
+                continue;
 
-int source_add(struct sviewer *sview, const char *path)
-{
-    struct list_node *new_node;
+            used += node->mem;
 
-    new_node = malloc(sizeof (struct list_node));
-    new_node->path = strdup(path);
-    new_node->lpath = NULL;
-    new_node->buf.length = 0;
-    new_node->buf.tlines = NULL;    /* This signals an empty buffer */
-    new_node->sel_line = 0;
-    new_node->sel_col = 0;
-    new_node->sel_col_rbeg = 0;
-    new_node->sel_col_rend = 0;
-    new_node->sel_rline = 0;
-    new_node->exe_line = 0;
-    new_node->last_modification = 0;    /* No timestamp yet */
+            if (node == keep || node->views > 0 || node->text)
+                continue;
 
-    if (sview->list_head == NULL) {
-        /* List is empty, this is the first node */
-        new_node->next = NULL;
-        sview->list_head = new_node;
-    } else {
-        /* Insert at the front of the list (easy) */
-        new_node->next = sview->list_head;
-        sview->list_head = new_node;
+            if (!lru || node->last_used < lru->last_used)
+                lru = node;
+        }
+
+        if (used <= limit || !lru)
+            break;
+
+        evict_file(lru);
     }
+}
 
-    return 0;
+/* find_breaks: Finds the first breakpoint of a file.
+ * ------------
+ *
+ *   sview:  The source viewer object
+ *   path:   The relative path to the file, interned
+ *
+ * Return Value: The index of the first breakpoint in sview->breaks that
+ *               isn't ordered before the file.
+ */
+static int find_breaks(struct sviewer *sview, const char *path)
+{
+    int low = 0, high = sview->breaks_count, mid;
+
+    while (low < high) {
+        mid = (low + high) / 2;
+        if ((uintptr_t) sview->breaks[mid].path < (uintptr_t) path)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
 }
 
-int source_set_relative_path(struct sviewer *sview,
-        const char *path, const char *lpath)
+/* break_compare: Orders breakpoints by file, then by line, the enabled
+ * --------------  ones on a line first.
+ */
+static int break_compare(const void *left, const void *right)
 {
+    const struct source_break *l = left, *r = right;
 
-    struct list_node *node = sview->list_head;
+    /* The paths are interned, so any order of them keeps a file together */
+    if (l->path != r->path)
+        return (uintptr_t) l->path < (uintptr_t) r->path ? -1 : 1;
 
-    while (node != NULL) {
-        if (strcmp(node->path, path) == 0) {
-            node->lpath = strdup(lpath);
-            return 0;
-        }
+    if (l->line != r->line)
+        return l->line - r->line;
 
-        node = node->next;
+    return (r->enabled ? 1 : 0) - (l->enabled ? 1 : 0);
+}
+
+/* find_break: Finds where a breakpoint is, or would go, in sview->breaks.
+ * -----------
+ *
+ * Return Value: The index of the first breakpoint that isn't ordered
+ *               before it.
+ */
+static int find_break(struct sviewer *sview, const struct source_break *b)
+{
+    int low = 0, high = sview->breaks_count, mid;
+
+    while (low < high) {
+        mid = (low + high) / 2;
+        if (break_compare(&sview->breaks[mid], b) < 0)
+            low = mid + 1;
+        else
+            high = mid;
     }
 
-    return -1;
+    return low;
 }
 
-int source_del(struct sviewer *sview, const char *path)
+/* apply_breaks: Marks the breakpoints of a file that was just given its
+ * ------------- relative path.
+ */
+static void apply_breaks(struct sviewer *sview, struct list_node *node)
 {
-    struct list_node *cur;
-    struct list_node *prev = NULL;
+    struct source_break *b;
     int i;
 
-    /* Find the target node */
-    for (cur = sview->list_head; cur != NULL; cur = cur->next) {
-        if (strcmp(path, cur->path) == 0)
+    source_marks_clear(&node->marks, SOURCE_MARK_BREAK);
+
+    if (!node->lpath)
+        return;
+
+    for (i = find_breaks(sview, node->lpath); i < sview->breaks_count; i++) {
+        b = &sview->breaks[i];
+        if (b->path != node->lpath)
             break;
-        prev = cur;
-    }
 
-    if (cur == NULL)
-        return 1;               /* Node not found */
+        /* The first one on a line is enabled if any of them is */
+        if (b->line > 0 && (i == 0 || b->line != sview->breaks[i - 1].line ||
+                        b->path != sview->breaks[i - 1].path))
+            source_marks_set(&node->marks, b->line - 1, SOURCE_MARK_BREAK,
+                    b->enabled ? 1 : 2);
+    }
+}
+
+/* heat_compare: Orders the lines of a profile by file, then by line.
+ * -------------
+ */
+static int heat_compare(const void *left, const void *right)
+{
+    const struct source_heat *l = left, *r = right;
+
+    if (l->path != r->path)
+        return (uintptr_t) l->path < (uintptr_t) r->path ? -1 : 1;
+
+    return l->line - r->line;
+}
+
+/* apply_heat: Marks the heat of the lines of a file that was just given
+ * ----------- its relative path.
+ */
+static void apply_heat(struct sviewer *sview, struct list_node *node)
+{
+    struct source_heat key;
+    struct source_heat *h;
+    int low = 0, high = sview->heat_count, mid;
+
+    source_marks_clear(&node->marks, SOURCE_MARK_HEAT);
+
+    if (!node->lpath)
+        return;
+
+    /* The first line of the file */
+    key.path = node->lpath;
+    key.line = 0;
+    while (low < high) {
+        mid = (low + high) / 2;
+        if (heat_compare(&sview->heat[mid], &key) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    for (h = sview->heat + low; h < sview->heat + sview->heat_count &&
+            h->path == node->lpath; h++)
+        if (h->line > 0)
+            source_marks_set(&node->marks, h->line - 1, SOURCE_MARK_HEAT,
+                    h->level);
+}
+
+/* view_show: Shows a node in a view, or nothing.
+ * ----------
+ *
+ * The view goes to the line that was selected when the node was last
+ * shown, and the node can't be unloaded while it's shown.
+ *
+ *   view:  The view
+ *   node:  The list node, or NULL to show the logo
+ */
+static void view_show(struct source_view *view, struct list_node *node)
+{
+    if (view->cur == node)
+        return;
+
+    if (view->cur) {
+        view->cur->last_line = view->sel_line;
+        view->cur->views--;
+    }
+
+    free(view->cur_line);
+    view->cur_line = NULL;
+    view->sel_col = view->sel_col_rbeg = view->sel_col_rend = 0;
+
+    view->cur = node;
+    if (node) {
+        node->views++;
+        view->sel_line = view->sel_rline = node->last_line;
+    }
+}
+
+/* node_view: Gets the view a change to a node's lines shows up in.
+ * ----------
+ *
+ * Return Value: The view the user is in if it shows the node, otherwise
+ *               the first one that does, or NULL if none do.
+ */
+static struct source_view *node_view(struct sviewer *sview,
+        struct list_node *node)
+{
+    int i;
+
+    if (sview->view->cur == node)
+        return sview->view;
+
+    for (i = 0; i < sview->view_count; i++)
+        if (sview->views[i].cur == node)
+            return &sview->views[i];
+
+    return NULL;
+}
+
+/* views_loaded: Keeps the views showing a node within its lines, once
+ * -------------  they were read.
+ *
+ *   sview:  The source viewer object
+ *   node:   The list node that was loaded
+ */
+static void views_loaded(struct sviewer *sview, struct list_node *node)
+{
+    struct source_view *view;
+    int i;
+
+    for (i = 0; i < sview->view_count; i++) {
+        view = &sview->views[i];
+        if (view->cur != node)
+            continue;
+
+        /* The search highlighting belongs to the lines there were */
+        free(view->cur_line);
+        view->cur_line = NULL;
+
+        if (view->sel_line >= node->buf.length) {
+            view->sel_line = node->buf.length > 0 ? node->buf.length - 1 : 0;
+            view->sel_rline = view->sel_line;
+        }
+    }
+}
+
+/* read_node: Loads a node's file.
+ * ----------
+ *
+ *   sview:  The source viewer object
+ *   node:   The list node to load
+ *
+ * Return Value:  Zero on success, non-zero on error.
+ */
+static int read_node(struct sviewer *sview, struct list_node *node)
+{
+    int ret;
+
+    /* Watch the file first, so a change made while it's read isn't missed */
+    unwatch_file(node);
+    node->watch = fs_watch_add(node->path);
+
+    if ((ret = load_file(node))) {
+        unwatch_file(node);
+        return ret;
+    }
+
+    views_loaded(sview, node);
+    source_changes++;
+
+    return 0;
+}
+
+/* request_node: Asks the loader to read a node's file in the background.
+ * -------------
+ *
+ *   node:   The list node to load
+ *
+ * Return Value:  Zero on success, -1 if it has to be read here instead.
+ */
+static int request_node(struct list_node *node)
+{
+    /* Watch the file first, so a change made while it's read isn't missed */
+    unwatch_file(node);
+    node->watch = fs_watch_add(node->path);
+
+    if (loader_request(node->path) == -1) {
+        unwatch_file(node);
+        return -1;
+    }
+
+    node->loading = 1;
+
+    return 0;
+}
+
+/* install_node: Loads a file the loader read into its node.
+ * -------------
+ *
+ *   sview:  The source viewer object
+ *   node:   The list node the file was read for
+ *   file:   The file
+ *
+ * Return Value:  Zero on success, non-zero on error.
+ */
+static int install_node(struct sviewer *sview, struct list_node *node,
+        struct loader_file *file)
+{
+    int ret;
+
+    if (!file->data) {
+        unwatch_file(node);
+        return 1;
+    }
+
+    if ((ret = load_file_data(node, file->data, file->size, file->mtime))) {
+        unwatch_file(node);
+        return ret;
+    }
+
+    views_loaded(sview, node);
+    source_changes++;
+
+    return 0;
+}
+
+/* set_exec_line: Makes a line of a loaded node the executing one.
+ * --------------
+ *
+ * The view node_view picks moves to it, the others stay where they are.
+ *
+ *   sview:  The source viewer object
+ *   node:   The list node
+ *   line:   The line number, 0 to leave the lines as they are
+ */
+static void set_exec_line(struct sviewer *sview, struct list_node *node,
+        int line)
+{
+    struct source_view *view;
+
+    if (line--) {
+        /* Check bounds of line */
+        if (line < 0)
+            line = 0;
+        if (line >= node->buf.length)
+            line = node->buf.length - 1;
+        node->exe_line = line;
+
+        if ((view = node_view(sview, node)))
+            view->sel_line = line;
+        else
+            node->last_line = line;
+    }
+}
+
+/* load_node: Loads a node's file, making room for it within srcmem.
+ * ----------
+ *
+ *   sview:  The source viewer object
+ *   node:   The list node to load
+ *
+ * Return Value:  Zero on success, non-zero on error.
+ */
+static int load_node(struct sviewer *sview, struct list_node *node)
+{
+    int ret;
+
+    if ((ret = read_node(sview, node)))
+        return ret;
+
+    node->last_used = ++sview->tick;
+    enforce_srcmem(sview, node);
+
+    return 0;
+}
+
+/* source_load: Loads the file of the node being shown.
+ * ------------
+ *
+ * The file is read in the background. It's waited for a little, so most
+ * files are shown right away, and the rest are shown by source_loaded.
+ *
+ *   sview:  The source viewer object
+ *   node:   The list node to load
+ *   line:   The line to show once it's loaded, 0 for the selected one
+ *
+ * Return Value:  Zero if it's loaded, 1 if it's still being read, -1 on
+ *                error.
+ */
+static int source_load(struct sviewer *sview, struct list_node *node,
+        int line)
+{
+    if (line)
+        node->load_line = line;
+
+    if (node->loading)
+        return 1;
+
+    /* Without the loader, the file is read here */
+    if (request_node(node) == -1)
+        return load_node(sview, node) ? -1 : 0;
+
+    if (!loader_wait(node->path, SOURCE_LOAD_WAIT))
+        return 1;
+
+    source_loaded(sview);
+
+    return file_loaded(node) ? 0 : -1;
+}
+
+/* set_break: Marks a line in a file as having a breakpoint.
+ * ----------
+ *
+ * The file doesn't have to be loaded, its marks are kept while it isn't.
+ *
+ *   sview:  The source viewer object
+ *   path:   The relative path to the file
+ *   line:   The line number of the breakpoint
+ *   value:  1 for an enabled breakpoint, 2 for a disabled one, 0 for none
+ *
+ * Return Value: 1 if the file is displayed in a view, 0 otherwise.
+ */
+static int set_break(struct sviewer *sview, const char *path, int line,
+        char value)
+{
+    struct list_node *node;
+
+    if ((node = get_relative_node(sview, path)) == NULL)
+        return 0;
+
+    if (line > 0)
+        source_marks_set(&node->marks, line - 1, SOURCE_MARK_BREAK, value);
+
+    return node->views > 0;
+}
+
+/* set_heat: Sets the heat of a line of a file, if the file is known.
+ * ---------
+ *
+ *   sview:  The source viewer object
+ *   path:   The relative path to the file
+ *   line:   The line number
+ *   level:  1 to 3, or 0 for none
+ *
+ * Return Value: 1 if the file is displayed in a view, 0 otherwise.
+ */
+static int set_heat(struct sviewer *sview, const char *path, int line,
+        int level)
+{
+    struct list_node *node;
+
+    if ((node = get_relative_node(sview, path)) == NULL)
+        return 0;
+
+    if (line > 0)
+        source_marks_set(&node->marks, line - 1, SOURCE_MARK_HEAT, level);
+
+    return node->views > 0;
+}
+
+/* mark_break: Marks a line with the breakpoints that are on it.
+ * -----------
+ *
+ * A line with more than one is enabled if any of them is, that one's first.
+ * The path must be interned, like the ones in sview->breaks.
+ *
+ * Return Value: 1 if the file is displayed in a view, 0 otherwise.
+ */
+static int mark_break(struct sviewer *sview, const char *path, int line)
+{
+    struct source_break key;
+    int i;
+
+    key.path = path;
+    key.line = line;
+    key.enabled = 1;
+    i = find_break(sview, &key);
+
+    if (i < sview->breaks_count && sview->breaks[i].line == line &&
+            sview->breaks[i].path == path)
+        return set_break(sview, path, line, sview->breaks[i].enabled ? 1 : 2);
+
+    return set_break(sview, path, line, 0);
+}
+
+/* free_matches: Frees the hlsearch matches of a view.
+ * -------------
+ */
+static void free_matches(struct source_view *view)
+{
+    int i;
+
+    for (i = 0; i < view->matches_count; i++)
+        free(view->matches[i].runs);
+    free(view->matches);
+    view->matches = NULL;
+    view->matches_count = 0;
+}
+
+/* get_match_runs: Gets a line drawn with its hlsearch matches.
+ * ---------------
+ *
+ * The matches are kept by line, so a row that was matched before costs
+ * nothing and scrolling only matches the rows that come into view.
+ *
+ *   view:  The view being displayed
+ *   line:  The line number
+ *   runs:  The highlighting of the line, or NULL
+ *
+ * Return Value: The runs to draw the line with.
+ */
+static const struct hl_run *get_match_runs(struct source_view *view,
+        int line, const struct hl_run *runs)
+{
+    struct source_match *match;
+    struct rx *t;
+
+    /* A line of each row, the rows show lines in a row */
+    if (view->matches_count < view->rows_count) {
+        free_matches(view);
+        view->matches_count = view->rows_count;
+        view->matches = cgdb_calloc(view->matches_count,
+                sizeof (struct source_match));
+    }
+
+    if (line < 0 || view->matches_count == 0)
+        return runs;
+
+    match = &view->matches[line % view->matches_count];
+    if (match->changes == source_changes && match->node == view->cur &&
+            match->line == line)
+        return match->runs ? match->runs : runs;
+
+    free(match->runs);
+    match->runs = NULL;
+    match->changes = source_changes;
+    match->node = view->cur;
+    match->line = line;
+
+    if ((t = hl_regex_compile(source_hlsearch, source_hlsearch_cflags)))
+        match->runs = hl_regex_all(t,
+                buffer_get_line(&view->cur->orig_buf, line), runs);
+
+    return match->runs ? match->runs : runs;
+}
+
+/* get_line_runs: Gets the highlighting to display for a line of a view.
+ * --------------
+ *
+ * The line the user is searching on is drawn with the search match, the
+ * others with the hlsearch matches.
+ *
+ *   view:  The view being displayed
+ *   line:  The line number
+ *
+ * Return Value: The runs to draw the line with, or NULL to draw it plain.
+ */
+static const struct hl_run *get_line_runs(struct source_view *view, int line)
+{
+    const struct hl_run *runs;
+
+    if (line == view->sel_line && view->cur_line)
+        return view->cur_line;
+
+    runs = sources_syntax_on ? buffer_get_runs(&view->cur->buf, line) : NULL;
+
+    if (source_hlsearch)
+        return get_match_runs(view, line, runs);
+
+    return runs;
+}
+
+/* get_search_line: Gets a line for hl_regex to search.
+ * ----------------
+ *
+ *   data:  The node being searched
+ *   line:  The line number
+ *   runs:  If not NULL, returns the highlighting of the line
+ */
+static const char *get_search_line(void *data, int line,
+        const struct hl_run **runs)
+{
+    struct list_node *node = data;
+
+    if (runs)
+        *runs = sources_syntax_on ? buffer_get_runs(&node->buf, line) : NULL;
+
+    return buffer_get_line(&node->orig_buf, line);
+}
+
+/* get_first_line: Gets the line displayed at the top of a view.
+ * ---------------
+ *
+ * The source file is centered if it's small enough, in which case the
+ * first line is negative.
+ *
+ *   view:    The view being displayed
+ *   height:  The height of the view
+ */
+static int get_first_line(struct source_view *view, int height)
+{
+    struct list_node *node = view->cur;
+    int line;
+
+    if (node->buf.length < height)
+        line = (node->buf.length - height) / 2;
+    else {
+        line = view->sel_line - height / 2;
+        if (line > node->buf.length - height)
+            line = node->buf.length - height;
+        else if (line < 0)
+            line = 0;
+    }
+
+    return line;
+}
+
+/* rows_prepare: Makes sure there is a source_row for each row of a view.
+ * -------------
+ *
+ * The rows start out as never drawn whenever the height changes.
+ */
+static void rows_prepare(struct source_view *view, int height)
+{
+    if (view->rows_count == height)
+        return;
+
+    free(view->rows);
+    view->rows = cgdb_calloc(height > 0 ? height : 1,
+            sizeof (struct source_row));
+    view->rows_count = height;
+}
+
+/* rows_forget: Marks every row of a view as never drawn.
+ * ------------
+ */
+static void rows_forget(struct source_view *view)
+{
+    if (view->rows)
+        memset(view->rows, 0, sizeof (struct source_row) * view->rows_count);
+}
+
+/* rows_scroll: Scrolls a view to show a new first line.
+ * ------------
+ *
+ * The rows that are still shown move with the text instead of being
+ * drawn again, and curses can scroll the terminal to match.
+ *
+ *   view:  The view
+ *   line:  The line the first row is about to show
+ */
+static void rows_scroll(struct source_view *view, int line)
+{
+    int delta = line - view->first_line;
+    int height = view->rows_count;
+    struct source_row *rows = view->rows;
+
+    view->first_line = line;
+
+    /* Nothing worth keeping is on the screen */
+    if (delta == 0 || delta >= height || -delta >= height ||
+            rows[0].changes != source_changes || rows[0].node != view->cur)
+        return;
+
+    scrollok(view->win, TRUE);
+    wscrl(view->win, delta);
+    scrollok(view->win, FALSE);
+
+    if (delta > 0) {
+        memmove(rows, rows + delta, sizeof (struct source_row) *
+                (height - delta));
+        memset(rows + height - delta, 0, sizeof (struct source_row) * delta);
+    } else {
+        memmove(rows - delta, rows, sizeof (struct source_row) *
+                (height + delta));
+        memset(rows, 0, sizeof (struct source_row) * -delta);
+    }
+}
+
+/* row_update: Determines if a row needs to be drawn, and records what it
+ * -----------  is drawn with if it does.
+ *
+ *   row:     The row
+ *   view:    The view the row is in
+ *   line:    The line of the file shown in the row
+ *   flags:   SOURCE_ROW_* for the line
+ *   lwidth:  The width of the line numbers
+ *   breakpt: The breakpoint on the line
+ *   heat:    How hot the line is in the profile
+ *
+ * Return Value: 1 if the row has to be drawn, 0 if it's already showing
+ *               the line as it would be drawn.
+ */
+static int row_update(struct source_row *row, struct source_view *view,
+        int line, int flags, int lwidth, char breakpt, char heat)
+{
+    if (row->changes == source_changes && row->node == view->cur &&
+            row->line == line && row->flags == flags &&
+            row->sel_col == view->sel_col && row->lwidth == lwidth &&
+            row->breakpt == breakpt && row->heat == heat)
+        return 0;
+
+    row->changes = source_changes;
+    row->node = view->cur;
+    row->line = line;
+    row->flags = flags;
+    row->sel_col = view->sel_col;
+    row->lwidth = lwidth;
+    row->breakpt = breakpt;
+    row->heat = heat;
+
+    return 1;
+}
+
+/* draw_current_line:  Draws the currently executing source line on the screen
+ * ------------------  including the user-selected marker (arrow, highlight,
+ *                     etc) indicating this is the executing line.
+ *
+ *   view:   The view being drawn
+ *   line:   The line number
+ *   lwidth: The width of the line number, used to limit printing to the width
+ *           of the screen.  Kinda ugly.
+ *   config: The options to draw with
+ */
+static void draw_current_line(struct source_view *view, int line, int lwidth,
+        int arrow_attr, const struct cgdbrc_snapshot *config)
+{
+
+    int height = 0;             /* Height of curses window */
+    int width = 0;              /* Width of curses window */
+    int i = 0, j = 0;           /* Iterators */
+    const char *otext = NULL;   /* The current line */
+    unsigned int length = 0;    /* Length of the line */
+    int column_offset = 0;      /* Text to skip due to arrow */
+    //int arrow_attr;
+    int highlight_attr =
+            hl_groups_get_attrs(hl_groups_instance)[HLG_LINE_HIGHLIGHT];
+    enum ArrowStyle config_arrowstyle = config->arrow_style;
+    int highlight_tabstop = config->tabstop;
+
+    /* Initialize height and width */
+    getmaxyx(view->win, height, width);
+
+    otext = buffer_get_line(&view->cur->orig_buf, line);
+    length = strlen(otext);
+
+    /* Draw the appropriate arrow, if applicable */
+    switch (config_arrowstyle) {
+
+        case ARROWSTYLE_SHORT:
+
+            wattron(view->win, arrow_attr);
+            waddch(view->win, ACS_LTEE);
+            waddch(view->win, '>');
+            wattroff(view->win, arrow_attr);
+            break;
+
+        case ARROWSTYLE_LONG:
+
+            wattron(view->win, arrow_attr);
+            waddch(view->win, ACS_LTEE);
+
+            /* Compute the length of the arrow, respecting tab stops, etc. */
+            for (i = 0; i < length - 1 && isspace((unsigned char) otext[i]); i++) {
+
+                /* Oh so cryptic */
+                int offset = otext[i] != '\t' ? 1 :
+                        highlight_tabstop - (column_offset % highlight_tabstop);
+
+                if (!isspace((unsigned char) otext[i + 1])) {
+                    offset--;
+                }
+
+                column_offset += offset;
+            }
+            column_offset -= view->sel_col;
+            if (column_offset < 0) {
+                column_offset = 0;
+            }
+
+            /* Now actually draw the arrow */
+            for (j = 0; j < column_offset; j++) {
+                waddch(view->win, ACS_HLINE);
+            }
+
+            waddch(view->win, '>');
+            wattroff(view->win, arrow_attr);
+            break;
 
-    /* Release file buffer, if one is in memory */
-    if (cur->buf.tlines) {
-        for (i = 0; i < cur->buf.length; i++) {
-            free(cur->buf.tlines[i]);
-            if (cur->buf.cur_line) {
-                free(cur->buf.cur_line);
-                cur->buf.cur_line = NULL;
+        case ARROWSTYLE_HIGHLIGHT:
+            waddch(view->win, VERT_LINE);
+            waddch(view->win, ' ');
+
+            wattron(view->win, highlight_attr);
+            j = utf8_column_bytes(otext, length, width - lwidth - 2, &i);
+            waddnstr(view->win, otext, j);
+            for (; i < width - lwidth - 2; i++) {
+                waddch(view->win, ' ');
             }
-            free(cur->orig_buf.tlines[i]);
+            wattroff(view->win, highlight_attr);
+
+            return;
+    }
+
+    /* Finally, print the source line */
+    hl_wprintw(view->win, otext, get_line_runs(view, line),
+            width - lwidth - 2, view->sel_col + column_offset,
+            highlight_tabstop);
+}
+
+/* view_move: Gives a view a new window.
+ * ----------
+ */
+static void view_move(struct source_view *view,
+        int pos_r, int pos_c, int height, int width)
+{
+    if (view->win)
+        delwin(view->win);
+    view->win = newwin(height, width, pos_r, pos_c);
+    wclear(view->win);
+
+    /* Let curses scroll the terminal instead of redrawing every row */
+    idlok(view->win, TRUE);
+
+    /* Nothing is drawn in the new window */
+    free(view->rows);
+    view->rows = NULL;
+    view->rows_count = 0;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* Descriptive comments found in header file: sources.h */
+
+/* source_marks_find: Finds where a mark goes in the marks of a file.
+ * ------------------
+ *
+ * Return Value: The index of the first mark at or after the line and kind.
+ */
+static int source_marks_find(const struct source_marks *marks, int line,
+        enum source_mark_kind kind)
+{
+    int low = 0, high = marks->count, mid;
+
+    while (low < high) {
+        mid = (low + high) / 2;
+        if (marks->marks[mid].line < line || (marks->marks[mid].line == line
+                        && marks->marks[mid].kind < kind))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+void source_marks_set(struct source_marks *marks, int line,
+        enum source_mark_kind kind, int value)
+{
+    int i = source_marks_find(marks, line, kind);
+    int found = i < marks->count && marks->marks[i].line == line &&
+            marks->marks[i].kind == kind;
+
+    if (value == 0) {
+        if (found) {
+            memmove(&marks->marks[i], &marks->marks[i + 1],
+                    sizeof (struct source_mark) * (marks->count - i - 1));
+            marks->count--;
         }
+        return;
     }
-    free(cur->buf.tlines);
-    free(cur->orig_buf.tlines);
 
-    /* Release the breakpoints */
-    if (cur->buf.breakpts) {
-        free(cur->buf.breakpts);
-        cur->buf.breakpts = NULL;
+    if (!found) {
+        if (marks->count == marks->size) {
+            marks->size = marks->size ? marks->size * 2 : 8;
+            marks->marks = cgdb_realloc(marks->marks,
+                    sizeof (struct source_mark) * marks->size);
+        }
+
+        memmove(&marks->marks[i + 1], &marks->marks[i],
+                sizeof (struct source_mark) * (marks->count - i));
+        marks->marks[i].line = line;
+        marks->marks[i].kind = kind;
+        marks->count++;
     }
 
-    /* Release file name */
-    free(cur->path);
-    cur->path = NULL;
+    marks->marks[i].value = value;
+}
+
+int source_marks_get(const struct source_marks *marks, int line,
+        enum source_mark_kind kind)
+{
+    int i = source_marks_find(marks, line, kind);
+
+    if (i < marks->count && marks->marks[i].line == line &&
+            marks->marks[i].kind == kind)
+        return marks->marks[i].value;
+
+    return 0;
+}
+
+int source_marks_next(const struct source_marks *marks, int *index, int line,
+        enum source_mark_kind kind)
+{
+    int i = *index;
+
+    /* The marks before the line are skipped with a search, not one by one */
+    if (i < marks->count && marks->marks[i].line < line)
+        i = source_marks_find(marks, line, 0);
+    *index = i;
+
+    for (; i < marks->count && marks->marks[i].line == line; i++)
+        if (marks->marks[i].kind == kind)
+            return marks->marks[i].value;
+
+    return 0;
+}
+
+void source_marks_clear(struct source_marks *marks,
+        enum source_mark_kind kind)
+{
+    int i, count = 0;
+
+    for (i = 0; i < marks->count; i++)
+        if (marks->marks[i].kind != kind)
+            marks->marks[count++] = marks->marks[i];
+
+    marks->count = count;
+}
+
+void buffer_set_length(struct buffer *buf, int length, size_t size)
+{
+    int i;
+
+    free(buf->lines);
+    free(buf->bases);
+    free(buf->text);
+    free(buf->runs);
+
+    buf->length = length;
+    buf->lines = cgdb_malloc(sizeof (uint32_t) * (length > 0 ? length : 1));
+    for (i = 0; i < length; i++)
+        buf->lines[i] = BUFFER_NO_LINE;
+
+    buf->bases = cgdb_malloc(sizeof (size_t) * BUFFER_BLOCKS(length));
+    for (i = 0; i < BUFFER_BLOCKS(length); i++)
+        buf->bases[i] = BUFFER_NO_BASE;
+
+    buf->runs = NULL;
+    buf->used = 0;
+    buf->size = size;
+    buf->text = size > 0 ? cgdb_malloc(size) : NULL;
+}
+
+/* buffer_reserve: Makes room for more elements at the end of a buffer's
+ * --------------- block of text or runs, growing it geometrically.
+ *
+ *   buf:     The buffer
+ *   block:   The block, either buf->text or buf->runs
+ *   needed:  The number of elements the block has to hold
+ *   elsize:  The size of an element
+ */
+static void buffer_reserve(struct buffer *buf, void **block, size_t needed,
+        size_t elsize)
+{
+    size_t size;
+
+    if (needed <= buf->size)
+        return;
+
+    size = buf->size ? buf->size : 4096 / elsize;
+    while (size < needed)
+        size *= 2;
+
+    *block = cgdb_realloc(*block, size * elsize);
+    buf->size = size;
+}
+
+/* buffer_set_offset: Points a line at the end of a buffer's block.
+ * ------------------
+ *
+ * The first line of a block of lines to be set gives the block its base.
+ *
+ *   buf:   The buffer
+ *   line:  The index of the line
+ *
+ * Return Value: 0 on success, -1 if the block of lines has outgrown the
+ * offsets.
+ */
+static int buffer_set_offset(struct buffer *buf, int line)
+{
+    size_t *base = &buf->bases[line / BUFFER_BLOCK];
+
+    if (*base == BUFFER_NO_BASE)
+        *base = buf->used;
+
+    if (buf->used - *base >= BUFFER_NO_LINE)
+        return -1;
+
+    buf->lines[line] = buf->used - *base;
+
+    return 0;
+}
+
+/* buffer_offset: The offset into the block of a line that has one.
+ * --------------
+ */
+static size_t buffer_offset(const struct buffer *buf, int line)
+{
+    return buf->bases[line / BUFFER_BLOCK] + buf->lines[line];
+}
+
+int buffer_set_line(struct buffer *buf, int line, const char *text,
+        size_t length)
+{
+    if (!buf->lines || line < 0 || line >= buf->length)
+        return -1;
+
+    if (!text) {
+        buf->lines[line] = BUFFER_NO_LINE;
+        return 0;
+    }
+
+    buffer_reserve(buf, (void **) &buf->text, buf->used + length + 1,
+            sizeof (char));
+    if (buffer_set_offset(buf, line) == -1)
+        return -1;
+
+    memcpy(buf->text + buf->used, text, length);
+    buf->text[buf->used + length] = 0;
+    buf->used += length + 1;
+
+    return 0;
+}
+
+const char *buffer_get_line(const struct buffer *buf, int line)
+{
+    if (!buf->lines || !buf->text || line < 0 || line >= buf->length ||
+            buf->lines[line] == BUFFER_NO_LINE)
+        return NULL;
+
+    return buf->text + buffer_offset(buf, line);
+}
+
+int buffer_set_runs(struct buffer *buf, int line, const struct hl_run *runs,
+        int count)
+{
+    if (!buf->lines || line < 0 || line >= buf->length)
+        return -1;
+
+    if (count <= 0) {
+        buf->lines[line] = BUFFER_NO_LINE;
+        return 0;
+    }
+
+    buffer_reserve(buf, (void **) &buf->runs, buf->used + count + 1,
+            sizeof (struct hl_run));
+    if (buffer_set_offset(buf, line) == -1)
+        return -1;
+
+    memcpy(buf->runs + buf->used, runs, sizeof (struct hl_run) * count);
+    memset(buf->runs + buf->used + count, 0, sizeof (struct hl_run));
+    buf->used += count + 1;
+
+    return 0;
+}
+
+const struct hl_run *buffer_get_runs(const struct buffer *buf, int line)
+{
+    if (!buf->lines || !buf->runs || line < 0 || line >= buf->length ||
+            buf->lines[line] == BUFFER_NO_LINE)
+        return NULL;
+
+    return buf->runs + buffer_offset(buf, line);
+}
+
+struct sviewer *source_new(int pos_r, int pos_c, int height, int width)
+{
+    struct sviewer *rv;
+
+    /* Allocate a new structure */
+    if ((rv = malloc(sizeof (struct sviewer))) == NULL)
+        return NULL;
+
+    /* Initialize the structure, the files are shown in one view */
+    memset(rv->views, 0, sizeof (rv->views));
+    view_move(&rv->views[0], pos_r, pos_c, height, width);
+    rv->view_count = 1;
+    rv->view = &rv->views[0];
+    rv->list_head = NULL;
+
+    /* The keys are the paths owned by the nodes */
+    rv->path_index = std_ohash_table_new(std_str_hash, std_str_equal);
+    rv->lpath_index = std_ohash_table_new(std_str_hash, std_str_equal);
+    rv->stat_cache = std_ohash_table_new_full(std_str_hash, std_str_equal,
+            NULL, source_stat_free);
+
+    rv->breaks = NULL;
+    rv->breaks_count = 0;
+
+    rv->heat = NULL;
+    rv->heat_count = 0;
+
+    rv->prefetch = NULL;
+    rv->prefetch_count = 0;
+
+    return rv;
+}
+
+int source_add(struct sviewer *sview, const char *path)
+{
+    struct list_node *new_node;
+
+    new_node = malloc(sizeof (struct list_node));
+    new_node->path = std_intern(path);
+    new_node->lpath = NULL;
+    memset(&new_node->buf, 0, sizeof (struct buffer));
+    memset(&new_node->orig_buf, 0, sizeof (struct buffer));
+    new_node->views = 0;
+    new_node->last_line = 0;
+    new_node->exe_line = 0;
+    new_node->last_modification = 0;    /* No timestamp yet */
+    new_node->file_size = 0;
+    new_node->watch = -1;
+    new_node->dirty = 0;
+    new_node->hl_lazy = 0;
+    new_node->hl_states = NULL;
+    new_node->hl_state_count = 0;
+    new_node->hl_previous = NULL;
+    new_node->symbols = NULL;
+    new_node->loading = 0;
+    new_node->load_line = 0;
+    new_node->text = 0;
+    new_node->mem = 0;
+    new_node->last_used = 0;
+    memset(&new_node->marks, 0, sizeof (struct source_marks));
+
+    if (sview->list_head == NULL) {
+        /* List is empty, this is the first node */
+        new_node->next = NULL;
+        sview->list_head = new_node;
+    } else {
+        /* Insert at the front of the list (easy) */
+        new_node->next = sview->list_head;
+        sview->list_head = new_node;
+    }
+
+    std_ohash_table_insert(sview->path_index, (void *) new_node->path,
+            new_node);
+
+    return 0;
+}
+
+int source_set_text(struct sviewer *sview, const char *path,
+        const char *data, size_t size)
+{
+    struct list_node *node = get_node(sview, path);
+
+    if (!node) {
+        if (source_add(sview, path))
+            return 1;
+        node = get_node(sview, path);
+    }
+
+    release_file_memory(node);
+
+    node->text = 1;
+    node->file_size = size;
+
+    if (load_file_buf(&node->orig_buf, data, size) == -1)
+        return 2;
+
+    /* The lines are drawn as they are */
+    node->language = TOKENIZER_LANGUAGE_UNKNOWN;
+    if (has_colors())
+        highlight(node, NULL, 0);
+    else {
+        node->buf.length = node->orig_buf.length;
+        node->buf.max_width = node->orig_buf.max_width;
+    }
+
+    node->last_used = ++sview->tick;
+    update_mem(node);
+    views_loaded(sview, node);
+
+    return 0;
+}
+
+int source_set_relative_path(struct sviewer *sview,
+        const char *path, const char *lpath)
+{
+
+    struct list_node *node = get_node(sview, path);
+
+    if (node == NULL)
+        return -1;
+
+    if (node->lpath) {
+        if (get_relative_node(sview, node->lpath) == node)
+            std_ohash_table_remove(sview->lpath_index, node->lpath);
+    }
+
+    node->lpath = std_intern(lpath);
+    std_ohash_table_insert(sview->lpath_index, (void *) node->lpath, node);
+
+    /* gdb names the files of its breakpoints by their relative path */
+    apply_breaks(sview, node);
+    apply_heat(sview, node);
+
+    return 0;
+}
+
+int source_del(struct sviewer *sview, const char *path)
+{
+    struct list_node *cur;
+    struct list_node *prev = NULL;
+    const char *key = std_intern_lookup(path);
+    int i;
+
+    if (key == NULL)
+        return 1;               /* Node not found */
+
+    /* Find the target node */
+    for (cur = sview->list_head; cur != NULL; cur = cur->next) {
+        if (cur->path == key)
+            break;
+        prev = cur;
+    }
+
+    if (cur == NULL)
+        return 1;               /* Node not found */
 
-    /* Release local file name */
-    if (cur->lpath) {
-        free(cur->lpath);
-        cur->lpath = NULL;
+    /* The rows can't be told apart from a node that takes its place */
+    for (i = 0; i < sview->view_count; i++) {
+        if (sview->views[i].cur == cur)
+            view_show(&sview->views[i], NULL);
+        rows_forget(&sview->views[i]);
     }
 
+    highlight_stop(cur);
+    highlight_forget(cur);
+    unwatch_file(cur);
+
+    /* Drop the node from the indexes */
+    std_ohash_table_remove(sview->path_index, cur->path);
+    if (cur->lpath && get_relative_node(sview, cur->lpath) == cur)
+        std_ohash_table_remove(sview->lpath_index, cur->lpath);
+
+    /* Release file buffer and breakpoints, if they are in memory */
+    release_file_buffer(&cur->buf);
+    release_file_buffer(&cur->orig_buf);
+    free(cur->marks.marks);
+    memset(&cur->marks, 0, sizeof (struct source_marks));
+
+    /* The file names are interned, they're only forgotten */
+    cur->path = NULL;
+    cur->lpath = NULL;
+
     /* Remove link from list */
     if (cur == sview->list_head)
         sview->list_head = sview->list_head->next;
@@ -534,7 +1885,7 @@ int source_length(struct sviewer *sview, const char *path)
 
     if (!cur) {
         /* Load the file if it's not already */
-        if (!cur->buf.tlines && load_file(cur))
+        if (!file_loaded(cur) && load_node(sview, cur))
             return -1;
     }
 
@@ -543,31 +1894,114 @@ int source_length(struct sviewer *sview, const char *path)
 
 char *source_current_file(struct sviewer *sview, char *path)
 {
-    if (sview == NULL || sview->cur == NULL)
+    if (sview == NULL || sview->view->cur == NULL)
         return NULL;
 
-    strcpy(path, sview->cur->path);
+    strcpy(path, sview->view->cur->path);
     return path;
 }
 
-int source_display(struct sviewer *sview, int focus)
+const struct buffer *source_get_buffer(struct sviewer *sview,
+        const char *path)
+{
+    struct list_node *node;
+
+    if (sview == NULL || path == NULL)
+        return NULL;
+
+    if ((node = get_node(sview, path)) == NULL &&
+            (node = get_relative_node(sview, path)) == NULL)
+        return NULL;
+
+    return file_loaded(node) ? &node->orig_buf : NULL;
+}
+
+const char *source_absolute_path(struct sviewer *sview, const char *lpath)
+{
+    struct list_node *node;
+
+    if (sview == NULL || lpath == NULL)
+        return NULL;
+
+    if ((node = get_relative_node(sview, lpath)) == NULL)
+        return NULL;
+
+    return node->path;
+}
+
+/* loading_display: Shows that the current file is still being read.
+ * ----------------
+ *
+ *   view:  The view showing the file
+ */
+static void loading_display(struct source_view *view)
+{
+    const char *path = view->cur->path;
+    size_t done, total;
+    char progress[64];
+    int height, width, length;
+
+    werase(view->win);
+    getmaxyx(view->win, height, width);
+
+    /* A long path is cut down to its end, the file name */
+    length = strlen(path) + strlen("Loading ...");
+    if (length > width) {
+        path += length - width < (int) strlen(path) ?
+                length - width : (int) strlen(path);
+        length = strlen(path) + strlen("Loading ...");
+    }
+
+    wmove(view->win, height / 2, length < width ? (width - length) / 2 : 0);
+    wprintw(view->win, "Loading %s...", path);
+
+    if (loader_progress(view->cur->path, &done, &total) && total > 0) {
+        snprintf(progress, sizeof (progress), "%lu of %lu KB",
+                (unsigned long) (done / 1024),
+                (unsigned long) (total / 1024));
+        length = strlen(progress);
+        if (height / 2 + 1 < height)
+            mvwaddnstr(view->win, height / 2 + 1,
+                    length < width ? (width - length) / 2 : 0, progress, width);
+    }
+}
+
+/* view_display: Draws a view of the source viewer.
+ * -------------
+ *
+ *   view:       The view
+ *   focus:      If the view has the focus
+ *   dorefresh:  If the terminal is refreshed, or only the virtual screen
+ *   config:     The options to draw with
+ */
+static void view_display(struct source_view *view, int focus,
+        enum win_refresh dorefresh, const struct cgdbrc_snapshot *config)
 {
     char fmt[5];
     int width, height;
     int lwidth;
     int line;
     int i;
+    int mark = 0;               /* The walk through the marks of the file */
+    int heat_mark = 0;          /* The same walk, for the heat */
+    char breakpt, heat;
     int attr = 0, sellineno;
+    const int *attrs = hl_groups_get_attrs(hl_groups_instance);
 
-    if (hl_groups_get_attr(hl_groups_instance, HLG_SELECTED_LINE_NUMBER,
-                    &sellineno) == -1)
-        return -1;
+    sellineno = attrs[HLG_SELECTED_LINE_NUMBER];
 
     /* Check that a file is loaded */
-    if (sview->cur == NULL || sview->cur->buf.tlines == NULL) {
-        logo_display(sview->win);
-        wrefresh(sview->win);
-        return 0;
+    if (view->cur == NULL || !file_loaded(view->cur)) {
+        rows_forget(view);
+        if (view->cur && view->cur->loading)
+            loading_display(view);
+        else
+            logo_display(view->win);
+        if (dorefresh == WIN_REFRESH)
+            wrefresh(view->win);
+        else
+            wnoutrefresh(view->win);
+        return;
     }
 
     /* Make sure cursor is visible */
@@ -577,172 +2011,170 @@ int source_display(struct sviewer *sview, int focus)
         curs_set(0);
 
     /* Initialize variables */
-    getmaxyx(sview->win, height, width);
+    getmaxyx(view->win, height, width);
 
     /* Set starting line number (center source file if it's small enough) */
-    if (sview->cur->buf.length < height)
-        line = (sview->cur->buf.length - height) / 2;
-    else {
-        line = sview->cur->sel_line - height / 2;
-        if (line > sview->cur->buf.length - height)
-            line = sview->cur->buf.length - height;
-        else if (line < 0)
-            line = 0;
-    }
+    line = get_first_line(view, height);
+
+    /* Large files are only highlighted once they're displayed */
+    if (view->cur->hl_lazy == 1)
+        highlight_start(view->cur, line, line + height);
 
     /* Print 'height' lines of the file, starting at 'line' */
-    lwidth = (int) log10(sview->cur->buf.length) + 1;
+    lwidth = (int) log10(view->cur->buf.length) + 1;
     sprintf(fmt, "%%%dd", lwidth);
 
-    
-   
+    rows_prepare(view, height);
+    if (has_colors())
+        rows_scroll(view, line);
+    else
+        rows_forget(view);
 
     for (i = 0; i < height; i++, line++) {
-        wmove(sview->win, i, 0);
+        breakpt = line >= 0 && line < view->cur->buf.length ?
+                source_marks_next(&view->cur->marks, &mark, line,
+                SOURCE_MARK_BREAK) : 0;
+        heat = line >= 0 && line < view->cur->buf.length ?
+                source_marks_next(&view->cur->marks, &heat_mark, line,
+                SOURCE_MARK_HEAT) : 0;
+
+        /* Only the rows that changed are drawn */
+        if (has_colors()) {
+            int flags = focus ? SOURCE_ROW_FOCUS : 0;
+
+            if (line == view->cur->exe_line)
+                flags |= SOURCE_ROW_EXE;
+            if (line == view->sel_line)
+                flags |= SOURCE_ROW_SEL;
+
+            if (!row_update(&view->rows[i], view, line, flags, lwidth,
+                            breakpt, heat))
+                continue;
+        }
+
+        wmove(view->win, i, 0);
         if (has_colors()) {
             /* Outside of file, just finish drawing the vertical line */
-            if (line < 0 || line >= sview->cur->buf.length) {
+            if (line < 0 || line >= view->cur->buf.length) {
                 int j;
 
                 for (j = 1; j < lwidth; j++)
-                    waddch(sview->win, ' ');
-                waddch(sview->win, '~');
+                    waddch(view->win, ' ');
+                waddch(view->win, '~');
                 if (focus)
-                    wattron(sview->win, A_BOLD);
-                waddch(sview->win, VERT_LINE);
+                    wattron(view->win, A_BOLD);
+                waddch(view->win, VERT_LINE);
                 if (focus)
-                    wattroff(sview->win, A_BOLD);
+                    wattroff(view->win, A_BOLD);
                 for (j = 2 + lwidth; j < width; j++)
-                    waddch(sview->win, ' ');
+                    waddch(view->win, ' ');
 
                 /* Mark the current line with an arrow or the selected line if in focus and arrowalllines is on */
-            } else if ( line == sview->cur->exe_line || (focus && cgdbrc_get(CGDBRC_ARROWSELECTEDLINE)->variant.int_val && sview->cur->sel_line == line) ) {
-                switch (sview->cur->buf.breakpts[line]) {
+            } else if ( line == view->cur->exe_line || (focus && config->arrow_selected_line && view->sel_line == line) ) {
+                switch (breakpt) {
                     case 0:
                         {
                             enum hl_group_kind arr_attr;
-                            if (line == sview->cur->sel_line && line != sview->cur->exe_line)
+                            if (line == view->sel_line && line != view->cur->exe_line)
                                 arr_attr = HLG_ARROW_SEL;
                             else
                                 arr_attr = HLG_ARROW;
 
-                            if (hl_groups_get_attr(hl_groups_instance, arr_attr,
-                                        &attr) == -1)
-                            return -1;
+                            attr = attrs[arr_attr];
                         }
                         break;
                     case 1:
-                        if (hl_groups_get_attr(hl_groups_instance,
-                                        HLG_ENABLED_BREAKPOINT, &attr) == -1)
-                            return -1;
+                        attr = attrs[HLG_ENABLED_BREAKPOINT];
                         break;
                     case 2:
-                        if (hl_groups_get_attr(hl_groups_instance,
-                                        HLG_DISABLED_BREAKPOINT, &attr) == -1)
-                            return -1;
+                        attr = attrs[HLG_DISABLED_BREAKPOINT];
                         break;
                 }
-                wattron(sview->win, attr);
-                wprintw(sview->win, fmt, line + 1);
-                wattroff(sview->win, attr);
+                wattron(view->win, attr);
+                wprintw(view->win, fmt, line + 1);
+                wattroff(view->win, attr);
 
-                draw_current_line(sview, line, lwidth, attr);
+                draw_current_line(view, line, lwidth, attr, config);
 
                 /* Look for breakpoints */
-            } else if (sview->cur->buf.breakpts[line]) {
-                if (sview->cur->buf.breakpts[line] == 1) {
-                    if (hl_groups_get_attr(hl_groups_instance,
-                                    HLG_ENABLED_BREAKPOINT, &attr) == -1)
-                        return -1;
-                } else {
-                    if (hl_groups_get_attr(hl_groups_instance,
-                                    HLG_DISABLED_BREAKPOINT, &attr) == -1)
-                        return -1;
-                }
-                wattron(sview->win, attr);
-                wprintw(sview->win, fmt, line + 1);
-                wattroff(sview->win, attr);
+            } else if (breakpt) {
+                if (breakpt == 1)
+                    attr = attrs[HLG_ENABLED_BREAKPOINT];
+                else
+                    attr = attrs[HLG_DISABLED_BREAKPOINT];
+                wattron(view->win, attr);
+                wprintw(view->win, fmt, line + 1);
+                wattroff(view->win, attr);
                 if (focus)
-                    wattron(sview->win, A_BOLD);
-                waddch(sview->win, VERT_LINE);
+                    wattron(view->win, A_BOLD);
+                waddch(view->win, VERT_LINE);
                 if (focus)
-                    wattroff(sview->win, A_BOLD);
-                waddch(sview->win, ' ');
-
-                /* I know this is rediculous, it needs to be reimplemented */
-                if (sources_syntax_on) {
-                    if (line == sview->cur->sel_line &&
-                            sview->cur->buf.cur_line != NULL) {
-                        hl_wprintw(sview->win, sview->cur->buf.cur_line,
-                                width - lwidth - 2, sview->cur->sel_col);
-
-                    } else {
-                        hl_wprintw(sview->win, sview->cur->buf.tlines[line],
-                                width - lwidth - 2, sview->cur->sel_col);
-                    }
-                } else {
-                    if (line == sview->cur->sel_line &&
-                            sview->cur->buf.cur_line != NULL) {
-                        hl_wprintw(sview->win, sview->cur->orig_buf.cur_line,
-                                width - lwidth - 2, sview->cur->sel_col);
-
-                    } else {
-                        hl_wprintw(sview->win,
-                                sview->cur->orig_buf.tlines[line],
-                                width - lwidth - 2, sview->cur->sel_col);
-                    }
-                }
+                    wattroff(view->win, A_BOLD);
+                waddch(view->win, ' ');
+
+                hl_wprintw(view->win,
+                        buffer_get_line(&view->cur->orig_buf, line),
+                        get_line_runs(view, line), width - lwidth - 2,
+                        view->sel_col, config->tabstop);
             }
-            /* Ordinary lines */
+            /* Ordinary lines, the profiler colors the number of the hot ones */
             else {
-                if (focus && sview->cur->sel_line == line)
-                    wattron(sview->win, sellineno);
-
-                wprintw(sview->win, fmt, line + 1);
+                if (focus && view->sel_line == line)
+                    attr = sellineno;
+                else if (heat)
+                    attr = attrs[HLG_PROFILE_COOL + heat - 1];
+                else
+                    attr = 0;
 
-                if (focus && sview->cur->sel_line == line)
-                    wattroff(sview->win, sellineno);
+                wattron(view->win, attr);
+                wprintw(view->win, fmt, line + 1);
+                wattroff(view->win, attr);
 
                 if (focus)
-                    wattron(sview->win, A_BOLD);
-                waddch(sview->win, VERT_LINE);
+                    wattron(view->win, A_BOLD);
+                waddch(view->win, VERT_LINE);
                 if (focus)
-                    wattroff(sview->win, A_BOLD);
-                waddch(sview->win, ' ');
-
-                /* I know this is rediculous, it needs to be reimplemented */
-                if (sources_syntax_on) {
-                    /* No special line information */
-                    if (line == sview->cur->sel_line &&
-                            sview->cur->buf.cur_line != NULL) {
-                        hl_wprintw(sview->win, sview->cur->buf.cur_line,
-                                width - lwidth - 2, sview->cur->sel_col);
-
-                    } else {
-                        hl_wprintw(sview->win, sview->cur->buf.tlines[line],
-                                width - lwidth - 2, sview->cur->sel_col);
-                    }
-                } else {
-                    /* No special line information */
-                    if (line == sview->cur->sel_line &&
-                            sview->cur->buf.cur_line != NULL) {
-                        hl_wprintw(sview->win, sview->cur->orig_buf.cur_line,
-                                width - lwidth - 2, sview->cur->sel_col);
-
-                    } else {
-                        hl_wprintw(sview->win,
-                                sview->cur->orig_buf.tlines[line],
-                                width - lwidth - 2, sview->cur->sel_col);
-                    }
-                }
+                    wattroff(view->win, A_BOLD);
+                waddch(view->win, ' ');
+
+                hl_wprintw(view->win,
+                        buffer_get_line(&view->cur->orig_buf, line),
+                        get_line_runs(view, line), width - lwidth - 2,
+                        view->sel_col, config->tabstop);
             }
         } else {
-            wprintw(sview->win, "%s\n", sview->cur->buf.tlines[line]);
+            wprintw(view->win, "%s\n",
+                    buffer_get_line(&view->cur->orig_buf, line));
         }
     }
 
-    wmove(sview->win, height - (line - sview->cur->sel_line), lwidth + 2);
-    wrefresh(sview->win);
+    wmove(view->win, height - (line - view->sel_line), lwidth + 2);
+
+    /* Rows that weren't drawn still have to be copied out, in case
+     * something else was drawn over them on the screen */
+    touchwin(view->win);
+    if (dorefresh == WIN_REFRESH)
+        wrefresh(view->win);
+    else
+        wnoutrefresh(view->win);
+
+}
+
+int source_display(struct sviewer *sview, int focus,
+        enum win_refresh dorefresh, const struct cgdbrc_snapshot *config)
+{
+    view_display(&sview->views[0], focus, dorefresh, config);
+
+    return 0;
+}
+
+int source_view_display(struct sviewer *sview, int index, int focus,
+        enum win_refresh dorefresh, const struct cgdbrc_snapshot *config)
+{
+    if (index < 0 || index >= sview->view_count)
+        return -1;
+
+    view_display(&sview->views[index], focus, dorefresh, config);
 
     return 0;
 }
@@ -750,21 +2182,187 @@ int source_display(struct sviewer *sview, int focus)
 void source_move(struct sviewer *sview,
         int pos_r, int pos_c, int height, int width)
 {
-    delwin(sview->win);
-    sview->win = newwin(height, width, pos_r, pos_c);
-    wclear(sview->win);
+    view_move(&sview->views[0], pos_r, pos_c, height, width);
 }
 
-void source_vscroll(struct sviewer *sview, int offset)
+void source_view_move(struct sviewer *sview, int index,
+        int pos_r, int pos_c, int height, int width)
+{
+    if (index >= 0 && index < sview->view_count)
+        view_move(&sview->views[index], pos_r, pos_c, height, width);
+}
+
+void source_set_views(struct sviewer *sview, int count)
+{
+    struct source_view *from = sview->view;
+    struct source_view *view;
+    int i;
+
+    if (count < 1)
+        count = 1;
+    if (count > SOURCE_VIEWS)
+        count = SOURCE_VIEWS;
+
+    /* The views that go away stop showing their files */
+    for (i = count; i < sview->view_count; i++) {
+        view = &sview->views[i];
+        view_show(view, NULL);
+        free(view->rows);
+        free_matches(view);
+        if (view->win)
+            delwin(view->win);
+        memset(view, 0, sizeof (struct source_view));
+    }
+
+    if (sview->view - sview->views >= count)
+        from = sview->view = &sview->views[0];
+
+    /* The new ones show what the user is looking at, their windows are
+     * made by source_view_move */
+    for (i = sview->view_count; i < count; i++) {
+        view = &sview->views[i];
+        view_show(view, from->cur);
+        view->sel_line = view->sel_rline = from->sel_line;
+        view->sel_col = from->sel_col;
+    }
+
+    sview->view_count = count;
+}
+
+void source_set_view(struct sviewer *sview, int index)
+{
+    if (index >= 0 && index < sview->view_count)
+        sview->view = &sview->views[index];
+}
+
+int source_get_view(struct sviewer *sview)
+{
+    return sview->view - sview->views;
+}
+
+void source_show_none(struct sviewer *sview)
+{
+    view_show(sview->view, NULL);
+}
+
+int source_selected_line(struct sviewer *sview, struct list_node *node)
+{
+    struct source_view *view = node_view(sview, node);
+
+    return view ? view->sel_line : node->last_line;
+}
+
+void source_set_hlsearch(const char *regex, int icase)
+{
+    free(source_hlsearch);
+    source_hlsearch = regex && *regex ? cgdb_strdup(regex) : NULL;
+    source_hlsearch_cflags = hl_regex_cflags(icase);
+
+    /* The rows and the matches kept are drawn again */
+    source_changes++;
+}
+
+/* view_symbols: Gets the symbol index of the file a view shows.
+ * -------------
+ */
+static struct symbols *view_symbols(struct source_view *view)
+{
+    struct symbols *symbols;
+
+    if (!view->cur || !file_loaded(view->cur))
+        return NULL;
+
+    if (!view->cur->symbols && (symbols = highlight_symbols(view->cur))) {
+        update_mem(view->cur);
+        return symbols;
+    }
+
+    return view->cur->symbols;
+}
+
+/* view_word: Gets the identifier at the cursor of a view.
+ * ----------
+ *
+ * Return Value: 0 on success, -1 if there's none.
+ */
+static int view_word(struct source_view *view, struct symbols *symbols,
+        char *name, size_t size, struct symbol_position *pos)
+{
+    int col = view->sel_rline == view->sel_line ? view->sel_col_rbeg : -1;
+
+    return symbols_at(symbols, view->sel_line, col, name, size, pos);
+}
+
+/* view_goto: Selects a place in the file a view shows.
+ * ----------
+ *
+ * It's where the next search starts, and the identifier at the cursor.
+ */
+static void view_goto(struct source_view *view,
+        const struct symbol_position *pos)
+{
+    free(view->cur_line);
+    view->cur_line = NULL;
+
+    view->sel_line = view->sel_rline = pos->line;
+    view->sel_col_rbeg = pos->col;
+    view->sel_col_rend = pos->col + pos->length;
+}
+
+int source_goto_definition(struct sviewer *sview, const char *name)
+{
+    struct symbols *symbols = view_symbols(sview->view);
+    struct symbol_position pos;
+    char word[MAX_LINE];
+    int ret;
+
+    if (!symbols)
+        return -2;
+
+    if (!name) {
+        if (view_word(sview->view, symbols, word, sizeof (word), &pos) == -1)
+            return -2;
+        name = word;
+    }
+
+    if ((ret = symbols_definition(symbols, name, &pos)) == -1)
+        return -1;
+
+    view_goto(sview->view, &pos);
+
+    return ret;
+}
+
+int source_goto_occurrence(struct sviewer *sview, int direction)
 {
-    if (sview->cur) {
-        sview->cur->sel_line += offset;
-        if (sview->cur->sel_line < 0)
-            sview->cur->sel_line = 0;
-        if (sview->cur->sel_line >= sview->cur->buf.length)
-            sview->cur->sel_line = sview->cur->buf.length - 1;
+    int wrapscan = cgdbrc_get(CGDBRC_WRAPSCAN)->variant.int_val;
+    struct symbols *symbols = view_symbols(sview->view);
+    struct symbol_position pos;
+    char word[MAX_LINE];
+
+    if (!symbols ||
+            view_word(sview->view, symbols, word, sizeof (word), &pos) == -1)
+        return -2;
+
+    if (symbols_next(symbols, word, pos.line, pos.col, direction, wrapscan,
+                    &pos) == -1)
+        return -1;
+
+    view_goto(sview->view, &pos);
+
+    return 0;
+}
 
-        sview->cur->sel_rline = sview->cur->sel_line;
+void source_vscroll(struct sviewer *sview, int offset)
+{
+    if (sview->view->cur) {
+        sview->view->sel_line += offset;
+        if (sview->view->sel_line < 0)
+            sview->view->sel_line = 0;
+        if (sview->view->sel_line >= sview->view->cur->buf.length)
+            sview->view->sel_line = sview->view->cur->buf.length - 1;
+
+        sview->view->sel_rline = sview->view->sel_line;
     }
 }
 
@@ -773,179 +2371,531 @@ void source_hscroll(struct sviewer *sview, int offset)
     int lwidth;
     int max_width;
 
-    if (sview->cur) {
-        lwidth = (int) log10(sview->cur->buf.length) + 1;
-        max_width = sview->cur->buf.max_width - COLS + lwidth + 6;
+    if (sview->view->cur) {
+        lwidth = (int) log10(sview->view->cur->buf.length) + 1;
+        max_width = sview->view->cur->buf.max_width -
+                getmaxx(sview->view->win) + lwidth + 6;
 
-        sview->cur->sel_col += offset;
-        if (sview->cur->sel_col > max_width)
-            sview->cur->sel_col = max_width;
-        if (sview->cur->sel_col < 0)
-            sview->cur->sel_col = 0;
+        sview->view->sel_col += offset;
+        if (sview->view->sel_col > max_width)
+            sview->view->sel_col = max_width;
+        if (sview->view->sel_col < 0)
+            sview->view->sel_col = 0;
     }
 }
 
 void source_set_sel_line(struct sviewer *sview, int line)
 {
-    if (sview->cur) {
+    if (sview->view->cur) {
         /* Set line (note correction for 0-based line counting) */
-        sview->cur->sel_line = line - 1;
-        if (sview->cur->sel_line < 0)
-            sview->cur->sel_line = 0;
-        if (sview->cur->sel_line >= sview->cur->buf.length)
-            sview->cur->sel_line = sview->cur->buf.length - 1;
+        sview->view->sel_line = line - 1;
+        if (sview->view->sel_line < 0)
+            sview->view->sel_line = 0;
+        if (sview->view->sel_line >= sview->view->cur->buf.length)
+            sview->view->sel_line = sview->view->cur->buf.length - 1;
 
-        sview->cur->sel_rline = sview->cur->sel_line;
+        sview->view->sel_rline = sview->view->sel_line;
     }
 }
 
 int source_set_exec_line(struct sviewer *sview, const char *path, int line)
 {
-    if (path && !verify_file_exists(path))
+    struct list_node *node = NULL;
+    int ret;
+
+    if (path && !verify_file_exists(sview, path))
         return 5;
 
     /* Locate node, if path has changed */
-    if (path != NULL && !(sview->cur = get_node(sview, path))) {
+    if (path != NULL && !(node = get_node(sview, path))) {
         /* Not found -- attempt to add */
         if (source_add(sview, path))
             return 1;
-        else if (!(sview->cur = get_node(sview, path)))
+        else if (!(node = get_node(sview, path)))
             return 2;
-    } else if (path == NULL && sview->cur == NULL)
+    } else if (path == NULL && sview->view->cur == NULL)
         return 3;
 
-    /* Buffer the file if it's not already */
-    if (!sview->cur->buf.tlines && load_file(sview->cur))
-        return 4;
+    if (path != NULL)
+        view_show(sview->view, node);
 
-    /* Update line, if set */
-    if (line--) {
-        /* Check bounds of line */
-        if (line < 0)
-            line = 0;
-        if (line >= sview->cur->buf.length)
-            line = sview->cur->buf.length - 1;
-        sview->cur->sel_line = sview->cur->exe_line = line;
+    /* Buffer the file if it's not already, it's shown once it's read */
+    if (!file_loaded(sview->view->cur)) {
+        ret = source_load(sview, sview->view->cur, line);
+        if (ret == 1)
+            return 0;
+        else if (ret)
+            return 4;
+    }
+
+    sview->view->cur->last_used = ++sview->tick;
+    set_exec_line(sview, sview->view->cur, line);
+
+    return 0;
+}
+
+int source_loaded(struct sviewer *sview)
+{
+    size_t limit = (size_t) cgdbrc_get(CGDBRC_SRCMEM)->variant.int_val
+            * 1024 * 1024;
+    struct loader_file *file;
+    struct list_node *node;
+    int redraw = 0;
+    int i;
+
+    while ((file = loader_finish())) {
+        node = get_node(sview, file->path);
+
+        /* The file was removed, or loaded some other way, since it was
+         * asked for */
+        if (!node || !node->loading || file_loaded(node)) {
+            if (node)
+                node->loading = 0;
+            loader_file_free(file);
+            continue;
+        }
+
+        node->loading = 0;
+
+        if (node->views > 0) {
+            if (install_node(sview, node, file) == 0) {
+                node->last_used = ++sview->tick;
+                set_exec_line(sview, node, node->load_line);
+                enforce_srcmem(sview, node);
+            }
+            redraw = 1;
+        } else if (limit && mem_used(sview) + 3 * file->size > limit) {
+            /* A prefetched file only gets the memory nothing else wants,
+             * and takes about three times its size once it's highlighted.
+             * The rest won't fit either. */
+            unwatch_file(node);
+            sview->prefetch_count = 0;
+        } else if (install_node(sview, node, file) == 0) {
+            /* Files that were never shown are the first to go */
+            node->last_used = 0;
+
+            /* Big files are otherwise highlighted once they're shown */
+            highlight_start(node, 0, 0);
+        }
+
+        node->load_line = 0;
+        loader_file_free(file);
+    }
+
+    /* A big file being read shows how far along it is */
+    for (i = 0; i < sview->view_count; i++)
+        if (sview->views[i].cur && sview->views[i].cur->loading)
+            redraw = 1;
+
+    return redraw;
+}
+
+int source_highlighted(struct sviewer *sview)
+{
+    struct list_node *node;
+    int redraw = 0;
+
+    while ((node = highlight_finish())) {
+        update_mem(node);
+        source_changes++;
+
+        if (node->views > 0)
+            redraw = 1;
+    }
+
+    return redraw;
+}
+
+int source_prefetch(struct sviewer *sview, const char *path)
+{
+    struct list_node *node;
+    int i;
+
+    if (!(node = get_node(sview, path)) &&
+            !(node = get_relative_node(sview, path))) {
+        /* Only gdb knows where a relative path is */
+        if (path[0] != '/' || !verify_file_exists(sview, path) ||
+                source_add(sview, path) || !(node = get_node(sview, path)))
+            return -1;
+    }
+
+    if (file_loaded(node))
+        return 0;
+
+    for (i = 0; i < sview->prefetch_count; i++)
+        if (sview->prefetch[i] == node->path)
+            return 0;
+
+    sview->prefetch = cgdb_realloc(sview->prefetch,
+            sizeof (char *) * (sview->prefetch_count + 1));
+    sview->prefetch[sview->prefetch_count++] = node->path;
+
+    return 0;
+}
+
+int source_restore(struct sviewer *sview, const char *path, int line)
+{
+    struct list_node *node;
+
+    if (!(node = get_node(sview, path))) {
+        if (!verify_file_exists(sview, path) || source_add(sview, path) ||
+                !(node = get_node(sview, path)))
+            return -1;
+    }
+
+    /* It's kept within the file once the file is read */
+    if (!file_loaded(node) && !node->loading)
+        node->last_line = line > 0 ? line - 1 : 0;
+
+    return source_prefetch(sview, node->path);
+}
+
+int source_prefetch_pending(struct sviewer *sview)
+{
+    /* A file is asked for once the one before it is read */
+    return sview->prefetch_count > 0 && !loader_busy();
+}
+
+int source_prefetch_next(struct sviewer *sview)
+{
+    size_t limit = (size_t) cgdbrc_get(CGDBRC_SRCMEM)->variant.int_val
+            * 1024 * 1024;
+    struct list_node *node;
+    struct stat st;
+    const char *path;
+
+    while (sview->prefetch_count > 0) {
+        path = sview->prefetch[0];
+        sview->prefetch_count--;
+        memmove(sview->prefetch, sview->prefetch + 1,
+                sizeof (char *) * sview->prefetch_count);
+
+        node = get_node(sview, path);
+
+        /* The file was shown, or removed, since it was asked for */
+        if (!node || node->loading || file_loaded(node) ||
+                stat(node->path, &st) == -1)
+            continue;
+
+        /* Only the memory nothing else wants is used. A file takes about
+         * three times its size once it's highlighted. */
+        if (limit && mem_used(sview) + 3 * (size_t) st.st_size > limit)
+            break;
+
+        /* The file is installed by source_loaded once it's read */
+        if (request_node(node) == 0)
+            return 1;
+
+        if (read_node(sview, node))
+            continue;
+
+        /* Files that were never shown are the first to go */
+        node->last_used = 0;
+        if (limit && mem_used(sview) > limit) {
+            evict_file(node);
+            break;
+        }
+
+        /* Big files are otherwise highlighted once they're shown */
+        highlight_start(node, 0, 0);
+
+        return 1;
     }
 
+    /* The rest won't fit either */
+    sview->prefetch_count = 0;
+
     return 0;
 }
 
+/* file_changed: Marks the nodes of a file the kernel reported a change to.
+ * -------------
+ */
+static void file_changed(int watch, int gone, void *context)
+{
+    struct sviewer *sview = context;
+    struct list_node *node;
+
+    /* Nothing stat said can be trusted if the kernel lost track */
+    if (watch == -1)
+        source_stat_forget(sview);
+
+    for (node = sview->list_head; node != NULL; node = node->next) {
+        if (watch == -1 || node->watch == watch) {
+            node->dirty = 1;
+
+            /* The kernel isn't watching it anymore, stat it from now on */
+            if (gone && node->watch == watch) {
+                node->watch = -1;
+                std_ohash_table_remove(sview->stat_cache, node->path);
+            }
+        }
+    }
+}
+
+void source_files_changed(struct sviewer *sview)
+{
+    fs_watch_dispatch(file_changed, sview);
+}
+
 void source_free(struct sviewer *sview)
 {
+    int i;
+
     /* Free all file buffers */
     while (sview->list_head != NULL)
         source_del(sview, sview->list_head->path);
 
-    delwin(sview->win);
+    std_ohash_table_destroy(sview->path_index);
+    std_ohash_table_destroy(sview->lpath_index);
+    std_ohash_table_destroy(sview->stat_cache);
+
+    free(sview->breaks);
+    free(sview->heat);
+    sview->prefetch_count = 0;
+    free(sview->prefetch);
+
+    for (i = 0; i < sview->view_count; i++) {
+        free(sview->views[i].rows);
+        free_matches(&sview->views[i]);
+        delwin(sview->views[i].win);
+    }
+}
+
+void source_invalidate(struct sviewer *sview)
+{
+    source_changes++;
 }
 
 void source_search_regex_init(struct sviewer *sview)
 {
-    if (sview == NULL || sview->cur == NULL)
+    if (sview == NULL || sview->view->cur == NULL)
         return;
 
+    hl_regex_reset();
+
     /* Start from beginning of line if not at same line */
-    if (sview->cur->sel_rline != sview->cur->sel_line) {
-        sview->cur->sel_col_rend = 0;
-        sview->cur->sel_col_rbeg = 0;
+    if (sview->view->sel_rline != sview->view->sel_line) {
+        sview->view->sel_col_rend = 0;
+        sview->view->sel_col_rbeg = 0;
     }
 
     /* Start searching at the beginning of the selected line */
-    sview->cur->sel_rline = sview->cur->sel_line;
+    sview->view->sel_rline = sview->view->sel_line;
 }
 
 int source_search_regex(struct sviewer *sview,
         const char *regex, int opt, int direction, int icase)
 {
+    /* The match is drawn on the line searched from */
+    source_changes++;
 
-    if (sview == NULL || sview->cur == NULL || regex == NULL ||
+    if (sview == NULL || sview->view->cur == NULL || regex == NULL ||
             strlen(regex) == 0) {
 
-        if (sview && sview->cur)
-            sview->cur->buf.cur_line = NULL;
+        if (sview && sview->view->cur) {
+            free(sview->view->cur_line);
+            sview->view->cur_line = NULL;
+        }
         return -1;
     }
 
-    return hl_regex(regex,
-            (const char **) sview->cur->buf.tlines,
-            (const char **) sview->cur->orig_buf.tlines,
-            sview->cur->orig_buf.length,
-            &sview->cur->buf.cur_line, &sview->cur->sel_line,
-            &sview->cur->sel_rline, &sview->cur->sel_col_rbeg,
-            &sview->cur->sel_col_rend, opt, direction, icase);
+    return hl_regex(regex, get_search_line, sview->view->cur,
+            sview->view->cur->orig_buf.length,
+            &sview->view->cur_line, &sview->view->sel_line,
+            &sview->view->sel_rline, &sview->view->sel_col_rbeg,
+            &sview->view->sel_col_rend, opt, direction, icase);
 }
 
-void source_disable_break(struct sviewer *sview, const char *path, int line)
+int source_update_breaks(struct sviewer *sview,
+        const struct source_break *breaks, int count)
 {
-    struct list_node *node;
-
-    if ((node = get_relative_node(sview, path)) == NULL)
-        return;
+    struct source_break *old = sview->breaks, *new;
+    int old_count = sview->breaks_count, new_count = 0;
+    int changed = 0, cmp, i, j;
+
+    new = cgdb_malloc(sizeof (struct source_break) * (count > 0 ? count : 1));
+    memcpy(new, breaks, sizeof (struct source_break) * count);
+    new_count = count;
+
+    /* Each one is kept, so one can be taken out by source_change_break */
+    for (i = 0; i < new_count; i++) {
+        new[i].path = std_intern(new[i].path);
+        new[i].enabled = new[i].enabled ? 1 : 0;
+    }
+    qsort(new, new_count, sizeof (struct source_break), break_compare);
+
+    /* Files loaded while the lines are marked pick up the new list */
+    sview->breaks = new;
+    sview->breaks_count = new_count;
+
+    /* Walk both sorted lists, touching only the lines that differ */
+    for (i = j = 0; i < old_count || j < new_count;) {
+        if (i == old_count)
+            cmp = 1;
+        else if (j == new_count)
+            cmp = -1;
+        else
+            cmp = break_compare(&old[i], &new[j]);
+
+        if (cmp < 0) {
+            changed |= mark_break(sview, old[i].path, old[i].line);
+            i++;
+        } else if (cmp > 0) {
+            changed |= mark_break(sview, new[j].path, new[j].line);
+            j++;
+        } else {
+            i++;
+            j++;
+        }
+    }
 
-    if (node->buf.tlines == NULL)
-        if (load_file(node))
-            return;
+    free(old);
 
-    if (line > 0 && line <= node->buf.length)
-        node->buf.breakpts[line - 1] = 2;
+    return changed;
 }
 
-void source_enable_break(struct sviewer *sview, const char *path, int line)
+int source_change_break(struct sviewer *sview,
+        const struct source_break *old, const struct source_break *new)
 {
-    struct list_node *node;
+    struct source_break b;
+    int i, changed = 0;
+
+    if (old) {
+        b = *old;
+        b.path = std_intern(b.path);
+        b.enabled = b.enabled ? 1 : 0;
+        i = find_break(sview, &b);
+
+        if (i < sview->breaks_count &&
+                break_compare(&sview->breaks[i], &b) == 0) {
+            memmove(sview->breaks + i, sview->breaks + i + 1,
+                    sizeof (struct source_break) *
+                    (sview->breaks_count - i - 1));
+            sview->breaks_count--;
+            changed |= mark_break(sview, b.path, b.line);
+        }
+    }
 
-    if ((node = get_relative_node(sview, path)) == NULL)
-        return;
+    if (new) {
+        b = *new;
+        b.path = std_intern(b.path);
+        b.enabled = b.enabled ? 1 : 0;
+        i = find_break(sview, &b);
+
+        sview->breaks = cgdb_realloc(sview->breaks,
+                sizeof (struct source_break) * (sview->breaks_count + 1));
+        memmove(sview->breaks + i + 1, sview->breaks + i,
+                sizeof (struct source_break) * (sview->breaks_count - i));
+        sview->breaks[i] = b;
+        sview->breaks_count++;
+        changed |= mark_break(sview, b.path, b.line);
+    }
 
-    if (node->buf.tlines == NULL)
-        if (load_file(node))
-            return;
+    return changed;
+}
 
-    if (line > 0 && line <= node->buf.length) {
-        node->buf.breakpts[line - 1] = 1;
-    }
+int source_has_break(struct sviewer *sview, const char *path, int line)
+{
+    struct source_break key;
+    int i;
+
+    key.path = path;
+    key.line = line;
+    key.enabled = 1;
+    i = find_break(sview, &key);
+
+    return i < sview->breaks_count && sview->breaks[i].line == line &&
+            sview->breaks[i].path == path;
 }
 
-void source_clear_breaks(struct sviewer *sview)
+int source_update_heat(struct sviewer *sview,
+        const struct source_heat *heat, int count)
 {
-    struct list_node *node;
+    struct source_heat *old = sview->heat, *new;
+    int old_count = sview->heat_count, new_count = count;
+    int changed = 0, cmp, i, j;
+
+    new = cgdb_malloc(sizeof (struct source_heat) * (count > 0 ? count : 1));
+    memcpy(new, heat, sizeof (struct source_heat) * count);
+    for (i = 0; i < new_count; i++)
+        new[i].path = std_intern(new[i].path);
+    qsort(new, new_count, sizeof (struct source_heat), heat_compare);
+
+    sview->heat = new;
+    sview->heat_count = new_count;
+
+    /* Most lines keep their heat from one update to the next */
+    for (i = j = 0; i < old_count || j < new_count;) {
+        if (i == old_count)
+            cmp = 1;
+        else if (j == new_count)
+            cmp = -1;
+        else
+            cmp = heat_compare(&old[i], &new[j]);
+
+        if (cmp < 0) {
+            changed |= set_heat(sview, old[i].path, old[i].line, 0);
+            i++;
+        } else if (cmp > 0) {
+            changed |= set_heat(sview, new[j].path, new[j].line,
+                    new[j].level);
+            j++;
+        } else {
+            if (old[i].level != new[j].level)
+                changed |= set_heat(sview, new[j].path, new[j].line,
+                        new[j].level);
+            i++;
+            j++;
+        }
+    }
 
-    for (node = sview->list_head; node != NULL; node = node->next)
-        memset(node->buf.breakpts, 0, node->buf.length);
+    free(old);
 
+    return changed;
 }
 
 int source_reload(struct sviewer *sview, const char *path, int force)
 {
     time_t timestamp;
     struct list_node *cur;
-    struct list_node *prev = NULL;
     int auto_source_reload =
             cgdbrc_get(CGDBRC_AUTOSOURCERELOAD)->variant.int_val;
 
     if (!path)
         return -1;
 
+    /* Find the target node */
+    if ((cur = get_node(sview, path)) == NULL)
+        return 1;               /* Node not found */
+
+    /* There's no file to read the lines from again */
+    if (cur->text)
+        return 0;
+
+    if (!auto_source_reload && !force)
+        return 0;
+
+    /* The kernel said nothing about the file, so it's unchanged */
+    if (cur->watch != -1 && !cur->dirty && !force)
+        return 0;
+
     if (get_timestamp(path, &timestamp) == -1)
         return -1;
 
-    /* Find the target node */
-    for (cur = sview->list_head; cur != NULL; cur = cur->next) {
-        if (strcmp(path, cur->path) == 0)
-            break;
-        prev = cur;
-    }
+    cur->dirty = 0;
 
-    if (cur == NULL)
-        return 1;               /* Node not found */
+    if (cur->last_modification < timestamp) {
+        /* The parts of the file that didn't change keep their highlighting */
+        struct hl_previous *previous = highlight_keep(cur);
+        int ret = release_file_memory(cur);
 
-    if ((auto_source_reload || force) && cur->last_modification < timestamp) {
+        highlight_reuse(cur, previous);
 
-        if (release_file_memory(sview->cur) == -1)
+        if (ret == -1)
             return -1;
 
-        if (load_file(cur))
+        if (load_node(sview, cur))
             return -1;
     }
 
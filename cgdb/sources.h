@@ -3,11 +3,13 @@
  * 
  * Source file management routines for the GUI.  Provides the ability to
  * add files to the list, load files, and display within a curses window.
- * Files are buffered in memory when they are displayed, and held in
- * memory for the duration of execution.  If memory consumption becomes a
- * problem, this can be optimized to unload files which have not been
- * displayed recently, or only load portions of large files at once. (May
- * affect syntax highlighting.)
+ * Files are buffered in memory when they are displayed.  If the srcmem
+ * option is set, the files which have not been displayed recently are
+ * unloaded to stay within it, and loaded again when they are needed.
+ *
+ * A viewer can show its files in more than one view, side by side. The
+ * views share the files, a file shown in two of them is loaded and
+ * highlighted once, each view only has where it is in the file it shows.
  *
  */
 
@@ -25,12 +27,20 @@
 #include <ncurses/curses.h>
 #endif /* HAVE_CURSES_H */
 
+#include "cgdb.h"
+
 /* System Includes */
 #if HAVE_TIME_H
 #include <time.h>
 #endif /* HAVE_TIME_H */
 
+#if HAVE_STDINT_H
+#include <stdint.h>
+#endif /* HAVE_STDINT_H */
+
 #include "tokenizer.h"
+#include "highlight_groups.h"
+#include "cgdbrc.h"
 
 /* ----------- */
 /* Definitions */
@@ -42,42 +52,223 @@
 #define SRC_WINDOW_NAME "Source"
 #define QUEUE_SIZE      10
 
+/* The most views a viewer shows its files in */
+#define SOURCE_VIEWS    2
+
+/* Files with more lines than this are highlighted lazily */
+#define HL_LAZY_LINES   20000
+
+/* The offset of a line in a buffer that has nothing of its own */
+#define BUFFER_NO_LINE  ((uint32_t) -1)
+
+/* The number of lines that share a base offset */
+#define BUFFER_BLOCK    1024
+
+/* The base offset of a block none of whose lines have been set */
+#define BUFFER_NO_BASE  ((size_t) -1)
+
+/* The number of base offsets a buffer of length lines has */
+#define BUFFER_BLOCKS(length) ((length) / BUFFER_BLOCK + 1)
+
 /* --------------- */
 /* Data Structures */
 /* --------------- */
 
+/* The kinds of marks a line of a file can have */
+enum source_mark_kind {
+    SOURCE_MARK_BREAK,          /* 1 for an enabled breakpoint, 2 disabled */
+    SOURCE_MARK_HEAT            /* 1 to 3, how often the profiler saw it */
+};
+
+/* A mark on a line of a file */
+struct source_mark {
+    int line;                   /* The index of the line */
+    enum source_mark_kind kind; /* What kind of mark it is */
+    int value;                  /* What it's set to, never 0 */
+};
+
+/* The marks of a file. Few lines have one, so only those that do are
+ * kept, sorted by line and then by kind. */
+struct source_marks {
+    struct source_mark *marks;
+    int count;                  /* The number of marks */
+    int size;                   /* The number of marks allocated */
+};
+
+/* A breakpoint, as gdb reports it */
+struct source_break {
+    const char *path;           /* The relative path to the file */
+    int line;                   /* The line number of the breakpoint */
+    int enabled;                /* 1 if it's enabled, 0 if it's disabled */
+};
+
+/* How hot a line is in the profile */
+struct source_heat {
+    const char *path;           /* The relative path to the file */
+    int line;                   /* The line number */
+    int level;                  /* 1 for cool, 2 for warm, 3 for hot */
+};
+
+/* What a row of the source window was last drawn with. A row is only
+ * drawn again when one of these changes. */
+struct source_row {
+    unsigned long changes;      /* source_changes when drawn, 0 for never */
+    struct list_node *node;     /* The file shown */
+    int line;                   /* The line of the file shown in the row */
+    int flags;                  /* SOURCE_ROW_* for the line */
+    int sel_col;                /* The horizontal scroll */
+    int lwidth;                 /* The width of the line numbers */
+    char breakpt;               /* The breakpoint on the line */
+    char heat;                  /* How hot the line is in the profile */
+};
+
+/* The hlsearch matches of a line. Only the rows a view draws are matched,
+ * the matches are kept until the lines or the pattern change. */
+struct source_match {
+    unsigned long changes;      /* source_changes when matched, 0 for never */
+    struct list_node *node;     /* The file matched */
+    int line;                   /* The line matched */
+    struct hl_run *runs;        /* The line with the matches, NULL if none */
+};
+
+/* Where a view is in the file it shows. Only the file's buffers are
+ * shared with the other views. */
+struct source_view {
+    struct list_node *cur;      /* Current node we're displaying */
+    WINDOW *win;                /* Curses window */
+
+    int sel_line;               /* Current line selected in viewer */
+    int sel_col;                /* Current column selected in viewer */
+    int sel_col_rbeg;           /* Current beg column matched in regex */
+    int sel_col_rend;           /* Current end column matched in regex */
+    int sel_rline;              /* Current line used by regex */
+    struct hl_run *cur_line;    /* The selected line, with the match drawn */
+
+    struct source_row *rows;    /* What each row of win shows */
+    int rows_count;             /* The height of win when rows was made */
+    int first_line;             /* The line shown in the first row */
+
+    struct source_match *matches;  /* The hlsearch matches, by line */
+    int matches_count;          /* The number of lines matches holds */
+};
+
 /* Source viewer object */
 struct sviewer {
     struct list_node *list_head;    /* File list */
-    struct list_node *cur;      /* Current node we're displaying */
-    WINDOW *win;                /* Curses window */
+
+    struct source_view views[SOURCE_VIEWS];
+    int view_count;             /* The views shown, at least 1 */
+    struct source_view *view;   /* The view the user is in, the functions
+                                 * that don't take a view act on it */
+
+    struct std_ohashtable *path_index;   /* File list, keyed by path */
+    struct std_ohashtable *lpath_index;  /* File list, keyed by lpath */
+    struct std_ohashtable *stat_cache;   /* What stat said, keyed by path */
+
+    struct source_break *breaks;    /* The breakpoints, sorted by file */
+    int breaks_count;           /* The number of breakpoints */
+
+    struct source_heat *heat;   /* The lines of the profile, sorted by file */
+    int heat_count;             /* The number of lines in heat */
+
+    const char **prefetch;      /* Files to load when there's nothing to do */
+    int prefetch_count;         /* The number of files in prefetch */
+
+    unsigned long tick;         /* Incremented each time a node is used */
 };
 
+/* A run of characters in a line that are drawn in the same group. The
+ * characters between runs are drawn as HLG_TEXT. A line's runs are sorted,
+ * and end with a run of length 0. */
+struct hl_run {
+    int start;                  /* Index of the first character */
+    int length;                 /* Number of characters */
+    enum hl_group_kind group;   /* How to draw them */
+};
+
+/* The state the tokenizer was in at the start of a line. Highlighting can
+ * start over from there instead of from the top of the file. */
+struct hl_state {
+    int line;                   /* The index of the line */
+    int state;                  /* See tokenizer_get_state */
+};
+
+struct hl_previous;
+struct symbols;
+
+/* The original buffer of a node keeps the text of its lines back to back
+ * in a single block, each one NUL terminated. The highlighted buffer holds
+ * no text, it keeps the runs of each line in a single block instead. Both
+ * find a line through a table of offsets into the block. A line with the
+ * offset BUFFER_NO_LINE has nothing of its own, it's drawn as plain text.
+ *
+ * The offsets are 32 bits, to keep the table small. Each is counted from
+ * the base offset of its block of BUFFER_BLOCK lines, which is 64 bits, so
+ * only a block of lines has to fit in 4GB, not the whole file. */
 struct buffer {
     int length;                 /* Number of lines in buffer */
-    char **tlines;              /* Array containing file ( lines of text ) */
-    char *cur_line;             /* cur line may have unique color */
-    char *breakpts;             /* Breakpoints */
+    uint32_t *lines;            /* Offset into text or runs of each line */
+    size_t *bases;              /* Base offset of each block of lines */
+    char *text;                 /* The text of the lines */
+    struct hl_run *runs;        /* The highlighting of the lines */
+    size_t used;                /* Elements of text or runs in use */
+    size_t size;                /* Elements of text or runs allocated */
     int max_width;              /* Width of longest line in file */
 };
 
 struct list_node;
 struct list_node {
-    char *path;                 /* Full path to source file */
-    char *lpath;                /* Relative path to source file */
+    const char *path;           /* Full path, interned */
+    const char *lpath;          /* Relative path, interned, or NULL */
     struct buffer buf;          /* File buffer */
     struct buffer orig_buf;     /* Original File buffer ( no color ) */
-    int sel_line;               /* Current line selected in viewer */
-    int sel_col;                /* Current column selected in viewer */
     int exe_line;               /* Current line executing */
 
-    int sel_col_rbeg;           /* Current beg column matched in regex */
-    int sel_col_rend;           /* Current end column matched in regex */
-    int sel_rline;              /* Current line used by regex */
+    /* The views showing the file, it isn't unloaded while one does. The
+     * line selected when a view last left it is where the next one to show
+     * it starts. */
+    int views;
+    int last_line;
 
     enum tokenizer_language_support language;   /* The language type of this file */
 
+    /* 0 if buf is fully highlighted, 1 if it's waiting to be highlighted
+     * lazily and 2 while the worker thread is highlighting it.
+     * Lines not highlighted yet are BUFFER_NO_LINE in buf. */
+    int hl_lazy;
+
+    /* The states at the start of every so many lines of buf, in order,
+     * once it's fully highlighted. Before the file is highlighted again
+     * after a reload, hl_previous has what it had before. */
+    struct hl_state *hl_states;
+    int hl_state_count;
+    struct hl_previous *hl_previous;
+
+    /* Where the identifiers are, built along with the highlighting, or
+     * NULL until highlight_symbols builds it */
+    struct symbols *symbols;
+
     time_t last_modification;   /* timestamp of last modification */
+    size_t file_size;           /* Size of the file when it was loaded */
+
+    /* The kernel's watch on the file while it's loaded, or -1 if it can't
+     * be watched and has to be checked with stat. dirty is set when the
+     * kernel reports a change that hasn't been looked at yet. */
+    int watch;
+    int dirty;
+
+    /* 1 while the loader is reading the file in the background. load_line
+     * is the line to show once it's read, 0 to show what was selected. */
+    int loading;
+    int load_line;
+
+    /* 1 if the lines were given with source_set_text, there's no file to
+     * read them from again */
+    int text;
+
+    size_t mem;                 /* Approximate bytes held by the buffers */
+    unsigned long last_used;    /* When the node was last used (see tick) */
+    struct source_marks marks;  /* Breakpoints, kept while unloaded */
 
     struct list_node *next;     /* Pointer to next link in list */
 };
@@ -86,6 +277,111 @@ struct list_node {
 /* Functions */
 /* --------- */
 
+/* source_marks_set: Sets the mark of a kind on a line.
+ * -----------------
+ *
+ *   marks:  The marks of the file
+ *   line:   The index of the line
+ *   kind:   The kind of mark
+ *   value:  What to set it to, 0 takes the mark off the line
+ */
+void source_marks_set(struct source_marks *marks, int line,
+        enum source_mark_kind kind, int value);
+
+/* source_marks_get: Gets the mark of a kind on a line.
+ * -----------------
+ *
+ * Return Value: What the mark is set to, or 0 if the line doesn't have one.
+ */
+int source_marks_get(const struct source_marks *marks, int line,
+        enum source_mark_kind kind);
+
+/* source_marks_next: Gets the mark of a kind on the next line drawn.
+ * ------------------
+ *
+ * Rows are drawn in order, so the marks are walked along with them
+ * instead of being looked up from the start each time.
+ *
+ *   marks:  The marks of the file
+ *   index:  Where the walk is, 0 to start it. It's moved to the first mark
+ *           at or after line.
+ *   line:   The index of the line, at or after the last one asked for
+ *   kind:   The kind of mark
+ *
+ * Return Value: What the mark is set to, or 0 if the line doesn't have one.
+ */
+int source_marks_next(const struct source_marks *marks, int *index, int line,
+        enum source_mark_kind kind);
+
+/* source_marks_clear: Takes every mark of a kind off a file.
+ * -------------------
+ */
+void source_marks_clear(struct source_marks *marks,
+        enum source_mark_kind kind);
+
+/* buffer_set_length: Gives a buffer a number of lines, with nothing in them.
+ * ------------------
+ *
+ * Any lines the buffer already had are dropped.
+ *
+ *   buf:     The buffer
+ *   length:  The number of lines
+ *   size:    A guess of how many bytes of text the lines will need, or 0
+ */
+void buffer_set_length(struct buffer *buf, int length, size_t size);
+
+/* buffer_set_line: Sets the text of a line in a buffer.
+ * ----------------
+ *
+ * The text is appended to the buffer, the space held by the old text of
+ * the line is not reused until the buffer is released.
+ *
+ *   buf:     The buffer
+ *   line:    The index of the line
+ *   text:    The text of the line, or NULL to make it BUFFER_NO_LINE
+ *   length:  The number of bytes in text
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+int buffer_set_line(struct buffer *buf, int line, const char *text,
+        size_t length);
+
+/* buffer_get_line: Gets the text of a line in a buffer.
+ * ----------------
+ *
+ *   buf:   The buffer
+ *   line:  The index of the line
+ *
+ * Return Value: The text, or NULL if the line has no text of its own.
+ */
+const char *buffer_get_line(const struct buffer *buf, int line);
+
+/* buffer_set_runs: Sets the highlighting of a line in a buffer.
+ * ----------------
+ *
+ * The runs are appended to the buffer, along with the run of length 0 that
+ * ends them. Like buffer_set_line, the old runs are not reused.
+ *
+ *   buf:    The buffer
+ *   line:   The index of the line
+ *   runs:   The runs of the line
+ *   count:  The number of runs, 0 makes the line BUFFER_NO_LINE
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+int buffer_set_runs(struct buffer *buf, int line, const struct hl_run *runs,
+        int count);
+
+/* buffer_get_runs: Gets the highlighting of a line in a buffer.
+ * ----------------
+ *
+ *   buf:   The buffer
+ *   line:  The index of the line
+ *
+ * Return Value: The runs, or NULL if the line has no highlighting.
+ */
+const struct hl_run *buffer_get_runs(const struct buffer *buf, int line);
+
 /* source_new:  Create a new source viewer object.
  * -----------
  *
@@ -109,6 +405,22 @@ struct sviewer *source_new(int pos_r, int pos_c, int height, int width);
  */
 int source_add(struct sviewer *sview, const char *path);
 
+/* source_set_text:  Sets the lines of a file that isn't read from disk.
+ * ----------------
+ *
+ *  The file is added if it isn't in the list. It's never unloaded to stay
+ *  within the srcmem option, or reloaded, only source_del frees it.
+ *
+ *   sview:  Source viewer object
+ *   path:   A name for the lines, unique like the path of a file
+ *   data:   The lines, each one ended by a newline
+ *   size:   The number of bytes in data
+ *
+ * Return Value:  Zero on success, non-zero on error.
+ */
+int source_set_text(struct sviewer *sview, const char *path,
+        const char *data, size_t size);
+
 /* source_set_relative_path: Sets the path that gdb uses for breakpoints
  * -------------------------
  * 
@@ -153,19 +465,54 @@ int source_length(struct sviewer *sview, const char *path);
  */
 char *source_current_file(struct sviewer *sview, char *path);
 
+/* source_get_buffer: Gets the text of a file, if it's loaded.
+ * ------------------
+ *
+ *   sview:  Source viewer object
+ *   path:   Full or relative path to the source file
+ *
+ *  Return Value: The original buffer of the file, or NULL if the file
+ *                isn't in memory. It's only good until the viewer is used
+ *                again.
+ */
+const struct buffer *source_get_buffer(struct sviewer *sview,
+        const char *path);
+
+/* source_absolute_path: Finds the full path of a file gdb named relatively.
+ * ---------------------
+ *
+ * Only the paths source_set_relative_path was told about are known, gdb
+ * isn't asked.
+ *
+ *   sview:  Source viewer object
+ *   lpath:  The relative path to the source file
+ *
+ *  Return Value: The full path, or NULL if it isn't known. It's only good
+ *                until the file is removed from the viewer.
+ */
+const char *source_absolute_path(struct sviewer *sview, const char *lpath);
+
 /* source_display:  Display a portion of a file in a curses window.
  * ---------------
  *
+ *  The first view is drawn, see source_view_display for the others.
+ *
  *   sview:  Source viewer object
  *   focus:  If the window should have focus
+ *   dorefresh: WIN_REFRESH to draw it now, WIN_NO_REFRESH to leave that to
+ *              the next doupdate
+ *   config: The options to draw with
  *
  * Return Value:  Zero on success, non-zero on error.
  */
-int source_display(struct sviewer *sview, int focus);
+int source_display(struct sviewer *sview, int focus,
+        enum win_refresh dorefresh, const struct cgdbrc_snapshot *config);
 
 /* source_move:  Relocate the source window.
  * ------------
  *
+ *  The first view is moved, see source_view_move for the others.
+ *
  *   sview:   Source viewer object
  *   pos_r:   Position of the viewer (row)
  *   pos_c:   Position of the viewer (column)
@@ -175,6 +522,123 @@ int source_display(struct sviewer *sview, int focus);
 void source_move(struct sviewer *sview,
         int pos_r, int pos_c, int height, int width);
 
+/* source_set_views:  Changes how many views the files are shown in.
+ * -----------------
+ *
+ *  A new view starts out showing what the view the user is in shows, at
+ *  the same line. If that view goes away, the user is put in the first.
+ *
+ *   sview:  Source viewer object
+ *   count:  The number of views, 1 to SOURCE_VIEWS
+ */
+void source_set_views(struct sviewer *sview, int count);
+
+/* source_set_view:  Puts the user in another view.
+ * ----------------
+ *
+ *  The functions that don't take a view, like source_vscroll and
+ *  source_set_exec_line, act on the view the user is in.
+ *
+ *   sview:  Source viewer object
+ *   index:  The view, from 0
+ */
+void source_set_view(struct sviewer *sview, int index);
+
+/* source_get_view:  Gets the view the user is in.
+ * ----------------
+ *
+ *   sview:  Source viewer object
+ *
+ * Return Value:  Its index, from 0.
+ */
+int source_get_view(struct sviewer *sview);
+
+/* source_view_display:  Draws one of the views, like source_display.
+ * --------------------
+ *
+ *   sview:  Source viewer object
+ *   index:  The view, from 0
+ *   focus:  If the view should have focus
+ *   dorefresh: WIN_REFRESH to draw it now, WIN_NO_REFRESH to leave that to
+ *              the next doupdate
+ *   config: The options to draw with
+ *
+ * Return Value:  Zero on success, non-zero on error.
+ */
+int source_view_display(struct sviewer *sview, int index, int focus,
+        enum win_refresh dorefresh, const struct cgdbrc_snapshot *config);
+
+/* source_view_move:  Moves one of the views, like source_move.
+ * -----------------
+ *
+ *   sview:   Source viewer object
+ *   index:   The view, from 0
+ *   pos_r:   Position of the view (row)
+ *   pos_c:   Position of the view (column)
+ *   height:  Height (in lines) of the view
+ *   width:   Width (in columns) of the view
+ */
+void source_view_move(struct sviewer *sview, int index,
+        int pos_r, int pos_c, int height, int width);
+
+/* source_show_none:  Stops showing a file in the view the user is in.
+ * -----------------
+ *
+ *  The logo is shown instead, until source_set_exec_line shows a file.
+ *
+ *   sview:  Source viewer object
+ */
+void source_show_none(struct sviewer *sview);
+
+/* source_selected_line:  Gets the line selected in a file.
+ * ---------------------
+ *
+ *   sview:  Source viewer object
+ *   node:   The file
+ *
+ * Return Value:  The index of the line selected in the view the user is
+ *                in, or in the first other view, that shows it. If none
+ *                do, the one selected when a view last showed it.
+ */
+int source_selected_line(struct sviewer *sview, struct list_node *node);
+
+/* source_set_hlsearch:  Sets the pattern every match of is drawn.
+ * --------------------
+ *
+ *  The matches are drawn in every viewer, on the rows it draws.
+ *
+ *   regex:  The regular expression, or NULL to draw none
+ *   icase:  1 if case insensitive, 0 otherwise
+ */
+void source_set_hlsearch(const char *regex, int icase);
+
+/* source_goto_definition:  Goes to where an identifier looks defined in the
+ * -----------------------  file shown, from its symbol index.
+ *
+ *   sview:  Source viewer object
+ *   name:   The identifier, or NULL for the one at the cursor, see
+ *           source_goto_occurrence
+ *
+ * Return Value:  1 if a definition was found, 0 if the identifier was only
+ *                found where it first is, -1 if it isn't in the file, -2
+ *                if there's no identifier or no index.
+ */
+int source_goto_definition(struct sviewer *sview, const char *name);
+
+/* source_goto_occurrence:  Goes to the next place the identifier at the
+ * -----------------------  cursor is in the file shown.
+ *
+ *  The identifier at the cursor is the one the last search or jump went
+ *  to, if it's on the selected line, or else the first of the line.
+ *
+ *   sview:      Source viewer object
+ *   direction:  1 for the next place, 0 for the one before
+ *
+ * Return Value:  0 on success, -1 if there's no other place, -2 if there's
+ *                no identifier or no index.
+ */
+int source_goto_occurrence(struct sviewer *sview, int direction);
+
 /* source_vscroll:  Change current position in source file.
  * --------------
  * 
@@ -236,7 +700,7 @@ void source_search_regex_init(struct sviewer *sview);
  *   icase:     If 0 ignore case.
  *
  * Return Value: Zero on match, 
- *               -1 if sview->cur is NULL
+ *               -1 if sview->view->cur is NULL
  *               -2 if regex is NULL
  *               -3 if regcomp fails
  *               non-zero on failure.
@@ -244,6 +708,99 @@ void source_search_regex_init(struct sviewer *sview);
 int source_search_regex(struct sviewer *sview, const char *regex, int opt,
         int direction, int icase);
 
+/* source_highlighted:  Takes in the files the highlighting worker has
+ * -------------------  finished. Call it when highlight_fd is readable.
+ *
+ *   sview:  Source viewer object
+ *
+ * Return Value:  1 if what is displayed in the viewer changed, 0 otherwise.
+ */
+int source_highlighted(struct sviewer *sview);
+
+/* source_files_changed:  Marks the files the kernel reported changes to,
+ * ---------------------  so the next source_reload looks at them. Call it
+ *                        when fs_watch_fd is readable.
+ *
+ *   sview:  Source viewer object
+ */
+void source_files_changed(struct sviewer *sview);
+
+/* source_invalidate:  Makes the next source_display draw every row.
+ * ------------------
+ *
+ *  source_display only draws the rows that changed. Call this after
+ *  changing something it can't see, such as the colors or the options
+ *  that change how lines are drawn.
+ *
+ *   sview:  Source viewer object
+ */
+void source_invalidate(struct sviewer *sview);
+
+/* source_loaded:  Installs the files the loader is done reading.
+ * --------------
+ *
+ *  A file gdb stopped in that took too long to read is shown as loading
+ *  until it's installed here. A prefetched one is installed if it still
+ *  fits within the srcmem option.
+ *
+ *   sview:  Source viewer object
+ *
+ * Return Value:  1 if the source window needs to be drawn, 0 otherwise.
+ */
+int source_loaded(struct sviewer *sview);
+
+/* source_prefetch:  Asks for a file to be loaded before it's displayed.
+ * ----------------
+ *
+ *  The file is loaded and highlighted by source_prefetch_next, once
+ *  there's nothing else to do.
+ *
+ *   sview:  Source viewer object
+ *   path:   The full path to the file, or the relative path of a file
+ *           that was already added
+ *
+ * Return Value:  0 if the file was queued or is loaded already, -1 if
+ *                there's no such file.
+ */
+int source_prefetch(struct sviewer *sview, const char *path);
+
+/* source_restore:  Adds a file that was open in an earlier run of cgdb.
+ * ---------------
+ *
+ *  The file is prefetched like by source_prefetch, and the selected line
+ *  is the one it had, as far as the file still has it.
+ *
+ *   sview:  Source viewer object
+ *   path:   The full path to the file
+ *   line:   The line that was selected, starting at 1
+ *
+ * Return Value:  0 if the file was queued or is loaded already, -1 if
+ *                there's no such file.
+ */
+int source_restore(struct sviewer *sview, const char *path, int line);
+
+/* source_prefetch_pending:  Determines if files are waiting to be loaded.
+ * ------------------------
+ *
+ *   sview:  Source viewer object
+ *
+ * Return Value:  1 if source_prefetch_next has work to do, 0 otherwise.
+ */
+int source_prefetch_pending(struct sviewer *sview);
+
+/* source_prefetch_next:  Loads the next file asked for by source_prefetch.
+ * ---------------------
+ *
+ *  The displayed file and the files shown before it are never evicted to
+ *  make room. Once the srcmem option is reached, the files still waiting
+ *  are forgotten.
+ *
+ *   sview:  Source viewer object
+ *
+ * Return Value:  1 if a file was loaded, 0 otherwise.
+ */
+int source_prefetch_next(struct sviewer *sview);
+
 /* source_free:  Release the memory associated with a source viewer.
  * ------------
  *
@@ -255,30 +812,67 @@ void source_free(struct sviewer *sview);
 /* Breakpoints */
 /* ----------- */
 
-/* source_disable_break:  Disable a given breakpoint.
+/* source_update_breaks:  Replaces the breakpoints with a new list.
  * ---------------------
  *
- *   sview:  The source viewer object
- *   path:   Full path to the source file
- *   line:   Line number of breakpoint
+ *  The new list is compared with the last one, and only the lines whose
+ *  breakpoints changed are touched. Files that are loaded later get their
+ *  breakpoints from the list too.
+ *
+ *   sview:   The source viewer object
+ *   breaks:  The new breakpoints, they are copied. A line with more than
+ *            one is enabled if any of them is.
+ *   count:   The number of breakpoints
+ *
+ *  Return Value:  1 if a line of the file being displayed changed,
+ *                 0 otherwise.
  */
-void source_disable_break(struct sviewer *sview, const char *path, int line);
+int source_update_breaks(struct sviewer *sview,
+        const struct source_break *breaks, int count);
 
-/* source_enable_break:  Enable a given breakpoint.
+/* source_change_break:  Moves, adds or removes a single breakpoint.
  * --------------------
  *
+ *  Only the lines of the breakpoint are touched, the others aren't looked
+ *  at.
+ *
  *   sview:  The source viewer object
- *   path:   Full path to the source file
- *   line:   Line number of breakpoint
+ *   old:    The breakpoint as it was, NULL if it's new
+ *   new:    The breakpoint as it is now, NULL if it was deleted. It's
+ *           copied.
+ *
+ *  Return Value:  1 if a line of the file being displayed changed,
+ *                 0 otherwise.
  */
-void source_enable_break(struct sviewer *sview, const char *path, int line);
+int source_change_break(struct sviewer *sview,
+        const struct source_break *old, const struct source_break *new);
 
-/* source_clear_breaks:  Clear all breakpoints from all files.
- * --------------------
+/* source_has_break:  Determines if a line has a breakpoint.
+ * -----------------
  *
  *   sview:  The source viewer object
+ *   path:   The relative path to the file, interned
+ *   line:   The line number
+ *
+ *  Return Value:  1 if it has one, enabled or not, 0 otherwise.
+ */
+int source_has_break(struct sviewer *sview, const char *path, int line);
+
+/* source_update_heat:  Replaces the heat of the lines with a new profile.
+ * -------------------
+ *
+ *  Like source_update_breaks, only the lines whose heat changed are
+ *  touched, and files that are loaded later get theirs from the profile.
+ *
+ *   sview:   Source viewer object
+ *   heat:    The lines that are hot, they are copied. Each line is in it
+ *            once at most.
+ *   count:   The number of lines, 0 takes the heat off all of them
+ *
+ * Return Value:  1 if the file being displayed changed, 0 otherwise.
  */
-void source_clear_breaks(struct sviewer *sview);
+int source_update_heat(struct sviewer *sview,
+        const struct source_heat *heat, int count);
 
 /**
  * Check's to see if the current source file has changed. If it has it loads
@@ -0,0 +1,397 @@
+/* spill.c:
+ * --------
+ *
+ * A block holds whole lines, each one followed by a NUL, so a line read
+ * back is ready to draw or to match. The lines of the last block stay in
+ * memory until it's full, then it's compressed and written after the ones
+ * before it. A block that doesn't get smaller is written as it is.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif /* HAVE_SYS_TYPES_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_ZLIB_H && HAVE_LIBZ
+#include <zlib.h>
+#endif /* HAVE_ZLIB_H && HAVE_LIBZ */
+
+/* Local Includes */
+#include "spill.h"
+#include "sys_util.h"
+#include "logger.h"
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The bytes of lines gathered before a block is written */
+#define SPILL_BLOCK (64 * 1024)
+
+/* The most blocks kept in memory once they're read back */
+#define SPILL_CACHED 2
+
+/* A block that was written to the file */
+struct spill_block {
+    off_t offset;               /* Where it starts in the file */
+    size_t size;                /* Its size in the file */
+    size_t raw;                 /* Its size uncompressed, size if it's not */
+    int first;                  /* The index of its first line */
+    int lines;                  /* The number of lines in it */
+};
+
+/* The lines of a block, in memory */
+struct spill_text {
+    int block;                  /* The block, -1 for none */
+    char *text;                 /* The lines, each one NUL terminated */
+    size_t length;              /* The bytes used in text */
+    size_t size;                /* The bytes allocated for text */
+    int *starts;                /* Where each line starts in text */
+    int lines;
+    int starts_size;
+    unsigned long used;         /* When it was last read, for eviction */
+};
+
+struct spill {
+    int fd;                     /* The temporary file */
+    off_t end;                  /* Its size */
+
+    struct spill_block *blocks; /* The blocks written, oldest first */
+    int nblocks;
+    int blocks_size;
+
+    struct spill_text last;     /* The lines not written yet */
+    struct spill_text cache[SPILL_CACHED];
+    unsigned long tick;
+};
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* text_clear: Empties the lines of a block.
+ * -----------
+ */
+static void text_clear(struct spill_text *text)
+{
+    text->length = 0;
+    text->lines = 0;
+}
+
+/* text_free: Frees the lines of a block.
+ * ----------
+ */
+static void text_free(struct spill_text *text)
+{
+    free(text->text);
+    free(text->starts);
+    text->text = NULL;
+    text->starts = NULL;
+    text->size = text->length = 0;
+    text->starts_size = text->lines = 0;
+    text->block = -1;
+}
+
+/* text_reserve: Makes room for some bytes after the lines of a block.
+ * -------------
+ */
+static void text_reserve(struct spill_text *text, size_t length)
+{
+    if (text->length + length <= text->size)
+        return;
+
+    text->size = text->size * 2 > text->length + length ?
+            text->size * 2 : text->length + length;
+    text->text = cgdb_realloc(text->text, text->size);
+}
+
+/* text_index: Finds where the lines of a block start.
+ * -----------
+ */
+static void text_index(struct spill_text *text)
+{
+    const char *p = text->text, *end = text->text + text->length, *nul;
+
+    for (text->lines = 0; p < end; p = nul + 1) {
+        if (text->lines == text->starts_size) {
+            text->starts_size = text->starts_size ? text->starts_size * 2 : 256;
+            text->starts = cgdb_realloc(text->starts,
+                    sizeof (int) * text->starts_size);
+        }
+        text->starts[text->lines++] = p - text->text;
+
+        if ((nul = memchr(p, '\0', end - p)) == NULL)
+            break;
+    }
+}
+
+/* spill_write: Writes the last block to the file.
+ * ------------
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+static int spill_write(struct spill *spill)
+{
+    struct spill_block *block;
+    const char *data = spill->last.text;
+    size_t size = spill->last.length;
+    char *compressed = NULL;
+    ssize_t n;
+    size_t done;
+
+#if HAVE_ZLIB_H && HAVE_LIBZ
+    uLongf length = compressBound(size);
+
+    compressed = cgdb_malloc(length);
+    if (compress2((Bytef *) compressed, &length, (const Bytef *) data, size,
+                    Z_BEST_SPEED) == Z_OK && length < size) {
+        data = compressed;
+        size = length;
+    }
+#endif /* HAVE_ZLIB_H && HAVE_LIBZ */
+
+    for (done = 0; done < size; done += n) {
+        n = pwrite(spill->fd, data + done, size - done, spill->end + done);
+        if (n <= 0) {
+            free(compressed);
+            return -1;
+        }
+    }
+
+    if (spill->nblocks == spill->blocks_size) {
+        spill->blocks_size = spill->blocks_size ? spill->blocks_size * 2 : 64;
+        spill->blocks = cgdb_realloc(spill->blocks,
+                sizeof (struct spill_block) * spill->blocks_size);
+    }
+
+    block = &spill->blocks[spill->nblocks];
+    block->offset = spill->end;
+    block->size = size;
+    block->raw = spill->last.length;
+    block->first = spill->nblocks > 0 ?
+            block[-1].first + block[-1].lines : 0;
+    block->lines = spill->last.lines;
+    spill->nblocks++;
+    spill->end += size;
+
+    text_clear(&spill->last);
+    free(compressed);
+
+    return 0;
+}
+
+/* spill_read: Reads a block back from the file.
+ * -----------
+ *
+ *   block:  The block
+ *
+ * Return Value: The lines of the block, or NULL on error.
+ */
+static struct spill_text *spill_read(struct spill *spill, int block)
+{
+    struct spill_block *b = &spill->blocks[block];
+    struct spill_text *text = &spill->cache[0];
+    char *data;
+    ssize_t n;
+    size_t done;
+    int i;
+
+    for (i = 0; i < SPILL_CACHED; i++) {
+        if (spill->cache[i].block == block) {
+            spill->cache[i].used = ++spill->tick;
+            return &spill->cache[i];
+        }
+
+        if (spill->cache[i].used < text->used)
+            text = &spill->cache[i];
+    }
+
+    text->block = -1;
+    text_clear(text);
+    text_reserve(text, b->raw);
+    data = b->size == b->raw ? text->text : cgdb_malloc(b->size);
+
+    for (done = 0; done < b->size; done += n) {
+        n = pread(spill->fd, data + done, b->size - done, b->offset + done);
+        if (n <= 0) {
+            if (data != text->text)
+                free(data);
+            return NULL;
+        }
+    }
+
+    if (data != text->text) {
+#if HAVE_ZLIB_H && HAVE_LIBZ
+        uLongf length = b->raw;
+
+        if (uncompress((Bytef *) text->text, &length, (const Bytef *) data,
+                        b->size) != Z_OK || length != b->raw) {
+            free(data);
+            return NULL;
+        }
+#endif /* HAVE_ZLIB_H && HAVE_LIBZ */
+        free(data);
+    }
+
+    text->length = b->raw;
+    text_index(text);
+    text->block = block;
+    text->used = ++spill->tick;
+
+    return text;
+}
+
+/* spill_find: Finds the block a line was written in.
+ * -----------
+ *
+ * Return Value: The block, or -1 if the line wasn't written yet.
+ */
+static int spill_find(struct spill *spill, int index)
+{
+    int low = 0, high = spill->nblocks - 1, mid;
+
+    if (spill->nblocks == 0 ||
+            index >= spill->blocks[high].first + spill->blocks[high].lines)
+        return -1;
+
+    while (low < high) {
+        mid = (low + high + 1) / 2;
+        if (spill->blocks[mid].first <= index)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    return low;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in spill.h for function descriptions. */
+
+struct spill *spill_new(void)
+{
+    struct spill *spill;
+    FILE *file;
+    int i;
+
+    /* The file is already deleted, it goes away with the descriptor */
+    if ((file = tmpfile()) == NULL)
+        return NULL;
+
+    spill = cgdb_calloc(1, sizeof (struct spill));
+    spill->fd = dup(fileno(file));
+    fclose(file);
+
+    if (spill->fd == -1) {
+        free(spill);
+        return NULL;
+    }
+
+    spill->last.block = -1;
+    for (i = 0; i < SPILL_CACHED; i++)
+        spill->cache[i].block = -1;
+
+    return spill;
+}
+
+void spill_free(struct spill *spill)
+{
+    int i;
+
+    if (!spill)
+        return;
+
+    cgdb_close(spill->fd);
+    free(spill->blocks);
+    text_free(&spill->last);
+    for (i = 0; i < SPILL_CACHED; i++)
+        text_free(&spill->cache[i]);
+    free(spill);
+}
+
+int spill_add(struct spill *spill, const char *text, int length)
+{
+    struct spill_text *last = &spill->last;
+
+    if (last->length > 0 && last->length + length + 1 > SPILL_BLOCK &&
+            spill_write(spill) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__, "spill_write failed");
+        return -1;
+    }
+
+    if (last->lines == last->starts_size) {
+        last->starts_size = last->starts_size ? last->starts_size * 2 : 256;
+        last->starts = cgdb_realloc(last->starts,
+                sizeof (int) * last->starts_size);
+    }
+
+    text_reserve(last, length + 1);
+    last->starts[last->lines++] = last->length;
+    memcpy(last->text + last->length, text, length);
+    last->text[last->length + length] = '\0';
+    last->length += length + 1;
+
+    return 0;
+}
+
+int spill_count(struct spill *spill)
+{
+    struct spill_block *block;
+
+    if (spill->nblocks == 0)
+        return spill->last.lines;
+
+    block = &spill->blocks[spill->nblocks - 1];
+
+    return block->first + block->lines + spill->last.lines;
+}
+
+const char *spill_get(struct spill *spill, int index, int *length)
+{
+    struct spill_text *text = &spill->last;
+    int block = spill_find(spill, index), line;
+    size_t end;
+
+    if (block == -1) {
+        line = index - (spill_count(spill) - spill->last.lines);
+    } else {
+        if ((text = spill_read(spill, block)) == NULL) {
+            logger_write_pos(logger, __FILE__, __LINE__, "spill_read failed");
+            return NULL;
+        }
+        line = index - spill->blocks[block].first;
+    }
+
+    if (line < 0 || line >= text->lines)
+        return NULL;
+
+    end = line + 1 < text->lines ? (size_t) text->starts[line + 1] :
+            text->length;
+    *length = end - text->starts[line] - 1;
+
+    return text->text + text->starts[line];
+}
@@ -0,0 +1,64 @@
+#ifndef _SPILL_H_
+#define _SPILL_H_
+
+/* spill.h:
+ * --------
+ *
+ * Keeps the lines a scroller drops out of its scrollback, so output from
+ * long ago can still be scrolled back to and searched.
+ *
+ * The lines are gathered into blocks of about SPILL_BLOCK bytes. Each full
+ * block is compressed with zlib, when cgdb is built with it, and appended
+ * to a temporary file that's deleted when cgdb exits. An index in memory
+ * says where each block starts. Reading a line back loads only its block,
+ * and the last couple of blocks loaded are kept.
+ *
+ */
+
+/* The lines a scroller dropped, see spill.c */
+struct spill;
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* spill_new: Creates an empty spill, with a temporary file of its own.
+ * ----------
+ *
+ * Return Value: The spill, or NULL if the file can't be created.
+ */
+struct spill *spill_new(void);
+
+/* spill_free: Frees a spill, and deletes its file.
+ * -----------
+ */
+void spill_free(struct spill *spill);
+
+/* spill_add: Adds a line after the ones added before.
+ * ----------
+ *
+ *   text:    The line, it has no newline
+ *   length:  Its length, in bytes
+ *
+ * Return Value: 0 on success, -1 if the file can't be written.
+ */
+int spill_add(struct spill *spill, const char *text, int length);
+
+/* spill_count: Gets the number of lines added.
+ * ------------
+ */
+int spill_count(struct spill *spill);
+
+/* spill_get: Reads a line back.
+ * ----------
+ *
+ *   index:   The line, 0 is the oldest one
+ *   length:  Set to its length, in bytes
+ *
+ * Return Value: The line, NUL terminated, or NULL if it can't be read. It's
+ *               valid until spill_get is called with a line of another
+ *               block, or lines are added.
+ */
+const char *spill_get(struct spill *spill, int index, int *length);
+
+#endif /* _SPILL_H_ */
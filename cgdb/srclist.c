@@ -0,0 +1,336 @@
+/* srclist.c:
+ * ----------
+ *
+ * A list is a text file named after the hash of what it's kept for, with
+ * one path on each line. The first lines are a version and what it's kept
+ * for, and the list is dropped unless they match. Like a snapshot, a list
+ * is written to a temporary file and renamed into place.
+ *
+ *   cgdbsrclist1
+ *   build-id <hex> | binary <timestamp> <path>
+ *   <path>
+ *   ...
+ *
+ * The build-id is the GNU build-id note of the program, found through its
+ * ELF program headers. Only the first bytes of the program are read.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif /* HAVE_SYS_STAT_H */
+
+/* Local Includes */
+#include "srclist.h"
+#include "resume.h"
+#include "fs_util.h"
+#include "std_hash.h"
+#include "sys_util.h"
+#include "logger.h"
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The name of the list directory, in the config directory */
+#define SRCLIST_DIR "srclist"
+
+/* Change the version when the layout of a list changes */
+#define SRCLIST_MAGIC "cgdbsrclist1"
+
+/* A line of a list */
+#define SRCLIST_LINE (FSUTIL_PATH_MAX + 64)
+
+/* What of ELF is needed to find the build-id */
+#define SRCLIST_PT_NOTE 4
+#define SRCLIST_NT_GNU_BUILD_ID 3
+#define SRCLIST_MAX_HEADERS 256 /* The program headers looked at */
+#define SRCLIST_MAX_NOTES 65536 /* The bytes of notes looked at */
+
+/* What srclist_write writes */
+struct srclist_contents {
+    const char *ident;
+    char **files;
+    int count;
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+static char srclist_home[FSUTIL_PATH_MAX];  /* The config directory */
+static char srclist_dir[FSUTIL_PATH_MAX];   /* The list directory */
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* srclist_number: Gets a number out of an ELF file.
+ * ---------------
+ *
+ *   data:   Where it is
+ *   bytes:  Its size, up to 8
+ *   big:    1 if the file is big endian, 0 if it's little endian
+ */
+static unsigned long long srclist_number(const unsigned char *data,
+        int bytes, int big)
+{
+    unsigned long long number = 0;
+    int i;
+
+    for (i = 0; i < bytes; i++)
+        number = (number << 8) | data[big ? i : bytes - 1 - i];
+
+    return number;
+}
+
+/* srclist_note: Finds the build-id among the notes of a segment.
+ * -------------
+ *
+ *   notes:  The notes
+ *   size:   The bytes in notes
+ *   align:  What the names and the descriptions are padded to
+ *   big:    1 if the file is big endian
+ *   id:     Set to the build-id in hex, at least SRCLIST_LINE in size
+ *
+ * Return Value: 0 if it was found, -1 otherwise.
+ */
+static int srclist_note(const unsigned char *notes, size_t size,
+        size_t align, int big, char *id)
+{
+    unsigned long long name_size, desc_size, type;
+    size_t at = 0, name_at, desc_at, i;
+
+    while (at + 12 <= size) {
+        name_size = srclist_number(notes + at, 4, big);
+        desc_size = srclist_number(notes + at + 4, 4, big);
+        type = srclist_number(notes + at + 8, 4, big);
+
+        name_at = at + 12;
+        desc_at = name_at + ((name_size + align - 1) & ~(align - 1));
+        if (name_size > size || desc_size > size || desc_at > size ||
+                desc_at + desc_size > size)
+            return -1;
+
+        if (type == SRCLIST_NT_GNU_BUILD_ID && name_size == 4 &&
+                memcmp(notes + name_at, "GNU", 4) == 0 && desc_size > 0 &&
+                desc_size * 2 < SRCLIST_LINE) {
+            for (i = 0; i < desc_size; i++)
+                sprintf(id + i * 2, "%02x", notes[desc_at + i]);
+            return 0;
+        }
+
+        at = desc_at + ((desc_size + align - 1) & ~(align - 1));
+    }
+
+    return -1;
+}
+
+/* srclist_build_id: Finds the GNU build-id of a program.
+ * -----------------
+ *
+ *   path:  The program
+ *   id:    Set to the build-id in hex, at least SRCLIST_LINE in size
+ *
+ * Return Value: 0 if it has one, -1 otherwise.
+ */
+static int srclist_build_id(const char *path, char *id)
+{
+    unsigned char header[64], *headers = NULL, *notes = NULL;
+    unsigned long long offset, size, align;
+    int fd, wide, big, entry, count, i, ret = -1;
+    const unsigned char *ph;
+
+    if ((fd = open(path, O_RDONLY)) == -1)
+        return -1;
+
+    if (pread(fd, header, sizeof (header), 0) != sizeof (header) ||
+            memcmp(header, "\177ELF", 4) != 0 ||
+            (header[4] != 1 && header[4] != 2) ||
+            (header[5] != 1 && header[5] != 2))
+        goto done;
+
+    /* ELFCLASS64 or ELFCLASS32, ELFDATA2MSB or ELFDATA2LSB */
+    wide = header[4] == 2;
+    big = header[5] == 2;
+
+    offset = wide ? srclist_number(header + 0x20, 8, big) :
+            srclist_number(header + 0x1c, 4, big);
+    entry = (int) srclist_number(header + (wide ? 0x36 : 0x2a), 2, big);
+    count = (int) srclist_number(header + (wide ? 0x38 : 0x2c), 2, big);
+    if (entry < (wide ? 0x38 : 0x20) || count <= 0 ||
+            count > SRCLIST_MAX_HEADERS)
+        goto done;
+
+    size = (unsigned long long) entry * count;
+    headers = cgdb_malloc(size);
+    if (pread(fd, headers, size, offset) != (ssize_t) size)
+        goto done;
+
+    for (i = 0; ret == -1 && i < count; i++) {
+        ph = headers + i * entry;
+        if (srclist_number(ph, 4, big) != SRCLIST_PT_NOTE)
+            continue;
+
+        offset = wide ? srclist_number(ph + 0x08, 8, big) :
+                srclist_number(ph + 0x04, 4, big);
+        size = wide ? srclist_number(ph + 0x20, 8, big) :
+                srclist_number(ph + 0x10, 4, big);
+        align = wide ? srclist_number(ph + 0x30, 8, big) :
+                srclist_number(ph + 0x1c, 4, big);
+        if (size == 0 || size > SRCLIST_MAX_NOTES)
+            continue;
+
+        notes = cgdb_realloc(notes, size);
+        if (pread(fd, notes, size, offset) != (ssize_t) size)
+            continue;
+
+        ret = srclist_note(notes, size, align == 8 ? 8 : 4, big, id);
+    }
+
+done:
+    free(notes);
+    free(headers);
+    cgdb_close(fd);
+
+    return ret;
+}
+
+/* srclist_write: Writes the list of a program, for fs_util_write_file.
+ * --------------
+ */
+static int srclist_write(FILE *file, void *data)
+{
+    struct srclist_contents *contents = data;
+    int i;
+
+    fprintf(file, "%s\n%s\n", SRCLIST_MAGIC, contents->ident);
+
+    /* Paths with a newline in them are left out, they can't be read back */
+    for (i = 0; i < contents->count; i++)
+        if (!strchr(contents->files[i], '\n'))
+            fprintf(file, "%s\n", contents->files[i]);
+
+    return 0;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in srclist.h for function descriptions. */
+
+void srclist_init(const char *home_dir)
+{
+    strncpy(srclist_home, home_dir, FSUTIL_PATH_MAX - 1);
+    fs_util_get_path(srclist_home, SRCLIST_DIR, srclist_dir);
+}
+
+char *srclist_ident(int argc, char *argv[])
+{
+    const char *program = resume_program(argc, argv);
+    char path[FSUTIL_PATH_MAX], id[SRCLIST_LINE];
+    char *ident;
+    struct stat st;
+
+    /* gdb looks for a program without a slash in the current directory */
+    if (!program || strlen(program) >= FSUTIL_PATH_MAX ||
+            !realpath(program, path) || stat(path, &st) == -1)
+        return NULL;
+
+    ident = cgdb_malloc(SRCLIST_LINE + 32);
+    if (srclist_build_id(path, id) == 0)
+        snprintf(ident, SRCLIST_LINE + 32, "build-id %s", id);
+    else
+        snprintf(ident, SRCLIST_LINE + 32, "binary %lld %s",
+                (long long) st.st_mtime, path);
+
+    return ident;
+}
+
+char **srclist_load(const char *ident, int *count)
+{
+    char entry[FSUTIL_PATH_MAX], line[SRCLIST_LINE];
+    char **files = NULL;
+    int size = 0;
+    size_t length;
+    FILE *file;
+
+    *count = 0;
+
+    fs_util_get_hashed_path(srclist_dir, std_str_hash(ident), entry);
+    if (!(file = fopen(entry, "r")))
+        return NULL;
+
+    /* Nothing is used unless it's the list of the program */
+    if (!fgets(line, sizeof (line), file) ||
+            strcmp(line, SRCLIST_MAGIC "\n") != 0 ||
+            !fgets(line, sizeof (line), file) ||
+            strncmp(line, ident, strlen(ident)) != 0 ||
+            strcmp(line + strlen(ident), "\n") != 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    while (fgets(line, sizeof (line), file)) {
+        /* A line that doesn't fit is from some other list */
+        length = strlen(line);
+        if (length <= 1 || line[length - 1] != '\n')
+            break;
+        line[length - 1] = '\0';
+
+        if (*count == size) {
+            size = size ? size * 2 : 64;
+            files = cgdb_realloc(files, sizeof (char *) * size);
+        }
+        files[(*count)++] = cgdb_strdup(line);
+    }
+
+    fclose(file);
+
+    return files;
+}
+
+int srclist_save(const char *ident, char **files, int count)
+{
+    struct srclist_contents contents = { ident, files, count };
+    char entry[FSUTIL_PATH_MAX];
+
+    if (!fs_util_create_dir_in_base(srclist_home, SRCLIST_DIR))
+        return -1;
+
+    fs_util_get_hashed_path(srclist_dir, std_str_hash(ident), entry);
+
+    if (fs_util_write_file(entry, srclist_write, &contents) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "Unable to save the source files of %s", ident);
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#ifndef _SRCLIST_H_
+#define _SRCLIST_H_
+
+/* srclist.h:
+ * ----------
+ *
+ * The source files gdb listed for a program, kept on disk, so the file
+ * dialog can show them as soon as it's opened. Listing them can take gdb
+ * seconds on a big program, the list it gives replaces the one that was
+ * kept when it comes.
+ *
+ * A list is kept for the build-id of the program, so a copy of it, or the
+ * same build of it somewhere else, has it too. A program without one has
+ * its list kept for its path and timestamp.
+ *
+ */
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* srclist_init: Tells where the lists are kept.
+ * -------------
+ *
+ *   home_dir:  The config directory, the lists are kept in a directory in
+ *              it. It is created the first time one is saved.
+ */
+void srclist_init(const char *home_dir);
+
+/* srclist_ident: Finds what the list of the program gdb debugs is kept for.
+ * --------------
+ *
+ *   argc:  The number of arguments gdb is given
+ *   argv:  The arguments gdb is given
+ *
+ * Return Value: The program's build-id, or its path and timestamp, the
+ *               caller frees it. NULL if gdb wasn't given a program.
+ */
+char *srclist_ident(int argc, char *argv[]);
+
+/* srclist_load: Reads the list that was kept for a program.
+ * -------------
+ *
+ *   ident:  From srclist_ident
+ *   count:  Set to the number of files
+ *
+ * Return Value: The files, the caller frees them and the array. NULL if
+ *               there's no list.
+ */
+char **srclist_load(const char *ident, int *count);
+
+/* srclist_save: Keeps the list of a program, in place of the last one.
+ * -------------
+ *
+ *   ident:  From srclist_ident
+ *   files:  The files gdb listed
+ *   count:  The number of files
+ *
+ * Return Value: 0 on success, -1 on error.
+ */
+int srclist_save(const char *ident, char **files, int count);
+
+#endif /* _SRCLIST_H_ */
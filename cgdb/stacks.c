@@ -0,0 +1,250 @@
+/* stacks.c:
+ * ---------
+ *
+ * Two stacks are the same when they go through the same functions, in the
+ * same order. The lines they're at can differ, a group is printed with the
+ * lines of its first tab. A frame without a function is compared by its
+ * address.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+/* Local Includes */
+#include "stacks.h"
+#include "interface.h"
+#include "tgdb_types.h"
+#include "ibuf.h"
+#include "sys_util.h"
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* The stack of a tab */
+struct stacks_stack {
+    int tab;                    /* The number of the tab */
+    int done;                   /* 1 once it answered */
+    char *key;                  /* What it's grouped by */
+    char *text;                 /* Its frames, as they're printed */
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+static struct stacks_stack *stacks;
+static int stacks_count;        /* The tabs asked, 0 when none are */
+static int stacks_due;          /* The ones that didn't answer yet */
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* Orders the stacks by key, and the tabs with the same key by number */
+static int stacks_compare(const void *a, const void *b)
+{
+    const struct stacks_stack *left = (const struct stacks_stack *) a;
+    const struct stacks_stack *right = (const struct stacks_stack *) b;
+    int result = strcmp(left->key, right->key);
+
+    return result ? result : left->tab - right->tab;
+}
+
+/* A group of tabs with the same stack, in stacks once they're sorted */
+struct stacks_group {
+    int first;
+    int count;
+};
+
+/* Orders the groups, the biggest first */
+static int stacks_group_compare(const void *a, const void *b)
+{
+    const struct stacks_group *left = (const struct stacks_group *) a;
+    const struct stacks_group *right = (const struct stacks_group *) b;
+
+    if (left->count != right->count)
+        return right->count - left->count;
+
+    return stacks[left->first].tab - stacks[right->first].tab;
+}
+
+/* stacks_tabs: Writes the tabs of a group, with runs of them as "3-7".
+ * ------------
+ */
+static void stacks_tabs(struct ibuf *text, const struct stacks_group *group)
+{
+    char number[32];
+    int i, j;
+
+    for (i = group->first; i < group->first + group->count; i = j + 1) {
+        for (j = i; j + 1 < group->first + group->count &&
+                stacks[j + 1].tab == stacks[j].tab + 1; j++)
+            ;
+
+        if (j == i)
+            snprintf(number, sizeof (number), "%s%d",
+                    i == group->first ? "" : ",", stacks[i].tab);
+        else
+            snprintf(number, sizeof (number), "%s%d-%d",
+                    i == group->first ? "" : ",", stacks[i].tab, stacks[j].tab);
+        ibuf_add(text, number);
+    }
+}
+
+/* stacks_print: Prints the groups, once every tab answered.
+ * -------------
+ */
+static void stacks_print(void)
+{
+    struct stacks_group *groups;
+    struct ibuf *text = ibuf_init();
+    char line[MAXLINE];
+    int count = 0, i;
+
+    qsort(stacks, stacks_count, sizeof (struct stacks_stack), stacks_compare);
+
+    groups = cgdb_malloc(sizeof (struct stacks_group) * stacks_count);
+    for (i = 0; i < stacks_count; i++) {
+        if (i > 0 && strcmp(stacks[i].key, stacks[i - 1].key) == 0) {
+            groups[count - 1].count++;
+            continue;
+        }
+        groups[count].first = i;
+        groups[count].count = 1;
+        count++;
+    }
+    qsort(groups, count, sizeof (struct stacks_group), stacks_group_compare);
+
+    snprintf(line, sizeof (line), "\n%d tab%s, %d different stack%s\n",
+            stacks_count, stacks_count == 1 ? "" : "s", count,
+            count == 1 ? "" : "s");
+    ibuf_add(text, line);
+
+    for (i = 0; i < count; i++) {
+        snprintf(line, sizeof (line), "%d tab%s: ", groups[i].count,
+                groups[i].count == 1 ? "" : "s");
+        ibuf_add(text, line);
+        stacks_tabs(text, &groups[i]);
+        ibuf_addchar(text, '\n');
+        ibuf_add(text, stacks[groups[i].first].text);
+    }
+
+    if_print(ibuf_get(text));
+
+    ibuf_free(text);
+    free(groups);
+}
+
+/* stacks_forget: Frees what was gathered.
+ * --------------
+ */
+static void stacks_forget(void)
+{
+    int i;
+
+    for (i = 0; i < stacks_count; i++) {
+        free(stacks[i].key);
+        free(stacks[i].text);
+    }
+    free(stacks);
+
+    stacks = NULL;
+    stacks_count = stacks_due = 0;
+}
+
+/* -------------------------------------- */
+/* Functions                              */
+/* -------------------------------------- */
+
+int stacks_start(int count)
+{
+    if (stacks_due > 0)
+        return -1;
+
+    stacks_forget();
+
+    if (count > 0) {
+        stacks = cgdb_calloc(count, sizeof (struct stacks_stack));
+        stacks_count = stacks_due = count;
+    }
+
+    return 0;
+}
+
+void stacks_add(int slot, int tab, const struct tgdb_frames *frames)
+{
+    struct stacks_stack *stack;
+    struct ibuf *key, *text;
+    const struct tgdb_frame *frame;
+    char line[MAXLINE];
+    int i;
+
+    if (slot < 0 || slot >= stacks_count || stacks[slot].done)
+        return;
+
+    key = ibuf_init();
+    text = ibuf_init();
+
+    if (!frames) {
+        ibuf_add(text, "  The tab was closed\n");
+    } else if (frames->count == 0) {
+        snprintf(line, sizeof (line), "  %s\n",
+                frames->error ? frames->error : "No stack");
+        ibuf_add(text, line);
+    }
+
+    for (i = 0; frames && i < frames->count; i++) {
+        frame = &frames->frames[i];
+
+        if (frame->function)
+            snprintf(line, sizeof (line), "%s\n", frame->function);
+        else
+            snprintf(line, sizeof (line), "0x%lx\n", frame->address);
+        ibuf_add(key, line);
+
+        if (frame->relative_path)
+            snprintf(line, sizeof (line), "  #%-3d %s at %s:%d\n",
+                    frame->level, frame->function ? frame->function : "??",
+                    frame->relative_path, frame->line_number);
+        else if (frame->function)
+            snprintf(line, sizeof (line), "  #%-3d %s\n", frame->level,
+                    frame->function);
+        else
+            snprintf(line, sizeof (line), "  #%-3d 0x%lx\n", frame->level,
+                    frame->address);
+        ibuf_add(text, line);
+    }
+
+    /* The tabs without frames are grouped by what they say instead */
+    if (ibuf_length(key) == 0)
+        ibuf_add(key, ibuf_get(text));
+
+    stack = &stacks[slot];
+    stack->tab = tab;
+    stack->done = 1;
+    stack->key = ibuf_steal(key);
+    stack->text = ibuf_steal(text);
+    ibuf_free(key);
+    ibuf_free(text);
+
+    if (--stacks_due == 0) {
+        stacks_print();
+        stacks_forget();
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef _STACKS_H_
+#define _STACKS_H_
+
+/* stacks.h:
+ * ---------
+ *
+ * The stacks of the programs the tabs debug, gathered to be looked at
+ * together. When each tab debugs a rank of the same job, most of them are
+ * usually in the same place: the tabs whose stacks go through the same
+ * functions are grouped, and each group is printed once, with the tabs in
+ * it, the biggest group first.
+ *
+ */
+
+struct tgdb_frames;
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* stacks_start: Starts gathering the stacks of some tabs.
+ * -------------
+ *
+ *   count:  How many tabs were asked for their stack. Each answers with
+ *           stacks_add, the groups are printed once they all did.
+ *
+ * Return Value: 0 on success, -1 if the last gathering isn't done.
+ */
+int stacks_start(int count);
+
+/* stacks_add: Takes the stack of a tab.
+ * -----------
+ *
+ *   slot:    Which of the tabs asked it is, from 0 to count - 1
+ *   tab:     The number of the tab, as it's printed
+ *   frames:  Its stack, or NULL if the tab went away without answering
+ */
+void stacks_add(int slot, int tab, const struct tgdb_frames *frames);
+
+#endif /* _STACKS_H_ */
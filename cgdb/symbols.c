@@ -0,0 +1,479 @@
+/* symbols.c:
+ * ----------
+ *
+ * The index keeps each name once, sorted, and each place a name is at in
+ * the order of the file. Every name has the places it's at, in order, so
+ * a name and a place in its list are each found by a binary search.
+ *
+ * The builder only appends, the sorting is done once by symbols_finish.
+ * Nothing is shared between builders, so the highlighter's workers each
+ * build one at the same time.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_STDINT_H
+#include <stdint.h>
+#endif /* HAVE_STDINT_H */
+
+/* Local Includes */
+#include "symbols.h"
+#include "sys_util.h"
+
+/* --------------- */
+/* Data Structures */
+/* --------------- */
+
+/* A place a name is at, while the index is built */
+struct symbols_entry {
+    union {
+        size_t offset;          /* Where the name is in the builder's text */
+        const char *text;       /* The name, once the text stops moving */
+    } name;
+    int length;
+    int line;
+    int col;
+    int definition;
+    uint32_t symbol;            /* The name's index, once they're sorted */
+};
+
+struct symbols_builder {
+    char *text;                 /* The names, one after the other */
+    size_t text_length;
+    size_t text_size;
+
+    struct symbols_entry *entries;
+    int count;
+    int size;
+};
+
+/* A name of the index */
+struct symbols_name {
+    uint32_t name;              /* Where it is in names, it ends in a '\0' */
+    uint32_t length;
+    uint32_t first;             /* Its first place in places */
+    uint32_t count;             /* The number of places it's at */
+    int32_t definition;         /* The index in occurs of its definition,
+                                 * or -1 */
+};
+
+/* A place a name is at */
+struct symbols_occur {
+    int32_t line;
+    int32_t col;
+    uint32_t symbol:31;         /* The index of the name */
+    uint32_t definition:1;      /* Set if it looks defined here */
+};
+
+struct symbols {
+    char *names;
+    size_t names_length;
+
+    struct symbols_name *symbols;       /* Sorted by name */
+    int count;
+
+    struct symbols_occur *occurs;       /* In the order of the file */
+    uint32_t *places;           /* Indexes into occurs, by name */
+    int occur_count;
+};
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* name_compare: Compares two names that don't end in a '\0'.
+ * -------------
+ */
+static int name_compare(const char *a, int alength, const char *b,
+        int blength)
+{
+    int ret = memcmp(a, b, alength < blength ? alength : blength);
+
+    if (ret)
+        return ret;
+
+    return alength - blength;
+}
+
+/* position_compare: Compares two places in the file.
+ * -----------------
+ */
+static int position_compare(int aline, int acol, int bline, int bcol)
+{
+    if (aline != bline)
+        return aline < bline ? -1 : 1;
+    if (acol != bcol)
+        return acol < bcol ? -1 : 1;
+
+    return 0;
+}
+
+static int entry_name_compare(const void *left, const void *right)
+{
+    const struct symbols_entry *a = left, *b = right;
+    int ret = name_compare(a->name.text, a->length, b->name.text, b->length);
+
+    return ret ? ret : position_compare(a->line, a->col, b->line, b->col);
+}
+
+static int entry_position_compare(const void *left, const void *right)
+{
+    const struct symbols_entry *a = left, *b = right;
+
+    return position_compare(a->line, a->col, b->line, b->col);
+}
+
+/* symbols_find: Finds a name in an index.
+ * -------------
+ *
+ * Return Value: The name, or NULL if it isn't in the index.
+ */
+static const struct symbols_name *symbols_find(const struct symbols *symbols,
+        const char *name)
+{
+    int low = 0, high, middle, ret, length;
+    const struct symbols_name *s;
+
+    if (!symbols || !name)
+        return NULL;
+
+    length = strlen(name);
+    high = symbols->count - 1;
+    while (low <= high) {
+        middle = low + (high - low) / 2;
+        s = &symbols->symbols[middle];
+
+        ret = name_compare(symbols->names + s->name, s->length, name, length);
+        if (ret == 0)
+            return s;
+        if (ret < 0)
+            low = middle + 1;
+        else
+            high = middle - 1;
+    }
+
+    return NULL;
+}
+
+/* occurs_find: Finds the first place of the file at or after a place.
+ * ------------
+ *
+ * Return Value: The index in occurs, occur_count if there's none.
+ */
+static int occurs_find(const struct symbols *symbols, int line, int col)
+{
+    int low = 0, high = symbols->occur_count, middle;
+    const struct symbols_occur *o;
+
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        o = &symbols->occurs[middle];
+
+        if (position_compare(o->line, o->col, line, col) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+/* symbols_position: Gets where a place of the index is.
+ * -----------------
+ */
+static void symbols_position(const struct symbols *symbols, int occur,
+        struct symbol_position *pos)
+{
+    const struct symbols_occur *o = &symbols->occurs[occur];
+
+    pos->line = o->line;
+    pos->col = o->col;
+    pos->length = symbols->symbols[o->symbol].length;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in symbols.h for function descriptions. */
+
+struct symbols_builder *symbols_builder_new(void)
+{
+    return cgdb_calloc(1, sizeof (struct symbols_builder));
+}
+
+void symbols_builder_free(struct symbols_builder *builder)
+{
+    if (builder) {
+        free(builder->text);
+        free(builder->entries);
+        free(builder);
+    }
+}
+
+void symbols_add(struct symbols_builder *builder, const char *name,
+        int length, int line, int col, int definition)
+{
+    struct symbols_entry *entry;
+
+    if (length <= 0)
+        return;
+
+    if (builder->text_length + length > builder->text_size) {
+        builder->text_size = builder->text_size ? builder->text_size * 2 :
+                4096;
+        if (builder->text_size < builder->text_length + length)
+            builder->text_size = builder->text_length + length;
+        builder->text = cgdb_realloc(builder->text, builder->text_size);
+    }
+
+    if (builder->count == builder->size) {
+        builder->size = builder->size ? builder->size * 2 : 256;
+        builder->entries = cgdb_realloc(builder->entries,
+                sizeof (struct symbols_entry) * builder->size);
+    }
+
+    entry = &builder->entries[builder->count++];
+    entry->name.offset = builder->text_length;
+    entry->length = length;
+    entry->line = line;
+    entry->col = col;
+    entry->definition = definition;
+
+    memcpy(builder->text + builder->text_length, name, length);
+    builder->text_length += length;
+}
+
+void symbols_copy(struct symbols_builder *builder,
+        const struct symbols *from, int start, int end, int delta)
+{
+    const struct symbols_occur *o;
+    const struct symbols_name *s;
+    int i;
+
+    if (!from)
+        return;
+
+    for (i = occurs_find(from, start, 0); i < from->occur_count; i++) {
+        o = &from->occurs[i];
+        if (o->line >= end)
+            break;
+
+        s = &from->symbols[o->symbol];
+        symbols_add(builder, from->names + s->name, s->length,
+                o->line + delta, o->col, o->definition);
+    }
+}
+
+struct symbols *symbols_finish(struct symbols_builder *builder)
+{
+    struct symbols *symbols = cgdb_calloc(1, sizeof (struct symbols));
+    struct symbols_entry *entries = builder->entries;
+    struct symbols_name *s = NULL;
+    int count = builder->count;
+    uint32_t *fill;
+    int i;
+
+    /* The text doesn't move anymore */
+    for (i = 0; i < count; i++)
+        entries[i].name.text = builder->text + entries[i].name.offset;
+
+    /* Each name is kept once, with a '\0' after it */
+    qsort(entries, count, sizeof (struct symbols_entry), entry_name_compare);
+
+    symbols->symbols = cgdb_malloc(sizeof (struct symbols_name) *
+            (count > 0 ? count : 1));
+    symbols->names = cgdb_malloc(builder->text_length + count + 1);
+
+    for (i = 0; i < count; i++) {
+        if (!s || name_compare(symbols->names + s->name, s->length,
+                        entries[i].name.text, entries[i].length) != 0) {
+            s = &symbols->symbols[symbols->count++];
+            s->name = symbols->names_length;
+            s->length = entries[i].length;
+            s->first = 0;
+            s->count = 0;
+            s->definition = -1;
+
+            memcpy(symbols->names + symbols->names_length,
+                    entries[i].name.text, entries[i].length);
+            symbols->names_length += entries[i].length;
+            symbols->names[symbols->names_length++] = '\0';
+        }
+
+        s->count++;
+        entries[i].symbol = s - symbols->symbols;
+    }
+
+    /* The places go in the order of the file, and each name's list of them
+     * is in the same order */
+    qsort(entries, count, sizeof (struct symbols_entry),
+            entry_position_compare);
+
+    symbols->occurs = cgdb_malloc(sizeof (struct symbols_occur) *
+            (count > 0 ? count : 1));
+    symbols->places = cgdb_malloc(sizeof (uint32_t) * (count > 0 ? count : 1));
+    symbols->occur_count = count;
+
+    for (i = 1; i < symbols->count; i++)
+        symbols->symbols[i].first = symbols->symbols[i - 1].first +
+                symbols->symbols[i - 1].count;
+
+    fill = cgdb_calloc(symbols->count > 0 ? symbols->count : 1,
+            sizeof (uint32_t));
+    for (i = 0; i < count; i++) {
+        s = &symbols->symbols[entries[i].symbol];
+
+        symbols->occurs[i].line = entries[i].line;
+        symbols->occurs[i].col = entries[i].col;
+        symbols->occurs[i].symbol = entries[i].symbol;
+        symbols->occurs[i].definition = entries[i].definition ? 1 : 0;
+
+        symbols->places[s->first + fill[entries[i].symbol]++] = i;
+        if (entries[i].definition && s->definition == -1)
+            s->definition = i;
+    }
+    free(fill);
+
+    symbols_builder_free(builder);
+
+    return symbols;
+}
+
+void symbols_free(struct symbols *symbols)
+{
+    if (symbols) {
+        free(symbols->names);
+        free(symbols->symbols);
+        free(symbols->occurs);
+        free(symbols->places);
+        free(symbols);
+    }
+}
+
+size_t symbols_size(const struct symbols *symbols)
+{
+    if (!symbols)
+        return 0;
+
+    return symbols->names_length +
+            symbols->count * sizeof (struct symbols_name) +
+            symbols->occur_count * (sizeof (struct symbols_occur) +
+            sizeof (uint32_t));
+}
+
+int symbols_definition(const struct symbols *symbols, const char *name,
+        struct symbol_position *pos)
+{
+    const struct symbols_name *s = symbols_find(symbols, name);
+
+    if (!s)
+        return -1;
+
+    if (s->definition != -1) {
+        symbols_position(symbols, s->definition, pos);
+        return 1;
+    }
+
+    symbols_position(symbols, symbols->places[s->first], pos);
+
+    return 0;
+}
+
+int symbols_next(const struct symbols *symbols, const char *name,
+        int line, int col, int direction, int wrap,
+        struct symbol_position *pos)
+{
+    const struct symbols_name *s = symbols_find(symbols, name);
+    const uint32_t *places;
+    const struct symbols_occur *o;
+    int low, high, middle;
+
+    if (!s)
+        return -1;
+
+    /* Find the first place after the one looked from */
+    places = symbols->places + s->first;
+    low = 0;
+    high = s->count;
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        o = &symbols->occurs[places[middle]];
+
+        if (position_compare(o->line, o->col, line, col) <= 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    if (!direction) {
+        /* The one before it, skipping the one looked from */
+        low--;
+        if (low >= 0) {
+            o = &symbols->occurs[places[low]];
+            if (o->line == line && o->col == col)
+                low--;
+        }
+    }
+
+    if (low < 0 || low >= (int) s->count) {
+        if (!wrap)
+            return -1;
+        low = direction ? 0 : (int) s->count - 1;
+    }
+
+    symbols_position(symbols, places[low], pos);
+
+    return 0;
+}
+
+int symbols_at(const struct symbols *symbols, int line, int col,
+        char *name, size_t size, struct symbol_position *pos)
+{
+    const struct symbols_occur *o;
+    const struct symbols_name *s;
+    int i, found = -1;
+
+    if (!symbols || size == 0)
+        return -1;
+
+    /* The last identifier starting at or before col, if it reaches it */
+    i = occurs_find(symbols, line, col + 1);
+    if (i > 0) {
+        o = &symbols->occurs[i - 1];
+        if (o->line == line &&
+                o->col + (int) symbols->symbols[o->symbol].length > col)
+            found = i - 1;
+    }
+
+    /* Or else the first one of the line */
+    if (found == -1) {
+        i = occurs_find(symbols, line, 0);
+        if (i < symbols->occur_count && symbols->occurs[i].line == line)
+            found = i;
+    }
+
+    if (found == -1)
+        return -1;
+
+    s = &symbols->symbols[symbols->occurs[found].symbol];
+    if (s->length + 1 > size)
+        return -1;
+
+    memcpy(name, symbols->names + s->name, s->length + 1);
+    symbols_position(symbols, found, pos);
+
+    return 0;
+}
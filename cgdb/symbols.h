@@ -0,0 +1,151 @@
+#ifndef _SYMBOLS_H_
+#define _SYMBOLS_H_
+
+/* symbols.h:
+ * ----------
+ *
+ * The symbol index of a source file: where each identifier is, and which
+ * of those places look like where it's defined. The highlighter builds it
+ * from the tokens it already gets, so the index costs no pass over the
+ * file of its own. Lookups are binary searches.
+ *
+ * What's a definition is a guess from the tokens around an identifier: a
+ * function name followed by '(' outside of braces, a struct, union, enum
+ * or class name followed by '{', a #define, and the name after keywords
+ * like func, type or procedure.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+/* --------------- */
+/* Data Structures */
+/* --------------- */
+
+/* The index of a file, see symbols_finish */
+struct symbols;
+
+/* An index being built, see symbols_builder_new */
+struct symbols_builder;
+
+/* Where an identifier is */
+struct symbol_position {
+    int line;                   /* The index of the line */
+    int col;                    /* The byte it starts at */
+    int length;                 /* Its length in bytes */
+};
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* symbols_builder_new: Starts building an index.
+ * --------------------
+ *
+ * Return Value: The builder, which symbols_finish frees.
+ */
+struct symbols_builder *symbols_builder_new(void);
+
+/* symbols_builder_free: Throws away an index that's being built.
+ * ---------------------
+ */
+void symbols_builder_free(struct symbols_builder *builder);
+
+/* symbols_add: Adds where an identifier is.
+ * ------------
+ *
+ *   builder:     The index being built
+ *   name:        The identifier, it needn't end in a '\0'
+ *   length:      Its length
+ *   line:        The index of the line it's on
+ *   col:         The byte of the line it starts at
+ *   definition:  1 if it looks like where it's defined, 0 otherwise
+ */
+void symbols_add(struct symbols_builder *builder, const char *name,
+        int length, int line, int col, int definition);
+
+/* symbols_copy: Adds the identifiers of some lines of another index.
+ * -------------
+ *
+ * This keeps the part of the index of a file that a reload didn't change.
+ *
+ *   builder:  The index being built
+ *   from:     The index to copy from, or NULL for none
+ *   start:    The first line of from to copy
+ *   end:      One past the last line of from to copy
+ *   delta:    Added to the lines copied
+ */
+void symbols_copy(struct symbols_builder *builder,
+        const struct symbols *from, int start, int end, int delta);
+
+/* symbols_finish: Gets the index that was built.
+ * ---------------
+ *
+ *   builder:  The index built, it's freed
+ *
+ * Return Value: The index, which must be freed with symbols_free.
+ */
+struct symbols *symbols_finish(struct symbols_builder *builder);
+
+/* symbols_free: Frees an index.
+ * -------------
+ */
+void symbols_free(struct symbols *symbols);
+
+/* symbols_size: Gets about how many bytes an index takes.
+ * -------------
+ */
+size_t symbols_size(const struct symbols *symbols);
+
+/* symbols_definition: Finds where an identifier is defined.
+ * -------------------
+ *
+ *   symbols:  The index
+ *   name:     The identifier
+ *   pos:      Set to the first place that looks like its definition, or
+ *             to where it first is if none do
+ *
+ * Return Value: 1 if it looks defined there, 0 if it's only where it first
+ *               is, -1 if the identifier isn't in the file.
+ */
+int symbols_definition(const struct symbols *symbols, const char *name,
+        struct symbol_position *pos);
+
+/* symbols_next: Finds the next place an identifier is.
+ * -------------
+ *
+ *   symbols:    The index
+ *   name:       The identifier
+ *   line, col:  Where to look from, that place isn't found
+ *   direction:  1 for the next one, 0 for the one before
+ *   wrap:       1 to go around the end (or the start) of the file
+ *   pos:        Set to where it is
+ *
+ * Return Value: 0 if it's found, -1 if not.
+ */
+int symbols_next(const struct symbols *symbols, const char *name,
+        int line, int col, int direction, int wrap,
+        struct symbol_position *pos);
+
+/* symbols_at: Finds the identifier at a place in the file.
+ * -----------
+ *
+ *   symbols:    The index
+ *   line, col:  The place, the first identifier of the line is found if
+ *               none is at col
+ *   name:       Set to the identifier
+ *   size:       The size of name, a longer identifier isn't found
+ *   pos:        Set to where it is
+ *
+ * Return Value: 0 if one is found, -1 if the line has none.
+ */
+int symbols_at(const struct symbols *symbols, int line, int col,
+        char *name, size_t size, struct symbol_position *pos);
+
+#endif /* _SYMBOLS_H_ */
@@ -0,0 +1,225 @@
+/* termout.c:
+ * ----------
+ *
+ * curses writes to the frame file with write(2), at the file's offset. A
+ * frame is read back from the start of the file, and the file is emptied
+ * for the next one, so it never grows past the biggest frame.
+ *
+ * curses can't get the terminal's settings from the file, it leaves the
+ * terminal alone. cgdb puts it in cbreak mode itself, what's left is the
+ * newline mapping curses turns off to move the cursor with a newline.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_CURSES_H
+#include <curses.h>
+#elif HAVE_NCURSES_CURSES_H
+#include <ncurses/curses.h>
+#endif /* HAVE_CURSES_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_SYS_IOCTL_H
+#include <sys/ioctl.h>
+#endif /* HAVE_SYS_IOCTL_H */
+
+#include "termout.h"
+#include "cgdbrc.h"
+#include "terminal.h"
+#include "io.h"
+#include "stats.h"
+#include "tracer.h"
+#include "sys_util.h"
+
+/* The synchronized update sequences, a frame is sent between them */
+#define TERMOUT_BEGIN "\033[?2026h"
+#define TERMOUT_END "\033[?2026l"
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+/* What curses draws to, NULL when it draws to the terminal */
+static FILE *termout_file;
+
+/* A frame, read back from the file, with room for the sequences */
+static char *termout_frame;
+static size_t termout_frame_size;
+
+/* 1 if the terminfo entry says the terminal knows mode 2026 */
+static int termout_sync_known;
+
+static struct stats_counter stats_frames =
+        STATS_COUNTER("terminal frames");
+static struct stats_counter stats_bytes =
+        STATS_COUNTER("terminal bytes");
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* termout_sync: Determines if the frames are sent as synchronized updates.
+ * -------------
+ */
+static int termout_sync(void)
+{
+    switch (cgdbrc_get(CGDBRC_SYNCUPDATE)->variant.int_val) {
+        case TERMOUT_SYNC_ON:
+            return 1;
+        case TERMOUT_SYNC_OFF:
+            return 0;
+        default:
+            return termout_sync_known;
+    }
+}
+
+/* termout_setenv: Sets an environment variable to a number.
+ * ---------------
+ *
+ * Return Value: Its value before, to put back with termout_putenv.
+ */
+static char *termout_setenv(const char *name, int value)
+{
+    const char *old = getenv(name);
+    char number[32];
+
+    snprintf(number, sizeof (number), "%d", value);
+    setenv(name, number, 1);
+
+    return old ? cgdb_strdup(old) : NULL;
+}
+
+/* termout_putenv: Puts back what termout_setenv changed.
+ * ---------------
+ */
+static void termout_putenv(const char *name, char *old)
+{
+    if (old)
+        setenv(name, old, 1);
+    else
+        unsetenv(name);
+
+    free(old);
+}
+
+/* -------------------------------------- */
+/* Functions                              */
+/* -------------------------------------- */
+
+int termout_start(void)
+{
+    struct winsize size;
+    char *lines, *columns;
+    const char *sync;
+    SCREEN *screen;
+
+    if (!isatty(STDOUT_FILENO) ||
+            ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == -1 ||
+            size.ws_row == 0 || size.ws_col == 0)
+        return -1;
+
+    if ((termout_file = tmpfile()) == NULL)
+        return -1;
+
+    /* curses takes the size from the environment, the file has none. The
+     * programs cgdb starts shouldn't get it. */
+    lines = termout_setenv("LINES", size.ws_row);
+    columns = termout_setenv("COLUMNS", size.ws_col);
+
+    screen = newterm(NULL, termout_file, stdin);
+
+    termout_putenv("LINES", lines);
+    termout_putenv("COLUMNS", columns);
+
+    if (!screen) {
+        fclose(termout_file);
+        termout_file = NULL;
+        return -1;
+    }
+
+    sync = tigetstr("Sync");
+    termout_sync_known = sync && sync != (char *) -1;
+
+    termout_resume();
+
+    return 0;
+}
+
+void termout_resume(void)
+{
+    if (termout_file)
+        tty_output_nl(STDOUT_FILENO);
+}
+
+long termout_send(void)
+{
+    static const int begin = sizeof (TERMOUT_BEGIN) - 1;
+    static const int end = sizeof (TERMOUT_END) - 1;
+    int sync = termout_sync();
+    char detail[32];
+    off_t length;
+    size_t size;
+    char *frame;
+
+    if (!termout_file)
+        return 0;
+
+    /* A curses that writes with stdio has some of it in the FILE */
+    fflush(termout_file);
+
+    length = lseek(fileno(termout_file), 0, SEEK_CUR);
+    if (length <= 0)
+        return length == 0 ? 0 : -1;
+
+    if (termout_frame_size < (size_t) length + begin + end) {
+        termout_frame_size = (size_t) length + begin + end;
+        termout_frame = cgdb_realloc(termout_frame, termout_frame_size);
+    }
+
+    /* The frame goes between the sequences, when they're sent */
+    frame = termout_frame + (sync ? begin : 0);
+    if (pread(fileno(termout_file), frame, length, 0) != length)
+        return -1;
+
+    /* Start over, so the file doesn't grow */
+    if (ftruncate(fileno(termout_file), 0) == -1 ||
+            lseek(fileno(termout_file), 0, SEEK_SET) == -1)
+        return -1;
+
+    size = length;
+    if (sync) {
+        memcpy(termout_frame, TERMOUT_BEGIN, begin);
+        memcpy(termout_frame + begin + length, TERMOUT_END, end);
+        size += begin + end;
+    }
+
+    if (io_writen(STDOUT_FILENO, termout_frame, size) != (ssize_t) size)
+        return -1;
+
+    STATS_ADD(&stats_frames, 1);
+    STATS_ADD(&stats_bytes, size);
+    if (tracer_enabled) {
+        snprintf(detail, sizeof (detail), "%lu bytes", (unsigned long) size);
+        tracer_instant("terminal frame", detail);
+    }
+
+    return size;
+}
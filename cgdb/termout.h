@@ -0,0 +1,62 @@
+#ifndef _TERMOUT_H_
+#define _TERMOUT_H_
+
+/* termout.h:
+ * ----------
+ *
+ * The output of curses, sent to the terminal a frame at a time. curses
+ * draws to a file instead of the terminal, the way render_bench has it
+ * draw, and what it drew since the last frame is sent with a single
+ * write. A frame that changes the source window, its status bar and the
+ * GDB window is otherwise written a window at a time, which tears on a
+ * fast terminal, and is a packet for each window over ssh.
+ *
+ * The terminals that know it are told when a frame starts and ends, with
+ * the synchronized update mode, DEC private mode 2026. They show the frame
+ * once it's all there. The syncupdate option says when it's used.
+ *
+ */
+
+/* The values of the syncupdate option */
+enum termout_sync {
+    TERMOUT_SYNC_AUTO = 0,      /* If the terminfo entry has Sync */
+    TERMOUT_SYNC_ON,            /* Always, terminals that don't know it
+                                 * leave it out */
+    TERMOUT_SYNC_OFF            /* Never */
+};
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* termout_start: Starts curses, drawing to the frame file.
+ * --------------
+ *
+ * The terminal is set up the way curses sets it up, it can't from the
+ * file. It's the size of standard output.
+ *
+ * Return Value: 0 on success, -1 if curses should be started on the
+ *               terminal instead, nothing was started then.
+ */
+int termout_start(void);
+
+/* termout_resume: Sets the terminal up again for curses.
+ * ---------------
+ *
+ * Called when cgdb gets the terminal back, after endwin, once it's in
+ * cbreak mode again. Nothing is done if curses draws to the terminal.
+ */
+void termout_resume(void);
+
+/* termout_send: Sends what curses drew since the last frame, at once.
+ * -------------
+ *
+ * It's counted in the "terminal frames" and "terminal bytes" statistics,
+ * and traced as a "terminal frame" with its size. Nothing is done if
+ * curses draws to the terminal, or drew nothing.
+ *
+ * Return Value: The bytes written to the terminal, or -1 on error.
+ */
+long termout_send(void);
+
+#endif /* _TERMOUT_H_ */
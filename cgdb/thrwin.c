@@ -0,0 +1,406 @@
+/* thrwin.c:
+ * ---------
+ *
+ * The threads are kept in order of their numbers, which is the order they
+ * started in, so a thread that starts mostly goes at the end and one that
+ * exits is found with a binary search. With thousands of threads, a change
+ * only touches the window if it's on one of the lines shown, and only the
+ * innermost frame of those threads is asked for, when they're stopped.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_CURSES_H
+#include <curses.h>
+#elif HAVE_NCURSES_CURSES_H
+#include <ncurses/curses.h>
+#endif /* HAVE_CURSES_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+/* Local Includes */
+#include "thrwin.h"
+#include "btwin.h"
+#include "cgdb.h"
+#include "tgdb_types.h"
+#include "sys_util.h"
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+/* The numbers of the threads, and 1 for each one that runs */
+static int *thrwin_threads;
+static unsigned char *thrwin_running;
+static int thrwin_count, thrwin_size;
+
+/* The thread gdb looks at, 0 if it's not known */
+static int thrwin_current;
+
+/* The first thread shown */
+static int thrwin_top;
+
+static WINDOW *thrwin_win;
+static char **thrwin_drawn;     /* The text on each line of thrwin_win */
+static int thrwin_height, thrwin_width;
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* thrwin_search: Finds where a thread is, or would go.
+ * --------------
+ *
+ *   thread:  The number of the thread
+ *
+ * Return Value: The index of the first thread whose number isn't less than
+ *               thread, thrwin_count if there's none.
+ */
+static int thrwin_search(int thread)
+{
+    int low = 0, high = thrwin_count, middle;
+
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (thrwin_threads[middle] < thread)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+/* thrwin_shown: Determines if a thread is on the window, or one after it
+ * -------------  would be, if it was added or removed.
+ *
+ *   i:  The index of the thread
+ */
+static int thrwin_shown(int i)
+{
+    return thrwin_win != NULL && i < thrwin_top + thrwin_height - 1;
+}
+
+/* thrwin_add: Adds a thread, if it's not listed.
+ * -----------
+ *
+ * Return Value: 1 if what's shown changed, 0 otherwise.
+ */
+static int thrwin_add(int thread)
+{
+    int i = thrwin_search(thread);
+
+    if (i < thrwin_count && thrwin_threads[i] == thread)
+        return 0;
+
+    if (thrwin_count == thrwin_size) {
+        thrwin_size = thrwin_size ? thrwin_size * 2 : 64;
+        thrwin_threads = cgdb_realloc(thrwin_threads,
+                sizeof (int) * thrwin_size);
+        thrwin_running = cgdb_realloc(thrwin_running, thrwin_size);
+    }
+    memmove(thrwin_threads + i + 1, thrwin_threads + i,
+            sizeof (int) * (thrwin_count - i));
+    memmove(thrwin_running + i + 1, thrwin_running + i, thrwin_count - i);
+    thrwin_threads[i] = thread;
+    thrwin_count++;
+
+    /* A thread is started by one that runs, gdb tells when it stops */
+    thrwin_running[i] = 1;
+
+    return thrwin_shown(i);
+}
+
+/* thrwin_remove: Removes a thread, if it's listed.
+ * --------------
+ *
+ * Return Value: 1 if what's shown changed, 0 otherwise.
+ */
+static int thrwin_remove(int thread)
+{
+    int i = thrwin_search(thread);
+
+    if (i == thrwin_count || thrwin_threads[i] != thread)
+        return 0;
+
+    memmove(thrwin_threads + i, thrwin_threads + i + 1,
+            sizeof (int) * (thrwin_count - i - 1));
+    memmove(thrwin_running + i, thrwin_running + i + 1,
+            thrwin_count - i - 1);
+    thrwin_count--;
+
+    if (thrwin_top > 0 && thrwin_top >= thrwin_count)
+        thrwin_top--;
+    if (thrwin_current == thread)
+        thrwin_current = 0;
+
+    return thrwin_shown(i);
+}
+
+/* thrwin_run: Marks a thread that runs or stopped.
+ * -----------
+ *
+ *   thread:   The number of the thread, or 0 for all of them
+ *   running:  1 if it runs, 0 if it stopped
+ *
+ * Return Value: 1 if what's shown changed, 0 otherwise.
+ */
+static int thrwin_run(int thread, int running)
+{
+    int i, changed = 0;
+
+    if (thread == 0) {
+        for (i = 0; i < thrwin_count; i++) {
+            if (thrwin_running[i] != running) {
+                thrwin_running[i] = running;
+                changed |= thrwin_shown(i);
+            }
+        }
+        return changed;
+    }
+
+    i = thrwin_search(thread);
+    if (i == thrwin_count || thrwin_threads[i] != thread ||
+            thrwin_running[i] == running)
+        return 0;
+
+    thrwin_running[i] = running;
+
+    return thrwin_shown(i);
+}
+
+/* thrwin_line: Gets the text of a line of the window.
+ * ------------
+ *
+ * The first line names the columns, each line after it is a thread, and
+ * where it is once the backtrace window has its innermost frame, or that
+ * it runs.
+ *
+ *   line:  The line, 0 is the first one
+ *   text:  Set to the text, it's cut to the width of the window
+ */
+static void thrwin_line(int line, char *text, size_t size)
+{
+    int i = thrwin_top + line - 1;
+    const struct tgdb_frame *frame;
+    int length;
+
+    if (size > (size_t) thrwin_width + 1)
+        size = thrwin_width + 1;
+    text[0] = '\0';
+
+    if (line == 0) {
+        snprintf(text, size, "  Id   Where");
+        return;
+    }
+
+    if (thrwin_count == 0) {
+        if (line == 1)
+            snprintf(text, size, "No threads");
+        return;
+    }
+
+    if (i >= thrwin_count)
+        return;
+
+    length = snprintf(text, size, "%c %-4d",
+            thrwin_threads[i] == thrwin_current ? '*' : ' ',
+            thrwin_threads[i]);
+
+    if (length < 0 || (size_t) length >= size)
+        return;
+
+    if (thrwin_running[i]) {
+        snprintf(text + length, size - length, " (running)");
+        return;
+    }
+
+    if (!(frame = btwin_peek(thrwin_threads[i])))
+        return;
+
+    length += snprintf(text + length, size - length, " 0x%lx in %s",
+            frame->address, frame->function ? frame->function : "??");
+
+    if (frame->relative_path && length >= 0 && (size_t) length < size)
+        snprintf(text + length, size - length, " at %s:%d",
+                frame->relative_path, frame->line_number);
+}
+
+/* thrwin_forget_drawn: Forgets what's on the lines of the window.
+ * --------------------
+ */
+static void thrwin_forget_drawn(void)
+{
+    int i;
+
+    for (i = 0; thrwin_drawn && i < thrwin_height; i++)
+        free(thrwin_drawn[i]);
+    free(thrwin_drawn);
+    thrwin_drawn = NULL;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in thrwin.h for function descriptions. */
+
+void thrwin_move(int top, int left, int height, int width)
+{
+    thrwin_close();
+
+    if ((thrwin_win = newwin(height, width, top, left)) == NULL)
+        return;
+
+    thrwin_height = height;
+    thrwin_width = width;
+    thrwin_drawn = cgdb_calloc(height, sizeof (char *));
+
+    thrwin_fetch();
+}
+
+void thrwin_display(void)
+{
+    char text[MAXLINE];
+    int line;
+
+    if (!thrwin_win)
+        return;
+
+    /* Only the lines that changed are drawn */
+    for (line = 0; line < thrwin_height; line++) {
+        thrwin_line(line, text, sizeof (text));
+
+        if (thrwin_drawn[line] && strcmp(thrwin_drawn[line], text) == 0)
+            continue;
+
+        wmove(thrwin_win, line, 0);
+        waddstr(thrwin_win, text);
+        wclrtoeol(thrwin_win);
+
+        free(thrwin_drawn[line]);
+        thrwin_drawn[line] = cgdb_strdup(text);
+    }
+
+    wnoutrefresh(thrwin_win);
+}
+
+void thrwin_close(void)
+{
+    thrwin_forget_drawn();
+
+    if (thrwin_win)
+        delwin(thrwin_win);
+    thrwin_win = NULL;
+    thrwin_height = thrwin_width = 0;
+}
+
+int thrwin_scroll(int pages)
+{
+    int rows = thrwin_height > 2 ? thrwin_height - 2 : 1;
+    int distance = (pages < 0 ? -pages : pages) * rows;
+
+    if (pages < 0) {
+        if (thrwin_top == 0)
+            return -1;
+        thrwin_top = thrwin_top > distance ? thrwin_top - distance : 0;
+    } else {
+        if (thrwin_top + distance >= thrwin_count)
+            return -1;
+        thrwin_top += distance;
+    }
+
+    thrwin_fetch();
+
+    return 0;
+}
+
+void thrwin_fetch(void)
+{
+    int i, end = thrwin_top + thrwin_height - 1;
+
+    if (!thrwin_win)
+        return;
+
+    /* An answer can come before btwin_prefetch returns, and change them */
+    for (i = thrwin_top; i < end && i < thrwin_count; i++)
+        if (!thrwin_running[i])
+            btwin_prefetch(thrwin_threads[i]);
+}
+
+void thrwin_fetch_all(void)
+{
+    int i;
+
+    /* gdb's one, when it didn't tell about any */
+    if (thrwin_count == 0) {
+        btwin_fetch_all(0);
+        return;
+    }
+
+    for (i = 0; i < thrwin_count; i++)
+        btwin_fetch_all(thrwin_threads[i]);
+}
+
+int thrwin_find(int thread)
+{
+    int i = thrwin_search(thread);
+
+    return i < thrwin_count && thrwin_threads[i] == thread;
+}
+
+int thrwin_select(int thread)
+{
+    int changed = thrwin_add(thread);
+    int old = thrwin_search(thrwin_current);
+
+    if (thread == thrwin_current)
+        return changed;
+
+    thrwin_current = thread;
+
+    return changed || thrwin_shown(old) || thrwin_shown(thrwin_search(thread));
+}
+
+int thrwin_change(const struct tgdb_thread_change *change)
+{
+    switch (change->event) {
+        case TGDB_THREAD_CREATED:
+            return thrwin_add(change->id);
+        case TGDB_THREAD_EXITED:
+            return thrwin_remove(change->id);
+        case TGDB_THREAD_SELECTED:
+            return thrwin_select(change->id);
+        case TGDB_THREAD_RUNNING:
+            return thrwin_run(change->id, 1);
+        case TGDB_THREAD_STOPPED:
+            return thrwin_run(change->id, 0);
+    }
+
+    return 0;
+}
+
+void thrwin_clear(void)
+{
+    free(thrwin_threads);
+    thrwin_threads = NULL;
+    free(thrwin_running);
+    thrwin_running = NULL;
+    thrwin_count = thrwin_size = 0;
+    thrwin_current = 0;
+    thrwin_top = 0;
+}
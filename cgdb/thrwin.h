@@ -0,0 +1,101 @@
+#ifndef _THRWIN_H_
+#define _THRWIN_H_
+
+/* thrwin.h:
+ * ---------
+ *
+ * The thread window. It lists the threads of the program, by number, with
+ * the one gdb looks at marked, and where each of them is, or that it runs.
+ * The threads are kept from what gdb tells when one starts, exits, runs or
+ * stops, gdb is never asked to list them. Where a thread is comes from the
+ * backtrace window, which is only asked for the stopped threads the window
+ * shows.
+ *
+ */
+
+struct tgdb_thread_change;
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* thrwin_move: Puts the thread window somewhere else on the screen.
+ * ------------
+ *
+ *   top, left:      The position of its upper left corner
+ *   height, width:  Its size
+ */
+void thrwin_move(int top, int left, int height, int width);
+
+/* thrwin_display: Draws the lines that changed since the last time.
+ * ---------------
+ *
+ * The terminal isn't refreshed, only the curses virtual screen.
+ */
+void thrwin_display(void);
+
+/* thrwin_close: Takes the thread window off the screen.
+ * -------------
+ *
+ * The threads are kept, they're shown again by thrwin_move.
+ */
+void thrwin_close(void);
+
+/* thrwin_scroll: Shows the threads a window further down or up.
+ * --------------
+ *
+ *   pages:  How many windows full, negative to go up
+ *
+ * Return Value: 0 on success, -1 if there's no thread that way.
+ */
+int thrwin_scroll(int pages);
+
+/* thrwin_fetch: Asks where the threads the window shows are.
+ * -------------
+ *
+ * Call it when gdb stopped, ready to answer. The answers are given to the
+ * backtrace window.
+ */
+void thrwin_fetch(void);
+
+/* thrwin_fetch_all: Asks for the whole stack of each thread.
+ * -----------------
+ *
+ * Even of the threads the window doesn't show. The answers are given to
+ * the backtrace window.
+ */
+void thrwin_fetch_all(void);
+
+/* thrwin_find: Determines if a thread is running.
+ * ------------
+ *
+ *   thread:  The number of the thread
+ *
+ * Return Value: 1 if gdb told it started and not that it exited, otherwise 0.
+ */
+int thrwin_find(int thread);
+
+/* thrwin_select: Marks the thread gdb looks at.
+ * --------------
+ *
+ *   thread:  The number of the thread, it's added if it's not listed
+ *
+ * Return Value: 1 if what's shown changed, 0 otherwise.
+ */
+int thrwin_select(int thread);
+
+/* thrwin_change: Adds, marks or removes a thread, or marks that it runs.
+ * --------------
+ *
+ *   change:  What happened to it
+ *
+ * Return Value: 1 if what's shown changed, 0 otherwise.
+ */
+int thrwin_change(const struct tgdb_thread_change *change);
+
+/* thrwin_clear: Forgets the threads, when the program exits.
+ * -------------
+ */
+void thrwin_clear(void);
+
+#endif /* _THRWIN_H_ */
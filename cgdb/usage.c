@@ -23,5 +23,31 @@ void usage(void)
             "   -h          Print help (this message) and then exit.\n"
 #endif
             "   -d          Set debugger to use.\n"
+#ifdef HAVE_GETOPT_H
+            "   --gdbmi     Talk to the debugger with GDB/MI (experimental).\n"
+#else
+            "   -m          Talk to the debugger with GDB/MI (experimental).\n"
+#endif
+#ifdef HAVE_GETOPT_H
+            "   --session   Keep the debugger running in a session server, at the\n"
+            "               socket given, and attach to it.\n"
+#else
+            "   -s          Keep the debugger running in a session server, at the\n"
+            "               socket given, and attach to it.\n"
+#endif
+#ifdef HAVE_GETOPT_H
+            "   --remote    Debug on another machine, through the command given,\n"
+            "               which runs cgdb --headless there.\n"
+            "   --headless  Run the debugger for a cgdb started with --remote.\n"
+#else
+            "   -r          Debug on another machine, through the command given,\n"
+            "               which runs cgdb -H there.\n"
+            "   -H          Run the debugger for a cgdb started with -r.\n"
+#endif
+#ifdef HAVE_GETOPT_H
+            "   --resume    Start where the last cgdb on the same program was.\n"
+#else
+            "   -R          Start where the last cgdb on the same program was.\n"
+#endif
             "   --          Marks the end of CGDB's options.\n");
 }
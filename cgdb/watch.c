@@ -0,0 +1,692 @@
+/* watch.c:
+ * --------
+ *
+ * The rows are kept in the order they're shown, the watched expressions
+ * first and the locals after them, with the children of an expanded row
+ * right after it. A row is found by the name gdb gave its variable object
+ * through a hash table, so what gdb says changed is found without looking
+ * through the others.
+ *
+ * gdb answers the requests in the order they were made, each one but a
+ * delete with a TGDB_UPDATE_VARIABLES. The requests waiting for an answer
+ * are kept in that order, with the row they're for.
+ *
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+/* System Includes */
+#if HAVE_CURSES_H
+#include <curses.h>
+#elif HAVE_NCURSES_CURSES_H
+#include <ncurses/curses.h>
+#endif /* HAVE_CURSES_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_CTYPE_H
+#include <ctype.h>
+#endif /* HAVE_CTYPE_H */
+
+/* Local Includes */
+#include "watch.h"
+#include "cgdb.h"
+#include "tgdb.h"
+#include "sys_util.h"
+#include "logger.h"
+#include "std_hash.h"
+
+extern struct tgdb *tgdb;
+
+/* ----------- */
+/* Definitions */
+/* ----------- */
+
+/* A row of the watch window */
+struct watch_item {
+    char *expression;           /* What the user typed, or the member name */
+    char *name;                 /* gdb's name for it, NULL until created */
+    char *value;                /* Its value, NULL if gdb didn't say */
+    char *error;                /* Why gdb couldn't create it, or NULL */
+    int children;               /* How many children it has */
+    int in_scope;               /* 0 if it can't be evaluated where gdb is */
+    int expanded;               /* 1 if its children are shown */
+    int local;                  /* 1 for a local, or a child of one */
+    int depth;                  /* 0 for a row that isn't a child */
+};
+
+/* A request waiting for gdb's answer */
+struct watch_pending {
+    enum tgdb_variable_command command;
+    struct watch_item *item;    /* The row, NULL if it's gone since */
+};
+
+/* --------------- */
+/* Local Variables */
+/* --------------- */
+
+static struct watch_item **watch_rows;
+static int watch_count, watch_size;
+
+/* The rows that have a variable object, by its name */
+static struct std_hashtable *watch_names;
+
+static struct watch_pending *watch_pending;
+static int watch_pending_head, watch_pending_count, watch_pending_size;
+
+/* The function the locals are of, NULL before they're listed */
+static char *watch_function;
+
+static WINDOW *watch_win;
+static char **watch_drawn;      /* The text on each line of watch_win */
+static int watch_height, watch_width;
+
+/* --------------- */
+/* Local Functions */
+/* --------------- */
+
+/* watch_request: Asks gdb for a variable command.
+ * --------------
+ *
+ *   command:  What to do
+ *   name:     The expression or variable object it's done to, or NULL
+ *   item:     The row the answer is for, or NULL
+ */
+static void watch_request(enum tgdb_variable_command command,
+        const char *name, struct watch_item *item)
+{
+    struct tgdb_request *request = tgdb_request_variable(tgdb, command, name);
+
+    if (!request)
+        return;
+
+    /* The answer can come before handle_request returns */
+    if (command != TGDB_VARIABLE_DELETE &&
+            command != TGDB_VARIABLE_DELETE_CHILDREN) {
+        if (watch_pending_count == watch_pending_size) {
+            watch_pending_size =
+                    watch_pending_size ? watch_pending_size * 2 : 16;
+            watch_pending = cgdb_realloc(watch_pending,
+                    sizeof (struct watch_pending) * watch_pending_size);
+        }
+        watch_pending[watch_pending_count].command = command;
+        watch_pending[watch_pending_count].item = item;
+        watch_pending_count++;
+    }
+
+    handle_request(tgdb, request);
+}
+
+/* item_new: Creates a row, gdb is asked for its variable object.
+ * ---------
+ *
+ *   expression:  What to evaluate
+ *   local:       1 for a local, 0 for a watched expression
+ */
+static struct watch_item *item_new(const char *expression, int local)
+{
+    struct watch_item *item = cgdb_calloc(1, sizeof (struct watch_item));
+
+    item->expression = cgdb_strdup(expression);
+    item->in_scope = 1;
+    item->local = local;
+
+    return item;
+}
+
+/* item_set_name: Sets gdb's name for a row's variable object.
+ * --------------
+ */
+static void item_set_name(struct watch_item *item, const char *name)
+{
+    if (item->name)
+        std_hash_table_remove(watch_names, item->name);
+    free(item->name);
+
+    item->name = name ? cgdb_strdup(name) : NULL;
+    if (item->name)
+        std_hash_table_insert(watch_names, item->name, item);
+}
+
+/* item_free: Frees a row, the requests for it are answered for nothing.
+ * ----------
+ */
+static void item_free(struct watch_item *item)
+{
+    int i;
+
+    for (i = watch_pending_head; i < watch_pending_count; i++)
+        if (watch_pending[i].item == item)
+            watch_pending[i].item = NULL;
+
+    item_set_name(item, NULL);
+    free(item->expression);
+    free(item->value);
+    free(item->error);
+    free(item);
+}
+
+/* item_string: Replaces a string of a row.
+ * ------------
+ */
+static void item_string(char **field, const char *value)
+{
+    free(*field);
+    *field = value ? cgdb_strdup(value) : NULL;
+}
+
+/* rows_insert: Puts rows in the window.
+ * ------------
+ *
+ *   index:  Where the first one goes
+ *   items:  The rows
+ *   count:  How many there are
+ */
+static void rows_insert(int index, struct watch_item **items, int count)
+{
+    if (watch_count + count > watch_size) {
+        watch_size = watch_size * 2 > watch_count + count ?
+                watch_size * 2 : watch_count + count + 16;
+        watch_rows = cgdb_realloc(watch_rows,
+                sizeof (struct watch_item *) * watch_size);
+    }
+
+    memmove(&watch_rows[index + count], &watch_rows[index],
+            sizeof (struct watch_item *) * (watch_count - index));
+    memcpy(&watch_rows[index], items, sizeof (struct watch_item *) * count);
+    watch_count += count;
+}
+
+/* rows_remove: Takes rows out of the window, and frees them.
+ * ------------
+ *
+ *   index:  The first one
+ *   count:  How many there are
+ */
+static void rows_remove(int index, int count)
+{
+    int i;
+
+    for (i = index; i < index + count; i++)
+        item_free(watch_rows[i]);
+
+    memmove(&watch_rows[index], &watch_rows[index + count],
+            sizeof (struct watch_item *) * (watch_count - index - count));
+    watch_count -= count;
+}
+
+/* row_find: Finds the row of an item.
+ * ---------
+ *
+ * Return Value: Its index, or -1 if it's not in the window.
+ */
+static int row_find(struct watch_item *item)
+{
+    int i;
+
+    for (i = 0; i < watch_count; i++)
+        if (watch_rows[i] == item)
+            return i;
+
+    return -1;
+}
+
+/* row_descendants: Counts the rows of the children of a row.
+ * ----------------
+ *
+ * They're the ones right after it that are deeper.
+ */
+static int row_descendants(int index)
+{
+    int depth = watch_rows[index]->depth, i;
+
+    for (i = index + 1; i < watch_count && watch_rows[i]->depth > depth; i++);
+
+    return i - index - 1;
+}
+
+/* row_locals: Finds the first row of the locals.
+ * -----------
+ *
+ * Return Value: Its index, watch_count if there are none.
+ */
+static int row_locals(void)
+{
+    int i;
+
+    for (i = 0; i < watch_count && !watch_rows[i]->local; i++);
+
+    return i;
+}
+
+/* row_collapse: Hides the children of a row.
+ * -------------
+ *
+ *   forget:  1 if gdb deleted them already, 0 to ask it to
+ */
+static void row_collapse(int index, int forget)
+{
+    struct watch_item *item = watch_rows[index];
+
+    rows_remove(index + 1, row_descendants(index));
+    if (item->expanded && item->name && !forget)
+        watch_request(TGDB_VARIABLE_DELETE_CHILDREN, item->name, NULL);
+    item->expanded = 0;
+}
+
+/* row_delete: Takes a row and its children out of the window.
+ * -----------
+ *
+ * Its variable object is deleted, with the ones of its children.
+ */
+static void row_delete(int index)
+{
+    struct watch_item *item = watch_rows[index];
+
+    if (item->name)
+        watch_request(TGDB_VARIABLE_DELETE, item->name, NULL);
+
+    rows_remove(index, row_descendants(index) + 1);
+}
+
+/* watch_created: Takes a variable object gdb created.
+ * --------------
+ */
+static void watch_created(const struct tgdb_variables *variables,
+        struct watch_item *item)
+{
+    const struct tgdb_variable *variable = &variables->variables[0];
+
+    /* The row went away while gdb was creating it */
+    if (!item) {
+        if (variables->count > 0 && variable->name)
+            watch_request(TGDB_VARIABLE_DELETE, variable->name, NULL);
+        return;
+    }
+
+    if (variables->error || variables->count == 0) {
+        item_string(&item->error,
+                variables->error ? variables->error : "error");
+        return;
+    }
+
+    item_set_name(item, variable->name);
+    item_string(&item->value, variable->value);
+    item->children = variable->children > 0 ? variable->children : 0;
+    item->in_scope = 1;
+}
+
+/* watch_children: Shows the children gdb listed of a row.
+ * ---------------
+ */
+static void watch_children(const struct tgdb_variables *variables,
+        struct watch_item *item)
+{
+    struct watch_item **children;
+    int index, i;
+
+    /* It was collapsed, or went away, while gdb was listing them */
+    if (!item || !item->expanded || (index = row_find(item)) == -1)
+        return;
+
+    if (variables->error) {
+        item->expanded = 0;
+        item_string(&item->error, variables->error);
+        return;
+    }
+
+    /* It was expanded again before the answer came */
+    rows_remove(index + 1, row_descendants(index));
+
+    children = cgdb_malloc(sizeof (struct watch_item *) *
+            (variables->count + 1));
+    for (i = 0; i < variables->count; i++) {
+        const struct tgdb_variable *variable = &variables->variables[i];
+
+        children[i] = item_new(variable->expression ? variable->expression :
+                variable->name, item->local);
+        children[i]->depth = item->depth + 1;
+        children[i]->children = variable->children > 0 ?
+                variable->children : 0;
+        item_string(&children[i]->value, variable->value);
+        item_set_name(children[i], variable->name);
+    }
+
+    rows_insert(index + 1, children, variables->count);
+    free(children);
+}
+
+/* watch_changed: Takes the variable objects gdb says changed.
+ * --------------
+ */
+static void watch_changed(const struct tgdb_variables *variables)
+{
+    int i, index;
+
+    for (i = 0; i < variables->count; i++) {
+        const struct tgdb_variable *variable = &variables->variables[i];
+        struct watch_item *item;
+
+        if (!variable->name ||
+                !(item = std_hash_table_lookup(watch_names, variable->name)))
+            continue;
+
+        if (variable->value)
+            item_string(&item->value, variable->value);
+        item->in_scope = variable->in_scope;
+
+        /* gdb deleted the children along with the old type */
+        if (variable->type_changed) {
+            if ((index = row_find(item)) != -1)
+                row_collapse(index, 1);
+            if (variable->children >= 0)
+                item->children = variable->children;
+        }
+    }
+}
+
+/* watch_locals: Adds a row for each local gdb listed.
+ * -------------
+ */
+static void watch_locals(const struct tgdb_variables *variables)
+{
+    struct watch_item **locals;
+    int i;
+
+    /* gdb went on to another function before they were listed */
+    for (i = watch_pending_head; i < watch_pending_count; i++)
+        if (watch_pending[i].command == TGDB_VARIABLE_LOCALS)
+            return;
+
+    /* A row says why there are none */
+    if (variables->error) {
+        locals = cgdb_malloc(sizeof (struct watch_item *));
+        locals[0] = item_new("locals", 1);
+        item_string(&locals[0]->error, variables->error);
+        rows_insert(watch_count, locals, 1);
+        free(locals);
+        return;
+    }
+
+    locals = cgdb_malloc(sizeof (struct watch_item *) *
+            (variables->count + 1));
+    for (i = 0; i < variables->count; i++)
+        locals[i] = item_new(variables->variables[i].expression ?
+                variables->variables[i].expression : "", 1);
+    rows_insert(watch_count, locals, variables->count);
+
+    for (i = 0; i < variables->count; i++)
+        watch_request(TGDB_VARIABLE_CREATE, locals[i]->expression, locals[i]);
+    free(locals);
+}
+
+/* watch_delete_locals: Takes the locals out of the window.
+ * --------------------
+ */
+static void watch_delete_locals(void)
+{
+    int i;
+
+    for (i = watch_count - 1; i >= 0; i--)
+        if (watch_rows[i]->local && watch_rows[i]->depth == 0)
+            row_delete(i);
+}
+
+/* watch_line: Gets the text of a line of the window.
+ * -----------
+ *
+ *   line:  The line, 0 is the first one
+ *   text:  Set to the text, it's cut to the width of the window
+ */
+static void watch_line(int line, char *text, size_t size)
+{
+    struct watch_item *item;
+    const char *value;
+    int locals = row_locals(), row = line;
+
+    if (size > (size_t) watch_width + 1)
+        size = watch_width + 1;
+
+    /* The locals are under a line of their own */
+    if (locals < watch_count && line >= locals) {
+        if (line == locals) {
+            snprintf(text, size, "-- locals %s",
+                    watch_function ? watch_function : "");
+            return;
+        }
+        row--;
+    }
+
+    if (row >= watch_count) {
+        text[0] = '\0';
+        return;
+    }
+
+    item = watch_rows[row];
+    if (item->error)
+        value = item->error;
+    else if (!item->name)
+        value = "...";
+    else if (!item->in_scope)
+        value = "<out of scope>";
+    else
+        value = item->value ? item->value : "";
+
+    snprintf(text, size, "%2d %c %*s%s = %s", row + 1,
+            item->expanded ? '-' : item->children > 0 ? '+' : ' ',
+            item->depth * 2, "", item->expression, value);
+}
+
+/* watch_forget_drawn: Forgets what's on the lines of the window.
+ * -------------------
+ */
+static void watch_forget_drawn(void)
+{
+    int i;
+
+    for (i = 0; watch_drawn && i < watch_height; i++)
+        free(watch_drawn[i]);
+    free(watch_drawn);
+    watch_drawn = NULL;
+}
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* See comments in watch.h for function descriptions. */
+
+void watch_move(int top, int left, int height, int width)
+{
+    watch_close();
+
+    if ((watch_win = newwin(height, width, top, left)) == NULL)
+        return;
+
+    watch_height = height;
+    watch_width = width;
+    watch_drawn = cgdb_calloc(height, sizeof (char *));
+}
+
+void watch_display(void)
+{
+    char text[MAXLINE];
+    int line;
+
+    if (!watch_win)
+        return;
+
+    /* Only the lines that changed are drawn */
+    for (line = 0; line < watch_height; line++) {
+        watch_line(line, text, sizeof (text));
+        if (watch_drawn[line] && strcmp(watch_drawn[line], text) == 0)
+            continue;
+
+        mvwaddstr(watch_win, line, 0, text);
+        wclrtoeol(watch_win);
+
+        free(watch_drawn[line]);
+        watch_drawn[line] = cgdb_strdup(text);
+    }
+
+    wnoutrefresh(watch_win);
+}
+
+void watch_close(void)
+{
+    watch_forget_drawn();
+
+    if (watch_win)
+        delwin(watch_win);
+    watch_win = NULL;
+    watch_height = watch_width = 0;
+}
+
+int watch_add(const char *expression)
+{
+    struct watch_item *item;
+    int index = row_locals();
+
+    while (isspace((unsigned char) *expression))
+        expression++;
+    if (*expression == '\0')
+        return -1;
+
+    if (!watch_names)
+        watch_names = std_hash_table_new(std_str_hash, std_str_equal);
+
+    item = item_new(expression, 0);
+    rows_insert(index, &item, 1);
+    watch_request(TGDB_VARIABLE_CREATE, item->expression, item);
+
+    return 0;
+}
+
+int watch_remove(const char *what)
+{
+    char *end;
+    long row = strtol(what, &end, 10);
+    int i;
+
+    while (isspace((unsigned char) *end))
+        end++;
+
+    for (i = 0; i < watch_count; i++) {
+        struct watch_item *item = watch_rows[i];
+
+        if (item->local || item->depth != 0)
+            continue;
+
+        if ((end != what && *end == '\0') ? i + 1 == row :
+                strcmp(item->expression, what) == 0) {
+            row_delete(i);
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+int watch_expand(int row)
+{
+    struct watch_item *item;
+
+    if (row < 1 || row > watch_count)
+        return -1;
+
+    item = watch_rows[row - 1];
+    if (item->expanded) {
+        row_collapse(row - 1, 0);
+        return 0;
+    }
+
+    if (!item->name || item->children == 0)
+        return -1;
+
+    item->expanded = 1;
+    watch_request(TGDB_VARIABLE_CHILDREN, item->name, item);
+
+    return 0;
+}
+
+void watch_stopped(const char *function)
+{
+    if (!watch_names)
+        watch_names = std_hash_table_new(std_str_hash, std_str_equal);
+
+    if (!function)
+        function = "";
+
+    /* The locals of another function */
+    if (!watch_function || strcmp(watch_function, function) != 0) {
+        watch_delete_locals();
+        free(watch_function);
+        watch_function = cgdb_strdup(function);
+        watch_request(TGDB_VARIABLE_LOCALS, NULL, NULL);
+    }
+
+    if (std_hash_table_size(watch_names) > 0)
+        watch_request(TGDB_VARIABLE_UPDATE, NULL, NULL);
+}
+
+int watch_variables(const struct tgdb_variables *variables)
+{
+    struct watch_pending pending;
+
+    if (watch_pending_head == watch_pending_count) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "variable answer without a request");
+        return 0;
+    }
+
+    pending = watch_pending[watch_pending_head++];
+    if (watch_pending_head == watch_pending_count)
+        watch_pending_head = watch_pending_count = 0;
+
+    if (pending.command != variables->command) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "variable answer out of order");
+        return 0;
+    }
+
+    switch (variables->command) {
+        case TGDB_VARIABLE_CREATE:
+            watch_created(variables, pending.item);
+            break;
+        case TGDB_VARIABLE_UPDATE:
+            if (variables->count == 0)
+                return 0;
+            watch_changed(variables);
+            break;
+        case TGDB_VARIABLE_CHILDREN:
+            watch_children(variables, pending.item);
+            break;
+        case TGDB_VARIABLE_LOCALS:
+            watch_locals(variables);
+            break;
+        default:
+            return 0;
+    }
+
+    return 1;
+}
+
+void watch_clear(void)
+{
+    watch_delete_locals();
+
+    free(watch_function);
+    watch_function = NULL;
+}
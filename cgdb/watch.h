@@ -0,0 +1,100 @@
+#ifndef _WATCH_H_
+#define _WATCH_H_
+
+/* watch.h:
+ * --------
+ *
+ * The watch window. It shows the expressions the user watches, and under
+ * them the arguments and locals of the function gdb is in, each with its
+ * value. Each one is a variable object of gdb, so at a stop gdb only lists
+ * the ones that changed, and only their rows are drawn again. The members
+ * of a struct or the elements of an array are shown once it's expanded,
+ * gdb isn't asked for them before.
+ *
+ * Every row has a number, the first one is 1. It's how the commands the
+ * user types pick a row.
+ *
+ */
+
+struct tgdb_variables;
+
+/* --------- */
+/* Functions */
+/* --------- */
+
+/* watch_move: Puts the watch window somewhere else on the screen.
+ * -----------
+ *
+ *   top, left:      The position of its upper left corner
+ *   height, width:  Its size
+ */
+void watch_move(int top, int left, int height, int width);
+
+/* watch_display: Draws the rows that changed since the last time.
+ * --------------
+ *
+ * The terminal isn't refreshed, only the curses virtual screen.
+ */
+void watch_display(void);
+
+/* watch_close: Takes the watch window off the screen.
+ * ------------
+ *
+ * What's watched is kept, it's shown again by watch_move.
+ */
+void watch_close(void);
+
+/* watch_add: Watches an expression.
+ * ----------
+ *
+ *   expression:  The expression, it's evaluated wherever gdb stops
+ *
+ * Return Value: 0 on success, -1 if the expression is empty.
+ */
+int watch_add(const char *expression);
+
+/* watch_remove: Stops watching an expression.
+ * -------------
+ *
+ *   what:  The number of its row, or the expression
+ *
+ * Return Value: 0 on success, -1 if nothing watched matches.
+ */
+int watch_remove(const char *what);
+
+/* watch_expand: Expands a row to show its children, or collapses it.
+ * -------------
+ *
+ *   row:  The number of the row
+ *
+ * Return Value: 0 on success, -1 if there's no such row or it has no
+ *               children.
+ */
+int watch_expand(int row);
+
+/* watch_stopped: Asks gdb what changed, after it stopped.
+ * --------------
+ *
+ * The locals are listed again when the function is another one.
+ *
+ *   function:  The function gdb stopped in, NULL if gdb didn't say
+ */
+void watch_stopped(const char *function);
+
+/* watch_variables: Takes the answer to a request for variable objects.
+ * ----------------
+ *
+ *   variables:  What gdb gave
+ *
+ * Return Value: 1 if a row changed, 0 otherwise.
+ */
+int watch_variables(const struct tgdb_variables *variables);
+
+/* watch_clear: Forgets the locals, when the program exits.
+ * ------------
+ *
+ * The watched expressions are kept, for the next time it runs.
+ */
+void watch_clear(void);
+
+#endif /* _WATCH_H_ */
@@ -0,0 +1,516 @@
+/*
+ * adt_bench: Benchmarks of the data structures of lib/adt, on the kind of
+ * work cgdb gives them.
+ *
+ * Usage: adt_bench [ibuf|hash|list] ...
+ *
+ * Without arguments all of them are run. Each writes a line of JSON per
+ * benchmark, see lib/util/bench.h.
+ *
+ *  ibuf - Appending lines of 64 bytes to an ibuf until it holds 1 byte to
+ *         10 MB, as the MI and console output is gathered. It's measured
+ *         with the geometric growth ibuf has, with room made up front by
+ *         ibuf_reserve, and with the 4096 byte blocks ibuf used to grow by.
+ *  hash - Looking up each of 10 to 100000 keys that look like the paths
+ *         of source files, in a std_hash, a std_ohash and a std_bbtree.
+ *         Inserting them all is measured too.
+ *  list - Building a list of 100000 nodes and clearing it again, as tgdb
+ *         does with its responses on each batch. The pooled std_list and
+ *         tgdb_list are measured against a list that mallocs each node.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#include "ibuf.h"
+#include "std_hash.h"
+#include "std_ohash.h"
+#include "std_bbtree.h"
+#include "std_list.h"
+#include "tgdb_list.h"
+#include "sys_util.h"
+#include "bench.h"
+
+#define BENCH_SUITE "adt"
+
+/* What each append adds, about a line of output */
+#define BENCH_LINE 64
+
+/* The nodes a list is built up to */
+#define BENCH_NODES 100000
+
+/* How big the block of the old ibuf was */
+#define BLOCK_SIZE 4096
+
+/* The repetitions of a benchmark that does this much work, so the small
+ * ones are repeated enough to time and the big ones don't take forever */
+static int repetitions(unsigned long work)
+{
+    unsigned long count = (64ul * 1024 * 1024) / (work ? work : 1);
+
+    if (count < 5)
+        return 5;
+    if (count > 1000)
+        return 1000;
+
+    return count;
+}
+
+/*
+ * ibuf
+ */
+
+/* The string ibuf was before it grew geometrically, it grew a block at a
+ * time. Kept here to measure ibuf against. */
+struct block_buf {
+    char *buf;
+    unsigned long length;
+    unsigned long blocks;
+};
+
+static void block_buf_addn(struct block_buf *s, const char *d, unsigned long n)
+{
+    if (s->length + n + 1 > s->blocks * BLOCK_SIZE) {
+        s->blocks = (s->length + n + 1 + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        s->buf = (char *) cgdb_realloc(s->buf, s->blocks * BLOCK_SIZE);
+    }
+
+    memcpy(s->buf + s->length, d, n);
+    s->length += n;
+    s->buf[s->length] = '\0';
+}
+
+/* A string appended to until it's size bytes long */
+struct bench_ibuf {
+    const char *line;
+    unsigned long size;
+};
+
+static int bench_ibuf_geometric(void *context)
+{
+    struct bench_ibuf *b = (struct bench_ibuf *) context;
+    struct ibuf *s = ibuf_init();
+    unsigned long length, n;
+
+    for (length = 0; length < b->size; length += n) {
+        n = b->size - length < BENCH_LINE ? b->size - length : BENCH_LINE;
+        ibuf_addn(s, b->line, n);
+    }
+
+    ibuf_free(s);
+
+    return 0;
+}
+
+static int bench_ibuf_reserve(void *context)
+{
+    struct bench_ibuf *b = (struct bench_ibuf *) context;
+    struct ibuf *s = ibuf_init();
+    unsigned long length, n;
+
+    ibuf_reserve(s, b->size);
+    for (length = 0; length < b->size; length += n) {
+        n = b->size - length < BENCH_LINE ? b->size - length : BENCH_LINE;
+        ibuf_addn(s, b->line, n);
+    }
+
+    ibuf_free(s);
+
+    return 0;
+}
+
+static int bench_ibuf_block(void *context)
+{
+    struct bench_ibuf *b = (struct bench_ibuf *) context;
+    struct block_buf s;
+    unsigned long length, n;
+
+    s.blocks = 1;
+    s.length = 0;
+    s.buf = (char *) cgdb_malloc(BLOCK_SIZE);
+    s.buf[0] = '\0';
+
+    for (length = 0; length < b->size; length += n) {
+        n = b->size - length < BENCH_LINE ? b->size - length : BENCH_LINE;
+        block_buf_addn(&s, b->line, n);
+    }
+
+    free(s.buf);
+
+    return 0;
+}
+
+static int bench_ibufs(void)
+{
+    static const unsigned long sizes[] = {
+        1, 64, 4096, 65536, 1024 * 1024, 10 * 1024 * 1024
+    };
+    static const struct {
+        const char *name;
+        int (*run) (void *context);
+    } kinds[] = {
+        { "ibuf", bench_ibuf_geometric },
+        { "ibuf reserve", bench_ibuf_reserve },
+        { "block", bench_ibuf_block }
+    };
+    char line[BENCH_LINE];
+    struct bench_ibuf b;
+    struct bench bench;
+    int i, j;
+
+    memset(line, 'x', sizeof (line));
+    line[BENCH_LINE - 1] = '\n';
+    b.line = line;
+
+    for (i = 0; i < sizeof (sizes) / sizeof (sizes[0]); i++) {
+        for (j = 0; j < sizeof (kinds) / sizeof (kinds[0]); j++) {
+            b.size = sizes[i];
+
+            bench_init(&bench, BENCH_SUITE, repetitions(b.size),
+                    "%s append %lu", kinds[j].name, b.size);
+            bench.items = b.size;
+            bench.unit = "bytes";
+
+            if (bench_run(&bench, kinds[j].run, &b) == -1)
+                return -1;
+            bench_print(&bench, NULL);
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * hash
+ */
+
+/* Keys that are all in one of the tables */
+struct bench_hash {
+    char **keys;
+    int count;
+    struct std_hashtable *hash;
+    struct std_ohashtable *ohash;
+    struct std_bbtree *tree;
+};
+
+static int bench_strcmp(const void *a, const void *b)
+{
+    return strcmp((const char *) a, (const char *) b);
+}
+
+/* Makes count paths, spread over directories like a source tree */
+static char **bench_paths(int count)
+{
+    char **keys = (char **) cgdb_malloc(sizeof (char *) * count);
+    char path[128];
+    int i;
+
+    for (i = 0; i < count; i++) {
+        snprintf(path, sizeof (path),
+                "/home/user/src/project/lib/module%03d/sub%02d/file%06d.c",
+                i % 97, i % 13, i);
+        keys[i] = cgdb_strdup(path);
+    }
+
+    return keys;
+}
+
+static int bench_hash_insert(void *context)
+{
+    struct bench_hash *b = (struct bench_hash *) context;
+    struct std_hashtable *hash = std_hash_table_new(std_str_hash,
+            std_str_equal);
+    int i;
+
+    for (i = 0; i < b->count; i++)
+        std_hash_table_insert(hash, b->keys[i], b->keys[i]);
+    std_hash_table_destroy(hash);
+
+    return 0;
+}
+
+static int bench_ohash_insert(void *context)
+{
+    struct bench_hash *b = (struct bench_hash *) context;
+    struct std_ohashtable *ohash = std_ohash_table_new(std_str_hash,
+            std_str_equal);
+    int i;
+
+    for (i = 0; i < b->count; i++)
+        std_ohash_table_insert(ohash, b->keys[i], b->keys[i]);
+    std_ohash_table_destroy(ohash);
+
+    return 0;
+}
+
+static int bench_bbtree_insert(void *context)
+{
+    struct bench_hash *b = (struct bench_hash *) context;
+    struct std_bbtree *tree = std_bbtree_new(bench_strcmp);
+    int i;
+
+    for (i = 0; i < b->count; i++)
+        std_bbtree_insert(tree, b->keys[i], b->keys[i]);
+    std_bbtree_destroy(tree);
+
+    return 0;
+}
+
+static int bench_hash_lookup(void *context)
+{
+    struct bench_hash *b = (struct bench_hash *) context;
+    int i;
+
+    for (i = 0; i < b->count; i++)
+        if (std_hash_table_lookup(b->hash, b->keys[i]) != b->keys[i])
+            return -1;
+
+    return 0;
+}
+
+static int bench_ohash_lookup(void *context)
+{
+    struct bench_hash *b = (struct bench_hash *) context;
+    int i;
+
+    for (i = 0; i < b->count; i++)
+        if (std_ohash_table_lookup(b->ohash, b->keys[i]) != b->keys[i])
+            return -1;
+
+    return 0;
+}
+
+static int bench_bbtree_lookup(void *context)
+{
+    struct bench_hash *b = (struct bench_hash *) context;
+    int i;
+
+    for (i = 0; i < b->count; i++)
+        if (std_bbtree_lookup(b->tree, b->keys[i]) != b->keys[i])
+            return -1;
+
+    return 0;
+}
+
+static int bench_hashes(void)
+{
+    static const int counts[] = { 10, 100, 1000, 10000, 100000 };
+    static const struct {
+        const char *name;
+        int (*insert) (void *context);
+        int (*lookup) (void *context);
+    } kinds[] = {
+        { "std_hash", bench_hash_insert, bench_hash_lookup },
+        { "std_ohash", bench_ohash_insert, bench_ohash_lookup },
+        { "std_bbtree", bench_bbtree_insert, bench_bbtree_lookup }
+    };
+    struct bench_hash b;
+    struct bench bench;
+    int i, j, k, result = 0;
+
+    for (i = 0; i < sizeof (counts) / sizeof (counts[0]) && result == 0; i++) {
+        b.count = counts[i];
+        b.keys = bench_paths(b.count);
+
+        b.hash = std_hash_table_new(std_str_hash, std_str_equal);
+        b.ohash = std_ohash_table_new(std_str_hash, std_str_equal);
+        b.tree = std_bbtree_new(bench_strcmp);
+        for (k = 0; k < b.count; k++) {
+            std_hash_table_insert(b.hash, b.keys[k], b.keys[k]);
+            std_ohash_table_insert(b.ohash, b.keys[k], b.keys[k]);
+            std_bbtree_insert(b.tree, b.keys[k], b.keys[k]);
+        }
+
+        for (j = 0; j < sizeof (kinds) / sizeof (kinds[0]); j++) {
+            bench_init(&bench, BENCH_SUITE, repetitions(b.count * 64),
+                    "%s insert %d", kinds[j].name, b.count);
+            bench.items = b.count;
+            bench.unit = "inserts";
+            if (bench_run(&bench, kinds[j].insert, &b) == -1) {
+                result = -1;
+                break;
+            }
+            bench_print(&bench, NULL);
+
+            bench_init(&bench, BENCH_SUITE, repetitions(b.count * 64),
+                    "%s lookup %d", kinds[j].name, b.count);
+            bench.items = b.count;
+            bench.unit = "lookups";
+            if (bench_run(&bench, kinds[j].lookup, &b) == -1) {
+                fprintf(stderr, "%s:%d %s lost a key\n", __FILE__, __LINE__,
+                        kinds[j].name);
+                result = -1;
+                break;
+            }
+            bench_print(&bench, NULL);
+        }
+
+        std_hash_table_destroy(b.hash);
+        std_ohash_table_destroy(b.ohash);
+        std_bbtree_destroy(b.tree);
+        for (k = 0; k < b.count; k++)
+            free(b.keys[k]);
+        free(b.keys);
+    }
+
+    return result;
+}
+
+/*
+ * list
+ */
+
+/* A list that mallocs each node, as std_list and tgdb_list did before
+ * their nodes came from a pool. Kept here to measure them against. */
+struct malloc_node {
+    void *data;
+    struct malloc_node *next;
+};
+
+/* The lists, kept from one repetition to the next like tgdb keeps its
+ * response list from one batch to the next */
+struct bench_list {
+    struct std_list *list;
+    struct tgdb_list *tlist;
+    int nodes[BENCH_NODES];
+};
+
+static int bench_std_list(void *context)
+{
+    struct bench_list *b = (struct bench_list *) context;
+    int i;
+
+    for (i = 0; i < BENCH_NODES; i++)
+        if (std_list_append(b->list, &b->nodes[i]) == -1)
+            return -1;
+
+    return std_list_remove_all(b->list);
+}
+
+static int bench_tgdb_list(void *context)
+{
+    struct bench_list *b = (struct bench_list *) context;
+    int i;
+
+    for (i = 0; i < BENCH_NODES; i++)
+        if (tgdb_list_append(b->tlist, &b->nodes[i]) == -1)
+            return -1;
+
+    return tgdb_list_clear(b->tlist);
+}
+
+static int bench_malloc_list(void *context)
+{
+    struct bench_list *b = (struct bench_list *) context;
+    struct malloc_node *head = NULL, **tail = &head, *node;
+    int i;
+
+    for (i = 0; i < BENCH_NODES; i++) {
+        node = (struct malloc_node *) cgdb_malloc(sizeof (struct malloc_node));
+        node->data = &b->nodes[i];
+        node->next = NULL;
+        *tail = node;
+        tail = &node->next;
+    }
+
+    while (head) {
+        node = head->next;
+        free(head);
+        head = node;
+    }
+
+    return 0;
+}
+
+static int bench_lists(void)
+{
+    static const struct {
+        const char *name;
+        int (*run) (void *context);
+    } kinds[] = {
+        { "std_list", bench_std_list },
+        { "tgdb_list", bench_tgdb_list },
+        { "malloc list", bench_malloc_list }
+    };
+    struct bench_list *b;
+    struct bench bench;
+    int i, result = 0;
+
+    b = (struct bench_list *) cgdb_malloc(sizeof (struct bench_list));
+    b->list = std_list_create(NULL);
+    b->tlist = tgdb_list_init();
+    for (i = 0; i < BENCH_NODES; i++)
+        b->nodes[i] = i;
+
+    for (i = 0; i < sizeof (kinds) / sizeof (kinds[0]); i++) {
+        bench_init(&bench, BENCH_SUITE, repetitions(BENCH_NODES * 16),
+                "%s build and clear %d", kinds[i].name, BENCH_NODES);
+        bench.items = BENCH_NODES;
+        bench.unit = "nodes";
+
+        if (bench_run(&bench, kinds[i].run, b) == -1) {
+            result = -1;
+            break;
+        }
+        bench_print(&bench, NULL);
+    }
+
+    std_list_destroy(b->list);
+    tgdb_list_destroy(b->tlist);
+    free(b);
+
+    return result;
+}
+
+static void usage(const char *progname)
+{
+    fprintf(stderr, "Usage: %s [ibuf|hash|list] ...\n", progname);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    static const struct {
+        const char *name;
+        int (*run) (void);
+    } groups[] = {
+        { "ibuf", bench_ibufs },
+        { "hash", bench_hashes },
+        { "list", bench_lists }
+    };
+    int i, j;
+
+    for (i = 1; i < argc; i++) {
+        for (j = 0; j < sizeof (groups) / sizeof (groups[0]); j++)
+            if (strcmp(argv[i], groups[j].name) == 0)
+                break;
+        if (j == sizeof (groups) / sizeof (groups[0]))
+            usage(argv[0]);
+    }
+
+    for (j = 0; j < sizeof (groups) / sizeof (groups[0]); j++) {
+        for (i = 1; i < argc; i++)
+            if (strcmp(argv[i], groups[j].name) == 0)
+                break;
+        if (argc > 1 && i == argc)
+            continue;
+
+        if (groups[j].run() == -1)
+            return 1;
+    }
+
+    return 0;
+}
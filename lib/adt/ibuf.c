@@ -9,21 +9,22 @@
 #include <ctype.h>
 #endif /* HAVE_CTYPE_H */
 
+/* The size of a new string's buffer, it doubles each time it fills up */
+#define IBUF_INITIAL_SIZE 256
+
 struct ibuf {
     char *buf;
     unsigned long cur_buf_pos;
-    unsigned long cur_block_size;
-    unsigned long BLOCK_SIZE;
+    unsigned long size;         /* The bytes allocated for buf */
 };
 
 struct ibuf *ibuf_init(void)
 {
     struct ibuf *s = (struct ibuf *) cgdb_malloc(sizeof (struct ibuf));
 
-    s->BLOCK_SIZE = 4096;
-    s->cur_block_size = 1;
+    s->size = IBUF_INITIAL_SIZE;
     s->cur_buf_pos = 0;
-    s->buf = (char *) cgdb_malloc(sizeof (char) * (s->BLOCK_SIZE));
+    s->buf = (char *) cgdb_malloc(sizeof (char) * (s->size));
     s->buf[s->cur_buf_pos] = '\0';
 
     return s;
@@ -44,25 +45,38 @@ void ibuf_clear(struct ibuf *s)
     if (!s)
         return;
 
-    s->cur_block_size = 1;
     s->cur_buf_pos = 0;
     s->buf[s->cur_buf_pos] = '\0';
 }
 
+void ibuf_reserve(struct ibuf *s, unsigned long n)
+{
+    unsigned long size;
+
+    if (!s)
+        return;
+
+    /* the '+1' is for the null-terminated char */
+    if (s->cur_buf_pos + n + 1 <= s->size)
+        return;
+
+    /* Doubling keeps adding a char at a time linear, however big the
+     * string gets */
+    for (size = s->size; size < s->cur_buf_pos + n + 1; size *= 2)
+        ;
+
+    s->buf = (char *) cgdb_realloc(s->buf, size);
+    s->size = size;
+}
+
 void ibuf_addchar(struct ibuf *s, char c)
 {
     if (!s)
         return;
 
     /* the '+1' is for the null-terminated char */
-    if (s->cur_buf_pos + 1 == ((s->cur_block_size) * s->BLOCK_SIZE)) {
-        /* NOTE: s->cur_block_size *= 2 would double the buffer size 
-         *  however, I didn't think it was necesary since it should rarly go
-         *  above 1 block.
-         */
-        s->cur_block_size += 1;
-        s->buf = (char *) realloc(s->buf, s->cur_block_size * s->BLOCK_SIZE);
-    }
+    if (s->cur_buf_pos + 1 == s->size)
+        ibuf_reserve(s, 1);
 
     /* Add the new char and null terminate */
     s->buf[(s->cur_buf_pos)++] = c;
@@ -71,10 +85,37 @@ void ibuf_addchar(struct ibuf *s, char c)
 
 void ibuf_add(struct ibuf *s, const char *d)
 {
-    int length = strlen(d), i;
+    ibuf_addn(s, d, strlen(d));
+}
+
+void ibuf_addn(struct ibuf *s, const char *d, unsigned long n)
+{
+    if (!s || n == 0)
+        return;
+
+    ibuf_reserve(s, n);
+
+    memcpy(s->buf + s->cur_buf_pos, d, n);
+    s->cur_buf_pos += n;
+    s->buf[s->cur_buf_pos] = '\0';
+}
+
+char *ibuf_steal(struct ibuf *s)
+{
+    char *buf;
+
+    if (!s)
+        return NULL;
+
+    buf = s->buf;
+
+    /* s starts over with a buffer of its own */
+    s->size = IBUF_INITIAL_SIZE;
+    s->cur_buf_pos = 0;
+    s->buf = (char *) cgdb_malloc(sizeof (char) * (s->size));
+    s->buf[s->cur_buf_pos] = '\0';
 
-    for (i = 0; i < length; i++)
-        ibuf_addchar(s, d[i]);
+    return buf;
 }
 
 void ibuf_delchar(struct ibuf *s)
@@ -33,6 +33,26 @@ void ibuf_addchar(struct ibuf *s, char c);
  */
 void ibuf_add(struct ibuf *s, const char *d);
 
+/* ibuf_addn: Adds some chars to the infinate buffer at once
+ *  s - the infinate string to modify
+ *  d - the chars to add, they don't need to be null terminated
+ *  n - the number of chars to add
+ */
+void ibuf_addn(struct ibuf *s, const char *d, unsigned long n);
+
+/* ibuf_reserve: Makes room for more chars, so that adding them doesn't
+ * reallocate the buffer. The buffer grows geometrically.
+ *  s - the infinate string to modify
+ *  n - the number of chars that will be added
+ */
+void ibuf_reserve(struct ibuf *s, unsigned long n);
+
+/* ibuf_steal: Takes the string out of the infinate buffer without a copy
+ *  return  - the string, which the caller must free. s is left empty, and
+ *            can be used again.
+ */
+char *ibuf_steal(struct ibuf *s);
+
 /* ibuf_delchar: Delete the last char put in */
 void ibuf_delchar(struct ibuf *s);
 
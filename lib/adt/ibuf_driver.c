@@ -44,6 +44,8 @@ static int test_addchar(ibuf s);
 static int test_delchar(ibuf s);
 static int test_dup(ibuf s);
 static int test_trim(ibuf s);
+static int test_grow(ibuf s);
+static int test_steal(ibuf s);
 
 /* main:
  *
@@ -69,6 +71,8 @@ int main(int argc, char *argv[])
     result |= test_delchar(s);
     result |= test_dup(s);
     result |= test_trim(s);
+    result |= test_grow(s);
+    result |= test_steal(s);
 
     debug("Destroying string...\n");
     ibuf_free(s);
@@ -230,3 +234,73 @@ static int test_trim(ibuf s)
     debug("test_trim: Succeeded.\n");
     return 0;
 }
+
+static int test_grow(ibuf s)
+{
+
+    unsigned long i;
+
+    /* Grow the string well past its first buffer, a char at a time */
+    ibuf_clear(s);
+    for (i = 0; i < 100000; i++)
+        ibuf_addchar(s, 'a' + i % 26);
+
+    if (ibuf_length(s) != 100000) {
+        debug("test_grow: expected length 100000, got: %lu\n",
+                ibuf_length(s));
+        return 1;
+    }
+
+    for (i = 0; i < 100000; i++) {
+        if (ibuf_get(s)[i] != 'a' + i % 26) {
+            debug("test_grow: mismatch at %lu\n", i);
+            return 1;
+        }
+    }
+
+    /* Then in pieces that aren't null terminated */
+    ibuf_clear(s);
+    ibuf_reserve(s, 10000);
+    for (i = 0; i < 1000; i++)
+        ibuf_addn(s, "hello world", 5);
+
+    if (ibuf_length(s) != 5000 || strncmp(ibuf_get(s), "hellohello", 10) ||
+            ibuf_get(s)[5000] != '\0') {
+        debug("test_grow: ibuf_addn built the wrong string\n");
+        return 2;
+    }
+
+    debug("test_grow: Succeeded.\n");
+    return 0;
+}
+
+static int test_steal(ibuf s)
+{
+
+    char *stolen;
+
+    ibuf_clear(s);
+    ibuf_add(s, "hello world");
+    stolen = ibuf_steal(s);
+
+    if (strcmp(stolen, "hello world") != 0) {
+        debug("test_steal: expected \"hello world\", got: %s\n", stolen);
+        return 1;
+    }
+    free(stolen);
+
+    /* The string is empty afterwards, and still works */
+    if (ibuf_length(s) != 0 || strcmp(ibuf_get(s), "") != 0) {
+        debug("test_steal: expected empty string, got: %s\n", ibuf_get(s));
+        return 2;
+    }
+
+    ibuf_add(s, "again");
+    if (strcmp(ibuf_get(s), "again") != 0) {
+        debug("test_steal: expected \"again\", got: %s\n", ibuf_get(s));
+        return 3;
+    }
+
+    debug("test_steal: Succeeded.\n");
+    return 0;
+}
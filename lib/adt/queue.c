@@ -66,6 +66,27 @@ void *queue_pop(struct queue *q)
     return d;
 }
 
+void *queue_peek(struct queue *q)
+{
+    if (!q || q->head == NULL)
+        return NULL;
+
+    return q->head->data;
+}
+
+void *queue_last(struct queue *q)
+{
+    struct node *cur;
+
+    if (!q || q->head == NULL)
+        return NULL;
+
+    for (cur = q->head; cur->next != NULL; cur = cur->next)
+        ;
+
+    return cur->data;
+}
+
 void queue_free_list(struct queue *q, item_func func)
 {
     struct node *prev, *cur = q->head;
@@ -99,6 +120,46 @@ void queue_traverse_list(struct queue *q, item_func func)
     }
 }
 
+void *queue_find(struct queue *q, item_match_func func, void *data)
+{
+    struct node *cur = q->head;
+
+    if (!func)
+        return NULL;
+
+    while (cur != NULL) {
+        if (func(cur->data, data))
+            return cur->data;
+        cur = cur->next;
+    }
+
+    return NULL;
+}
+
+int queue_free_matching(struct queue *q, item_match_func func, void *data,
+        item_func free_func)
+{
+    struct node **link = &q->head, *cur;
+    int removed = 0;
+
+    if (!func || !free_func)
+        return 0;
+
+    while ((cur = *link) != NULL) {
+        if (func(cur->data, data)) {
+            *link = cur->next;
+            free_func(cur->data);
+            free(cur);
+            removed++;
+        } else
+            link = &cur->next;
+    }
+
+    q->size = q->size - removed;
+
+    return removed;
+}
+
 int queue_size(struct queue *q)
 {
     /* This list is empty */
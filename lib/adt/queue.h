@@ -12,6 +12,7 @@
 struct queue;
 
 typedef void (*item_func) (void *item);
+typedef int (*item_match_func) (void *item, void *data);
 
 /* queue_init: Initializes a new empty queue.
  *      returns     - The new head of the queue
@@ -35,6 +36,18 @@ void queue_append(struct queue *q, void *item);
  */
 void *queue_pop(struct queue *q);
 
+/* queue_peek: Gets the first element, without removing it.
+ *      q           - The queue to look at
+ * Returns          - The first element, or NULL if the queue is empty
+ */
+void *queue_peek(struct queue *q);
+
+/* queue_last: Gets the last element, without removing it.
+ *      q           - The queue to look at
+ * Returns          - The last element, or NULL if the queue is empty
+ */
+void *queue_last(struct queue *q);
+
 /* queue_free_list: Free's list item by calling func on each element
  *      q           - The queue to modify
  *      func        - The function to free an item
@@ -47,6 +60,24 @@ void queue_free_list(struct queue *q, item_func func);
  */
 void queue_traverse_list(struct queue *q, item_func func);
 
+/* queue_find: Finds the first element that func matches
+ *      q           - The queue to search
+ *      func        - Returns 1 if item matches, 0 otherwise
+ *      data        - Passed along to func
+ * Returns          - The element, or NULL if none matches
+ */
+void *queue_find(struct queue *q, item_match_func func, void *data);
+
+/* queue_free_matching: Removes each element that func matches
+ *      q           - The queue to modify
+ *      func        - Returns 1 if item is to be removed, 0 otherwise
+ *      data        - Passed along to func
+ *      free_func   - The function to free a removed item
+ * Returns          - The number of elements removed
+ */
+int queue_free_matching(struct queue *q, item_match_func func, void *data,
+        item_func free_func);
+
 /* buffers_size: Gets the size of the queue.
  *      q           - The queue to modify
  * Returns          - The size of the list, 0 if head is NULL
@@ -0,0 +1,125 @@
+#include <string.h>
+
+#include "std_arena.h"
+
+/* The size of a block, allocations bigger than this get a block of their own */
+#define STD_ARENA_BLOCK_SIZE 4096
+
+/* The allocations are kept aligned for any of these */
+union std_arena_align {
+    void *pointer;
+    long integer;
+    double real;
+};
+
+/* A block of memory, the allocations follow the header */
+struct std_arena_block {
+    struct std_arena_block *next;
+    size_t size;                /* The bytes after the header */
+    union std_arena_align align;
+};
+
+struct std_arena {
+    struct std_arena_block *blocks;     /* The newest block is first */
+    size_t used;                /* The bytes used in the newest block */
+    size_t size;                /* The bytes in the newest block */
+};
+
+/* Adds a block that has room for at least size bytes */
+static int std_arena_add_block(struct std_arena *arena, size_t size)
+{
+    struct std_arena_block *block;
+
+    if (size < STD_ARENA_BLOCK_SIZE)
+        size = STD_ARENA_BLOCK_SIZE;
+
+    block = malloc(sizeof (struct std_arena_block) + size);
+    if (!block)
+        return -1;
+
+    block->next = arena->blocks;
+    block->size = size;
+    arena->blocks = block;
+    arena->used = 0;
+    arena->size = size;
+
+    return 0;
+}
+
+struct std_arena *std_arena_create(void)
+{
+    struct std_arena *arena = malloc(sizeof (struct std_arena));
+
+    if (!arena)
+        return NULL;
+
+    arena->blocks = NULL;
+    arena->used = 0;
+    arena->size = 0;
+
+    return arena;
+}
+
+void std_arena_destroy(struct std_arena *arena)
+{
+    if (!arena)
+        return;
+
+    std_arena_reset(arena);
+    free(arena->blocks);
+    free(arena);
+}
+
+void *std_arena_alloc(struct std_arena *arena, size_t size)
+{
+    void *memory;
+
+    if (!arena)
+        return NULL;
+
+    size = (size + sizeof (union std_arena_align) - 1) /
+            sizeof (union std_arena_align) * sizeof (union std_arena_align);
+
+    if (arena->used + size > arena->size &&
+            std_arena_add_block(arena, size) == -1)
+        return NULL;
+
+    memory = (char *) (arena->blocks + 1) + arena->used;
+    arena->used += size;
+    memset(memory, 0, size);
+
+    return memory;
+}
+
+char *std_arena_strdup(struct std_arena *arena, const char *s)
+{
+    size_t length;
+    char *copy;
+
+    if (!s)
+        return NULL;
+
+    length = strlen(s) + 1;
+    if ((copy = std_arena_alloc(arena, length)) != NULL)
+        memcpy(copy, s, length);
+
+    return copy;
+}
+
+void std_arena_reset(struct std_arena *arena)
+{
+    struct std_arena_block *block;
+
+    if (!arena || !arena->blocks)
+        return;
+
+    /* Keep the oldest block, it's the one every batch needs */
+    while (arena->blocks->next) {
+        block = arena->blocks;
+        arena->blocks = block->next;
+        free(block);
+    }
+
+    arena->used = 0;
+    arena->size = arena->blocks->size;
+}
@@ -0,0 +1,67 @@
+#ifndef __STD_ARENA_H__
+#define __STD_ARENA_H__
+
+#include <stdlib.h>
+
+/**
+ * A region of memory that objects are allocated in one after another, and
+ * that is all given back at once.
+ *
+ * Nothing in the arena is freed on its own. Resetting the arena frees it
+ * all, and keeps its first block to be used again.
+ */
+struct std_arena;
+
+/**
+ * Creates a new arena.
+ *
+ * @return
+ * A new arena, or NULL on error.
+ */
+struct std_arena *std_arena_create(void);
+
+/**
+ * Destroys the arena, and everything allocated in it.
+ *
+ * \param arena
+ * The arena to destroy
+ */
+void std_arena_destroy(struct std_arena *arena);
+
+/**
+ * Allocates zeroed memory in the arena.
+ *
+ * \param arena
+ * The arena to allocate in
+ *
+ * \param size
+ * The number of bytes to allocate
+ *
+ * @return
+ * The memory, or NULL on error.
+ */
+void *std_arena_alloc(struct std_arena *arena, size_t size);
+
+/**
+ * Copies a string into the arena.
+ *
+ * \param arena
+ * The arena to copy the string into
+ *
+ * \param s
+ * The string to copy
+ *
+ * @return
+ * The copy, or NULL if s is NULL or on error.
+ */
+char *std_arena_strdup(struct std_arena *arena, const char *s);
+
+/**
+ * Frees everything allocated in the arena, so it can be used again.
+ *
+ * \param arena
+ * The arena to reset
+ */
+void std_arena_reset(struct std_arena *arena);
+
+#endif /* __STD_ARENA_H__ */
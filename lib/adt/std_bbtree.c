@@ -93,6 +93,12 @@ static struct std_bbtreenode *std_bbtree_node_rotate_right(struct std_bbtreenode
 
 static void std_bbtree_node_check(struct std_bbtreenode *node);
 
+static struct std_bbtreenode *std_bbtree_node_build(void **keys,
+        void **values, int count, int *height);
+
+static int std_bbtree_cursor_bound(struct std_bbtree *tree, const void *key,
+        struct std_bbtree_cursor *cursor, int upper);
+
 static struct std_bbtreenode *std_bbtree_node_new(void *key, void *value)
 {
     struct std_bbtreenode *node;
@@ -313,6 +319,133 @@ int std_bbtree_nnodes(struct std_bbtree *tree)
         return 0;
 }
 
+int std_bbtree_build(struct std_bbtree *tree,
+        void **keys, void **values, int count)
+{
+    int i, height;
+
+    if (!tree || tree->root || count < 0 || (count > 0 && !keys))
+        return -1;
+
+    for (i = 1; i < count; i++)
+        if (tree->key_compare(keys[i - 1], keys[i],
+                        tree->key_compare_data) >= 0)
+            return -1;
+
+    tree->root = std_bbtree_node_build(keys, values, count, &height);
+
+    return 0;
+}
+
+int std_bbtree_first(struct std_bbtree *tree,
+        struct std_bbtree_cursor *cursor)
+{
+    struct std_bbtreenode *node;
+
+    if (!tree || !cursor)
+        return -1;
+
+    cursor->depth = 0;
+    for (node = tree->root; node; node = node->left)
+        cursor->path[cursor->depth++] = node;
+
+    return cursor->depth > 0;
+}
+
+int std_bbtree_last(struct std_bbtree *tree,
+        struct std_bbtree_cursor *cursor)
+{
+    struct std_bbtreenode *node;
+
+    if (!tree || !cursor)
+        return -1;
+
+    cursor->depth = 0;
+    for (node = tree->root; node; node = node->right)
+        cursor->path[cursor->depth++] = node;
+
+    return cursor->depth > 0;
+}
+
+int std_bbtree_lower_bound(struct std_bbtree *tree, const void *key,
+        struct std_bbtree_cursor *cursor)
+{
+    return std_bbtree_cursor_bound(tree, key, cursor, 0);
+}
+
+int std_bbtree_upper_bound(struct std_bbtree *tree, const void *key,
+        struct std_bbtree_cursor *cursor)
+{
+    return std_bbtree_cursor_bound(tree, key, cursor, 1);
+}
+
+int std_bbtree_cursor_next(struct std_bbtree_cursor *cursor)
+{
+    struct std_bbtreenode *node;
+
+    if (!cursor || cursor->depth == 0)
+        return -1;
+
+    node = cursor->path[cursor->depth - 1];
+
+    /* The next key is the smallest one on the right, if there's a right */
+    if (node->right) {
+        for (node = node->right; node; node = node->left)
+            cursor->path[cursor->depth++] = node;
+        return 1;
+    }
+
+    /* Otherwise it's the first node above whose left this one is under */
+    while (cursor->depth > 1 &&
+            cursor->path[cursor->depth - 2]->right ==
+            cursor->path[cursor->depth - 1])
+        cursor->depth--;
+    cursor->depth--;
+
+    return cursor->depth > 0;
+}
+
+int std_bbtree_cursor_prev(struct std_bbtree_cursor *cursor)
+{
+    struct std_bbtreenode *node;
+
+    if (!cursor || cursor->depth == 0)
+        return -1;
+
+    node = cursor->path[cursor->depth - 1];
+
+    if (node->left) {
+        for (node = node->left; node; node = node->right)
+            cursor->path[cursor->depth++] = node;
+        return 1;
+    }
+
+    while (cursor->depth > 1 &&
+            cursor->path[cursor->depth - 2]->left ==
+            cursor->path[cursor->depth - 1])
+        cursor->depth--;
+    cursor->depth--;
+
+    return cursor->depth > 0;
+}
+
+int std_bbtree_cursor_get(const struct std_bbtree_cursor *cursor,
+        void **key, void **value)
+{
+    struct std_bbtreenode *node;
+
+    if (!cursor || cursor->depth == 0)
+        return -1;
+
+    node = cursor->path[cursor->depth - 1];
+    if (key)
+        *key = node->key;
+    if (value)
+        *value = node->value;
+
+    return 0;
+}
+
 static struct std_bbtreenode *std_bbtree_node_insert(struct std_bbtree *tree,
         struct std_bbtreenode *node,
         void *key, void *value, int replace, int *inserted)
@@ -727,3 +860,57 @@ static void std_bbtree_node_check(struct std_bbtreenode *node)
             std_bbtree_node_check(node->right);
     }
 }
+
+/* Builds a balanced subtree of sorted pairs, the middle one is its root
+ * and height is set to its height */
+static struct std_bbtreenode *std_bbtree_node_build(void **keys,
+        void **values, int count, int *height)
+{
+    struct std_bbtreenode *node;
+    int middle = count / 2;
+    int left_height, right_height;
+
+    if (count == 0) {
+        *height = 0;
+        return NULL;
+    }
+
+    node = std_bbtree_node_new(keys[middle], values ? values[middle] : NULL);
+    node->left = std_bbtree_node_build(keys, values, middle, &left_height);
+    node->right = std_bbtree_node_build(keys + middle + 1,
+            values ? values + middle + 1 : NULL, count - middle - 1,
+            &right_height);
+    node->balance = right_height - left_height;
+
+    *height = MAX(left_height, right_height) + 1;
+
+    return node;
+}
+
+/* Positions a cursor on the first pair whose key isn't smaller than key,
+ * or if upper, on the first one whose key is larger. The path down to it
+ * is the start of the path the search goes down. */
+static int std_bbtree_cursor_bound(struct std_bbtree *tree, const void *key,
+        struct std_bbtree_cursor *cursor, int upper)
+{
+    struct std_bbtreenode *node;
+    int depth = 0, found = 0, cmp;
+
+    if (!tree || !cursor)
+        return -1;
+
+    for (node = tree->root; node; depth++) {
+        cursor->path[depth] = node;
+        cmp = tree->key_compare(key, node->key, tree->key_compare_data);
+
+        if (cmp < 0 || (cmp == 0 && !upper)) {
+            found = depth + 1;
+            node = node->left;
+        } else
+            node = node->right;
+    }
+
+    cursor->depth = found;
+
+    return found > 0;
+}
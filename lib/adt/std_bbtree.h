@@ -27,6 +27,26 @@
  */
 struct std_bbtree;
 
+struct std_bbtreenode;
+
+/**
+ * The height a tree can't reach. A tree with as many nodes as an int
+ * can count is at most 45 nodes high.
+ */
+#define STD_BBTREE_MAX_HEIGHT 48
+
+/**
+ * A position on a key/value pair of a tree, to go through the pairs in
+ * order, from std_bbtree_first(), std_bbtree_lower_bound() and the like.
+ * Its fields are private, it's meant to be kept on the stack. It's no
+ * longer valid once the tree is changed.
+ */
+struct std_bbtree_cursor {
+    /* The nodes from the root down to the pair, none if it's off the end */
+    struct std_bbtreenode *path[STD_BBTREE_MAX_HEIGHT];
+    int depth;
+};
+
 typedef int (*STDTraverseFunc) (void *key, void *value, void *data);
 
 /**
@@ -296,4 +316,138 @@ int std_bbtree_height(struct std_bbtree *tree);
  */
 int std_bbtree_nnodes(struct std_bbtree *tree);
 
+/**
+ * Adds key/value pairs that are already in order to an empty tree. The
+ * tree is built balanced in one pass, in O(n), instead of being balanced
+ * after each insert.
+ *
+ * \param tree
+ * The tree to add to, it must be empty.
+ *
+ * \param keys
+ * The keys, each must come after the one before it.
+ *
+ * \param values
+ * The value of each key, or NULL to add them all with a NULL value.
+ *
+ * \param count
+ * The number of keys.
+ *
+ * @return
+ * 0 on success, or -1 on error, if the tree isn't empty or the keys
+ * aren't in order. The tree isn't changed on error.
+ */
+int std_bbtree_build(struct std_bbtree *tree,
+        void **keys, void **values, int count);
+
+/**
+ * Puts a cursor on the key/value pair with the smallest key.
+ *
+ * \param tree
+ * The tree to go through.
+ *
+ * \param cursor
+ * The cursor to position.
+ *
+ * @return
+ * 1 if the cursor is on a pair, 0 if the tree is empty, or -1 on error.
+ */
+int std_bbtree_first(struct std_bbtree *tree,
+        struct std_bbtree_cursor *cursor);
+
+/**
+ * Puts a cursor on the key/value pair with the largest key.
+ *
+ * \param tree
+ * The tree to go through.
+ *
+ * \param cursor
+ * The cursor to position.
+ *
+ * @return
+ * 1 if the cursor is on a pair, 0 if the tree is empty, or -1 on error.
+ */
+int std_bbtree_last(struct std_bbtree *tree,
+        struct std_bbtree_cursor *cursor);
+
+/**
+ * Puts a cursor on the first key/value pair whose key isn't smaller than
+ * the given key, in O(log n).
+ *
+ * \param tree
+ * The tree to search.
+ *
+ * \param key
+ * The key to compare with.
+ *
+ * \param cursor
+ * The cursor to position.
+ *
+ * @return
+ * 1 if the cursor is on a pair, 0 if every key is smaller, or -1 on error.
+ */
+int std_bbtree_lower_bound(struct std_bbtree *tree, const void *key,
+        struct std_bbtree_cursor *cursor);
+
+/**
+ * Puts a cursor on the first key/value pair whose key is larger than the
+ * given key, in O(log n).
+ *
+ * \param tree
+ * The tree to search.
+ *
+ * \param key
+ * The key to compare with.
+ *
+ * \param cursor
+ * The cursor to position.
+ *
+ * @return
+ * 1 if the cursor is on a pair, 0 if no key is larger, or -1 on error.
+ */
+int std_bbtree_upper_bound(struct std_bbtree *tree, const void *key,
+        struct std_bbtree_cursor *cursor);
+
+/**
+ * Moves a cursor to the pair with the next larger key.
+ *
+ * \param cursor
+ * The cursor to move.
+ *
+ * @return
+ * 1 if the cursor is on a pair, 0 if it went off the end, or -1 if it
+ * wasn't on a pair.
+ */
+int std_bbtree_cursor_next(struct std_bbtree_cursor *cursor);
+
+/**
+ * Moves a cursor to the pair with the next smaller key.
+ *
+ * \param cursor
+ * The cursor to move.
+ *
+ * @return
+ * 1 if the cursor is on a pair, 0 if it went off the start, or -1 if it
+ * wasn't on a pair.
+ */
+int std_bbtree_cursor_prev(struct std_bbtree_cursor *cursor);
+
+/**
+ * Gets the key/value pair a cursor is on.
+ *
+ * \param cursor
+ * The cursor.
+ *
+ * \param key
+ * Returns the key, if it's not NULL.
+ *
+ * \param value
+ * Returns the value, if it's not NULL.
+ *
+ * @return
+ * 0 on success, or -1 if the cursor isn't on a pair.
+ */
+int std_bbtree_cursor_get(const struct std_bbtree_cursor *cursor,
+        void **key, void **value);
+
 #endif /* __G_TREE_H__ */
@@ -26,8 +26,11 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 #include <assert.h>
+#include <sys/time.h>
 #include "std_bbtree.h"
+#include "std_list.h"
 
 int array[10000];
 int failed = 0;
@@ -104,6 +107,192 @@ int runtreetest(struct std_bbtree *tree)
     return 0;
 }
 
+static int int_compare(const void *a, const void *b)
+{
+    const int *one = a;
+    const int *two = b;
+
+    return *one < *two ? -1 : *one > *two;
+}
+
+/* Checks the bounds and the cursors of a tree of the even numbers below
+ * 2 * count, against what they should find */
+static void check_bounds(struct std_bbtree *tree, int count)
+{
+    struct std_bbtree_cursor cursor;
+    void *key;
+    int i, x, seen;
+
+    assert(std_bbtree_nnodes(tree) == count);
+
+    for (x = -2; x <= 2 * count + 1; x++) {
+        /* The first even number at least x, and the first one above it */
+        int lower = x <= 0 ? 0 : (x + 1) / 2 * 2;
+        int upper = x < 0 ? 0 : x / 2 * 2 + 2;
+
+        assert(std_bbtree_lower_bound(tree, &x, &cursor) ==
+                (lower < 2 * count));
+        if (lower < 2 * count) {
+            std_bbtree_cursor_get(&cursor, &key, NULL);
+            assert(*(int *) key == lower);
+        }
+
+        assert(std_bbtree_upper_bound(tree, &x, &cursor) ==
+                (upper < 2 * count));
+        if (upper < 2 * count) {
+            std_bbtree_cursor_get(&cursor, &key, NULL);
+            assert(*(int *) key == upper);
+
+            /* The key before it is the last one that's not larger than x */
+            if (std_bbtree_cursor_prev(&cursor) == 1) {
+                std_bbtree_cursor_get(&cursor, &key, NULL);
+                assert(*(int *) key == upper - 2);
+            } else
+                assert(upper == 0);
+        }
+    }
+
+    seen = 0;
+    for (i = std_bbtree_first(tree, &cursor); i == 1;
+            i = std_bbtree_cursor_next(&cursor)) {
+        std_bbtree_cursor_get(&cursor, &key, NULL);
+        assert(*(int *) key == 2 * seen);
+        seen++;
+    }
+    assert(seen == count && std_bbtree_cursor_next(&cursor) == -1);
+
+    for (i = std_bbtree_last(tree, &cursor); i == 1;
+            i = std_bbtree_cursor_prev(&cursor)) {
+        seen--;
+        std_bbtree_cursor_get(&cursor, &key, NULL);
+        assert(*(int *) key == 2 * seen);
+    }
+    assert(seen == 0);
+}
+
+static void runcursortest(void)
+{
+    struct std_bbtree *tree;
+    void *keys[200];
+    int i, count;
+
+    for (i = 0; i < 200; i++) {
+        array[i] = 2 * i;
+        keys[i] = &array[i];
+    }
+
+    for (count = 0; count <= 200; count++) {
+        /* Built from the sorted keys */
+        tree = std_bbtree_new(int_compare);
+        assert(std_bbtree_build(tree, keys, NULL, count) == 0);
+        check_bounds(tree, count);
+        if (count > 0)
+            assert(std_bbtree_build(tree, keys, NULL, count) == -1);
+        std_bbtree_destroy(tree);
+
+        /* Inserted one at a time from both ends, which rotates the tree */
+        tree = std_bbtree_new(int_compare);
+        for (i = 0; i < count; i++)
+            std_bbtree_insert(tree, keys[i % 2 ? count - 1 - i / 2 : i / 2],
+                    NULL);
+        check_bounds(tree, count);
+        std_bbtree_destroy(tree);
+    }
+
+    /* The keys must be in order */
+    tree = std_bbtree_new(int_compare);
+    keys[0] = &array[1];
+    keys[1] = &array[0];
+    assert(std_bbtree_build(tree, keys, NULL, 2) == -1);
+    assert(std_bbtree_nnodes(tree) == 0);
+    std_bbtree_destroy(tree);
+}
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/* Times building a sorted container of count keys, then finding the first
+ * key at least as large as a number, and going through the next 100 keys
+ * from there, the way a range of addresses or lines is looked at */
+static void compare(int count)
+{
+    struct std_bbtree *tree;
+    struct std_bbtree_cursor cursor;
+    struct std_list *list;
+    std_list_iterator iter;
+    int *numbers = malloc(sizeof (int) * count);
+    void **keys = malloc(sizeof (void *) * count);
+    int queries = 1000, i, j, x, found, sum[2] = { 0, 0 };
+    double start, times[2][2];
+    void *key;
+
+    for (i = 0; i < count; i++) {
+        numbers[i] = 2 * i;
+        keys[i] = &numbers[i];
+    }
+
+    start = now();
+    tree = std_bbtree_new(int_compare);
+    std_bbtree_build(tree, keys, NULL, count);
+    times[0][0] = now() - start;
+
+    start = now();
+    list = std_list_create(NULL);
+    for (i = 0; i < count; i++)
+        std_list_append(list, keys[i]);
+    times[1][0] = now() - start;
+
+    srand(1);
+    start = now();
+    for (i = 0; i < queries; i++) {
+        x = rand() % (2 * count);
+        found = std_bbtree_lower_bound(tree, &x, &cursor);
+        for (j = 0; j < 100 && found == 1;
+                j++, found = std_bbtree_cursor_next(&cursor)) {
+            std_bbtree_cursor_get(&cursor, &key, NULL);
+            sum[0] += *(int *) key;
+        }
+    }
+    times[0][1] = now() - start;
+
+    srand(1);
+    start = now();
+    for (i = 0; i < queries; i++) {
+        x = rand() % (2 * count);
+        for (iter = std_list_begin(list); iter != std_list_end(list);
+                iter = std_list_next(iter)) {
+            std_list_get_data(iter, &key);
+            if (*(int *) key >= x)
+                break;
+        }
+        for (j = 0; j < 100 && iter != std_list_end(list);
+                j++, iter = std_list_next(iter)) {
+            std_list_get_data(iter, &key);
+            sum[1] += *(int *) key;
+        }
+    }
+    times[1][1] = now() - start;
+
+    assert(sum[0] == sum[1]);
+
+    for (i = 0; i < 2; i++)
+        printf("{\"container\": \"%s\", \"keys\": %d, \"build_ms\": %.3f, "
+                "\"range_ms\": %.3f, \"ranges\": %d}\n",
+                i ? "std_list" : "std_bbtree", count, times[i][0] * 1000,
+                times[i][1] * 1000, queries);
+
+    std_bbtree_destroy(tree);
+    std_list_destroy(list);
+    free(keys);
+    free(numbers);
+}
+
 int main(int argc, char *argv[])
 {
     struct std_bbtree *tree = NULL;
@@ -112,6 +301,12 @@ int main(int argc, char *argv[])
     for (i = 0; i < 10000; i++)
         runtreetest(tree);
 
+    runcursortest();
+
+    /* std_bbtree_driver -b [keys] compares the tree with a list */
+    if (argc > 1 && strcmp(argv[1], "-b") == 0)
+        compare(argc > 2 ? atoi(argv[2]) : 100000);
+
     printf("PASSED\n");
 
     return 0;
@@ -306,7 +306,9 @@ unsigned int std_hash_table_size(struct std_hashtable *hash_table);
 
 /* 
  * Some standard hash functions 
- * TODO: These are unimplemented. Please implement them when needed.
+ *
+ * The str functions take keys that are NUL terminated strings, and the
+ * int functions take keys that are pointers to ints.
  */
 
 int std_str_equal(const void *v, const void *v2);
@@ -22,7 +22,9 @@
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <sys/time.h>
 #include "std_hash.h"
+#include "std_ohash.h"
 
 int array[10000];
 
@@ -279,6 +281,146 @@ static void direct_hash_test(void)
     std_hash_table_destroy(h);
 }
 
+/* The same tests as main and second_hash_test, on the open addressing table */
+static void ohash_test(int simple_hash)
+{
+    struct std_ohashtable *h;
+    char key[20], val[20], *v, *orig_key, *orig_val;
+    int i, value = 120, *pvalue;
+
+    h = std_ohash_table_new(my_hash, my_hash_equal);
+    assert(h != NULL);
+    for (i = 0; i < 10000; i++) {
+        array[i] = i;
+        std_ohash_table_insert(h, &array[i], &array[i]);
+    }
+    assert(std_ohash_table_size(h) == 10000);
+
+    pvalue = std_ohash_table_find(h, find_first, &value);
+    assert(pvalue && *pvalue == value);
+
+    for (i = 0; i < 10000; i += 2)
+        assert(std_ohash_table_remove(h, &array[i]) == 1);
+    assert(std_ohash_table_remove(h, &array[0]) == 0);
+    for (i = 0; i < 10000; i++)
+        assert((std_ohash_table_lookup(h, &array[i]) != NULL) == (i % 2));
+
+    /* The deleted slots get reused */
+    for (i = 0; i < 10000; i += 2)
+        std_ohash_table_insert(h, &array[i], &array[i]);
+    assert(std_ohash_table_size(h) == 10000);
+
+    assert(std_ohash_table_foreach_remove(h, my_hash_callback_remove,
+                    NULL) == 5000 && std_ohash_table_size(h) == 5000);
+    std_ohash_table_foreach(h, my_hash_callback_remove_test, NULL);
+    std_ohash_table_destroy(h);
+
+    h = std_ohash_table_new(simple_hash ? one_hash : honeyman_hash,
+            second_hash_cmp);
+    assert(h != NULL);
+    for (i = 0; i < 20; i++) {
+        sprintf(key, "%d", i);
+        sprintf(val, "%d value", i);
+        std_ohash_table_insert(h, strdup(key), strdup(val));
+    }
+    assert(std_ohash_table_size(h) == 20);
+
+    sprintf(key, "%d", 3);
+    assert(std_ohash_table_lookup_extended(h, key, (void *) &orig_key,
+                    (void *) &orig_val));
+    std_ohash_table_steal(h, key);
+    free(orig_key);
+    free(orig_val);
+
+    for (i = 0; i < 20; i++) {
+        sprintf(key, "%d", i);
+        v = std_ohash_table_lookup(h, key);
+        assert((v != NULL) == (i != 3));
+        assert(!v || atoi(v) == i);
+    }
+
+    std_ohash_table_foreach_steal(h, remove_even_foreach, NULL);
+    std_ohash_table_foreach(h, not_even_foreach, NULL);
+    assert(std_ohash_table_size(h) == 9);
+    std_ohash_table_destroy(h);
+
+    h = std_ohash_table_new(NULL, NULL);
+    for (i = 1; i <= 20; i++)
+        std_ohash_table_insert(h, (void *) (long) i, (void *) (long) (i + 42));
+    for (i = 1; i <= 20; i++)
+        assert((long) std_ohash_table_lookup(h, (void *) (long) i) == i + 42);
+    std_ohash_table_destroy(h);
+}
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/* Times inserting, looking up and removing count path like strings in each
+ * of the tables, the way the source viewer's file index uses them */
+static void compare(int count)
+{
+    struct std_hashtable *h;
+    struct std_ohashtable *oh;
+    char **keys = malloc(sizeof (char *) * count), key[64];
+    double start, times[2][3];
+    int i, j, found[2] = { 0, 0 };
+
+    for (i = 0; i < count; i++) {
+        sprintf(key, "/usr/src/project/module%d/file%d.c", i % 97, i);
+        keys[i] = strdup(key);
+    }
+
+    h = std_hash_table_new(std_str_hash, std_str_equal);
+    start = now();
+    for (i = 0; i < count; i++)
+        std_hash_table_insert(h, keys[i], keys[i]);
+    times[0][0] = now() - start;
+    start = now();
+    for (j = 0; j < 10; j++)
+        for (i = 0; i < count; i++)
+            found[0] += std_hash_table_lookup(h, keys[i]) != NULL;
+    times[0][1] = now() - start;
+    start = now();
+    for (i = 0; i < count; i++)
+        std_hash_table_remove(h, keys[i]);
+    times[0][2] = now() - start;
+    std_hash_table_destroy(h);
+
+    oh = std_ohash_table_new(std_str_hash, std_str_equal);
+    start = now();
+    for (i = 0; i < count; i++)
+        std_ohash_table_insert(oh, keys[i], keys[i]);
+    times[1][0] = now() - start;
+    start = now();
+    for (j = 0; j < 10; j++)
+        for (i = 0; i < count; i++)
+            found[1] += std_ohash_table_lookup(oh, keys[i]) != NULL;
+    times[1][1] = now() - start;
+    start = now();
+    for (i = 0; i < count; i++)
+        std_ohash_table_remove(oh, keys[i]);
+    times[1][2] = now() - start;
+    std_ohash_table_destroy(oh);
+
+    assert(found[0] == found[1]);
+
+    for (i = 0; i < 2; i++)
+        printf("{\"table\": \"%s\", \"keys\": %d, \"insert_ms\": %.3f, "
+                "\"lookup_ms\": %.3f, \"remove_ms\": %.3f}\n",
+                i ? "std_ohash" : "std_hash", count, times[i][0] * 1000,
+                times[i][1] * 1000, times[i][2] * 1000);
+
+    for (i = 0; i < count; i++)
+        free(keys[i]);
+    free(keys);
+}
+
 int main(int argc, char *argv[])
 {
     struct std_hashtable *hash_table;
@@ -321,6 +463,12 @@ int main(int argc, char *argv[])
     second_hash_test(1);
     second_hash_test(0);
     direct_hash_test();
+    ohash_test(1);
+    ohash_test(0);
+
+    /* std_hash_driver -b [keys] compares the two tables */
+    if (argc > 1 && strcmp(argv[1], "-b") == 0)
+        compare(argc > 2 ? atoi(argv[2]) : 100000);
 
     printf("PASSED\n");
 
@@ -0,0 +1,51 @@
+#include <string.h>
+
+#include "std_intern.h"
+#include "std_arena.h"
+#include "std_hash.h"
+#include "std_ohash.h"
+
+/* The interned strings are keys and values both, the arena owns them */
+static struct std_ohashtable *intern_table;
+static struct std_arena *intern_arena;
+
+const char *std_intern(const char *s)
+{
+    char *copy;
+
+    if (!s)
+        return NULL;
+
+    if (!intern_table) {
+        intern_table = std_ohash_table_new(std_str_hash, std_str_equal);
+        intern_arena = std_arena_create();
+    }
+
+    copy = std_ohash_table_lookup(intern_table, s);
+    if (copy)
+        return copy;
+
+    copy = std_arena_strdup(intern_arena, s);
+    std_ohash_table_insert(intern_table, copy, copy);
+
+    return copy;
+}
+
+const char *std_intern_lookup(const char *s)
+{
+    if (!s || !intern_table)
+        return NULL;
+
+    return std_ohash_table_lookup(intern_table, s);
+}
+
+void std_intern_shutdown(void)
+{
+    if (!intern_table)
+        return;
+
+    std_ohash_table_destroy(intern_table);
+    std_arena_destroy(intern_arena);
+    intern_table = NULL;
+    intern_arena = NULL;
+}
@@ -0,0 +1,44 @@
+#ifndef __STD_INTERN_H__
+#define __STD_INTERN_H__
+
+/**
+ * The strings that are used all over, like the paths of source files, kept
+ * once for the whole process.
+ *
+ * Interning a string gives back the one copy of it, so two interned strings
+ * are equal exactly when they're the same pointer. The copies are never
+ * freed, they belong to the table until std_intern_shutdown, so whoever
+ * gets one can keep it as long as it likes without copying or freeing it.
+ *
+ * The table is only meant to be used from the main thread. The strings in
+ * it can be read from any thread.
+ */
+
+/**
+ * Gets the one copy of a string, adding it if it's new.
+ *
+ * \param s
+ * The string, or NULL.
+ *
+ * @return
+ * The interned copy, or NULL if s is NULL.
+ */
+const char *std_intern(const char *s);
+
+/**
+ * Gets the one copy of a string, if it's been interned.
+ *
+ * \param s
+ * The string, or NULL.
+ *
+ * @return
+ * The interned copy, or NULL if s is NULL or was never interned.
+ */
+const char *std_intern_lookup(const char *s);
+
+/**
+ * Frees every interned string. Nothing that was interned can be used after.
+ */
+void std_intern_shutdown(void);
+
+#endif /* __STD_INTERN_H__ */
@@ -3,6 +3,7 @@
 
 /* Local Includes */
 #include "std_list.h"
+#include "std_pool.h"
 
 /**
  * A node in the linked list.
@@ -54,6 +55,11 @@ struct std_list {
 	 * item is free'd.
 	 */
     STDDestroyNotify destroy_func;
+
+    /**
+	 * The nodes come from here, and go back when they're removed.
+	 */
+    struct std_pool *pool;
 };
 
 /* Functions */
@@ -62,14 +68,17 @@ struct std_list {
 /**
  * Allocate a single std_list_node.
  *
+ * @param list
+ * The list whose pool the node comes from.
+ *
  * @return
  * A new list on success, or NULL on error
  */
-static struct std_list_node *std_list_node_create(void)
+static struct std_list_node *std_list_node_create(struct std_list *list)
 {
     struct std_list_node *list_node;
 
-    list_node = malloc(sizeof (struct std_list_node));
+    list_node = std_pool_alloc(list->pool);
 
     if (!list_node)
         return NULL;
@@ -84,11 +93,14 @@ static struct std_list_node *std_list_node_create(void)
 /**
  * Destroy a single std_list_node.
  *
+ * @param list
+ * The list whose pool the node goes back to.
+ *
  * @return
  * 0 on success, or -1 on error.
  */
-static int std_list_node_destroy(struct std_list_node *list_node,
-        STDDestroyNotify destroy_func)
+static int std_list_node_destroy(struct std_list *list,
+        struct std_list_node *list_node, STDDestroyNotify destroy_func)
 {
 
     if (!list_node)
@@ -100,7 +112,7 @@ static int std_list_node_destroy(struct std_list_node *list_node,
     list_node->data = NULL;
     list_node->next = NULL;
     list_node->prev = NULL;
-    free(list_node);
+    std_pool_free(list->pool, list_node);
     list_node = NULL;
 
     return 0;
@@ -121,10 +133,14 @@ struct std_list *std_list_create(STDDestroyNotify destroy_func)
     if (!list)
         return NULL;
 
-    list->begin = std_list_node_create();
+    list->pool = std_pool_create(sizeof (struct std_list_node));
+    list->begin = std_list_node_create(list);
 
-    if (!list->begin)
+    if (!list->begin) {
+        std_pool_destroy(list->pool);
+        free(list);
         return NULL;
+    }
 
     list->end = list->begin;
     list->length = 0;
@@ -158,9 +174,10 @@ int std_list_destroy(struct std_list *list)
         return -1;
 
     /* Free the dummy node (remove won't do this) */
-    std_list_node_destroy(list->end, list->destroy_func);
+    std_list_node_destroy(list, list->end, list->destroy_func);
 
     /* Free the list structure */
+    std_pool_destroy(list->pool);
     free(list);
 
     return 0;
@@ -202,7 +219,7 @@ int std_list_insert(struct std_list *list,
     if (!iter)
         return -1;
 
-    new_node = std_list_node_create();
+    new_node = std_list_node_create(list);
 
     if (!new_node)
         return -1;
@@ -291,7 +308,7 @@ std_list_iterator std_list_remove(struct std_list * list,
         after->prev = before;
     }
 
-    if (std_list_node_destroy(iter, list->destroy_func) == -1)
+    if (std_list_node_destroy(list, iter, list->destroy_func) == -1)
         return NULL;
 
     list->length -= 1;
@@ -0,0 +1,394 @@
+#include <string.h>
+
+#include "std_ohash.h"
+
+/*
+ * The entries are kept in one array, and a key that collides goes in the
+ * next free slot after the one it hashes to (linear probing).
+ *
+ * Each slot also has a one byte tag, in an array of its own. The tag is
+ * OHASH_EMPTY, OHASH_DELETED, or 7 bits of the hash of the key in the slot.
+ * A lookup walks the tags, which are next to each other in memory, and only
+ * calls the equal function when the 7 bits match. It stops at the first
+ * empty slot.
+ *
+ * Removing an entry leaves a deleted tag, so the keys after it can still be
+ * found. The deleted slots are reused by inserts and dropped when the table
+ * is resized.
+ */
+
+#define OHASH_MIN_SIZE 16
+#define OHASH_EMPTY 0x80
+#define OHASH_DELETED 0xfe
+#define OHASH_TAG(hash) ((unsigned char) (((hash) >> 25) & 0x7f))
+
+struct std_ohashentry {
+    void *key;
+    void *value;
+};
+
+struct std_ohashtable {
+    unsigned int size;          /* The number of slots, a power of 2 */
+    unsigned int nnodes;        /* The number of entries */
+    unsigned int ndeleted;      /* The number of deleted slots */
+    unsigned char *tags;
+    struct std_ohashentry *entries;
+    STDHashFunc hash_func;
+    STDEqualFunc key_equal_func;
+    STDDestroyNotify key_destroy_func;
+    STDDestroyNotify value_destroy_func;
+};
+
+/* Spreads the hash function's bits, so that keys like aligned pointers and
+ * small integers don't all land in the same few slots */
+static unsigned int std_ohash_mix(struct std_ohashtable *hash_table,
+        const void *key)
+{
+    unsigned int hash = (*hash_table->hash_func) (key) * 2654435761u;
+
+    return hash ^ (hash >> 15);
+}
+
+/* Allocates the slots of hash_table, all of them empty */
+static int std_ohash_table_alloc(struct std_ohashtable *hash_table,
+        unsigned int size)
+{
+    hash_table->tags = malloc(size);
+    hash_table->entries = malloc(sizeof (struct std_ohashentry) * size);
+
+    if (!hash_table->tags || !hash_table->entries) {
+        free(hash_table->tags);
+        free(hash_table->entries);
+        return -1;
+    }
+
+    memset(hash_table->tags, OHASH_EMPTY, size);
+    hash_table->size = size;
+    hash_table->ndeleted = 0;
+
+    return 0;
+}
+
+/* Moves the entries into a table big enough for twice as many of them */
+static void std_ohash_table_resize(struct std_ohashtable *hash_table)
+{
+    unsigned char *tags = hash_table->tags;
+    struct std_ohashentry *entries = hash_table->entries;
+    unsigned int old_size = hash_table->size, size = OHASH_MIN_SIZE;
+    unsigned int i, j, hash;
+
+    while (size < hash_table->nnodes * 2 + 2)
+        size *= 2;
+
+    /* Keep the old table if no memory can be found for a new one */
+    if (std_ohash_table_alloc(hash_table, size) == -1) {
+        hash_table->tags = tags;
+        hash_table->entries = entries;
+        return;
+    }
+
+    for (i = 0; i < old_size; i++) {
+        if (tags[i] & 0x80)
+            continue;
+
+        hash = std_ohash_mix(hash_table, entries[i].key);
+        for (j = hash & (size - 1); hash_table->tags[j] != OHASH_EMPTY;)
+            j = (j + 1) & (size - 1);
+
+        hash_table->tags[j] = tags[i];
+        hash_table->entries[j] = entries[i];
+    }
+
+    free(tags);
+    free(entries);
+}
+
+/* Finds the slot the key is in. If it isn't there, the slot it should be
+ * put in is returned in free_slot. */
+static int std_ohash_table_lookup_slot(struct std_ohashtable *hash_table,
+        const void *key, unsigned int *free_slot)
+{
+    unsigned int hash = std_ohash_mix(hash_table, key);
+    unsigned int mask = hash_table->size - 1, i = hash & mask;
+    unsigned char tag = OHASH_TAG(hash);
+    int deleted = -1;
+
+    for (; hash_table->tags[i] != OHASH_EMPTY; i = (i + 1) & mask) {
+        if (hash_table->tags[i] == tag) {
+            void *slot_key = hash_table->entries[i].key;
+
+            if (hash_table->key_equal_func ?
+                    (*hash_table->key_equal_func) (slot_key, key) :
+                    slot_key == key)
+                return i;
+        } else if (hash_table->tags[i] == OHASH_DELETED && deleted == -1)
+            deleted = i;
+    }
+
+    if (free_slot)
+        *free_slot = deleted != -1 ? (unsigned int) deleted : i;
+
+    return -1;
+}
+
+/* Empties the slot, calling the destroy functions if notify is 1 */
+static void std_ohash_table_remove_slot(struct std_ohashtable *hash_table,
+        unsigned int i, int notify)
+{
+    if (notify && hash_table->key_destroy_func)
+        hash_table->key_destroy_func(hash_table->entries[i].key);
+
+    if (notify && hash_table->value_destroy_func)
+        hash_table->value_destroy_func(hash_table->entries[i].value);
+
+    hash_table->tags[i] = OHASH_DELETED;
+    hash_table->nnodes--;
+    hash_table->ndeleted++;
+}
+
+/* Shrinks the table once most of it is empty */
+static void std_ohash_table_maybe_shrink(struct std_ohashtable *hash_table)
+{
+    if (hash_table->size > OHASH_MIN_SIZE &&
+            hash_table->nnodes * 8 < hash_table->size)
+        std_ohash_table_resize(hash_table);
+}
+
+struct std_ohashtable *std_ohash_table_new(STDHashFunc hash_func,
+        STDEqualFunc key_equal_func)
+{
+    return std_ohash_table_new_full(hash_func, key_equal_func, NULL, NULL);
+}
+
+struct std_ohashtable *std_ohash_table_new_full(STDHashFunc hash_func,
+        STDEqualFunc key_equal_func,
+        STDDestroyNotify key_destroy_func, STDDestroyNotify value_destroy_func)
+{
+    struct std_ohashtable *hash_table;
+
+    hash_table = malloc(sizeof (struct std_ohashtable));
+    if (!hash_table)
+        return NULL;
+
+    hash_table->nnodes = 0;
+    hash_table->hash_func = hash_func ? hash_func : std_direct_hash;
+    hash_table->key_equal_func = key_equal_func;
+    hash_table->key_destroy_func = key_destroy_func;
+    hash_table->value_destroy_func = value_destroy_func;
+
+    if (std_ohash_table_alloc(hash_table, OHASH_MIN_SIZE) == -1) {
+        free(hash_table);
+        return NULL;
+    }
+
+    return hash_table;
+}
+
+void std_ohash_table_destroy(struct std_ohashtable *hash_table)
+{
+    unsigned int i;
+
+    if (!hash_table)
+        return;
+
+    for (i = 0; i < hash_table->size; i++) {
+        if (!(hash_table->tags[i] & 0x80))
+            std_ohash_table_remove_slot(hash_table, i, 1);
+    }
+
+    free(hash_table->tags);
+    free(hash_table->entries);
+    free(hash_table);
+}
+
+void *std_ohash_table_lookup(struct std_ohashtable *hash_table,
+        const void *key)
+{
+    int i;
+
+    if (!hash_table)
+        return NULL;
+
+    i = std_ohash_table_lookup_slot(hash_table, key, NULL);
+
+    return i != -1 ? hash_table->entries[i].value : NULL;
+}
+
+int std_ohash_table_lookup_extended(struct std_ohashtable *hash_table,
+        const void *lookup_key, void **orig_key, void **value)
+{
+    int i;
+
+    if (!hash_table)
+        return 0;
+
+    if ((i = std_ohash_table_lookup_slot(hash_table, lookup_key, NULL)) == -1)
+        return 0;
+
+    if (orig_key)
+        *orig_key = hash_table->entries[i].key;
+    if (value)
+        *value = hash_table->entries[i].value;
+
+    return 1;
+}
+
+/* Inserts the key, replacing the old key with it if keep_new_key is 1 */
+static void std_ohash_table_insert_internal(struct std_ohashtable
+        *hash_table, void *key, void *value, int keep_new_key)
+{
+    unsigned int slot;
+    int i;
+
+    if (!hash_table)
+        return;
+
+    if ((i = std_ohash_table_lookup_slot(hash_table, key, &slot)) != -1) {
+        if (keep_new_key) {
+            if (hash_table->key_destroy_func)
+                hash_table->key_destroy_func(hash_table->entries[i].key);
+            hash_table->entries[i].key = key;
+        } else if (hash_table->key_destroy_func)
+            hash_table->key_destroy_func(key);
+
+        if (hash_table->value_destroy_func)
+            hash_table->value_destroy_func(hash_table->entries[i].value);
+
+        hash_table->entries[i].value = value;
+        return;
+    }
+
+    /* Keep at least a quarter of the slots empty, so probes stay short */
+    if (hash_table->tags[slot] == OHASH_EMPTY &&
+            (hash_table->nnodes + hash_table->ndeleted + 1) * 4 >
+            hash_table->size * 3) {
+        std_ohash_table_resize(hash_table);
+        std_ohash_table_lookup_slot(hash_table, key, &slot);
+    }
+
+    if (hash_table->tags[slot] == OHASH_DELETED)
+        hash_table->ndeleted--;
+
+    hash_table->tags[slot] = OHASH_TAG(std_ohash_mix(hash_table, key));
+    hash_table->entries[slot].key = key;
+    hash_table->entries[slot].value = value;
+    hash_table->nnodes++;
+}
+
+void std_ohash_table_insert(struct std_ohashtable *hash_table,
+        void *key, void *value)
+{
+    std_ohash_table_insert_internal(hash_table, key, value, 0);
+}
+
+void std_ohash_table_replace(struct std_ohashtable *hash_table,
+        void *key, void *value)
+{
+    std_ohash_table_insert_internal(hash_table, key, value, 1);
+}
+
+/* Removes the key, calling the destroy functions if notify is 1 */
+static int std_ohash_table_remove_internal(struct std_ohashtable *hash_table,
+        const void *key, int notify)
+{
+    int i;
+
+    if (!hash_table)
+        return 0;
+
+    if ((i = std_ohash_table_lookup_slot(hash_table, key, NULL)) == -1)
+        return 0;
+
+    std_ohash_table_remove_slot(hash_table, i, notify);
+    std_ohash_table_maybe_shrink(hash_table);
+
+    return 1;
+}
+
+int std_ohash_table_remove(struct std_ohashtable *hash_table,
+        const void *key)
+{
+    return std_ohash_table_remove_internal(hash_table, key, 1);
+}
+
+int std_ohash_table_steal(struct std_ohashtable *hash_table, const void *key)
+{
+    return std_ohash_table_remove_internal(hash_table, key, 0);
+}
+
+void std_ohash_table_foreach(struct std_ohashtable *hash_table,
+        STDHFunc func, void *user_data)
+{
+    unsigned int i;
+
+    if (!hash_table || !func)
+        return;
+
+    for (i = 0; i < hash_table->size; i++) {
+        if (!(hash_table->tags[i] & 0x80))
+            (*func) (hash_table->entries[i].key, hash_table->entries[i].value,
+                    user_data);
+    }
+}
+
+void *std_ohash_table_find(struct std_ohashtable *hash_table,
+        STDHRFunc predicate, void *user_data)
+{
+    unsigned int i;
+
+    if (!hash_table || !predicate)
+        return NULL;
+
+    for (i = 0; i < hash_table->size; i++) {
+        if (!(hash_table->tags[i] & 0x80) &&
+                (*predicate) (hash_table->entries[i].key,
+                        hash_table->entries[i].value, user_data))
+            return hash_table->entries[i].value;
+    }
+
+    return NULL;
+}
+
+/* Removes the entries func returns 1 for, calling the destroy functions if
+ * notify is 1. The table is only resized once all of them are gone. */
+static unsigned int std_ohash_table_foreach_remove_or_steal(struct
+        std_ohashtable *hash_table, STDHRFunc func, void *user_data,
+        int notify)
+{
+    unsigned int i, deleted = 0;
+
+    if (!hash_table || !func)
+        return 0;
+
+    for (i = 0; i < hash_table->size; i++) {
+        if (!(hash_table->tags[i] & 0x80) &&
+                (*func) (hash_table->entries[i].key,
+                        hash_table->entries[i].value, user_data)) {
+            std_ohash_table_remove_slot(hash_table, i, notify);
+            deleted++;
+        }
+    }
+
+    std_ohash_table_maybe_shrink(hash_table);
+
+    return deleted;
+}
+
+unsigned int std_ohash_table_foreach_remove(struct std_ohashtable
+        *hash_table, STDHRFunc func, void *user_data)
+{
+    return std_ohash_table_foreach_remove_or_steal(hash_table, func,
+            user_data, 1);
+}
+
+unsigned int std_ohash_table_foreach_steal(struct std_ohashtable *hash_table,
+        STDHRFunc func, void *user_data)
+{
+    return std_ohash_table_foreach_remove_or_steal(hash_table, func,
+            user_data, 0);
+}
+
+unsigned int std_ohash_table_size(struct std_ohashtable *hash_table)
+{
+    return hash_table ? hash_table->nnodes : 0;
+}
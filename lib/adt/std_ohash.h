@@ -0,0 +1,259 @@
+#ifndef __STD_OHASH_H__
+#define __STD_OHASH_H__
+
+#include <stdlib.h>
+#include "std_types.h"
+#include "std_hash.h"
+
+/**
+ * A hash table with the same interface as std_hashtable, that keeps its
+ * entries in one array instead of chaining them. Nothing is allocated for
+ * each entry, and a lookup reads a run of one byte tags before it touches
+ * any keys.
+ *
+ * Use it for tables that are looked up often. std_hash_table_new()'s hash
+ * and equal functions all work with it.
+ */
+struct std_ohashtable;
+
+/**
+ * Creates a new hash table.
+ *
+ * \param hash_func
+ * A function to create a hash value from a key. If hash_func is NULL,
+ * std_direct_hash() is used.
+ *
+ * \param key_equal_func
+ * A function to check two keys for equality. If key_equal_func is NULL,
+ * keys are compared directly.
+ *
+ * @return
+ * A new hash table
+ */
+struct std_ohashtable *std_ohash_table_new(STDHashFunc hash_func,
+        STDEqualFunc key_equal_func);
+
+/**
+ * Creates a new hash table like std_ohash_table_new() and allows to specify
+ * functions to free the memory allocated for the key and value that get
+ * called when removing the entry from the hash table.
+ *
+ * \param hash_func
+ * A function to create a hash value from a key
+ *
+ * \param key_equal_func
+ * A function to check two keys for equality.
+ *
+ * \param key_destroy_func
+ * A function to free the key, or NULL.
+ *
+ * \param value_destroy_func
+ * A function to free the value, or NULL.
+ *
+ * @return
+ * A new hash table
+ */
+struct std_ohashtable *std_ohash_table_new_full(STDHashFunc hash_func,
+        STDEqualFunc key_equal_func,
+        STDDestroyNotify key_destroy_func, STDDestroyNotify value_destroy_func);
+
+/**
+ * Destroys the hash table, calling the destroy functions on all of the keys
+ * and values.
+ *
+ * \param hash_table
+ * The hash table to destroy
+ */
+void std_ohash_table_destroy(struct std_ohashtable *hash_table);
+
+/**
+ * Inserts a new key and value into a hash table.
+ *
+ * If the key already exists in the hash table its current value is replaced
+ * with the new value, and the passed key is freed. See
+ * std_hash_table_insert().
+ *
+ * \param hash_table
+ * The hash table to insert into
+ *
+ * \param key
+ * A key to insert
+ *
+ * \param value
+ * The value to associate with the key.
+ */
+void std_ohash_table_insert(struct std_ohashtable *hash_table,
+        void *key, void *value);
+
+/**
+ * Inserts a new key and value into a hash table like
+ * std_ohash_table_insert(), but if the key already exists the old key is
+ * replaced by the new one.
+ *
+ * \param hash_table
+ * The hash table to insert into
+ *
+ * \param key
+ * A key to insert
+ *
+ * \param value
+ * The value to associate with the key.
+ */
+void std_ohash_table_replace(struct std_ohashtable *hash_table,
+        void *key, void *value);
+
+/**
+ * Removes a key and its associated value from a hash table, freeing them
+ * with the destroy functions.
+ *
+ * \param hash_table
+ * The hash table to remove from.
+ *
+ * \param key
+ * The key to remove
+ *
+ * @return
+ * 1 if the key was found and removed from the hash table.
+ */
+int std_ohash_table_remove(struct std_ohashtable *hash_table,
+        const void *key);
+
+/**
+ * Removes a key and its associated value from a hash table without calling
+ * the key and value destroy functions.
+ *
+ * \param hash_table
+ * The hash to steal from
+ *
+ * \param key
+ * The key to remove
+ *
+ * @return
+ * 1 if the key was found and removed from the hash table.
+ */
+int std_ohash_table_steal(struct std_ohashtable *hash_table, const void *key);
+
+/**
+ * Looks up a key in a hash table.
+ *
+ * \param hash_table
+ * The hash table to look a key up in
+ *
+ * \param key
+ * The key to lookup
+ *
+ * @return
+ * The associated value, or NULL if the key is not found.
+ */
+void *std_ohash_table_lookup(struct std_ohashtable *hash_table,
+        const void *key);
+
+/**
+ * Looks up a key in the hash table, returning the original key and the
+ * associated value.
+ *
+ * \param hash_table
+ * The hash to lookup data in
+ *
+ * \param lookup_key
+ * The key to look up.
+ *
+ * \param orig_key
+ * returns the original key.
+ *
+ * \param value
+ * returns the value associated with the key.
+ *
+ * @return
+ * 1 if the key was found in the hash table.
+ */
+int std_ohash_table_lookup_extended(struct std_ohashtable *hash_table,
+        const void *lookup_key, void **orig_key, void **value);
+
+/**
+ * Calls the given function for each of the key/value pairs in the hash table.
+ * The hash table may not be modified while iterating over it.
+ *
+ * \param hash_table
+ * The hash to iterate over
+ *
+ * \param func
+ * The function to call for each key/value pair.
+ *
+ * \param user_data
+ * user data to pass to the function.
+ */
+void std_ohash_table_foreach(struct std_ohashtable *hash_table,
+        STDHFunc func, void *user_data);
+
+/**
+ * Calls the given function for key/value pairs in the hash table until
+ * predicate returns 1.
+ *
+ * \param hash_table
+ * The hash table
+ *
+ * \param predicate
+ * function to test the key/value pairs for a certain property.
+ *
+ * \param user_data
+ * user data to pass to the function.
+ *
+ * @return
+ * The value of the first key/value pair for which predicate returns 1, or
+ * NULL if there is none.
+ */
+void *std_ohash_table_find(struct std_ohashtable *hash_table,
+        STDHRFunc predicate, void *user_data);
+
+/**
+ * Calls the given function for each key/value pair in the hash table. If the
+ * function returns 1, then the key/value pair is removed from the hash table
+ * and freed with the destroy functions.
+ *
+ * \param hash_table
+ * The hash table
+ *
+ * \param func
+ * The function to call for each key/value pair.
+ *
+ * \param user_data
+ * user data to pass to the function.
+ *
+ * @return
+ * The number of key/value pairs removed.
+ */
+unsigned int std_ohash_table_foreach_remove(struct std_ohashtable
+        *hash_table, STDHRFunc func, void *user_data);
+
+/**
+ * Like std_ohash_table_foreach_remove(), but no key or value destroy
+ * functions are called.
+ *
+ * \param hash_table
+ * The hash table
+ *
+ * \param func
+ * The function to call for each key/value pair.
+ *
+ * \param user_data
+ * user data to pass to the function.
+ *
+ * @return
+ * the number of key/value pairs removed.
+ */
+unsigned int std_ohash_table_foreach_steal(struct std_ohashtable *hash_table,
+        STDHRFunc func, void *user_data);
+
+/**
+ * Returns the number of elements contained in the hash table.
+ *
+ * \param hash_table
+ * The hash table
+ *
+ * @return
+ * The number of key/value pairs in the hash table.
+ */
+unsigned int std_ohash_table_size(struct std_ohashtable *hash_table);
+
+#endif /* __STD_OHASH_H__ */
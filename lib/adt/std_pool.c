@@ -0,0 +1,112 @@
+#include "std_pool.h"
+
+/* The objects in the first block, each block after it has twice as many */
+#define STD_POOL_MIN_COUNT 16
+#define STD_POOL_MAX_COUNT 1024
+
+/* The objects are kept aligned for any of these */
+union std_pool_align {
+    void *pointer;
+    long integer;
+    double real;
+};
+
+/* A block of objects, they follow the header */
+struct std_pool_block {
+    struct std_pool_block *next;
+    union std_pool_align align;
+};
+
+/* A free object, it holds the next free object */
+struct std_pool_object {
+    struct std_pool_object *next;
+};
+
+struct std_pool {
+    size_t object_size;
+    struct std_pool_block *blocks;  /* The newest block is first */
+    int count;                  /* The number of objects in the newest block */
+    int used;                   /* The objects handed out of the newest block */
+    struct std_pool_object *free_objects;   /* Objects given back */
+};
+
+struct std_pool *std_pool_create(size_t object_size)
+{
+    struct std_pool *pool = malloc(sizeof (struct std_pool));
+
+    if (!pool)
+        return NULL;
+
+    /* Room for the free list, and the next object stays aligned */
+    if (object_size < sizeof (struct std_pool_object))
+        object_size = sizeof (struct std_pool_object);
+    object_size = (object_size + sizeof (union std_pool_align) - 1) /
+            sizeof (union std_pool_align) * sizeof (union std_pool_align);
+
+    pool->object_size = object_size;
+    pool->blocks = NULL;
+    pool->count = 0;
+    pool->used = 0;
+    pool->free_objects = NULL;
+
+    return pool;
+}
+
+void std_pool_destroy(struct std_pool *pool)
+{
+    struct std_pool_block *block, *next;
+
+    if (!pool)
+        return;
+
+    for (block = pool->blocks; block; block = next) {
+        next = block->next;
+        free(block);
+    }
+
+    free(pool);
+}
+
+void *std_pool_alloc(struct std_pool *pool)
+{
+    struct std_pool_object *object;
+    struct std_pool_block *block;
+    int count;
+
+    if (!pool)
+        return NULL;
+
+    if ((object = pool->free_objects) != NULL) {
+        pool->free_objects = object->next;
+        return object;
+    }
+
+    if (pool->used == pool->count) {
+        count = pool->count ? pool->count * 2 : STD_POOL_MIN_COUNT;
+        if (count > STD_POOL_MAX_COUNT)
+            count = STD_POOL_MAX_COUNT;
+
+        block = malloc(sizeof (struct std_pool_block) +
+                pool->object_size * count);
+        if (!block)
+            return NULL;
+
+        block->next = pool->blocks;
+        pool->blocks = block;
+        pool->count = count;
+        pool->used = 0;
+    }
+
+    return (char *) (pool->blocks + 1) + pool->object_size * pool->used++;
+}
+
+void std_pool_free(struct std_pool *pool, void *object)
+{
+    struct std_pool_object *free_object = object;
+
+    if (!pool || !object)
+        return;
+
+    free_object->next = pool->free_objects;
+    pool->free_objects = free_object;
+}
@@ -0,0 +1,57 @@
+#ifndef __STD_POOL_H__
+#define __STD_POOL_H__
+
+#include <stdlib.h>
+
+/**
+ * A pool of objects that are all the same size.
+ *
+ * The objects are carved out of blocks that get bigger as the pool grows,
+ * and freed objects are kept to be handed out again. Building up a list and
+ * tearing it down again goes through the pool instead of malloc and free.
+ * The memory is only given back when the pool is destroyed.
+ */
+struct std_pool;
+
+/**
+ * Creates a new pool.
+ *
+ * \param object_size
+ * The size of each object in the pool.
+ *
+ * @return
+ * A new pool, or NULL on error.
+ */
+struct std_pool *std_pool_create(size_t object_size);
+
+/**
+ * Destroys the pool, and every object that came from it.
+ *
+ * \param pool
+ * The pool to destroy
+ */
+void std_pool_destroy(struct std_pool *pool);
+
+/**
+ * Gets an object from the pool. Its contents are undefined.
+ *
+ * \param pool
+ * The pool to get the object from
+ *
+ * @return
+ * The object, or NULL on error.
+ */
+void *std_pool_alloc(struct std_pool *pool);
+
+/**
+ * Gives an object back to the pool, to be handed out again.
+ *
+ * \param pool
+ * The pool the object came from
+ *
+ * \param object
+ * The object to give back
+ */
+void std_pool_free(struct std_pool *pool, void *object);
+
+#endif /* __STD_POOL_H__ */
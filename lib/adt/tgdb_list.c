@@ -1,4 +1,5 @@
 #include "tgdb_list.h"
+#include "std_pool.h"
 #include "sys_util.h"
 
 struct tgdb_list_node {
@@ -11,6 +12,9 @@ struct tgdb_list {
     int size;
     struct tgdb_list_node *head;
     struct tgdb_list_node *tail;
+    /* The nodes come from here, and go back when they're deleted. It's
+     * created with the first node. */
+    struct std_pool *pool;
 };
 
 struct tgdb_list *tgdb_list_init(void)
@@ -23,6 +27,7 @@ struct tgdb_list *tgdb_list_init(void)
     list->size = 0;
     list->head = NULL;
     list->tail = NULL;
+    list->pool = NULL;
 
     return list;
 }
@@ -32,6 +37,8 @@ int tgdb_list_destroy(struct tgdb_list *list)
     if (!list)
         return -1;
 
+    /* This frees the nodes still in the list too */
+    std_pool_destroy(list->pool);
     free(list);
     list = NULL;
 
@@ -130,7 +137,6 @@ static void tgdb_list_delete(struct tgdb_list *list,
 
         node->next = NULL;
         node->prev = NULL;
-        node = NULL;
 
         list->head = NULL;
         list->tail = NULL;
@@ -140,7 +146,6 @@ static void tgdb_list_delete(struct tgdb_list *list,
         /* Only the head is populated, free it */
         node->next = NULL;
         node->prev = NULL;
-        node = NULL;
 
         list->head = NULL;
         list->tail = NULL;
@@ -152,7 +157,6 @@ static void tgdb_list_delete(struct tgdb_list *list,
 
         node->next = NULL;
         node->prev = NULL;
-        node = NULL;
 
         /* If the list is size 2, remove the tail and set only the head */
         if (tgdb_list_size(list) == 2)
@@ -166,7 +170,6 @@ static void tgdb_list_delete(struct tgdb_list *list,
 
         node->next = NULL;
         node->prev = NULL;
-        node = NULL;
 
         /* Delete from middle of list */
     } else {
@@ -175,18 +178,22 @@ static void tgdb_list_delete(struct tgdb_list *list,
 
         node->next = NULL;
         node->prev = NULL;
-        node = NULL;
     }
 
     list->size--;
+    std_pool_free(list->pool, node);
 }
 
-static struct tgdb_list_node *tgdb_list_new_node(void)
+static struct tgdb_list_node *tgdb_list_new_node(struct tgdb_list *list)
 {
     struct tgdb_list_node *node;
 
-    node = (struct tgdb_list_node *) cgdb_malloc(sizeof (struct
-                    tgdb_list_node));
+    if (!list->pool &&
+            !(list->pool = std_pool_create(sizeof (struct tgdb_list_node))))
+        return NULL;
+
+    if ((node = std_pool_alloc(list->pool)) == NULL)
+        return NULL;
 
     node->data = (void *) NULL;
     node->next = NULL;
@@ -202,7 +209,7 @@ int tgdb_list_append(struct tgdb_list *tlist, void *item)
     if (!tlist)
         return -1;
 
-    if ((node = tgdb_list_new_node()) == NULL)
+    if ((node = tgdb_list_new_node(tlist)) == NULL)
         return -1;
 
     node->data = item;
@@ -219,7 +226,7 @@ int tgdb_list_prepend(struct tgdb_list *tlist, void *item)
     if (!tlist)
         return -1;
 
-    if ((node = tgdb_list_new_node()) == NULL)
+    if ((node = tgdb_list_new_node(tlist)) == NULL)
         return -1;
 
     node->data = item;
@@ -237,7 +244,7 @@ int tgdb_list_insert_after(struct tgdb_list *tlist,
     if (!tlist)
         return -1;
 
-    if ((node = tgdb_list_new_node()) == NULL)
+    if ((node = tgdb_list_new_node(tlist)) == NULL)
         return -1;
 
     node->data = item;
@@ -256,7 +263,7 @@ int tgdb_list_insert_before(struct tgdb_list *tlist,
     if (!tlist)
         return -1;
 
-    if ((node = tgdb_list_new_node()) == NULL)
+    if ((node = tgdb_list_new_node(tlist)) == NULL)
         return -1;
 
     node->data = item;
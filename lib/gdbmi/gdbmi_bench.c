@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include "gdbmi_pt.h"
+#include "gdbmi_parser.h"
+#include "bench.h"
+
+/* What parsing a file once finds */
+struct bench_result {
+    unsigned long records;
+    unsigned long failed;
+    unsigned long mallocs;
+};
+
+/* A file being parsed */
+struct bench_file {
+    gdbmi_parser_ptr parser;
+    const char *data;
+    size_t length;
+    struct bench_result result;
+};
+
+static void usage(char *progname)
+{
+    printf("%s [-l] [-n repetitions] <file> ...\n", progname);
+    printf("  -l  Parse lazily, like the front end does\n");
+    printf("  -n  Parse each file this many times, 100 by default\n");
+    printf("\nEach file is parsed a line at a time, and a line of JSON\n"
+            "is written for it.\n");
+    exit(-1);
+}
+
+static long peak_rss_kb(void)
+{
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) == -1)
+        return -1;
+
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+static char *read_file(const char *path, size_t *length)
+{
+    FILE *file;
+    char *data = NULL;
+    size_t size = 0, count;
+
+    file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "%s:%d Can't open %s\n", __FILE__, __LINE__, path);
+        return NULL;
+    }
+
+    *length = 0;
+    do {
+        if (*length == size) {
+            size = size ? size * 2 : 65536;
+            data = realloc(data, size);
+            if (!data) {
+                fprintf(stderr, "%s:%d", __FILE__, __LINE__);
+                fclose(file);
+                return NULL;
+            }
+        }
+
+        count = fread(data + *length, 1, size - *length, file);
+        *length += count;
+    } while (count > 0);
+
+    fclose(file);
+
+    return data;
+}
+
+/* Parses the lines of a file the way the front end gets them from GDB,
+ * one record at a time */
+static int bench_data(void *context)
+{
+    struct bench_file *file = (struct bench_file *) context;
+    const char *data = file->data, *line, *end;
+    size_t length = file->length;
+    unsigned long mallocs = gdbmi_arena_malloc_count();
+    gdbmi_output_ptr output;
+    int parse_failed;
+
+    memset(&file->result, 0, sizeof (struct bench_result));
+
+    for (line = data; line < data + length; line = end) {
+        end = memchr(line, '\n', data + length - line);
+        end = end ? end + 1 : data + length;
+
+        if (gdbmi_parser_parse_span(file->parser, line, end - line, &output,
+                        &parse_failed) == -1) {
+            fprintf(stderr, "%s:%d", __FILE__, __LINE__);
+            return -1;
+        }
+
+        if (parse_failed)
+            file->result.failed++;
+        else if (strncmp(line, "(gdb)", 5) != 0)
+            file->result.records++;
+
+        if (output)
+            destroy_gdbmi_output(output);
+    }
+
+    file->result.mallocs = gdbmi_arena_malloc_count() - mallocs;
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    struct bench_file file;
+    struct bench bench;
+    int lazy = 0, repetitions = 100, opt, i, failed = 0;
+    const char *name;
+    char *data;
+
+    while ((opt = getopt(argc, argv, "ln:")) != -1) {
+        switch (opt) {
+            case 'l':
+                lazy = 1;
+                break;
+            case 'n':
+                repetitions = atoi(optarg);
+                if (repetitions <= 0)
+                    usage(argv[0]);
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+
+    if (optind == argc)
+        usage(argv[0]);
+
+    file.parser = gdbmi_parser_create();
+    if (!file.parser) {
+        fprintf(stderr, "%s:%d", __FILE__, __LINE__);
+        return -1;
+    }
+
+    gdbmi_parser_set_lazy(file.parser, lazy);
+
+    for (i = optind; i < argc; i++) {
+        data = read_file(argv[i], &file.length);
+        if (!data)
+            return -1;
+        file.data = data;
+
+        /* The same wherever the build is */
+        name = strrchr(argv[i], '/') ? strrchr(argv[i], '/') + 1 : argv[i];
+        bench_init(&bench, "gdbmi", repetitions, "%s %s", name,
+                lazy ? "lazy" : "eager");
+        bench.items = file.length;
+        bench.unit = "bytes";
+        if (bench_run(&bench, bench_data, &file) == -1)
+            return -1;
+
+        bench_print(&bench, "\"records\": %lu, \"failed\": %lu, "
+                "\"records_per_s\": %.0f, "
+                "\"arena_mallocs_per_record\": %.3f, \"peak_rss_kb\": %ld",
+                file.result.records, file.result.failed,
+                file.result.records * 1e9 /
+                (bench.wall_median ? bench.wall_median : 1),
+                (double) file.result.mallocs /
+                (file.result.records ? file.result.records : 1),
+                peak_rss_kb());
+
+        failed += file.result.failed != 0;
+        free(data);
+    }
+
+    gdbmi_parser_destroy(file.parser);
+
+    return failed ? 1 : 0;
+}
@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.3a+.  */
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -42,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.3a+"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -60,740 +63,761 @@
 /* Pull parsers.  */
 #define YYPULL 0
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
 
 /* Substitute the variable and function names.  */
 #define yypush_parse    gdbmi_push_parse
 #define yypstate_new    gdbmi_pstate_new
+#define yypstate_clear  gdbmi_pstate_clear
 #define yypstate_delete gdbmi_pstate_delete
 #define yypstate        gdbmi_pstate
 #define yylex           gdbmi_lex
 #define yyerror         gdbmi_error
-#define yylval          gdbmi_lval
-#define yychar          gdbmi_char
 #define yydebug         gdbmi_debug
 #define yynerrs         gdbmi_nerrs
 
-/* Copy the first part of user declarations.  */
 
-/* Line 189 of yacc.c  */
-#line 8 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "gdbmi_grammar.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_OPEN_BRACE = 3,                 /* OPEN_BRACE  */
+  YYSYMBOL_CLOSED_BRACE = 4,               /* CLOSED_BRACE  */
+  YYSYMBOL_OPEN_PAREN = 5,                 /* OPEN_PAREN  */
+  YYSYMBOL_CLOSED_PAREN = 6,               /* CLOSED_PAREN  */
+  YYSYMBOL_ADD_OP = 7,                     /* ADD_OP  */
+  YYSYMBOL_MULT_OP = 8,                    /* MULT_OP  */
+  YYSYMBOL_EQUAL_SIGN = 9,                 /* EQUAL_SIGN  */
+  YYSYMBOL_TILDA = 10,                     /* TILDA  */
+  YYSYMBOL_AT_SYMBOL = 11,                 /* AT_SYMBOL  */
+  YYSYMBOL_AMPERSAND = 12,                 /* AMPERSAND  */
+  YYSYMBOL_OPEN_BRACKET = 13,              /* OPEN_BRACKET  */
+  YYSYMBOL_CLOSED_BRACKET = 14,            /* CLOSED_BRACKET  */
+  YYSYMBOL_NEWLINE = 15,                   /* NEWLINE  */
+  YYSYMBOL_INTEGER_LITERAL = 16,           /* INTEGER_LITERAL  */
+  YYSYMBOL_STRING_LITERAL = 17,            /* STRING_LITERAL  */
+  YYSYMBOL_CSTRING = 18,                   /* CSTRING  */
+  YYSYMBOL_LAZY_VALUE = 19,                /* LAZY_VALUE  */
+  YYSYMBOL_COMMA = 20,                     /* COMMA  */
+  YYSYMBOL_CARROT = 21,                    /* CARROT  */
+  YYSYMBOL_YYACCEPT = 22,                  /* $accept  */
+  YYSYMBOL_output_list = 23,               /* output_list  */
+  YYSYMBOL_output = 24,                    /* output  */
+  YYSYMBOL_record_list = 25,               /* record_list  */
+  YYSYMBOL_result_record = 26,             /* result_record  */
+  YYSYMBOL_oob_record = 27,                /* oob_record  */
+  YYSYMBOL_async_record = 28,              /* async_record  */
+  YYSYMBOL_async_record_class = 29,        /* async_record_class  */
+  YYSYMBOL_result_class = 30,              /* result_class  */
+  YYSYMBOL_async_class = 31,               /* async_class  */
+  YYSYMBOL_result_list = 32,               /* result_list  */
+  YYSYMBOL_result = 33,                    /* result  */
+  YYSYMBOL_variable = 34,                  /* variable  */
+  YYSYMBOL_value_list = 35,                /* value_list  */
+  YYSYMBOL_value = 36,                     /* value  */
+  YYSYMBOL_tuple = 37,                     /* tuple  */
+  YYSYMBOL_list = 38,                      /* list  */
+  YYSYMBOL_stream_record = 39,             /* stream_record  */
+  YYSYMBOL_stream_record_class = 40,       /* stream_record_class  */
+  YYSYMBOL_opt_token = 41,                 /* opt_token  */
+  YYSYMBOL_token = 42                      /* token  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+/* Unqualified %code blocks.  */
+#line 30 "gdbmi_grammar.y"
 
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include "gdbmi_pt.h"
+#include "gdbmi_keyword.h"
+
+/* flex */
+extern char *gdbmi_get_text (void *scanner);
+extern int gdbmi_get_lineno (void *scanner);
+
+void gdbmi_error (gdbmi_pdata_ptr gdbmi_pdata, void *gdbmi_scanner,
+		  const char *s)
+{ 
+  const char *text = gdbmi_get_text (gdbmi_scanner);
+
+  fprintf (stderr, "%s:%d Error %s", __FILE__, __LINE__, s);
+  if (strcmp (text, "\n") == 0)
+    fprintf (stderr, "%s:%d at end of line %d\n", __FILE__, __LINE__, 
+	     gdbmi_get_lineno (gdbmi_scanner));
+  else 
+    fprintf (stderr, "%s:%d at token(%s), line (%d)\n", __FILE__, __LINE__, 
+	     text, gdbmi_get_lineno (gdbmi_scanner));
+}
 
-extern char *gdbmi_text;
-extern int gdbmi_lex(void);
-extern int gdbmi_lineno;
-
-void gdbmi_error(gdbmi_pdata_ptr gdbmi_pdata, const char *s)
+/* Copies the text of a token into a string of the tree */
+static char *gdbmi_text_dup (gdbmi_arena_ptr arena,
+			     const struct gdbmi_text *text)
 {
-    fprintf(stderr, "%s:%d Error %s", __FILE__, __LINE__, s);
-    if (strcmp(gdbmi_text, "\n") == 0)
-        fprintf(stderr, "%s:%d at end of line %d\n", __FILE__, __LINE__,
-                gdbmi_lineno);
-    else {
-        fprintf(stderr, "%s:%d at token(%s), line (%d)\n", __FILE__, __LINE__,
-                gdbmi_text, gdbmi_lineno);
-        gdbmi_lex();
-        fprintf(stderr, "%s:%d before (%s)\n", __FILE__, __LINE__, gdbmi_text);
-    }
+  return gdbmi_arena_strndup (arena, text->data, text->length);
 }
 
-/* Line 189 of yacc.c  */
-#line 111 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.c"
+/* Makes a c-string of the tree out of a CSTRING token, leaving its
+   escapes for when it's read */
+static void gdbmi_text_cstring (gdbmi_arena_ptr arena,
+				const struct gdbmi_text *text,
+				struct gdbmi_cstring *cstring)
+{
+  /* The quotes are left out */
+  cstring->length = text->length - 2;
+  cstring->data = gdbmi_arena_strndup (arena, text->data + 1,
+				       cstring->length);
+  cstring->escaped = memchr (text->data + 1, '\\', cstring->length) != NULL;
+}
 
-/* Enabling traces.  */
-#ifndef YYDEBUG
-#define YYDEBUG 0
-#endif
+/* Compares the text of a token with a string */
+static int gdbmi_text_is (const struct gdbmi_text *text, const char *s)
+{
+  return strlen (s) == text->length &&
+    strncmp (s, text->data, text->length) == 0;
+}
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-#undef YYERROR_VERBOSE
-#define YYERROR_VERBOSE 1
-#else
-#define YYERROR_VERBOSE 0
-#endif
+/* The number in the text of a token, which isn't null terminated */
+static long gdbmi_text_number (const struct gdbmi_text *text)
+{
+  long result = 0;
+  size_t i;
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-#define YYTOKEN_TABLE 0
-#endif
+  for (i = 0; i < text->length; i++)
+    result = result * 10 + (text->data[i] - '0');
 
-/* "%code requires" blocks.  */
-
-/* Line 209 of yacc.c  */
-#line 5 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-struct gdbmi_pdata;
-
-/* Line 209 of yacc.c  */
-#line 139 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.c"
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-#define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-enum yytokentype {
-    OPEN_BRACE = 258,
-    CLOSED_BRACE = 259,
-    OPEN_PAREN = 260,
-    CLOSED_PAREN = 261,
-    ADD_OP = 262,
-    MULT_OP = 263,
-    EQUAL_SIGN = 264,
-    TILDA = 265,
-    AT_SYMBOL = 266,
-    AMPERSAND = 267,
-    OPEN_BRACKET = 268,
-    CLOSED_BRACKET = 269,
-    NEWLINE = 270,
-    INTEGER_LITERAL = 271,
-    STRING_LITERAL = 272,
-    CSTRING = 273,
-    COMMA = 274,
-    CARROT = 275
-};
-#endif
-/* Tokens.  */
-#define OPEN_BRACE 258
-#define CLOSED_BRACE 259
-#define OPEN_PAREN 260
-#define CLOSED_PAREN 261
-#define ADD_OP 262
-#define MULT_OP 263
-#define EQUAL_SIGN 264
-#define TILDA 265
-#define AT_SYMBOL 266
-#define AMPERSAND 267
-#define OPEN_BRACKET 268
-#define CLOSED_BRACKET 269
-#define NEWLINE 270
-#define INTEGER_LITERAL 271
-#define STRING_LITERAL 272
-#define CSTRING 273
-#define COMMA 274
-#define CARROT 275
-
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE {
-
-/* Line 214 of yacc.c  */
-#line 53 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-
-    struct gdbmi_output *u_output;
-    struct gdbmi_oob_record *u_oob_record;
-    struct gdbmi_result_record *u_result_record;
-    int u_result_class;
-    int u_async_record_choice;
-    struct gdbmi_result *u_result;
-    long u_token;
-    struct gdbmi_async_record *u_async_record;
-    struct gdbmi_stream_record *u_stream_record;
-    int u_async_class;
-    char *u_variable;
-    struct gdbmi_value *u_value;
-    struct gdbmi_tuple *u_tuple;
-    struct gdbmi_list *u_list;
-    int u_stream_record_choice;
-
-/* Line 214 of yacc.c  */
-#line 216 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.c"
-} YYSTYPE;
-
-#define YYSTYPE_IS_TRIVIAL 1
-#define yystype YYSTYPE         /* obsolescent; will be withdrawn */
-#define YYSTYPE_IS_DECLARED 1
-#endif
+  return result;
+}
 
-#ifndef YYPUSH_DECLS
-#define YYPUSH_DECLS
-struct yypstate;
-typedef struct yypstate yypstate;
-enum { YYPUSH_MORE = 4 };
+#line 220 "gdbmi_grammar.c"
 
-#if defined __STDC__ || defined __cplusplus
-int yypush_parse(yypstate * yyps, int yypushed_char,
-        YYSTYPE const *yypushed_val, struct gdbmi_pdata *gdbmi_pdata);
-#else
-int yypush_parse();
+#ifdef short
+# undef short
 #endif
 
-#if defined __STDC__ || defined __cplusplus
-yypstate *yypstate_new(void);
-#else
-yypstate *yypstate_new();
-#endif
-#if defined __STDC__ || defined __cplusplus
-void yypstate_delete(yypstate * yyps);
-#else
-void yypstate_delete();
-#endif
-#endif
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Copy the second part of user declarations.  */
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-/* Line 264 of yacc.c  */
-#line 252 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.c"
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-#undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
 typedef unsigned char yytype_uint8;
-#endif
-
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
 #else
-typedef short int yytype_int8;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef int yytype_uint16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
-#else
-typedef short int yytype_int16;
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
-#ifdef __SIZE_TYPE__
-#define YYSIZE_T __SIZE_TYPE__
-#elif defined size_t
-#define YYSIZE_T size_t
-#elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-#include <stddef.h>             /* INFRINGES ON USER NAME SPACE */
-#define YYSIZE_T size_t
-#else
-#define YYSIZE_T unsigned int
-#endif
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
-#if YYENABLE_NLS
-#if ENABLE_NLS
-#include <libintl.h>            /* INFRINGES ON USER NAME SPACE */
-#define YY_(msgid) dgettext ("bison-runtime", msgid)
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
 #endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
-#ifndef YY_
-#define YY_(msgid) msgid
-#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-#define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-#define YYUSE(e)                /* empty */
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-#define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int YYID(int yyi)
-#else
-static int YYID(yyi)
-     int yyi;
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
 #endif
-{
-    return yyi;
-}
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
 
-#ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
-#ifndef YYSTACK_ALLOC_MAXIMUM
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
        invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
        to allow for a few compiler-allocated temporary stack slots.  */
-#define YYSTACK_ALLOC_MAXIMUM 4032  /* reasonable circa 2006 */
-#endif
-#else
-#define YYSTACK_ALLOC YYMALLOC
-#define YYSTACK_FREE YYFREE
-#ifndef YYSTACK_ALLOC_MAXIMUM
-#define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
-#endif
-#if (defined __cplusplus && ! defined _STDLIB_H \
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
-#include <stdlib.h>             /* INFRINGES ON USER NAME SPACE */
-#ifndef _STDLIB_H
-#define _STDLIB_H 1
-#endif
-#endif
-#ifndef YYMALLOC
-#define YYMALLOC malloc
-#if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-void *malloc(YYSIZE_T);         /* INFRINGES ON USER NAME SPACE */
-#endif
-#endif
-#ifndef YYFREE
-#define YYFREE free
-#if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-void free(void *);              /* INFRINGES ON USER NAME SPACE */
-#endif
-#endif
-#endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
-union yyalloc {
-    yytype_int16 yyss_alloc;
-    YYSTYPE yyvs_alloc;
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-#define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
-#define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-#ifndef YYCOPY
-#if defined __GNUC__ && 1 < __GNUC__
-#define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#else
-#define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#endif
-#endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-#define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  4
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   46
+#define YYLAST   47
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  21
+#define YYNTOKENS  22
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  22
+#define YYNNTS  21
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  40
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  61
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   275
-
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
-
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] = {
-    0, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 1, 2, 3, 4,
-    5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
-    15, 16, 17, 18, 19, 20
-};
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   276
 
-#if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] = {
-    0, 0, 3, 5, 8, 15, 16, 20, 21, 24,
-    28, 34, 36, 38, 42, 48, 50, 52, 54, 56,
-    58, 60, 64, 68, 70, 72, 76, 78, 80, 82,
-    85, 89, 92, 96, 100, 103, 105, 107, 109, 110,
-    112
-};
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] = {
-    22, 0, -1, 23, -1, 22, 23, -1, 24, 25,
-    5, 34, 6, 15, -1, -1, 24, 27, 15, -1,
-    -1, 26, 15, -1, 41, 20, 30, -1, 41, 20,
-    30, 19, 32, -1, 28, -1, 39, -1, 41, 29,
-    31, -1, 41, 29, 31, 19, 32, -1, 8, -1,
-    7, -1, 9, -1, 17, -1, 17, -1, 33, -1,
-    32, 19, 33, -1, 34, 9, 36, -1, 17, -1,
-    36, -1, 35, 19, 36, -1, 18, -1, 37, -1,
-    38, -1, 3, 4, -1, 3, 32, 4, -1, 13,
-    14, -1, 13, 35, 14, -1, 13, 32, 14, -1,
-    40, 18, -1, 10, -1, 11, -1, 12, -1, -1,
-    42, -1, 16, -1
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21
 };
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] = {
-    0, 96, 96, 100, 105, 116, 120, 124, 128, 132,
-    139, 146, 152, 158, 165, 173, 177, 181, 185, 200,
-    207, 211, 215, 221, 225, 229, 233, 239, 245, 251,
-    255, 260, 264, 270, 276, 282, 286, 290, 294, 298,
-    302
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   157,   157,   162,   167,   181,   185,   190,   195,   202,
+     209,   215,   221,   228,   236,   240,   244,   248,   272,   306,
+     310,   314,   321,   325,   329,   333,   339,   345,   351,   359,
+     363,   368,   372,   378,   384,   390,   394,   398,   402,   406,
+     410
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
-static const char *const yytname[] = {
-    "$end", "error", "$undefined", "OPEN_BRACE", "CLOSED_BRACE",
-    "OPEN_PAREN", "CLOSED_PAREN", "ADD_OP", "MULT_OP", "EQUAL_SIGN", "TILDA",
-    "AT_SYMBOL", "AMPERSAND", "OPEN_BRACKET", "CLOSED_BRACKET", "NEWLINE",
-    "INTEGER_LITERAL", "STRING_LITERAL", "CSTRING", "COMMA", "CARROT",
-    "$accept", "output_list", "output", "opt_oob_record_list",
-    "opt_result_record", "result_record", "oob_record", "async_record",
-    "async_record_class", "result_class", "async_class", "result_list",
-    "result", "variable", "value_list", "value", "tuple", "list",
-    "stream_record", "stream_record_class", "opt_token", "token", 0
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "OPEN_BRACE",
+  "CLOSED_BRACE", "OPEN_PAREN", "CLOSED_PAREN", "ADD_OP", "MULT_OP",
+  "EQUAL_SIGN", "TILDA", "AT_SYMBOL", "AMPERSAND", "OPEN_BRACKET",
+  "CLOSED_BRACKET", "NEWLINE", "INTEGER_LITERAL", "STRING_LITERAL",
+  "CSTRING", "LAZY_VALUE", "COMMA", "CARROT", "$accept", "output_list",
+  "output", "record_list", "result_record", "oob_record", "async_record",
+  "async_record_class", "result_class", "async_class", "result_list",
+  "result", "variable", "value_list", "value", "tuple", "list",
+  "stream_record", "stream_record_class", "opt_token", "token", YY_NULLPTR
 };
-#endif
 
-#ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] = {
-    0, 256, 257, 258, 259, 260, 261, 262, 263, 264,
-    265, 266, 267, 268, 269, 270, 271, 272, 273, 274,
-    275
-};
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
 #endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] = {
-    0, 21, 22, 22, 23, 24, 24, 25, 25, 26,
-    26, 27, 27, 28, 28, 29, 29, 29, 30, 31,
-    32, 32, 33, 34, 35, 35, 36, 36, 36, 37,
-    37, 38, 38, 38, 39, 40, 40, 40, 41, 41,
-    42
-};
+#define YYPACT_NINF (-39)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  0
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] = {
-    0, 2, 1, 2, 6, 0, 3, 0, 2, 3,
-    5, 1, 1, 3, 5, 1, 1, 1, 1, 1,
-    1, 3, 3, 1, 1, 3, 1, 1, 1, 2,
-    3, 2, 3, 3, 2, 1, 1, 1, 0, 1,
-    1
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int8 yypact[] =
+{
+     -39,     5,   -39,    22,   -39,   -39,    -9,   -39,   -39,   -39,
+     -39,     4,    10,   -39,   -39,    11,    15,   -39,   -39,    24,
+     -39,   -39,   -39,   -39,   -39,   -39,    18,    20,    13,   -39,
+      21,   -39,    23,   -39,    -9,    -9,    25,   -39,    33,    25,
+      -9,    -1,   -39,     9,    -3,   -39,   -39,   -39,   -39,   -39,
+     -39,     0,   -39,   -13,   -11,   -39,   -39,   -39,   -39,    -1,
+     -39
 };
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
    means the default is an error.  */
-static const yytype_uint8 yydefact[] = {
-    5, 5, 2, 38, 1, 3, 35, 36, 37, 40,
-    0, 0, 0, 11, 12, 0, 0, 39, 0, 8,
-    6, 34, 16, 15, 17, 0, 0, 23, 0, 18,
-    9, 19, 13, 0, 0, 0, 4, 10, 20, 0,
-    14, 0, 0, 21, 0, 0, 26, 22, 27, 28,
-    29, 0, 31, 0, 0, 24, 30, 33, 32, 0,
-    25
+static const yytype_int8 yydefact[] =
+{
+       5,     5,     2,    38,     1,     3,     0,    35,    36,    37,
+      40,     0,     0,    10,    11,     0,     0,    39,    22,     0,
+       7,     6,    34,    15,    14,    16,     0,     0,     0,    17,
+       8,    18,    12,     4,     0,     0,     9,    19,     0,    13,
+       0,     0,    20,     0,     0,    25,    28,    21,    26,    27,
+      29,     0,    31,     0,     0,    23,    30,    33,    32,     0,
+      24
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
+{
+     -39,   -39,    43,   -39,   -39,   -39,   -39,   -39,   -39,   -39,
+      -4,     6,    41,   -39,   -38,   -39,   -39,   -39,   -39,   -39,
+     -39
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] = {
-    -1, 1, 2, 3, 10, 11, 12, 13, 26, 30,
-    32, 37, 38, 39, 54, 47, 48, 49, 14, 15,
-    16, 17
+static const yytype_int8 yydefgoto[] =
+{
+       0,     1,     2,     3,    11,    12,    13,    27,    30,    32,
+      36,    37,    38,    54,    47,    48,    49,    14,    15,    16,
+      17
 };
 
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -40
-static const yytype_int8 yypact[] = {
-    -40, 7, -40, 19, -40, -40, -40, -40, -40, -40,
-    -4, -6, -2, -40, -40, 10, 14, -40, 16, -40,
-    -40, -40, -40, -40, -40, 20, 21, -40, 30, -40,
-    22, -40, 23, 24, 16, 16, -40, 25, -40, 31,
-    25, 16, -1, -40, 1, -3, -40, -40, -40, -40,
-    -40, 0, -40, -11, 13, -40, -40, -40, -40, -1,
-    -40
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
+{
+      43,    57,    43,    58,    56,     4,    55,    40,    18,    59,
+      44,    52,    44,    50,    18,    45,    46,    45,    46,    20,
+      40,    60,    23,    24,    25,    21,    18,     6,    33,    22,
+      28,    39,     7,     8,     9,    29,    26,    31,    10,    51,
+      53,    34,    41,    35,     5,    40,    42,    19
 };
 
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] = {
-    -40, -40, 42, -40, -40, -40, -40, -40, -40, -40,
-    -40, -19, 4, 28, -40, -39, -40, -40, -40, -40,
-    -40, -40
+static const yytype_int8 yycheck[] =
+{
+       3,    14,     3,    14,     4,     0,    44,    20,    17,    20,
+      13,    14,    13,     4,    17,    18,    19,    18,    19,    15,
+      20,    59,     7,     8,     9,    15,    17,     5,    15,    18,
+       6,    35,    10,    11,    12,    17,    21,    17,    16,    43,
+      44,    20,     9,    20,     1,    20,    40,     6
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -8
-static const yytype_int8 yytable[] = {
-    44, 18, 44, 57, 56, 50, 55, 4, 41, 19,
-    45, 52, 45, 20, 27, 46, 40, 46, 27, 41,
-    60, 22, 23, 24, -7, 51, 53, 58, 21, 6,
-    7, 8, 59, 27, 25, 9, 33, 29, 31, 36,
-    42, 34, 35, 5, 41, 43, 28
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,    23,    24,    25,     0,    24,     5,    10,    11,    12,
+      16,    26,    27,    28,    39,    40,    41,    42,    17,    34,
+      15,    15,    18,     7,     8,     9,    21,    29,     6,    17,
+      30,    17,    31,    15,    20,    20,    32,    33,    34,    32,
+      20,     9,    33,     3,    13,    18,    19,    36,    37,    38,
+       4,    32,    14,    32,    35,    36,     4,    14,    14,    20,
+      36
 };
 
-static const yytype_uint8 yycheck[] = {
-    3, 5, 3, 14, 4, 4, 45, 0, 19, 15,
-    13, 14, 13, 15, 17, 18, 35, 18, 17, 19,
-    59, 7, 8, 9, 5, 44, 45, 14, 18, 10,
-    11, 12, 19, 17, 20, 16, 6, 17, 17, 15,
-    9, 19, 19, 1, 19, 41, 18
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    22,    23,    23,    24,    25,    25,    25,    26,    26,
+      27,    27,    28,    28,    29,    29,    29,    30,    31,    32,
+      32,    33,    34,    35,    35,    36,    36,    36,    36,    37,
+      37,    38,    38,    38,    39,    40,    40,    40,    41,    41,
+      42
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] = {
-    0, 22, 23, 24, 0, 23, 10, 11, 12, 16,
-    25, 26, 27, 28, 39, 40, 41, 42, 5, 15,
-    15, 18, 7, 8, 9, 20, 29, 17, 34, 17,
-    30, 17, 31, 6, 19, 19, 15, 32, 33, 34,
-    32, 19, 9, 33, 3, 13, 18, 36, 37, 38,
-    4, 32, 14, 32, 35, 36, 4, 14, 14, 19,
-    36
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     2,     5,     0,     3,     3,     3,     5,
+       1,     1,     3,     5,     1,     1,     1,     1,     1,     1,
+       3,     3,     1,     1,     3,     1,     1,     1,     1,     2,
+       3,     2,     3,     3,     2,     1,     1,     1,     0,     1,
+       1
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
 
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#define YYFAIL		goto yyerrlab
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (gdbmi_pdata, YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-#define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (gdbmi_pdata, gdbmi_scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-#if YYLTYPE_IS_TRIVIAL
-#define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-#else
-#define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
-#endif
+/* Enable debugging if requested.  */
+#if YYDEBUG
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
 
-#ifdef YYLEX_PARAM
-#define YYLEX yylex (&yylval, YYLEX_PARAM)
-#else
-#define YYLEX yylex (&yylval)
-#endif
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
 
-/* Enable debugging if requested.  */
-#if YYDEBUG
 
-#ifndef YYFPRINTF
-#include <stdio.h>              /* INFRINGES ON USER NAME SPACE */
-#define YYFPRINTF fprintf
-#endif
 
-#define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-#define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value, gdbmi_pdata); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
- /*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, gdbmi_pdata, gdbmi_scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print(FILE * yyoutput, int yytype,
-        YYSTYPE const *const yyvaluep, struct gdbmi_pdata *gdbmi_pdata)
-#else
-static void yy_symbol_value_print(yyoutput, yytype, yyvaluep, gdbmi_pdata)
-     FILE *yyoutput;
-     int yytype;
-     YYSTYPE const *const yyvaluep;
-     struct gdbmi_pdata *gdbmi_pdata;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, struct gdbmi_pdata *gdbmi_pdata, void *gdbmi_scanner)
 {
-    if (!yyvaluep)
-        return;
-    YYUSE(gdbmi_pdata);
-#ifdef YYPRINT
-    if (yytype < YYNTOKENS)
-        YYPRINT(yyoutput, yytoknum[yytype], *yyvaluep);
-#else
-    YYUSE(yyoutput);
-#endif
-    switch (yytype) {
-        default:
-            break;
-    }
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (gdbmi_pdata);
+  YY_USE (gdbmi_scanner);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
 static void
-yy_symbol_print(FILE * yyoutput, int yytype, YYSTYPE const *const yyvaluep,
-        struct gdbmi_pdata *gdbmi_pdata)
-#else
-static void yy_symbol_print(yyoutput, yytype, yyvaluep, gdbmi_pdata)
-     FILE *yyoutput;
-     int yytype;
-     YYSTYPE const *const yyvaluep;
-     struct gdbmi_pdata *gdbmi_pdata;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, struct gdbmi_pdata *gdbmi_pdata, void *gdbmi_scanner)
 {
-    if (yytype < YYNTOKENS)
-        YYFPRINTF(yyoutput, "token %s (", yytname[yytype]);
-    else
-        YYFPRINTF(yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-    yy_symbol_value_print(yyoutput, yytype, yyvaluep, gdbmi_pdata);
-    YYFPRINTF(yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, gdbmi_pdata, gdbmi_scanner);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -801,80 +825,69 @@ static void yy_symbol_print(yyoutput, yytype, yyvaluep, gdbmi_pdata)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void yy_stack_print(yytype_int16 * yybottom, yytype_int16 * yytop)
-#else
-static void yy_stack_print(yybottom, yytop)
-     yytype_int16 *yybottom;
-     yytype_int16 *yytop;
-#endif
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
-    YYFPRINTF(stderr, "Stack now");
-    for (; yybottom <= yytop; yybottom++) {
-        int yybot = *yybottom;
-
-        YYFPRINTF(stderr, " %d", yybot);
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
     }
-    YYFPRINTF(stderr, "\n");
+  YYFPRINTF (stderr, "\n");
 }
 
-#define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_reduce_print(YYSTYPE * yyvsp, int yyrule, struct gdbmi_pdata *gdbmi_pdata)
-#else
-static void yy_reduce_print(yyvsp, yyrule, gdbmi_pdata)
-     YYSTYPE *yyvsp;
-     int yyrule;
-     struct gdbmi_pdata *gdbmi_pdata;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, struct gdbmi_pdata *gdbmi_pdata, void *gdbmi_scanner)
 {
-    int yynrhs = yyr2[yyrule];
-    int yyi;
-    unsigned long int yylno = yyrline[yyrule];
-
-    YYFPRINTF(stderr, "Reducing stack by rule %d (line %lu):\n",
-            yyrule - 1, yylno);
-    /* The symbols being reduced.  */
-    for (yyi = 0; yyi < yynrhs; yyi++) {
-        YYFPRINTF(stderr, "   $%d = ", yyi + 1);
-        yy_symbol_print(stderr, yyrhs[yyprhs[yyrule] + yyi],
-                &(yyvsp[(yyi + 1) - (yynrhs)])
-                , gdbmi_pdata);
-        YYFPRINTF(stderr, "\n");
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], gdbmi_pdata, gdbmi_scanner);
+      YYFPRINTF (stderr, "\n");
     }
 }
 
-#define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule, gdbmi_pdata); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, gdbmi_pdata, gdbmi_scanner); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-#define YYDPRINTF(Args)
-#define YY_SYMBOL_PRINT(Title, Type, Value, Location)
-#define YY_STACK_PRINT(Bottom, Top)
-#define YY_REDUCE_PRINT(Rule)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
+
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
-#define YYINITDEPTH 200
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
 #endif
 
 /* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
@@ -885,1172 +898,1003 @@ int yydebug;
    evaluated with infinite-precision integer arithmetic.  */
 
 #ifndef YYMAXDEPTH
-#define YYMAXDEPTH 10000
+# define YYMAXDEPTH 10000
 #endif
-
-#if YYERROR_VERBOSE
+/* Parser data structure.  */
+struct yypstate
+  {
+    /* Number of syntax errors so far.  */
+    int yynerrs;
 
-#ifndef yystrlen
-#if defined __GLIBC__ && defined _STRING_H
-#define yystrlen strlen
-#else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T yystrlen(const char *yystr)
-#else
-static YYSIZE_T yystrlen(yystr)
-     const char *yystr;
-#endif
-{
-    YYSIZE_T yylen;
+    yy_state_fast_t yystate;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus;
 
-    for (yylen = 0; yystr[yylen]; yylen++)
-        continue;
-    return yylen;
-}
-#endif
-#endif
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
-#ifndef yystpcpy
-#if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#define yystpcpy stpcpy
-#else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *yystpcpy(char *yydest, const char *yysrc)
-#else
-static char *yystpcpy(yydest, yysrc)
-     char *yydest;
-     const char *yysrc;
-#endif
-{
-    char *yyd = yydest;
-    const char *yys = yysrc;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize;
 
-    while ((*yyd++ = *yys++) != '\0')
-        continue;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss;
+    yy_state_t *yyssp;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs;
+    YYSTYPE *yyvsp;
+    /* Whether this instance has not started parsing yet.
+     * If 2, it corresponds to a finished parsing.  */
+    int yynew;
+  };
 
-    return yyd - 1;
-}
-#endif
-#endif
 
-#ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T yytnamerr(char *yyres, const char *yystr)
-{
-    if (*yystr == '"') {
-        YYSIZE_T yyn = 0;
-        char const *yyp = yystr;
-
-        for (;;)
-            switch (*++yyp) {
-                case '\'':
-                case ',':
-                    goto do_not_strip_quotes;
-
-                case '\\':
-                    if (*++yyp != '\\')
-                        goto do_not_strip_quotes;
-                    /* Fall through.  */
-                default:
-                    if (yyres)
-                        yyres[yyn] = *yyp;
-                    yyn++;
-                    break;
-
-                case '"':
-                    if (yyres)
-                        yyres[yyn] = '\0';
-                    return yyn;
-            }
-      do_not_strip_quotes:;
-    }
 
-    if (!yyres)
-        return yystrlen(yystr);
 
-    return yystpcpy(yyres, yystr) - yyres;
-}
-#endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T yysyntax_error(char *yyresult, int yystate, int yychar)
-{
-    int yyn = yypact[yystate];
-
-    if (!(YYPACT_NINF < yyn && yyn <= YYLAST))
-        return 0;
-    else {
-        int yytype = YYTRANSLATE(yychar);
-        YYSIZE_T yysize0 = yytnamerr(0, yytname[yytype]);
-        YYSIZE_T yysize = yysize0;
-        YYSIZE_T yysize1;
-        int yysize_overflow = 0;
-        enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-        char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-        int yyx;
-
-#if 0
-        /* This is so xgettext sees the translatable formats that are
-           constructed on the fly.  */
-        YY_("syntax error, unexpected %s");
-        YY_("syntax error, unexpected %s, expecting %s");
-        YY_("syntax error, unexpected %s, expecting %s or %s");
-        YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-        YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-#endif
-        char *yyfmt;
-        char const *yyf;
-        static char const yyunexpected[] = "syntax error, unexpected %s";
-        static char const yyexpecting[] = ", expecting %s";
-        static char const yyor[] = " or %s";
-        char yyformat[sizeof yyunexpected
-                + sizeof yyexpecting - 1 + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-                        * (sizeof yyor - 1))];
-        char const *yyprefix = yyexpecting;
-
-        /* Start YYX at -YYN if negative to avoid negative indexes in
-           YYCHECK.  */
-        int yyxbegin = yyn < 0 ? -yyn : 0;
-
-        /* Stay within bounds of both yycheck and yytname.  */
-        int yychecklim = YYLAST - yyn + 1;
-        int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-        int yycount = 1;
-
-        yyarg[0] = yytname[yytype];
-        yyfmt = yystpcpy(yyformat, yyunexpected);
-
-        for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR) {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM) {
-                    yycount = 1;
-                    yysize = yysize0;
-                    yyformat[sizeof yyunexpected - 1] = '\0';
-                    break;
-                }
-                yyarg[yycount++] = yytname[yyx];
-                yysize1 = yysize + yytnamerr(0, yytname[yyx]);
-                yysize_overflow |= (yysize1 < yysize);
-                yysize = yysize1;
-                yyfmt = yystpcpy(yyfmt, yyprefix);
-                yyprefix = yyor;
-            }
 
-        yyf = YY_(yyformat);
-        yysize1 = yysize + yystrlen(yyf);
-        yysize_overflow |= (yysize1 < yysize);
-        yysize = yysize1;
-
-        if (yysize_overflow)
-            return YYSIZE_MAXIMUM;
-
-        if (yyresult) {
-            /* Avoid sprintf, as that infringes on the user's name space.
-               Don't have undefined behavior even if the translation
-               produced a string with the wrong number of "%s"s.  */
-            char *yyp = yyresult;
-            int yyi = 0;
-
-            while ((*yyp = *yyf) != '\0') {
-                if (*yyp == '%' && yyf[1] == 's' && yyi < yycount) {
-                    yyp += yytnamerr(yyp, yyarg[yyi++]);
-                    yyf += 2;
-                } else {
-                    yyp++;
-                    yyf++;
-                }
-            }
-        }
-        return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
- /*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct(const char *yymsg, int yytype, YYSTYPE * yyvaluep,
-        struct gdbmi_pdata *gdbmi_pdata)
-#else
-static void yydestruct(yymsg, yytype, yyvaluep, gdbmi_pdata)
-     const char *yymsg;
-     int yytype;
-     YYSTYPE *yyvaluep;
-     struct gdbmi_pdata *gdbmi_pdata;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, struct gdbmi_pdata *gdbmi_pdata, void *gdbmi_scanner)
 {
-    YYUSE(yyvaluep);
-    YYUSE(gdbmi_pdata);
-
-    if (!yymsg)
-        yymsg = "Deleting";
-    YY_SYMBOL_PRINT(yymsg, yytype, yyvaluep, yylocationp);
-
-    switch (yytype) {
-
-        default:
-            break;
-    }
+  YY_USE (yyvaluep);
+  YY_USE (gdbmi_pdata);
+  YY_USE (gdbmi_scanner);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
-struct yypstate {
-    /* Number of syntax errors so far.  */
-    int yynerrs;
 
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
 
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
 
-       Refer to the stacks thru separate pointers, to allow yyoverflow
-       to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+#define gdbmi_nerrs yyps->gdbmi_nerrs
+#define yystate yyps->yystate
+#define yyerrstatus yyps->yyerrstatus
+#define yyssa yyps->yyssa
+#define yyss yyps->yyss
+#define yyssp yyps->yyssp
+#define yyvsa yyps->yyvsa
+#define yyvs yyps->yyvs
+#define yyvsp yyps->yyvsp
+#define yystacksize yyps->yystacksize
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+/* Initialize the parser data structure.  */
+static void
+yypstate_clear (yypstate *yyps)
+{
+  yynerrs = 0;
+  yystate = 0;
+  yyerrstatus = 0;
 
-    YYSIZE_T yystacksize;
+  yyssp = yyss;
+  yyvsp = yyvs;
 
-    /* Used to determine if this is the first time this instance has
-       been used.  */
-    int yynew;
-};
+  /* Initialize the state stack, in case yypcontext_expected_tokens is
+     called before the first call to yyparse. */
+  *yyssp = 0;
+  yyps->yynew = 1;
+}
 
 /* Initialize the parser data structure.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-yypstate *yypstate_new(void)
-#else
-yypstate *yypstate_new()
-#endif
+yypstate *
+yypstate_new (void)
 {
-    yypstate *yyps;
-
-    yyps = (yypstate *) malloc(sizeof *yyps);
-    if (!yyps)
-        return 0;
-    yyps->yynew = 1;
-    return yyps;
+  yypstate *yyps;
+  yyps = YY_CAST (yypstate *, YYMALLOC (sizeof *yyps));
+  if (!yyps)
+    return YY_NULLPTR;
+  yystacksize = YYINITDEPTH;
+  yyss = yyssa;
+  yyvs = yyvsa;
+  yypstate_clear (yyps);
+  return yyps;
 }
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-void yypstate_delete(yypstate * yyps)
-#else
-void yypstate_delete(yyps)
-     yypstate *yyps;
-#endif
+void
+yypstate_delete (yypstate *yyps)
 {
+  if (yyps)
+    {
 #ifndef yyoverflow
-    /* If the stack was reallocated but the parse did not complete, then the
-       stack still needs to be freed.  */
-    if (!yyps->yynew && yyps->yyss != yyps->yyssa)
-        YYSTACK_FREE(yyps->yyss);
+      /* If the stack was reallocated but the parse did not complete, then the
+         stack still needs to be freed.  */
+      if (yyss != yyssa)
+        YYSTACK_FREE (yyss);
 #endif
-    free(yyps);
+      YYFREE (yyps);
+    }
 }
 
-#define gdbmi_nerrs yyps->gdbmi_nerrs
-#define yystate yyps->yystate
-#define yyerrstatus yyps->yyerrstatus
-#define yyssa yyps->yyssa
-#define yyss yyps->yyss
-#define yyssp yyps->yyssp
-#define yyvsa yyps->yyvsa
-#define yyvs yyps->yyvs
-#define yyvsp yyps->yyvsp
-#define yystacksize yyps->yystacksize
 
-/*-------------------------.
-| yyparse or yypush_parse.  |
-`-------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/*---------------.
+| yypush_parse.  |
+`---------------*/
+
 int
-yypush_parse(yypstate * yyps, int yypushed_char, YYSTYPE const *yypushed_val,
-        struct gdbmi_pdata *gdbmi_pdata)
-#else
-int yypush_parse(yyps, yypushed_char, yypushed_val, gdbmi_pdata)
-     yypstate *yyps;
-     int yypushed_char;
-     YYSTYPE const *yypushed_val;
-     struct gdbmi_pdata *gdbmi_pdata;
-#endif
+yypush_parse (yypstate *yyps,
+              int yypushed_char, YYSTYPE const *yypushed_val, struct gdbmi_pdata *gdbmi_pdata, void *gdbmi_scanner)
 {
-/* The lookahead symbol.  */
-    int yychar;
+/* Lookahead token kind.  */
+int yychar;
 
-/* The semantic value of the lookahead symbol.  */
-    YYSTYPE yylval;
 
-    int yyn;
-    int yyresult;
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
-    /* Lookahead token as an internal (translated) token number.  */
-    int yytoken;
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
 
-    /* The variables used to return semantic value and location from the
-       action routines.  */
-    YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-    /* Buffer for error messages, and its allocated size.  */
-    char yymsgbuf[128];
-    char *yymsg = yymsgbuf;
-    YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
-    /* The number of symbols on the RHS of the reduced rule.
-       Keep to zero when no symbol should be popped.  */
-    int yylen = 0;
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
 
-    if (!yyps->yynew) {
-        yyn = yypact[yystate];
-        goto yyread_pushed_token;
-    }
+  switch (yyps->yynew)
+    {
+    case 0:
+      yyn = yypact[yystate];
+      goto yyread_pushed_token;
 
-    yytoken = 0;
-    yyss = yyssa;
-    yyvs = yyvsa;
+    case 2:
+      yypstate_clear (yyps);
+      break;
 
-    yystacksize = YYINITDEPTH;
+    default:
+      break;
+    }
 
-    YYDPRINTF((stderr, "Starting parse\n"));
+  YYDPRINTF ((stderr, "Starting parse\n"));
 
-    yystate = 0;
-    yyerrstatus = 0;
-    yynerrs = 0;
-    yychar = YYEMPTY;           /* Cause a token to be read.  */
+  yychar = YYEMPTY; /* Cause a token to be read.  */
 
-    /* Initialize stack pointers.
-       Waste one element of value and location stack
-       so that they stay on the same level as the state stack.
-       The wasted elements are never initialized.  */
-    yyssp = yyss;
-    yyvsp = yyvs;
+  goto yysetstate;
 
-    goto yysetstate;
 
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
-  yynewstate:
-    /* In all cases, when you get here, the value and location stacks
-       have just been pushed.  So pushing a state here evens the stacks.  */
-    yyssp++;
-
-  yysetstate:
-    *yyssp = yystate;
-
-    if (yyss + yystacksize - 1 <= yyssp) {
-        /* Get the current used size of the three stacks, in elements.  */
-        YYSIZE_T yysize = yyssp - yyss + 1;
-
-#ifdef yyoverflow
-        {
-            /* Give user a chance to reallocate the stack.  Use copies of
-               these so that the &'s don't force the real ones into
-               memory.  */
-            YYSTYPE *yyvs1 = yyvs;
-            yytype_int16 *yyss1 = yyss;
-
-            /* Each stack pointer address is followed by the size of the
-               data in use in that stack, in bytes.  This used to be a
-               conditional around just the two extra args, but that might
-               be undefined if yyoverflow is a macro.  */
-            yyoverflow(YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp), &yystacksize);
-
-            yyss = yyss1;
-            yyvs = yyvs1;
-        }
-#else /* no yyoverflow */
-#ifndef YYSTACK_RELOCATE
-        goto yyexhaustedlab;
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
 #else
-        /* Extend the stack our own way.  */
-        if (YYMAXDEPTH <= yystacksize)
-            goto yyexhaustedlab;
-        yystacksize *= 2;
-        if (YYMAXDEPTH < yystacksize)
-            yystacksize = YYMAXDEPTH;
-
-        {
-            yytype_int16 *yyss1 = yyss;
-            union yyalloc *yyptr =
-                    (union yyalloc *) YYSTACK_ALLOC(YYSTACK_BYTES(yystacksize));
-            if (!yyptr)
-                goto yyexhaustedlab;
-            YYSTACK_RELOCATE(yyss_alloc, yyss);
-            YYSTACK_RELOCATE(yyvs_alloc, yyvs);
-#undef YYSTACK_RELOCATE
-            if (yyss1 != yyssa)
-                YYSTACK_FREE(yyss1);
-        }
-#endif
-#endif /* no yyoverflow */
-
-        yyssp = yyss + yysize - 1;
-        yyvsp = yyvs + yysize - 1;
-
-        YYDPRINTF((stderr, "Stack size increased to %lu\n",
-                        (unsigned long int) yystacksize));
-
-        if (yyss + yystacksize - 1 <= yyssp)
-            YYABORT;
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-    YYDPRINTF((stderr, "Entering state %d\n", yystate));
 
-    if (yystate == YYFINAL)
-        YYACCEPT;
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
 
-    goto yybackup;
 
 /*-----------.
 | yybackup.  |
 `-----------*/
-  yybackup:
-
-    /* Do appropriate processing given the current state.  Read a
-       lookahead token if we need one and don't already have one.  */
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
 
-    /* First try to decide what to do without reference to lookahead token.  */
-    yyn = yypact[yystate];
-    if (yyn == YYPACT_NINF)
-        goto yydefault;
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
 
-    /* Not known => get a lookahead token if don't already have one.  */
+  /* Not known => get a lookahead token if don't already have one.  */
 
-    /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
-    if (yychar == YYEMPTY) {
-        if (!yyps->yynew) {
-            YYDPRINTF((stderr, "Return for a new token:\n"));
-            yyresult = YYPUSH_MORE;
-            goto yypushreturn;
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      if (!yyps->yynew)
+        {
+          YYDPRINTF ((stderr, "Return for a new token:\n"));
+          yyresult = YYPUSH_MORE;
+          goto yypushreturn;
         }
-        yyps->yynew = 0;
-
-      yyread_pushed_token:
-        YYDPRINTF((stderr, "Reading a token: "));
-        yychar = yypushed_char;
-        if (yypushed_val)
-            yylval = *yypushed_val;
+      yyps->yynew = 0;
+yyread_pushed_token:
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yypushed_char;
+      if (yypushed_val)
+        yylval = *yypushed_val;
     }
 
-    if (yychar <= YYEOF) {
-        yychar = yytoken = YYEOF;
-        YYDPRINTF((stderr, "Now at end of input.\n"));
-    } else {
-        yytoken = YYTRANSLATE(yychar);
-        YY_SYMBOL_PRINT("Next token is", yytoken, &yylval, &yylloc);
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
-
-    /* If the proper action on seeing token YYTOKEN is to reduce or to
-       detect an error, take that action.  */
-    yyn += yytoken;
-    if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
-        goto yydefault;
-    yyn = yytable[yyn];
-    if (yyn <= 0) {
-        if (yyn == 0 || yyn == YYTABLE_NINF)
-            goto yyerrlab;
-        yyn = -yyn;
-        goto yyreduce;
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
     }
 
-    /* Count tokens shifted since error; after three, turn off error
-       status.  */
-    if (yyerrstatus)
-        yyerrstatus--;
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
 
-    /* Shift the lookahead token.  */
-    YY_SYMBOL_PRINT("Shifting", yytoken, &yylval, &yylloc);
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
 
-    /* Discard the shifted token.  */
-    yychar = YYEMPTY;
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
-    yystate = yyn;
-    *++yyvsp = yylval;
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
 
-    goto yynewstate;
 
 /*-----------------------------------------------------------.
 | yydefault -- do the default action for the current state.  |
 `-----------------------------------------------------------*/
-  yydefault:
-    yyn = yydefact[yystate];
-    if (yyn == 0)
-        goto yyerrlab;
-    goto yyreduce;
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
-  yyreduce:
-    /* yyn is the number of a rule to reduce with.  */
-    yylen = yyr2[yyn];
-
-    /* If YYLEN is nonzero, implement the default value of the action:
-       `$$ = $1'.
-
-       Otherwise, the following line sets YYVAL to garbage.
-       This behavior is undocumented and Bison
-       users should not rely upon it.  Assigning to YYVAL
-       unconditionally makes the parser a bit smaller, and it avoids a
-       GCC warning that YYVAL may be used uninitialized.  */
-    yyval = yyvsp[1 - yylen];
-
-    YY_REDUCE_PRINT(yyn);
-    switch (yyn) {
-        case 2:
-
-/* Line 1464 of yacc.c  */
-#line 96 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            gdbmi_pdata->tree = (yyvsp[(1) - (1)].u_output);
-        }
-            break;
-
-        case 3:
-
-/* Line 1464 of yacc.c  */
-#line 100 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            gdbmi_pdata->tree =
-                    append_gdbmi_output(gdbmi_pdata->tree,
-                    (yyvsp[(2) - (2)].u_output));
-            gdbmi_pdata->parsed_one = 1;
-        }
-            break;
-
-        case 4:
-
-/* Line 1464 of yacc.c  */
-#line 105 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_output) = create_gdbmi_output();
-            (yyval.u_output)->oob_record = (yyvsp[(1) - (6)].u_oob_record);
-            (yyval.u_output)->result_record =
-                    (yyvsp[(2) - (6)].u_result_record);
-
-            if (strcmp("gdb", (yyvsp[(4) - (6)].u_variable)) != 0)
-                gdbmi_error(gdbmi_pdata, "Syntax error, expected 'gdb'");
-
-            free((yyvsp[(4) - (6)].u_variable));
-        }
-            break;
-
-        case 5:
-
-/* Line 1464 of yacc.c  */
-#line 116 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_oob_record) = NULL;
-        }
-            break;
-
-        case 6:
-
-/* Line 1464 of yacc.c  */
-#line 120 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_oob_record) =
-                    append_gdbmi_oob_record((yyvsp[(1) - (3)].u_oob_record),
-                    (yyvsp[(2) - (3)].u_oob_record));
-        }
-            break;
-
-        case 7:
-
-/* Line 1464 of yacc.c  */
-#line 124 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_result_record) = NULL;
-        }
-            break;
-
-        case 8:
-
-/* Line 1464 of yacc.c  */
-#line 128 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_result_record) = (yyvsp[(1) - (2)].u_result_record);
-        }
-            break;
-
-        case 9:
-
-/* Line 1464 of yacc.c  */
-#line 132 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_result_record) = create_gdbmi_result_record();
-            (yyval.u_result_record)->token = (yyvsp[(1) - (3)].u_token);
-            (yyval.u_result_record)->result_class =
-                    (yyvsp[(3) - (3)].u_result_class);
-            (yyval.u_result_record)->result = NULL;
-        }
-            break;
-
-        case 10:
-
-/* Line 1464 of yacc.c  */
-#line 139 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_result_record) = create_gdbmi_result_record();
-            (yyval.u_result_record)->token = (yyvsp[(1) - (5)].u_token);
-            (yyval.u_result_record)->result_class =
-                    (yyvsp[(3) - (5)].u_result_class);
-            (yyval.u_result_record)->result = (yyvsp[(5) - (5)].u_result);
-        }
-            break;
-
-        case 11:
-
-/* Line 1464 of yacc.c  */
-#line 146 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_oob_record) = create_gdbmi_oob_record();
-            (yyval.u_oob_record)->record = GDBMI_ASYNC;
-            (yyval.u_oob_record)->option.async_record =
-                    (yyvsp[(1) - (1)].u_async_record);
-        }
-            break;
-
-        case 12:
-
-/* Line 1464 of yacc.c  */
-#line 152 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_oob_record) = create_gdbmi_oob_record();
-            (yyval.u_oob_record)->record = GDBMI_STREAM;
-            (yyval.u_oob_record)->option.stream_record =
-                    (yyvsp[(1) - (1)].u_stream_record);
-        }
-            break;
-
-        case 13:
-
-/* Line 1464 of yacc.c  */
-#line 158 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_async_record) = create_gdbmi_async_record();
-            (yyval.u_async_record)->token = (yyvsp[(1) - (3)].u_token);
-            (yyval.u_async_record)->async_record =
-                    (yyvsp[(2) - (3)].u_async_record_choice);
-            (yyval.u_async_record)->async_class =
-                    (yyvsp[(3) - (3)].u_async_class);
-        }
-            break;
-
-        case 14:
-
-/* Line 1464 of yacc.c  */
-#line 165 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_async_record) = create_gdbmi_async_record();
-            (yyval.u_async_record)->token = (yyvsp[(1) - (5)].u_token);
-            (yyval.u_async_record)->async_record =
-                    (yyvsp[(2) - (5)].u_async_record_choice);
-            (yyval.u_async_record)->async_class =
-                    (yyvsp[(3) - (5)].u_async_class);
-            (yyval.u_async_record)->result = (yyvsp[(5) - (5)].u_result);
-        }
-            break;
-
-        case 15:
-
-/* Line 1464 of yacc.c  */
-#line 173 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_async_record_choice) = GDBMI_EXEC;
-        }
-            break;
-
-        case 16:
-
-/* Line 1464 of yacc.c  */
-#line 177 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_async_record_choice) = GDBMI_STATUS;
-        }
-            break;
-
-        case 17:
-
-/* Line 1464 of yacc.c  */
-#line 181 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_async_record_choice) = GDBMI_NOTIFY;
-        }
-            break;
-
-        case 18:
-
-/* Line 1464 of yacc.c  */
-#line 185 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            if (strcmp("done", gdbmi_text) == 0)
-                (yyval.u_result_class) = GDBMI_DONE;
-            else if (strcmp("running", gdbmi_text) == 0)
-                (yyval.u_result_class) = GDBMI_RUNNING;
-            else if (strcmp("connected", gdbmi_text) == 0)
-                (yyval.u_result_class) = GDBMI_CONNECTED;
-            else if (strcmp("error", gdbmi_text) == 0)
-                (yyval.u_result_class) = GDBMI_ERROR;
-            else if (strcmp("exit", gdbmi_text) == 0)
-                (yyval.u_result_class) = GDBMI_EXIT;
-            else
-                gdbmi_error(gdbmi_pdata,
-                        "Syntax error, expected 'done|running|connected|error|exit");
-        }
-            break;
-
-        case 19:
-
-/* Line 1464 of yacc.c  */
-#line 200 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            if (strcmp("stopped", gdbmi_text) != 0)
-                gdbmi_error(gdbmi_pdata, "Syntax error, expected 'stopped'");
-
-            (yyval.u_async_class) = GDBMI_STOPPED;
-        }
-            break;
-
-        case 20:
-
-/* Line 1464 of yacc.c  */
-#line 207 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_result) =
-                    append_gdbmi_result(NULL, (yyvsp[(1) - (1)].u_result));
-        }
-            break;
-
-        case 21:
-
-/* Line 1464 of yacc.c  */
-#line 211 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_result) =
-                    append_gdbmi_result((yyvsp[(1) - (3)].u_result),
-                    (yyvsp[(3) - (3)].u_result));
-        }
-            break;
-
-        case 22:
-
-/* Line 1464 of yacc.c  */
-#line 215 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_result) = create_gdbmi_result();
-            (yyval.u_result)->variable = (yyvsp[(1) - (3)].u_variable);
-            (yyval.u_result)->value = (yyvsp[(3) - (3)].u_value);
-        }
-            break;
-
-        case 23:
-
-/* Line 1464 of yacc.c  */
-#line 221 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_variable) = strdup(gdbmi_text);
-        }
-            break;
-
-        case 24:
-
-/* Line 1464 of yacc.c  */
-#line 225 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_value) =
-                    append_gdbmi_value(NULL, (yyvsp[(1) - (1)].u_value));
-        }
-            break;
-
-        case 25:
-
-/* Line 1464 of yacc.c  */
-#line 229 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_value) =
-                    append_gdbmi_value((yyvsp[(1) - (3)].u_value),
-                    (yyvsp[(3) - (3)].u_value));
-        }
-            break;
-
-        case 26:
-
-/* Line 1464 of yacc.c  */
-#line 233 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_value) = create_gdbmi_value();
-            (yyval.u_value)->value_choice = GDBMI_CSTRING;
-            (yyval.u_value)->option.cstring = strdup(gdbmi_text);
-        }
-            break;
-
-        case 27:
-
-/* Line 1464 of yacc.c  */
-#line 239 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_value) = create_gdbmi_value();
-            (yyval.u_value)->value_choice = GDBMI_TUPLE;
-            (yyval.u_value)->option.tuple = (yyvsp[(1) - (1)].u_tuple);
-        }
-            break;
-
-        case 28:
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* output_list: output  */
+#line 157 "gdbmi_grammar.y"
+                    {
+  gdbmi_pdata->tree = (yyvsp[0].u_output);
+  gdbmi_pdata->parsed_one = 1;
+}
+#line 1290 "gdbmi_grammar.c"
+    break;
+
+  case 3: /* output_list: output_list output  */
+#line 162 "gdbmi_grammar.y"
+                                {
+  gdbmi_pdata->tree = append_gdbmi_output (gdbmi_pdata->tree, (yyvsp[0].u_output));
+  gdbmi_pdata->parsed_one = 1;
+}
+#line 1299 "gdbmi_grammar.c"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 245 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_value) = create_gdbmi_value();
-            (yyval.u_value)->value_choice = GDBMI_LIST;
-            (yyval.u_value)->option.list = (yyvsp[(1) - (1)].u_list);
-        }
-            break;
+  case 4: /* output: record_list OPEN_PAREN variable CLOSED_PAREN NEWLINE  */
+#line 167 "gdbmi_grammar.y"
+                                                             { 
+  (yyval.u_output) = (yyvsp[-4].u_output);
 
-        case 29:
+  /* The output takes the arena its nodes are in, the next output gets
+     a new one */
+  (yyval.u_output)->arena = gdbmi_pdata->arena;
+  gdbmi_pdata->arena = NULL;
 
-/* Line 1464 of yacc.c  */
-#line 251 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_tuple) = NULL;
-        }
-            break;
+  if (!gdbmi_text_is (&(yyvsp[-2].u_text), "gdb"))
+    gdbmi_error (gdbmi_pdata, gdbmi_scanner, "Syntax error, expected 'gdb'");
+}
+#line 1315 "gdbmi_grammar.c"
+    break;
 
-        case 30:
+  case 5: /* record_list: %empty  */
+#line 181 "gdbmi_grammar.y"
+             {
+  (yyval.u_output) = create_gdbmi_output (gdbmi_pdata->arena);
+}
+#line 1323 "gdbmi_grammar.c"
+    break;
+
+  case 6: /* record_list: record_list oob_record NEWLINE  */
+#line 185 "gdbmi_grammar.y"
+                                            {
+  (yyval.u_output) = (yyvsp[-2].u_output);
+  (yyval.u_output)->oob_record = append_gdbmi_oob_record ((yyval.u_output)->oob_record, (yyvsp[-1].u_oob_record));
+}
+#line 1332 "gdbmi_grammar.c"
+    break;
+
+  case 7: /* record_list: record_list result_record NEWLINE  */
+#line 190 "gdbmi_grammar.y"
+                                               {
+  (yyval.u_output) = (yyvsp[-2].u_output);
+  (yyval.u_output)->result_record = (yyvsp[-1].u_result_record);
+}
+#line 1341 "gdbmi_grammar.c"
+    break;
+
+  case 8: /* result_record: opt_token CARROT result_class  */
+#line 195 "gdbmi_grammar.y"
+                                             {
+  (yyval.u_result_record) = create_gdbmi_result_record (gdbmi_pdata->arena);
+  (yyval.u_result_record)->token = (yyvsp[-2].u_token);
+  (yyval.u_result_record)->result_class = (yyvsp[0].u_result_class);
+  (yyval.u_result_record)->result = NULL;
+}
+#line 1352 "gdbmi_grammar.c"
+    break;
+
+  case 9: /* result_record: opt_token CARROT result_class COMMA result_list  */
+#line 202 "gdbmi_grammar.y"
+                                                               {
+  (yyval.u_result_record) = create_gdbmi_result_record (gdbmi_pdata->arena);
+  (yyval.u_result_record)->token = (yyvsp[-4].u_token);
+  (yyval.u_result_record)->result_class = (yyvsp[-2].u_result_class);
+  (yyval.u_result_record)->result = (yyvsp[0].u_result);
+}
+#line 1363 "gdbmi_grammar.c"
+    break;
+
+  case 10: /* oob_record: async_record  */
+#line 209 "gdbmi_grammar.y"
+                         {
+  (yyval.u_oob_record) = create_gdbmi_oob_record (gdbmi_pdata->arena);
+  (yyval.u_oob_record)->record = GDBMI_ASYNC;
+  (yyval.u_oob_record)->option.async_record = (yyvsp[0].u_async_record);
+}
+#line 1373 "gdbmi_grammar.c"
+    break;
+
+  case 11: /* oob_record: stream_record  */
+#line 215 "gdbmi_grammar.y"
+                          {
+  (yyval.u_oob_record) = create_gdbmi_oob_record (gdbmi_pdata->arena);
+  (yyval.u_oob_record)->record = GDBMI_STREAM;
+  (yyval.u_oob_record)->option.stream_record = (yyvsp[0].u_stream_record);
+}
+#line 1383 "gdbmi_grammar.c"
+    break;
+
+  case 12: /* async_record: opt_token async_record_class async_class  */
+#line 221 "gdbmi_grammar.y"
+                                                       {
+  (yyval.u_async_record) = create_gdbmi_async_record (gdbmi_pdata->arena);
+  (yyval.u_async_record)->token = (yyvsp[-2].u_token);
+  (yyval.u_async_record)->async_record = (yyvsp[-1].u_async_record_choice);
+  (yyval.u_async_record)->async_class = (yyvsp[0].u_async_class);
+}
+#line 1394 "gdbmi_grammar.c"
+    break;
+
+  case 13: /* async_record: opt_token async_record_class async_class COMMA result_list  */
+#line 228 "gdbmi_grammar.y"
+                                                                         {
+  (yyval.u_async_record) = create_gdbmi_async_record (gdbmi_pdata->arena);
+  (yyval.u_async_record)->token = (yyvsp[-4].u_token);
+  (yyval.u_async_record)->async_record = (yyvsp[-3].u_async_record_choice);
+  (yyval.u_async_record)->async_class = (yyvsp[-2].u_async_class);
+  (yyval.u_async_record)->result = (yyvsp[0].u_result);
+}
+#line 1406 "gdbmi_grammar.c"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 255 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_tuple) = create_gdbmi_tuple();
-            (yyval.u_tuple)->result = (yyvsp[(2) - (3)].u_result);
-        }
-            break;
+  case 14: /* async_record_class: MULT_OP  */
+#line 236 "gdbmi_grammar.y"
+                            {
+  (yyval.u_async_record_choice) = GDBMI_EXEC;
+}
+#line 1414 "gdbmi_grammar.c"
+    break;
 
-        case 31:
+  case 15: /* async_record_class: ADD_OP  */
+#line 240 "gdbmi_grammar.y"
+                           {
+  (yyval.u_async_record_choice) = GDBMI_STATUS;
+}
+#line 1422 "gdbmi_grammar.c"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 260 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_list) = NULL;
-        }
-            break;
+  case 16: /* async_record_class: EQUAL_SIGN  */
+#line 244 "gdbmi_grammar.y"
+                               {
+  (yyval.u_async_record_choice) = GDBMI_NOTIFY;	
+}
+#line 1430 "gdbmi_grammar.c"
+    break;
+
+  case 17: /* result_class: STRING_LITERAL  */
+#line 248 "gdbmi_grammar.y"
+                             {
+  switch (gdbmi_keyword_lookup ((yyvsp[0].u_text).data, (yyvsp[0].u_text).length))
+    {
+    case GDBMI_KEYWORD_DONE:
+      (yyval.u_result_class) = GDBMI_DONE;
+      break;
+    case GDBMI_KEYWORD_RUNNING:
+      (yyval.u_result_class) = GDBMI_RUNNING;
+      break;
+    case GDBMI_KEYWORD_CONNECTED:
+      (yyval.u_result_class) = GDBMI_CONNECTED;
+      break;
+    case GDBMI_KEYWORD_ERROR:
+      (yyval.u_result_class) = GDBMI_ERROR;
+      break;
+    case GDBMI_KEYWORD_EXIT:
+      (yyval.u_result_class) = GDBMI_EXIT;
+      break;
+    default:
+      gdbmi_error (gdbmi_pdata, gdbmi_scanner, "Syntax error, expected 'done|running|connected|error|exit");
+      break;
+    }
+}
+#line 1458 "gdbmi_grammar.c"
+    break;
+
+  case 18: /* async_class: STRING_LITERAL  */
+#line 272 "gdbmi_grammar.y"
+                            {
+  switch (gdbmi_keyword_lookup ((yyvsp[0].u_text).data, (yyvsp[0].u_text).length))
+    {
+    case GDBMI_KEYWORD_STOPPED:
+      (yyval.u_async_class) = GDBMI_STOPPED;
+      break;
+    case GDBMI_KEYWORD_RUNNING:
+      (yyval.u_async_class) = GDBMI_ASYNC_RUNNING;
+      break;
+    case GDBMI_KEYWORD_BREAKPOINT_CREATED:
+      (yyval.u_async_class) = GDBMI_BREAKPOINT_CREATED;
+      break;
+    case GDBMI_KEYWORD_BREAKPOINT_MODIFIED:
+      (yyval.u_async_class) = GDBMI_BREAKPOINT_MODIFIED;
+      break;
+    case GDBMI_KEYWORD_BREAKPOINT_DELETED:
+      (yyval.u_async_class) = GDBMI_BREAKPOINT_DELETED;
+      break;
+    case GDBMI_KEYWORD_THREAD_SELECTED:
+      (yyval.u_async_class) = GDBMI_THREAD_SELECTED;
+      break;
+    case GDBMI_KEYWORD_THREAD_CREATED:
+      (yyval.u_async_class) = GDBMI_THREAD_CREATED;
+      break;
+    case GDBMI_KEYWORD_THREAD_EXITED:
+      (yyval.u_async_class) = GDBMI_THREAD_EXITED;
+      break;
+    default:
+      /* GDB adds new notifications all the time, they aren't errors */
+      (yyval.u_async_class) = GDBMI_ASYNC_UNKNOWN;
+      break;
+    }
+}
+#line 1496 "gdbmi_grammar.c"
+    break;
 
-        case 32:
+  case 19: /* result_list: result  */
+#line 306 "gdbmi_grammar.y"
+                    {
+  (yyval.u_result) = append_gdbmi_result (NULL, (yyvsp[0].u_result));	
+}
+#line 1504 "gdbmi_grammar.c"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 264 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_list) = create_gdbmi_list();
-            (yyval.u_list)->list_choice = GDBMI_VALUE;
-            (yyval.u_list)->option.value = (yyvsp[(2) - (3)].u_value);
-        }
-            break;
+  case 20: /* result_list: result_list COMMA result  */
+#line 310 "gdbmi_grammar.y"
+                                      {
+  (yyval.u_result) = append_gdbmi_result ((yyvsp[-2].u_result), (yyvsp[0].u_result));
+}
+#line 1512 "gdbmi_grammar.c"
+    break;
+
+  case 21: /* result: variable EQUAL_SIGN value  */
+#line 314 "gdbmi_grammar.y"
+                                  {
+  (yyval.u_result) = create_gdbmi_result (gdbmi_pdata->arena);
+  (yyval.u_result)->variable = gdbmi_text_dup (gdbmi_pdata->arena, &(yyvsp[-2].u_text));
+  (yyval.u_result)->keyword = gdbmi_keyword_lookup ((yyvsp[-2].u_text).data, (yyvsp[-2].u_text).length);
+  (yyval.u_result)->value = (yyvsp[0].u_value);
+}
+#line 1523 "gdbmi_grammar.c"
+    break;
 
-        case 33:
+  case 22: /* variable: STRING_LITERAL  */
+#line 321 "gdbmi_grammar.y"
+                         {
+  (yyval.u_text) = (yyvsp[0].u_text);
+}
+#line 1531 "gdbmi_grammar.c"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 270 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_list) = create_gdbmi_list();
-            (yyval.u_list)->list_choice = GDBMI_RESULT;
-            (yyval.u_list)->option.result = (yyvsp[(2) - (3)].u_result);
-        }
-            break;
+  case 23: /* value_list: value  */
+#line 325 "gdbmi_grammar.y"
+                  {
+  (yyval.u_value) = append_gdbmi_value (NULL, (yyvsp[0].u_value));	
+}
+#line 1539 "gdbmi_grammar.c"
+    break;
 
-        case 34:
+  case 24: /* value_list: value_list COMMA value  */
+#line 329 "gdbmi_grammar.y"
+                                   {
+  (yyval.u_value) = append_gdbmi_value ((yyvsp[-2].u_value), (yyvsp[0].u_value)); 
+}
+#line 1547 "gdbmi_grammar.c"
+    break;
+
+  case 25: /* value: CSTRING  */
+#line 333 "gdbmi_grammar.y"
+               {
+  (yyval.u_value) = create_gdbmi_value (gdbmi_pdata->arena);
+  (yyval.u_value)->value_choice = GDBMI_CSTRING;
+  gdbmi_text_cstring (gdbmi_pdata->arena, &(yyvsp[0].u_text), &(yyval.u_value)->option.cstring);
+}
+#line 1557 "gdbmi_grammar.c"
+    break;
+
+  case 26: /* value: tuple  */
+#line 339 "gdbmi_grammar.y"
+             {
+  (yyval.u_value) = create_gdbmi_value (gdbmi_pdata->arena);
+  (yyval.u_value)->value_choice = GDBMI_TUPLE;
+  (yyval.u_value)->option.tuple = (yyvsp[0].u_tuple);
+}
+#line 1567 "gdbmi_grammar.c"
+    break;
+
+  case 27: /* value: list  */
+#line 345 "gdbmi_grammar.y"
+            {
+  (yyval.u_value) = create_gdbmi_value (gdbmi_pdata->arena);
+  (yyval.u_value)->value_choice = GDBMI_LIST;
+  (yyval.u_value)->option.list = (yyvsp[0].u_list);
+}
+#line 1577 "gdbmi_grammar.c"
+    break;
+
+  case 28: /* value: LAZY_VALUE  */
+#line 351 "gdbmi_grammar.y"
+                  {
+  (yyval.u_value) = create_gdbmi_value (gdbmi_pdata->arena);
+  (yyval.u_value)->value_choice = GDBMI_LAZY;
+  (yyval.u_value)->option.lazy.data = gdbmi_text_dup (gdbmi_pdata->arena, &(yyvsp[0].u_text));
+  (yyval.u_value)->option.lazy.length = (yyvsp[0].u_text).length;
+  (yyval.u_value)->option.lazy.arena = gdbmi_pdata->arena;
+}
+#line 1589 "gdbmi_grammar.c"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 276 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_stream_record) = create_gdbmi_stream_record();
-            (yyval.u_stream_record)->stream_record =
-                    (yyvsp[(1) - (2)].u_stream_record_choice);
-            (yyval.u_stream_record)->cstring = strdup(gdbmi_text);
-        }
-            break;
+  case 29: /* tuple: OPEN_BRACE CLOSED_BRACE  */
+#line 359 "gdbmi_grammar.y"
+                               {
+  (yyval.u_tuple) = NULL;
+}
+#line 1597 "gdbmi_grammar.c"
+    break;
+
+  case 30: /* tuple: OPEN_BRACE result_list CLOSED_BRACE  */
+#line 363 "gdbmi_grammar.y"
+                                           {
+  (yyval.u_tuple) = create_gdbmi_tuple (gdbmi_pdata->arena);
+  (yyval.u_tuple)->result = (yyvsp[-1].u_result);
+}
+#line 1606 "gdbmi_grammar.c"
+    break;
 
-        case 35:
+  case 31: /* list: OPEN_BRACKET CLOSED_BRACKET  */
+#line 368 "gdbmi_grammar.y"
+                                  {
+  (yyval.u_list) = NULL;
+}
+#line 1614 "gdbmi_grammar.c"
+    break;
+
+  case 32: /* list: OPEN_BRACKET value_list CLOSED_BRACKET  */
+#line 372 "gdbmi_grammar.y"
+                                             {
+  (yyval.u_list) = create_gdbmi_list (gdbmi_pdata->arena);
+  (yyval.u_list)->list_choice = GDBMI_VALUE;
+  (yyval.u_list)->option.value = (yyvsp[-1].u_value);
+}
+#line 1624 "gdbmi_grammar.c"
+    break;
+
+  case 33: /* list: OPEN_BRACKET result_list CLOSED_BRACKET  */
+#line 378 "gdbmi_grammar.y"
+                                              {
+  (yyval.u_list) = create_gdbmi_list (gdbmi_pdata->arena);
+  (yyval.u_list)->list_choice = GDBMI_RESULT;
+  (yyval.u_list)->option.result = (yyvsp[-1].u_result);
+}
+#line 1634 "gdbmi_grammar.c"
+    break;
+
+  case 34: /* stream_record: stream_record_class CSTRING  */
+#line 384 "gdbmi_grammar.y"
+                                           {
+  (yyval.u_stream_record) = create_gdbmi_stream_record (gdbmi_pdata->arena);
+  (yyval.u_stream_record)->stream_record = (yyvsp[-1].u_stream_record_choice);
+  gdbmi_text_cstring (gdbmi_pdata->arena, &(yyvsp[0].u_text), &(yyval.u_stream_record)->cstring);
+}
+#line 1644 "gdbmi_grammar.c"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 282 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_stream_record_choice) = GDBMI_CONSOLE;
-        }
-            break;
+  case 35: /* stream_record_class: TILDA  */
+#line 390 "gdbmi_grammar.y"
+                           {
+  (yyval.u_stream_record_choice) = GDBMI_CONSOLE;
+}
+#line 1652 "gdbmi_grammar.c"
+    break;
 
-        case 36:
+  case 36: /* stream_record_class: AT_SYMBOL  */
+#line 394 "gdbmi_grammar.y"
+                               {
+  (yyval.u_stream_record_choice) = GDBMI_TARGET;
+}
+#line 1660 "gdbmi_grammar.c"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 286 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_stream_record_choice) = GDBMI_TARGET;
-        }
-            break;
+  case 37: /* stream_record_class: AMPERSAND  */
+#line 398 "gdbmi_grammar.y"
+                               {
+  (yyval.u_stream_record_choice) = GDBMI_LOG;
+}
+#line 1668 "gdbmi_grammar.c"
+    break;
 
-        case 37:
+  case 38: /* opt_token: %empty  */
+#line 402 "gdbmi_grammar.y"
+           {
+  (yyval.u_token) = -1;	
+}
+#line 1676 "gdbmi_grammar.c"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 290 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_stream_record_choice) = GDBMI_LOG;
-        }
-            break;
+  case 39: /* opt_token: token  */
+#line 406 "gdbmi_grammar.y"
+                 {
+  (yyval.u_token) = (yyvsp[0].u_token);
+}
+#line 1684 "gdbmi_grammar.c"
+    break;
 
-        case 38:
+  case 40: /* token: INTEGER_LITERAL  */
+#line 410 "gdbmi_grammar.y"
+                       {
+  (yyval.u_token) = gdbmi_text_number (&(yyvsp[0].u_text));
+}
+#line 1692 "gdbmi_grammar.c"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 294 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_token) = -1;
-        }
-            break;
 
-        case 39:
+#line 1696 "gdbmi_grammar.c"
 
-/* Line 1464 of yacc.c  */
-#line 298 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-        {
-            (yyval.u_token) = (yyvsp[(1) - (1)].u_token);
-        }
-            break;
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (gdbmi_pdata, gdbmi_scanner, YY_("syntax error"));
+    }
 
-        case 40:
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
 
-/* Line 1464 of yacc.c  */
-#line 302 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
+      if (yychar <= YYEOF)
         {
-            (yyval.u_token) = atol(gdbmi_text);
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
         }
-            break;
-
-/* Line 1464 of yacc.c  */
-#line 1934 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.c"
-        default:
-            break;
-    }
-    YY_SYMBOL_PRINT("-> $$ =", yyr1[yyn], &yyval, &yyloc);
-
-    YYPOPSTACK(yylen);
-    yylen = 0;
-    YY_STACK_PRINT(yyss, yyssp);
-
-    *++yyvsp = yyval;
-
-    /* Now `shift' the result of the reduction.  Determine what state
-       that goes to, based on the state we popped back to and the rule
-       number reduced by.  */
-
-    yyn = yyr1[yyn];
-
-    yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-    if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-        yystate = yytable[yystate];
-    else
-        yystate = yydefgoto[yyn - YYNTOKENS];
-
-    goto yynewstate;
-
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
-  yyerrlab:
-    /* If not already recovering from an error, report this error.  */
-    if (!yyerrstatus) {
-        ++yynerrs;
-#if ! YYERROR_VERBOSE
-        yyerror(gdbmi_pdata, YY_("syntax error"));
-#else
+      else
         {
-            YYSIZE_T yysize = yysyntax_error(0, yystate, yychar);
-
-            if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM) {
-                YYSIZE_T yyalloc = 2 * yysize;
-
-                if (!(yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-                    yyalloc = YYSTACK_ALLOC_MAXIMUM;
-                if (yymsg != yymsgbuf)
-                    YYSTACK_FREE(yymsg);
-                yymsg = (char *) YYSTACK_ALLOC(yyalloc);
-                if (yymsg)
-                    yymsg_alloc = yyalloc;
-                else {
-                    yymsg = yymsgbuf;
-                    yymsg_alloc = sizeof yymsgbuf;
-                }
-            }
-
-            if (0 < yysize && yysize <= yymsg_alloc) {
-                (void) yysyntax_error(yymsg, yystate, yychar);
-                yyerror(gdbmi_pdata, yymsg);
-            } else {
-                yyerror(gdbmi_pdata, YY_("syntax error"));
-                if (yysize != 0)
-                    goto yyexhaustedlab;
-            }
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, gdbmi_pdata, gdbmi_scanner);
+          yychar = YYEMPTY;
         }
-#endif
     }
 
-    if (yyerrstatus == 3) {
-        /* If just tried and failed to reuse lookahead token after an
-           error, discard it.  */
-
-        if (yychar <= YYEOF) {
-            /* Return failure if at end of input.  */
-            if (yychar == YYEOF)
-                YYABORT;
-        } else {
-            yydestruct("Error: discarding", yytoken, &yylval, gdbmi_pdata);
-            yychar = YYEMPTY;
-        }
-    }
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
 
-    /* Else will try to reuse lookahead token after shifting the error
-       token.  */
-    goto yyerrlab1;
 
 /*---------------------------------------------------.
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
-  yyerrorlab:
-
-    /* Pacify compilers like GCC when the user code never invokes
-       YYERROR and the label yyerrorlab therefore never appears in user
-       code.  */
-    if ( /*CONSTCOND*/ 0)
-        goto yyerrorlab;
-
-    /* Do not reclaim the symbols of the rule which action triggered
-       this YYERROR.  */
-    YYPOPSTACK(yylen);
-    yylen = 0;
-    YY_STACK_PRINT(yyss, yyssp);
-    yystate = *yyssp;
-    goto yyerrlab1;
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
 
 /*-------------------------------------------------------------.
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
-  yyerrlab1:
-    yyerrstatus = 3;            /* Each real token shifted decrements this.  */
-
-    for (;;) {
-        yyn = yypact[yystate];
-        if (yyn != YYPACT_NINF) {
-            yyn += YYTERROR;
-            if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR) {
-                yyn = yytable[yyn];
-                if (0 < yyn)
-                    break;
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
             }
         }
 
-        /* Pop the current state because it cannot handle the error token.  */
-        if (yyssp == yyss)
-            YYABORT;
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
 
-        yydestruct("Error: popping", yystos[yystate], yyvsp, gdbmi_pdata);
-        YYPOPSTACK(1);
-        yystate = *yyssp;
-        YY_STACK_PRINT(yyss, yyssp);
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, gdbmi_pdata, gdbmi_scanner);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
     }
 
-    *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
 
-    /* Shift the error token.  */
-    YY_SYMBOL_PRINT("Shifting", yystos[yyn], yyvsp, yylsp);
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
 
-    yystate = yyn;
-    goto yynewstate;
 
 /*-------------------------------------.
 | yyacceptlab -- YYACCEPT comes here.  |
 `-------------------------------------*/
-  yyacceptlab:
-    yyresult = 0;
-    goto yyreturn;
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
-  yyabortlab:
-    yyresult = 1;
-    goto yyreturn;
-
-#if !defined(yyoverflow) || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
-  yyexhaustedlab:
-    yyerror(gdbmi_pdata, YY_("memory exhausted"));
-    yyresult = 2;
-    /* Fall through.  */
-#endif
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
 
-  yyreturn:
-    if (yychar != YYEMPTY)
-        yydestruct("Cleanup: discarding lookahead",
-                yytoken, &yylval, gdbmi_pdata);
-    /* Do not reclaim the symbols of the rule which action triggered
-       this YYABORT or YYACCEPT.  */
-    YYPOPSTACK(yylen);
-    YY_STACK_PRINT(yyss, yyssp);
-    while (yyssp != yyss) {
-        yydestruct("Cleanup: popping", yystos[*yyssp], yyvsp, gdbmi_pdata);
-        YYPOPSTACK(1);
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (gdbmi_pdata, gdbmi_scanner, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, gdbmi_pdata, gdbmi_scanner);
     }
-#ifndef yyoverflow
-    if (yyss != yyssa)
-        YYSTACK_FREE(yyss);
-#endif
-    yyps->yynew = 1;
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, gdbmi_pdata, gdbmi_scanner);
+      YYPOPSTACK (1);
+    }
+  yyps->yynew = 2;
+  goto yypushreturn;
 
-  yypushreturn:
-#if YYERROR_VERBOSE
-    if (yymsg != yymsgbuf)
-        YYSTACK_FREE(yymsg);
-#endif
-    /* Make sure YYID is used.  */
-    return YYID(yyresult);
+
+/*-------------------------.
+| yypushreturn -- return.  |
+`-------------------------*/
+yypushreturn:
+
+  return yyresult;
 }
+#undef gdbmi_nerrs
+#undef yystate
+#undef yyerrstatus
+#undef yyssa
+#undef yyss
+#undef yyssp
+#undef yyvsa
+#undef yyvs
+#undef yyvsp
+#undef yystacksize
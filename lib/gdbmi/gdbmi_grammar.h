@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.3a+.  */
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,117 +27,127 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_GDBMI_GDBMI_GRAMMAR_H_INCLUDED
+# define YY_GDBMI_GDBMI_GRAMMAR_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int gdbmi_debug;
+#endif
 /* "%code requires" blocks.  */
+#line 5 "gdbmi_grammar.y"
+
+#include <stddef.h>
 
-/* Line 1685 of yacc.c  */
-#line 5 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
 struct gdbmi_pdata;
 
-/* Line 1685 of yacc.c  */
-#line 44 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.h"
+/* The text of a token, it points into the text being parsed */
+struct gdbmi_text {
+  const char *data;
+  size_t length;
+};
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-#define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-enum yytokentype {
-    OPEN_BRACE = 258,
-    CLOSED_BRACE = 259,
-    OPEN_PAREN = 260,
-    CLOSED_PAREN = 261,
-    ADD_OP = 262,
-    MULT_OP = 263,
-    EQUAL_SIGN = 264,
-    TILDA = 265,
-    AT_SYMBOL = 266,
-    AMPERSAND = 267,
-    OPEN_BRACKET = 268,
-    CLOSED_BRACKET = 269,
-    NEWLINE = 270,
-    INTEGER_LITERAL = 271,
-    STRING_LITERAL = 272,
-    CSTRING = 273,
-    COMMA = 274,
-    CARROT = 275
+/* The text the lexer reads, it belongs to the caller of the parser */
+struct gdbmi_input {
+  const char *data;
+  size_t length;
+  size_t read;		/* How much of it was handed to flex */
+  size_t scanned;	/* How much of it the tokens so far cover */
+  int lazy;		/* 1 if tuples and lists are left for later */
+  int depth;		/* How deep the lexer is in a tuple or list */
+  size_t lazy_start;	/* Where that tuple or list started */
 };
+
+#line 72 "gdbmi_grammar.h"
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    OPEN_BRACE = 258,              /* OPEN_BRACE  */
+    CLOSED_BRACE = 259,            /* CLOSED_BRACE  */
+    OPEN_PAREN = 260,              /* OPEN_PAREN  */
+    CLOSED_PAREN = 261,            /* CLOSED_PAREN  */
+    ADD_OP = 262,                  /* ADD_OP  */
+    MULT_OP = 263,                 /* MULT_OP  */
+    EQUAL_SIGN = 264,              /* EQUAL_SIGN  */
+    TILDA = 265,                   /* TILDA  */
+    AT_SYMBOL = 266,               /* AT_SYMBOL  */
+    AMPERSAND = 267,               /* AMPERSAND  */
+    OPEN_BRACKET = 268,            /* OPEN_BRACKET  */
+    CLOSED_BRACKET = 269,          /* CLOSED_BRACKET  */
+    NEWLINE = 270,                 /* NEWLINE  */
+    INTEGER_LITERAL = 271,         /* INTEGER_LITERAL  */
+    STRING_LITERAL = 272,          /* STRING_LITERAL  */
+    CSTRING = 273,                 /* CSTRING  */
+    LAZY_VALUE = 274,              /* LAZY_VALUE  */
+    COMMA = 275,                   /* COMMA  */
+    CARROT = 276                   /* CARROT  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
-#define OPEN_BRACE 258
-#define CLOSED_BRACE 259
-#define OPEN_PAREN 260
-#define CLOSED_PAREN 261
-#define ADD_OP 262
-#define MULT_OP 263
-#define EQUAL_SIGN 264
-#define TILDA 265
-#define AT_SYMBOL 266
-#define AMPERSAND 267
-#define OPEN_BRACKET 268
-#define CLOSED_BRACKET 269
-#define NEWLINE 270
-#define INTEGER_LITERAL 271
-#define STRING_LITERAL 272
-#define CSTRING 273
-#define COMMA 274
-#define CARROT 275
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE {
-
-/* Line 1685 of yacc.c  */
-#line 53 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.y"
-
-    struct gdbmi_output *u_output;
-    struct gdbmi_oob_record *u_oob_record;
-    struct gdbmi_result_record *u_result_record;
-    int u_result_class;
-    int u_async_record_choice;
-    struct gdbmi_result *u_result;
-    long u_token;
-    struct gdbmi_async_record *u_async_record;
-    struct gdbmi_stream_record *u_stream_record;
-    int u_async_class;
-    char *u_variable;
-    struct gdbmi_value *u_value;
-    struct gdbmi_tuple *u_tuple;
-    struct gdbmi_list *u_list;
-    int u_stream_record_choice;
-
-/* Line 1685 of yacc.c  */
-#line 121 "../../../../cgdb/lib/gdbmi/src/gdbmi_grammar.h"
-} YYSTYPE;
-
-#define YYSTYPE_IS_TRIVIAL 1
-#define yystype YYSTYPE         /* obsolescent; will be withdrawn */
-#define YYSTYPE_IS_DECLARED 1
-#endif
+union YYSTYPE
+{
+#line 115 "gdbmi_grammar.y"
 
-#ifndef YYPUSH_DECLS
-#define YYPUSH_DECLS
-struct gdbmi_pstate;
-typedef struct gdbmi_pstate gdbmi_pstate;
-enum { YYPUSH_MORE = 4 };
+  struct gdbmi_text u_text;
+  struct gdbmi_output *u_output;
+  struct gdbmi_oob_record *u_oob_record;
+  struct gdbmi_result_record *u_result_record;
+  int u_result_class;
+  int u_async_record_choice;
+  struct gdbmi_result *u_result;
+  long u_token;
+  struct gdbmi_async_record *u_async_record;
+  struct gdbmi_stream_record *u_stream_record;
+  int u_async_class;
+  struct gdbmi_value *u_value;
+  struct gdbmi_tuple *u_tuple;
+  struct gdbmi_list *u_list;
+  int u_stream_record_choice;
 
-#if defined __STDC__ || defined __cplusplus
-int gdbmi_push_parse(gdbmi_pstate * yyps, int yypushed_char,
-        YYSTYPE const *yypushed_val, struct gdbmi_pdata *gdbmi_pdata);
-#else
-int gdbmi_push_parse();
-#endif
+#line 128 "gdbmi_grammar.h"
 
-#if defined __STDC__ || defined __cplusplus
-gdbmi_pstate *gdbmi_pstate_new(void);
-#else
-gdbmi_pstate *gdbmi_pstate_new();
-#endif
-#if defined __STDC__ || defined __cplusplus
-void gdbmi_pstate_delete(gdbmi_pstate * yyps);
-#else
-void gdbmi_pstate_delete();
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
+
+
+
+
+#ifndef YYPUSH_MORE_DEFINED
+# define YYPUSH_MORE_DEFINED
+enum { YYPUSH_MORE = 4 };
 #endif
+
+typedef struct gdbmi_pstate gdbmi_pstate;
+
+
+int gdbmi_push_parse (gdbmi_pstate *ps,
+                  int pushed_char, YYSTYPE const *pushed_val, struct gdbmi_pdata *gdbmi_pdata, void *gdbmi_scanner);
+
+gdbmi_pstate *gdbmi_pstate_new (void);
+void gdbmi_pstate_delete (gdbmi_pstate *ps);
+
+
+#endif /* !YY_GDBMI_GDBMI_GRAMMAR_H_INCLUDED  */
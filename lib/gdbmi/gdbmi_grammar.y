@@ -2,34 +2,95 @@
 %define api.pure
 %define api.push_pull "push"
 %defines
-%code requires { struct gdbmi_pdata; }
+%code requires {
+#include <stddef.h>
+
+struct gdbmi_pdata;
+
+/* The text of a token, it points into the text being parsed */
+struct gdbmi_text {
+  const char *data;
+  size_t length;
+};
+
+/* The text the lexer reads, it belongs to the caller of the parser */
+struct gdbmi_input {
+  const char *data;
+  size_t length;
+  size_t read;		/* How much of it was handed to flex */
+  size_t scanned;	/* How much of it the tokens so far cover */
+  int lazy;		/* 1 if tuples and lists are left for later */
+  int depth;		/* How deep the lexer is in a tuple or list */
+  size_t lazy_start;	/* Where that tuple or list started */
+};
+}
 %parse-param { struct gdbmi_pdata *gdbmi_pdata }
+%parse-param { void *gdbmi_scanner }
 
-%{
+%code {
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include "gdbmi_pt.h"
+#include "gdbmi_keyword.h"
 
-extern char *gdbmi_text;
-extern int gdbmi_lex (void);
-extern int gdbmi_lineno;
+/* flex */
+extern char *gdbmi_get_text (void *scanner);
+extern int gdbmi_get_lineno (void *scanner);
 
-void gdbmi_error (gdbmi_pdata_ptr gdbmi_pdata, const char *s)
+void gdbmi_error (gdbmi_pdata_ptr gdbmi_pdata, void *gdbmi_scanner,
+		  const char *s)
 { 
+  const char *text = gdbmi_get_text (gdbmi_scanner);
+
   fprintf (stderr, "%s:%d Error %s", __FILE__, __LINE__, s);
-  if (strcmp (gdbmi_text, "\n") == 0)
+  if (strcmp (text, "\n") == 0)
     fprintf (stderr, "%s:%d at end of line %d\n", __FILE__, __LINE__, 
-	     gdbmi_lineno);
+	     gdbmi_get_lineno (gdbmi_scanner));
   else 
-    {
-      fprintf (stderr, "%s:%d at token(%s), line (%d)\n", __FILE__, __LINE__, 
-	       gdbmi_text, gdbmi_lineno );
-      gdbmi_lex();
-      fprintf (stderr, "%s:%d before (%s)\n", __FILE__, __LINE__, gdbmi_text);
-    }
+    fprintf (stderr, "%s:%d at token(%s), line (%d)\n", __FILE__, __LINE__, 
+	     text, gdbmi_get_lineno (gdbmi_scanner));
+}
+
+/* Copies the text of a token into a string of the tree */
+static char *gdbmi_text_dup (gdbmi_arena_ptr arena,
+			     const struct gdbmi_text *text)
+{
+  return gdbmi_arena_strndup (arena, text->data, text->length);
+}
+
+/* Makes a c-string of the tree out of a CSTRING token, leaving its
+   escapes for when it's read */
+static void gdbmi_text_cstring (gdbmi_arena_ptr arena,
+				const struct gdbmi_text *text,
+				struct gdbmi_cstring *cstring)
+{
+  /* The quotes are left out */
+  cstring->length = text->length - 2;
+  cstring->data = gdbmi_arena_strndup (arena, text->data + 1,
+				       cstring->length);
+  cstring->escaped = memchr (text->data + 1, '\\', cstring->length) != NULL;
+}
+
+/* Compares the text of a token with a string */
+static int gdbmi_text_is (const struct gdbmi_text *text, const char *s)
+{
+  return strlen (s) == text->length &&
+    strncmp (s, text->data, text->length) == 0;
+}
+
+/* The number in the text of a token, which isn't null terminated */
+static long gdbmi_text_number (const struct gdbmi_text *text)
+{
+  long result = 0;
+  size_t i;
+
+  for (i = 0; i < text->length; i++)
+    result = result * 10 + (text->data[i] - '0');
+
+  return result;
+}
 }
-%}
 
 %token OPEN_BRACE	/* { */
 %token CLOSED_BRACE 	/* } */
@@ -44,13 +105,15 @@ void gdbmi_error (gdbmi_pdata_ptr gdbmi_pdata, const char *s)
 %token OPEN_BRACKET 	/* [ */
 %token CLOSED_BRACKET 	/* ] */
 %token NEWLINE		/* \n \r\n \r */
-%token INTEGER_LITERAL 	/* A number 1234 */
-%token STRING_LITERAL 	/* A string literal */
-%token CSTRING 		/* "a string like \" this " */
+%token <u_text> INTEGER_LITERAL 	/* A number 1234 */
+%token <u_text> STRING_LITERAL 	/* A string literal */
+%token <u_text> CSTRING 		/* "a string like \" this " */
+%token <u_text> LAZY_VALUE 	/* A whole {tuple} or [list], in lazy mode */
 %token COMMA		/* , */
 %token CARROT		/* ^ */
 
 %union {
+  struct gdbmi_text u_text;
   struct gdbmi_output *u_output;
   struct gdbmi_oob_record *u_oob_record;
   struct gdbmi_result_record *u_result_record;
@@ -61,7 +124,6 @@ void gdbmi_error (gdbmi_pdata_ptr gdbmi_pdata, const char *s)
   struct gdbmi_async_record *u_async_record;
   struct gdbmi_stream_record *u_stream_record;
   int u_async_class;
-  char *u_variable;
   struct gdbmi_value *u_value;
   struct gdbmi_tuple *u_tuple;
   struct gdbmi_list *u_list;
@@ -71,8 +133,7 @@ void gdbmi_error (gdbmi_pdata_ptr gdbmi_pdata, const char *s)
 %type <u_output> output_list
 %type <u_output> output
 %type <u_oob_record> oob_record
-%type <u_oob_record> opt_oob_record_list
-%type <u_result_record> opt_result_record
+%type <u_output> record_list
 %type <u_result_record> result_record
 %type <u_result_class> result_class
 %type <u_async_record_choice> async_record_class
@@ -83,7 +144,7 @@ void gdbmi_error (gdbmi_pdata_ptr gdbmi_pdata, const char *s)
 %type <u_async_record> async_record
 %type <u_stream_record> stream_record
 %type <u_async_class> async_class
-%type <u_variable> variable
+%type <u_text> variable
 %type <u_value> value
 %type <u_value> value_list
 %type <u_tuple> tuple
@@ -95,6 +156,7 @@ void gdbmi_error (gdbmi_pdata_ptr gdbmi_pdata, const char *s)
 
 output_list: output {
   gdbmi_pdata->tree = $1;
+  gdbmi_pdata->parsed_one = 1;
 };
 
 output_list: output_list output {
@@ -102,68 +164,69 @@ output_list: output_list output {
   gdbmi_pdata->parsed_one = 1;
 };
 
-output: opt_oob_record_list opt_result_record OPEN_PAREN variable CLOSED_PAREN NEWLINE { 
-  $$ = create_gdbmi_output ();
-  $$->oob_record = $1;
-  $$->result_record = $2;
+output: record_list OPEN_PAREN variable CLOSED_PAREN NEWLINE { 
+  $$ = $1;
 
-  if (strcmp ("gdb", $4) != 0)
-    gdbmi_error (gdbmi_pdata, "Syntax error, expected 'gdb'");
+  /* The output takes the arena its nodes are in, the next output gets
+     a new one */
+  $$->arena = gdbmi_pdata->arena;
+  gdbmi_pdata->arena = NULL;
 
-  free ($4);
+  if (!gdbmi_text_is (&$3, "gdb"))
+    gdbmi_error (gdbmi_pdata, gdbmi_scanner, "Syntax error, expected 'gdb'");
 } ;
 
-opt_oob_record_list: {
-  $$ = NULL;
+/* gdb writes asynchronous records after the result record too, like
+   *running after ^running, so the records are taken in any order */
+record_list: {
+  $$ = create_gdbmi_output (gdbmi_pdata->arena);
 };
 
-opt_oob_record_list: opt_oob_record_list oob_record NEWLINE {
-  $$ = append_gdbmi_oob_record ($1, $2);
-};
-
-opt_result_record: {
-  $$ = NULL;
+record_list: record_list oob_record NEWLINE {
+  $$ = $1;
+  $$->oob_record = append_gdbmi_oob_record ($$->oob_record, $2);
 };
 
-opt_result_record: result_record NEWLINE {
+record_list: record_list result_record NEWLINE {
   $$ = $1;
+  $$->result_record = $2;
 };
 
 result_record: opt_token CARROT result_class {
-  $$ = create_gdbmi_result_record ();
+  $$ = create_gdbmi_result_record (gdbmi_pdata->arena);
   $$->token = $1;
   $$->result_class = $3;
   $$->result = NULL;
 };
 
 result_record: opt_token CARROT result_class COMMA result_list {
-  $$ = create_gdbmi_result_record ();
+  $$ = create_gdbmi_result_record (gdbmi_pdata->arena);
   $$->token = $1;
   $$->result_class = $3;
   $$->result = $5;
 };
 
 oob_record: async_record {
-  $$ = create_gdbmi_oob_record();
+  $$ = create_gdbmi_oob_record (gdbmi_pdata->arena);
   $$->record = GDBMI_ASYNC;
   $$->option.async_record = $1;
 };
 
 oob_record: stream_record {
-  $$ = create_gdbmi_oob_record();
+  $$ = create_gdbmi_oob_record (gdbmi_pdata->arena);
   $$->record = GDBMI_STREAM;
   $$->option.stream_record = $1;
 };
 
 async_record: opt_token async_record_class async_class {
-  $$ = create_gdbmi_async_record ();
+  $$ = create_gdbmi_async_record (gdbmi_pdata->arena);
   $$->token = $1;
   $$->async_record = $2;
   $$->async_class = $3;
 };
 
 async_record: opt_token async_record_class async_class COMMA result_list {
-  $$ = create_gdbmi_async_record ();
+  $$ = create_gdbmi_async_record (gdbmi_pdata->arena);
   $$->token = $1;
   $$->async_record = $2;
   $$->async_class = $3;
@@ -183,25 +246,61 @@ async_record_class: EQUAL_SIGN {
 };
 
 result_class: STRING_LITERAL {
-  if (strcmp ("done", gdbmi_text) == 0)
-    $$ = GDBMI_DONE;
-  else if (strcmp ("running", gdbmi_text) == 0)
-    $$ = GDBMI_RUNNING;
-  else if (strcmp ("connected", gdbmi_text) == 0)
-    $$ = GDBMI_CONNECTED;
-  else if (strcmp ("error", gdbmi_text) == 0)
-    $$ = GDBMI_ERROR;
-  else if (strcmp ("exit", gdbmi_text) == 0)
-    $$ = GDBMI_EXIT;
-  else
-    gdbmi_error (gdbmi_pdata, "Syntax error, expected 'done|running|connected|error|exit");
+  switch (gdbmi_keyword_lookup ($1.data, $1.length))
+    {
+    case GDBMI_KEYWORD_DONE:
+      $$ = GDBMI_DONE;
+      break;
+    case GDBMI_KEYWORD_RUNNING:
+      $$ = GDBMI_RUNNING;
+      break;
+    case GDBMI_KEYWORD_CONNECTED:
+      $$ = GDBMI_CONNECTED;
+      break;
+    case GDBMI_KEYWORD_ERROR:
+      $$ = GDBMI_ERROR;
+      break;
+    case GDBMI_KEYWORD_EXIT:
+      $$ = GDBMI_EXIT;
+      break;
+    default:
+      gdbmi_error (gdbmi_pdata, gdbmi_scanner, "Syntax error, expected 'done|running|connected|error|exit");
+      break;
+    }
 };
 
 async_class: STRING_LITERAL {
-  if (strcmp ("stopped", gdbmi_text) != 0)
-    gdbmi_error (gdbmi_pdata,  "Syntax error, expected 'stopped'" );
-
-  $$ = GDBMI_STOPPED;
+  switch (gdbmi_keyword_lookup ($1.data, $1.length))
+    {
+    case GDBMI_KEYWORD_STOPPED:
+      $$ = GDBMI_STOPPED;
+      break;
+    case GDBMI_KEYWORD_RUNNING:
+      $$ = GDBMI_ASYNC_RUNNING;
+      break;
+    case GDBMI_KEYWORD_BREAKPOINT_CREATED:
+      $$ = GDBMI_BREAKPOINT_CREATED;
+      break;
+    case GDBMI_KEYWORD_BREAKPOINT_MODIFIED:
+      $$ = GDBMI_BREAKPOINT_MODIFIED;
+      break;
+    case GDBMI_KEYWORD_BREAKPOINT_DELETED:
+      $$ = GDBMI_BREAKPOINT_DELETED;
+      break;
+    case GDBMI_KEYWORD_THREAD_SELECTED:
+      $$ = GDBMI_THREAD_SELECTED;
+      break;
+    case GDBMI_KEYWORD_THREAD_CREATED:
+      $$ = GDBMI_THREAD_CREATED;
+      break;
+    case GDBMI_KEYWORD_THREAD_EXITED:
+      $$ = GDBMI_THREAD_EXITED;
+      break;
+    default:
+      /* GDB adds new notifications all the time, they aren't errors */
+      $$ = GDBMI_ASYNC_UNKNOWN;
+      break;
+    }
 };
 
 result_list: result {
@@ -213,13 +312,14 @@ result_list: result_list COMMA result {
 };
 
 result: variable EQUAL_SIGN value {
-  $$ = create_gdbmi_result ();
-  $$->variable = $1;
+  $$ = create_gdbmi_result (gdbmi_pdata->arena);
+  $$->variable = gdbmi_text_dup (gdbmi_pdata->arena, &$1);
+  $$->keyword = gdbmi_keyword_lookup ($1.data, $1.length);
   $$->value = $3;
 };
 
 variable: STRING_LITERAL {
-  $$ = strdup (gdbmi_text);
+  $$ = $1;
 };
 
 value_list: value {
@@ -231,29 +331,37 @@ value_list: value_list COMMA value {
 };
 
 value: CSTRING {
-  $$ = create_gdbmi_value ();
+  $$ = create_gdbmi_value (gdbmi_pdata->arena);
   $$->value_choice = GDBMI_CSTRING;
-  $$->option.cstring = strdup (gdbmi_text); 
+  gdbmi_text_cstring (gdbmi_pdata->arena, &$1, &$$->option.cstring);
 };
 
 value: tuple {
-  $$ = create_gdbmi_value ();
+  $$ = create_gdbmi_value (gdbmi_pdata->arena);
   $$->value_choice = GDBMI_TUPLE;
   $$->option.tuple = $1;
 };
 
 value: list {
-  $$ = create_gdbmi_value ();
+  $$ = create_gdbmi_value (gdbmi_pdata->arena);
   $$->value_choice = GDBMI_LIST;
   $$->option.list = $1;
 };
 
+value: LAZY_VALUE {
+  $$ = create_gdbmi_value (gdbmi_pdata->arena);
+  $$->value_choice = GDBMI_LAZY;
+  $$->option.lazy.data = gdbmi_text_dup (gdbmi_pdata->arena, &$1);
+  $$->option.lazy.length = $1.length;
+  $$->option.lazy.arena = gdbmi_pdata->arena;
+};
+
 tuple: OPEN_BRACE CLOSED_BRACE {
   $$ = NULL;
 };
 
 tuple: OPEN_BRACE result_list CLOSED_BRACE {
-  $$ = create_gdbmi_tuple ();
+  $$ = create_gdbmi_tuple (gdbmi_pdata->arena);
   $$->result = $2;
 };
 
@@ -262,21 +370,21 @@ list: OPEN_BRACKET CLOSED_BRACKET {
 };
 
 list: OPEN_BRACKET value_list CLOSED_BRACKET {
-  $$ = create_gdbmi_list ();
+  $$ = create_gdbmi_list (gdbmi_pdata->arena);
   $$->list_choice = GDBMI_VALUE;
   $$->option.value = $2;
 };
 
 list: OPEN_BRACKET result_list CLOSED_BRACKET {
-  $$ = create_gdbmi_list ();
+  $$ = create_gdbmi_list (gdbmi_pdata->arena);
   $$->list_choice = GDBMI_RESULT;
   $$->option.result = $2;
 };
 
 stream_record: stream_record_class CSTRING {
-  $$ = create_gdbmi_stream_record ();
+  $$ = create_gdbmi_stream_record (gdbmi_pdata->arena);
   $$->stream_record = $1;
-  $$->cstring = strdup ( gdbmi_text );
+  gdbmi_text_cstring (gdbmi_pdata->arena, &$2, &$$->cstring);
 };
 
 stream_record_class: TILDA {
@@ -300,5 +408,5 @@ opt_token: token {
 };
 
 token: INTEGER_LITERAL {
-  $$ = atol (gdbmi_text);
+  $$ = gdbmi_text_number (&$1);
 };
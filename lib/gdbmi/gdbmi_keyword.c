@@ -0,0 +1,477 @@
+#include <string.h>
+#include "gdbmi_keyword.h"
+
+/* The text of each keyword, in the order of the enum  */
+static const char *const gdbmi_keyword_names[] = {
+    NULL,
+    "done",
+    "running",
+    "connected",
+    "error",
+    "exit",
+    "stopped",
+    "breakpoint-created",
+    "breakpoint-modified",
+    "breakpoint-deleted",
+    "thread-selected",
+    "thread-created",
+    "thread-exited",
+    "breakpoint-hit",
+    "watchpoint-trigger",
+    "read-watchpoint-trigger",
+    "access-watchpoint-trigger",
+    "function-finished",
+    "location-reached",
+    "watchpoint-scope",
+    "end-stepping-range",
+    "exited-signalled",
+    "exited",
+    "exited-normally",
+    "signal-received",
+    "solib-event",
+    "fork",
+    "vfork",
+    "syscall-entry",
+    "syscall-return",
+    "exec",
+    "no-history",
+    "BreakpointTable",
+    "addr",
+    "begin",
+    "bkpt",
+    "body",
+    "changelist",
+    "child",
+    "children",
+    "contents",
+    "disp",
+    "enabled",
+    "exit-code",
+    "exp",
+    "file",
+    "files",
+    "frame",
+    "fullname",
+    "func",
+    "id",
+    "in_scope",
+    "level",
+    "line",
+    "memory",
+    "msg",
+    "name",
+    "new_num_children",
+    "new_type",
+    "number",
+    "numchild",
+    "offset",
+    "reason",
+    "signal-name",
+    "stack",
+    "stopped-threads",
+    "thread-id",
+    "times",
+    "type",
+    "type_changed",
+    "value",
+    "variables",
+    "-file-list-exec-source-file",
+    "-file-list-exec-source-files",
+    "-break-list",
+    "-stack-info-frame",
+    "-stack-list-frames",
+    "-stack-list-variables",
+    "-var-create",
+    "-var-update",
+    "-var-list-children",
+    "-data-read-memory-bytes",
+};
+
+/* The keywords are told apart with a switch on the length of the text,
+   then on the bytes that differ between the keywords of that length, so
+   the text is only compared with the one keyword it could be. A keyword
+   that's added needs a case in the switch of its length, under a byte
+   that no other keyword of that length has there.  */
+enum gdbmi_keyword gdbmi_keyword_lookup(const char *text, size_t length)
+{
+    enum gdbmi_keyword keyword;
+
+    switch (length) {
+        case 2:
+            keyword = GDBMI_KEYWORD_ID;
+            break;
+        case 3:
+            switch (text[0]) {
+                case 'e':
+                    keyword = GDBMI_KEYWORD_EXP;
+                    break;
+                case 'm':
+                    keyword = GDBMI_KEYWORD_MSG;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 4:
+            switch (text[2]) {
+                case 'd':
+                    switch (text[0]) {
+                        case 'a':
+                            keyword = GDBMI_KEYWORD_ADDR;
+                            break;
+                        case 'b':
+                            keyword = GDBMI_KEYWORD_BODY;
+                            break;
+                        default:
+                            return GDBMI_KEYWORD_UNKNOWN;
+                    }
+                    break;
+                case 'e':
+                    keyword = GDBMI_KEYWORD_EXEC;
+                    break;
+                case 'i':
+                    keyword = GDBMI_KEYWORD_EXIT;
+                    break;
+                case 'l':
+                    keyword = GDBMI_KEYWORD_FILE;
+                    break;
+                case 'm':
+                    keyword = GDBMI_KEYWORD_NAME;
+                    break;
+                case 'n':
+                    switch (text[0]) {
+                        case 'd':
+                            keyword = GDBMI_KEYWORD_DONE;
+                            break;
+                        case 'f':
+                            keyword = GDBMI_KEYWORD_FUNC;
+                            break;
+                        case 'l':
+                            keyword = GDBMI_KEYWORD_LINE;
+                            break;
+                        default:
+                            return GDBMI_KEYWORD_UNKNOWN;
+                    }
+                    break;
+                case 'p':
+                    switch (text[0]) {
+                        case 'b':
+                            keyword = GDBMI_KEYWORD_BKPT;
+                            break;
+                        case 't':
+                            keyword = GDBMI_KEYWORD_TYPE;
+                            break;
+                        default:
+                            return GDBMI_KEYWORD_UNKNOWN;
+                    }
+                    break;
+                case 'r':
+                    keyword = GDBMI_KEYWORD_FORK;
+                    break;
+                case 's':
+                    keyword = GDBMI_KEYWORD_DISP;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 5:
+            switch (text[0]) {
+                case 'b':
+                    keyword = GDBMI_KEYWORD_BEGIN;
+                    break;
+                case 'c':
+                    keyword = GDBMI_KEYWORD_CHILD;
+                    break;
+                case 'e':
+                    keyword = GDBMI_KEYWORD_ERROR;
+                    break;
+                case 'f':
+                    switch (text[1]) {
+                        case 'i':
+                            keyword = GDBMI_KEYWORD_FILES;
+                            break;
+                        case 'r':
+                            keyword = GDBMI_KEYWORD_FRAME;
+                            break;
+                        default:
+                            return GDBMI_KEYWORD_UNKNOWN;
+                    }
+                    break;
+                case 'l':
+                    keyword = GDBMI_KEYWORD_LEVEL;
+                    break;
+                case 's':
+                    keyword = GDBMI_KEYWORD_STACK;
+                    break;
+                case 't':
+                    keyword = GDBMI_KEYWORD_TIMES;
+                    break;
+                case 'v':
+                    switch (text[1]) {
+                        case 'a':
+                            keyword = GDBMI_KEYWORD_VALUE;
+                            break;
+                        case 'f':
+                            keyword = GDBMI_KEYWORD_VFORK;
+                            break;
+                        default:
+                            return GDBMI_KEYWORD_UNKNOWN;
+                    }
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 6:
+            switch (text[0]) {
+                case 'e':
+                    keyword = GDBMI_KEYWORD_EXITED;
+                    break;
+                case 'm':
+                    keyword = GDBMI_KEYWORD_MEMORY;
+                    break;
+                case 'n':
+                    keyword = GDBMI_KEYWORD_NUMBER;
+                    break;
+                case 'o':
+                    keyword = GDBMI_KEYWORD_OFFSET;
+                    break;
+                case 'r':
+                    keyword = GDBMI_KEYWORD_REASON;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 7:
+            switch (text[0]) {
+                case 'e':
+                    keyword = GDBMI_KEYWORD_ENABLED;
+                    break;
+                case 'r':
+                    keyword = GDBMI_KEYWORD_RUNNING;
+                    break;
+                case 's':
+                    keyword = GDBMI_KEYWORD_STOPPED;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 8:
+            switch (text[2]) {
+                case '_':
+                    keyword = GDBMI_KEYWORD_IN_SCOPE;
+                    break;
+                case 'i':
+                    keyword = GDBMI_KEYWORD_CHILDREN;
+                    break;
+                case 'l':
+                    keyword = GDBMI_KEYWORD_FULLNAME;
+                    break;
+                case 'm':
+                    keyword = GDBMI_KEYWORD_NUMCHILD;
+                    break;
+                case 'n':
+                    keyword = GDBMI_KEYWORD_CONTENTS;
+                    break;
+                case 'w':
+                    keyword = GDBMI_KEYWORD_NEW_TYPE;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 9:
+            switch (text[0]) {
+                case 'c':
+                    keyword = GDBMI_KEYWORD_CONNECTED;
+                    break;
+                case 'e':
+                    keyword = GDBMI_KEYWORD_EXIT_CODE;
+                    break;
+                case 't':
+                    keyword = GDBMI_KEYWORD_THREAD_ID;
+                    break;
+                case 'v':
+                    keyword = GDBMI_KEYWORD_VARIABLES;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 10:
+            switch (text[0]) {
+                case 'c':
+                    keyword = GDBMI_KEYWORD_CHANGELIST;
+                    break;
+                case 'n':
+                    keyword = GDBMI_KEYWORD_NO_HISTORY;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 11:
+            switch (text[5]) {
+                case '-':
+                    keyword = GDBMI_KEYWORD_SOLIB_EVENT;
+                    break;
+                case 'c':
+                    keyword = GDBMI_KEYWORD_VAR_CREATE;
+                    break;
+                case 'k':
+                    keyword = GDBMI_KEYWORD_BREAK_LIST;
+                    break;
+                case 'l':
+                    keyword = GDBMI_KEYWORD_SIGNAL_NAME;
+                    break;
+                case 'u':
+                    keyword = GDBMI_KEYWORD_VAR_UPDATE;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 12:
+            keyword = GDBMI_KEYWORD_TYPE_CHANGED;
+            break;
+        case 13:
+            switch (text[0]) {
+                case 's':
+                    keyword = GDBMI_KEYWORD_SYSCALL_ENTRY;
+                    break;
+                case 't':
+                    keyword = GDBMI_KEYWORD_THREAD_EXITED;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 14:
+            switch (text[0]) {
+                case 'b':
+                    keyword = GDBMI_KEYWORD_BREAKPOINT_HIT;
+                    break;
+                case 's':
+                    keyword = GDBMI_KEYWORD_SYSCALL_RETURN;
+                    break;
+                case 't':
+                    keyword = GDBMI_KEYWORD_THREAD_CREATED;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 15:
+            switch (text[1]) {
+                case 'h':
+                    keyword = GDBMI_KEYWORD_THREAD_SELECTED;
+                    break;
+                case 'i':
+                    keyword = GDBMI_KEYWORD_SIGNAL_RECEIVED;
+                    break;
+                case 'r':
+                    keyword = GDBMI_KEYWORD_BREAKPOINT_TABLE;
+                    break;
+                case 't':
+                    keyword = GDBMI_KEYWORD_STOPPED_THREADS;
+                    break;
+                case 'x':
+                    keyword = GDBMI_KEYWORD_EXITED_NORMALLY;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 16:
+            switch (text[0]) {
+                case 'e':
+                    keyword = GDBMI_KEYWORD_EXITED_SIGNALLED;
+                    break;
+                case 'l':
+                    keyword = GDBMI_KEYWORD_LOCATION_REACHED;
+                    break;
+                case 'n':
+                    keyword = GDBMI_KEYWORD_NEW_NUM_CHILDREN;
+                    break;
+                case 'w':
+                    keyword = GDBMI_KEYWORD_WATCHPOINT_SCOPE;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 17:
+            switch (text[0]) {
+                case '-':
+                    keyword = GDBMI_KEYWORD_STACK_INFO_FRAME;
+                    break;
+                case 'f':
+                    keyword = GDBMI_KEYWORD_FUNCTION_FINISHED;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 18:
+            switch (text[11]) {
+                case '-':
+                    keyword = GDBMI_KEYWORD_STACK_LIST_FRAMES;
+                    break;
+                case 'c':
+                    keyword = GDBMI_KEYWORD_BREAKPOINT_CREATED;
+                    break;
+                case 'd':
+                    keyword = GDBMI_KEYWORD_BREAKPOINT_DELETED;
+                    break;
+                case 'g':
+                    keyword = GDBMI_KEYWORD_END_STEPPING_RANGE;
+                    break;
+                case 'h':
+                    keyword = GDBMI_KEYWORD_VAR_LIST_CHILDREN;
+                    break;
+                case 't':
+                    keyword = GDBMI_KEYWORD_WATCHPOINT_TRIGGER;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 19:
+            keyword = GDBMI_KEYWORD_BREAKPOINT_MODIFIED;
+            break;
+        case 21:
+            keyword = GDBMI_KEYWORD_STACK_LIST_VARIABLES;
+            break;
+        case 23:
+            switch (text[0]) {
+                case '-':
+                    keyword = GDBMI_KEYWORD_DATA_READ_MEMORY_BYTES;
+                    break;
+                case 'r':
+                    keyword = GDBMI_KEYWORD_READ_WATCHPOINT_TRIGGER;
+                    break;
+                default:
+                    return GDBMI_KEYWORD_UNKNOWN;
+            }
+            break;
+        case 25:
+            keyword = GDBMI_KEYWORD_ACCESS_WATCHPOINT_TRIGGER;
+            break;
+        case 27:
+            keyword = GDBMI_KEYWORD_FILE_LIST_EXEC_SOURCE_FILE;
+            break;
+        case 28:
+            keyword = GDBMI_KEYWORD_FILE_LIST_EXEC_SOURCE_FILES;
+            break;
+        default:
+            return GDBMI_KEYWORD_UNKNOWN;
+    }
+
+    if (memcmp(text, gdbmi_keyword_names[keyword], length) != 0)
+        return GDBMI_KEYWORD_UNKNOWN;
+
+    return keyword;
+}
@@ -0,0 +1,114 @@
+#ifndef __GDBMI_KEYWORD_H__
+#define __GDBMI_KEYWORD_H__
+
+#include <stddef.h>
+
+/* The words of GDB/MI the front end looks for: the classes of the records,
+   the reasons the program stops for, the names of the results it reads,
+   and the commands whose results it reads. The parser finds the keyword of
+   each class and result name once, and they're compared as numbers from
+   then on.  */
+enum gdbmi_keyword {
+    /* Text that isn't a keyword */
+    GDBMI_KEYWORD_UNKNOWN,
+
+    /* The classes of result records */
+    GDBMI_KEYWORD_DONE,
+    GDBMI_KEYWORD_RUNNING,     /* Also the class of an asynchronous record */
+    GDBMI_KEYWORD_CONNECTED,
+    GDBMI_KEYWORD_ERROR,
+    GDBMI_KEYWORD_EXIT,
+
+    /* The classes of asynchronous records */
+    GDBMI_KEYWORD_STOPPED,
+    GDBMI_KEYWORD_BREAKPOINT_CREATED,
+    GDBMI_KEYWORD_BREAKPOINT_MODIFIED,
+    GDBMI_KEYWORD_BREAKPOINT_DELETED,
+    GDBMI_KEYWORD_THREAD_SELECTED,
+    GDBMI_KEYWORD_THREAD_CREATED,
+    GDBMI_KEYWORD_THREAD_EXITED,
+
+    /* The reasons the program stopped */
+    GDBMI_KEYWORD_BREAKPOINT_HIT,
+    GDBMI_KEYWORD_WATCHPOINT_TRIGGER,
+    GDBMI_KEYWORD_READ_WATCHPOINT_TRIGGER,
+    GDBMI_KEYWORD_ACCESS_WATCHPOINT_TRIGGER,
+    GDBMI_KEYWORD_FUNCTION_FINISHED,
+    GDBMI_KEYWORD_LOCATION_REACHED,
+    GDBMI_KEYWORD_WATCHPOINT_SCOPE,
+    GDBMI_KEYWORD_END_STEPPING_RANGE,
+    GDBMI_KEYWORD_EXITED_SIGNALLED,
+    GDBMI_KEYWORD_EXITED,
+    GDBMI_KEYWORD_EXITED_NORMALLY,
+    GDBMI_KEYWORD_SIGNAL_RECEIVED,
+    GDBMI_KEYWORD_SOLIB_EVENT,
+    GDBMI_KEYWORD_FORK,
+    GDBMI_KEYWORD_VFORK,
+    GDBMI_KEYWORD_SYSCALL_ENTRY,
+    GDBMI_KEYWORD_SYSCALL_RETURN,
+    GDBMI_KEYWORD_EXEC,
+    GDBMI_KEYWORD_NO_HISTORY,
+
+    /* The names of the results the front end reads */
+    GDBMI_KEYWORD_BREAKPOINT_TABLE,
+    GDBMI_KEYWORD_ADDR,
+    GDBMI_KEYWORD_BEGIN,
+    GDBMI_KEYWORD_BKPT,
+    GDBMI_KEYWORD_BODY,
+    GDBMI_KEYWORD_CHANGELIST,
+    GDBMI_KEYWORD_CHILD,
+    GDBMI_KEYWORD_CHILDREN,
+    GDBMI_KEYWORD_CONTENTS,
+    GDBMI_KEYWORD_DISP,
+    GDBMI_KEYWORD_ENABLED,
+    GDBMI_KEYWORD_EXIT_CODE,
+    GDBMI_KEYWORD_EXP,
+    GDBMI_KEYWORD_FILE,
+    GDBMI_KEYWORD_FILES,
+    GDBMI_KEYWORD_FRAME,
+    GDBMI_KEYWORD_FULLNAME,
+    GDBMI_KEYWORD_FUNC,
+    GDBMI_KEYWORD_ID,
+    GDBMI_KEYWORD_IN_SCOPE,
+    GDBMI_KEYWORD_LEVEL,
+    GDBMI_KEYWORD_LINE,
+    GDBMI_KEYWORD_MEMORY,
+    GDBMI_KEYWORD_MSG,
+    GDBMI_KEYWORD_NAME,
+    GDBMI_KEYWORD_NEW_NUM_CHILDREN,
+    GDBMI_KEYWORD_NEW_TYPE,
+    GDBMI_KEYWORD_NUMBER,
+    GDBMI_KEYWORD_NUMCHILD,
+    GDBMI_KEYWORD_OFFSET,
+    GDBMI_KEYWORD_REASON,
+    GDBMI_KEYWORD_SIGNAL_NAME,
+    GDBMI_KEYWORD_STACK,
+    GDBMI_KEYWORD_STOPPED_THREADS,
+    GDBMI_KEYWORD_THREAD_ID,
+    GDBMI_KEYWORD_TIMES,
+    GDBMI_KEYWORD_TYPE,
+    GDBMI_KEYWORD_TYPE_CHANGED,
+    GDBMI_KEYWORD_VALUE,
+    GDBMI_KEYWORD_VARIABLES,
+
+    /* The MI commands whose results are read */
+    GDBMI_KEYWORD_FILE_LIST_EXEC_SOURCE_FILE,
+    GDBMI_KEYWORD_FILE_LIST_EXEC_SOURCE_FILES,
+    GDBMI_KEYWORD_BREAK_LIST,
+    GDBMI_KEYWORD_STACK_INFO_FRAME,
+    GDBMI_KEYWORD_STACK_LIST_FRAMES,
+    GDBMI_KEYWORD_STACK_LIST_VARIABLES,
+    GDBMI_KEYWORD_VAR_CREATE,
+    GDBMI_KEYWORD_VAR_UPDATE,
+    GDBMI_KEYWORD_VAR_LIST_CHILDREN,
+    GDBMI_KEYWORD_DATA_READ_MEMORY_BYTES,
+
+    /* This is here only to represent the number of keywords */
+    GDBMI_KEYWORD_LAST
+};
+
+/* Finds the keyword a text is. The text doesn't have to be null
+   terminated, and it's gone through once at most.  */
+enum gdbmi_keyword gdbmi_keyword_lookup(const char *text, size_t length);
+
+#endif /* __GDBMI_KEYWORD_H__ */
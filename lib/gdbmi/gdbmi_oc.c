@@ -3,68 +3,49 @@
 #include <string.h>
 #include "gdbmi_oc.h"
 
-#if 0
-static const char *const async_reason_string_lookup[] = {
-    "breakpoint-hit",
-    "watchpoint-trigger",
-    "read-watchpoint-trigger",
-    "access-watchpoint-trigger",
-    "function-finished",
-    "location-reached",
-    "watchpoint-scope",
-    "end-stepping-range",
-    "exited-signalled",
-    "exited",
-    "exited-normally",
-    "signal-received",
-    NULL
-};
-
-/* Represents the reason why GDB is sending an asynchronous command to the
-   front end.  */
-enum async_reply_reason {
-    EXEC_ASYNC_BREAKPOINT_HIT = 0,
-    EXEC_ASYNC_WATCHPOINT_TRIGGER,
-    EXEC_ASYNC_READ_WATCHPOINT_TRIGGER,
-    EXEC_ASYNC_ACCESS_WATCHPOINT_TRIGGER,
-    EXEC_ASYNC_FUNCTION_FINISHED,
-    EXEC_ASYNC_LOCATION_REACHED,
-    EXEC_ASYNC_WATCHPOINT_SCOPE,
-    EXEC_ASYNC_END_STEPPING_RANGE,
-    EXEC_ASYNC_EXITED_SIGNALLED,
-    EXEC_ASYNC_EXITED,
-    EXEC_ASYNC_EXITED_NORMALLY,
-    EXEC_ASYNC_SIGNAL_RECEIVED,
-    /* This is here only to represent the number of enums.  */
-    EXEC_ASYNC_LAST
-};
-
-static const char *async_reason_lookup(enum async_reply_reason reason)
+/**
+ * Finds the MI input command a name is.
+ *
+ * \return
+ * The command, or GDBMI_LAST if the front end doesn't look at its results.
+ */
+static enum gdbmi_input_command gdbmi_input_command_lookup(const char *command)
 {
-    return async_reason_string_lookup[reason];
+    switch (gdbmi_keyword_lookup(command, strlen(command))) {
+        case GDBMI_KEYWORD_FILE_LIST_EXEC_SOURCE_FILE:
+            return GDBMI_FILE_LIST_EXEC_SOURCE_FILE;
+        case GDBMI_KEYWORD_FILE_LIST_EXEC_SOURCE_FILES:
+            return GDBMI_FILE_LIST_EXEC_SOURCE_FILES;
+        case GDBMI_KEYWORD_BREAK_LIST:
+            return GDBMI_BREAK_LIST;
+        case GDBMI_KEYWORD_STACK_INFO_FRAME:
+            return GDBMI_STACK_INFO_FRAME;
+        case GDBMI_KEYWORD_STACK_LIST_FRAMES:
+            return GDBMI_STACK_LIST_FRAMES;
+        case GDBMI_KEYWORD_STACK_LIST_VARIABLES:
+            return GDBMI_STACK_LIST_VARIABLES;
+        case GDBMI_KEYWORD_VAR_CREATE:
+            return GDBMI_VAR_CREATE;
+        case GDBMI_KEYWORD_VAR_UPDATE:
+            return GDBMI_VAR_UPDATE;
+        case GDBMI_KEYWORD_VAR_LIST_CHILDREN:
+            return GDBMI_VAR_LIST_CHILDREN;
+        case GDBMI_KEYWORD_DATA_READ_MEMORY_BYTES:
+            return GDBMI_DATA_READ_MEMORY_BYTES;
+        default:
+            return GDBMI_LAST;
+    }
 }
-#endif
-
-struct gdbmi_input_command_hash {
-    const char *const cstring_val;
-    enum gdbmi_input_command enum_val;
-} gdbmi_input_lookup[] = {
-    {
-    "-file-list-exec-source-file", GDBMI_FILE_LIST_EXEC_SOURCE_FILE}, {
-    "-file-list-exec-source-files", GDBMI_FILE_LIST_EXEC_SOURCE_FILES}, {
-    "-break-list", GDBMI_BREAK_LIST}, {
-    NULL, GDBMI_LAST}
-};
 
-static enum gdbmi_input_command gdbmi_input_command_lookup(const char *command)
+/**
+ * Gets the text of a string of an output command, for printing.
+ *
+ * \return
+ * The text, or "(null)" if the string isn't there.
+ */
+static const char *gdbmi_oc_text(gdbmi_cstring_ptr cstring)
 {
-    int i;
-
-    for (i = 0; gdbmi_input_lookup[i].cstring_val; ++i)
-        if (strcmp(command, gdbmi_input_lookup[i].cstring_val) == 0)
-            return gdbmi_input_lookup[i].enum_val;
-
-    return GDBMI_LAST;
+    return cstring ? gdbmi_cstring_text(cstring, NULL) : "(null)";
 }
 
 /* Creating, Destroying and printing gdbmi_oc  */
@@ -85,17 +66,15 @@ int destroy_gdbmi_oc(gdbmi_oc_ptr param)
     if (!param)
         return 0;
 
-    if (destroy_gdbmi_cstring_ll(param->console_output) == -1)
+    if (destroy_gdbmi_console(param->console_output) == -1)
         return -1;
     param->console_output = NULL;
 
+    if (destroy_gdbmi_async(param->async) == -1)
+        return -1;
+    param->async = NULL;
+
     switch (param->input_command) {
-        case GDBMI_FILE_LIST_EXEC_SOURCE_FILE:
-            free(param->input_commands.file_list_exec_source_file.file);
-            param->input_commands.file_list_exec_source_file.file = NULL;
-            free(param->input_commands.file_list_exec_source_file.fullname);
-            param->input_commands.file_list_exec_source_file.fullname = NULL;
-            break;
         case GDBMI_FILE_LIST_EXEC_SOURCE_FILES:
             if (destroy_gdbmi_file_path_info(param->input_commands.
                             file_list_exec_source_files.file_name_pair) == -1)
@@ -106,6 +85,42 @@ int destroy_gdbmi_oc(gdbmi_oc_ptr param)
                             breakpoint_ptr) == -1)
                 return -1;
             break;
+        case GDBMI_STACK_INFO_FRAME:
+            if (destroy_gdbmi_frame(param->input_commands.stack_info_frame.
+                            frame) == -1)
+                return -1;
+            break;
+        case GDBMI_STACK_LIST_FRAMES:
+            if (destroy_gdbmi_frame(param->input_commands.stack_list_frames.
+                            frames) == -1)
+                return -1;
+            break;
+        case GDBMI_STACK_LIST_VARIABLES:
+            if (destroy_gdbmi_variable(param->input_commands.
+                            stack_list_variables.variables) == -1)
+                return -1;
+            break;
+        case GDBMI_VAR_CREATE:
+            if (destroy_gdbmi_variable(param->input_commands.var_create.
+                            variable) == -1)
+                return -1;
+            break;
+        case GDBMI_VAR_UPDATE:
+            if (destroy_gdbmi_variable(param->input_commands.var_update.
+                            changelist) == -1)
+                return -1;
+            break;
+        case GDBMI_VAR_LIST_CHILDREN:
+            if (destroy_gdbmi_variable(param->input_commands.
+                            var_list_children.children) == -1)
+                return -1;
+            break;
+        case GDBMI_DATA_READ_MEMORY_BYTES:
+            if (destroy_gdbmi_memory(param->input_commands.
+                            data_read_memory_bytes.memory) == -1)
+                return -1;
+            break;
+        case GDBMI_FILE_LIST_EXEC_SOURCE_FILE:
         case GDBMI_LAST:
             break;
     };
@@ -149,7 +164,13 @@ int print_gdbmi_oc(gdbmi_oc_ptr param)
         else
             printf("synchronous\n");
 
-        if (print_gdbmi_cstring_ll(cur->console_output) == -1)
+        if (cur->error_msg)
+            printf("error_msg->(%s)\n", gdbmi_oc_text(cur->error_msg));
+
+        if (print_gdbmi_console(cur->console_output) == -1)
+            return -1;
+
+        if (print_gdbmi_async(cur->async) == -1)
             return -1;
 
         switch (cur->input_command) {
@@ -158,10 +179,11 @@ int print_gdbmi_oc(gdbmi_oc_ptr param)
                 printf("line=%d\n",
                         cur->input_commands.file_list_exec_source_file.line);
                 printf("file=%s\n",
-                        cur->input_commands.file_list_exec_source_file.file);
+                        gdbmi_oc_text(cur->input_commands.
+                                file_list_exec_source_file.file));
                 printf("fullname=%s\n",
-                        cur->input_commands.file_list_exec_source_file.
-                        fullname);
+                        gdbmi_oc_text(cur->input_commands.
+                                file_list_exec_source_file.fullname));
                 break;
             case GDBMI_FILE_LIST_EXEC_SOURCE_FILES:
             {
@@ -188,6 +210,51 @@ int print_gdbmi_oc(gdbmi_oc_ptr param)
                     return -1;
                 }
             }
+                break;
+            case GDBMI_STACK_INFO_FRAME:
+                printf("stack-info-frame\n");
+                if (print_gdbmi_frame(cur->input_commands.stack_info_frame.
+                                frame) == -1) {
+                    fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                    return -1;
+                }
+                break;
+            case GDBMI_STACK_LIST_FRAMES:
+                printf("stack-list-frames\n");
+                if (print_gdbmi_frame(cur->input_commands.stack_list_frames.
+                                frames) == -1)
+                    return -1;
+                break;
+            case GDBMI_STACK_LIST_VARIABLES:
+                printf("stack-list-variables\n");
+                if (print_gdbmi_variable(cur->input_commands.
+                                stack_list_variables.variables) == -1)
+                    return -1;
+                break;
+            case GDBMI_VAR_CREATE:
+                printf("var-create\n");
+                if (print_gdbmi_variable(cur->input_commands.var_create.
+                                variable) == -1)
+                    return -1;
+                break;
+            case GDBMI_VAR_UPDATE:
+                printf("var-update\n");
+                if (print_gdbmi_variable(cur->input_commands.var_update.
+                                changelist) == -1)
+                    return -1;
+                break;
+            case GDBMI_VAR_LIST_CHILDREN:
+                printf("var-list-children\n");
+                if (print_gdbmi_variable(cur->input_commands.
+                                var_list_children.children) == -1)
+                    return -1;
+                break;
+            case GDBMI_DATA_READ_MEMORY_BYTES:
+                printf("data-read-memory-bytes\n");
+                if (print_gdbmi_memory(cur->input_commands.
+                                data_read_memory_bytes.memory) == -1)
+                    return -1;
+                break;
             case GDBMI_LAST:
                 break;
         };
@@ -199,65 +266,393 @@ int print_gdbmi_oc(gdbmi_oc_ptr param)
 }
 
 /**
- * This will convert a cstring that was passed from GDB to the front end.
- * A typically cstring will look like,
- *   "Type \"show copying\" to see the conditions.\n"
- * The \" should be converted to a ", and the \n should be converted to a 
- * newline. Also, the first and last " should go away. The other cases are 
- * handled in the code bleow.
+ * Finds a result in a result list.
  *
- * \param orig
- * The string to convert
+ * \param result
+ * The result list to look in, it may be NULL
  *
- * \param new
- * The new string, the memory will be allocated in this function and passed back.
+ * \param variable
+ * The keyword of the name of the result
+ *
+ * \return
+ * The value of the result, or NULL if the list doesn't have it.
+ */
+static gdbmi_value_ptr
+gdbmi_find_value(gdbmi_result_ptr result, enum gdbmi_keyword variable)
+{
+    for (; result; result = result->next) {
+        if (result->keyword == variable) {
+            /* Only the values that are looked at get decoded */
+            gdbmi_decode_value(result->value);
+            return result->value;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Gets the cstring of a result.
+ *
+ * \param result
+ * The result list to look in
+ *
+ * \param variable
+ * The keyword of the name of the result
+ *
+ * \return
+ * The cstring, or NULL if the list doesn't have one by that name.
+ */
+static gdbmi_cstring_ptr
+gdbmi_get_cstring(gdbmi_result_ptr result, enum gdbmi_keyword variable)
+{
+    gdbmi_value_ptr value = gdbmi_find_value(result, variable);
+
+    if (!value || value->value_choice != GDBMI_CSTRING)
+        return NULL;
+
+    return &value->option.cstring;
+}
+
+/**
+ * Gets the text of a cstring of a result.
+ *
+ * \return
+ * The text, or NULL if the list doesn't have a cstring by that name.
+ */
+static const char *
+gdbmi_get_text(gdbmi_result_ptr result, enum gdbmi_keyword variable)
+{
+    gdbmi_cstring_ptr cstring = gdbmi_get_cstring(result, variable);
+
+    return cstring ? gdbmi_cstring_text(cstring, NULL) : NULL;
+}
+
+/**
+ * Gets a result that's a number. The number is left alone if the list
+ * doesn't have it.
+ *
+ * \param base
+ * The base the number is written in
  *
  * \return
  * 0 on success, -1 on error.
  */
-static int convert_cstring(const char *orig, char **new)
+static int
+gdbmi_get_number(gdbmi_result_ptr result, enum gdbmi_keyword variable,
+        int base, int *number)
 {
-    int length;
-    char *nstring;
-    int i, cur;
+    const char *text = gdbmi_get_text(result, variable);
 
-    if (!orig || !new)
+    if (text)
+        *number = (int) strtol(text, NULL, base);
+
+    return 0;
+}
+
+/**
+ * Gets the results of a result that's a tuple.
+ *
+ * \return
+ * The results of the tuple, or NULL if the list doesn't have it or it's
+ * empty.
+ */
+static gdbmi_result_ptr
+gdbmi_get_tuple(gdbmi_result_ptr result, enum gdbmi_keyword variable)
+{
+    gdbmi_value_ptr value = gdbmi_find_value(result, variable);
+
+    if (!value || value->value_choice != GDBMI_TUPLE || !value->option.tuple)
+        return NULL;
+
+    return value->option.tuple->result;
+}
+
+/**
+ * Gets a breakpoint out of the results of a bkpt tuple. These come back
+ * from -break-list, and along with the breakpoint notifications.
+ *
+ * \param result
+ * The results of the tuple
+ *
+ * \param breakpoint
+ * The breakpoint, allocated even if there's an error.
+ *
+ * \return
+ * 0 on success, -1 on error.
+ */
+static int
+gdbmi_get_breakpoint(gdbmi_result_ptr result,
+        gdbmi_oc_breakpoint_ptr * breakpoint)
+{
+    gdbmi_oc_breakpoint_ptr ptr = create_gdbmi_breakpoint();
+    const char *text;
+
+    *breakpoint = ptr;
+    if (!ptr)
         return -1;
 
-    length = strlen(orig);
-    nstring = malloc(sizeof (char) * (length + 1));
-    cur = 0;
-
-    /* Loop from 1 to length -1 to skip the first and last char, 
-     * they are the " chars. */
-    for (i = 1; i < length - 1; ++i) {
-        if (orig[i] == '\\') {
-            i++;
-            switch (orig[i]) {
-                case 'n':
-                    nstring[cur++] = '\r';
-                    nstring[cur++] = '\n';
-                    break;
-                case '"':
-                    nstring[cur++] = '"';
-                    break;
-                case 't':
-                    nstring[cur++] = '\t';
-                    break;
-                case '\\':
-                    nstring[cur++] = '\\';
-                    break;
-                default:
-                    fprintf(stderr, "%s:%d char(%d)\n", __FILE__, __LINE__,
-                            orig[i]);
-                    return -1;
-            };
-        } else
-            nstring[cur++] = orig[i];
+    if (gdbmi_get_number(result, GDBMI_KEYWORD_NUMBER, 10, &ptr->number) == -1)
+        return -1;
+
+    /* There are hw, read and acc watchpoints too */
+    text = gdbmi_get_text(result, GDBMI_KEYWORD_TYPE);
+    if (text && strstr(text, "watchpoint"))
+        ptr->type = GDBMI_WATCHPOINT;
+    else
+        ptr->type = GDBMI_BREAKPOINT;
+
+    text = gdbmi_get_text(result, GDBMI_KEYWORD_DISP);
+    if (text && strcmp(text, "keep") != 0)
+        ptr->disposition = GDBMI_NOKEEP;
+    else
+        ptr->disposition = GDBMI_KEEP;
+
+    text = gdbmi_get_text(result, GDBMI_KEYWORD_ENABLED);
+    ptr->enabled = text && strcmp(text, "y") == 0;
+
+    /* The strings are read when they're needed */
+    ptr->address = gdbmi_get_cstring(result, GDBMI_KEYWORD_ADDR);
+    ptr->func = gdbmi_get_cstring(result, GDBMI_KEYWORD_FUNC);
+    ptr->file = gdbmi_get_cstring(result, GDBMI_KEYWORD_FILE);
+    ptr->fullname = gdbmi_get_cstring(result, GDBMI_KEYWORD_FULLNAME);
+
+    if (gdbmi_get_number(result, GDBMI_KEYWORD_LINE, 10, &ptr->line) == -1)
+        return -1;
+
+    if (gdbmi_get_number(result, GDBMI_KEYWORD_TIMES, 10, &ptr->times) == -1)
+        return -1;
+
+    return 0;
+}
+
+/**
+ * Gets a frame out of the results of a frame tuple. These come back from
+ * -stack-info-frame, -stack-list-frames, and along with *stopped.
+ *
+ * \param result
+ * The results of the tuple
+ *
+ * \param frame
+ * The frame, allocated even if there's an error.
+ *
+ * \return
+ * 0 on success, -1 on error.
+ */
+static int
+gdbmi_get_frame(gdbmi_result_ptr result, gdbmi_oc_frame_ptr * frame)
+{
+    gdbmi_oc_frame_ptr ptr = create_gdbmi_frame();
+
+    *frame = ptr;
+    if (!ptr)
+        return -1;
+
+    ptr->address = gdbmi_get_cstring(result, GDBMI_KEYWORD_ADDR);
+    ptr->func = gdbmi_get_cstring(result, GDBMI_KEYWORD_FUNC);
+    ptr->file = gdbmi_get_cstring(result, GDBMI_KEYWORD_FILE);
+    ptr->fullname = gdbmi_get_cstring(result, GDBMI_KEYWORD_FULLNAME);
+
+    if (gdbmi_get_number(result, GDBMI_KEYWORD_LINE, 10, &ptr->line) == -1)
+        return -1;
+
+    if (gdbmi_get_number(result, GDBMI_KEYWORD_LEVEL, 10, &ptr->level) == -1)
+        return -1;
+
+    return 0;
+}
+
+/**
+ * Gets a variable object out of the results of a tuple. These are the
+ * results of -var-create, each child of -var-list-children, each change
+ * of -var-update and each local of -stack-list-variables.
+ *
+ * \param result
+ * The results
+ *
+ * \param variable
+ * The variable, allocated even if there's an error.
+ *
+ * \return
+ * 0 on success, -1 on error.
+ */
+static int
+gdbmi_get_variable(gdbmi_result_ptr result, gdbmi_oc_variable_ptr * variable)
+{
+    gdbmi_oc_variable_ptr ptr = create_gdbmi_variable();
+    const char *text;
+
+    *variable = ptr;
+    if (!ptr)
+        return -1;
+
+    ptr->name = gdbmi_get_cstring(result, GDBMI_KEYWORD_NAME);
+    ptr->expression = gdbmi_get_cstring(result, GDBMI_KEYWORD_EXP);
+    ptr->value = gdbmi_get_cstring(result, GDBMI_KEYWORD_VALUE);
+    ptr->numchild = -1;
+
+    text = gdbmi_get_text(result, GDBMI_KEYWORD_IN_SCOPE);
+    ptr->in_scope = !text || strcmp(text, "true") == 0;
+
+    /* A change of type comes with the new type and children */
+    text = gdbmi_get_text(result, GDBMI_KEYWORD_TYPE_CHANGED);
+    ptr->type_changed = text && strcmp(text, "true") == 0;
+
+    if (ptr->type_changed) {
+        ptr->type = gdbmi_get_cstring(result, GDBMI_KEYWORD_NEW_TYPE);
+        if (gdbmi_get_number(result, GDBMI_KEYWORD_NEW_NUM_CHILDREN, 10,
+                        &ptr->numchild) == -1)
+            return -1;
+    } else {
+        ptr->type = gdbmi_get_cstring(result, GDBMI_KEYWORD_TYPE);
+        if (gdbmi_get_number(result, GDBMI_KEYWORD_NUMCHILD, 10,
+                        &ptr->numchild) == -1)
+            return -1;
     }
-    nstring[cur] = '\0';
 
-    *new = nstring;
+    return 0;
+}
+
+/**
+ * Gets the variables of a list of tuples, like the changelist of
+ * -var-update or the variables of -stack-list-variables.
+ *
+ * \param list
+ * The list, or NULL
+ *
+ * \param variables
+ * The variables, in the order of the list.
+ *
+ * \return
+ * 0 on success, -1 on error.
+ */
+static int
+gdbmi_get_variable_tuples(gdbmi_value_ptr list,
+        gdbmi_oc_variable_ptr * variables)
+{
+    gdbmi_oc_variable_ptr last = NULL, ptr;
+    gdbmi_value_ptr value_ptr;
+    int result;
+
+    /* An empty list parses to NULL */
+    if (!list || list->value_choice != GDBMI_LIST || !list->option.list ||
+            list->option.list->list_choice != GDBMI_VALUE)
+        return 0;
+
+    for (value_ptr = list->option.list->option.value; value_ptr;
+            value_ptr = value_ptr->next) {
+        gdbmi_decode_value(value_ptr);
+        if (value_ptr->value_choice != GDBMI_TUPLE || !value_ptr->option.tuple)
+            continue;
+
+        /* The end of the list is kept, a stop can change many of them */
+        result = gdbmi_get_variable(value_ptr->option.tuple->result, &ptr);
+        if (last)
+            last->next = ptr;
+        else
+            *variables = ptr;
+        last = ptr;
+
+        if (result == -1)
+            return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Gets what an asynchronous record tells the front end.
+ *
+ * \param record
+ * The asynchronous record
+ *
+ * \param async
+ * The asynchronous record for the output command, allocated even if
+ * there's an error.
+ *
+ * \return
+ * 0 on success, -1 on error.
+ */
+static int
+gdbmi_get_async(gdbmi_async_record_ptr record, gdbmi_oc_async_ptr * async)
+{
+    gdbmi_oc_async_ptr ptr = create_gdbmi_async();
+    gdbmi_result_ptr tuple;
+    const char *text;
+
+    *async = ptr;
+    if (!ptr)
+        return -1;
+
+    ptr->async_class = record->async_class;
+
+    switch (record->async_class) {
+        case GDBMI_STOPPED:
+            ptr->reason = gdbmi_get_cstring(record->result,
+                    GDBMI_KEYWORD_REASON);
+            if (ptr->reason)
+                ptr->reason_keyword = gdbmi_keyword_lookup(ptr->reason->data,
+                        ptr->reason->length);
+            ptr->signal_name = gdbmi_get_cstring(record->result,
+                    GDBMI_KEYWORD_SIGNAL_NAME);
+
+            /* GDB writes the exit code in octal */
+            if (gdbmi_get_number(record->result, GDBMI_KEYWORD_EXIT_CODE, 8,
+                            &ptr->exit_code) == -1)
+                return -1;
+
+            /* The thread that stopped, gdb looks at it now unless it's in
+             * non-stop mode */
+            if (gdbmi_get_number(record->result, GDBMI_KEYWORD_THREAD_ID, 10,
+                            &ptr->thread_id) == -1)
+                return -1;
+
+            /* In non-stop mode, it's a list of the one thread */
+            text = gdbmi_get_text(record->result,
+                    GDBMI_KEYWORD_STOPPED_THREADS);
+            ptr->all_threads = text && strcmp(text, "all") == 0;
+
+            tuple = gdbmi_get_tuple(record->result, GDBMI_KEYWORD_FRAME);
+            if (tuple && gdbmi_get_frame(tuple, &ptr->frame) == -1)
+                return -1;
+            break;
+        case GDBMI_THREAD_SELECTED:
+            if (gdbmi_get_number(record->result, GDBMI_KEYWORD_ID, 10,
+                            &ptr->thread_id) == -1)
+                return -1;
+
+            tuple = gdbmi_get_tuple(record->result, GDBMI_KEYWORD_FRAME);
+            if (tuple && gdbmi_get_frame(tuple, &ptr->frame) == -1)
+                return -1;
+            break;
+        case GDBMI_THREAD_CREATED:
+        case GDBMI_THREAD_EXITED:
+            if (gdbmi_get_number(record->result, GDBMI_KEYWORD_ID, 10,
+                            &ptr->thread_id) == -1)
+                return -1;
+            break;
+        case GDBMI_BREAKPOINT_CREATED:
+        case GDBMI_BREAKPOINT_MODIFIED:
+            tuple = gdbmi_get_tuple(record->result, GDBMI_KEYWORD_BKPT);
+            if (tuple && gdbmi_get_breakpoint(tuple, &ptr->breakpoint) == -1)
+                return -1;
+            break;
+        case GDBMI_BREAKPOINT_DELETED:
+            if (gdbmi_get_number(record->result, GDBMI_KEYWORD_ID, 10,
+                            &ptr->breakpoint_number) == -1)
+                return -1;
+            break;
+        case GDBMI_ASYNC_RUNNING:
+            if (gdbmi_get_number(record->result, GDBMI_KEYWORD_THREAD_ID, 10,
+                            &ptr->thread_id) == -1)
+                return -1;
+
+            text = gdbmi_get_text(record->result, GDBMI_KEYWORD_THREAD_ID);
+            ptr->all_threads = text && strcmp(text, "all") == 0;
+            break;
+        case GDBMI_ASYNC_UNKNOWN:
+            break;
+    }
 
     return 0;
 }
@@ -279,6 +674,8 @@ static int convert_cstring(const char *orig, char **new)
 static int
 gdbmi_get_output_command(gdbmi_output_ptr output_ptr, gdbmi_oc_ptr * oc_ptr)
 {
+    gdbmi_oc_console_ptr console_last = NULL;
+
     if (!output_ptr || !oc_ptr)
         return -1;
 
@@ -291,24 +688,52 @@ gdbmi_get_output_command(gdbmi_output_ptr output_ptr, gdbmi_oc_ptr * oc_ptr)
     /* Check to see if the output command is synchronous or asynchronous */
     if (!output_ptr->result_record)
         (*oc_ptr)->is_asynchronous = 1;
+    else {
+        (*oc_ptr)->result_class = output_ptr->result_record->result_class;
 
-    /* Walk the output_ptr to get the MI stream record's */
+        if ((*oc_ptr)->result_class == GDBMI_ERROR)
+            (*oc_ptr)->error_msg =
+                    gdbmi_get_cstring(output_ptr->result_record->result,
+                    GDBMI_KEYWORD_MSG);
+    }
+
+    /* Walk the output_ptr to get the MI stream and async record's */
     if (output_ptr->oob_record) {
         gdbmi_oob_record_ptr cur = output_ptr->oob_record;
 
         while (cur) {
             if (cur->record == GDBMI_STREAM) {
                 if (cur->option.stream_record->stream_record == GDBMI_CONSOLE) {
-                    char *orig = cur->option.stream_record->cstring;
-                    gdbmi_oc_cstring_ll_ptr ncstring =
-                            create_gdbmi_cstring_ll();
-                    if (convert_cstring(orig, &(ncstring->cstring)) == -1) {
+                    gdbmi_oc_console_ptr console = create_gdbmi_console();
+
+                    if (!console) {
                         fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
                         return -1;
                     }
 
-                    (*oc_ptr)->console_output = append_gdbmi_cstring_ll(
-                            (*oc_ptr)->console_output, ncstring);
+                    /* The end of the list is kept, a long listing has many lines */
+                    console->cstring = &cur->option.stream_record->cstring;
+                    if (console_last)
+                        console_last->next = console;
+                    else
+                        (*oc_ptr)->console_output = console;
+                    console_last = console;
+                }
+            } else if (cur->record == GDBMI_ASYNC) {
+                gdbmi_async_record_ptr record = cur->option.async_record;
+
+                /* The status records are only progress reports */
+                if (record->async_record != GDBMI_STATUS &&
+                        record->async_class != GDBMI_ASYNC_UNKNOWN) {
+                    gdbmi_oc_async_ptr async;
+                    int result = gdbmi_get_async(record, &async);
+
+                    (*oc_ptr)->async = append_gdbmi_async((*oc_ptr)->async,
+                            async);
+                    if (result == -1) {
+                        fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                        return -1;
+                    }
                 }
             }
             cur = cur->next;
@@ -326,6 +751,7 @@ gdbmi_get_specific_output_command(gdbmi_output_ptr output_ptr,
     /* If the command is synchronous, then it is a response to an MI input command. */
     char *mi_input_cmd;
     enum gdbmi_input_command mi_input_cmd_kind;
+    gdbmi_result_ptr result_ptr;
 
     if (!mi_input_cmds) {
         fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
@@ -335,433 +761,263 @@ gdbmi_get_specific_output_command(gdbmi_output_ptr output_ptr,
     mi_input_cmd = mi_input_cmds->cstring;
     mi_input_cmd_kind = gdbmi_input_command_lookup(mi_input_cmd);
 
+    /* There's nothing to get out of a command that didn't work */
+    if (oc_ptr->result_class == GDBMI_ERROR)
+        return 0;
+
     oc_ptr->input_command = mi_input_cmd_kind;
+    result_ptr = output_ptr->result_record->result;
+
     switch (mi_input_cmd_kind) {
         case GDBMI_FILE_LIST_EXEC_SOURCE_FILE:
+            if (gdbmi_get_number(result_ptr, GDBMI_KEYWORD_LINE, 10,
+                            &oc_ptr->input_commands.file_list_exec_source_file.
+                            line) == -1) {
+                fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                return -1;
+            }
+
+            oc_ptr->input_commands.file_list_exec_source_file.file =
+                    gdbmi_get_cstring(result_ptr, GDBMI_KEYWORD_FILE);
+            oc_ptr->input_commands.file_list_exec_source_file.fullname =
+                    gdbmi_get_cstring(result_ptr, GDBMI_KEYWORD_FULLNAME);
+            break;
+        case GDBMI_FILE_LIST_EXEC_SOURCE_FILES:
         {
-            gdbmi_result_ptr result_ptr = output_ptr->result_record->result;
+            gdbmi_value_ptr files = gdbmi_find_value(result_ptr,
+                    GDBMI_KEYWORD_FILES);
+            gdbmi_value_ptr value_ptr;
+
+            /* An empty list parses to NULL */
+            if (!files || files->value_choice != GDBMI_LIST ||
+                    !files->option.list ||
+                    files->option.list->list_choice != GDBMI_VALUE)
+                break;
 
-            while (result_ptr) {
-                if (strcmp(result_ptr->variable, "line") == 0) {
-                    char *nline;
+            for (value_ptr = files->option.list->option.value; value_ptr;
+                    value_ptr = value_ptr->next) {
+                gdbmi_oc_file_path_info_ptr ptr;
+                gdbmi_result_ptr result;
 
-                    if (convert_cstring(result_ptr->value->option.cstring,
-                                    &nline) == -1) {
-                        fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
-                        return -1;
-                    }
+                gdbmi_decode_value(value_ptr);
+                if (value_ptr->value_choice != GDBMI_TUPLE ||
+                        !value_ptr->option.tuple)
+                    continue;
 
-                    oc_ptr->input_commands.file_list_exec_source_file.line =
-                            atoi(nline);
-                    free(nline);
-                    nline = NULL;
-                } else if (strcmp(result_ptr->variable, "file") == 0) {
-                    char *nline;
+                result = value_ptr->option.tuple->result;
+                ptr = create_gdbmi_file_path_info();
+                oc_ptr->input_commands.file_list_exec_source_files.
+                        file_name_pair =
+                        append_gdbmi_file_path_info(oc_ptr->input_commands.
+                        file_list_exec_source_files.file_name_pair, ptr);
 
-                    if (convert_cstring(result_ptr->value->option.cstring,
-                                    &nline) == -1) {
-                        fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
-                        return -1;
-                    }
+                if (!ptr) {
+                    fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                    return -1;
+                }
 
-                    oc_ptr->input_commands.file_list_exec_source_file.file =
-                            nline;
-                } else if (strcmp(result_ptr->variable, "fullname") == 0) {
-                    char *nline;
+                ptr->file = gdbmi_get_cstring(result, GDBMI_KEYWORD_FILE);
+                ptr->fullname = gdbmi_get_cstring(result,
+                        GDBMI_KEYWORD_FULLNAME);
+            }
+        }
+            break;
+        case GDBMI_BREAK_LIST:
+        {
+            gdbmi_result_ptr table = gdbmi_get_tuple(result_ptr,
+                    GDBMI_KEYWORD_BREAKPOINT_TABLE);
+            gdbmi_value_ptr body = gdbmi_find_value(table, GDBMI_KEYWORD_BODY);
+
+            /* An empty body parses to NULL */
+            if (!body || body->value_choice != GDBMI_LIST ||
+                    !body->option.list ||
+                    body->option.list->list_choice != GDBMI_RESULT)
+                break;
 
-                    if (convert_cstring(result_ptr->value->option.cstring,
-                                    &nline) == -1) {
-                        fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
-                        return -1;
-                    }
-                    oc_ptr->input_commands.file_list_exec_source_file.fullname =
-                            nline;
+            for (result_ptr = body->option.list->option.result; result_ptr;
+                    result_ptr = result_ptr->next) {
+                gdbmi_oc_breakpoint_ptr ptr;
+                int result;
+
+                if (result_ptr->keyword != GDBMI_KEYWORD_BKPT)
+                    continue;
+
+                gdbmi_decode_value(result_ptr->value);
+                if (result_ptr->value->value_choice != GDBMI_TUPLE ||
+                        !result_ptr->value->option.tuple)
+                    continue;
+
+                result = gdbmi_get_breakpoint(result_ptr->value->option.
+                        tuple->result, &ptr);
+                oc_ptr->input_commands.break_list.breakpoint_ptr =
+                        append_gdbmi_breakpoint(oc_ptr->input_commands.
+                        break_list.breakpoint_ptr, ptr);
+                if (result == -1) {
+                    fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                    return -1;
                 }
+            }
+        }
+            break;
+        case GDBMI_STACK_INFO_FRAME:
+        {
+            gdbmi_result_ptr frame = gdbmi_get_tuple(result_ptr,
+                    GDBMI_KEYWORD_FRAME);
 
-                result_ptr = result_ptr->next;
+            if (frame && gdbmi_get_frame(frame,
+                            &oc_ptr->input_commands.stack_info_frame.frame) ==
+                    -1) {
+                fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                return -1;
             }
         }
             break;
-        case GDBMI_FILE_LIST_EXEC_SOURCE_FILES:
+        case GDBMI_STACK_LIST_FRAMES:
         {
-            gdbmi_result_ptr result_ptr = output_ptr->result_record->result;
-
-            while (result_ptr) {
-                if (strcmp(result_ptr->variable, "files") == 0) {
-                    if (result_ptr->value->value_choice == GDBMI_LIST) {
-                        gdbmi_list_ptr list = result_ptr->value->option.list;
-
-                        while (list) {
-                            if (list->list_choice == GDBMI_VALUE) {
-                                gdbmi_value_ptr value_ptr = list->option.value;
-
-                                while (value_ptr) {
-                                    if (value_ptr->value_choice == GDBMI_TUPLE) {
-                                        gdbmi_oc_file_path_info_ptr ptr =
-                                                create_gdbmi_file_path_info();
-                                        gdbmi_result_ptr result =
-                                                value_ptr->option.tuple->result;
-                                        while (result) {
-                                            if (strcmp(result->variable,
-                                                            "file") == 0) {
-                                                if (convert_cstring(result->
-                                                                value->option.
-                                                                cstring,
-                                                                &(ptr->file)) ==
-                                                        -1) {
-                                                    fprintf(stderr, "%s:%d\n",
-                                                            __FILE__, __LINE__);
-                                                    return -1;
-                                                }
-                                            } else if (strcmp(result->variable,
-                                                            "fullname") == 0) {
-                                                if (convert_cstring(result->
-                                                                value->option.
-                                                                cstring,
-                                                                &(ptr->fullname)) == -1) {
-                                                    fprintf(stderr, "%s:%d\n",
-                                                            __FILE__, __LINE__);
-                                                    return -1;
-                                                }
-                                            }
-                                            result = result->next;
-                                        }
-
-                                        oc_ptr->input_commands.
-                                                file_list_exec_source_files.
-                                                file_name_pair =
-                                                append_gdbmi_file_path_info
-                                                (oc_ptr->input_commands.
-                                                file_list_exec_source_files.
-                                                file_name_pair, ptr);
-                                    }
-                                    value_ptr = value_ptr->next;
-                                }
-                            }
-
-                            list = list->next;
-                        }
-                    }
+            gdbmi_value_ptr stack = gdbmi_find_value(result_ptr,
+                    GDBMI_KEYWORD_STACK);
+            gdbmi_oc_frame_ptr last = NULL, ptr;
+            gdbmi_result_ptr frame;
+            int result;
+
+            /* An empty stack parses to NULL */
+            if (!stack || stack->value_choice != GDBMI_LIST ||
+                    !stack->option.list ||
+                    stack->option.list->list_choice != GDBMI_RESULT)
+                break;
+
+            for (frame = stack->option.list->option.result; frame;
+                    frame = frame->next) {
+                if (frame->keyword != GDBMI_KEYWORD_FRAME)
+                    continue;
+
+                gdbmi_decode_value(frame->value);
+                if (frame->value->value_choice != GDBMI_TUPLE ||
+                        !frame->value->option.tuple)
+                    continue;
+
+                /* The end of the list is kept, a stack can be deep */
+                result = gdbmi_get_frame(frame->value->option.tuple->result,
+                        &ptr);
+                if (last)
+                    last->next = ptr;
+                else
+                    oc_ptr->input_commands.stack_list_frames.frames = ptr;
+                last = ptr;
+
+                if (result == -1) {
+                    fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                    return -1;
                 }
+            }
+        }
+            break;
+        case GDBMI_STACK_LIST_VARIABLES:
+            if (gdbmi_get_variable_tuples(gdbmi_find_value(result_ptr,
+                                    GDBMI_KEYWORD_VARIABLES),
+                            &oc_ptr->input_commands.stack_list_variables.
+                            variables) == -1) {
+                fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                return -1;
+            }
+            break;
+        case GDBMI_VAR_CREATE:
+            if (gdbmi_get_variable(result_ptr,
+                            &oc_ptr->input_commands.var_create.variable) ==
+                    -1) {
+                fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                return -1;
+            }
+            break;
+        case GDBMI_VAR_UPDATE:
+            if (gdbmi_get_variable_tuples(gdbmi_find_value(result_ptr,
+                                    GDBMI_KEYWORD_CHANGELIST),
+                            &oc_ptr->input_commands.var_update.changelist) ==
+                    -1) {
+                fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                return -1;
+            }
+            break;
+        case GDBMI_VAR_LIST_CHILDREN:
+        {
+            gdbmi_value_ptr children = gdbmi_find_value(result_ptr,
+                    GDBMI_KEYWORD_CHILDREN);
+            gdbmi_oc_variable_ptr last = NULL, ptr;
+            int result;
+
+            /* An empty list parses to NULL */
+            if (!children || children->value_choice != GDBMI_LIST ||
+                    !children->option.list ||
+                    children->option.list->list_choice != GDBMI_RESULT)
+                break;
 
-                result_ptr = result_ptr->next;
+            for (result_ptr = children->option.list->option.result;
+                    result_ptr; result_ptr = result_ptr->next) {
+                if (result_ptr->keyword != GDBMI_KEYWORD_CHILD)
+                    continue;
+
+                gdbmi_decode_value(result_ptr->value);
+                if (result_ptr->value->value_choice != GDBMI_TUPLE ||
+                        !result_ptr->value->option.tuple)
+                    continue;
+
+                result = gdbmi_get_variable(result_ptr->value->option.
+                        tuple->result, &ptr);
+                if (last)
+                    last->next = ptr;
+                else
+                    oc_ptr->input_commands.var_list_children.children = ptr;
+                last = ptr;
+
+                if (result == -1) {
+                    fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                    return -1;
+                }
             }
         }
             break;
-        case GDBMI_BREAK_LIST:
+        case GDBMI_DATA_READ_MEMORY_BYTES:
         {
-            gdbmi_result_ptr result_ptr = output_ptr->result_record->result;
-
-            if (strcmp(result_ptr->variable, "BreakpointTable") == 0) {
-                if (result_ptr->value->value_choice == GDBMI_TUPLE) {
-                    result_ptr = result_ptr->value->option.tuple->result;
-                    while (result_ptr) {
-                        if (strcmp(result_ptr->variable, "body") == 0) {
-                            if (result_ptr->value->value_choice == GDBMI_LIST) {
-                                gdbmi_list_ptr list_ptr =
-                                        result_ptr->value->option.list;
-                                if (list_ptr
-                                        && list_ptr->list_choice ==
-                                        GDBMI_RESULT) {
-                                    gdbmi_result_ptr result_ptr =
-                                            list_ptr->option.result;
-                                    while (result_ptr) {
-                                        if (strcmp(result_ptr->variable,
-                                                        "bkpt") == 0) {
-                                            gdbmi_oc_breakpoint_ptr ptr =
-                                                    create_gdbmi_breakpoint();
-
-                                            gdbmi_value_ptr value_ptr =
-                                                    result_ptr->value;
-                                            if (value_ptr->value_choice ==
-                                                    GDBMI_TUPLE) {
-                                                gdbmi_result_ptr result_ptr =
-                                                        value_ptr->option.
-                                                        tuple->result;
-                                                while (result_ptr) {
-                                                    if (strcmp(result_ptr->
-                                                                    variable,
-                                                                    "number") ==
-                                                            0) {
-                                                        if (result_ptr->value->
-                                                                value_choice ==
-                                                                GDBMI_CSTRING) {
-                                                            char *nstr;
-
-                                                            if (convert_cstring
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            &nstr)
-                                                                    == -1) {
-                                                                fprintf(stderr,
-                                                                        "%s:%d\n",
-                                                                        __FILE__,
-                                                                        __LINE__);
-                                                                return -1;
-                                                            }
-
-                                                            ptr->number =
-                                                                    atoi(nstr);
-                                                            free(nstr);
-                                                            nstr = NULL;
-                                                        }
-                                                    } else if (strcmp
-                                                            (result_ptr->
-                                                                    variable,
-                                                                    "type") ==
-                                                            0) {
-                                                        if (result_ptr->value->
-                                                                value_choice ==
-                                                                GDBMI_CSTRING) {
-                                                            if (strcmp
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            "\"breakpoint\"")
-                                                                    == 0)
-                                                                ptr->type =
-                                                                        GDBMI_BREAKPOINT;
-                                                            else if (strcmp
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            "\"watchpoint\"")
-                                                                    == 0)
-                                                                ptr->type =
-                                                                        GDBMI_WATCHPOINT;
-                                                        }
-                                                    } else if (strcmp
-                                                            (result_ptr->
-                                                                    variable,
-                                                                    "disp") ==
-                                                            0) {
-                                                        if (result_ptr->value->
-                                                                value_choice ==
-                                                                GDBMI_CSTRING) {
-                                                            if (strcmp
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            "\"keep\"")
-                                                                    == 0)
-                                                                ptr->disposition
-                                                                        =
-                                                                        GDBMI_KEEP;
-                                                            else if (strcmp
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            "\"nokeep\"")
-                                                                    == 0)
-                                                                ptr->disposition
-                                                                        =
-                                                                        GDBMI_NOKEEP;
-                                                        }
-                                                    } else if (strcmp
-                                                            (result_ptr->
-                                                                    variable,
-                                                                    "enabled")
-                                                            == 0) {
-                                                        if (result_ptr->value->
-                                                                value_choice ==
-                                                                GDBMI_CSTRING) {
-                                                            if (strcmp
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            "\"y\"")
-                                                                    == 0)
-                                                                ptr->enabled =
-                                                                        1;
-                                                            else
-                                                                ptr->enabled =
-                                                                        0;
-                                                        }
-                                                    } else if (strcmp
-                                                            (result_ptr->
-                                                                    variable,
-                                                                    "addr") ==
-                                                            0) {
-                                                        if (result_ptr->value->
-                                                                value_choice ==
-                                                                GDBMI_CSTRING) {
-                                                            if (convert_cstring
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            &ptr->
-                                                                            address)
-                                                                    == -1) {
-                                                                fprintf(stderr,
-                                                                        "%s:%d\n",
-                                                                        __FILE__,
-                                                                        __LINE__);
-                                                                return -1;
-                                                            }
-                                                        }
-                                                    } else if (strcmp
-                                                            (result_ptr->
-                                                                    variable,
-                                                                    "func") ==
-                                                            0) {
-                                                        if (result_ptr->value->
-                                                                value_choice ==
-                                                                GDBMI_CSTRING) {
-                                                            if (convert_cstring
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            &ptr->
-                                                                            func)
-                                                                    == -1) {
-                                                                fprintf(stderr,
-                                                                        "%s:%d\n",
-                                                                        __FILE__,
-                                                                        __LINE__);
-                                                                return -1;
-                                                            }
-                                                        }
-                                                    } else if (strcmp
-                                                            (result_ptr->
-                                                                    variable,
-                                                                    "file") ==
-                                                            0) {
-                                                        if (result_ptr->value->
-                                                                value_choice ==
-                                                                GDBMI_CSTRING) {
-                                                            if (convert_cstring
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            &ptr->
-                                                                            file)
-                                                                    == -1) {
-                                                                fprintf(stderr,
-                                                                        "%s:%d\n",
-                                                                        __FILE__,
-                                                                        __LINE__);
-                                                                return -1;
-                                                            }
-                                                        }
-                                                    } else if (strcmp
-                                                            (result_ptr->
-                                                                    variable,
-                                                                    "fullname")
-                                                            == 0) {
-                                                        if (result_ptr->value->
-                                                                value_choice ==
-                                                                GDBMI_CSTRING) {
-                                                            if (convert_cstring
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            &ptr->
-                                                                            fullname)
-                                                                    == -1) {
-                                                                fprintf(stderr,
-                                                                        "%s:%d\n",
-                                                                        __FILE__,
-                                                                        __LINE__);
-                                                                return -1;
-                                                            }
-                                                        }
-                                                    } else if (strcmp
-                                                            (result_ptr->
-                                                                    variable,
-                                                                    "line") ==
-                                                            0) {
-                                                        if (result_ptr->value->
-                                                                value_choice ==
-                                                                GDBMI_CSTRING) {
-                                                            char *nstr;
-
-                                                            if (convert_cstring
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            &nstr)
-                                                                    == -1) {
-                                                                fprintf(stderr,
-                                                                        "%s:%d\n",
-                                                                        __FILE__,
-                                                                        __LINE__);
-                                                                return -1;
-                                                            }
-
-                                                            ptr->line =
-                                                                    atoi(nstr);
-                                                            free(nstr);
-                                                            nstr = NULL;
-                                                        }
-                                                    } else if (strcmp
-                                                            (result_ptr->
-                                                                    variable,
-                                                                    "times") ==
-                                                            0) {
-                                                        if (result_ptr->value->
-                                                                value_choice ==
-                                                                GDBMI_CSTRING) {
-                                                            char *nstr;
-
-                                                            if (convert_cstring
-                                                                    (result_ptr->
-                                                                            value->
-                                                                            option.
-                                                                            cstring,
-                                                                            &nstr)
-                                                                    == -1) {
-                                                                fprintf(stderr,
-                                                                        "%s:%d\n",
-                                                                        __FILE__,
-                                                                        __LINE__);
-                                                                return -1;
-                                                            }
-
-                                                            ptr->times =
-                                                                    atoi(nstr);
-                                                            free(nstr);
-                                                            nstr = NULL;
-                                                        }
-                                                    }
-
-                                                    result_ptr =
-                                                            result_ptr->next;
-                                                }
-                                            }
-
-                                            oc_ptr->input_commands.break_list.
-                                                    breakpoint_ptr =
-                                                    append_gdbmi_breakpoint
-                                                    (oc_ptr->input_commands.
-                                                    break_list.breakpoint_ptr,
-                                                    ptr);
-                                        }
-                                        result_ptr = result_ptr->next;
-                                    }
-                                }
-                            }
-                        }
-                        result_ptr = result_ptr->next;
-                    }
+            gdbmi_value_ptr list = gdbmi_find_value(result_ptr,
+                    GDBMI_KEYWORD_MEMORY);
+            gdbmi_oc_memory_ptr last = NULL, ptr;
+            gdbmi_value_ptr value_ptr;
+
+            /* An empty list parses to NULL */
+            if (!list || list->value_choice != GDBMI_LIST ||
+                    !list->option.list ||
+                    list->option.list->list_choice != GDBMI_VALUE)
+                break;
+
+            for (value_ptr = list->option.list->option.value; value_ptr;
+                    value_ptr = value_ptr->next) {
+                gdbmi_decode_value(value_ptr);
+                if (value_ptr->value_choice != GDBMI_TUPLE ||
+                        !value_ptr->option.tuple)
+                    continue;
+
+                if (!(ptr = create_gdbmi_memory())) {
+                    fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
+                    return -1;
                 }
+                ptr->begin = gdbmi_get_cstring(value_ptr->option.tuple->
+                        result, GDBMI_KEYWORD_BEGIN);
+                ptr->offset = gdbmi_get_cstring(value_ptr->option.tuple->
+                        result, GDBMI_KEYWORD_OFFSET);
+                ptr->contents = gdbmi_get_cstring(value_ptr->option.tuple->
+                        result, GDBMI_KEYWORD_CONTENTS);
+
+                if (last)
+                    last->next = ptr;
+                else
+                    oc_ptr->input_commands.data_read_memory_bytes.memory = ptr;
+                last = ptr;
             }
         }
             break;
         case GDBMI_LAST:
-            fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
-            return -1;
+            /* A command the front end doesn't look at */
+            break;
     };
 
     return 0;
@@ -790,11 +1046,11 @@ gdbmi_get_output_commands(gdbmi_output_ptr output_ptr,
         gdbmi_oc_ptr cur_oc_ptr = NULL;
 
         result = gdbmi_get_output_command(cur, &cur_oc_ptr);
+        *oc_ptr = append_gdbmi_oc(*oc_ptr, cur_oc_ptr);
         if (result == -1) {
             fprintf(stderr, "%s:%d\n", __FILE__, __LINE__);
             return -1;
         }
-        *oc_ptr = append_gdbmi_oc(*oc_ptr, cur_oc_ptr);
 
         /* If it is not asynchronous, then need to get the specific results */
         if (!cur_oc_ptr->is_asynchronous) {
@@ -874,6 +1130,37 @@ int print_gdbmi_cstring_ll(gdbmi_oc_cstring_ll_ptr param)
     return 0;
 }
 
+gdbmi_oc_console_ptr create_gdbmi_console(void)
+{
+    return calloc(1, sizeof (struct gdbmi_oc_console));
+}
+
+int destroy_gdbmi_console(gdbmi_oc_console_ptr param)
+{
+    gdbmi_oc_console_ptr next;
+
+    /* The text belongs to the parse tree */
+    while (param) {
+        next = param->next;
+        free(param);
+        param = next;
+    }
+
+    return 0;
+}
+
+int print_gdbmi_console(gdbmi_oc_console_ptr param)
+{
+    gdbmi_oc_console_ptr cur = param;
+
+    while (cur) {
+        printf("cstring->(%s)\n", gdbmi_oc_text(cur->cstring));
+        cur = cur->next;
+    }
+
+    return 0;
+}
+
 gdbmi_oc_file_path_info_ptr create_gdbmi_file_path_info(void)
 {
     return calloc(1, sizeof (struct gdbmi_oc_file_path_info));
@@ -884,12 +1171,6 @@ int destroy_gdbmi_file_path_info(gdbmi_oc_file_path_info_ptr param)
     if (!param)
         return 0;
 
-    free(param->file);
-    param->file = NULL;
-
-    free(param->fullname);
-    param->fullname = NULL;
-
     if (destroy_gdbmi_file_path_info(param->next) == -1)
         return -1;
     param->next = NULL;
@@ -925,8 +1206,8 @@ int print_gdbmi_file_path_info(gdbmi_oc_file_path_info_ptr param)
     gdbmi_oc_file_path_info_ptr cur = param;
 
     while (cur) {
-        printf("file->(%s)\n", cur->file);
-        printf("fullname->(%s)\n", cur->fullname);
+        printf("file->(%s)\n", gdbmi_oc_text(cur->file));
+        printf("fullname->(%s)\n", gdbmi_oc_text(cur->fullname));
         cur = cur->next;
     }
 
@@ -943,26 +1224,6 @@ int destroy_gdbmi_breakpoint(gdbmi_oc_breakpoint_ptr param)
     if (!param)
         return 0;
 
-    if (param->address) {
-        free(param->address);
-        param->address = NULL;
-    }
-
-    if (param->func) {
-        free(param->func);
-        param->func = NULL;
-    }
-
-    if (param->file) {
-        free(param->file);
-        param->file = NULL;
-    }
-
-    if (param->fullname) {
-        free(param->fullname);
-        param->fullname = NULL;
-    }
-
     if (destroy_gdbmi_breakpoint(param->next) == -1)
         return -1;
     param->next = NULL;
@@ -1024,10 +1285,10 @@ int print_gdbmi_breakpoint(gdbmi_oc_breakpoint_ptr param)
         };
 
         printf("enabled=%d\n", cur->enabled);
-        printf("address->(%s)\n", cur->address);
-        printf("func->(%s)\n", cur->func);
-        printf("file->(%s)\n", cur->file);
-        printf("fullname->(%s)\n", cur->fullname);
+        printf("address->(%s)\n", gdbmi_oc_text(cur->address));
+        printf("func->(%s)\n", gdbmi_oc_text(cur->func));
+        printf("file->(%s)\n", gdbmi_oc_text(cur->file));
+        printf("fullname->(%s)\n", gdbmi_oc_text(cur->fullname));
         printf("line=%d\n", cur->line);
         printf("times=%d\n", cur->times);
 
@@ -1036,3 +1297,193 @@ int print_gdbmi_breakpoint(gdbmi_oc_breakpoint_ptr param)
 
     return 0;
 }
+
+gdbmi_oc_frame_ptr create_gdbmi_frame(void)
+{
+    return calloc(1, sizeof (struct gdbmi_oc_frame));
+}
+
+int destroy_gdbmi_frame(gdbmi_oc_frame_ptr param)
+{
+    gdbmi_oc_frame_ptr next;
+
+    /* A backtrace can be deep, they're freed without recursing */
+    for (; param; param = next) {
+        next = param->next;
+        free(param);
+    }
+
+    return 0;
+}
+
+int print_gdbmi_frame(gdbmi_oc_frame_ptr param)
+{
+    gdbmi_oc_frame_ptr cur = param;
+
+    while (cur) {
+        printf("level=%d\n", cur->level);
+        printf("address->(%s)\n", gdbmi_oc_text(cur->address));
+        printf("func->(%s)\n", gdbmi_oc_text(cur->func));
+        printf("file->(%s)\n", gdbmi_oc_text(cur->file));
+        printf("fullname->(%s)\n", gdbmi_oc_text(cur->fullname));
+        printf("line=%d\n", cur->line);
+
+        cur = cur->next;
+    }
+
+    return 0;
+}
+
+gdbmi_oc_variable_ptr create_gdbmi_variable(void)
+{
+    return calloc(1, sizeof (struct gdbmi_oc_variable));
+}
+
+int destroy_gdbmi_variable(gdbmi_oc_variable_ptr param)
+{
+    gdbmi_oc_variable_ptr next;
+
+    /* A stop can change many of them, they're freed without recursing */
+    for (; param; param = next) {
+        next = param->next;
+        free(param);
+    }
+
+    return 0;
+}
+
+int print_gdbmi_variable(gdbmi_oc_variable_ptr param)
+{
+    gdbmi_oc_variable_ptr cur = param;
+
+    while (cur) {
+        printf("name->(%s)\n", gdbmi_oc_text(cur->name));
+        printf("exp->(%s)\n", gdbmi_oc_text(cur->expression));
+        printf("value->(%s)\n", gdbmi_oc_text(cur->value));
+        printf("type->(%s)\n", gdbmi_oc_text(cur->type));
+        printf("numchild=%d\n", cur->numchild);
+        printf("in_scope=%d\n", cur->in_scope);
+        printf("type_changed=%d\n", cur->type_changed);
+
+        cur = cur->next;
+    }
+
+    return 0;
+}
+
+gdbmi_oc_memory_ptr create_gdbmi_memory(void)
+{
+    return calloc(1, sizeof (struct gdbmi_oc_memory));
+}
+
+int destroy_gdbmi_memory(gdbmi_oc_memory_ptr param)
+{
+    gdbmi_oc_memory_ptr next;
+
+    for (; param; param = next) {
+        next = param->next;
+        free(param);
+    }
+
+    return 0;
+}
+
+int print_gdbmi_memory(gdbmi_oc_memory_ptr param)
+{
+    gdbmi_oc_memory_ptr cur = param;
+
+    while (cur) {
+        printf("begin->(%s)\n", gdbmi_oc_text(cur->begin));
+        printf("offset->(%s)\n", gdbmi_oc_text(cur->offset));
+        printf("contents->(%s)\n", gdbmi_oc_text(cur->contents));
+
+        cur = cur->next;
+    }
+
+    return 0;
+}
+
+gdbmi_oc_async_ptr create_gdbmi_async(void)
+{
+    return calloc(1, sizeof (struct gdbmi_oc_async));
+}
+
+int destroy_gdbmi_async(gdbmi_oc_async_ptr param)
+{
+    if (!param)
+        return 0;
+
+    if (destroy_gdbmi_frame(param->frame) == -1)
+        return -1;
+    param->frame = NULL;
+
+    if (destroy_gdbmi_breakpoint(param->breakpoint) == -1)
+        return -1;
+    param->breakpoint = NULL;
+
+    if (destroy_gdbmi_async(param->next) == -1)
+        return -1;
+    param->next = NULL;
+
+    free(param);
+
+    return 0;
+}
+
+gdbmi_oc_async_ptr
+append_gdbmi_async(gdbmi_oc_async_ptr list, gdbmi_oc_async_ptr item)
+{
+    if (!item)
+        return NULL;
+
+    if (!list)
+        list = item;
+    else {
+        gdbmi_oc_async_ptr cur = list;
+
+        while (cur->next)
+            cur = cur->next;
+
+        cur->next = item;
+    }
+
+    return list;
+}
+
+int print_gdbmi_async(gdbmi_oc_async_ptr param)
+{
+    gdbmi_oc_async_ptr cur = param;
+
+    while (cur) {
+        if (print_gdbmi_async_class(cur->async_class) == -1)
+            return -1;
+
+        if (cur->reason)
+            printf("reason->(%s)\n", gdbmi_oc_text(cur->reason));
+
+        if (cur->signal_name)
+            printf("signal_name->(%s)\n", gdbmi_oc_text(cur->signal_name));
+
+        if (cur->async_class == GDBMI_STOPPED)
+            printf("exit_code=%d\n", cur->exit_code);
+
+        if (print_gdbmi_frame(cur->frame) == -1)
+            return -1;
+
+        if (cur->breakpoint && print_gdbmi_breakpoint(cur->breakpoint) == -1)
+            return -1;
+
+        if (cur->async_class == GDBMI_BREAKPOINT_DELETED)
+            printf("breakpoint_number=%d\n", cur->breakpoint_number);
+
+        if (cur->thread_id)
+            printf("thread_id=%d\n", cur->thread_id);
+
+        if (cur->all_threads)
+            printf("all_threads\n");
+
+        cur = cur->next;
+    }
+
+    return 0;
+}
@@ -15,6 +15,20 @@ enum gdbmi_input_command {
     /*  24.5 GDB/MI Breakpoint table commands */
     GDBMI_BREAK_LIST,
 
+    /*  24.10 GDB/MI Stack Manipulation Commands */
+    GDBMI_STACK_INFO_FRAME,
+    GDBMI_STACK_LIST_FRAMES,
+    GDBMI_STACK_LIST_VARIABLES,
+
+    /*  24.15 GDB/MI Variable Objects */
+    GDBMI_VAR_CREATE,
+    GDBMI_VAR_UPDATE,
+    GDBMI_VAR_LIST_CHILDREN,
+
+    /*  24.13 GDB/MI Data Manipulation */
+    GDBMI_DATA_READ_MEMORY_BYTES,
+
+    /* A command the front end doesn't look at, like one the user typed */
     GDBMI_LAST
 };
 
@@ -29,15 +43,30 @@ struct gdbmi_oc_cstring_ll {
     gdbmi_oc_cstring_ll_ptr next;
 };
 
+/* The strings of the output commands are the c-strings of the parse tree
+ * they came from, they aren't copied. A string that isn't in the tree is
+ * NULL. The output commands have to be destroyed before the tree. */
+
+/* The console output of a command, for use by the gdbmi output commands */
+struct gdbmi_oc_console;
+typedef struct gdbmi_oc_console *gdbmi_oc_console_ptr;
+struct gdbmi_oc_console {
+    /* The text of a console stream record */
+    gdbmi_cstring_ptr cstring;
+
+    /* A pointer to the next console output  */
+    gdbmi_oc_console_ptr next;
+};
+
 /* A file path linked list, for use by the gdbmi output commands */
 struct gdbmi_oc_file_path_info;
 typedef struct gdbmi_oc_file_path_info *gdbmi_oc_file_path_info_ptr;
 struct gdbmi_oc_file_path_info {
     /* The filename, relative path. */
-    char *file;
+    gdbmi_cstring_ptr file;
 
     /* The fullname, absolute path. */
-    char *fullname;
+    gdbmi_cstring_ptr fullname;
 
     /* A pointer to the next file path.  */
     gdbmi_oc_file_path_info_ptr next;
@@ -61,22 +90,135 @@ struct gdbmi_oc_breakpoint {
     enum breakpoint_disposition disposition;
     /* 1 if enabled, otherwise 0 */
     int enabled;
-    char *address;
-    char *func;
-    char *file;
-    char *fullname;
+    gdbmi_cstring_ptr address;
+    gdbmi_cstring_ptr func;
+    gdbmi_cstring_ptr file;
+    gdbmi_cstring_ptr fullname;
     int line;
     int times;
 
     gdbmi_oc_breakpoint_ptr next;
 };
 
+/* A stack frame, for use by the gdbmi output commands */
+struct gdbmi_oc_frame;
+typedef struct gdbmi_oc_frame *gdbmi_oc_frame_ptr;
+struct gdbmi_oc_frame {
+    /* The address of the instruction the frame is at, in hex. */
+    gdbmi_cstring_ptr address;
+    gdbmi_cstring_ptr func;
+    /* The filename, relative path, or NULL if there's no debug info. */
+    gdbmi_cstring_ptr file;
+    /* The fullname, absolute path, or NULL if GDB couldn't find the file. */
+    gdbmi_cstring_ptr fullname;
+    int line;
+    /* 0 for the innermost frame, 1 for its caller and so on. */
+    int level;
+
+    /* A pointer to the next frame, when there's a list of them */
+    gdbmi_oc_frame_ptr next;
+};
+
+/* A variable object, a change to one, or a local, for use by the gdbmi
+ * output commands */
+struct gdbmi_oc_variable;
+typedef struct gdbmi_oc_variable *gdbmi_oc_variable_ptr;
+struct gdbmi_oc_variable {
+    /* GDB's name for the variable object, like "var1.next". For a local,
+     * the name of the local. */
+    gdbmi_cstring_ptr name;
+    /* The expression of a child, like "next", or NULL. */
+    gdbmi_cstring_ptr expression;
+    gdbmi_cstring_ptr value;
+    /* The type, or the new type if it changed. */
+    gdbmi_cstring_ptr type;
+    /* The number of children, or the new number, -1 if GDB didn't say. */
+    int numchild;
+    /* 1 unless GDB says it's out of scope, or invalid. */
+    int in_scope;
+    /* 1 if GDB says its type changed. */
+    int type_changed;
+
+    /* A pointer to the next variable */
+    gdbmi_oc_variable_ptr next;
+};
+
+/* A block of memory that was read, for use by the gdbmi output commands */
+struct gdbmi_oc_memory;
+typedef struct gdbmi_oc_memory *gdbmi_oc_memory_ptr;
+struct gdbmi_oc_memory {
+    /* The address of the first byte, in hex. */
+    gdbmi_cstring_ptr begin;
+    /* How far that is from the address asked for, in hex. */
+    gdbmi_cstring_ptr offset;
+    /* The bytes, each one as 2 hex digits. */
+    gdbmi_cstring_ptr contents;
+
+    /* A pointer to the next block, the ones that couldn't be read are
+     * left out */
+    gdbmi_oc_memory_ptr next;
+};
+
+/* An asynchronous record, for use by the gdbmi output commands */
+struct gdbmi_oc_async;
+typedef struct gdbmi_oc_async *gdbmi_oc_async_ptr;
+struct gdbmi_oc_async {
+    enum gdbmi_async_class async_class;
+
+    /* GDBMI_STOPPED: Why the target stopped, like "breakpoint-hit" or 
+     * "exited-normally", or NULL. */
+    gdbmi_cstring_ptr reason;
+
+    /* GDBMI_STOPPED: The keyword of the reason, like
+     * GDBMI_KEYWORD_BREAKPOINT_HIT, or GDBMI_KEYWORD_UNKNOWN. */
+    enum gdbmi_keyword reason_keyword;
+
+    /* GDBMI_STOPPED: The signal the target got, like "SIGINT", if the
+     * reason is "signal-received", or NULL. */
+    gdbmi_cstring_ptr signal_name;
+
+    /* GDBMI_STOPPED: The exit code, if the reason is "exited". */
+    int exit_code;
+
+    /* GDBMI_STOPPED and GDBMI_THREAD_SELECTED: The frame, or NULL. */
+    gdbmi_oc_frame_ptr frame;
+
+    /* GDBMI_BREAKPOINT_CREATED and GDBMI_BREAKPOINT_MODIFIED: 
+     * The breakpoint, or NULL. */
+    gdbmi_oc_breakpoint_ptr breakpoint;
+
+    /* GDBMI_BREAKPOINT_DELETED: The number of the breakpoint. */
+    int breakpoint_number;
+
+    /* GDBMI_STOPPED, GDBMI_ASYNC_RUNNING, GDBMI_THREAD_SELECTED,
+     * GDBMI_THREAD_CREATED and GDBMI_THREAD_EXITED: The global number of
+     * the thread, or 0. */
+    int thread_id;
+
+    /* GDBMI_STOPPED and GDBMI_ASYNC_RUNNING: 1 if every thread stopped or
+     * runs, as in all-stop mode, 0 if only the one of thread_id does. */
+    int all_threads;
+
+    /* A pointer to the next asynchronous record */
+    gdbmi_oc_async_ptr next;
+};
+
 struct gdbmi_oc {
     /* If this is 1, then the command was asynchronous, otherwise it wasn't */
     int is_asynchronous;
 
+    /* How the MI input command went, if the command is synchronous */
+    enum gdbmi_result_class result_class;
+
+    /* The message GDB gave, if the result class is GDBMI_ERROR */
+    gdbmi_cstring_ptr error_msg;
+
+    /* The asynchronous records that came along with the command, in the 
+     * order GDB sent them. This is a null terminated list. */
+    gdbmi_oc_async_ptr async;
+
     /* The console output. This is a null terminated list. */
-    gdbmi_oc_cstring_ll_ptr console_output;
+    gdbmi_oc_console_ptr console_output;
 
     /* The GDBMI output command this represents. If set to GDBMI_LAST,
      * then this is an asynchronous command. */
@@ -87,8 +229,8 @@ struct gdbmi_oc {
         /*  24.7 GDB/MI Program control */
         struct {
             int line;
-            char *file;
-            char *fullname;
+            gdbmi_cstring_ptr file;
+            gdbmi_cstring_ptr fullname;
         } file_list_exec_source_file;
 
         struct {
@@ -99,6 +241,37 @@ struct gdbmi_oc {
         struct {
             gdbmi_oc_breakpoint_ptr breakpoint_ptr;
         } break_list;
+
+        /*  24.10 GDB/MI Stack Manipulation Commands */
+        struct {
+            gdbmi_oc_frame_ptr frame;
+        } stack_info_frame;
+
+        struct {
+            gdbmi_oc_frame_ptr frames;
+        } stack_list_frames;
+
+        struct {
+            gdbmi_oc_variable_ptr variables;
+        } stack_list_variables;
+
+        /*  24.15 GDB/MI Variable Objects */
+        struct {
+            gdbmi_oc_variable_ptr variable;
+        } var_create;
+
+        struct {
+            gdbmi_oc_variable_ptr changelist;
+        } var_update;
+
+        struct {
+            gdbmi_oc_variable_ptr children;
+        } var_list_children;
+
+        /*  24.13 GDB/MI Data Manipulation */
+        struct {
+            gdbmi_oc_memory_ptr memory;
+        } data_read_memory_bytes;
     } input_commands;
 
     /* The next MI output command */
@@ -112,7 +285,9 @@ struct gdbmi_oc {
  * The MI parse tree
  *
  * \param mi_input_cmds
- * The next MI input command.
+ * The next MI input command. Each synchronous output command is the 
+ * response to the next one of these, by name, like "-break-list". A name
+ * the front end doesn't look at gets an output command of GDBMI_LAST.
  *
  * \param oc_ptr
  * On return, this will be the MI output commands that were derived from the 
@@ -138,6 +313,11 @@ gdbmi_oc_cstring_ll_ptr append_gdbmi_cstring_ll(gdbmi_oc_cstring_ll_ptr list,
         gdbmi_oc_cstring_ll_ptr item);
 int print_gdbmi_cstring_ll(gdbmi_oc_cstring_ll_ptr param);
 
+/* Creating, Destroying and printing MI console output linked lists */
+gdbmi_oc_console_ptr create_gdbmi_console(void);
+int destroy_gdbmi_console(gdbmi_oc_console_ptr param);
+int print_gdbmi_console(gdbmi_oc_console_ptr param);
+
 /* Creating, Destroying and printing MI file_path linked lists */
 gdbmi_oc_file_path_info_ptr create_gdbmi_file_path_info(void);
 int destroy_gdbmi_file_path_info(gdbmi_oc_file_path_info_ptr param);
@@ -153,4 +333,26 @@ gdbmi_oc_breakpoint_ptr append_gdbmi_breakpoint(gdbmi_oc_breakpoint_ptr list,
         gdbmi_oc_breakpoint_ptr item);
 int print_gdbmi_breakpoint(gdbmi_oc_breakpoint_ptr param);
 
+/* Creating, Destroying and printing MI frames */
+gdbmi_oc_frame_ptr create_gdbmi_frame(void);
+int destroy_gdbmi_frame(gdbmi_oc_frame_ptr param);
+int print_gdbmi_frame(gdbmi_oc_frame_ptr param);
+
+/* Creating, Destroying and printing MI variable linked lists */
+gdbmi_oc_variable_ptr create_gdbmi_variable(void);
+int destroy_gdbmi_variable(gdbmi_oc_variable_ptr param);
+int print_gdbmi_variable(gdbmi_oc_variable_ptr param);
+
+/* Creating, Destroying and printing MI memory block linked lists */
+gdbmi_oc_memory_ptr create_gdbmi_memory(void);
+int destroy_gdbmi_memory(gdbmi_oc_memory_ptr param);
+int print_gdbmi_memory(gdbmi_oc_memory_ptr param);
+
+/* Creating, Destroying and printing MI asynchronous record linked lists */
+gdbmi_oc_async_ptr create_gdbmi_async(void);
+int destroy_gdbmi_async(gdbmi_oc_async_ptr param);
+gdbmi_oc_async_ptr append_gdbmi_async(gdbmi_oc_async_ptr list,
+        gdbmi_oc_async_ptr item);
+int print_gdbmi_async(gdbmi_oc_async_ptr param);
+
 #endif /* __GDBMI_OC_H__ */
@@ -5,21 +5,23 @@
 #include "gdbmi_grammar.h"
 #include "gdbmi_parser.h"
 
-int gdbmi_parse(void);
-
 /* flex */
-typedef struct yy_buffer_state *YY_BUFFER_STATE;
-extern YY_BUFFER_STATE gdbmi__scan_string(const char *yy_str);
-extern void gdbmi__delete_buffer(YY_BUFFER_STATE state);
-extern FILE *gdbmi_in;
-extern int gdbmi_lex(void);
-extern char *gdbmi_text;
-extern int gdbmi_lineno;
+typedef void *yyscan_t;
+extern int gdbmi_lex_init_extra(struct gdbmi_input *input, yyscan_t * scanner);
+extern int gdbmi_lex_destroy(yyscan_t scanner);
+extern void gdbmi_restart(FILE * input_file, yyscan_t scanner);
+extern int gdbmi_lex(YYSTYPE * lval, yyscan_t scanner);
 
 struct gdbmi_parser {
     char *last_error;
     gdbmi_pstate *pstate;
     gdbmi_pdata_ptr pdata_ptr;
+
+    /* The lexer, and the text it's reading. Both are kept from one call
+     * to the next, so parsing a record doesn't allocate anything but the
+     * parse tree. */
+    yyscan_t scanner;
+    struct gdbmi_input input;
 };
 
 gdbmi_parser_ptr gdbmi_parser_create(void)
@@ -48,6 +50,13 @@ gdbmi_parser_ptr gdbmi_parser_create(void)
         return NULL;
     }
 
+    /* Create the lexer, it reads from parser->input */
+    memset(&parser->input, 0, sizeof (struct gdbmi_input));
+    if (gdbmi_lex_init_extra(&parser->input, &parser->scanner) != 0) {
+        fprintf(stderr, "%s:%d", __FILE__, __LINE__);
+        return NULL;
+    }
+
     return parser;
 }
 
@@ -73,23 +82,39 @@ int gdbmi_parser_destroy(gdbmi_parser_ptr parser)
         parser->pdata_ptr = NULL;
     }
 
+    if (parser->scanner) {
+        gdbmi_lex_destroy(parser->scanner);
+        parser->scanner = NULL;
+    }
+
     free(parser);
     parser = NULL;
     return 0;
 }
 
+int gdbmi_parser_set_lazy(gdbmi_parser_ptr parser, int lazy)
+{
+    if (!parser)
+        return -1;
+
+    parser->input.lazy = lazy;
+
+    return 0;
+}
+
 int
-gdbmi_parser_parse_string(gdbmi_parser_ptr parser,
-        const char *mi_command, gdbmi_output_ptr * pt, int *parse_failed)
+gdbmi_parser_parse_span(gdbmi_parser_ptr parser,
+        const char *mi_data, size_t length, gdbmi_output_ptr * pt,
+        int *parse_failed)
 {
-    YY_BUFFER_STATE state;
+    YYSTYPE lval;
     int pattern;
-    int mi_status;
+    int mi_status = YYPUSH_MORE;
 
     if (!parser)
         return -1;
 
-    if (!mi_command)
+    if (!mi_data)
         return -1;
 
     if (!parse_failed)
@@ -101,40 +126,73 @@ gdbmi_parser_parse_string(gdbmi_parser_ptr parser,
 
     parser->pdata_ptr->parsed_one = 0;
 
-    /* Create a new input buffer for flex. */
-    state = gdbmi__scan_string(strdup(mi_command));
+    /* Point the lexer at the data, and throw away what it read before */
+    parser->input.data = mi_data;
+    parser->input.length = length;
+    parser->input.read = 0;
+    parser->input.scanned = 0;
+    parser->input.depth = 0;
+    gdbmi_restart(NULL, parser->scanner);
 
-    /* Create a new input buffer for flex and
-     * iterate over all the tokens. */
+    /* Iterate over all the tokens. */
     do {
-        pattern = gdbmi_lex();
+        pattern = gdbmi_lex(&lval, parser->scanner);
         if (pattern == 0)
             break;
-        mi_status =
-                gdbmi_push_parse(parser->pstate, pattern, NULL,
-                parser->pdata_ptr);
+
+        /* The nodes of the next output go in an arena of their own */
+        if (!parser->pdata_ptr->arena) {
+            parser->pdata_ptr->arena = create_gdbmi_arena();
+            if (!parser->pdata_ptr->arena) {
+                fprintf(stderr, "%s:%d", __FILE__, __LINE__);
+                return -1;
+            }
+        }
+
+        mi_status = gdbmi_push_parse(parser->pstate, pattern, &lval,
+                parser->pdata_ptr, parser->scanner);
     } while (mi_status == YYPUSH_MORE);
 
     /* Parser is done, this should never happen */
     if (mi_status != YYPUSH_MORE && mi_status != 0) {
         *parse_failed = 1;
+
+        /* The push parser starts over on the next call, the outputs it
+         * already had are lost with it, and so is the one it was in */
+        if (parser->pdata_ptr->tree) {
+            destroy_gdbmi_output(parser->pdata_ptr->tree);
+            parser->pdata_ptr->tree = NULL;
+        }
+
+        destroy_gdbmi_arena(parser->pdata_ptr->arena);
+        parser->pdata_ptr->arena = NULL;
     } else if (parser->pdata_ptr->parsed_one) {
         *pt = parser->pdata_ptr->tree;
         parser->pdata_ptr->tree = NULL;
     }
 
-    /* Free the scanners buffer */
-    gdbmi__delete_buffer(state);
-
     return 0;
 }
 
+int
+gdbmi_parser_parse_string(gdbmi_parser_ptr parser,
+        const char *mi_command, gdbmi_output_ptr * pt, int *parse_failed)
+{
+    if (!mi_command)
+        return -1;
+
+    return gdbmi_parser_parse_span(parser, mi_command, strlen(mi_command),
+            pt, parse_failed);
+}
+
 int
 gdbmi_parser_parse_file(gdbmi_parser_ptr parser,
         const char *mi_command_file, gdbmi_output_ptr * pt, int *parse_failed)
 {
-    int pattern;
-    int mi_status;
+    FILE *file;
+    char *data;
+    size_t length, size, count;
+    int result;
 
     if (!parser)
         return -1;
@@ -148,34 +206,35 @@ gdbmi_parser_parse_file(gdbmi_parser_ptr parser,
     *pt = 0;
     *parse_failed = 0;
 
-    /* Initialize data */
-    gdbmi_in = fopen(mi_command_file, "r");
+    file = fopen(mi_command_file, "r");
 
-    if (!gdbmi_in) {
+    if (!file) {
         fprintf(stderr, "%s:%d", __FILE__, __LINE__);
         return -1;
     }
 
-    /* Create a new input buffer for flex and
-     * iterate over all the tokens. */
-    do {
-        pattern = gdbmi_lex();
-        if (pattern == 0)
-            break;
-        mi_status =
-                gdbmi_push_parse(parser->pstate, pattern, NULL,
-                parser->pdata_ptr);
-    } while (mi_status == YYPUSH_MORE);
+    /* The lexer reads from memory, so the whole file is read first */
+    length = 0;
+    size = BUFSIZ;
+    data = malloc(size);
+    while (data && (count = fread(data + length, 1, size - length, file))) {
+        length += count;
+        if (length == size) {
+            size *= 2;
+            data = realloc(data, size);
+        }
+    }
 
-    /* Parser is done, this should never happen */
-    if (mi_status != YYPUSH_MORE && mi_status != 0) {
-        *parse_failed = 1;
-    } else {
-        *pt = parser->pdata_ptr->tree;
-        parser->pdata_ptr->tree = NULL;
+    fclose(file);
+
+    if (!data) {
+        fprintf(stderr, "%s:%d", __FILE__, __LINE__);
+        return -1;
     }
 
-    fclose(gdbmi_in);
+    result = gdbmi_parser_parse_span(parser, data, length, pt, parse_failed);
 
-    return 0;
+    free(data);
+
+    return result;
 }
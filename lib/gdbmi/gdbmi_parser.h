@@ -1,6 +1,8 @@
 #ifndef __GDBMI_PARSER_H__
 #define __GDBMI_PARSER_H__
 
+#include <stddef.h>
+
 #include "gdbmi_pt.h"
 
 /* Doxygen headers {{{ */
@@ -50,6 +52,27 @@ gdbmi_parser_ptr gdbmi_parser_create(void);
  */
 int gdbmi_parser_destroy(gdbmi_parser_ptr parser);
 
+/**
+ * Make the parser lazy, or eager again.
+ *
+ * A lazy parser indexes the results at the top of each record, but keeps
+ * the tuples and lists they hold as the text GDB sent. Each is decoded,
+ * one level at a time, the first time gdbmi_decode_value is called on
+ * it. The functions that read the tree for the front end do that, and
+ * so does print_gdbmi_output. An eager parser, the default, builds the
+ * whole tree as it goes.
+ *
+ * \param parser
+ * The gdbmi_parser context to operate on.
+ *
+ * \param lazy
+ * 1 for a lazy parser, 0 for an eager one
+ *
+ * \return
+ * 0 on succes, or -1 on error.
+ */
+int gdbmi_parser_set_lazy(gdbmi_parser_ptr parser, int lazy);
+
 /*@}*/
 
 /**
@@ -67,17 +90,20 @@ int gdbmi_parser_destroy(gdbmi_parser_ptr parser);
  * The normal usage of this function is to call it over and over again with
  * more data and wait for it to return an mi output command.
  *
- * It would be more convienent to allow the parser to parse any random
- * data but that would require flex to be a push flexer. It may even have
- * this feature but since I already changed bison, I don't want to think
- * anymore right now about how to improve this interface. It's good enough
- * for a first shot.
+ * The data is read where it is, it isn't copied, and it can be reused as
+ * soon as this function returns. The parser keeps its lexer and its parser
+ * state from one call to the next, so the only memory it allocates is for
+ * the parse tree.
  *
  * \param parser
  * The gdbmi_parser context to operate on.
  *
  * \param mi_data
- * The null terminated mi data. This consists of one or more lines.
+ * The mi data. This consists of one or more lines, it doesn't have to be
+ * null terminated.
+ *
+ * \param length
+ * The number of characters in mi_data.
  *
  * \param pt
  * If this function is successful (returns 0), then pt may be set.
@@ -95,6 +121,30 @@ int gdbmi_parser_destroy(gdbmi_parser_ptr parser);
  * \return
  * 0 on succes, or -1 on error.
  */
+int gdbmi_parser_parse_span(gdbmi_parser_ptr parser,
+        const char *mi_data, size_t length, gdbmi_output_ptr * pt,
+        int *parse_failed);
+
+/**
+ * Tell the MI parser to parse null terminated data.
+ *
+ * This is gdbmi_parser_parse_span, for a string.
+ *
+ * \param parser
+ * The gdbmi_parser context to operate on.
+ *
+ * \param mi_data
+ * The null terminated mi data. This consists of one or more lines.
+ *
+ * \param pt
+ * Set like gdbmi_parser_parse_span sets it.
+ *
+ * \param parse_failed
+ * 1 if the parser failed to parse the command, otherwise 0
+ *
+ * \return
+ * 0 on succes, or -1 on error.
+ */
 int gdbmi_parser_parse_string(gdbmi_parser_ptr parser,
         const char *mi_data, gdbmi_output_ptr * pt, int *parse_failed);
 
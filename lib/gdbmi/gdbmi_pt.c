@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "gdbmi_pt.h"
 
@@ -37,6 +38,191 @@ int print_gdbmi_result_class(enum gdbmi_result_class param)
     return 0;
 }
 
+/* The memory of an arena comes in blocks, each one twice as big as the
+ * one before, up to GDBMI_ARENA_MAX_BLOCK. The nodes are carved out of
+ * the memory after the block header. */
+#define GDBMI_ARENA_MIN_BLOCK 4096
+#define GDBMI_ARENA_MAX_BLOCK 65536
+
+struct gdbmi_arena_block {
+    struct gdbmi_arena_block *next;
+    size_t size;
+    size_t used;
+};
+
+struct gdbmi_arena {
+    struct gdbmi_arena_block *blocks;
+    size_t next_size;
+};
+
+/* Everything handed out is aligned for the members of the nodes */
+union gdbmi_arena_align {
+    long l;
+    double d;
+    void *p;
+};
+
+#define GDBMI_ARENA_ALIGN(n) \
+    (((n) + sizeof (union gdbmi_arena_align) - 1) & \
+        ~(sizeof (union gdbmi_arena_align) - 1))
+
+#define GDBMI_ARENA_HEADER GDBMI_ARENA_ALIGN(sizeof (struct gdbmi_arena_block))
+
+/* How many times the arenas called malloc, for gdbmi_bench */
+static unsigned long gdbmi_arena_mallocs;
+
+/* Creating and Destroying arena  */
+gdbmi_arena_ptr create_gdbmi_arena(void)
+{
+    gdbmi_arena_ptr arena = malloc(sizeof (struct gdbmi_arena));
+
+    if (!arena)
+        return NULL;
+
+    gdbmi_arena_mallocs++;
+
+    arena->blocks = NULL;
+    arena->next_size = GDBMI_ARENA_MIN_BLOCK;
+
+    return arena;
+}
+
+void destroy_gdbmi_arena(gdbmi_arena_ptr arena)
+{
+    struct gdbmi_arena_block *block, *next;
+
+    if (!arena)
+        return;
+
+    for (block = arena->blocks; block; block = next) {
+        next = block->next;
+        free(block);
+    }
+
+    free(arena);
+}
+
+void *gdbmi_arena_alloc(gdbmi_arena_ptr arena, size_t size)
+{
+    struct gdbmi_arena_block *block = arena->blocks;
+    size_t block_size;
+    void *result;
+
+    size = GDBMI_ARENA_ALIGN(size);
+
+    if (!block || block->size - block->used < size) {
+        /* A big string gets a block of its own size */
+        block_size = arena->next_size;
+        if (block_size < GDBMI_ARENA_HEADER + size)
+            block_size = GDBMI_ARENA_HEADER + size;
+        else if (arena->next_size < GDBMI_ARENA_MAX_BLOCK)
+            arena->next_size *= 2;
+
+        block = malloc(block_size);
+        if (!block)
+            return NULL;
+
+        gdbmi_arena_mallocs++;
+
+        block->size = block_size;
+        block->used = GDBMI_ARENA_HEADER;
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    result = (char *) block + block->used;
+    block->used += size;
+    memset(result, 0, size);
+
+    return result;
+}
+
+unsigned long gdbmi_arena_malloc_count(void)
+{
+    return gdbmi_arena_mallocs;
+}
+
+char *gdbmi_arena_strndup(gdbmi_arena_ptr arena, const char *s, size_t length)
+{
+    char *result = gdbmi_arena_alloc(arena, length + 1);
+
+    if (result) {
+        memcpy(result, s, length);
+        result[length] = 0;
+    }
+
+    return result;
+}
+
+/**
+ * Unescapes a c-string where it is. A typical c-string looks like,
+ *   Type \"show copying\" to see the conditions.\n
+ * The \" should be converted to a ", and the \n should be converted to a 
+ * newline. The other cases are handled in the code below. No escape 
+ * sequence is shorter than what it stands for, so the text never grows.
+ */
+static void gdbmi_cstring_unescape(gdbmi_cstring_ptr cstring)
+{
+    char *s = cstring->data;
+    size_t length = cstring->length, i, cur = 0;
+    int digits, octal;
+
+    for (i = 0; i < length; ++i) {
+        if (s[i] == '\\' && i + 1 < length) {
+            i++;
+            switch (s[i]) {
+                case 'n':
+                    s[cur++] = '\r';
+                    s[cur++] = '\n';
+                    break;
+                case 'r':
+                    s[cur++] = '\r';
+                    break;
+                case 't':
+                    s[cur++] = '\t';
+                    break;
+                case '0':
+                case '1':
+                case '2':
+                case '3':
+                case '4':
+                case '5':
+                case '6':
+                case '7':
+                    /* GDB writes the bytes it can't print in octal */
+                    octal = 0;
+                    for (digits = 0; digits < 3 && i < length &&
+                            s[i] >= '0' && s[i] <= '7'; ++digits, ++i)
+                        octal = octal * 8 + s[i] - '0';
+                    s[cur++] = (char) octal;
+                    i--;
+                    break;
+                default:
+                    /* \" and \\ stand for themselves, so does anything
+                     * else GDB escapes */
+                    s[cur++] = s[i];
+                    break;
+            };
+        } else
+            s[cur++] = s[i];
+    }
+    s[cur] = '\0';
+
+    cstring->length = cur;
+    cstring->escaped = 0;
+}
+
+const char *gdbmi_cstring_text(gdbmi_cstring_ptr cstring, size_t *length)
+{
+    if (cstring->escaped)
+        gdbmi_cstring_unescape(cstring);
+
+    if (length)
+        *length = cstring->length;
+
+    return cstring->data;
+}
+
 /* Creating and  Destroying */
 gdbmi_pdata_ptr create_gdbmi_pdata(void)
 {
@@ -48,36 +234,30 @@ int destroy_gdbmi_pdata(gdbmi_pdata_ptr param)
     if (!param)
         return 0;
 
+    destroy_gdbmi_output(param->tree);
+    destroy_gdbmi_arena(param->arena);
     free(param);
 
     return 0;
 }
 
 /* Creating, Destroying and printing gdbmi_output  */
-gdbmi_output_ptr create_gdbmi_output(void)
+gdbmi_output_ptr create_gdbmi_output(gdbmi_arena_ptr arena)
 {
-    return calloc(1, sizeof (struct gdbmi_output));
+    return gdbmi_arena_alloc(arena, sizeof (struct gdbmi_output));
 }
 
 int destroy_gdbmi_output(gdbmi_output_ptr param)
 {
-    if (!param)
-        return 0;
-
-    if (destroy_gdbmi_oob_record(param->oob_record) == -1)
-        return -1;
-    param->oob_record = NULL;
+    gdbmi_output_ptr next;
 
-    if (destroy_gdbmi_result_record(param->result_record) == -1)
-        return -1;
-    param->result_record = NULL;
-
-    if (destroy_gdbmi_output(param->next) == -1)
-        return -1;
-    param->next = NULL;
+    /* Each output lives in its own arena, with everything under it */
+    while (param) {
+        next = param->next;
+        destroy_gdbmi_arena(param->arena);
+        param = next;
+    }
 
-    free(param);
-    param = NULL;
     return 0;
 }
 
@@ -121,24 +301,10 @@ int print_gdbmi_output(gdbmi_output_ptr param)
     return 0;
 }
 
-/* Creating, Destroying and printing record  */
-gdbmi_result_record_ptr create_gdbmi_result_record(void)
+/* Creating and printing record  */
+gdbmi_result_record_ptr create_gdbmi_result_record(gdbmi_arena_ptr arena)
 {
-    return calloc(1, sizeof (struct gdbmi_result_record));
-}
-
-int destroy_gdbmi_result_record(gdbmi_result_record_ptr param)
-{
-    if (!param)
-        return 0;
-
-    if (destroy_gdbmi_result(param->result) == -1)
-        return -1;
-    param->result = NULL;
-
-    free(param);
-    param = NULL;
-    return 0;
+    return gdbmi_arena_alloc(arena, sizeof (struct gdbmi_result_record));
 }
 
 int print_gdbmi_result_record(gdbmi_result_record_ptr param)
@@ -163,33 +329,10 @@ int print_gdbmi_result_record(gdbmi_result_record_ptr param)
     return 0;
 }
 
-/* Creating, Destroying and printing result  */
-gdbmi_result_ptr create_gdbmi_result(void)
+/* Creating and printing result  */
+gdbmi_result_ptr create_gdbmi_result(gdbmi_arena_ptr arena)
 {
-    return calloc(1, sizeof (struct gdbmi_result_record));
-}
-
-int destroy_gdbmi_result(gdbmi_result_ptr param)
-{
-    if (!param)
-        return 0;
-
-    if (param->variable) {
-        free(param->variable);
-        param->variable = NULL;
-    }
-
-    if (destroy_gdbmi_value(param->value) == -1)
-        return -1;
-    param->value = NULL;
-
-    if (destroy_gdbmi_result(param->next) == -1)
-        return -1;
-    param->next = NULL;
-
-    free(param);
-    param = NULL;
-    return 0;
+    return gdbmi_arena_alloc(arena, sizeof (struct gdbmi_result));
 }
 
 gdbmi_result_ptr
@@ -246,36 +389,10 @@ int print_gdbmi_oob_record_choice(enum gdbmi_oob_record_choice param)
     return 0;
 }
 
-/* Creating, Destroying and printing oob_record  */
-gdbmi_oob_record_ptr create_gdbmi_oob_record(void)
+/* Creating and printing oob_record  */
+gdbmi_oob_record_ptr create_gdbmi_oob_record(gdbmi_arena_ptr arena)
 {
-    return calloc(1, sizeof (struct gdbmi_oob_record));
-}
-
-int destroy_gdbmi_oob_record(gdbmi_oob_record_ptr param)
-{
-    if (!param)
-        return 0;
-
-    if (param->record == GDBMI_ASYNC) {
-        if (destroy_gdbmi_async_record(param->option.async_record) == -1)
-            return -1;
-        param->option.async_record = NULL;
-    } else if (param->record == GDBMI_STREAM) {
-        if (destroy_gdbmi_stream_record(param->option.stream_record) == -1)
-            return -1;
-        param->option.stream_record = NULL;
-    } else {
-        return -1;
-    }
-
-    if (destroy_gdbmi_oob_record(param->next) == -1)
-        return -1;
-    param->next = NULL;
-
-    free(param);
-    param = NULL;
-    return 0;
+    return gdbmi_arena_alloc(arena, sizeof (struct gdbmi_oob_record));
 }
 
 gdbmi_oob_record_ptr
@@ -363,24 +480,10 @@ int print_gdbmi_stream_record_choice(enum gdbmi_stream_record_choice param)
     return 0;
 }
 
-/* Creating, Destroying and printing async_record  */
-gdbmi_async_record_ptr create_gdbmi_async_record(void)
+/* Creating and printing async_record  */
+gdbmi_async_record_ptr create_gdbmi_async_record(gdbmi_arena_ptr arena)
 {
-    return calloc(1, sizeof (struct gdbmi_async_record));
-}
-
-int destroy_gdbmi_async_record(gdbmi_async_record_ptr param)
-{
-    if (!param)
-        return 0;
-
-    if (destroy_gdbmi_result(param->result) == -1)
-        return -1;
-    param->result = NULL;
-
-    free(param);
-    param = NULL;
-    return 0;
+    return gdbmi_arena_alloc(arena, sizeof (struct gdbmi_async_record));
 }
 
 int print_gdbmi_async_record(gdbmi_async_record_ptr param)
@@ -415,6 +518,30 @@ int print_gdbmi_async_class(enum gdbmi_async_class param)
         case GDBMI_STOPPED:
             printf("GDBMI_STOPPED\n");
             break;
+        case GDBMI_ASYNC_RUNNING:
+            printf("GDBMI_ASYNC_RUNNING\n");
+            break;
+        case GDBMI_BREAKPOINT_CREATED:
+            printf("GDBMI_BREAKPOINT_CREATED\n");
+            break;
+        case GDBMI_BREAKPOINT_MODIFIED:
+            printf("GDBMI_BREAKPOINT_MODIFIED\n");
+            break;
+        case GDBMI_BREAKPOINT_DELETED:
+            printf("GDBMI_BREAKPOINT_DELETED\n");
+            break;
+        case GDBMI_THREAD_SELECTED:
+            printf("GDBMI_THREAD_SELECTED\n");
+            break;
+        case GDBMI_THREAD_CREATED:
+            printf("GDBMI_THREAD_CREATED\n");
+            break;
+        case GDBMI_THREAD_EXITED:
+            printf("GDBMI_THREAD_EXITED\n");
+            break;
+        case GDBMI_ASYNC_UNKNOWN:
+            printf("GDBMI_ASYNC_UNKNOWN\n");
+            break;
         default:
             return -1;
     };
@@ -434,6 +561,9 @@ int print_gdbmi_value_choice(enum gdbmi_value_choice param)
         case GDBMI_LIST:
             printf("GDBMI_LIST\n");
             break;
+        case GDBMI_LAZY:
+            printf("GDBMI_LAZY\n");
+            break;
         default:
             return -1;
     };
@@ -441,40 +571,10 @@ int print_gdbmi_value_choice(enum gdbmi_value_choice param)
     return 0;
 }
 
-/* Creating, Destroying and printing value  */
-gdbmi_value_ptr create_gdbmi_value(void)
+/* Creating and printing value  */
+gdbmi_value_ptr create_gdbmi_value(gdbmi_arena_ptr arena)
 {
-    return calloc(1, sizeof (struct gdbmi_value));
-}
-
-int destroy_gdbmi_value(gdbmi_value_ptr param)
-{
-    if (!param)
-        return 0;
-
-    if (param->value_choice == GDBMI_CSTRING) {
-        if (param->option.cstring) {
-            free(param->option.cstring);
-            param->option.cstring = NULL;
-        }
-    } else if (param->value_choice == GDBMI_TUPLE) {
-        if (destroy_gdbmi_tuple(param->option.tuple) == -1)
-            return -1;
-        param->option.tuple = NULL;
-    } else if (param->value_choice == GDBMI_LIST) {
-        if (destroy_gdbmi_list(param->option.list) == -1)
-            return -1;
-        param->option.list = NULL;
-    } else
-        return -1;
-
-    if (destroy_gdbmi_value(param->next) == -1)
-        return -1;
-    param->next = NULL;
-
-    free(param);
-    param = NULL;
-    return 0;
+    return gdbmi_arena_alloc(arena, sizeof (struct gdbmi_value));
 }
 
 gdbmi_value_ptr append_gdbmi_value(gdbmi_value_ptr list, gdbmi_value_ptr item)
@@ -496,18 +596,215 @@ gdbmi_value_ptr append_gdbmi_value(gdbmi_value_ptr list, gdbmi_value_ptr item)
     return list;
 }
 
+/* Reads the text of a lazy value. The text is written over as it's read,
+   the c-strings and variables in it are null terminated where they are.  */
+struct gdbmi_decoder {
+    char *s;
+    char *end;
+    gdbmi_arena_ptr arena;
+};
+
+/* Returns what follows the c-string, tuple or list at s, or NULL if it 
+   doesn't end before end.  */
+static char *gdbmi_decode_skip(char *s, char *end)
+{
+    int depth = 0, quoted = 0;
+
+    for (; s < end; ++s) {
+        if (quoted) {
+            if (*s == '\\')
+                ++s;
+            else if (*s == '"')
+                quoted = 0;
+        } else if (*s == '"')
+            quoted = 1;
+        else if (*s == '{' || *s == '[')
+            ++depth;
+        else if (*s == '}' || *s == ']')
+            --depth;
+
+        if (!quoted && depth == 0)
+            return s + 1;
+    }
+
+    return NULL;
+}
+
+static gdbmi_value_ptr gdbmi_decode_one(struct gdbmi_decoder *decoder)
+{
+    gdbmi_value_ptr value;
+    char *s = decoder->s, *next;
+
+    if (s == decoder->end || (*s != '"' && *s != '{' && *s != '['))
+        return NULL;
+
+    next = gdbmi_decode_skip(s, decoder->end);
+    if (!next)
+        return NULL;
+
+    value = create_gdbmi_value(decoder->arena);
+    if (!value)
+        return NULL;
+
+    if (*s == '"') {
+        value->value_choice = GDBMI_CSTRING;
+        value->option.cstring.data = s + 1;
+        value->option.cstring.length = next - s - 2;
+        value->option.cstring.escaped =
+                memchr(s + 1, '\\', next - s - 2) != NULL;
+        /* The closing quote is where it ends  */
+        next[-1] = '\0';
+    } else {
+        /* Left for when it's read, like the value it's in was  */
+        value->value_choice = GDBMI_LAZY;
+        value->option.lazy.data = s;
+        value->option.lazy.length = next - s;
+        value->option.lazy.arena = decoder->arena;
+    }
+
+    decoder->s = next;
+
+    return value;
+}
+
+static gdbmi_result_ptr gdbmi_decode_result(struct gdbmi_decoder *decoder)
+{
+    gdbmi_result_ptr result;
+    char *variable = decoder->s;
+
+    while (decoder->s < decoder->end && *decoder->s != '=')
+        ++decoder->s;
+
+    if (decoder->s == decoder->end || decoder->s == variable)
+        return NULL;
+
+    result = create_gdbmi_result(decoder->arena);
+    if (!result)
+        return NULL;
+
+    result->variable = variable;
+    result->keyword = gdbmi_keyword_lookup(variable, decoder->s - variable);
+
+    /* The equal sign is where the variable ends  */
+    *decoder->s++ = '\0';
+    result->value = gdbmi_decode_one(decoder);
+    if (!result->value)
+        return NULL;
+
+    return result;
+}
+
+/* Reads the results of a tuple or list, or the values of a list. The 
+   ones after the first are appended as they're read, with tails, so a 
+   long list doesn't get walked again for each of them.  */
+static int gdbmi_decode_results(struct gdbmi_decoder *decoder,
+        gdbmi_result_ptr * results)
+{
+    gdbmi_result_ptr tail = NULL, result;
+
+    for (;;) {
+        result = gdbmi_decode_result(decoder);
+        if (!result)
+            return -1;
+
+        if (tail)
+            tail->next = result;
+        else
+            *results = result;
+        tail = result;
+        if (decoder->s == decoder->end || *decoder->s != ',')
+            break;
+        ++decoder->s;
+    }
+
+    return decoder->s == decoder->end ? 0 : -1;
+}
+
+static int gdbmi_decode_values(struct gdbmi_decoder *decoder,
+        gdbmi_value_ptr * values)
+{
+    gdbmi_value_ptr tail = NULL, value;
+
+    for (;;) {
+        value = gdbmi_decode_one(decoder);
+        if (!value)
+            return -1;
+
+        if (tail)
+            tail->next = value;
+        else
+            *values = value;
+        tail = value;
+        if (decoder->s == decoder->end || *decoder->s != ',')
+            break;
+        ++decoder->s;
+    }
+
+    return decoder->s == decoder->end ? 0 : -1;
+}
+
+int gdbmi_decode_value(gdbmi_value_ptr value)
+{
+    struct gdbmi_decoder decoder;
+    struct gdbmi_lazy lazy;
+    gdbmi_tuple_ptr tuple = NULL;
+    gdbmi_list_ptr list = NULL;
+    int result = 0;
+
+    if (!value || value->value_choice != GDBMI_LAZY)
+        return 0;
+
+    lazy = value->option.lazy;
+
+    /* The brackets are left out, the lexer checked that they match  */
+    decoder.s = lazy.data + 1;
+    decoder.end = lazy.data + lazy.length - 1;
+    decoder.arena = lazy.arena;
+
+    if (lazy.data[0] == '{') {
+        if (decoder.s != decoder.end) {
+            tuple = create_gdbmi_tuple(decoder.arena);
+            if (!tuple || gdbmi_decode_results(&decoder, &tuple->result) == -1)
+                result = -1;
+        }
+        value->value_choice = GDBMI_TUPLE;
+        value->option.tuple = result == 0 ? tuple : NULL;
+    } else {
+        if (decoder.s != decoder.end) {
+            list = create_gdbmi_list(decoder.arena);
+            if (!list)
+                result = -1;
+            else if (*decoder.s == '"' || *decoder.s == '{' ||
+                    *decoder.s == '[') {
+                list->list_choice = GDBMI_VALUE;
+                result = gdbmi_decode_values(&decoder, &list->option.value);
+            } else {
+                list->list_choice = GDBMI_RESULT;
+                result = gdbmi_decode_results(&decoder, &list->option.result);
+            }
+        }
+        value->value_choice = GDBMI_LIST;
+        value->option.list = result == 0 ? list : NULL;
+    }
+
+    return result;
+}
+
 int print_gdbmi_value(gdbmi_value_ptr param)
 {
     gdbmi_value_ptr cur = param;
     int result;
 
     while (cur) {
+        /* Printing is for debugging, the whole tree is shown  */
+        gdbmi_decode_value(cur);
+
         result = print_gdbmi_value_choice(cur->value_choice);
         if (result == -1)
             return -1;
 
         if (cur->value_choice == GDBMI_CSTRING) {
-            printf("cstring->(%s)\n", cur->option.cstring);
+            printf("cstring->(\"%s\")\n", cur->option.cstring.data);
         } else if (cur->value_choice == GDBMI_TUPLE) {
             result = print_gdbmi_tuple(cur->option.tuple);
             if (result == -1)
@@ -525,28 +822,10 @@ int print_gdbmi_value(gdbmi_value_ptr param)
     return 0;
 }
 
-/* Creating, Destroying and printing tuple  */
-gdbmi_tuple_ptr create_gdbmi_tuple(void)
+/* Creating and printing tuple  */
+gdbmi_tuple_ptr create_gdbmi_tuple(gdbmi_arena_ptr arena)
 {
-    return calloc(1, sizeof (struct gdbmi_tuple));
-}
-
-int destroy_gdbmi_tuple(gdbmi_tuple_ptr param)
-{
-    if (!param)
-        return 0;
-
-    if (destroy_gdbmi_result(param->result) == -1)
-        return -1;
-    param->result = NULL;
-
-    if (destroy_gdbmi_tuple(param->next) == -1)
-        return -1;
-    param->next = NULL;
-
-    free(param);
-    param = NULL;
-    return 0;
+    return gdbmi_arena_alloc(arena, sizeof (struct gdbmi_tuple));
 }
 
 int print_gdbmi_tuple(gdbmi_tuple_ptr param)
@@ -581,35 +860,10 @@ int print_gdbmi_list_choice(enum gdbmi_list_choice param)
     return 0;
 }
 
-/* Creating, Destroying and printing list  */
-gdbmi_list_ptr create_gdbmi_list(void)
-{
-    return calloc(1, sizeof (struct gdbmi_list));
-}
-
-int destroy_gdbmi_list(gdbmi_list_ptr param)
+/* Creating and printing list  */
+gdbmi_list_ptr create_gdbmi_list(gdbmi_arena_ptr arena)
 {
-    if (!param)
-        return 0;
-
-    if (param->list_choice == GDBMI_VALUE) {
-        if (destroy_gdbmi_value(param->option.value) == -1)
-            return -1;
-        param->option.value = NULL;
-    } else if (param->list_choice == GDBMI_RESULT) {
-        if (destroy_gdbmi_result(param->option.result) == -1)
-            return -1;
-        param->option.result = NULL;
-    } else
-        return -1;
-
-    if (destroy_gdbmi_list(param->next) == -1)
-        return -1;
-    param->next = NULL;
-
-    free(param);
-    param = NULL;
-    return 0;
+    return gdbmi_arena_alloc(arena, sizeof (struct gdbmi_list));
 }
 
 gdbmi_list_ptr append_gdbmi_list(gdbmi_list_ptr list, gdbmi_list_ptr item)
@@ -658,25 +912,10 @@ int print_gdbmi_list(gdbmi_list_ptr param)
     return 0;
 }
 
-/* Creating, Destroying and printing stream_record  */
-gdbmi_stream_record_ptr create_gdbmi_stream_record(void)
-{
-    return calloc(1, sizeof (struct gdbmi_stream_record));
-}
-
-int destroy_gdbmi_stream_record(gdbmi_stream_record_ptr param)
+/* Creating and printing stream_record  */
+gdbmi_stream_record_ptr create_gdbmi_stream_record(gdbmi_arena_ptr arena)
 {
-    if (!param)
-        return 0;
-
-    if (param->cstring) {
-        free(param->cstring);
-        param->cstring = NULL;
-    }
-
-    free(param);
-    param = NULL;
-    return 0;
+    return gdbmi_arena_alloc(arena, sizeof (struct gdbmi_stream_record));
 }
 
 int print_gdbmi_stream_record(gdbmi_stream_record_ptr param)
@@ -686,7 +925,7 @@ int print_gdbmi_stream_record(gdbmi_stream_record_ptr param)
     result = print_gdbmi_stream_record_choice(param->stream_record);
     if (result == -1)
         return -1;
-    printf("cstring->(%s)\n", param->cstring);
+    printf("cstring->(\"%s\")\n", param->cstring.data);
 
     return 0;
 }
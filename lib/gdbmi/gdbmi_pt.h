@@ -1,6 +1,9 @@
 #ifndef __GDBMI_PT_H__
 #define __GDBMI_PT_H__
 
+#include <stddef.h>
+#include "gdbmi_keyword.h"
+
 typedef struct gdbmi_output *gdbmi_output_ptr;
 typedef struct gdbmi_oob_record *gdbmi_oob_record_ptr;
 typedef struct gdbmi_result_record *gdbmi_result_record_ptr;
@@ -12,10 +15,16 @@ typedef struct gdbmi_value *gdbmi_value_ptr;
 typedef struct gdbmi_tuple *gdbmi_tuple_ptr;
 typedef struct gdbmi_list *gdbmi_list_ptr;
 typedef struct gdbmi_pdata *gdbmi_pdata_ptr;
+typedef struct gdbmi_arena *gdbmi_arena_ptr;
+typedef struct gdbmi_cstring *gdbmi_cstring_ptr;
 
 struct gdbmi_pdata {
     int parsed_one;
     gdbmi_output_ptr tree;
+
+    /* The arena the nodes of the output being parsed go in. The output
+       takes it once it's parsed, and the parser starts a new one.  */
+    gdbmi_arena_ptr arena;
 };
 
 /* A choice of result's that GDB is capable of producing  */
@@ -38,6 +47,10 @@ struct gdbmi_output {
 
     /* A pointer to the next output  */
     gdbmi_output_ptr next;
+
+    /* The memory of this output and everything it contains, strings 
+       included. The nodes of the tree are never freed one by one.  */
+    gdbmi_arena_ptr arena;
 };
 
 /* A result record represents the result of a command sent to GDB.  */
@@ -111,8 +124,18 @@ enum gdbmi_stream_record_choice {
     GDBMI_LOG
 };
 
+/* The asynchronous records the front end looks at. The rest are 
+   GDBMI_ASYNC_UNKNOWN.  */
 enum gdbmi_async_class {
-    GDBMI_STOPPED
+    GDBMI_STOPPED,
+    GDBMI_ASYNC_RUNNING,
+    GDBMI_BREAKPOINT_CREATED,
+    GDBMI_BREAKPOINT_MODIFIED,
+    GDBMI_BREAKPOINT_DELETED,
+    GDBMI_THREAD_SELECTED,
+    GDBMI_THREAD_CREATED,
+    GDBMI_THREAD_EXITED,
+    GDBMI_ASYNC_UNKNOWN
 };
 
 /* An asyncronous record  */
@@ -134,25 +157,51 @@ struct gdbmi_async_record {
 struct gdbmi_result {
     /* Key  */
     char *variable;
+    /* The keyword the key is, GDBMI_KEYWORD_UNKNOWN if it's none  */
+    enum gdbmi_keyword keyword;
     /* Value  */
     gdbmi_value_ptr value;
     /* Pointer to the next result  */
     gdbmi_result_ptr next;
 };
 
+/* A c-string GDB sent, without its quotes. It's kept the way GDB wrote 
+   it until it's read with gdbmi_cstring_text, which unescapes it where it 
+   is. Like the rest of the tree, it lives in the arena of its output.  */
+struct gdbmi_cstring {
+    /* The text, null terminated  */
+    char *data;
+    /* The length of the text  */
+    size_t length;
+    /* 1 until the escapes in the text are decoded  */
+    int escaped;
+};
+
 enum gdbmi_value_choice {
     GDBMI_CSTRING,
     GDBMI_TUPLE,
-    GDBMI_LIST
+    GDBMI_LIST,
+    /* A tuple or list the lazy parser hasn't decoded yet. 
+       gdbmi_decode_value makes it a GDBMI_TUPLE or a GDBMI_LIST.  */
+    GDBMI_LAZY
+};
+
+/* The text of a tuple or list, brackets included, as GDB wrote it  */
+struct gdbmi_lazy {
+    char *data;
+    size_t length;
+    /* The arena the nodes go in when it's decoded  */
+    gdbmi_arena_ptr arena;
 };
 
 struct gdbmi_value {
     enum gdbmi_value_choice value_choice;
 
     union {
-        char *cstring;
+        struct gdbmi_cstring cstring;
         gdbmi_tuple_ptr tuple;
         gdbmi_list_ptr list;
+        struct gdbmi_lazy lazy;
     } option;
 
     gdbmi_value_ptr next;
@@ -181,40 +230,57 @@ struct gdbmi_list {
 
 struct gdbmi_stream_record {
     enum gdbmi_stream_record_choice stream_record;
-    char *cstring;
+    struct gdbmi_cstring cstring;
 };
 
 /* Print result class  */
 int print_gdbmi_result_class(enum gdbmi_result_class param);
 
+/* Creating and Destroying arena. Destroying it frees everything that was
+   allocated in it.  */
+gdbmi_arena_ptr create_gdbmi_arena(void);
+void destroy_gdbmi_arena(gdbmi_arena_ptr arena);
+
+/* Allocates zeroed memory in an arena, or returns NULL  */
+void *gdbmi_arena_alloc(gdbmi_arena_ptr arena, size_t size);
+
+/* The number of times the arenas called malloc so far. The nodes of a 
+   tree are all allocated in arenas, so this is what parsing costs.  */
+unsigned long gdbmi_arena_malloc_count(void);
+
+/* Copies length characters of s into an arena, and null terminates them  */
+char *gdbmi_arena_strndup(gdbmi_arena_ptr arena, const char *s, size_t length);
+
+/* Gets the unescaped text of a c-string. It's null terminated, and 
+   length, if it isn't NULL, is set to its length. The text belongs to 
+   the tree.  */
+const char *gdbmi_cstring_text(gdbmi_cstring_ptr cstring, size_t *length);
+
 /* Creating and  Destroying */
 gdbmi_pdata_ptr create_gdbmi_pdata(void);
 int destroy_gdbmi_pdata(gdbmi_pdata_ptr param);
 
 /* Creating, Destroying and printing output  */
-gdbmi_output_ptr create_gdbmi_output(void);
+gdbmi_output_ptr create_gdbmi_output(gdbmi_arena_ptr arena);
 int destroy_gdbmi_output(gdbmi_output_ptr param);
 gdbmi_output_ptr append_gdbmi_output(gdbmi_output_ptr list,
         gdbmi_output_ptr item);
 int print_gdbmi_output(gdbmi_output_ptr param);
 
-/* Creating, Destroying and printing record  */
-gdbmi_result_record_ptr create_gdbmi_result_record(void);
-int destroy_gdbmi_result_record(gdbmi_result_record_ptr param);
+/* Creating and printing record  */
+gdbmi_result_record_ptr create_gdbmi_result_record(gdbmi_arena_ptr arena);
 int print_gdbmi_result_record(gdbmi_result_record_ptr param);
 
-/* Creating, Destroying and printing result  */
-gdbmi_result_ptr create_gdbmi_result(void);
-int destroy_gdbmi_result(gdbmi_result_ptr param);
+/* Creating and printing result  */
+gdbmi_result_ptr create_gdbmi_result(gdbmi_arena_ptr arena);
 gdbmi_result_ptr append_gdbmi_result(gdbmi_result_ptr list,
         gdbmi_result_ptr item);
 int print_gdbmi_result(gdbmi_result_ptr param);
 
 int print_gdbmi_oob_record_choice(enum gdbmi_oob_record_choice param);
 
-/* Creating, Destroying and printing oob_record  */
-gdbmi_oob_record_ptr create_gdbmi_oob_record(void);
-int destroy_gdbmi_oob_record(gdbmi_oob_record_ptr param);
+/* Creating and printing oob_record  */
+gdbmi_oob_record_ptr create_gdbmi_oob_record(gdbmi_arena_ptr arena);
 gdbmi_oob_record_ptr append_gdbmi_oob_record(gdbmi_oob_record_ptr list,
         gdbmi_oob_record_ptr item);
 int print_gdbmi_oob_record(gdbmi_oob_record_ptr param);
@@ -223,37 +289,38 @@ int print_gdbmi_async_record_choice(enum gdbmi_async_record_choice param);
 
 int print_gdbmi_stream_record_choice(enum gdbmi_stream_record_choice param);
 
-/* Creating, Destroying and printing async_record  */
-gdbmi_async_record_ptr create_gdbmi_async_record(void);
-int destroy_gdbmi_async_record(gdbmi_async_record_ptr param);
+/* Creating and printing async_record  */
+gdbmi_async_record_ptr create_gdbmi_async_record(gdbmi_arena_ptr arena);
 int print_gdbmi_async_record(gdbmi_async_record_ptr param);
 
 int print_gdbmi_async_class(enum gdbmi_async_class param);
 
 int print_gdbmi_value_choice(enum gdbmi_value_choice param);
 
-/* Creating, Destroying and printing value  */
-gdbmi_value_ptr create_gdbmi_value(void);
-int destroy_gdbmi_value(gdbmi_value_ptr param);
+/* Decodes a GDBMI_LAZY value where it is, one level deep. The tuples and 
+   lists in it are left for later in turn. Other values are left alone. 
+   Returns 0 on success, or -1 if the text isn't a tuple or list, which 
+   leaves an empty one.  */
+int gdbmi_decode_value(gdbmi_value_ptr value);
+
+/* Creating and printing value  */
+gdbmi_value_ptr create_gdbmi_value(gdbmi_arena_ptr arena);
 gdbmi_value_ptr append_gdbmi_value(gdbmi_value_ptr list, gdbmi_value_ptr item);
 int print_gdbmi_value(gdbmi_value_ptr param);
 
-/* Creating, Destroying and printing tuple  */
-gdbmi_tuple_ptr create_gdbmi_tuple(void);
-int destroy_gdbmi_tuple(gdbmi_tuple_ptr param);
+/* Creating and printing tuple  */
+gdbmi_tuple_ptr create_gdbmi_tuple(gdbmi_arena_ptr arena);
 int print_gdbmi_tuple(gdbmi_tuple_ptr param);
 
 int print_gdbmi_list_choice(enum gdbmi_list_choice param);
 
-/* Creating, Destroying and printing list  */
-gdbmi_list_ptr create_gdbmi_list(void);
-int destroy_gdbmi_list(gdbmi_list_ptr param);
+/* Creating and printing list  */
+gdbmi_list_ptr create_gdbmi_list(gdbmi_arena_ptr arena);
 gdbmi_list_ptr append_gdbmi_list(gdbmi_list_ptr list, gdbmi_list_ptr item);
 int print_gdbmi_list(gdbmi_list_ptr param);
 
-/* Creating, Destroying and printing stream_record  */
-gdbmi_stream_record_ptr create_gdbmi_stream_record(void);
-int destroy_gdbmi_stream_record(gdbmi_stream_record_ptr param);
+/* Creating and printing stream_record  */
+gdbmi_stream_record_ptr create_gdbmi_stream_record(gdbmi_arena_ptr arena);
 int print_gdbmi_stream_record(gdbmi_stream_record_ptr param);
 
 #endif
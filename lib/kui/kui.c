@@ -203,15 +203,14 @@ int kui_map_print_cgdb_key_array(struct kui_map *map)
  * matching any map in this set with the current key strokes being typed.
  */
 struct kui_map_set {
-    /* The ktree used in determining if a map has been reached or is being
-     * reached. Of course, nothing could match also. This structure is efficient
-     * in doing the work, it looks only at the current key read.  */
-    struct kui_tree *ktree;
-
     /* A linked list of the maps being checked for. */
     std_list maps;
 };
 
+/* Bumped each time a map is registered or deregistered, so the kui
+ * contexts know to compile their maps again. */
+static unsigned long kui_ms_changes;
+
 static int kui_map_destroy_callback(void *data)
 {
     struct kui_map *map;
@@ -240,13 +239,6 @@ struct kui_map_set *kui_ms_create(void)
         return NULL;
     }
 
-    map->ktree = kui_tree_create();
-
-    if (!map->ktree) {
-        kui_ms_destroy(map);
-        return NULL;
-    }
-
     return map;
 }
 
@@ -257,11 +249,6 @@ int kui_ms_destroy(struct kui_map_set *kui_ms)
     if (!kui_ms)
         return -1;
 
-    if (kui_ms->ktree) {
-        if (kui_tree_destroy(kui_ms->ktree) == -1)
-            retval = -1;
-    }
-
     if (kui_ms->maps) {
         if (std_list_destroy(kui_ms->maps) == -1)
             retval = -1;
@@ -303,21 +290,114 @@ int kui_ms_register_map(struct kui_map_set *kui_ms,
     if (!map)
         return -1;
 
+    /* The new map replaces any map of the same key */
+    if (std_list_find(kui_ms->maps, key_data, kui_map_compare_key_callback)
+            != std_list_end(kui_ms->maps) &&
+            kui_ms_deregister_map(kui_ms, key_data) == -1) {
+        kui_map_destroy(map);
+        return -1;
+    }
+
     if (std_list_insert_sorted(kui_ms->maps, map,
                     kui_map_compare_callback) == -1)
         return -1;
 
-    if (kui_tree_insert(kui_ms->ktree, map->literal_key, map) == -1)
-        return -1;
+    kui_ms_changes++;
 
     return 0;
 }
 
-int kui_ms_deregister_map(struct kui_map_set *kui_ms, const char *key)
+/**
+ * A map of kui_ms_register_maps, and where it was given, so that the last
+ * of the maps of a key is the one kept.
+ */
+struct kui_map_entry {
+    struct kui_map *map;
+    int index;
+};
+
+static int kui_map_entry_compare(const void *a, const void *b)
 {
+    const struct kui_map_entry *one = (const struct kui_map_entry *) a;
+    const struct kui_map_entry *two = (const struct kui_map_entry *) b;
+    int ret = strcmp(one->map->original_key, two->map->original_key);
+
+    return ret ? ret : one->index - two->index;
+}
+
+int kui_ms_register_maps(struct kui_map_set *kui_ms,
+        const char *const *keys, const char *const *values, int count)
+{
+    struct kui_map_entry *entries;
     std_list_iterator iter;
     struct kui_map *map;
     void *data;
+    int i, made, cmp, failed, retval = 0;
+
+    if (!kui_ms || count < 0)
+        return -1;
+
+    entries = (struct kui_map_entry *) malloc(sizeof (struct kui_map_entry) *
+            (count + 1));
+    if (!entries)
+        return -1;
+
+    /* A map that can't be made is left out, the others are still added */
+    for (i = 0, made = 0; i < count; i++) {
+        entries[made].map = kui_map_create(keys[i], values[i]);
+        entries[made].index = i;
+
+        if (entries[made].map)
+            made++;
+        else
+            retval = -1;
+    }
+    count = made;
+
+    qsort(entries, count, sizeof (struct kui_map_entry),
+            kui_map_entry_compare);
+
+    /* The maps are sorted like the list is, so they're merged into it in
+     * one walk down the list */
+    iter = std_list_begin(kui_ms->maps);
+    for (i = 0, failed = 0; i < count; i++) {
+        map = entries[i].map;
+
+        if (failed || (i + 1 < count &&
+                        strcmp(map->original_key,
+                                entries[i + 1].map->original_key) == 0)) {
+            kui_map_destroy(map);
+            continue;
+        }
+
+        cmp = 1;
+        while (iter != std_list_end(kui_ms->maps) &&
+                std_list_get_data(iter, &data) == 0 &&
+                (cmp = strcmp(((struct kui_map *) data)->original_key,
+                                map->original_key)) < 0)
+            iter = std_list_next(iter);
+
+        /* The new map replaces any map of the same key */
+        if (iter != std_list_end(kui_ms->maps) && cmp == 0)
+            iter = std_list_remove(kui_ms->maps, iter);
+
+        if (!iter || std_list_insert(kui_ms->maps, iter, map) == -1) {
+            kui_map_destroy(map);
+            failed = 1;
+            retval = -1;
+        }
+    }
+
+    free(entries);
+    kui_ms_changes++;
+
+    return retval;
+}
+
+int kui_ms_deregister_map(struct kui_map_set *kui_ms, const char *key)
+{
+    std_list_iterator iter;
+    void *data;
 
     if (!kui_ms)
         return -1;
@@ -332,14 +412,10 @@ int kui_ms_deregister_map(struct kui_map_set *kui_ms, const char *key)
 
     /* If the mapping exists, remove it. */
     if (data) {
-        map = (struct kui_map *) data;
-
-        /* Delete from the tree */
-        if (kui_tree_delete(kui_ms->ktree, map->literal_key) == -1)
-            return -1;
-
         if (std_list_remove(kui_ms->maps, iter) == NULL)
             return -1;
+
+        kui_ms_changes++;
     }
 
     return 0;
@@ -347,6 +423,128 @@ int kui_ms_deregister_map(struct kui_map_set *kui_ms, const char *key)
 
 /* }}} */
 
+/* struct kui_keys {{{ */
+
+/**
+ * The most keys a kui context can have waiting to be read.
+ */
+#define KUI_KEYS_SIZE 1024
+
+/**
+ * A queue of keys, kept in a ring so that keys come and go without being
+ * allocated.
+ */
+struct kui_keys {
+    /**
+	 * The keys, count of them starting at start, wrapping around.
+	 */
+    int keys[KUI_KEYS_SIZE];
+    int start;
+    int count;
+};
+
+/**
+ * Gets a key from a queue.
+ *
+ * \param q
+ * The queue.
+ *
+ * \param i
+ * The key to get, 0 is the first key.
+ *
+ * @return
+ * The key.
+ */
+static int kui_keys_get(struct kui_keys *q, int i)
+{
+    return q->keys[(q->start + i) % KUI_KEYS_SIZE];
+}
+
+/**
+ * Puts a key at the front of a queue, to be read next.
+ *
+ * \param q
+ * The queue.
+ *
+ * \param key
+ * The key.
+ *
+ * @return
+ * 0 on success, or -1 if the queue is full.
+ */
+static int kui_keys_push_front(struct kui_keys *q, int key)
+{
+    if (q->count == KUI_KEYS_SIZE)
+        return -1;
+
+    q->start = (q->start + KUI_KEYS_SIZE - 1) % KUI_KEYS_SIZE;
+    q->keys[q->start] = key;
+    q->count++;
+
+    return 0;
+}
+
+/**
+ * Puts a key at the back of a queue, to be read last.
+ *
+ * \param q
+ * The queue.
+ *
+ * \param key
+ * The key.
+ *
+ * @return
+ * 0 on success, or -1 if the queue is full.
+ */
+static int kui_keys_push_back(struct kui_keys *q, int key)
+{
+    if (q->count == KUI_KEYS_SIZE)
+        return -1;
+
+    q->keys[(q->start + q->count) % KUI_KEYS_SIZE] = key;
+    q->count++;
+
+    return 0;
+}
+
+/**
+ * Takes the key at the front of a queue.
+ *
+ * \param q
+ * The queue.
+ *
+ * \param key
+ * The key taken.
+ *
+ * @return
+ * 0 on success, or -1 if the queue is empty.
+ */
+static int kui_keys_pop_front(struct kui_keys *q, int *key)
+{
+    if (q->count == 0)
+        return -1;
+
+    *key = q->keys[q->start];
+    q->start = (q->start + 1) % KUI_KEYS_SIZE;
+    q->count--;
+
+    return 0;
+}
+
+/**
+ * Empties a queue.
+ *
+ * \param q
+ * The queue.
+ */
+static void kui_keys_clear(struct kui_keys *q)
+{
+    q->start = 0;
+    q->count = 0;
+}
+
+/* }}} */
+
 /* struct kuictx {{{ */
 
 /**
@@ -359,14 +557,45 @@ struct kuictx {
     std_list kui_map_set_list;
 
     /**
-	 * A list of characters, used as a buffer for stdin.
+	 * The maps of all the map sets, compiled into one tree. It's NULL
+	 * until it's needed, and built again when the maps change.
 	 */
-    std_list buffer;
+    struct kui_tree *ktree;
 
     /**
-	 * A volitale buffer. This is reset upon every call to kui_getkey.
+	 * The value of kui_ms_changes when ktree was built.
 	 */
-    std_list volatile_buffer;
+    unsigned long ktree_changes;
+
+    /**
+	 * The characters to read before stdin, put back after looking for
+	 * a map.
+	 */
+    struct kui_keys buffer;
+
+    /**
+	 * A volitale buffer. This is reset upon every call to kui_getkey,
+	 * unless the last one left a map being matched.
+	 * It has the characters read while looking for a map, in order.
+	 */
+    struct kui_keys volatile_buffer;
+
+    /**
+	 * 1 if a map that's only partly typed is left for the next call to
+	 * kui_getkey to finish, instead of waiting ms for the rest of it.
+	 */
+    int defer;
+
+    /**
+	 * 1 while the keys of a map that's only partly typed are kept in
+	 * volatile_buffer and ktree, for the next call to kui_getkey.
+	 */
+    int matching;
+
+    /**
+	 * 1 once the keys kept while matching have waited long enough.
+	 */
+    int expired;
 
     /**
 	 * The callback function used to get data read in.
@@ -389,19 +618,6 @@ struct kuictx {
     int fd;
 };
 
-static int kui_ms_destroy_int_callback(void *param)
-{
-    int *i = (int *) param;
-
-    if (!i)
-        return -1;
-
-    free(i);
-    i = NULL;
-
-    return 0;
-}
-
 struct kuictx *kui_create(int stdinfd,
         kui_getkey_callback callback, int ms, void *state_data)
 {
@@ -414,8 +630,12 @@ struct kuictx *kui_create(int stdinfd,
 
     kctx->callback = callback;
     kctx->state_data = state_data;
+    kctx->ktree = NULL;
     kctx->kui_map_set_list = std_list_create(NULL);
     kctx->ms = ms;
+    kctx->defer = 0;
+    kctx->matching = 0;
+    kctx->expired = 0;
 
     if (!kctx->kui_map_set_list) {
         kui_destroy(kctx);
@@ -424,19 +644,8 @@ struct kuictx *kui_create(int stdinfd,
 
     kctx->fd = stdinfd;
 
-    kctx->buffer = std_list_create(kui_ms_destroy_int_callback);
-
-    if (!kctx->buffer) {
-        kui_destroy(kctx);
-        return NULL;
-    }
-
-    kctx->volatile_buffer = std_list_create(kui_ms_destroy_int_callback);
-
-    if (!kctx->volatile_buffer) {
-        kui_destroy(kctx);
-        return NULL;
-    }
+    kui_keys_clear(&kctx->buffer);
+    kui_keys_clear(&kctx->volatile_buffer);
 
     return kctx;
 }
@@ -454,16 +663,10 @@ int kui_destroy(struct kuictx *kctx)
         kctx->kui_map_set_list = NULL;
     }
 
-    if (kctx->buffer) {
-        if (std_list_destroy(kctx->buffer) == -1)
-            ret = -1;
-        kctx->buffer = NULL;
-    }
-
-    if (kctx->volatile_buffer) {
-        if (std_list_destroy(kctx->volatile_buffer) == -1)
+    if (kctx->ktree) {
+        if (kui_tree_destroy(kctx->ktree) == -1)
             ret = -1;
-        kctx->volatile_buffer = NULL;
+        kctx->ktree = NULL;
     }
 
     free(kctx);
@@ -480,11 +683,33 @@ std_list kui_get_map_sets(struct kuictx * kctx)
     return kctx->kui_map_set_list;
 }
 
+/**
+ * Throws away the compiled maps of a kui context, they're built again
+ * when they're next needed.
+ *
+ * \param kctx
+ * The kui context to operate on.
+ */
+static void kui_forget_maps(struct kuictx *kctx)
+{
+    if (kctx->ktree) {
+        kui_tree_destroy(kctx->ktree);
+        kctx->ktree = NULL;
+    }
+}
+
+static int kui_put_back_match(struct kuictx *kctx);
+
 int kui_clear_map_sets(struct kuictx *kctx)
 {
     if (!kctx)
         return -1;
 
+    if (kui_put_back_match(kctx) == -1)
+        return -1;
+
+    kui_forget_maps(kctx);
+
     return std_list_remove_all(kctx->kui_map_set_list);
 }
 
@@ -496,279 +721,125 @@ int kui_add_map_set(struct kuictx *kctx, struct kui_map_set *kui_ms)
     if (!kui_ms)
         return -1;
 
+    if (kui_put_back_match(kctx) == -1)
+        return -1;
+
     if (std_list_append(kctx->kui_map_set_list, kui_ms) == -1)
         return -1;
 
+    kui_forget_maps(kctx);
+
     return 0;
 }
 
 /**
- * This basically get's a char from the internal buffer within the kui context
- * or it get's a charachter from the standard input file descriptor.
+ * Compiles the maps of all the map sets in a kui context into one tree,
+ * unless that's already been done since they last changed.
  *
- * It only blocks for a limited amount of time, waiting for user input.
+ * If map sets have a map with the same key, the one in the last map set
+ * is used.
  *
  * \param kctx
  * The kui context to operate on.
  *
- * \param key
- * The key that was read
- *
  * @return
- * 1 on success,
- * 0 if no more input, 
- * or -1 on error.
+ * 0 on success, or -1 on error.
  */
-static int kui_findchar(struct kuictx *kctx, int *key)
+static int kui_compile_maps(struct kuictx *kctx)
 {
-    int length;
+    std_list_iterator set_iter, iter;
+    struct kui_map_set *map_set;
+    struct kui_map *map;
     void *data;
-    std_list_iterator iter;
 
-    if (!key)
-        return -1;
+    if (kctx->ktree && kctx->ktree_changes == kui_ms_changes)
+        return 0;
 
-    /* Use the buffer first. */
-    length = std_list_length(kctx->buffer);
+    kui_forget_maps(kctx);
 
-    if (length == -1)
+    kctx->ktree = kui_tree_create();
+    if (!kctx->ktree)
         return -1;
 
-    if (length > 0) {
-        /* Take the first char in the list */
-        iter = std_list_begin(kctx->buffer);
-
-        if (!iter)
-            return -1;
+    for (set_iter = std_list_begin(kctx->kui_map_set_list);
+            set_iter != std_list_end(kctx->kui_map_set_list);
+            set_iter = std_list_next(set_iter)) {
 
-        if (std_list_get_data(iter, &data) == -1)
+        if (std_list_get_data(set_iter, &data) == -1)
             return -1;
 
-        /* Get the char */
-        *key = *(int *) data;
-
-        /* Delete the item */
-        if (std_list_remove(kctx->buffer, iter) == NULL)
-            return -1;
-
-    } else {
-        /* Otherwise, look to read in a char,
-         * This function called returns the same conditions as this function*/
-        return kctx->callback(kctx->fd, kctx->ms, kctx->state_data, key);
-    }
-
-    return 1;
-}
-
-/**
- * Updates the state data for each map set in the kui
- *
- * \param data
- * The kui context to operate on.
- *
- * \param user_data
- * Not used 
- *
- * @return
- * 1 on success, 0 to stop, -1 on error
- */
-static int kui_reset_state_data(void *data, void *user_data)
-{
-    struct kui_map_set *map_set = (struct kui_map_set *) data;
-
-    if (kui_tree_reset_state(map_set->ktree) == -1)
-        return -1;
-
-    return 1;
-}
-
-/**
- * Updates each list in the kui context.
- *
- * \param data
- * The kui context to operate on.
- *
- * \param user_data
- * The key received.
- *
- * @return
- * 1 on success, 0 to stop, -1 on error
- */
-static int kui_update_each_list(struct kuictx *kctx, int key, int *map_found)
-{
-    std_list_iterator iter;
-    struct kui_map_set *map_set;
-    void *data;
-
-    if (!kctx)
-        return -1;
-
-    *map_found = 0;
-
-    /* Continue if at least 1 of the lists still says 
-     * KUI_MAP_STILL_LOOKING. If none of the lists is at this state, then
-     * there is no need to keep looking
-     */
-    for (iter = std_list_begin(kctx->kui_map_set_list);
-            iter != std_list_end(kctx->kui_map_set_list);
-            iter = std_list_next(iter)) {
+        map_set = (struct kui_map_set *) data;
 
-        if (std_list_get_data(iter, &data) == -1)
-            return -1;
+        for (iter = std_list_begin(map_set->maps);
+                iter != std_list_end(map_set->maps);
+                iter = std_list_next(iter)) {
 
-        map_set = (struct kui_map_set *) data;
+            if (std_list_get_data(iter, &data) == -1)
+                return -1;
 
-        if (kui_tree_push_key(map_set->ktree, key, map_found) == -1)
-            return -1;
+            map = (struct kui_map *) data;
 
-        if (*map_found) {
-            /* If a map was found, reset the extra char's read */
-            if (std_list_remove_all(kctx->volatile_buffer) == -1)
+            if (kui_tree_insert(kctx->ktree, map->literal_key, map) == -1)
                 return -1;
         }
     }
 
+    kctx->ktree_changes = kui_ms_changes;
+
     return 0;
 }
 
 /**
- * Checks to see if any of the map set's are matching a map.
- * If they are, then the kui context should keep trying to match. Otherwise
- * it should stop trying to match.
+ * Checks if a kui context leaves a map that's partly typed for the next
+ * call, instead of waiting for the rest of it. A context that's been asked
+ * to block for as long as it takes always waits.
  *
  * \param kctx
  * The kui context to operate on.
  *
- * \param should_continue
- * outbound as 1 if the kui context should keep looking, otherwise 0.
- *
  * @return
- * 0 on success, or -1 on error.
+ * 1 if it does, otherwise 0.
  */
-static int kui_should_continue_looking(struct kuictx *kctx,
-        int *should_continue)
+static int kui_deferring(struct kuictx *kctx)
 {
-    std_list_iterator iter;
-    struct kui_map_set *map_set;
-    void *data;
-    enum kui_tree_state map_state;
-
-    if (!kctx)
-        return -1;
-
-    if (!should_continue)
-        return -1;
-
-    *should_continue = 0;
-
-    /* Continue if at least 1 of the lists still says 
-     * KUI_MAP_STILL_LOOKING. If none of the lists is at this state, then
-     * there is no need to keep looking
-     */
-    for (iter = std_list_begin(kctx->kui_map_set_list);
-            iter != std_list_end(kctx->kui_map_set_list);
-            iter = std_list_next(iter)) {
-
-        if (std_list_get_data(iter, &data) == -1)
-            return -1;
-
-        map_set = (struct kui_map_set *) data;
-
-        if (kui_tree_get_state(map_set->ktree, &map_state) == -1)
-            return -1;
-
-        if (map_state == KUI_TREE_MATCHING)
-            *should_continue = 1;
-    }
-
-    return 0;
+    return kctx->defer && kctx->ms != -1;
 }
 
 /**
- * Update each map list's state.
- *
- * \param data
- * The kui context to operate on.
- *
- * \param user_data
- * Unused
+ * This basically get's a char from the internal buffer within the kui context
+ * or it get's a charachter from the standard input file descriptor.
  *
- * @return
- * 1 on success, 0 to stop, -1 on error
- */
-static int kui_finalize_state(void *data, void *user_data)
-{
-    struct kui_map_set *map_set = (struct kui_map_set *) data;
-
-    if (kui_tree_finalize_state(map_set->ktree) == -1)
-        return -1;
-
-    return 1;
-}
-
-/**
- * Checks to see if a kui map has been found.
+ * It only blocks for a limited amount of time, waiting for user input.
  *
  * \param kctx
  * The kui context to operate on.
  *
- * \param was_map_found
- * outbound as 1 if a map was found , otherwise 0.
- *
- * \param the_map_found
- * If was_map_found returns as 1, then this is the map that was found.
+ * \param key
+ * The key that was read
  *
  * @return
- * 0 on success, or -1 on error.
+ * 1 on success,
+ * 0 if no more input, 
+ * or -1 on error.
  */
-static int kui_was_map_found(struct kuictx *kctx,
-        int *was_map_found, struct kui_map **the_map_found)
+static int kui_findchar(struct kuictx *kctx, int *key)
 {
-    std_list_iterator iter;
-    struct kui_map_set *map_set;
-    void *data;
-    enum kui_tree_state map_state;
-
-    if (!was_map_found)
-        return -1;
-
-    if (!the_map_found)
+    if (!key)
         return -1;
 
-    *was_map_found = 0;
-
-    /* At this point, the loop exited for one of several reasons.
-     *
-     * Each list has a correct state value. If one of the lists has the value
-     * KUI_MAP_FOUND, then a map was found. This should be the value used.
-     *
-     * If none of the lists has the value kui_map_found, then no map was found.
-     * What a shame. Why did I write all of this code ?!?
-     */
-    for (iter = std_list_begin(kctx->kui_map_set_list);
-            iter != std_list_end(kctx->kui_map_set_list);
-            iter = std_list_next(iter)) {
-
-        if (std_list_get_data(iter, &data) == -1)
-            return -1;
-
-        map_set = (struct kui_map_set *) data;
-
-        if (kui_tree_get_state(map_set->ktree, &map_state) == -1)
+    /* Use the buffer first. */
+    if (kctx->buffer.count > 0) {
+        /* Take the first char in the buffer */
+        if (kui_keys_pop_front(&kctx->buffer, key) == -1)
             return -1;
-
-        if (map_state == KUI_TREE_FOUND) {
-            void *data;
-
-            if (kui_tree_get_data(map_set->ktree, &data) == -1)
-                return -1;
-
-            *was_map_found = 1;
-            *the_map_found = (struct kui_map *) data;
-        }
+    } else {
+        /* Otherwise, look to read in a char,
+         * This function called returns the same conditions as this function*/
+        return kctx->callback(kctx->fd, kui_deferring(kctx) ? 0 : kctx->ms,
+                kctx->state_data, key);
     }
 
-    return 0;
+    return 1;
 }
 
 static int intlen(const int *val)
@@ -828,44 +899,17 @@ static int kui_update_buffer(struct kuictx *kctx,
 {
 
     int i;
-    std_list_iterator iter;
 
+    /* The first char read is the key */
     if (!map_was_found) {
-        void *data;
-
-        iter = std_list_end(kctx->volatile_buffer);
-
-        iter = std_list_previous(iter);
-
-        if (!iter || iter == std_list_end(kctx->volatile_buffer))
-            return -1;
-
-        if (std_list_get_data(iter, &data) == -1)
-            return -1;
-
-        *key = *(int *) data;
-
-        if (std_list_remove(kctx->volatile_buffer, iter) == NULL)
+        if (kui_keys_pop_front(&kctx->volatile_buffer, key) == -1)
             return -1;
     }
 
-    /* Add the extra char's read */
-    for (iter = std_list_begin(kctx->volatile_buffer);
-            iter != std_list_end(kctx->volatile_buffer);
-            iter = std_list_next(iter)) {
-
-        int *val = malloc(sizeof (int));
-        void *data;
-
-        if (!val)
-            return -1;
-
-        if (std_list_get_data(iter, &data) == -1)
-            return -1;
-
-        *val = *(int *) data;
-
-        if (std_list_prepend(kctx->buffer, val) == -1)
+    /* Add the extra char's read, the last one first */
+    for (i = kctx->volatile_buffer.count - 1; i >= 0; --i) {
+        if (kui_keys_push_front(&kctx->buffer,
+                        kui_keys_get(&kctx->volatile_buffer, i)) == -1)
             return -1;
     }
 
@@ -877,14 +921,8 @@ static int kui_update_buffer(struct kuictx *kctx,
         length = intlen(the_map_found->literal_value);
 
         for (i = length - 1; i >= 0; --i) {
-            int *val = malloc(sizeof (int));
-
-            if (!val)
-                return -1;
-
-            *val = the_map_found->literal_value[i];
-
-            if (std_list_prepend(kctx->buffer, val) == -1)
+            if (kui_keys_push_front(&kctx->buffer,
+                            the_map_found->literal_value[i]) == -1)
                 return -1;
         }
     }
@@ -892,6 +930,8 @@ static int kui_update_buffer(struct kuictx *kctx,
     return 0;
 }
 
+static int kui_end_match(struct kuictx *kctx, int *was_map_found);
+
 /**
  * Get's the next char.
  *
@@ -902,15 +942,14 @@ static int kui_update_buffer(struct kuictx *kctx,
  *
  * @return
  * -1 on error
+ * -2 if deferring and no key is ready yet
  * The key on success ( valid if map_found == 0 )
  */
 static int kui_findkey(struct kuictx *kctx, int *was_map_found)
 {
 
     int key, retval;
-    int should_continue;
-    struct kui_map *the_map_found = NULL;
-    int *val;
+    enum kui_tree_state map_state;
     int map_found;
 
     /* Validate parameters */
@@ -926,15 +965,18 @@ static int kui_findkey(struct kuictx *kctx, int *was_map_found)
     /* Initialize variables on stack */
     key = -1;
     *was_map_found = 0;
-    should_continue = 0;
 
-    if (std_list_remove_all(kctx->volatile_buffer) == -1)
-        return -1;
+    /* A map the last call left partly typed is carried on with */
+    if (!kctx->matching) {
+        kui_keys_clear(&kctx->volatile_buffer);
 
-    /* Reset the state data for all of the lists */
-    if (std_list_foreach(kctx->kui_map_set_list, kui_reset_state_data,
-                    NULL) == -1)
-        return -1;
+        /* All of the maps are matched at once */
+        if (kui_compile_maps(kctx) == -1)
+            return -1;
+
+        if (kui_tree_reset_state(kctx->ktree) == -1)
+            return -1;
+    }
 
     /* Start the main loop */
     while (1) {
@@ -942,51 +984,88 @@ static int kui_findkey(struct kuictx *kctx, int *was_map_found)
         if (retval == -1)
             return -1;
 
-        /* If there is no more data ready, stop. */
-        if (retval == 0)
+        /* If there is no more data ready, stop. When deferring, the keys
+         * read so far wait for the next call, until they've expired. */
+        if (retval == 0) {
+            if (kui_deferring(kctx) && (!kctx->matching || !kctx->expired))
+                return -2;
             break;
+        }
 
-        /* Append to the list */
-        val = malloc(sizeof (int));
-        if (!val)
-            return -1;
-        *val = key;
-        if (std_list_prepend(kctx->volatile_buffer, val) == -1)
+        kctx->matching = 1;
+        kctx->expired = 0;
+
+        /* Append to the buffer */
+        if (kui_keys_push_back(&kctx->volatile_buffer, key) == -1)
             return -1;
 
-        /* Update each list, with the character read, and the position. */
-        if (kui_update_each_list(kctx, key, &map_found) == -1)
+        /* Follow the character read in the tree */
+        if (kui_tree_push_key(kctx->ktree, key, &map_found) == -1)
             return -1;
 
-        /* Check to see if at least a single map is being matched */
-        if (kui_should_continue_looking(kctx, &should_continue) == -1)
+        /* If a map was found, reset the extra char's read */
+        if (map_found)
+            kui_keys_clear(&kctx->volatile_buffer);
+
+        /* Stop once no map is being matched */
+        if (kui_tree_get_state(kctx->ktree, &map_state) == -1)
             return -1;
 
-        if (!should_continue)
+        if (map_state != KUI_TREE_MATCHING)
             break;
     }
 
-    key = 0;                    /* This should no longer be used. Enforcing that. */
+    return kui_end_match(kctx, was_map_found);
+}
 
-    /* All done looking for chars, let lists that matched a mapping
-     * be known. ex KUI_MAP_STILL_LOOKING => KUI_MAP_FOUND. This 
+/**
+ * Finishes matching the keys read, with what's been read so far.
+ *
+ * \param kctx
+ * The kui context to operate on.
+ *
+ * \param was_map_found
+ * Returns as 1 if a mapping was found, otherwise 0, as for kui_findkey.
+ *
+ * @return
+ * -1 on error
+ * The key on success ( valid if was_map_found == 0 )
+ */
+static int kui_end_match(struct kuictx *kctx, int *was_map_found)
+{
+    struct kui_map *the_map_found = NULL;
+    enum kui_tree_state map_state;
+    int key = 0;                /* Only set if no map was found */
+
+    kctx->matching = 0;
+    kctx->expired = 0;
+    *was_map_found = 0;
+
+    /* All done looking for chars, let the tree know that it matched a
+     * mapping. ex KUI_MAP_STILL_LOOKING => KUI_MAP_FOUND. This 
      * happens when 
      *    map abc   xyz
      *    map abcde xyz
      *
-     * If the user types abcd, the list will still be looking,
+     * If the user types abcd, the tree will still be looking,
      * even though it already found a mapping.
      */
-    if (std_list_foreach(kctx->kui_map_set_list, kui_finalize_state,
-                    NULL) == -1)
+    if (kui_tree_finalize_state(kctx->ktree) == -1)
         return -1;
 
     /* Check to see if a map was found.
      * If it was, get the map also.
      */
-    if (kui_was_map_found(kctx, was_map_found, &the_map_found) == -1)
+    if (kui_tree_get_state(kctx->ktree, &map_state) == -1)
         return -1;
 
+    if (map_state == KUI_TREE_FOUND) {
+        if (kui_tree_get_data(kctx->ktree, &the_map_found) == -1)
+            return -1;
+
+        *was_map_found = 1;
+    }
+
     /* Update the buffer and get the final char. */
     if (kui_update_buffer(kctx, the_map_found, *was_map_found, &key) == -1)
         return -1;
@@ -994,6 +1073,34 @@ static int kui_findkey(struct kuictx *kctx, int *was_map_found)
     return key;
 }
 
+/**
+ * Finishes matching a map that's partly typed, before the maps change. The
+ * keys read for it are put back in the buffer, as the map's value if they
+ * matched one.
+ *
+ * \param kctx
+ * The kui context to operate on.
+ *
+ * @return
+ * 0 on success, or -1 on error.
+ */
+static int kui_put_back_match(struct kuictx *kctx)
+{
+    int map_found, key;
+
+    if (!kctx->matching)
+        return 0;
+
+    key = kui_end_match(kctx, &map_found);
+    if (key == -1)
+        return -1;
+
+    if (!map_found && kui_keys_push_front(&kctx->buffer, key) == -1)
+        return -1;
+
+    return 0;
+}
+
 int kui_getkey(struct kuictx *kctx)
 {
     int map_found;
@@ -1013,15 +1120,12 @@ int kui_getkey(struct kuictx *kctx)
 
 int kui_cangetkey(struct kuictx *kctx)
 {
-    int length;
-
     /* Use the buffer first. */
-    length = std_list_length(kctx->buffer);
-
-    if (length == -1)
-        return -1;
+    if (kctx->buffer.count > 0)
+        return 1;
 
-    if (length > 0)
+    /* The keys of a map that's waited long enough are ready as they are */
+    if (kctx->matching && kctx->expired)
         return 1;
 
     return 0;
@@ -1061,6 +1165,8 @@ struct kui_manager {
     /* Need a reference to the terminal escape sequence mappings when destroying
      * this context. (a list is populated in the create function)  */
     struct kui_map_set *terminal_key_set;
+    /* 1 while the terminal is sending a bracketed paste, otherwise 0 */
+    int pasting;
 };
 
 static int create_terminal_mappings(struct kui_manager *kuim, struct kuictx *i)
@@ -1081,11 +1187,42 @@ static int create_terminal_mappings(struct kui_manager *kuim, struct kuictx *i)
     return 0;
 }
 
+/**
+ * Reads the terminal's input. Everything the terminal has sent is read at
+ * once, so a paste isn't read a char at a time. The first char is returned
+ * and the rest are put in the buffer, to be read next.
+ *
+ * \param obj
+ * The terminal kui context.
+ */
 int char_callback(const int fd,
         const unsigned int ms, const void *obj, int *key)
 {
+    struct kuictx *kctx = (struct kuictx *) obj;
+    char buf[KUI_KEYS_SIZE / 2];
+    int size, count, i;
+
+    if (!key)
+        return -1;
+
+    /* Leave room in the buffer for the keys put back while looking for
+     * a map. */
+    size = KUI_KEYS_SIZE / 2 - kctx->buffer.count;
+    if (size < 1)
+        size = 1;
+
+    count = io_getchars(fd, ms, buf, size);
+    if (count <= 0)
+        return count;
+
+    *key = buf[0];
+
+    for (i = 1; i < count; ++i) {
+        if (kui_keys_push_back(&kctx->buffer, buf[i]) == -1)
+            return -1;
+    }
 
-    return io_getchar(fd, ms, key);
+    return 1;
 }
 
 int kui_callback(const int fd, const unsigned int ms, const void *obj, int *key)
@@ -1101,28 +1238,24 @@ int kui_callback(const int fd, const unsigned int ms, const void *obj, int *key)
     if (result == -1)
         return -1;
 
-    if (result == 1) {
-        *key = kui_getkey(kctx);
-        if (*key == -1)
-            return -1;
-    }
-
     /* If there is no data ready, check the I/O */
     if (result == 0) {
         result = io_data_ready(kctx->fd, ms);
         if (result == -1)
             return -1;
 
-        if (result == 1) {
-            *key = kui_getkey(kctx);
-            if (*key == -1)
-                return -1;
-        }
-
         if (result == 0)
             return 0;
     }
 
+    *key = kui_getkey(kctx);
+    if (*key == -1)
+        return -1;
+
+    /* A terminal escape sequence that's partly typed isn't a key yet */
+    if (*key == -2)
+        return 0;
+
     return 1;
 }
 
@@ -1137,6 +1270,7 @@ struct kui_manager *kui_manager_create(int stdinfd,
         return NULL;
 
     man->normal_keys = NULL;
+    man->pasting = 0;
     man->terminal_keys =
             kui_create(stdinfd, char_callback, keycode_timeout, NULL);
 
@@ -1145,6 +1279,9 @@ struct kui_manager *kui_manager_create(int stdinfd,
         return NULL;
     }
 
+    /* The callback puts what it reads ahead in the terminal buffer */
+    man->terminal_keys->state_data = man->terminal_keys;
+
     if (create_terminal_mappings(man, man->terminal_keys) == -1) {
         kui_manager_destroy(man);
         return NULL;
@@ -1229,11 +1366,27 @@ int kui_manager_cangetkey(struct kui_manager *kuim)
 
 int kui_manager_getkey(struct kui_manager *kuim)
 {
+    int key;
+
     if (!kuim)
         return -1;
 
-    return kui_getkey(kuim->normal_keys);
+    /* A paste skips the user defined mappings. Any keys already put back
+     * in the normal buffer came first. */
+    if (kuim->pasting && kuim->normal_keys->buffer.count > 0) {
+        if (kui_keys_pop_front(&kuim->normal_keys->buffer, &key) == -1)
+            return -1;
+    } else if (kuim->pasting)
+        key = kui_getkey(kuim->terminal_keys);
+    else
+        key = kui_getkey(kuim->normal_keys);
+
+    if (key == CGDB_KEY_PASTE_START)
+        kuim->pasting = 1;
+    else if (key == CGDB_KEY_PASTE_END)
+        kuim->pasting = 0;
 
+    return key;
 }
 
 int kui_manager_getkey_blocking(struct kui_manager *kuim)
@@ -1252,7 +1405,7 @@ int kui_manager_getkey_blocking(struct kui_manager *kuim)
     kui_set_blocking_ms(kuim->normal_keys, -1);
 
     /* Get the key */
-    val = kui_getkey(kuim->normal_keys);
+    val = kui_manager_getkey(kuim);
 
     /* Restore the values */
     kui_set_blocking_ms(kuim->terminal_keys, terminal_keys_msec);
@@ -1261,6 +1414,45 @@ int kui_manager_getkey_blocking(struct kui_manager *kuim)
     return val;
 }
 
+int kui_manager_defer_timeouts(struct kui_manager *kuim, int defer)
+{
+    if (!kuim)
+        return -1;
+
+    kuim->terminal_keys->defer = defer;
+    kuim->normal_keys->defer = defer;
+
+    return 0;
+}
+
+int kui_manager_get_timeout(struct kui_manager *kuim)
+{
+    if (!kuim)
+        return -1;
+
+    /* A terminal escape sequence is finished before the map it's in */
+    if (kuim->terminal_keys->matching)
+        return kuim->terminal_keys->ms;
+
+    if (kuim->normal_keys->matching)
+        return kuim->normal_keys->ms;
+
+    return -1;
+}
+
+int kui_manager_expire_timeout(struct kui_manager *kuim)
+{
+    if (!kuim)
+        return -1;
+
+    if (kuim->terminal_keys->matching)
+        kuim->terminal_keys->expired = 1;
+    else if (kuim->normal_keys->matching)
+        kuim->normal_keys->expired = 1;
+
+    return 0;
+}
+
 int kui_manager_set_terminal_escape_sequence_timeout(struct kui_manager *kuim,
         unsigned int msec)
 {
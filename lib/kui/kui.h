@@ -191,6 +191,30 @@ int kui_ms_destroy(struct kui_map_set *kui_ms);
 int kui_ms_register_map(struct kui_map_set *kui_ms,
         const char *key, const char *value);
 
+/**
+ * Add many maps to the map set at once. This is what kui_ms_register_map
+ * does for each of them in order, but the maps are sorted together and
+ * merged into the set in one pass, instead of each one being inserted.
+ * A map that can't be made is left out, and the others are still added.
+ *
+ * \param kui_ms
+ * The kui map set to add to.
+ *
+ * \param keys
+ * The keys. Should be null terminated.
+ *
+ * \param values
+ * The value of each key. Should be null terminated.
+ *
+ * \param count
+ * The number of keys.
+ *
+ * @return
+ * 0 on success, or -1 if any of the maps couldn't be added
+ */
+int kui_ms_register_maps(struct kui_map_set *kui_ms,
+        const char *const *keys, const char *const *values, int count);
+
 /**
  * Remove a map from the map set.
  *
@@ -370,7 +394,8 @@ int kui_cangetkey(struct kuictx *kctx);
  * The kui context.
  *
  * @return
- * -1 on error, otherwise, a valid key.
+ * -1 on error, -2 if the context defers its timeout and no key is ready
+ * yet, otherwise, a valid key.
  *  A key can either be a normal ascii key, or a CGDB_KEY_* value.
  */
 
@@ -533,7 +558,8 @@ int kui_manager_cangetkey(struct kui_manager *kuim);
  * The kui context.
  *
  * @return
- * -1 on error, otherwise, a valid key.
+ * -1 on error, -2 if the timeouts are deferred and no key is ready yet,
+ * otherwise, a valid key.
  *  A key can either be a normal ascii key, or a CGDB_KEY_* value.
  */
 int kui_manager_getkey(struct kui_manager *kuim);
@@ -551,6 +577,52 @@ int kui_manager_getkey(struct kui_manager *kuim);
  */
 int kui_manager_getkey_blocking(struct kui_manager *kuim);
 
+/**
+ * Tell's the kui not to wait for the rest of a map, or a terminal escape
+ * sequence, that's only partly typed. Instead, kui_manager_getkey returns
+ * -2 and keeps the keys read, carrying on with them the next time it's
+ * called. The caller waits for kui_manager_get_timeout milliseconds, and
+ * then calls kui_manager_expire_timeout, unless more input came first.
+ *
+ * kui_manager_getkey_blocking still waits.
+ *
+ * \param kuim
+ * The kui context.
+ *
+ * \param defer
+ * 1 to leave the wait to the caller, 0 to wait in kui_manager_getkey.
+ *
+ * \return
+ * 0 on success, or -1 on error.
+ */
+int kui_manager_defer_timeouts(struct kui_manager *kuim, int defer);
+
+/**
+ * Get's how long the keys of a map that's partly typed wait for the rest
+ * of it, when the timeouts are deferred.
+ *
+ * \param kuim
+ * The kui context.
+ *
+ * \return
+ * The milliseconds to wait, or -1 if no map is partly typed.
+ */
+int kui_manager_get_timeout(struct kui_manager *kuim);
+
+/**
+ * Tell's the kui that the keys of a map that's partly typed have waited
+ * kui_manager_get_timeout milliseconds. It makes kui_manager_cangetkey
+ * return 1, and kui_manager_getkey returns the keys as they were typed, or
+ * the value of the shorter map they finished.
+ *
+ * \param kuim
+ * The kui context.
+ *
+ * \return
+ * 0 on success, or -1 on error.
+ */
+int kui_manager_expire_timeout(struct kui_manager *kuim);
+
 /**
  * Set's the terminal escape sequence time out value.
  * This is used to tell CGDB how long to block when looking to match terminal
@@ -105,6 +105,10 @@ enum cgdb_key {
     CGDB_KEY_CTRL_Y,
     CGDB_KEY_CTRL_Z,
 
+    /* The start and end of a bracketed paste */
+    CGDB_KEY_PASTE_START,
+    CGDB_KEY_PASTE_END,
+
     CGDB_KEY_ERROR
 };
 
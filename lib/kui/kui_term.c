@@ -24,6 +24,10 @@
 #include <stdio.h>              /* for stderr */
 #endif /* HAVE_STDIO_H */
 
+#if HAVE_CTYPE_H
+#include <ctype.h>
+#endif /* HAVE_CTYPE_H */
+
 /* term.h prototypes */
 extern int tgetent();
 extern int tgetflag();
@@ -33,6 +37,7 @@ extern int tputs();
 extern char *tgoto();
 
 #include "kui_term.h"
+#include "sys_util.h"
 
 #define MAXLINE 4096
 #define MAX_SEQ_LIST_SIZE 8
@@ -144,7 +149,11 @@ struct keydata {
     CGDB_KEY_CTRL_W, "\027"}, {
     CGDB_KEY_CTRL_X, "\030"}, {
     CGDB_KEY_CTRL_Y, "\031"}, {
-    CGDB_KEY_CTRL_Z, "\032"}, {
+    CGDB_KEY_CTRL_Z, "\032"},
+            /* Bracketed paste */
+    {
+    CGDB_KEY_PASTE_START, "\033[200~"}, {
+    CGDB_KEY_PASTE_END, "\033[201~"}, {
     CGDB_KEY_ERROR, NULL}
 };
 
@@ -242,6 +251,8 @@ struct cgdb_keycode_data {
     CGDB_KEY_CTRL_X, "<C-x>", "CGDB_KEY_CTRL_X"}, {
     CGDB_KEY_CTRL_Y, "<C-y>", "CGDB_KEY_CTRL_Y"}, {
     CGDB_KEY_CTRL_Z, "<C-z>", "CGDB_KEY_CTRL_Z"}, {
+    CGDB_KEY_PASTE_START, "<PasteStart>", "CGDB_KEY_PASTE_START"}, {
+    CGDB_KEY_PASTE_END, "<PasteEnd>", "CGDB_KEY_PASTE_END"}, {
     0, "<Nul>", "<Zero>"}, {
     CGDB_KEY_CTRL_H, "<BS>", "<Backspace>"}, {
     CGDB_KEY_CTRL_I, "<Tab>", "<Tab>"}, {
@@ -258,66 +269,51 @@ struct cgdb_keycode_data {
     CGDB_KEY_ERROR, "CGDB_KEY_ERROR", "CGDB_KEY_ERROR"}
 };
 
-/** 
- * This adds key bindings that many terminals use. 
- *
- * @return
- * 0 on success, or -1 on error
- */
-static int add_keybindings(struct kui_map_set *map)
-{
-    int i, val;
-    const char *keycode;
+/* The key sequences the terminal's mappings are made of, they point into
+ * the terminal's entry */
+struct keyseqs {
+    const char **seqs;
+    enum cgdb_key *keys;
+    int count;
+    int size;
+};
 
-    for (i = 0; hard_coded_bindings[i].key != CGDB_KEY_ERROR; ++i) {
-        keycode =
-                kui_term_get_keycode_from_cgdb_key(hard_coded_bindings[i].key);
-        val = kui_ms_register_map(map, hard_coded_bindings[i].key_seq, keycode);
-        if (val == -1)
-            return -1;
+/* Adds a key sequence, after the ones it should win over */
+static void keyseqs_add(struct keyseqs *list, enum cgdb_key key,
+        const char *seq)
+{
+    if (list->count == list->size) {
+        list->size = list->size ? list->size * 2 : 64;
+        list->seqs = (const char **) cgdb_realloc(list->seqs,
+                sizeof (char *) * list->size);
+        list->keys = (enum cgdb_key *) cgdb_realloc(list->keys,
+                sizeof (enum cgdb_key) * list->size);
     }
 
-    return 0;
+    list->seqs[list->count] = seq;
+    list->keys[list->count] = key;
+    list->count++;
 }
 
-/* Gets a single key sequence */
-static int import_keyseq(struct tlist *list, struct kui_map_set *map)
+static void keyseqs_free(struct keyseqs *list)
 {
-    int ret;
-    static char *term_buffer = (char *) NULL;
-    static char *buffer = (char *) NULL;
-    char *env;
-
-    if (term_buffer == 0) {
-        term_buffer = (char *) malloc(4080);
-        buffer = (char *) malloc(4080);
-    }
-
-    env = getenv("TERM");
-
-    if (!env)
-        return -1;
-
-    ret = tgetent(term_buffer, env);
-    if (ret == 0)
-        return -1;
-    else if (ret == -1)
-        return -1;
+    free(list->seqs);
+    free(list->keys);
+}
 
+/* Gets a single key sequence, once the terminal's entry has been loaded.
+ * The termcap strings are copied into buffer. */
+static void import_keyseq(struct tlist *list, struct keyseqs *seqs,
+        char **buffer)
+{
     /* Set up the termcap seq */
-    list->tname_seq = tgetstr(list->tname, &buffer);
+    list->tname_seq = tgetstr(list->tname, buffer);
     if (list->tname_seq == 0) {
         /*fprintf ( stderr, "CAPNAME (%s) is not present in this TERM's termcap description\n", i->tname); */
     } else if (list->tname_seq == (char *) -1) {
         /* fprintf ( stderr, "CAPNAME (%s) is not a termcap string capability\n", i->tname); */
-    } else {
-        const char *keycode;
-
-        keycode = kui_term_get_keycode_from_cgdb_key(list->key);
-        ret = kui_ms_register_map(map, list->tname_seq, keycode);
-        if (ret == -1)
-            return -1;
-    }
+    } else
+        keyseqs_add(seqs, list->key, list->tname_seq);
 
     /* Set up the terminfo seq */
     list->tiname_seq = tigetstr(list->tiname);
@@ -325,49 +321,67 @@ static int import_keyseq(struct tlist *list, struct kui_map_set *map)
         /* fprintf ( stderr, "CAPNAME (%s) is not present in this TERM's terminfo description\n", i->tiname); */
     } else if (list->tiname_seq == (char *) -1) {
         /* fprintf ( stderr, "CAPNAME (%s) is not a terminfo string capability\n", i->tiname); */
-    } else {
-        const char *keycode;
-
-        keycode = kui_term_get_keycode_from_cgdb_key(list->key);
-        ret = kui_ms_register_map(map, list->tiname_seq, keycode);
-        if (ret == -1)
-            return -1;
-    }
-
-    return 0;
+    } else
+        keyseqs_add(seqs, list->key, list->tiname_seq);
 }
 
 /**
  * Read's in all of the termcap and terminfo key sequences.
- *
- * @return
- * 0 on success, or -1 on error
  */
-static int import_keyseqs(struct kui_map_set *map)
+static void import_keyseqs(const char *term, struct keyseqs *seqs)
 {
+    static char *term_buffer = (char *) NULL;
+    static char *buffer = (char *) NULL;
     int i;
 
-    for (i = 0; seqlist[i].tname != NULL; i++)
-        import_keyseq(&seqlist[i], map);
+    if (term_buffer == 0) {
+        term_buffer = (char *) malloc(4080);
+        buffer = (char *) malloc(4080);
+    }
 
-    return 0;
+    /* Without an entry for the terminal, only the hard coded bindings
+     * are used. The entry is loaded once for all of the keys. */
+    if (tgetent(term_buffer, term) != 1)
+        return;
+
+    for (i = 0; seqlist[i].tname != NULL; i++)
+        import_keyseq(&seqlist[i], seqs, &buffer);
 }
 
 struct kui_map_set *kui_term_get_terminal_mappings(void)
 {
     struct kui_map_set *map;
+    struct keyseqs seqs;
+    const char **values;
+    char *term = getenv("TERM");
+    int i, ret;
 
     map = kui_ms_create();
 
-    if (import_keyseqs(map) == -1)
-        return NULL;
-
     if (!map)
         return NULL;
 
-    /* Add all the extra's */
-    if (add_keybindings(map) == -1) {
-        /* TODO: Free map and return */
+    memset(&seqs, 0, sizeof (seqs));
+
+    if (term)
+        import_keyseqs(term, &seqs);
+
+    /* Add all the extra's, many terminals use them */
+    for (i = 0; hard_coded_bindings[i].key != CGDB_KEY_ERROR; ++i)
+        keyseqs_add(&seqs, hard_coded_bindings[i].key,
+                hard_coded_bindings[i].key_seq);
+
+    values = (const char **) cgdb_malloc(sizeof (char *) * (seqs.count + 1));
+    for (i = 0; i < seqs.count; i++)
+        values[i] = kui_term_get_keycode_from_cgdb_key(seqs.keys[i]);
+
+    ret = kui_ms_register_maps(map, seqs.seqs, values, seqs.count);
+
+    free(values);
+    keyseqs_free(&seqs);
+
+    if (ret == -1) {
+        kui_ms_destroy(map);
         return NULL;
     }
 
@@ -376,12 +390,20 @@ struct kui_map_set *kui_term_get_terminal_mappings(void)
 
 int kui_term_get_cgdb_key_from_keycode(const char *keycode)
 {
-    int i;
+    int i, second;
+
+    if (!keycode[0])
+        return CGDB_KEY_ERROR;
+
+    /* The keycodes all start with '<', the char after it rules most of
+     * them out without comparing the rest */
+    second = tolower((unsigned char) keycode[1]);
 
     for (i = 0; cgdb_keycodes[i].key != CGDB_KEY_ERROR; ++i) {
         struct cgdb_keycode_data *ckey = &cgdb_keycodes[i];
 
-        if (strcasecmp(keycode, ckey->keycode) == 0)
+        if (tolower((unsigned char) ckey->keycode[1]) == second &&
+                strcasecmp(keycode, ckey->keycode) == 0)
             return ckey->key;
     }
 
@@ -7,6 +7,12 @@
  * This documentation is intended to be a brief description behind how kui_tree
  * works internally.
  *
+ * The nodes of the tree are kept in an array, the root is node 0. The edges
+ * from a node to its children are all kept in one hash table, keyed on the
+ * node and the key. Following a key from the current node is a single
+ * lookup, however many children the node has.
+ *
+ * The tree only grows. When maps are removed, the tree is built again.
  */
 
 /* }}}*/
@@ -19,12 +25,7 @@
  */
 struct kui_tree_node {
     /**
-	 * The key this node represents.
-	 */
-    int key;
-
-    /**
-	 * If non-null, this node represents a macro and the data is 
+	 * If non-null, this node represents a macro and the data is
 	 * the value of the macro.
 	 *
 	 * Otherwise, this node is not the end of a macro.
@@ -32,328 +33,251 @@ struct kui_tree_node {
     void *macro_value;
 
     /**
-	 * A doubly linked list of all the children.
-	 * The list is sorted by the key so that a faster lookup can happen.
-	 *
-	 * If this is a bottleneck, it can be changed into a hash, or something
-	 * more efficient.
+	 * The number of children of the node.
 	 */
-    std_list children;
+    int children;
 };
 
 /**
- * Destroys a kui tree node.
- *
- * \param ktnode
- * The tree node to destroy
- *
- * @return
- * 0 on success, or -1 on error.
+ * An edge from a node to one of its children, in the hash table.
  */
-int kui_tree_node_destroy(struct kui_tree_node *ktnode)
-{
-    int retval = 0;
-
-    if (!ktnode)
-        return -1;
-
-    if (ktnode->children) {
-        if (std_list_destroy(ktnode->children) == -1)
-            retval = -1;
-        ktnode->children = NULL;
-    }
+struct kui_tree_edge {
+    /**
+	 * The node the edge leaves.
+	 */
+    int from;
 
-    free(ktnode);
-    ktnode = NULL;
+    /**
+	 * The key that leads to the child.
+	 */
+    int key;
 
-    return retval;
-}
+    /**
+	 * The child, or 0 if the slot in the hash table is empty. The root is
+	 * never a child.
+	 */
+    int to;
+};
 
-static int destroy_kui_tree_node_callback(void *data)
-{
-    struct kui_tree_node *ktnode = (struct kui_tree_node *) data;
+/* }}} */
 
-    if (!ktnode)
-        return -1;
+/* struct kui_tree {{{ */
 
-    return kui_tree_node_destroy(ktnode);
-}
+/**
+ * This data structure is capable of storing a set of maps internally in such a
+ * way that it is easy to see what maps are active if a char at a time is fed
+ * to this structure.
+ *
+ * Also, it can determine what mapping was reached if one was found.
+ */
+struct kui_tree {
+    /* The nodes, the root is the first */
+    struct kui_tree_node *nodes;
+    int node_count;
+    int node_size;
+    /* The edges, hashed on the node and key. edge_size is a power of 2. */
+    struct kui_tree_edge *edges;
+    int edge_count;
+    int edge_size;
+    /* The current position pointing into the tree ( while looking for a map ) */
+    int cur;
+    /* The last node found while looking for a map. */
+    /* This happens because maps can be subsets of other maps. */
+    int found_node;
+    /* The internal state of the tree ( still looking, map found, not found ) */
+    enum kui_tree_state state;
+    /* If a map was found at all, this is set to 1 while looking, otherwise 0. */
+    int found;
+};
 
 /**
- * Creates a new kui tree node.
+ * Hashes an edge.
+ *
+ * \param ktree
+ * The tree the edge is in.
+ *
+ * \param from
+ * The node the edge leaves.
+ *
+ * \param key
+ * The key of the edge.
  *
  * @return
- * A new instance on success, or NULL on error. 
+ * The slot in the hash table to start looking for the edge at.
  */
-struct kui_tree_node *kui_tree_node_create(void)
+static int kui_tree_hash(struct kui_tree *ktree, int from, int key)
 {
-    struct kui_tree_node *ktnode;
+    unsigned int hash = (unsigned int) from * 2654435761u;
 
-    ktnode = (struct kui_tree_node *) malloc(sizeof (struct kui_tree_node));
-
-    if (!ktnode)
-        return NULL;
+    hash ^= (unsigned int) key * 40503u;
 
-    ktnode->key = 0;
-    ktnode->macro_value = NULL;
-
-    /* Allocate children */
-    ktnode->children = std_list_create(destroy_kui_tree_node_callback);
-
-    if (!ktnode->children) {
-        kui_tree_node_destroy(ktnode);
-        return NULL;
-    }
-
-    return ktnode;
+    return (int) ((hash ^ (hash >> 15)) & (ktree->edge_size - 1));
 }
 
 /**
- * Finds a pointer to the child node.
+ * Finds a child of a node.
  *
- * \param key
- * The key to look for.
- *
- * \param children
- * The children to look in
+ * \param ktree
+ * The tree to look in.
  *
- * \param found 
- * If the key was found, this will return as true, otherwise false.
+ * \param from
+ * The node whose child to look for.
  *
- * \param ktnode
- * If found, this will be the node that contains the item.
+ * \param key
+ * The key to look for.
  *
- * \return
- * 0 on success, or -1 on error.
+ * @return
+ * The slot in the hash table the edge is in, or the empty slot it would go
+ * in if the node has no child for the key.
  */
-static int kui_tree_find(int key,
-        std_list children, int *found, struct kui_tree_node **ktnode)
+static int kui_tree_find(struct kui_tree *ktree, int from, int key)
 {
-    struct kui_tree_node *node;
-    std_list_iterator iter;
-
-    *found = 0;
-    *ktnode = NULL;
-
-    /* Look for the key in the children */
-    for (iter = std_list_begin(children);
-            iter != std_list_end(children); iter = std_list_next(iter)) {
-        void *data;
-
-        if (std_list_get_data(iter, &data) == -1)
-            return -1;
-
-        node = (struct kui_tree_node *) data;
-
-        if (node->key == key) {
-            *found = 1;
-            *ktnode = node;
-            break;
-        } else if (node->key > key)
-            break;
-    }
-
-    return 0;
-}
+    int i = kui_tree_hash(ktree, from, key);
 
-static int kui_tree_node_compare_callback(const void *a, const void *b)
-{
-    struct kui_tree_node *one = (struct kui_tree_node *) a;
-    struct kui_tree_node *two = (struct kui_tree_node *) b;
+    while (ktree->edges[i].to != 0 &&
+            (ktree->edges[i].from != from || ktree->edges[i].key != key))
+        i = (i + 1) & (ktree->edge_size - 1);
 
-    if (one->key == two->key)
-        return 0;
-    else if (one->key < two->key)
-        return -1;
-    else
-        return 1;
+    return i;
 }
 
-static int kui_tree_node_key_compare_callback(const void *a, const void *b)
+/**
+ * Doubles the size of the hash table of edges.
+ *
+ * \param ktree
+ * The tree whose hash table is full.
+ *
+ * @return
+ * 0 on success, or -1 on error.
+ */
+static int kui_tree_grow_edges(struct kui_tree *ktree)
 {
-    struct kui_tree_node *one = (struct kui_tree_node *) a;
-    int two = *(int *) b;
+    struct kui_tree_edge *edges = ktree->edges;
+    int size = ktree->edge_size, i, j;
 
-    if (one->key == two)
-        return 0;
-    else if (one->key < two)
-        return -1;
-    else
-        return 1;
-}
+    ktree->edge_size *= 2;
+    ktree->edges = (struct kui_tree_edge *) calloc(ktree->edge_size,
+            sizeof (struct kui_tree_edge));
 
-static int kui_tree_node_insert(struct kui_tree_node *ktnode,
-        int *klist, void *data)
-{
-    struct kui_tree_node *node;
-    int found;
-
-    if (!ktnode)
+    if (!ktree->edges) {
+        ktree->edges = edges;
+        ktree->edge_size = size;
         return -1;
-
-    if (klist[0] == 0) {
-        ktnode->macro_value = data;
-        return 0;
     }
 
-    if (kui_tree_find(klist[0], ktnode->children, &found, &node) == -1)
-        return -1;
-
-    /* If the node was found, use it, otherwise create a new one */
-    if (!found) {
-        node = kui_tree_node_create();
-
-        if (!node)
-            return -1;
-
-        node->key = klist[0];
-
-        if (std_list_insert_sorted(ktnode->children, node,
-                        kui_tree_node_compare_callback) == -1)
-            return -1;
+    for (i = 0; i < size; ++i) {
+        if (edges[i].to != 0) {
+            j = kui_tree_find(ktree, edges[i].from, edges[i].key);
+            ktree->edges[j] = edges[i];
+        }
     }
 
-    return kui_tree_node_insert(node, &klist[1], data);
+    free(edges);
+
+    return 0;
 }
 
-static int kui_tree_node_delete(struct kui_tree_node *ktnode,
-        struct kui_tree_node **from, int *klist)
+/**
+ * Adds a node to the tree.
+ *
+ * \param ktree
+ * The tree to add the node to.
+ *
+ * @return
+ * The new node on success, or -1 on error.
+ */
+static int kui_tree_add_node(struct kui_tree *ktree)
 {
+    struct kui_tree_node *nodes;
 
-    struct kui_tree_node *node;
-    int found;
-
-    if (!ktnode)
-        return -1;
-
-    /* base case */
-    if (klist[0] == 0)
-        return 0;
-
-    if (kui_tree_find(klist[0], ktnode->children, &found, &node) == -1)
-        return -1;
-
-    if (!found)                 /* The key must be found */
-        return -1;
-
-    if (kui_tree_node_delete(node, from, &klist[1]) == -1)
-        return -1;
-
-    /* No need to mess with the bottom node on the way out */
-    if (klist[1] == 0) {
-        *from = node;
-        return 0;
-    }
-
-    /* If "from" has no children, remove it from the current node's children
-     * and then delete it. 
-     * If it has children, leave it alone.
-     */
-    if (std_list_length((*from)->children) == 0) {
-        std_list_iterator iter;
+    if (ktree->node_count == ktree->node_size) {
+        nodes = (struct kui_tree_node *) realloc(ktree->nodes,
+                sizeof (struct kui_tree_node) * ktree->node_size * 2);
 
-        iter = std_list_find(node->children, &(*from)->key,
-                kui_tree_node_key_compare_callback);
-
-        if (!iter)
+        if (!nodes)
             return -1;
 
-        /* From is freed by std_list_remove callback */
-        if (std_list_remove(node->children, iter) == NULL)
-            return -1;
+        ktree->nodes = nodes;
+        ktree->node_size *= 2;
     }
 
-    *from = node;
+    ktree->nodes[ktree->node_count].macro_value = NULL;
+    ktree->nodes[ktree->node_count].children = 0;
 
-    return 0;
+    return ktree->node_count++;
 }
 
-/* }}} */
-
-/* struct kui_tree {{{ */
-
-/**
- * This data structure is capable of storing a set of maps internally in such a
- * way that it is easy to see what maps are active if a char at a time is fed
- * to this structure.
- *
- * Also, it can determine what mapping was reached if one was found.
- */
-struct kui_tree {
-    /* The root of the tree */
-    struct kui_tree_node *root;
-    /* The current position pointing into the tree ( while looking for a map ) */
-    struct kui_tree_node *cur;
-    /* The last node found while looking for a map. */
-    /* This happens because maps can be subsets of other maps. */
-    struct kui_tree_node *found_node;
-    /* The internal state of the tree ( still looking, map found, not found ) */
-    enum kui_tree_state state;
-    /* If a map was found at all, this is set to 1 while looking, otherwise 0. */
-    int found;
-};
-
 int kui_tree_destroy(struct kui_tree *ktree)
 {
-    int retval = 0;
-
     if (!ktree)
         return -1;
 
-    if (kui_tree_node_destroy(ktree->root) == -1)
-        retval = -1;
-
+    free(ktree->nodes);
+    free(ktree->edges);
     free(ktree);
     ktree = NULL;
 
-    return retval;
+    return 0;
 }
 
 struct kui_tree *kui_tree_create(void)
 {
     struct kui_tree *ktree;
 
-    ktree = (struct kui_tree *) malloc(sizeof (struct kui_tree));
+    ktree = (struct kui_tree *) calloc(1, sizeof (struct kui_tree));
 
     if (!ktree)
         return NULL;
 
-    ktree->root = kui_tree_node_create();
+    ktree->node_size = 64;
+    ktree->nodes = (struct kui_tree_node *) malloc(sizeof (struct
+                    kui_tree_node) * ktree->node_size);
+    ktree->edge_size = 128;
+    ktree->edges = (struct kui_tree_edge *) calloc(ktree->edge_size,
+            sizeof (struct kui_tree_edge));
 
-    if (!ktree->root) {
+    if (!ktree->nodes || !ktree->edges || kui_tree_add_node(ktree) == -1) {
         kui_tree_destroy(ktree);
         return NULL;
     }
 
+    kui_tree_reset_state(ktree);
+
     return ktree;
 }
 
 int kui_tree_insert(struct kui_tree *ktree, int *klist, void *data)
 {
-    return kui_tree_node_insert(ktree->root, klist, data);
-}
+    int node = 0, child, i;
 
-int kui_tree_delete(struct kui_tree *ktree, int *klist)
-{
-    struct kui_tree_node *from;
-
-    if (kui_tree_node_delete(ktree->root, &from, klist) == -1)
+    if (!ktree)
         return -1;
 
-    if (std_list_length(from->children) == 0) {
-        std_list_iterator iter;
+    for (; klist[0] != 0; ++klist) {
+        /* Keep the table at most half full, so lookups stay short */
+        if ((ktree->edge_count + 1) * 2 > ktree->edge_size &&
+                kui_tree_grow_edges(ktree) == -1)
+            return -1;
 
-        iter = std_list_find(ktree->root->children, &from->key,
-                kui_tree_node_key_compare_callback);
+        i = kui_tree_find(ktree, node, klist[0]);
 
-        if (!iter)
-            return -1;
+        /* If the node was found, use it, otherwise create a new one */
+        if (ktree->edges[i].to == 0) {
+            if ((child = kui_tree_add_node(ktree)) == -1)
+                return -1;
 
-        /* From is freed by std_list_remove callback */
-        if (std_list_remove(ktree->root->children, iter) == NULL)
-            return -1;
+            ktree->edges[i].from = node;
+            ktree->edges[i].key = klist[0];
+            ktree->edges[i].to = child;
+            ktree->edge_count++;
+            ktree->nodes[node].children++;
+        }
+
+        node = ktree->edges[i].to;
     }
 
+    ktree->nodes[node].macro_value = data;
+
     return 0;
 }
 
@@ -362,10 +286,10 @@ int kui_tree_reset_state(struct kui_tree *ktree)
     if (!ktree)
         return -1;
 
-    ktree->cur = ktree->root;
+    ktree->cur = 0;
     ktree->state = KUI_TREE_MATCHING;
     ktree->found = 0;
-    ktree->found_node = NULL;
+    ktree->found_node = 0;
 
     return 0;
 }
@@ -399,15 +323,16 @@ int kui_tree_get_data(struct kui_tree *ktree, void *data)
     if (!ktree->found)
         return -1;
 
-    memcpy(data, &ktree->found_node->macro_value, sizeof (void *));
+    memcpy(data, &ktree->nodes[ktree->found_node].macro_value,
+            sizeof (void *));
 
     return 0;
 }
 
 int kui_tree_push_key(struct kui_tree *ktree, int key, int *map_found)
 {
-    int found;
     struct kui_tree_node *ktnode;
+    int i;
 
     *map_found = 0;
 
@@ -415,27 +340,24 @@ int kui_tree_push_key(struct kui_tree *ktree, int key, int *map_found)
         return -1;
 
     /* Check to see if this key matches */
-    if (kui_tree_find(key, ktree->cur->children, &found, &ktnode) == -1)
-        return -1;
+    i = kui_tree_find(ktree, ktree->cur, key);
 
     /* Not found */
-    if (!found) {
+    if (ktree->edges[i].to == 0) {
         ktree->state = KUI_TREE_NOT_FOUND;
-        ktree->cur = NULL;
         return 0;
     }
 
-    if (found) {
-        ktree->cur = ktnode;
+    ktree->cur = ktree->edges[i].to;
+    ktnode = &ktree->nodes[ktree->cur];
 
-        if (std_list_length(ktnode->children) == 0)
-            ktree->state = KUI_TREE_FOUND;
+    if (ktnode->children == 0)
+        ktree->state = KUI_TREE_FOUND;
 
-        if (ktnode->macro_value) {
-            ktree->found = 1;
-            ktree->found_node = ktnode;
-            *map_found = 1;
-        }
+    if (ktnode->macro_value) {
+        ktree->found = 1;
+        ktree->found_node = ktree->cur;
+        *map_found = 1;
     }
 
     return 0;
@@ -1,12 +1,6 @@
 #ifndef __KUI_TREE_H__
 #define __KUI_TREE_H__
 
-/* Includes {{{*/
-
-#include "std_list.h"
-
-/* }}}*/
-
 /* Doxygen headers {{{ */
 /*! 
  * \file
@@ -17,6 +11,9 @@
  * It is a statefull data structure, which can be told to start matching, to
  * recieve input, and then to stop matching. When it is told to stop, it knows
  * exactly which macro's have been completed, and how much data is extra.
+ *
+ * Maps can only be added to a tree, a tree with a map removed is built
+ * again from the maps left.
  */
 /* }}} */
 
@@ -62,8 +59,8 @@ int kui_tree_destroy(struct kui_tree *ktree);
 
 /******************************************************************************/
 /**
- * @name Inserting and Deleteing from a kui_tree
- * These are the basic functions of adding to and removing from a kui_tree
+ * @name Inserting into a kui_tree
+ * This is the basic function of adding to a kui_tree
  */
 /******************************************************************************/
 
@@ -87,21 +84,6 @@ int kui_tree_destroy(struct kui_tree *ktree);
  */
 int kui_tree_insert(struct kui_tree *ktree, int *klist, void *data);
 
-/**
- * Adding a key from the kui tree.
- *
- * \param ktree
- * The tree to delete a key from.
- *
- * \param klist
- * The key to remove from the tree
- * It is a null terminated list.
- *
- * @return
- * 0 on success, or -1 on error.
- */
-int kui_tree_delete(struct kui_tree *ktree, int *klist);
-
 /*@}*/
 
 /******************************************************************************/
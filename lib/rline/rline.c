@@ -1,5 +1,6 @@
 #include <sys_util.h>
 #include "rline.h"
+#include "rline_history.h"
 
 #if HAVE_CONFIG_H
 #include "config.h"
@@ -64,17 +65,171 @@ struct rline {
      * since that particular functionality of readline does not work with
      * the alternative interface. */
     int rline_rl_completion_query_items;
+
+    /* The history, readline's own has the same lines */
+    struct rline_history *history;
+
+    /* The reverse search. While the user types what to search for, the
+     * keys are bound to rline_search_key in search_keymap. The line the
+     * user had is put back if the search is given up. */
+    int searching;
+    Keymap search_keymap;
+    Keymap search_saved_keymap;
+    char search[256];
+    int search_length;
+    int search_match;
+    int search_failed;
+    char *search_saved_line;
+    int search_saved_point;
+
+    /* 1 when the key that ended the search is to be handled by readline */
+    int search_replay;
 };
 
+/* The functions readline calls for a key get no context */
+static struct rline *rline_current;
+
+/* The key that starts a reverse search, and finds the next match */
+#define RLINE_SEARCH_KEY ('R' & 0x1f)
+
 static void custom_deprep_term_function()
 {
 }
 
+/* Reverse search {{{*/
+
+/**
+ * Shows what's being searched for, in place of the prompt.
+ */
+static void rline_search_show(struct rline *rline)
+{
+    rl_message("(%sreverse-i-search)`%s': ",
+            rline->search_failed ? "failed " : "", rline->search);
+}
+
+/**
+ * Shows the newest line before a line that has what's searched for.
+ *
+ * \param before
+ * The index of the line to search before.
+ */
+static void rline_search_find(struct rline *rline, int before)
+{
+    const char *line;
+    int match;
+
+    match = rline_history_search(rline->history, rline->search, before);
+    rline->search_failed = (match == -1);
+
+    if (match != -1) {
+        rline->search_match = match;
+        line = rline_history_get(rline->history, match);
+        rl_replace_line(line, 0);
+        rl_point = strstr(line, rline->search) - line;
+    }
+
+    rline_search_show(rline);
+}
+
+/**
+ * Ends the search.
+ *
+ * \param restore
+ * 1 to put back the line the user had, 0 to keep the match.
+ */
+static void rline_search_end(struct rline *rline, int restore)
+{
+    rl_set_keymap(rline->search_saved_keymap);
+
+    if (restore) {
+        rl_replace_line(rline->search_saved_line, 0);
+        rl_point = rline->search_saved_point;
+    } else if (rline->search_match < rline_history_count(rline->history))
+        history_set_pos(rline->search_match);
+
+    free(rline->search_saved_line);
+    rline->search_saved_line = NULL;
+    rline->searching = 0;
+
+    rl_clear_message();
+}
+
+/**
+ * The key that starts a reverse search.
+ */
+static int rline_search_start(int count, int key)
+{
+    struct rline *rline = rline_current;
+
+    rline->searching = 1;
+    rline->search[0] = '\0';
+    rline->search_length = 0;
+    rline->search_match = rline_history_count(rline->history);
+    rline->search_failed = 0;
+    rline->search_saved_line = strdup(rl_line_buffer);
+    rline->search_saved_point = rl_point;
+
+    rline->search_saved_keymap = rl_get_keymap();
+    rl_set_keymap(rline->search_keymap);
+
+    rline_search_show(rline);
+
+    return 0;
+}
+
+/**
+ * A key typed during a reverse search.
+ *
+ * Text is added to what's searched for, the search key finds the next
+ * match, and the other keys end the search and do what they always do.
+ */
+static int rline_search_key(int count, int key)
+{
+    struct rline *rline = rline_current;
+    int count_lines = rline_history_count(rline->history);
+
+    if (key == RLINE_SEARCH_KEY) {
+        if (rline->search_length > 0 && !rline->search_failed)
+            rline_search_find(rline, rline->search_match);
+    } else if (key == ('G' & 0x1f)) {
+        rline_search_end(rline, 1);
+    } else if (key == 0x7f || key == '\b') {
+        if (rline->search_length > 0)
+            rline->search[--rline->search_length] = '\0';
+
+        /* The search starts over from the newest line */
+        rline->search_match = count_lines;
+        rline->search_failed = 0;
+        if (rline->search_length > 0)
+            rline_search_find(rline, count_lines);
+        else
+            rline_search_show(rline);
+    } else if (key >= ' ' &&
+            rline->search_length < (int) sizeof (rline->search) - 1) {
+        rline->search[rline->search_length++] = key;
+        rline->search[rline->search_length] = '\0';
+
+        /* The line that matched still does if it has the longer text */
+        rline_search_find(rline, rline->search_match < count_lines ?
+                rline->search_match + 1 : count_lines);
+    } else {
+        rline_search_end(rline, 0);
+        rl_execute_next(key);
+        rline->search_replay = 1;
+    }
+
+    return 0;
+}
+
+/* }}}*/
+
 /* Createing and Destroying a librline context. {{{*/
 struct rline *rline_initialize(int slavefd, command_cb * command,
         completion_cb * completion, char *TERM)
 {
     struct rline *rline = (struct rline *) malloc(sizeof (struct rline));
+    const char *convert_meta;
+    int key;
 
     if (!rline)
         return NULL;
@@ -83,6 +238,12 @@ struct rline *rline_initialize(int slavefd, command_cb * command,
     rline->input = NULL;
     rline->output = NULL;
 
+    rline->history = rline_history_create();
+    rline->searching = 0;
+    rline->search_keymap = NULL;
+    rline->search_saved_line = NULL;
+    rline->search_replay = 0;
+
     rline->input = fdopen(slavefd, "r");
     if (!rline->input) {
         rline_shutdown(rline);
@@ -98,6 +259,7 @@ struct rline *rline_initialize(int slavefd, command_cb * command,
     rline->tab_completion = completion;
     rline->rline_rl_last_func = NULL;
     rline->rline_rl_completion_query_items = rl_completion_query_items;
+    rline_current = rline;
 
     rl_readline_name = "cgdb";
     rl_instream = rline->input;
@@ -114,6 +276,17 @@ struct rline *rline_initialize(int slavefd, command_cb * command,
     rl_callback_handler_install("(gdb) ", command);
     rl_bind_key('\t', completion);
 
+    /* The reverse search uses the index of the history. When readline
+     * turns the bytes past ASCII into ESC and a key, binding them would
+     * make ESC a prefix, and the search would miss the ESC of an escape
+     * sequence, so then only ASCII is bound. */
+    convert_meta = rl_variable_value("convert-meta");
+    rline->search_keymap = rl_make_bare_keymap();
+    for (key = 0; key < 256; key++)
+        if (key < 128 || !convert_meta || strcmp(convert_meta, "on") != 0)
+            rl_bind_key_in_map(key, rline_search_key, rline->search_keymap);
+    rl_bind_key(RLINE_SEARCH_KEY, rline_search_start);
+
     /* Set the terminal type to dumb so the output of readline can be
      * understood by tgdb */
     if (rl_reset_terminal(TERM) == -1) {
@@ -148,6 +321,15 @@ int rline_shutdown(struct rline *rline)
     if (rline->output)
         fclose(rline->output);
 
+    rline_history_destroy(rline->history);
+    free(rline->search_saved_line);
+    if (rline->search_keymap) {
+        rl_discard_keymap(rline->search_keymap);
+        free(rline->search_keymap);
+    }
+    if (rline_current == rline)
+        rline_current = NULL;
+
     free(rline);
     rline = NULL;
 
@@ -158,16 +340,40 @@ int rline_shutdown(struct rline *rline)
 /* }}}*/
 
 /* Reading and Writing the librline context. {{{*/
+int rline_set_history_size(struct rline *rline, int size)
+{
+    if (!rline)
+        return -1;
+
+    rline_history_set_size(rline->history, size);
+
+    if (size > 0)
+        stifle_history(size);
+    else
+        unstifle_history();
+
+    return 0;
+}
+
 int rline_read_history(struct rline *rline, const char *file)
 {
+    int i, count, ret;
+
     if (!rline)
         return -1;
 
     using_history();
-    read_history(file);
+    clear_history();
+
+    ret = rline_history_read(rline->history, file);
+
+    /* readline gets the same lines, to move through them */
+    count = rline_history_count(rline->history);
+    for (i = 0; i < count; i++)
+        add_history(rline_history_get(rline->history, i));
     history_set_pos(history_length);
 
-    return 0;
+    return ret;
 }
 
 int rline_write_history(struct rline *rline, const char *file)
@@ -175,9 +381,7 @@ int rline_write_history(struct rline *rline, const char *file)
     if (!rline)
         return -1;
 
-    write_history(file);
-
-    return 0;
+    return rline_history_write(rline->history, file);
 }
 
 /*@}*/
@@ -200,6 +404,9 @@ int rline_clear(struct rline *rline)
     if (!rline)
         return -1;
 
+    if (rline->searching)
+        rline_search_end(rline, 0);
+
     /* Clear whatever readline has in it's buffer. */
     rl_point = 0;
     rl_end = 0;
@@ -218,6 +425,7 @@ int rline_add_history(struct rline *rline, const char *line)
         return -1;
 
     add_history(line);
+    rline_history_add(rline->history, line);
 
     return 0;
 }
@@ -268,6 +476,14 @@ int rline_rl_callback_read_char(struct rline *rline)
 
     rl_callback_read_char();
 
+    /* The key that ended a search is readline's. It's already read, newer
+     * readlines handle it before returning, older ones leave it pending. */
+    if (rline->search_replay) {
+        rline->search_replay = 0;
+        if (rl_pending_input)
+            rl_callback_read_char();
+    }
+
     return 0;
 }
 
@@ -392,6 +608,21 @@ rline_rl_complete(struct rline *rline, struct tgdb_list *list,
     return 0;
 }
 
+int rline_rl_completion_lists(struct rline *rline)
+{
+    rl_command_func_t *compare_func = NULL;
+
+    if (!rline)
+        return -1;
+
+    /* The same check rline_rl_complete makes */
+    if (rline->rline_rl_last_func == rline->tab_completion &&
+            rline->rline_rl_last_func == rl_last_func)
+        compare_func = rline->tab_completion;
+
+    return rl_completion_mode(compare_func) == '?';
+}
+
 int rline_resize_terminal_and_redisplay(struct rline *rline, int rows, int cols)
 {
     struct winsize size;
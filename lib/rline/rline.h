@@ -89,6 +89,23 @@ int rline_shutdown(struct rline *rline);
 
 /*@{*/
 
+/**
+ * Set how many lines of history are kept.
+ *
+ * The history file is rewritten with the last lines once it grows half
+ * again past the size, otherwise only the new lines are appended to it.
+ *
+ * \param rline
+ * The readline context to operate on.
+ *
+ * \param size
+ * The number of lines, 0 to keep them all.
+ *
+ * \return
+ * 0 on success or -1 on error
+ */
+int rline_set_history_size(struct rline *rline, int size);
+
 /**
  * Read readline history into memory.
  *
@@ -106,6 +123,8 @@ int rline_read_history(struct rline *rline, const char *file);
 /**
  * Write readline history to file.
  *
+ * Only the lines added since it was read are written.
+ *
  * \param rline
  * The readline context to operate on.
  *
@@ -252,6 +271,19 @@ typedef void (*display_callback) (char **, int, int);
 int rline_rl_complete(struct rline *rline, struct tgdb_list *list,
         display_callback display_cb);
 
+/**
+ * Checks if completing the current line now would list the possible
+ * completions, rather than complete the line. This is the case when the
+ * user hit tab twice in a row.
+ *
+ * \param rline
+ * The readline context to operate on.
+ *
+ * \return
+ * 1 if the completions would be listed, 0 if not, or -1 on error.
+ */
+int rline_rl_completion_lists(struct rline *rline);
+
 /**
  * This will adjust the size of the PTY that readline is working on, then 
  * it will alert readline that it will need to be redisplay it's data.
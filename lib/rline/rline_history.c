@@ -0,0 +1,517 @@
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_STDINT_H
+#include <stdint.h>
+#endif /* HAVE_STDINT_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#include <sys_util.h>
+#include "rline_history.h"
+
+/**
+ * The lines that have a 3 byte sequence in them.
+ *
+ * Each line gets a number when it's added, one more than the line before
+ * it, and is listed by that number, so the lists are in order. A line that
+ * is dropped is the oldest one, so it's at the start of its lists, and
+ * they start after it from then on. A list is moved back to the front of
+ * its memory once half of it is dropped lines, and a gram no line has
+ * anymore is taken out of the index.
+ */
+struct rline_gram {
+    /* The bytes, with 1 << 24 set, 0 if the slot is empty */
+    uint32_t key;
+
+    /* The numbers of the lines that have it, oldest first, from start */
+    uint32_t *lines;
+    int start;
+    int count;
+    int size;
+};
+
+struct rline_history {
+    /* The lines, the oldest one is at lines[start] */
+    char **lines;
+    int start;
+    int count;
+    int size;
+
+    /* The number of the oldest line */
+    uint32_t first;
+
+    /* The number of lines kept, 0 for all of them */
+    int max;
+
+    /* The number of the first line added since the file was read, and the
+     * lines the file has */
+    uint32_t session;
+    int file_lines;
+
+    /* The index, a hash table of grams_size slots */
+    struct rline_gram *grams;
+    int grams_size;
+    int grams_used;
+};
+
+/* Fibonacci hashing of a gram's key, the table's size is a power of 2 */
+#define GRAM_SLOT(history, key) \
+    ((int) (((uint32_t) (key) * 2654435761u) & ((history)->grams_size - 1)))
+
+/**
+ * Gets the key of the 3 bytes at text.
+ */
+static uint32_t gram_key(const char *text)
+{
+    const unsigned char *bytes = (const unsigned char *) text;
+
+    return 1u << 24 | bytes[0] << 16 | bytes[1] << 8 | bytes[2];
+}
+
+/**
+ * Finds the slot of a gram, or the empty slot it would go in.
+ */
+static struct rline_gram *gram_slot(struct rline_history *history,
+        uint32_t key)
+{
+    int slot = GRAM_SLOT(history, key);
+
+    while (history->grams[slot].key && history->grams[slot].key != key)
+        slot = (slot + 1) & (history->grams_size - 1);
+
+    return &history->grams[slot];
+}
+
+/**
+ * Doubles the index's slots, once half of them are used.
+ */
+static void gram_grow(struct rline_history *history)
+{
+    struct rline_gram *old = history->grams;
+    int old_size = history->grams_size, i;
+
+    if (history->grams_size && history->grams_used * 2 < history->grams_size)
+        return;
+
+    history->grams_size = old_size ? old_size * 2 : 1024;
+    history->grams = cgdb_calloc(history->grams_size,
+            sizeof (struct rline_gram));
+
+    for (i = 0; i < old_size; i++)
+        if (old[i].key)
+            *gram_slot(history, old[i].key) = old[i];
+
+    free(old);
+}
+
+/**
+ * Takes a gram out of the index, the grams after it in its run of used
+ * slots are put back in, so none is behind an empty slot.
+ */
+static void gram_remove(struct rline_history *history,
+        struct rline_gram *gram)
+{
+    struct rline_gram moved;
+    int slot = gram - history->grams;
+
+    free(gram->lines);
+    memset(gram, 0, sizeof (struct rline_gram));
+    history->grams_used--;
+
+    for (slot = (slot + 1) & (history->grams_size - 1);
+            history->grams[slot].key;
+            slot = (slot + 1) & (history->grams_size - 1)) {
+        moved = history->grams[slot];
+        memset(&history->grams[slot], 0, sizeof (struct rline_gram));
+        *gram_slot(history, moved.key) = moved;
+    }
+}
+
+/**
+ * Takes the oldest line out of the lists of the grams in it.
+ */
+static void gram_drop(struct rline_history *history, const char *line,
+        uint32_t number)
+{
+    struct rline_gram *gram;
+    size_t i, length = strlen(line);
+    int live;
+
+    for (i = 0; i + 3 <= length; i++) {
+        gram = gram_slot(history, gram_key(line + i));
+
+        /* A gram that's in the line more than once was dropped already */
+        if (!gram->key || gram->start == gram->count ||
+                gram->lines[gram->start] != number)
+            continue;
+
+        gram->start++;
+        live = gram->count - gram->start;
+
+        if (live == 0)
+            gram_remove(history, gram);
+        else if (gram->start >= live) {
+            memmove(gram->lines, gram->lines + gram->start,
+                    sizeof (uint32_t) * live);
+            gram->start = 0;
+            gram->count = live;
+
+            if (gram->size >= live * 4 && gram->size > 4) {
+                gram->size /= 2;
+                gram->lines = cgdb_realloc(gram->lines,
+                        sizeof (uint32_t) * gram->size);
+            }
+        }
+    }
+}
+
+/**
+ * Lists a line under each of the grams in it.
+ */
+static void gram_add(struct rline_history *history, const char *line,
+        uint32_t number)
+{
+    struct rline_gram *gram;
+    uint32_t key;
+    size_t i, length = strlen(line);
+
+    for (i = 0; i + 3 <= length; i++) {
+        gram_grow(history);
+
+        key = gram_key(line + i);
+        gram = gram_slot(history, key);
+        if (!gram->key) {
+            gram->key = key;
+            history->grams_used++;
+        }
+
+        /* A gram that's in the line more than once lists it once */
+        if (gram->count > gram->start &&
+                gram->lines[gram->count - 1] == number)
+            continue;
+
+        if (gram->count == gram->size) {
+            gram->size = gram->size ? gram->size * 2 : 4;
+            gram->lines = cgdb_realloc(gram->lines,
+                    sizeof (uint32_t) * gram->size);
+        }
+        gram->lines[gram->count++] = number;
+    }
+}
+
+/**
+ * Drops the oldest lines, until there are no more than the size.
+ */
+static void history_trim(struct rline_history *history)
+{
+    while (history->max > 0 && history->count > history->max) {
+        if (history->grams)
+            gram_drop(history, history->lines[history->start],
+                    history->first);
+        free(history->lines[history->start]);
+        history->start++;
+        history->count--;
+        history->first++;
+    }
+}
+
+/**
+ * Drops every line, and the index.
+ */
+static void history_clear(struct rline_history *history)
+{
+    int i;
+
+    for (i = 0; i < history->count; i++)
+        free(history->lines[history->start + i]);
+    free(history->lines);
+    history->lines = NULL;
+    history->start = history->count = history->size = 0;
+
+    for (i = 0; i < history->grams_size; i++)
+        free(history->grams[i].lines);
+    free(history->grams);
+    history->grams = NULL;
+    history->grams_size = history->grams_used = 0;
+}
+
+/**
+ * Writes lines to a file, from an index to the newest one.
+ */
+static int history_put(struct rline_history *history, FILE *file, int from)
+{
+    int i;
+
+    for (i = from; i < history->count; i++)
+        fprintf(file, "%s\n", history->lines[history->start + i]);
+
+    return ferror(file) ? -1 : 0;
+}
+
+struct rline_history *rline_history_create(void)
+{
+    return cgdb_calloc(1, sizeof (struct rline_history));
+}
+
+void rline_history_destroy(struct rline_history *history)
+{
+    if (!history)
+        return;
+
+    history_clear(history);
+    free(history);
+}
+
+void rline_history_set_size(struct rline_history *history, int size)
+{
+    history->max = size > 0 ? size : 0;
+    history_trim(history);
+}
+
+int rline_history_read(struct rline_history *history, const char *file)
+{
+    FILE *input;
+    char *data = NULL, *line, *end;
+    size_t length = 0, size = 0, n;
+    int lines = 0, skip;
+
+    history_clear(history);
+    history->first = 0;
+    history->session = 0;
+    history->file_lines = 0;
+
+    if (!(input = fopen(file, "r")))
+        return errno == ENOENT ? 0 : -1;
+
+    /* The file is read whole, it's not much more than the size */
+    do {
+        if (length == size) {
+            size = size ? size * 2 : 65536;
+            data = cgdb_realloc(data, size + 1);
+        }
+        n = fread(data + length, 1, size - length, input);
+        length += n;
+    } while (n > 0);
+
+    if (ferror(input)) {
+        fclose(input);
+        free(data);
+        return -1;
+    }
+    fclose(input);
+
+    if (!data)
+        return 0;
+    data[length] = '\0';
+
+    for (line = data; line < data + length; line = end + 1) {
+        if (!(end = memchr(line, '\n', data + length - line)))
+            end = data + length;
+        lines++;
+    }
+
+    /* Only the last lines are kept */
+    skip = history->max > 0 && lines > history->max ? lines - history->max : 0;
+
+    for (line = data; line < data + length; line = end + 1) {
+        if (!(end = memchr(line, '\n', data + length - line)))
+            end = data + length;
+        *end = '\0';
+
+        if (skip > 0)
+            skip--;
+        else if (*line)
+            rline_history_add(history, line);
+    }
+
+    free(data);
+
+    history->session = history->first + history->count;
+    history->file_lines = lines;
+
+    return 0;
+}
+
+int rline_history_write(struct rline_history *history, const char *file)
+{
+    FILE *output;
+    char *temp;
+    int from, added, ret;
+
+    /* The lines the session added that are still kept */
+    if (history->session < history->first)
+        from = 0;
+    else
+        from = history->session - history->first;
+    added = history->count - from;
+
+    if (history->max == 0 ||
+            history->file_lines + added <= history->max + history->max / 2) {
+        if (added == 0)
+            return 0;
+
+        if (!(output = fopen(file, "a")))
+            return -1;
+
+        ret = history_put(history, output, from);
+        if (fclose(output) == EOF)
+            ret = -1;
+
+        if (ret == 0) {
+            history->file_lines += added;
+            history->session = history->first + history->count;
+        }
+
+        return ret;
+    }
+
+    /* The file is rewritten with the lines that are kept */
+    temp = cgdb_malloc(strlen(file) + 5);
+    sprintf(temp, "%s.tmp", file);
+
+    if (!(output = fopen(temp, "w"))) {
+        free(temp);
+        return -1;
+    }
+
+    ret = history_put(history, output, 0);
+    if (fclose(output) == EOF)
+        ret = -1;
+
+    if (ret == 0 && rename(temp, file) == -1)
+        ret = -1;
+
+    if (ret == -1)
+        unlink(temp);
+    else {
+        history->file_lines = history->count;
+        history->session = history->first + history->count;
+    }
+
+    free(temp);
+
+    return ret;
+}
+
+void rline_history_add(struct rline_history *history, const char *line)
+{
+    if (history->start + history->count == history->size) {
+        if (history->start > 0 && history->start >= history->size / 2) {
+            /* The dropped lines make room at the front */
+            memmove(history->lines, history->lines + history->start,
+                    sizeof (char *) * history->count);
+            history->start = 0;
+        } else {
+            history->size = history->size ? history->size * 2 : 256;
+            history->lines = cgdb_realloc(history->lines,
+                    sizeof (char *) * history->size);
+        }
+    }
+
+    history->lines[history->start + history->count] = cgdb_strdup(line);
+    gram_add(history, line, history->first + history->count);
+    history->count++;
+
+    history_trim(history);
+}
+
+int rline_history_count(struct rline_history *history)
+{
+    return history->count;
+}
+
+const char *rline_history_get(struct rline_history *history, int index)
+{
+    if (index < 0 || index >= history->count)
+        return NULL;
+
+    return history->lines[history->start + index];
+}
+
+int rline_history_search(struct rline_history *history, const char *text,
+        int before)
+{
+    struct rline_gram *gram, *shortest = NULL;
+    size_t i, length = strlen(text);
+    uint32_t limit;
+    int low, high, middle;
+
+    if (before > history->count)
+        before = history->count;
+
+    if (length == 0 || before <= 0)
+        return -1;
+
+    /* Text shorter than a gram is looked for in each line */
+    if (length < 3) {
+        while (--before >= 0)
+            if (strstr(history->lines[history->start + before], text))
+                return before;
+        return -1;
+    }
+
+    if (!history->grams)
+        return -1;
+
+    /* Only the lines with the rarest gram of the text can have it */
+    for (i = 0; i + 3 <= length; i++) {
+        gram = gram_slot(history, gram_key(text + i));
+        if (!gram->key)
+            return -1;
+        if (!shortest || gram->count - gram->start <
+                shortest->count - shortest->start)
+            shortest = gram;
+    }
+
+    /* The first line listed at or after the one to start before */
+    limit = history->first + before;
+    low = shortest->start;
+    high = shortest->count;
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (shortest->lines[middle] < limit)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    while (--low >= shortest->start) {
+        before = shortest->lines[low] - history->first;
+        if (strstr(history->lines[history->start + before], text))
+            return before;
+    }
+
+    return -1;
+}
+
+void rline_history_index(struct rline_history *history, int *grams,
+        int *postings)
+{
+    int i;
+
+    *grams = history->grams_used;
+    *postings = 0;
+    for (i = 0; i < history->grams_size; i++)
+        if (history->grams[i].key)
+            *postings += history->grams[i].count - history->grams[i].start;
+}
@@ -0,0 +1,158 @@
+#ifndef __RLINE_HISTORY_H__
+#define __RLINE_HISTORY_H__
+
+/*!
+ * \file
+ * rline_history.h
+ *
+ * \brief
+ * The history of the lines the user typed, kept alongside readline's own.
+ *
+ * Only the last lines are kept, as many as the size allows, in the file and
+ * in memory. A session only appends its own lines to the file, the file is
+ * rewritten with the last lines once it grew half again past the size.
+ *
+ * Each line is indexed by the 3 byte sequences in it, so a search only
+ * looks at the lines that have all of the ones of the text it's after,
+ * instead of every line.
+ */
+
+/**
+ *  This struct is a reference to a history.
+ */
+struct rline_history;
+
+/**
+ * Creates an empty history.
+ *
+ * @return
+ * The history.
+ */
+struct rline_history *rline_history_create(void);
+
+/**
+ * Frees a history.
+ *
+ * \param history
+ * The history to free, or NULL.
+ */
+void rline_history_destroy(struct rline_history *history);
+
+/**
+ * Sets how many lines are kept.
+ *
+ * The first lines are dropped if there are more.
+ *
+ * \param history
+ * The history to operate on.
+ *
+ * \param size
+ * The number of lines, 0 to keep them all.
+ */
+void rline_history_set_size(struct rline_history *history, int size);
+
+/**
+ * Reads the last lines of a history file.
+ *
+ * The lines the history has already are dropped. A file that doesn't exist
+ * is an empty history.
+ *
+ * \param history
+ * The history to operate on.
+ *
+ * \param file
+ * The file, one line of history on each line.
+ *
+ * @return
+ * 0 on success or -1 on error.
+ */
+int rline_history_read(struct rline_history *history, const char *file);
+
+/**
+ * Saves the lines added since the history was read.
+ *
+ * They're appended to the file, unless it has to be rewritten to drop its
+ * first lines.
+ *
+ * \param history
+ * The history to operate on.
+ *
+ * \param file
+ * The file to save them in.
+ *
+ * @return
+ * 0 on success or -1 on error.
+ */
+int rline_history_write(struct rline_history *history, const char *file);
+
+/**
+ * Adds a line to the end of the history.
+ *
+ * \param history
+ * The history to operate on.
+ *
+ * \param line
+ * The line, it's copied.
+ */
+void rline_history_add(struct rline_history *history, const char *line);
+
+/**
+ * Gets how many lines the history has.
+ *
+ * \param history
+ * The history to operate on.
+ *
+ * @return
+ * The number of lines.
+ */
+int rline_history_count(struct rline_history *history);
+
+/**
+ * Gets a line of the history.
+ *
+ * \param history
+ * The history to operate on.
+ *
+ * \param index
+ * The index of the line, 0 is the oldest one.
+ *
+ * @return
+ * The line, or NULL if there's no such line.
+ */
+const char *rline_history_get(struct rline_history *history, int index);
+
+/**
+ * Finds the newest line before a line that has some text in it.
+ *
+ * \param history
+ * The history to operate on.
+ *
+ * \param text
+ * The text to look for.
+ *
+ * \param before
+ * The index of the line the search starts before, the count of lines to
+ * search all of them.
+ *
+ * @return
+ * The index of the line, or -1 if no line before it has the text.
+ */
+int rline_history_search(struct rline_history *history, const char *text,
+        int before);
+
+/**
+ * Gets the size of the index, which only has the lines that are kept.
+ *
+ * \param history
+ * The history to operate on.
+ *
+ * \param grams
+ * Set to the number of 3 byte sequences indexed.
+ *
+ * \param postings
+ * Set to the number of times a line is listed under one of them.
+ */
+void rline_history_index(struct rline_history *history, int *grams,
+        int *postings);
+
+#endif /* __RLINE_HISTORY_H__ */
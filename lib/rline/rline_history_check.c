@@ -0,0 +1,96 @@
+/*
+ * rline_history_check: Adds ten times as many lines to a history as it
+ * keeps, and checks that its index only has the lines that are kept, and
+ * that a search finds what looking at every line does.
+ *
+ * "make check" runs it.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#include "rline_history.h"
+
+/* The lines kept */
+#define CHECK_SIZE 200
+
+/* The lines added */
+#define CHECK_LINES (CHECK_SIZE * 10)
+
+/* The texts searched for after each line */
+static const char *texts[] = { "print", "p 1", "0a", "ff", "x", "nothing" };
+
+/* Makes up the line with a number, most have grams no other line has */
+static void check_line(unsigned int number, char *line, size_t size)
+{
+    unsigned int hash = number * 2654435761u;
+
+    if (number % 3 == 0)
+        snprintf(line, size, "print var_%x", hash);
+    else
+        snprintf(line, size, "p %u + %x", number, hash >> 8);
+}
+
+/* The newest line before another that has text, looking at each line */
+static int check_search(struct rline_history *history, const char *text,
+        int before)
+{
+    while (--before >= 0)
+        if (strstr(rline_history_get(history, before), text))
+            return before;
+
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    struct rline_history *history = rline_history_create();
+    char line[64];
+    int failures = 0, most = 0, grams, postings, length, count, i, j;
+
+    rline_history_set_size(history, CHECK_SIZE);
+
+    for (i = 0; i < CHECK_LINES && failures < 10; i++) {
+        check_line(i, line, sizeof (line));
+        rline_history_add(history, line);
+
+        /* A line is listed once at most under each gram in it */
+        count = rline_history_count(history);
+        for (j = 0, length = 0; j < count; j++)
+            length += strlen(rline_history_get(history, j)) - 2;
+
+        rline_history_index(history, &grams, &postings);
+        if (grams > length || postings > length) {
+            printf("FAIL: line %d: %d grams and %d postings for %d lines "
+                    "of %d grams\n", i, grams, postings, count, length);
+            failures++;
+        }
+        if (postings > most)
+            most = postings;
+
+        for (j = 0; j < sizeof (texts) / sizeof (texts[0]); j++)
+            if (rline_history_search(history, texts[j], count) !=
+                    check_search(history, texts[j], count)) {
+                printf("FAIL: line %d: the search for \"%s\" is wrong\n",
+                        i, texts[j]);
+                failures++;
+            }
+    }
+
+    rline_history_destroy(history);
+
+    if (failures == 0)
+        printf("PASS: %d lines, %d kept, %d postings at most\n",
+                CHECK_LINES, CHECK_SIZE, most);
+
+    return failures ? 1 : 0;
+}
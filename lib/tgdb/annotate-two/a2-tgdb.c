@@ -176,12 +176,15 @@ static int tgdb_setup_config_file(struct annotate_two *a2, const char *dir)
 }
 
 void *a2_create_context(const char *debugger,
-        int argc, char **argv, const char *config_dir, struct logger *logger)
+        int argc, char **argv, const char *config_dir,
+        struct std_arena *arena, struct logger *logger)
 {
 
     struct annotate_two *a2 = initialize_annotate_two();
     char a2_debug_file[FSUTIL_PATH_MAX];
 
+    a2->arena = arena;
+
     if (!tgdb_setup_config_file(a2, config_dir)) {
         logger_write_pos(logger, __FILE__, __LINE__,
                 "tgdb_init_config_file error");
@@ -189,7 +192,7 @@ void *a2_create_context(const char *debugger,
     }
 
     /* Initialize the debug file that a2_tgdb writes to */
-    fs_util_get_path(config_dir, "a2_tgdb_debug.txt", a2_debug_file);
+    fs_util_get_path(config_dir, "a2_tgdb_debug.trace", a2_debug_file);
     io_debug_init(a2_debug_file);
 
     a2->debugger_pid =
@@ -214,9 +217,11 @@ int a2_initialize(void *ctx,
 
     a2->data = data_initialize();
     a2->sm = state_machine_initialize();
-    a2->c = commands_initialize();
+    a2->c = commands_initialize(a2->arena);
     a2->g = globals_initialize();
     a2->client_command_list = tgdb_list_init();
+    a2->pipelined_commands = queue_init();
+    a2->running_pipelinable = 0;
 
     a2_open_new_tty(a2, inferior_stdin, inferior_stdout);
 
@@ -248,6 +253,7 @@ int a2_shutdown(void *ctx)
     state_machine_shutdown(a2->sm);
     commands_shutdown(a2->c);
     globals_shutdown(a2->g);
+    queue_free_list(a2->pipelined_commands, tgdb_command_destroy);
     return 0;
 }
 
@@ -286,6 +292,9 @@ int a2_parse_io(void *ctx,
     val = a2_handle_data(a2, a2->sm, input_data, input_data_size,
             debugger_output, debugger_output_size, list);
 
+    /* The source files found in this output, if 'info sources' is running */
+    commands_send_gui_source_batch(a2->c, list);
+
     a2->cur_response_list = NULL;
 
     if (a2->command_finished)
@@ -301,11 +310,15 @@ struct tgdb_list *a2_get_client_commands(void *ctx)
     return a2->client_command_list;
 }
 
-int a2_get_source_filename_pair(void *ctx, const char *file)
+int a2_get_source_filename_pair(void *ctx, const char *file,
+        struct tgdb_list *list)
 {
     struct annotate_two *a2 = (struct annotate_two *) ctx;
     int ret;
 
+    if (commands_send_cached_filename_pair(a2->c, file, list))
+        return 0;
+
     ret = commands_issue_command(a2->c, a2->client_command_list, ANNOTATE_LIST,
             file, 0);
     if (ret == -1) {
@@ -409,19 +422,25 @@ char *a2_return_client_command(void *ctx, enum tgdb_command_type c)
 char *a2_client_modify_breakpoint(void *ctx,
         const char *file, int line, enum tgdb_breakpoint_action b)
 {
-    char *val = (char *) cgdb_malloc(sizeof (char) * (strlen(file) + 128));
-
-    if (b == TGDB_BREAKPOINT_ADD) {
-        sprintf(val, "break \"%s\":%d", file, line);
-        return val;
-    } else if (b == TGDB_BREAKPOINT_DELETE) {
-        sprintf(val, "clear \"%s\":%d", file, line);
-        return val;
-    } else if (b == TGDB_TBREAKPOINT_ADD) {
-        sprintf(val, "tbreak \"%s\":%d", file, line);
-        return val;
-    } else
+    const char *command;
+    char *path, *val;
+
+    if (b == TGDB_BREAKPOINT_ADD)
+        command = "break";
+    else if (b == TGDB_BREAKPOINT_DELETE)
+        command = "clear";
+    else if (b == TGDB_TBREAKPOINT_ADD)
+        command = "tbreak";
+    else
         return NULL;
+
+    /* A quote or a backslash in the path would end it early */
+    path = fs_util_quote_path(file);
+    val = (char *) cgdb_malloc(sizeof (char) * (strlen(path) + 128));
+    sprintf(val, "%s %s:%d", command, path, line);
+    free(path);
+
+    return val;
 }
 
 pid_t a2_get_debugger_pid(void *ctx)
@@ -446,6 +465,21 @@ int a2_completion_callback(void *ctx, const char *command)
     return 0;
 }
 
+int a2_disassemble(void *ctx, const char *address)
+{
+    struct annotate_two *a2 = (struct annotate_two *) ctx;
+
+    if (commands_issue_command(a2->c,
+                    a2->client_command_list,
+                    ANNOTATE_DISASSEMBLE, address, 0) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "commands_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
 int a2_user_ran_command(void *ctx)
 {
     struct annotate_two *a2 = (struct annotate_two *) ctx;
@@ -453,11 +487,81 @@ int a2_user_ran_command(void *ctx)
     return commands_user_ran_command(a2->c, a2->client_command_list);
 }
 
+/* a2_can_pipeline: Determines if a command never asks the user anything, and
+ * ----------------  the command after it doesn't care how it went.
+ */
+static int a2_can_pipeline(struct tgdb_command *com)
+{
+    enum annotate_commands *a_com =
+            (enum annotate_commands *) com->tgdb_client_private_data;
+
+    if (com->command_choice != TGDB_COMMAND_TGDB_CLIENT || a_com == NULL)
+        return 0;
+
+    switch (*a_com) {
+        case ANNOTATE_INFO_BREAKPOINTS:
+        case ANNOTATE_INFO_SOURCES:
+        case ANNOTATE_INFO_SOURCE_RELATIVE:
+        case ANNOTATE_INFO_SOURCE_FILENAME_PAIR:
+        case ANNOTATE_COMPLETE:
+        case ANNOTATE_DISASSEMBLE:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
 int a2_prepare_for_command(void *ctx, struct tgdb_command *com)
 {
     struct annotate_two *a2 = (struct annotate_two *) ctx;
+    int ret;
+
+    ret = commands_prepare_for_command(a2, a2->c, com);
+    a2->running_pipelinable = (ret == 0 && a2_can_pipeline(com));
+
+    return ret;
+}
+
+int a2_pipeline_command(void *ctx, struct tgdb_command *com)
+{
+    struct annotate_two *a2 = (struct annotate_two *) ctx;
+
+    if (!a2->running_pipelinable ||
+            data_get_state(a2->data) != INTERNAL_COMMAND ||
+            !a2_can_pipeline(com) ||
+            queue_size(a2->pipelined_commands) >= A2_PIPELINE_DEPTH)
+        return 0;
+
+    queue_append(a2->pipelined_commands, com);
+
+    return 1;
+}
+
+int a2_run_pipelined_command(struct annotate_two *a2)
+{
+    struct tgdb_command *com = queue_pop(a2->pipelined_commands);
+
+    if (!com) {
+        a2->running_pipelinable = 0;
+        return 0;
+    }
+
+    /* The debugger already has it, its output comes next */
+    if (a2_prepare_for_command(a2, com) == -1)
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "a2_prepare_for_command error");
+    tgdb_command_destroy(com);
+
+    /* TGDB only gets to run more once they are all done */
+    a2->command_finished = 0;
 
-    return commands_prepare_for_command(a2, a2->c, com);
+    return 1;
+}
+
+void a2_drop_pipelined_commands(struct annotate_two *a2)
+{
+    queue_free_list(a2->pipelined_commands, tgdb_command_destroy);
+    a2->running_pipelinable = 0;
 }
 
 int a2_is_misc_prompt(void *ctx)
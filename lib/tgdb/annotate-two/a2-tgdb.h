@@ -85,7 +85,12 @@ enum annotate_commands {
     /**
 	 * Sets the prompt.
 	 */
-    ANNOTATE_SET_PROMPT
+    ANNOTATE_SET_PROMPT,
+
+    /**
+	 * Disassembles a function.
+	 */
+    ANNOTATE_DISASSEMBLE
 };
 
 /******************************************************************************/
@@ -116,11 +121,18 @@ enum annotate_commands {
  * \param config_dir
  * The current config directory. Files can be stored here.
  *
+ * \param arena
+ * The arena the responses are allocated in. TGDB resets it after each batch.
+ *
+ * \param logger
+ * The data structure to report errors to.
+ *
  * @return
  * NULL on error, A valid descriptor upon success
  */
 void *a2_create_context(const char *debugger_path,
-        int argc, char **argv, const char *config_dir, struct logger *logger);
+        int argc, char **argv, const char *config_dir,
+        struct std_arena *arena, struct logger *logger);
 
 /** 
  * This initializes the libannotate_two libarary.
@@ -222,6 +234,44 @@ int a2_user_ran_command(void *ctx);
  */
 int a2_prepare_for_command(void *ctx, struct tgdb_command *com);
 
+/**
+ * Takes a command that TGDB is about to write to the debugger while another
+ * command is still running. It has to be one that never asks the user
+ * anything, behind one whose outcome doesn't matter to it.
+ *
+ * \param ctx
+ * The annotate two context.
+ *
+ * \param com
+ * The command to be run. It belongs to the context if it's taken.
+ *
+ * @return
+ * 1 if the command was taken and can be written now, 0 if it has to wait
+ * for the running command to finish.
+ */
+int a2_pipeline_command(void *ctx, struct tgdb_command *com);
+
+/**
+ * Prepares for the next command that was written ahead, once the prompt
+ * ends the one running.
+ *
+ * \param a2
+ * The annotate two context.
+ *
+ * @return
+ * 1 if a command is running now, 0 if there were none.
+ */
+int a2_run_pipelined_command(struct annotate_two *a2);
+
+/**
+ * Forgets the commands that were written ahead. The debugger's terminal
+ * throws away the input it hasn't read yet when it's interrupted.
+ *
+ * \param a2
+ * The annotate two context.
+ */
+void a2_drop_pipelined_commands(struct annotate_two *a2);
+
 /** 
  * This is a hack. It should be removed eventually.
  * It tells tgdb-base not to send its internal commands when this is true.
@@ -261,7 +311,9 @@ int a2_is_misc_prompt(void *ctx);
   *
   * \param debugger_output
   * This is an out variable. It contains data that has been determined to
-  * be the output of the debugger that the user should see.
+  * be the output of the debugger that the user should see. It must have
+  * room for 2 bytes more than input_data_size, a newline and a ^Z held
+  * back from the last call, and a null terminator.
   *
   * \param debugger_output_size
   * This is the size of debugger_output
@@ -322,10 +374,15 @@ struct tgdb_list *a2_get_client_commands(void *ctx);
  * \param file
  * The relative path that gdb outputted.
  *
+ * \param list
+ * If the pair was looked up before, the TGDB_FILENAME_PAIR response is
+ * appended here and gdb isn't asked.
+ *
  * @return
  * 0 on success, otherwise -1 on error.
  */
-int a2_get_source_filename_pair(void *ctx, const char *file);
+int a2_get_source_filename_pair(void *ctx, const char *file,
+        struct tgdb_list *list);
 
 /**
  * Get's the fullname, filename and line number GDB is currently at.
@@ -369,6 +426,20 @@ int a2_get_inferior_sources(void *ctx);
  */
 int a2_completion_callback(void *ctx, const char *command);
 
+/** 
+ * This asks gdb for the instructions of a function.
+ *
+ * \param ctx
+ * The annotate two context.
+ *
+ * \param address
+ * An address in the function, or NULL for the one gdb is at.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error.
+ */
+int a2_disassemble(void *ctx, const char *address);
+
 /** 
  * This returns the command to send to gdb for the enum C.
  * It will return NULL on error, otherwise correct string on output.
@@ -17,6 +17,7 @@
 #include "commands.h"
 #include "globals.h"
 #include "io.h"
+#include "a2-tgdb.h"
 
 static int
 handle_source(struct annotate_two *a2, const char *buf, size_t n,
@@ -96,16 +97,17 @@ static int handle_prompt(struct annotate_two *a2, const char *buf, size_t n,
     if (global_has_info_sources_started(a2->g) == 1) {
         global_reset_info_sources_started(a2->g);
         commands_send_gui_sources(a2->c, list);
-        return 0;
     }
 
     /* 'complete' is done, return the completions to the gui */
-    if (global_has_completion_started(a2->g) == 1) {
+    else if (global_has_completion_started(a2->g) == 1) {
         global_reset_completion_started(a2->g);
         commands_send_gui_completions(a2->c, list);
-        return 0;
     }
 
+    /* The debugger goes on with the command written after this one */
+    a2_run_pipelined_command(a2);
+
     return 0;
 }
 
@@ -120,6 +122,10 @@ static int handle_breakpoints_invalid(struct annotate_two *a2, const char *buf,
         size_t n, struct tgdb_list *list)
 {
     /* Don't use anymore because GDB is buggy */
+
+    /* It still comes when shared libraries are loaded, which can bring
+     * in other source files */
+    commands_invalidate_paths(a2->c);
     return 0;
 }
 
@@ -183,11 +189,7 @@ static int handle_error_begin(struct annotate_two *a2, const char *buf,
      * annotate error ( usually meaning that gdb can not find the symbols
      * for the debugged program ) then send a denied response. */
     if (commands_get_state(a2->c) == INFO_SOURCES) {
-        struct tgdb_response *response = (struct tgdb_response *)
-                cgdb_malloc(sizeof (struct tgdb_response));
-
-        response->header = TGDB_SOURCES_DENIED;
-        tgdb_types_append_command(list, response);
+        tgdb_types_new_response(a2->arena, list, TGDB_SOURCES_DENIED);
         return 0;
     }
 
@@ -212,6 +214,9 @@ static int handle_error_begin(struct annotate_two *a2, const char *buf,
 static int handle_quit(struct annotate_two *a2, const char *buf, size_t n,
         struct tgdb_list *list)
 {
+    /* The commands written ahead were thrown away with the interrupt */
+    a2_drop_pipelined_commands(a2);
+
     data_set_state(a2, POST_PROMPT);    /* TEMPORARY */
     return 0;
 }
@@ -220,18 +225,16 @@ static int handle_exited(struct annotate_two *a2, const char *buf, size_t n,
         struct tgdb_list *list)
 {
     char *tmp = (char *) malloc(sizeof (char) * (n + 1));
-    int *i = (int *) malloc(sizeof (int));
+    int *i = (int *) std_arena_alloc(a2->arena, sizeof (int));
     struct tgdb_response *response;
 
     sprintf(tmp, "%s", buf + 7);    /* Skip the 'exited ' part */
     *i = atoi(tmp);
     free(tmp);
     tmp = NULL;
-    response = (struct tgdb_response *)
-            cgdb_malloc(sizeof (struct tgdb_response));
-    response->header = TGDB_INFERIOR_EXITED;
+    response = tgdb_types_new_response(a2->arena, list,
+            TGDB_INFERIOR_EXITED);
     response->choice.inferior_exited.exit_status = i;
-    tgdb_types_append_command(list, response);
     return 0;
 }
 
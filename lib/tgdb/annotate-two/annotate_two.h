@@ -10,11 +10,16 @@
 #endif /* HAVE_SYS_TYPES_H */
 
 #include "tgdb_command.h"
+#include "queue.h"
+#include "std_arena.h"
 #include "fs_util.h"
 #include "fork_util.h"          /* For pty_pair_ptr */
 
 #define TTY_NAME_SIZE 64
 
+/* The most commands written to the debugger ahead of the one running */
+#define A2_PIPELINE_DEPTH 4
+
 /**
  * This is the main context for the annotate two subsytem.
  */
@@ -94,6 +99,24 @@ struct annotate_two {
 	 * The current response list.
 	 */
     struct tgdb_list *cur_response_list;
+
+    /**
+	 * The arena the responses and what they point to are allocated in.
+	 * TGDB resets it after each batch of responses.
+	 */
+    struct std_arena *arena;
+
+    /**
+	 * The commands written to the debugger while another one was still
+	 * running. Each one is prepared for when the prompt ends the one
+	 * before it.
+	 */
+    struct queue *pipelined_commands;
+
+    /**
+	 * 1 if more commands can be written behind the one running.
+	 */
+    int running_pipelinable;
 };
 
 #endif /* __ANNOTATE_TWO_H__ */
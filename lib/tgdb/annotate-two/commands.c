@@ -2,6 +2,10 @@
 #include "config.h"
 #endif /* HAVE_CONFIG_H */
 
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
 #if HAVE_STDLIB_H
 #include <stdlib.h>
 #endif /* HAVE_STDLIB_H */
@@ -10,14 +14,14 @@
 #include <string.h>
 #endif /* HAVE_STRING_H */
 
+#if HAVE_CTYPE_H
+#include <ctype.h>
+#endif /* HAVE_CTYPE_H */
+
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
 #endif /* HAVE_SYS_TYPES_H */
 
-#if HAVE_REGEX_H
-#include <regex.h>
-#endif /* HAVE_REGEX_H */
-
 /* Local includes */
 #include "commands.h"
 #include "data.h"
@@ -31,6 +35,9 @@
 #include "a2-tgdb.h"
 #include "queue.h"
 #include "tgdb_list.h"
+#include "std_ohash.h"
+#include "std_arena.h"
+#include "std_intern.h"
 #include "annotate_two.h"
 
 /**
@@ -39,6 +46,9 @@
  */
 struct commands {
 
+  /** The arena the responses are allocated in.  */
+    struct std_arena *arena;
+
   /** The current absolute path the debugger is at in the inferior.  */
     struct ibuf *absolute_path;
 
@@ -69,11 +79,20 @@ struct commands {
   /** If the current breakpoint is enabled */
     int breakpoint_enabled;
 
+  /** The number of the current breakpoint, and 1 once it's all read */
+    int breakpoint_number;
+    int breakpoint_number_ended;
+
   /** ???  */
     int breakpoint_started;
 
-    /* The regular expression matching the breakpoint GDB output */
-    regex_t regex_bp;
+    /* The breakpoints parsed from the table, as text, and the ones last
+     * sent to the gui. The gui only gets the table when they differ. */
+    struct ibuf *breakpoint_text;
+    struct ibuf *breakpoint_sent_text;
+
+    /* 1 once a table was sent to the gui */
+    int breakpoint_sent;
 
     /*@} */
 
@@ -96,6 +115,14 @@ struct commands {
   /** The name of the file requested to have 'info source' run on.  */
     struct ibuf *last_info_source_requested;
 
+  /** The relative path gdb gave for each absolute path it stopped in,
+   * both interned.  */
+    struct std_ohashtable *relative_paths;
+
+  /** The absolute path gdb found for each file the gui asked about, both
+   * interned.  */
+    struct std_ohashtable *filename_pairs;
+
     /*@} */
 
     /* info sources information {{{ */
@@ -110,6 +137,12 @@ struct commands {
   /** All of the source, parsed in put in a list, 1 at a time.  */
     struct tgdb_list *inferior_source_files;
 
+  /** The sources parsed since the last batch was given to the gui.  */
+    struct tgdb_list *source_files_batch;
+
+  /** How much of info_sources_string has been parsed into files.  */
+    unsigned long info_sources_parsed;
+
     /*@} */
     /* }}} */
 
@@ -128,6 +161,21 @@ struct commands {
     /*@} */
     /* }}} */
 
+    /* disassemble information {{{ */
+    /*@{ */
+
+  /** The instructions gdb listed so far.  */
+    struct ibuf *disassemble_text;
+
+    /*@} */
+    /* }}} */
+
+  /** The address from the last source annotation, 0 if it had none.  */
+    unsigned long address;
+
+  /** 1 while 'info line' runs, its source annotation isn't where gdb is.  */
+    int info_line;
+
   /** The absolute path prefix output by GDB when 'info source' is given */
     const char *source_prefix;
 
@@ -141,11 +189,22 @@ struct commands {
     int source_relative_prefix_length;
 };
 
-struct commands *commands_initialize(void)
+int free_char_star(void *item)
+{
+    char *s = (char *) item;
+
+    free(s);
+    s = NULL;
+
+    return 0;
+}
+
+struct commands *commands_initialize(struct std_arena *arena)
 {
     struct commands *c =
             (struct commands *) cgdb_malloc(sizeof (struct commands));
-    const char *regex = "[io]n (.*) at (.*):([0-9]+)";
+
+    c->arena = arena;
 
     c->absolute_path = ibuf_init();
     c->line_number = ibuf_init();
@@ -157,24 +216,35 @@ struct commands *commands_initialize(void)
     c->breakpoint_string = ibuf_init();
     c->breakpoint_table = 0;
     c->breakpoint_enabled = 0;
+    c->breakpoint_number = 0;
+    c->breakpoint_number_ended = 0;
     c->breakpoint_started = 0;
-    if (regcomp(&c->regex_bp, regex, REG_EXTENDED) != 0)
-        return NULL;
+    c->breakpoint_text = ibuf_init();
+    c->breakpoint_sent_text = ibuf_init();
+    c->breakpoint_sent = 0;
 
     c->info_source_string = ibuf_init();
     c->info_source_relative_path = ibuf_init();
     c->info_source_absolute_path = ibuf_init();
     c->info_source_ready = 0;
     c->last_info_source_requested = ibuf_init();
+    c->relative_paths = std_ohash_table_new(std_str_hash, std_str_equal);
+    c->filename_pairs = std_ohash_table_new(std_str_hash, std_str_equal);
 
     c->sources_ready = 0;
     c->info_sources_string = ibuf_init();
     c->inferior_source_files = tgdb_list_init();
+    c->source_files_batch = tgdb_list_init();
+    c->info_sources_parsed = 0;
 
     c->tab_completion_ready = 0;
     c->tab_completion_string = ibuf_init();
     c->tab_completions = tgdb_list_init();
 
+    c->disassemble_text = ibuf_init();
+    c->address = 0;
+    c->info_line = 0;
+
     c->source_prefix = "Located in ";
     c->source_prefix_length = 11;
 
@@ -188,10 +258,8 @@ int free_breakpoint(void *item)
 {
     struct tgdb_breakpoint *bp = (struct tgdb_breakpoint *) item;
 
-    if (bp->file) {
-        free(bp->file);
-        bp->file = NULL;
-    }
+    /* The file is interned */
+    bp->file = NULL;
 
     if (bp->funcname) {
         free(bp->funcname);
@@ -204,16 +272,6 @@ int free_breakpoint(void *item)
     return 0;
 }
 
-int free_char_star(void *item)
-{
-    char *s = (char *) item;
-
-    free(s);
-    s = NULL;
-
-    return 0;
-}
-
 void commands_shutdown(struct commands *c)
 {
     if (c == NULL)
@@ -230,7 +288,10 @@ void commands_shutdown(struct commands *c)
 
     ibuf_free(c->breakpoint_string);
     c->breakpoint_string = NULL;
-    regfree(&c->regex_bp);
+    ibuf_free(c->breakpoint_text);
+    c->breakpoint_text = NULL;
+    ibuf_free(c->breakpoint_sent_text);
+    c->breakpoint_sent_text = NULL;
 
     ibuf_free(c->info_source_string);
     c->info_source_string = NULL;
@@ -241,6 +302,11 @@ void commands_shutdown(struct commands *c)
     ibuf_free(c->info_source_absolute_path);
     c->info_source_absolute_path = NULL;
 
+    std_ohash_table_destroy(c->relative_paths);
+    c->relative_paths = NULL;
+    std_ohash_table_destroy(c->filename_pairs);
+    c->filename_pairs = NULL;
+
     ibuf_free(c->info_sources_string);
     c->info_sources_string = NULL;
 
@@ -249,9 +315,15 @@ void commands_shutdown(struct commands *c)
 
     tgdb_list_destroy(c->tab_completions);
 
+    ibuf_free(c->disassemble_text);
+    c->disassemble_text = NULL;
+
     tgdb_list_free(c->inferior_source_files, free_char_star);
     tgdb_list_destroy(c->inferior_source_files);
 
+    tgdb_list_free(c->source_files_batch, free_char_star);
+    tgdb_list_destroy(c->source_files_batch);
+
     /* TODO: free source_files queue */
 
     free(c);
@@ -268,6 +340,9 @@ commands_parse_field(struct commands *c, const char *buf, size_t n, int *field)
     return 0;
 }
 
+static void commands_send_source_relative_source_file(struct commands *c,
+        struct tgdb_list *list);
+
 /* source filename:line:character:middle:addr */
 int
 commands_parse_source(struct commands *c,
@@ -278,12 +353,15 @@ commands_parse_source(struct commands *c,
     char copy[n + 1];
     char *cur = copy + n;
     struct ibuf *file = ibuf_init(), *line = ibuf_init();
+    const char *cached;
 
     strncpy(copy, buf, n + 1);  /* modify local copy */
 
     while (cur != copy && i <= 3) {
         if (*cur == ':') {
-            if (i == 3) {
+            if (i == 0)
+                c->address = c->info_line ? 0 : strtoul(cur + 1, NULL, 16);
+            else if (i == 3) {
                 int length = strlen(cur + 1);
                 char *temp = cgdb_malloc(sizeof (char) * (length + 1));
 
@@ -328,6 +406,17 @@ commands_parse_source(struct commands *c,
     ibuf_free(file);
     ibuf_free(line);
 
+    /* Going up and down the stack returns to the same few files, gdb
+     * only has to be asked about each one once */
+    cached = std_ohash_table_lookup(c->relative_paths,
+            ibuf_get(c->absolute_path));
+    if (cached) {
+        ibuf_clear(c->info_source_relative_path);
+        ibuf_add(c->info_source_relative_path, cached);
+        commands_send_source_relative_source_file(c, list);
+        return 0;
+    }
+
     /* set up the info_source command to get the relative path */
     if (commands_issue_command(c,
                     client_command_list,
@@ -340,29 +429,87 @@ commands_parse_source(struct commands *c,
     return 0;
 }
 
-/** 
+/**
+ * Find the fields of a breakpoint that GDB passes back when annotate=2 is
+ * set. The line is in this format.
+ *
+ *  '[io]n FUNCTION at FILE:NUMBER'
+ *
+ * It's found the way the regular expression '[io]n (.*) at (.*):([0-9]+)'
+ * would, in one pass over the line. FILE ends at the last ':number', and
+ * FUNCTION at the last ' at ' before it. If the filename contains ' at '
+ * in it, then TGDB will stop prematurly.
+ *
+ * \param line
+ * The line to parse
+ *
+ * \param length
+ * The length of line
+ *
+ * \param func
+ * Set to the offset of FUNCTION, it ends where FILE starts less 4
+ *
+ * \param file
+ * Set to the offset of FILE
+ *
+ * \param number
+ * Set to the offset of the ':' before NUMBER
+ *
+ * @return
+ * 0 on success, or -1 if the line isn't in this format.
+ */
+static int
+parse_breakpoint_fields(const char *line, size_t length,
+        size_t *func, size_t *file, size_t *number)
+{
+    size_t colon, at, in;
+
+    /* The last ':' followed by a digit */
+    for (colon = length; colon >= 2; colon--)
+        if (line[colon - 2] == ':' &&
+                line[colon - 1] >= '0' && line[colon - 1] <= '9')
+            break;
+    if (colon < 2)
+        return -1;
+    colon -= 2;
+
+    /* The last ' at ' before it */
+    for (at = colon; at >= 4; at--)
+        if (memcmp(line + at - 4, " at ", 4) == 0)
+            break;
+    if (at < 4)
+        return -1;
+    at -= 4;
+
+    /* The first 'in ' or 'on ' before that */
+    for (in = 0; in + 3 <= at; in++)
+        if ((line[in] == 'i' || line[in] == 'o') &&
+                line[in + 1] == 'n' && line[in + 2] == ' ')
+            break;
+    if (in + 3 > at)
+        return -1;
+
+    *func = in + 3;
+    *file = at + 4;
+    *number = colon;
+
+    return 0;
+}
+
+/**
  * Parse a breakpoint that GDB passes back when annotate=2 is set.
- * 
+ *
  * Unfortunatly, the line that this function has to parse is completly 
  * ambiguous. GDB does not output a line that can be read in a 
  * non-ambiguous way. Therefore, TGDB tries its best to read the line 
- * properly. The line is in this format.
- *
- *  '[io]n .* at .*:number'
- *
- * so, TGDB can parser the ':number' part without a problem. However,
- * it may not be able to get function name and filename correctly. If
- * the filename contains ' at ' in it, then TGDB will stop prematurly.
+ * properly, see parse_breakpoint_fields.
  */
 static int parse_breakpoint(struct commands *c)
 {
-#define BP_REGEX_SIZE (4)
     char *info_ptr;
-    size_t nmatch = BP_REGEX_SIZE;
-    regmatch_t pmatch[BP_REGEX_SIZE];
-    char *matches[BP_REGEX_SIZE] = { NULL, NULL, NULL, NULL };
-    int cur, val;
+    size_t length, func, file, number;
     struct tgdb_breakpoint *tb;
+    char number_text[32];
 
     info_ptr = ibuf_get(c->breakpoint_string);
     if (!info_ptr)              /* This should never really happen */
@@ -373,40 +520,43 @@ static int parse_breakpoint(struct commands *c)
     if (strstr(info_ptr, " at ") == NULL)
         return 0;
 
-    val = regexec(&c->regex_bp, info_ptr, nmatch, pmatch, 0);
-    if (val != 0) {
-        logger_write_pos(logger, __FILE__, __LINE__, "regexec failed");
+    length = ibuf_length(c->breakpoint_string);
+    if (parse_breakpoint_fields(info_ptr, length, &func, &file,
+                    &number) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "could not parse breakpoint (%s)", info_ptr);
         return -1;
     }
 
-    /* Get the whole match, function, filename and number name */
-    for (cur = 0; cur < BP_REGEX_SIZE; ++cur)
-        if (pmatch[cur].rm_so != -1) {
-            int size = pmatch[cur].rm_eo - pmatch[cur].rm_so;
-
-            matches[cur] = cgdb_malloc(sizeof (char) * (size) + 1);
-            strncpy(matches[cur], &info_ptr[pmatch[cur].rm_so], size);
-            matches[cur][size] = 0;
-        }
-
     tb = (struct tgdb_breakpoint *) cgdb_malloc(sizeof (struct
                     tgdb_breakpoint));
-    tb->funcname = matches[1];
-    tb->file = matches[2];
-    tb->line = atoi(matches[3]);
+    tb->funcname = cgdb_malloc(file - 4 - func + 1);
+    memcpy(tb->funcname, info_ptr + func, file - 4 - func);
+    tb->funcname[file - 4 - func] = '\0';
+    tb->line = atoi(info_ptr + number + 1);
+
+    /* Most breakpoints are in a few files, they share their name */
+    info_ptr[number] = '\0';
+    tb->file = std_intern(info_ptr + file);
+    info_ptr[number] = ':';
 
     if (c->breakpoint_enabled == 1)
         tb->enabled = 1;
     else
         tb->enabled = 0;
 
+    /* The hit count is on a line of its own after the table row */
+    tb->number = c->breakpoint_number;
+    tb->hits = 0;
+
     tgdb_list_append(c->breakpoint_list, tb);
 
-    /* Matches 1 && 2 are freed by client. */
-    free(matches[0]);
-    matches[0] = NULL;
-    free(matches[3]);
-    matches[3] = NULL;
+    /* What the gui gets, the hit counts and such don't matter to it */
+    ibuf_addn(c->breakpoint_text, info_ptr + func, length - func);
+    ibuf_addchar(c->breakpoint_text, tb->enabled ? 'y' : 'n');
+    snprintf(number_text, sizeof (number_text), "%d", tb->number);
+    ibuf_add(c->breakpoint_text, number_text);
+    ibuf_addchar(c->breakpoint_text, '\n');
 
     return 0;
 }
@@ -433,20 +583,33 @@ commands_set_state(struct commands *c,
                 if (parse_breakpoint(c) == -1)
                     logger_write_pos(logger, __FILE__, __LINE__,
                             "parse_breakpoint error");
-            {
-                struct tgdb_response *response = (struct tgdb_response *)
-                        cgdb_malloc(sizeof (struct tgdb_response));
 
-                response->header = TGDB_UPDATE_BREAKPOINTS;
-                response->choice.update_breakpoints.breakpoint_list =
-                        c->breakpoint_list;
+            /* The same breakpoints as last time, the gui has them already */
+            if (c->breakpoint_sent &&
+                    ibuf_length(c->breakpoint_text) ==
+                    ibuf_length(c->breakpoint_sent_text) &&
+                    memcmp(ibuf_get(c->breakpoint_text),
+                            ibuf_get(c->breakpoint_sent_text),
+                            ibuf_length(c->breakpoint_text)) == 0) {
+                tgdb_list_free(c->breakpoint_list, free_breakpoint);
+            } else {
+                struct tgdb_response *response;
+                struct ibuf *text = c->breakpoint_sent_text;
+
+                c->breakpoint_sent_text = c->breakpoint_text;
+                c->breakpoint_text = text;
+                c->breakpoint_sent = 1;
 
                 /* At this point, annotate needs to send the breakpoints to the gui.
                  * All of the valid breakpoints are stored in breakpoint_queue. */
-                tgdb_types_append_command(list, response);
+                response = tgdb_types_new_response(c->arena, list,
+                        TGDB_UPDATE_BREAKPOINTS);
+                response->choice.update_breakpoints.breakpoint_list =
+                        c->breakpoint_list;
             }
 
             ibuf_clear(c->breakpoint_string);
+            ibuf_clear(c->breakpoint_text);
             c->breakpoint_enabled = 0;
 
             c->breakpoint_started = 0;
@@ -457,6 +620,7 @@ commands_set_state(struct commands *c,
         case BREAKPOINT_TABLE_BEGIN:
 
             /* The breakpoint queue should be empty at this point */
+            ibuf_clear(c->breakpoint_text);
             c->breakpoint_table = 1;
             c->breakpoint_started = 1;
             break;
@@ -479,6 +643,12 @@ void commands_set_field_num(struct commands *c, int field_num)
     if (c->breakpoint_table && c->cur_command_state == FIELD
             && c->cur_field_num == 5)
         ibuf_clear(c->breakpoint_string);
+
+    /* The number is the first field of a row, it comes after the record */
+    if (c->breakpoint_table && c->cur_field_num == 0) {
+        c->breakpoint_number = 0;
+        c->breakpoint_number_ended = 0;
+    }
 }
 
 enum COMMAND_STATE commands_get_state(struct commands *c)
@@ -503,27 +673,36 @@ commands_prepare_info_source(struct annotate_two *a2, struct commands *c,
     c->info_source_ready = 0;
 }
 
-void
-commands_list_command_finished(struct commands *c,
-        struct tgdb_list *list, int success)
+/* commands_send_source_denied:
+ * ----------------------------
+ *
+ * Tells the gui the last file requested can not be found.
+ */
+static void
+commands_send_source_denied(struct commands *c, struct tgdb_list *list)
 {
-    /* The file does not exist and it can not be opened.
-     * So we return that information to the gui.  */
     struct tgdb_source_file *rejected = (struct tgdb_source_file *)
-            cgdb_malloc(sizeof (struct tgdb_source_file));
-    struct tgdb_response *response = (struct tgdb_response *)
-            cgdb_malloc(sizeof (struct tgdb_response));
+            std_arena_alloc(c->arena, sizeof (struct tgdb_source_file));
+    struct tgdb_response *response;
 
     if (c->last_info_source_requested == NULL)
         rejected->absolute_path = NULL;
     else
         rejected->absolute_path =
-                strdup(ibuf_get(c->last_info_source_requested));
+                std_intern(ibuf_get(c->last_info_source_requested));
 
-    response->header = TGDB_ABSOLUTE_SOURCE_DENIED;
+    response = tgdb_types_new_response(c->arena, list,
+            TGDB_ABSOLUTE_SOURCE_DENIED);
     response->choice.absolute_source_denied.source_file = rejected;
+}
 
-    tgdb_types_append_command(list, response);
+void
+commands_list_command_finished(struct commands *c,
+        struct tgdb_list *list, int success)
+{
+    /* The file does not exist and it can not be opened.
+     * So we return that information to the gui.  */
+    commands_send_source_denied(c, list);
 }
 
 /* This will send to the gui the absolute path to the file being requested. 
@@ -538,38 +717,29 @@ commands_send_source_absolute_source_file(struct commands *c,
 
     /* found */
     if (length > 0) {
-        char *apath = NULL, *rpath = NULL;
+        const char *apath = NULL, *rpath = NULL;
         struct tgdb_response *response;
 
         if (length > 0)
-            apath = ibuf_get(c->info_source_absolute_path);
+            apath = std_intern(ibuf_get(c->info_source_absolute_path));
         if (ibuf_length(c->info_source_relative_path) > 0)
-            rpath = ibuf_get(c->info_source_relative_path);
-
-        response = (struct tgdb_response *)
-                cgdb_malloc(sizeof (struct tgdb_response));
-        response->header = TGDB_FILENAME_PAIR;
-        response->choice.filename_pair.absolute_path = strdup(apath);
-        response->choice.filename_pair.relative_path = strdup(rpath);
-        tgdb_types_append_command(list, response);
+            rpath = std_intern(ibuf_get(c->info_source_relative_path));
+
+        if (rpath && c->last_info_source_requested) {
+            std_ohash_table_insert(c->filename_pairs, (void *)
+                    std_intern(ibuf_get(c->last_info_source_requested)),
+                    (void *) apath);
+            std_ohash_table_insert(c->relative_paths, (void *) apath,
+                    (void *) rpath);
+        }
+
+        response = tgdb_types_new_response(c->arena, list,
+                TGDB_FILENAME_PAIR);
+        response->choice.filename_pair.absolute_path = apath;
+        response->choice.filename_pair.relative_path = rpath;
         /* not found */
-    } else {
-        struct tgdb_source_file *rejected = (struct tgdb_source_file *)
-                cgdb_malloc(sizeof (struct tgdb_source_file));
-        struct tgdb_response *response = (struct tgdb_response *)
-                cgdb_malloc(sizeof (struct tgdb_response));
-
-        response->header = TGDB_ABSOLUTE_SOURCE_DENIED;
-
-        if (c->last_info_source_requested == NULL)
-            rejected->absolute_path = NULL;
-        else
-            rejected->absolute_path =
-                    strdup(ibuf_get(c->last_info_source_requested));
-
-        response->choice.absolute_source_denied.source_file = rejected;
-        tgdb_types_append_command(list, response);
-    }
+    } else
+        commands_send_source_denied(c, list);
 }
 
 static void
@@ -580,21 +750,97 @@ commands_send_source_relative_source_file(struct commands *c,
      * TGDB_UPDATE_FILE_POSITION is needed.
      */
     /* This section allocates a new structure to add into the queue 
-     * All of its members will need to be freed later.
+     * It is freed with the rest of the batch.
      */
     struct tgdb_file_position *tfp = (struct tgdb_file_position *)
-            cgdb_malloc(sizeof (struct tgdb_file_position));
-    struct tgdb_response *response = (struct tgdb_response *)
-            cgdb_malloc(sizeof (struct tgdb_response));
+            std_arena_alloc(c->arena, sizeof (struct tgdb_file_position));
+    struct tgdb_response *response;
 
-    tfp->absolute_path = strdup(ibuf_get(c->absolute_path));
-    tfp->relative_path = strdup(ibuf_get(c->info_source_relative_path));
+    tfp->absolute_path = std_intern(ibuf_get(c->absolute_path));
+    tfp->relative_path = std_intern(ibuf_get(c->info_source_relative_path));
     tfp->line_number = atoi(ibuf_get(c->line_number));
+    tfp->address = c->address;
 
-    response->header = TGDB_UPDATE_FILE_POSITION;
+    response = tgdb_types_new_response(c->arena, list,
+            TGDB_UPDATE_FILE_POSITION);
     response->choice.update_file_position.file_position = tfp;
+}
+
+static int commands_forget_path(void *key, void *value, void *data)
+{
+    return 1;
+}
+
+void commands_invalidate_paths(struct commands *c)
+{
+    std_ohash_table_foreach_remove(c->relative_paths, commands_forget_path,
+            NULL);
+    std_ohash_table_foreach_remove(c->filename_pairs, commands_forget_path,
+            NULL);
+}
+
+int
+commands_send_cached_filename_pair(struct commands *c, const char *file,
+        struct tgdb_list *list)
+{
+    const char *apath, *rpath;
+    struct tgdb_response *response;
+
+    apath = std_ohash_table_lookup(c->filename_pairs, file);
+    if (!apath)
+        return 0;
+
+    rpath = std_ohash_table_lookup(c->relative_paths, apath);
+    if (!rpath)
+        return 0;
+
+    response = tgdb_types_new_response(c->arena, list, TGDB_FILENAME_PAIR);
+    response->choice.filename_pair.absolute_path = apath;
+    response->choice.filename_pair.relative_path = rpath;
+
+    return 1;
+}
+
+/* commands_process_lines:
+ * -----------------------
+ *
+ * Adds a to buf, and calls line each time buf has a whole line in it, with
+ * the '\n' left off. A line can come in over many calls.
+ */
+static void commands_process_lines(struct commands *c, struct ibuf *buf,
+        const char *a, size_t size, struct tgdb_list *list,
+        void (*line) (struct commands * c, struct tgdb_list * list))
+{
+    const char *end = a + size, *nl;
 
-    tgdb_types_append_command(list, response);
+    while (a < end) {
+        nl = memchr(a, '\n', end - a);
+        ibuf_addn(buf, a, (nl ? nl : end) - a);
+        if (!nl)
+            break;
+
+        line(c, list);
+        a = nl + 1;
+    }
+}
+
+/* commands_process_text:
+ * ----------------------
+ *
+ * Adds a to buf, without its '\r' and '\n' chars.
+ */
+static void commands_process_text(struct ibuf *buf, const char *a, size_t size)
+{
+    size_t i, start = 0;
+
+    for (i = 0; i < size; i++) {
+        if (a[i] == '\r' || a[i] == '\n') {
+            ibuf_addn(buf, a + start, i - start);
+            start = i + 1;
+        }
+    }
+
+    ibuf_addn(buf, a + start, size - start);
 }
 
 /* commands_process_info_source:
@@ -602,101 +848,132 @@ commands_send_source_relative_source_file(struct commands *c,
  *
  * This function is capable of parsing the output of 'info source'.
  * It can get both the absolute and relative path to the source file.
+ * It's called with each line of the output.
  */
 static void
-commands_process_info_source(struct commands *c, struct tgdb_list *list, char a)
+commands_process_info_source(struct commands *c, struct tgdb_list *list)
 {
     unsigned long length;
-    static char *info_ptr;
+    char *info_ptr;
 
-    if (c->info_source_ready)   /* Already found */
+    if (c->info_source_ready) { /* Already found */
+        ibuf_clear(c->info_source_string);
         return;
+    }
+
+    /* The '\r' are ignored */
+    if (ibuf_length(c->info_source_string) > 0 &&
+            ibuf_get(c->info_source_string)[ibuf_length(c->
+                            info_source_string) - 1] == '\r')
+        ibuf_delchar(c->info_source_string);
 
     info_ptr = ibuf_get(c->info_source_string);
     length = ibuf_length(c->info_source_string);
 
-    if (a == '\r')
-        return;
+    /* This is the line containing the absolute path to the source file */
+    if (length >= c->source_prefix_length &&
+            strncmp(info_ptr, c->source_prefix,
+                    c->source_prefix_length) == 0) {
+        ibuf_add(c->info_source_absolute_path,
+                info_ptr + c->source_prefix_length);
+        c->info_source_ready = 1;
+
+        /* commands_finalize_command will use the populated data */
+
+        /* This is the line contatining the relative path to the source file */
+    } else if (length >= c->source_relative_prefix_length &&
+            strncmp(info_ptr, c->source_relative_prefix,
+                    c->source_relative_prefix_length) == 0) {
+        ibuf_add(c->info_source_relative_path,
+                info_ptr + c->source_relative_prefix_length);
+    }
 
-    if (a == '\n') {
-        /* This is the line containing the absolute path to the source file */
-        if (length >= c->source_prefix_length &&
-                strncmp(info_ptr, c->source_prefix,
-                        c->source_prefix_length) == 0) {
-            ibuf_add(c->info_source_absolute_path,
-                    info_ptr + c->source_prefix_length);
-            c->info_source_ready = 1;
-            ibuf_clear(c->info_source_string);
-
-            /* commands_finalize_command will use the populated data */
-
-            /* This is the line contatining the relative path to the source file */
-        } else if (length >= c->source_relative_prefix_length &&
-                strncmp(info_ptr, c->source_relative_prefix,
-                        c->source_relative_prefix_length) == 0) {
-            ibuf_add(c->info_source_relative_path,
-                    info_ptr + c->source_relative_prefix_length);
-            ibuf_clear(c->info_source_string);
-        } else
-            ibuf_clear(c->info_source_string);
-    } else
-        ibuf_addchar(c->info_source_string, a);
+    ibuf_clear(c->info_source_string);
 }
 
-static void commands_process_source_line(struct commands *c)
+/* commands_add_source_file:
+ * --------------------------
+ *
+ * Adds a file to the inferior's source files, and to the next batch.
+ */
+static void commands_add_source_file(struct commands *c, const char *file,
+        size_t length)
 {
-    unsigned long length = ibuf_length(c->info_sources_string), i, start = 0;
-    static char *info_ptr;
-    static char *nfile;
+    char *nfile;
 
-    info_ptr = ibuf_get(c->info_sources_string);
+    nfile = cgdb_malloc(length + 1);
+    memcpy(nfile, file, length);
+    nfile[length] = '\0';
+    tgdb_list_append(c->inferior_source_files, nfile);
+    tgdb_list_append(c->source_files_batch, cgdb_strdup(nfile));
+}
 
-    for (i = 0; i < length; ++i) {
-        if (i > 0 && info_ptr[i - 1] == ',' && info_ptr[i] == ' ') {
-            nfile = calloc(sizeof (char), i - start);
-            strncpy(nfile, info_ptr + start, i - start - 1);
-            start += ((i + 1) - start);
-            tgdb_list_append(c->inferior_source_files, nfile);
-        } else if (i == length - 1) {
-            nfile = calloc(sizeof (char), i - start + 2);
-            strncpy(nfile, info_ptr + start, i - start + 1);
-            tgdb_list_append(c->inferior_source_files, nfile);
+/* commands_process_source_files:
+ * ------------------------------
+ *
+ * Adds each file of the line of 'info sources' in info_sources_string,
+ * that hasn't been parsed yet, to the inferior's source files. They're
+ * separated by ", ".
+ *
+ * finished - 1 if the line is over, and what's after the last ", " is a
+ *            file. Otherwise it could be the start of one.
+ */
+static void commands_process_source_files(struct commands *c, int finished)
+{
+    const char *line = ibuf_get(c->info_sources_string);
+    const char *info_ptr = line + c->info_sources_parsed;
+    const char *end = line + ibuf_length(c->info_sources_string);
+    const char *comma;
+
+    while (info_ptr < end) {
+        /* Find the next ", ", a ',' alone is part of the file name */
+        comma = info_ptr;
+        while ((comma = memchr(comma, ',', end - comma)) != NULL &&
+                (comma + 1 == end || comma[1] != ' '))
+            comma++;
+
+        if (!comma) {
+            if (finished)
+                commands_add_source_file(c, info_ptr, end - info_ptr);
+            break;
         }
+
+        commands_add_source_file(c, info_ptr, comma - info_ptr);
+        info_ptr = comma + 2;
     }
+
+    c->info_sources_parsed = info_ptr - line;
 }
 
-/* process's source files */
-static void commands_process_sources(struct commands *c, char a)
+/* process's a line of source files */
+static void commands_process_sources(struct commands *c, struct tgdb_list *list)
 {
     static const char *sourcesReadyString = "Source files for which symbols ";
     static const int sourcesReadyStringLength = 31;
-    static char *info_ptr;
-
-    ibuf_addchar(c->info_sources_string, a);
+    char *info_ptr;
 
-    if (a == '\n') {
-        ibuf_delchar(c->info_sources_string);   /* remove '\n' and null terminate */
-        /* valid lines are 
-         * 1. after the first line,
-         * 2. do not end in ':' 
-         * 3. and are not empty 
-         */
-        info_ptr = ibuf_get(c->info_sources_string);
+    /* valid lines are 
+     * 1. after the first line,
+     * 2. do not end in ':' 
+     * 3. and are not empty 
+     */
+    info_ptr = ibuf_get(c->info_sources_string);
 
-        if (strncmp(info_ptr, sourcesReadyString, sourcesReadyStringLength) ==
-                0)
-            c->sources_ready = 1;
+    if (strncmp(info_ptr, sourcesReadyString, sourcesReadyStringLength) == 0)
+        c->sources_ready = 1;
 
-        /* is this a valid line */
-        if (ibuf_length(c->info_sources_string) > 0 && c->sources_ready
-                && info_ptr[ibuf_length(c->info_sources_string) - 1] != ':')
-            commands_process_source_line(c);
+    /* is this a valid line */
+    if (ibuf_length(c->info_sources_string) > 0 && c->sources_ready
+            && info_ptr[ibuf_length(c->info_sources_string) - 1] != ':')
+        commands_process_source_files(c, 1);
 
-        ibuf_clear(c->info_sources_string);
-    }
+    ibuf_clear(c->info_sources_string);
+    c->info_sources_parsed = 0;
 }
 
-static void commands_process_completion(struct commands *c)
+/* process's a line of completions */
+static void commands_process_completion(struct commands *c,
+        struct tgdb_list *list)
 {
     const char *ptr = ibuf_get(c->tab_completion_string);
     const char *scomplete = "server complete ";
@@ -705,43 +982,47 @@ static void commands_process_completion(struct commands *c)
      * GNAT 3.15p version of GDB. Most likely this could happen with other 
      * implementations that are derived from GDB.
      */
-    if (strncmp(ptr, scomplete, strlen(scomplete)) != 0)
+    if (ibuf_length(c->tab_completion_string) > 0 &&
+            strncmp(ptr, scomplete, strlen(scomplete)) != 0)
         tgdb_list_append(c->tab_completions, strdup(ptr));
+
+    ibuf_clear(c->tab_completion_string);
 }
 
-/* process's source files */
-static void commands_process_complete(struct commands *c, char a)
+void commands_free(struct commands *c, void *item)
 {
-    ibuf_addchar(c->tab_completion_string, a);
+    free((char *) item);
+}
 
-    if (a == '\n') {
-        ibuf_delchar(c->tab_completion_string); /* remove '\n' and null terminate */
+void commands_send_gui_source_batch(struct commands *c,
+        struct tgdb_list *list)
+{
+    struct tgdb_response *response;
 
-        if (ibuf_length(c->tab_completion_string) > 0)
-            commands_process_completion(c);
+    if (tgdb_list_size(c->source_files_batch) == 0)
+        return;
 
-        ibuf_clear(c->tab_completion_string);
-    }
-}
+    response = tgdb_types_new_response(c->arena, list, TGDB_ADD_SOURCE_FILES);
+    response->choice.update_source_files.source_files = c->source_files_batch;
 
-void commands_free(struct commands *c, void *item)
-{
-    free((char *) item);
+    /* The response has the list now */
+    c->source_files_batch = tgdb_list_init();
 }
 
 void commands_send_gui_sources(struct commands *c, struct tgdb_list *list)
 {
+    /* The last of the files go out first */
+    commands_send_gui_source_batch(c, list);
+
     /* If the inferior program was not compiled with debug, then no sources
      * will be available. If no sources are available, do not return the
      * TGDB_UPDATE_SOURCE_FILES command. */
     if (tgdb_list_size(c->inferior_source_files) > 0) {
-        struct tgdb_response *response = (struct tgdb_response *)
-                cgdb_malloc(sizeof (struct tgdb_response));
+        struct tgdb_response *response = tgdb_types_new_response(c->arena,
+                list, TGDB_UPDATE_SOURCE_FILES);
 
-        response->header = TGDB_UPDATE_SOURCE_FILES;
         response->choice.update_source_files.source_files =
                 c->inferior_source_files;
-        tgdb_types_append_command(list, response);
     }
 }
 
@@ -751,31 +1032,55 @@ void commands_send_gui_completions(struct commands *c, struct tgdb_list *list)
      * will be available. If no sources are available, do not return the
      * TGDB_UPDATE_SOURCE_FILES command. */
 /*  if (tgdb_list_size ( c->tab_completions ) > 0)*/
-    struct tgdb_response *response = (struct tgdb_response *)
-            cgdb_malloc(sizeof (struct tgdb_response));
+    struct tgdb_response *response = tgdb_types_new_response(c->arena, list,
+            TGDB_UPDATE_COMPLETIONS);
 
-    response->header = TGDB_UPDATE_COMPLETIONS;
     response->choice.update_completions.completion_list = c->tab_completions;
-    tgdb_types_append_command(list, response);
 }
 
-void commands_process(struct commands *c, char a, struct tgdb_list *list)
+void commands_process(struct commands *c, const char *a, size_t size,
+        struct tgdb_list *list)
 {
     if (commands_get_state(c) == INFO_SOURCES) {
-        commands_process_sources(c, a);
+        commands_process_lines(c, c->info_sources_string, a, size, list,
+                commands_process_sources);
+
+        /* The files are given to the gui while gdb is still listing them,
+         * the lines can be very long */
+        if (c->sources_ready && ibuf_length(c->info_sources_string) > 0)
+            commands_process_source_files(c, 0);
     } else if (commands_get_state(c) == COMPLETE) {
-        commands_process_complete(c, a);
+        commands_process_lines(c, c->tab_completion_string, a, size, list,
+                commands_process_completion);
     } else if (commands_get_state(c) == INFO_LIST) {
         /* do nothing with data */
+    } else if (commands_get_state(c) == DISASSEMBLE) {
+        size_t i;
+
+        /* The lines are kept apart, each instruction is on one */
+        for (i = 0; i < size; i++)
+            if (a[i] != '\r')
+                ibuf_addchar(c->disassemble_text, a[i]);
     } else if (commands_get_state(c) == INFO_SOURCE_FILENAME_PAIR
             || commands_get_state(c) == INFO_SOURCE_RELATIVE) {
-        commands_process_info_source(c, list, a);
+        commands_process_lines(c, c->info_source_string, a, size, list,
+                commands_process_info_source);
     } else if (c->breakpoint_table && c->cur_command_state == FIELD && c->cur_field_num == 5) { /* the file name and line num */
-        if (a != '\n' && a != '\r')
-            ibuf_addchar(c->breakpoint_string, a);
+        commands_process_text(c->breakpoint_string, a, size);
     } else if (c->breakpoint_table && c->cur_command_state == FIELD
-            && c->cur_field_num == 3 && a == 'y') {
+            && c->cur_field_num == 3 && memchr(a, 'y', size)) {
         c->breakpoint_enabled = 1;
+    } else if (c->breakpoint_table && c->cur_command_state == FIELD
+            && c->cur_field_num == 0) {
+        size_t i;
+
+        /* A location of a breakpoint is numbered like 2.1 */
+        for (i = 0; i < size && !c->breakpoint_number_ended; i++) {
+            if (a[i] >= '0' && a[i] <= '9')
+                c->breakpoint_number = c->breakpoint_number * 10 + a[i] - '0';
+            else if (a[i] == '.')
+                c->breakpoint_number_ended = 1;
+        }
     }
 }
 
@@ -817,6 +1122,7 @@ commands_prepare_info_sources(struct annotate_two *a2, struct commands *c)
 {
     c->sources_ready = 0;
     ibuf_clear(c->info_sources_string);
+    c->info_sources_parsed = 0;
     commands_set_state(c, INFO_SOURCES, NULL);
     global_set_start_info_sources(a2->g);
 }
@@ -842,33 +1148,95 @@ void commands_finalize_command(struct commands *c, struct tgdb_list *list)
     switch (commands_get_state(c)) {
         case INFO_SOURCE_RELATIVE:
         case INFO_SOURCE_FILENAME_PAIR:
-            if (c->info_source_ready == 0) {
-                struct tgdb_source_file *rejected = (struct tgdb_source_file *)
-                        cgdb_malloc(sizeof (struct tgdb_source_file));
-                struct tgdb_response *response = (struct tgdb_response *)
-                        cgdb_malloc(sizeof (struct tgdb_response));
-
-                if (c->last_info_source_requested == NULL)
-                    rejected->absolute_path = NULL;
-                else
-                    rejected->absolute_path =
-                            strdup(ibuf_get(c->last_info_source_requested));
-
-                response->header = TGDB_ABSOLUTE_SOURCE_DENIED;
-                response->choice.absolute_source_denied.source_file = rejected;
-                tgdb_types_append_command(list, response);
-            } else {
-                if (commands_get_state(c) == INFO_SOURCE_RELATIVE)
+            if (c->info_source_ready == 0)
+                commands_send_source_denied(c, list);
+            else {
+                if (commands_get_state(c) == INFO_SOURCE_RELATIVE) {
+                    if (ibuf_length(c->info_source_relative_path) > 0)
+                        std_ohash_table_insert(c->relative_paths, (void *)
+                                std_intern(ibuf_get(c->absolute_path)),
+                                (void *) std_intern(ibuf_get(
+                                        c->info_source_relative_path)));
                     commands_send_source_relative_source_file(c, list);
+                }
                 else if (commands_get_state(c) == INFO_SOURCE_FILENAME_PAIR)
                     commands_send_source_absolute_source_file(c, list);
             }
             break;
+        case DISASSEMBLE:
+        {
+            /* Sent even when gdb listed nothing, so the gui stops waiting */
+            struct tgdb_response *response =
+                    tgdb_types_new_response(c->arena, list,
+                    TGDB_UPDATE_DISASSEMBLY);
+
+            response->choice.update_disassembly.disassembly =
+                    tgdb_types_new_disassembly(c->arena,
+                    ibuf_get(c->disassemble_text),
+                    ibuf_length(c->disassemble_text));
+            break;
+        }
         default:
             break;
     }
 }
 
+/* commands_changes_symbols:
+ * -------------------------
+ *
+ *  Determines if a command the user typed can make gdb load other symbols,
+ *  or look for the source files somewhere else. The paths gdb gave before
+ *  may be wrong after it.
+ *
+ *  command: The command, as it is written to gdb.
+ *
+ *  Returns: 1 if it can, 0 otherwise.
+ */
+static int commands_changes_symbols(const char *command)
+{
+    static const char *words[] = {
+        "file", "symbol-file", "add-symbol-file", "remove-symbol-file",
+        "exec-file", "core", "core-file", "sharedlibrary", "nosharedlibrary",
+        "directory", "dir", "run", "r", "start", "starti", "attach",
+        "target", "kill", "detach", NULL
+    };
+    static const char *settings[] = {
+        "substitute-path", "directories", "sysroot", "solib-search-path",
+        NULL
+    };
+    const char **words_ptr = words;
+    size_t length;
+
+    if (!command)
+        return 0;
+
+    while (isspace((unsigned char) *command))
+        command++;
+
+    length = strcspn(command, " \t\n");
+
+    if (length == 3 && strncmp(command, "set", 3) == 0) {
+        command += length;
+        while (isspace((unsigned char) *command))
+            command++;
+        length = strcspn(command, " \t\n");
+        words_ptr = settings;
+    } else if (length == 5 && strncmp(command, "unset", 5) == 0) {
+        command += length;
+        while (isspace((unsigned char) *command))
+            command++;
+        length = strcspn(command, " \t\n");
+        words_ptr = settings;
+    }
+
+    for (; *words_ptr; words_ptr++)
+        if (strlen(*words_ptr) == length &&
+                strncmp(command, *words_ptr, length) == 0)
+            return 1;
+
+    return 0;
+}
+
 int
 commands_prepare_for_command(struct annotate_two *a2,
         struct commands *c, struct tgdb_command *com)
@@ -879,6 +1247,7 @@ commands_prepare_for_command(struct annotate_two *a2,
 
     /* Set the commands state to nothing */
     commands_set_state(c, VOID, NULL);
+    c->info_line = a_com && *a_com == ANNOTATE_INFO_LINE;
 
     /* The list command is no longer running */
     global_list_finished(a2->g);
@@ -889,6 +1258,9 @@ commands_prepare_for_command(struct annotate_two *a2,
     }
 
     if (a_com == NULL) {
+        if (commands_changes_symbols(com->tgdb_command_data))
+            commands_invalidate_paths(c);
+
         data_set_state(a2, USER_COMMAND);
         return 0;
     }
@@ -917,6 +1289,10 @@ commands_prepare_for_command(struct annotate_two *a2,
             commands_prepare_tab_completion(a2, c);
             io_debug_write_fmt("<%s\n>", com->tgdb_command_data);
             break;              /* Nothing to do */
+        case ANNOTATE_DISASSEMBLE:
+            ibuf_clear(c->disassemble_text);
+            commands_set_state(c, DISASSEMBLE, NULL);
+            break;
         case ANNOTATE_INFO_SOURCE:
         case ANNOTATE_SET_PROMPT:
         case ANNOTATE_VOID:
@@ -1030,6 +1406,17 @@ static char *commands_create_command(struct commands *c,
         case ANNOTATE_SET_PROMPT:
             ncom = strdup(data);
             break;
+        case ANNOTATE_DISASSEMBLE:
+            if (data == NULL)
+                ncom = strdup("server disassemble\n");
+            else {
+                ncom = (char *) cgdb_malloc(sizeof (char) * (22 +
+                                strlen(data)));
+                strcpy(ncom, "server disassemble ");
+                strcat(ncom, data);
+                strcat(ncom, "\n");
+            }
+            break;
         case ANNOTATE_VOID:
         default:
             logger_write_pos(logger, __FILE__, __LINE__, "switch error");
@@ -1103,6 +1490,11 @@ commands_issue_command(struct commands *c,
                 (void *) nacom);
     }
 
+    /* One 'info breakpoints' waiting to run is enough, it's issued after
+     * every command */
+    if (client_command && com == ANNOTATE_INFO_BREAKPOINTS)
+        client_command->coalesce = 1;
+
     if (ncom) {
         free(ncom);
         ncom = NULL;
@@ -26,11 +26,15 @@ enum COMMAND_STATE {
     /* Related to the 'info source' command */
     INFO_LIST,
     INFO_SOURCE_FILENAME_PAIR,
-    INFO_SOURCE_RELATIVE
+    INFO_SOURCE_RELATIVE,
+
+    /* Related to the 'disassemble' command */
+    DISASSEMBLE
 };
 
-/* commands_initialize: Initialize the commands unit */
-struct commands *commands_initialize(void);
+/* commands_initialize: Initialize the commands unit. The responses it makes
+ * are allocated in arena. */
+struct commands *commands_initialize(struct std_arena *arena);
 void commands_shutdown(struct commands *c);
 
 /* commands_parse_field: This is called when tgdb gets a field annotation
@@ -86,11 +90,15 @@ int commands_issue_command(struct commands *c,
 
 /* commands_process: This function recieves the output from gdb when gdb
  *                   is running a command on behalf of this package.
+ *                   The output is split into lines in bulk, a line can
+ *                   come in over many calls.
  *
- *    a     -> the character recieved from gdb.
+ *    a     -> the characters recieved from gdb.
+ *    size  -> the number of characters in a.
  *    com   -> commands to give back to gdb.
  */
-void commands_process(struct commands *c, char a, struct tgdb_list *list);
+void commands_process(struct commands *c, const char *a, size_t size,
+        struct tgdb_list *list);
 
 /* commands_list_command_finished: Returns to the gui the absolute path of
  *                                  the filename requested.
@@ -107,6 +115,30 @@ void commands_list_command_finished(struct commands *c,
  */
 void commands_send_gui_sources(struct commands *c, struct tgdb_list *list);
 
+/* commands_send_gui_source_batch: This gives the gui the sources that were
+ *                                 read since the last batch, while gdb is
+ *                                 still listing them.
+ *
+ *    com   -> commands to give back to gdb.
+ */
+void commands_send_gui_source_batch(struct commands *c,
+        struct tgdb_list *list);
+
+/* commands_send_cached_filename_pair: Gives the gui the filename pair of a
+ *                                     file that gdb was asked about before.
+ *
+ *    file  -> The file the gui asked about.
+ *
+ *    RETURNS: 1 if the pair was known and sent, otherwise 0
+ */
+int commands_send_cached_filename_pair(struct commands *c, const char *file,
+        struct tgdb_list *list);
+
+/* commands_invalidate_paths: Forgets the paths gdb gave, after gdb may have
+ *                            loaded other symbols.
+ */
+void commands_invalidate_paths(struct commands *c);
+
 /* This gives the gui all of the completions that were just read from gdb 
  * through a 'complete' command.
  *
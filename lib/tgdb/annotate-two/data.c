@@ -17,6 +17,8 @@
 #include "logger.h"
 #include "a2-tgdb.h"
 #include "sys_util.h"
+#include "stats.h"
+#include "tracer.h"
 
 /**
  * The info stored for each data context.
@@ -48,6 +50,20 @@ struct data {
     char gdb_prompt_last[GDB_PROMPT_SIZE];
 };
 
+/**
+ * The bytes of gdb's output that were parsed in each state, for the
+ * statistics. In the order of enum internal_state.
+ */
+static struct stats_counter stats_state_bytes[] = {
+    STATS_COUNTER("a2 bytes in void"),
+    STATS_COUNTER("a2 bytes at prompt"),
+    STATS_COUNTER("a2 bytes user at prompt"),
+    STATS_COUNTER("a2 bytes post prompt"),
+    STATS_COUNTER("a2 bytes user command"),
+    STATS_COUNTER("a2 bytes gui command"),
+    STATS_COUNTER("a2 bytes internal command")
+};
+
 struct data *data_initialize(void)
 {
     struct data *d = (struct data *) cgdb_malloc(sizeof (struct data));
@@ -95,13 +111,14 @@ void data_set_state(struct annotate_two *a2, enum internal_state state)
                 strcpy(a2->data->gdb_prompt_last, a2->data->gdb_prompt);
                 /* Update the prompt */
                 if (a2->cur_response_list) {
-                    struct tgdb_response *response = (struct tgdb_response *)
-                            cgdb_malloc(sizeof (struct tgdb_response));
+                    struct tgdb_response *response =
+                            tgdb_types_new_response(a2->arena,
+                            a2->cur_response_list,
+                            TGDB_UPDATE_CONSOLE_PROMPT_VALUE);
 
-                    response->header = TGDB_UPDATE_CONSOLE_PROMPT_VALUE;
                     response->choice.update_console_prompt_value.prompt_value =
-                            cgdb_strdup(a2->data->gdb_prompt_last);
-                    tgdb_list_append(a2->cur_response_list, response);
+                            std_arena_strdup(a2->arena,
+                            a2->data->gdb_prompt_last);
                 }
             }
 
@@ -131,6 +148,8 @@ void data_set_state(struct annotate_two *a2, enum internal_state state)
 void data_process(struct annotate_two *a2,
         char a, char *buf, int *n, struct tgdb_list *list)
 {
+    STATS_ADD(&stats_state_bytes[a2->data->data_state], 1);
+
     switch (a2->data->data_state) {
         case VOID:
             buf[(*n)++] = a;
@@ -144,7 +163,7 @@ void data_process(struct annotate_two *a2,
         case GUI_COMMAND:
         case INTERNAL_COMMAND:
             if (a2->data->data_state == INTERNAL_COMMAND)
-                commands_process(a2->c, a, list);
+                commands_process(a2->c, &a, 1, list);
             else if (a2->data->data_state == GUI_COMMAND)
                 buf[(*n)++] = a;
 
@@ -155,3 +174,31 @@ void data_process(struct annotate_two *a2,
             break;
     }                           /* end switch */
 }
+
+void data_process_span(struct annotate_two *a2,
+        const char *a, size_t size, char *buf, int *n, struct tgdb_list *list)
+{
+    size_t i;
+
+    switch (a2->data->data_state) {
+        case VOID:
+        case GUI_COMMAND:
+            STATS_ADD(&stats_state_bytes[a2->data->data_state], size);
+            memcpy(buf + *n, a, size);
+            *n += size;
+            break;
+        case INTERNAL_COMMAND:{
+            unsigned long long span = tracer_begin();
+
+            STATS_ADD(&stats_state_bytes[a2->data->data_state], size);
+            commands_process(a2->c, a, size, list);
+            tracer_end("commands_process", span);
+            break;
+        }
+        default:
+            /* data_process counts these */
+            for (i = 0; i < size; i++)
+                data_process(a2, a[i], buf, n, list);
+            break;
+    }                           /* end switch */
+}
@@ -55,6 +55,18 @@ extern "C" {
     void data_process(struct annotate_two *a2,
             char a, char *buf, int *n, struct tgdb_list *list);
 
+/* data_process_span:  Does what data_process does for each character of a,
+ *                     copying them to buf at once when they all go there.
+ *
+ *    a     -  The characters read from gdb, none of them '\r', '\n' or '\032'.
+ *    size  -  The number of characters in a.
+ *    buf   -  This is a buffer of information that will get returned to the user.
+ *    n     -  This is the current size of buf.
+ */
+    void data_process_span(struct annotate_two *a2,
+            const char *a, size_t size, char *buf, int *n,
+            struct tgdb_list *list);
+
 #ifdef __cplusplus
 }
 #endif
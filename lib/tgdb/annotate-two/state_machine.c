@@ -22,6 +22,7 @@
 #include "annotate_two.h"
 #include "sys_util.h"
 #include "ibuf.h"
+#include "tracer.h"
 
 /* This package looks for annotations coming from gdb's output.
  * The program that is being debugged does not have its ouput pass
@@ -80,11 +81,38 @@ void state_machine_shutdown(struct state_machine *sm)
     sm = NULL;
 }
 
+/**
+ * Finds the next c in data, from an offset on.
+ *
+ * \param next
+ * Where c was found the last time, or -1 if it wasn't looked for yet. It's
+ * still right if it's not before FROM, so memchr only goes over each part
+ * of DATA once for each character.
+ *
+ * @return
+ * Where c is, or size if it's not in the rest of data.
+ */
+static size_t next_char(const char *data, size_t size, size_t from, char c,
+        ssize_t *next)
+{
+    const char *p;
+
+    if (*next == -1 || (size_t) *next < from) {
+        p = memchr(data + from, c, size - from);
+        *next = p ? p - data : size;
+    }
+
+    return *next;
+}
+
 int a2_handle_data(struct annotate_two *a2, struct state_machine *sm,
         const char *data, const size_t size,
         char *gui_data, size_t * gui_size, struct tgdb_list *command_list)
 {
     int i, counter = 0;
+    size_t end;
+    ssize_t next_cr = -1, next_nl = -1, next_z = -1;
+    unsigned long long span = tracer_begin();
 
     /* track state to find next file and line number */
     for (i = 0; i < size; ++i) {
@@ -152,13 +180,18 @@ int a2_handle_data(struct annotate_two *a2, struct state_machine *sm,
             default:
                 switch (sm->tgdb_state) {
                     case DATA:
-                        data_process(a2, data[i], gui_data, &counter,
-                                command_list);
-                        break;
                     case NL_DATA:
+                        /* Everything up to the next special character is
+                         * data, it's passed along at once */
                         sm->tgdb_state = DATA;
-                        data_process(a2, data[i], gui_data, &counter,
-                                command_list);
+                        end = next_char(data, size, i, '\r', &next_cr);
+                        if (next_char(data, size, i, '\n', &next_nl) < end)
+                            end = next_nl;
+                        if (next_char(data, size, i, '\032', &next_z) < end)
+                            end = next_z;
+                        data_process_span(a2, data + i, end - i, gui_data,
+                                &counter, command_list);
+                        i = end - 1;
                         break;
                     case NEW_LINE:
                         sm->tgdb_state = DATA;
@@ -177,7 +210,13 @@ int a2_handle_data(struct annotate_two *a2, struct state_machine *sm,
                                 command_list);
                         break;
                     case ANNOTATION:
-                        ibuf_addchar(sm->tgdb_buffer, data[i]);
+                        /* The annotation runs to the end of the line, it
+                         * goes in at once */
+                        end = next_char(data, size, i, '\r', &next_cr);
+                        if (next_char(data, size, i, '\n', &next_nl) < end)
+                            end = next_nl;
+                        ibuf_addn(sm->tgdb_buffer, data + i, end - i);
+                        i = end - 1;
                         break;
                     default:
                         logger_write_pos(logger, __FILE__, __LINE__,
@@ -190,5 +229,6 @@ int a2_handle_data(struct annotate_two *a2, struct state_machine *sm,
 
     gui_data[counter] = '\0';
     *gui_size = counter;
+    tracer_end("a2_handle_data", span);
     return 0;
 }
@@ -36,7 +36,9 @@ void state_machine_shutdown(struct state_machine *sm);
  * The size of the buffer data.
  *
  * \param gui_data
- * This is the information in DATA that was not an annotation.
+ * This is the information in DATA that was not an annotation. It needs room
+ * for size + 2 bytes and a null terminator, a newline and a ^Z from the
+ * last call may go out ahead of DATA.
  *
  * \param gui_size
  * The size of the buffer gui_data.
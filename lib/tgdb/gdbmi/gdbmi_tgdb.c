@@ -30,7 +30,13 @@
 #include <errno.h>
 #endif /* HAVE_ERRNO_H */
 
+#if HAVE_CTYPE_H
+#include <ctype.h>
+#endif /* HAVE_CTYPE_H */
+
 #include "gdbmi_tgdb.h"
+#include "gdbmi_parser.h"
+#include "gdbmi_oc.h"
 #include "fork_util.h"
 #include "fs_util.h"
 #include "pseudo.h"
@@ -39,21 +45,114 @@
 #include "queue.h"
 #include "sys_util.h"
 #include "ibuf.h"
+#include "std_arena.h"
+#include "std_intern.h"
+#include "std_ohash.h"
+
+/**
+ * Where the MI output of gdb is in a line. Each line is a stream record,
+ * which has text in a C string, a result or asynchronous record, the
+ * prompt, or something that isn't MI at all.
+ */
+enum gdbmi_line_state {
+    /** At the start of a line */
+    GDBMI_LINE_START,
+
+    /** A line that isn't MI, it's shown as it is */
+    GDBMI_LINE_TEXT,
+
+    /** A result or asynchronous record, or the prompt */
+    GDBMI_LINE_RECORD,
+
+    /** After the ~, @ or & of a stream record */
+    GDBMI_LINE_STREAM_OPEN,
+
+    /** In the C string of a stream record */
+    GDBMI_LINE_STREAM,
+
+    /** After a backslash in the C string */
+    GDBMI_LINE_STREAM_ESCAPE,
+
+    /** In an octal escape in the C string */
+    GDBMI_LINE_STREAM_OCTAL,
+
+    /** After the C string of a stream record */
+    GDBMI_LINE_STREAM_CLOSE
+};
+
+/**
+ * Where the text of a stream record goes.
+ */
+enum gdbmi_stream_target {
+    /** Nobody wants it */
+    GDBMI_STREAM_DROP,
+
+    /** The console */
+    GDBMI_STREAM_OUTPUT,
 
-#define PATH_MAX 4096
-#define TTY_NAME_SIZE 64
+    /** A line at a time into the capture buffer */
+    GDBMI_STREAM_CAPTURE,
+
+    /** The log of what gdb prints while the program runs */
+    GDBMI_STREAM_LOG
+};
+
+/**
+ * How far a sample of the running program is, see gdbmi_sample.
+ */
+enum gdbmi_sample_state {
+    /** No sample is being taken */
+    GDBMI_SAMPLE_IDLE,
+
+    /** The interrupt was sent, the program didn't stop yet */
+    GDBMI_SAMPLE_WAITING,
+
+    /** The program stopped, its frames are listed and it's continued */
+    GDBMI_SAMPLE_TAKING
+};
+
+/**
+ * A breakpoint gdb told about.
+ */
+struct gdbmi_breakpoint {
+    int number;
+
+    /** The file, interned */
+    const char *file;
+    char *funcname;
+    int line;
+    int enabled;
+    int hits;
+
+    /** 1 if its number is in changed_breakpoints */
+    int changed;
+};
+
+/**
+ * The paths gdb found for a file the front end asked about, interned.
+ */
+struct gdbmi_filename_pair {
+    const char *absolute_path;
+    const char *relative_path;
+};
 
 /**
  * This is the main context for the gdbmi subsytem.
  */
 struct tgdb_gdbmi {
 
-    /** 
+    /**
 	 * This is set when this context has initialized itself
 	 */
     int tgdb_initialized;
 
-    /** 
+    /**
+	 * The arena the responses and what they point to are allocated in.
+	 * TGDB resets it after each batch of responses.
+	 */
+    struct std_arena *arena;
+
+    /**
 	 * writing to this will write to the stdin of the debugger
 	 */
     int debugger_stdin;
@@ -63,133 +162,393 @@ struct tgdb_gdbmi {
 	 */
     int debugger_out;
 
-    /**
-     * writing to this will write to the stdin of the inferior
-	 */
-    int inferior_stdin;
-
-    /**
-	 * Reading from reads the stdout/stderr of the inferior
-	 */
-    int inferior_out;
+    /** The master, slave and slavename of the pty device */
+    pty_pair_ptr pty_pair;
 
     /**
-	 * Only kept around so it can be closed properly
-	 */
-    int inferior_slave_fd;
-
-    /** 
 	 * pid of child process.
 	 */
     pid_t debugger_pid;
 
-    /** 
+    /**
 	 * The config directory that this context can write too.
 	 */
-    char config_dir[PATH_MAX];
+    char config_dir[FSUTIL_PATH_MAX];
 
     /**
 	 * The init file for the debugger.
 	 */
-    char gdbmi_gdb_init_file[PATH_MAX];
+    char gdbmi_gdb_init_file[FSUTIL_PATH_MAX];
 
     /**
-	 * The name of the inferior tty.
-	 */
-    char inferior_tty_name[TTY_NAME_SIZE];
-
-    /** 
-	 * This is a list of all the commands generated since in the last call. 
+	 * This is a list of all the commands generated since in the last call.
 	 */
     struct tgdb_list *client_command_list;
 
     /**
-	 * This is the current output command from GDB.
-	 */
-    struct ibuf *tgdb_cur_output_command;
+     * The MI parser.
+     */
+    gdbmi_parser_ptr parser;
+
+    /**
+     * The record being received. Each record goes to the parser when its
+     * line is complete, the parser keeps them until the prompt ends the
+     * output command.
+     */
+    struct ibuf *record_line;
+
+    /** Where the output of gdb is in the line */
+    enum gdbmi_line_state line_state;
+
+    /** Where the text of the stream record being received goes */
+    enum gdbmi_stream_target stream_target;
+
+    /** The first character of the stream record, ~, @ or & */
+    char stream_kind;
+
+    /** 1 if the stream being received is the message of an error record */
+    int stream_in_record;
+
+    /** The value and the number of digits of the octal escape so far */
+    int octal, octal_digits;
+
+    /**
+     * The command gdb is running. GDBMI_VOID means it's the user's, or gdb
+     * is running none.
+     */
+    enum gdbmi_commands command;
+
+    /** 1 if the user's command is an MI command, and not a CLI one */
+    int mi_command;
+
+    /** 0 until the echo of the user's CLI command is skipped */
+    int echo_skipped;
+
+    /** 1 if the user's command can select another frame */
+    int frame_command;
+
+    /** 1 if the position of the frame was sent for the current command */
+    int frame_reported;
+
+    /**
+     * A stop the front end is told about at the end of the input it came
+     * in, unless the thread runs again before, as it does when the commands
+     * of a breakpoint continue it. Such a hit isn't shown at all.
+     */
+    int stop_pending, stop_thread, stop_all_threads;
+    struct tgdb_file_position *stop_position;
+
+    /** 1 while the inferior is running, in all-stop mode */
+    int running;
+
+    /** 1 once gdb is in non-stop mode, and what the command that sets it
+     * asks for */
+    int non_stop, non_stop_asked;
+
+    /** The thread gdb looks at, 0 if it's not known */
+    int thread;
+
+    /**
+     * Which threads run: all of them but the exceptions if threads_running
+     * is 1, otherwise only the exceptions, in the order of their numbers.
+     * In non-stop mode, each thread runs and stops by itself.
+     */
+    int threads_running;
+    int *thread_exceptions;
+    int thread_exceptions_count, thread_exceptions_size;
+
+    /** How far the sample being taken is, and how many frames it lists */
+    enum gdbmi_sample_state sample_state;
+    int sample_depth;
+
+    /** 1 if the user interrupted the program while a sample was taken */
+    int sample_cancelled;
+
+    /** 1 if gdb is waiting at the prompt */
+    int at_prompt;
+
+    /** 1 once the prompt was told to the front end */
+    int prompt_sent;
+
+    /** 1 if the file that was asked for couldn't be listed */
+    int list_failed;
+
+    /** The file the front end asked the path of last */
+    char *last_file_requested;
+
+    /**
+     * 1 while gdb debugs a core dump. Nothing in it changes then, so the
+     * paths gdb found for each file the front end asked about are kept,
+     * as a 'struct gdbmi_filename_pair *' by the interned file, and gdb
+     * isn't asked again.
+     */
+    int core;
+    struct std_ohashtable *filename_pairs;
+
+    /** 1 if the user's command can load a core dump, and if the output of
+     * the command that lists the target said it is one */
+    int core_command;
+    int core_found;
+
+    /** The lines of the console output of the current command */
+    struct ibuf *capture;
+
+    /**
+     * What gdb printed on the console while the program ran, since the
+     * last of it was sent. It goes to the log, unless a *stopped comes
+     * first: then it was gdb saying why the program stopped.
+     */
+    struct ibuf *log;
+
+    /** The console output of a disassemble command, newlines and all */
+    struct ibuf *disassembly;
+
+    /** How many bytes the memory command being run asked for */
+    int memory_length;
+
+    /** The thread and the level of the first frame the frames command
+     * being run lists */
+    int frames_thread;
+    int frames_low;
+
+    /**
+     * The threads that were started, exited or selected since the last
+     * update, in the order gdb told about them.
+     */
+    struct tgdb_thread_change *thread_changes;
+    int thread_changes_count, thread_changes_size;
+
+    /** The breakpoints, in the order of their numbers */
+    struct gdbmi_breakpoint *breakpoints;
+    int breakpoints_count, breakpoints_size;
+
+    /** 1 if all of the breakpoints are sent next, after a '-break-list' */
+    int breakpoints_changed;
+
+    /**
+     * The numbers of the breakpoints that changed since they were sent,
+     * in the order they changed. gdb tells about each one that changes.
+     */
+    int *changed_breakpoints;
+    int changed_breakpoints_count, changed_breakpoints_size;
+
+    /** 1 if the user's MI command can change breakpoints */
+    int break_command;
+
+    /** The lists the front end gets, they stay around */
+    struct tgdb_list *breakpoint_list;
+    struct tgdb_list *source_files;
+    struct tgdb_list *completions;
 };
 
-#if 0
-//static int gdbmi_set_inferior_tty ( void *ctx ) {
-//  struct annotate_two *a2 = (struct annotate_two *)ctx;
-//
-//    if ( commands_issue_command ( 
-//              a2->c, 
-//              a2->client_command_list,
-//              ANNOTATE_TTY, 
-//              a2->inferior_tty_name, 
-//              0 ) == -1 ) {
-//        err_msg("%s:%d commands_issue_command error", __FILE__, __LINE__);
-//        return -1;
-//    }
-//
-//    return 0;
-//}
-//
-///* This is ok as static, all references will use the same data. */
-//static char *gdbmi_tgdb_commands[] = {
-//  "continue",
-//  "finish",
-//  "next",
-//  "run",
-//  "step",
-//  "up",
-//  "down"
-//};
-//
-//
-//static int close_inferior_connection ( void *ctx ) {
-//  struct annotate_two *a2 = (struct annotate_two *)ctx;
-//
-//  if ( a2->inferior_stdin != -1 )
-//      cgdb_close ( a2->inferior_stdin );
-//
-//  a2->inferior_stdin = -1;
-//  a2->inferior_out   = -1;
-//  
-//  /* close tty connection */
-//  if ( a2->inferior_slave_fd != -1 )
-//      cgdb_close ( a2->inferior_slave_fd );
-//
-//  a2->inferior_slave_fd = -1;
-//
-//  if ( a2->inferior_tty_name[0] != '\0' )
-//      pty_release ( a2->inferior_tty_name );
-//
-//  return 0;
-//}
-//
-///* Here are the two functions that deal with getting tty information out
-// * of the annotate_two subsystem.
-// */
-//
-//int gdbmi_open_new_tty ( 
-//      void *ctx,
-//      int *inferior_stdin, 
-//      int *inferior_stdout ) {
-//  struct annotate_two *a2 = (struct annotate_two *)ctx;
-//
-//    close_inferior_connection(a2);
-//
-//  /* Open up the tty communication */
-//  if ( util_new_tty(&(a2->inferior_stdin), &(a2->inferior_slave_fd), a2->inferior_tty_name) == -1){
-//      err_msg("%s:%d -> Could not open child tty", __FILE__, __LINE__);
-//      return -1;
-//  }
-//
-//  *inferior_stdin     = a2->inferior_stdin;
-//  *inferior_stdout    = a2->inferior_stdin;
-//
-//    a2_set_inferior_tty ( a2 );
-//    
-//    return 0;
-//}
-//
-//char *a2_get_tty_name ( void *ctx ) {
-//  struct annotate_two *a2 = (struct annotate_two *)ctx;
-//  return a2->inferior_tty_name;
-//}
-#endif
+/* gdbmi_issue_command:
+ * --------------------
+ *
+ *  Queues a command of tgdb's to run through gdb.
+ *
+ *  command: The command, without the newline.
+ *  data:    The argument, or NULL.
+ *
+ *  Returns: 0 on success, or -1 on error.
+ */
+static int gdbmi_issue_command(struct tgdb_gdbmi *gdbmi,
+        enum gdbmi_commands command, const char *data)
+{
+    struct tgdb_command *client_command;
+    enum gdbmi_commands *ncommand;
+    struct ibuf *ncom = ibuf_init();
+
+    switch (command) {
+        case GDBMI_INFO_BREAKPOINTS:
+            ibuf_add(ncom, "-break-list");
+            break;
+        case GDBMI_TTY:
+            ibuf_add(ncom, "-inferior-tty-set ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_COMPLETE:
+            ibuf_add(ncom, "complete ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_INFO_SOURCES:
+            ibuf_add(ncom, "-file-list-exec-source-files");
+            break;
+        case GDBMI_INFO_SOURCE_RELATIVE:
+        case GDBMI_INFO_SOURCE_ABSOLUTE:
+            ibuf_add(ncom, "-file-list-exec-source-file");
+            break;
+        case GDBMI_INFO_FRAME:
+            ibuf_add(ncom, "-stack-info-frame");
+            break;
+        case GDBMI_LIST_SOURCE:
+            /* Listing a file makes it the current source file */
+            ibuf_add(ncom, "list");
+            if (data) {
+                ibuf_add(ncom, " \"");
+                ibuf_add(ncom, data);
+                ibuf_add(ncom, "\":1");
+            }
+            break;
+        case GDBMI_DISASSEMBLE:
+            ibuf_add(ncom, "disassemble");
+            if (data) {
+                ibuf_addchar(ncom, ' ');
+                ibuf_add(ncom, data);
+            }
+            break;
+        case GDBMI_VARIABLE_CREATE:
+            /* A floating one, evaluated in the frame gdb is at each time */
+            ibuf_add(ncom, "-var-create - @ \"");
+            for (; *data; data++) {
+                if (*data == '"' || *data == '\\')
+                    ibuf_addchar(ncom, '\\');
+                ibuf_addchar(ncom, *data);
+            }
+            ibuf_addchar(ncom, '"');
+            break;
+        case GDBMI_VARIABLE_UPDATE:
+            ibuf_add(ncom, "-var-update --all-values *");
+            break;
+        case GDBMI_VARIABLE_CHILDREN:
+            ibuf_add(ncom, "-var-list-children --all-values ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_VARIABLE_DELETE:
+            ibuf_add(ncom, "-var-delete ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_VARIABLE_DELETE_CHILDREN:
+            ibuf_add(ncom, "-var-delete -c ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_LOCALS:
+            ibuf_add(ncom, "-stack-list-variables --no-values");
+            break;
+        case GDBMI_READ_MEMORY:
+            ibuf_add(ncom, "-data-read-memory-bytes ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_LIST_FRAMES:
+            ibuf_add(ncom, "-stack-list-frames ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_SELECT_FRAME:
+            ibuf_add(ncom, "-stack-select-frame ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_SELECT_THREAD:
+            ibuf_add(ncom, "-thread-select ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_SAMPLE_FRAMES:
+            ibuf_add(ncom, "-stack-list-frames ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_SAMPLE_CONTINUE:
+            ibuf_add(ncom, "-exec-continue");
+            break;
+        case GDBMI_MI_ASYNC:
+            ibuf_add(ncom, "-gdb-set mi-async ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_NON_STOP:
+            ibuf_add(ncom, "-gdb-set non-stop ");
+            ibuf_add(ncom, data);
+            break;
+        case GDBMI_INTERRUPT:
+            ibuf_add(ncom, "-exec-interrupt");
+            if (data) {
+                ibuf_addchar(ncom, ' ');
+                ibuf_add(ncom, data);
+            }
+            break;
+        case GDBMI_INFO_TARGET:
+            ibuf_add(ncom, "info target");
+            break;
+        case GDBMI_VOID:
+        default:
+            logger_write_pos(logger, __FILE__, __LINE__, "switch error");
+            ibuf_free(ncom);
+            return -1;
+    }
+
+    ibuf_addchar(ncom, '\n');
+
+    ncommand = (enum gdbmi_commands *) cgdb_malloc(sizeof (enum
+                    gdbmi_commands));
+    *ncommand = command;
+
+    /* A sample goes before the commands that wait for the program to
+     * stop, it's only stopped for as long as the sample takes. So does an
+     * interrupt, like the user's ^c */
+    client_command = tgdb_command_create(ibuf_get(ncom),
+            command == GDBMI_SAMPLE_FRAMES || command == GDBMI_SAMPLE_CONTINUE ||
+            command == GDBMI_INTERRUPT ?
+            TGDB_COMMAND_TGDB_CLIENT_PRIORITY : TGDB_COMMAND_TGDB_CLIENT,
+            (void *) ncommand);
+
+    /* One '-break-list' waiting to run is enough, it's issued after
+     * each MI command that changes breakpoints */
+    if (command == GDBMI_INFO_BREAKPOINTS)
+        client_command->coalesce = 1;
+
+    ibuf_free(ncom);
+
+    tgdb_list_append(gdbmi->client_command_list, client_command);
+
+    return 0;
+}
+
+static int gdbmi_set_inferior_tty(struct tgdb_gdbmi *gdbmi)
+{
+    if (gdbmi_issue_command(gdbmi, GDBMI_TTY,
+                    pty_pair_get_slavename(gdbmi->pty_pair)) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int close_inferior_connection(struct tgdb_gdbmi *gdbmi)
+{
+    if (gdbmi->pty_pair)
+        pty_pair_destroy(gdbmi->pty_pair);
+    gdbmi->pty_pair = NULL;
+
+    return 0;
+}
+
+int gdbmi_open_new_tty(void *ctx, int *inferior_stdin, int *inferior_stdout)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+
+    close_inferior_connection(gdbmi);
+
+    gdbmi->pty_pair = pty_pair_create();
+    if (!gdbmi->pty_pair) {
+        logger_write_pos(logger, __FILE__, __LINE__, "pty_pair_create failed");
+        return -1;
+    }
+
+    *inferior_stdin = pty_pair_get_masterfd(gdbmi->pty_pair);
+    *inferior_stdout = pty_pair_get_masterfd(gdbmi->pty_pair);
+
+    gdbmi_set_inferior_tty(gdbmi);
+
+    return 0;
+}
+
+const char *gdbmi_get_tty_name(void *ctx)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+
+    if (!gdbmi->pty_pair)
+        return NULL;
+
+    return pty_pair_get_slavename(gdbmi->pty_pair);
+}
 
 /* initialize_gdbmi
  *
@@ -200,23 +559,26 @@ static struct tgdb_gdbmi *initialize_tgdb_gdbmi(void)
     struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *)
             cgdb_malloc(sizeof (struct tgdb_gdbmi));
 
+    memset(gdbmi, 0, sizeof (struct tgdb_gdbmi));
+
     gdbmi->tgdb_initialized = 0;
     gdbmi->debugger_stdin = -1;
     gdbmi->debugger_out = -1;
 
-    gdbmi->inferior_stdin = -1;
-    gdbmi->inferior_out = -1;
-    gdbmi->inferior_slave_fd = -1;
-    gdbmi->inferior_tty_name[0] = '\0';
+    gdbmi->pty_pair = NULL;
 
     /* null terminate */
     gdbmi->config_dir[0] = '\0';
     gdbmi->gdbmi_gdb_init_file[0] = '\0';
 
+    gdbmi->line_state = GDBMI_LINE_START;
+    gdbmi->command = GDBMI_VOID;
+    gdbmi->echo_skipped = 1;
+
     return gdbmi;
 }
 
-/* tgdb_setup_config_file: 
+/* tgdb_setup_config_file:
  * -----------------------
  *  Creates a config file for the user.
  *
@@ -234,7 +596,7 @@ static int tgdb_setup_config_file(struct tgdb_gdbmi *gdbmi, const char *dir)
     fs_util_get_path(dir, "gdbmi_gdb_init", gdbmi->gdbmi_gdb_init_file);
 
     if ((fp = fopen(gdbmi->gdbmi_gdb_init_file, "w"))) {
-        fprintf(fp, "set height 0\n" "set prompt (tgdbmi) \n");
+        fprintf(fp, "set height 0\n");
         fclose(fp);
     } else {
         logger_write_pos(logger, __FILE__, __LINE__, "fopen error '%s'",
@@ -246,11 +608,14 @@ static int tgdb_setup_config_file(struct tgdb_gdbmi *gdbmi, const char *dir)
 }
 
 void *gdbmi_create_context(const char *debugger,
-        int argc, char **argv, const char *config_dir, struct logger *logger)
+        int argc, char **argv, const char *config_dir,
+        struct std_arena *arena, struct logger *logger)
 {
 
     struct tgdb_gdbmi *gdbmi = initialize_tgdb_gdbmi();
-    char gdbmi_debug_file[PATH_MAX];
+    char gdbmi_debug_file[FSUTIL_PATH_MAX];
+
+    gdbmi->arena = arena;
 
     if (!tgdb_setup_config_file(gdbmi, config_dir)) {
         logger_write_pos(logger, __FILE__, __LINE__,
@@ -259,7 +624,7 @@ void *gdbmi_create_context(const char *debugger,
     }
 
     /* Initialize the debug file that gdbmi_tgdb writes to */
-    fs_util_get_path(config_dir, "gdbmi_tgdb_debug.txt", gdbmi_debug_file);
+    fs_util_get_path(config_dir, "gdbmi_tgdb_debug.trace", gdbmi_debug_file);
 
     io_debug_init(gdbmi_debug_file);
 
@@ -272,11 +637,31 @@ void *gdbmi_create_context(const char *debugger,
     if (gdbmi->debugger_pid == -1)
         return NULL;
 
-    gdbmi->tgdb_cur_output_command = ibuf_init();
+    gdbmi->parser = gdbmi_parser_create();
+    if (!gdbmi->parser) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_parser_create error");
+        return NULL;
+    }
+
+    /* The front end reads a few results of each record, the rest of a
+     * record is never decoded */
+    gdbmi_parser_set_lazy(gdbmi->parser, 1);
+
+    gdbmi->record_line = ibuf_init();
+    gdbmi->capture = ibuf_init();
+    gdbmi->log = ibuf_init();
+    gdbmi->disassembly = ibuf_init();
 
     return gdbmi;
 }
 
+static int gdbmi_free_string(void *item)
+{
+    free(item);
+    return 0;
+}
+
 int gdbmi_initialize(void *ctx,
         int *debugger_stdin, int *debugger_stdout,
         int *inferior_stdin, int *inferior_stdout)
@@ -284,342 +669,2321 @@ int gdbmi_initialize(void *ctx,
     struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
 
     gdbmi->client_command_list = tgdb_list_init();
+    gdbmi->breakpoint_list = tgdb_list_init();
+    gdbmi->source_files = tgdb_list_init();
+    gdbmi->completions = tgdb_list_init();
+    gdbmi->filename_pairs = std_ohash_table_new_full(NULL, NULL, NULL,
+            gdbmi_free_string);
 
     *debugger_stdin = gdbmi->debugger_stdin;
     *debugger_stdout = gdbmi->debugger_out;
 
-    gdbmi->tgdb_initialized = 1;
+    gdbmi_open_new_tty(gdbmi, inferior_stdin, inferior_stdout);
+
+    /* gdb may already have some breakpoints when it starts. This could happen
+     * if the user puts breakpoints in there .gdbinit.
+     * This makes sure that TGDB asks for the breakpoints on start up.
+     */
+    if (gdbmi_issue_command(gdbmi, GDBMI_INFO_BREAKPOINTS, NULL) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
 
-#if 0
-    /* Need to set the prompt via a tgdb_response */
-    struct tgdb_client_command *client_command = NULL;
+    gdbmi->tgdb_initialized = 1;
 
-    client_command = tgdb_client_command_create("(tgdbmi) ",
-            TGDB_CLIENT_COMMAND_TGDB_BASE,
-            TGDB_CLIENT_COMMAND_DISPLAY_NOTHING,
-            TGDB_CLIENT_COMMAND_ACTION_CONSOLE_SET_PROMPT, NULL);
+    return 0;
+}
 
-    tgdb_list_append(gdbmi->client_command_list, client_command);
-#endif
+static int gdbmi_free_breakpoint(void *item)
+{
+    struct tgdb_breakpoint *tb = (struct tgdb_breakpoint *) item;
 
+    /* The file is interned */
+    free(tb->funcname);
+    free(tb);
     return 0;
 }
 
+/* gdbmi_clear_breakpoints:
+ * ------------------------
+ *
+ *  Forgets every breakpoint.
+ */
+static void gdbmi_clear_breakpoints(struct tgdb_gdbmi *gdbmi)
+{
+    int i;
+
+    for (i = 0; i < gdbmi->breakpoints_count; i++)
+        free(gdbmi->breakpoints[i].funcname);
+
+    /* The ones that changed are sent with the rest */
+    gdbmi->breakpoints_changed = 1;
+    gdbmi->breakpoints_count = 0;
+    gdbmi->changed_breakpoints_count = 0;
+}
+
 int gdbmi_shutdown(void *ctx)
 {
     struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
 
     cgdb_close(gdbmi->debugger_stdin);
 
-    ibuf_free(gdbmi->tgdb_cur_output_command);
-    gdbmi->tgdb_cur_output_command = NULL;
+    close_inferior_connection(gdbmi);
+
+    gdbmi_parser_destroy(gdbmi->parser);
+    gdbmi->parser = NULL;
+
+    ibuf_free(gdbmi->record_line);
+    gdbmi->record_line = NULL;
+    ibuf_free(gdbmi->capture);
+    ibuf_free(gdbmi->log);
+    gdbmi->capture = NULL;
+    ibuf_free(gdbmi->disassembly);
+    gdbmi->disassembly = NULL;
+
+    free(gdbmi->last_file_requested);
+    gdbmi->last_file_requested = NULL;
+    std_ohash_table_destroy(gdbmi->filename_pairs);
+    gdbmi->filename_pairs = NULL;
+
+    gdbmi_clear_breakpoints(gdbmi);
+    free(gdbmi->breakpoints);
+    gdbmi->breakpoints = NULL;
+    free(gdbmi->changed_breakpoints);
+    gdbmi->changed_breakpoints = NULL;
+    free(gdbmi->thread_changes);
+    gdbmi->thread_changes = NULL;
+    free(gdbmi->thread_exceptions);
+    gdbmi->thread_exceptions = NULL;
+
+    if (gdbmi->tgdb_initialized) {
+        tgdb_list_free(gdbmi->breakpoint_list, gdbmi_free_breakpoint);
+        tgdb_list_destroy(gdbmi->breakpoint_list);
+        tgdb_list_free(gdbmi->source_files, gdbmi_free_string);
+        tgdb_list_destroy(gdbmi->source_files);
+        tgdb_list_free(gdbmi->completions, gdbmi_free_string);
+        tgdb_list_destroy(gdbmi->completions);
+    }
 
     return 0;
 }
 
-#if 0
 /* TODO: Implement error messages. */
-//int a2_err_msg ( void *ctx ) {
-//  return -1;
-//}
-#endif
+int gdbmi_err_msg(void *ctx)
+{
+    return -1;
+}
 
 int gdbmi_is_client_ready(void *ctx)
 {
-    return 1;
-}
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
 
-enum newlinestyle {
-    GDBMI_NL,
-    GDBMI_CR_NL,
-    GDBMI_CR
-};
+    if (!gdbmi->tgdb_initialized)
+        return 0;
 
-/**
- * Checks to see if ibuf ends with the string ending.
- *
- * \param ibuf
- * The string to check the ending of
+    return gdbmi->at_prompt;
+}
+
+/* gdbmi_append_response:
+ * ----------------------
  *
- * \param style
- * represents what kind of newline is associated with this command.
+ *  Adds a response with the header given to the list, and returns it to
+ *  be filled in.
+ */
+static struct tgdb_response *gdbmi_append_response(struct tgdb_gdbmi *gdbmi,
+        struct tgdb_list *list, enum INTERFACE_RESPONSE_COMMANDS header)
+{
+    return tgdb_types_new_response(gdbmi->arena, list, header);
+}
+
+/* gdbmi_dup_text:
+ * ---------------
  *
- * \param success
- * 1 if ibuf ends with ending, otherwise 0
+ *  Copies a string gdb sent, for the front end to keep.
  *
- * \return
- * 0 on success, or -1 on error
+ *  Returns: The copy, or NULL if gdb didn't send the string.
  */
-static int ends_with_gdbmi_prompt(struct ibuf *ibuf, enum newlinestyle style,
-        int *success)
+static char *gdbmi_dup_text(gdbmi_cstring_ptr cstring)
 {
-    char *ibuf_string;
-    int length;
+    const char *text;
+    size_t length;
+    char *result;
 
-    if (!ibuf)
-        return -1;
-
-    if (!success)
-        return -1;
-
-    *success = 0;
-
-    length = ibuf_length(ibuf);
-
-    /* If the string is not long enough, don't try */
-    if (style == GDBMI_CR_NL && length < 8)
-        return 0;
-    else if (length < 7)
-        return 0;
+    if (!cstring)
+        return NULL;
 
-    ibuf_string = ibuf_get(ibuf);
+    text = gdbmi_cstring_text(cstring, &length);
+    result = (char *) cgdb_malloc(length + 1);
+    memcpy(result, text, length + 1);
 
-    /* Match the char's backwards, go to the end */
-    ibuf_string = ibuf_string + length - 1;
+    return result;
+}
 
-    if (style == GDBMI_CR_NL)
-        ibuf_string -= 2;
-    else
-        ibuf_string--;
+/* gdbmi_response_text:
+ * --------------------
+ *
+ *  Copies a string gdb sent into the arena of the responses, for the front
+ *  end to read until the next batch.
+ *
+ *  Returns: The copy, or NULL if gdb didn't send the string.
+ */
+static char *gdbmi_response_text(struct tgdb_gdbmi *gdbmi,
+        gdbmi_cstring_ptr cstring)
+{
+    const char *text;
+    size_t length;
+    char *result;
 
-    /* Check for the prompt */
-    if (*(ibuf_string) == ' ' &&
-            *(ibuf_string - 1) == ')' &&
-            *(ibuf_string - 2) == 'b' &&
-            *(ibuf_string - 3) == 'd' &&
-            *(ibuf_string - 4) == 'g' && *(ibuf_string - 5) == '(')
-        *success = 1;
+    if (!cstring)
+        return NULL;
 
-    /* Look at newline */
-    return 0;
+    text = gdbmi_cstring_text(cstring, &length);
+    result = (char *) std_arena_alloc(gdbmi->arena, length + 1);
+    memcpy(result, text, length + 1);
 
+    return result;
 }
 
-/**
- * Determine's what kind of newline the string ends in.
+/* gdbmi_response_path:
+ * --------------------
  *
+ *  Gets the interned copy of a path gdb sent, for the front end to keep.
+ *
+ *  Returns: The path, or NULL if gdb didn't send it.
  */
-static int gdbmi_get_newline_style(struct ibuf *ibuf, enum newlinestyle *style)
+static const char *gdbmi_response_path(gdbmi_cstring_ptr cstring)
 {
-    char *buf;
-    int length;
+    if (!cstring)
+        return NULL;
 
-    if (!ibuf)
-        return -1;
+    return std_intern(gdbmi_cstring_text(cstring, NULL));
+}
 
-    if (!style)
-        return -1;
+/* gdbmi_file_position:
+ * --------------------
+ *
+ *  Gets the file and line gdb is at, for the front end.
+ *
+ *  Returns: The position, in the arena of the responses, or NULL if gdb
+ *           couldn't find the file.
+ */
+static struct tgdb_file_position *gdbmi_file_position(
+        struct tgdb_gdbmi *gdbmi, gdbmi_cstring_ptr fullname,
+        gdbmi_cstring_ptr file, int line, unsigned long address,
+        gdbmi_cstring_ptr function)
+{
+    struct tgdb_file_position *tfp;
 
-    buf = ibuf_get(ibuf);
-    length = ibuf_length(ibuf);
+    if (!fullname || !file)
+        return NULL;
 
-    /* Check to see if an entire command has been reached. */
-    if (buf[length - 1] == '\r') {
-        *style = GDBMI_CR;
-    } else if (buf[length - 1] == '\n') {
-        if (length > 1 && buf[length - 2] == '\r')
-            *style = GDBMI_CR_NL;
-        else
-            *style = GDBMI_NL;
-    }
+    tfp = (struct tgdb_file_position *)
+            std_arena_alloc(gdbmi->arena, sizeof (struct tgdb_file_position));
+    tfp->absolute_path = gdbmi_response_path(fullname);
+    tfp->relative_path = gdbmi_response_path(file);
+    tfp->line_number = line;
+    tfp->address = address;
+    tfp->function = gdbmi_response_text(gdbmi, function);
 
-    return 0;
+    return tfp;
 }
 
-/* 
- * 1. Align the 'input' data into null-terminated strings that
- *    end in a newline.
- * 2. Check to see if a command has been fully recieved.
- *    2a. If it has, go to step 3
- *    2b. If it hasn't, return from the function
- * 3. parse the command.
- * 4. traverse the parse tree to populate the tgdb_list with
- *    commands the user/front end is looking for.
+/* gdbmi_frame_position:
+ * ---------------------
+ *
+ *  Gets the file and line a frame is at, NULL if it's not known.
  */
-int gdbmi_parse_io(void *ctx,
-        const char *input_data, const size_t input_data_size,
-        char *debugger_output, size_t * debugger_output_size,
-        char *inferior_output, size_t * inferior_output_size,
-        struct tgdb_list *list)
+static struct tgdb_file_position *gdbmi_frame_position(
+        struct tgdb_gdbmi *gdbmi, gdbmi_oc_frame_ptr frame)
 {
-    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
-    int found_command = 0;
-    enum newlinestyle style = GDBMI_NL;
+    unsigned long address = 0;
 
-    ibuf_add(gdbmi->tgdb_cur_output_command, input_data);
+    if (!frame)
+        return NULL;
 
-    if (input_data[input_data_size - 1] == '\r' ||
-            input_data[input_data_size - 1] == '\n') {
-        if (gdbmi_get_newline_style(gdbmi->tgdb_cur_output_command,
-                        &style) == -1) {
-            logger_write_pos(logger, __FILE__, __LINE__,
-                    "gdbmi_get_newline_stlye error");
-            return -1;
-        }
+    if (frame->address)
+        address = strtoul(gdbmi_cstring_text(frame->address, NULL), NULL, 16);
 
-        if (ends_with_gdbmi_prompt(gdbmi->tgdb_cur_output_command, style,
-                        &found_command) == -1) {
-            logger_write_pos(logger, __FILE__, __LINE__,
-                    "ends_with_gdbmi_prompt error");
-            return -1;
-        }
-    }
+    return gdbmi_file_position(gdbmi, frame->fullname, frame->file,
+            frame->line, address, frame->func);
+}
 
-    if (found_command) {
-/*		gdbmi_walk_command ( gdbmi->tgdb_cur_output_command );*/
-        ibuf_clear(gdbmi->tgdb_cur_output_command);
-    }
+/* gdbmi_send_position:
+ * --------------------
+ *
+ *  Tells the front end the file and line gdb is at. Nothing is sent if
+ *  the position isn't known.
+ */
+static void gdbmi_send_position(struct tgdb_gdbmi *gdbmi,
+        struct tgdb_file_position *tfp, struct tgdb_list *list)
+{
+    struct tgdb_response *response;
 
-    /* Return nothing for now */
-    *debugger_output_size = 0;
-    *inferior_output_size = 0;
+    if (!tfp)
+        return;
 
-    if (found_command)
-        return 1;
+    response = gdbmi_append_response(gdbmi, list, TGDB_UPDATE_FILE_POSITION);
+    response->choice.update_file_position.file_position = tfp;
 
-    return 0;
+    gdbmi->frame_reported = 1;
 }
 
-struct tgdb_list *gdbmi_get_client_commands(void *ctx)
+static void gdbmi_send_file_position(struct tgdb_gdbmi *gdbmi,
+        gdbmi_cstring_ptr fullname, gdbmi_cstring_ptr file, int line,
+        unsigned long address, gdbmi_cstring_ptr function,
+        struct tgdb_list *list)
 {
-    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
-
-    return gdbmi->client_command_list;
+    gdbmi_send_position(gdbmi, gdbmi_file_position(gdbmi, fullname, file,
+                    line, address, function), list);
 }
 
-#if 0
-//
-//int a2_get_source_absolute_filename ( 
-//      void *ctx,
-//      const char *file ) {
-//  struct annotate_two *a2 = (struct annotate_two *)ctx;
-//
-//    if ( commands_issue_command ( 
-//              a2->c, 
-//              a2->client_command_list,
-//              ANNOTATE_LIST, 
-//              file, 
-//              0 ) == -1 ) {
-//        err_msg("%s:%d commands_issue_command error", __FILE__, __LINE__);
-//        return -1;
-//    }
-//
-//    if ( commands_issue_command ( 
-//              a2->c, 
-//              a2->client_command_list,
-//              ANNOTATE_INFO_SOURCE_ABSOLUTE, 
-//              file, 
-//              0 ) == -1 ) {
-//        err_msg("%s:%d commands_issue_command error", __FILE__, __LINE__);
-//        return -1;
-//    }
-//
-//  return 0;
-//}
-//
-//int a2_get_inferior_sources ( void *ctx) {
-//  struct annotate_two *a2 = (struct annotate_two *)ctx;
-//    if ( commands_issue_command ( 
-//              a2->c, 
-//              a2->client_command_list,
-//              ANNOTATE_INFO_SOURCES, 
-//              NULL, 
-//              0 ) == -1 ) {
-//        err_msg("%s:%d commands_issue_command error", __FILE__, __LINE__);
-//        return -1;
-//    }
-//
-//  return 0;
-//}
-//
-//int a2_change_prompt(
-//      void *ctx,
-//      const char *prompt) {
-//  struct annotate_two *a2 = (struct annotate_two *)ctx;
-//
-//    /* Must call a callback to change the prompt */
-//    if ( commands_issue_command ( 
-//              a2->c, 
-//              a2->client_command_list,
-//              ANNOTATE_SET_PROMPT, 
-//              prompt, 
-//              2 ) == -1 ) {
-//        err_msg("%s:%d commands_issue_command error", __FILE__, __LINE__);
-//        return -1;
-//    }
-//            
-//    return 0;
-//}
-//
-//int a2_command_callback(
-//      void *ctx,
-//      const char *command) {
-//  /* Unimplemented */
-//  return -1;
-//}
-//
-//char *a2_return_client_command ( void *ctx, enum tgdb_command_type c ) {
-//  if ( c < TGDB_CONTINUE || c >= TGDB_ERROR )
-//      return NULL;
-//
-//  return a2_tgdb_commands[c];
-//}
-//
-//char *a2_client_modify_breakpoint ( 
-//      void *ctx, 
-//      const char *file, 
-//      int line, 
-//      enum tgdb_breakpoint_action b ) {
-//  char *val = (char*)cgdb_malloc ( sizeof(char)* ( strlen(file) + 128 ) );
-//
-//  if ( b == TGDB_BREAKPOINT_ADD ) {
-//      sprintf ( val, "break %s:%d", file, line ); 
-//      return val;
-//  } else if ( b == TGDB_BREAKPOINT_DELETE ) {
-//      sprintf ( val, "clear %s:%d", file, line ); 
-//      return val;
-//  } else 
-//      return NULL;
-//}
-#endif
+static void gdbmi_send_frame(struct tgdb_gdbmi *gdbmi,
+        gdbmi_oc_frame_ptr frame, struct tgdb_list *list)
+{
+    gdbmi_send_position(gdbmi, gdbmi_frame_position(gdbmi, frame), list);
+}
 
-pid_t gdbmi_get_debugger_pid(void *ctx)
+static void gdbmi_send_source_denied(struct tgdb_gdbmi *gdbmi,
+        struct tgdb_list *list)
 {
-    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+    struct tgdb_source_file *rejected = (struct tgdb_source_file *)
+            std_arena_alloc(gdbmi->arena, sizeof (struct tgdb_source_file));
+    struct tgdb_response *response;
 
-    return gdbmi->debugger_pid;
+    if (gdbmi->last_file_requested)
+        rejected->absolute_path = std_intern(gdbmi->last_file_requested);
+    else
+        rejected->absolute_path = NULL;
+
+    response = gdbmi_append_response(gdbmi, list,
+            TGDB_ABSOLUTE_SOURCE_DENIED);
+    response->choice.absolute_source_denied.source_file = rejected;
 }
 
-#if 0
-//int a2_completion_callback(
-//      void *ctx,
-//      const char *command) {
-//  struct annotate_two *a2 = (struct annotate_two *)ctx;
-//    if ( commands_issue_command ( 
-//              a2->c, 
-//              a2->client_command_list,
-//              ANNOTATE_COMPLETE, command, 4 ) == -1 ) {
-//        err_msg("%s:%d commands_issue_command error", __FILE__, __LINE__);
-//        return -1;
-//    }
-//
-//    return 0;
-//}
-#endif
+/* gdbmi_find_breakpoint:
+ * ----------------------
+ *
+ *  Returns the index of the first breakpoint in breakpoints with a number
+ *  that isn't less than number. It's breakpoints_count if there's none.
+ */
+static int gdbmi_find_breakpoint(struct tgdb_gdbmi *gdbmi, int number)
+{
+    int low = 0, high = gdbmi->breakpoints_count, middle;
 
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (gdbmi->breakpoints[middle].number < number)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+/* gdbmi_breakpoint_changed:
+ * -------------------------
+ *
+ *  Remembers that a breakpoint changed, to send it with the next update.
+ *
+ *  number:  The number of the breakpoint
+ *  b:       The breakpoint, or NULL if it was deleted
+ */
+static void gdbmi_breakpoint_changed(struct tgdb_gdbmi *gdbmi, int number,
+        struct gdbmi_breakpoint *b)
+{
+    /* They're all sent */
+    if (gdbmi->breakpoints_changed)
+        return;
+
+    /* It's sent as it is when the update is */
+    if (b && b->changed)
+        return;
+
+    if (gdbmi->changed_breakpoints_count ==
+            gdbmi->changed_breakpoints_size) {
+        gdbmi->changed_breakpoints_size = gdbmi->changed_breakpoints_size ?
+                gdbmi->changed_breakpoints_size * 2 : 16;
+        gdbmi->changed_breakpoints = cgdb_realloc(gdbmi->changed_breakpoints,
+                sizeof (int) * gdbmi->changed_breakpoints_size);
+    }
+    gdbmi->changed_breakpoints[gdbmi->changed_breakpoints_count++] = number;
+
+    if (b)
+        b->changed = 1;
+}
+
+static void gdbmi_delete_breakpoint(struct tgdb_gdbmi *gdbmi, int number)
+{
+    int i = gdbmi_find_breakpoint(gdbmi, number), changed;
+
+    if (i == gdbmi->breakpoints_count ||
+            gdbmi->breakpoints[i].number != number)
+        return;
+
+    changed = gdbmi->breakpoints[i].changed;
+    free(gdbmi->breakpoints[i].funcname);
+    memmove(gdbmi->breakpoints + i, gdbmi->breakpoints + i + 1,
+            sizeof (struct gdbmi_breakpoint) *
+            (gdbmi->breakpoints_count - i - 1));
+    gdbmi->breakpoints_count--;
+
+    /* Its number is there already, it's sent as deleted */
+    if (!changed)
+        gdbmi_breakpoint_changed(gdbmi, number, NULL);
+}
+
+/* gdbmi_set_breakpoint:
+ * ---------------------
+ *
+ *  Adds a breakpoint gdb told about, or changes the one with its number.
+ *  Watchpoints, and breakpoints that aren't in a file the front end can
+ *  show, are left out.
+ */
+static void gdbmi_set_breakpoint(struct tgdb_gdbmi *gdbmi,
+        gdbmi_oc_breakpoint_ptr breakpoint)
+{
+    struct gdbmi_breakpoint *b;
+    const char *file, *func;
+    int i;
+
+    if (breakpoint->type != GDBMI_BREAKPOINT || !breakpoint->file) {
+        gdbmi_delete_breakpoint(gdbmi, breakpoint->number);
+        return;
+    }
+
+    file = gdbmi_response_path(breakpoint->file);
+
+    func = breakpoint->func ? gdbmi_cstring_text(breakpoint->func, NULL) :
+            NULL;
+
+    i = gdbmi_find_breakpoint(gdbmi, breakpoint->number);
+    if (i < gdbmi->breakpoints_count &&
+            gdbmi->breakpoints[i].number == breakpoint->number) {
+        b = &gdbmi->breakpoints[i];
+
+        /* gdb tells about some changes the front end doesn't show */
+        if (b->file == file && b->line == breakpoint->line &&
+                b->enabled == breakpoint->enabled &&
+                b->hits == breakpoint->times &&
+                ((!b->funcname && !func) ||
+                        (b->funcname && func &&
+                                strcmp(b->funcname, func) == 0)))
+            return;
+
+        free(b->funcname);
+    } else {
+        if (gdbmi->breakpoints_count == gdbmi->breakpoints_size) {
+            gdbmi->breakpoints_size = gdbmi->breakpoints_size ?
+                    gdbmi->breakpoints_size * 2 : 16;
+            gdbmi->breakpoints = cgdb_realloc(gdbmi->breakpoints,
+                    sizeof (struct gdbmi_breakpoint) *
+                    gdbmi->breakpoints_size);
+        }
+
+        /* gdb numbers them in the order they're made, this is the end */
+        b = &gdbmi->breakpoints[i];
+        memmove(b + 1, b, sizeof (struct gdbmi_breakpoint) *
+                (gdbmi->breakpoints_count - i));
+        gdbmi->breakpoints_count++;
+        b->number = breakpoint->number;
+        b->changed = 0;
+    }
+
+    b->file = file;
+    b->funcname = gdbmi_dup_text(breakpoint->func);
+    b->line = breakpoint->line;
+    b->enabled = breakpoint->enabled;
+    b->hits = breakpoint->times;
+    gdbmi_breakpoint_changed(gdbmi, b->number, b);
+}
+
+/* gdbmi_send_breakpoint_changes:
+ * ------------------------------
+ *
+ *  Tells the front end about the breakpoints that changed since the last
+ *  update, without the ones that didn't.
+ */
+static void gdbmi_send_breakpoint_changes(struct tgdb_gdbmi *gdbmi,
+        struct tgdb_list *list)
+{
+    struct tgdb_response *response;
+    struct tgdb_breakpoint_changes *changes;
+    struct tgdb_breakpoint_change *change;
+    struct gdbmi_breakpoint *b;
+    int i, j;
+
+    changes = (struct tgdb_breakpoint_changes *) std_arena_alloc(gdbmi->arena,
+            sizeof (struct tgdb_breakpoint_changes));
+    changes->count = gdbmi->changed_breakpoints_count;
+    changes->changes = (struct tgdb_breakpoint_change *)
+            std_arena_alloc(gdbmi->arena,
+            sizeof (struct tgdb_breakpoint_change) * changes->count);
+
+    for (i = 0; i < changes->count; i++) {
+        change = &changes->changes[i];
+        memset(change, 0, sizeof (struct tgdb_breakpoint_change));
+        change->breakpoint.number = gdbmi->changed_breakpoints[i];
+
+        j = gdbmi_find_breakpoint(gdbmi, change->breakpoint.number);
+        if (j == gdbmi->breakpoints_count ||
+                gdbmi->breakpoints[j].number != change->breakpoint.number) {
+            change->deleted = 1;
+            continue;
+        }
+
+        b = &gdbmi->breakpoints[j];
+        change->breakpoint.file = b->file;
+        change->breakpoint.funcname =
+                std_arena_strdup(gdbmi->arena, b->funcname);
+        change->breakpoint.line = b->line;
+        change->breakpoint.enabled = b->enabled;
+        change->breakpoint.hits = b->hits;
+        b->changed = 0;
+    }
+
+    response = gdbmi_append_response(gdbmi, list,
+            TGDB_UPDATE_BREAKPOINT_CHANGES);
+    response->choice.update_breakpoint_changes.changes = changes;
+
+    gdbmi->changed_breakpoints_count = 0;
+}
+
+static void gdbmi_send_breakpoints(struct tgdb_gdbmi *gdbmi,
+        struct tgdb_list *list)
+{
+    struct tgdb_response *response;
+    struct tgdb_breakpoint *tb;
+    int i;
+
+    if (!gdbmi->breakpoints_changed) {
+        if (gdbmi->changed_breakpoints_count > 0)
+            gdbmi_send_breakpoint_changes(gdbmi, list);
+        return;
+    }
+
+    /* An update sent before in the same batch gets the new breakpoints */
+    tgdb_list_free(gdbmi->breakpoint_list, gdbmi_free_breakpoint);
+
+    for (i = 0; i < gdbmi->breakpoints_count; i++) {
+        tb = (struct tgdb_breakpoint *)
+                cgdb_malloc(sizeof (struct tgdb_breakpoint));
+        tb->file = gdbmi->breakpoints[i].file;
+        tb->funcname = gdbmi->breakpoints[i].funcname ?
+                cgdb_strdup(gdbmi->breakpoints[i].funcname) : NULL;
+        tb->line = gdbmi->breakpoints[i].line;
+        tb->enabled = gdbmi->breakpoints[i].enabled;
+        tb->number = gdbmi->breakpoints[i].number;
+        tb->hits = gdbmi->breakpoints[i].hits;
+        tgdb_list_append(gdbmi->breakpoint_list, tb);
+        gdbmi->breakpoints[i].changed = 0;
+    }
+
+    response = gdbmi_append_response(gdbmi, list, TGDB_UPDATE_BREAKPOINTS);
+    response->choice.update_breakpoints.breakpoint_list =
+            gdbmi->breakpoint_list;
+
+    gdbmi->breakpoints_changed = 0;
+    gdbmi->changed_breakpoints_count = 0;
+}
+
+/* gdbmi_send_variables:
+ * ---------------------
+ *
+ *  Tells the front end what a variable command gave. It's told even when
+ *  the command failed, so it knows which of its requests was answered.
+ *
+ *  command:    The command that was asked for.
+ *  variables:  The variables gdb gave.
+ */
+static void gdbmi_send_variables(struct tgdb_gdbmi *gdbmi, gdbmi_oc_ptr oc,
+        enum tgdb_variable_command command, gdbmi_oc_variable_ptr variables,
+        struct tgdb_list *list)
+{
+    struct tgdb_variables *v = (struct tgdb_variables *)
+            std_arena_alloc(gdbmi->arena, sizeof (struct tgdb_variables));
+    struct tgdb_response *response;
+    gdbmi_oc_variable_ptr cur;
+    int i;
+
+    v->command = command;
+
+    if (oc->result_class != GDBMI_DONE)
+        v->error = oc->error_msg ? gdbmi_response_text(gdbmi, oc->error_msg) :
+                std_arena_strdup(gdbmi->arena, "error");
+    else
+        for (cur = variables; cur; cur = cur->next)
+            v->count++;
+
+    v->variables = (struct tgdb_variable *) std_arena_alloc(gdbmi->arena,
+            sizeof (struct tgdb_variable) * (v->count + 1));
+
+    for (i = 0, cur = variables; i < v->count; i++, cur = cur->next) {
+        struct tgdb_variable *variable = &v->variables[i];
+
+        /* A local only has its name */
+        if (command == TGDB_VARIABLE_LOCALS)
+            variable->expression = gdbmi_response_text(gdbmi, cur->name);
+        else {
+            variable->name = gdbmi_response_text(gdbmi, cur->name);
+            variable->expression = gdbmi_response_text(gdbmi,
+                    cur->expression);
+        }
+
+        variable->value = gdbmi_response_text(gdbmi, cur->value);
+        variable->type = gdbmi_response_text(gdbmi, cur->type);
+        variable->children = cur->numchild;
+        variable->in_scope = cur->in_scope;
+        variable->type_changed = cur->type_changed;
+    }
+
+    response = gdbmi_append_response(gdbmi, list, TGDB_UPDATE_VARIABLES);
+    response->choice.update_variables.variables = v;
+}
+
+/* gdbmi_hex_digit:
+ * ----------------
+ *
+ *  Returns: The value of a hex digit, or -1 if it isn't one.
+ */
+static int gdbmi_hex_digit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/* gdbmi_send_memory:
+ * ------------------
+ *
+ *  Tells the front end the bytes a memory command read. It's told even when
+ *  the command failed, so it knows its request was answered. gdb leaves
+ *  out the blocks it couldn't read, so each block is put where it belongs
+ *  in the bytes that were asked for.
+ *
+ *  memory:  The blocks gdb read.
+ */
+static void gdbmi_send_memory(struct tgdb_gdbmi *gdbmi, gdbmi_oc_ptr oc,
+        gdbmi_oc_memory_ptr memory, struct tgdb_list *list)
+{
+    struct tgdb_memory *m = (struct tgdb_memory *)
+            std_arena_alloc(gdbmi->arena, sizeof (struct tgdb_memory));
+    struct tgdb_response *response;
+    unsigned long offset;
+    const char *contents;
+    size_t size, i;
+    int high, low;
+
+    m->length = gdbmi->memory_length;
+    m->bytes = (unsigned char *) std_arena_alloc(gdbmi->arena, m->length);
+    m->readable = (unsigned char *) std_arena_alloc(gdbmi->arena, m->length);
+    memset(m->bytes, 0, m->length);
+    memset(m->readable, 0, m->length);
+
+    if (oc->result_class != GDBMI_DONE)
+        m->error = oc->error_msg ? gdbmi_response_text(gdbmi, oc->error_msg) :
+                std_arena_strdup(gdbmi->arena, "error");
+
+    /* The offset of a block is from the address asked for */
+    if (memory && memory->begin && memory->offset) {
+        m->address = strtoul(gdbmi_cstring_text(memory->begin, NULL), NULL,
+                16) - strtoul(gdbmi_cstring_text(memory->offset, NULL),
+                NULL, 16);
+    }
+
+    for (; m->error == NULL && memory; memory = memory->next) {
+        if (!memory->offset || !memory->contents)
+            continue;
+
+        offset = strtoul(gdbmi_cstring_text(memory->offset, NULL), NULL, 16);
+        contents = gdbmi_cstring_text(memory->contents, &size);
+
+        for (i = 0; i + 1 < size && offset < (unsigned long) m->length;
+                i += 2, offset++) {
+            high = gdbmi_hex_digit(contents[i]);
+            low = gdbmi_hex_digit(contents[i + 1]);
+            if (high == -1 || low == -1)
+                break;
+
+            m->bytes[offset] = (unsigned char) (high * 16 + low);
+            m->readable[offset] = 1;
+        }
+    }
+
+    response = gdbmi_append_response(gdbmi, list, TGDB_UPDATE_MEMORY);
+    response->choice.update_memory.memory = m;
+}
+
+/* gdbmi_new_frames:
+ * -----------------
+ *
+ *  Makes the frames a frames command listed into what the front end gets.
+ *
+ *  frames:  The frames gdb listed, innermost first.
+ *
+ *  Returns: The frames, in the arena.
+ */
+static struct tgdb_frames *gdbmi_new_frames(struct tgdb_gdbmi *gdbmi,
+        gdbmi_oc_ptr oc, gdbmi_oc_frame_ptr frames)
+{
+    struct tgdb_frames *f = (struct tgdb_frames *)
+            std_arena_alloc(gdbmi->arena, sizeof (struct tgdb_frames));
+    gdbmi_oc_frame_ptr frame;
+    int i;
+
+    f->thread = gdbmi->frames_thread;
+    f->low = gdbmi->frames_low;
+    f->count = 0;
+    f->error = NULL;
+
+    if (oc->result_class != GDBMI_DONE)
+        f->error = oc->error_msg ? gdbmi_response_text(gdbmi, oc->error_msg) :
+                std_arena_strdup(gdbmi->arena, "error");
+    else
+        for (frame = frames; frame; frame = frame->next)
+            f->count++;
+
+    f->frames = (struct tgdb_frame *) std_arena_alloc(gdbmi->arena,
+            sizeof (struct tgdb_frame) * (f->count + 1));
+
+    for (i = 0, frame = frames; i < f->count; i++, frame = frame->next) {
+        struct tgdb_frame *tf = &f->frames[i];
+
+        tf->level = frame->level;
+        tf->address = frame->address ? strtoul(gdbmi_cstring_text(frame->
+                        address, NULL), NULL, 16) : 0;
+        tf->function = gdbmi_response_text(gdbmi, frame->func);
+        tf->relative_path = gdbmi_response_path(frame->file);
+        tf->absolute_path = gdbmi_response_path(frame->fullname);
+        tf->line_number = frame->line;
+    }
+
+    return f;
+}
+
+/* gdbmi_send_frames:
+ * ------------------
+ *
+ *  Tells the front end the frames a frames command listed. It's told even
+ *  when the command failed, so it knows its request was answered.
+ *
+ *  frames:  The frames gdb listed, innermost first.
+ */
+static void gdbmi_send_frames(struct tgdb_gdbmi *gdbmi, gdbmi_oc_ptr oc,
+        gdbmi_oc_frame_ptr frames, struct tgdb_list *list)
+{
+    struct tgdb_response *response;
+
+    response = gdbmi_append_response(gdbmi, list, TGDB_UPDATE_FRAMES);
+    response->choice.update_frames.frames =
+            gdbmi_new_frames(gdbmi, oc, frames);
+}
+
+/* gdbmi_sample_stopped:
+ * ---------------------
+ *
+ *  Takes the sample, if the program stopped for the interrupt
+ *  gdbmi_sample got ready for. Any other stop is the user's: it was
+ *  another signal, a breakpoint, or the program exited before the
+ *  interrupt came.
+ *
+ *  Returns: 1 if the stop is a sample's, 0 otherwise.
+ */
+static int gdbmi_sample_stopped(struct tgdb_gdbmi *gdbmi,
+        gdbmi_oc_async_ptr async)
+{
+    char data[32];
+
+    if (gdbmi->sample_state != GDBMI_SAMPLE_WAITING)
+        return 0;
+
+    gdbmi->sample_state = GDBMI_SAMPLE_IDLE;
+
+    if (async->reason_keyword != GDBMI_KEYWORD_SIGNAL_RECEIVED ||
+            !async->signal_name ||
+            strcmp(gdbmi_cstring_text(async->signal_name, NULL),
+                    "SIGINT") != 0)
+        return 0;
+
+    /* The frames are listed right away, the program is continued when
+     * they are */
+    snprintf(data, sizeof (data), "0 %d", gdbmi->sample_depth - 1);
+    if (gdbmi_issue_command(gdbmi, GDBMI_SAMPLE_FRAMES, data) == -1)
+        return 0;
+
+    gdbmi->sample_state = GDBMI_SAMPLE_TAKING;
+    gdbmi->frames_thread = async->thread_id;
+    gdbmi->frames_low = 0;
+
+    return 1;
+}
+
+/* gdbmi_thread_changed:
+ * ---------------------
+ *
+ *  Remembers what happened to a thread, to send it with the next update.
+ */
+static void gdbmi_thread_changed(struct tgdb_gdbmi *gdbmi,
+        enum tgdb_thread_event event, int id)
+{
+    /* All of the threads run or stop at once in all-stop mode */
+    if (id < 0 || (id == 0 && event != TGDB_THREAD_RUNNING &&
+                    event != TGDB_THREAD_STOPPED))
+        return;
+
+    if (gdbmi->thread_changes_count == gdbmi->thread_changes_size) {
+        gdbmi->thread_changes_size = gdbmi->thread_changes_size ?
+                gdbmi->thread_changes_size * 2 : 16;
+        gdbmi->thread_changes = cgdb_realloc(gdbmi->thread_changes,
+                sizeof (struct tgdb_thread_change) *
+                gdbmi->thread_changes_size);
+    }
+
+    gdbmi->thread_changes[gdbmi->thread_changes_count].event = event;
+    gdbmi->thread_changes[gdbmi->thread_changes_count].id = id;
+    gdbmi->thread_changes_count++;
+}
+
+/* gdbmi_thread_search:
+ * --------------------
+ *
+ *  Returns the index of the first exception whose number isn't less than
+ *  id, thread_exceptions_count if there's none.
+ */
+static int gdbmi_thread_search(struct tgdb_gdbmi *gdbmi, int id)
+{
+    int low = 0, high = gdbmi->thread_exceptions_count, middle;
+
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (gdbmi->thread_exceptions[middle] < id)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+/* gdbmi_thread_running:
+ * ---------------------
+ *
+ *  Returns: 1 if the thread runs, 0 if it's stopped.
+ */
+static int gdbmi_thread_running(struct tgdb_gdbmi *gdbmi, int id)
+{
+    int i = gdbmi_thread_search(gdbmi, id);
+    int exception = i < gdbmi->thread_exceptions_count &&
+            gdbmi->thread_exceptions[i] == id;
+
+    return gdbmi->threads_running != exception;
+}
+
+/* gdbmi_thread_forget:
+ * --------------------
+ *
+ *  Forgets if a thread runs, once it exited.
+ */
+static void gdbmi_thread_forget(struct tgdb_gdbmi *gdbmi, int id)
+{
+    int i = gdbmi_thread_search(gdbmi, id);
+
+    if (i == gdbmi->thread_exceptions_count ||
+            gdbmi->thread_exceptions[i] != id)
+        return;
+
+    memmove(gdbmi->thread_exceptions + i, gdbmi->thread_exceptions + i + 1,
+            sizeof (int) * (gdbmi->thread_exceptions_count - i - 1));
+    gdbmi->thread_exceptions_count--;
+}
+
+/* gdbmi_thread_ran:
+ * -----------------
+ *
+ *  Remembers that a thread runs or stopped, to send it with the next
+ *  update.
+ *
+ *  id:      The thread, or 0 for all of them.
+ *  running: 1 if it runs, 0 if it stopped.
+ */
+static void gdbmi_thread_ran(struct tgdb_gdbmi *gdbmi, int id, int running)
+{
+    int i;
+
+    if (id == 0) {
+        gdbmi->threads_running = running;
+        gdbmi->thread_exceptions_count = 0;
+    } else if (id > 0 && gdbmi_thread_running(gdbmi, id) != running) {
+        i = gdbmi_thread_search(gdbmi, id);
+        if (i < gdbmi->thread_exceptions_count &&
+                gdbmi->thread_exceptions[i] == id)
+            gdbmi_thread_forget(gdbmi, id);
+        else {
+            if (gdbmi->thread_exceptions_count ==
+                    gdbmi->thread_exceptions_size) {
+                gdbmi->thread_exceptions_size =
+                        gdbmi->thread_exceptions_size ?
+                        gdbmi->thread_exceptions_size * 2 : 16;
+                gdbmi->thread_exceptions =
+                        cgdb_realloc(gdbmi->thread_exceptions,
+                        sizeof (int) * gdbmi->thread_exceptions_size);
+            }
+            memmove(gdbmi->thread_exceptions + i + 1,
+                    gdbmi->thread_exceptions + i,
+                    sizeof (int) * (gdbmi->thread_exceptions_count - i));
+            gdbmi->thread_exceptions[i] = id;
+            gdbmi->thread_exceptions_count++;
+        }
+    }
+
+    gdbmi_thread_changed(gdbmi,
+            running ? TGDB_THREAD_RUNNING : TGDB_THREAD_STOPPED, id);
+}
+
+/* gdbmi_follow_stop:
+ * ------------------
+ *
+ *  Determines if the front end is told where a thread stopped. In
+ *  non-stop mode, gdb keeps looking at the thread it looked at, and so does
+ *  the source window, unless that one runs. Then gdb is made to look at
+ *  the one that stopped.
+ *
+ *  Returns: 1 if it's told, 0 otherwise.
+ */
+static int gdbmi_follow_stop(struct tgdb_gdbmi *gdbmi,
+        gdbmi_oc_async_ptr async)
+{
+    int thread = async->thread_id;
+    char data[32];
+
+    if (gdbmi->non_stop && !async->all_threads && thread > 0 &&
+            thread != gdbmi->thread) {
+        if (gdbmi->thread > 0 && !gdbmi_thread_running(gdbmi, gdbmi->thread))
+            return 0;
+
+        snprintf(data, sizeof (data), "%d", thread);
+        gdbmi_issue_command(gdbmi, GDBMI_SELECT_THREAD, data);
+    }
+
+    gdbmi->thread = thread;
+
+    return 1;
+}
+
+/* gdbmi_send_threads:
+ * -------------------
+ *
+ *  Tells the front end about the threads that changed since the last
+ *  update. A program that starts thousands of threads tells about all of
+ *  them in a few updates, and gdb is never asked to list them.
+ */
+static void gdbmi_send_threads(struct tgdb_gdbmi *gdbmi,
+        struct tgdb_list *list)
+{
+    struct tgdb_thread_changes *changes;
+    struct tgdb_response *response;
+
+    if (gdbmi->thread_changes_count == 0)
+        return;
+
+    changes = (struct tgdb_thread_changes *) std_arena_alloc(gdbmi->arena,
+            sizeof (struct tgdb_thread_changes));
+    changes->count = gdbmi->thread_changes_count;
+    changes->changes = (struct tgdb_thread_change *)
+            std_arena_alloc(gdbmi->arena,
+            sizeof (struct tgdb_thread_change) * changes->count);
+    memcpy(changes->changes, gdbmi->thread_changes,
+            sizeof (struct tgdb_thread_change) * changes->count);
+
+    response = gdbmi_append_response(gdbmi, list, TGDB_UPDATE_THREADS);
+    response->choice.update_threads.changes = changes;
+
+    gdbmi->thread_changes_count = 0;
+}
+
+/* gdbmi_send_stop:
+ * ----------------
+ *
+ *  Tells the front end about the stop that's pending, if there's one.
+ */
+static void gdbmi_send_stop(struct tgdb_gdbmi *gdbmi, struct tgdb_list *list)
+{
+    if (!gdbmi->stop_pending)
+        return;
+
+    gdbmi->stop_pending = 0;
+
+    /* The front end knows whose stack it is before it's told where the
+     * frame is */
+    gdbmi_thread_changed(gdbmi, TGDB_THREAD_SELECTED, gdbmi->stop_thread);
+    gdbmi_send_threads(gdbmi, list);
+    gdbmi_send_position(gdbmi, gdbmi->stop_position, list);
+    gdbmi->stop_position = NULL;
+}
+
+/* gdbmi_continued:
+ * ----------------
+ *
+ *  Forgets the pending stop if a *running record runs its thread again.
+ */
+static void gdbmi_continued(struct tgdb_gdbmi *gdbmi,
+        gdbmi_oc_async_ptr async)
+{
+    if (!gdbmi->stop_pending)
+        return;
+
+    if (!async->all_threads && !gdbmi->stop_all_threads &&
+            async->thread_id != gdbmi->stop_thread)
+        return;
+
+    gdbmi->stop_pending = 0;
+    gdbmi->stop_position = NULL;
+}
+
+/* gdbmi_handle_async:
+ * -------------------
+ *
+ *  Handles an asynchronous record, that came with any command.
+ */
+static int gdbmi_forget_pair(void *key, void *value, void *data)
+{
+    return 1;
+}
+
+/* gdbmi_set_core:
+ * ---------------
+ *
+ *  Tells the front end that gdb started or stopped debugging a core dump.
+ *
+ *  core: 1 if gdb debugs one now, 0 otherwise.
+ */
+static void gdbmi_set_core(struct tgdb_gdbmi *gdbmi, int core,
+        struct tgdb_list *list)
+{
+    struct tgdb_response *response;
+
+    if (core == gdbmi->core)
+        return;
+
+    gdbmi->core = core;
+
+    /* The paths of another program may be elsewhere */
+    if (!core)
+        std_ohash_table_foreach_remove(gdbmi->filename_pairs,
+                gdbmi_forget_pair, NULL);
+
+    response = gdbmi_append_response(gdbmi, list, TGDB_CORE_FILE);
+    response->choice.core_file.core = core;
+}
+
+static void gdbmi_handle_async(struct tgdb_gdbmi *gdbmi,
+        gdbmi_oc_async_ptr async, struct tgdb_list *list)
+{
+    struct tgdb_response *response;
+    int *status;
+
+    /* What the pending stop is told with would go out of order */
+    if (async->async_class == GDBMI_STOPPED ||
+            async->async_class == GDBMI_THREAD_SELECTED ||
+            async->async_class == GDBMI_THREAD_EXITED)
+        gdbmi_send_stop(gdbmi, list);
+
+    switch (async->async_class) {
+        case GDBMI_STOPPED:
+            gdbmi->running = 0;
+
+            if (gdbmi_sample_stopped(gdbmi, async))
+                break;
+
+            gdbmi_thread_ran(gdbmi,
+                    async->all_threads ? 0 : async->thread_id, 0);
+
+            if (async->reason_keyword == GDBMI_KEYWORD_EXITED ||
+                    async->reason_keyword == GDBMI_KEYWORD_EXITED_NORMALLY ||
+                    async->reason_keyword == GDBMI_KEYWORD_EXITED_SIGNALLED) {
+                gdbmi->thread = 0;
+                gdbmi_send_threads(gdbmi, list);
+                status = (int *) std_arena_alloc(gdbmi->arena, sizeof (int));
+                *status = async->exit_code;
+                response = gdbmi_append_response(gdbmi, list,
+                        TGDB_INFERIOR_EXITED);
+                response->choice.inferior_exited.exit_status = status;
+                break;
+            }
+
+            if (!gdbmi_follow_stop(gdbmi, async))
+                break;
+
+            /* Nothing asks gdb where it is, a position will come */
+            gdbmi->stop_pending = 1;
+            gdbmi->stop_thread = async->thread_id;
+            gdbmi->stop_all_threads = async->all_threads;
+            gdbmi->stop_position = gdbmi_frame_position(gdbmi, async->frame);
+            if (gdbmi->stop_position)
+                gdbmi->frame_reported = 1;
+            break;
+        case GDBMI_ASYNC_RUNNING:
+            gdbmi->running = 1;
+            gdbmi_set_core(gdbmi, 0, list);
+            gdbmi_continued(gdbmi, async);
+            gdbmi_thread_ran(gdbmi,
+                    async->all_threads ? 0 : async->thread_id, 1);
+            break;
+        case GDBMI_THREAD_SELECTED:
+            if (async->thread_id > 0)
+                gdbmi->thread = async->thread_id;
+            gdbmi_thread_changed(gdbmi, TGDB_THREAD_SELECTED,
+                    async->thread_id);
+            gdbmi_send_threads(gdbmi, list);
+            gdbmi_send_frame(gdbmi, async->frame, list);
+            break;
+        case GDBMI_THREAD_CREATED:
+            gdbmi_thread_changed(gdbmi, TGDB_THREAD_CREATED,
+                    async->thread_id);
+            break;
+        case GDBMI_THREAD_EXITED:
+            gdbmi_thread_forget(gdbmi, async->thread_id);
+            gdbmi_thread_changed(gdbmi, TGDB_THREAD_EXITED, async->thread_id);
+            break;
+        case GDBMI_BREAKPOINT_CREATED:
+        case GDBMI_BREAKPOINT_MODIFIED:
+            if (async->breakpoint)
+                gdbmi_set_breakpoint(gdbmi, async->breakpoint);
+            break;
+        case GDBMI_BREAKPOINT_DELETED:
+            gdbmi_delete_breakpoint(gdbmi, async->breakpoint_number);
+            break;
+        default:
+            break;
+    }
+}
+
+/* gdbmi_handle_result:
+ * --------------------
+ *
+ *  Handles the result record of the command tgdb or the user ran.
+ */
+static void gdbmi_handle_result(struct tgdb_gdbmi *gdbmi, gdbmi_oc_ptr oc,
+        struct tgdb_list *list)
+{
+    struct tgdb_response *response;
+    gdbmi_oc_breakpoint_ptr breakpoint;
+    gdbmi_oc_file_path_info_ptr path;
+
+    if (oc->result_class == GDBMI_RUNNING) {
+        gdbmi->running = 1;
+        gdbmi_set_core(gdbmi, 0, list);
+
+        /* The program runs the user's command again, its output is shown */
+        if (gdbmi->command == GDBMI_SAMPLE_CONTINUE) {
+            gdbmi->sample_state = GDBMI_SAMPLE_IDLE;
+            gdbmi->command = GDBMI_VOID;
+            gdbmi->sample_cancelled = 0;
+        }
+        return;
+    }
+
+    gdbmi->running = 0;
+
+    switch (gdbmi->command) {
+        case GDBMI_INFO_BREAKPOINTS:
+            if (oc->result_class != GDBMI_DONE)
+                break;
+
+            gdbmi_clear_breakpoints(gdbmi);
+            breakpoint = oc->input_commands.break_list.breakpoint_ptr;
+            for (; breakpoint; breakpoint = breakpoint->next)
+                gdbmi_set_breakpoint(gdbmi, breakpoint);
+            break;
+        case GDBMI_LIST_SOURCE:
+            /* The path gdb would give next is of another file */
+            if (oc->result_class == GDBMI_ERROR &&
+                    gdbmi->last_file_requested) {
+                gdbmi->list_failed = 1;
+                gdbmi_send_source_denied(gdbmi, list);
+            }
+            break;
+        case GDBMI_INFO_SOURCE_ABSOLUTE:
+            if (gdbmi->list_failed)
+                gdbmi->list_failed = 0;
+            else if (oc->result_class == GDBMI_DONE &&
+                    oc->input_commands.file_list_exec_source_file.fullname) {
+                response = gdbmi_append_response(gdbmi, list,
+                        TGDB_FILENAME_PAIR);
+                response->choice.filename_pair.absolute_path =
+                        gdbmi_response_path(oc->input_commands.
+                        file_list_exec_source_file.fullname);
+                response->choice.filename_pair.relative_path =
+                        gdbmi_response_path(oc->input_commands.
+                        file_list_exec_source_file.file);
+
+                if (gdbmi->core && gdbmi->last_file_requested) {
+                    struct gdbmi_filename_pair *pair =
+                            (struct gdbmi_filename_pair *)
+                            cgdb_malloc(sizeof (struct gdbmi_filename_pair));
+
+                    pair->absolute_path =
+                            response->choice.filename_pair.absolute_path;
+                    pair->relative_path =
+                            response->choice.filename_pair.relative_path;
+                    std_ohash_table_replace(gdbmi->filename_pairs, (void *)
+                            std_intern(gdbmi->last_file_requested), pair);
+                }
+            } else
+                gdbmi_send_source_denied(gdbmi, list);
+            break;
+        case GDBMI_INFO_SOURCE_RELATIVE:
+            if (oc->result_class == GDBMI_DONE)
+                gdbmi_send_file_position(gdbmi,
+                        oc->input_commands.file_list_exec_source_file.fullname,
+                        oc->input_commands.file_list_exec_source_file.file,
+                        oc->input_commands.file_list_exec_source_file.line,
+                        0, NULL, list);
+            break;
+        case GDBMI_INFO_FRAME:
+            if (oc->result_class == GDBMI_DONE)
+                gdbmi_send_frame(gdbmi,
+                        oc->input_commands.stack_info_frame.frame, list);
+            break;
+        case GDBMI_INFO_SOURCES:
+            if (oc->result_class != GDBMI_DONE) {
+                gdbmi_append_response(gdbmi, list, TGDB_SOURCES_DENIED);
+                break;
+            }
+
+            tgdb_list_free(gdbmi->source_files, gdbmi_free_string);
+            path = oc->input_commands.file_list_exec_source_files.
+                    file_name_pair;
+            for (; path; path = path->next) {
+                if (path->fullname)
+                    tgdb_list_append(gdbmi->source_files,
+                            gdbmi_dup_text(path->fullname));
+                else if (path->file)
+                    tgdb_list_append(gdbmi->source_files,
+                            gdbmi_dup_text(path->file));
+            }
+
+            /* A program without debug info has no sources, the front end
+             * isn't told about none at all */
+            if (tgdb_list_size(gdbmi->source_files) > 0) {
+                response = gdbmi_append_response(gdbmi, list,
+                        TGDB_UPDATE_SOURCE_FILES);
+                response->choice.update_source_files.source_files =
+                        gdbmi->source_files;
+            }
+            break;
+        case GDBMI_COMPLETE:
+            response = gdbmi_append_response(gdbmi, list,
+                    TGDB_UPDATE_COMPLETIONS);
+            response->choice.update_completions.completion_list =
+                    gdbmi->completions;
+            break;
+        case GDBMI_DISASSEMBLE:
+            /* Sent even when gdb listed nothing, so the gui stops waiting */
+            response = gdbmi_append_response(gdbmi, list,
+                    TGDB_UPDATE_DISASSEMBLY);
+            response->choice.update_disassembly.disassembly =
+                    tgdb_types_new_disassembly(gdbmi->arena,
+                    ibuf_get(gdbmi->disassembly),
+                    oc->result_class == GDBMI_DONE ?
+                    ibuf_length(gdbmi->disassembly) : 0);
+            break;
+        case GDBMI_VARIABLE_CREATE:
+            gdbmi_send_variables(gdbmi, oc, TGDB_VARIABLE_CREATE,
+                    oc->input_commands.var_create.variable, list);
+            break;
+        case GDBMI_VARIABLE_UPDATE:
+            gdbmi_send_variables(gdbmi, oc, TGDB_VARIABLE_UPDATE,
+                    oc->input_commands.var_update.changelist, list);
+            break;
+        case GDBMI_VARIABLE_CHILDREN:
+            gdbmi_send_variables(gdbmi, oc, TGDB_VARIABLE_CHILDREN,
+                    oc->input_commands.var_list_children.children, list);
+            break;
+        case GDBMI_LOCALS:
+            gdbmi_send_variables(gdbmi, oc, TGDB_VARIABLE_LOCALS,
+                    oc->input_commands.stack_list_variables.variables, list);
+            break;
+        case GDBMI_READ_MEMORY:
+            gdbmi_send_memory(gdbmi, oc,
+                    oc->input_commands.data_read_memory_bytes.memory, list);
+            break;
+        case GDBMI_LIST_FRAMES:
+            gdbmi_send_frames(gdbmi, oc,
+                    oc->input_commands.stack_list_frames.frames, list);
+            break;
+        case GDBMI_SAMPLE_FRAMES:
+            if (oc->result_class == GDBMI_DONE) {
+                response = gdbmi_append_response(gdbmi, list,
+                        TGDB_UPDATE_SAMPLE);
+                response->choice.update_sample.frames =
+                        gdbmi_new_frames(gdbmi, oc,
+                        oc->input_commands.stack_list_frames.frames);
+            }
+
+            /* The user wants the program to stay stopped where it is */
+            if (gdbmi->sample_cancelled) {
+                gdbmi->sample_state = GDBMI_SAMPLE_IDLE;
+                gdbmi->sample_cancelled = 0;
+                gdbmi_issue_command(gdbmi, GDBMI_INFO_FRAME, NULL);
+            } else
+                gdbmi_issue_command(gdbmi, GDBMI_SAMPLE_CONTINUE, NULL);
+            break;
+        case GDBMI_SAMPLE_CONTINUE:
+            /* It's stopped after all, the front end is told where */
+            gdbmi->sample_state = GDBMI_SAMPLE_IDLE;
+            gdbmi->sample_cancelled = 0;
+            gdbmi_issue_command(gdbmi, GDBMI_INFO_FRAME, NULL);
+            break;
+        case GDBMI_VOID:
+            /* gdb doesn't say where an older one moved to */
+            if (gdbmi->frame_command && !gdbmi->frame_reported &&
+                    oc->result_class == GDBMI_DONE)
+                gdbmi_issue_command(gdbmi, GDBMI_INFO_FRAME, NULL);
+
+            /* gdb tells about the breakpoints a CLI command changes, but
+             * not the ones an MI command does */
+            if (gdbmi->break_command && oc->result_class == GDBMI_DONE)
+                gdbmi_issue_command(gdbmi, GDBMI_INFO_BREAKPOINTS, NULL);
+
+            if (gdbmi->core_command && oc->result_class == GDBMI_DONE)
+                gdbmi_issue_command(gdbmi, GDBMI_INFO_TARGET, NULL);
+            break;
+        case GDBMI_INFO_TARGET:
+            if (oc->result_class == GDBMI_DONE)
+                gdbmi_set_core(gdbmi, gdbmi->core_found, list);
+            break;
+        case GDBMI_NON_STOP:
+            if (oc->result_class == GDBMI_DONE)
+                gdbmi->non_stop = gdbmi->non_stop_asked;
+            break;
+        case GDBMI_TTY:
+        default:
+            break;
+    }
+}
+
+/* gdbmi_input_command:
+ * --------------------
+ *
+ *  Returns the name of the MI command tgdb is running, for
+ *  gdbmi_get_output_commands to know what the result record answers.
+ */
+static char *gdbmi_input_command(struct tgdb_gdbmi *gdbmi)
+{
+    switch (gdbmi->command) {
+        case GDBMI_INFO_BREAKPOINTS:
+            return "-break-list";
+        case GDBMI_INFO_SOURCES:
+            return "-file-list-exec-source-files";
+        case GDBMI_INFO_SOURCE_RELATIVE:
+        case GDBMI_INFO_SOURCE_ABSOLUTE:
+            return "-file-list-exec-source-file";
+        case GDBMI_INFO_FRAME:
+            return "-stack-info-frame";
+        case GDBMI_VARIABLE_CREATE:
+            return "-var-create";
+        case GDBMI_VARIABLE_UPDATE:
+            return "-var-update";
+        case GDBMI_VARIABLE_CHILDREN:
+            return "-var-list-children";
+        case GDBMI_LOCALS:
+            return "-stack-list-variables";
+        case GDBMI_READ_MEMORY:
+            return "-data-read-memory-bytes";
+        case GDBMI_LIST_FRAMES:
+        case GDBMI_SAMPLE_FRAMES:
+            return "-stack-list-frames";
+        default:
+            return "";
+    }
+}
+
+/* gdbmi_process_output:
+ * ---------------------
+ *
+ *  Tells the front end what it needs to know about the output command
+ *  that ended with the prompt.
+ *
+ *  output: The output command, or NULL if it couldn't be parsed.
+ *
+ *  Returns: 1 if the command is finished, 0 if the inferior is running.
+ */
+static int gdbmi_process_output(struct tgdb_gdbmi *gdbmi,
+        gdbmi_output_ptr output, struct tgdb_list *list)
+{
+    struct gdbmi_oc_cstring_ll mi_input_cmd;
+    gdbmi_oc_ptr oc = NULL, cur;
+    gdbmi_oc_async_ptr async;
+
+    mi_input_cmd.cstring = gdbmi_input_command(gdbmi);
+    mi_input_cmd.next = NULL;
+
+    if (output && gdbmi_get_output_commands(output,
+                    output->result_record ? &mi_input_cmd : NULL, &oc) == -1)
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_get_output_commands error");
+
+    for (cur = oc; cur; cur = cur->next) {
+        for (async = cur->async; async; async = async->next)
+            gdbmi_handle_async(gdbmi, async, list);
+
+        if (!cur->is_asynchronous)
+            gdbmi_handle_result(gdbmi, cur, list);
+    }
+
+    gdbmi_send_breakpoints(gdbmi, list);
+    gdbmi_send_threads(gdbmi, list);
+
+    destroy_gdbmi_oc(oc);
+
+    ibuf_clear(gdbmi->capture);
+
+    /* In non-stop mode, gdb takes the next command while the program runs,
+     * and a thread that runs or stops by itself is told with a prompt of
+     * its own, that ends no command */
+    if (gdbmi->non_stop) {
+        if (output && !output->result_record)
+            return 0;
+    } else if (gdbmi->running)
+        return 0;
+
+    if (!gdbmi->prompt_sent) {
+        struct tgdb_response *response =
+                gdbmi_append_response(gdbmi, list,
+                TGDB_UPDATE_CONSOLE_PROMPT_VALUE);
+
+        response->choice.update_console_prompt_value.prompt_value =
+                std_arena_strdup(gdbmi->arena, "(gdb) ");
+        gdbmi->prompt_sent = 1;
+    }
+
+    gdbmi->command = GDBMI_VOID;
+    gdbmi->echo_skipped = 1;
+    gdbmi->at_prompt = 1;
+
+    return 1;
+}
+
+/* gdbmi_record_line:
+ * ------------------
+ *
+ *  Hands a record that was received to the parser.
+ *
+ *  output: Set to the output command the record completes, or NULL.
+ *
+ *  Returns: 1 if it's the prompt, so the output command is complete.
+ */
+static int gdbmi_record_line(struct tgdb_gdbmi *gdbmi,
+        gdbmi_output_ptr * output)
+{
+    int parse_failed, prompt;
+
+    *output = NULL;
+    prompt = strncmp(ibuf_get(gdbmi->record_line), "(gdb)", 5) == 0;
+
+    ibuf_addchar(gdbmi->record_line, '\n');
+    if (gdbmi_parser_parse_span(gdbmi->parser,
+                    ibuf_get(gdbmi->record_line),
+                    ibuf_length(gdbmi->record_line), output,
+                    &parse_failed) == -1 || parse_failed) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_parser_parse_span error '%s'",
+                ibuf_get(gdbmi->record_line));
+        *output = NULL;
+    }
+
+    ibuf_clear(gdbmi->record_line);
+
+    return prompt;
+}
+
+/* gdbmi_stream_start:
+ * -------------------
+ *
+ *  Decides where the text of a stream record goes.
+ */
+static enum gdbmi_stream_target gdbmi_stream_start(struct tgdb_gdbmi *gdbmi,
+        char kind)
+{
+    /* The target's output is always shown */
+    if (kind == '@')
+        return GDBMI_STREAM_OUTPUT;
+
+    if ((gdbmi->command == GDBMI_COMPLETE ||
+                    gdbmi->command == GDBMI_DISASSEMBLE ||
+                    gdbmi->command == GDBMI_INFO_TARGET) && kind == '~')
+        return GDBMI_STREAM_CAPTURE;
+
+    if (gdbmi->command != GDBMI_VOID)
+        return GDBMI_STREAM_DROP;
+
+    /* gdb tells on the console that the program got the interrupt */
+    if (gdbmi->sample_state != GDBMI_SAMPLE_IDLE)
+        return GDBMI_STREAM_DROP;
+
+    /* gdb logs the CLI command it was given, the user just typed that */
+    if (kind == '&' && !gdbmi->echo_skipped) {
+        gdbmi->echo_skipped = 1;
+        return GDBMI_STREAM_DROP;
+    }
+
+    /* Nothing was asked, it's a breakpoint that printed and went on */
+    if (kind == '~' && gdbmi->running)
+        return GDBMI_STREAM_LOG;
+
+    return GDBMI_STREAM_OUTPUT;
+}
+
+/* gdbmi_stream_char:
+ * ------------------
+ *
+ *  Sends a character of the text of a stream record where it goes.
+ */
+static void gdbmi_stream_char(struct tgdb_gdbmi *gdbmi, char c,
+        char *debugger_output, size_t * n)
+{
+    switch (gdbmi->stream_target) {
+        case GDBMI_STREAM_OUTPUT:
+            debugger_output[(*n)++] = c;
+            break;
+        case GDBMI_STREAM_CAPTURE:
+            if (gdbmi->command == GDBMI_DISASSEMBLE) {
+                ibuf_addchar(gdbmi->disassembly, c);
+                break;
+            }
+
+            if (c != '\n') {
+                ibuf_addchar(gdbmi->capture, c);
+                break;
+            }
+
+            /* The line of the core file, if there's one, is all it needs */
+            if (gdbmi->command == GDBMI_INFO_TARGET) {
+                if (strstr(ibuf_get(gdbmi->capture), "core dump file"))
+                    gdbmi->core_found = 1;
+                ibuf_clear(gdbmi->capture);
+                break;
+            }
+
+            if (ibuf_length(gdbmi->capture) > 0)
+                tgdb_list_append(gdbmi->completions,
+                        cgdb_strdup(ibuf_get(gdbmi->capture)));
+            ibuf_clear(gdbmi->capture);
+            break;
+        case GDBMI_STREAM_LOG:
+            if (c != '\0')
+                ibuf_addchar(gdbmi->log, c);
+            break;
+        case GDBMI_STREAM_DROP:
+            break;
+    }
+}
+
+/* gdbmi_send_log:
+ * ---------------
+ *
+ *  Sends what gdb printed while the program ran where it goes.
+ *
+ *  stopped: 1 if a *stopped came after it. Unless it's for a sample, gdb
+ *           said why on the console, and it's shown there.
+ */
+static void gdbmi_send_log(struct tgdb_gdbmi *gdbmi, int stopped,
+        char *debugger_output, size_t * n, struct tgdb_list *list)
+{
+    struct tgdb_response *response;
+    size_t length = ibuf_length(gdbmi->log);
+
+    if (length == 0)
+        return;
+
+    if (stopped && gdbmi->sample_state == GDBMI_SAMPLE_IDLE) {
+        /* It came in with the input that's being parsed, it fits */
+        memcpy(debugger_output + *n, ibuf_get(gdbmi->log), length);
+        *n += length;
+    } else {
+        response = gdbmi_append_response(gdbmi, list, TGDB_UPDATE_LOG);
+        response->choice.update_log.text =
+                std_arena_strdup(gdbmi->arena, ibuf_get(gdbmi->log));
+    }
+
+    ibuf_clear(gdbmi->log);
+}
+
+/* gdbmi_stream_escape:
+ * --------------------
+ *
+ *  Returns the character of the escape sequence that ends in c.
+ */
+static char gdbmi_stream_escape(char c)
+{
+    switch (c) {
+        case 'n':
+            return '\n';
+        case 't':
+            return '\t';
+        case 'r':
+            return '\r';
+        case 'a':
+            return '\a';
+        case 'b':
+            return '\b';
+        case 'f':
+            return '\f';
+        case 'v':
+            return '\v';
+        case 'e':
+            return '\033';
+        default:
+            return c;
+    }
+}
+
+/* gdbmi_error_message:
+ * --------------------
+ *
+ *  Determines if the record being received is starting the message of an
+ *  error the user should see. gdb only logs the errors of CLI commands.
+ */
+static int gdbmi_error_message(struct tgdb_gdbmi *gdbmi)
+{
+    static const char prefix[] = "^error,msg=\"";
+    const char *line = ibuf_get(gdbmi->record_line);
+
+    /* Like when non-stop mode is set after the program started */
+    if (gdbmi->command == GDBMI_MI_ASYNC || gdbmi->command == GDBMI_NON_STOP)
+        ;
+    else if (gdbmi->command != GDBMI_VOID || !gdbmi->mi_command)
+        return 0;
+
+    line += strspn(line, "0123456789");
+
+    return strcmp(line, prefix) == 0;
+}
+
+/*
+ * The output of gdb is handled a line at a time, as it comes.
+ * 1. The text of the stream records is decoded, and goes to the console,
+ *    or to the command tgdb is running.
+ * 2. The result and asynchronous records are parsed as their lines
+ *    end. Only the line being received is kept, the parser builds the
+ *    output command from the records.
+ * 3. When the prompt comes, the front end is told what it needs to know
+ *    about the output command.
+ */
+int gdbmi_parse_io(void *ctx,
+        const char *input_data, const size_t input_data_size,
+        char *debugger_output, size_t * debugger_output_size,
+        char *inferior_output, size_t * inferior_output_size,
+        struct tgdb_list *list)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+    gdbmi_output_ptr output;
+    int found_command = 0;
+    size_t i, j, n = 0;
+    char c;
+
+    for (i = 0; i < input_data_size; i++) {
+        c = input_data[i];
+
+        /* The lines end in \r\n on the pty, the \r never matters */
+        if (c == '\r' && gdbmi->line_state != GDBMI_LINE_STREAM &&
+                gdbmi->line_state != GDBMI_LINE_STREAM_OCTAL)
+            continue;
+
+        if (gdbmi->stream_in_record)
+            ibuf_addchar(gdbmi->record_line, c);
+
+        switch (gdbmi->line_state) {
+            case GDBMI_LINE_START:
+                if (c == '\n')
+                    break;
+
+                if (c == '~' || c == '@' || c == '&') {
+                    gdbmi->stream_kind = c;
+                    gdbmi->line_state = GDBMI_LINE_STREAM_OPEN;
+                } else if (isdigit((unsigned char) c) || c == '^' ||
+                        c == '*' || c == '+' || c == '=' || c == '(') {
+                    ibuf_addchar(gdbmi->record_line, c);
+                    gdbmi->line_state = GDBMI_LINE_RECORD;
+                } else {
+                    debugger_output[n++] = c;
+                    gdbmi->line_state = GDBMI_LINE_TEXT;
+                }
+                break;
+            case GDBMI_LINE_TEXT:
+                debugger_output[n++] = c;
+                if (c == '\n')
+                    gdbmi->line_state = GDBMI_LINE_START;
+                break;
+            case GDBMI_LINE_RECORD:
+                if (c == '\n') {
+                    gdbmi->line_state = GDBMI_LINE_START;
+                    if (strncmp(ibuf_get(gdbmi->record_line), "*stopped",
+                                    8) == 0)
+                        gdbmi_send_log(gdbmi, 1, debugger_output, &n, list);
+                    if (gdbmi_record_line(gdbmi, &output) &&
+                            gdbmi_process_output(gdbmi, output, list))
+                        found_command = 1;
+                    destroy_gdbmi_output(output);
+                    break;
+                }
+
+                if (c != '"') {
+                    /* The record up to the next quote or the end of the
+                     * line goes in at once */
+                    for (j = i + 1; j < input_data_size; j++)
+                        if (input_data[j] == '\n' || input_data[j] == '"' ||
+                                input_data[j] == '\r')
+                            break;
+
+                    ibuf_addn(gdbmi->record_line, input_data + i, j - i);
+                    i = j - 1;
+                    break;
+                }
+
+                ibuf_addchar(gdbmi->record_line, c);
+                if (gdbmi_error_message(gdbmi)) {
+                    gdbmi->stream_in_record = 1;
+                    gdbmi->stream_target = GDBMI_STREAM_OUTPUT;
+                    gdbmi->line_state = GDBMI_LINE_STREAM;
+                }
+                break;
+            case GDBMI_LINE_STREAM_OPEN:
+                if (c == '"') {
+                    gdbmi->stream_target =
+                            gdbmi_stream_start(gdbmi, gdbmi->stream_kind);
+                    gdbmi->line_state = GDBMI_LINE_STREAM;
+                } else {
+                    /* It only looked like a stream record */
+                    debugger_output[n++] = gdbmi->stream_kind;
+                    debugger_output[n++] = c;
+                    gdbmi->line_state =
+                            c == '\n' ? GDBMI_LINE_START : GDBMI_LINE_TEXT;
+                }
+                break;
+            case GDBMI_LINE_STREAM:
+                if (c == '\\')
+                    gdbmi->line_state = GDBMI_LINE_STREAM_ESCAPE;
+                else if (c == '"') {
+                    if (gdbmi->stream_in_record) {
+                        gdbmi_stream_char(gdbmi, '\n', debugger_output, &n);
+                        gdbmi->stream_in_record = 0;
+                        gdbmi->line_state = GDBMI_LINE_RECORD;
+                    } else
+                        gdbmi->line_state = GDBMI_LINE_STREAM_CLOSE;
+                } else if (c == '\n') {
+                    /* The C string wasn't closed */
+                    if (gdbmi->stream_in_record)
+                        ibuf_clear(gdbmi->record_line);
+                    gdbmi->stream_in_record = 0;
+                    gdbmi->line_state = GDBMI_LINE_START;
+                } else
+                    gdbmi_stream_char(gdbmi, c, debugger_output, &n);
+                break;
+            case GDBMI_LINE_STREAM_ESCAPE:
+                if (c >= '0' && c <= '7') {
+                    gdbmi->octal = c - '0';
+                    gdbmi->octal_digits = 1;
+                    gdbmi->line_state = GDBMI_LINE_STREAM_OCTAL;
+                } else {
+                    gdbmi_stream_char(gdbmi, gdbmi_stream_escape(c),
+                            debugger_output, &n);
+                    gdbmi->line_state = GDBMI_LINE_STREAM;
+                }
+                break;
+            case GDBMI_LINE_STREAM_OCTAL:
+                if (c >= '0' && c <= '7' && gdbmi->octal_digits < 3) {
+                    gdbmi->octal = gdbmi->octal * 8 + c - '0';
+                    gdbmi->octal_digits++;
+                    break;
+                }
+
+                gdbmi_stream_char(gdbmi, (char) gdbmi->octal,
+                        debugger_output, &n);
+                gdbmi->line_state = GDBMI_LINE_STREAM;
+
+                /* The character after the escape is looked at again */
+                if (gdbmi->stream_in_record)
+                    ibuf_delchar(gdbmi->record_line);
+                i--;
+                break;
+            case GDBMI_LINE_STREAM_CLOSE:
+                if (c == '\n')
+                    gdbmi->line_state = GDBMI_LINE_START;
+                break;
+        }
+    }
+
+    /* The rest is shown in the log as it comes, without waiting to see if
+     * a *stopped follows */
+    gdbmi_send_log(gdbmi, 0, debugger_output, &n, list);
+
+    /* The thread didn't run again at once, it's shown where it stopped */
+    gdbmi_send_stop(gdbmi, list);
+    gdbmi_send_threads(gdbmi, list);
+
+    *debugger_output_size = n;
+    *inferior_output_size = 0;
+
+    return found_command;
+}
+
+struct tgdb_list *gdbmi_get_client_commands(void *ctx)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+
+    return gdbmi->client_command_list;
+}
+
+int gdbmi_get_source_filename_pair(void *ctx, const char *file,
+        struct tgdb_list *list)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+    struct gdbmi_filename_pair *pair;
+    struct tgdb_response *response;
+
+    /* A core dump's sources don't move, the front end gets it right away */
+    if (gdbmi->core && (pair = (struct gdbmi_filename_pair *)
+                    std_ohash_table_lookup(gdbmi->filename_pairs,
+                            std_intern(file)))) {
+        response = gdbmi_append_response(gdbmi, list, TGDB_FILENAME_PAIR);
+        response->choice.filename_pair.absolute_path = pair->absolute_path;
+        response->choice.filename_pair.relative_path = pair->relative_path;
+        return 0;
+    }
+
+    free(gdbmi->last_file_requested);
+    gdbmi->last_file_requested = cgdb_strdup(file);
+
+    if (gdbmi_issue_command(gdbmi, GDBMI_LIST_SOURCE, file) == -1 ||
+            gdbmi_issue_command(gdbmi, GDBMI_INFO_SOURCE_ABSOLUTE,
+                    NULL) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
+int gdbmi_get_current_location(void *ctx, int on_startup)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+
+    /* Until something runs, the file with main in it is the current one
+     * once it's listed */
+    if (on_startup) {
+        free(gdbmi->last_file_requested);
+        gdbmi->last_file_requested = NULL;
+
+        if (gdbmi_issue_command(gdbmi, GDBMI_LIST_SOURCE, NULL) == -1) {
+            logger_write_pos(logger, __FILE__, __LINE__,
+                    "gdbmi_issue_command error");
+            return -1;
+        }
+    }
+
+    if (gdbmi_issue_command(gdbmi, GDBMI_INFO_SOURCE_RELATIVE, NULL) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    /* gdb may have been started on a core dump */
+    if (on_startup &&
+            gdbmi_issue_command(gdbmi, GDBMI_INFO_TARGET, NULL) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
+int gdbmi_get_inferior_sources(void *ctx)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+
+    if (gdbmi_issue_command(gdbmi, GDBMI_INFO_SOURCES, NULL) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
+char *gdbmi_return_client_command(void *ctx, enum tgdb_command_type c)
+{
+    char *ret = NULL;
+
+    switch (c) {
+        case TGDB_CONTINUE:
+            ret = "continue";
+            break;
+        case TGDB_FINISH:
+            ret = "finish";
+            break;
+        case TGDB_NEXT:
+            ret = "next";
+            break;
+        case TGDB_START:
+            ret = "start";
+            break;
+        case TGDB_RUN:
+            ret = "run";
+            break;
+        case TGDB_KILL:
+            ret = "kill";
+            break;
+        case TGDB_STEP:
+            ret = "step";
+            break;
+        case TGDB_UNTIL:
+            ret = "until";
+            break;
+        case TGDB_UP:
+            ret = "up";
+            break;
+        case TGDB_DOWN:
+            ret = "down";
+            break;
+        case TGDB_ERROR:
+            break;
+    }
+
+    return ret;
+}
+
+char *gdbmi_client_modify_breakpoint(void *ctx,
+        const char *file, int line, enum tgdb_breakpoint_action b)
+{
+    const char *command;
+    char *path, *val;
+
+    if (b == TGDB_BREAKPOINT_ADD)
+        command = "break";
+    else if (b == TGDB_BREAKPOINT_DELETE)
+        command = "clear";
+    else if (b == TGDB_TBREAKPOINT_ADD)
+        command = "tbreak";
+    else
+        return NULL;
+
+    /* A quote or a backslash in the path would end it early */
+    path = fs_util_quote_path(file);
+    val = (char *) cgdb_malloc(sizeof (char) * (strlen(path) + 128));
+    sprintf(val, "%s %s:%d", command, path, line);
+    free(path);
+
+    return val;
+}
+
+pid_t gdbmi_get_debugger_pid(void *ctx)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+
+    return gdbmi->debugger_pid;
+}
+
+int gdbmi_completion_callback(void *ctx, const char *command)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+
+    if (gdbmi_issue_command(gdbmi, GDBMI_COMPLETE, command) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
+/* gdb tells about each breakpoint that changes, they aren't asked for */
 int gdbmi_user_ran_command(void *ctx)
 {
     return 0;
 }
 
+/* gdbmi_changes_breakpoints:
+ * --------------------------
+ *
+ *  Determines if an MI command the user typed can change breakpoints.
+ *
+ *  command: The command, as it is written to gdb.
+ *
+ *  Returns: 1 if it can, 0 otherwise.
+ */
+static int gdbmi_changes_breakpoints(const char *command)
+{
+    command += strspn(command, " \t");
+
+    return strncmp(command, "-break-", 7) == 0 ||
+            strncmp(command, "-dprintf-", 9) == 0;
+}
+
+/* gdbmi_changes_frame:
+ * --------------------
+ *
+ *  Determines if a command the user typed can select another frame. Only
+ *  newer versions of gdb tell where it is.
+ *
+ *  command: The command, as it is written to gdb.
+ *
+ *  Returns: 1 if it can, 0 otherwise.
+ */
+static int gdbmi_changes_frame(const char *command)
+{
+    static const char *words[] = {
+        "up", "down", "frame", "f", "up-silently", "down-silently",
+        "select-frame", "thread", "-stack-select-frame", "-thread-select",
+        NULL
+    };
+    const char **words_ptr;
+    size_t length;
+
+    if (!command)
+        return 0;
+
+    while (isspace((unsigned char) *command))
+        command++;
+
+    length = strcspn(command, " \t\n");
+
+    for (words_ptr = words; *words_ptr; words_ptr++)
+        if (strlen(*words_ptr) == length &&
+                strncmp(command, *words_ptr, length) == 0)
+            return 1;
+
+    return 0;
+}
+
+/* gdbmi_loads_core:
+ * -----------------
+ *
+ *  Determines if a command the user typed can load a core dump, or make
+ *  gdb debug something else than the one it has.
+ *
+ *  command: The command, as it is written to gdb.
+ *
+ *  Returns: 1 if it can, 0 otherwise.
+ */
+static int gdbmi_loads_core(const char *command)
+{
+    static const char *words[] = {
+        "core", "core-file", "target", "file", "detach", "kill", NULL
+    };
+    const char **words_ptr;
+    size_t length;
+
+    while (isspace((unsigned char) *command))
+        command++;
+
+    length = strcspn(command, " \t\n");
+
+    for (words_ptr = words; *words_ptr; words_ptr++)
+        if (strlen(*words_ptr) == length &&
+                strncmp(command, *words_ptr, length) == 0)
+            return 1;
+
+    return 0;
+}
+
+int gdbmi_disassemble(void *ctx, const char *address)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+
+    if (gdbmi_issue_command(gdbmi, GDBMI_DISASSEMBLE, address) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
+int gdbmi_variable(void *ctx, enum tgdb_variable_command command,
+        const char *name)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+    enum gdbmi_commands g_com;
+
+    switch (command) {
+        case TGDB_VARIABLE_CREATE:
+            g_com = GDBMI_VARIABLE_CREATE;
+            break;
+        case TGDB_VARIABLE_UPDATE:
+            g_com = GDBMI_VARIABLE_UPDATE;
+            break;
+        case TGDB_VARIABLE_CHILDREN:
+            g_com = GDBMI_VARIABLE_CHILDREN;
+            break;
+        case TGDB_VARIABLE_DELETE:
+            g_com = GDBMI_VARIABLE_DELETE;
+            break;
+        case TGDB_VARIABLE_DELETE_CHILDREN:
+            g_com = GDBMI_VARIABLE_DELETE_CHILDREN;
+            break;
+        case TGDB_VARIABLE_LOCALS:
+            g_com = GDBMI_LOCALS;
+            break;
+        default:
+            logger_write_pos(logger, __FILE__, __LINE__, "switch error");
+            return -1;
+    }
+
+    /* All but the whole updates and the locals are of something */
+    if (!name && g_com != GDBMI_VARIABLE_UPDATE && g_com != GDBMI_LOCALS) {
+        logger_write_pos(logger, __FILE__, __LINE__, "no variable given");
+        return -1;
+    }
+
+    if (gdbmi_issue_command(gdbmi, g_com, name) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
+int gdbmi_read_memory(void *ctx, const char *address, int length)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+    struct ibuf *data;
+    char number[32];
+    int result;
+
+    if (!address || length <= 0) {
+        logger_write_pos(logger, __FILE__, __LINE__, "no memory given");
+        return -1;
+    }
+
+    /* The address is an expression, it's quoted so it can have spaces */
+    data = ibuf_init();
+    ibuf_addchar(data, '"');
+    for (; *address; address++) {
+        if (*address == '"' || *address == '\\')
+            ibuf_addchar(data, '\\');
+        ibuf_addchar(data, *address);
+    }
+    snprintf(number, sizeof (number), "\" %d", length);
+    ibuf_add(data, number);
+
+    result = gdbmi_issue_command(gdbmi, GDBMI_READ_MEMORY, ibuf_get(data));
+    ibuf_free(data);
+
+    if (result == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
+int gdbmi_list_frames(void *ctx, int thread, int low, int high)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+    char data[64];
+
+    if (thread < 0 || low < 0 || high < low) {
+        logger_write_pos(logger, __FILE__, __LINE__, "no frames given");
+        return -1;
+    }
+
+    /* gdb goes back to the thread it looked at when it's done */
+    if (thread > 0)
+        snprintf(data, sizeof (data), "--thread %d %d %d", thread, low, high);
+    else
+        snprintf(data, sizeof (data), "%d %d", low, high);
+    if (gdbmi_issue_command(gdbmi, GDBMI_LIST_FRAMES, data) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
+int gdbmi_select_frame(void *ctx, int level)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+    char data[32];
+
+    if (level < 0) {
+        logger_write_pos(logger, __FILE__, __LINE__, "no frame given");
+        return -1;
+    }
+
+    snprintf(data, sizeof (data), "%d", level);
+    if (gdbmi_issue_command(gdbmi, GDBMI_SELECT_FRAME, data) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
+int gdbmi_select_thread(void *ctx, int id)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+    char data[32];
+
+    if (id <= 0) {
+        logger_write_pos(logger, __FILE__, __LINE__, "no thread given");
+        return -1;
+    }
+
+    snprintf(data, sizeof (data), "%d", id);
+    if (gdbmi_issue_command(gdbmi, GDBMI_SELECT_THREAD, data) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    /* The commands after it are run in that thread */
+    gdbmi->thread = id;
+
+    return 0;
+}
+
+int gdbmi_sample(void *ctx, int depth)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+
+    if (depth == 0) {
+        if (gdbmi->sample_state == GDBMI_SAMPLE_WAITING)
+            gdbmi->sample_state = GDBMI_SAMPLE_IDLE;
+        else if (gdbmi->sample_state == GDBMI_SAMPLE_TAKING)
+            gdbmi->sample_cancelled = 1;
+        return 0;
+    }
+
+    /* gdb doesn't stop the program for the interrupt in non-stop mode */
+    if (depth < 0 || !gdbmi->running || gdbmi->non_stop ||
+            gdbmi->sample_state != GDBMI_SAMPLE_IDLE)
+        return -1;
+
+    gdbmi->sample_state = GDBMI_SAMPLE_WAITING;
+    gdbmi->sample_depth = depth;
+
+    return 0;
+}
+
+int gdbmi_non_stop(void *ctx, int on)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+    const char *value = on ? "on" : "off";
+
+    /* gdb only takes commands while the program runs in async mode */
+    if (gdbmi_issue_command(gdbmi, GDBMI_MI_ASYNC, value) == -1 ||
+            gdbmi_issue_command(gdbmi, GDBMI_NON_STOP, value) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
+int gdbmi_interrupt(void *ctx)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+    int one = gdbmi->thread > 0 && gdbmi_thread_running(gdbmi, gdbmi->thread);
+
+    if (!gdbmi->non_stop)
+        return -1;
+
+    if (gdbmi_issue_command(gdbmi, GDBMI_INTERRUPT,
+                    one ? NULL : "--all") == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdbmi_issue_command error");
+        return -1;
+    }
+
+    return 0;
+}
+
 int gdbmi_prepare_for_command(void *ctx, struct tgdb_command *com)
+{
+    struct tgdb_gdbmi *gdbmi = (struct tgdb_gdbmi *) ctx;
+    enum gdbmi_commands *g_com =
+            (enum gdbmi_commands *) com->tgdb_client_private_data;
+    const char *data = com->tgdb_command_data;
+
+    gdbmi->command = g_com ? *g_com : GDBMI_VOID;
+    gdbmi->at_prompt = 0;
+    gdbmi->echo_skipped = 1;
+    gdbmi->frame_reported = 0;
+    gdbmi->frame_command = 0;
+    gdbmi->mi_command = 0;
+    gdbmi->break_command = 0;
+    gdbmi->core_command = 0;
+
+    if (gdbmi->command == GDBMI_INFO_TARGET)
+        gdbmi->core_found = 0;
+
+    /* A list that worked leaves no failure behind */
+    if (gdbmi->command == GDBMI_LIST_SOURCE)
+        gdbmi->list_failed = 0;
+
+    /* The front end is done with the completions of the last time */
+    if (gdbmi->command == GDBMI_COMPLETE)
+        tgdb_list_free(gdbmi->completions, gdbmi_free_string);
+
+    if (gdbmi->command == GDBMI_DISASSEMBLE)
+        ibuf_clear(gdbmi->disassembly);
+
+    /* It's on or off */
+    if (gdbmi->command == GDBMI_NON_STOP)
+        gdbmi->non_stop_asked = strncmp(strrchr(data, ' ') + 1, "on", 2) == 0;
+
+    /* The length is what the command ends with */
+    if (gdbmi->command == GDBMI_READ_MEMORY)
+        gdbmi->memory_length = atoi(strrchr(data, ' ') + 1);
+
+    /* The thread, if there's one, and the low level come right after the
+     * name of the command */
+    if (gdbmi->command == GDBMI_LIST_FRAMES) {
+        const char *levels = strchr(data, ' ') + 1;
+
+        gdbmi->frames_thread = 0;
+        if (strncmp(levels, "--thread ", 9) == 0) {
+            gdbmi->frames_thread = atoi(levels + 9);
+            levels = strchr(levels + 9, ' ') + 1;
+        }
+        gdbmi->frames_low = atoi(levels);
+    }
+
+    if (!g_com && data) {
+        gdbmi->mi_command = data[strspn(data, " \t")] == '-';
+        gdbmi->echo_skipped = gdbmi->mi_command;
+        gdbmi->frame_command = gdbmi_changes_frame(data);
+        gdbmi->break_command = gdbmi->mi_command &&
+                gdbmi_changes_breakpoints(data);
+        gdbmi->core_command = !gdbmi->mi_command && gdbmi_loads_core(data);
+    }
+
+    io_debug_write_fmt("<%s\n>", data);
+
+    return 0;
+}
+
+int gdbmi_pipeline_command(void *ctx, struct tgdb_command *com)
 {
     return 0;
 }
 
-#if 0
-//int a2_is_misc_prompt ( void *ctx ) {
-//  struct annotate_two *a2 = (struct annotate_two *)ctx;
-//  return globals_is_misc_prompt ( a2->g );
-//}
-#endif
+/* MI has no prompts of its own, gdb answers its questions by itself */
+int gdbmi_is_misc_prompt(void *ctx)
+{
+    return 0;
+}
@@ -55,29 +55,105 @@ enum gdbmi_commands {
     GDBMI_INFO_SOURCES,
 
     /**
-	 * relative source path.
+	 * The current source file and line, for the front end's position.
 	 */
     GDBMI_INFO_SOURCE_RELATIVE,
 
     /**
-	 * absolute source path.
+	 * The absolute path of the source file that was listed last.
 	 */
     GDBMI_INFO_SOURCE_ABSOLUTE,
 
     /**
- 	 * Shows information on the current source file
+	 * The frame the user moved to.
 	 */
-    GDBMI_INFO_SOURCE,
+    GDBMI_INFO_FRAME,
 
     /**
- 	 * displays the contents of current source file
+ 	 * Makes a source file the current one, by listing it
 	 */
-    GDBMI_LIST,
+    GDBMI_LIST_SOURCE,
 
     /**
-	 * Sets the prompt.
+	 * Disassembles a function.
 	 */
-    GDBMI_SET_PROMPT
+    GDBMI_DISASSEMBLE,
+
+    /**
+	 * Creates a variable object.
+	 */
+    GDBMI_VARIABLE_CREATE,
+
+    /**
+	 * Lists the variable objects that changed.
+	 */
+    GDBMI_VARIABLE_UPDATE,
+
+    /**
+	 * Lists the children of a variable object.
+	 */
+    GDBMI_VARIABLE_CHILDREN,
+
+    /**
+	 * Deletes a variable object, or only its children.
+	 */
+    GDBMI_VARIABLE_DELETE,
+    GDBMI_VARIABLE_DELETE_CHILDREN,
+
+    /**
+	 * Lists the arguments and locals of the frame.
+	 */
+    GDBMI_LOCALS,
+
+    /**
+	 * Reads bytes of the memory of the inferior.
+	 */
+    GDBMI_READ_MEMORY,
+
+    /**
+	 * Lists a window of the frames of the stack.
+	 */
+    GDBMI_LIST_FRAMES,
+
+    /**
+	 * Makes another frame the one gdb looks at.
+	 */
+    GDBMI_SELECT_FRAME,
+
+    /**
+	 * Makes another thread the one gdb looks at.
+	 */
+    GDBMI_SELECT_THREAD,
+
+    /**
+	 * Lists the innermost frames of the program a sample stopped.
+	 */
+    GDBMI_SAMPLE_FRAMES,
+
+    /**
+	 * Continues the program a sample stopped.
+	 */
+    GDBMI_SAMPLE_CONTINUE,
+
+    /**
+	 * Makes gdb take commands while the program runs, or not.
+	 */
+    GDBMI_MI_ASYNC,
+
+    /**
+	 * Turns non-stop mode on or off.
+	 */
+    GDBMI_NON_STOP,
+
+    /**
+	 * Interrupts a thread, or all of them, in non-stop mode.
+	 */
+    GDBMI_INTERRUPT,
+
+    /**
+	 * Lists what gdb debugs, to tell if it's a core dump.
+	 */
+    GDBMI_INFO_TARGET
 };
 
 /******************************************************************************/
@@ -108,11 +184,18 @@ enum gdbmi_commands {
  * \param config_dir
  * The current config directory. Files can be stored here.
  *
+ * \param arena
+ * The arena the responses are allocated in. TGDB resets it after each batch.
+ *
+ * \param logger
+ * The data structure to report errors to.
+ *
  * @return
  * NULL on error, A valid descriptor upon success
  */
 void *gdbmi_create_context(const char *debugger_path,
-        int argc, char **argv, const char *config_dir, struct logger *logger);
+        int argc, char **argv, const char *config_dir,
+        struct std_arena *arena, struct logger *logger);
 
 /** 
  * This initializes the libgdbmi libarary.
@@ -165,8 +248,7 @@ int gdbmi_shutdown(void *ctx);
 
 /** 
  * Returns the last error message ?
- * Not implemented yet.
- * What should it return? How should errors be handled?
+ * Not implemented yet, gdb's errors are shown in the console.
  *
  * \param ctx
  * The gdbmi context.
@@ -306,18 +388,36 @@ struct tgdb_list *gdbmi_get_client_commands(void *ctx);
 /*@h*/
 
 /** 
- * Gets the Absolute path of FILE.
+ * Gets the absolute and relative path of FILE.
  *  
  * \param ctx
  * The gdbmi context.
  *
  * \param file
- * The relative path that gdb outputted.
+ * The path that gdb outputted.
+ *
+ * \param list
+ * Not used, the paths come back as a TGDB_FILENAME_PAIR.
  *
  * @return
  * 0 on success, otherwise -1 on error.
  */
-int gdbmi_get_source_absolute_filename(void *ctx, const char *file);
+int gdbmi_get_source_filename_pair(void *ctx, const char *file,
+        struct tgdb_list *list);
+
+/** 
+ * Gets the file and line gdb is currently at.
+ *
+ * \param ctx
+ * The gdbmi context.
+ *
+ * \param on_startup
+ * 1 if gdb just started, so the file with main in it is listed first.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error.
+ */
+int gdbmi_get_current_location(void *ctx, int on_startup);
 
 /** 
  * Gets all the source files that the inferior makes up.
@@ -331,46 +431,166 @@ int gdbmi_get_source_absolute_filename(void *ctx, const char *file);
 int gdbmi_get_inferior_sources(void *ctx);
 
 /** 
- * This will change the prompt the user sees to PROMPT.
+ * This is called when readline determines a command needs to be completed.
  *
  * \param ctx
  * The gdbmi context.
  *
- * \param prompt
- * The new prompt to change too.
+ * \param command
+ * The command to be completed
  *
  * @return
  * 0 on success, otherwise -1 on error.
  */
-int gdbmi_change_prompt(void *ctx, const char *prompt);
+int gdbmi_completion_callback(void *ctx, const char *command);
 
 /** 
- * This is called when readline determines a command has been typed. 
+ * This asks gdb for the instructions of a function.
  *
  * \param ctx
  * The gdbmi context.
  *
- * \param command
- * The command the user typed without the '\n'.
+ * \param address
+ * An address in the function, or NULL for the one gdb is at.
  *
  * @return
  * 0 on success, otherwise -1 on error.
  */
-int gdbmi_command_callback(void *ctx, const char *command);
+int gdbmi_disassemble(void *ctx, const char *address);
 
 /** 
- * This is called when readline determines a command needs to be completed.
+ * This asks gdb to do something with its variable objects.
  *
  * \param ctx
  * The gdbmi context.
  *
  * \param command
- * The command to be completed
+ * What to do.
+ *
+ * \param name
+ * The expression or the variable object it's done to, or NULL.
  *
  * @return
  * 0 on success, otherwise -1 on error.
  */
-int gdbmi_completion_callback(void *ctx, const char *command);
+int gdbmi_variable(void *ctx, enum tgdb_variable_command command,
+        const char *name);
+
+/** 
+ * This asks gdb for bytes of the memory of the inferior.
+ *
+ * \param ctx
+ * The gdbmi context.
+ *
+ * \param address
+ * An expression for the address of the first byte.
+ *
+ * \param length
+ * How many bytes to read.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error.
+ */
+int gdbmi_read_memory(void *ctx, const char *address, int length);
+
+/** 
+ * This asks gdb for a window of the frames of the stack.
+ *
+ * \param ctx
+ * The gdbmi context.
+ *
+ * \param thread
+ * The global number of the thread, 0 for the one gdb looks at.
+ *
+ * \param low
+ * The level of the first frame.
+ *
+ * \param high
+ * The level of the last frame.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error.
+ */
+int gdbmi_list_frames(void *ctx, int thread, int low, int high);
+
+/** 
+ * This makes gdb look at another frame.
+ *
+ * \param ctx
+ * The gdbmi context.
+ *
+ * \param level
+ * The level of the frame.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error.
+ */
+int gdbmi_select_frame(void *ctx, int level);
+
+/** 
+ * This makes gdb look at another thread.
+ *
+ * \param ctx
+ * The gdbmi context.
+ *
+ * \param id
+ * The global number of the thread.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error.
+ */
+int gdbmi_select_thread(void *ctx, int id);
+
+/** 
+ * This gets ready to take a sample of where the running program is, when
+ * the interrupt tgdb sends next stops it. The innermost frames are listed
+ * and the program is continued, the console shows nothing of it.
+ *
+ * \param ctx
+ * The gdbmi context.
+ *
+ * \param depth
+ * How many frames to list. 0 makes the next stop the user's again, when
+ * the user interrupts the program too, that always succeeds.
+ *
+ * @return
+ * 0 on success, otherwise -1 if the program isn't running, a sample is
+ * being taken already, or gdb is in non-stop mode.
+ */
+int gdbmi_sample(void *ctx, int depth);
+
+/** 
+ * This turns gdb's non-stop mode on or off, it has to be before the
+ * program runs. In non-stop mode, a thread that stops doesn't stop the
+ * others, and gdb takes commands while they run. The front end is told
+ * about each thread that runs or stops, and where a thread stopped only
+ * when it's the one gdb looks at, or that one runs.
+ *
+ * \param ctx
+ * The gdbmi context.
+ *
+ * \param on
+ * 1 to turn it on, 0 to turn it off.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error.
+ */
+int gdbmi_non_stop(void *ctx, int on);
+
+/** 
+ * This interrupts the program with a command, in non-stop mode, where gdb
+ * doesn't stop it when it gets the interrupt character. It's the thread
+ * gdb looks at that's stopped, or all of them if that one is stopped
+ * already.
+ *
+ * \param ctx
+ * The gdbmi context.
+ *
+ * @return
+ * 0 if the command was queued, or -1 if gdb isn't in non-stop mode, and
+ * should get the interrupt character.
+ */
+int gdbmi_interrupt(void *ctx);
 
 /** 
  * This returns the command to send to gdb for the enum C.
@@ -415,6 +635,20 @@ char *gdbmi_client_modify_breakpoint(void *ctx,
  */
 pid_t gdbmi_get_debugger_pid(void *ctx);
 
+/** 
+ * gdb answers one MI command at a time, so nothing is pipelined.
+ *
+ * \param ctx
+ * The gdbmi context.
+ *
+ * \param com
+ * The command that could be written now.
+ *
+ * @return
+ * 0, the command waits its turn.
+ */
+int gdbmi_pipeline_command(void *ctx, struct tgdb_command *com);
+
 /*@}*/
 
 /******************************************************************************/
@@ -448,7 +682,7 @@ int gdbmi_open_new_tty(void *ctx, int *inferior_stdin, int *inferior_stdout);
  * @return
  * tty name on success, otherwise NULL on error.
  */
-char *gdbmi_get_tty_name(void *ctx);
+const char *gdbmi_get_tty_name(void *ctx);
 
 /*@}*/
 
@@ -0,0 +1,325 @@
+/*
+ * a2_transcript: Runs canned gdb output through annotate-two, and checks
+ * what it makes of it.
+ *
+ * Each transcript writes commands to gdb back to back, the way tgdb
+ * pipelines them, and then gives annotate-two what gdb printed for them.
+ * gdb reads the commands one at a time, so its output for each one follows
+ * the prompt of the one before it. The responses annotate-two makes have
+ * to come out in order, one set for each command, and it must be at the
+ * prompt once, and only once, the last command is done.
+ *
+ * annotate-two starts this program in place of gdb, which throws away the
+ * commands it's sent. "make check" runs it.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_LIMITS_H
+#include <limits.h>
+#endif /* HAVE_LIMITS_H */
+
+#if HAVE_DIRENT_H
+#include <dirent.h>
+#endif /* HAVE_DIRENT_H */
+
+#include "a2-tgdb.h"
+#include "tgdb_command.h"
+#include "tgdb_types.h"
+#include "tgdb_list.h"
+#include "std_arena.h"
+#include "logger.h"
+
+/* Set in the environment of the stand in for gdb */
+#define TRANSCRIPT_SINK "A2_TRANSCRIPT_SINK"
+
+/* The start of an annotation */
+#define A "\n\032\032"
+
+/* What gdb prints after it reads a command, and when it's done with it */
+#define POST_PROMPT A "post-prompt\n"
+#define PROMPT A "pre-prompt\n(gdb) " A "prompt\n"
+
+/* The commands a transcript writes to gdb */
+enum transcript_command {
+    TRANSCRIPT_BREAKPOINTS,     /* 'info breakpoints' */
+    TRANSCRIPT_SOURCES,         /* 'info sources' */
+    TRANSCRIPT_COMPLETE         /* 'complete b ma' */
+};
+
+struct transcript {
+    const char *name;
+
+    /* The commands, in the order they're written to gdb */
+    enum transcript_command commands[4];
+    int count;
+
+    /* What gdb prints for all of them */
+    const char *output;
+
+    /* The responses annotate-two has to make, in order */
+    enum INTERFACE_RESPONSE_COMMANDS responses[8];
+    int responses_count;
+};
+
+static struct transcript transcripts[] = {
+    {
+        "pipeline",
+        {TRANSCRIPT_SOURCES, TRANSCRIPT_COMPLETE}, 2,
+        POST_PROMPT
+        "Source files for which symbols have been read in:\n\n"
+        "/tmp/main.c, /tmp/util.c\n\n"
+        "Source files for which symbols will be read in on demand:\n\n\n"
+        PROMPT
+        POST_PROMPT "b main\n" PROMPT,
+        {TGDB_ADD_SOURCE_FILES, TGDB_UPDATE_SOURCE_FILES,
+                    TGDB_UPDATE_COMPLETIONS}, 3
+    },
+
+    /* gdb reports the error and goes on with the commands after it, an
+     * error doesn't throw away what's been written to it. There are no
+     * breakpoints, which isn't news to the gui. */
+    {
+        "error in a pipeline",
+        {TRANSCRIPT_BREAKPOINTS, TRANSCRIPT_SOURCES, TRANSCRIPT_COMPLETE}, 3,
+        POST_PROMPT "No breakpoints or watchpoints.\n" PROMPT
+        POST_PROMPT
+        A "error-begin\n"
+        "No symbol table is loaded.  Use the \"file\" command.\n"
+        A "error\n" PROMPT
+        POST_PROMPT "b main\n" PROMPT,
+        {TGDB_SOURCES_DENIED, TGDB_UPDATE_SOURCE_FILES,
+                    TGDB_UPDATE_COMPLETIONS}, 3
+    }
+};
+
+/* Stands in for gdb, and throws away what annotate-two sends it */
+static int sink(void)
+{
+    char buf[4096];
+
+    while (read(STDIN_FILENO, buf, sizeof (buf)) > 0);
+
+    return 0;
+}
+
+/* Removes the directory annotate-two kept its files in */
+static void remove_dir(const char *path)
+{
+    char entry_path[PATH_MAX];
+    struct dirent *entry;
+    DIR *dir;
+
+    if ((dir = opendir(path)) != NULL) {
+        while ((entry = readdir(dir)) != NULL) {
+            if (strcmp(entry->d_name, ".") == 0 ||
+                    strcmp(entry->d_name, "..") == 0)
+                continue;
+
+            snprintf(entry_path, sizeof (entry_path), "%s/%s", path,
+                    entry->d_name);
+            remove(entry_path);
+        }
+        closedir(dir);
+    }
+
+    remove(path);
+}
+
+static int command_free(void *item)
+{
+    struct tgdb_command *command = (struct tgdb_command *) item;
+
+    free(command->tgdb_command_data);
+    free(command->tgdb_client_private_data);
+    tgdb_command_destroy(command);
+
+    return 0;
+}
+
+static int issue(void *a2, enum transcript_command command)
+{
+    switch (command) {
+        case TRANSCRIPT_BREAKPOINTS:
+            return a2_user_ran_command(a2);
+        case TRANSCRIPT_SOURCES:
+            return a2_get_inferior_sources(a2);
+        case TRANSCRIPT_COMPLETE:
+            return a2_completion_callback(a2, "b ma");
+    }
+
+    return -1;
+}
+
+/* Gives annotate-two output, as if it was read from gdb. The output gdb
+ * printed is written to console. Returns 1 if the command finished. */
+static int parse(void *a2, const char *output, struct tgdb_list *responses,
+        char *console, size_t n)
+{
+    char inferior[16];
+    size_t console_size = n, inferior_size = sizeof (inferior);
+    int ret;
+
+    ret = a2_parse_io(a2, output, strlen(output), console, &console_size,
+            inferior, &inferior_size, responses);
+    console[console_size] = '\0';
+
+    return ret;
+}
+
+/* Runs a transcript, returns the number of failures */
+static int run(void *a2, struct std_arena *arena, struct transcript *t)
+{
+    struct tgdb_list *commands = a2_get_client_commands(a2);
+    struct tgdb_list *responses = tgdb_list_init();
+    struct tgdb_response *response;
+    tgdb_list_iterator *i;
+    char console[4096];
+    int failures = 0, finished, count = 0, k;
+
+    for (k = 0; k < t->count; k++)
+        if (issue(a2, t->commands[k]) == -1) {
+            printf("FAIL: %s: command %d wasn't issued\n", t->name, k);
+            return 1;
+        }
+
+    /* The first command runs, the rest are written right behind it */
+    k = 0;
+    for (i = tgdb_list_get_first(commands); i; i = tgdb_list_next(i), k++) {
+        struct tgdb_command *command = tgdb_list_get_item(i);
+
+        if (k == 0) {
+            if (a2_prepare_for_command(a2, command) == -1) {
+                printf("FAIL: %s: %s wasn't prepared\n", t->name,
+                        command->tgdb_command_data);
+                failures++;
+            }
+            command_free(command);
+        } else if (a2_pipeline_command(a2, command) != 1) {
+            printf("FAIL: %s: %s wasn't pipelined\n", t->name,
+                    command->tgdb_command_data);
+            command_free(command);
+            failures++;
+        }
+    }
+    tgdb_list_clear(commands);
+
+    if (k != t->count) {
+        printf("FAIL: %s: %d commands, not %d\n", t->name, k, t->count);
+        failures++;
+    }
+
+    finished = parse(a2, t->output, responses, console, sizeof (console));
+
+    for (i = tgdb_list_get_first(responses); i; i = tgdb_list_next(i)) {
+        response = tgdb_list_get_item(i);
+
+        if (count < t->responses_count &&
+                response->header == t->responses[count])
+            count++;
+        else if (response->header == TGDB_UPDATE_CONSOLE_PROMPT_VALUE)
+            continue;
+        else {
+            printf("FAIL: %s: response %d is %d\n", t->name, count,
+                    response->header);
+            failures++;
+        }
+    }
+
+    if (count != t->responses_count) {
+        printf("FAIL: %s: %d of %d responses\n", t->name, count,
+                t->responses_count);
+        failures++;
+    }
+
+    if (finished != 1 || !a2_is_client_ready(a2)) {
+        printf("FAIL: %s: not at the prompt at the end\n", t->name);
+        failures++;
+    }
+
+    /* Nothing of the internal commands is for the user */
+    if (console[0] != '\0') {
+        printf("FAIL: %s: the console got \"%s\"\n", t->name, console);
+        failures++;
+    }
+
+    if (failures == 0)
+        printf("PASS: %s\n", t->name);
+
+    tgdb_list_destroy(responses);
+    std_arena_reset(arena);
+
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    struct std_arena *arena;
+    struct tgdb_list *responses;
+    char self[PATH_MAX], dir[] = "/tmp/a2_transcript.XXXXXX";
+    char console[4096];
+    void *a2;
+    int debugger_stdin, debugger_stdout, inferior_stdin, inferior_stdout;
+    int failures = 0;
+    size_t k;
+
+    if (getenv(TRANSCRIPT_SINK))
+        return sink();
+
+    if (!realpath(argv[0], self)) {
+        fprintf(stderr, "%s:%d Can't find %s\n", __FILE__, __LINE__, argv[0]);
+        return 1;
+    }
+
+    if (!mkdtemp(dir)) {
+        fprintf(stderr, "%s:%d Can't make %s\n", __FILE__, __LINE__, dir);
+        return 1;
+    }
+    setenv(TRANSCRIPT_SINK, "1", 1);
+
+    logger = logger_create();
+    arena = std_arena_create();
+
+    a2 = a2_create_context(self, 0, NULL, dir, arena, logger);
+    if (!a2 || a2_initialize(a2, &debugger_stdin, &debugger_stdout,
+                    &inferior_stdin, &inferior_stdout) == -1) {
+        fprintf(stderr, "%s:%d Can't start annotate-two\n", __FILE__,
+                __LINE__);
+        return 1;
+    }
+
+    /* Get to the first prompt, without the commands annotate-two starts
+     * with */
+    tgdb_list_free(a2_get_client_commands(a2), command_free);
+    responses = tgdb_list_init();
+    parse(a2, "GNU gdb" PROMPT, responses, console, sizeof (console));
+    tgdb_list_destroy(responses);
+    std_arena_reset(arena);
+
+    for (k = 0; k < sizeof (transcripts) / sizeof (transcripts[0]); k++)
+        failures += run(a2, arena, &transcripts[k]);
+
+    a2_shutdown(a2);
+    std_arena_destroy(arena);
+    remove_dir(dir);
+
+    return failures ? 1 : 0;
+}
@@ -492,7 +492,7 @@ int main(int argc, char **argv)
     rline = rline_initialize(slavefd, rlctx_send_user_command, tab_completion,
             getenv("TERM"));
 
-    if ((tgdb = tgdb_initialize(NULL, argc - 1, argv + 1, &gdb_fd)) == NULL) {
+    if ((tgdb = tgdb_initialize(NULL, argc - 1, argv + 1, &gdb_fd, 0)) == NULL) {
         logger_write_pos(logger, __FILE__, __LINE__, "tgdb_start error");
         goto driver_end;
     }
@@ -0,0 +1,266 @@
+/*
+ * fake_gdb: Stands in for gdb, to see how tgdb and cgdb hold up when gdb or
+ * the program being debugged print a lot.
+ *
+ * It speaks annotate-two, like "gdb --annotate=2", and knows a handful of
+ * commands. There's no program being debugged, what it prints is made up,
+ * as much of it as it's asked for.
+ *
+ *   text N        Prints N bytes of console output
+ *   frames N      Stops N times in a row, with the frame and source
+ *                 annotations gdb prints each time
+ *   next, step    Stops once, and so do "next N" and "step N", like gdb
+ *   breaks N      Makes 'info breakpoints' list N breakpoints
+ *   inferior N    The program prints N bytes to its terminal, while
+ *                 fake_gdb goes on taking commands
+ *   quit          Exits
+ *
+ * It also answers the commands tgdb runs itself, 'info breakpoints',
+ * 'info source', 'disassemble' and 'tty'. Anything else prints nothing.
+ *
+ * tgdb_stress drives it, or cgdb can be run with "cgdb -d fake_gdb".
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_SIGNAL_H
+#include <signal.h>
+#endif /* HAVE_SIGNAL_H */
+
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
+#define FAKE_FILE "/tmp/fake_gdb.c"
+#define FAKE_LINES 1000
+
+/* Each line is an instruction of main, 4 bytes long, from this address */
+#define FAKE_ADDRESS 0x401000UL
+#define FAKE_PC (FAKE_ADDRESS + (line - 1) * 4)
+
+/* The breakpoints 'info breakpoints' lists */
+static unsigned long breakpoints = 0;
+
+/* The program's terminal, from the 'tty' command */
+static char tty_name[4096];
+
+/* The line the program is stopped at */
+static unsigned long line = 1;
+
+static void annotation(const char *name)
+{
+    printf("\n\032\032%s\n", name);
+}
+
+static void prompt(void)
+{
+    annotation("pre-prompt");
+    printf("(gdb) ");
+    annotation("prompt");
+    fflush(stdout);
+}
+
+static void text(unsigned long size)
+{
+    char row[80];
+    unsigned long i;
+
+    memset(row, 'x', sizeof (row) - 1);
+    row[sizeof (row) - 1] = '\n';
+
+    for (i = 0; i + sizeof (row) <= size; i += sizeof (row))
+        fwrite(row, 1, sizeof (row), stdout);
+
+    if (i < size) {
+        fwrite(row, 1, size - i - 1, stdout);
+        putchar('\n');
+    }
+}
+
+static void stop(void)
+{
+    line = line % FAKE_LINES + 1;
+
+    annotation("starting");
+    printf("\n\032\032frame-begin 0 0x%lx\n", FAKE_PC);
+    printf("\032\032frame-function-name\nmain\n");
+    printf("\032\032frame-args\n ()\n");
+    printf("\032\032frame-source-begin\n at \n");
+    printf("\032\032frame-source-file\nfake_gdb.c\n");
+    printf("\032\032frame-source-file-end\n:\n");
+    printf("\032\032frame-source-line\n%lu\n", line);
+    printf("\032\032frame-source-end\n\n");
+    annotation("frame-end");
+    printf("\032\032source %s:%lu:%lu:beg:0x%lx\n", FAKE_FILE, line,
+            line * 20, FAKE_PC);
+    annotation("stopped");
+}
+
+static void field(int number)
+{
+    printf("\n\032\032field %d\n", number);
+}
+
+static void info_breakpoints(void)
+{
+    unsigned long i;
+
+    if (breakpoints == 0) {
+        printf("No breakpoints or watchpoints.\n");
+        return;
+    }
+
+    annotation("breakpoints-headers");
+    field(0);
+    printf("Num     ");
+    field(1);
+    printf("Type           ");
+    field(2);
+    printf("Disp ");
+    field(3);
+    printf("Enb ");
+    field(4);
+    printf("Address            ");
+    field(5);
+    printf("What");
+    annotation("breakpoints-table");
+
+    for (i = 0; i < breakpoints; i++) {
+        annotation("record");
+        field(0);
+        printf("%-7lu ", i + 1);
+        field(1);
+        printf("breakpoint     ");
+        field(2);
+        printf("keep ");
+        field(3);
+        printf("%c   ", i % 2 ? 'n' : 'y');
+        field(4);
+        printf("0x%016lx ", 0x401136 + i * 4);
+        field(5);
+        printf("in main at %s:%lu\n", FAKE_FILE, i % FAKE_LINES + 1);
+    }
+
+    annotation("breakpoints-table-end");
+}
+
+static void info_source(void)
+{
+    printf("Current source file is fake_gdb.c\n");
+    printf("Compilation directory is /tmp\n");
+    printf("Located in %s\n", FAKE_FILE);
+    printf("Contains %d lines.\n", FAKE_LINES);
+    printf("Source language is c.\n");
+}
+
+static void disassemble(void)
+{
+    unsigned long i;
+
+    printf("Dump of assembler code for function main:\n");
+    for (i = 0; i < FAKE_LINES; i++)
+        printf("%s0x%016lx <+%lu>:\tnop\n", i == line - 1 ? "=> " : "   ",
+                FAKE_ADDRESS + i * 4, i * 4);
+    printf("End of assembler dump.\n");
+}
+
+/* The program prints size bytes to its terminal, as fast as it can */
+static void inferior(unsigned long size)
+{
+    char buf[4096];
+    ssize_t n;
+    int fd;
+
+    if (tty_name[0] == '\0' || fork() != 0)
+        return;
+
+    fd = open(tty_name, O_WRONLY);
+    if (fd == -1)
+        _exit(1);
+
+    memset(buf, 'y', sizeof (buf));
+    buf[sizeof (buf) - 1] = '\n';
+
+    while (size > 0) {
+        n = write(fd, buf, size > sizeof (buf) ? sizeof (buf) : size);
+        if (n <= 0)
+            _exit(1);
+        size -= n;
+    }
+
+    _exit(0);
+}
+
+static void command(char *com)
+{
+    unsigned long n = 0;
+
+    com[strcspn(com, "\r\n")] = '\0';
+
+    /* tgdb runs its own commands this way */
+    if (strncmp(com, "server ", 7) == 0)
+        com += 7;
+
+    sscanf(com, "%*s %lu", &n);
+
+    if (strcmp(com, "info breakpoints") == 0)
+        info_breakpoints();
+    else if (strcmp(com, "info source") == 0)
+        info_source();
+    else if (strncmp(com, "disassemble", 11) == 0)
+        disassemble();
+    else if (strncmp(com, "tty ", 4) == 0) {
+        strncpy(tty_name, com + 4, sizeof (tty_name) - 1);
+        tty_name[sizeof (tty_name) - 1] = '\0';
+    } else if (strncmp(com, "text ", 5) == 0)
+        text(n);
+    else if (strncmp(com, "frames ", 7) == 0) {
+        while (n-- > 0)
+            stop();
+    } else if (strcmp(com, "next") == 0 || strcmp(com, "step") == 0 ||
+            strncmp(com, "next ", 5) == 0 || strncmp(com, "step ", 5) == 0)
+        stop();
+    else if (strncmp(com, "breaks ", 7) == 0)
+        breakpoints = n;
+    else if (strncmp(com, "inferior ", 9) == 0)
+        inferior(n);
+    else if (strcmp(com, "quit") == 0)
+        exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+    char com[4096];
+
+    /* The program's children aren't waited for */
+    signal(SIGCHLD, SIG_IGN);
+
+    printf("fake_gdb, it only pretends to debug.\n");
+    prompt();
+
+    while (fgets(com, sizeof (com), stdin)) {
+        annotation("post-prompt");
+        command(com);
+        prompt();
+    }
+
+    return 0;
+}
@@ -0,0 +1,23 @@
+#!/bin/sh
+#
+# Floods tgdb with output from fake_gdb, and reports how it keeps up.
+# "make stress" runs it in the build directory.
+#
+# The sizes can be changed in the environment,
+#   TEXT         bytes of console output gdb prints
+#   INFERIOR     bytes the program prints to its terminal
+#   BREAKPOINTS  breakpoints in each 'info breakpoints'
+#   FRAMES       stops in a row, each with frame and source annotations
+
+TEXT=${TEXT:-104857600}
+INFERIOR=${INFERIOR:-104857600}
+BREAKPOINTS=${BREAKPOINTS:-10000}
+FRAMES=${FRAMES:-10000}
+
+exec ./tgdb_stress -d "`pwd`/fake_gdb" \
+    "text $TEXT" \
+    "frames $FRAMES" \
+    "breaks $BREAKPOINTS" \
+    "next" \
+    "breaks 0" \
+    "inferior $INFERIOR"
@@ -3,6 +3,10 @@
 #include "config.h"
 #endif /* HAVE_CONFIG_H */
 
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
 #if HAVE_STDLIB_H
 #include <stdlib.h>
 #endif /* HAVE_STDLIB_H */
@@ -23,9 +27,18 @@
 #include <sys/wait.h>
 #endif
 
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
 #include "tgdb.h"
 #include "tgdb_command.h"
 #include "tgdb_client_interface.h"
+#include "tgdb_remote.h"
 #include "fs_util.h"
 #include "ibuf.h"
 #include "io.h"
@@ -35,12 +48,41 @@
 #include "fork_util.h"
 #include "sys_util.h"
 #include "tgdb_list.h"
+#include "std_arena.h"
 #include "logger.h"
+#include "stats.h"
+#include "tracer.h"
 
 /* }}} */
 
 static int num_loggers = 0;
 
+/* struct tgdb_pending {{{ */
+
+/**
+ * A request given to tgdb_request_submit that tgdb_dispatch_responses
+ * hasn't finished with.
+ */
+struct tgdb_pending {
+
+  /** The handle of the request.  */
+    int handle;
+
+  /** Where the request is at.  */
+    enum tgdb_request_status status;
+
+  /** The function to tell about the responses, or NULL.  */
+    tgdb_request_callback callback;
+
+  /** Passed along to callback.  */
+    void *data;
+
+  /** The request submitted after this one.  */
+    struct tgdb_pending *next;
+};
+
+/* }}} */
+
 /* struct tgdb {{{ */
 
 /**
@@ -51,9 +93,21 @@ struct tgdb {
   /** A client context to abstract the debugger.  */
     struct tgdb_client_context *tcc;
 
+  /**
+   * The connection to a headless tgdb, that talks to the debugger instead.
+   * It is NULL when tgdb runs the debugger itself, and tcc is NULL when it
+   * isn't.  */
+    struct tgdb_remote *remote;
+
   /** Reading from this will read from the debugger's output */
     int debugger_stdout;
 
+  /**
+   * This reads debugger_stdout on a thread of its own, so the debugger is
+   * never kept waiting while the front end draws. It is NULL if the thread
+   * couldn't be started, debugger_stdout is read directly then.  */
+    struct io_reader *debugger_reader;
+
   /** Writing to this will write to the debugger's stdin */
     int debugger_stdin;
 
@@ -63,6 +117,11 @@ struct tgdb {
   /** Writing to this will write to the stdin of the program being debugged */
     int inferior_stdin;
 
+  /**
+   * The keys waiting to be written to inferior_stdout. It is NULL if there
+   * was no memory for it, the keys are written right away then.  */
+    struct io_writer *inferior_writer;
+
   /***************************************************************************
    * All the queue's the clients can run commands through
    * The different queue's can be slightly confusing.
@@ -89,12 +148,20 @@ struct tgdb {
    * GDB and get a response, then the commands are buffered until it is there
    * turn to run. These commands are run in the order that they are recieved.
    *
-   * This is here as a convience to the FE. TGDB currently does not access 
-   * these commands. It provides the push/pop functionality and it erases the
-   * queue when a control_c is received.
+   * This is here as a convience to the FE. TGDB provides the push/pop
+   * functionality and it erases the queue when a control_c is received.
+   * The requests that only refresh what the FE shows go in
+   * gdb_client_refresh_queue instead, see tgdb_queue_append.
    */
     struct queue *gdb_client_request_queue;
 
+  /**
+   * The requests that only refresh what the FE shows. They run once
+   * gdb_client_request_queue is empty, and one that's already waiting
+   * isn't added again.
+   */
+    struct queue *gdb_client_refresh_queue;
+
   /** 
    * The out of band input queue. 
    *
@@ -127,6 +194,21 @@ struct tgdb {
   /** If ^c was hit by user */
     sig_atomic_t control_c;
 
+  /** 1 once tgdb_sample sent an interrupt, until the user sends one */
+    int sampling;
+
+  /** Where the debugger tests the conditions of the breakpoints set */
+    enum tgdb_condition_evaluation condition_evaluation;
+
+  /** The config directory, the breakpoint scripts are written in it */
+    char config_dir[FSUTIL_PATH_MAX];
+
+  /**
+   * The script of the last tgdb_request_add_breakpoints, or NULL. The
+   * debugger reads it when the request runs, so it's only removed when the
+   * next one is written, or on shutdown.  */
+    char *breakpoint_script;
+
   /**
    * This is the last GUI command that has been run.
    * It is used to display to the client the GUI commands.
@@ -152,6 +234,30 @@ struct tgdb {
   /** An iterator into command_list. */
     tgdb_list_iterator *command_list_iterator;
 
+  /**
+   * The responses in command_list, and what they point to, are allocated in
+   * this arena. It is reset when the front end is done with them.  */
+    struct std_arena *response_arena;
+
+  /** The requests given to tgdb_request_submit, oldest first.  */
+    struct tgdb_pending *pending;
+
+  /** The handle the next submitted request gets.  */
+    int next_handle;
+
+  /** The handle of the submitted request the debugger is running, or 0.  */
+    int running_handle;
+
+  /**
+   * The last response in command_list that was tagged with the request
+   * that made it, or NULL if none are yet.  */
+    tgdb_list_iterator *tagged;
+
+  /**
+   * The last response in command_list that tgdb_dispatch_responses gave
+   * to the callbacks, or NULL if it hasn't given any yet.  */
+    tgdb_list_iterator *dispatched;
+
   /**
    * When GDB dies (purposely or not), the SIGCHLD is sent to the application controlling TGDB.
    * This data structure represents the fact that SIGCHLD has been sent.
@@ -160,6 +266,18 @@ struct tgdb {
    * no matter how many are receieved, this will only be 1. Otherwise if none have been
    * received this will be 0.  */
     int has_sigchld_recv;
+
+  /**
+   * The debugger's output is read into this before it's parsed. It's kept
+   * from one call of tgdb_process to the next, and grows to the size asked
+   * for.  */
+    char *read_buf;
+    size_t read_buf_size;
+
+  /**
+   * When the command the debugger is running was written to it, for the
+   * statistics, or 0 if they aren't being recorded.  */
+    unsigned long long command_sent;
 };
 
 /* }}} */
@@ -168,6 +286,9 @@ struct tgdb {
 static int tgdb_deliver_command(struct tgdb *tgdb,
         struct tgdb_command *command);
 static int tgdb_unqueue_and_deliver_command(struct tgdb *tgdb);
+static int tgdb_pipeline_command(struct tgdb *tgdb,
+        struct tgdb_command *command);
+static int tgdb_request_matches_sent(void *item, void *data);
 static int tgdb_run_or_queue_command(struct tgdb *tgdb,
         struct tgdb_command *com);
 
@@ -214,15 +335,23 @@ static struct tgdb *initialize_tgdb_context(void)
     struct tgdb *tgdb = (struct tgdb *) cgdb_malloc(sizeof (struct tgdb));
 
     tgdb->tcc = NULL;
+    tgdb->remote = NULL;
     tgdb->control_c = 0;
+    tgdb->sampling = 0;
+    tgdb->condition_evaluation = TGDB_CONDITION_AUTO;
+    tgdb->config_dir[0] = '\0';
+    tgdb->breakpoint_script = NULL;
 
     tgdb->debugger_stdout = -1;
+    tgdb->debugger_reader = NULL;
     tgdb->debugger_stdin = -1;
 
     tgdb->inferior_stdout = -1;
     tgdb->inferior_stdin = -1;
+    tgdb->inferior_writer = io_writer_create();
 
     tgdb->gdb_client_request_queue = NULL;
+    tgdb->gdb_client_refresh_queue = NULL;
     tgdb->gdb_input_queue = NULL;
     tgdb->oob_input_queue = NULL;
 
@@ -232,9 +361,17 @@ static struct tgdb *initialize_tgdb_context(void)
     tgdb->show_gui_commands = 0;
 
     tgdb->command_list = tgdb_list_init();
+    tgdb->response_arena = std_arena_create();
+    tgdb->pending = NULL;
+    tgdb->next_handle = 0;
+    tgdb->running_handle = 0;
+    tgdb->tagged = NULL;
+    tgdb->dispatched = NULL;
     tgdb->has_sigchld_recv = 0;
 
-    logger = NULL;
+    tgdb->read_buf = NULL;
+    tgdb->read_buf_size = 0;
+    tgdb->command_sent = 0;
 
     return tgdb;
 }
@@ -315,14 +452,20 @@ static int tgdb_initialize_logger_interface(struct tgdb *tgdb, char *config_dir)
     return 0;
 }
 
-/* Createing and Destroying a libtgdb context. {{{*/
-
-struct tgdb *tgdb_initialize(const char *debugger,
-        int argc, char **argv, int *debugger_fd)
+/**
+ * Creates a tgdb context, with its config directory, logger and queues.
+ *
+ * \param config_dir
+ * Should be FSUTIL_PATH_MAX in size on way in.
+ * On way out, it will be the path to the config dir
+ *
+ * \return
+ * The context, or NULL on error.
+ */
+static struct tgdb *tgdb_create(char *config_dir)
 {
     /* Initialize the libtgdb context */
     struct tgdb *tgdb = initialize_tgdb_context();
-    char config_dir[FSUTIL_PATH_MAX];
 
     /* Create config directory */
     if (tgdb_initialize_config_dir(tgdb, config_dir) == -1) {
@@ -335,13 +478,32 @@ struct tgdb *tgdb_initialize(const char *debugger,
         return NULL;
     }
 
+    strcpy(tgdb->config_dir, config_dir);
+
     tgdb->gdb_client_request_queue = queue_init();
+    tgdb->gdb_client_refresh_queue = queue_init();
     tgdb->gdb_input_queue = queue_init();
     tgdb->oob_input_queue = queue_init();
 
+    return tgdb;
+}
+
+/* Createing and Destroying a libtgdb context. {{{*/
+
+struct tgdb *tgdb_initialize(const char *debugger,
+        int argc, char **argv, int *debugger_fd, int gdbmi)
+{
+    char config_dir[FSUTIL_PATH_MAX];
+    struct tgdb *tgdb = tgdb_create(config_dir);
+
+    if (!tgdb)
+        return NULL;
+
     tgdb->tcc = tgdb_client_create_context(debugger, argc, argv, config_dir,
             TGDB_CLIENT_DEBUGGER_GNU_GDB,
-            TGDB_CLIENT_PROTOCOL_GNU_GDB_ANNOTATE_TWO, logger);
+            gdbmi ? TGDB_CLIENT_PROTOCOL_GNU_GDB_GDBMI :
+            TGDB_CLIENT_PROTOCOL_GNU_GDB_ANNOTATE_TWO,
+            tgdb->response_arena, logger);
 
     /* create an instance and initialize a tgdb_client_context */
     if (tgdb->tcc == NULL) {
@@ -361,7 +523,34 @@ struct tgdb *tgdb_initialize(const char *debugger,
 
     tgdb_process_client_commands(tgdb);
 
-    *debugger_fd = tgdb->debugger_stdout;
+    tgdb->debugger_reader = io_reader_create(tgdb->debugger_stdout);
+    if (tgdb->debugger_reader)
+        *debugger_fd = io_reader_fd(tgdb->debugger_reader);
+    else {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "io_reader_create failed, reading gdb directly");
+        *debugger_fd = tgdb->debugger_stdout;
+    }
+
+    return tgdb;
+}
+
+struct tgdb *tgdb_initialize_remote(const char *command, int *debugger_fd)
+{
+    char config_dir[FSUTIL_PATH_MAX];
+    struct tgdb *tgdb = tgdb_create(config_dir);
+
+    if (!tgdb)
+        return NULL;
+
+    tgdb->remote = tgdb_remote_create(command);
+    if (!tgdb->remote) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_remote_create failed");
+        return NULL;
+    }
+
+    *debugger_fd = tgdb_remote_fd(tgdb->remote);
 
     return tgdb;
 }
@@ -374,10 +563,43 @@ int tgdb_shutdown(struct tgdb *tgdb)
             printf("Could not destroy logger interface\n");
             return -1;
         }
+        logger = NULL;
     }
 
     --num_loggers;
 
+    free(tgdb->read_buf);
+    tgdb->read_buf = NULL;
+
+    if (tgdb->breakpoint_script) {
+        unlink(tgdb->breakpoint_script);
+        free(tgdb->breakpoint_script);
+        tgdb->breakpoint_script = NULL;
+    }
+
+    io_reader_destroy(tgdb->debugger_reader);
+    tgdb->debugger_reader = NULL;
+
+    io_writer_destroy(tgdb->inferior_writer);
+    tgdb->inferior_writer = NULL;
+
+    tgdb_delete_responses(tgdb);
+    std_arena_destroy(tgdb->response_arena);
+    tgdb->response_arena = NULL;
+
+    while (tgdb->pending) {
+        struct tgdb_pending *pending = tgdb->pending;
+
+        tgdb->pending = pending->next;
+        free(pending);
+    }
+
+    if (tgdb->remote) {
+        tgdb_remote_destroy(tgdb->remote);
+        tgdb->remote = NULL;
+        return 0;
+    }
+
     return tgdb_client_destroy_context(tgdb->tcc);
 }
 
@@ -388,9 +610,29 @@ char *tgdb_err_msg(struct tgdb *tgdb)
     return NULL;
 }
 
+/* The commands given to the debugger, and how long it took to answer them */
+static struct stats_counter stats_commands_queued =
+        STATS_COUNTER("tgdb commands queued");
+static struct stats_counter stats_commands_issued =
+        STATS_COUNTER("tgdb commands issued");
+static struct stats_counter stats_commands_completed =
+        STATS_COUNTER("tgdb commands completed");
+static struct stats_histogram stats_command_round_trip =
+        STATS_HISTOGRAM("tgdb command round trip");
+
+/* What was read from the debugger, and how long parsing it took */
+static struct stats_counter stats_bytes_parsed =
+        STATS_COUNTER("tgdb bytes parsed");
+static struct stats_histogram stats_parse = STATS_HISTOGRAM("tgdb parse");
+
 void command_completion_callback(struct tgdb *tgdb)
 {
     tgdb->IS_SUBSYSTEM_READY_FOR_NEXT_COMMAND = 1;
+
+    STATS_ADD(&stats_commands_completed, 1);
+    stats_stop(&stats_command_round_trip, tgdb->command_sent);
+    tgdb->command_sent = 0;
+    tracer_instant("command completed", NULL);
 }
 
 static char *tgdb_get_client_command(struct tgdb *tgdb,
@@ -409,13 +651,19 @@ static char *tgdb_client_modify_breakpoint_call(struct tgdb *tgdb,
 
 /**
  * Determines if tgdb should send data to gdb or put it in a buffer. This 
- * is when the debugger is ready and there are no commands to run.
+ * is when the debugger is ready and there are no commands to run. In
+ * non-stop mode, the client is ready at each prompt, even while threads
+ * run, and it's the thread the debugger looks at that the commands are
+ * run in.
  *
  * \return
  * 1 if can issue directly to gdb. Otherwise 0.
  */
 static int tgdb_can_issue_command(struct tgdb *tgdb)
 {
+    if (tgdb->remote)
+        return !tgdb_remote_is_busy(tgdb->remote);
+
     if (tgdb->IS_SUBSYSTEM_READY_FOR_NEXT_COMMAND &&
             tgdb_client_is_client_ready(tgdb->tcc) &&
             (queue_size(tgdb->gdb_input_queue) == 0))
@@ -476,11 +724,29 @@ static void tgdb_request_destroy(void *item)
         case TGDB_REQUEST_MODIFY_BREAKPOINT:
             free((char *) request_ptr->choice.modify_breakpoint.file);
             request_ptr->choice.modify_breakpoint.file = NULL;
+            free((char *) request_ptr->choice.modify_breakpoint.condition);
+            request_ptr->choice.modify_breakpoint.condition = NULL;
             break;
         case TGDB_REQUEST_COMPLETE:
             free((char *) request_ptr->choice.complete.line);
             request_ptr->choice.complete.line = NULL;
             break;
+        case TGDB_REQUEST_DISASSEMBLE:
+            free((char *) request_ptr->choice.disassemble.address);
+            request_ptr->choice.disassemble.address = NULL;
+            break;
+        case TGDB_REQUEST_VARIABLE:
+            free((char *) request_ptr->choice.variable.name);
+            request_ptr->choice.variable.name = NULL;
+            break;
+        case TGDB_REQUEST_READ_MEMORY:
+            free((char *) request_ptr->choice.read_memory.address);
+            request_ptr->choice.read_memory.address = NULL;
+            break;
+        case TGDB_REQUEST_ADD_BREAKPOINTS:
+            free(request_ptr->choice.add_breakpoints.breakpoints);
+            request_ptr->choice.add_breakpoints.breakpoints = NULL;
+            break;
         default:
             break;
     }
@@ -489,13 +755,96 @@ static void tgdb_request_destroy(void *item)
     request_ptr = NULL;
 }
 
+/**
+ * Throws away everything that's waiting to be run, when the user interrupts
+ * the debugger.
+ *
+ * \param tgdb
+ * The TGDB context to use.
+ */
+/**
+ * Finds a submitted request.
+ *
+ * \param tgdb
+ * The tgdb context
+ *
+ * \param handle
+ * The handle of the request
+ *
+ * \return
+ * The request, or NULL if there is none with the handle.
+ */
+static struct tgdb_pending *tgdb_pending_find(struct tgdb *tgdb, int handle)
+{
+    struct tgdb_pending *pending;
+
+    for (pending = tgdb->pending; pending; pending = pending->next) {
+        if (pending->handle == handle)
+            return pending;
+    }
+
+    return NULL;
+}
+
+/**
+ * Tags the responses made since the last call with the submitted request
+ * that is running.
+ */
+static void tgdb_tag_responses(struct tgdb *tgdb)
+{
+    tgdb_list_iterator *i;
+    struct tgdb_response *response;
+
+    if (tgdb->tagged)
+        i = tgdb_list_next(tgdb->tagged);
+    else
+        i = tgdb_list_get_first(tgdb->command_list);
+
+    for (; i; i = tgdb_list_next(i)) {
+        response = (struct tgdb_response *) tgdb_list_get_item(i);
+        response->request = tgdb->running_handle;
+        tgdb->tagged = i;
+    }
+}
+
+/**
+ * Marks the submitted request that is running as done.
+ */
+static void tgdb_request_finished(struct tgdb *tgdb)
+{
+    struct tgdb_pending *pending;
+
+    if (!tgdb->running_handle)
+        return;
+
+    pending = tgdb_pending_find(tgdb, tgdb->running_handle);
+    if (pending)
+        pending->status = TGDB_REQUEST_DONE;
+
+    tgdb->running_handle = 0;
+}
+
+static void tgdb_cancel_queued(struct tgdb *tgdb)
+{
+    struct tgdb_pending *pending;
+
+    for (pending = tgdb->pending; pending; pending = pending->next) {
+        if (pending->status == TGDB_REQUEST_QUEUED)
+            pending->status = TGDB_REQUEST_CANCELLED;
+    }
+
+    queue_free_list(tgdb->gdb_input_queue, tgdb_command_destroy);
+    queue_free_list(tgdb->gdb_client_request_queue, tgdb_request_destroy);
+    queue_free_list(tgdb->gdb_client_refresh_queue, tgdb_request_destroy);
+}
+
 /* tgdb_handle_signals
  */
 static int tgdb_handle_signals(struct tgdb *tgdb)
 {
+    /* What was queued since the interrupt was sent */
     if (tgdb->control_c) {
-        queue_free_list(tgdb->gdb_input_queue, tgdb_command_destroy);
-        queue_free_list(tgdb->gdb_client_request_queue, tgdb_request_destroy);
+        tgdb_cancel_queued(tgdb);
         tgdb->control_c = 0;
     }
 
@@ -506,6 +855,28 @@ static int tgdb_handle_signals(struct tgdb *tgdb)
  * This is the main_loop stuff for tgdb-base
  ******************************************************************************/
 
+/**
+ * Determines if a queued command is the same as a new one.
+ *
+ * \param item
+ * The queued command
+ *
+ * \param data
+ * The new command
+ *
+ * \return
+ * 1 if they are the same, 0 otherwise
+ */
+static int tgdb_command_matches(void *item, void *data)
+{
+    struct tgdb_command *queued = (struct tgdb_command *) item;
+    struct tgdb_command *command = (struct tgdb_command *) data;
+
+    return queued->coalesce &&
+            queued->command_choice == command->command_choice &&
+            strcmp(queued->tgdb_command_data, command->tgdb_command_data) == 0;
+}
+
 /* 
  * Sends a command to the debugger. This function gets called when the GUI
  * wants to run a command.
@@ -585,6 +956,25 @@ tgdb_run_or_queue_command(struct tgdb *tgdb, struct tgdb_command *command)
         if (tgdb_deliver_command(tgdb, command) == -1)
             return -1;
     } else {
+        /* The one already waiting gets the same answer, when it's run */
+        if (command->coalesce &&
+                command->command_choice == TGDB_COMMAND_TGDB_CLIENT &&
+                queue_find(tgdb->gdb_input_queue, tgdb_command_matches,
+                        command)) {
+            free(command->tgdb_command_data);
+            free(command->tgdb_client_private_data);
+            tgdb_command_destroy(command);
+            return 0;
+        }
+
+        /* It can go right behind the command that's running */
+        if (queue_size(tgdb->gdb_input_queue) == 0 &&
+                queue_size(tgdb->oob_input_queue) == 0 &&
+                tgdb_pipeline_command(tgdb, command) == 1)
+            return 0;
+
+        STATS_ADD(&stats_commands_queued, 1);
+
         /* Make sure to put the command into the correct queue. */
         switch (command->command_choice) {
             case TGDB_COMMAND_FRONT_END:
@@ -642,6 +1032,10 @@ static int tgdb_deliver_command(struct tgdb *tgdb, struct tgdb_command *command)
     /* A regular command from the client */
     io_debug_write_fmt("<%s>", command->tgdb_command_data);
 
+    STATS_ADD(&stats_commands_issued, 1);
+    tgdb->command_sent = stats_start();
+    tracer_instant("command issued", command->tgdb_command_data);
+
     io_writen(tgdb->debugger_stdin, command->tgdb_command_data,
             strlen(command->tgdb_command_data));
 
@@ -663,6 +1057,42 @@ static int tgdb_deliver_command(struct tgdb *tgdb, struct tgdb_command *command)
     return 0;
 }
 
+/**
+ * Writes a client command to the debugger while another one is still
+ * running, so it doesn't wait for a round trip to the debugger. The
+ * responses still come in the order the commands were written, the client
+ * tells them apart.
+ *
+ * \param tgdb
+ * The TGDB context to use.
+ *
+ * \param command
+ * The command to run.
+ *
+ * \return
+ * 1 if the command was written, 0 if it has to be queued, -1 on error
+ */
+static int tgdb_pipeline_command(struct tgdb *tgdb, struct tgdb_command *command)
+{
+    int ret;
+
+    if (command->command_choice != TGDB_COMMAND_TGDB_CLIENT)
+        return 0;
+
+    ret = tgdb_client_pipeline_command(tgdb->tcc, command);
+    if (ret != 1)
+        return ret;
+
+    io_debug_write_fmt("<%s>", command->tgdb_command_data);
+    STATS_ADD(&stats_commands_issued, 1);
+    tracer_instant("command pipelined", command->tgdb_command_data);
+
+    io_writen(tgdb->debugger_stdin, command->tgdb_command_data,
+            strlen(command->tgdb_command_data));
+
+    return 1;
+}
+
 /**
  * TGDB will search it's command queue's and determine what the next command
  * to deliever to GDB should be.
@@ -705,12 +1135,27 @@ static int tgdb_unqueue_and_deliver_command(struct tgdb *tgdb)
             }
         }
 
+        /* A refresh the next user command makes again, after it's run */
+        if (item->coalesce &&
+                queue_find(tgdb->gdb_client_request_queue,
+                        tgdb_request_matches_sent, NULL)) {
+            free(item->tgdb_command_data);
+            free(item->tgdb_client_private_data);
+            tgdb_command_destroy(item);
+            goto tgdb_unqueue_and_deliver_command_tag;
+        }
+
         /* This happens when a command was skipped because the client no longer
          * needs the command to be run */
         if (tgdb_deliver_command(tgdb, item) == -1)
             goto tgdb_unqueue_and_deliver_command_tag;
 
         tgdb_command_destroy(item);
+
+        /* The client commands queued behind it can follow it right away */
+        while ((item = queue_peek(tgdb->gdb_input_queue)) != NULL &&
+                tgdb_pipeline_command(tgdb, item) == 1)
+            queue_pop(tgdb->gdb_input_queue);
     }
 
     return 0;
@@ -719,14 +1164,50 @@ static int tgdb_unqueue_and_deliver_command(struct tgdb *tgdb)
 /* These functions are used to communicate with the inferior */
 int tgdb_send_inferior_char(struct tgdb *tgdb, char c)
 {
-    if (io_write_byte(tgdb->inferior_stdout, c) == -1) {
-        logger_write_pos(logger, __FILE__, __LINE__, "io_write_byte failed");
+    if (tgdb_send_inferior_data(tgdb, &c, 1) == -1)
         return -1;
+
+    return tgdb_flush_inferior_data(tgdb) == -1 ? -1 : 0;
+}
+
+int tgdb_send_inferior_data(struct tgdb *tgdb, const char *buf, size_t n)
+{
+    if (tgdb->remote)
+        return tgdb_remote_send_inferior_data(tgdb->remote, buf, n);
+
+    if (!tgdb->inferior_writer ||
+            io_writer_put(tgdb->inferior_writer, buf, n) == -1) {
+        /* Written right away, after what's waiting */
+        if (tgdb_flush_inferior_data(tgdb) != 0 ||
+                io_writen(tgdb->inferior_stdout, buf, n) != (ssize_t) n) {
+            logger_write_pos(logger, __FILE__, __LINE__, "io_writen failed");
+            return -1;
+        }
     }
 
     return 0;
 }
 
+int tgdb_flush_inferior_data(struct tgdb *tgdb)
+{
+    int ret;
+
+    if (tgdb->remote)
+        return tgdb_remote_flush_inferior_data(tgdb->remote);
+
+    if (!tgdb->inferior_writer)
+        return 0;
+
+    if ((ret = io_writer_flush(tgdb->inferior_writer,
+                            tgdb->inferior_stdout)) == -1) {
+        /* The program went away, what it didn't read is dropped */
+        io_writer_clear(tgdb->inferior_writer);
+        logger_write_pos(logger, __FILE__, __LINE__, "io_writer_flush failed");
+    }
+
+    return ret;
+}
+
 /* returns to the caller data from the child */
 /**
  * Returns output that the debugged program printed (the inferior).
@@ -745,18 +1226,19 @@ int tgdb_send_inferior_char(struct tgdb *tgdb, char c)
  */
 ssize_t tgdb_recv_inferior_data(struct tgdb * tgdb, char *buf, size_t n)
 {
-    char local_buf[n + 1];
     ssize_t size;
 
+    if (tgdb->remote)
+        return tgdb_remote_recv_inferior_data(tgdb->remote, buf, n);
+
     /* read all the data possible from the child that is ready. */
-    if ((size = io_read(tgdb->inferior_stdin, local_buf, n)) < 0) {
-        logger_write_pos(logger, __FILE__, __LINE__, "inferior_fd read failed");
+    if ((size = io_read_ready(tgdb->inferior_stdin, buf, n)) < 0) {
+        if (errno != EAGAIN)
+            logger_write_pos(logger, __FILE__, __LINE__,
+                    "inferior_fd read failed");
         return -1;
     }
 
-    strncpy(buf, local_buf, size);
-    buf[size] = '\0';
-
     return size;
 }
 
@@ -775,19 +1257,17 @@ static int tgdb_add_quit_command(struct tgdb *tgdb)
     struct tgdb_response *response;
 
     tstatus = (struct tgdb_debugger_exit_status *)
-            cgdb_malloc(sizeof (struct tgdb_debugger_exit_status));
+            std_arena_alloc(tgdb->response_arena,
+            sizeof (struct tgdb_debugger_exit_status));
 
     /* Child did not exit normally */
     tstatus->exit_status = -1;
     tstatus->return_value = 0;
 
-    response =
-            (struct tgdb_response *) cgdb_malloc(sizeof (struct tgdb_response));
-    response->header = TGDB_QUIT;
+    response = tgdb_types_new_response(tgdb->response_arena,
+            tgdb->command_list, TGDB_QUIT);
     response->choice.quit.exit_status = tstatus;
 
-    tgdb_types_append_command(tgdb->command_list, response);
-
     return 0;
 }
 
@@ -810,20 +1290,19 @@ static int tgdb_get_quit_command(struct tgdb *tgdb, int *tgdb_will_quit)
     int status = 0;
     pid_t ret;
     struct tgdb_debugger_exit_status *tstatus;
-    struct tgdb_response *response = (struct tgdb_response *)
-            cgdb_malloc(sizeof (struct tgdb_response));
+    struct tgdb_response *response;
 
     if (!tgdb_will_quit)
         return -1;
 
     *tgdb_will_quit = 0;
 
-    tstatus = (struct tgdb_debugger_exit_status *)
-            cgdb_malloc(sizeof (struct tgdb_debugger_exit_status));
-
     ret = waitpid(pid, &status, WNOHANG);
 
-    if (ret == -1) {
+    if (ret == -1 && errno == ECHILD) {
+        /* GDB is run by a session server, its exit is seen as an EOF */
+        return 0;
+    } else if (ret == -1) {
         logger_write_pos(logger, __FILE__, __LINE__, "waitpid error");
         return -1;
     } else if (ret == 0) {
@@ -831,6 +1310,10 @@ static int tgdb_get_quit_command(struct tgdb *tgdb, int *tgdb_will_quit)
         return 0;
     }
 
+    tstatus = (struct tgdb_debugger_exit_status *)
+            std_arena_alloc(tgdb->response_arena,
+            sizeof (struct tgdb_debugger_exit_status));
+
     if ((WIFEXITED(status)) == 0) {
         /* Child did not exit normally */
         tstatus->exit_status = -1;
@@ -840,49 +1323,179 @@ static int tgdb_get_quit_command(struct tgdb *tgdb, int *tgdb_will_quit)
         tstatus->return_value = WEXITSTATUS(status);
     }
 
-    response->header = TGDB_QUIT;
+    response = tgdb_types_new_response(tgdb->response_arena,
+            tgdb->command_list, TGDB_QUIT);
     response->choice.quit.exit_status = tstatus;
-    tgdb_types_append_command(tgdb->command_list, response);
     *tgdb_will_quit = 1;
 
     return 0;
 }
 
-size_t tgdb_process(struct tgdb * tgdb, char *buf, size_t n, int *is_finished)
+/**
+ * Parses what gdb printed, and does what it calls for. This is everything
+ * tgdb_process does after reading from gdb.
+ *
+ * \param tgdb
+ * The tgdb context.
+ *
+ * \param local_buf
+ * What gdb printed, the client context may change it.
+ *
+ * \param size
+ * The size of local_buf.
+ *
+ * \param buf
+ * The output for the user is written to this.
+ *
+ * \param buf_size
+ * The size of the output for the user, on the way out.
+ *
+ * \return
+ * 0 on success or -1 on error
+ */
+static int tgdb_process_output(struct tgdb *tgdb, char *local_buf,
+        size_t size, char *buf, size_t *buf_size)
 {
-    char local_buf[10 * n];
-    ssize_t size;
-    size_t buf_size = 0;
-    int is_busy;
-
-    /* make the queue empty */
-    tgdb_delete_responses(tgdb);
-
-    /* TODO: This is kind of a hack.
-     * Since I know that I didn't do a read yet, the next select loop will
-     * get me back here. This probably shouldn't return, however, I have to
-     * re-write a lot of this function. Also, I think this function should
-     * return a malloc'd string, not a static buffer.
+    /* 2. At this point local_buf has everything new from this read.
+     * Basically this function is responsible for seperating the annotations
+     * that gdb writes from the data. 
      *
-     * Currently, I see it as a bigger hack to try to just append this to the
-     * beggining of buf.
+     * buf and buf_size are the data to be returned to the user.
      */
-    if (tgdb->last_gui_command != NULL) {
-        int ret;
+    {
+        /* unused for now */
+        char *infbuf = NULL;
+        size_t infbuf_size;
+        int result;
+        unsigned long long start = stats_start();
 
-        if (tgdb_is_busy(tgdb, &is_busy) == -1) {
-            logger_write_pos(logger, __FILE__, __LINE__, "tgdb_is_busy failed");
-            return -1;
+        result = tgdb_client_parse_io(tgdb->tcc,
+                local_buf, size,
+                buf, buf_size, infbuf, &infbuf_size, tgdb->command_list);
+
+        stats_stop(&stats_parse, start);
+        STATS_ADD(&stats_bytes_parsed, size);
+
+        tgdb_process_client_commands(tgdb);
+
+        if (result == 0) {
+            /* success, and more to parse, ss isn't done */
+        } else if (result == 1) {
+            /* success, and finished command */
+            command_completion_callback(tgdb);
+        } else if (result == -1) {
+            logger_write_pos(logger, __FILE__, __LINE__,
+                    "tgdb_client_parse_io failed");
+        }
+    }
+
+    /* 3. if ^c has been sent, clear the buffers.
+     *        If a signal has been recieved, clear the queue and return
+     */
+    if (tgdb_handle_signals(tgdb) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_handle_signals failed");
+        return -1;
+    }
+
+    /* 4. runs the users buffered command if any exists */
+    if (tgdb_has_command_to_run(tgdb))
+        tgdb_unqueue_and_deliver_command(tgdb);
+
+    return 0;
+}
+
+/**
+ * Gets the responses ready for the front end, after tgdb_process is done
+ * with gdb's output.
+ *
+ * \param tgdb
+ * The tgdb context.
+ *
+ * \param is_finished
+ * Set to 1 if tgdb can take another request, 0 otherwise.
+ *
+ * \return
+ * 0 on success or -1 on error
+ */
+static int tgdb_process_finish(struct tgdb *tgdb, int *is_finished)
+{
+    int is_busy;
+
+    /* Set the iterator to the beggining. So when the user
+     * calls tgdb_get_command it, it will be in the right spot.
+     */
+    tgdb->command_list_iterator = tgdb_list_get_first(tgdb->command_list);
+    tgdb_tag_responses(tgdb);
+
+    if (tgdb_is_busy(tgdb, &is_busy) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__, "tgdb_is_busy failed");
+        return -1;
+    }
+    *is_finished = !is_busy;
+
+    if (!is_busy)
+        tgdb_request_finished(tgdb);
+
+    return 0;
+}
+
+size_t tgdb_process(struct tgdb * tgdb, char *buf, size_t n, int *is_finished)
+{
+    char *local_buf;
+    ssize_t size;
+    size_t buf_size = 0;
+    int is_busy;
+    unsigned long long span;
+
+    /* make the queue empty */
+    tgdb_delete_responses(tgdb);
+
+    /* The headless tgdb did the parsing, this only reads what it made */
+    if (tgdb->remote) {
+        int closed;
+
+        size = tgdb_remote_process(tgdb->remote, tgdb->response_arena,
+                tgdb->command_list, buf, n, &closed);
+        if (size > 0)
+            buf_size = size;
+        else
+            buf[0] = '\0';
+
+        if (closed)
+            tgdb_add_quit_command(tgdb);
+
+        tgdb_handle_signals(tgdb);
+        goto tgdb_finish;
+    }
+
+    /* TODO: This is kind of a hack.
+     * Since I know that I didn't do a read yet, the next select loop will
+     * get me back here. This probably shouldn't return, however, I have to
+     * re-write a lot of this function.
+     *
+     * Currently, I see it as a bigger hack to try to just append this to the
+     * beggining of buf.
+     */
+    if (tgdb->last_gui_command != NULL) {
+        size_t ret;
+
+        if (tgdb_is_busy(tgdb, &is_busy) == -1) {
+            logger_write_pos(logger, __FILE__, __LINE__, "tgdb_is_busy failed");
+            return -1;
         }
         *is_finished = !is_busy;
 
         if (tgdb->show_gui_commands) {
-            strcpy(buf, tgdb->last_gui_command);
             ret = strlen(tgdb->last_gui_command);
+            if (ret > n)
+                ret = n;
+            memcpy(buf, tgdb->last_gui_command, ret);
         } else {
-            strcpy(buf, "\n");
+            buf[0] = '\n';
             ret = 1;
         }
+        buf[ret] = '\0';
 
         free(tgdb->last_gui_command);
         tgdb->last_gui_command = NULL;
@@ -911,11 +1524,36 @@ size_t tgdb_process(struct tgdb * tgdb, char *buf, size_t n, int *is_finished)
             goto tgdb_finish;
     }
 
-    /* set buf to null for debug reasons */
-    memset(buf, '\0', n);
+    buf[0] = '\0';
+
+    /* The client context may give back a little more than it's given */
+    if (n <= TGDB_CLIENT_HELD_OUTPUT) {
+        logger_write_pos(logger, __FILE__, __LINE__, "buf is too small");
+        return -1;
+    }
+    n -= TGDB_CLIENT_HELD_OUTPUT;
+
+    if (tgdb->read_buf_size < n + 1) {
+        tgdb->read_buf_size = n + 1;
+        tgdb->read_buf = cgdb_realloc(tgdb->read_buf, tgdb->read_buf_size);
+    }
+    local_buf = tgdb->read_buf;
+
+    /* 1. read all the data possible from gdb that is ready, so that it's
+     * parsed in one go. It's read into the same buffer each time, and the
+     * client context writes what the user should see straight to buf. */
+    span = tracer_begin();
+    if (tgdb->debugger_reader)
+        size = io_reader_read(tgdb->debugger_reader, local_buf, n);
+    else
+        size = io_read_ready(tgdb->debugger_stdout, local_buf, n);
+    tracer_end("read", span);
+
+    if (size < 0) {
+        /* There was nothing to read after all */
+        if (errno == EAGAIN)
+            goto tgdb_finish;
 
-    /* 1. read all the data possible from gdb that is ready. */
-    if ((size = io_read(tgdb->debugger_stdout, local_buf, n)) < 0) {
         logger_write_pos(logger, __FILE__, __LINE__,
                 "could not read from masterfd");
         buf_size = -1;
@@ -926,62 +1564,45 @@ size_t tgdb_process(struct tgdb * tgdb, char *buf, size_t n, int *is_finished)
         goto tgdb_finish;
     }
 
-    local_buf[size] = '\0';
+    /* 2. - 4. parse it, handle signals and run the user's next command */
+    if (tgdb_process_output(tgdb, local_buf, size, buf, &buf_size) == -1)
+        return -1;
 
-    /* 2. At this point local_buf has everything new from this read.
-     * Basically this function is responsible for seperating the annotations
-     * that gdb writes from the data. 
-     *
-     * buf and buf_size are the data to be returned from the user.
-     */
-    {
-        /* unused for now */
-        char *infbuf = NULL;
-        size_t infbuf_size;
-        int result;
+  tgdb_finish:
 
-        result = tgdb_client_parse_io(tgdb->tcc,
-                local_buf, size,
-                buf, &buf_size, infbuf, &infbuf_size, tgdb->command_list);
+    if (tgdb_process_finish(tgdb, is_finished) == -1)
+        return -1;
 
-        tgdb_process_client_commands(tgdb);
+    return buf_size;
+}
 
-        if (result == 0) {
-            /* success, and more to parse, ss isn't done */
-        } else if (result == 1) {
-            /* success, and finished command */
-            command_completion_callback(tgdb);
-        } else if (result == -1) {
-            logger_write_pos(logger, __FILE__, __LINE__,
-                    "tgdb_client_parse_io failed");
-        }
-    }
+size_t tgdb_process_buffer(struct tgdb *tgdb, const char *data, size_t size,
+        char *buf, size_t n, int *is_finished)
+{
+    size_t buf_size = 0;
 
-    /* 3. if ^c has been sent, clear the buffers.
-     *        If a signal has been recieved, clear the queue and return
-     */
-    if (tgdb_handle_signals(tgdb) == -1) {
-        logger_write_pos(logger, __FILE__, __LINE__,
-                "tgdb_handle_signals failed");
+    tgdb_delete_responses(tgdb);
+
+    if (tgdb->remote || n <= TGDB_CLIENT_HELD_OUTPUT ||
+            size > n - TGDB_CLIENT_HELD_OUTPUT) {
+        logger_write_pos(logger, __FILE__, __LINE__, "buf is too small");
         return -1;
     }
 
-    /* 4. runs the users buffered command if any exists */
-    if (tgdb_has_command_to_run(tgdb))
-        tgdb_unqueue_and_deliver_command(tgdb);
+    if (tgdb->read_buf_size < size + 1) {
+        tgdb->read_buf_size = size + 1;
+        tgdb->read_buf = cgdb_realloc(tgdb->read_buf, tgdb->read_buf_size);
+    }
+    memcpy(tgdb->read_buf, data, size);
+    tgdb->read_buf[size] = '\0';
 
-  tgdb_finish:
+    buf[0] = '\0';
 
-    /* Set the iterator to the beggining. So when the user
-     * calls tgdb_get_command it, it will be in the right spot.
-     */
-    tgdb->command_list_iterator = tgdb_list_get_first(tgdb->command_list);
+    if (tgdb_process_output(tgdb, tgdb->read_buf, size, buf, &buf_size) == -1)
+        return -1;
 
-    if (tgdb_is_busy(tgdb, &is_busy) == -1) {
-        logger_write_pos(logger, __FILE__, __LINE__, "tgdb_is_busy failed");
+    if (tgdb_process_finish(tgdb, is_finished) == -1)
         return -1;
-    }
-    *is_finished = !is_busy;
 
     return buf_size;
 }
@@ -1011,7 +1632,12 @@ void tgdb_traverse_responses(struct tgdb *tgdb)
 
 void tgdb_delete_responses(struct tgdb *tgdb)
 {
-    tgdb_list_free(tgdb->command_list, tgdb_types_free_command);
+    tgdb_list_foreach(tgdb->command_list, tgdb_types_release_command);
+    tgdb_list_clear(tgdb->command_list);
+    tgdb->command_list_iterator = NULL;
+    tgdb->tagged = NULL;
+    tgdb->dispatched = NULL;
+    std_arena_reset(tgdb->response_arena);
 }
 
 /* }}}*/
@@ -1020,9 +1646,17 @@ void tgdb_delete_responses(struct tgdb *tgdb)
 
 int tgdb_tty_new(struct tgdb *tgdb)
 {
-    int ret = tgdb_client_open_new_tty(tgdb->tcc,
-            &tgdb->inferior_stdin,
-            &tgdb->inferior_stdout);
+    int ret;
+
+    if (tgdb->remote)
+        return tgdb_remote_tty_new(tgdb->remote);
+
+    /* The keys were meant for the program on the old tty */
+    if (tgdb->inferior_writer)
+        io_writer_clear(tgdb->inferior_writer);
+
+    ret = tgdb_client_open_new_tty(tgdb->tcc,
+            &tgdb->inferior_stdin, &tgdb->inferior_stdout);
 
     tgdb_process_client_commands(tgdb);
 
@@ -1031,11 +1665,17 @@ int tgdb_tty_new(struct tgdb *tgdb)
 
 int tgdb_get_inferior_fd(struct tgdb *tgdb)
 {
+    if (tgdb->remote)
+        return tgdb_remote_get_inferior_fd(tgdb->remote);
+
     return tgdb->inferior_stdout;
 }
 
 const char *tgdb_tty_name(struct tgdb *tgdb)
 {
+    if (tgdb->remote)
+        return tgdb_remote_tty_name(tgdb->remote);
+
     return tgdb_client_get_tty_name(tgdb->tcc);
 }
 
@@ -1054,7 +1694,7 @@ tgdb_request_run_console_command(struct tgdb * tgdb, const char *command)
         return NULL;
 
     request_ptr = (tgdb_request_ptr)
-            cgdb_malloc(sizeof (struct tgdb_request));
+            cgdb_calloc(1, sizeof (struct tgdb_request));
     if (!request_ptr)
         return NULL;
 
@@ -1073,7 +1713,7 @@ tgdb_request_ptr tgdb_request_inferiors_source_files(struct tgdb * tgdb)
         return NULL;
 
     request_ptr = (tgdb_request_ptr)
-            cgdb_malloc(sizeof (struct tgdb_request));
+            cgdb_calloc(1, sizeof (struct tgdb_request));
     if (!request_ptr)
         return NULL;
 
@@ -1094,7 +1734,7 @@ tgdb_request_filename_pair(struct tgdb * tgdb, const char *file)
         return NULL;
 
     request_ptr = (tgdb_request_ptr)
-            cgdb_malloc(sizeof (struct tgdb_request));
+            cgdb_calloc(1, sizeof (struct tgdb_request));
     if (!request_ptr)
         return NULL;
 
@@ -1118,7 +1758,7 @@ tgdb_request_current_location(struct tgdb * tgdb, int on_startup)
         return NULL;
 
     request_ptr = (tgdb_request_ptr)
-            cgdb_malloc(sizeof (struct tgdb_request));
+            cgdb_calloc(1, sizeof (struct tgdb_request));
     if (!request_ptr)
         return NULL;
 
@@ -1137,12 +1777,13 @@ tgdb_request_run_debugger_command(struct tgdb * tgdb, enum tgdb_command_type c)
         return NULL;
 
     request_ptr = (tgdb_request_ptr)
-            cgdb_malloc(sizeof (struct tgdb_request));
+            cgdb_calloc(1, sizeof (struct tgdb_request));
     if (!request_ptr)
         return NULL;
 
     request_ptr->header = TGDB_REQUEST_DEBUGGER_COMMAND;
     request_ptr->choice.debugger_command.c = c;
+    request_ptr->choice.debugger_command.count = 1;
 
     return request_ptr;
 }
@@ -1157,7 +1798,7 @@ tgdb_request_modify_breakpoint(struct tgdb * tgdb, const char *file, int line,
         return NULL;
 
     request_ptr = (tgdb_request_ptr)
-            cgdb_malloc(sizeof (struct tgdb_request));
+            cgdb_calloc(1, sizeof (struct tgdb_request));
     if (!request_ptr)
         return NULL;
 
@@ -1170,128 +1811,352 @@ tgdb_request_modify_breakpoint(struct tgdb * tgdb, const char *file, int line,
     return request_ptr;
 }
 
-tgdb_request_ptr tgdb_request_complete(struct tgdb * tgdb, const char *line)
+tgdb_request_ptr
+tgdb_request_condition_breakpoint(struct tgdb * tgdb, const char *file,
+        int line, const char *condition,
+        enum tgdb_condition_evaluation evaluation)
 {
     tgdb_request_ptr request_ptr;
 
-    if (!tgdb)
+    if (!condition || !*condition)
         return NULL;
 
-    request_ptr = (tgdb_request_ptr)
-            cgdb_malloc(sizeof (struct tgdb_request));
+    request_ptr = tgdb_request_modify_breakpoint(tgdb, file, line,
+            TGDB_BREAKPOINT_ADD);
     if (!request_ptr)
         return NULL;
 
-    request_ptr->header = TGDB_REQUEST_COMPLETE;
-    request_ptr->choice.complete.line = (const char *)
-            cgdb_strdup(line);
+    request_ptr->choice.modify_breakpoint.condition = (const char *)
+            cgdb_strdup(condition);
+    request_ptr->choice.modify_breakpoint.evaluation = evaluation;
 
     return request_ptr;
 }
 
-/* }}}*/
+tgdb_request_ptr
+tgdb_request_add_breakpoints(struct tgdb * tgdb,
+        const struct tgdb_breakpoint * breakpoints, int count)
+{
+    tgdb_request_ptr request_ptr;
+    struct tgdb_breakpoint *copy;
+    int i;
 
-/* Process {{{*/
+    if (!tgdb || !breakpoints || count <= 0)
+        return NULL;
 
-static int
-tgdb_process_console_command(struct tgdb *tgdb, tgdb_request_ptr request)
-{
-    struct ibuf *command;
+    request_ptr = (tgdb_request_ptr)
+            cgdb_calloc(1, sizeof (struct tgdb_request));
+
+    /* The files are interned, they stay around */
+    copy = (struct tgdb_breakpoint *)
+            cgdb_calloc(count, sizeof (struct tgdb_breakpoint));
+    for (i = 0; i < count; i++) {
+        copy[i].file = breakpoints[i].file;
+        copy[i].line = breakpoints[i].line;
+        copy[i].enabled = breakpoints[i].enabled;
+    }
 
-    if (!tgdb || !request)
-        return -1;
+    request_ptr->header = TGDB_REQUEST_ADD_BREAKPOINTS;
+    request_ptr->choice.add_breakpoints.breakpoints = copy;
+    request_ptr->choice.add_breakpoints.count = count;
 
-    if (!tgdb_can_issue_command(tgdb))
-        return -1;
+    return request_ptr;
+}
 
-    if (request->header != TGDB_REQUEST_CONSOLE_COMMAND)
-        return -1;
+tgdb_request_ptr tgdb_request_complete(struct tgdb * tgdb, const char *line)
+{
+    tgdb_request_ptr request_ptr;
 
-    command = ibuf_init();
-    ibuf_add(command, request->choice.console_command.command);
-    ibuf_addchar(command, '\n');
+    if (!tgdb)
+        return NULL;
 
-    if (tgdb_send(tgdb, ibuf_get(command), TGDB_COMMAND_CONSOLE) == -1) {
-        logger_write_pos(logger, __FILE__, __LINE__, "tgdb_send failed");
-        return -1;
-    }
+    request_ptr = (tgdb_request_ptr)
+            cgdb_calloc(1, sizeof (struct tgdb_request));
+    if (!request_ptr)
+        return NULL;
 
-    ibuf_free(command);
-    command = NULL;
+    request_ptr->header = TGDB_REQUEST_COMPLETE;
+    request_ptr->choice.complete.line = (const char *)
+            cgdb_strdup(line);
 
-    return 0;
+    return request_ptr;
 }
 
-static int
-tgdb_process_info_sources(struct tgdb *tgdb, tgdb_request_ptr request)
+tgdb_request_ptr tgdb_request_disassemble(struct tgdb * tgdb,
+        const char *address)
 {
-    int ret;
+    tgdb_request_ptr request_ptr;
 
-    if (!tgdb || !request)
-        return -1;
+    if (!tgdb)
+        return NULL;
 
-    if (request->header != TGDB_REQUEST_INFO_SOURCES)
-        return -1;
+    request_ptr = (tgdb_request_ptr)
+            cgdb_calloc(1, sizeof (struct tgdb_request));
+    if (!request_ptr)
+        return NULL;
 
-    ret = tgdb_client_get_inferior_source_files(tgdb->tcc);
-    tgdb_process_client_commands(tgdb);
+    request_ptr->header = TGDB_REQUEST_DISASSEMBLE;
+    request_ptr->choice.disassemble.address = address ?
+            (const char *) cgdb_strdup(address) : NULL;
 
-    return ret;
+    return request_ptr;
 }
 
-static int
-tgdb_process_filename_pair(struct tgdb *tgdb, tgdb_request_ptr request)
+tgdb_request_ptr tgdb_request_variable(struct tgdb * tgdb,
+        enum tgdb_variable_command command, const char *name)
 {
-    int ret;
+    tgdb_request_ptr request_ptr;
 
-    if (!tgdb || !request)
-        return -1;
+    if (!tgdb)
+        return NULL;
 
-    if (request->header != TGDB_REQUEST_FILENAME_PAIR)
-        return -1;
+    request_ptr = (tgdb_request_ptr)
+            cgdb_calloc(1, sizeof (struct tgdb_request));
+    if (!request_ptr)
+        return NULL;
 
-    ret = tgdb_client_get_filename_pair(tgdb->tcc,
-            request->choice.filename_pair.file);
-    tgdb_process_client_commands(tgdb);
+    request_ptr->header = TGDB_REQUEST_VARIABLE;
+    request_ptr->choice.variable.command = command;
+    request_ptr->choice.variable.name = name ?
+            (const char *) cgdb_strdup(name) : NULL;
 
-    return ret;
+    return request_ptr;
 }
 
-static int
-tgdb_process_current_location(struct tgdb *tgdb, tgdb_request_ptr request)
+tgdb_request_ptr tgdb_request_read_memory(struct tgdb * tgdb,
+        const char *address, int length)
 {
-    int ret = 0;
+    tgdb_request_ptr request_ptr;
 
-    if (!tgdb || !request)
-        return -1;
+    if (!tgdb || !address || length <= 0)
+        return NULL;
 
-    if (request->header != TGDB_REQUEST_CURRENT_LOCATION)
-        return -1;
+    request_ptr = (tgdb_request_ptr)
+            cgdb_calloc(1, sizeof (struct tgdb_request));
+    if (!request_ptr)
+        return NULL;
 
-    ret = tgdb_client_get_current_location(tgdb->tcc,
-            request->choice.current_location.on_startup);
-    tgdb_process_client_commands(tgdb);
+    request_ptr->header = TGDB_REQUEST_READ_MEMORY;
+    request_ptr->choice.read_memory.address =
+            (const char *) cgdb_strdup(address);
+    request_ptr->choice.read_memory.length = length;
 
-    return ret;
+    return request_ptr;
 }
 
-static int
-tgdb_process_debugger_command(struct tgdb *tgdb, tgdb_request_ptr request)
+tgdb_request_ptr tgdb_request_frames(struct tgdb * tgdb, int thread, int low,
+        int high)
 {
-    if (!tgdb || !request)
+    tgdb_request_ptr request_ptr;
+
+    if (!tgdb || thread < 0 || low < 0 || high < low)
+        return NULL;
+
+    request_ptr = (tgdb_request_ptr)
+            cgdb_calloc(1, sizeof (struct tgdb_request));
+    if (!request_ptr)
+        return NULL;
+
+    request_ptr->header = TGDB_REQUEST_FRAMES;
+    request_ptr->choice.frames.thread = thread;
+    request_ptr->choice.frames.low = low;
+    request_ptr->choice.frames.high = high;
+
+    return request_ptr;
+}
+
+tgdb_request_ptr tgdb_request_select_frame(struct tgdb * tgdb, int level)
+{
+    tgdb_request_ptr request_ptr;
+
+    if (!tgdb || level < 0)
+        return NULL;
+
+    request_ptr = (tgdb_request_ptr)
+            cgdb_calloc(1, sizeof (struct tgdb_request));
+    if (!request_ptr)
+        return NULL;
+
+    request_ptr->header = TGDB_REQUEST_SELECT_FRAME;
+    request_ptr->choice.select_frame.level = level;
+
+    return request_ptr;
+}
+
+tgdb_request_ptr tgdb_request_select_thread(struct tgdb * tgdb, int id)
+{
+    tgdb_request_ptr request_ptr;
+
+    if (!tgdb || id <= 0)
+        return NULL;
+
+    request_ptr = (tgdb_request_ptr)
+            cgdb_calloc(1, sizeof (struct tgdb_request));
+    if (!request_ptr)
+        return NULL;
+
+    request_ptr->header = TGDB_REQUEST_SELECT_THREAD;
+    request_ptr->choice.select_thread.id = id;
+
+    return request_ptr;
+}
+
+/* }}}*/
+
+/* Process {{{*/
+
+static int
+tgdb_process_console_command(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    struct ibuf *command;
+
+    if (!tgdb || !request)
+        return -1;
+
+    if (!tgdb_can_issue_command(tgdb))
+        return -1;
+
+    if (request->header != TGDB_REQUEST_CONSOLE_COMMAND)
+        return -1;
+
+    command = ibuf_init();
+    ibuf_add(command, request->choice.console_command.command);
+    ibuf_addchar(command, '\n');
+
+    if (tgdb_send(tgdb, ibuf_get(command), TGDB_COMMAND_CONSOLE) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__, "tgdb_send failed");
+        return -1;
+    }
+
+    ibuf_free(command);
+    command = NULL;
+
+    return 0;
+}
+
+static int
+tgdb_process_info_sources(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    int ret;
+
+    if (!tgdb || !request)
+        return -1;
+
+    if (request->header != TGDB_REQUEST_INFO_SOURCES)
+        return -1;
+
+    ret = tgdb_client_get_inferior_source_files(tgdb->tcc);
+    tgdb_process_client_commands(tgdb);
+
+    return ret;
+}
+
+static int
+tgdb_process_filename_pair(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    tgdb_list_iterator *last;
+    int ret;
+
+    if (!tgdb || !request)
+        return -1;
+
+    if (request->header != TGDB_REQUEST_FILENAME_PAIR)
+        return -1;
+
+    last = tgdb_list_get_last(tgdb->command_list);
+    ret = tgdb_client_get_filename_pair(tgdb->tcc,
+            request->choice.filename_pair.file, tgdb->command_list);
+    tgdb_process_client_commands(tgdb);
+
+    /* The client knew the pair, the front end can get it right away */
+    if (!tgdb->command_list_iterator) {
+        if (last)
+            tgdb->command_list_iterator = tgdb_list_next(last);
+        else
+            tgdb->command_list_iterator =
+                    tgdb_list_get_first(tgdb->command_list);
+    }
+
+    return ret;
+}
+
+static int
+tgdb_process_current_location(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    int ret = 0;
+
+    if (!tgdb || !request)
+        return -1;
+
+    if (request->header != TGDB_REQUEST_CURRENT_LOCATION)
+        return -1;
+
+    ret = tgdb_client_get_current_location(tgdb->tcc,
+            request->choice.current_location.on_startup);
+    tgdb_process_client_commands(tgdb);
+
+    return ret;
+}
+
+static int
+tgdb_process_debugger_command(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    char command[64];
+
+    if (!tgdb || !request)
         return -1;
 
     if (request->header != TGDB_REQUEST_DEBUGGER_COMMAND)
         return -1;
 
+    /* Steps that were collapsed run as one, gdb stops once at the end */
+    if (request->choice.debugger_command.count > 1) {
+        snprintf(command, sizeof (command), "%s %d",
+                tgdb_get_client_command(tgdb,
+                        request->choice.debugger_command.c),
+                request->choice.debugger_command.count);
+        return tgdb_send(tgdb, command, TGDB_COMMAND_FRONT_END);
+    }
+
     return tgdb_send(tgdb, tgdb_get_client_command(tgdb,
                     request->choice.debugger_command.c),
             TGDB_COMMAND_FRONT_END);
 }
 
+/**
+ * Tells the debugger where to test the conditions of the breakpoints set
+ * from now on, unless it's where it tests them already.
+ *
+ * \return
+ * 0 on success, -1 on error.
+ */
+static int
+tgdb_set_condition_evaluation(struct tgdb *tgdb,
+        enum tgdb_condition_evaluation evaluation)
+{
+    static const char *modes[] = { "auto", "host", "target" };
+    char command[64];
+
+    if (evaluation == tgdb->condition_evaluation)
+        return 0;
+
+    if ((unsigned) evaluation > TGDB_CONDITION_TARGET)
+        return -1;
+
+    snprintf(command, sizeof (command),
+            "set breakpoint condition-evaluation %s", modes[evaluation]);
+    if (tgdb_send(tgdb, command, TGDB_COMMAND_FRONT_END) == -1)
+        return -1;
+
+    tgdb->condition_evaluation = evaluation;
+
+    return 0;
+}
+
 static int
 tgdb_process_modify_breakpoint(struct tgdb *tgdb, tgdb_request_ptr request)
 {
+    const char *condition;
     char *val;
 
     if (!tgdb || !request)
@@ -1308,6 +2173,20 @@ tgdb_process_modify_breakpoint(struct tgdb *tgdb, tgdb_request_ptr request)
     if (val == NULL)
         return -1;
 
+    /* Both debuggers take the condition after the location */
+    condition = request->choice.modify_breakpoint.condition;
+    if (condition) {
+        if (tgdb_set_condition_evaluation(tgdb,
+                        request->choice.modify_breakpoint.evaluation) == -1) {
+            free(val);
+            return -1;
+        }
+
+        val = cgdb_realloc(val, strlen(val) + strlen(condition) + 5);
+        strcat(val, " if ");
+        strcat(val, condition);
+    }
+
     if (tgdb_send(tgdb, val, TGDB_COMMAND_FRONT_END) == -1) {
         logger_write_pos(logger, __FILE__, __LINE__, "tgdb_send failed");
         return -1;
@@ -1318,6 +2197,99 @@ tgdb_process_modify_breakpoint(struct tgdb *tgdb, tgdb_request_ptr request)
     return 0;
 }
 
+/**
+ * Writes the breakpoints of a request to a new script in the config
+ * directory, a command to set each and one to disable it if it's disabled.
+ *
+ * \return
+ * The path of the script, or NULL on error.
+ */
+static char *
+tgdb_write_breakpoint_script(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    struct tgdb_breakpoint *breakpoints =
+            request->choice.add_breakpoints.breakpoints;
+    char path[FSUTIL_PATH_MAX];
+    char *val;
+    FILE *file;
+    int fd, i, ret = 0;
+
+    fs_util_get_path(tgdb->config_dir, "breakpointsXXXXXX", path);
+    if ((fd = mkstemp(path)) == -1)
+        return NULL;
+
+    if (!(file = fdopen(fd, "w"))) {
+        close(fd);
+        unlink(path);
+        return NULL;
+    }
+
+    for (i = 0; i < request->choice.add_breakpoints.count; i++) {
+        val = tgdb_client_modify_breakpoint_call(tgdb,
+                breakpoints[i].file, breakpoints[i].line,
+                TGDB_BREAKPOINT_ADD);
+        if (!val) {
+            ret = -1;
+            break;
+        }
+
+        fprintf(file, "%s\n", val);
+        if (!breakpoints[i].enabled)
+            fprintf(file, "disable $bpnum\n");
+        free(val);
+    }
+
+    if (ferror(file))
+        ret = -1;
+    if (fclose(file) == EOF)
+        ret = -1;
+
+    if (ret == -1) {
+        unlink(path);
+        return NULL;
+    }
+
+    return cgdb_strdup(path);
+}
+
+static int
+tgdb_process_add_breakpoints(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    char *script, *command;
+    int ret;
+
+    if (!tgdb || !request)
+        return -1;
+
+    if (request->header != TGDB_REQUEST_ADD_BREAKPOINTS)
+        return -1;
+
+    if (!(script = tgdb_write_breakpoint_script(tgdb, request))) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "Unable to write the breakpoint script");
+        return -1;
+    }
+
+    /* The last script was read when its request ran, before this one */
+    if (tgdb->breakpoint_script) {
+        unlink(tgdb->breakpoint_script);
+        free(tgdb->breakpoint_script);
+    }
+    tgdb->breakpoint_script = script;
+
+    /* gdb reads all of them with one command, and its client refreshes the
+     * breakpoints once, when it's done */
+    command = (char *) cgdb_malloc(strlen(script) + 8);
+    sprintf(command, "source %s", script);
+    ret = tgdb_send(tgdb, command, TGDB_COMMAND_FRONT_END);
+    free(command);
+
+    if (ret == -1)
+        logger_write_pos(logger, __FILE__, __LINE__, "tgdb_send failed");
+
+    return ret;
+}
+
 static int tgdb_process_complete(struct tgdb *tgdb, tgdb_request_ptr request)
 {
     int ret;
@@ -1335,14 +2307,214 @@ static int tgdb_process_complete(struct tgdb *tgdb, tgdb_request_ptr request)
     return ret;
 }
 
-int tgdb_process_command(struct tgdb *tgdb, tgdb_request_ptr request)
+static int
+tgdb_process_disassemble(struct tgdb *tgdb, tgdb_request_ptr request)
 {
+    int ret;
+
     if (!tgdb || !request)
         return -1;
 
-    if (!tgdb_can_issue_command(tgdb))
+    if (request->header != TGDB_REQUEST_DISASSEMBLE)
+        return -1;
+
+    ret = tgdb_client_disassemble(tgdb->tcc,
+            request->choice.disassemble.address);
+    tgdb_process_client_commands(tgdb);
+
+    return ret;
+}
+
+static int
+tgdb_process_variable(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    tgdb_list_iterator *last;
+    int ret;
+
+    if (!tgdb || !request)
+        return -1;
+
+    if (request->header != TGDB_REQUEST_VARIABLE)
+        return -1;
+
+    last = tgdb_list_get_last(tgdb->command_list);
+    ret = tgdb_client_variable(tgdb->tcc, request->choice.variable.command,
+            request->choice.variable.name);
+    tgdb_process_client_commands(tgdb);
+
+    /* The front end waits for the answer, it's told the client can't */
+    if (ret == -1 &&
+            request->choice.variable.command != TGDB_VARIABLE_DELETE &&
+            request->choice.variable.command !=
+            TGDB_VARIABLE_DELETE_CHILDREN) {
+        struct tgdb_variables *variables = (struct tgdb_variables *)
+                std_arena_alloc(tgdb->response_arena,
+                sizeof (struct tgdb_variables));
+        struct tgdb_response *response;
+
+        variables->command = request->choice.variable.command;
+        variables->error = std_arena_strdup(tgdb->response_arena,
+                "variable objects need GDB/MI");
+        variables->variables = (struct tgdb_variable *)
+                std_arena_alloc(tgdb->response_arena,
+                sizeof (struct tgdb_variable));
+
+        response = tgdb_types_new_response(tgdb->response_arena,
+                tgdb->command_list, TGDB_UPDATE_VARIABLES);
+        response->choice.update_variables.variables = variables;
+
+        /* The front end can get it right away */
+        if (!tgdb->command_list_iterator) {
+            if (last)
+                tgdb->command_list_iterator = tgdb_list_next(last);
+            else
+                tgdb->command_list_iterator =
+                        tgdb_list_get_first(tgdb->command_list);
+        }
+    }
+
+    return ret;
+}
+
+static int
+tgdb_process_read_memory(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    tgdb_list_iterator *last;
+    int ret;
+
+    if (!tgdb || !request)
         return -1;
 
+    if (request->header != TGDB_REQUEST_READ_MEMORY)
+        return -1;
+
+    last = tgdb_list_get_last(tgdb->command_list);
+    ret = tgdb_client_read_memory(tgdb->tcc,
+            request->choice.read_memory.address,
+            request->choice.read_memory.length);
+    tgdb_process_client_commands(tgdb);
+
+    /* The front end waits for the answer, it's told the client can't */
+    if (ret == -1) {
+        int length = request->choice.read_memory.length;
+        struct tgdb_memory *memory = (struct tgdb_memory *)
+                std_arena_alloc(tgdb->response_arena,
+                sizeof (struct tgdb_memory));
+        struct tgdb_response *response;
+
+        memory->length = length;
+        memory->bytes = (unsigned char *) std_arena_alloc(tgdb->
+                response_arena, length);
+        memory->readable = (unsigned char *) std_arena_alloc(tgdb->
+                response_arena, length);
+        memory->error = std_arena_strdup(tgdb->response_arena,
+                "reading memory needs GDB/MI");
+
+        response = tgdb_types_new_response(tgdb->response_arena,
+                tgdb->command_list, TGDB_UPDATE_MEMORY);
+        response->choice.update_memory.memory = memory;
+
+        /* The front end can get it right away */
+        if (!tgdb->command_list_iterator) {
+            if (last)
+                tgdb->command_list_iterator = tgdb_list_next(last);
+            else
+                tgdb->command_list_iterator =
+                        tgdb_list_get_first(tgdb->command_list);
+        }
+    }
+
+    return ret;
+}
+
+static int tgdb_process_frames(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    tgdb_list_iterator *last;
+    int ret;
+
+    if (!tgdb || !request)
+        return -1;
+
+    if (request->header != TGDB_REQUEST_FRAMES)
+        return -1;
+
+    last = tgdb_list_get_last(tgdb->command_list);
+    ret = tgdb_client_list_frames(tgdb->tcc, request->choice.frames.thread,
+            request->choice.frames.low, request->choice.frames.high);
+    tgdb_process_client_commands(tgdb);
+
+    /* The front end waits for the answer, it's told the client can't */
+    if (ret == -1) {
+        struct tgdb_frames *frames = (struct tgdb_frames *)
+                std_arena_alloc(tgdb->response_arena,
+                sizeof (struct tgdb_frames));
+        struct tgdb_response *response;
+
+        frames->thread = request->choice.frames.thread;
+        frames->low = request->choice.frames.low;
+        frames->count = 0;
+        frames->frames = NULL;
+        frames->error = std_arena_strdup(tgdb->response_arena,
+                "listing frames needs GDB/MI");
+
+        response = tgdb_types_new_response(tgdb->response_arena,
+                tgdb->command_list, TGDB_UPDATE_FRAMES);
+        response->choice.update_frames.frames = frames;
+
+        /* The front end can get it right away */
+        if (!tgdb->command_list_iterator) {
+            if (last)
+                tgdb->command_list_iterator = tgdb_list_next(last);
+            else
+                tgdb->command_list_iterator =
+                        tgdb_list_get_first(tgdb->command_list);
+        }
+    }
+
+    return ret;
+}
+
+static int
+tgdb_process_select_frame(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    int ret;
+
+    if (!tgdb || !request)
+        return -1;
+
+    if (request->header != TGDB_REQUEST_SELECT_FRAME)
+        return -1;
+
+    ret = tgdb_client_select_frame(tgdb->tcc,
+            request->choice.select_frame.level);
+    tgdb_process_client_commands(tgdb);
+
+    return ret;
+}
+
+static int
+tgdb_process_select_thread(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    int ret;
+
+    if (!tgdb || !request)
+        return -1;
+
+    if (request->header != TGDB_REQUEST_SELECT_THREAD)
+        return -1;
+
+    ret = tgdb_client_select_thread(tgdb->tcc,
+            request->choice.select_thread.id);
+    tgdb_process_client_commands(tgdb);
+
+    return ret;
+}
+
+static int tgdb_process_request(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    if (tgdb->remote)
+        return tgdb_remote_send_request(tgdb->remote, request);
+
     if (request->header == TGDB_REQUEST_CONSOLE_COMMAND)
         return tgdb_process_console_command(tgdb, request);
     else if (request->header == TGDB_REQUEST_INFO_SOURCES)
@@ -1357,21 +2529,261 @@ int tgdb_process_command(struct tgdb *tgdb, tgdb_request_ptr request)
         return tgdb_process_modify_breakpoint(tgdb, request);
     else if (request->header == TGDB_REQUEST_COMPLETE)
         return tgdb_process_complete(tgdb, request);
+    else if (request->header == TGDB_REQUEST_DISASSEMBLE)
+        return tgdb_process_disassemble(tgdb, request);
+    else if (request->header == TGDB_REQUEST_VARIABLE)
+        return tgdb_process_variable(tgdb, request);
+    else if (request->header == TGDB_REQUEST_READ_MEMORY)
+        return tgdb_process_read_memory(tgdb, request);
+    else if (request->header == TGDB_REQUEST_FRAMES)
+        return tgdb_process_frames(tgdb, request);
+    else if (request->header == TGDB_REQUEST_SELECT_FRAME)
+        return tgdb_process_select_frame(tgdb, request);
+    else if (request->header == TGDB_REQUEST_SELECT_THREAD)
+        return tgdb_process_select_thread(tgdb, request);
+    else if (request->header == TGDB_REQUEST_ADD_BREAKPOINTS)
+        return tgdb_process_add_breakpoints(tgdb, request);
 
     return 0;
 }
 
+int tgdb_process_command(struct tgdb *tgdb, tgdb_request_ptr request)
+{
+    struct tgdb_pending *pending;
+    int ret;
+
+    if (!tgdb || !request)
+        return -1;
+
+    if (!tgdb_can_issue_command(tgdb))
+        return -1;
+
+    /* The responses so far belong to the request before this one */
+    tgdb_tag_responses(tgdb);
+
+    tgdb->running_handle = request->handle;
+    if ((pending = tgdb_pending_find(tgdb, request->handle)) != NULL)
+        pending->status = TGDB_REQUEST_RUNNING;
+
+    ret = tgdb_process_request(tgdb, request);
+    tgdb_tag_responses(tgdb);
+
+    /* tgdb may know the answer without asking gdb */
+    if (tgdb_can_issue_command(tgdb))
+        tgdb_request_finished(tgdb);
+
+    return ret;
+}
+
 /* }}}*/
 
 /* }}} */
 
 /* TGDB Queue commands {{{*/
 
+/**
+ * Determines if a request only refreshes what the FE shows. These can run
+ * after the user's commands, and once is enough for each.
+ *
+ * \param request
+ * The request
+ *
+ * \return
+ * 1 if it's a refresh, 0 otherwise
+ */
+static int tgdb_request_is_refresh(tgdb_request_ptr request)
+{
+    switch (request->header) {
+        case TGDB_REQUEST_INFO_SOURCES:
+        case TGDB_REQUEST_FILENAME_PAIR:
+        case TGDB_REQUEST_CURRENT_LOCATION:
+        case TGDB_REQUEST_DISASSEMBLE:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Determines if a request moves the program, or the frame the debugger
+ * looks at. The debugger reports the new location when it's done.
+ *
+ * \param request
+ * The request
+ *
+ * \return
+ * 1 if it moves, 0 otherwise
+ */
+static int tgdb_request_moves(tgdb_request_ptr request)
+{
+    if (request->header != TGDB_REQUEST_DEBUGGER_COMMAND)
+        return 0;
+
+    switch (request->choice.debugger_command.c) {
+        case TGDB_CONTINUE:
+        case TGDB_FINISH:
+        case TGDB_NEXT:
+        case TGDB_START:
+        case TGDB_RUN:
+        case TGDB_STEP:
+        case TGDB_UNTIL:
+        case TGDB_UP:
+        case TGDB_DOWN:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Determines if a request steps through the program, which gdb can do
+ * a number of times with a single command.
+ *
+ * \param request
+ * The request
+ *
+ * \return
+ * 1 if it steps, 0 otherwise
+ */
+static int tgdb_request_steps(tgdb_request_ptr request)
+{
+    if (request->header != TGDB_REQUEST_DEBUGGER_COMMAND)
+        return 0;
+
+    return request->choice.debugger_command.c == TGDB_NEXT ||
+            request->choice.debugger_command.c == TGDB_STEP;
+}
+
+/**
+ * Determines if two refresh requests ask for the same thing, for
+ * queue_find.
+ *
+ * \param item
+ * The queued request
+ *
+ * \param data
+ * The new request
+ *
+ * \return
+ * 1 if they are the same, 0 otherwise
+ */
+static int tgdb_request_matches(void *item, void *data)
+{
+    tgdb_request_ptr queued = (tgdb_request_ptr) item;
+    tgdb_request_ptr request = (tgdb_request_ptr) data;
+
+    if (queued->header != request->header)
+        return 0;
+
+    switch (request->header) {
+        case TGDB_REQUEST_INFO_SOURCES:
+            return 1;
+        case TGDB_REQUEST_FILENAME_PAIR:
+            return strcmp(queued->choice.filename_pair.file,
+                    request->choice.filename_pair.file) == 0;
+        case TGDB_REQUEST_CURRENT_LOCATION:
+            return queued->choice.current_location.on_startup ==
+                    request->choice.current_location.on_startup;
+        case TGDB_REQUEST_DISASSEMBLE:
+            if (!queued->choice.disassemble.address ||
+                    !request->choice.disassemble.address)
+                return queued->choice.disassemble.address ==
+                        request->choice.disassemble.address;
+            return strcmp(queued->choice.disassemble.address,
+                    request->choice.disassemble.address) == 0;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Determines if a queued request asks for the location, for
+ * queue_free_matching.
+ */
+static int tgdb_request_matches_location(void *item, void *data)
+{
+    tgdb_request_ptr queued = (tgdb_request_ptr) item;
+
+    return queued->header == TGDB_REQUEST_CURRENT_LOCATION;
+}
+
+/**
+ * Determines if a queued request has the handle data points to, for
+ * queue_find and queue_free_matching.
+ */
+static int tgdb_request_matches_handle(void *item, void *data)
+{
+    tgdb_request_ptr queued = (tgdb_request_ptr) item;
+
+    return queued->handle == *(int *) data;
+}
+
+/**
+ * Determines if a queued request is sent to the debugger as a command,
+ * which makes the client refresh the breakpoints, for queue_find.
+ */
+static int tgdb_request_matches_sent(void *item, void *data)
+{
+    tgdb_request_ptr queued = (tgdb_request_ptr) item;
+
+    return queued->header == TGDB_REQUEST_CONSOLE_COMMAND ||
+            queued->header == TGDB_REQUEST_DEBUGGER_COMMAND ||
+            queued->header == TGDB_REQUEST_MODIFY_BREAKPOINT ||
+            queued->header == TGDB_REQUEST_ADD_BREAKPOINTS;
+}
+
 int tgdb_queue_append(struct tgdb *tgdb, tgdb_request_ptr request)
 {
     if (!tgdb || !request)
         return -1;
 
+    if (tgdb_request_is_refresh(request)) {
+        tgdb_request_ptr queued = queue_find(tgdb->gdb_client_refresh_queue,
+                tgdb_request_matches, request);
+
+        /* The one already waiting gets the same answer. A submitted
+         * request is answered on its own, its callback is waiting for it. */
+        if (queued && !queued->handle && !request->handle) {
+            tgdb_request_destroy(request);
+            return 0;
+        }
+
+        queue_append(tgdb->gdb_client_refresh_queue, request);
+        return 0;
+    }
+
+    /* A step that's held down queues up faster than gdb steps. The steps
+     * waiting at the end of the queue are run as "next N", so the location
+     * and the breakpoints are only refreshed once, for the last stop. */
+    if (tgdb_request_steps(request) && !request->handle) {
+        tgdb_request_ptr last = queue_last(tgdb->gdb_client_request_queue);
+
+        if (last && !last->handle && tgdb_request_steps(last) &&
+                last->choice.debugger_command.c ==
+                request->choice.debugger_command.c) {
+            last->choice.debugger_command.count +=
+                    request->choice.debugger_command.count;
+            tgdb_request_destroy(request);
+            return 0;
+        }
+    }
+
+    /* The location the debugger was at is stale once it moves */
+    if (tgdb_request_moves(request)) {
+        struct tgdb_pending *pending;
+        tgdb_request_ptr queued;
+
+        for (pending = tgdb->pending; pending; pending = pending->next) {
+            queued = queue_find(tgdb->gdb_client_refresh_queue,
+                    tgdb_request_matches_handle, &pending->handle);
+            if (queued && tgdb_request_matches_location(queued, NULL))
+                pending->status = TGDB_REQUEST_CANCELLED;
+        }
+
+        queue_free_matching(tgdb->gdb_client_refresh_queue,
+                tgdb_request_matches_location, NULL, tgdb_request_destroy);
+    }
+
     queue_append(tgdb->gdb_client_request_queue, request);
 
     return 0;
@@ -1384,7 +2796,10 @@ tgdb_request_ptr tgdb_queue_pop(struct tgdb * tgdb)
     if (!tgdb)
         return NULL;
 
+    /* The user's commands go ahead of the refreshes */
     item = queue_pop(tgdb->gdb_client_request_queue);
+    if (!item)
+        item = queue_pop(tgdb->gdb_client_refresh_queue);
 
     return item;
 }
@@ -1394,11 +2809,141 @@ int tgdb_queue_size(struct tgdb *tgdb, int *size)
     if (!tgdb || !size)
         return -1;
 
-    *size = queue_size(tgdb->gdb_client_request_queue);
+    *size = queue_size(tgdb->gdb_client_request_queue) +
+            queue_size(tgdb->gdb_client_refresh_queue);
+
+    return 0;
+}
+
+/* }}}*/
+
+/* Asynchronous requests {{{*/
+
+int tgdb_request_submit(struct tgdb *tgdb, tgdb_request_ptr request,
+        tgdb_request_callback callback, void *data)
+{
+    struct tgdb_pending *pending, **last;
+    int is_busy;
+
+    if (!tgdb || !request)
+        return -1;
+
+    if (tgdb_is_busy(tgdb, &is_busy) == -1)
+        return -1;
+
+    pending = (struct tgdb_pending *)
+            cgdb_malloc(sizeof (struct tgdb_pending));
+    pending->handle = request->handle = ++tgdb->next_handle;
+    pending->status = TGDB_REQUEST_QUEUED;
+    pending->callback = callback;
+    pending->data = data;
+    pending->next = NULL;
+
+    for (last = &tgdb->pending; *last; last = &(*last)->next);
+    *last = pending;
+
+    if (is_busy)
+        tgdb_queue_append(tgdb, request);
+    else if (tgdb_process_command(tgdb, request) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_process_command failed");
+        pending->status = TGDB_REQUEST_CANCELLED;
+    }
+
+    return pending->handle;
+}
+
+int tgdb_request_cancel(struct tgdb *tgdb, int handle)
+{
+    struct tgdb_pending **p, *pending;
+
+    if (!tgdb)
+        return -1;
+
+    for (p = &tgdb->pending; *p && (*p)->handle != handle; p = &(*p)->next);
+
+    if (!*p)
+        return -1;
+
+    pending = *p;
+    *p = pending->next;
+
+    if (pending->status == TGDB_REQUEST_QUEUED) {
+        queue_free_matching(tgdb->gdb_client_request_queue,
+                tgdb_request_matches_handle, &handle, tgdb_request_destroy);
+        queue_free_matching(tgdb->gdb_client_refresh_queue,
+                tgdb_request_matches_handle, &handle, tgdb_request_destroy);
+    }
+
+    free(pending);
 
     return 0;
 }
 
+enum tgdb_request_status tgdb_request_status(struct tgdb *tgdb, int handle)
+{
+    struct tgdb_pending *pending;
+
+    if (!tgdb || !(pending = tgdb_pending_find(tgdb, handle)))
+        return TGDB_REQUEST_DONE;
+
+    return pending->status;
+}
+
+void tgdb_dispatch_responses(struct tgdb *tgdb)
+{
+    tgdb_list_iterator *i;
+    struct tgdb_response *response;
+    struct tgdb_pending **p, *pending, *finished = NULL, **last = &finished;
+
+    if (!tgdb)
+        return;
+
+    tgdb_tag_responses(tgdb);
+
+    /* A callback may submit requests, their responses come after these */
+    if (tgdb->dispatched)
+        i = tgdb_list_next(tgdb->dispatched);
+    else
+        i = tgdb_list_get_first(tgdb->command_list);
+
+    for (; i; i = tgdb_list_next(i)) {
+        tgdb->dispatched = i;
+        response = (struct tgdb_response *) tgdb_list_get_item(i);
+
+        if (response->request &&
+                (pending = tgdb_pending_find(tgdb, response->request)) &&
+                pending->callback)
+            pending->callback(tgdb, pending->handle, TGDB_REQUEST_RUNNING,
+                    response, pending->data);
+    }
+
+    /* The finished requests are taken out first, so the callbacks can
+     * submit and cancel requests */
+    for (p = &tgdb->pending; *p;) {
+        pending = *p;
+
+        if (pending->status == TGDB_REQUEST_DONE ||
+                pending->status == TGDB_REQUEST_CANCELLED) {
+            *p = pending->next;
+            pending->next = NULL;
+            *last = pending;
+            last = &pending->next;
+        } else
+            p = &pending->next;
+    }
+
+    while (finished) {
+        pending = finished;
+        finished = pending->next;
+
+        if (pending->callback)
+            pending->callback(tgdb, pending->handle, pending->status, NULL,
+                    pending->data);
+        free(pending);
+    }
+}
+
 /* }}}*/
 
 /* Signal Handling Support {{{*/
@@ -1408,10 +2953,37 @@ int tgdb_signal_notification(struct tgdb *tgdb, int signum)
     struct termios t;
     cc_t *sig_char = NULL;
 
+    /* The headless tgdb interrupts the debugger, it's not a child of this
+     * process */
+    if (tgdb->remote) {
+        if (signum == SIGINT) {
+            tgdb_cancel_queued(tgdb);
+            tgdb->control_c = 1;
+        }
+
+        if (signum == SIGINT || signum == SIGQUIT)
+            return tgdb_remote_signal(tgdb->remote, signum);
+
+        return 0;
+    }
+
     tcgetattr(tgdb->debugger_stdin, &t);
 
     if (signum == SIGINT) {     /* ^c */
+        tgdb_cancel_queued(tgdb);
+
+        /* In non-stop mode, gdb is given a command, that isn't cancelled */
+        if (tgdb_client_interrupt(tgdb->tcc) == 0)
+            return tgdb_process_client_commands(tgdb);
+
         tgdb->control_c = 1;
+
+        /* The program stays stopped, even if a sample stops it */
+        if (tgdb->sampling) {
+            tgdb_client_sample(tgdb->tcc, 0);
+            tgdb->sampling = 0;
+        }
+
         sig_char = &t.c_cc[VINTR];
         if (write(tgdb->debugger_stdin, sig_char, 1) < 1)
             return -1;
@@ -1426,14 +2998,52 @@ int tgdb_signal_notification(struct tgdb *tgdb, int signum)
     return 0;
 }
 
+int tgdb_sample(struct tgdb *tgdb, int depth)
+{
+    struct termios t;
+
+    if (tgdb->remote || depth <= 0)
+        return -1;
+
+    if (tgdb_client_sample(tgdb->tcc, depth) == -1)
+        return -1;
+
+    /* Unlike the user's ^c, what is queued still runs after the sample */
+    tcgetattr(tgdb->debugger_stdin, &t);
+    if (write(tgdb->debugger_stdin, &t.c_cc[VINTR], 1) < 1) {
+        tgdb_client_sample(tgdb->tcc, 0);
+        return -1;
+    }
+
+    tgdb->sampling = 1;
+
+    return 0;
+}
+
 /* }}}*/
 
 /* Config Options {{{*/
+int tgdb_set_non_stop(struct tgdb *tgdb, int on)
+{
+    /* The headless tgdb isn't told about it */
+    if (tgdb->remote)
+        return -1;
+
+    if (tgdb_client_non_stop(tgdb->tcc, on) == -1)
+        return -1;
+
+    return tgdb_process_client_commands(tgdb);
+}
+
 int tgdb_set_verbose_gui_command_output(struct tgdb *tgdb, int value)
 {
     if ((value == 0) || (value == 1))
         tgdb->show_gui_commands = value;
 
+    /* The headless tgdb is the one that shows them */
+    if (tgdb->remote && (value == 0 || value == 1))
+        tgdb_remote_set_verbose(tgdb->remote, value);
+
     if (tgdb->show_gui_commands == 1)
         return 1;
 
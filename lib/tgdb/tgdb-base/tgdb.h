@@ -61,11 +61,57 @@ extern "C" {
    * \param debugger_fd
    * The descriptor to the debugger's I/O
    *
+   * \param gdbmi
+   * 1 to talk to the debugger with GDB/MI, 0 to use annotate two.
+   *
    * @return
    * NULL on error, a valid context on success.
    */
     struct tgdb *tgdb_initialize(const char *debugger,
-            int argc, char **argv, int *debugger_fd);
+            int argc, char **argv, int *debugger_fd, int gdbmi);
+
+  /**
+   * This initializes a tgdb library instance that talks to a headless tgdb,
+   * one that runs tgdb_serve, instead of to gdb. It's used the same way as
+   * one that tgdb_initialize starts.
+   *
+   * The source files are still read by the front end, so they have to be
+   * at the same paths on both machines.
+   *
+   * \param command
+   * The command that connects to the headless tgdb, like
+   * "ssh host cgdb --headless ./program". It's run by the shell, and
+   * talked to on its stdin and stdout.
+   *
+   * \param debugger_fd
+   * The descriptor to select on for the headless tgdb's messages
+   *
+   * @return
+   * NULL on error, a valid context on success.
+   */
+    struct tgdb *tgdb_initialize_remote(const char *command, int *debugger_fd);
+
+  /**
+   * Runs tgdb headless, for a front end on another machine that called
+   * tgdb_initialize_remote. It returns when the front end goes away, or
+   * the debugger exits.
+   *
+   * \param tgdb
+   * An instance of the tgdb library, from tgdb_initialize.
+   *
+   * \param debugger_fd
+   * The descriptor tgdb_initialize gave back.
+   *
+   * \param in
+   * The front end's messages are read from this descriptor.
+   *
+   * \param out
+   * The messages for the front end are written to this descriptor.
+   *
+   * @return
+   * 0 on success or -1 on error
+   */
+    int tgdb_serve(struct tgdb *tgdb, int debugger_fd, int in, int out);
 
   /**
    * This will terminate a libtgdb session. No functions should be called on
@@ -157,11 +203,14 @@ extern "C" {
    * An instance of the tgdb library to operate on.
    *
    * \param buf
-   * The output of the debugger will be returned in this buffer.
-   * The buffer passed back will not exceed N in size.
+   * The output of the debugger will be returned in this buffer, null
+   * terminated. The buffer passed back will not exceed N in size, so BUF
+   * needs room for N + 1 bytes. It's the caller's, and can be used again.
    *
    * \param n
    * Tells libtgdb how large the buffer BUF is that the client passed in.
+   * Everything the debugger has ready is read and parsed at once, up to
+   * N bytes.
    *
    * \param is_finished
    * If this is passed in as NULL, it is not set.
@@ -176,6 +225,30 @@ extern "C" {
     size_t tgdb_process(struct tgdb *tgdb, char *buf, size_t n,
             int *is_finished);
 
+  /**
+   * Does what tgdb_process does, with output gdb printed before instead of
+   * what is ready to be read from gdb. tgdb_replay uses this to run
+   * captured output through tgdb's parsers at full speed.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param data
+   * The output gdb printed.
+   *
+   * \param size
+   * The size of data.
+   *
+   * \param buf, n, is_finished
+   * The same as for tgdb_process. buf needs a few bytes more than size,
+   * since tgdb may give back a little it held on to from before.
+   *
+   * @return
+   * The number of valid bytes in BUF on success, or -1 on error.
+   */
+    size_t tgdb_process_buffer(struct tgdb *tgdb, const char *data,
+            size_t size, char *buf, size_t n, int *is_finished);
+
   /**
    * This sends a byte of data to the program being debugged.
    *
@@ -190,6 +263,37 @@ extern "C" {
    */
     int tgdb_send_inferior_char(struct tgdb *tgdb, char c);
 
+  /**
+   * This queues data for the program being debugged. It's written by
+   * tgdb_flush_inferior_data, so a batch of keys takes one write.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param buf
+   * The data to pass to the program being debugged.
+   *
+   * \param n
+   * The number of bytes in buf.
+   *
+   * @return
+   * 0 on success or -1 on error
+   */
+    int tgdb_send_inferior_data(struct tgdb *tgdb, const char *buf, size_t n);
+
+  /**
+   * This writes the data queued by tgdb_send_inferior_data, without
+   * blocking.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * @return
+   * 0 when it was all written, 1 when some is still queued because the
+   * program isn't reading, it should be flushed again later, or -1 on error
+   */
+    int tgdb_flush_inferior_data(struct tgdb *tgdb);
+
   /**
    * Gets the ouput from the program being debugged.
    * 
@@ -198,12 +302,16 @@ extern "C" {
    *
    * \param buf
    * The output of the program being debugged will be returned here.
+   * Everything that's ready is read, up to N bytes, and it's null terminated.
+   * The output may hold null bytes of its own, so use the returned length
+   * rather than strlen.
    *
    * \param n
-   * Tells libtgdb how large the buffer BUF is.
+   * Tells libtgdb how large the buffer BUF is, less the null terminator.
    *
    * @return
-   * The number of valid bytes in BUF on success, or 0 on error.
+   * The number of valid bytes in BUF on success, 0 on EOF, or -1 on error.
+   * errno is EAGAIN when there was nothing to read.
    */
     ssize_t tgdb_recv_inferior_data(struct tgdb *tgdb, char *buf, size_t n);
 
@@ -244,6 +352,11 @@ extern "C" {
 
   /**
    * This will free all of the memory used by the responses that tgdb returns.
+   * The responses, and everything they point to, are allocated together and
+   * are all freed at once. A front end that keeps something from a response
+   * must copy it, see tgdb_types_copy_file_position.
+   *
+   * tgdb_process calls this before it reads the next batch of responses.
    *
    * \param tgdb
    * An instance of the tgdb library to operate on.
@@ -444,6 +557,58 @@ extern "C" {
     tgdb_request_ptr tgdb_request_modify_breakpoint(struct tgdb *tgdb,
             const char *file, int line, enum tgdb_breakpoint_action b);
 
+  /**
+   * Adds a breakpoint that only stops the program when a condition is true.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param file
+   * The file to set the breakpoint in.
+   *
+   * \param line
+   * The line in FILE to set the breakpoint in.
+   *
+   * \param condition
+   * The expression, in the language of the program.
+   *
+   * \param evaluation
+   * Where the debugger tests it. The debugger is told before the breakpoint
+   * is set, when it's not where the last one was tested.
+   *
+   * @return
+   * Will return as a tgdb request command on success, otherwise NULL.
+   */
+    tgdb_request_ptr tgdb_request_condition_breakpoint(struct tgdb *tgdb,
+            const char *file, int line, const char *condition,
+            enum tgdb_condition_evaluation evaluation);
+
+  /**
+   * Sets a number of breakpoints with one command. They are written to a
+   * script the debugger sources, so they take a single round trip, and the
+   * breakpoints are refreshed once, after the last one is set. A disabled
+   * breakpoint is disabled right after it's set.
+   *
+   * The debugger stops reading the script at the first breakpoint it can't
+   * set, like it does for any script.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param breakpoints
+   * The breakpoints to set. Only their file, line and enabled are used,
+   * and they're copied.
+   *
+   * \param count
+   * The number of breakpoints.
+   *
+   * @return
+   * Will return as a tgdb request command on success, otherwise NULL. It's
+   * NULL when there are no breakpoints.
+   */
+    tgdb_request_ptr tgdb_request_add_breakpoints(struct tgdb *tgdb,
+            const struct tgdb_breakpoint *breakpoints, int count);
+
   /**
    * Used to get all of the possible tab completion options for LINE.
    *
@@ -458,6 +623,125 @@ extern "C" {
    */
     tgdb_request_ptr tgdb_request_complete(struct tgdb *tgdb, const char *line);
 
+  /**
+   * Used to get the instructions of a function. They come back in a
+   * TGDB_UPDATE_DISASSEMBLY response.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param address
+   * An address in the function, like "0x401126", or NULL for the function
+   * the debugger is at.
+   *
+   * \return
+   * Will return as a tgdb request command on success, otherwise NULL.
+   */
+    tgdb_request_ptr tgdb_request_disassemble(struct tgdb *tgdb,
+            const char *address);
+
+  /**
+   * Used to create, update, expand or delete variable objects. Each
+   * request but the ones that delete gets a TGDB_UPDATE_VARIABLES
+   * response, in the order they were made. Only the GDB/MI client has
+   * variable objects.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param command
+   * What to do.
+   *
+   * \param name
+   * The expression or the variable object it's done to, or NULL if the
+   * command doesn't need one.
+   *
+   * \return
+   * Will return as a tgdb request command on success, otherwise NULL.
+   */
+    tgdb_request_ptr tgdb_request_variable(struct tgdb *tgdb,
+            enum tgdb_variable_command command, const char *name);
+
+  /**
+   * Used to read bytes of the memory of the program being debugged. Each
+   * request gets a TGDB_UPDATE_MEMORY response, in the order they were
+   * made, even if nothing could be read. Only the GDB/MI client can read
+   * memory.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param address
+   * An expression for the address of the first byte, like "0x601040" or
+   * "&packet".
+   *
+   * \param length
+   * How many bytes to read.
+   *
+   * \return
+   * Will return as a tgdb request command on success, otherwise NULL.
+   */
+    tgdb_request_ptr tgdb_request_read_memory(struct tgdb *tgdb,
+            const char *address, int length);
+
+  /**
+   * Used to list a window of the frames of the stack. Each request gets a
+   * TGDB_UPDATE_FRAMES response, in the order they were made, even if no
+   * frame could be listed. Fewer frames than asked for means the stack
+   * isn't that deep. Only the GDB/MI client can list frames.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param thread
+   * The global number of the thread, or 0 for the one the debugger looks
+   * at. The debugger keeps looking at the one it did.
+   *
+   * \param low
+   * The level of the first frame, 0 is the innermost one.
+   *
+   * \param high
+   * The level of the last frame.
+   *
+   * \return
+   * Will return as a tgdb request command on success, otherwise NULL.
+   */
+    tgdb_request_ptr tgdb_request_frames(struct tgdb *tgdb, int thread,
+            int low, int high);
+
+  /**
+   * Used to make the debugger look at another frame, so that what's
+   * evaluated is evaluated there. There's no response, the front end
+   * already knows where the frame is from the frames it listed. Only the
+   * GDB/MI client can select a frame.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param level
+   * The level of the frame.
+   *
+   * \return
+   * Will return as a tgdb request command on success, otherwise NULL.
+   */
+    tgdb_request_ptr tgdb_request_select_frame(struct tgdb *tgdb, int level);
+
+  /**
+   * Used to make the debugger look at another thread, at its innermost
+   * frame. There's no response, the front end lists the thread's frames
+   * itself. Only the GDB/MI client can select a thread.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param id
+   * The global number of the thread, from a TGDB_UPDATE_THREADS.
+   *
+   * \return
+   * Will return as a tgdb request command on success, otherwise NULL.
+   */
+    tgdb_request_ptr tgdb_request_select_thread(struct tgdb *tgdb, int id);
+
 /*@}*/
 /* }}}*/
 
@@ -513,6 +797,108 @@ extern "C" {
 
 /* }}}*/
 
+/* Asynchronous requests {{{*/
+/******************************************************************************/
+/**
+ * @name Asynchronous requests
+ * These functions run a request and tell the front end about the responses
+ * it caused, so that many requests can be waiting at once.
+ */
+/******************************************************************************/
+
+/*@{*/
+
+  /** Where a submitted request is at. */
+    enum tgdb_request_status {
+    /** The request is waiting for the debugger to finish the ones before it */
+        TGDB_REQUEST_QUEUED,
+    /** The debugger is running the request */
+        TGDB_REQUEST_RUNNING,
+    /** The debugger is done with the request */
+        TGDB_REQUEST_DONE,
+    /** The request was thrown away before it ran */
+        TGDB_REQUEST_CANCELLED
+    };
+
+  /**
+   * This is called by tgdb_dispatch_responses for a submitted request.
+   *
+   * It is called with TGDB_REQUEST_RUNNING for each response the request
+   * caused, then once with TGDB_REQUEST_DONE or TGDB_REQUEST_CANCELLED and
+   * a NULL response. The response is only valid until the next batch.
+   */
+    typedef void (*tgdb_request_callback) (struct tgdb * tgdb, int handle,
+            enum tgdb_request_status status, struct tgdb_response * response,
+            void *data);
+
+  /**
+   * Runs a request, or queues it if TGDB is busy.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param request
+   * The request to run. TGDB owns it now.
+   *
+   * \param callback
+   * The function to tell about the responses, or NULL to only poll the
+   * request with tgdb_request_status.
+   *
+   * \param data
+   * Passed along to callback.
+   *
+   * \return
+   * The handle of the request, or -1 on error.
+   */
+    int tgdb_request_submit(struct tgdb *tgdb, tgdb_request_ptr request,
+            tgdb_request_callback callback, void *data);
+
+  /**
+   * Forgets a submitted request. If it is still queued it won't be run,
+   * otherwise its responses only go to tgdb_get_response. The callback
+   * isn't called for it again.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param handle
+   * The handle tgdb_request_submit returned.
+   *
+   * \return
+   * 0 on success or -1 if there is no such request.
+   */
+    int tgdb_request_cancel(struct tgdb *tgdb, int handle);
+
+  /**
+   * Gets where a submitted request is at.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param handle
+   * The handle tgdb_request_submit returned.
+   *
+   * \return
+   * The status of the request. Requests that were dispatched as finished,
+   * or cancelled, are forgotten and TGDB_REQUEST_DONE is returned.
+   */
+    enum tgdb_request_status tgdb_request_status(struct tgdb *tgdb,
+            int handle);
+
+  /**
+   * Calls the callbacks of the submitted requests, with the responses that
+   * came since the last call, and for the requests that finished.
+   * The front end should call this after it has got the responses of a
+   * batch with tgdb_get_response.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   */
+    void tgdb_dispatch_responses(struct tgdb *tgdb);
+
+/*@}*/
+/* }}}*/
+
 /* Signal Handling Support {{{*/
 /******************************************************************************/
 /**
@@ -543,6 +929,29 @@ extern "C" {
    */
     int tgdb_signal_notification(struct tgdb *tgdb, int signum);
 
+  /**
+   * Interrupts the running program to take a sample of where it is, for a
+   * profiler. When it stops, its innermost frames are listed and it's
+   * continued before any command that's queued, so it's stopped for a
+   * round trip to the debugger or two. The front end gets a
+   * TGDB_UPDATE_SAMPLE, and nothing else tells it the program stopped.
+   * If the program stops for some other reason before the interrupt comes,
+   * it's a stop like any other, and no sample is taken.
+   *
+   * It needs GDB/MI, and the debugger to be run by this tgdb.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param depth
+   * How many frames to list, innermost first.
+   *
+   * @return
+   * 0 on success, or -1 if the program isn't running, a sample is being
+   * taken already, or samples can't be taken.
+   */
+    int tgdb_sample(struct tgdb *tgdb, int depth);
+
 /*@}*/
 /* }}}*/
 
@@ -595,6 +1004,30 @@ extern "C" {
    */
     int tgdb_set_verbose_error_handling(struct tgdb *tgdb, int value);
 
+  /**
+   * This turns the debugger's non-stop mode on or off, before the program
+   * runs. In non-stop mode, a thread that stops, at a breakpoint or
+   * otherwise, doesn't stop the others, and the debugger takes commands
+   * while they run. The front end gets a TGDB_THREAD_RUNNING or
+   * TGDB_THREAD_STOPPED change for each thread, and it's only told where a
+   * thread stopped when it's the one the debugger looks at, or that one
+   * runs. A ^c stops the thread the debugger looks at, or all of them if
+   * it's stopped already.
+   *
+   * It needs GDB/MI, and the debugger to be run by this tgdb. The debugger
+   * tells the user if it can't change the mode anymore.
+   *
+   * \param tgdb
+   * An instance of the tgdb library to operate on.
+   *
+   * \param on
+   * 1 to turn it on, 0 to turn it off.
+   *
+   * @return
+   * 0 on success, or -1 if the debugger has no non-stop mode.
+   */
+    int tgdb_set_non_stop(struct tgdb *tgdb, int on);
+
 /*@}*/
 /* }}}*/
 
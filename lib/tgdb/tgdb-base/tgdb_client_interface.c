@@ -25,7 +25,8 @@ static struct tgdb_client_debugger_interfaces {
 
     void *(*tgdb_client_create_context) (const char *debugger_path,
             int argc, char **argv,
-            const char *config_dir, struct logger * logger);
+            const char *config_dir, struct std_arena * arena,
+            struct logger * logger);
 
     int (*tgdb_client_initialize_context) (void *ctx,
             int *debugger_stdin, int *debugger_stdout,
@@ -52,7 +53,8 @@ static struct tgdb_client_debugger_interfaces {
 
     struct tgdb_list *(*tgdb_client_get_client_commands) (void *ctx);
 
-    int (*tgdb_client_get_filename_pair) (void *ctx, const char *path);
+    int (*tgdb_client_get_filename_pair) (void *ctx, const char *path,
+            struct tgdb_list * list);
 
     int (*tgdb_client_get_current_location) (void *ctx, int on_startup);
 
@@ -61,6 +63,26 @@ static struct tgdb_client_debugger_interfaces {
     int (*tgdb_client_completion_callback) (void *ctx,
             const char *completion_command);
 
+    int (*tgdb_client_disassemble) (void *ctx, const char *address);
+
+    int (*tgdb_client_variable) (void *ctx,
+            enum tgdb_variable_command command, const char *name);
+
+    int (*tgdb_client_read_memory) (void *ctx, const char *address,
+            int length);
+
+    int (*tgdb_client_list_frames) (void *ctx, int thread, int low, int high);
+
+    int (*tgdb_client_select_frame) (void *ctx, int level);
+
+    int (*tgdb_client_select_thread) (void *ctx, int id);
+
+    int (*tgdb_client_sample) (void *ctx, int depth);
+
+    int (*tgdb_client_non_stop) (void *ctx, int on);
+
+    int (*tgdb_client_interrupt) (void *ctx);
+
     char *(*tgdb_client_return_command) (void *ctx, enum tgdb_command_type c);
 
     char *(*tgdb_client_modify_breakpoint) (void *ctx,
@@ -73,6 +95,8 @@ static struct tgdb_client_debugger_interfaces {
 
     const char *(*tgdb_client_get_tty_name) (void *ctx);
 
+    int (*tgdb_client_pipeline_command) (void *ctx, struct tgdb_command * com);
+
 } tgdb_client_debugger_interfaces[] = {
     {
         TGDB_CLIENT_DEBUGGER_GNU_GDB, TGDB_CLIENT_PROTOCOL_GNU_GDB_ANNOTATE_TWO,
@@ -104,6 +128,24 @@ static struct tgdb_client_debugger_interfaces {
                 a2_get_inferior_sources,
                 /* tgdb_client_completion_callback */
                 a2_completion_callback,
+                /* tgdb_client_disassemble */
+                a2_disassemble,
+                /* tgdb_client_variable, annotate-two has no variable objects */
+                NULL,
+                /* tgdb_client_read_memory, nor a way to read memory whole */
+                NULL,
+                /* tgdb_client_list_frames, nor a window of frames */
+                NULL,
+                /* tgdb_client_select_frame */
+                NULL,
+                /* tgdb_client_select_thread, nor a list of the threads */
+                NULL,
+                /* tgdb_client_sample */
+                NULL,
+                /* tgdb_client_non_stop */
+                NULL,
+                /* tgdb_client_interrupt */
+                NULL,
                 /* tgdb_client_return_command */
                 a2_return_client_command,
                 /* tgdb_client_modify_breakpoint */
@@ -113,7 +155,9 @@ static struct tgdb_client_debugger_interfaces {
                 /* tgdb_client_open_new_tty */
                 a2_open_new_tty,
                 /* tgdb_client_get_tty_name */
-    a2_get_tty_name}, {
+                a2_get_tty_name,
+                /* tgdb_client_pipeline_command */
+    a2_pipeline_command}, {
         TGDB_CLIENT_DEBUGGER_GNU_GDB, TGDB_CLIENT_PROTOCOL_GNU_GDB_GDBMI,
                 /* tgdb_client_create_context */
                 gdbmi_create_context,
@@ -122,7 +166,7 @@ static struct tgdb_client_debugger_interfaces {
                 /* tgdb_client_destroy_context */
                 gdbmi_shutdown,
                 /* tgdb_client_err_msg */
-                NULL,
+                gdbmi_err_msg,
                 /* tgdb_client_is_client_ready */
                 gdbmi_is_client_ready,
                 /* tgdb_client_tgdb_ran_command */
@@ -130,29 +174,49 @@ static struct tgdb_client_debugger_interfaces {
                 /* tgdb_client_prepare_for_command */
                 gdbmi_prepare_for_command,
                 /* tgdb_client_can_tgdb_run_commands */
-                NULL,
+                gdbmi_is_misc_prompt,
                 /* tgdb_client_parse_io */
                 gdbmi_parse_io,
                 /* tgdb_client_get_client_commands */
                 gdbmi_get_client_commands,
                 /* tgdb_client_get_filename_pair */
-                NULL,
+                gdbmi_get_source_filename_pair,
                 /* tgdb_client_get_current_location */
-                NULL,
+                gdbmi_get_current_location,
                 /* tgdb_client_get_inferior_source_files */
-                NULL,
+                gdbmi_get_inferior_sources,
                 /* tgdb_client_completion_callback */
-                NULL,
+                gdbmi_completion_callback,
+                /* tgdb_client_disassemble */
+                gdbmi_disassemble,
+                /* tgdb_client_variable */
+                gdbmi_variable,
+                /* tgdb_client_read_memory */
+                gdbmi_read_memory,
+                /* tgdb_client_list_frames */
+                gdbmi_list_frames,
+                /* tgdb_client_select_frame */
+                gdbmi_select_frame,
+                /* tgdb_client_select_thread */
+                gdbmi_select_thread,
+                /* tgdb_client_sample */
+                gdbmi_sample,
+                /* tgdb_client_non_stop */
+                gdbmi_non_stop,
+                /* tgdb_client_interrupt */
+                gdbmi_interrupt,
                 /* tgdb_client_return_command */
-                NULL,
+                gdbmi_return_client_command,
                 /* tgdb_client_modify_breakpoint */
-                NULL,
+                gdbmi_client_modify_breakpoint,
                 /* tgdb_client_get_debugger_pid */
                 gdbmi_get_debugger_pid,
                 /* tgdb_client_open_new_tty */
-                NULL,
+                gdbmi_open_new_tty,
                 /* tgdb_client_get_tty_name */
-    NULL}, {
+                gdbmi_get_tty_name,
+                /* tgdb_client_pipeline_command */
+    gdbmi_pipeline_command}, {
         TGDB_CLIENT_DEBUGGER_UNSUPPORTED, TGDB_CLIENT_PROTOCOL_UNSUPPORTED,
                 /* tgdb_client_create_context */
                 NULL,
@@ -180,6 +244,24 @@ static struct tgdb_client_debugger_interfaces {
                 NULL,
                 /* tgdb_client_completion_callback */
                 NULL,
+                /* tgdb_client_disassemble */
+                NULL,
+                /* tgdb_client_variable */
+                NULL,
+                /* tgdb_client_read_memory */
+                NULL,
+                /* tgdb_client_list_frames */
+                NULL,
+                /* tgdb_client_select_frame */
+                NULL,
+                /* tgdb_client_select_thread */
+                NULL,
+                /* tgdb_client_sample */
+                NULL,
+                /* tgdb_client_non_stop */
+                NULL,
+                /* tgdb_client_interrupt */
+                NULL,
                 /* tgdb_client_return_command */
                 NULL,
                 /* tgdb_client_modify_breakpoint */
@@ -189,6 +271,8 @@ static struct tgdb_client_debugger_interfaces {
                 /* tgdb_client_open_new_tty */
                 NULL,
                 /* tgdb_client_get_tty_name */
+                NULL,
+                /* tgdb_client_pipeline_command */
     NULL}
 };
 
@@ -225,7 +309,8 @@ struct tgdb_client_context {
 struct tgdb_client_context *tgdb_client_create_context(const char
         *debugger_path, int argc, char **argv, const char *config_dir,
         enum tgdb_client_supported_debuggers debugger,
-        enum tgdb_client_supported_protocols protocol, struct logger *logger)
+        enum tgdb_client_supported_protocols protocol,
+        struct std_arena *arena, struct logger *logger)
 {
 
     struct tgdb_client_context *tcc = NULL;
@@ -250,7 +335,7 @@ struct tgdb_client_context *tgdb_client_create_context(const char
         tcc->tgdb_debugger_context =
                 tcc->tgdb_client_interface->
                 tgdb_client_create_context(debugger_path, argc, argv,
-                config_dir, logger);
+                config_dir, arena, logger);
 
         if (tcc->tgdb_debugger_context == NULL) {
             logger_write_pos(tcc->logger, __FILE__, __LINE__,
@@ -381,7 +466,7 @@ struct tgdb_list *tgdb_client_get_client_commands(struct tgdb_client_context
 }
 
 int tgdb_client_get_filename_pair(struct tgdb_client_context *tcc,
-        const char *path)
+        const char *path, struct tgdb_list *list)
 {
     if (tcc == NULL || tcc->tgdb_client_interface == NULL) {
         logger_write_pos(logger, __FILE__, __LINE__,
@@ -390,7 +475,7 @@ int tgdb_client_get_filename_pair(struct tgdb_client_context *tcc,
     }
 
     return tcc->tgdb_client_interface->tgdb_client_get_filename_pair(tcc->
-            tgdb_debugger_context, path);
+            tgdb_debugger_context, path, list);
 }
 
 int tgdb_client_get_current_location(struct tgdb_client_context *tcc,
@@ -431,6 +516,124 @@ int tgdb_client_completion_callback(struct tgdb_client_context *tcc,
             tgdb_debugger_context, completion_command);
 }
 
+int tgdb_client_disassemble(struct tgdb_client_context *tcc,
+        const char *address)
+{
+    if (tcc == NULL || tcc->tgdb_client_interface == NULL) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_client_disassemble unimplemented");
+        return -1;
+    }
+
+    return tcc->tgdb_client_interface->tgdb_client_disassemble(tcc->
+            tgdb_debugger_context, address);
+}
+
+int tgdb_client_variable(struct tgdb_client_context *tcc,
+        enum tgdb_variable_command command, const char *name)
+{
+    if (tcc == NULL || tcc->tgdb_client_interface == NULL ||
+            tcc->tgdb_client_interface->tgdb_client_variable == NULL) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_client_variable unimplemented");
+        return -1;
+    }
+
+    return tcc->tgdb_client_interface->tgdb_client_variable(tcc->
+            tgdb_debugger_context, command, name);
+}
+
+int tgdb_client_read_memory(struct tgdb_client_context *tcc,
+        const char *address, int length)
+{
+    if (tcc == NULL || tcc->tgdb_client_interface == NULL ||
+            tcc->tgdb_client_interface->tgdb_client_read_memory == NULL) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_client_read_memory unimplemented");
+        return -1;
+    }
+
+    return tcc->tgdb_client_interface->tgdb_client_read_memory(tcc->
+            tgdb_debugger_context, address, length);
+}
+
+int tgdb_client_list_frames(struct tgdb_client_context *tcc, int thread,
+        int low, int high)
+{
+    if (tcc == NULL || tcc->tgdb_client_interface == NULL ||
+            tcc->tgdb_client_interface->tgdb_client_list_frames == NULL) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_client_list_frames unimplemented");
+        return -1;
+    }
+
+    return tcc->tgdb_client_interface->tgdb_client_list_frames(tcc->
+            tgdb_debugger_context, thread, low, high);
+}
+
+int tgdb_client_select_frame(struct tgdb_client_context *tcc, int level)
+{
+    if (tcc == NULL || tcc->tgdb_client_interface == NULL ||
+            tcc->tgdb_client_interface->tgdb_client_select_frame == NULL) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_client_select_frame unimplemented");
+        return -1;
+    }
+
+    return tcc->tgdb_client_interface->tgdb_client_select_frame(tcc->
+            tgdb_debugger_context, level);
+}
+
+int tgdb_client_select_thread(struct tgdb_client_context *tcc, int id)
+{
+    if (tcc == NULL || tcc->tgdb_client_interface == NULL ||
+            tcc->tgdb_client_interface->tgdb_client_select_thread == NULL) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_client_select_thread unimplemented");
+        return -1;
+    }
+
+    return tcc->tgdb_client_interface->tgdb_client_select_thread(tcc->
+            tgdb_debugger_context, id);
+}
+
+int tgdb_client_sample(struct tgdb_client_context *tcc, int depth)
+{
+    if (tcc == NULL || tcc->tgdb_client_interface == NULL ||
+            tcc->tgdb_client_interface->tgdb_client_sample == NULL) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_client_sample unimplemented");
+        return -1;
+    }
+
+    return tcc->tgdb_client_interface->tgdb_client_sample(tcc->
+            tgdb_debugger_context, depth);
+}
+
+int tgdb_client_non_stop(struct tgdb_client_context *tcc, int on)
+{
+    if (tcc == NULL || tcc->tgdb_client_interface == NULL ||
+            tcc->tgdb_client_interface->tgdb_client_non_stop == NULL) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_client_non_stop unimplemented");
+        return -1;
+    }
+
+    return tcc->tgdb_client_interface->tgdb_client_non_stop(tcc->
+            tgdb_debugger_context, on);
+}
+
+int tgdb_client_interrupt(struct tgdb_client_context *tcc)
+{
+    /* The debugger gets the interrupt character, as it always did */
+    if (tcc == NULL || tcc->tgdb_client_interface == NULL ||
+            tcc->tgdb_client_interface->tgdb_client_interrupt == NULL)
+        return -1;
+
+    return tcc->tgdb_client_interface->tgdb_client_interrupt(tcc->
+            tgdb_debugger_context);
+}
+
 char *tgdb_client_return_command(struct tgdb_client_context *tcc,
         enum tgdb_command_type c)
 {
@@ -495,3 +698,20 @@ const char *tgdb_client_get_tty_name(struct tgdb_client_context *tcc)
     return tcc->tgdb_client_interface->tgdb_client_get_tty_name(tcc->
             tgdb_debugger_context);
 }
+
+int tgdb_client_pipeline_command(struct tgdb_client_context *tcc,
+        struct tgdb_command *com)
+{
+    if (tcc == NULL || tcc->tgdb_client_interface == NULL) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "tgdb_client_pipeline_command unimplemented");
+        return -1;
+    }
+
+    /* Each command waits for the one before it */
+    if (tcc->tgdb_client_interface->tgdb_client_pipeline_command == NULL)
+        return 0;
+
+    return tcc->tgdb_client_interface->tgdb_client_pipeline_command(tcc->
+            tgdb_debugger_context, com);
+}
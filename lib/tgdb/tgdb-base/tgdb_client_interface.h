@@ -11,6 +11,7 @@
 
 #include "tgdb_command.h"
 #include "logger.h"
+#include "std_arena.h"
 
 /*!
  * \file
@@ -142,6 +143,9 @@ enum tgdb_client_supported_protocols {
  * \param protocol
  * This is the protocol the user wishes to use with the particular debugger.
  *
+ * \param arena
+ * The arena the responses the client makes are allocated in.
+ *
  * \param logger
  * The data structure to report errors to.
  *
@@ -151,7 +155,8 @@ enum tgdb_client_supported_protocols {
 struct tgdb_client_context *tgdb_client_create_context(const char
         *debugger_path, int argc, char **argv, const char *config_dir,
         enum tgdb_client_supported_debuggers debugger,
-        enum tgdb_client_supported_protocols protocol, struct logger *logger);
+        enum tgdb_client_supported_protocols protocol,
+        struct std_arena *arena, struct logger *logger);
 
 /** 
  * This will initialize a client context.
@@ -267,6 +272,24 @@ int tgdb_client_tgdb_ran_command(struct tgdb_client_context *tcc);
 int tgdb_client_prepare_for_command(struct tgdb_client_context *tcc,
         struct tgdb_command *com);
 
+/**
+ * This is called by TGDB before it writes a command to the debugger while
+ * another command is still running. The client decides if the command can
+ * go now, and then it prepares for it itself when its output begins.
+ *
+ * \param tcc
+ * The client context.
+ *
+ * \param com
+ * The command to be run. It belongs to the client if it's taken.
+ *
+ * @return
+ * 1 if the command was taken, 0 if it has to wait for the running
+ * command to finish, -1 on error.
+ */
+int tgdb_client_pipeline_command(struct tgdb_client_context *tcc,
+        struct tgdb_command *com);
+
 /** 
  * Determines if the client is capable of accepting TGDB commands. The client
  * may not be willing to allow TGDB to run its internal commands if the 
@@ -292,6 +315,13 @@ int tgdb_client_can_tgdb_run_commands(struct tgdb_client_context *tcc);
 
 /*@{*/
 
+/**
+ * The most output a client context can hold back from one call of
+ * tgdb_client_parse_io, and give with the next. A newline and a ^Z might
+ * start an annotation, so the annotation parser waits to see.
+ */
+#define TGDB_CLIENT_HELD_OUTPUT 2
+
  /** 
   * This recieves all of the output from the debugger. It is all routed 
   * through this function. 
@@ -308,7 +338,9 @@ int tgdb_client_can_tgdb_run_commands(struct tgdb_client_context *tcc);
   *
   * \param debugger_output
   * Contains data that has been determined to be the output of the 
-  * debugger that the user should see.
+  * debugger that the user should see. It's owned by the caller, and must
+  * have room for input_data_size + TGDB_CLIENT_HELD_OUTPUT bytes and a
+  * null terminator.
   *
   * \param debugger_output_size
   * This is the size of debugger_output
@@ -372,11 +404,15 @@ struct tgdb_list *tgdb_client_get_client_commands(struct tgdb_client_context
  * \param path
  * The path that the debugger outputted. (relative or absolute)
  *
+ * \param list
+ * If the client already knows the pair, it appends the TGDB_FILENAME_PAIR
+ * response here instead of asking the debugger.
+ *
  * @return
  * 0 on success, otherwise -1 on error.
  */
 int tgdb_client_get_filename_pair(struct tgdb_client_context *tcc,
-        const char *path);
+        const char *path, struct tgdb_list *list);
 
 /**
  * Get's the current fullname, filename and line number that the debugger is 
@@ -423,6 +459,163 @@ int tgdb_client_get_inferior_source_files(struct tgdb_client_context *tcc);
 int tgdb_client_completion_callback(struct tgdb_client_context *tcc,
         const char *completion_command);
 
+/** 
+ * TGDB calls this function when the front end asks for the instructions of
+ * a function.
+ *
+ * \param tcc
+ * The client context.
+ *
+ * \param address
+ * An address in the function, or NULL for the one the debugger is at.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error.
+ */
+int tgdb_client_disassemble(struct tgdb_client_context *tcc,
+        const char *address);
+
+/** 
+ * TGDB calls this function when the front end asks for something to be
+ * done with the variable objects of the debugger.
+ *
+ * \param tcc
+ * The client context.
+ *
+ * \param command
+ * What to do.
+ *
+ * \param name
+ * The expression or the variable object it's done to, or NULL.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error, or if the client has no variable
+ * objects.
+ */
+int tgdb_client_variable(struct tgdb_client_context *tcc,
+        enum tgdb_variable_command command, const char *name);
+
+/** 
+ * TGDB calls this function when the front end asks for bytes of the
+ * memory of the program.
+ *
+ * \param tcc
+ * The client context.
+ *
+ * \param address
+ * An expression for the address of the first byte.
+ *
+ * \param length
+ * How many bytes to read.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error, or if the client can't read memory.
+ */
+int tgdb_client_read_memory(struct tgdb_client_context *tcc,
+        const char *address, int length);
+
+/** 
+ * TGDB calls this function when the front end asks for a window of the
+ * frames of the stack.
+ *
+ * \param tcc
+ * The client context.
+ *
+ * \param thread
+ * The global number of the thread, 0 for the one the debugger looks at.
+ *
+ * \param low
+ * The level of the first frame, 0 is the innermost one.
+ *
+ * \param high
+ * The level of the last frame.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error, or if the client can't list them.
+ */
+int tgdb_client_list_frames(struct tgdb_client_context *tcc, int thread,
+        int low, int high);
+
+/** 
+ * TGDB calls this function when the front end makes the debugger look at
+ * another frame. The debugger doesn't tell where the frame is, the front
+ * end knows it from the frames it listed.
+ *
+ * \param tcc
+ * The client context.
+ *
+ * \param level
+ * The level of the frame.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error, or if the client can't select one.
+ */
+int tgdb_client_select_frame(struct tgdb_client_context *tcc, int level);
+
+/** 
+ * TGDB calls this function when the front end makes the debugger look at
+ * another thread. The debugger looks at its innermost frame, the front end
+ * lists the thread's frames to know where it is.
+ *
+ * \param tcc
+ * The client context.
+ *
+ * \param id
+ * The global number of the thread.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error, or if the client can't select one.
+ */
+int tgdb_client_select_thread(struct tgdb_client_context *tcc, int id);
+
+/** 
+ * TGDB calls this function before it interrupts the running program to
+ * take a sample of where it is. When the program stops, the client lists
+ * its innermost frames and continues it, without telling the front end
+ * that it stopped.
+ *
+ * \param tcc
+ * The client context.
+ *
+ * \param depth
+ * How many frames to list, innermost first.
+ *
+ * @return
+ * 0 on success, otherwise -1 if the program isn't running, a sample is
+ * being taken already, or the client can't take one.
+ */
+int tgdb_client_sample(struct tgdb_client_context *tcc, int depth);
+
+/** 
+ * TGDB calls this function to turn the debugger's non-stop mode on or off.
+ * In non-stop mode, a thread that stops doesn't stop the others, and the
+ * debugger takes commands while they run; the client is ready for the next
+ * command at each prompt.
+ *
+ * \param tcc
+ * The client context.
+ *
+ * \param on
+ * 1 to turn it on, 0 to turn it off.
+ *
+ * @return
+ * 0 on success, otherwise -1 on error, or if the client has no such mode.
+ */
+int tgdb_client_non_stop(struct tgdb_client_context *tcc, int on);
+
+/** 
+ * TGDB calls this function when the user interrupts the program, before it
+ * sends the debugger the interrupt character.
+ *
+ * \param tcc
+ * The client context.
+ *
+ * @return
+ * 0 if the client queued a command that interrupts the program instead,
+ * otherwise -1, and the debugger gets the interrupt character.
+ */
+int tgdb_client_interrupt(struct tgdb_client_context *tcc);
+
 /** 
  * This returns the command to send to gdb for the enum C.
  * It will return NULL on error, otherwise correct string on output.
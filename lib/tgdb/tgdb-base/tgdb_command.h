@@ -68,6 +68,12 @@ struct tgdb_command {
 
     /** Private data the client context can use. */
     void *tgdb_client_private_data;
+
+    /**
+	 * 1 if the command can be dropped when the same command is 
+	 * already waiting in the queue, 0 otherwise.
+	 */
+    int coalesce;
 };
 
 /**
@@ -0,0 +1,496 @@
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
+#if HAVE_SIGNAL_H
+#include <signal.h>
+#endif /* HAVE_SIGNAL_H */
+
+#if HAVE_SYS_SELECT_H
+#include <sys/select.h>
+#endif /* HAVE_SYS_SELECT_H */
+
+#if HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif /* HAVE_SYS_WAIT_H */
+
+#if HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif /* HAVE_SYS_SOCKET_H */
+
+#include "tgdb.h"
+#include "tgdb_remote.h"
+#include "tgdb_wire.h"
+#include "ibuf.h"
+#include "io.h"
+#include "sys_util.h"
+#include "logger.h"
+
+/** The most read from gdb, the program or the front end at once */
+#define TGDB_SERVE_MAXBUF 65536
+
+struct tgdb_remote {
+    /** The command that connects to the headless tgdb */
+    pid_t pid;
+
+    /** The connection */
+    int fd;
+    struct tgdb_wire *wire;
+
+    /** The number of requests passed on */
+    int sent;
+
+    /** 1 until the headless tgdb says it can take a request */
+    int busy;
+
+    /** The name of the program's terminal */
+    char *tty_name;
+
+    /**
+     * The program's output, that the front end didn't read yet. A byte is
+     * written to wake[1] when it stops being empty, so the front end has
+     * something to select on.  */
+    struct ibuf *inferior;
+    unsigned long inferior_pos;
+    int wake[2];
+};
+
+/* The front end's end {{{ */
+
+struct tgdb_remote *tgdb_remote_create(const char *command)
+{
+#if HAVE_SYS_SOCKET_H
+    struct tgdb_remote *remote;
+    int sv[2], null_fd;
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__, "socketpair failed");
+        return NULL;
+    }
+
+    remote = (struct tgdb_remote *)
+            cgdb_calloc(1, sizeof (struct tgdb_remote));
+    remote->fd = sv[0];
+    remote->busy = 1;
+    remote->inferior = ibuf_init();
+
+    if (pipe(remote->wake) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__, "pipe failed");
+        close(sv[0]);
+        close(sv[1]);
+        ibuf_free(remote->inferior);
+        free(remote);
+        return NULL;
+    }
+
+    if ((remote->pid = fork()) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__, "fork failed");
+        close(sv[1]);
+        tgdb_remote_destroy(remote);
+        return NULL;
+    }
+
+    if (remote->pid == 0) {
+        /* Away from the terminal, so ^c only gets to gdb through tgdb */
+        setsid();
+
+        dup2(sv[1], STDIN_FILENO);
+        dup2(sv[1], STDOUT_FILENO);
+        if ((null_fd = open("/dev/null", O_WRONLY)) != -1)
+            dup2(null_fd, STDERR_FILENO);
+
+        close(sv[0]);
+        close(sv[1]);
+
+        execl("/bin/sh", "sh", "-c", command, (char *) NULL);
+        _exit(127);
+    }
+
+    close(sv[1]);
+
+    /* The command exiting shows up as an EOF */
+    signal(SIGPIPE, SIG_IGN);
+
+    remote->wire = tgdb_wire_create();
+
+    return remote;
+#else
+    logger_write_pos(logger, __FILE__, __LINE__,
+            "remote debugging isn't supported on this system");
+    return NULL;
+#endif /* HAVE_SYS_SOCKET_H */
+}
+
+void tgdb_remote_destroy(struct tgdb_remote *remote)
+{
+    if (!remote)
+        return;
+
+    if (remote->fd != -1)
+        close(remote->fd);
+
+    if (remote->pid > 0) {
+        kill(remote->pid, SIGTERM);
+        waitpid(remote->pid, NULL, 0);
+    }
+
+    close(remote->wake[0]);
+    close(remote->wake[1]);
+
+    tgdb_wire_destroy(remote->wire);
+    ibuf_free(remote->inferior);
+    free(remote->tty_name);
+    free(remote);
+}
+
+int tgdb_remote_fd(struct tgdb_remote *remote)
+{
+    return remote->fd;
+}
+
+int tgdb_remote_is_busy(struct tgdb_remote *remote)
+{
+    return remote->busy;
+}
+
+int tgdb_remote_send_request(struct tgdb_remote *remote,
+        tgdb_request_ptr request)
+{
+    tgdb_wire_put_request(remote->wire, request);
+    remote->sent++;
+    remote->busy = 1;
+
+    return tgdb_wire_flush(remote->wire, remote->fd);
+}
+
+ssize_t tgdb_remote_process(struct tgdb_remote *remote,
+        struct std_arena *arena, struct tgdb_list *list, char *buf, size_t n,
+        int *closed)
+{
+    struct tgdb_wire_message message;
+    size_t size = 0;
+    ssize_t ret;
+    int result;
+
+    *closed = 0;
+
+    /* The output is never more than what's read now, and a message that
+     * was cut short the last time */
+    if (n <= TGDB_WIRE_CONSOLE_MAX + TGDB_WIRE_HEADER_MAX) {
+        logger_write_pos(logger, __FILE__, __LINE__, "buf is too small");
+        return -1;
+    }
+    n -= TGDB_WIRE_CONSOLE_MAX + TGDB_WIRE_HEADER_MAX;
+
+    ret = tgdb_wire_read(remote->wire, remote->fd, n);
+    if (ret == -1 && errno == EAGAIN)
+        return -1;
+    else if (ret <= 0)
+        *closed = 1;
+
+    while ((result = tgdb_wire_next(remote->wire, arena, list,
+                            &message)) == 1) {
+        switch (message.type) {
+            case TGDB_WIRE_CONSOLE:
+                memcpy(buf + size, message.data, message.size);
+                size += message.size;
+                break;
+            case TGDB_WIRE_INFERIOR:
+                if (ibuf_length(remote->inferior) == 0 &&
+                        io_write_byte(remote->wake[1], 'x') == -1)
+                    logger_write_pos(logger, __FILE__, __LINE__,
+                            "io_write_byte failed");
+                ibuf_addn(remote->inferior, message.data, message.size);
+                break;
+            case TGDB_WIRE_STATE:
+                /* It hasn't seen the last request yet if the count is off */
+                remote->busy = (message.value & 1) ||
+                        (message.value >> 1) != remote->sent;
+                break;
+            case TGDB_WIRE_TTY:
+                free(remote->tty_name);
+                remote->tty_name = message.data ?
+                        cgdb_strdup(message.data) : NULL;
+                break;
+            default:
+                /* The responses are in the list already */
+                break;
+        }
+    }
+
+    if (result == -1)
+        *closed = 1;
+
+    buf[size] = '\0';
+
+    return size;
+}
+
+int tgdb_remote_send_inferior_data(struct tgdb_remote *remote,
+        const char *buf, size_t n)
+{
+    tgdb_wire_put_inferior(remote->wire, buf, n);
+
+    return 0;
+}
+
+int tgdb_remote_flush_inferior_data(struct tgdb_remote *remote)
+{
+    return tgdb_wire_flush(remote->wire, remote->fd);
+}
+
+ssize_t tgdb_remote_recv_inferior_data(struct tgdb_remote *remote,
+        char *buf, size_t n)
+{
+    unsigned long left = ibuf_length(remote->inferior) -
+            remote->inferior_pos;
+    char c;
+
+    if (left == 0) {
+        errno = EAGAIN;
+        return -1;
+    }
+
+    if (n > left)
+        n = left;
+
+    memcpy(buf, ibuf_get(remote->inferior) + remote->inferior_pos, n);
+    buf[n] = '\0';
+    remote->inferior_pos += n;
+
+    if (remote->inferior_pos == ibuf_length(remote->inferior)) {
+        ibuf_clear(remote->inferior);
+        remote->inferior_pos = 0;
+
+        if (io_read_byte(&c, remote->wake[0]) == -1)
+            logger_write_pos(logger, __FILE__, __LINE__,
+                    "io_read_byte failed");
+    }
+
+    return n;
+}
+
+int tgdb_remote_get_inferior_fd(struct tgdb_remote *remote)
+{
+    return remote->wake[0];
+}
+
+int tgdb_remote_tty_new(struct tgdb_remote *remote)
+{
+    tgdb_wire_put_value(remote->wire, TGDB_WIRE_TTY_NEW, 0);
+
+    return tgdb_wire_flush(remote->wire, remote->fd);
+}
+
+const char *tgdb_remote_tty_name(struct tgdb_remote *remote)
+{
+    return remote->tty_name ? remote->tty_name : "";
+}
+
+int tgdb_remote_signal(struct tgdb_remote *remote, int signum)
+{
+    tgdb_wire_put_value(remote->wire, TGDB_WIRE_SIGNAL, signum);
+
+    return tgdb_wire_flush(remote->wire, remote->fd);
+}
+
+int tgdb_remote_set_verbose(struct tgdb_remote *remote, int value)
+{
+    tgdb_wire_put_value(remote->wire, TGDB_WIRE_VERBOSE, value);
+
+    return tgdb_wire_flush(remote->wire, remote->fd);
+}
+
+/* }}} */
+
+/* The headless end {{{ */
+
+/* Adds the responses tgdb made to the messages for the front end */
+static void tgdb_serve_put_responses(struct tgdb *tgdb,
+        struct tgdb_wire *wire, int *quit)
+{
+    struct tgdb_response *response;
+
+    while ((response = tgdb_get_response(tgdb)) != NULL) {
+        tgdb_wire_put_response(wire, response);
+
+        if (response->header == TGDB_QUIT)
+            *quit = 1;
+    }
+}
+
+/* Runs the requests that waited for gdb, until one has to wait for it */
+static void tgdb_serve_run_queued(struct tgdb *tgdb, struct tgdb_wire *wire,
+        int *quit)
+{
+    int size, is_busy = 0;
+
+    tgdb_queue_size(tgdb, &size);
+
+    while (size > 0 && !is_busy) {
+        tgdb_process_command(tgdb, tgdb_queue_pop(tgdb));
+        tgdb_serve_put_responses(tgdb, wire, quit);
+
+        tgdb_is_busy(tgdb, &is_busy);
+        tgdb_queue_size(tgdb, &size);
+    }
+}
+
+/* Handles a message from the front end */
+static void tgdb_serve_message(struct tgdb *tgdb, struct tgdb_wire *wire,
+        struct tgdb_wire_message *message, int *received, int *quit)
+{
+    int is_busy;
+
+    switch (message->type) {
+        case TGDB_WIRE_REQUEST:
+            (*received)++;
+
+            tgdb_is_busy(tgdb, &is_busy);
+            if (is_busy)
+                tgdb_queue_append(tgdb, message->request);
+            else {
+                tgdb_process_command(tgdb, message->request);
+                tgdb_serve_put_responses(tgdb, wire, quit);
+            }
+            break;
+        case TGDB_WIRE_INFERIOR:
+            /* Written by the loop in tgdb_serve, with the rest of a paste */
+            tgdb_send_inferior_data(tgdb, message->data, message->size);
+            break;
+        case TGDB_WIRE_SIGNAL:
+            tgdb_signal_notification(tgdb, message->value);
+            break;
+        case TGDB_WIRE_TTY_NEW:
+            if (tgdb_tty_new(tgdb) != -1)
+                tgdb_wire_put_tty(wire, tgdb_tty_name(tgdb));
+            break;
+        case TGDB_WIRE_VERBOSE:
+            tgdb_set_verbose_gui_command_output(tgdb, message->value);
+            break;
+        default:
+            break;
+    }
+}
+
+int tgdb_serve(struct tgdb *tgdb, int debugger_fd, int in, int out)
+{
+    struct tgdb_wire *wire = tgdb_wire_create();
+    struct tgdb_wire_message message;
+    char *buf = (char *) cgdb_malloc(TGDB_SERVE_MAXBUF + 1);
+    int received = 0, state = -1, quit = 0, closed = 0, ret = 0;
+    int inferior_fd, max, is_busy, is_finished, result, pending;
+    fd_set rfds, wfds;
+    ssize_t size;
+
+    /* The front end going away shows up as an EOF */
+    signal(SIGPIPE, SIG_IGN);
+
+    tgdb_wire_put_tty(wire, tgdb_tty_name(tgdb));
+
+    while (!closed) {
+        /* Whether tgdb can take a request, when that changed */
+        tgdb_is_busy(tgdb, &is_busy);
+        if (((received << 1) | is_busy) != state) {
+            state = (received << 1) | is_busy;
+            tgdb_wire_put_value(wire, TGDB_WIRE_STATE, state);
+        }
+
+        if (tgdb_wire_flush(wire, out) == -1 || quit)
+            break;
+
+        inferior_fd = tgdb_get_inferior_fd(tgdb);
+
+        /* What the program didn't take yet waits for it to be writable */
+        pending = inferior_fd != -1 && tgdb_flush_inferior_data(tgdb) == 1;
+        FD_ZERO(&wfds);
+        if (pending)
+            FD_SET(inferior_fd, &wfds);
+
+        FD_ZERO(&rfds);
+        FD_SET(debugger_fd, &rfds);
+        FD_SET(in, &rfds);
+        max = debugger_fd > in ? debugger_fd : in;
+
+        if (inferior_fd != -1) {
+            FD_SET(inferior_fd, &rfds);
+            if (inferior_fd > max)
+                max = inferior_fd;
+        }
+
+        if (select(max + 1, &rfds, pending ? &wfds : NULL, NULL, NULL) == -1) {
+            if (errno == EINTR)
+                continue;
+
+            logger_write_pos(logger, __FILE__, __LINE__, "select failed");
+            ret = -1;
+            break;
+        }
+
+        if (inferior_fd != -1 && FD_ISSET(inferior_fd, &rfds)) {
+            size = tgdb_recv_inferior_data(tgdb, buf, TGDB_SERVE_MAXBUF);
+
+            /* The program closed its terminal, the next run gets a new one */
+            if (size > 0)
+                tgdb_wire_put_inferior(wire, buf, size);
+            else if (size == 0 && tgdb_tty_new(tgdb) != -1)
+                tgdb_wire_put_tty(wire, tgdb_tty_name(tgdb));
+        }
+
+        if (FD_ISSET(debugger_fd, &rfds)) {
+            size = tgdb_process(tgdb, buf, TGDB_SERVE_MAXBUF, &is_finished);
+            if (size == -1) {
+                logger_write_pos(logger, __FILE__, __LINE__,
+                        "tgdb_process failed");
+                ret = -1;
+                break;
+            }
+
+            tgdb_wire_put_console(wire, buf, size);
+            tgdb_serve_put_responses(tgdb, wire, &quit);
+
+            if (is_finished)
+                tgdb_serve_run_queued(tgdb, wire, &quit);
+        }
+
+        if (FD_ISSET(in, &rfds)) {
+            size = tgdb_wire_read(wire, in, TGDB_SERVE_MAXBUF);
+            if (size == 0 || (size == -1 && errno != EAGAIN))
+                closed = 1;
+
+            while ((result = tgdb_wire_next(wire, NULL, NULL,
+                                    &message)) == 1)
+                tgdb_serve_message(tgdb, wire, &message, &received, &quit);
+
+            if (result == -1)
+                closed = 1;
+        }
+    }
+
+    tgdb_wire_destroy(wire);
+    free(buf);
+
+    return ret;
+}
+
+/* }}} */
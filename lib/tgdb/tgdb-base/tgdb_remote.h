@@ -0,0 +1,139 @@
+#ifndef __TGDB_REMOTE_H__
+#define __TGDB_REMOTE_H__
+
+/*!
+ * \file
+ * tgdb_remote.h
+ *
+ * \brief
+ * Runs tgdb on another machine, next to gdb, for a front end on a slow
+ * link.
+ *
+ * A headless tgdb, see tgdb_serve in tgdb.h, talks to gdb and sends the
+ * front end what it made of gdb's output, in the format of tgdb_wire.h.
+ * The front end's tgdb passes its requests on, and gives it the responses
+ * that come back the same way it would if it ran gdb itself.
+ *
+ * The front end reaches the headless tgdb through a command, like
+ * "ssh host cgdb --headless ./program", that it talks to on its stdin and
+ * stdout.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif /* HAVE_SYS_TYPES_H */
+
+#include "tgdb_types.h"
+#include "tgdb_list.h"
+#include "std_arena.h"
+
+/**
+ * The front end's end of the connection.
+ */
+struct tgdb_remote;
+
+/**
+ * Runs the command that connects to the headless tgdb.
+ *
+ * \param command
+ * The command, it's run by the shell.
+ *
+ * @return
+ * The connection, or NULL on error.
+ */
+struct tgdb_remote *tgdb_remote_create(const char *command);
+
+/**
+ * Closes the connection, and waits for the command to exit.
+ *
+ * \param remote
+ * The connection.
+ */
+void tgdb_remote_destroy(struct tgdb_remote *remote);
+
+/**
+ * Gets the fd the front end should select on for the debugger's output.
+ *
+ * \param remote
+ * The connection.
+ *
+ * @return
+ * The fd.
+ */
+int tgdb_remote_fd(struct tgdb_remote *remote);
+
+/**
+ * Determines if the headless tgdb can take a request.
+ *
+ * \param remote
+ * The connection.
+ *
+ * @return
+ * 1 if it's busy, 0 if it can take a request.
+ */
+int tgdb_remote_is_busy(struct tgdb_remote *remote);
+
+/**
+ * Passes a request on.
+ *
+ * \param remote
+ * The connection.
+ *
+ * \param request
+ * The request.
+ *
+ * @return
+ * 0 on success, or -1 on error.
+ */
+int tgdb_remote_send_request(struct tgdb_remote *remote,
+        tgdb_request_ptr request);
+
+/**
+ * Reads what the headless tgdb sent, like tgdb_process.
+ *
+ * \param remote
+ * The connection.
+ *
+ * \param arena
+ * The responses are allocated in this arena.
+ *
+ * \param list
+ * The responses are appended to this list.
+ *
+ * \param buf
+ * The debugger's output for the user is written to this.
+ *
+ * \param n
+ * The size of buf. It's large enough for all the output this reads.
+ *
+ * \param closed
+ * Set to 1 if the connection was closed, 0 otherwise.
+ *
+ * @return
+ * The number of bytes written to buf, or -1 on error, with errno set to
+ * EAGAIN if there was nothing to read.
+ */
+ssize_t tgdb_remote_process(struct tgdb_remote *remote,
+        struct std_arena *arena, struct tgdb_list *list, char *buf, size_t n,
+        int *closed);
+
+/**
+ * These pass on what the front end does with the program being debugged,
+ * see tgdb.h.
+ */
+int tgdb_remote_send_inferior_data(struct tgdb_remote *remote,
+        const char *buf, size_t n);
+int tgdb_remote_flush_inferior_data(struct tgdb_remote *remote);
+ssize_t tgdb_remote_recv_inferior_data(struct tgdb_remote *remote,
+        char *buf, size_t n);
+int tgdb_remote_get_inferior_fd(struct tgdb_remote *remote);
+int tgdb_remote_tty_new(struct tgdb_remote *remote);
+const char *tgdb_remote_tty_name(struct tgdb_remote *remote);
+int tgdb_remote_signal(struct tgdb_remote *remote, int signum);
+int tgdb_remote_set_verbose(struct tgdb_remote *remote, int value);
+
+#endif /* __TGDB_REMOTE_H__ */
@@ -0,0 +1,401 @@
+/*
+ * tgdb_replay: Runs gdb's output from a debug trace through tgdb, at full
+ * speed and without a gdb, and measures what it costs.
+ *
+ * The trace is the one tgdb writes to its config directory, see io_trace.h.
+ * Each read of gdb's output in it is given to tgdb_process_buffer as it was
+ * read, so a run parses the same chunks every time. tgdb is started with
+ * this program standing in for gdb, which throws away what it's sent.
+ *
+ * tgdb's config directory is made in a temporary HOME, so the replay
+ * doesn't write over the trace it reads.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#if HAVE_LIMITS_H
+#include <limits.h>
+#endif /* HAVE_LIMITS_H */
+
+#if HAVE_DIRENT_H
+#include <dirent.h>
+#endif /* HAVE_DIRENT_H */
+
+#include "tgdb.h"
+#include "io_trace.h"
+
+/* Set in the environment of the fake gdb */
+#define REPLAY_SINK "TGDB_REPLAY_SINK"
+
+/* A read of gdb's output, from the trace */
+struct replay_chunk {
+    const char *data;
+    size_t size;
+};
+
+struct replay_trace {
+    char *data;
+    struct replay_chunk *chunks;
+    size_t count;
+    size_t bytes;
+    size_t largest;
+};
+
+/* What replaying the trace cost, over all the iterations */
+struct replay_result {
+    unsigned long chunks;
+    unsigned long bytes;
+    unsigned long responses;
+    unsigned long errors;
+
+    /* tgdb_process_buffer, reading the responses, and releasing them */
+    double parse;
+    double dispatch;
+    double release;
+};
+
+static void usage(char *progname)
+{
+    printf("%s [-m] [-f fd] [-n iterations] <trace>\n", progname);
+    printf("  -m  The trace is of gdb's machine interface, not annotations\n");
+    printf("  -f  Replay what was read from this fd, by default the one\n"
+            "      the most was read from\n");
+    printf("  -n  Replay the trace this many times, 10 by default\n");
+    printf("\nA line of JSON is written with the results.\n");
+    exit(-1);
+}
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static char *read_file(const char *path, size_t *length)
+{
+    FILE *file;
+    char *data = NULL;
+    size_t size = 0, count;
+
+    file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "%s:%d Can't open %s\n", __FILE__, __LINE__, path);
+        return NULL;
+    }
+
+    *length = 0;
+    do {
+        if (*length == size) {
+            size = size ? size * 2 : 65536;
+            data = realloc(data, size);
+            if (!data) {
+                fprintf(stderr, "%s:%d", __FILE__, __LINE__);
+                fclose(file);
+                return NULL;
+            }
+        }
+
+        count = fread(data + *length, 1, size - *length, file);
+        *length += count;
+    } while (count > 0);
+
+    fclose(file);
+
+    return data;
+}
+
+/* Finds the fd most of the trace was read from, gdb's output */
+static int busiest_fd(const char *data, size_t length)
+{
+    struct io_trace_header header;
+    struct {
+        int fd;
+        size_t bytes;
+    } fds[16];
+    size_t at = IO_TRACE_MAGIC_SIZE;
+    int count = 0, best = -1, i;
+
+    while (at + sizeof (header) <= length) {
+        memcpy(&header, data + at, sizeof (header));
+        at += sizeof (header);
+        if (header.type == IO_TRACE_LOST)
+            continue;
+        at += header.length;
+
+        if (header.type != IO_TRACE_READ)
+            continue;
+
+        for (i = 0; i < count && fds[i].fd != header.fd; i++);
+        if (i == count && count < 16) {
+            fds[count].fd = header.fd;
+            fds[count++].bytes = 0;
+        }
+        if (i < count)
+            fds[i].bytes += header.length;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (best == -1 || fds[i].bytes > fds[best].bytes)
+            best = i;
+    }
+
+    return best == -1 ? -1 : fds[best].fd;
+}
+
+/* Loads the reads from fd in the trace at path. If fd is -1, the one most
+ * was read from is used. */
+static int load_trace(const char *path, int fd, struct replay_trace *trace)
+{
+    struct io_trace_header header;
+    size_t length, at, size = 0;
+
+    memset(trace, 0, sizeof (struct replay_trace));
+
+    trace->data = read_file(path, &length);
+    if (!trace->data)
+        return -1;
+
+    if (length < IO_TRACE_MAGIC_SIZE ||
+            memcmp(trace->data, IO_TRACE_MAGIC, IO_TRACE_MAGIC_SIZE) != 0) {
+        fprintf(stderr, "%s is not a debug trace\n", path);
+        return -1;
+    }
+
+    if (fd == -1)
+        fd = busiest_fd(trace->data, length);
+
+    for (at = IO_TRACE_MAGIC_SIZE; at + sizeof (header) <= length;) {
+        memcpy(&header, trace->data + at, sizeof (header));
+        at += sizeof (header);
+
+        if (header.type == IO_TRACE_LOST) {
+            fprintf(stderr, "%s lost %lu bytes, the replay may not parse\n",
+                    path, (unsigned long) header.length);
+            continue;
+        }
+
+        if (at + header.length > length)
+            break;
+
+        if (header.type == IO_TRACE_READ && header.fd == fd &&
+                header.length > 0) {
+            if (trace->count == size) {
+                size = size ? size * 2 : 1024;
+                trace->chunks = realloc(trace->chunks,
+                        size * sizeof (struct replay_chunk));
+                if (!trace->chunks) {
+                    fprintf(stderr, "%s:%d", __FILE__, __LINE__);
+                    return -1;
+                }
+            }
+
+            trace->chunks[trace->count].data = trace->data + at;
+            trace->chunks[trace->count++].size = header.length;
+            trace->bytes += header.length;
+            if (header.length > trace->largest)
+                trace->largest = header.length;
+        }
+
+        at += header.length;
+    }
+
+    if (trace->count == 0) {
+        fprintf(stderr, "%s has nothing read from gdb\n", path);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Replays the trace once */
+static void replay(struct tgdb *tgdb, struct replay_trace *trace,
+        char *buf, size_t n, struct replay_result *result)
+{
+    struct tgdb_response *response;
+    double start, parsed, dispatched;
+    size_t i, size;
+    int is_finished;
+
+    for (i = 0; i < trace->count; i++) {
+        start = now();
+        size = tgdb_process_buffer(tgdb, trace->chunks[i].data,
+                trace->chunks[i].size, buf, n, &is_finished);
+        parsed = now();
+
+        if (size == (size_t) -1)
+            result->errors++;
+
+        while ((response = tgdb_get_response(tgdb)) != NULL)
+            result->responses++;
+        dispatched = now();
+
+        tgdb_delete_responses(tgdb);
+
+        result->parse += parsed - start;
+        result->dispatch += dispatched - parsed;
+        result->release += now() - dispatched;
+    }
+
+    result->chunks += trace->count;
+    result->bytes += trace->bytes;
+}
+
+static void print_result(const char *name, int gdbmi, int iterations,
+        struct replay_result *result)
+{
+    double seconds = result->parse + result->dispatch + result->release;
+
+    if (seconds <= 0)
+        seconds = 1e-9;
+
+    printf("{\"file\": \"%s\", \"protocol\": \"%s\", \"iterations\": %d, "
+            "\"chunks\": %lu, \"bytes\": %lu, \"responses\": %lu, "
+            "\"errors\": %lu, \"seconds\": %.6f, \"mb_per_s\": %.3f, "
+            "\"responses_per_s\": %.0f, \"parse_s\": %.6f, "
+            "\"dispatch_s\": %.6f, \"release_s\": %.6f}\n",
+            name, gdbmi ? "mi" : "annotate-two", iterations,
+            result->chunks, result->bytes, result->responses,
+            result->errors, seconds,
+            result->bytes / seconds / (1024 * 1024),
+            result->responses / seconds,
+            result->parse, result->dispatch, result->release);
+}
+
+/* Stands in for gdb, and throws away what tgdb sends it */
+static int sink(void)
+{
+    char buf[4096];
+
+    while (read(STDIN_FILENO, buf, sizeof (buf)) > 0);
+
+    return 0;
+}
+
+/* Removes the temporary HOME, and what tgdb made in it */
+static void remove_dir(const char *path)
+{
+    char entry_path[PATH_MAX];
+    struct dirent *entry;
+    DIR *dir;
+
+    if ((dir = opendir(path)) != NULL) {
+        while ((entry = readdir(dir)) != NULL) {
+            if (strcmp(entry->d_name, ".") == 0 ||
+                    strcmp(entry->d_name, "..") == 0)
+                continue;
+
+            snprintf(entry_path, sizeof (entry_path), "%s/%s", path,
+                    entry->d_name);
+            if (remove(entry_path) == -1)
+                remove_dir(entry_path);
+        }
+        closedir(dir);
+    }
+
+    remove(path);
+}
+
+int main(int argc, char **argv)
+{
+    struct replay_trace trace;
+    struct replay_result result;
+    struct tgdb *tgdb;
+    char self[PATH_MAX], home[] = "/tmp/tgdb_replay.XXXXXX";
+    char *buf;
+    size_t n;
+    int gdbmi = 0, fd = -1, iterations = 10, debugger_fd, opt, i;
+
+    if (getenv(REPLAY_SINK))
+        return sink();
+
+    while ((opt = getopt(argc, argv, "mf:n:")) != -1) {
+        switch (opt) {
+            case 'm':
+                gdbmi = 1;
+                break;
+            case 'f':
+                fd = atoi(optarg);
+                break;
+            case 'n':
+                iterations = atoi(optarg);
+                if (iterations <= 0)
+                    usage(argv[0]);
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+
+    if (optind + 1 != argc)
+        usage(argv[0]);
+
+    /* Read before tgdb starts a trace of its own */
+    if (load_trace(argv[optind], fd, &trace) == -1)
+        return -1;
+
+    if (!realpath(argv[0], self)) {
+        fprintf(stderr, "%s:%d Can't find %s\n", __FILE__, __LINE__, argv[0]);
+        return -1;
+    }
+
+    if (!mkdtemp(home)) {
+        fprintf(stderr, "%s:%d Can't make %s\n", __FILE__, __LINE__, home);
+        return -1;
+    }
+    setenv("HOME", home, 1);
+    setenv(REPLAY_SINK, "1", 1);
+
+    tgdb = tgdb_initialize(self, 0, NULL, &debugger_fd, gdbmi);
+    if (!tgdb) {
+        fprintf(stderr, "%s:%d tgdb_initialize failed\n", __FILE__, __LINE__);
+        remove_dir(home);
+        return -1;
+    }
+
+    n = trace.largest + 64;
+    buf = malloc(n);
+    if (!buf) {
+        fprintf(stderr, "%s:%d", __FILE__, __LINE__);
+        return -1;
+    }
+
+    memset(&result, 0, sizeof (struct replay_result));
+    for (i = 0; i < iterations; i++)
+        replay(tgdb, &trace, buf, n, &result);
+
+    print_result(argv[optind], gdbmi, iterations, &result);
+
+    tgdb_shutdown(tgdb);
+    remove_dir(home);
+
+    free(buf);
+    free(trace.chunks);
+    free(trace.data);
+
+    return result.errors ? 1 : 0;
+}
@@ -0,0 +1,289 @@
+/*
+ * tgdb_stress: Runs commands in a debugger through tgdb, the way cgdb does,
+ * and measures how long tgdb takes to get through what the debugger prints.
+ *
+ * It's meant to drive fake_gdb, which prints as much as it's asked to. For
+ * each command a line of JSON is written, with the time the command took,
+ * how much it printed, and how fast tgdb got through it.
+ *
+ * When a command makes the program print, like fake_gdb's "inferior N",
+ * tgdb_stress waits for the N bytes. While they come in, it runs the probe
+ * command over and over, and reports how long it took to answer, which is
+ * how long a user's command waits behind the program's output.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#ifdef HAVE_SYS_SELECT_H
+#include <sys/select.h>
+#endif
+
+#include "tgdb.h"
+
+/* How long to wait for a command before giving up on it */
+#define STRESS_TIMEOUT 120
+
+/* How often the probe command is run */
+#define STRESS_PROBE_MS 20
+
+struct stress_result {
+    unsigned long console_bytes;
+    unsigned long inferior_bytes;
+    unsigned long responses;
+
+    /* Since the command was sent */
+    double first_output;
+    double finished;
+    double seconds;
+
+    unsigned long probes;
+    double probe_total;
+    double probe_max;
+};
+
+static char buf[256 * 1024];
+
+static void usage(char *progname)
+{
+    printf("%s [-d debugger] [-p probe] <command> ...\n", progname);
+    printf("  -d  The debugger to run, ./fake_gdb by default\n");
+    printf("  -p  The command to time while the program prints, "
+            "\"next\" by default\n");
+    printf("\nEach command is run in turn, and a line of JSON is written "
+            "for it.\n");
+    exit(-1);
+}
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static int send_command(struct tgdb *tgdb, const char *command)
+{
+    tgdb_request_ptr request;
+
+    request = tgdb_request_run_console_command(tgdb, command);
+    if (!request || tgdb_process_command(tgdb, request) == -1) {
+        fprintf(stderr, "%s:%d Can't run %s\n", __FILE__, __LINE__, command);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Reads what the debugger printed, returns 1 once tgdb is done with it, or
+ * -1 if the debugger is gone */
+static int read_debugger(struct tgdb *tgdb, struct stress_result *result)
+{
+    struct tgdb_response *response;
+    size_t size;
+    int is_finished = 0;
+
+    size = tgdb_process(tgdb, buf, sizeof (buf), &is_finished);
+    if (size == (size_t) -1)
+        return -1;
+
+    result->console_bytes += size;
+
+    while ((response = tgdb_get_response(tgdb)) != NULL) {
+        result->responses++;
+        if (response->header == TGDB_QUIT)
+            return -1;
+    }
+
+    return is_finished;
+}
+
+/* Runs command, or waits for the debugger to start if it's NULL, until
+ * tgdb is done with it and the program printed inferior_bytes bytes */
+static int stress(struct tgdb *tgdb, int gdb_fd, const char *command,
+        unsigned long inferior_bytes, const char *probe,
+        struct stress_result *result)
+{
+    double start = now(), probe_start = 0, probe_last = 0, t;
+    int done = 0, probing = 0, inferior_fd, max, ret;
+    struct timeval timeout;
+    fd_set rfds;
+    ssize_t n;
+
+    memset(result, 0, sizeof (struct stress_result));
+    if (command && send_command(tgdb, command) == -1)
+        return -1;
+
+    while (!done || probing || result->inferior_bytes < inferior_bytes) {
+        t = now();
+        if (t - start > STRESS_TIMEOUT) {
+            fprintf(stderr, "%s:%d %s timed out\n", __FILE__, __LINE__,
+                    command ? command : "startup");
+            return -1;
+        }
+
+        /* The user runs a command while the program prints */
+        if (done && !probing && result->inferior_bytes < inferior_bytes &&
+                (t - probe_last) * 1000 >= STRESS_PROBE_MS) {
+            if (send_command(tgdb, probe) == -1)
+                return -1;
+            probing = 1;
+            probe_start = t;
+        }
+
+        inferior_fd = tgdb_get_inferior_fd(tgdb);
+        max = gdb_fd > inferior_fd ? gdb_fd : inferior_fd;
+
+        FD_ZERO(&rfds);
+        FD_SET(gdb_fd, &rfds);
+        if (inferior_fd != -1)
+            FD_SET(inferior_fd, &rfds);
+
+        timeout.tv_sec = 0;
+        timeout.tv_usec = STRESS_PROBE_MS * 1000;
+
+        ret = select(max + 1, &rfds, NULL, NULL, &timeout);
+        if (ret == -1 && errno == EINTR)
+            continue;
+        else if (ret == -1) {
+            fprintf(stderr, "%s:%d select failed\n", __FILE__, __LINE__);
+            return -1;
+        }
+
+        if (inferior_fd != -1 && FD_ISSET(inferior_fd, &rfds)) {
+            n = tgdb_recv_inferior_data(tgdb, buf, sizeof (buf) - 1);
+            if (n > 0)
+                result->inferior_bytes += n;
+        }
+
+        if (FD_ISSET(gdb_fd, &rfds)) {
+            unsigned long before = result->console_bytes;
+
+            ret = read_debugger(tgdb, result);
+            if (ret == -1) {
+                fprintf(stderr, "%s:%d The debugger went away\n",
+                        __FILE__, __LINE__);
+                return -1;
+            }
+
+            t = now();
+            if (!done && before == 0 && result->console_bytes > 0)
+                result->first_output = t - start;
+
+            if (ret == 1 && probing) {
+                probing = 0;
+                probe_last = t;
+                result->probes++;
+                result->probe_total += t - probe_start;
+                if (t - probe_start > result->probe_max)
+                    result->probe_max = t - probe_start;
+            } else if (ret == 1 && !done) {
+                done = 1;
+                result->finished = t - start;
+                probe_last = t;
+            }
+        }
+    }
+
+    result->seconds = now() - start;
+
+    return 0;
+}
+
+static void print_result(const char *command, struct stress_result *result)
+{
+    double seconds = result->seconds > 0 ? result->seconds : 1e-9;
+    unsigned long bytes = result->console_bytes + result->inferior_bytes;
+
+    printf("{\"command\": \"%s\", \"seconds\": %.6f, "
+            "\"finished_s\": %.6f, \"first_output_s\": %.6f, "
+            "\"console_bytes\": %lu, \"inferior_bytes\": %lu, "
+            "\"responses\": %lu, \"mb_per_s\": %.3f, "
+            "\"probes\": %lu, \"probe_avg_ms\": %.3f, "
+            "\"probe_max_ms\": %.3f}\n",
+            command, result->seconds, result->finished,
+            result->first_output, result->console_bytes,
+            result->inferior_bytes, result->responses,
+            bytes / seconds / (1024 * 1024), result->probes,
+            result->probes ? result->probe_total / result->probes * 1000 : 0,
+            result->probe_max * 1000);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    const char *debugger = "./fake_gdb", *probe = "next";
+    struct stress_result result;
+    unsigned long inferior_bytes;
+    struct tgdb *tgdb;
+    int gdb_fd, opt, i, ret = 0;
+
+    while ((opt = getopt(argc, argv, "d:p:")) != -1) {
+        switch (opt) {
+            case 'd':
+                debugger = optarg;
+                break;
+            case 'p':
+                probe = optarg;
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+
+    if (optind == argc)
+        usage(argv[0]);
+
+    tgdb = tgdb_initialize(debugger, 0, NULL, &gdb_fd, 0);
+    if (!tgdb) {
+        fprintf(stderr, "%s:%d tgdb_initialize failed\n", __FILE__, __LINE__);
+        return -1;
+    }
+
+    if (stress(tgdb, gdb_fd, NULL, 0, probe, &result) == -1)
+        return -1;
+    print_result("startup", &result);
+
+    for (i = optind; i < argc; i++) {
+        inferior_bytes = 0;
+        sscanf(argv[i], "inferior %lu", &inferior_bytes);
+
+        if (stress(tgdb, gdb_fd, argv[i], inferior_bytes, probe,
+                        &result) == -1) {
+            ret = -1;
+            break;
+        }
+        print_result(argv[i], &result);
+    }
+
+    tgdb_shutdown(tgdb);
+
+    return ret;
+}
@@ -25,6 +25,7 @@
 #include "ibuf.h"
 #include "tgdb_list.h"
 #include "queue.h"
+#include "std_arena.h"
 
 static int tgdb_types_print_item(void *command)
 {
@@ -55,9 +56,9 @@ static int tgdb_types_print_item(void *command)
                     logger_write_pos(logger, __FILE__, __LINE__,
                             "breakpoint is NULL");
 
-                fprintf(fd,
-                        "\tFILE(%s) FUNCNAME(%s) LINE(%d) ENABLED(%d)\n",
-                        tb->file, tb->funcname, tb->line, tb->enabled);
+                fprintf(fd, "\tNUMBER(%d) FILE(%s) FUNCNAME(%s) LINE(%d) "
+                        "ENABLED(%d) HITS(%d)\n", tb->number, tb->file,
+                        tb->funcname, tb->line, tb->enabled, tb->hits);
 
                 iterator = tgdb_list_next(iterator);
             }
@@ -71,8 +72,10 @@ static int tgdb_types_print_item(void *command)
                     com->choice.update_file_position.file_position;
 
             fprintf(fd,
-                    "TGDB_UPDATE_FILE_POSITION ABSOLUTE(%s)RELATIVE(%s)LINE(%d)\n",
-                    tfp->absolute_path, tfp->relative_path, tfp->line_number);
+                    "TGDB_UPDATE_FILE_POSITION ABSOLUTE(%s)RELATIVE(%s)LINE(%d)"
+                    "ADDRESS(0x%lx)FUNCTION(%s)\n", tfp->absolute_path,
+                    tfp->relative_path, tfp->line_number, tfp->address,
+                    tfp->function);
             break;
         }
         case TGDB_UPDATE_SOURCE_FILES:
@@ -93,6 +96,20 @@ static int tgdb_types_print_item(void *command)
             fprintf(fd, "Inferior source files end\n");
             break;
         }
+        case TGDB_ADD_SOURCE_FILES:
+        {
+            struct tgdb_list *list =
+                    com->choice.update_source_files.source_files;
+            tgdb_list_iterator *i;
+
+            i = tgdb_list_get_first(list);
+            while (i) {
+                fprintf(fd, "TGDB_ADD_SOURCE_FILE (%s)\n",
+                        (char *) tgdb_list_get_item(i));
+                i = tgdb_list_next(i);
+            }
+            break;
+        }
         case TGDB_SOURCES_DENIED:
             fprintf(fd, "TGDB_SOURCES_DENIED\n");
             break;
@@ -146,6 +163,123 @@ static int tgdb_types_print_item(void *command)
             fprintf(fd, "TGDB_UPDATE_CONSOLE_PROMPT_VALUE(%s)\n", value);
             break;
         }
+        case TGDB_UPDATE_DISASSEMBLY:
+        {
+            struct tgdb_disassembly *disassembly =
+                    com->choice.update_disassembly.disassembly;
+            int i;
+
+            fprintf(fd, "TGDB_UPDATE_DISASSEMBLY FUNCTION(%s) PC(0x%lx)\n",
+                    disassembly->function, disassembly->pc);
+            for (i = 0; i < disassembly->count; i++)
+                fprintf(fd, "\tADDRESS(0x%lx) TEXT(%s)\n",
+                        disassembly->instructions[i].address,
+                        disassembly->instructions[i].text);
+            break;
+        }
+        case TGDB_UPDATE_VARIABLES:
+        {
+            struct tgdb_variables *variables =
+                    com->choice.update_variables.variables;
+            int i;
+
+            fprintf(fd, "TGDB_UPDATE_VARIABLES COMMAND(%d) ERROR(%s)\n",
+                    variables->command, variables->error);
+            for (i = 0; i < variables->count; i++)
+                fprintf(fd, "\tNAME(%s) EXPRESSION(%s) VALUE(%s) TYPE(%s) "
+                        "CHILDREN(%d) IN_SCOPE(%d) TYPE_CHANGED(%d)\n",
+                        variables->variables[i].name,
+                        variables->variables[i].expression,
+                        variables->variables[i].value,
+                        variables->variables[i].type,
+                        variables->variables[i].children,
+                        variables->variables[i].in_scope,
+                        variables->variables[i].type_changed);
+            break;
+        }
+        case TGDB_UPDATE_MEMORY:
+        {
+            struct tgdb_memory *memory = com->choice.update_memory.memory;
+            int i;
+
+            fprintf(fd, "TGDB_UPDATE_MEMORY ADDRESS(0x%lx) LENGTH(%d) "
+                    "ERROR(%s)\n", memory->address, memory->length,
+                    memory->error);
+            for (i = 0; i < memory->length; i++) {
+                if (memory->readable[i])
+                    fprintf(fd, "%s%02x", i % 16 ? " " : "\t",
+                            memory->bytes[i]);
+                else
+                    fprintf(fd, "%s??", i % 16 ? " " : "\t");
+                if (i % 16 == 15 || i == memory->length - 1)
+                    fprintf(fd, "\n");
+            }
+            break;
+        }
+        case TGDB_UPDATE_LOG:
+            fprintf(fd, "TGDB_UPDATE_LOG(%s)\n", com->choice.update_log.text);
+            break;
+        case TGDB_CORE_FILE:
+            fprintf(fd, "TGDB_CORE_FILE(%d)\n", com->choice.core_file.core);
+            break;
+        case TGDB_UPDATE_FRAMES:
+        case TGDB_UPDATE_SAMPLE:
+        {
+            struct tgdb_frames *frames = com->header == TGDB_UPDATE_FRAMES ?
+                    com->choice.update_frames.frames :
+                    com->choice.update_sample.frames;
+            int i;
+
+            fprintf(fd, "%s THREAD(%d) LOW(%d) COUNT(%d) ERROR(%s)\n",
+                    com->header == TGDB_UPDATE_FRAMES ? "TGDB_UPDATE_FRAMES" :
+                    "TGDB_UPDATE_SAMPLE", frames->thread, frames->low,
+                    frames->count, frames->error);
+            for (i = 0; i < frames->count; i++)
+                fprintf(fd, "\tLEVEL(%d) ADDRESS(0x%lx) FUNCTION(%s) "
+                        "RELATIVE(%s) ABSOLUTE(%s) LINE(%d)\n",
+                        frames->frames[i].level, frames->frames[i].address,
+                        frames->frames[i].function,
+                        frames->frames[i].relative_path,
+                        frames->frames[i].absolute_path,
+                        frames->frames[i].line_number);
+            break;
+        }
+        case TGDB_UPDATE_BREAKPOINT_CHANGES:
+        {
+            struct tgdb_breakpoint_changes *changes =
+                    com->choice.update_breakpoint_changes.changes;
+            int i;
+
+            fprintf(fd, "TGDB_UPDATE_BREAKPOINT_CHANGES COUNT(%d)\n",
+                    changes->count);
+            for (i = 0; i < changes->count; i++) {
+                struct tgdb_breakpoint *tb = &changes->changes[i].breakpoint;
+
+                if (changes->changes[i].deleted)
+                    fprintf(fd, "\tNUMBER(%d) DELETED\n", tb->number);
+                else
+                    fprintf(fd, "\tNUMBER(%d) FILE(%s) FUNCNAME(%s) "
+                            "LINE(%d) ENABLED(%d) HITS(%d)\n", tb->number,
+                            tb->file, tb->funcname, tb->line, tb->enabled,
+                            tb->hits);
+            }
+            break;
+        }
+        case TGDB_UPDATE_THREADS:
+        {
+            static const char *const events[] = {
+                "CREATED", "EXITED", "SELECTED", "RUNNING", "STOPPED"
+            };
+            struct tgdb_thread_changes *changes =
+                    com->choice.update_threads.changes;
+            int i;
+
+            fprintf(fd, "TGDB_UPDATE_THREADS COUNT(%d)\n", changes->count);
+            for (i = 0; i < changes->count; i++)
+                fprintf(fd, "\tID(%d) %s\n", changes->changes[i].id,
+                        events[changes->changes[i].event]);
+            break;
+        }
         case TGDB_QUIT:
         {
             struct tgdb_debugger_exit_status *status =
@@ -165,8 +299,7 @@ static int tgdb_types_breakpoint_free(void *data)
 
     tb = (struct tgdb_breakpoint *) data;
 
-    /* Free the structure */
-    free((char *) tb->file);
+    /* Free the structure, the file belongs to the debugger interface */
     tb->file = NULL;
     free((char *) tb->funcname);
     tb->funcname = NULL;
@@ -184,7 +317,11 @@ static int tgdb_types_source_files_free(void *data)
     return 0;
 }
 
-static int tgdb_types_delete_item(void *command)
+/*
+ * The responses, and everything they point to, are in the arena of their
+ * batch. Only the lists that outlive a batch own memory of their own.
+ */
+static int tgdb_types_release_item(void *command)
 {
     struct tgdb_response *com = (struct tgdb_response *) command;
 
@@ -200,18 +337,6 @@ static int tgdb_types_delete_item(void *command)
             tgdb_list_free(list, tgdb_types_breakpoint_free);
             break;
         }
-        case TGDB_UPDATE_FILE_POSITION:
-        {
-            struct tgdb_file_position *tfp =
-                    com->choice.update_file_position.file_position;
-
-            free(tfp->absolute_path), tfp->absolute_path = NULL;
-            free(tfp->relative_path), tfp->relative_path = NULL;
-
-            free(tfp);
-            tfp = NULL;
-            break;
-        }
         case TGDB_UPDATE_SOURCE_FILES:
         {
             struct tgdb_list *list =
@@ -219,35 +344,15 @@ static int tgdb_types_delete_item(void *command)
             tgdb_list_free(list, tgdb_types_source_files_free);
             break;
         }
-        case TGDB_SOURCES_DENIED:
-            /* Nothing to do */
-            break;
-        case TGDB_FILENAME_PAIR:
-        {
-            free((char *) com->choice.filename_pair.absolute_path);
-            com->choice.filename_pair.absolute_path = NULL;
-            free((char *) com->choice.filename_pair.relative_path);
-            com->choice.filename_pair.relative_path = NULL;
-            break;
-        }
-        case TGDB_ABSOLUTE_SOURCE_DENIED:
+        case TGDB_ADD_SOURCE_FILES:
         {
-            struct tgdb_source_file *file =
-                    com->choice.absolute_source_denied.source_file;
-            free(file->absolute_path);
-            file->absolute_path = NULL;
-            free(file);
-            file = NULL;
+            /* Each batch is a list of its own */
+            struct tgdb_list *list =
+                    com->choice.update_source_files.source_files;
+            tgdb_list_free(list, tgdb_types_source_files_free);
+            tgdb_list_destroy(list);
             break;
         }
-        case TGDB_INFERIOR_EXITED:
-        {
-            int *status = com->choice.inferior_exited.exit_status;
-
-            free(status);
-            status = NULL;
-        }
-            break;
         case TGDB_UPDATE_COMPLETIONS:
         {
             struct tgdb_list *list =
@@ -255,26 +360,11 @@ static int tgdb_types_delete_item(void *command)
             tgdb_list_free(list, tgdb_types_source_files_free);
             break;
         }
-        case TGDB_UPDATE_CONSOLE_PROMPT_VALUE:
-        {
-            const char *value =
-                    com->choice.update_console_prompt_value.prompt_value;
-            free((char *) value);
-            value = NULL;
-            break;
-        }
-        case TGDB_QUIT:
-        {
-            struct tgdb_debugger_exit_status *status =
-                    com->choice.quit.exit_status;
-            free(status);
-            status = NULL;
+        default:
+            /* Nothing to do, it's all in the arena */
             break;
-        }
     }
 
-    free(com);
-    com = NULL;
     return 0;
 }
 
@@ -283,14 +373,119 @@ int tgdb_types_print_command(void *command)
     return tgdb_types_print_item((void *) command);
 }
 
-int tgdb_types_free_command(void *command)
+int tgdb_types_release_command(void *command)
 {
-    return tgdb_types_delete_item((void *) command);
+    return tgdb_types_release_item((void *) command);
 }
 
-void
-tgdb_types_append_command(struct tgdb_list *command_list,
-        struct tgdb_response *response)
+struct tgdb_response *tgdb_types_new_response(struct std_arena *arena,
+        struct tgdb_list *command_list, enum INTERFACE_RESPONSE_COMMANDS header)
 {
+    struct tgdb_response *response;
+
+    response = (struct tgdb_response *) std_arena_alloc(arena,
+            sizeof (struct tgdb_response));
+    if (!response)
+        return NULL;
+
+    response->header = header;
     tgdb_list_append(command_list, response);
+
+    return response;
+}
+
+struct tgdb_file_position *tgdb_types_copy_file_position(const struct
+        tgdb_file_position *tfp)
+{
+    struct tgdb_file_position *copy;
+
+    copy = (struct tgdb_file_position *)
+            cgdb_malloc(sizeof (struct tgdb_file_position));
+    copy->absolute_path = tfp->absolute_path;
+    copy->relative_path = tfp->relative_path;
+    copy->line_number = tfp->line_number;
+    copy->address = tfp->address;
+    copy->function = tfp->function ? cgdb_strdup(tfp->function) : NULL;
+
+    return copy;
+}
+
+void tgdb_types_free_file_position(struct tgdb_file_position *tfp)
+{
+    if (!tfp)
+        return;
+
+    /* The paths are interned */
+    free(tfp->function);
+    free(tfp);
+}
+
+/* tgdb_types_arena_strndup: Copies some bytes of a string into an arena.
+ * -------------------------
+ */
+static char *tgdb_types_arena_strndup(struct std_arena *arena, const char *s,
+        size_t length)
+{
+    char *copy = (char *) std_arena_alloc(arena, length + 1);
+
+    memcpy(copy, s, length);
+    copy[length] = '\0';
+
+    return copy;
+}
+
+struct tgdb_disassembly *tgdb_types_new_disassembly(struct std_arena *arena,
+        const char *text, size_t length)
+{
+    static const char header[] = "Dump of assembler code for function ";
+    struct tgdb_disassembly *disassembly;
+    struct tgdb_instruction *instruction;
+    const char *pos, *end = text + length, *eol, *start;
+    char *after;
+    int count = 0, pc;
+
+    disassembly = (struct tgdb_disassembly *) std_arena_alloc(arena,
+            sizeof (struct tgdb_disassembly));
+
+    /* Each instruction is on a line of its own, the most there can be */
+    for (pos = text; pos < end && (eol = memchr(pos, '\n', end - pos));
+            pos = eol + 1)
+        count++;
+
+    disassembly->instructions = (struct tgdb_instruction *)
+            std_arena_alloc(arena, sizeof (struct tgdb_instruction) *
+            (count + 1));
+
+    for (pos = text; pos < end; pos = eol + 1) {
+        if ((eol = memchr(pos, '\n', end - pos)) == NULL)
+            eol = end;
+
+        if ((size_t) (eol - pos) > sizeof (header) - 1 &&
+                strncmp(pos, header, sizeof (header) - 1) == 0) {
+            start = pos + sizeof (header) - 1;
+            disassembly->function = tgdb_types_arena_strndup(arena, start,
+                    eol - start - (eol[-1] == ':'));
+            continue;
+        }
+
+        /* The instruction the debugger is at is marked with an arrow */
+        pc = eol - pos > 3 && strncmp(pos, "=> ", 3) == 0;
+        for (start = pos + 3 * pc; start < eol && *start == ' '; start++)
+            ;
+
+        if (eol - start < 3 || strncmp(start, "0x", 2) != 0)
+            continue;
+
+        instruction = &disassembly->instructions[disassembly->count++];
+        instruction->address = strtoul(start, &after, 16);
+        while (after < eol && *after == ' ')
+            after++;
+        instruction->text = tgdb_types_arena_strndup(arena, after,
+                eol - after);
+
+        if (pc)
+            disassembly->pc = instruction->address;
+    }
+
+    return disassembly;
 }
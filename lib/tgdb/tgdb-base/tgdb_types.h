@@ -19,6 +19,7 @@ extern "C" {
 #endif
 
 #include "tgdb_list.h"
+#include "std_arena.h"
 
     /* A reference to a command that has been created by TGDB */
     struct tgdb_command;
@@ -47,25 +48,17 @@ extern "C" {
     int tgdb_types_print_command(void *command);
 
  /**
-  * This will free a client generated command.
-  * These are the commands that are returned to the front end.
+  * This will release what a client generated command owns outside of the
+  * arena it was allocated in. The command itself is freed when the arena is
+  * reset.
   *
   * \param command
-  * The command to print. It should be of type 'struct tgdb_response'
+  * The command to release. It should be of type 'struct tgdb_response'
   * 
   * @return
-  * Will return -1 if free'ing failed. Otherwise, 0.
-  */
-    int tgdb_types_free_command(void *command);
-
- /**
-  * This will append a new command into TGDB's queue.
-  *
-  * \param command_list
-  * \param response
+  * Will return -1 if releasing failed. Otherwise, 0.
   */
-    void tgdb_types_append_command(struct tgdb_list *command_list,
-            struct tgdb_response *response);
+    int tgdb_types_release_command(void *command);
 
 /*@}*/
 
@@ -146,6 +139,22 @@ extern "C" {
         TGDB_BREAKPOINT_ENABLE
     };
 
+ /**
+  * Where the debugger tests the condition of a conditional breakpoint.
+  */
+    enum tgdb_condition_evaluation {
+
+    /** In the target if it can, otherwise in the debugger. */
+        TGDB_CONDITION_AUTO,
+
+    /** In the debugger, the program stops at each hit to test it. */
+        TGDB_CONDITION_HOST,
+
+    /** In the target, as an agent expression. The program only stops when
+     * the condition is true. */
+        TGDB_CONDITION_TARGET
+    };
+
  /**
   * This structure represents a breakpoint.
   */
@@ -153,9 +162,10 @@ extern "C" {
 
     /**
      * This is the file that the breakpoint is set in. This path name can be
-     * relative.
+     * relative. It's interned, see std_intern, so it's the same string for
+     * each breakpoint in the file.
      */
-        char *file;
+        const char *file;
 
     /** The name of the function the breakpoint is set at.  */
         char *funcname;
@@ -165,6 +175,37 @@ extern "C" {
 
     /** 0 if it is not enabled or 1 if it is enabled.  */
         int enabled;
+
+    /** The number gdb gave it, 0 if the debugger interface doesn't know.  */
+        int number;
+
+    /** How many times the program stopped at it.  */
+        int hits;
+    };
+
+ /**
+  * A breakpoint that was set, changed or deleted since the last update.
+  */
+    struct tgdb_breakpoint_change {
+
+    /** 
+     * What the breakpoint is now. Only the number is set when it was
+     * deleted. A change with the number of a breakpoint the front end
+     * doesn't have is a new one.
+     */
+        struct tgdb_breakpoint breakpoint;
+
+    /** 1 if it was deleted, otherwise 0.  */
+        int deleted;
+    };
+
+ /**
+  * The breakpoints that changed since the last update, in the order they
+  * changed.
+  */
+    struct tgdb_breakpoint_changes {
+        int count;
+        struct tgdb_breakpoint_change *changes;
     };
 
  /**
@@ -172,22 +213,247 @@ extern "C" {
   */
     struct tgdb_file_position {
 
-    /** The absolute path to the file.  */
-        char *absolute_path;
+    /** The absolute path to the file, interned.  */
+        const char *absolute_path;
 
-    /** The relative path to the file.  */
-        char *relative_path;
+    /** The relative path to the file, interned.  */
+        const char *relative_path;
 
     /** The line number in the file.  */
         int line_number;
+
+    /**
+     * The address of the instruction the debugger is at, or 0 if the
+     * debugger didn't say.  */
+        unsigned long address;
+
+    /** The function the debugger is in, or NULL if it didn't say.  */
+        char *function;
+    };
+
+ /**
+  * An instruction of a disassembled function.
+  */
+    struct tgdb_instruction {
+
+    /** The address of the instruction.  */
+        unsigned long address;
+
+    /** The instruction, as the debugger shows it after the address.  */
+        char *text;
+    };
+
+ /**
+  * The instructions of a function, as the debugger disassembled them.
+  */
+    struct tgdb_disassembly {
+
+    /** The name of the function, or NULL if the debugger didn't say.  */
+        char *function;
+
+    /**
+     * The address of the instruction the debugger is at, or 0 if it's not
+     * in the function.  */
+        unsigned long pc;
+
+    /** The instructions, in order of their addresses.  */
+        struct tgdb_instruction *instructions;
+
+    /** The number of instructions, 0 if it couldn't be disassembled.  */
+        int count;
+    };
+
+ /**
+  * What a variable request asks the debugger to do with its variable
+  * objects. A variable object is an expression the debugger keeps, and
+  * only says the value of again when it changes.
+  */
+    enum tgdb_variable_command {
+    /** Create one for an expression, evaluated in whatever frame the
+     * debugger is in. The name is the expression. */
+        TGDB_VARIABLE_CREATE,
+
+    /** List the ones with values that changed since the last update.
+     * There's no name. */
+        TGDB_VARIABLE_UPDATE,
+
+    /** List the children of one, the members of a struct or the elements
+     * of an array. The name is the variable object's. */
+        TGDB_VARIABLE_CHILDREN,
+
+    /** Delete one and its children. The name is the variable object's. */
+        TGDB_VARIABLE_DELETE,
+
+    /** Delete the children of one, but not it. The name is the variable
+     * object's. */
+        TGDB_VARIABLE_DELETE_CHILDREN,
+
+    /** List the names of the arguments and locals of the frame the
+     * debugger is in. There's no name. */
+        TGDB_VARIABLE_LOCALS
+    };
+
+ /**
+  * A variable object, or what changed of it.
+  */
+    struct tgdb_variable {
+
+    /** The debugger's name for it, NULL for a local that was listed.  */
+        char *name;
+
+    /**
+     * The expression of a child, like the name of a member, or the name
+     * of a local. NULL otherwise.  */
+        char *expression;
+
+    /** Its value, or NULL if the debugger didn't say.  */
+        char *value;
+
+    /** Its type, or NULL if the debugger didn't say or it didn't change.  */
+        char *type;
+
+    /** How many children it has, or -1 if the debugger didn't say.  */
+        int children;
+
+    /** 1 if it can be evaluated where the debugger is, otherwise 0.  */
+        int in_scope;
+
+    /** 1 if its type changed, and with it its children.  */
+        int type_changed;
+    };
+
+ /**
+  * The answer to a variable request.
+  */
+    struct tgdb_variables {
+
+    /** The command that was asked for.  */
+        enum tgdb_variable_command command;
+
+    /**
+     * The variable object created, the children listed, the ones that
+     * changed, or the locals.  */
+        struct tgdb_variable *variables;
+
+    /** The number of variables.  */
+        int count;
+
+    /** The message of the debugger if the command failed, otherwise NULL.  */
+        char *error;
+    };
+
+ /**
+  * Bytes of the memory of the program being debugged.
+  */
+    struct tgdb_memory {
+
+    /** The address of the first byte asked for, 0 if it's not known.  */
+        unsigned long address;
+
+    /** How many bytes were asked for.  */
+        int length;
+
+    /** The bytes, length of them. The ones that couldn't be read are 0.  */
+        unsigned char *bytes;
+
+    /** 1 for each byte that was read, 0 for each one that couldn't be.  */
+        unsigned char *readable;
+
+    /** The message of the debugger if nothing was read, otherwise NULL.  */
+        char *error;
+    };
+
+ /**
+  * A frame of the stack of the program being debugged.
+  */
+    struct tgdb_frame {
+
+    /** 0 for the innermost frame, 1 for its caller and so on.  */
+        int level;
+
+    /** The address of the instruction the frame is at.  */
+        unsigned long address;
+
+    /** The function, or NULL if the debugger didn't say.  */
+        char *function;
+
+    /** The relative path to the file, interned, or NULL if there's no
+     * debug info.  */
+        const char *relative_path;
+
+    /** The absolute path to the file, interned, or NULL if it wasn't
+     * found.  */
+        const char *absolute_path;
+
+    /** The line number in the file, or 0 if there's no file.  */
+        int line_number;
+    };
+
+ /**
+  * Frames of the stack, a window of them from one level on.
+  */
+    struct tgdb_frames {
+
+    /** The thread they're of, 0 for the one the debugger looks at.  */
+        int thread;
+
+    /** The level of the first frame asked for.  */
+        int low;
+
+    /** How many frames there are, fewer than were asked for at the top.  */
+        int count;
+
+    /** The frames, count of them, in order.  */
+        struct tgdb_frame *frames;
+
+    /** The message of the debugger if none were listed, otherwise NULL.  */
+        char *error;
+    };
+
+ /**
+  * What happened to a thread of the program being debugged.
+  */
+    enum tgdb_thread_event {
+    /** The thread was started, or was there when the debugger attached */
+        TGDB_THREAD_CREATED,
+    /** The thread is gone */
+        TGDB_THREAD_EXITED,
+    /** The debugger looks at the thread now, it stopped or was picked */
+        TGDB_THREAD_SELECTED,
+    /** The thread runs, the id is 0 if they all do */
+        TGDB_THREAD_RUNNING,
+    /** The thread stopped, the id is 0 if they all did. In non-stop mode,
+     * the others keep running, and the debugger may look at another one */
+        TGDB_THREAD_STOPPED
+    };
+
+ /**
+  * A thread that was started, exited, selected, run or stopped.
+  */
+    struct tgdb_thread_change {
+
+    /** What happened to it.  */
+        enum tgdb_thread_event event;
+
+    /** The global number the debugger gave the thread.  */
+        int id;
+    };
+
+ /**
+  * The threads that changed since the last update, in the order they
+  * changed.
+  */
+    struct tgdb_thread_changes {
+        int count;
+        struct tgdb_thread_change *changes;
     };
 
  /**
   * This is used to return a path to the front end.
   */
     struct tgdb_source_file {
-    /** The absolute path to the file of interest.  */
-        char *absolute_path;
+    /** The absolute path to the file of interest, interned.  */
+        const char *absolute_path;
     };
 
  /**
@@ -230,13 +496,32 @@ extern "C" {
     /** Modify a breakpoint (ie delete/create/disable) */
         TGDB_REQUEST_MODIFY_BREAKPOINT,
     /** Ask GDB to give a list of tab completions for a given string */
-        TGDB_REQUEST_COMPLETE
+        TGDB_REQUEST_COMPLETE,
+    /** Ask GDB for the instructions of a function */
+        TGDB_REQUEST_DISASSEMBLE,
+    /** Create, update, expand or delete the variable objects of GDB */
+        TGDB_REQUEST_VARIABLE,
+    /** Ask GDB for bytes of the memory of the program */
+        TGDB_REQUEST_READ_MEMORY,
+    /** Ask GDB for a window of the frames of the stack */
+        TGDB_REQUEST_FRAMES,
+    /** Make GDB look at another frame, without it telling where it is */
+        TGDB_REQUEST_SELECT_FRAME,
+    /** Make GDB look at another thread, without it telling where it is */
+        TGDB_REQUEST_SELECT_THREAD,
+    /** Set a number of breakpoints with one command */
+        TGDB_REQUEST_ADD_BREAKPOINTS
     };
 
     struct tgdb_request {
     /** This is the type of request.  */
         enum INTERFACE_REQUEST_COMMANDS header;
 
+    /**
+     * The handle tgdb_request_submit gave the request, or 0 if it wasn't
+     * submitted that way.  */
+        int handle;
+
         union {
             struct {
     /** The null terminated console command to pass to GDB */
@@ -256,6 +541,8 @@ extern "C" {
             struct {
     /** This is the command that libtgdb should run through the debugger */
                 enum tgdb_command_type c;
+    /** How many times to run it, more than 1 once steps are collapsed */
+                int count;
             } debugger_command;
 
             struct {
@@ -265,12 +552,63 @@ extern "C" {
                 int line;
                 /* The action to take */
                 enum tgdb_breakpoint_action b;
+                /* The condition of a breakpoint that's added, or NULL */
+                const char *condition;
+                /* Where the debugger tests the condition */
+                enum tgdb_condition_evaluation evaluation;
             } modify_breakpoint;
 
             struct {
                 /* The line to ask GDB for completions for */
                 const char *line;
             } complete;
+
+            struct {
+                /* An address in the function to disassemble, NULL for the
+                 * one the debugger is at */
+                const char *address;
+            } disassemble;
+
+            struct {
+                /* What to do */
+                enum tgdb_variable_command command;
+                /* The expression or the variable object it's done to, or
+                 * NULL if the command doesn't need one */
+                const char *name;
+            } variable;
+
+            struct {
+                /* An expression for the address of the first byte */
+                const char *address;
+                /* How many bytes to read */
+                int length;
+            } read_memory;
+
+            struct {
+                /* The thread, 0 for the one the debugger looks at */
+                int thread;
+                /* The levels of the first and the last frame */
+                int low;
+                int high;
+            } frames;
+
+            struct {
+                /* The level of the frame */
+                int level;
+            } select_frame;
+
+            struct {
+                /* The global number of the thread */
+                int id;
+            } select_thread;
+
+            struct {
+                /* The breakpoints to set, only their file, line and
+                 * enabled are used */
+                struct tgdb_breakpoint *breakpoints;
+                /* The number of breakpoints */
+                int count;
+            } add_breakpoints;
         } choice;
     };
 
@@ -299,6 +637,13 @@ extern "C" {
      */
         TGDB_UPDATE_SOURCE_FILES,
 
+    /**
+     * This returns some of the source files, while the debugger is still
+     * listing them. TGDB_UPDATE_SOURCE_FILES still comes with all of them
+     * once it's done.
+     */
+        TGDB_ADD_SOURCE_FILES,
+
     /**
      * This is a response to the tgdb_get_sources function call.
      * If the sources can not be recieved you will get this response.
@@ -339,6 +684,74 @@ extern "C" {
     /** The prompt has changed, here is the new value.  */
         TGDB_UPDATE_CONSOLE_PROMPT_VALUE,
 
+    /**
+     * This is a response to tgdb_request_disassemble. It has the
+     * instructions of the function asked for.
+     * This is a 'struct tgdb_disassembly *'.
+     */
+        TGDB_UPDATE_DISASSEMBLY,
+
+    /**
+     * This is a response to tgdb_request_variable. One is sent for each
+     * request, except the ones that delete variable objects.
+     * This is a 'struct tgdb_variables *'.
+     */
+        TGDB_UPDATE_VARIABLES,
+
+    /**
+     * This is a response to tgdb_request_read_memory. One is sent for
+     * each request, even if nothing could be read.
+     * This is a 'struct tgdb_memory *'.
+     */
+        TGDB_UPDATE_MEMORY,
+
+    /**
+     * This is a response to tgdb_request_frames. One is sent for each
+     * request, even if there are no frames.
+     * This is a 'struct tgdb_frames *'.
+     */
+        TGDB_UPDATE_FRAMES,
+
+    /**
+     * Only the breakpoints that changed since the last update, when gdb
+     * tells about each one as it changes. The front end applies them to
+     * the breakpoints it has; TGDB_UPDATE_BREAKPOINTS still gives all of
+     * them when tgdb had to ask gdb for the whole list again.
+     * This is a 'struct tgdb_breakpoint_changes *'.
+     */
+        TGDB_UPDATE_BREAKPOINT_CHANGES,
+
+    /**
+     * The threads that were started, exited, selected, run or stopped
+     * since the last update, as gdb told about each one. The front end keeps its own
+     * list of the threads from them, they're never listed whole.
+     * This is a 'struct tgdb_thread_changes *'.
+     */
+        TGDB_UPDATE_THREADS,
+
+    /**
+     * A sample tgdb_sample took of where the running program was, its
+     * innermost frames first. The program was continued right after, the
+     * front end isn't told that it stopped.
+     * This is a 'struct tgdb_frames *'.
+     */
+        TGDB_UPDATE_SAMPLE,
+
+    /**
+     * What gdb printed while the program ran, like the output of a dprintf.
+     * It never goes to the console output, it's sent as it comes, a line
+     * can be split between two of them. Only GDB/MI sends it.
+     * This is a 'const char *'.
+     */
+        TGDB_UPDATE_LOG,
+
+    /**
+     * gdb started or stopped debugging a core dump. Nothing changes in a
+     * core dump, what the front end was told about it stays good until it
+     * gets this again. Only GDB/MI sends it.
+     */
+        TGDB_CORE_FILE,
+
     /**
      * This happens when gdb quits.
      * libtgdb is done. 
@@ -357,6 +770,11 @@ extern "C" {
     /** This is the type of response.  */
         enum INTERFACE_RESPONSE_COMMANDS header;
 
+    /**
+     * The handle of the submitted request that was running when the
+     * response was made, or 0 if there was none.  */
+        int request;
+
         union {
             /* header == TGDB_UPDATE_BREAKPOINTS */
             struct {
@@ -370,7 +788,7 @@ extern "C" {
                 struct tgdb_file_position *file_position;
             } update_file_position;
 
-            /* header == TGDB_UPDATE_SOURCE_FILES */
+            /* header == TGDB_UPDATE_SOURCE_FILES or TGDB_ADD_SOURCE_FILES */
             struct {
                 /* This list has elements of 'const char *' representing each 
                  * filename. The filename may be relative or absolute. */
@@ -415,6 +833,53 @@ extern "C" {
                 const char *prompt_value;
             } update_console_prompt_value;
 
+            /* header == TGDB_UPDATE_DISASSEMBLY */
+            struct {
+                struct tgdb_disassembly *disassembly;
+            } update_disassembly;
+
+            /* header == TGDB_UPDATE_VARIABLES */
+            struct {
+                struct tgdb_variables *variables;
+            } update_variables;
+
+            /* header == TGDB_UPDATE_MEMORY */
+            struct {
+                struct tgdb_memory *memory;
+            } update_memory;
+
+            /* header == TGDB_UPDATE_FRAMES */
+            struct {
+                struct tgdb_frames *frames;
+            } update_frames;
+
+            /* header == TGDB_UPDATE_BREAKPOINT_CHANGES */
+            struct {
+                struct tgdb_breakpoint_changes *changes;
+            } update_breakpoint_changes;
+
+            /* header == TGDB_UPDATE_THREADS */
+            struct {
+                struct tgdb_thread_changes *changes;
+            } update_threads;
+
+            /* header == TGDB_UPDATE_SAMPLE */
+            struct {
+                struct tgdb_frames *frames;
+            } update_sample;
+
+            /* header == TGDB_UPDATE_LOG */
+            struct {
+                /* The text, newlines and all */
+                const char *text;
+            } update_log;
+
+            /* header == TGDB_CORE_FILE */
+            struct {
+                /* 1 if gdb debugs a core dump now, 0 otherwise */
+                int core;
+            } core_file;
+
             /* header == TGDB_QUIT */
             struct {
                 struct tgdb_debugger_exit_status *exit_status;
@@ -423,6 +888,68 @@ extern "C" {
         } choice;
     };
 
+ /**
+  * This allocates a new response in the arena of the current batch, and
+  * appends it to TGDB's queue.
+  *
+  * \param arena
+  * The arena the responses of the batch are allocated in.
+  *
+  * \param command_list
+  * The queue to append the response to.
+  *
+  * \param header
+  * The type of response.
+  *
+  * @return
+  * The zeroed response, or NULL on error.
+  */
+    struct tgdb_response *tgdb_types_new_response(struct std_arena *arena,
+            struct tgdb_list *command_list,
+            enum INTERFACE_RESPONSE_COMMANDS header);
+
+ /**
+  * The file position of a TGDB_UPDATE_FILE_POSITION response is only valid
+  * until the next batch of responses. This copies it for a front end that
+  * keeps it longer. The paths are interned, so only the function is copied.
+  *
+  * \param tfp
+  * The file position to copy.
+  *
+  * @return
+  * The copy, free it with tgdb_types_free_file_position.
+  */
+    struct tgdb_file_position *tgdb_types_copy_file_position(const struct
+            tgdb_file_position *tfp);
+
+ /**
+  * Frees a file position made by tgdb_types_copy_file_position.
+  *
+  * \param tfp
+  * The file position to free.
+  */
+    void tgdb_types_free_file_position(struct tgdb_file_position *tfp);
+
+ /**
+  * This parses what the debugger's 'disassemble' command printed. Both
+  * clients ask for the instructions with it, and it prints them the same
+  * way to either one.
+  *
+  * \param arena
+  * The arena the disassembly is allocated in.
+  *
+  * \param text
+  * The lines the command printed, each one ended by a newline.
+  *
+  * \param length
+  * The number of bytes in text.
+  *
+  * @return
+  * The disassembly. It has no instructions if the command failed.
+  */
+    struct tgdb_disassembly *tgdb_types_new_disassembly(struct std_arena
+            *arena, const char *text, size_t length);
+
 #ifdef __cplusplus
 }
 #endif
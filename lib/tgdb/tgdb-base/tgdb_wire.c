@@ -0,0 +1,1489 @@
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#include "tgdb_wire.h"
+#include "logger.h"
+#include "sys_util.h"
+#include "ibuf.h"
+#include "io.h"
+#include "std_hash.h"
+#include "std_ohash.h"
+#include "std_intern.h"
+
+/* Internal Documentation {{{*/
+/*
+ * A string is sent as a number, the code, and maybe the text after it.
+ *   0 is NULL.
+ *   1 is followed by the text, and gives it the next number in the table.
+ *   2 is followed by the text, that isn't put in the table.
+ *   Anything else is the string that was given number code - 3.
+ * Each end of the connection has a table for the strings it sent and one
+ * for the strings it was sent; they fill up the same way. Once a table is
+ * full, new strings are sent with 2.
+ *
+ * A breakpoint update gives the number of breakpoints, and for each of them
+ * either 0 and the breakpoint, or 1 + the place in the last update of a
+ * breakpoint that didn't change.
+ *
+ * A breakpoint changes update gives the number of changes, and for each of
+ * them the number of the breakpoint, 1 if it was deleted, and if it
+ * wasn't, the rest of the breakpoint. The breakpoints sent last aren't
+ * changed by it; the next full update sends the ones that changed whole.
+ *
+ * A file position update gives which of the paths changed since the last
+ * one, those paths, how far the line moved, the address and the function.
+ *
+ * A disassembly update gives the function, the pc, the number of
+ * instructions, and for each of them how far its address is from the one
+ * before it and its text.
+ *
+ * A variables update gives the command, the error, the number of variables
+ * and each of them. The names, expressions and types repeat from one stop
+ * to the next, so they're put in the table; the values aren't.
+ *
+ * A memory update gives the address, the length, the error, a bit for each
+ * byte that's set if it was read, and the bytes that were read.
+ *
+ * A frames update gives the thread, the level of the first frame, the
+ * error, the number of frames and each of them. The paths and functions
+ * come back each time the stack is listed, so they're put in the table.
+ *
+ * A threads update gives the number of changes, and for each of them what
+ * happened and the number of the thread.
+ */
+
+/* }}}*/
+
+/** The most strings in a table */
+#define TGDB_WIRE_STRINGS_MAX 65536
+
+#define TGDB_WIRE_STRING_NULL 0
+#define TGDB_WIRE_STRING_ADD 1
+#define TGDB_WIRE_STRING_TEXT 2
+#define TGDB_WIRE_STRING_FIRST 3
+
+#define TGDB_WIRE_ABSOLUTE_PATH 0x1
+#define TGDB_WIRE_RELATIVE_PATH 0x2
+
+/**
+ * A breakpoint in the last update, kept to compare the next one with.
+ */
+struct tgdb_wire_breakpoint {
+    const char *file;           /* Interned */
+    char *funcname;
+    int line;
+    int enabled;
+    int number;
+    int hits;
+};
+
+/**
+ * Where a message that's being read is at.
+ */
+struct tgdb_wire_cursor {
+    const unsigned char *pos;
+    const unsigned char *end;
+
+    /** 1 if the message ended too soon */
+    int error;
+};
+
+struct tgdb_wire {
+    /** The messages waiting to be written */
+    struct ibuf *out;
+
+    /** The payload of the message being added */
+    struct ibuf *payload;
+
+    /** The strings sent, mapped to their number + 1 */
+    struct std_ohashtable *out_strings;
+    unsigned int out_strings_count;
+
+    /** The strings received, by number */
+    char **in_strings;
+    unsigned int in_strings_count;
+    unsigned int in_strings_size;
+
+    /** The breakpoints sent and received last */
+    struct tgdb_wire_breakpoint *out_breakpoints;
+    int out_breakpoints_count;
+    struct tgdb_wire_breakpoint *in_breakpoints;
+    int in_breakpoints_count;
+
+    /** The file positions sent and received last, the paths are interned */
+    struct tgdb_file_position out_position;
+    struct tgdb_file_position in_position;
+
+    /** What was read, from in_pos to in_len isn't taken out yet */
+    char *in;
+    size_t in_pos;
+    size_t in_len;
+    size_t in_size;
+
+    /** The strings of the message being taken out are copied in here */
+    struct std_arena *scratch;
+
+    /** The lists the front end gets, they stay around */
+    struct tgdb_list *breakpoint_list;
+    struct tgdb_list *source_files;
+    struct tgdb_list *completions;
+};
+
+static void tgdb_wire_breakpoints_free(struct tgdb_wire_breakpoint *b,
+        int count)
+{
+    int i;
+
+    for (i = 0; i < count; i++)
+        free(b[i].funcname);
+
+    free(b);
+}
+
+static int tgdb_wire_free_breakpoint(void *data)
+{
+    struct tgdb_breakpoint *tb = (struct tgdb_breakpoint *) data;
+
+    /* The file is interned */
+    free(tb->funcname);
+    free(tb);
+
+    return 0;
+}
+
+static int tgdb_wire_free_string(void *data)
+{
+    free(data);
+    return 0;
+}
+
+struct tgdb_wire *tgdb_wire_create(void)
+{
+    struct tgdb_wire *wire;
+
+    wire = (struct tgdb_wire *) cgdb_calloc(1, sizeof (struct tgdb_wire));
+
+    wire->out = ibuf_init();
+    wire->payload = ibuf_init();
+    wire->out_strings = std_ohash_table_new_full(std_str_hash,
+            std_str_equal, tgdb_wire_free_string, NULL);
+    wire->scratch = std_arena_create();
+    wire->breakpoint_list = tgdb_list_init();
+    wire->source_files = tgdb_list_init();
+    wire->completions = tgdb_list_init();
+
+    return wire;
+}
+
+void tgdb_wire_destroy(struct tgdb_wire *wire)
+{
+    unsigned int i;
+
+    if (!wire)
+        return;
+
+    ibuf_free(wire->out);
+    ibuf_free(wire->payload);
+    std_ohash_table_destroy(wire->out_strings);
+
+    for (i = 0; i < wire->in_strings_count; i++)
+        free(wire->in_strings[i]);
+    free(wire->in_strings);
+
+    tgdb_wire_breakpoints_free(wire->out_breakpoints,
+            wire->out_breakpoints_count);
+    tgdb_wire_breakpoints_free(wire->in_breakpoints,
+            wire->in_breakpoints_count);
+
+    free(wire->in);
+    std_arena_destroy(wire->scratch);
+
+    tgdb_list_free(wire->breakpoint_list, tgdb_wire_free_breakpoint);
+    tgdb_list_destroy(wire->breakpoint_list);
+    tgdb_list_free(wire->source_files, tgdb_wire_free_string);
+    tgdb_list_destroy(wire->source_files);
+    tgdb_list_free(wire->completions, tgdb_wire_free_string);
+    tgdb_list_destroy(wire->completions);
+
+    free(wire);
+}
+
+/* Writing messages {{{ */
+
+static void tgdb_wire_add_uint(struct ibuf *buf, unsigned long value)
+{
+    char bytes[10];
+    int i = 0;
+
+    while (value >= 0x80) {
+        bytes[i++] = (char) ((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    bytes[i++] = (char) value;
+
+    ibuf_addn(buf, bytes, i);
+}
+
+/* Small negative numbers are sent as small numbers too */
+static void tgdb_wire_add_int(struct ibuf *buf, long value)
+{
+    tgdb_wire_add_uint(buf, value < 0 ?
+            ((unsigned long) (-(value + 1)) << 1) | 1 :
+            (unsigned long) value << 1);
+}
+
+static void tgdb_wire_add_text(struct ibuf *buf, const char *s)
+{
+    unsigned long len = strlen(s);
+
+    tgdb_wire_add_uint(buf, len);
+    ibuf_addn(buf, s, len);
+}
+
+static void tgdb_wire_add_string(struct tgdb_wire *wire, const char *s,
+        int intern)
+{
+    void *number;
+
+    if (!s) {
+        tgdb_wire_add_uint(wire->payload, TGDB_WIRE_STRING_NULL);
+        return;
+    }
+
+    if (!intern) {
+        tgdb_wire_add_uint(wire->payload, TGDB_WIRE_STRING_TEXT);
+        tgdb_wire_add_text(wire->payload, s);
+        return;
+    }
+
+    number = std_ohash_table_lookup(wire->out_strings, s);
+    if (number) {
+        tgdb_wire_add_uint(wire->payload, (unsigned long) number - 1 +
+                TGDB_WIRE_STRING_FIRST);
+        return;
+    }
+
+    if (wire->out_strings_count == TGDB_WIRE_STRINGS_MAX) {
+        tgdb_wire_add_uint(wire->payload, TGDB_WIRE_STRING_TEXT);
+        tgdb_wire_add_text(wire->payload, s);
+        return;
+    }
+
+    std_ohash_table_insert(wire->out_strings, cgdb_strdup(s),
+            (void *) (unsigned long) ++wire->out_strings_count);
+    tgdb_wire_add_uint(wire->payload, TGDB_WIRE_STRING_ADD);
+    tgdb_wire_add_text(wire->payload, s);
+}
+
+/* Moves the payload that was added into a message of its own */
+static void tgdb_wire_end_message(struct tgdb_wire *wire,
+        enum tgdb_wire_type type)
+{
+    ibuf_addchar(wire->out, (char) type);
+    tgdb_wire_add_uint(wire->out, ibuf_length(wire->payload));
+    ibuf_addn(wire->out, ibuf_get(wire->payload),
+            ibuf_length(wire->payload));
+    ibuf_clear(wire->payload);
+}
+
+static int tgdb_wire_str_equal(const char *a, const char *b)
+{
+    if (!a || !b)
+        return a == b;
+
+    return strcmp(a, b) == 0;
+}
+
+static char *tgdb_wire_strdup(const char *s)
+{
+    return s ? cgdb_strdup(s) : NULL;
+}
+
+void tgdb_wire_put_console(struct tgdb_wire *wire, const char *buf,
+        size_t size)
+{
+    size_t n;
+
+    for (; size > 0; buf += n, size -= n) {
+        n = size < TGDB_WIRE_CONSOLE_MAX ? size : TGDB_WIRE_CONSOLE_MAX;
+        ibuf_addn(wire->payload, buf, n);
+        tgdb_wire_end_message(wire, TGDB_WIRE_CONSOLE);
+    }
+}
+
+void tgdb_wire_put_inferior(struct tgdb_wire *wire, const char *buf,
+        size_t size)
+{
+    if (size == 0)
+        return;
+
+    ibuf_addn(wire->payload, buf, size);
+    tgdb_wire_end_message(wire, TGDB_WIRE_INFERIOR);
+}
+
+void tgdb_wire_put_value(struct tgdb_wire *wire, enum tgdb_wire_type type,
+        int value)
+{
+    tgdb_wire_add_int(wire->payload, value);
+    tgdb_wire_end_message(wire, type);
+}
+
+void tgdb_wire_put_tty(struct tgdb_wire *wire, const char *name)
+{
+    tgdb_wire_add_string(wire, name, 0);
+    tgdb_wire_end_message(wire, TGDB_WIRE_TTY);
+}
+
+static void tgdb_wire_put_breakpoints(struct tgdb_wire *wire,
+        struct tgdb_list *list)
+{
+    struct tgdb_wire_breakpoint *breakpoints, *old;
+    struct tgdb_breakpoint *tb;
+    tgdb_list_iterator *i;
+    int count = tgdb_list_size(list), n = 0, j, k;
+
+    breakpoints = (struct tgdb_wire_breakpoint *)
+            cgdb_calloc(count + 1, sizeof (struct tgdb_wire_breakpoint));
+    tgdb_wire_add_uint(wire->payload, count);
+
+    for (i = tgdb_list_get_first(list); i; i = tgdb_list_next(i), n++) {
+        tb = (struct tgdb_breakpoint *) tgdb_list_get_item(i);
+
+        /* The breakpoints mostly stay in the same order */
+        for (j = 0; j < wire->out_breakpoints_count; j++) {
+            k = (n + j) % wire->out_breakpoints_count;
+            old = &wire->out_breakpoints[k];
+
+            if (old->line == tb->line && old->enabled == tb->enabled &&
+                    old->number == tb->number && old->hits == tb->hits &&
+                    tgdb_wire_str_equal(old->file, tb->file) &&
+                    tgdb_wire_str_equal(old->funcname, tb->funcname))
+                break;
+        }
+
+        if (j < wire->out_breakpoints_count)
+            tgdb_wire_add_uint(wire->payload, k + 1);
+        else {
+            tgdb_wire_add_uint(wire->payload, 0);
+            tgdb_wire_add_string(wire, tb->file, 1);
+            tgdb_wire_add_string(wire, tb->funcname, 1);
+            tgdb_wire_add_int(wire->payload, tb->line);
+            tgdb_wire_add_uint(wire->payload, tb->enabled);
+            tgdb_wire_add_uint(wire->payload, tb->number);
+            tgdb_wire_add_uint(wire->payload, tb->hits);
+        }
+
+        breakpoints[n].file = tb->file;
+        breakpoints[n].funcname = tgdb_wire_strdup(tb->funcname);
+        breakpoints[n].line = tb->line;
+        breakpoints[n].enabled = tb->enabled;
+        breakpoints[n].number = tb->number;
+        breakpoints[n].hits = tb->hits;
+    }
+
+    tgdb_wire_breakpoints_free(wire->out_breakpoints,
+            wire->out_breakpoints_count);
+    wire->out_breakpoints = breakpoints;
+    wire->out_breakpoints_count = n;
+}
+
+static void tgdb_wire_put_breakpoint_changes(struct tgdb_wire *wire,
+        struct tgdb_breakpoint_changes *changes)
+{
+    int i;
+
+    tgdb_wire_add_uint(wire->payload, changes->count);
+
+    for (i = 0; i < changes->count; i++) {
+        struct tgdb_breakpoint *tb = &changes->changes[i].breakpoint;
+
+        tgdb_wire_add_uint(wire->payload, tb->number);
+        tgdb_wire_add_uint(wire->payload, changes->changes[i].deleted);
+        if (changes->changes[i].deleted)
+            continue;
+
+        tgdb_wire_add_string(wire, tb->file, 1);
+        tgdb_wire_add_string(wire, tb->funcname, 1);
+        tgdb_wire_add_int(wire->payload, tb->line);
+        tgdb_wire_add_uint(wire->payload, tb->enabled);
+        tgdb_wire_add_uint(wire->payload, tb->hits);
+    }
+}
+
+static void tgdb_wire_put_file_position(struct tgdb_wire *wire,
+        struct tgdb_file_position *tfp)
+{
+    struct tgdb_file_position *last = &wire->out_position;
+    int changed = 0;
+
+    if (!tgdb_wire_str_equal(last->absolute_path, tfp->absolute_path))
+        changed |= TGDB_WIRE_ABSOLUTE_PATH;
+    if (!tgdb_wire_str_equal(last->relative_path, tfp->relative_path))
+        changed |= TGDB_WIRE_RELATIVE_PATH;
+
+    tgdb_wire_add_uint(wire->payload, changed);
+
+    if (changed & TGDB_WIRE_ABSOLUTE_PATH) {
+        tgdb_wire_add_string(wire, tfp->absolute_path, 1);
+        last->absolute_path = tfp->absolute_path;
+    }
+
+    if (changed & TGDB_WIRE_RELATIVE_PATH) {
+        tgdb_wire_add_string(wire, tfp->relative_path, 1);
+        last->relative_path = tfp->relative_path;
+    }
+
+    tgdb_wire_add_int(wire->payload,
+            (long) tfp->line_number - last->line_number);
+    last->line_number = tfp->line_number;
+    tgdb_wire_add_uint(wire->payload, tfp->address);
+    tgdb_wire_add_string(wire, tfp->function, 1);
+}
+
+static void tgdb_wire_put_disassembly(struct tgdb_wire *wire,
+        struct tgdb_disassembly *d)
+{
+    unsigned long address = 0;
+    int i;
+
+    tgdb_wire_add_string(wire, d->function, 1);
+    tgdb_wire_add_uint(wire->payload, d->pc);
+    tgdb_wire_add_uint(wire->payload, d->count);
+
+    for (i = 0; i < d->count; i++) {
+        tgdb_wire_add_int(wire->payload,
+                (long) (d->instructions[i].address - address));
+        address = d->instructions[i].address;
+        tgdb_wire_add_string(wire, d->instructions[i].text, 0);
+    }
+}
+
+static void tgdb_wire_put_variables(struct tgdb_wire *wire,
+        struct tgdb_variables *v)
+{
+    int i;
+
+    tgdb_wire_add_uint(wire->payload, v->command);
+    tgdb_wire_add_string(wire, v->error, 0);
+    tgdb_wire_add_uint(wire->payload, v->count);
+
+    for (i = 0; i < v->count; i++) {
+        struct tgdb_variable *variable = &v->variables[i];
+
+        tgdb_wire_add_string(wire, variable->name, 1);
+        tgdb_wire_add_string(wire, variable->expression, 1);
+        tgdb_wire_add_string(wire, variable->value, 0);
+        tgdb_wire_add_string(wire, variable->type, 1);
+        tgdb_wire_add_int(wire->payload, variable->children);
+        tgdb_wire_add_uint(wire->payload,
+                variable->in_scope | variable->type_changed << 1);
+    }
+}
+
+static void tgdb_wire_put_memory(struct tgdb_wire *wire,
+        struct tgdb_memory *m)
+{
+    char bits;
+    int i;
+
+    tgdb_wire_add_uint(wire->payload, m->address);
+    tgdb_wire_add_uint(wire->payload, m->length);
+    tgdb_wire_add_string(wire, m->error, 0);
+
+    for (i = 0, bits = 0; i < m->length; i++) {
+        if (m->readable[i])
+            bits |= 1 << (i % 8);
+        if (i % 8 == 7 || i == m->length - 1) {
+            ibuf_addchar(wire->payload, bits);
+            bits = 0;
+        }
+    }
+
+    for (i = 0; i < m->length; i++)
+        if (m->readable[i])
+            ibuf_addchar(wire->payload, (char) m->bytes[i]);
+}
+
+static void tgdb_wire_put_frames(struct tgdb_wire *wire,
+        struct tgdb_frames *f)
+{
+    int i;
+
+    tgdb_wire_add_uint(wire->payload, f->thread);
+    tgdb_wire_add_uint(wire->payload, f->low);
+    tgdb_wire_add_string(wire, f->error, 0);
+    tgdb_wire_add_uint(wire->payload, f->count);
+
+    for (i = 0; i < f->count; i++) {
+        struct tgdb_frame *frame = &f->frames[i];
+
+        tgdb_wire_add_uint(wire->payload, frame->level);
+        tgdb_wire_add_uint(wire->payload, frame->address);
+        tgdb_wire_add_string(wire, frame->function, 1);
+        tgdb_wire_add_string(wire, frame->relative_path, 1);
+        tgdb_wire_add_string(wire, frame->absolute_path, 1);
+        tgdb_wire_add_int(wire->payload, frame->line_number);
+    }
+}
+
+static void tgdb_wire_put_threads(struct tgdb_wire *wire,
+        struct tgdb_thread_changes *changes)
+{
+    int i;
+
+    tgdb_wire_add_uint(wire->payload, changes->count);
+
+    for (i = 0; i < changes->count; i++) {
+        tgdb_wire_add_uint(wire->payload, changes->changes[i].event);
+        tgdb_wire_add_uint(wire->payload, changes->changes[i].id);
+    }
+}
+
+static void tgdb_wire_put_strings(struct tgdb_wire *wire,
+        struct tgdb_list *list, int intern)
+{
+    tgdb_list_iterator *i;
+
+    tgdb_wire_add_uint(wire->payload, tgdb_list_size(list));
+
+    for (i = tgdb_list_get_first(list); i; i = tgdb_list_next(i))
+        tgdb_wire_add_string(wire, (const char *) tgdb_list_get_item(i),
+                intern);
+}
+
+void tgdb_wire_put_response(struct tgdb_wire *wire,
+        struct tgdb_response *response)
+{
+    tgdb_wire_add_uint(wire->payload, response->header);
+
+    switch (response->header) {
+        case TGDB_UPDATE_BREAKPOINTS:
+            tgdb_wire_put_breakpoints(wire,
+                    response->choice.update_breakpoints.breakpoint_list);
+            break;
+        case TGDB_UPDATE_FILE_POSITION:
+            tgdb_wire_put_file_position(wire,
+                    response->choice.update_file_position.file_position);
+            break;
+        case TGDB_UPDATE_SOURCE_FILES:
+        case TGDB_ADD_SOURCE_FILES:
+            tgdb_wire_put_strings(wire,
+                    response->choice.update_source_files.source_files, 1);
+            break;
+        case TGDB_SOURCES_DENIED:
+            break;
+        case TGDB_FILENAME_PAIR:
+            tgdb_wire_add_string(wire,
+                    response->choice.filename_pair.absolute_path, 1);
+            tgdb_wire_add_string(wire,
+                    response->choice.filename_pair.relative_path, 1);
+            break;
+        case TGDB_ABSOLUTE_SOURCE_DENIED:
+            tgdb_wire_add_string(wire, response->choice.
+                    absolute_source_denied.source_file->absolute_path, 1);
+            break;
+        case TGDB_INFERIOR_EXITED:
+            tgdb_wire_add_int(wire->payload,
+                    *response->choice.inferior_exited.exit_status);
+            break;
+        case TGDB_UPDATE_COMPLETIONS:
+            tgdb_wire_put_strings(wire,
+                    response->choice.update_completions.completion_list, 0);
+            break;
+        case TGDB_UPDATE_CONSOLE_PROMPT_VALUE:
+            tgdb_wire_add_string(wire, response->choice.
+                    update_console_prompt_value.prompt_value, 1);
+            break;
+        case TGDB_UPDATE_DISASSEMBLY:
+            tgdb_wire_put_disassembly(wire,
+                    response->choice.update_disassembly.disassembly);
+            break;
+        case TGDB_UPDATE_VARIABLES:
+            tgdb_wire_put_variables(wire,
+                    response->choice.update_variables.variables);
+            break;
+        case TGDB_UPDATE_MEMORY:
+            tgdb_wire_put_memory(wire, response->choice.update_memory.memory);
+            break;
+        case TGDB_UPDATE_FRAMES:
+            tgdb_wire_put_frames(wire, response->choice.update_frames.frames);
+            break;
+        case TGDB_UPDATE_BREAKPOINT_CHANGES:
+            tgdb_wire_put_breakpoint_changes(wire,
+                    response->choice.update_breakpoint_changes.changes);
+            break;
+        case TGDB_UPDATE_THREADS:
+            tgdb_wire_put_threads(wire,
+                    response->choice.update_threads.changes);
+            break;
+        case TGDB_UPDATE_SAMPLE:
+            tgdb_wire_put_frames(wire, response->choice.update_sample.frames);
+            break;
+        case TGDB_UPDATE_LOG:
+            tgdb_wire_add_string(wire, response->choice.update_log.text, 0);
+            break;
+        case TGDB_CORE_FILE:
+            tgdb_wire_add_uint(wire->payload, response->choice.core_file.core);
+            break;
+        case TGDB_QUIT:
+        {
+            struct tgdb_debugger_exit_status *status =
+                    response->choice.quit.exit_status;
+
+            tgdb_wire_add_int(wire->payload, status ? status->exit_status : -1);
+            tgdb_wire_add_int(wire->payload, status ? status->return_value : 0);
+            break;
+        }
+    }
+
+    tgdb_wire_end_message(wire, TGDB_WIRE_RESPONSE);
+}
+
+void tgdb_wire_put_request(struct tgdb_wire *wire, tgdb_request_ptr request)
+{
+    tgdb_wire_add_uint(wire->payload, request->header);
+
+    switch (request->header) {
+        case TGDB_REQUEST_CONSOLE_COMMAND:
+            tgdb_wire_add_string(wire,
+                    request->choice.console_command.command, 0);
+            break;
+        case TGDB_REQUEST_INFO_SOURCES:
+            break;
+        case TGDB_REQUEST_FILENAME_PAIR:
+            tgdb_wire_add_string(wire, request->choice.filename_pair.file, 1);
+            break;
+        case TGDB_REQUEST_CURRENT_LOCATION:
+            tgdb_wire_add_uint(wire->payload,
+                    request->choice.current_location.on_startup);
+            break;
+        case TGDB_REQUEST_DEBUGGER_COMMAND:
+            tgdb_wire_add_uint(wire->payload,
+                    request->choice.debugger_command.c);
+            tgdb_wire_add_uint(wire->payload,
+                    request->choice.debugger_command.count);
+            break;
+        case TGDB_REQUEST_MODIFY_BREAKPOINT:
+            tgdb_wire_add_string(wire,
+                    request->choice.modify_breakpoint.file, 1);
+            tgdb_wire_add_int(wire->payload,
+                    request->choice.modify_breakpoint.line);
+            tgdb_wire_add_uint(wire->payload,
+                    request->choice.modify_breakpoint.b);
+            tgdb_wire_add_string(wire,
+                    request->choice.modify_breakpoint.condition, 0);
+            tgdb_wire_add_uint(wire->payload,
+                    request->choice.modify_breakpoint.evaluation);
+            break;
+        case TGDB_REQUEST_COMPLETE:
+            tgdb_wire_add_string(wire, request->choice.complete.line, 0);
+            break;
+        case TGDB_REQUEST_DISASSEMBLE:
+            tgdb_wire_add_string(wire,
+                    request->choice.disassemble.address, 0);
+            break;
+        case TGDB_REQUEST_VARIABLE:
+            tgdb_wire_add_uint(wire->payload,
+                    request->choice.variable.command);
+            tgdb_wire_add_string(wire, request->choice.variable.name, 0);
+            break;
+        case TGDB_REQUEST_READ_MEMORY:
+            tgdb_wire_add_string(wire,
+                    request->choice.read_memory.address, 0);
+            tgdb_wire_add_uint(wire->payload,
+                    request->choice.read_memory.length);
+            break;
+        case TGDB_REQUEST_FRAMES:
+            tgdb_wire_add_uint(wire->payload, request->choice.frames.thread);
+            tgdb_wire_add_uint(wire->payload, request->choice.frames.low);
+            tgdb_wire_add_uint(wire->payload, request->choice.frames.high);
+            break;
+        case TGDB_REQUEST_SELECT_FRAME:
+            tgdb_wire_add_uint(wire->payload,
+                    request->choice.select_frame.level);
+            break;
+        case TGDB_REQUEST_SELECT_THREAD:
+            tgdb_wire_add_uint(wire->payload,
+                    request->choice.select_thread.id);
+            break;
+        case TGDB_REQUEST_ADD_BREAKPOINTS: {
+            struct tgdb_breakpoint *tb =
+                    request->choice.add_breakpoints.breakpoints;
+            int i;
+
+            tgdb_wire_add_uint(wire->payload,
+                    request->choice.add_breakpoints.count);
+            for (i = 0; i < request->choice.add_breakpoints.count; i++) {
+                tgdb_wire_add_string(wire, tb[i].file, 1);
+                tgdb_wire_add_int(wire->payload, tb[i].line);
+                tgdb_wire_add_uint(wire->payload, tb[i].enabled);
+            }
+            break;
+        }
+    }
+
+    tgdb_wire_end_message(wire, TGDB_WIRE_REQUEST);
+}
+
+int tgdb_wire_flush(struct tgdb_wire *wire, int fd)
+{
+    unsigned long len = ibuf_length(wire->out);
+
+    if (len == 0)
+        return 0;
+
+    if (io_writen(fd, ibuf_get(wire->out), len) != (ssize_t) len) {
+        logger_write_pos(logger, __FILE__, __LINE__, "io_writen failed");
+        return -1;
+    }
+
+    ibuf_clear(wire->out);
+
+    return 0;
+}
+
+/* }}} */
+
+/* Reading messages {{{ */
+
+static unsigned long tgdb_wire_get_uint(struct tgdb_wire_cursor *c)
+{
+    unsigned long value = 0;
+    int shift;
+
+    for (shift = 0; c->pos < c->end && shift < 64; shift += 7) {
+        value |= (unsigned long) (*c->pos & 0x7f) << shift;
+
+        if (!(*c->pos++ & 0x80))
+            return value;
+    }
+
+    c->error = 1;
+    return 0;
+}
+
+static long tgdb_wire_get_int(struct tgdb_wire_cursor *c)
+{
+    unsigned long value = tgdb_wire_get_uint(c);
+
+    return value & 1 ? -(long) (value >> 1) - 1 : (long) (value >> 1);
+}
+
+/* Copies text that was sent into the scratch arena */
+static char *tgdb_wire_get_text(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c)
+{
+    unsigned long len = tgdb_wire_get_uint(c);
+    char *s;
+
+    if (c->error || len > (unsigned long) (c->end - c->pos)) {
+        c->error = 1;
+        return NULL;
+    }
+
+    s = (char *) std_arena_alloc(wire->scratch, len + 1);
+    memcpy(s, c->pos, len);
+    c->pos += len;
+
+    return s;
+}
+
+/* The string is good until the next message is taken out */
+static const char *tgdb_wire_get_string(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c)
+{
+    unsigned long code = tgdb_wire_get_uint(c);
+    char *s;
+
+    if (c->error || code == TGDB_WIRE_STRING_NULL)
+        return NULL;
+
+    if (code == TGDB_WIRE_STRING_TEXT)
+        return tgdb_wire_get_text(wire, c);
+
+    if (code == TGDB_WIRE_STRING_ADD) {
+        if (!(s = tgdb_wire_get_text(wire, c)))
+            return NULL;
+
+        if (wire->in_strings_count == wire->in_strings_size) {
+            wire->in_strings_size = wire->in_strings_size ?
+                    wire->in_strings_size * 2 : 64;
+            wire->in_strings = cgdb_realloc(wire->in_strings,
+                    sizeof (char *) * wire->in_strings_size);
+        }
+        wire->in_strings[wire->in_strings_count++] = cgdb_strdup(s);
+
+        return s;
+    }
+
+    code -= TGDB_WIRE_STRING_FIRST;
+    if (code >= wire->in_strings_count) {
+        c->error = 1;
+        return NULL;
+    }
+
+    return wire->in_strings[code];
+}
+
+static void tgdb_wire_get_breakpoints(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c, struct tgdb_response *response)
+{
+    struct tgdb_wire_breakpoint *breakpoints;
+    struct tgdb_breakpoint *tb;
+    unsigned long count = tgdb_wire_get_uint(c), code;
+    int n;
+
+    /* Each breakpoint takes a byte at least */
+    if (c->error || count > (unsigned long) (c->end - c->pos)) {
+        c->error = 1;
+        return;
+    }
+
+    breakpoints = (struct tgdb_wire_breakpoint *)
+            cgdb_calloc(count + 1, sizeof (struct tgdb_wire_breakpoint));
+
+    for (n = 0; n < (int) count && !c->error; n++) {
+        code = tgdb_wire_get_uint(c);
+
+        if (code == 0) {
+            breakpoints[n].file = std_intern(tgdb_wire_get_string(wire, c));
+            breakpoints[n].funcname =
+                    tgdb_wire_strdup(tgdb_wire_get_string(wire, c));
+            breakpoints[n].line = tgdb_wire_get_int(c);
+            breakpoints[n].enabled = tgdb_wire_get_uint(c);
+            breakpoints[n].number = tgdb_wire_get_uint(c);
+            breakpoints[n].hits = tgdb_wire_get_uint(c);
+        } else if (code <= (unsigned long) wire->in_breakpoints_count) {
+            breakpoints[n] = wire->in_breakpoints[code - 1];
+            breakpoints[n].funcname =
+                    tgdb_wire_strdup(breakpoints[n].funcname);
+        } else
+            c->error = 1;
+    }
+
+    tgdb_wire_breakpoints_free(wire->in_breakpoints,
+            wire->in_breakpoints_count);
+    wire->in_breakpoints = breakpoints;
+    wire->in_breakpoints_count = n;
+
+    /* An update before in the same batch gets the new breakpoints */
+    tgdb_list_free(wire->breakpoint_list, tgdb_wire_free_breakpoint);
+
+    for (n = 0; n < wire->in_breakpoints_count; n++) {
+        tb = (struct tgdb_breakpoint *)
+                cgdb_malloc(sizeof (struct tgdb_breakpoint));
+        tb->file = breakpoints[n].file;
+        tb->funcname = tgdb_wire_strdup(breakpoints[n].funcname);
+        tb->line = breakpoints[n].line;
+        tb->enabled = breakpoints[n].enabled;
+        tb->number = breakpoints[n].number;
+        tb->hits = breakpoints[n].hits;
+        tgdb_list_append(wire->breakpoint_list, tb);
+    }
+
+    response->choice.update_breakpoints.breakpoint_list =
+            wire->breakpoint_list;
+}
+
+static void tgdb_wire_get_breakpoint_changes(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c, struct std_arena *arena,
+        struct tgdb_response *response)
+{
+    struct tgdb_breakpoint_changes *changes =
+            (struct tgdb_breakpoint_changes *) std_arena_alloc(arena,
+            sizeof (struct tgdb_breakpoint_changes));
+    unsigned long count = tgdb_wire_get_uint(c);
+    int i;
+
+    /* Each change takes at least 2 bytes of the message */
+    if (c->error || count > (unsigned long) (c->end - c->pos)) {
+        c->error = 1;
+        count = 0;
+    }
+
+    changes->count = count;
+    changes->changes = (struct tgdb_breakpoint_change *)
+            std_arena_alloc(arena,
+            sizeof (struct tgdb_breakpoint_change) * (count + 1));
+    memset(changes->changes, 0,
+            sizeof (struct tgdb_breakpoint_change) * (count + 1));
+
+    for (i = 0; i < changes->count && !c->error; i++) {
+        struct tgdb_breakpoint *tb = &changes->changes[i].breakpoint;
+
+        tb->number = tgdb_wire_get_uint(c);
+        changes->changes[i].deleted = tgdb_wire_get_uint(c);
+        if (changes->changes[i].deleted)
+            continue;
+
+        tb->file = std_intern(tgdb_wire_get_string(wire, c));
+        tb->funcname =
+                std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+        tb->line = tgdb_wire_get_int(c);
+        tb->enabled = tgdb_wire_get_uint(c);
+        tb->hits = tgdb_wire_get_uint(c);
+    }
+
+    response->choice.update_breakpoint_changes.changes = changes;
+}
+
+static void tgdb_wire_get_threads(struct tgdb_wire_cursor *c,
+        struct std_arena *arena, struct tgdb_response *response)
+{
+    struct tgdb_thread_changes *changes =
+            (struct tgdb_thread_changes *) std_arena_alloc(arena,
+            sizeof (struct tgdb_thread_changes));
+    unsigned long count = tgdb_wire_get_uint(c);
+    int i;
+
+    /* Each change takes at least 2 bytes of the message */
+    if (c->error || count > (unsigned long) (c->end - c->pos)) {
+        c->error = 1;
+        count = 0;
+    }
+
+    changes->count = count;
+    changes->changes = (struct tgdb_thread_change *) std_arena_alloc(arena,
+            sizeof (struct tgdb_thread_change) * (count + 1));
+
+    for (i = 0; i < changes->count && !c->error; i++) {
+        unsigned long event = tgdb_wire_get_uint(c);
+
+        if (event > TGDB_THREAD_STOPPED)
+            c->error = 1;
+        changes->changes[i].event = (enum tgdb_thread_event) event;
+        changes->changes[i].id = tgdb_wire_get_uint(c);
+    }
+
+    response->choice.update_threads.changes = changes;
+}
+
+static void tgdb_wire_get_file_position(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c, struct std_arena *arena,
+        struct tgdb_response *response)
+{
+    struct tgdb_file_position *last = &wire->in_position, *tfp;
+    unsigned long changed = tgdb_wire_get_uint(c);
+
+    if (changed & TGDB_WIRE_ABSOLUTE_PATH)
+        last->absolute_path = std_intern(tgdb_wire_get_string(wire, c));
+
+    if (changed & TGDB_WIRE_RELATIVE_PATH)
+        last->relative_path = std_intern(tgdb_wire_get_string(wire, c));
+
+    last->line_number += tgdb_wire_get_int(c);
+
+    tfp = (struct tgdb_file_position *) std_arena_alloc(arena,
+            sizeof (struct tgdb_file_position));
+    tfp->absolute_path = last->absolute_path;
+    tfp->relative_path = last->relative_path;
+    tfp->line_number = last->line_number;
+    tfp->address = tgdb_wire_get_uint(c);
+    tfp->function = std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+
+    response->choice.update_file_position.file_position = tfp;
+}
+
+static void tgdb_wire_get_disassembly(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c, struct std_arena *arena,
+        struct tgdb_response *response)
+{
+    struct tgdb_disassembly *d = (struct tgdb_disassembly *)
+            std_arena_alloc(arena, sizeof (struct tgdb_disassembly));
+    unsigned long address = 0, count;
+    int i;
+
+    d->function = std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+    d->pc = tgdb_wire_get_uint(c);
+    count = tgdb_wire_get_uint(c);
+
+    /* Each instruction takes at least 2 bytes of the message */
+    if (count > (unsigned long) (c->end - c->pos)) {
+        c->error = 1;
+        count = 0;
+    }
+
+    d->count = count;
+    d->instructions = (struct tgdb_instruction *) std_arena_alloc(arena,
+            sizeof (struct tgdb_instruction) * (count + 1));
+
+    for (i = 0; i < d->count && !c->error; i++) {
+        address += tgdb_wire_get_int(c);
+        d->instructions[i].address = address;
+        d->instructions[i].text =
+                std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+    }
+
+    response->choice.update_disassembly.disassembly = d;
+}
+
+static void tgdb_wire_get_variables(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c, struct std_arena *arena,
+        struct tgdb_response *response)
+{
+    struct tgdb_variables *v = (struct tgdb_variables *)
+            std_arena_alloc(arena, sizeof (struct tgdb_variables));
+    unsigned long count, flags;
+    int i;
+
+    v->command = tgdb_wire_get_uint(c);
+    v->error = std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+    count = tgdb_wire_get_uint(c);
+
+    /* Each variable takes at least 6 bytes of the message */
+    if (v->command > TGDB_VARIABLE_LOCALS ||
+            count > (unsigned long) (c->end - c->pos)) {
+        c->error = 1;
+        count = 0;
+    }
+
+    v->count = count;
+    v->variables = (struct tgdb_variable *) std_arena_alloc(arena,
+            sizeof (struct tgdb_variable) * (count + 1));
+
+    for (i = 0; i < v->count && !c->error; i++) {
+        struct tgdb_variable *variable = &v->variables[i];
+
+        variable->name =
+                std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+        variable->expression =
+                std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+        variable->value =
+                std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+        variable->type =
+                std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+        variable->children = tgdb_wire_get_int(c);
+        flags = tgdb_wire_get_uint(c);
+        variable->in_scope = flags & 1;
+        variable->type_changed = (flags >> 1) & 1;
+    }
+
+    response->choice.update_variables.variables = v;
+}
+
+static void tgdb_wire_get_memory(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c, struct std_arena *arena,
+        struct tgdb_response *response)
+{
+    struct tgdb_memory *m = (struct tgdb_memory *)
+            std_arena_alloc(arena, sizeof (struct tgdb_memory));
+    unsigned long length;
+    int i;
+
+    m->address = tgdb_wire_get_uint(c);
+    length = tgdb_wire_get_uint(c);
+    m->error = std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+
+    /* Each 8 bytes take at least 1 byte of the message */
+    if (c->error || length / 8 > (unsigned long) (c->end - c->pos)) {
+        c->error = 1;
+        length = 0;
+    }
+
+    m->length = length;
+    m->bytes = (unsigned char *) std_arena_alloc(arena, length + 1);
+    m->readable = (unsigned char *) std_arena_alloc(arena, length + 1);
+
+    for (i = 0; i < m->length && !c->error; i++) {
+        if (c->pos + i / 8 >= c->end) {
+            c->error = 1;
+            break;
+        }
+        m->readable[i] = (c->pos[i / 8] >> (i % 8)) & 1;
+    }
+    if (!c->error)
+        c->pos += (m->length + 7) / 8;
+
+    /* The ones that couldn't be read aren't sent, they're 0 */
+    memset(m->bytes, 0, length + 1);
+    for (i = 0; i < m->length && !c->error; i++) {
+        if (!m->readable[i])
+            continue;
+        if (c->pos >= c->end) {
+            c->error = 1;
+            break;
+        }
+        m->bytes[i] = *c->pos++;
+    }
+
+    response->choice.update_memory.memory = m;
+}
+
+static void tgdb_wire_get_frames(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c, struct std_arena *arena,
+        struct tgdb_response *response)
+{
+    struct tgdb_frames *f = (struct tgdb_frames *)
+            std_arena_alloc(arena, sizeof (struct tgdb_frames));
+    unsigned long count;
+    int i;
+
+    f->thread = tgdb_wire_get_uint(c);
+    f->low = tgdb_wire_get_uint(c);
+    f->error = std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+    count = tgdb_wire_get_uint(c);
+
+    /* Each frame takes at least 6 bytes of the message */
+    if (c->error || count > (unsigned long) (c->end - c->pos)) {
+        c->error = 1;
+        count = 0;
+    }
+
+    f->count = count;
+    f->frames = (struct tgdb_frame *) std_arena_alloc(arena,
+            sizeof (struct tgdb_frame) * (count + 1));
+
+    for (i = 0; i < f->count && !c->error; i++) {
+        struct tgdb_frame *frame = &f->frames[i];
+
+        frame->level = tgdb_wire_get_uint(c);
+        frame->address = tgdb_wire_get_uint(c);
+        frame->function =
+                std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+        frame->relative_path = std_intern(tgdb_wire_get_string(wire, c));
+        frame->absolute_path = std_intern(tgdb_wire_get_string(wire, c));
+        frame->line_number = tgdb_wire_get_int(c);
+    }
+
+    response->choice.update_frames.frames = f;
+}
+
+static void tgdb_wire_get_strings(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c, struct tgdb_list *list)
+{
+    unsigned long count = tgdb_wire_get_uint(c);
+    const char *s;
+
+    for (; count > 0 && !c->error; count--) {
+        s = tgdb_wire_get_string(wire, c);
+        if (s)
+            tgdb_list_append(list, cgdb_strdup(s));
+    }
+}
+
+static void tgdb_wire_get_response(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c, struct std_arena *arena,
+        struct tgdb_list *list, struct tgdb_wire_message *message)
+{
+    enum INTERFACE_RESPONSE_COMMANDS header = tgdb_wire_get_uint(c);
+    struct tgdb_response *response;
+
+    /* Only the front end is sent responses */
+    if (c->error || header > TGDB_QUIT || !arena) {
+        c->error = 1;
+        return;
+    }
+
+    /* It goes in the list once all of it was read */
+    response = tgdb_types_new_response(arena, NULL, header);
+
+    switch (header) {
+        case TGDB_UPDATE_BREAKPOINTS:
+            tgdb_wire_get_breakpoints(wire, c, response);
+            break;
+        case TGDB_UPDATE_FILE_POSITION:
+            tgdb_wire_get_file_position(wire, c, arena, response);
+            break;
+        case TGDB_UPDATE_SOURCE_FILES:
+            tgdb_list_free(wire->source_files, tgdb_wire_free_string);
+            tgdb_wire_get_strings(wire, c, wire->source_files);
+            response->choice.update_source_files.source_files =
+                    wire->source_files;
+            break;
+        case TGDB_ADD_SOURCE_FILES:
+            /* Each batch is a list of its own */
+            response->choice.update_source_files.source_files =
+                    tgdb_list_init();
+            tgdb_wire_get_strings(wire, c,
+                    response->choice.update_source_files.source_files);
+            break;
+        case TGDB_SOURCES_DENIED:
+            break;
+        case TGDB_FILENAME_PAIR:
+            response->choice.filename_pair.absolute_path =
+                    std_intern(tgdb_wire_get_string(wire, c));
+            response->choice.filename_pair.relative_path =
+                    std_intern(tgdb_wire_get_string(wire, c));
+            break;
+        case TGDB_ABSOLUTE_SOURCE_DENIED:
+        {
+            struct tgdb_source_file *file = (struct tgdb_source_file *)
+                    std_arena_alloc(arena, sizeof (struct tgdb_source_file));
+
+            file->absolute_path = std_intern(tgdb_wire_get_string(wire, c));
+            response->choice.absolute_source_denied.source_file = file;
+            break;
+        }
+        case TGDB_INFERIOR_EXITED:
+        {
+            int *status = (int *) std_arena_alloc(arena, sizeof (int));
+
+            *status = tgdb_wire_get_int(c);
+            response->choice.inferior_exited.exit_status = status;
+            break;
+        }
+        case TGDB_UPDATE_COMPLETIONS:
+            tgdb_list_free(wire->completions, tgdb_wire_free_string);
+            tgdb_wire_get_strings(wire, c, wire->completions);
+            response->choice.update_completions.completion_list =
+                    wire->completions;
+            break;
+        case TGDB_UPDATE_CONSOLE_PROMPT_VALUE:
+            response->choice.update_console_prompt_value.prompt_value =
+                    std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+            break;
+        case TGDB_UPDATE_DISASSEMBLY:
+            tgdb_wire_get_disassembly(wire, c, arena, response);
+            break;
+        case TGDB_UPDATE_VARIABLES:
+            tgdb_wire_get_variables(wire, c, arena, response);
+            break;
+        case TGDB_UPDATE_MEMORY:
+            tgdb_wire_get_memory(wire, c, arena, response);
+            break;
+        case TGDB_UPDATE_FRAMES:
+            tgdb_wire_get_frames(wire, c, arena, response);
+            break;
+        case TGDB_UPDATE_BREAKPOINT_CHANGES:
+            tgdb_wire_get_breakpoint_changes(wire, c, arena, response);
+            break;
+        case TGDB_UPDATE_THREADS:
+            tgdb_wire_get_threads(c, arena, response);
+            break;
+        case TGDB_UPDATE_SAMPLE:
+            /* The frames are read in the same way */
+            tgdb_wire_get_frames(wire, c, arena, response);
+            response->choice.update_sample.frames =
+                    response->choice.update_frames.frames;
+            break;
+        case TGDB_UPDATE_LOG:
+            response->choice.update_log.text =
+                    std_arena_strdup(arena, tgdb_wire_get_string(wire, c));
+            break;
+        case TGDB_CORE_FILE:
+            response->choice.core_file.core = tgdb_wire_get_uint(c) != 0;
+            break;
+        case TGDB_QUIT:
+        {
+            struct tgdb_debugger_exit_status *status =
+                    (struct tgdb_debugger_exit_status *)
+                    std_arena_alloc(arena,
+                    sizeof (struct tgdb_debugger_exit_status));
+
+            status->exit_status = tgdb_wire_get_int(c);
+            status->return_value = tgdb_wire_get_int(c);
+            response->choice.quit.exit_status = status;
+            break;
+        }
+    }
+
+    if (!c->error) {
+        tgdb_list_append(list, response);
+        message->response = response;
+    }
+}
+
+static void tgdb_wire_get_request(struct tgdb_wire *wire,
+        struct tgdb_wire_cursor *c, struct tgdb_wire_message *message)
+{
+    enum INTERFACE_REQUEST_COMMANDS header = tgdb_wire_get_uint(c);
+    tgdb_request_ptr request;
+
+    if (c->error || header > TGDB_REQUEST_ADD_BREAKPOINTS) {
+        c->error = 1;
+        return;
+    }
+
+    request = (tgdb_request_ptr) cgdb_calloc(1, sizeof (struct tgdb_request));
+    request->header = header;
+    message->request = request;
+
+    switch (header) {
+        case TGDB_REQUEST_CONSOLE_COMMAND:
+            request->choice.console_command.command =
+                    tgdb_wire_strdup(tgdb_wire_get_string(wire, c));
+            break;
+        case TGDB_REQUEST_INFO_SOURCES:
+            break;
+        case TGDB_REQUEST_FILENAME_PAIR:
+            request->choice.filename_pair.file =
+                    tgdb_wire_strdup(tgdb_wire_get_string(wire, c));
+            break;
+        case TGDB_REQUEST_CURRENT_LOCATION:
+            request->choice.current_location.on_startup =
+                    tgdb_wire_get_uint(c);
+            break;
+        case TGDB_REQUEST_DEBUGGER_COMMAND:
+            request->choice.debugger_command.c = tgdb_wire_get_uint(c);
+            request->choice.debugger_command.count = tgdb_wire_get_uint(c);
+            break;
+        case TGDB_REQUEST_MODIFY_BREAKPOINT:
+            request->choice.modify_breakpoint.file =
+                    tgdb_wire_strdup(tgdb_wire_get_string(wire, c));
+            request->choice.modify_breakpoint.line = tgdb_wire_get_int(c);
+            request->choice.modify_breakpoint.b = tgdb_wire_get_uint(c);
+            request->choice.modify_breakpoint.condition =
+                    tgdb_wire_strdup(tgdb_wire_get_string(wire, c));
+            request->choice.modify_breakpoint.evaluation =
+                    tgdb_wire_get_uint(c);
+            break;
+        case TGDB_REQUEST_COMPLETE:
+            request->choice.complete.line =
+                    tgdb_wire_strdup(tgdb_wire_get_string(wire, c));
+            break;
+        case TGDB_REQUEST_DISASSEMBLE:
+            request->choice.disassemble.address =
+                    tgdb_wire_strdup(tgdb_wire_get_string(wire, c));
+            break;
+        case TGDB_REQUEST_VARIABLE:
+            request->choice.variable.command = tgdb_wire_get_uint(c);
+            request->choice.variable.name =
+                    tgdb_wire_strdup(tgdb_wire_get_string(wire, c));
+            break;
+        case TGDB_REQUEST_READ_MEMORY:
+            request->choice.read_memory.address =
+                    tgdb_wire_strdup(tgdb_wire_get_string(wire, c));
+            request->choice.read_memory.length = tgdb_wire_get_uint(c);
+            break;
+        case TGDB_REQUEST_FRAMES:
+            request->choice.frames.thread = tgdb_wire_get_uint(c);
+            request->choice.frames.low = tgdb_wire_get_uint(c);
+            request->choice.frames.high = tgdb_wire_get_uint(c);
+            break;
+        case TGDB_REQUEST_SELECT_FRAME:
+            request->choice.select_frame.level = tgdb_wire_get_uint(c);
+            break;
+        case TGDB_REQUEST_SELECT_THREAD:
+            request->choice.select_thread.id = tgdb_wire_get_uint(c);
+            break;
+        case TGDB_REQUEST_ADD_BREAKPOINTS: {
+            unsigned long count = tgdb_wire_get_uint(c), i;
+            struct tgdb_breakpoint *tb;
+
+            /* Each breakpoint takes at least 3 bytes of the message */
+            if (c->error || count > (unsigned long) (c->end - c->pos) / 3) {
+                c->error = 1;
+                break;
+            }
+
+            tb = (struct tgdb_breakpoint *)
+                    cgdb_calloc(count + 1, sizeof (struct tgdb_breakpoint));
+            for (i = 0; i < count && !c->error; i++) {
+                tb[i].file = std_intern(tgdb_wire_get_string(wire, c));
+                tb[i].line = tgdb_wire_get_int(c);
+                tb[i].enabled = tgdb_wire_get_uint(c);
+            }
+            request->choice.add_breakpoints.breakpoints = tb;
+            request->choice.add_breakpoints.count = count;
+            break;
+        }
+    }
+}
+
+ssize_t tgdb_wire_read(struct tgdb_wire *wire, int fd, size_t n)
+{
+    ssize_t size;
+
+    /* What was taken out already isn't needed */
+    if (wire->in_pos > 0) {
+        memmove(wire->in, wire->in + wire->in_pos,
+                wire->in_len - wire->in_pos);
+        wire->in_len -= wire->in_pos;
+        wire->in_pos = 0;
+    }
+
+    if (wire->in_size < wire->in_len + n + 1) {
+        wire->in_size = wire->in_len + n + 1;
+        wire->in = cgdb_realloc(wire->in, wire->in_size);
+    }
+
+    size = io_read_ready(fd, wire->in + wire->in_len, n);
+    if (size > 0)
+        wire->in_len += size;
+
+    return size;
+}
+
+int tgdb_wire_next(struct tgdb_wire *wire, struct std_arena *arena,
+        struct tgdb_list *list, struct tgdb_wire_message *message)
+{
+    struct tgdb_wire_cursor c;
+    unsigned long size;
+    int type;
+
+    c.pos = (const unsigned char *) wire->in + wire->in_pos;
+    c.end = (const unsigned char *) wire->in + wire->in_len;
+    c.error = 0;
+
+    if (c.pos == c.end)
+        return 0;
+
+    type = *c.pos++;
+    size = tgdb_wire_get_uint(&c);
+
+    /* The length is never longer than this */
+    if (c.error && c.pos - (const unsigned char *) wire->in - wire->in_pos >=
+            TGDB_WIRE_HEADER_MAX)
+        goto error;
+
+    /* The rest of the message isn't here yet */
+    if (c.error || size > (unsigned long) (c.end - c.pos))
+        return 0;
+
+    wire->in_pos = (char *) c.pos + size - wire->in;
+    c.end = c.pos + size;
+
+    std_arena_reset(wire->scratch);
+    memset(message, 0, sizeof (struct tgdb_wire_message));
+    message->type = (enum tgdb_wire_type) type;
+
+    switch (type) {
+        case TGDB_WIRE_CONSOLE:
+        case TGDB_WIRE_INFERIOR:
+            message->data = (const char *) c.pos;
+            message->size = size;
+            break;
+        case TGDB_WIRE_STATE:
+        case TGDB_WIRE_SIGNAL:
+        case TGDB_WIRE_TTY_NEW:
+        case TGDB_WIRE_VERBOSE:
+            message->value = tgdb_wire_get_int(&c);
+            break;
+        case TGDB_WIRE_TTY:
+            message->data = tgdb_wire_get_string(wire, &c);
+            break;
+        case TGDB_WIRE_RESPONSE:
+            tgdb_wire_get_response(wire, &c, arena, list, message);
+            break;
+        case TGDB_WIRE_REQUEST:
+            tgdb_wire_get_request(wire, &c, message);
+            break;
+        default:
+            goto error;
+    }
+
+    if (c.error)
+        goto error;
+
+    return 1;
+
+  error:
+    logger_write_pos(logger, __FILE__, __LINE__, "bad message of type %d",
+            type);
+    return -1;
+}
+
+/* }}} */
@@ -0,0 +1,195 @@
+#ifndef __TGDB_WIRE_H__
+#define __TGDB_WIRE_H__
+
+/*!
+ * \file
+ * tgdb_wire.h
+ *
+ * \brief
+ * The format a headless tgdb, running next to gdb, and a front end talk in
+ * over a socket. See tgdb_remote.h.
+ *
+ * Each message is a type byte, the length of the payload, and the payload.
+ * Numbers are sent 7 bits to a byte, so that small ones take a byte.
+ *
+ * The messages are kept small for slow links. A string sent once, like a
+ * file name, is sent as a number after that. Breakpoint updates only send
+ * the breakpoints that changed, and file positions the fields that did.
+ * Everything a batch of gdb's output makes is written at once.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif /* HAVE_SYS_TYPES_H */
+
+#include "tgdb_types.h"
+#include "tgdb_list.h"
+#include "std_arena.h"
+
+/**
+ * The most console output sent in one message. Anything longer is split.
+ */
+#define TGDB_WIRE_CONSOLE_MAX 4096
+
+/**
+ * The most bytes the type and length of a message take.
+ */
+#define TGDB_WIRE_HEADER_MAX 6
+
+/**
+ * The messages.
+ */
+enum tgdb_wire_type {
+    /** Output gdb printed for the user, in data and size */
+    TGDB_WIRE_CONSOLE = 1,
+
+    /** Output of the program being debugged, or input to it */
+    TGDB_WIRE_INFERIOR,
+
+    /** value is 1 if tgdb is busy, 0 if it can take a request */
+    TGDB_WIRE_STATE,
+
+    /** The name of the program's terminal, in data */
+    TGDB_WIRE_TTY,
+
+    /** A response, in response */
+    TGDB_WIRE_RESPONSE,
+
+    /** A request, in request */
+    TGDB_WIRE_REQUEST,
+
+    /** The signal in value was sent to the front end */
+    TGDB_WIRE_SIGNAL,
+
+    /** Give the program a new terminal */
+    TGDB_WIRE_TTY_NEW,
+
+    /** Show the commands the front end runs if value is 1 */
+    TGDB_WIRE_VERBOSE
+};
+
+/**
+ * A message that was read.
+ */
+struct tgdb_wire_message {
+    enum tgdb_wire_type type;
+
+    /** The text of the message, it's good until the next one is read */
+    const char *data;
+    size_t size;
+
+    int value;
+
+    /**
+     * The response, appended to the list given to tgdb_wire_next. It is
+     * released with tgdb_types_release_command like any other.  */
+    struct tgdb_response *response;
+
+    /** The request, freed the same way as the ones tgdb makes */
+    tgdb_request_ptr request;
+};
+
+/**
+ * One end of the connection.
+ */
+struct tgdb_wire;
+
+/**
+ * Creates an end of the connection.
+ *
+ * @return
+ * The new context.
+ */
+struct tgdb_wire *tgdb_wire_create(void);
+
+/**
+ * Frees an end of the connection. The fd it talks over is left open.
+ *
+ * \param wire
+ * The context to free.
+ */
+void tgdb_wire_destroy(struct tgdb_wire *wire);
+
+/* Writing messages {{{ */
+
+/**
+ * These add a message to the ones that are written the next time
+ * tgdb_wire_flush is called.
+ */
+
+void tgdb_wire_put_console(struct tgdb_wire *wire, const char *buf,
+        size_t size);
+void tgdb_wire_put_inferior(struct tgdb_wire *wire, const char *buf,
+        size_t size);
+void tgdb_wire_put_value(struct tgdb_wire *wire, enum tgdb_wire_type type,
+        int value);
+void tgdb_wire_put_tty(struct tgdb_wire *wire, const char *name);
+void tgdb_wire_put_response(struct tgdb_wire *wire,
+        struct tgdb_response *response);
+void tgdb_wire_put_request(struct tgdb_wire *wire, tgdb_request_ptr request);
+
+/**
+ * Writes the messages added since the last call, all at once.
+ *
+ * \param wire
+ * The context.
+ *
+ * \param fd
+ * The fd to write to.
+ *
+ * @return
+ * 0 on success, or -1 on error.
+ */
+int tgdb_wire_flush(struct tgdb_wire *wire, int fd);
+
+/* }}} */
+
+/* Reading messages {{{ */
+
+/**
+ * Reads what's ready on fd, without blocking.
+ *
+ * \param wire
+ * The context.
+ *
+ * \param fd
+ * The fd to read from.
+ *
+ * \param n
+ * The most bytes to read.
+ *
+ * @return
+ * The number of bytes read, 0 on EOF, or -1 on error, with errno set to
+ * EAGAIN if fd had nothing to read.
+ */
+ssize_t tgdb_wire_read(struct tgdb_wire *wire, int fd, size_t n);
+
+/**
+ * Takes the next message out of what was read.
+ *
+ * \param wire
+ * The context.
+ *
+ * \param arena
+ * The responses, and what they point to, are allocated in this arena.
+ *
+ * \param list
+ * The responses are appended to this list.
+ *
+ * \param message
+ * The message, on the way out.
+ *
+ * @return
+ * 1 if there was a message, 0 if the rest of the next one wasn't read
+ * yet, or -1 if what was read isn't a message.
+ */
+int tgdb_wire_next(struct tgdb_wire *wire, struct std_arena *arena,
+        struct tgdb_list *list, struct tgdb_wire_message *message);
+
+/* }}} */
+
+#endif /* __TGDB_WIRE_H__ */
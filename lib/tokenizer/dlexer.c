@@ -1,3786 +0,0 @@
-#line 2 "dlexer.c"
-
-#line 4 "dlexer.c"
-
-#define  YY_INT_ALIGNED short int
-
-/* A lexical scanner generated by flex */
-
-#define yy_create_buffer d__create_buffer
-#define yy_delete_buffer d__delete_buffer
-#define yy_flex_debug d__flex_debug
-#define yy_init_buffer d__init_buffer
-#define yy_flush_buffer d__flush_buffer
-#define yy_load_buffer_state d__load_buffer_state
-#define yy_switch_to_buffer d__switch_to_buffer
-#define yyin d_in
-#define yyleng d_leng
-#define yylex d_lex
-#define yylineno d_lineno
-#define yyout d_out
-#define yyrestart d_restart
-#define yytext d_text
-#define yywrap d_wrap
-#define yyalloc d_alloc
-#define yyrealloc d_realloc
-#define yyfree d_free
-
-#define FLEX_SCANNER
-#define YY_FLEX_MAJOR_VERSION 2
-#define YY_FLEX_MINOR_VERSION 5
-#define YY_FLEX_SUBMINOR_VERSION 35
-#if YY_FLEX_SUBMINOR_VERSION > 0
-#define FLEX_BETA
-#endif
-
-/* First, we deal with  platform-specific or compiler-specific issues. */
-
-/* begin standard C headers. */
-#include <stdio.h>
-#include <string.h>
-#include <errno.h>
-#include <stdlib.h>
-
-/* end standard C headers. */
-
-/* flex integer type definitions */
-
-#ifndef FLEXINT_H
-#define FLEXINT_H
-
-/* C99 systems have <inttypes.h>. Non-C99 systems may or may not. */
-
-#if defined (__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
-
-/* C99 says to define __STDC_LIMIT_MACROS before including stdint.h,
- * if you want the limit (max/min) macros for int types. 
- */
-#ifndef __STDC_LIMIT_MACROS
-#define __STDC_LIMIT_MACROS 1
-#endif
-
-#include <inttypes.h>
-typedef int8_t flex_int8_t;
-typedef uint8_t flex_uint8_t;
-typedef int16_t flex_int16_t;
-typedef uint16_t flex_uint16_t;
-typedef int32_t flex_int32_t;
-typedef uint32_t flex_uint32_t;
-#else
-typedef signed char flex_int8_t;
-typedef short int flex_int16_t;
-typedef int flex_int32_t;
-typedef unsigned char flex_uint8_t; 
-typedef unsigned short int flex_uint16_t;
-typedef unsigned int flex_uint32_t;
-
-/* Limits of integral types. */
-#ifndef INT8_MIN
-#define INT8_MIN               (-128)
-#endif
-#ifndef INT16_MIN
-#define INT16_MIN              (-32767-1)
-#endif
-#ifndef INT32_MIN
-#define INT32_MIN              (-2147483647-1)
-#endif
-#ifndef INT8_MAX
-#define INT8_MAX               (127)
-#endif
-#ifndef INT16_MAX
-#define INT16_MAX              (32767)
-#endif
-#ifndef INT32_MAX
-#define INT32_MAX              (2147483647)
-#endif
-#ifndef UINT8_MAX
-#define UINT8_MAX              (255U)
-#endif
-#ifndef UINT16_MAX
-#define UINT16_MAX             (65535U)
-#endif
-#ifndef UINT32_MAX
-#define UINT32_MAX             (4294967295U)
-#endif
-
-#endif /* ! C99 */
-
-#endif /* ! FLEXINT_H */
-
-#ifdef __cplusplus
-
-/* The "const" storage-class-modifier is valid. */
-#define YY_USE_CONST
-
-#else	/* ! __cplusplus */
-
-/* C99 requires __STDC__ to be defined as 1. */
-#if defined (__STDC__)
-
-#define YY_USE_CONST
-
-#endif	/* defined (__STDC__) */
-#endif	/* ! __cplusplus */
-
-#ifdef YY_USE_CONST
-#define yyconst const
-#else
-#define yyconst
-#endif
-
-/* Returned upon end-of-file. */
-#define YY_NULL 0
-
-/* Promotes a possibly negative, possibly signed char to an unsigned
- * integer for use as an array index.  If the signed char is negative,
- * we want to instead treat it as an 8-bit unsigned char, hence the
- * double cast.
- */
-#define YY_SC_TO_UI(c) ((unsigned int) (unsigned char) c)
-
-/* Enter a start condition.  This macro really ought to take a parameter,
- * but we do it the disgusting crufty way forced on us by the ()-less
- * definition of BEGIN.
- */
-#define BEGIN (yy_start) = 1 + 2 *
-
-/* Translate the current start state into a value that can be later handed
- * to BEGIN to return to the state.  The YYSTATE alias is for lex
- * compatibility.
- */
-#define YY_START (((yy_start) - 1) / 2)
-#define YYSTATE YY_START
-
-/* Action number for EOF rule of a given start state. */
-#define YY_STATE_EOF(state) (YY_END_OF_BUFFER + state + 1)
-
-/* Special action meaning "start processing a new file". */
-#define YY_NEW_FILE d_restart(d_in  )
-
-#define YY_END_OF_BUFFER_CHAR 0
-
-/* Size of default input buffer. */
-#ifndef YY_BUF_SIZE
-#ifdef __ia64__
-/* On IA-64, the buffer size is 16k, not 8k.
- * Moreover, YY_BUF_SIZE is 2*YY_READ_BUF_SIZE in the general case.
- * Ditto for the __ia64__ case accordingly.
- */
-#define YY_BUF_SIZE 32768
-#else
-#define YY_BUF_SIZE 16384
-#endif /* __ia64__ */
-#endif
-
-/* The state buf must be large enough to hold one state per character in the main buffer.
- */
-#define YY_STATE_BUF_SIZE   ((YY_BUF_SIZE + 2) * sizeof(yy_state_type))
-
-#ifndef YY_TYPEDEF_YY_BUFFER_STATE
-#define YY_TYPEDEF_YY_BUFFER_STATE
-typedef struct yy_buffer_state *YY_BUFFER_STATE;
-#endif
-
-extern int d_leng;
-
-extern FILE *d_in, *d_out;
-
-#define EOB_ACT_CONTINUE_SCAN 0
-#define EOB_ACT_END_OF_FILE 1
-#define EOB_ACT_LAST_MATCH 2
-
-    #define YY_LESS_LINENO(n)
-    
-/* Return all but the first "n" matched characters back to the input stream. */
-#define yyless(n) \
-	do \
-		{ \
-		/* Undo effects of setting up d_text. */ \
-        int yyless_macro_arg = (n); \
-        YY_LESS_LINENO(yyless_macro_arg);\
-		*yy_cp = (yy_hold_char); \
-		YY_RESTORE_YY_MORE_OFFSET \
-		(yy_c_buf_p) = yy_cp = yy_bp + yyless_macro_arg - YY_MORE_ADJ; \
-		YY_DO_BEFORE_ACTION; /* set up d_text again */ \
-		} \
-	while ( 0 )
-
-#define unput(c) yyunput( c, (yytext_ptr)  )
-
-#ifndef YY_TYPEDEF_YY_SIZE_T
-#define YY_TYPEDEF_YY_SIZE_T
-typedef size_t yy_size_t;
-#endif
-
-#ifndef YY_STRUCT_YY_BUFFER_STATE
-#define YY_STRUCT_YY_BUFFER_STATE
-struct yy_buffer_state
-	{
-	FILE *yy_input_file;
-
-	char *yy_ch_buf;		/* input buffer */
-	char *yy_buf_pos;		/* current position in input buffer */
-
-	/* Size of input buffer in bytes, not including room for EOB
-	 * characters.
-	 */
-	yy_size_t yy_buf_size;
-
-	/* Number of characters read into yy_ch_buf, not including EOB
-	 * characters.
-	 */
-	int yy_n_chars;
-
-	/* Whether we "own" the buffer - i.e., we know we created it,
-	 * and can realloc() it to grow it, and should free() it to
-	 * delete it.
-	 */
-	int yy_is_our_buffer;
-
-	/* Whether this is an "interactive" input source; if so, and
-	 * if we're using stdio for input, then we want to use getc()
-	 * instead of fread(), to make sure we stop fetching input after
-	 * each newline.
-	 */
-	int yy_is_interactive;
-
-	/* Whether we're considered to be at the beginning of a line.
-	 * If so, '^' rules will be active on the next match, otherwise
-	 * not.
-	 */
-	int yy_at_bol;
-
-    int yy_bs_lineno; /**< The line count. */
-    int yy_bs_column; /**< The column count. */
-    
-	/* Whether to try to fill the input buffer when we reach the
-	 * end of it.
-	 */
-	int yy_fill_buffer;
-
-	int yy_buffer_status;
-
-#define YY_BUFFER_NEW 0
-#define YY_BUFFER_NORMAL 1
-	/* When an EOF's been seen but there's still some text to process
-	 * then we mark the buffer as YY_EOF_PENDING, to indicate that we
-	 * shouldn't try reading from the input source any more.  We might
-	 * still have a bunch of tokens to match, though, because of
-	 * possible backing-up.
-	 *
-	 * When we actually see the EOF, we change the status to "new"
-	 * (via d_restart()), so that the user can continue scanning by
-	 * just pointing d_in at a new input file.
-	 */
-#define YY_BUFFER_EOF_PENDING 2
-
-	};
-#endif /* !YY_STRUCT_YY_BUFFER_STATE */
-
-/* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
-
-/* We provide macros for accessing buffer states in case in the
- * future we want to put the buffer states in a more general
- * "scanner state".
- *
- * Returns the top of the stack, or NULL.
- */
-#define YY_CURRENT_BUFFER ( (yy_buffer_stack) \
-                          ? (yy_buffer_stack)[(yy_buffer_stack_top)] \
-                          : NULL)
-
-/* Same as previous macro, but useful when we know that the buffer stack is not
- * NULL or when we need an lvalue. For internal use only.
- */
-#define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
-
-/* yy_hold_char holds the character lost when d_text is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int d_leng;
-
-/* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
-
-/* Flag which is used to allow d_wrap()'s to do buffer switches
- * instead of setting up a fresh d_in.  A bit of a hack ...
- */
-static int yy_did_buffer_switch_on_eof;
-
-void d_restart (FILE *input_file  );
-void d__switch_to_buffer (YY_BUFFER_STATE new_buffer  );
-YY_BUFFER_STATE d__create_buffer (FILE *file,int size  );
-void d__delete_buffer (YY_BUFFER_STATE b  );
-void d__flush_buffer (YY_BUFFER_STATE b  );
-void d_push_buffer_state (YY_BUFFER_STATE new_buffer  );
-void d_pop_buffer_state (void );
-
-static void d_ensure_buffer_stack (void );
-static void d__load_buffer_state (void );
-static void d__init_buffer (YY_BUFFER_STATE b,FILE *file  );
-
-#define YY_FLUSH_BUFFER d__flush_buffer(YY_CURRENT_BUFFER )
-
-YY_BUFFER_STATE d__scan_buffer (char *base,yy_size_t size  );
-YY_BUFFER_STATE d__scan_string (yyconst char *yy_str  );
-YY_BUFFER_STATE d__scan_bytes (yyconst char *bytes,int len  );
-
-void *d_alloc (yy_size_t  );
-void *d_realloc (void *,yy_size_t  );
-void d_free (void *  );
-
-#define yy_new_buffer d__create_buffer
-
-#define yy_set_interactive(is_interactive) \
-	{ \
-	if ( ! YY_CURRENT_BUFFER ){ \
-        d_ensure_buffer_stack (); \
-		YY_CURRENT_BUFFER_LVALUE =    \
-            d__create_buffer(d_in,YY_BUF_SIZE ); \
-	} \
-	YY_CURRENT_BUFFER_LVALUE->yy_is_interactive = is_interactive; \
-	}
-
-#define yy_set_bol(at_bol) \
-	{ \
-	if ( ! YY_CURRENT_BUFFER ){\
-        d_ensure_buffer_stack (); \
-		YY_CURRENT_BUFFER_LVALUE =    \
-            d__create_buffer(d_in,YY_BUF_SIZE ); \
-	} \
-	YY_CURRENT_BUFFER_LVALUE->yy_at_bol = at_bol; \
-	}
-
-#define YY_AT_BOL() (YY_CURRENT_BUFFER_LVALUE->yy_at_bol)
-
-/* Begin user sect3 */
-
-typedef unsigned char YY_CHAR;
-
-FILE *d_in = (FILE *) 0, *d_out = (FILE *) 0;
-
-typedef int yy_state_type;
-
-extern int d_lineno;
-
-int d_lineno = 1;
-
-extern char *d_text;
-#define yytext_ptr d_text
-
-static yy_state_type yy_get_previous_state (void );
-static yy_state_type yy_try_NUL_trans (yy_state_type current_state  );
-static int yy_get_next_buffer (void );
-static void yy_fatal_error (yyconst char msg[]  );
-
-/* Done after the current pattern has been matched and before the
- * corresponding action - sets up d_text.
- */
-#define YY_DO_BEFORE_ACTION \
-	(yytext_ptr) = yy_bp; \
-	d_leng = (size_t) (yy_cp - yy_bp); \
-	(yy_hold_char) = *yy_cp; \
-	*yy_cp = '\0'; \
-	(yy_c_buf_p) = yy_cp;
-
-#define YY_NUM_RULES 210
-#define YY_END_OF_BUFFER 211
-/* This struct is not used in this scanner,
-   but its presence is necessary. */
-struct yy_trans_info
-	{
-	flex_int32_t yy_verify;
-	flex_int32_t yy_nxt;
-	};
-static yyconst flex_int16_t yy_accept[732] =
-    {   0,
-        0,    0,  111,  111,  118,  118,  146,  146,  153,  153,
-      160,  160,  211,  209,  207,  204,  206,  144,  209,  209,
-      209,  166,  166,  209,  208,  166,  159,  208,  208,  208,
-      208,  208,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,  208,  208,  208,  208,  208,  208,  208,  111,  113,
-      114,  112,  118,  122,  123,  119,  120,  146,  147,  148,
-      150,  210,  153,  154,  155,  157,  210,  160,  161,  162,
-      164,  205,  127,    0,    0,  110,  117,  126,  166,    0,
-      167,  169,  171,    0,  168,    0,    0,    0,    0,    0,
-      208,  208,  166,  208,  167,  169,  171,  166,  208,  208,
-
-      208,  168,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,  208,  208,  208,  208,  208,  208,  208,  208,  208,
-       77,  208,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,  208,  208,  208,   85,  208,   86,  208,   88,  208,
-      208,  208,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,  208,  152,  208,  208,  208,  208,  208,  208,  208,
-      208,  208,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,  208,  208,  208,  208,  208,  208,  145,  111,  115,
-      112,  112,  116,  118,  124,  119,  119,  125,  120,  121,
-      120,  146,    0,  149,  151,  153,    0,  156,  158,  160,
-
-      163,  165,  199,    0,  199,  126,    0,  173,  170,  172,
-      177,  182,    0,    0,    0,    0,    0,  208,  167,  169,
-      171,  168,  173,  173,  170,  172,  166,  208,  208,  208,
-      208,  208,  208,  208,  208,  208,  208,   65,  208,  208,
-        8,  208,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,  208,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,  208,  208,  208,  208,  208,  208,  208,  208,   80,
-      208,  208,  208,  208,  208,  208,  208,  208,    6,  208,
-      208,  208,  208,  208,  208,   90,  208,  208,   91,  208,
-      208,  208,  208,  208,  208,  208,  208,  208,   41,  208,
-
-      208,  208,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,  208,  208,  102,  208,  208,  208,  208,  208,  208,
-      208,  208,  208,  208,  208,  208,  208,  208,  200,  175,
-      174,  178,  180,    0,  182,  183,    0,  185,    0,    0,
-        0,    0,    0,  170,  172,  174,  174,  208,  208,  208,
-      208,  208,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,    5,   67,    9,  208,    7,   69,   71,  208,  208,
-       12,  208,   10,  208,  208,  208,  208,  208,  208,  208,
-      208,  208,  208,  208,   78,   18,  208,  208,  208,  208,
-      208,  208,  208,  208,   84,  208,  208,  208,  208,  208,
-
-      208,  208,  208,  208,   34,   35,  208,  208,  208,  202,
-      208,  208,  208,  208,  208,  208,  208,   39,   40,  208,
-      208,  208,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,   99,  208,  203,  208,  208,  208,   53,  208,  208,
-      208,  208,  208,   57,  208,  208,  208,  109,  208,  176,
-      179,  181,    0,  182,  184,    0,  186,    0,    0,  139,
-        0,    0,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,  137,  138,  208,   63,   64,  208,   68,   70,  208,
-      208,   14,   15,  208,   16,   21,   74,  208,  208,  208,
-      208,  208,  208,  208,  208,  208,  201,   27,   28,  208,
-
-      208,  208,  208,  208,  208,  208,   31,  208,  208,   33,
-       89,  208,  208,  208,  208,  208,  208,  208,  208,  208,
-      208,   42,  208,   44,  208,  208,  208,  208,  208,  208,
-      100,  208,  208,  208,  101,  208,  208,  208,   51,   52,
-       54,   55,  208,  208,  208,  208,   59,  108,  208,    0,
-        0,  187,    0,    0,    0,    0,  136,  208,  208,  208,
-      208,  208,  134,  208,  208,  208,   66,  208,   13,  208,
-      208,  208,   76,  208,   23,  208,  208,   19,   20,  208,
-      208,  208,   25,  208,   29,  208,  128,  208,  208,  129,
-      208,  208,  208,  131,  208,  208,  208,   94,   95,   43,
-
-       45,  208,   96,   47,   48,   49,   97,  208,  208,  208,
-      104,  105,  208,   56,  208,  208,  208,  208,    0,    0,
-      189,  191,  188,    0,    0,  141,    0,  208,  208,  208,
-      208,  208,  133,  208,  208,   11,  208,   73,  208,  208,
-       22,  208,   79,   81,  208,   26,  208,  208,  208,   36,
-      208,  130,   92,  208,  208,  208,  208,  208,  103,  208,
-      107,  208,   60,   61,  193,  187,  190,  192,  143,    0,
-      140,  208,  208,    2,   62,    3,  208,    4,   72,   75,
-      208,   24,  208,   83,  208,  208,  208,   37,  208,  208,
-      208,  208,   98,  106,   58,  195,  197,  194,  189,  191,
-
-      188,  142,    1,  135,  208,  208,  208,   30,   32,   87,
-       93,   38,  208,  208,  196,  198,  190,  192,  132,   17,
-      208,   46,  208,  208,  208,  208,   50,  208,  208,   82,
-        0
-    } ;
-
-static yyconst flex_int32_t yy_ec[256] =
-    {   0,
-        1,    1,    1,    1,    1,    1,    1,    1,    2,    3,
-        2,    2,    4,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    2,    1,    5,    6,    1,    1,    1,    7,    1,
-        1,    8,    9,    1,   10,    1,   11,   12,   13,   14,
-       14,   14,   14,   14,   14,   14,   14,    1,    1,    1,
-        1,    1,    1,   15,   16,   16,   16,   16,   17,   18,
-       19,   19,   19,   19,   19,   20,   19,   19,   19,   21,
-       19,   19,   19,   19,   22,   19,   19,   19,   19,   19,
-        1,   23,    1,    1,   24,   25,   26,   27,   28,   29,
-
-       30,   31,   32,   33,   34,   19,   35,   36,   37,   38,
-       39,   40,   41,   42,   43,   44,   45,   46,   47,   48,
-       49,   50,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1
-    } ;
-
-static yyconst flex_int32_t yy_meta[51] =
-    {   0,
-        1,    1,    2,    3,    4,    1,    1,    5,    6,    1,
-        6,    7,    7,    7,    1,    8,    8,    8,    9,    9,
-        9,    9,    1,    8,   10,    8,    8,    8,    8,    8,
-        8,    9,    9,    9,    9,    9,    9,    9,    9,    9,
-        9,    9,    9,    9,    9,    9,    9,    9,    9,    9
-    } ;
-
-static yyconst flex_int16_t yy_base[754] =
-    {   0,
-        0,    0,   48,   50,   56,   59,   68,   71,   74,   77,
-       80,   82,  525, 3113, 3113, 3113,  520, 3113,    0,  476,
-       79,   96,   69,   92,   89,  133, 3113,  156,  161,  199,
-      176,  195,  232,  126,  167,  266,  208,  184,  237,  240,
-      247,  172,  298,  251,  336,  305,  324,  243,    0, 3113,
-      490,   53,    0, 3113,  489,   46,   84,  466, 3113,  481,
-       96,  468,  447, 3113,  462,  105,  458,    0, 3113,  453,
-      241, 3113,    0,  444,  430, 3113, 3113,    0,   71,  315,
-     3113,   44,  403,  136, 3113,    0,  388,  377,   43,  375,
-        0,  293,  368,  391,  301,  308,  342,  392,  347,  363,
-
-      381,  396,  414,  418,  421,  427,  430,  433,  436,  441,
-      447,  455,  463,  466,  469,  474,  484,  491,  494,  497,
-      500,  503,  506,  517,  522,  526,  529,  538,  541,  544,
-      547,  559,  565,  570,  575,  578,  581,  584,  587,  592,
-      609,  616,  619,  622,  626,  631,  637,  641,  644,  639,
-      647,  673, 3113,  678,  681,  684,  689,  693,  700,  704,
-      712,  715,  719,  729,  732,  735,  743,  750,  746,  753,
-      756,  763,  767,  778,  781,  784,  794, 3113,    0, 3113,
-      104,  120, 3113,    0, 3113,   95,  145, 3113,  205, 3113,
-      215,  391,  407, 3113, 3113,  388,  401, 3113, 3113,    0,
-
-     3113, 3113, 3113,  390,  380,    0,  800,  805, 3113, 3113,
-      813,  847,  341,  344,  347,  328,  324,  830,    0,   77,
-      346,    0,  867,  870,  808,  818,  270,  883,  843,  833,
-      890,  894,  838,  897,  900,  903,  916,  906,  931,  937,
-      940,  943,  946,  951,  954,  957,  960,  966,  977,  981,
-      984,  990,  993,  996, 1001, 1004, 1016, 1011, 1026, 1031,
-     1034, 1039, 1042, 1047, 1050, 1053, 1058, 1068, 1072, 1078,
-     1083, 1090, 1093, 1100, 1103, 1106, 1109, 1118, 1122, 1127,
-     1142, 1145, 1148, 1152, 1157, 1160, 1163, 1169, 1175, 1178,
-     1186, 1194, 1197, 1200, 1203, 1210, 1215, 1221, 1224, 1227,
-
-     1235, 1238, 1241, 1246, 1249, 1252, 1255, 1265, 1275, 1278,
-     1282, 1287, 1292, 1298, 1301, 1307, 1315, 1320, 1323, 1326,
-     1329, 1332, 1342, 1336, 1346, 1364, 1368, 1371, 3113, 1374,
-     3113,  149,  345,    0, 1402,  160,  230,  331,  315,  300,
-      286,  257,  247,    0,    0,    0, 1377, 1381, 1394, 1397,
-     1424, 1427, 1431, 1390, 1436, 1442, 1448, 1451, 1455, 1458,
-     1461, 1465, 1473, 1487, 1492, 1495, 1498, 1501, 1504, 1507,
-     1510, 1516, 1519, 1526, 1531, 1534, 1537, 1540, 1544, 1547,
-     1551, 1558, 1565, 1572, 1577, 1584, 1590, 1595, 1598, 1601,
-     1605, 1608, 1616, 1611, 1620, 1632, 1635, 1645, 1651, 1654,
-
-     1660, 1663, 1666, 1670, 1673, 1676, 1679, 1685, 1688, 1697,
-     1700, 1706, 1710, 1713, 1721, 1724, 1731, 1736, 1740, 1743,
-     1747, 1750, 1754, 1757, 1760, 1770, 1775, 1778, 1787, 1792,
-     1797, 1800, 1804, 1809, 1814, 1817, 1822, 1825, 1828, 1832,
-     1842, 1845, 1849, 1855, 1859, 1862, 1865, 1868, 1876, 3113,
-     3113, 3113,  151,  262, 3113, 1884, 3113,  260,  242, 3113,
-      232,  198, 1879, 1887, 1893, 1902, 1905, 1908, 1911, 1916,
-     1921, 1924, 1928, 1931, 1934, 1937, 1942, 1949, 1952, 1955,
-     1958, 1961, 1964, 1967, 1970, 1975, 1980, 1983, 1986, 1994,
-     1997, 2001, 2004, 2008, 2014, 2021, 2024, 2027, 2031, 2034,
-
-     2040, 2043, 2052, 2055, 2058, 2063, 2066, 2069, 2077, 2080,
-     2083, 2089, 2092, 2096, 2100, 2103, 2108, 2111, 2114, 2121,
-     2124, 2128, 2134, 2141, 2144, 2147, 2152, 2156, 2159, 2162,
-     2165, 2180, 2173, 2183, 2186, 2189, 2198, 2204, 2208, 2211,
-     2216, 2219, 2224, 2227, 2230, 2233, 2236, 2239, 2243,  265,
-      324, 2270,  201,  185,  180,  157, 2249, 2260, 2252, 2263,
-     2266, 2273, 2285, 2293, 2304, 2308, 2311, 2314, 2317, 2325,
-     2328, 2333, 2336, 2339, 2342, 2346, 2349, 2354, 2362, 2367,
-     2370, 2373, 2376, 2379, 2382, 2386, 2392, 2405, 2408, 2411,
-     2414, 2423, 2426, 2429, 2432, 2435, 2441, 2445, 2451, 2454,
-
-     2457, 2461, 2464, 2468, 2471, 2474, 2477, 2481, 2484, 2487,
-     2490, 2493, 2496, 2499, 2502, 2509, 2512, 2517, 2520, 2523,
-      301,  156, 3113,  136,  114, 3113,  113, 2529, 2538, 2541,
-     2548, 2551, 2554, 2559, 2562, 2566, 2569, 2572, 2575, 2582,
-     2588, 2595, 2598, 2601, 2604, 2607, 2610, 2615, 2618, 2621,
-     2624, 2635, 2638, 2645, 2648, 2651, 2654, 2657, 2664, 2667,
-     2671, 2676, 2681, 2684, 2700, 2734, 3113, 3113, 3113,   88,
-     3113, 2687, 2690, 2695, 2705, 2713, 2716, 2723, 2726, 2729,
-     2737, 2749, 2752, 2757, 2760, 2763, 2768, 2771, 2774, 2783,
-     2786, 2792, 2795, 2801, 2804,  346,  109, 3113,  351,   91,
-
-     3113, 3113, 2807, 2810, 2816, 2819, 2822, 2825, 2828, 2831,
-     2837, 2841, 2844, 2848, 3113, 3113, 3113, 3113, 2851, 2854,
-     2857, 2860, 2863, 2866, 2870, 2873, 2877, 2888, 2892, 2895,
-     3113, 2931, 2941, 2951, 2961, 2971, 2974, 2983, 2987, 2996,
-     3006, 3016, 3026, 3036, 3046, 3056, 3066, 3075, 3085, 3089,
-     3091, 3100, 3104
-    } ;
-
-static yyconst flex_int16_t yy_def[754] =
-    {   0,
-      731,    1,  732,  732,  733,  733,  734,  734,  735,  735,
-      736,  736,  731,  731,  731,  731,  731,  731,  737,  738,
-      731,  731,   22,  731,  739,  739,  731,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  740,  731,
-      731,  741,  742,  731,  731,  743,  744,  745,  731,  731,
-      731,  745,  746,  731,  731,  731,  746,  747,  731,  731,
-      731,  731,  737,  731,  748,  731,  731,  749,   22,  731,
-      731,  731,  731,  731,  731,  750,  731,  731,  731,  731,
-      751,  739,  751,  739,  739,  739,  739,   26,  739,  739,
-
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,   33,
-      739,  739,  731,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  731,  740,  731,
-      741,  741,  731,  742,  731,  743,  743,  731,  744,  731,
-      744,  745,  745,  731,  731,  746,  746,  731,  731,  747,
-
-      731,  731,  731,  731,  731,  749,  731,  731,  731,  731,
-      731,  752,  731,  731,  731,  731,  731,  751,  751,  751,
-      751,  751,  751,  739,  739,  739,   26,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  731,  731,
-      731,  731,  731,  753,  752,  753,  753,  753,  731,  731,
-      731,  731,  731,  751,  751,  751,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  731,
-      731,  731,  753,  335,  731,  731,  731,  731,  731,  731,
-      731,  731,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  731,
-      753,  731,  731,  731,  731,  731,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  731,  731,
-      731,  731,  731,  731,  731,  731,  731,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  731,  731,  731,  731,  731,  731,
-      731,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  739,  731,  731,  731,  731,  731,
-
-      731,  731,  739,  739,  739,  739,  739,  739,  739,  739,
-      739,  739,  739,  739,  731,  731,  731,  731,  739,  739,
-      739,  739,  739,  739,  739,  739,  739,  739,  739,  739,
-        0,  731,  731,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731
-    } ;
-
-static yyconst flex_int16_t yy_nxt[3164] =
-    {   0,
-       14,   15,   16,   17,   18,   19,   20,   14,   14,   14,
-       21,   22,   23,   23,   24,   25,   25,   25,   25,   25,
-       25,   25,   14,   26,   27,   28,   29,   30,   31,   32,
-       33,   34,   35,   36,   25,   37,   38,   39,   40,   41,
-       25,   42,   43,   44,   45,   46,   47,   48,   25,   25,
-       50,   51,   50,   51,  187,   52,  188,   52,   54,   55,
-      182,   54,   55,  183,   56,  209,   57,   56,  215,   57,
-       59,   60,   61,   59,   60,   61,   64,   65,   66,   64,
-       65,   66,   69,   70,   69,   70,   76,   77,  209,   78,
-       62,  216,  190,   62,  191,  731,   67,  731,  344,   67,
-
-       91,   91,   91,  731,   71,  731,   71,   79,   79,   79,
-      718,  731,   80,   81,  731,   82,  731,   83,  731,   79,
-       87,  344,   84,  195,  195,   80,   81,  182,  716,   85,
-      183,   88,  199,  199,   89,   90,  702,   91,   91,   91,
-       83,  671,  195,   86,   93,   93,   93,  211,  211,   94,
-       95,  199,   96,  187,   97,  188,   98,  670,   99,  211,
-      100,  101,   94,   95,  132,  669,  102,   91,   91,   91,
-      451,  550,   91,   91,   91,  668,  153,   97,   91,   91,
-       91,  455,  103,   91,   91,   91,  627,   91,   91,   91,
-      550,  104,  133,  451,  107,   91,   91,   91,  105,  108,
-
-      106,  154,  109,  119,  455,  120,   91,   91,   91,  110,
-       91,   91,   91,  731,  121,  731,  626,  142,  122,   91,
-       91,   91,  143,  731,  111,  191,  625,  112,  113,  114,
-      123,  115,  124,  140,  116,  125,  624,  117,  456,  456,
-      118,  556,  126,   91,   91,   91,  141,  178,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,  127,   91,   91,
-       91,  555,   91,   91,   91,  128,  144,  129,  202,  202,
-      130,  554,  149,  619,  619,  145,  131,   91,   91,   91,
-      162,  146,  551,  163,  147,  148,  553,  202,  150,  462,
-      151,  152,  164,  227,  134,   92,  135,   92,   92,  165,
-
-      461,  551,  136,  137,   91,   91,   91,  138,  139,   91,
-       91,   91,   91,   91,   91,  460,   91,   91,   91,   91,
-       91,   91,  667,  207,  207,  155,  208,  208,  208,  225,
-      156,  157,  620,  620,  172,   91,   91,   91,  208,  459,
-      458,  158,  159,  173,  160,  667,  161,   91,   91,   91,
-      457,  174,  225,   91,   91,   91,  175,  176,   91,   91,
-       91,  226,  166,  167,  452,  345,  177,  715,  343,  168,
-      342,  169,  717,  170,   91,   91,   91,  341,  171,   93,
-       93,   93,  340,  339,  218,  219,  329,  220,  233,  221,
-      715,   93,   91,   91,   91,  717,  329,  218,  219,  207,
-
-      207,  222,  223,  223,  223,  196,  234,   91,   91,   91,
-      197,  192,  221,  193,  224,  227,  217,   92,  214,  228,
-       92,  213,  210,  229,  235,   91,   91,   91,  230,   91,
-       91,   91,   91,   91,   91,  231,  205,  232,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-      203,  237,   91,   91,   91,  201,  236,  238,   91,   91,
-       91,  242,  196,  239,  198,  244,   91,   91,   91,  197,
-      240,  243,  192,  241,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,  194,  245,   91,   91,   91,  193,  246,
-      247,  185,  180,  248,  251,   91,   91,   91,   75,  252,
-
-      249,  250,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-      254,  253,   72,  256,  731,  731,  255,  257,   91,   91,
-       91,  731,  258,   91,   91,   91,  259,   91,   91,   91,
-       91,   91,   91,  731,  260,  731,  261,  731,  262,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,  263,  731,  731,  267,  265,  264,  731,  731,  266,
-       91,   91,   91,  731,  731,  268,   91,   91,   91,  269,
-      731,   91,   91,   91,  271,  270,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-
-       91,  731,  272,   91,   91,   91,  731,  273,  274,  731,
-      275,  731,  731,  281,  276,  731,  731,  277,  731,  278,
-       91,   91,   91,  731,  279,  731,  280,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,  731,   91,   91,   91,
-      731,  282,   91,   91,   91,  731,  283,  285,   91,   91,
-       91,  731,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,  731,  731,  284,  292,  731,  288,  731,  286,  287,
-      290,  291,  293,  731,   92,  731,  731,  294,  731,  731,
-      289,  731,  731,   92,   91,   91,   91,  731,  295,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,  731,  296,
-
-       91,   91,   91,  298,   91,   91,   91,  731,  299,  302,
-      731,   91,   91,   91,  297,   91,   91,   91,  305,  301,
-      731,  300,  303,   91,   91,   91,   91,   91,   91,  731,
-       91,   91,   91,  731,  306,  731,  731,  308,  304,  307,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,  309,
-      731,  310,  311,  731,   91,   91,   91,   91,   91,   91,
-      312,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-      731,  315,  317,  313,   91,   91,   91,  314,   91,   91,
-       91,  731,  731,  316,  319,  731,  320,  318,  321,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,  731,  731,
-
-      323,  731,  324,  731,  322,   91,   91,   91,  731,  731,
-      325,  330,  330,  330,  326,  731,  208,  208,  208,   91,
-       91,   91,  331,  330,  211,  211,  731,  327,  208,   91,
-       91,   91,  332,  731,  333,  331,  211,  328,  207,  207,
-      731,  223,  223,  223,   91,   91,   91,  731,  731,   91,
-       91,   91,  731,  223,   91,   91,   91,  333,  335,  335,
-      335,  731,  335,  335,  335,  731,  336,  337,  338,  355,
-      335,  350,  335,  335,  335,  335,  335,  335,  223,  223,
-      223,  223,  223,  223,  346,  349,  337,  347,  731,  731,
-      223,  338,  731,  224,   91,   91,   91,  346,  731,  731,
-
-      347,   91,   91,   91,  731,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-      731,  731,  351,  353,  731,  731,  348,   91,   91,   91,
-      731,  352,  731,  354,  731,  356,  731,  731,  357,  731,
-      731,  359,   91,   91,   91,  731,  358,  360,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-      361,  731,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,  731,  362,  365,   91,   91,   91,
-      731,  364,  731,  366,  731,  731,  367,  369,   91,   91,
-       91,  363,   91,   91,   91,   91,   91,   91,  731,  731,
-
-      368,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-      370,  731,   91,   91,   91,   91,   91,   91,  731,  372,
-      371,  377,   91,   91,   91,  373,  378,   91,   91,   91,
-      731,  731,  374,  731,  731,  375,  376,   91,   91,   91,
-      381,  380,   91,   91,   91,   91,   91,   91,  379,  731,
-       91,   91,   91,   91,   91,   91,  731,  383,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,  382,  385,   91,
-       91,   91,  387,  731,  731,  384,  731,  731,  386,   91,
-       91,   91,  389,   91,   91,   91,  731,  731,  388,   91,
-       91,   91,  731,  391,   91,   91,   91,  392,  731,  731,
-
-      390,   91,   91,   91,   91,   91,   91,  393,  731,  731,
-      394,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,  731,  731,  396,  731,  731,  395,   91,
-       91,   91,  731,   91,   91,   91,  731,  731,   91,   91,
-       91,  398,  731,  731,  397,  731,  731,  400,  731,  731,
-      399,  402,  403,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,  401,   91,   91,   91,  731,  404,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,  731,  731,  406,
-       91,   91,   91,  731,  731,  407,   91,   91,   91,   91,
-       91,   91,  731,  405,  731,  409,  731,   91,   91,   91,
-
-      731,  408,  731,  731,  410,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,  731,  731,  411,
-      412,   91,   91,   91,  731,  413,   91,   91,   91,  731,
-      731,  416,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,  731,  414,  415,  418,  417,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,  731,  419,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,  731,
-      731,  420,  731,  731,  421,  424,   91,   91,   91,  422,
-      731,  731,  423,  731,  428,  426,   91,   91,   91,   91,
-       91,   91,  425,   91,   91,   91,  427,  731,   91,   91,
-
-       91,  731,  430,   91,   91,   91,  731,  731,  429,   91,
-       91,   91,   91,   91,   91,  731,  731,  431,   91,   91,
-       91,  434,  731,  731,  432,  433,   91,   91,   91,  731,
-      435,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,  731,   91,   91,   91,
-      436,  731,  437,   91,   91,   91,  731,   91,   91,   91,
-      439,  445,  731,  438,  440,  731,  731,  442,  731,  441,
-      444,  446,  731,  731,  443,   91,   91,   91,  731,   91,
-       91,   91,   91,   91,   91,  330,  330,  330,   91,   91,
-       91,  450,   91,   91,   91,  731,  731,  330,  731,  447,
-
-      448,   91,   91,   91,  450,   91,   91,   91,   91,   91,
-       91,  463,  449,  454,  454,  454,  731,  454,  454,  454,
-      731,  336,  337,  338,  731,  454,  464,  454,  454,  454,
-      454,  454,  454,  469,  465,   91,   91,   91,   91,   91,
-       91,  337,   91,   91,   91,  731,  338,   91,   91,   91,
-      731,  731,  467,   91,   91,   91,  731,  731,  468,   91,
-       91,   91,   91,   91,   91,  466,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,  470,   91,   91,   91,  731,
-      471,  731,  731,  472,   91,   91,   91,  731,  731,  473,
-      731,  731,  474,  731,  731,  476,  731,  475,   91,   91,
-
-       91,  731,  477,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,  731,  731,  478,   91,   91,   91,
-       91,   91,   91,  480,  731,  731,  479,   91,   91,   91,
-      731,  481,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,  731,   91,   91,   91,   91,   91,
-       91,  731,   91,   91,   91,  731,  731,  484,  482,   91,
-       91,   91,  485,  731,  483,  487,   91,   91,   91,  731,
-      731,  486,  489,   91,   91,   91,  731,  491,   91,   91,
-       91,  488,  731,  731,  490,   91,   91,   91,  731,  731,
-
-      492,   91,   91,   91,  731,  493,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,  731,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,  494,  731,   91,   91,   91,
-      497,   91,   91,   91,  731,  731,  495,  731,  731,  496,
-      498,  500,  731,   91,   91,   91,   91,   91,   91,  731,
-      731,  499,  731,  731,  501,  502,   91,   91,   91,  731,
-      731,  503,   91,   91,   91,   91,   91,   91,  731,  731,
-      504,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-      731,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,  731,  505,  506,   91,   91,   91,   91,
-
-       91,   91,  731,  507,  508,  510,  731,  509,   91,   91,
-       91,   91,   91,   91,  731,  731,  511,   91,   91,   91,
-      512,   91,   91,   91,   91,   91,   91,  731,  731,  513,
-      731,  515,   91,   91,   91,   91,   91,   91,  517,  731,
-      731,  514,   91,   91,   91,  731,  516,   91,   91,   91,
-      518,   91,   91,   91,   91,   91,   91,  519,   91,   91,
-       91,   91,   91,   91,  520,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,  731,  731,  522,  731,  731,  523,
-      525,   91,   91,   91,  521,  526,   91,   91,   91,   91,
-       91,   91,  731,  528,  731,  527,  731,  524,   91,   91,
-
-       91,  731,  530,   91,   91,   91,  731,  529,   91,   91,
-       91,   91,   91,   91,  532,   91,   91,   91,  731,  531,
-       91,   91,   91,  731,  533,   91,   91,   91,   91,   91,
-       91,  731,  534,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,  536,   91,   91,   91,  539,  537,  731,  731,
-      535,  731,  538,   91,   91,   91,   91,   91,   91,  541,
-       91,   91,   91,  731,  731,  540,   91,   91,   91,  542,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,  545,  731,  731,  543,  544,   91,   91,   91,
-       91,   91,   91,  731,  548,  552,  552,  552,   91,   91,
-
-       91,  731,  546,  547,   91,   91,   91,  552,  557,  549,
-      731,  731,  558,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,  731,  559,   91,   91,   91,
-      731,  560,   91,   91,   91,   91,   91,   91,  561,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,  562,  563,   91,   91,   91,  566,  565,  731,  564,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,  731,  567,   91,   91,   91,  731,
-      568,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-
-      731,  569,  731,  731,  570,   91,   91,   91,   91,   91,
-       91,  572,   91,   91,   91,   91,   91,   91,  571,   91,
-       91,   91,  731,  573,  574,   91,   91,   91,  731,  731,
-      575,  731,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,  576,   91,   91,   91,   91,   91,   91,  731,  731,
-      577,   91,   91,   91,   91,   91,   91,  578,  579,  731,
-      731,  581,  580,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,  731,  582,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,  586,  731,  731,  583,  584,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,  731,  585,  588,
-
-       91,   91,   91,   91,   91,   91,  587,   91,   91,   91,
-      589,   91,   91,   91,   91,   91,   91,  731,  590,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,  594,  592,
-      591,  593,   91,   91,   91,   91,   91,   91,  596,   91,
-       91,   91,  731,  731,  597,   91,   91,   91,  598,  731,
-      731,  595,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,  599,  600,   91,   91,   91,  731,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,  731,
-      602,  731,  603,  604,   91,   91,   91,  601,  731,  731,
-      605,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-
-       91,   91,   91,  731,  731,  606,  731,  731,  609,   91,
-       91,   91,  607,  731,  608,   91,   91,   91,  610,   91,
-       91,   91,   91,   91,   91,  731,  611,   91,   91,   91,
-       91,   91,   91,  731,  612,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,  613,   91,   91,   91,  731,  731,  617,
-       91,   91,   91,   91,   91,   91,  616,  731,  615,  731,
-      614,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-      618,  552,  552,  552,   91,   91,   91,  731,  630,  621,
-      731,  622,  731,  552,  731,  629,   91,   91,   91,  731,
-
-      731,  628,  731,  623,   91,   91,   91,  731,  731,  631,
-      731,  632,  731,  731,  622,   91,   91,   91,  731,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,  731,  731,  634,  633,  635,   91,   91,   91,   91,
-       91,   91,  731,  636,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,  731,   91,   91,   91,
-       91,   91,   91,  731,  640,   91,   91,   91,  731,  637,
-      731,  638,  642,   91,   91,   91,  639,  641,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,  731,   91,   91,   91,
-
-      731,  731,  644,   91,   91,   91,  731,  731,  646,  731,
-      731,  645,  647,  731,  731,  643,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,  731,  731,
-      648,  731,  731,  649,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,  731,
-      731,  651,   91,   91,   91,  652,   91,   91,   91,  731,
-      650,  653,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,  655,   91,   91,   91,   91,   91,   91,  654,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,  656,   91,   91,   91,   91,   91,   91,   91,   91,
-
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,  731,  659,  731,  657,
-       91,   91,   91,   91,   91,   91,  731,  658,   91,   91,
-       91,  665,  665,  665,  666,  666,  666,  731,  660,  661,
-       91,   91,   91,  665,  662,  731,  666,  731,  664,   91,
-       91,   91,   91,   91,   91,  663,  731,  731,  672,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,  731,  674,
-       91,   91,   91,   91,   91,   91,  673,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,  731,
-      675,  731,  676,   91,   91,   91,  677,  731,  679,   91,
-
-       91,   91,  731,  731,  680,  678,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,  683,  681,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,  682,  731,
-      731,  684,  686,  731,  731,  685,   91,   91,   91,   91,
-       91,   91,  731,  688,  731,  687,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,  690,  731,  731,  689,   91,   91,   91,   91,   91,
-       91,  691,   91,   91,   91,  731,  693,   91,   91,   91,
-      731,  692,   91,   91,   91,   91,   91,   91,   91,   91,
-
-       91,   91,   91,   91,  731,  695,   91,   91,   91,  731,
-      694,  665,  665,  665,  731,  703,   91,   91,   91,  696,
-      731,  697,  731,  665,   91,   91,   91,   91,   91,   91,
-      731,  704,  731,  698,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,  731,  697,  666,  666,  666,   91,   91,
-       91,  731,  731,  699,  731,  700,  731,  666,  731,  705,
-       91,   91,   91,   91,   91,   91,  706,  701,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,  731,  700,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,  731,  708,
-      731,  731,  709,  707,   91,   91,   91,   91,   91,   91,
-
-      731,  731,  711,   91,   91,   91,   91,   91,   91,  713,
-      731,  710,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,  731,  714,  712,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,  731,  731,  720,   91,   91,
-       91,  721,   91,   91,   91,   91,   91,   91,  719,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-       91,   91,   91,   91,   91,   91,   91,   91,   91,   91,
-      731,   91,   91,   91,   91,   91,   91,  722,   91,   91,
-       91,  731,  725,  731,  731,  726,  731,  723,  727,   91,
-
-       91,   91,  724,   91,   91,   91,   91,   91,   91,  731,
-      731,  731,  731,  731,  728,  731,  731,  731,  731,  731,
-      731,  730,  731,  731,  731,  731,  731,  731,  731,  731,
-      729,   49,   49,   49,   49,   49,   49,   49,   49,   49,
-       49,   53,   53,   53,   53,   53,   53,   53,   53,   53,
-       53,   58,   58,   58,   58,   58,   58,   58,   58,   58,
-       58,   63,   63,   63,   63,   63,   63,   63,   63,   63,
-       63,   68,   68,   68,   68,   68,   68,   68,   68,   68,
-       68,   73,   73,   74,  731,   74,   74,   74,   74,   74,
-       74,   74,   74,   92,   92,   92,  179,  731,  731,  179,
-
-      731,  179,  179,  179,  179,  179,  181,  731,  731,  181,
-      181,  181,  181,  181,  181,  181,  184,  731,  731,  184,
-      184,  731,  184,  184,  184,  184,  186,  731,  731,  186,
-      186,  186,  186,  186,  186,  186,  189,  731,  731,  189,
-      189,  189,  189,  189,  189,  189,  192,  731,  731,  731,
-      192,  192,  192,  192,  192,  192,  196,  731,  731,  731,
-      196,  196,  196,  196,  196,  196,  200,  731,  731,  200,
-      200,  200,  200,  200,  200,  204,  731,  204,  204,  204,
-      204,  204,  204,  204,  204,  206,  731,  731,  206,  206,
-      206,  206,  206,  206,  206,  212,  212,   91,   91,   91,
-
-      334,  731,  334,  334,  334,  334,  334,  334,  334,  334,
-      453,  453,   13,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731
-    } ;
-
-static yyconst flex_int16_t yy_chk[3164] =
-    {   0,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        3,    3,    4,    4,   56,    3,   56,    4,    5,    5,
-       52,    6,    6,   52,    5,   82,    5,    6,   89,    6,
-        7,    7,    7,    8,    8,    8,    9,    9,    9,   10,
-       10,   10,   11,   11,   12,   12,   21,   21,   82,   21,
-        7,   89,   57,    8,   57,   23,    9,   79,  220,   10,
-
-       25,   25,   25,  186,   11,  186,   12,   22,   22,   22,
-      700,  181,   22,   22,  181,   22,   23,   22,   79,   22,
-       24,  220,   22,   61,   61,   22,   22,  182,  697,   22,
-      182,   24,   66,   66,   24,   24,  670,   34,   34,   34,
-       22,  627,   61,   22,   26,   26,   26,   84,   84,   26,
-       26,   66,   26,  187,   26,  187,   26,  625,   26,   84,
-       26,   26,   26,   26,   34,  624,   26,   28,   28,   28,
-      332,  453,   29,   29,   29,  622,   42,   26,   35,   35,
-       35,  336,   28,   42,   42,   42,  556,   31,   31,   31,
-      453,   28,   35,  332,   29,   38,   38,   38,   28,   29,
-
-       28,   42,   29,   31,  336,   31,   32,   32,   32,   29,
-       30,   30,   30,  189,   31,  189,  555,   38,   31,   37,
-       37,   37,   38,  191,   30,  191,  554,   30,   30,   30,
-       32,   30,   32,   37,   30,   32,  553,   30,  337,  337,
-       30,  462,   32,   33,   33,   33,   37,   48,   39,   39,
-       39,   40,   40,   40,   48,   48,   48,   33,   41,   41,
-       41,  461,   44,   44,   44,   33,   39,   33,   71,   71,
-       33,  459,   41,  550,  550,   39,   33,   36,   36,   36,
-       44,   39,  454,   44,   40,   40,  458,   71,   41,  343,
-       41,   41,   44,  227,   36,  227,   36,  227,  227,   44,
-
-      342,  454,   36,   36,   92,   92,   92,   36,   36,   43,
-       43,   43,   95,   95,   95,  341,   46,   46,   46,   96,
-       96,   96,  621,   80,   80,   43,   80,   80,   80,   96,
-       43,   43,  551,  551,   46,   47,   47,   47,   80,  340,
-      339,   43,   43,   46,   43,  621,   43,   45,   45,   45,
-      338,   47,   96,   97,   97,   97,   47,   47,   99,   99,
-       99,   97,   45,   45,  333,  221,   47,  696,  217,   45,
-      216,   45,  699,   45,  100,  100,  100,  215,   45,   93,
-       93,   93,  214,  213,   93,   93,  205,   93,   99,   93,
-      696,   93,  101,  101,  101,  699,  204,   93,   93,   94,
-
-       94,   93,   94,   94,   94,  197,  100,  102,  102,  102,
-      196,  193,   93,  192,   94,   98,   90,   98,   88,   98,
-       98,   87,   83,   98,  101,  103,  103,  103,   98,  104,
-      104,  104,  105,  105,  105,   98,   75,   98,  106,  106,
-      106,  107,  107,  107,  108,  108,  108,  109,  109,  109,
-       74,  104,  110,  110,  110,   70,  103,  105,  111,  111,
-      111,  108,   67,  105,   65,  109,  112,  112,  112,   63,
-      106,  108,   62,  107,  113,  113,  113,  114,  114,  114,
-      115,  115,  115,   60,  110,  116,  116,  116,   58,  111,
-      111,   55,   51,  112,  115,  117,  117,  117,   20,  116,
-
-      113,  114,  118,  118,  118,  119,  119,  119,  120,  120,
-      120,  121,  121,  121,  122,  122,  122,  123,  123,  123,
-      118,  117,   17,  120,   13,    0,  119,  120,  124,  124,
-      124,    0,  120,  125,  125,  125,  120,  126,  126,  126,
-      127,  127,  127,    0,  121,    0,  122,    0,  123,  128,
-      128,  128,  129,  129,  129,  130,  130,  130,  131,  131,
-      131,  124,    0,    0,  127,  126,  125,    0,    0,  126,
-      132,  132,  132,    0,    0,  128,  133,  133,  133,  129,
-        0,  134,  134,  134,  131,  130,  135,  135,  135,  136,
-      136,  136,  137,  137,  137,  138,  138,  138,  139,  139,
-
-      139,    0,  132,  140,  140,  140,    0,  133,  134,    0,
-      135,    0,    0,  138,  136,    0,    0,  136,    0,  137,
-      141,  141,  141,    0,  137,    0,  137,  142,  142,  142,
-      143,  143,  143,  144,  144,  144,    0,  145,  145,  145,
-        0,  140,  146,  146,  146,    0,  141,  143,  147,  147,
-      147,    0,  148,  148,  148,  149,  149,  149,  151,  151,
-      151,    0,    0,  142,  150,    0,  146,    0,  144,  145,
-      148,  149,  150,    0,  150,    0,    0,  150,    0,    0,
-      147,    0,    0,  150,  152,  152,  152,    0,  151,  154,
-      154,  154,  155,  155,  155,  156,  156,  156,    0,  152,
-
-      157,  157,  157,  154,  158,  158,  158,    0,  154,  156,
-        0,  159,  159,  159,  152,  160,  160,  160,  158,  155,
-        0,  154,  156,  161,  161,  161,  162,  162,  162,    0,
-      163,  163,  163,    0,  158,    0,    0,  160,  157,  159,
-      164,  164,  164,  165,  165,  165,  166,  166,  166,  161,
-        0,  162,  163,    0,  167,  167,  167,  169,  169,  169,
-      163,  168,  168,  168,  170,  170,  170,  171,  171,  171,
-        0,  165,  167,  164,  172,  172,  172,  164,  173,  173,
-      173,    0,    0,  166,  169,    0,  170,  168,  171,  174,
-      174,  174,  175,  175,  175,  176,  176,  176,    0,    0,
-
-      173,    0,  173,    0,  172,  177,  177,  177,    0,    0,
-      174,  207,  207,  207,  175,    0,  208,  208,  208,  225,
-      225,  225,  208,  207,  211,  211,    0,  176,  208,  226,
-      226,  226,  211,    0,  211,  208,  211,  177,  218,  218,
-        0,  218,  218,  218,  230,  230,  230,    0,    0,  233,
-      233,  233,    0,  218,  229,  229,  229,  211,  212,  212,
-      212,    0,  212,  212,  212,    0,  212,  212,  212,  233,
-      212,  230,  212,  212,  212,  212,  212,  212,  223,  223,
-      223,  224,  224,  224,  223,  229,  212,  224,    0,    0,
-      223,  212,    0,  224,  228,  228,  228,  223,    0,    0,
-
-      224,  231,  231,  231,    0,  232,  232,  232,  234,  234,
-      234,  235,  235,  235,  236,  236,  236,  238,  238,  238,
-        0,    0,  231,  232,    0,    0,  228,  237,  237,  237,
-        0,  231,    0,  232,    0,  234,    0,    0,  235,    0,
-        0,  237,  239,  239,  239,    0,  236,  237,  240,  240,
-      240,  241,  241,  241,  242,  242,  242,  243,  243,  243,
-      239,    0,  244,  244,  244,  245,  245,  245,  246,  246,
-      246,  247,  247,  247,    0,  240,  244,  248,  248,  248,
-        0,  243,    0,  245,    0,    0,  246,  247,  249,  249,
-      249,  242,  250,  250,  250,  251,  251,  251,    0,    0,
-
-      246,  252,  252,  252,  253,  253,  253,  254,  254,  254,
-      248,    0,  255,  255,  255,  256,  256,  256,    0,  250,
-      249,  254,  258,  258,  258,  251,  255,  257,  257,  257,
-        0,    0,  252,    0,    0,  253,  253,  259,  259,  259,
-      258,  257,  260,  260,  260,  261,  261,  261,  256,    0,
-      262,  262,  262,  263,  263,  263,    0,  260,  264,  264,
-      264,  265,  265,  265,  266,  266,  266,  259,  262,  267,
-      267,  267,  264,    0,    0,  261,    0,    0,  263,  268,
-      268,  268,  266,  269,  269,  269,    0,    0,  265,  270,
-      270,  270,    0,  268,  271,  271,  271,  269,    0,    0,
-
-      267,  272,  272,  272,  273,  273,  273,  270,    0,    0,
-      271,  274,  274,  274,  275,  275,  275,  276,  276,  276,
-      277,  277,  277,    0,    0,  273,    0,    0,  272,  278,
-      278,  278,    0,  279,  279,  279,    0,    0,  280,  280,
-      280,  275,    0,    0,  274,    0,    0,  277,    0,    0,
-      276,  279,  280,  281,  281,  281,  282,  282,  282,  283,
-      283,  283,  278,  284,  284,  284,    0,  281,  285,  285,
-      285,  286,  286,  286,  287,  287,  287,    0,    0,  283,
-      288,  288,  288,    0,    0,  284,  289,  289,  289,  290,
-      290,  290,    0,  282,    0,  287,    0,  291,  291,  291,
-
-        0,  285,    0,    0,  288,  292,  292,  292,  293,  293,
-      293,  294,  294,  294,  295,  295,  295,    0,    0,  290,
-      291,  296,  296,  296,    0,  292,  297,  297,  297,    0,
-        0,  295,  298,  298,  298,  299,  299,  299,  300,  300,
-      300,    0,  293,  294,  297,  296,  301,  301,  301,  302,
-      302,  302,  303,  303,  303,    0,  298,  304,  304,  304,
-      305,  305,  305,  306,  306,  306,  307,  307,  307,    0,
-        0,  300,    0,    0,  301,  304,  308,  308,  308,  302,
-        0,    0,  303,    0,  307,  306,  309,  309,  309,  310,
-      310,  310,  305,  311,  311,  311,  306,    0,  312,  312,
-
-      312,    0,  309,  313,  313,  313,    0,    0,  308,  314,
-      314,  314,  315,  315,  315,    0,    0,  310,  316,  316,
-      316,  313,    0,    0,  311,  312,  317,  317,  317,    0,
-      315,  318,  318,  318,  319,  319,  319,  320,  320,  320,
-      321,  321,  321,  322,  322,  322,    0,  324,  324,  324,
-      316,    0,  317,  323,  323,  323,    0,  325,  325,  325,
-      319,  324,    0,  318,  320,    0,    0,  321,    0,  320,
-      323,  325,    0,    0,  322,  326,  326,  326,    0,  327,
-      327,  327,  328,  328,  328,  330,  330,  330,  347,  347,
-      347,  330,  348,  348,  348,    0,    0,  330,    0,  326,
-
-      327,  354,  354,  354,  330,  349,  349,  349,  350,  350,
-      350,  348,  328,  335,  335,  335,    0,  335,  335,  335,
-        0,  335,  335,  335,    0,  335,  349,  335,  335,  335,
-      335,  335,  335,  354,  350,  351,  351,  351,  352,  352,
-      352,  335,  353,  353,  353,    0,  335,  355,  355,  355,
-        0,    0,  352,  356,  356,  356,    0,    0,  353,  357,
-      357,  357,  358,  358,  358,  351,  359,  359,  359,  360,
-      360,  360,  361,  361,  361,  355,  362,  362,  362,    0,
-      355,    0,    0,  356,  363,  363,  363,    0,    0,  357,
-        0,    0,  358,    0,    0,  360,    0,  359,  364,  364,
-
-      364,    0,  361,  365,  365,  365,  366,  366,  366,  367,
-      367,  367,  368,  368,  368,  369,  369,  369,  370,  370,
-      370,  371,  371,  371,    0,    0,  365,  372,  372,  372,
-      373,  373,  373,  370,    0,    0,  369,  374,  374,  374,
-        0,  372,  375,  375,  375,  376,  376,  376,  377,  377,
-      377,  378,  378,  378,    0,  379,  379,  379,  380,  380,
-      380,    0,  381,  381,  381,    0,    0,  376,  374,  382,
-      382,  382,  377,    0,  375,  379,  383,  383,  383,    0,
-        0,  378,  381,  384,  384,  384,    0,  382,  385,  385,
-      385,  380,    0,    0,  381,  386,  386,  386,    0,    0,
-
-      383,  387,  387,  387,    0,  384,  388,  388,  388,  389,
-      389,  389,  390,  390,  390,    0,  391,  391,  391,  392,
-      392,  392,  394,  394,  394,  387,    0,  393,  393,  393,
-      390,  395,  395,  395,    0,    0,  388,    0,    0,  389,
-      391,  393,    0,  396,  396,  396,  397,  397,  397,    0,
-        0,  392,    0,    0,  394,  396,  398,  398,  398,    0,
-        0,  397,  399,  399,  399,  400,  400,  400,    0,    0,
-      398,  401,  401,  401,  402,  402,  402,  403,  403,  403,
-        0,  404,  404,  404,  405,  405,  405,  406,  406,  406,
-      407,  407,  407,    0,  399,  400,  408,  408,  408,  409,
-
-      409,  409,    0,  401,  402,  404,    0,  403,  410,  410,
-      410,  411,  411,  411,    0,    0,  407,  412,  412,  412,
-      408,  413,  413,  413,  414,  414,  414,    0,    0,  409,
-        0,  412,  415,  415,  415,  416,  416,  416,  414,    0,
-        0,  411,  417,  417,  417,    0,  413,  418,  418,  418,
-      415,  419,  419,  419,  420,  420,  420,  416,  421,  421,
-      421,  422,  422,  422,  417,  423,  423,  423,  424,  424,
-      424,  425,  425,  425,    0,    0,  421,    0,    0,  422,
-      424,  426,  426,  426,  420,  424,  427,  427,  427,  428,
-      428,  428,    0,  425,    0,  424,    0,  423,  429,  429,
-
-      429,    0,  427,  430,  430,  430,    0,  426,  431,  431,
-      431,  432,  432,  432,  429,  433,  433,  433,    0,  428,
-      434,  434,  434,    0,  430,  435,  435,  435,  436,  436,
-      436,    0,  431,  437,  437,  437,  438,  438,  438,  439,
-      439,  439,  435,  440,  440,  440,  436,  435,    0,    0,
-      433,    0,  435,  441,  441,  441,  442,  442,  442,  439,
-      443,  443,  443,    0,    0,  437,  444,  444,  444,  440,
-      445,  445,  445,  446,  446,  446,  447,  447,  447,  448,
-      448,  448,  443,    0,    0,  441,  442,  449,  449,  449,
-      463,  463,  463,    0,  447,  456,  456,  456,  464,  464,
-
-      464,    0,  445,  446,  465,  465,  465,  456,  463,  449,
-        0,    0,  464,  466,  466,  466,  467,  467,  467,  468,
-      468,  468,  469,  469,  469,    0,  465,  470,  470,  470,
-        0,  466,  471,  471,  471,  472,  472,  472,  467,  473,
-      473,  473,  474,  474,  474,  475,  475,  475,  476,  476,
-      476,  468,  469,  477,  477,  477,  474,  471,    0,  470,
-      478,  478,  478,  479,  479,  479,  480,  480,  480,  481,
-      481,  481,  482,  482,  482,  483,  483,  483,  484,  484,
-      484,  485,  485,  485,    0,  477,  486,  486,  486,    0,
-      480,  487,  487,  487,  488,  488,  488,  489,  489,  489,
-
-        0,  481,    0,    0,  484,  490,  490,  490,  491,  491,
-      491,  489,  492,  492,  492,  493,  493,  493,  488,  494,
-      494,  494,    0,  490,  491,  495,  495,  495,    0,    0,
-      492,    0,  496,  496,  496,  497,  497,  497,  498,  498,
-      498,  493,  499,  499,  499,  500,  500,  500,    0,    0,
-      494,  501,  501,  501,  502,  502,  502,  495,  496,    0,
-        0,  500,  498,  503,  503,  503,  504,  504,  504,  505,
-      505,  505,    0,  501,  506,  506,  506,  507,  507,  507,
-      508,  508,  508,  505,    0,    0,  502,  503,  509,  509,
-      509,  510,  510,  510,  511,  511,  511,    0,  504,  508,
-
-      512,  512,  512,  513,  513,  513,  506,  514,  514,  514,
-      509,  515,  515,  515,  516,  516,  516,    0,  512,  517,
-      517,  517,  518,  518,  518,  519,  519,  519,  516,  514,
-      513,  515,  520,  520,  520,  521,  521,  521,  518,  522,
-      522,  522,    0,    0,  519,  523,  523,  523,  520,    0,
-        0,  517,  524,  524,  524,  525,  525,  525,  526,  526,
-      526,  521,  523,  527,  527,  527,    0,  528,  528,  528,
-      529,  529,  529,  530,  530,  530,  531,  531,  531,    0,
-      526,    0,  527,  528,  533,  533,  533,  525,    0,    0,
-      529,  532,  532,  532,  534,  534,  534,  535,  535,  535,
-
-      536,  536,  536,    0,    0,  530,    0,    0,  534,  537,
-      537,  537,  532,    0,  533,  538,  538,  538,  536,  539,
-      539,  539,  540,  540,  540,    0,  537,  541,  541,  541,
-      542,  542,  542,    0,  538,  543,  543,  543,  544,  544,
-      544,  545,  545,  545,  546,  546,  546,  547,  547,  547,
-      548,  548,  548,  543,  549,  549,  549,    0,    0,  547,
-      557,  557,  557,  559,  559,  559,  546,    0,  545,    0,
-      544,  558,  558,  558,  560,  560,  560,  561,  561,  561,
-      549,  552,  552,  552,  562,  562,  562,    0,  560,  552,
-        0,  552,    0,  552,    0,  559,  563,  563,  563,    0,
-
-        0,  558,    0,  552,  564,  564,  564,    0,    0,  561,
-        0,  562,    0,    0,  552,  565,  565,  565,    0,  566,
-      566,  566,  567,  567,  567,  568,  568,  568,  569,  569,
-      569,    0,    0,  565,  564,  566,  570,  570,  570,  571,
-      571,  571,    0,  568,  572,  572,  572,  573,  573,  573,
-      574,  574,  574,  575,  575,  575,    0,  576,  576,  576,
-      577,  577,  577,    0,  574,  578,  578,  578,    0,  570,
-        0,  571,  577,  579,  579,  579,  572,  576,  580,  580,
-      580,  581,  581,  581,  582,  582,  582,  583,  583,  583,
-      584,  584,  584,  585,  585,  585,    0,  586,  586,  586,
-
-        0,    0,  581,  587,  587,  587,    0,    0,  584,    0,
-        0,  582,  586,    0,    0,  580,  588,  588,  588,  589,
-      589,  589,  590,  590,  590,  591,  591,  591,    0,    0,
-      588,    0,    0,  589,  592,  592,  592,  593,  593,  593,
-      594,  594,  594,  595,  595,  595,  596,  596,  596,    0,
-        0,  592,  597,  597,  597,  593,  598,  598,  598,    0,
-      591,  595,  599,  599,  599,  600,  600,  600,  601,  601,
-      601,  597,  602,  602,  602,  603,  603,  603,  596,  604,
-      604,  604,  605,  605,  605,  606,  606,  606,  607,  607,
-      607,  602,  608,  608,  608,  609,  609,  609,  610,  610,
-
-      610,  611,  611,  611,  612,  612,  612,  613,  613,  613,
-      614,  614,  614,  615,  615,  615,    0,  610,    0,  608,
-      616,  616,  616,  617,  617,  617,    0,  609,  618,  618,
-      618,  619,  619,  619,  620,  620,  620,    0,  613,  615,
-      628,  628,  628,  619,  616,    0,  620,    0,  618,  629,
-      629,  629,  630,  630,  630,  617,    0,    0,  628,  631,
-      631,  631,  632,  632,  632,  633,  633,  633,    0,  630,
-      634,  634,  634,  635,  635,  635,  629,  636,  636,  636,
-      637,  637,  637,  638,  638,  638,  639,  639,  639,    0,
-      631,    0,  632,  640,  640,  640,  634,    0,  637,  641,
-
-      641,  641,    0,    0,  639,  635,  642,  642,  642,  643,
-      643,  643,  644,  644,  644,  645,  645,  645,  646,  646,
-      646,  647,  647,  647,  644,  640,  648,  648,  648,  649,
-      649,  649,  650,  650,  650,  651,  651,  651,  642,    0,
-        0,  645,  648,    0,    0,  647,  652,  652,  652,  653,
-      653,  653,    0,  651,    0,  649,  654,  654,  654,  655,
-      655,  655,  656,  656,  656,  657,  657,  657,  658,  658,
-      658,  655,    0,    0,  654,  659,  659,  659,  660,  660,
-      660,  656,  661,  661,  661,    0,  658,  662,  662,  662,
-        0,  657,  663,  663,  663,  664,  664,  664,  672,  672,
-
-      672,  673,  673,  673,    0,  662,  674,  674,  674,    0,
-      660,  665,  665,  665,    0,  672,  675,  675,  675,  665,
-        0,  665,    0,  665,  676,  676,  676,  677,  677,  677,
-        0,  673,    0,  665,  678,  678,  678,  679,  679,  679,
-      680,  680,  680,    0,  665,  666,  666,  666,  681,  681,
-      681,    0,    0,  666,    0,  666,    0,  666,    0,  677,
-      682,  682,  682,  683,  683,  683,  681,  666,  684,  684,
-      684,  685,  685,  685,  686,  686,  686,    0,  666,  687,
-      687,  687,  688,  688,  688,  689,  689,  689,    0,  685,
-        0,    0,  686,  683,  690,  690,  690,  691,  691,  691,
-
-        0,    0,  689,  692,  692,  692,  693,  693,  693,  691,
-        0,  687,  694,  694,  694,  695,  695,  695,  703,  703,
-      703,  704,  704,  704,    0,  692,  690,  705,  705,  705,
-      706,  706,  706,  707,  707,  707,  708,  708,  708,  709,
-      709,  709,  710,  710,  710,    0,    0,  706,  711,  711,
-      711,  707,  712,  712,  712,  713,  713,  713,  705,  714,
-      714,  714,  719,  719,  719,  720,  720,  720,  721,  721,
-      721,  722,  722,  722,  723,  723,  723,  724,  724,  724,
-        0,  725,  725,  725,  726,  726,  726,  713,  727,  727,
-      727,    0,  723,    0,    0,  724,    0,  714,  725,  728,
-
-      728,  728,  721,  729,  729,  729,  730,  730,  730,    0,
-        0,    0,    0,    0,  726,    0,    0,    0,    0,    0,
-        0,  729,    0,    0,    0,    0,    0,    0,    0,    0,
-      728,  732,  732,  732,  732,  732,  732,  732,  732,  732,
-      732,  733,  733,  733,  733,  733,  733,  733,  733,  733,
-      733,  734,  734,  734,  734,  734,  734,  734,  734,  734,
-      734,  735,  735,  735,  735,  735,  735,  735,  735,  735,
-      735,  736,  736,  736,  736,  736,  736,  736,  736,  736,
-      736,  737,  737,  738,    0,  738,  738,  738,  738,  738,
-      738,  738,  738,  739,  739,  739,  740,    0,    0,  740,
-
-        0,  740,  740,  740,  740,  740,  741,    0,    0,  741,
-      741,  741,  741,  741,  741,  741,  742,    0,    0,  742,
-      742,    0,  742,  742,  742,  742,  743,    0,    0,  743,
-      743,  743,  743,  743,  743,  743,  744,    0,    0,  744,
-      744,  744,  744,  744,  744,  744,  745,    0,    0,    0,
-      745,  745,  745,  745,  745,  745,  746,    0,    0,    0,
-      746,  746,  746,  746,  746,  746,  747,    0,    0,  747,
-      747,  747,  747,  747,  747,  748,    0,  748,  748,  748,
-      748,  748,  748,  748,  748,  749,    0,    0,  749,  749,
-      749,  749,  749,  749,  749,  750,  750,  751,  751,  751,
-
-      752,    0,  752,  752,  752,  752,  752,  752,  752,  752,
-      753,  753,  731,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731,  731,  731,  731,  731,  731,  731,  731,
-      731,  731,  731
-    } ;
-
-static yy_state_type yy_last_accepting_state;
-static char *yy_last_accepting_cpos;
-
-extern int d__flex_debug;
-int d__flex_debug = 0;
-
-/* The intent behind this definition is that it'll catch
- * any uses of REJECT which flex missed.
- */
-#define REJECT reject_used_but_not_detected
-#define yymore() yymore_used_but_not_detected
-#define YY_MORE_ADJ 0
-#define YY_RESTORE_YY_MORE_OFFSET
-char *d_text;
-#line 1 "dlexer.l"
-#line 13 "dlexer.l"
-
-#include <stdio.h>
-#include "tokenizer.h"
-
-int nesting_level;
-
-
-
-
-
-#line 1431 "dlexer.c"
-
-#define INITIAL 0
-#define comment 1
-#define nesting_comment 2
-#define string_literal 3
-#define wysiwyg_literal 4
-#define alt_wysiwyg_literal 5
-
-#ifndef YY_NO_UNISTD_H
-/* Special case for "unistd.h", since it is non-ANSI. We include it way
- * down here because we want the user's section 1 to have been scanned first.
- * The user has a chance to override it with an option.
- */
-#include <unistd.h>
-#endif
-
-#ifndef YY_EXTRA_TYPE
-#define YY_EXTRA_TYPE void *
-#endif
-
-static int yy_init_globals (void );
-
-/* Accessor methods to globals.
-   These are made visible to non-reentrant scanners for convenience. */
-
-int d_lex_destroy (void );
-
-int d_get_debug (void );
-
-void d_set_debug (int debug_flag  );
-
-YY_EXTRA_TYPE d_get_extra (void );
-
-void d_set_extra (YY_EXTRA_TYPE user_defined  );
-
-FILE *d_get_in (void );
-
-void d_set_in  (FILE * in_str  );
-
-FILE *d_get_out (void );
-
-void d_set_out  (FILE * out_str  );
-
-int d_get_leng (void );
-
-char *d_get_text (void );
-
-int d_get_lineno (void );
-
-void d_set_lineno (int line_number  );
-
-/* Macros after this point can all be overridden by user definitions in
- * section 1.
- */
-
-#ifndef YY_SKIP_YYWRAP
-#ifdef __cplusplus
-extern "C" int d_wrap (void );
-#else
-extern int d_wrap (void );
-#endif
-#endif
-
-    static void yyunput (int c,char *buf_ptr  );
-    
-#ifndef yytext_ptr
-static void yy_flex_strncpy (char *,yyconst char *,int );
-#endif
-
-#ifdef YY_NEED_STRLEN
-static int yy_flex_strlen (yyconst char * );
-#endif
-
-#ifndef YY_NO_INPUT
-
-#ifdef __cplusplus
-static int yyinput (void );
-#else
-static int input (void );
-#endif
-
-#endif
-
-/* Amount of stuff to slurp up with each read. */
-#ifndef YY_READ_BUF_SIZE
-#ifdef __ia64__
-/* On IA-64, the buffer size is 16k, not 8k */
-#define YY_READ_BUF_SIZE 16384
-#else
-#define YY_READ_BUF_SIZE 8192
-#endif /* __ia64__ */
-#endif
-
-/* Copy whatever the last rule matched to the standard output. */
-#ifndef ECHO
-/* This used to be an fputs(), but since the string might contain NUL's,
- * we now use fwrite().
- */
-#define ECHO do { if (fwrite( d_text, d_leng, 1, d_out )) {} } while (0)
-#endif
-
-/* Gets input and stuffs it into "buf".  number of characters read, or YY_NULL,
- * is returned in "result".
- */
-#ifndef YY_INPUT
-#define YY_INPUT(buf,result,max_size) \
-	if ( YY_CURRENT_BUFFER_LVALUE->yy_is_interactive ) \
-		{ \
-		int c = '*'; \
-		size_t n; \
-		for ( n = 0; n < max_size && \
-			     (c = getc( d_in )) != EOF && c != '\n'; ++n ) \
-			buf[n] = (char) c; \
-		if ( c == '\n' ) \
-			buf[n++] = (char) c; \
-		if ( c == EOF && ferror( d_in ) ) \
-			YY_FATAL_ERROR( "input in flex scanner failed" ); \
-		result = n; \
-		} \
-	else \
-		{ \
-		errno=0; \
-		while ( (result = fread(buf, 1, max_size, d_in))==0 && ferror(d_in)) \
-			{ \
-			if( errno != EINTR) \
-				{ \
-				YY_FATAL_ERROR( "input in flex scanner failed" ); \
-				break; \
-				} \
-			errno=0; \
-			clearerr(d_in); \
-			} \
-		}\
-\
-
-#endif
-
-/* No semi-colon after return; correct usage is to write "yyterminate();" -
- * we don't want an extra ';' after the "return" because that will cause
- * some compilers to complain about unreachable statements.
- */
-#ifndef yyterminate
-#define yyterminate() return YY_NULL
-#endif
-
-/* Number of entries by which start-condition stack grows. */
-#ifndef YY_START_STACK_INCR
-#define YY_START_STACK_INCR 25
-#endif
-
-/* Report a fatal error. */
-#ifndef YY_FATAL_ERROR
-#define YY_FATAL_ERROR(msg) yy_fatal_error( msg )
-#endif
-
-/* end tables serialization structures and prototypes */
-
-/* Default declaration of generated scanner - a define so the user can
- * easily add parameters.
- */
-#ifndef YY_DECL
-#define YY_DECL_IS_OURS 1
-
-extern int d_lex (void);
-
-#define YY_DECL int d_lex (void)
-#endif /* !YY_DECL */
-
-/* Code executed at the beginning of each rule, after d_text and d_leng
- * have been set up.
- */
-#ifndef YY_USER_ACTION
-#define YY_USER_ACTION
-#endif
-
-/* Code executed at the end of each rule. */
-#ifndef YY_BREAK
-#define YY_BREAK break;
-#endif
-
-#define YY_RULE_SETUP \
-	YY_USER_ACTION
-
-/** The main scanner function which does all the work.
- */
-YY_DECL
-{
-	register yy_state_type yy_current_state;
-	register char *yy_cp, *yy_bp;
-	register int yy_act;
-    
-#line 26 "dlexer.l"
-
-#line 1625 "dlexer.c"
-
-	if ( !(yy_init) )
-		{
-		(yy_init) = 1;
-
-#ifdef YY_USER_INIT
-		YY_USER_INIT;
-#endif
-
-		if ( ! (yy_start) )
-			(yy_start) = 1;	/* first start state */
-
-		if ( ! d_in )
-			d_in = stdin;
-
-		if ( ! d_out )
-			d_out = stdout;
-
-		if ( ! YY_CURRENT_BUFFER ) {
-			d_ensure_buffer_stack ();
-			YY_CURRENT_BUFFER_LVALUE =
-				d__create_buffer(d_in,YY_BUF_SIZE );
-		}
-
-		d__load_buffer_state( );
-		}
-
-	while ( 1 )		/* loops until end-of-file is reached */
-		{
-		yy_cp = (yy_c_buf_p);
-
-		/* Support of d_text. */
-		*yy_cp = (yy_hold_char);
-
-		/* yy_bp points to the position in yy_ch_buf of the start of
-		 * the current run.
-		 */
-		yy_bp = yy_cp;
-
-		yy_current_state = (yy_start);
-yy_match:
-		do
-			{
-			register YY_CHAR yy_c = yy_ec[YY_SC_TO_UI(*yy_cp)];
-			if ( yy_accept[yy_current_state] )
-				{
-				(yy_last_accepting_state) = yy_current_state;
-				(yy_last_accepting_cpos) = yy_cp;
-				}
-			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
-				{
-				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 732 )
-					yy_c = yy_meta[(unsigned int) yy_c];
-				}
-			yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-			++yy_cp;
-			}
-		while ( yy_base[yy_current_state] != 3113 );
-
-yy_find_action:
-		yy_act = yy_accept[yy_current_state];
-		if ( yy_act == 0 )
-			{ /* have to back up */
-			yy_cp = (yy_last_accepting_cpos);
-			yy_current_state = (yy_last_accepting_state);
-			yy_act = yy_accept[yy_current_state];
-			}
-
-		YY_DO_BEFORE_ACTION;
-
-do_action:	/* This label is used only to access EOF actions. */
-
-		switch ( yy_act )
-	{ /* beginning of action switch */
-			case 0: /* must back up */
-			/* undo the effects of YY_DO_BEFORE_ACTION */
-			*yy_cp = (yy_hold_char);
-			yy_cp = (yy_last_accepting_cpos);
-			yy_current_state = (yy_last_accepting_state);
-			goto yy_find_action;
-
-case 1:
-YY_RULE_SETUP
-#line 27 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 2:
-YY_RULE_SETUP
-#line 28 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 3:
-YY_RULE_SETUP
-#line 29 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 4:
-YY_RULE_SETUP
-#line 30 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 5:
-YY_RULE_SETUP
-#line 31 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 6:
-YY_RULE_SETUP
-#line 32 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 7:
-YY_RULE_SETUP
-#line 33 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 8:
-YY_RULE_SETUP
-#line 34 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 9:
-YY_RULE_SETUP
-#line 35 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 10:
-YY_RULE_SETUP
-#line 36 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 11:
-YY_RULE_SETUP
-#line 37 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 12:
-YY_RULE_SETUP
-#line 38 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 13:
-YY_RULE_SETUP
-#line 39 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 14:
-YY_RULE_SETUP
-#line 40 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 15:
-YY_RULE_SETUP
-#line 41 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 16:
-YY_RULE_SETUP
-#line 42 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 17:
-YY_RULE_SETUP
-#line 43 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 18:
-YY_RULE_SETUP
-#line 44 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 19:
-YY_RULE_SETUP
-#line 45 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 20:
-YY_RULE_SETUP
-#line 46 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 21:
-YY_RULE_SETUP
-#line 47 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 22:
-YY_RULE_SETUP
-#line 48 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 23:
-YY_RULE_SETUP
-#line 49 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 24:
-YY_RULE_SETUP
-#line 50 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 25:
-YY_RULE_SETUP
-#line 51 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 26:
-YY_RULE_SETUP
-#line 52 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 27:
-YY_RULE_SETUP
-#line 53 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 28:
-YY_RULE_SETUP
-#line 54 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 29:
-YY_RULE_SETUP
-#line 55 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 30:
-YY_RULE_SETUP
-#line 56 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 31:
-YY_RULE_SETUP
-#line 57 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 32:
-YY_RULE_SETUP
-#line 58 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 33:
-YY_RULE_SETUP
-#line 59 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 34:
-YY_RULE_SETUP
-#line 60 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 35:
-YY_RULE_SETUP
-#line 61 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 36:
-YY_RULE_SETUP
-#line 62 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 37:
-YY_RULE_SETUP
-#line 63 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 38:
-YY_RULE_SETUP
-#line 64 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 39:
-YY_RULE_SETUP
-#line 65 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 40:
-YY_RULE_SETUP
-#line 66 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 41:
-YY_RULE_SETUP
-#line 67 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 42:
-YY_RULE_SETUP
-#line 68 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 43:
-YY_RULE_SETUP
-#line 69 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 44:
-YY_RULE_SETUP
-#line 70 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 45:
-YY_RULE_SETUP
-#line 71 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 46:
-YY_RULE_SETUP
-#line 72 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 47:
-YY_RULE_SETUP
-#line 73 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 48:
-YY_RULE_SETUP
-#line 74 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 49:
-YY_RULE_SETUP
-#line 75 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 50:
-YY_RULE_SETUP
-#line 76 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 51:
-YY_RULE_SETUP
-#line 77 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 52:
-YY_RULE_SETUP
-#line 78 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 53:
-YY_RULE_SETUP
-#line 79 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 54:
-YY_RULE_SETUP
-#line 80 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 55:
-YY_RULE_SETUP
-#line 81 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 56:
-YY_RULE_SETUP
-#line 82 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 57:
-YY_RULE_SETUP
-#line 83 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 58:
-YY_RULE_SETUP
-#line 84 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 59:
-YY_RULE_SETUP
-#line 85 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 60:
-YY_RULE_SETUP
-#line 86 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 61:
-YY_RULE_SETUP
-#line 87 "dlexer.l"
-{ return(TOKENIZER_TYPE); }
-	YY_BREAK
-case 62:
-YY_RULE_SETUP
-#line 89 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 63:
-YY_RULE_SETUP
-#line 90 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 64:
-YY_RULE_SETUP
-#line 91 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 65:
-YY_RULE_SETUP
-#line 92 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 66:
-YY_RULE_SETUP
-#line 93 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 67:
-YY_RULE_SETUP
-#line 94 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 68:
-YY_RULE_SETUP
-#line 95 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 69:
-YY_RULE_SETUP
-#line 96 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 70:
-YY_RULE_SETUP
-#line 97 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 71:
-YY_RULE_SETUP
-#line 98 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 72:
-YY_RULE_SETUP
-#line 99 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 73:
-YY_RULE_SETUP
-#line 100 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 74:
-YY_RULE_SETUP
-#line 101 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 75:
-YY_RULE_SETUP
-#line 102 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 76:
-YY_RULE_SETUP
-#line 103 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 77:
-YY_RULE_SETUP
-#line 104 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 78:
-YY_RULE_SETUP
-#line 105 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 79:
-YY_RULE_SETUP
-#line 106 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 80:
-YY_RULE_SETUP
-#line 107 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 81:
-YY_RULE_SETUP
-#line 108 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 82:
-YY_RULE_SETUP
-#line 109 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 83:
-YY_RULE_SETUP
-#line 110 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 84:
-YY_RULE_SETUP
-#line 111 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 85:
-YY_RULE_SETUP
-#line 112 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 86:
-YY_RULE_SETUP
-#line 113 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 87:
-YY_RULE_SETUP
-#line 114 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 88:
-YY_RULE_SETUP
-#line 115 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 89:
-YY_RULE_SETUP
-#line 116 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 90:
-YY_RULE_SETUP
-#line 117 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 91:
-YY_RULE_SETUP
-#line 118 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 92:
-YY_RULE_SETUP
-#line 119 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 93:
-YY_RULE_SETUP
-#line 120 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 94:
-YY_RULE_SETUP
-#line 121 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 95:
-YY_RULE_SETUP
-#line 122 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 96:
-YY_RULE_SETUP
-#line 123 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 97:
-YY_RULE_SETUP
-#line 124 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 98:
-YY_RULE_SETUP
-#line 125 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 99:
-YY_RULE_SETUP
-#line 126 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 100:
-YY_RULE_SETUP
-#line 127 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 101:
-YY_RULE_SETUP
-#line 128 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 102:
-YY_RULE_SETUP
-#line 129 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 103:
-YY_RULE_SETUP
-#line 130 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 104:
-YY_RULE_SETUP
-#line 131 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 105:
-YY_RULE_SETUP
-#line 132 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 106:
-YY_RULE_SETUP
-#line 133 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 107:
-YY_RULE_SETUP
-#line 134 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 108:
-YY_RULE_SETUP
-#line 135 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 109:
-YY_RULE_SETUP
-#line 136 "dlexer.l"
-{ return(TOKENIZER_KEYWORD); }
-	YY_BREAK
-case 110:
-YY_RULE_SETUP
-#line 138 "dlexer.l"
-{ BEGIN(comment);     return(TOKENIZER_COMMENT); }
-	YY_BREAK
-case 111:
-YY_RULE_SETUP
-#line 139 "dlexer.l"
-{ return(TOKENIZER_COMMENT); }
-	YY_BREAK
-case 112:
-YY_RULE_SETUP
-#line 140 "dlexer.l"
-{ return(TOKENIZER_COMMENT); }
-	YY_BREAK
-case 113:
-/* rule 113 can match eol */
-YY_RULE_SETUP
-#line 141 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 114:
-YY_RULE_SETUP
-#line 142 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 115:
-/* rule 115 can match eol */
-YY_RULE_SETUP
-#line 143 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 116:
-YY_RULE_SETUP
-#line 144 "dlexer.l"
-{ BEGIN(INITIAL);     return(TOKENIZER_COMMENT); }
-	YY_BREAK
-case 117:
-YY_RULE_SETUP
-#line 146 "dlexer.l"
-{ BEGIN(nesting_comment); nesting_level = (0); return(TOKENIZER_COMMENT); }
-	YY_BREAK
-case 118:
-YY_RULE_SETUP
-#line 147 "dlexer.l"
-{ return(TOKENIZER_COMMENT); }
-	YY_BREAK
-case 119:
-YY_RULE_SETUP
-#line 148 "dlexer.l"
-{ return(TOKENIZER_COMMENT); }
-	YY_BREAK
-case 120:
-YY_RULE_SETUP
-#line 149 "dlexer.l"
-{ return(TOKENIZER_COMMENT); }
-	YY_BREAK
-case 121:
-YY_RULE_SETUP
-#line 150 "dlexer.l"
-{ nesting_level++; return(TOKENIZER_COMMENT); }
-	YY_BREAK
-case 122:
-/* rule 122 can match eol */
-YY_RULE_SETUP
-#line 151 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 123:
-YY_RULE_SETUP
-#line 152 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 124:
-/* rule 124 can match eol */
-YY_RULE_SETUP
-#line 153 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 125:
-YY_RULE_SETUP
-#line 154 "dlexer.l"
-{ if (nesting_level-- == 0) BEGIN(INITIAL);  return(TOKENIZER_COMMENT); }
-	YY_BREAK
-case 126:
-YY_RULE_SETUP
-#line 156 "dlexer.l"
-{ return(TOKENIZER_COMMENT); }
-	YY_BREAK
-case 127:
-YY_RULE_SETUP
-#line 158 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 128:
-YY_RULE_SETUP
-#line 159 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 129:
-YY_RULE_SETUP
-#line 160 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 130:
-YY_RULE_SETUP
-#line 161 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 131:
-YY_RULE_SETUP
-#line 162 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 132:
-YY_RULE_SETUP
-#line 163 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 133:
-YY_RULE_SETUP
-#line 164 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 134:
-YY_RULE_SETUP
-#line 165 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 135:
-YY_RULE_SETUP
-#line 166 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 136:
-YY_RULE_SETUP
-#line 167 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 137:
-YY_RULE_SETUP
-#line 168 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 138:
-YY_RULE_SETUP
-#line 169 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 139:
-YY_RULE_SETUP
-#line 170 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 140:
-YY_RULE_SETUP
-#line 171 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 141:
-YY_RULE_SETUP
-#line 172 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 142:
-YY_RULE_SETUP
-#line 173 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 143:
-YY_RULE_SETUP
-#line 174 "dlexer.l"
-{ return(TOKENIZER_DIRECTIVE); }
-	YY_BREAK
-case 144:
-YY_RULE_SETUP
-#line 177 "dlexer.l"
-{ BEGIN(string_literal);     return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 145:
-YY_RULE_SETUP
-#line 178 "dlexer.l"
-{ BEGIN(string_literal);     return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 146:
-YY_RULE_SETUP
-#line 179 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 147:
-/* rule 147 can match eol */
-YY_RULE_SETUP
-#line 180 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 148:
-YY_RULE_SETUP
-#line 181 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 149:
-/* rule 149 can match eol */
-YY_RULE_SETUP
-#line 182 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 150:
-YY_RULE_SETUP
-#line 183 "dlexer.l"
-{ BEGIN(INITIAL);            return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 151:
-YY_RULE_SETUP
-#line 184 "dlexer.l"
-{ BEGIN(INITIAL);            return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 152:
-YY_RULE_SETUP
-#line 186 "dlexer.l"
-{ BEGIN(wysiwyg_literal);    return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 153:
-YY_RULE_SETUP
-#line 187 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 154:
-/* rule 154 can match eol */
-YY_RULE_SETUP
-#line 188 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 155:
-YY_RULE_SETUP
-#line 189 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 156:
-/* rule 156 can match eol */
-YY_RULE_SETUP
-#line 190 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 157:
-YY_RULE_SETUP
-#line 191 "dlexer.l"
-{ BEGIN(INITIAL);            return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 158:
-YY_RULE_SETUP
-#line 192 "dlexer.l"
-{ BEGIN(INITIAL);            return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 159:
-YY_RULE_SETUP
-#line 194 "dlexer.l"
-{ BEGIN(alt_wysiwyg_literal);    return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 160:
-YY_RULE_SETUP
-#line 195 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 161:
-/* rule 161 can match eol */
-YY_RULE_SETUP
-#line 196 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 162:
-YY_RULE_SETUP
-#line 197 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 163:
-/* rule 163 can match eol */
-YY_RULE_SETUP
-#line 198 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 164:
-YY_RULE_SETUP
-#line 199 "dlexer.l"
-{ BEGIN(INITIAL);            return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 165:
-YY_RULE_SETUP
-#line 200 "dlexer.l"
-{ BEGIN(INITIAL);            return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 166:
-YY_RULE_SETUP
-#line 203 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 167:
-YY_RULE_SETUP
-#line 204 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 168:
-YY_RULE_SETUP
-#line 205 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 169:
-YY_RULE_SETUP
-#line 206 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 170:
-YY_RULE_SETUP
-#line 207 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 171:
-YY_RULE_SETUP
-#line 208 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 172:
-YY_RULE_SETUP
-#line 209 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 173:
-YY_RULE_SETUP
-#line 210 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 174:
-YY_RULE_SETUP
-#line 211 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 175:
-YY_RULE_SETUP
-#line 212 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 176:
-YY_RULE_SETUP
-#line 213 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 177:
-YY_RULE_SETUP
-#line 215 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 178:
-YY_RULE_SETUP
-#line 216 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 179:
-YY_RULE_SETUP
-#line 217 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 180:
-YY_RULE_SETUP
-#line 218 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 181:
-YY_RULE_SETUP
-#line 219 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 182:
-YY_RULE_SETUP
-#line 221 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 183:
-YY_RULE_SETUP
-#line 222 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 184:
-YY_RULE_SETUP
-#line 223 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 185:
-YY_RULE_SETUP
-#line 224 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 186:
-YY_RULE_SETUP
-#line 225 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 187:
-YY_RULE_SETUP
-#line 226 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 188:
-YY_RULE_SETUP
-#line 227 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 189:
-YY_RULE_SETUP
-#line 228 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 190:
-YY_RULE_SETUP
-#line 229 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 191:
-YY_RULE_SETUP
-#line 230 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 192:
-YY_RULE_SETUP
-#line 231 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 193:
-YY_RULE_SETUP
-#line 232 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 194:
-YY_RULE_SETUP
-#line 233 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 195:
-YY_RULE_SETUP
-#line 234 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 196:
-YY_RULE_SETUP
-#line 235 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 197:
-YY_RULE_SETUP
-#line 236 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 198:
-YY_RULE_SETUP
-#line 237 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 199:
-YY_RULE_SETUP
-#line 239 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 200:
-YY_RULE_SETUP
-#line 240 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 201:
-YY_RULE_SETUP
-#line 241 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 202:
-YY_RULE_SETUP
-#line 242 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 203:
-YY_RULE_SETUP
-#line 243 "dlexer.l"
-{ return(TOKENIZER_LITERAL); }
-	YY_BREAK
-case 204:
-/* rule 204 can match eol */
-YY_RULE_SETUP
-#line 245 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 205:
-/* rule 205 can match eol */
-YY_RULE_SETUP
-#line 246 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 206:
-YY_RULE_SETUP
-#line 247 "dlexer.l"
-{ return(TOKENIZER_NEWLINE); }
-	YY_BREAK
-case 207:
-YY_RULE_SETUP
-#line 248 "dlexer.l"
-{ return(TOKENIZER_TEXT);    }
-	YY_BREAK
-case 208:
-YY_RULE_SETUP
-#line 249 "dlexer.l"
-{ return(TOKENIZER_TEXT);    }
-	YY_BREAK
-case 209:
-YY_RULE_SETUP
-#line 250 "dlexer.l"
-{ return(TOKENIZER_TEXT);    }
-	YY_BREAK
-case 210:
-YY_RULE_SETUP
-#line 252 "dlexer.l"
-ECHO;
-	YY_BREAK
-#line 2770 "dlexer.c"
-case YY_STATE_EOF(INITIAL):
-case YY_STATE_EOF(comment):
-case YY_STATE_EOF(nesting_comment):
-case YY_STATE_EOF(string_literal):
-case YY_STATE_EOF(wysiwyg_literal):
-case YY_STATE_EOF(alt_wysiwyg_literal):
-	yyterminate();
-
-	case YY_END_OF_BUFFER:
-		{
-		/* Amount of text matched not including the EOB char. */
-		int yy_amount_of_matched_text = (int) (yy_cp - (yytext_ptr)) - 1;
-
-		/* Undo the effects of YY_DO_BEFORE_ACTION. */
-		*yy_cp = (yy_hold_char);
-		YY_RESTORE_YY_MORE_OFFSET
-
-		if ( YY_CURRENT_BUFFER_LVALUE->yy_buffer_status == YY_BUFFER_NEW )
-			{
-			/* We're scanning a new file or input source.  It's
-			 * possible that this happened because the user
-			 * just pointed d_in at a new source and called
-			 * d_lex().  If so, then we have to assure
-			 * consistency between YY_CURRENT_BUFFER and our
-			 * globals.  Here is the right place to do so, because
-			 * this is the first action (other than possibly a
-			 * back-up) that will match for the new input source.
-			 */
-			(yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
-			YY_CURRENT_BUFFER_LVALUE->yy_input_file = d_in;
-			YY_CURRENT_BUFFER_LVALUE->yy_buffer_status = YY_BUFFER_NORMAL;
-			}
-
-		/* Note that here we test for yy_c_buf_p "<=" to the position
-		 * of the first EOB in the buffer, since yy_c_buf_p will
-		 * already have been incremented past the NUL character
-		 * (since all states make transitions on EOB to the
-		 * end-of-buffer state).  Contrast this with the test
-		 * in input().
-		 */
-		if ( (yy_c_buf_p) <= &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] )
-			{ /* This was really a NUL. */
-			yy_state_type yy_next_state;
-
-			(yy_c_buf_p) = (yytext_ptr) + yy_amount_of_matched_text;
-
-			yy_current_state = yy_get_previous_state(  );
-
-			/* Okay, we're now positioned to make the NUL
-			 * transition.  We couldn't have
-			 * yy_get_previous_state() go ahead and do it
-			 * for us because it doesn't know how to deal
-			 * with the possibility of jamming (and we don't
-			 * want to build jamming into it because then it
-			 * will run more slowly).
-			 */
-
-			yy_next_state = yy_try_NUL_trans( yy_current_state );
-
-			yy_bp = (yytext_ptr) + YY_MORE_ADJ;
-
-			if ( yy_next_state )
-				{
-				/* Consume the NUL. */
-				yy_cp = ++(yy_c_buf_p);
-				yy_current_state = yy_next_state;
-				goto yy_match;
-				}
-
-			else
-				{
-				yy_cp = (yy_c_buf_p);
-				goto yy_find_action;
-				}
-			}
-
-		else switch ( yy_get_next_buffer(  ) )
-			{
-			case EOB_ACT_END_OF_FILE:
-				{
-				(yy_did_buffer_switch_on_eof) = 0;
-
-				if ( d_wrap( ) )
-					{
-					/* Note: because we've taken care in
-					 * yy_get_next_buffer() to have set up
-					 * d_text, we can now set up
-					 * yy_c_buf_p so that if some total
-					 * hoser (like flex itself) wants to
-					 * call the scanner after we return the
-					 * YY_NULL, it'll still work - another
-					 * YY_NULL will get returned.
-					 */
-					(yy_c_buf_p) = (yytext_ptr) + YY_MORE_ADJ;
-
-					yy_act = YY_STATE_EOF(YY_START);
-					goto do_action;
-					}
-
-				else
-					{
-					if ( ! (yy_did_buffer_switch_on_eof) )
-						YY_NEW_FILE;
-					}
-				break;
-				}
-
-			case EOB_ACT_CONTINUE_SCAN:
-				(yy_c_buf_p) =
-					(yytext_ptr) + yy_amount_of_matched_text;
-
-				yy_current_state = yy_get_previous_state(  );
-
-				yy_cp = (yy_c_buf_p);
-				yy_bp = (yytext_ptr) + YY_MORE_ADJ;
-				goto yy_match;
-
-			case EOB_ACT_LAST_MATCH:
-				(yy_c_buf_p) =
-				&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)];
-
-				yy_current_state = yy_get_previous_state(  );
-
-				yy_cp = (yy_c_buf_p);
-				yy_bp = (yytext_ptr) + YY_MORE_ADJ;
-				goto yy_find_action;
-			}
-		break;
-		}
-
-	default:
-		YY_FATAL_ERROR(
-			"fatal flex scanner internal error--no action found" );
-	} /* end of action switch */
-		} /* end of scanning one token */
-} /* end of d_lex */
-
-/* yy_get_next_buffer - try to read in a new buffer
- *
- * Returns a code representing an action:
- *	EOB_ACT_LAST_MATCH -
- *	EOB_ACT_CONTINUE_SCAN - continue scanning from current position
- *	EOB_ACT_END_OF_FILE - end of file
- */
-static int yy_get_next_buffer (void)
-{
-    	register char *dest = YY_CURRENT_BUFFER_LVALUE->yy_ch_buf;
-	register char *source = (yytext_ptr);
-	register int number_to_move, i;
-	int ret_val;
-
-	if ( (yy_c_buf_p) > &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars) + 1] )
-		YY_FATAL_ERROR(
-		"fatal flex scanner internal error--end of buffer missed" );
-
-	if ( YY_CURRENT_BUFFER_LVALUE->yy_fill_buffer == 0 )
-		{ /* Don't try to fill the buffer, so this is an EOF. */
-		if ( (yy_c_buf_p) - (yytext_ptr) - YY_MORE_ADJ == 1 )
-			{
-			/* We matched a single character, the EOB, so
-			 * treat this as a final EOF.
-			 */
-			return EOB_ACT_END_OF_FILE;
-			}
-
-		else
-			{
-			/* We matched some text prior to the EOB, first
-			 * process it.
-			 */
-			return EOB_ACT_LAST_MATCH;
-			}
-		}
-
-	/* Try to read more data. */
-
-	/* First move last chars to start of buffer. */
-	number_to_move = (int) ((yy_c_buf_p) - (yytext_ptr)) - 1;
-
-	for ( i = 0; i < number_to_move; ++i )
-		*(dest++) = *(source++);
-
-	if ( YY_CURRENT_BUFFER_LVALUE->yy_buffer_status == YY_BUFFER_EOF_PENDING )
-		/* don't do the read, it's not guaranteed to return an EOF,
-		 * just force an EOF
-		 */
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars) = 0;
-
-	else
-		{
-			int num_to_read =
-			YY_CURRENT_BUFFER_LVALUE->yy_buf_size - number_to_move - 1;
-
-		while ( num_to_read <= 0 )
-			{ /* Not enough room in the buffer - grow it. */
-
-			/* just a shorter name for the current buffer */
-			YY_BUFFER_STATE b = YY_CURRENT_BUFFER;
-
-			int yy_c_buf_p_offset =
-				(int) ((yy_c_buf_p) - b->yy_ch_buf);
-
-			if ( b->yy_is_our_buffer )
-				{
-				int new_size = b->yy_buf_size * 2;
-
-				if ( new_size <= 0 )
-					b->yy_buf_size += b->yy_buf_size / 8;
-				else
-					b->yy_buf_size *= 2;
-
-				b->yy_ch_buf = (char *)
-					/* Include room in for 2 EOB chars. */
-					d_realloc((void *) b->yy_ch_buf,b->yy_buf_size + 2  );
-				}
-			else
-				/* Can't grow it, we don't own it. */
-				b->yy_ch_buf = 0;
-
-			if ( ! b->yy_ch_buf )
-				YY_FATAL_ERROR(
-				"fatal error - scanner input buffer overflow" );
-
-			(yy_c_buf_p) = &b->yy_ch_buf[yy_c_buf_p_offset];
-
-			num_to_read = YY_CURRENT_BUFFER_LVALUE->yy_buf_size -
-						number_to_move - 1;
-
-			}
-
-		if ( num_to_read > YY_READ_BUF_SIZE )
-			num_to_read = YY_READ_BUF_SIZE;
-
-		/* Read in more data. */
-		YY_INPUT( (&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[number_to_move]),
-			(yy_n_chars), (size_t) num_to_read );
-
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
-		}
-
-	if ( (yy_n_chars) == 0 )
-		{
-		if ( number_to_move == YY_MORE_ADJ )
-			{
-			ret_val = EOB_ACT_END_OF_FILE;
-			d_restart(d_in  );
-			}
-
-		else
-			{
-			ret_val = EOB_ACT_LAST_MATCH;
-			YY_CURRENT_BUFFER_LVALUE->yy_buffer_status =
-				YY_BUFFER_EOF_PENDING;
-			}
-		}
-
-	else
-		ret_val = EOB_ACT_CONTINUE_SCAN;
-
-	if ((yy_size_t) ((yy_n_chars) + number_to_move) > YY_CURRENT_BUFFER_LVALUE->yy_buf_size) {
-		/* Extend the array by 50%, plus the number we really need. */
-		yy_size_t new_size = (yy_n_chars) + number_to_move + ((yy_n_chars) >> 1);
-		YY_CURRENT_BUFFER_LVALUE->yy_ch_buf = (char *) d_realloc((void *) YY_CURRENT_BUFFER_LVALUE->yy_ch_buf,new_size  );
-		if ( ! YY_CURRENT_BUFFER_LVALUE->yy_ch_buf )
-			YY_FATAL_ERROR( "out of dynamic memory in yy_get_next_buffer()" );
-	}
-
-	(yy_n_chars) += number_to_move;
-	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] = YY_END_OF_BUFFER_CHAR;
-	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars) + 1] = YY_END_OF_BUFFER_CHAR;
-
-	(yytext_ptr) = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[0];
-
-	return ret_val;
-}
-
-/* yy_get_previous_state - get the state just before the EOB char was reached */
-
-    static yy_state_type yy_get_previous_state (void)
-{
-	register yy_state_type yy_current_state;
-	register char *yy_cp;
-    
-	yy_current_state = (yy_start);
-
-	for ( yy_cp = (yytext_ptr) + YY_MORE_ADJ; yy_cp < (yy_c_buf_p); ++yy_cp )
-		{
-		register YY_CHAR yy_c = (*yy_cp ? yy_ec[YY_SC_TO_UI(*yy_cp)] : 1);
-		if ( yy_accept[yy_current_state] )
-			{
-			(yy_last_accepting_state) = yy_current_state;
-			(yy_last_accepting_cpos) = yy_cp;
-			}
-		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
-			{
-			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 732 )
-				yy_c = yy_meta[(unsigned int) yy_c];
-			}
-		yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-		}
-
-	return yy_current_state;
-}
-
-/* yy_try_NUL_trans - try to make a transition on the NUL character
- *
- * synopsis
- *	next_state = yy_try_NUL_trans( current_state );
- */
-    static yy_state_type yy_try_NUL_trans  (yy_state_type yy_current_state )
-{
-	register int yy_is_jam;
-    	register char *yy_cp = (yy_c_buf_p);
-
-	register YY_CHAR yy_c = 1;
-	if ( yy_accept[yy_current_state] )
-		{
-		(yy_last_accepting_state) = yy_current_state;
-		(yy_last_accepting_cpos) = yy_cp;
-		}
-	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
-		{
-		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 732 )
-			yy_c = yy_meta[(unsigned int) yy_c];
-		}
-	yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-	yy_is_jam = (yy_current_state == 731);
-
-	return yy_is_jam ? 0 : yy_current_state;
-}
-
-    static void yyunput (int c, register char * yy_bp )
-{
-	register char *yy_cp;
-    
-    yy_cp = (yy_c_buf_p);
-
-	/* undo effects of setting up d_text */
-	*yy_cp = (yy_hold_char);
-
-	if ( yy_cp < YY_CURRENT_BUFFER_LVALUE->yy_ch_buf + 2 )
-		{ /* need to shift things up to make room */
-		/* +2 for EOB chars. */
-		register int number_to_move = (yy_n_chars) + 2;
-		register char *dest = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[
-					YY_CURRENT_BUFFER_LVALUE->yy_buf_size + 2];
-		register char *source =
-				&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[number_to_move];
-
-		while ( source > YY_CURRENT_BUFFER_LVALUE->yy_ch_buf )
-			*--dest = *--source;
-
-		yy_cp += (int) (dest - source);
-		yy_bp += (int) (dest - source);
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars =
-			(yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_buf_size;
-
-		if ( yy_cp < YY_CURRENT_BUFFER_LVALUE->yy_ch_buf + 2 )
-			YY_FATAL_ERROR( "flex scanner push-back overflow" );
-		}
-
-	*--yy_cp = (char) c;
-
-	(yytext_ptr) = yy_bp;
-	(yy_hold_char) = *yy_cp;
-	(yy_c_buf_p) = yy_cp;
-}
-
-#ifndef YY_NO_INPUT
-#ifdef __cplusplus
-    static int yyinput (void)
-#else
-    static int input  (void)
-#endif
-
-{
-	int c;
-    
-	*(yy_c_buf_p) = (yy_hold_char);
-
-	if ( *(yy_c_buf_p) == YY_END_OF_BUFFER_CHAR )
-		{
-		/* yy_c_buf_p now points to the character we want to return.
-		 * If this occurs *before* the EOB characters, then it's a
-		 * valid NUL; if not, then we've hit the end of the buffer.
-		 */
-		if ( (yy_c_buf_p) < &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] )
-			/* This was really a NUL. */
-			*(yy_c_buf_p) = '\0';
-
-		else
-			{ /* need more input */
-			int offset = (yy_c_buf_p) - (yytext_ptr);
-			++(yy_c_buf_p);
-
-			switch ( yy_get_next_buffer(  ) )
-				{
-				case EOB_ACT_LAST_MATCH:
-					/* This happens because yy_g_n_b()
-					 * sees that we've accumulated a
-					 * token and flags that we need to
-					 * try matching the token before
-					 * proceeding.  But for input(),
-					 * there's no matching to consider.
-					 * So convert the EOB_ACT_LAST_MATCH
-					 * to EOB_ACT_END_OF_FILE.
-					 */
-
-					/* Reset buffer status. */
-					d_restart(d_in );
-
-					/*FALLTHROUGH*/
-
-				case EOB_ACT_END_OF_FILE:
-					{
-					if ( d_wrap( ) )
-						return EOF;
-
-					if ( ! (yy_did_buffer_switch_on_eof) )
-						YY_NEW_FILE;
-#ifdef __cplusplus
-					return yyinput();
-#else
-					return input();
-#endif
-					}
-
-				case EOB_ACT_CONTINUE_SCAN:
-					(yy_c_buf_p) = (yytext_ptr) + offset;
-					break;
-				}
-			}
-		}
-
-	c = *(unsigned char *) (yy_c_buf_p);	/* cast for 8-bit char's */
-	*(yy_c_buf_p) = '\0';	/* preserve d_text */
-	(yy_hold_char) = *++(yy_c_buf_p);
-
-	return c;
-}
-#endif	/* ifndef YY_NO_INPUT */
-
-/** Immediately switch to a different input stream.
- * @param input_file A readable stream.
- * 
- * @note This function does not reset the start condition to @c INITIAL .
- */
-    void d_restart  (FILE * input_file )
-{
-    
-	if ( ! YY_CURRENT_BUFFER ){
-        d_ensure_buffer_stack ();
-		YY_CURRENT_BUFFER_LVALUE =
-            d__create_buffer(d_in,YY_BUF_SIZE );
-	}
-
-	d__init_buffer(YY_CURRENT_BUFFER,input_file );
-	d__load_buffer_state( );
-}
-
-/** Switch to a different input buffer.
- * @param new_buffer The new input buffer.
- * 
- */
-    void d__switch_to_buffer  (YY_BUFFER_STATE  new_buffer )
-{
-    
-	/* TODO. We should be able to replace this entire function body
-	 * with
-	 *		d_pop_buffer_state();
-	 *		d_push_buffer_state(new_buffer);
-     */
-	d_ensure_buffer_stack ();
-	if ( YY_CURRENT_BUFFER == new_buffer )
-		return;
-
-	if ( YY_CURRENT_BUFFER )
-		{
-		/* Flush out information for old buffer. */
-		*(yy_c_buf_p) = (yy_hold_char);
-		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = (yy_c_buf_p);
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
-		}
-
-	YY_CURRENT_BUFFER_LVALUE = new_buffer;
-	d__load_buffer_state( );
-
-	/* We don't actually know whether we did this switch during
-	 * EOF (d_wrap()) processing, but the only time this flag
-	 * is looked at is after d_wrap() is called, so it's safe
-	 * to go ahead and always set it.
-	 */
-	(yy_did_buffer_switch_on_eof) = 1;
-}
-
-static void d__load_buffer_state  (void)
-{
-    	(yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
-	(yytext_ptr) = (yy_c_buf_p) = YY_CURRENT_BUFFER_LVALUE->yy_buf_pos;
-	d_in = YY_CURRENT_BUFFER_LVALUE->yy_input_file;
-	(yy_hold_char) = *(yy_c_buf_p);
-}
-
-/** Allocate and initialize an input buffer state.
- * @param file A readable stream.
- * @param size The character buffer size in bytes. When in doubt, use @c YY_BUF_SIZE.
- * 
- * @return the allocated buffer state.
- */
-    YY_BUFFER_STATE d__create_buffer  (FILE * file, int  size )
-{
-	YY_BUFFER_STATE b;
-    
-	b = (YY_BUFFER_STATE) d_alloc(sizeof( struct yy_buffer_state )  );
-	if ( ! b )
-		YY_FATAL_ERROR( "out of dynamic memory in d__create_buffer()" );
-
-	b->yy_buf_size = size;
-
-	/* yy_ch_buf has to be 2 characters longer than the size given because
-	 * we need to put in 2 end-of-buffer characters.
-	 */
-	b->yy_ch_buf = (char *) d_alloc(b->yy_buf_size + 2  );
-	if ( ! b->yy_ch_buf )
-		YY_FATAL_ERROR( "out of dynamic memory in d__create_buffer()" );
-
-	b->yy_is_our_buffer = 1;
-
-	d__init_buffer(b,file );
-
-	return b;
-}
-
-/** Destroy the buffer.
- * @param b a buffer created with d__create_buffer()
- * 
- */
-    void d__delete_buffer (YY_BUFFER_STATE  b )
-{
-    
-	if ( ! b )
-		return;
-
-	if ( b == YY_CURRENT_BUFFER ) /* Not sure if we should pop here. */
-		YY_CURRENT_BUFFER_LVALUE = (YY_BUFFER_STATE) 0;
-
-	if ( b->yy_is_our_buffer )
-		d_free((void *) b->yy_ch_buf  );
-
-	d_free((void *) b  );
-}
-
-#ifndef __cplusplus
-extern int isatty (int );
-#endif /* __cplusplus */
-    
-/* Initializes or reinitializes a buffer.
- * This function is sometimes called more than once on the same buffer,
- * such as during a d_restart() or at EOF.
- */
-    static void d__init_buffer  (YY_BUFFER_STATE  b, FILE * file )
-
-{
-	int oerrno = errno;
-    
-	d__flush_buffer(b );
-
-	b->yy_input_file = file;
-	b->yy_fill_buffer = 1;
-
-    /* If b is the current buffer, then d__init_buffer was _probably_
-     * called from d_restart() or through yy_get_next_buffer.
-     * In that case, we don't want to reset the lineno or column.
-     */
-    if (b != YY_CURRENT_BUFFER){
-        b->yy_bs_lineno = 1;
-        b->yy_bs_column = 0;
-    }
-
-        b->yy_is_interactive = file ? (isatty( fileno(file) ) > 0) : 0;
-    
-	errno = oerrno;
-}
-
-/** Discard all buffered characters. On the next scan, YY_INPUT will be called.
- * @param b the buffer state to be flushed, usually @c YY_CURRENT_BUFFER.
- * 
- */
-    void d__flush_buffer (YY_BUFFER_STATE  b )
-{
-    	if ( ! b )
-		return;
-
-	b->yy_n_chars = 0;
-
-	/* We always need two end-of-buffer characters.  The first causes
-	 * a transition to the end-of-buffer state.  The second causes
-	 * a jam in that state.
-	 */
-	b->yy_ch_buf[0] = YY_END_OF_BUFFER_CHAR;
-	b->yy_ch_buf[1] = YY_END_OF_BUFFER_CHAR;
-
-	b->yy_buf_pos = &b->yy_ch_buf[0];
-
-	b->yy_at_bol = 1;
-	b->yy_buffer_status = YY_BUFFER_NEW;
-
-	if ( b == YY_CURRENT_BUFFER )
-		d__load_buffer_state( );
-}
-
-/** Pushes the new state onto the stack. The new state becomes
- *  the current state. This function will allocate the stack
- *  if necessary.
- *  @param new_buffer The new state.
- *  
- */
-void d_push_buffer_state (YY_BUFFER_STATE new_buffer )
-{
-    	if (new_buffer == NULL)
-		return;
-
-	d_ensure_buffer_stack();
-
-	/* This block is copied from d__switch_to_buffer. */
-	if ( YY_CURRENT_BUFFER )
-		{
-		/* Flush out information for old buffer. */
-		*(yy_c_buf_p) = (yy_hold_char);
-		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = (yy_c_buf_p);
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
-		}
-
-	/* Only push if top exists. Otherwise, replace top. */
-	if (YY_CURRENT_BUFFER)
-		(yy_buffer_stack_top)++;
-	YY_CURRENT_BUFFER_LVALUE = new_buffer;
-
-	/* copied from d__switch_to_buffer. */
-	d__load_buffer_state( );
-	(yy_did_buffer_switch_on_eof) = 1;
-}
-
-/** Removes and deletes the top of the stack, if present.
- *  The next element becomes the new top.
- *  
- */
-void d_pop_buffer_state (void)
-{
-    	if (!YY_CURRENT_BUFFER)
-		return;
-
-	d__delete_buffer(YY_CURRENT_BUFFER );
-	YY_CURRENT_BUFFER_LVALUE = NULL;
-	if ((yy_buffer_stack_top) > 0)
-		--(yy_buffer_stack_top);
-
-	if (YY_CURRENT_BUFFER) {
-		d__load_buffer_state( );
-		(yy_did_buffer_switch_on_eof) = 1;
-	}
-}
-
-/* Allocates the stack if it does not exist.
- *  Guarantees space for at least one push.
- */
-static void d_ensure_buffer_stack (void)
-{
-	int num_to_alloc;
-    
-	if (!(yy_buffer_stack)) {
-
-		/* First allocation is just for 2 elements, since we don't know if this
-		 * scanner will even need a stack. We use 2 instead of 1 to avoid an
-		 * immediate realloc on the next call.
-         */
-		num_to_alloc = 1;
-		(yy_buffer_stack) = (struct yy_buffer_state**)d_alloc
-								(num_to_alloc * sizeof(struct yy_buffer_state*)
-								);
-		if ( ! (yy_buffer_stack) )
-			YY_FATAL_ERROR( "out of dynamic memory in d_ensure_buffer_stack()" );
-								  
-		memset((yy_buffer_stack), 0, num_to_alloc * sizeof(struct yy_buffer_state*));
-				
-		(yy_buffer_stack_max) = num_to_alloc;
-		(yy_buffer_stack_top) = 0;
-		return;
-	}
-
-	if ((yy_buffer_stack_top) >= ((yy_buffer_stack_max)) - 1){
-
-		/* Increase the buffer to prepare for a possible push. */
-		int grow_size = 8 /* arbitrary grow size */;
-
-		num_to_alloc = (yy_buffer_stack_max) + grow_size;
-		(yy_buffer_stack) = (struct yy_buffer_state**)d_realloc
-								((yy_buffer_stack),
-								num_to_alloc * sizeof(struct yy_buffer_state*)
-								);
-		if ( ! (yy_buffer_stack) )
-			YY_FATAL_ERROR( "out of dynamic memory in d_ensure_buffer_stack()" );
-
-		/* zero only the new slots.*/
-		memset((yy_buffer_stack) + (yy_buffer_stack_max), 0, grow_size * sizeof(struct yy_buffer_state*));
-		(yy_buffer_stack_max) = num_to_alloc;
-	}
-}
-
-/** Setup the input buffer state to scan directly from a user-specified character buffer.
- * @param base the character buffer
- * @param size the size in bytes of the character buffer
- * 
- * @return the newly allocated buffer state object. 
- */
-YY_BUFFER_STATE d__scan_buffer  (char * base, yy_size_t  size )
-{
-	YY_BUFFER_STATE b;
-    
-	if ( size < 2 ||
-	     base[size-2] != YY_END_OF_BUFFER_CHAR ||
-	     base[size-1] != YY_END_OF_BUFFER_CHAR )
-		/* They forgot to leave room for the EOB's. */
-		return 0;
-
-	b = (YY_BUFFER_STATE) d_alloc(sizeof( struct yy_buffer_state )  );
-	if ( ! b )
-		YY_FATAL_ERROR( "out of dynamic memory in d__scan_buffer()" );
-
-	b->yy_buf_size = size - 2;	/* "- 2" to take care of EOB's */
-	b->yy_buf_pos = b->yy_ch_buf = base;
-	b->yy_is_our_buffer = 0;
-	b->yy_input_file = 0;
-	b->yy_n_chars = b->yy_buf_size;
-	b->yy_is_interactive = 0;
-	b->yy_at_bol = 1;
-	b->yy_fill_buffer = 0;
-	b->yy_buffer_status = YY_BUFFER_NEW;
-
-	d__switch_to_buffer(b  );
-
-	return b;
-}
-
-/** Setup the input buffer state to scan a string. The next call to d_lex() will
- * scan from a @e copy of @a str.
- * @param yystr a NUL-terminated string to scan
- * 
- * @return the newly allocated buffer state object.
- * @note If you want to scan bytes that may contain NUL values, then use
- *       d__scan_bytes() instead.
- */
-YY_BUFFER_STATE d__scan_string (yyconst char * yystr )
-{
-    
-	return d__scan_bytes(yystr,strlen(yystr) );
-}
-
-/** Setup the input buffer state to scan the given bytes. The next call to d_lex() will
- * scan from a @e copy of @a bytes.
- * @param yybytes the byte buffer to scan
- * @param _yybytes_len the number of bytes in the buffer pointed to by @a bytes.
- * 
- * @return the newly allocated buffer state object.
- */
-YY_BUFFER_STATE d__scan_bytes  (yyconst char * yybytes, int  _yybytes_len )
-{
-	YY_BUFFER_STATE b;
-	char *buf;
-	yy_size_t n;
-	int i;
-    
-	/* Get memory for full buffer, including space for trailing EOB's. */
-	n = _yybytes_len + 2;
-	buf = (char *) d_alloc(n  );
-	if ( ! buf )
-		YY_FATAL_ERROR( "out of dynamic memory in d__scan_bytes()" );
-
-	for ( i = 0; i < _yybytes_len; ++i )
-		buf[i] = yybytes[i];
-
-	buf[_yybytes_len] = buf[_yybytes_len+1] = YY_END_OF_BUFFER_CHAR;
-
-	b = d__scan_buffer(buf,n );
-	if ( ! b )
-		YY_FATAL_ERROR( "bad buffer in d__scan_bytes()" );
-
-	/* It's okay to grow etc. this buffer, and we should throw it
-	 * away when we're done.
-	 */
-	b->yy_is_our_buffer = 1;
-
-	return b;
-}
-
-#ifndef YY_EXIT_FAILURE
-#define YY_EXIT_FAILURE 2
-#endif
-
-static void yy_fatal_error (yyconst char* msg )
-{
-    	(void) fprintf( stderr, "%s\n", msg );
-	exit( YY_EXIT_FAILURE );
-}
-
-/* Redefine yyless() so it works in section 3 code. */
-
-#undef yyless
-#define yyless(n) \
-	do \
-		{ \
-		/* Undo effects of setting up d_text. */ \
-        int yyless_macro_arg = (n); \
-        YY_LESS_LINENO(yyless_macro_arg);\
-		d_text[d_leng] = (yy_hold_char); \
-		(yy_c_buf_p) = d_text + yyless_macro_arg; \
-		(yy_hold_char) = *(yy_c_buf_p); \
-		*(yy_c_buf_p) = '\0'; \
-		d_leng = yyless_macro_arg; \
-		} \
-	while ( 0 )
-
-/* Accessor  methods (get/set functions) to struct members. */
-
-/** Get the current line number.
- * 
- */
-int d_get_lineno  (void)
-{
-        
-    return d_lineno;
-}
-
-/** Get the input stream.
- * 
- */
-FILE *d_get_in  (void)
-{
-        return d_in;
-}
-
-/** Get the output stream.
- * 
- */
-FILE *d_get_out  (void)
-{
-        return d_out;
-}
-
-/** Get the length of the current token.
- * 
- */
-int d_get_leng  (void)
-{
-        return d_leng;
-}
-
-/** Get the current token.
- * 
- */
-
-char *d_get_text  (void)
-{
-        return d_text;
-}
-
-/** Set the current line number.
- * @param line_number
- * 
- */
-void d_set_lineno (int  line_number )
-{
-    
-    d_lineno = line_number;
-}
-
-/** Set the input stream. This does not discard the current
- * input buffer.
- * @param in_str A readable stream.
- * 
- * @see d__switch_to_buffer
- */
-void d_set_in (FILE *  in_str )
-{
-        d_in = in_str ;
-}
-
-void d_set_out (FILE *  out_str )
-{
-        d_out = out_str ;
-}
-
-int d_get_debug  (void)
-{
-        return d__flex_debug;
-}
-
-void d_set_debug (int  bdebug )
-{
-        d__flex_debug = bdebug ;
-}
-
-static int yy_init_globals (void)
-{
-        /* Initialization is the same as for the non-reentrant scanner.
-     * This function is called from d_lex_destroy(), so don't allocate here.
-     */
-
-    (yy_buffer_stack) = 0;
-    (yy_buffer_stack_top) = 0;
-    (yy_buffer_stack_max) = 0;
-    (yy_c_buf_p) = (char *) 0;
-    (yy_init) = 0;
-    (yy_start) = 0;
-
-/* Defined in main.c */
-#ifdef YY_STDINIT
-    d_in = stdin;
-    d_out = stdout;
-#else
-    d_in = (FILE *) 0;
-    d_out = (FILE *) 0;
-#endif
-
-    /* For future reference: Set errno on error, since we are called by
-     * d_lex_init()
-     */
-    return 0;
-}
-
-/* d_lex_destroy is for both reentrant and non-reentrant scanners. */
-int d_lex_destroy  (void)
-{
-    
-    /* Pop the buffer stack, destroying each element. */
-	while(YY_CURRENT_BUFFER){
-		d__delete_buffer(YY_CURRENT_BUFFER  );
-		YY_CURRENT_BUFFER_LVALUE = NULL;
-		d_pop_buffer_state();
-	}
-
-	/* Destroy the stack itself. */
-	d_free((yy_buffer_stack) );
-	(yy_buffer_stack) = NULL;
-
-    /* Reset the globals. This is important in a non-reentrant scanner so the next time
-     * d_lex() is called, initialization will occur. */
-    yy_init_globals( );
-
-    return 0;
-}
-
-/*
- * Internal utility routines.
- */
-
-#ifndef yytext_ptr
-static void yy_flex_strncpy (char* s1, yyconst char * s2, int n )
-{
-	register int i;
-	for ( i = 0; i < n; ++i )
-		s1[i] = s2[i];
-}
-#endif
-
-#ifdef YY_NEED_STRLEN
-static int yy_flex_strlen (yyconst char * s )
-{
-	register int n;
-	for ( n = 0; s[n]; ++n )
-		;
-
-	return n;
-}
-#endif
-
-void *d_alloc (yy_size_t  size )
-{
-	return (void *) malloc( size );
-}
-
-void *d_realloc  (void * ptr, yy_size_t  size )
-{
-	/* The cast to (char *) in the following accommodates both
-	 * implementations that use char* generic pointers, and those
-	 * that use void* generic pointers.  It works with the latter
-	 * because both ANSI C and C++ allow castless assignment from
-	 * any pointer type to void*, and deal with argument conversions
-	 * as though doing an assignment.
-	 */
-	return (void *) realloc( (char *) ptr, size );
-}
-
-void d_free (void * ptr )
-{
-	free( (char *) ptr );	/* see d_realloc() for (char *) cast */
-}
-
-#define YYTABLES_NAME "yytables"
-
-#line 252 "dlexer.l"
-
-
-
-int d_wrap ( void ) {
-        {
-                /* Silly impossible function call to stop warning of unused functions */
-                if ( 0 ) {
-                        yyunput(0, "");
-                }
-        }
-
-    return 1;
-}
-
@@ -1,6 +1,7 @@
 #include "tokenizer.h"
 #include "sys_util.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* Some default file extensions */
@@ -11,75 +12,160 @@ char *d_extensions[] = { ".d", ".di" };
 char *go_extensions[] = { ".go" };
 char *ada_extensions[] = { ".adb", ".ads", ".ada", ".ADB", ".ADS", ".ADA" };
 
-extern int c_lex(void);
-extern FILE *c_in;
-extern char *c_text;
-
-extern int d_lex(void);
-extern FILE *d_in;
-extern char *d_text;
-
-extern int go_lex(void);
-extern FILE *go_in;
-extern char *go_text;
+/* The scanners are reentrant, each tokenizer has its own. These are the
+ * same for each language, see the end of the lexers. */
+struct tokenizer_scanner {
+    void *(*create) (FILE * file, const char *buffer, size_t length);
+    int (*lex) (void *scanner);
+    int (*destroy) (void *scanner);
+    char *(*text) (void *scanner);
+    size_t (*length) (void *scanner);
+    int (*get_state) (void *scanner);
+    void (*set_state) (void *scanner, int state);
+};
 
-extern int ada_lex(void);
-extern FILE *ada_in;
-extern char *ada_text;
+#define TOKENIZER_SCANNER(prefix) \
+    extern void *prefix##_scanner_create(FILE *file, const char *buffer, \
+            size_t length); \
+    extern int prefix##_lex(void *scanner); \
+    extern int prefix##_lex_destroy(void *scanner); \
+    extern char *prefix##_get_text(void *scanner); \
+    extern size_t prefix##_scanner_length(void *scanner); \
+    extern int prefix##_scanner_get_state(void *scanner); \
+    extern void prefix##_scanner_set_state(void *scanner, int state);
+
+TOKENIZER_SCANNER(c)
+TOKENIZER_SCANNER(d)
+TOKENIZER_SCANNER(go)
+TOKENIZER_SCANNER(ada)
+
+/* In the order of enum tokenizer_language_support */
+static const struct tokenizer_scanner scanners[] = {
+    {c_scanner_create, c_lex, c_lex_destroy, c_get_text, c_scanner_length,
+            c_scanner_get_state, c_scanner_set_state},
+    {d_scanner_create, d_lex, d_lex_destroy, d_get_text, d_scanner_length,
+            d_scanner_get_state, d_scanner_set_state},
+    {go_scanner_create, go_lex, go_lex_destroy, go_get_text,
+            go_scanner_length, go_scanner_get_state, go_scanner_set_state},
+    {ada_scanner_create, ada_lex, ada_lex_destroy, ada_get_text,
+            ada_scanner_length, ada_scanner_get_state, ada_scanner_set_state}
+};
 
 struct tokenizer {
     enum tokenizer_language_support lang;
-    int (*tokenizer_lex) (void);
-    FILE **tokenizer_in;
-    char **tokenizer_text;
+    const struct tokenizer_scanner *s;
+
+    /* The scanner of the scan in progress, or NULL */
+    void *scanner;
+
+    /* The file being scanned, or NULL if scanning a buffer */
+    FILE *file;
 
     enum tokenizer_type tpacket;
-    struct ibuf *i;
+
+    /* Where the current token is in the text being scanned */
+    size_t offset;
+    size_t length;
 };
 
 struct tokenizer *tokenizer_init(void)
 {
     struct tokenizer *n =
             (struct tokenizer *) cgdb_malloc(sizeof (struct tokenizer));
-    n->i = ibuf_init();
     n->lang = TOKENIZER_LANGUAGE_UNKNOWN;
-    n->tokenizer_lex = NULL;
-    n->tokenizer_in = NULL;
-    n->tokenizer_text = NULL;
+    n->s = NULL;
+    n->scanner = NULL;
+    n->file = NULL;
+    n->tpacket = 0;
+    n->offset = 0;
+    n->length = 0;
     return n;
 }
 
+/* tokenizer_end
+ * -------------
+ *
+ *  Frees the scanner of the scan in progress, and closes its file.
+ */
+static void tokenizer_end(struct tokenizer *t)
+{
+    if (t->scanner) {
+        (t->s->destroy) (t->scanner);
+        t->scanner = NULL;
+    }
+
+    if (t->file) {
+        fclose(t->file);
+        t->file = NULL;
+    }
+}
+
+void tokenizer_destroy(struct tokenizer *t)
+{
+    if (!t)
+        return;
+
+    /* Abandoned in the middle of a scan */
+    tokenizer_end(t);
+
+    free(t);
+}
+
+/* tokenizer_start
+ * ---------------
+ *
+ *  Starts a scan of a file, or of a buffer if file is NULL, with a new
+ *  scanner for the language.
+ *
+ *  Return: -1 on error, 0 on success, 1 if the language is not supported
+ */
+static int tokenizer_start(struct tokenizer *t, FILE * file,
+        const char *buffer, size_t length, enum tokenizer_language_support l)
+{
+    tokenizer_end(t);
+
+    if (l < TOKENIZER_ENUM_START_POS || l >= TOKENIZER_LANGUAGE_UNKNOWN)
+        return 1;
+
+    t->lang = l;
+    t->s = &scanners[l - TOKENIZER_ENUM_START_POS];
+    t->offset = 0;
+    t->length = 0;
+
+    t->scanner = (t->s->create) (file, buffer, length);
+    if (!t->scanner)
+        return -1;
+
+    t->file = file;
+
+    return 0;
+}
+
 int tokenizer_set_file(struct tokenizer *t, const char *file,
         enum tokenizer_language_support l)
 {
+    FILE *f;
 
     if (l < TOKENIZER_ENUM_START_POS || l >= TOKENIZER_LANGUAGE_UNKNOWN)
         return 0;
 
-    t->lang = l;
+    f = fopen(file, "r");
 
-    if (l == TOKENIZER_LANGUAGE_C) {
-        t->tokenizer_lex = c_lex;
-        t->tokenizer_in = &c_in;
-        t->tokenizer_text = &c_text;
-    } else if (l == TOKENIZER_LANGUAGE_D) {
-        t->tokenizer_lex = d_lex;
-        t->tokenizer_in = &d_in;
-        t->tokenizer_text = &d_text;
-    } else if (l == TOKENIZER_LANGUAGE_GO) {
-        t->tokenizer_lex = go_lex;
-        t->tokenizer_in = &go_in;
-        t->tokenizer_text = &go_text;
-    } else {
-        t->tokenizer_lex = ada_lex;
-        t->tokenizer_in = &ada_in;
-        t->tokenizer_text = &ada_text;
+    if (!f || tokenizer_start(t, f, NULL, 0, l) == -1) {
+        if (f)
+            fclose(f);
+        fprintf(stderr, "%s:%d tokizer_set_file error", __FILE__, __LINE__);
+        return -1;
     }
 
-    *(t->tokenizer_in) = fopen(file, "r");
+    return 0;
+}
 
-    if (!(*(t->tokenizer_in))) {
-        fprintf(stderr, "%s:%d tokizer_set_file error", __FILE__, __LINE__);
+int tokenizer_set_buffer(struct tokenizer *t, const char *buffer,
+        size_t length, enum tokenizer_language_support l)
+{
+    if (tokenizer_start(t, NULL, buffer, length, l) == -1) {
+        fprintf(stderr, "%s:%d tokizer_set_buffer error", __FILE__, __LINE__);
         return -1;
     }
 
@@ -88,21 +174,41 @@ int tokenizer_set_file(struct tokenizer *t, const char *file,
 
 int tokenizer_get_token(struct tokenizer *t)
 {
-    if (t == NULL || t->tokenizer_lex == NULL)
+    if (t == NULL || t->scanner == NULL)
         return 0;
 
-    t->tpacket = (t->tokenizer_lex) ();
-    ibuf_clear(t->i);
-    ibuf_add(t->i, (const char *) *(t->tokenizer_text));
+    t->offset += t->length;
+    t->tpacket = (t->s->lex) (t->scanner);
 
     if (!(t->tpacket)) {
-        fclose(*(t->tokenizer_in));
+        t->length = 0;
+        tokenizer_end(t);
         return 0;
     }
 
+    t->length = (t->s->length) (t->scanner);
+
     return 1;
 }
 
+int tokenizer_get_state(struct tokenizer *t)
+{
+    if (!t->scanner)
+        return 0;
+
+    return (t->s->get_state) (t->scanner);
+}
+
+int tokenizer_set_state(struct tokenizer *t, int state)
+{
+    if (!t->scanner)
+        return -1;
+
+    (t->s->set_state) (t->scanner, state);
+
+    return 0;
+}
+
 enum tokenizer_type tokenizer_get_packet_type(struct tokenizer *t)
 {
     return t->tpacket;
@@ -131,9 +237,20 @@ const char *tokenizer_get_printable_enum(enum tokenizer_type e)
 
 char *tokenizer_get_data(struct tokenizer *t)
 {
-    char *string = ibuf_get(t->i);
+    if (!t->scanner)
+        return NULL;
+
+    return (t->s->text) (t->scanner);
+}
 
-    return string;
+size_t tokenizer_get_offset(struct tokenizer *t)
+{
+    return t->offset;
+}
+
+size_t tokenizer_get_length(struct tokenizer *t)
+{
+    return t->length;
 }
 
 enum tokenizer_language_support tokenizer_get_default_file_type(const char
@@ -1,7 +1,7 @@
 #ifndef __TOKENIZER_H__
 #define __TOKENIZER_H__
 
-#include "ibuf.h"
+#include <stddef.h>
 
 struct tokenizer;
 
@@ -30,7 +30,9 @@ enum tokenizer_language_support {
 /* tokenizer_init
  * --------------
  *
- *  This initializers a new tokenizer.
+ *  This initializers a new tokenizer. Each tokenizer has scanners of its
+ *  own, so different tokenizers can be used at the same time, in
+ *  different threads.
  *
  *  t:      The tokenizer object to work on
  *
@@ -60,6 +62,23 @@ void tokenizer_destroy(struct tokenizer *t);
 int tokenizer_set_file(struct tokenizer *t, const char *file,
         enum tokenizer_language_support l);
 
+/* tokenizer_set_buffer
+ * --------------------
+ *
+ *  This functions will prepare the tokenizer to parse a buffer already
+ *  in memory, such as the contents of a file that has been loaded. The
+ *  buffer is copied, so it does not have to outlive the scan. The
+ *  offsets of the tokens are offsets into it.
+ *  
+ *  t:      The tokenizer object to work on
+ *  buffer: The text to tokenize.
+ *  length: The number of bytes in buffer.
+ *
+ *  Return: -1 on error. 0 on success
+ */
+int tokenizer_set_buffer(struct tokenizer *t, const char *buffer,
+        size_t length, enum tokenizer_language_support l);
+
 /* tokenizer_get_token
  * -------------------
  *
@@ -71,6 +90,35 @@ int tokenizer_set_file(struct tokenizer *t, const char *file,
  */
 int tokenizer_get_token(struct tokenizer *t);
 
+/* tokenizer_get_state
+ * -------------------
+ *
+ *  This gets the state the scanner is in after the last token, whether
+ *  it's in a comment, a string and so on. Right after a
+ *  TOKENIZER_NEWLINE, it's the state the next line starts in. A scan
+ *  can carry on from there later with tokenizer_set_state.
+ *
+ *  t:      The tokenizer object to work on
+ *
+ *  Returns: The state, 0 is the state every scan starts in
+ */
+int tokenizer_get_state(struct tokenizer *t);
+
+/* tokenizer_set_state
+ * -------------------
+ *
+ *  This puts the scanner in a state tokenizer_get_state returned, so the
+ *  next token is scanned as if the text before it had been scanned too.
+ *  It's called after tokenizer_set_buffer or tokenizer_set_file, before
+ *  the first token, with the same language the state came from.
+ *
+ *  t:      The tokenizer object to work on
+ *  state:  The state
+ *
+ *  Return: -1 on error. 0 on success
+ */
+int tokenizer_set_state(struct tokenizer *t, int state);
+
 /* tokenizer_type
  * --------------
  *
@@ -100,10 +148,34 @@ const char *tokenizer_get_printable_enum(enum tokenizer_type e);
  *
  *  t:      The tokenizer object to work on
  *
- *  Returns: The token data. This is from the heap. The user must free it.
+ *  Returns: The token data, null terminated. It belongs to the tokenizer
+ *           and is only good until the next call to tokenizer_get_token.
  */
 char *tokenizer_get_data(struct tokenizer *t);
 
+/* tokenizer_get_offset
+ * --------------------
+ *
+ *  This gets where the token starts, in the buffer or file being scanned.
+ *
+ *  t:      The tokenizer object to work on
+ *
+ *  Returns: The offset of the token
+ */
+size_t tokenizer_get_offset(struct tokenizer *t);
+
+/* tokenizer_get_length
+ * --------------------
+ *
+ *  This gets the length of the token. The token is the length bytes at
+ *  its offset, no copy of it has to be made.
+ *
+ *  t:      The tokenizer object to work on
+ *
+ *  Returns: The length of the token
+ */
+size_t tokenizer_get_length(struct tokenizer *t);
+
 /* tokenizer_get_default_file_type
  *
  * This will return the type of file the tokenizer thinks the
@@ -1,35 +1,208 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "tokenizer.h"
+#include "bench.h"
+
+/* A file being tokenized, and what tokenizing it once found */
+struct bench_file {
+    const char *data;
+    size_t length;
+    enum tokenizer_language_support language;
+    int lines;
+
+    unsigned long tokens;
+    unsigned long long first_ns;        /* Spent getting to the first lines */
+};
 
 static void usage(void)
 {
 
     printf("tokenizer_driver <file> <c|d|go|ada>\n");
+    printf("tokenizer_driver -b [-n repetitions] [-s scale] [-l lines] "
+            "<file> <c|d|go|ada> ...\n");
+    printf("  -b  Measure how fast each file is tokenized instead\n");
+    printf("  -n  Tokenize each file this many times, 20 by default\n");
+    printf("  -s  Repeat each file this many times first, 1 by default\n");
+    printf("  -l  Also time getting to this many lines, 100 by default\n");
+    printf("\nA line of JSON is written for each file.\n");
     exit(-1);
 }
 
-int main(int argc, char **argv)
+static enum tokenizer_language_support get_language(const char *name)
+{
+    if (strcmp(name, "c") == 0)
+        return TOKENIZER_LANGUAGE_C;
+    else if (strcmp(name, "d") == 0)
+        return TOKENIZER_LANGUAGE_D;
+    else if (strcmp(name, "go") == 0)
+        return TOKENIZER_LANGUAGE_GO;
+    else if (strcmp(name, "ada") == 0)
+        return TOKENIZER_LANGUAGE_ADA;
+
+    usage();
+    return TOKENIZER_LANGUAGE_UNKNOWN;
+}
+
+/* Reads a file, repeated scale times */
+static char *read_file(const char *path, int scale, size_t *length)
+{
+    FILE *file;
+    char *data = NULL;
+    size_t size = 0, count;
+    int i;
+
+    file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "%s:%d Can't open %s\n", __FILE__, __LINE__, path);
+        return NULL;
+    }
+
+    *length = 0;
+    do {
+        if (*length == size) {
+            size = size ? size * 2 : 65536;
+            data = realloc(data, size);
+            if (!data) {
+                fprintf(stderr, "%s:%d", __FILE__, __LINE__);
+                fclose(file);
+                return NULL;
+            }
+        }
+
+        count = fread(data + *length, 1, size - *length, file);
+        *length += count;
+    } while (count > 0);
+
+    fclose(file);
+
+    data = realloc(data, *length * scale + 1);
+    if (!data) {
+        fprintf(stderr, "%s:%d", __FILE__, __LINE__);
+        return NULL;
+    }
+
+    for (i = 1; i < scale; i++)
+        memcpy(data + *length * i, data, *length);
+    *length *= scale;
+
+    return data;
+}
+
+/* Tokenizes the data once, the way the source viewer does */
+static int bench_data(void *context)
 {
+    struct bench_file *file = (struct bench_file *) context;
     struct tokenizer *t = tokenizer_init();
+    unsigned long long start = bench_wall();
+    int ret, line = 0;
+
+    file->tokens = 0;
+    file->first_ns = 0;
+
+    if (tokenizer_set_buffer(t, file->data, file->length,
+                    file->language) == -1) {
+        fprintf(stderr, "%s:%d tokenizer_set_buffer error\n",
+                __FILE__, __LINE__);
+        tokenizer_destroy(t);
+        return -1;
+    }
+
+    while ((ret = tokenizer_get_token(t)) > 0) {
+        file->tokens++;
+
+        if (tokenizer_get_packet_type(t) == TOKENIZER_NEWLINE &&
+                ++line == file->lines)
+            file->first_ns = bench_wall() - start;
+    }
+
+    /* The file is shorter than that */
+    if (line < file->lines)
+        file->first_ns = bench_wall() - start;
+
+    tokenizer_destroy(t);
+
+    return ret;
+}
+
+static int bench(int argc, char **argv)
+{
+    int repetitions = 20, scale = 1, opt, i;
+    struct bench_file file;
+    struct bench bench;
+    const char *name;
+    char *data;
+
+    file.lines = 100;
+
+    while ((opt = getopt(argc, argv, "bn:s:l:")) != -1) {
+        switch (opt) {
+            case 'b':
+                break;
+            case 'n':
+                if ((repetitions = atoi(optarg)) <= 0)
+                    usage();
+                break;
+            case 's':
+                if ((scale = atoi(optarg)) <= 0)
+                    usage();
+                break;
+            case 'l':
+                if ((file.lines = atoi(optarg)) <= 0)
+                    usage();
+                break;
+            default:
+                usage();
+        }
+    }
+
+    if (optind == argc || (argc - optind) % 2 != 0)
+        usage();
+
+    for (i = optind; i < argc; i += 2) {
+        file.language = get_language(argv[i + 1]);
+        data = read_file(argv[i], scale, &file.length);
+        if (!data)
+            return -1;
+        file.data = data;
+
+        /* The same wherever the build is */
+        name = strrchr(argv[i], '/') ? strrchr(argv[i], '/') + 1 : argv[i];
+        bench_init(&bench, "tokenizer", repetitions, "%s %s x%d", name,
+                argv[i + 1], scale);
+        bench.items = file.length;
+        bench.unit = "bytes";
+        if (bench_run(&bench, bench_data, &file) == -1)
+            return -1;
+
+        bench_print(&bench, "\"tokens\": %lu, \"tokens_per_s\": %.0f, "
+                "\"first_%d_lines_ms\": %.3f", file.tokens,
+                file.tokens * 1e9 / (bench.wall_median ? bench.wall_median : 1),
+                file.lines, file.first_ns / 1e6);
+
+        free(data);
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    struct tokenizer *t;
     int ret;
     enum tokenizer_language_support l = TOKENIZER_LANGUAGE_UNKNOWN;
 
+    if (argc > 1 && strcmp(argv[1], "-b") == 0)
+        return bench(argc, argv);
+
     if (argc != 3)
         usage();
 
-    if (strcmp(argv[2], "c") == 0)
-        l = TOKENIZER_LANGUAGE_C;
-    else if (strcmp(argv[2], "d") == 0)
-        l = TOKENIZER_LANGUAGE_D;
-    else if (strcmp(argv[2], "go") == 0)
-        l = TOKENIZER_LANGUAGE_GO;
-    else if (strcmp(argv[2], "ada") == 0)
-        l = TOKENIZER_LANGUAGE_ADA;
-    else
-        usage();
+    l = get_language(argv[2]);
 
+    t = tokenizer_init();
     if (tokenizer_set_file(t, argv[1], l) == -1) {
         printf("%s:%d tokenizer_set_file error\n", __FILE__, __LINE__);
         return -1;
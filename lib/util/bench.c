@@ -0,0 +1,216 @@
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STDARG_H
+#include <stdarg.h>
+#endif /* HAVE_STDARG_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_TIME_H
+#include <time.h>
+#endif /* HAVE_TIME_H */
+
+#if HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif /* HAVE_SYS_TIME_H */
+
+#include "bench.h"
+#include "sys_util.h"
+
+/* The warmups when the environment doesn't say */
+#define BENCH_WARMUP 3
+
+/* bench_env: A count from the environment, or fallback if it has none. */
+static int bench_env(const char *name, int fallback)
+{
+    const char *value = getenv(name);
+
+    if (!value || atoi(value) < 0)
+        return fallback;
+
+    return atoi(value);
+}
+
+/* bench_compare_times: Orders the times of the repetitions. */
+static int bench_compare_times(const void *a, const void *b)
+{
+    unsigned long long left = *(const unsigned long long *) a;
+    unsigned long long right = *(const unsigned long long *) b;
+
+    return left < right ? -1 : left > right;
+}
+
+/* bench_median: The median of times, which is sorted by it. */
+static unsigned long long bench_median(unsigned long long *times, int count)
+{
+    qsort(times, count, sizeof (unsigned long long), bench_compare_times);
+
+    if (count % 2 == 0)
+        return (times[count / 2 - 1] + times[count / 2]) / 2;
+
+    return times[count / 2];
+}
+
+/* bench_string: Writes a string of JSON, with what needs it escaped. */
+static void bench_string(const char *s)
+{
+    putchar('"');
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            printf("\\%c", *s);
+        else if ((unsigned char) *s < 0x20)
+            printf("\\u%04x", (unsigned char) *s);
+        else
+            putchar(*s);
+    }
+    putchar('"');
+}
+
+unsigned long long bench_wall(void)
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+        return (unsigned long long) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+    {
+        struct timeval tv;
+
+        gettimeofday(&tv, NULL);
+
+        return (unsigned long long) tv.tv_sec * 1000000000 +
+                (unsigned long long) tv.tv_usec * 1000;
+    }
+}
+
+unsigned long long bench_cycles(void)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    unsigned int low, high;
+
+    __asm__ __volatile__("rdtsc":"=a"(low), "=d"(high));
+
+    return ((unsigned long long) high << 32) | low;
+#elif defined(__GNUC__) && defined(__aarch64__)
+    unsigned long long count;
+
+    __asm__ __volatile__("mrs %0, cntvct_el0":"=r"(count));
+
+    return count;
+#else
+    return 0;
+#endif
+}
+
+void bench_init(struct bench *bench, const char *suite, int repetitions,
+        const char *fmt, ...)
+{
+    va_list ap;
+
+    memset(bench, 0, sizeof (struct bench));
+
+    bench->suite = suite;
+    bench->warmup = bench_env("BENCH_WARMUP", BENCH_WARMUP);
+    bench->repetitions = bench_env("BENCH_REPETITIONS", repetitions);
+    if (bench->repetitions == 0)
+        bench->repetitions = 1;
+
+    va_start(ap, fmt);
+    vsnprintf(bench->name, sizeof (bench->name), fmt, ap);
+    va_end(ap);
+}
+
+int bench_run(struct bench *bench, int (*run) (void *context), void *context)
+{
+    unsigned long long *walls, *cycles, start, start_cycles, sum = 0;
+    unsigned long long allocs;
+    int i;
+
+    for (i = 0; i < bench->warmup; i++)
+        if (run(context) == -1)
+            return -1;
+
+    /* Made before the allocations are counted */
+    walls = (unsigned long long *) cgdb_calloc(bench->repetitions,
+            sizeof (unsigned long long));
+    cycles = (unsigned long long *) cgdb_calloc(bench->repetitions,
+            sizeof (unsigned long long));
+
+    allocs = cgdb_alloc_count();
+    for (i = 0; i < bench->repetitions; i++) {
+        start_cycles = bench_cycles();
+        start = bench_wall();
+
+        if (run(context) == -1) {
+            free(walls);
+            free(cycles);
+            return -1;
+        }
+
+        walls[i] = bench_wall() - start;
+        cycles[i] = bench_cycles() - start_cycles;
+    }
+    bench->allocs = (double) (cgdb_alloc_count() - allocs) /
+            bench->repetitions;
+
+    bench->wall_min = walls[0];
+    for (i = 0; i < bench->repetitions; i++) {
+        sum += walls[i];
+        if (walls[i] < bench->wall_min)
+            bench->wall_min = walls[i];
+    }
+    bench->wall_mean = sum / bench->repetitions;
+    bench->wall_median = bench_median(walls, bench->repetitions);
+    bench->cycles_median = bench_median(cycles, bench->repetitions);
+
+    free(walls);
+    free(cycles);
+
+    return 0;
+}
+
+void bench_print(const struct bench *bench, const char *fmt, ...)
+{
+    va_list ap;
+
+    printf("{\"suite\": ");
+    bench_string(bench->suite);
+    printf(", \"benchmark\": ");
+    bench_string(bench->name);
+    printf(", \"warmup\": %d, \"repetitions\": %d, "
+            "\"wall_ns_min\": %llu, \"wall_ns_median\": %llu, "
+            "\"wall_ns_mean\": %llu, \"cycles_median\": %llu, "
+            "\"allocs_per_rep\": %.3f",
+            bench->warmup, bench->repetitions, bench->wall_min,
+            bench->wall_median, bench->wall_mean, bench->cycles_median,
+            bench->allocs);
+
+    if (bench->items && bench->unit) {
+        printf(", \"%s_per_rep\": %llu, \"%s_per_s\": %.0f", bench->unit,
+                bench->items, bench->unit, bench->items * 1e9 /
+                (bench->wall_median ? bench->wall_median : 1));
+    }
+
+    if (fmt) {
+        printf(", ");
+        va_start(ap, fmt);
+        vprintf(fmt, ap);
+        va_end(ap);
+    }
+
+    printf("}\n");
+    fflush(stdout);
+}
@@ -0,0 +1,106 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+/*******************************************************************************
+ *
+ * This is the benchmark harness. Each benchmark program of cgdb and its
+ * libraries measures what it measures with it, so they all warm up, repeat
+ * and time the same way, and all write the same line of JSON for it.
+ *
+ * A benchmark is a function that does the work once. bench_run calls it a
+ * few times to warm up, then times each of the repetitions by itself, with
+ * the wall clock and, where the processor has one, its cycle counter. The
+ * allocations made through cgdb_malloc and the rest of the wrappers of
+ * sys_util.h during the repetitions are counted as well.
+ *
+ * The number of warmups and repetitions can be set for all benchmarks at
+ * once with BENCH_WARMUP and BENCH_REPETITIONS in the environment.
+ *
+ * The lines of JSON are compared with the ones of an earlier run by
+ * bench_compare, see "make bench".
+ ******************************************************************************/
+
+/* A benchmark, and what it measured */
+struct bench {
+    /* Set by bench_init, they can be changed before bench_run */
+    const char *suite;          /* The program or library it's part of */
+    char name[256];             /* What it measures, in the suite */
+    int warmup;                 /* The runs that aren't timed */
+    int repetitions;            /* The runs that are */
+
+    /* The units of work of a repetition, like bytes or records, and what
+     * they are. The JSON has how many are done a second, if it's not 0. */
+    unsigned long long items;
+    const char *unit;
+
+    /* Set by bench_run, the times are of a repetition, in nanoseconds */
+    unsigned long long wall_min;
+    unsigned long long wall_median;
+    unsigned long long wall_mean;
+    unsigned long long cycles_median;   /* 0 without a cycle counter */
+    double allocs;              /* Allocations a repetition */
+};
+
+/* bench_init:
+ * -----------
+ *
+ *  Sets up a benchmark with the default warmups and repetitions, or the
+ *  ones of the environment.
+ *
+ *  bench       - The benchmark.
+ *  suite       - The program or library it's part of, it's kept.
+ *  repetitions - The default number of repetitions.
+ *  fmt         - The name of the benchmark, formatted like printf.
+ */
+void bench_init(struct bench *bench, const char *suite, int repetitions,
+        const char *fmt, ...)
+#ifdef __GNUC__
+        __attribute__ ((format(printf, 4, 5)))
+#endif
+        ;
+
+/* bench_run:
+ * ----------
+ *
+ *  Warms up and runs a benchmark, and records what it measured in it.
+ *
+ *  bench   - The benchmark.
+ *  run     - Does the work once. It returns 0, or -1 to stop on an error.
+ *  context - Passed to run.
+ *
+ *  Returns 0 on success, or -1 if run failed.
+ */
+int bench_run(struct bench *bench, int (*run) (void *context), void *context);
+
+/* bench_print:
+ * ------------
+ *
+ *  Writes the line of JSON of a benchmark to stdout.
+ *
+ *  bench - The benchmark, after bench_run.
+ *  fmt   - More fields of the benchmark's own, formatted like printf, as
+ *          in "\"bytes\": %lu", or NULL for none.
+ */
+void bench_print(const struct bench *bench, const char *fmt, ...)
+#ifdef __GNUC__
+        __attribute__ ((format(printf, 2, 3)))
+#endif
+        ;
+
+/* bench_wall:
+ * -----------
+ *
+ *  Returns the time now, in nanoseconds, from a clock that's never set
+ *  back. For the benchmarks that time something bench_run doesn't.
+ */
+unsigned long long bench_wall(void);
+
+/* bench_cycles:
+ * -------------
+ *
+ *  Returns the processor's cycle counter, or 0 if it has none cgdb knows
+ *  how to read.
+ */
+unsigned long long bench_cycles(void);
+
+#endif /* __BENCH_H__ */
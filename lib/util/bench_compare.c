@@ -0,0 +1,218 @@
+/*
+ * bench_compare: Compares the lines of JSON bench_print wrote in a run of
+ * the benchmarks with the ones of an earlier run, the baseline.
+ *
+ * Usage: bench_compare [-t PERCENT] BASELINE CURRENT
+ *
+ * The benchmarks are matched by their suite and name, and the median time
+ * of a repetition of each is compared. One that takes more than PERCENT
+ * longer than in the baseline, 10 by default, is a regression. Lines that
+ * aren't JSON, and benchmarks only one of the runs has, are listed but
+ * don't count.
+ *
+ * It exits with 1 if there's a regression, 2 on error, 0 otherwise.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#include "sys_util.h"
+
+/* A benchmark of a run */
+struct result {
+    char *key;                  /* The suite and the name */
+    double median;              /* wall_ns_median */
+    int matched;                /* 1 once the other run has it too */
+};
+
+struct run {
+    struct result *results;
+    int count, size;
+};
+
+/* json_string: Gets the string value of a field of a line of JSON.
+ * ------------
+ *
+ * Only the escapes bench_print makes are undone.
+ *
+ * Return Value: The value, or NULL if the line doesn't have the field.
+ */
+static char *json_string(const char *line, const char *field)
+{
+    char pattern[64], *value;
+    const char *at;
+    size_t length = 0;
+
+    snprintf(pattern, sizeof (pattern), "\"%s\": \"", field);
+    if (!(at = strstr(line, pattern)))
+        return NULL;
+    at += strlen(pattern);
+
+    value = cgdb_malloc(strlen(at) + 1);
+    for (; *at && *at != '"'; at++) {
+        if (*at == '\\' && at[1])
+            at++;
+        value[length++] = *at;
+    }
+    value[length] = '\0';
+
+    return value;
+}
+
+/* json_number: Gets the number value of a field of a line of JSON.
+ * ------------
+ *
+ * Return Value: 0 on success, -1 if the line doesn't have the field.
+ */
+static int json_number(const char *line, const char *field, double *value)
+{
+    char pattern[64];
+    const char *at;
+
+    snprintf(pattern, sizeof (pattern), "\"%s\": ", field);
+    if (!(at = strstr(line, pattern)))
+        return -1;
+
+    *value = strtod(at + strlen(pattern), NULL);
+
+    return 0;
+}
+
+/* read_run: Reads the benchmarks of a run from a file.
+ * ---------
+ *
+ * Return Value: 0 on success, -1 if the file couldn't be read.
+ */
+static int read_run(const char *path, struct run *run)
+{
+    char line[4096], *suite, *name;
+    struct result result;
+    FILE *file;
+
+    if (!(file = fopen(path, "r"))) {
+        fprintf(stderr, "bench_compare: can't read %s\n", path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof (line), file)) {
+        if (line[0] != '{' || json_number(line, "wall_ns_median",
+                        &result.median) == -1)
+            continue;
+
+        suite = json_string(line, "suite");
+        name = json_string(line, "benchmark");
+        if (!suite || !name) {
+            free(suite);
+            free(name);
+            continue;
+        }
+
+        result.key = cgdb_malloc(strlen(suite) + strlen(name) + 2);
+        sprintf(result.key, "%s/%s", suite, name);
+        result.matched = 0;
+        free(suite);
+        free(name);
+
+        if (run->count == run->size) {
+            run->size = run->size ? run->size * 2 : 64;
+            run->results = cgdb_realloc(run->results,
+                    sizeof (struct result) * run->size);
+        }
+        run->results[run->count++] = result;
+    }
+
+    fclose(file);
+
+    return 0;
+}
+
+static struct result *find_result(struct run *run, const char *key)
+{
+    int i;
+
+    for (i = 0; i < run->count; i++)
+        if (!run->results[i].matched && strcmp(run->results[i].key, key) == 0)
+            return &run->results[i];
+
+    return NULL;
+}
+
+static void usage(const char *progname)
+{
+    fprintf(stderr, "Usage: %s [-t PERCENT] BASELINE CURRENT\n", progname);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    struct run baseline = { NULL, 0, 0 }, current = { NULL, 0, 0 };
+    struct result *old, *new;
+    double threshold = 10, change;
+    int regressions = 0, opt, i;
+
+    while ((opt = getopt(argc, argv, "t:")) != -1) {
+        switch (opt) {
+            case 't':
+                threshold = atof(optarg);
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+
+    if (optind + 2 != argc || threshold < 0)
+        usage(argv[0]);
+
+    if (read_run(argv[optind], &baseline) == -1 ||
+            read_run(argv[optind + 1], &current) == -1)
+        return 2;
+
+    printf("%-52s %14s %14s %9s\n", "Benchmark", "Baseline ns", "Current ns",
+            "Change");
+
+    for (i = 0; i < current.count; i++) {
+        new = &current.results[i];
+        if (!(old = find_result(&baseline, new->key))) {
+            printf("%-52s %14s %14.0f %9s\n", new->key, "-", new->median,
+                    "new");
+            continue;
+        }
+        old->matched = new->matched = 1;
+
+        change = old->median > 0 ?
+                (new->median - old->median) * 100 / old->median : 0;
+        printf("%-52s %14.0f %14.0f %+8.1f%%%s\n", new->key, old->median,
+                new->median, change, change > threshold ? " SLOWER" : "");
+
+        if (change > threshold)
+            regressions++;
+    }
+
+    for (i = 0; i < baseline.count; i++)
+        if (!baseline.results[i].matched)
+            printf("%-52s %14.0f %14s %9s\n", baseline.results[i].key,
+                    baseline.results[i].median, "-", "gone");
+
+    if (regressions)
+        printf("\n%d benchmark%s more than %.0f%% slower than the baseline\n",
+                regressions, regressions == 1 ? " is" : "s are", threshold);
+
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,500 @@
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif /* HAVE_SYS_TYPES_H */
+
+#if HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif /* HAVE_SYS_TIME_H */
+
+#if HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#elif HAVE_SYS_EVENT_H
+#include <sys/event.h>
+#else
+#include <poll.h>
+#endif /* HAVE_SYS_EPOLL_H */
+
+#include "event_loop.h"
+#include "sys_util.h"
+#include "tracer.h"
+#include "stats.h"
+
+/* A descriptor being waited on. The serial tells a descriptor apart from
+ * one that was removed and added again while its event was pending. */
+struct event_entry {
+    int fd;
+    int priority;
+    event_handler handler;
+    void *context;
+    unsigned long serial;
+};
+
+/* A descriptor the kernel reported, waiting for its handler to be called */
+struct event_ready {
+    int fd;
+    int priority;
+    unsigned long serial;
+};
+
+struct event_timer {
+    int id;
+    struct timeval due;
+    event_timer_handler handler;
+    void *context;
+};
+
+static int loop_fd = -1;        /* The epoll or kqueue descriptor */
+static int started;
+static struct event_entry *entries;
+static int entries_count, entries_size;
+static struct event_ready *ready;
+static int ready_size;
+static struct event_timer *timers;
+static int timers_count, timers_size;
+static unsigned long serials;
+static int timer_ids;
+
+/* event_loop_find:
+ * ----------------
+ *
+ *  Returns the index of a descriptor in entries, or -1 if it isn't there.
+ */
+static int event_loop_find(int fd)
+{
+    int i;
+
+    for (i = 0; i < entries_count; i++)
+        if (entries[i].fd == fd)
+            return i;
+
+    return -1;
+}
+
+/* event_loop_reserve:
+ * -------------------
+ *
+ *  Makes room in ready for each descriptor that can be reported at once.
+ */
+static void event_loop_reserve(void)
+{
+    if (ready_size < entries_count) {
+        ready_size = entries_size;
+        ready = cgdb_realloc(ready, sizeof (struct event_ready) * ready_size);
+    }
+}
+
+/* event_loop_mark:
+ * ----------------
+ *
+ *  Adds a descriptor the kernel reported to ready.
+ */
+static void event_loop_mark(int fd, int *count)
+{
+    int i;
+
+    if ((i = event_loop_find(fd)) == -1)
+        return;
+
+    ready[*count].fd = fd;
+    ready[*count].priority = entries[i].priority;
+    ready[*count].serial = entries[i].serial;
+    (*count)++;
+}
+
+#if HAVE_SYS_EPOLL_H
+
+static int event_loop_open(void)
+{
+    return epoll_create(16);
+}
+
+static int event_loop_watch(int fd)
+{
+    struct epoll_event event;
+
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+
+    return epoll_ctl(loop_fd, EPOLL_CTL_ADD, fd, &event);
+}
+
+static void event_loop_unwatch(int fd)
+{
+    struct epoll_event event;
+
+    /* Fails when fd was closed already, which took it out of the set */
+    epoll_ctl(loop_fd, EPOLL_CTL_DEL, fd, &event);
+}
+
+static int event_loop_wait(int timeout)
+{
+    struct epoll_event events[16];
+    int count, result, i;
+
+    count = 0;
+    result = epoll_wait(loop_fd, events, 16, timeout);
+    for (i = 0; i < result; i++)
+        event_loop_mark(events[i].data.fd, &count);
+
+    return result == -1 ? -1 : count;
+}
+
+#elif HAVE_SYS_EVENT_H
+
+static int event_loop_open(void)
+{
+    return kqueue();
+}
+
+static int event_loop_watch(int fd)
+{
+    struct kevent change;
+
+    EV_SET(&change, fd, EVFILT_READ, EV_ADD, 0, 0, NULL);
+
+    return kevent(loop_fd, &change, 1, NULL, 0, NULL);
+}
+
+static void event_loop_unwatch(int fd)
+{
+    struct kevent change;
+
+    /* Fails when fd was closed already, which took it out of the queue */
+    EV_SET(&change, fd, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+    kevent(loop_fd, &change, 1, NULL, 0, NULL);
+}
+
+static int event_loop_wait(int timeout)
+{
+    struct kevent events[16];
+    struct timespec ts;
+    int count, result, i;
+
+    ts.tv_sec = timeout / 1000;
+    ts.tv_nsec = (timeout % 1000) * 1000000;
+
+    count = 0;
+    result = kevent(loop_fd, NULL, 0, events, 16,
+            timeout == -1 ? NULL : &ts);
+    for (i = 0; i < result; i++)
+        event_loop_mark((int) events[i].ident, &count);
+
+    return result == -1 ? -1 : count;
+}
+
+#else
+
+static struct pollfd *polls;
+static int polls_size;
+
+static int event_loop_open(void)
+{
+    /* poll gets the descriptors each time, there's nothing to open */
+    return -1;
+}
+
+static int event_loop_watch(int fd)
+{
+    return 0;
+}
+
+static void event_loop_unwatch(int fd)
+{
+}
+
+static int event_loop_wait(int timeout)
+{
+    int count, result, i;
+
+    if (polls_size < entries_count) {
+        polls_size = entries_size;
+        polls = cgdb_realloc(polls, sizeof (struct pollfd) * polls_size);
+    }
+
+    for (i = 0; i < entries_count; i++) {
+        polls[i].fd = entries[i].fd;
+        polls[i].events = POLLIN;
+        polls[i].revents = 0;
+    }
+
+    count = 0;
+    result = poll(polls, entries_count, timeout);
+    for (i = 0; result > 0 && i < entries_count; i++)
+        if (polls[i].revents & (POLLIN | POLLHUP | POLLERR))
+            event_loop_mark(polls[i].fd, &count);
+
+    return result == -1 ? -1 : count;
+}
+
+#endif /* HAVE_SYS_EPOLL_H */
+
+/* event_loop_compare:
+ * -------------------
+ *
+ *  Orders ready by priority, for qsort.
+ */
+static int event_loop_compare(const void *a, const void *b)
+{
+    const struct event_ready *x = a, *y = b;
+
+    return x->priority - y->priority;
+}
+
+/* event_loop_until:
+ * -----------------
+ *
+ *  Returns the milliseconds from now to a time, 0 if it's passed.
+ */
+static int event_loop_until(struct timeval *due, struct timeval *now)
+{
+    long msecs = (due->tv_sec - now->tv_sec) * 1000 +
+            (due->tv_usec - now->tv_usec) / 1000;
+
+    return msecs > 0 ? (int) msecs : 0;
+}
+
+/* event_loop_timeout:
+ * -------------------
+ *
+ *  Shortens a timeout so the wait ends when the first timer expires.
+ */
+static int event_loop_timeout(int timeout)
+{
+    struct timeval now;
+    int i, msecs;
+
+    if (timers_count == 0)
+        return timeout;
+
+    gettimeofday(&now, NULL);
+    for (i = 0; i < timers_count; i++) {
+        msecs = event_loop_until(&timers[i].due, &now);
+        if (timeout == -1 || msecs < timeout)
+            timeout = msecs;
+    }
+
+    return timeout;
+}
+
+/* event_loop_expire:
+ * ------------------
+ *
+ *  Calls the handlers of the timers that expired.
+ */
+static void event_loop_expire(void)
+{
+    struct event_timer timer;
+    struct timeval now;
+    int i;
+
+    gettimeofday(&now, NULL);
+    for (i = 0; i < timers_count;) {
+        if (event_loop_until(&timers[i].due, &now) > 0) {
+            i++;
+            continue;
+        }
+
+        /* Removing it first lets the handler add it again */
+        timer = timers[i];
+        timers[i] = timers[--timers_count];
+        timer.handler(timer.context);
+    }
+}
+
+int event_loop_init(void)
+{
+    if (started)
+        return 0;
+
+    loop_fd = event_loop_open();
+#if HAVE_SYS_EPOLL_H || HAVE_SYS_EVENT_H
+    if (loop_fd == -1)
+        return -1;
+
+    /* gdb and the inferior don't need it */
+    fcntl(loop_fd, F_SETFD, FD_CLOEXEC);
+#endif
+
+    started = 1;
+
+    return 0;
+}
+
+int event_loop_add(int fd, int priority, event_handler handler,
+        void *context)
+{
+    int i;
+
+    if (!started || fd == -1 || !handler)
+        return -1;
+
+    /* The descriptor may be another one by now, so the kernel is told
+     * about it again */
+    if ((i = event_loop_find(fd)) != -1)
+        event_loop_unwatch(fd);
+    else {
+        if (entries_count == entries_size) {
+            entries_size = entries_size ? entries_size * 2 : 16;
+            entries = cgdb_realloc(entries,
+                    sizeof (struct event_entry) * entries_size);
+        }
+        i = entries_count++;
+    }
+
+    entries[i].fd = fd;
+    entries[i].priority = priority;
+    entries[i].handler = handler;
+    entries[i].context = context;
+    entries[i].serial = ++serials;
+
+    if (event_loop_watch(fd) == -1) {
+        entries[i] = entries[--entries_count];
+        return -1;
+    }
+
+    return 0;
+}
+
+void event_loop_remove(int fd)
+{
+    int i;
+
+    if (fd == -1 || (i = event_loop_find(fd)) == -1)
+        return;
+
+    event_loop_unwatch(fd);
+    entries[i] = entries[--entries_count];
+}
+
+int event_loop_add_timer(int msecs, event_timer_handler handler,
+        void *context)
+{
+    struct event_timer *timer;
+
+    if (timers_count == timers_size) {
+        timers_size = timers_size ? timers_size * 2 : 4;
+        timers = cgdb_realloc(timers,
+                sizeof (struct event_timer) * timers_size);
+    }
+
+    timer = &timers[timers_count++];
+    timer->id = timer_ids++;
+    timer->handler = handler;
+    timer->context = context;
+
+    gettimeofday(&timer->due, NULL);
+    timer->due.tv_sec += msecs / 1000;
+    timer->due.tv_usec += (msecs % 1000) * 1000;
+    if (timer->due.tv_usec >= 1000000) {
+        timer->due.tv_sec++;
+        timer->due.tv_usec -= 1000000;
+    }
+
+    /* Ids wrap around long before a timer could still be waiting */
+    if (timer_ids < 0)
+        timer_ids = 0;
+
+    return timer->id;
+}
+
+void event_loop_remove_timer(int timer)
+{
+    int i;
+
+    for (i = 0; i < timers_count; i++) {
+        if (timers[i].id == timer) {
+            timers[i] = timers[--timers_count];
+            return;
+        }
+    }
+}
+
+/* Each time the wait ends, and the times only a timer ended it. When
+ * nothing's happening, neither should go up. */
+static struct stats_counter stats_wakeups =
+        STATS_COUNTER("event loop wakeups");
+static struct stats_counter stats_timer_wakeups =
+        STATS_COUNTER("event loop timer wakeups");
+
+int event_loop_run(int timeout)
+{
+    int count, handled, result, i, j;
+    unsigned long long span;
+
+    if (!started)
+        return -1;
+
+    event_loop_reserve();
+
+    span = tracer_begin();
+    count = event_loop_wait(event_loop_timeout(timeout));
+    tracer_end("wait", span);
+    if (count == -1) {
+        if (errno != EINTR)
+            return -1;
+        count = 0;
+    }
+
+    STATS_ADD(&stats_wakeups, 1);
+    if (count == 0 && timers_count > 0)
+        STATS_ADD(&stats_timer_wakeups, 1);
+
+    span = tracer_begin();
+
+    qsort(ready, count, sizeof (struct event_ready), event_loop_compare);
+
+    handled = 0;
+    for (i = 0; i < count; i++) {
+        /* An earlier handler removed it, or put another in its place */
+        j = event_loop_find(ready[i].fd);
+        if (j == -1 || entries[j].serial != ready[i].serial)
+            continue;
+
+        handled++;
+        result = entries[j].handler(ready[i].fd, entries[j].context);
+        if (result == -1)
+            return -1;
+        if (result == 1)
+            break;
+    }
+
+    event_loop_expire();
+    tracer_end("wakeup", span);
+
+    return handled;
+}
+
+void event_loop_shutdown(void)
+{
+    if (!started)
+        return;
+
+    if (loop_fd != -1) {
+        cgdb_close(loop_fd);
+        loop_fd = -1;
+    }
+
+    entries_count = 0;
+    timers_count = 0;
+    started = 0;
+}
@@ -0,0 +1,119 @@
+#ifndef __EVENT_LOOP_H__
+#define __EVENT_LOOP_H__
+
+/*******************************************************************************
+ *
+ * This is the event loop unit. It waits for file descriptors to become
+ * readable and for timers to expire, and calls the handler registered for
+ * each one. It waits with epoll on Linux, kqueue on the BSDs and Mac OS X,
+ * and poll everywhere else, so the set of descriptors doesn't have to be
+ * handed to the kernel again each time, and there's no limit on how big a
+ * descriptor can be.
+ *
+ * The handlers of the descriptors that are ready at the same time are
+ * called in the order of their priorities, lowest first.
+ ******************************************************************************/
+
+/* event_handler:
+ * --------------
+ *
+ *  Called by event_loop_run when a descriptor is readable.
+ *
+ *  fd      - The descriptor.
+ *  context - The context passed to event_loop_add.
+ *
+ *  Returns 0 to go on, 1 to leave the other descriptors that are ready
+ *  for the next call of event_loop_run, or -1 to make it return -1.
+ */
+typedef int (*event_handler) (int fd, void *context);
+
+/* event_timer_handler:
+ * --------------------
+ *
+ *  Called by event_loop_run when a timer expires.
+ *
+ *  context - The context passed to event_loop_add_timer.
+ */
+typedef void (*event_timer_handler) (void *context);
+
+/* event_loop_init:
+ * ----------------
+ *
+ *  Starts the event loop.
+ *
+ *  Returns 0 on success, or -1 on error.
+ */
+int event_loop_init(void);
+
+/* event_loop_add:
+ * ---------------
+ *
+ *  Calls a handler each time a descriptor is readable. A descriptor that's
+ *  already added gets the new handler.
+ *
+ *  fd       - The descriptor, -1 is ignored.
+ *  priority - The order the handler is called in, among the descriptors
+ *             that are ready at the same time.
+ *  handler  - The function to call.
+ *  context  - Passed along to handler.
+ *
+ *  Returns 0 on success, or -1 on error.
+ */
+int event_loop_add(int fd, int priority, event_handler handler,
+        void *context);
+
+/* event_loop_remove:
+ * ------------------
+ *
+ *  Stops calling the handler of a descriptor. It can be called from a
+ *  handler, and after the descriptor is closed.
+ *
+ *  fd - The descriptor, one that wasn't added is ignored.
+ */
+void event_loop_remove(int fd);
+
+/* event_loop_add_timer:
+ * ---------------------
+ *
+ *  Calls a handler once, after some time.
+ *
+ *  msecs   - The milliseconds to wait, 0 calls it the next time around.
+ *  handler - The function to call.
+ *  context - Passed along to handler.
+ *
+ *  Returns the timer, to pass to event_loop_remove_timer.
+ */
+int event_loop_add_timer(int msecs, event_timer_handler handler,
+        void *context);
+
+/* event_loop_remove_timer:
+ * ------------------------
+ *
+ *  Cancels a timer that hasn't expired yet.
+ *
+ *  timer - The timer from event_loop_add_timer, -1 is ignored.
+ */
+void event_loop_remove_timer(int timer);
+
+/* event_loop_run:
+ * ---------------
+ *
+ *  Waits for descriptors to be readable, and calls their handlers, then
+ *  calls the handlers of the timers that expired.
+ *
+ *  timeout - The most milliseconds to wait, if no timer expires before
+ *            then. 0 only checks, -1 waits for as long as it takes.
+ *
+ *  Returns the number of descriptors whose handler was called, 0 if none
+ *  were ready, or -1 if a handler or the wait failed.
+ */
+int event_loop_run(int timeout);
+
+/* event_loop_shutdown:
+ * --------------------
+ *
+ *  Forgets every descriptor and timer, and stops the event loop.
+ */
+void event_loop_shutdown(void);
+
+#endif /* __EVENT_LOOP_H__ */
@@ -40,6 +40,10 @@
 #include "pseudo.h"
 #include "logger.h"
 #include "terminal.h"
+#include "session.h"
+
+/* The socket of the session server gdb is run by, or NULL to run it here */
+static const char *session_socket_path = NULL;
 
 struct pty_pair {
     int masterfd;
@@ -179,6 +183,11 @@ static int pty_free_memory(char *s, int fd, int argc, char *argv[])
     return error;
 }
 
+void invoke_debugger_set_session(const char *socket_path)
+{
+    session_socket_path = socket_path;
+}
+
 int invoke_debugger(const char *path,
         int argc, char *argv[], int *in, int *out, int choice, char *filename)
 {
@@ -195,6 +204,10 @@ int invoke_debugger(const char *path,
     char slavename[64];
     int masterfd;
 
+    if (session_socket_path)
+        return session_attach(session_socket_path, path, argc, argv, in, out,
+                choice, filename);
+
     /* Copy the argv into the local_argv, and NULL terminate it.
      * sneak in the path name, the user did not type that */
     local_argv = (char **) cgdb_malloc((malloc_size) * sizeof (char *));
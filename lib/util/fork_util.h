@@ -80,4 +80,12 @@ const char *pty_pair_get_slavename(pty_pair_ptr pty_pair);
 int invoke_debugger(const char *path,
         int argc, char *argv[], int *in, int *out, int choice, char *filename);
 
+/* invoke_debugger_set_session: Makes invoke_debugger attach to the gdb
+ *      kept running by the session server on socket_path, starting them
+ *      if they aren't running already. See session.h.
+ *      socket_path: The path of the server's socket, or NULL to start
+ *                   gdb as a child of this process. It is not copied.
+ */
+void invoke_debugger_set_session(const char *socket_path);
+
 #endif
@@ -22,6 +22,10 @@
 #include <sys/stat.h>
 #endif
 
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
 #if HAVE_SIGNAL_H
 #include <signal.h>
 #endif /* HAVE_SIGNAL_H */
@@ -32,6 +36,7 @@
 
 #include "fs_util.h"
 #include "logger.h"
+#include "sys_util.h"
 
 #define MAXLINE 4096
 
@@ -123,6 +128,86 @@ void fs_util_get_path(const char *base, const char *name, char *path)
     strncpy(path, dir, strlen(dir) + 1);
 }
 
+void fs_util_get_hashed_path(const char *base, unsigned int hash, char *path)
+{
+    char name[16];
+
+    sprintf(name, "%08x", hash);
+    fs_util_get_path(base, name, path);
+}
+
+char *fs_util_quote_path(const char *path)
+{
+    char *quoted = cgdb_malloc(strlen(path) * 2 + 3), *pos = quoted;
+
+    *pos++ = '"';
+    for (; *path; path++) {
+        if (*path == '"' || *path == '\\')
+            *pos++ = '\\';
+        *pos++ = *path;
+    }
+    *pos++ = '"';
+    *pos = '\0';
+
+    return quoted;
+}
+
+char *fs_util_unquote_path(char *text)
+{
+    char *from = text + 1, *to = text;
+
+    if (*text != '"')
+        return NULL;
+
+    for (; *from && *from != '"'; from++) {
+        if (*from == '\\' && from[1])
+            from++;
+        *to++ = *from;
+    }
+
+    if (*from != '"')
+        return NULL;
+
+    *to = '\0';
+
+    return from + 1;
+}
+
+int fs_util_write_file(const char *path, fs_util_writer writer, void *data)
+{
+    char temp[FSUTIL_PATH_MAX + 8];
+    FILE *file;
+    int fd, ret;
+
+    sprintf(temp, "%s.tmp", path);
+
+    if ((fd = open(temp, O_WRONLY | O_CREAT | O_TRUNC, 0600)) == -1)
+        return -1;
+
+    if (!(file = fdopen(fd, "w"))) {
+        close(fd);
+        unlink(temp);
+        return -1;
+    }
+
+    ret = writer(file, data);
+
+    if (ferror(file))
+        ret = -1;
+
+    if (fclose(file) == EOF)
+        ret = -1;
+
+    /* Readers see the old file or the new one, never part of one */
+    if (ret == 0 && rename(temp, path) == -1)
+        ret = -1;
+
+    if (ret == -1)
+        unlink(temp);
+
+    return ret;
+}
+
 int fs_util_file_exists_in_path(char * filePath)
 {
     struct stat buff;
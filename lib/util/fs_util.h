@@ -1,6 +1,14 @@
 #ifndef __FS_UTIL_H__
 #define __FS_UTIL_H__
 
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
 /*******************************************************************************
  *
  * This is the file system unit. All attempts to access the file system should
@@ -69,6 +77,68 @@ int fs_util_create_dir_in_base(const char *base, const char *dirname);
  */
 void fs_util_get_path(const char *base, const char *name, char *path);
 
+/* fs_util_get_hashed_path:
+ * ------------------------
+ *
+ *  Returns the path of the file named after a hash in directory base. This
+ *  is how the caches keep a file for each key.
+ *  ex. base=/home/me/.cgdb/cache, hash=0x1f => path=/home/me/.cgdb/cache/0000001f
+ *
+ *  base    - The directory the file is in
+ *  hash    - The hash of the key the file is for
+ */
+void fs_util_get_hashed_path(const char *base, unsigned int hash, char *path);
+
+/* fs_util_quote_path:
+ * -------------------
+ *
+ *  Quotes a path for gdb's commands, in double quotes, with a backslash in
+ *  front of each double quote and backslash in it.
+ *  ex. path=/tmp/a"b => "/tmp/a\"b"
+ *
+ *  path    - The path to quote
+ *
+ *  Returns the quoted path, which the caller frees.
+ */
+char *fs_util_quote_path(const char *path);
+
+/* fs_util_unquote_path:
+ * ---------------------
+ *
+ *  Reads back a path fs_util_quote_path quoted. The path is written over
+ *  the quoted one, from its start, and ended with a '\0'.
+ *
+ *  text    - The quoted path, starting at its opening quote
+ *
+ *  Returns what follows the closing quote, or NULL if there's none.
+ */
+char *fs_util_unquote_path(char *text);
+
+/* fs_util_writer:
+ * ---------------
+ *
+ *  Writes the contents of a file for fs_util_write_file.
+ *
+ *  Returns 0 on success or -1 on error.
+ */
+typedef int (*fs_util_writer) (FILE *file, void *data);
+
+/* fs_util_write_file:
+ * -------------------
+ *
+ *  Replaces the file at path with what writer writes. It writes to path.tmp,
+ *  and renames it over path once it's all written, so path is never left
+ *  half written. path.tmp is removed if anything fails. The file can only
+ *  be read by the user.
+ *
+ *  path    - The file to replace
+ *  writer  - Writes the contents of the file
+ *  data    - Passed to writer
+ *
+ *  Returns 0 on success or -1 on error.
+ */
+int fs_util_write_file(const char *path, fs_util_writer writer, void *data);
+
 /* fs_util_file_exists_in path:
  * ----------------------------
  *
@@ -0,0 +1,83 @@
+/*
+ * fs_util_check: Checks that the paths fs_util_quote_path quotes for gdb's
+ * commands are read back by fs_util_unquote_path as they were.
+ *
+ * Each path is put in a break command, the way a breakpoint is exported,
+ * and the command is split again, the way it's imported. "make check"
+ * runs it.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#include "fs_util.h"
+
+static const char *paths[] = {
+    "main.c",
+    "/home/me/src/main.c",
+    "/tmp/a b/main.c",
+    "/tmp/a\"b/main.c",
+    "/tmp/a\\b/main.c",
+    "/tmp/\\\"/main.c",
+    "/tmp/a:b/main.c",
+    "/tmp/ends with a backslash\\",
+    "\""
+};
+
+/* Returns 0 if a path makes it through a break command, -1 otherwise */
+static int round_trip(const char *path)
+{
+    char *quoted = fs_util_quote_path(path), *command, *rest;
+    int line = 0, ret = 0;
+
+    command = malloc(strlen(quoted) + 32);
+    sprintf(command, "%s:%d", quoted, 42);
+
+    rest = fs_util_unquote_path(command);
+    if (!rest || sscanf(rest, ":%d", &line) != 1 || line != 42 ||
+            strcmp(command, path) != 0) {
+        printf("FAIL: %s was quoted as %s\n", path, quoted);
+        ret = -1;
+    }
+
+    free(command);
+    free(quoted);
+
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    char unterminated[] = "\"/tmp/main.c:42", unquoted[] = "main.c:42";
+    int failures = 0;
+    size_t i;
+
+    for (i = 0; i < sizeof (paths) / sizeof (paths[0]); i++)
+        if (round_trip(paths[i]) == -1)
+            failures++;
+
+    /* A path that isn't quoted, or whose quote isn't closed, isn't read */
+    if (fs_util_unquote_path(unterminated) ||
+            fs_util_unquote_path(unquoted)) {
+        printf("FAIL: an unquoted path was read\n");
+        failures++;
+    }
+
+    if (failures == 0)
+        printf("PASS: %d paths\n", (int) i);
+
+    return failures ? 1 : 0;
+}
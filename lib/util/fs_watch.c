@@ -0,0 +1,321 @@
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif /* HAVE_SYS_TYPES_H */
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif /* HAVE_SYS_STAT_H */
+
+#if HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#elif HAVE_SYS_EVENT_H
+#include <sys/event.h>
+#include <sys/time.h>
+#endif /* HAVE_SYS_INOTIFY_H */
+
+#include "fs_watch.h"
+#include "sys_util.h"
+
+/* A watched file. inotify hands back the same watch for a file that's
+ * added twice, kqueue needs the device and inode to notice. */
+struct fs_watch_entry {
+    int watch;
+    int refs;
+    dev_t dev;
+    ino_t ino;
+};
+
+static int watch_fd = -1;       /* The inotify or kqueue descriptor */
+static struct fs_watch_entry *entries;
+static int entries_count, entries_size;
+
+/* fs_watch_find:
+ * --------------
+ *
+ *  Returns the index of a watch in entries, or -1 if it isn't there.
+ */
+static int fs_watch_find(int watch)
+{
+    int i;
+
+    for (i = 0; i < entries_count; i++)
+        if (entries[i].watch == watch)
+            return i;
+
+    return -1;
+}
+
+/* fs_watch_drop:
+ * --------------
+ *
+ *  Removes an entry from entries, without telling the kernel.
+ */
+static void fs_watch_drop(int i)
+{
+    entries[i] = entries[--entries_count];
+}
+
+/* fs_watch_insert:
+ * ----------------
+ *
+ *  Adds a new entry with one reference.
+ */
+static void fs_watch_insert(int watch, dev_t dev, ino_t ino)
+{
+    if (entries_count == entries_size) {
+        entries_size = entries_size ? entries_size * 2 : 16;
+        entries = cgdb_realloc(entries,
+                sizeof (struct fs_watch_entry) * entries_size);
+    }
+
+    entries[entries_count].watch = watch;
+    entries[entries_count].refs = 1;
+    entries[entries_count].dev = dev;
+    entries[entries_count].ino = ino;
+    entries_count++;
+}
+
+#if HAVE_SYS_INOTIFY_H
+
+static int fs_watch_open(void)
+{
+    return inotify_init();
+}
+
+static int fs_watch_add_file(const char *path)
+{
+    int watch, i;
+
+    watch = inotify_add_watch(watch_fd, path, IN_MODIFY | IN_ATTRIB |
+            IN_CLOSE_WRITE | IN_MOVE_SELF | IN_DELETE_SELF);
+    if (watch == -1)
+        return -1;
+
+    if ((i = fs_watch_find(watch)) != -1)
+        entries[i].refs++;
+    else
+        fs_watch_insert(watch, 0, 0);
+
+    return watch;
+}
+
+static void fs_watch_remove_file(int watch)
+{
+    inotify_rm_watch(watch_fd, watch);
+}
+
+int fs_watch_dispatch(fs_watch_callback callback, void *context)
+{
+    union {
+        struct inotify_event event;
+        char data[4096];
+    } u;
+    struct inotify_event *event;
+    ssize_t length, pos;
+    int i;
+
+    if (watch_fd == -1)
+        return -1;
+
+    while ((length = read(watch_fd, u.data, sizeof (u.data))) > 0) {
+        for (pos = 0; pos < length;
+                pos += sizeof (struct inotify_event) + event->len) {
+            event = (struct inotify_event *) (u.data + pos);
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                callback(-1, 0, context);
+                continue;
+            }
+
+            /* Events can still be queued for watches already removed */
+            if ((i = fs_watch_find(event->wd)) == -1)
+                continue;
+
+            if (event->mask & (IN_MOVE_SELF | IN_DELETE_SELF | IN_IGNORED)) {
+                /* A renamed file is still watched under its new name */
+                inotify_rm_watch(watch_fd, event->wd);
+                fs_watch_drop(i);
+                callback(event->wd, 1, context);
+            } else
+                callback(event->wd, 0, context);
+        }
+    }
+
+    if (length == -1 && errno != EAGAIN && errno != EINTR)
+        return -1;
+
+    return 0;
+}
+
+#elif HAVE_SYS_EVENT_H
+
+static int fs_watch_open(void)
+{
+    return kqueue();
+}
+
+static int fs_watch_add_file(const char *path)
+{
+    struct kevent change;
+    struct stat st;
+    int fd, i;
+
+#ifdef O_EVTONLY
+    fd = open(path, O_EVTONLY);
+#else
+    fd = open(path, O_RDONLY);
+#endif
+    if (fd == -1)
+        return -1;
+
+    if (fstat(fd, &st) == -1) {
+        cgdb_close(fd);
+        return -1;
+    }
+
+    /* The file is already watched through another path */
+    for (i = 0; i < entries_count; i++) {
+        if (entries[i].dev == st.st_dev && entries[i].ino == st.st_ino) {
+            cgdb_close(fd);
+            entries[i].refs++;
+            return entries[i].watch;
+        }
+    }
+
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    EV_SET(&change, fd, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+            NOTE_WRITE | NOTE_EXTEND | NOTE_ATTRIB | NOTE_DELETE |
+            NOTE_RENAME | NOTE_REVOKE, 0, NULL);
+    if (kevent(watch_fd, &change, 1, NULL, 0, NULL) == -1) {
+        cgdb_close(fd);
+        return -1;
+    }
+
+    fs_watch_insert(fd, st.st_dev, st.st_ino);
+
+    return fd;
+}
+
+static void fs_watch_remove_file(int watch)
+{
+    /* Closing the file takes it out of the kqueue */
+    cgdb_close(watch);
+}
+
+int fs_watch_dispatch(fs_watch_callback callback, void *context)
+{
+    struct kevent events[16];
+    struct timespec timeout = { 0, 0 };
+    int count, i, j, watch;
+
+    if (watch_fd == -1)
+        return -1;
+
+    do {
+        count = kevent(watch_fd, NULL, 0, events, 16, &timeout);
+        if (count == -1)
+            return errno == EINTR ? 0 : -1;
+
+        for (i = 0; i < count; i++) {
+            watch = (int) events[i].ident;
+
+            if ((j = fs_watch_find(watch)) == -1)
+                continue;
+
+            if (events[i].fflags & (NOTE_DELETE | NOTE_RENAME | NOTE_REVOKE)) {
+                cgdb_close(watch);
+                fs_watch_drop(j);
+                callback(watch, 1, context);
+            } else
+                callback(watch, 0, context);
+        }
+    } while (count == 16);
+
+    return 0;
+}
+
+#else
+
+static int fs_watch_open(void)
+{
+    return -1;
+}
+
+static int fs_watch_add_file(const char *path)
+{
+    return -1;
+}
+
+static void fs_watch_remove_file(int watch)
+{
+}
+
+int fs_watch_dispatch(fs_watch_callback callback, void *context)
+{
+    return -1;
+}
+
+#endif /* HAVE_SYS_INOTIFY_H */
+
+int fs_watch_init(void)
+{
+    if (watch_fd != -1)
+        return 0;
+
+    if ((watch_fd = fs_watch_open()) == -1)
+        return -1;
+
+    /* gdb and the inferior don't need it, and the main loop never waits
+     * on it when reading */
+    fcntl(watch_fd, F_SETFD, FD_CLOEXEC);
+    fcntl(watch_fd, F_SETFL, fcntl(watch_fd, F_GETFL) | O_NONBLOCK);
+
+    return 0;
+}
+
+int fs_watch_fd(void)
+{
+    return watch_fd;
+}
+
+int fs_watch_add(const char *path)
+{
+    if (watch_fd == -1 || !path)
+        return -1;
+
+    return fs_watch_add_file(path);
+}
+
+void fs_watch_remove(int watch)
+{
+    int i;
+
+    if (watch == -1 || (i = fs_watch_find(watch)) == -1)
+        return;
+
+    if (--entries[i].refs == 0) {
+        fs_watch_remove_file(watch);
+        fs_watch_drop(i);
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef __FS_WATCH_H__
+#define __FS_WATCH_H__
+
+/*******************************************************************************
+ *
+ * This is the file watching unit. It asks the kernel to report when files
+ * change, with inotify on Linux and kqueue on the BSDs and Mac OS X, so that
+ * files don't have to be stat'ed over and over to find out.
+ *
+ * Everything here quietly fails on systems with neither. Callers should
+ * treat a file that can't be watched as one that may have changed at any
+ * time.
+ ******************************************************************************/
+
+/* fs_watch_callback:
+ * ------------------
+ *
+ *  Called by fs_watch_dispatch for each file the kernel reported.
+ *
+ *  watch   - The watch of the file, or -1 if the kernel lost track and any
+ *            watched file may have changed.
+ *  gone    - 1 if the file was deleted or renamed, and so isn't watched
+ *            anymore. The watch must not be removed in that case.
+ *  context - The context passed to fs_watch_dispatch.
+ */
+typedef void (*fs_watch_callback) (int watch, int gone, void *context);
+
+/* fs_watch_init:
+ * --------------
+ *
+ *  Starts watching files.
+ *
+ *  Returns 0 on success, or -1 if files can't be watched.
+ */
+int fs_watch_init(void);
+
+/* fs_watch_fd:
+ * ------------
+ *
+ *  Gets the file descriptor that becomes readable when a watched file
+ *  changes. fs_watch_dispatch should be called when it does.
+ *
+ *  Returns the file descriptor, or -1 if files aren't being watched.
+ */
+int fs_watch_fd(void);
+
+/* fs_watch_add:
+ * -------------
+ *
+ *  Starts watching a file. Adding a file that's already watched gives the
+ *  same watch back, and it's removed once each add has been removed.
+ *
+ *  path - The file to watch.
+ *
+ *  Returns the watch, or -1 if the file can't be watched.
+ */
+int fs_watch_add(const char *path);
+
+/* fs_watch_remove:
+ * ----------------
+ *
+ *  Stops watching a file.
+ *
+ *  watch - The watch returned by fs_watch_add, -1 is ignored.
+ */
+void fs_watch_remove(int watch);
+
+/* fs_watch_dispatch:
+ * ------------------
+ *
+ *  Reads what the kernel reported and calls callback for each change.
+ *
+ *  callback - The function to call.
+ *  context  - Passed along to callback.
+ *
+ *  Returns 0 on success, or -1 on error.
+ */
+int fs_watch_dispatch(fs_watch_callback callback, void *context);
+
+#endif /* __FS_WATCH_H__ */
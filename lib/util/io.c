@@ -50,17 +50,55 @@
 #include <errno.h>
 #endif /* HAVE_ERRNO_H */
 
+#if HAVE_SIGNAL_H
+#include <signal.h>
+#endif /* HAVE_SIGNAL_H */
+
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
 #include "io.h"
+#include "io_trace.h"
 #include "logger.h"
 
 #define MAXLINE 4096
 
-static FILE *dfd = NULL;
+/*
+ * The debug trace. io_trace_put copies each record into buf, and the
+ * trace thread writes what's there to fd, so tracing doesn't make the
+ * reads that are traced wait on the disk. The thread writes when buf is
+ * half full, or IO_TRACE_FLUSH_MS after a record came in, and sleeps while
+ * there's nothing to write. When buf is full, records are
+ * dropped, and the number of bytes lost is recorded once there's room.
+ *
+ * head and tail only grow, a byte is at (index & IO_TRACE_MASK). Only the
+ * thread moves tail, after it wrote the bytes before it, so buf can be
+ * written from without holding the lock.
+ */
+#define IO_TRACE_SIZE (1024 * 1024)
+#define IO_TRACE_MASK (IO_TRACE_SIZE - 1)
+#define IO_TRACE_CHUNK (16 * 1024)
+#define IO_TRACE_FLUSH_MS 100
+
+struct io_trace {
+    int fd;
+    char *buf;
+    size_t head, tail;
+    size_t lost;
+    int stop;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_t thread;
+};
+
+static struct io_trace trace = {
+    .fd = -1,
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER
+};
 static int debug_on = 0;
 
-static const char *debug_begin = "";
-static const char *debug_end = "";
-
 static void process_error(void)
 {
     if (errno == EINTR)
@@ -79,23 +117,216 @@ static void process_error(void)
         logger_write_pos(logger, __FILE__, __LINE__, "ERRNO = EFAULT");
 }
 
+/* io_trace_copy: Copies size bytes of data to the end of the trace buffer.
+ * The caller holds the lock, and made sure there's room.
+ */
+static void io_trace_copy(const void *data, size_t size)
+{
+    size_t at = trace.head & IO_TRACE_MASK;
+    size_t first = IO_TRACE_SIZE - at;
+
+    if (first > size)
+        first = size;
+
+    memcpy(trace.buf + at, data, first);
+    memcpy(trace.buf, (const char *) data + first, size - first);
+    trace.head += size;
+}
+
+/* io_trace_put: Adds a record to the trace buffer, or drops it if the
+ * buffer is full.
+ */
+static void io_trace_put(enum io_trace_type type, int fd,
+        const char *data, size_t size)
+{
+    struct io_trace_header header;
+    struct timeval now;
+    size_t used;
+    int idle;
+
+    gettimeofday(&now, NULL);
+    header.sec = (uint32_t) now.tv_sec;
+    header.usec = (uint32_t) now.tv_usec;
+    header.fd = fd;
+
+    pthread_mutex_lock(&trace.mutex);
+
+    idle = trace.head == trace.tail;
+
+    if (trace.lost > 0 &&
+            IO_TRACE_SIZE - (trace.head - trace.tail) >= sizeof (header)) {
+        header.type = IO_TRACE_LOST;
+        header.length = (uint32_t) trace.lost;
+        io_trace_copy(&header, sizeof (header));
+        trace.lost = 0;
+    }
+
+    if (trace.lost > 0 ||
+            IO_TRACE_SIZE - (trace.head - trace.tail) <
+            sizeof (header) + size) {
+        trace.lost += size;
+    } else {
+        header.type = type;
+        header.length = (uint32_t) size;
+        io_trace_copy(&header, sizeof (header));
+        io_trace_copy(data, size);
+    }
+
+    /* The thread sleeps until there's something to write */
+    used = trace.head - trace.tail;
+    if ((idle && used > 0) || used >= IO_TRACE_SIZE / 2)
+        pthread_cond_signal(&trace.cond);
+
+    pthread_mutex_unlock(&trace.mutex);
+}
+
+/* io_trace_thread: Writes the trace buffer to the debug file.
+ * ---------------
+ */
+static void *io_trace_thread(void *arg)
+{
+    struct timeval now;
+    struct timespec deadline;
+    size_t start, end, at, first;
+    int dropped = 0;
+
+    pthread_mutex_lock(&trace.mutex);
+
+    for (;;) {
+        /* The records that come in with the first are written together */
+        while (!trace.stop && trace.head == trace.tail)
+            pthread_cond_wait(&trace.cond, &trace.mutex);
+
+        gettimeofday(&now, NULL);
+        deadline.tv_sec = now.tv_sec;
+        deadline.tv_nsec = (now.tv_usec + IO_TRACE_FLUSH_MS * 1000) * 1000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        while (!trace.stop && trace.head - trace.tail < IO_TRACE_SIZE / 2) {
+            if (pthread_cond_timedwait(&trace.cond, &trace.mutex,
+                            &deadline) == ETIMEDOUT)
+                break;
+        }
+
+        if (trace.head == trace.tail) {
+            if (trace.stop)
+                break;
+            continue;
+        }
+
+        start = trace.tail;
+        end = trace.head;
+        pthread_mutex_unlock(&trace.mutex);
+
+        /* Once a write fails, the rest is thrown away */
+        at = start & IO_TRACE_MASK;
+        first = IO_TRACE_SIZE - at;
+        if (first > end - start)
+            first = end - start;
+
+        if (!dropped && io_writen(trace.fd, trace.buf + at, first) == -1)
+            dropped = 1;
+        if (!dropped && end - start > first &&
+                io_writen(trace.fd, trace.buf, end - start - first) == -1)
+            dropped = 1;
+
+        pthread_mutex_lock(&trace.mutex);
+        trace.tail = end;
+    }
+
+    pthread_mutex_unlock(&trace.mutex);
+
+    return NULL;
+}
+
+/* io_debug_stop: Writes what's left in the trace buffer, and closes the
+ * debug file.
+ */
+static void io_debug_stop(void)
+{
+    if (debug_on != 1)
+        return;
+
+    pthread_mutex_lock(&trace.mutex);
+    trace.stop = 1;
+    pthread_cond_signal(&trace.cond);
+    pthread_mutex_unlock(&trace.mutex);
+
+    pthread_join(trace.thread, NULL);
+
+    close(trace.fd);
+    free(trace.buf);
+    trace.fd = -1;
+    trace.buf = NULL;
+    debug_on = 0;
+}
+
+/* io_debug_atfork_child: The trace thread isn't in a forked child, so it
+ * doesn't trace.
+ */
+static void io_debug_atfork_child(void)
+{
+    debug_on = 0;
+}
+
 int io_debug_init(const char *filename)
 {
-    char config_dir[MAXLINE];
+    static int registered = 0;
+    sigset_t all, old;
+    int ret;
 
     if (filename == NULL)
         return -1;
 
-    strcpy(config_dir, filename);
+    io_debug_stop();
 
-    if ((dfd = fopen(config_dir, "w")) == NULL) {
+    trace.fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (trace.fd == -1) {
         logger_write_pos(logger, __FILE__, __LINE__,
                 "could not open debug file");
         return -1;
     }
 
-    /* A nifty trick to have debug dump to the terminal
-     * dfd = stderr;*/
+    trace.buf = (char *) malloc(IO_TRACE_SIZE);
+    if (!trace.buf ||
+            io_writen(trace.fd, IO_TRACE_MAGIC, IO_TRACE_MAGIC_SIZE) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "could not start the debug trace");
+        free(trace.buf);
+        trace.buf = NULL;
+        close(trace.fd);
+        trace.fd = -1;
+        return -1;
+    }
+
+    trace.head = trace.tail = 0;
+    trace.lost = 0;
+    trace.stop = 0;
+
+    /* Signals are for the main thread */
+    sigfillset(&all);
+    pthread_sigmask(SIG_BLOCK, &all, &old);
+    ret = pthread_create(&trace.thread, NULL, io_trace_thread, NULL);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    if (ret != 0) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "could not start the debug trace");
+        free(trace.buf);
+        trace.buf = NULL;
+        close(trace.fd);
+        trace.fd = -1;
+        return -1;
+    }
+
+    if (!registered) {
+        atexit(io_debug_stop);
+        pthread_atfork(NULL, NULL, io_debug_atfork_child);
+        registered = 1;
+    }
 
     debug_on = 1;
 
@@ -104,8 +335,10 @@ int io_debug_init(const char *filename)
 
 void io_debug_write(const char *write)
 {
-    fprintf(dfd, "%s%s%s", debug_begin, write, debug_end);
-    fflush(dfd);
+    if (debug_on != 1)
+        return;
+
+    io_trace_put(IO_TRACE_NOTE, -1, write, strlen(write));
 }
 
 void io_debug_write_fmt(const char *fmt, ...)
@@ -113,6 +346,9 @@ void io_debug_write_fmt(const char *fmt, ...)
     va_list ap;
     char va_buf[MAXLINE];
 
+    if (debug_on != 1)
+        return;
+
     va_start(ap, fmt);
 #ifdef   HAVE_VSNPRINTF
     vsnprintf(va_buf, sizeof (va_buf), fmt, ap);    /* this is safe */
@@ -121,8 +357,7 @@ void io_debug_write_fmt(const char *fmt, ...)
 #endif
     va_end(ap);
 
-    fprintf(dfd, "%s", va_buf);
-    fflush(dfd);
+    io_trace_put(IO_TRACE_NOTE, -1, va_buf, strlen(va_buf));
 }
 
 int io_read_byte(char *c, int source)
@@ -166,6 +401,25 @@ int io_rw_byte(int source, int dest)
     return 0;
 }
 
+/* io_debug_read: Adds data that was read from fd to the debug trace.
+ * --------------
+ */
+static void io_debug_read(int fd, const char *buf, ssize_t size)
+{
+    size_t chunk;
+
+    if (debug_on != 1)
+        return;
+
+    /* Big reads are split so that one doesn't fill the buffer */
+    while (size > 0) {
+        chunk = size > IO_TRACE_CHUNK ? IO_TRACE_CHUNK : (size_t) size;
+        io_trace_put(IO_TRACE_READ, fd, buf, chunk);
+        buf += chunk;
+        size -= chunk;
+    }
+}
+
 ssize_t io_read(int fd, void *buf, size_t count)
 {
     ssize_t amountRead;
@@ -189,30 +443,58 @@ ssize_t io_read(int fd, void *buf, size_t count)
         char *tmp = (char *) buf;
 
         tmp[amountRead] = '\0';
-        if (debug_on == 1) {
-            int i;
-
-            fprintf(dfd, "%s", debug_begin);
-            for (i = 0; i < amountRead; ++i) {
-                if (((char *) buf)[i] == '\r')
-                    fprintf(dfd, "(%s)", "\\r");
-                else if (((char *) buf)[i] == '\n')
-                    fprintf(dfd, "(%s)\n", "\\n");
-                else if (((char *) buf)[i] == '\032')
-                    fprintf(dfd, "(%s)", "\\032");
-                else if (((char *) buf)[i] == '\b')
-                    fprintf(dfd, "(%s)", "\\b");
-                else
-                    fprintf(dfd, "%c", ((char *) buf)[i]);
-            }
-            fprintf(dfd, "%s", debug_end);
-            fflush(dfd);
-        }
+        io_debug_read(fd, tmp, amountRead);
         return amountRead;
 
     }
 }
 
+ssize_t io_read_ready(int fd, void *buf, size_t count)
+{
+    char *tmp = (char *) buf;
+    size_t total = 0;
+    ssize_t amountRead = 0;
+    int flag, error, reads = 0;
+
+    /* Set nonblocking, only while reading so writes to fd still wait */
+    flag = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flag | O_NONBLOCK);
+
+    while (total < count) {
+        amountRead = read(fd, tmp + total, count - total);
+        if (amountRead == -1 && errno == EINTR)
+            continue;
+        if (amountRead <= 0)
+            break;
+
+        total += amountRead;
+        reads++;
+    }
+
+    error = errno;
+    fcntl(fd, F_SETFL, flag);
+    errno = error;
+
+    tmp[total] = '\0';
+
+    if (total > 0) {
+        io_debug_read(fd, tmp, total);
+        if (debug_on == 1)
+            io_debug_write_fmt("(%d bytes in %d reads)\n", (int) total, reads);
+        return total;
+    }
+
+    /* Nothing was read, errno still tells why */
+    if (amountRead == -1 && errno == EAGAIN)
+        return -1;
+    else if (amountRead == -1 && errno != EIO) {
+        logger_write_pos(logger, __FILE__, __LINE__, "error reading from fd");
+        return -1;
+    }
+
+    return 0;                   /* EOF, EIO happens on EOF for some reason */
+}
+
 ssize_t io_writen(int fd, const void *vptr, size_t n)
 {
     ssize_t nwritten;
@@ -287,10 +569,24 @@ int io_getchar(int fd, unsigned int ms, int *key)
 {
     char c;
     int ret;
+
+    if (!key)
+        return -1;
+
+    ret = io_getchars(fd, ms, &c, 1);
+    if (ret == 1)
+        *key = c;
+
+    return ret;
+}
+
+int io_getchars(int fd, unsigned int ms, char *buf, int size)
+{
+    int ret;
     int flag = 0;
     int val;
 
-    if (!key)
+    if (!buf || size <= 0)
         return -1;
 
     val = io_data_ready(fd, ms);
@@ -308,18 +604,14 @@ int io_getchar(int fd, unsigned int ms, int *key)
 
   read_again:
 
-    /* Read a char */
-    ret = read(fd, &c, 1);
+    /* Read everything that's there */
+    ret = read(fd, buf, size);
 
-    if (ret == -1 && errno == EAGAIN)
-        c = 0;                  /* No data available */
-    else if (ret == -1 && errno == EINTR)
+    if (ret == -1 && errno == EINTR)
         goto read_again;
-    else if (ret == -1) {
-        c = 0;
+    else if (ret == -1 && errno != EAGAIN)
         logger_write_pos(logger, __FILE__, __LINE__, "Errno(%d)\n", errno);
-    } else if (ret == 0) {
-        c = 0;
+    else if (ret == 0) {
         ret = -1;
         logger_write_pos(logger, __FILE__, __LINE__, "Read returned nothing\n");
     }
@@ -327,9 +619,326 @@ int io_getchar(int fd, unsigned int ms, int *key)
     /* Set to original state */
     fcntl(fd, F_SETFL, flag);
 
-    if (ret == -1)
+    return ret;
+}
+
+/*
+ * The reader thread is the only one that moves tail, and the main thread is
+ * the only one that moves head. Both only grow, the buffer is at
+ * (index & IO_READER_MASK). So nothing is locked.
+ *
+ * The thread writes a byte to wake[1] each time it adds data, that is what
+ * makes io_reader_fd readable. When the buffer is full, it sets full and
+ * waits for a byte on space[0], which io_reader_read writes once it has
+ * made room.
+ */
+#define IO_READER_SIZE (256 * 1024)
+#define IO_READER_MASK (IO_READER_SIZE - 1)
+
+struct io_reader {
+    int fd;
+    int wake[2];
+    int space[2];
+    pthread_t thread;
+    size_t head;                /* Where the main thread takes data from */
+    size_t tail;                /* Where the thread puts data */
+    int full;                   /* 1 while the thread waits for room */
+    int done;                   /* 1 once the thread got to the end of fd */
+    int error;                  /* The errno the thread stopped on, or 0 */
+    char buf[IO_READER_SIZE];
+};
+
+/* io_reader_notify: Writes a byte to a pipe the other thread waits on. It
+ *                   never blocks, a full pipe has a byte to read already.
+ */
+static void io_reader_notify(int fd)
+{
+    char c = 0;
+
+    while (write(fd, &c, 1) == -1 && errno == EINTR);
+}
+
+static void *io_reader_thread(void *data)
+{
+    struct io_reader *reader = (struct io_reader *) data;
+    size_t head, tail, room;
+    ssize_t size;
+    char c;
+
+    for (;;) {
+        head = __atomic_load_n(&reader->head, __ATOMIC_SEQ_CST);
+        tail = reader->tail;
+
+        if (tail - head == IO_READER_SIZE) {
+            __atomic_store_n(&reader->full, 1, __ATOMIC_SEQ_CST);
+
+            /* The main thread may have made room before it saw full */
+            if (__atomic_load_n(&reader->head, __ATOMIC_SEQ_CST) == head)
+                while (read(reader->space[0], &c, 1) == -1 && errno == EINTR);
+            continue;
+        }
+
+        /* Read as much as fits before the buffer wraps */
+        room = IO_READER_SIZE - (tail - head);
+        if (room > IO_READER_SIZE - (tail & IO_READER_MASK))
+            room = IO_READER_SIZE - (tail & IO_READER_MASK);
+
+        size = read(reader->fd, reader->buf + (tail & IO_READER_MASK), room);
+        if (size == -1 && errno == EINTR)
+            continue;
+
+        if (size <= 0) {
+            /* EIO happens on EOF for some reason */
+            reader->error = (size == -1 && errno != EIO) ? errno : 0;
+            __atomic_store_n(&reader->done, 1, __ATOMIC_SEQ_CST);
+            io_reader_notify(reader->wake[1]);
+            return NULL;
+        }
+
+        __atomic_store_n(&reader->tail, tail + size, __ATOMIC_SEQ_CST);
+        io_reader_notify(reader->wake[1]);
+    }
+}
+
+struct io_reader *io_reader_create(int fd)
+{
+    struct io_reader *reader;
+    sigset_t all, old;
+    int ret;
+
+    reader = (struct io_reader *) malloc(sizeof (struct io_reader));
+    if (!reader)
+        return NULL;
+
+    reader->fd = fd;
+    reader->head = reader->tail = 0;
+    reader->full = reader->done = reader->error = 0;
+
+    if (pipe(reader->wake) == -1) {
+        free(reader);
+        return NULL;
+    }
+
+    if (pipe(reader->space) == -1) {
+        close(reader->wake[0]);
+        close(reader->wake[1]);
+        free(reader);
+        return NULL;
+    }
+
+    /* Only the thread waits on space, nothing waits on wake */
+    fcntl(reader->wake[0], F_SETFL, O_NONBLOCK);
+    fcntl(reader->wake[1], F_SETFL, O_NONBLOCK);
+    fcntl(reader->space[1], F_SETFL, O_NONBLOCK);
+
+    /* Signals are left to the main thread */
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    ret = pthread_create(&reader->thread, NULL, io_reader_thread, reader);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    if (ret != 0) {
+        close(reader->wake[0]);
+        close(reader->wake[1]);
+        close(reader->space[0]);
+        close(reader->space[1]);
+        free(reader);
+        return NULL;
+    }
+
+    return reader;
+}
+
+void io_reader_destroy(struct io_reader *reader)
+{
+    if (!reader)
+        return;
+
+    /* The thread is waiting in read, which is a cancellation point */
+    pthread_cancel(reader->thread);
+    pthread_join(reader->thread, NULL);
+
+    close(reader->wake[0]);
+    close(reader->wake[1]);
+    close(reader->space[0]);
+    close(reader->space[1]);
+    free(reader);
+}
+
+int io_reader_fd(struct io_reader *reader)
+{
+    return reader->wake[0];
+}
+
+ssize_t io_reader_read(struct io_reader *reader, void *buf, size_t count)
+{
+    char *tmp = (char *) buf, wake[MAXLINE];
+    size_t head = reader->head, tail, total, first;
+    int done;
+
+    /* Emptied before the data is looked at, so none is missed */
+    while (read(reader->wake[0], wake, sizeof (wake)) > 0);
+
+    done = __atomic_load_n(&reader->done, __ATOMIC_SEQ_CST);
+    tail = __atomic_load_n(&reader->tail, __ATOMIC_SEQ_CST);
+
+    if (tail == head) {
+        tmp[0] = '\0';
+
+        if (!done) {
+            errno = EAGAIN;
+            return -1;
+        } else if (reader->error) {
+            errno = reader->error;
+            logger_write_pos(logger, __FILE__, __LINE__,
+                    "error reading from fd");
+            return -1;
+        }
+
+        return 0;
+    }
+
+    total = tail - head;
+    if (total > count)
+        total = count;
+
+    first = IO_READER_SIZE - (head & IO_READER_MASK);
+    if (first > total)
+        first = total;
+
+    memcpy(tmp, reader->buf + (head & IO_READER_MASK), first);
+    memcpy(tmp + first, reader->buf, total - first);
+    tmp[total] = '\0';
+
+    __atomic_store_n(&reader->head, head + total, __ATOMIC_SEQ_CST);
+
+    /* The rest, or the end of fd, is still to be read */
+    if (head + total != tail || done)
+        io_reader_notify(reader->wake[1]);
+
+    if (__atomic_exchange_n(&reader->full, 0, __ATOMIC_SEQ_CST))
+        io_reader_notify(reader->space[1]);
+
+    io_debug_read(reader->fd, tmp, total);
+
+    return total;
+}
+
+/*
+ * The bytes waiting to be written are buf[start] up to buf[length]. A
+ * flush writes as many as the descriptor takes without blocking, and keeps
+ * the rest for the next one.
+ */
+#define IO_WRITER_SIZE 256
+
+struct io_writer {
+    char *buf;
+    size_t start;               /* The first byte not written yet */
+    size_t length;              /* The end of the bytes in buf */
+    size_t size;                /* The bytes allocated for buf */
+};
+
+struct io_writer *io_writer_create(void)
+{
+    struct io_writer *writer;
+
+    writer = (struct io_writer *) malloc(sizeof (struct io_writer));
+    if (!writer)
+        return NULL;
+
+    writer->buf = NULL;
+    writer->start = writer->length = writer->size = 0;
+
+    return writer;
+}
+
+void io_writer_destroy(struct io_writer *writer)
+{
+    if (!writer)
+        return;
+
+    free(writer->buf);
+    free(writer);
+}
+
+int io_writer_put(struct io_writer *writer, const void *buf, size_t n)
+{
+    size_t size;
+    char *grown;
+
+    /* The bytes that were written make room first */
+    if (writer->start > 0 && writer->length + n > writer->size) {
+        memmove(writer->buf, writer->buf + writer->start,
+                writer->length - writer->start);
+        writer->length -= writer->start;
+        writer->start = 0;
+    }
+
+    if (writer->length + n > writer->size) {
+        size = writer->size ? writer->size : IO_WRITER_SIZE;
+        while (size < writer->length + n)
+            size *= 2;
+
+        grown = (char *) realloc(writer->buf, size);
+        if (!grown)
+            return -1;
+
+        writer->buf = grown;
+        writer->size = size;
+    }
+
+    memcpy(writer->buf + writer->length, buf, n);
+    writer->length += n;
+
+    return 0;
+}
+
+size_t io_writer_pending(struct io_writer *writer)
+{
+    return writer->length - writer->start;
+}
+
+void io_writer_clear(struct io_writer *writer)
+{
+    writer->start = writer->length = 0;
+}
+
+int io_writer_flush(struct io_writer *writer, int fd)
+{
+    ssize_t size = 0;
+    int flag, error;
+
+    if (writer->start == writer->length)
+        return 0;
+
+    /* Set nonblocking, only while writing so other writes to fd still wait */
+    flag = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flag | O_NONBLOCK);
+
+    while (writer->start < writer->length) {
+        size = write(fd, writer->buf + writer->start,
+                writer->length - writer->start);
+        if (size == -1 && errno == EINTR)
+            continue;
+        if (size <= 0)
+            break;
+
+        writer->start += size;
+    }
+
+    error = errno;
+    fcntl(fd, F_SETFL, flag);
+    errno = error;
+
+    if (writer->start == writer->length) {
+        writer->start = writer->length = 0;
+        return 0;
+    }
+
+    if (size == -1 && errno != EAGAIN) {
+        logger_write_pos(logger, __FILE__, __LINE__, "error writing to fd");
         return -1;
+    }
 
-    *key = c;
     return 1;
 }
@@ -40,6 +40,20 @@ int io_rw_byte(int source, int dest);
  */
 ssize_t io_read(int fd, void *buf, size_t count);
 
+/* io_read_ready: Reads from fd until it has nothing more to give, or
+ *                count bytes have been read, without blocking. buf must
+ *                have room for count + 1 bytes, it's null terminated.
+ *
+ *                When debugging, the number of reads it took is written
+ *                to the debug file.
+ *
+ *          Returns: The amount read on success.
+ *                   0 on EOF and
+ *                   -1 on error, with errno set to EAGAIN if fd had
+ *                   nothing to read
+ */
+ssize_t io_read_ready(int fd, void *buf, size_t count);
+
 /* io_writen: This will write n bytes of vptr to fd. 
  *
  *     It recieves:
@@ -57,14 +71,17 @@ ssize_t io_writen(int fd, const void *vptr, size_t n);
  *    is usefull in determining what is going on under tgdb since the gui 
  *    is good at hiding that info from the user.
  *    
- *    filename is the file that the debug info will go to. If it is null, the 
- *    debug data will be writting to $HOME/.tgdb/tgdb_debug.txt
+ *    filename is the file that the debug info will go to. It's a binary
+ *    trace, see io_trace.h, that is written by a thread of its own so that
+ *    tracing hardly changes the timing of tgdb. Run io_trace_dump on it to
+ *    read it.
  *
  *    Returns: 0 on success, or -1 if can not open file.
  */
 int io_debug_init(const char *filename);
 
-/* io_debug_write: Writes null terminated data cstring to debug file.  */
+/* io_debug_write: Adds the null terminated cstring write to the debug trace.
+ *    Nothing is done if io_debug_init wasn't called. */
 void io_debug_write(const char *write);
 void io_debug_write_fmt(const char *fmt, ...);
 
@@ -114,4 +131,104 @@ int io_data_ready(int fd, int ms);
  */
 int io_getchar(int fd, unsigned int ms, int *key);
 
+/**
+ * Read in all the characters that are ready, up to size of them.
+ *
+ * This waits for input the same way io_getchar does, but then reads
+ * everything that has arrived with a single read.
+ *
+ * \param fd
+ * The descriptor to read in from.
+ *
+ * \param ms
+ * The The amount of time in milliseconds to wait for input.
+ * Pass 0, if you do not want to wait.
+ * Pass -1, if you want to block indefinately.
+ *
+ * \param buf
+ * The characters read if the return value is successful
+ *
+ * \param size
+ * The size of buf
+ *
+ * @return
+ * -1 on error, 0 if no data is ready, or the number of characters read
+ */
+int io_getchars(int fd, unsigned int ms, char *buf, int size);
+
+/* io_reader: Reads a file descriptor on a thread of its own, into a buffer
+ *            the main thread takes the data out of. The writer on the other
+ *            end of fd is never kept waiting on the main thread, unless the
+ *            buffer fills up.
+ */
+struct io_reader;
+
+/* io_reader_create: Starts reading fd on a new thread.
+ *
+ *      Returns: The reader, or NULL if the thread couldn't be started.
+ */
+struct io_reader *io_reader_create(int fd);
+
+/* io_reader_destroy: Stops the thread and frees the reader. fd is left open.
+ */
+void io_reader_destroy(struct io_reader *reader);
+
+/* io_reader_fd: Gets a file descriptor that is readable when the reader has
+ *               data, or has reached the end of fd. Select on it instead of
+ *               on fd, and call io_reader_read when it is readable.
+ */
+int io_reader_fd(struct io_reader *reader);
+
+/* io_reader_read: Takes up to count bytes the thread read, without
+ *                 blocking. buf must have room for count + 1 bytes, it's
+ *                 null terminated, like io_read_ready.
+ *
+ *          Returns: The amount read on success.
+ *                   0 on EOF and
+ *                   -1 on error, with errno set to EAGAIN if there was
+ *                   nothing to read
+ */
+ssize_t io_reader_read(struct io_reader *reader, void *buf, size_t count);
+
+/* io_writer: Collects bytes for a file descriptor, so that many small
+ *            writes, such as the keys of a paste, become one write. The
+ *            descriptor is given to each flush, so the same writer can be
+ *            used for it after it's opened again.
+ */
+struct io_writer;
+
+/* io_writer_create: Creates a writer with nothing waiting to be written.
+ *
+ *      Returns: The writer, or NULL if there's no memory.
+ */
+struct io_writer *io_writer_create(void);
+
+/* io_writer_destroy: Frees the writer, and the bytes it didn't write.
+ */
+void io_writer_destroy(struct io_writer *writer);
+
+/* io_writer_put: Adds n bytes of buf to the bytes waiting to be written.
+ *
+ *      Returns: 0 on success, or -1 if there's no memory.
+ */
+int io_writer_put(struct io_writer *writer, const void *buf, size_t n);
+
+/* io_writer_pending: Returns the number of bytes waiting to be written.
+ */
+size_t io_writer_pending(struct io_writer *writer);
+
+/* io_writer_clear: Forgets the bytes waiting to be written.
+ */
+void io_writer_clear(struct io_writer *writer);
+
+/* io_writer_flush: Writes the bytes waiting to fd, with a single write when
+ *                  it takes them all, without blocking. What fd can't take
+ *                  now is kept for the next flush.
+ *
+ *          Returns: 0 when everything was written,
+ *                   1 when some bytes are still waiting, fd would block and
+ *                   -1 on error
+ */
+int io_writer_flush(struct io_writer *writer, int fd);
+
 #endif /* __IO_H__ */
@@ -0,0 +1,51 @@
+#ifndef __IO_TRACE_H__
+#define __IO_TRACE_H__
+
+/* The format of the debug trace io_debug_init starts, see io.h.
+ *
+ * The file starts with IO_TRACE_MAGIC. Each record after it is a
+ * struct io_trace_header, followed by length bytes of data. The fields
+ * are in the byte order of the machine that wrote the trace.
+ *
+ * io_trace_dump prints a trace the way the debug file used to look.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDINT_H
+#include <stdint.h>
+#endif /* HAVE_STDINT_H */
+
+#define IO_TRACE_MAGIC "TGDBTRC1"
+#define IO_TRACE_MAGIC_SIZE 8
+
+enum io_trace_type {
+    /* Data that was read from fd */
+    IO_TRACE_READ = 1,
+
+    /* Text written with io_debug_write, like the commands sent to gdb */
+    IO_TRACE_NOTE,
+
+    /* length bytes of records didn't fit in the buffer, and were lost */
+    IO_TRACE_LOST
+};
+
+struct io_trace_header {
+    /* The time the record was made at */
+    uint32_t sec;
+    uint32_t usec;
+
+    /* The fd that was read from, or -1 */
+    int32_t fd;
+
+    /* The amount of data after the header, or for IO_TRACE_LOST, the
+     * amount that was lost */
+    uint32_t length;
+
+    /* An enum io_trace_type */
+    uint32_t type;
+};
+
+#endif /* __IO_TRACE_H__ */
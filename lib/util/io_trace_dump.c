@@ -0,0 +1,158 @@
+/*
+ * io_trace_dump: Prints a debug trace made by io_debug_init the way the
+ * debug file used to look, with what was read from gdb escaped.
+ *
+ * Usage: io_trace_dump [-t] [file]
+ *
+ * -t prints a line with the time, relative to the first record, the kind
+ * of record and the fd before each record. The trace is read from stdin if
+ * no file is given.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#include "io_trace.h"
+
+/* print_read: Prints data that was read, escaped like the debug file was.
+ * -----------
+ */
+static void print_read(FILE *out, const char *buf, size_t size)
+{
+    size_t i;
+
+    for (i = 0; i < size; ++i) {
+        if (buf[i] == '\r')
+            fputs("(\\r)", out);
+        else if (buf[i] == '\n')
+            fputs("(\\n)\n", out);
+        else if (buf[i] == '\032')
+            fputs("(\\032)", out);
+        else if (buf[i] == '\b')
+            fputs("(\\b)", out);
+        else
+            putc(buf[i], out);
+    }
+}
+
+/* print_header: Prints the line -t adds before a record.
+ * -------------
+ */
+static void print_header(FILE *out, const struct io_trace_header *header,
+        const struct io_trace_header *first)
+{
+    long long usec = ((long long) header->sec - first->sec) * 1000000 +
+            ((long long) header->usec - first->usec);
+
+    if (header->type == IO_TRACE_READ)
+        fprintf(out, "\n[%lld.%06lld read fd %d, %lu bytes]\n",
+                usec / 1000000, usec % 1000000, (int) header->fd,
+                (unsigned long) header->length);
+    else if (header->type == IO_TRACE_NOTE)
+        fprintf(out, "\n[%lld.%06lld note]\n", usec / 1000000,
+                usec % 1000000);
+}
+
+/* dump: Prints the trace in in to out.
+ * -----
+ *
+ * Returns: 0 on success, or -1 if in isn't a trace.
+ */
+static int dump(FILE *in, FILE *out, int times)
+{
+    struct io_trace_header header, first;
+    char magic[IO_TRACE_MAGIC_SIZE];
+    char *buf = NULL;
+    size_t buf_size = 0;
+    int records = 0;
+
+    if (fread(magic, 1, sizeof (magic), in) != sizeof (magic) ||
+            memcmp(magic, IO_TRACE_MAGIC, IO_TRACE_MAGIC_SIZE) != 0) {
+        fprintf(stderr, "io_trace_dump: not a debug trace\n");
+        return -1;
+    }
+
+    while (fread(&header, sizeof (header), 1, in) == 1) {
+        if (records++ == 0)
+            first = header;
+
+        if (header.type == IO_TRACE_LOST) {
+            fprintf(out, "(lost %lu bytes)\n", (unsigned long) header.length);
+            continue;
+        }
+
+        if (header.length > buf_size) {
+            char *bigger = (char *) realloc(buf, header.length);
+
+            if (!bigger) {
+                fprintf(stderr, "io_trace_dump: out of memory\n");
+                free(buf);
+                return -1;
+            }
+            buf = bigger;
+            buf_size = header.length;
+        }
+
+        if (fread(buf, 1, header.length, in) != header.length) {
+            fprintf(stderr, "io_trace_dump: the trace is cut short\n");
+            break;
+        }
+
+        if (times)
+            print_header(out, &header, &first);
+
+        if (header.type == IO_TRACE_READ)
+            print_read(out, buf, header.length);
+        else
+            fwrite(buf, 1, header.length, out);
+    }
+
+    free(buf);
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *in = stdin;
+    int times = 0;
+    int opt, ret;
+
+    while ((opt = getopt(argc, argv, "t")) != -1) {
+        if (opt == 't')
+            times = 1;
+        else {
+            fprintf(stderr, "Usage: %s [-t] [file]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (optind < argc && (in = fopen(argv[optind], "rb")) == NULL) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    ret = dump(in, stdout, times);
+
+    if (in != stdin)
+        fclose(in);
+
+    return ret == 0 ? 0 : 1;
+}
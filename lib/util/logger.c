@@ -22,8 +22,28 @@
 #include <errno.h>
 #endif /* HAVE_ERRNO_H */
 
+#if HAVE_SIGNAL_H
+#include <signal.h>
+#endif /* HAVE_SIGNAL_H */
+
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
 #define MAXLINE 4096
 
+/*
+ * The messages waiting to be written. logger_write_level copies each one
+ * into buf, and the logger's thread writes what's there to fd. When buf is
+ * full, messages are dropped, and the number that were is written once
+ * there's room.
+ *
+ * head and tail only grow, a byte is at (index & LOGGER_BUF_MASK). Only the
+ * thread moves tail, after it wrote the bytes before it.
+ */
+#define LOGGER_BUF_SIZE (64 * 1024)
+#define LOGGER_BUF_MASK (LOGGER_BUF_SIZE - 1)
+
 #include "logger.h"
 
 struct logger *logger = NULL;
@@ -51,8 +71,40 @@ struct logger {
 	 * 0 if it is not.
 	 */
     int recording;
+
+    /** The highest level of the messages that are written. */
+    int level;
+
+    /** The messages waiting for the thread, see LOGGER_BUF_SIZE. */
+    char *buf;
+    size_t head, tail;
+    unsigned long lost;
+
+    /** Set if the thread is running, and when it should stop. */
+    int started;
+    int stop;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;        /* There's something to write */
+    pthread_cond_t written;     /* The thread wrote what there was */
+    pthread_t thread;
 };
 
+/* Set in a forked child. The thread isn't there, so it writes itself. */
+static int logger_forked;
+
+static void logger_atfork_child(void)
+{
+    logger_forked = 1;
+}
+
+/* What's waiting is written out when the program exits without
+ * destroying the logger. */
+static void logger_atexit(void)
+{
+    logger_flush(logger);
+}
+
 struct logger *logger_create(void)
 {
     struct logger *log;
@@ -66,16 +118,207 @@ struct logger *logger_create(void)
     log->fd = NULL;
     log->used = 0;
     log->recording = 1;
+    log->level = LOGGER_LEVEL;
+
+    log->buf = NULL;
+    log->head = log->tail = 0;
+    log->lost = 0;
+    log->started = 0;
+    log->stop = 0;
+    pthread_mutex_init(&log->mutex, NULL);
+    pthread_cond_init(&log->cond, NULL);
+    pthread_cond_init(&log->written, NULL);
 
     return log;
 }
 
+/**
+ * Writes the messages in the buffer, until the logger is destroyed.
+ */
+static void *logger_thread(void *arg)
+{
+    struct logger *log = (struct logger *) arg;
+    size_t start, end, at, first;
+
+    pthread_mutex_lock(&log->mutex);
+
+    for (;;) {
+        while (!log->stop && log->head == log->tail)
+            pthread_cond_wait(&log->cond, &log->mutex);
+
+        if (log->head == log->tail)
+            break;
+
+        /* fd is only changed once the buffer is written, under the lock */
+        start = log->tail;
+        end = log->head;
+        pthread_mutex_unlock(&log->mutex);
+
+        at = start & LOGGER_BUF_MASK;
+        first = LOGGER_BUF_SIZE - at;
+        if (first > end - start)
+            first = end - start;
+
+        if (log->fd) {
+            fwrite(log->buf + at, 1, first, log->fd);
+            fwrite(log->buf, 1, end - start - first, log->fd);
+            fflush(log->fd);
+        }
+
+        pthread_mutex_lock(&log->mutex);
+        log->tail = end;
+        pthread_cond_broadcast(&log->written);
+    }
+
+    pthread_mutex_unlock(&log->mutex);
+
+    return NULL;
+}
+
+/**
+ * Starts the logger's thread, the first time something is written.
+ *
+ * \return
+ * 0 on success, or -1 if the logger has to write messages itself.
+ */
+static int logger_start(struct logger *log)
+{
+    static int registered = 0;
+    sigset_t all, old;
+    int ret;
+
+    pthread_mutex_lock(&log->mutex);
+
+    if (log->started) {
+        pthread_mutex_unlock(&log->mutex);
+        return 0;
+    }
+
+    log->buf = (char *) malloc(LOGGER_BUF_SIZE);
+    if (!log->buf) {
+        pthread_mutex_unlock(&log->mutex);
+        return -1;
+    }
+
+    if (!registered) {
+        pthread_atfork(NULL, NULL, logger_atfork_child);
+        atexit(logger_atexit);
+        registered = 1;
+    }
+
+    /* Signals are for the main thread */
+    sigfillset(&all);
+    pthread_sigmask(SIG_BLOCK, &all, &old);
+    ret = pthread_create(&log->thread, NULL, logger_thread, log);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    if (ret != 0) {
+        free(log->buf);
+        log->buf = NULL;
+        pthread_mutex_unlock(&log->mutex);
+        return -1;
+    }
+
+    log->started = 1;
+    pthread_mutex_unlock(&log->mutex);
+
+    return 0;
+}
+
+/**
+ * Copies size bytes of data to the end of the buffer. The caller holds
+ * the lock, and made sure there's room.
+ */
+static void logger_copy(struct logger *log, const char *data, size_t size)
+{
+    size_t at = log->head & LOGGER_BUF_MASK;
+    size_t first = LOGGER_BUF_SIZE - at;
+
+    if (first > size)
+        first = size;
+
+    memcpy(log->buf + at, data, first);
+    memcpy(log->buf, data + first, size - first);
+    log->head += size;
+}
+
+/**
+ * Adds a message to the buffer, or drops it if the buffer is full.
+ */
+static void logger_put(struct logger *log, const char *data, size_t size)
+{
+    char lost[64];
+    int length;
+
+    pthread_mutex_lock(&log->mutex);
+
+    if (log->lost > 0) {
+        length = snprintf(lost, sizeof (lost),
+                "(%lu log messages were dropped)\n", log->lost);
+        if (LOGGER_BUF_SIZE - (log->head - log->tail) >= (size_t) length) {
+            logger_copy(log, lost, length);
+            log->lost = 0;
+        }
+    }
+
+    if (log->lost > 0 || LOGGER_BUF_SIZE - (log->head - log->tail) < size)
+        log->lost++;
+    else
+        logger_copy(log, data, size);
+
+    pthread_cond_signal(&log->cond);
+    pthread_mutex_unlock(&log->mutex);
+}
+
+int logger_flush(struct logger *log)
+{
+    if (!log)
+        return -1;
+
+    if (!log->started || logger_forked)
+        return 0;
+
+    pthread_mutex_lock(&log->mutex);
+    while (log->head != log->tail)
+        pthread_cond_wait(&log->written, &log->mutex);
+    pthread_mutex_unlock(&log->mutex);
+
+    return 0;
+}
+
+/**
+ * Stops the logger's thread, once it wrote everything.
+ */
+static void logger_stop(struct logger *log)
+{
+    if (!log->started)
+        return;
+
+    if (!logger_forked) {
+        pthread_mutex_lock(&log->mutex);
+        log->stop = 1;
+        pthread_cond_signal(&log->cond);
+        pthread_mutex_unlock(&log->mutex);
+
+        pthread_join(log->thread, NULL);
+    }
+
+    free(log->buf);
+    log->buf = NULL;
+    log->started = 0;
+}
+
 int logger_destroy(struct logger *log)
 {
 
     if (!log)
         return 0;
 
+    logger_stop(log);
+    pthread_mutex_destroy(&log->mutex);
+    pthread_cond_destroy(&log->cond);
+    pthread_cond_destroy(&log->written);
+
     if (log->log_file) {
         free(log->log_file);
         log->log_file = NULL;
@@ -109,6 +352,9 @@ static int logger_close_writer(struct logger *log)
     if (!log)
         return -1;
 
+    /* What was written before goes to the old file */
+    logger_flush(log);
+
     /* A file is being written to */
     if (log->log_file) {
         free(log->log_file);
@@ -185,11 +431,16 @@ int logger_get_file(struct logger *log, char **file)
     return 0;
 }
 
-int logger_write_pos(struct logger *log,
-        const char *file, int line, const char *fmt, ...)
+/**
+ * Writes a message to the logger, the arguments are in a va_list.
+ */
+static int logger_write_va(struct logger *log, int level,
+        const char *file, int line, const char *fmt, va_list ap)
 {
-    va_list ap;
+    static const char *prefixes[] = { "", "warning: ", "info: ", "debug: " };
     char va_buf[MAXLINE];
+    char message[MAXLINE + 256];
+    int length;
 
     if (!log)
         return -1;
@@ -198,25 +449,64 @@ int logger_write_pos(struct logger *log,
     if (!fmt)
         return 0;
 
-    if (!log->recording)
+    if (!log->recording || level > log->level || !log->fd)
         return 0;
 
     /* Get the buffer with format */
-    va_start(ap, fmt);
 #ifdef   HAVE_VSNPRINTF
     vsnprintf(va_buf, sizeof (va_buf), fmt, ap);    /* this is safe */
 #else
     vsprintf(va_buf, fmt, ap);  /* this is not safe */
 #endif
-    va_end(ap);
 
-    fprintf(log->fd, "%s:%d %s\n", file, line, va_buf);
+    if (level < LOGGER_LEVEL_ERROR || level > LOGGER_LEVEL_DEBUG)
+        level = LOGGER_LEVEL_ERROR;
 
-    log->used = 1;
+    length = snprintf(message, sizeof (message), "%s:%d %s%s\n", file, line,
+            prefixes[level], va_buf);
+    if (length < 0)
+        return -1;
+    if ((size_t) length >= sizeof (message))
+        length = sizeof (message) - 1;
+
+    if (logger_forked || logger_start(log) == -1)
+        fwrite(message, 1, length, log->fd);
+    else
+        logger_put(log, message, length);
+
+    /* Info and debug messages aren't unexpected */
+    if (level <= LOGGER_LEVEL_WARNING)
+        log->used = 1;
 
     return 0;
 }
 
+int logger_write_pos(struct logger *log,
+        const char *file, int line, const char *fmt, ...)
+{
+    va_list ap;
+    int ret;
+
+    va_start(ap, fmt);
+    ret = logger_write_va(log, LOGGER_LEVEL_ERROR, file, line, fmt, ap);
+    va_end(ap);
+
+    return ret;
+}
+
+int logger_write_level(struct logger *log, int level,
+        const char *file, int line, const char *fmt, ...)
+{
+    va_list ap;
+    int ret;
+
+    va_start(ap, fmt);
+    ret = logger_write_va(log, level, file, line, fmt, ap);
+    va_end(ap);
+
+    return ret;
+}
+
 int logger_has_recv_data(struct logger *log, int *has_recv_data)
 {
     if (!has_recv_data)
@@ -246,6 +536,19 @@ int logger_set_record(struct logger *log, int record)
     return 0;
 }
 
+int logger_set_level(struct logger *log, int level)
+{
+    if (!log)
+        return -1;
+
+    if (level < LOGGER_LEVEL_ERROR || level > LOGGER_LEVEL_DEBUG)
+        return -1;
+
+    log->level = level;
+
+    return 0;
+}
+
 int logger_is_recording(struct logger *log)
 {
     if (!log)
@@ -17,9 +17,62 @@
  * \brief
  * This interface is intended to be the abstraction layer between an application 
  * and any data logging that application needs to perform.
+ *
+ * Writing to a logger doesn't wait on the disk. The message is formatted
+ * and copied to a buffer, and a thread of the logger's own writes it out.
  */
 /* }}} */
 
+/**
+ * @name Log levels
+ *
+ * Each message has a level. logger_write_pos writes errors, logger_warning,
+ * logger_info and logger_debug write the others.
+ *
+ * The levels above LOGGER_LEVEL aren't compiled in at all, their calls and
+ * the formatting of their arguments go away. It's LOGGER_LEVEL_INFO unless
+ * the build says otherwise, with CPPFLAGS=-DLOGGER_LEVEL=3 for instance.
+ * The levels that are compiled in can still be turned off with
+ * logger_set_level.
+ */
+
+/*@{*/
+
+#define LOGGER_LEVEL_ERROR 0
+#define LOGGER_LEVEL_WARNING 1
+#define LOGGER_LEVEL_INFO 2
+#define LOGGER_LEVEL_DEBUG 3
+
+#ifndef LOGGER_LEVEL
+#define LOGGER_LEVEL LOGGER_LEVEL_INFO
+#endif
+
+#define logger_error(log, ...) \
+    logger_write_level(log, LOGGER_LEVEL_ERROR, __FILE__, __LINE__, __VA_ARGS__)
+
+#define logger_warning(log, ...) \
+    do { \
+        if (LOGGER_LEVEL >= LOGGER_LEVEL_WARNING) \
+            logger_write_level(log, LOGGER_LEVEL_WARNING, __FILE__, __LINE__, \
+                    __VA_ARGS__); \
+    } while (0)
+
+#define logger_info(log, ...) \
+    do { \
+        if (LOGGER_LEVEL >= LOGGER_LEVEL_INFO) \
+            logger_write_level(log, LOGGER_LEVEL_INFO, __FILE__, __LINE__, \
+                    __VA_ARGS__); \
+    } while (0)
+
+#define logger_debug(log, ...) \
+    do { \
+        if (LOGGER_LEVEL >= LOGGER_LEVEL_DEBUG) \
+            logger_write_level(log, LOGGER_LEVEL_DEBUG, __FILE__, __LINE__, \
+                    __VA_ARGS__); \
+    } while (0)
+
+/*@}*/
+
 /* struct logger {{{ */
 
 /**
@@ -155,6 +208,46 @@ int logger_set_fd(struct logger *log, FILE * fd);
 int logger_write_pos(struct logger *log,
         const char *file, int line, const char *fmt, ...);
 
+/**
+ * Write data to the logger, at a level. The macros logger_warning,
+ * logger_info and logger_debug call this, with the position filled in.
+ *
+ * \param log
+ * The logger context to write to.
+ *
+ * \param level
+ * The level of the message, LOGGER_LEVEL_ERROR to LOGGER_LEVEL_DEBUG.
+ * It's thrown away if it's above the logger's level.
+ *
+ * \param file
+ * The name of the file the message was produced in
+ *
+ * \param line
+ * The line number the message came from
+ *
+ * \param fmt
+ * The format of the message
+ *
+ * \param ...
+ * The data to write
+ *
+ * \return
+ * 0 on succes, -1 on error
+ */
+int logger_write_level(struct logger *log, int level,
+        const char *file, int line, const char *fmt, ...);
+
+/**
+ * Waits until everything written to the logger is in its file.
+ *
+ * \param log
+ * The logger context
+ *
+ * \return
+ * 0 on succes, -1 on error
+ */
+int logger_flush(struct logger *log);
+
 /*@}*/
 
 /*@{*/
@@ -196,6 +289,22 @@ int logger_has_recv_data(struct logger *log, int *has_recv_data);
  */
 int logger_set_record(struct logger *log, int record);
 
+/**
+ * Sets the highest level of the messages the logger writes, the others
+ * are thrown away before they're formatted. By default it's LOGGER_LEVEL,
+ * the highest that's compiled in.
+ *
+ * \param log
+ * The logger context
+ *
+ * \param level
+ * LOGGER_LEVEL_ERROR to LOGGER_LEVEL_DEBUG
+ *
+ * \return
+ * 0 on succes, -1 on error
+ */
+int logger_set_level(struct logger *log, int level);
+
 /**
  * Checks to see if the logger is currently recording.
  *
@@ -0,0 +1,435 @@
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif /* HAVE_ERRNO_H */
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif /* HAVE_FCNTL_H */
+
+#if HAVE_SIGNAL_H
+#include <signal.h>
+#endif /* HAVE_SIGNAL_H */
+
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif /* HAVE_SYS_TYPES_H */
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif /* HAVE_SYS_STAT_H */
+
+#if HAVE_SYS_SELECT_H
+#include <sys/select.h>
+#endif /* HAVE_SYS_SELECT_H */
+
+#if HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif /* HAVE_SYS_WAIT_H */
+
+#if HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif /* HAVE_SYS_SOCKET_H */
+
+#if HAVE_SYS_UN_H
+#include <sys/un.h>
+#endif /* HAVE_SYS_UN_H */
+
+#include "session.h"
+#include "fork_util.h"
+#include "sys_util.h"
+#include "logger.h"
+#include "io.h"
+
+#if HAVE_SYS_SOCKET_H && HAVE_SYS_UN_H
+
+/**
+ * What the server tells a front end when it connects. gdb's pty comes
+ * with it, when the front end can attach.
+ */
+struct session_hello {
+    /* gdb's pid, or -1 if another front end is attached */
+    int pid;
+    /* 0 for annotate 2, 1 for gdbmi, as given to invoke_debugger */
+    int choice;
+    /* 1 if a front end was attached to this gdb before, otherwise 0 */
+    int attached;
+};
+
+/* The connection to the server, kept open while attached */
+static int session_fd = -1;
+
+/* session_address: Fills in the address of the socket at socket_path.
+ *
+ * Returns: 0 on success, or -1 if the path is too long.
+ */
+static int session_address(const char *socket_path, struct sockaddr_un *addr)
+{
+    memset(addr, 0, sizeof (struct sockaddr_un));
+    addr->sun_family = AF_UNIX;
+
+    if (strlen(socket_path) >= sizeof (addr->sun_path)) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "session socket path too long '%s'", socket_path);
+        return -1;
+    }
+
+    strcpy(addr->sun_path, socket_path);
+
+    return 0;
+}
+
+/* session_connect: Connects to the server on socket_path.
+ *
+ * Returns: The connection on success, or -1 on error, with errno set.
+ */
+static int session_connect(const char *socket_path)
+{
+    struct sockaddr_un addr;
+    int fd, error;
+
+    if (session_address(socket_path, &addr) == -1) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+
+    if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1)
+        return -1;
+
+    if (connect(fd, (struct sockaddr *) &addr, sizeof (addr)) == -1) {
+        error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+
+    return fd;
+}
+
+/* session_send: Sends the hello, and fd with it unless it's -1.
+ *
+ * Returns: 0 on success, or -1 on error.
+ */
+static int session_send(int sock, struct session_hello *hello, int fd)
+{
+    union {
+        struct cmsghdr align;
+        char buf[CMSG_SPACE(sizeof (int))];
+    } control;
+    struct msghdr msg;
+    struct iovec iov;
+    struct cmsghdr *cmsg;
+
+    memset(&msg, 0, sizeof (msg));
+    iov.iov_base = hello;
+    iov.iov_len = sizeof (struct session_hello);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    if (fd != -1) {
+        msg.msg_control = control.buf;
+        msg.msg_controllen = sizeof (control.buf);
+        cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof (int));
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof (int));
+    }
+
+    if (sendmsg(sock, &msg, 0) != sizeof (struct session_hello))
+        return -1;
+
+    return 0;
+}
+
+/* session_recv: Receives the hello, and the fd that came with it.
+ *
+ * fd:      Set to the fd, or -1 if none was sent.
+ *
+ * Returns: 0 on success, or -1 on error.
+ */
+static int session_recv(int sock, struct session_hello *hello, int *fd)
+{
+    union {
+        struct cmsghdr align;
+        char buf[CMSG_SPACE(sizeof (int))];
+    } control;
+    struct msghdr msg;
+    struct iovec iov;
+    struct cmsghdr *cmsg;
+    ssize_t size;
+
+    *fd = -1;
+
+    memset(&msg, 0, sizeof (msg));
+    iov.iov_base = hello;
+    iov.iov_len = sizeof (struct session_hello);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof (control.buf);
+
+    do
+        size = recvmsg(sock, &msg, 0);
+    while (size == -1 && errno == EINTR);
+
+    if (size != sizeof (struct session_hello))
+        return -1;
+
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+            memcpy(fd, CMSG_DATA(cmsg), sizeof (int));
+    }
+
+    return 0;
+}
+
+/* session_serve: Starts gdb and hands it to the front ends that connect,
+ * -------------  one at a time, until gdb exits. This runs in the server.
+ */
+static void session_serve(int listen_fd, const char *socket_path,
+        const char *path, int argc, char *argv[], int choice, char *filename)
+{
+    struct session_hello hello, busy;
+    struct timeval timeout;
+    fd_set set;
+    int masterfd, client = -1, fd, max_fd, i;
+    char c;
+
+    /* The server has no terminal, and nothing of cgdb's but the socket */
+    setsid();
+    signal(SIGHUP, SIG_IGN);
+    signal(SIGINT, SIG_IGN);
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGCHLD, SIG_DFL);
+
+    if ((fd = open("/dev/null", O_RDWR)) != -1) {
+        dup2(fd, STDIN_FILENO);
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+    }
+
+    max_fd = sysconf(_SC_OPEN_MAX);
+    for (i = STDERR_FILENO + 1; i < max_fd && i < 1024; ++i) {
+        if (i != listen_fd)
+            close(i);
+    }
+
+    /* Start gdb itself, not another server */
+    invoke_debugger_set_session(NULL);
+    hello.pid = invoke_debugger(path, argc, argv, &masterfd, &masterfd,
+            choice, filename);
+    hello.choice = choice;
+    hello.attached = 0;
+
+    if (hello.pid == -1) {
+        unlink(socket_path);
+        _exit(1);
+    }
+
+    while (waitpid(hello.pid, NULL, WNOHANG) == 0) {
+        FD_ZERO(&set);
+        FD_SET(listen_fd, &set);
+        max_fd = listen_fd;
+
+        if (client != -1) {
+            FD_SET(client, &set);
+            if (client > max_fd)
+                max_fd = client;
+        }
+
+        /* Wake up now and then to see if gdb is still running */
+        timeout.tv_sec = 1;
+        timeout.tv_usec = 0;
+
+        if (select(max_fd + 1, &set, NULL, NULL, &timeout) == -1) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        /* The front end never writes, so this is it going away */
+        if (client != -1 && FD_ISSET(client, &set) &&
+                read(client, &c, 1) <= 0) {
+            close(client);
+            client = -1;
+        }
+
+        if (!FD_ISSET(listen_fd, &set))
+            continue;
+
+        if ((fd = accept(listen_fd, NULL, NULL)) == -1)
+            continue;
+
+        if (client != -1) {
+            busy = hello;
+            busy.pid = -1;
+            session_send(fd, &busy, -1);
+            close(fd);
+        } else if (session_send(fd, &hello, masterfd) == 0) {
+            client = fd;
+            hello.attached = 1;
+        } else
+            close(fd);
+    }
+
+    unlink(socket_path);
+    _exit(0);
+}
+
+/* session_start: Starts a server listening on socket_path.
+ *
+ * Returns: 0 on success, or -1 on error.
+ */
+static int session_start(const char *socket_path, const char *path,
+        int argc, char *argv[], int choice, char *filename)
+{
+    struct sockaddr_un addr;
+    struct stat st;
+    int listen_fd, result;
+    mode_t mask;
+    pid_t pid;
+
+    if (session_address(socket_path, &addr) == -1)
+        return -1;
+
+    if ((listen_fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__, "socket error");
+        return -1;
+    }
+
+    /* Whoever can connect gets to run commands in gdb. The socket
+     * could be left over from a server that is gone, anything else at
+     * the path isn't ours to remove. */
+    if (lstat(socket_path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            logger_write_pos(logger, __FILE__, __LINE__,
+                    "'%s' is not a socket", socket_path);
+            close(listen_fd);
+            return -1;
+        }
+        unlink(socket_path);
+    }
+
+    mask = umask(077);
+    result = bind(listen_fd, (struct sockaddr *) &addr, sizeof (addr));
+    umask(mask);
+
+    if (result == -1 || listen(listen_fd, 4) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "can't listen on '%s'", socket_path);
+        close(listen_fd);
+        return -1;
+    }
+
+    pid = fork();
+    if (pid == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__, "fork failed");
+        close(listen_fd);
+        unlink(socket_path);
+        return -1;
+    } else if (pid == 0) {
+        /* Fork again, so the server and gdb aren't children of cgdb */
+        if (fork() == 0)
+            session_serve(listen_fd, socket_path, path, argc, argv,
+                    choice, filename);
+        _exit(0);
+    }
+
+    cgdb_close(listen_fd);
+    waitpid(pid, NULL, 0);
+
+    return 0;
+}
+
+int session_attach(const char *socket_path, const char *path,
+        int argc, char *argv[], int *in, int *out, int choice, char *filename)
+{
+    struct session_hello hello;
+    int sock, fd;
+
+    sock = session_connect(socket_path);
+    if (sock == -1 && (errno == ENOENT || errno == ECONNREFUSED)) {
+        if (session_start(socket_path, path, argc, argv, choice,
+                        filename) == -1)
+            return -1;
+
+        sock = session_connect(socket_path);
+    } else if (sock != -1 && argc > 0)
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "gdb is already running, its arguments are not changed");
+
+    if (sock == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "can't connect to '%s'", socket_path);
+        return -1;
+    }
+
+    if (session_recv(sock, &hello, &fd) == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "the session server didn't answer");
+        close(sock);
+        return -1;
+    }
+
+    if (hello.pid == -1 || fd == -1) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "another cgdb is attached to the session");
+        close(sock);
+        return -1;
+    }
+
+    if (hello.choice != choice) {
+        logger_write_pos(logger, __FILE__, __LINE__,
+                "the session's gdb was started %s --gdbmi",
+                hello.choice ? "with" : "without");
+        close(fd);
+        close(sock);
+        return -1;
+    }
+
+    /* The connection is not passed on to gdb's or the shell's children */
+    fcntl(sock, F_SETFD, FD_CLOEXEC);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    session_fd = sock;
+
+    /* gdb has shown its prompt already, to the front end that was attached
+     * before. A command that does nothing gets it to show another. */
+    if (hello.attached) {
+        const char *command = choice ? "-gdb-set height 0\n" : "echo\n";
+
+        io_writen(fd, command, strlen(command));
+    }
+
+    *in = fd;
+    *out = fd;
+
+    return hello.pid;
+}
+
+#else
+
+int session_attach(const char *socket_path, const char *path,
+        int argc, char *argv[], int *in, int *out, int choice, char *filename)
+{
+    logger_write_pos(logger, __FILE__, __LINE__,
+            "sessions need UNIX sockets, which this system lacks");
+    return -1;
+}
+
+#endif /* HAVE_SYS_SOCKET_H && HAVE_SYS_UN_H */
@@ -0,0 +1,40 @@
+#ifndef __SESSION_H__
+#define __SESSION_H__
+
+/**
+ * A session server keeps gdb running between runs of cgdb, so that the
+ * program's symbols are only loaded once.
+ *
+ * The server listens on a UNIX socket. A front end that connects to it is
+ * handed the pty gdb runs on, and uses it the same way as if it had started
+ * gdb itself. Only one front end is attached at a time. When it exits,
+ * gdb keeps running and the next front end to connect gets it. The server
+ * exits with gdb, when gdb is quit.
+ */
+
+/**
+ * Attaches to the session server listening on socket_path. If there is
+ * none, a server is started, and it starts gdb with the arguments given.
+ * When gdb is already running, the arguments are not used.
+ *
+ * The front end stays attached until it exits.
+ *
+ * \param socket_path
+ * The path of the server's socket.
+ *
+ * \param path, argc, argv, choice, filename
+ * The arguments to invoke_debugger, used to start gdb.
+ *
+ * \param in
+ * Writing to this fd will write to gdb's stdin.
+ *
+ * \param out
+ * Reading from this fd will read from gdb's stdout and stderr.
+ *
+ * \return
+ * The pid of gdb on success, or -1 on error.
+ */
+int session_attach(const char *socket_path, const char *path,
+        int argc, char *argv[], int *in, int *out, int choice, char *filename);
+
+#endif
@@ -0,0 +1,278 @@
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif /* HAVE_SYS_TIME_H */
+
+#include "stats.h"
+
+int stats_enabled = 0;
+
+/* The ones something was recorded in, sorted by name */
+static struct stats_counter *counters;
+static struct stats_histogram *histograms;
+
+/* How long statistics have been recorded for, not counting the time they
+ * were off, and when they were last turned on */
+static unsigned long long recorded_usec;
+static unsigned long long enabled_at;
+
+unsigned long long stats_clock(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+
+    return (unsigned long long) tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+/* stats_register_counter: Adds a counter to the report. */
+static void stats_register_counter(struct stats_counter *counter)
+{
+    struct stats_counter **at = &counters;
+
+    while (*at && strcmp((*at)->name, counter->name) < 0)
+        at = &(*at)->next;
+
+    counter->next = *at;
+    *at = counter;
+    counter->registered = 1;
+}
+
+/* stats_register_histogram: Adds a histogram to the report. */
+static void stats_register_histogram(struct stats_histogram *histogram)
+{
+    struct stats_histogram **at = &histograms;
+
+    while (*at && strcmp((*at)->name, histogram->name) < 0)
+        at = &(*at)->next;
+
+    histogram->next = *at;
+    *at = histogram;
+    histogram->registered = 1;
+}
+
+/* stats_bucket: Returns the bucket usec goes in. */
+static int stats_bucket(unsigned long long usec)
+{
+    int bit = 3;
+
+    if (usec < STATS_SUB_BUCKETS)
+        return (int) usec;
+
+    /* The highest bit set, the 3 below it pick the sub bucket */
+    while (usec >> (bit + 1))
+        bit++;
+
+    return (bit - 2) * STATS_SUB_BUCKETS +
+            (int) ((usec >> (bit - 3)) & (STATS_SUB_BUCKETS - 1));
+}
+
+/* stats_bucket_top: Returns the largest value that goes in bucket. */
+static unsigned long long stats_bucket_top(int bucket)
+{
+    int shift;
+
+    if (bucket < STATS_SUB_BUCKETS)
+        return bucket;
+
+    shift = bucket / STATS_SUB_BUCKETS - 1;
+
+    return (((unsigned long long) STATS_SUB_BUCKETS +
+                    bucket % STATS_SUB_BUCKETS + 1) << shift) - 1;
+}
+
+/* stats_percentile: Returns the time below which percent of the times in
+ * histogram are, as the top of the bucket it's in. */
+static unsigned long long stats_percentile(struct stats_histogram *histogram,
+        double percent)
+{
+    unsigned long long wanted, seen = 0, top;
+    int i;
+
+    wanted = (unsigned long long) (histogram->count * percent / 100.0);
+    if (wanted == 0)
+        wanted = 1;
+
+    for (i = 0; i < STATS_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= wanted)
+            break;
+    }
+
+    top = stats_bucket_top(i < STATS_BUCKETS ? i : STATS_BUCKETS - 1);
+
+    return top < histogram->max ? top : histogram->max;
+}
+
+void stats_enable(int enable)
+{
+    if (enable && !stats_enabled)
+        enabled_at = stats_clock();
+    else if (!enable && stats_enabled)
+        recorded_usec += stats_clock() - enabled_at;
+
+    stats_enabled = enable ? 1 : 0;
+}
+
+void stats_reset(void)
+{
+    struct stats_counter *counter;
+    struct stats_histogram *histogram;
+
+    for (counter = counters; counter; counter = counter->next)
+        counter->value = 0;
+
+    for (histogram = histograms; histogram; histogram = histogram->next) {
+        histogram->count = 0;
+        histogram->sum = 0;
+        histogram->min = 0;
+        histogram->max = 0;
+        memset(histogram->buckets, 0, sizeof (histogram->buckets));
+    }
+
+    recorded_usec = 0;
+    enabled_at = stats_clock();
+}
+
+void stats_add(struct stats_counter *counter, unsigned long long n)
+{
+    if (!stats_enabled)
+        return;
+
+    if (!counter->registered)
+        stats_register_counter(counter);
+
+    counter->value += n;
+}
+
+unsigned long long stats_start(void)
+{
+    if (!stats_enabled)
+        return 0;
+
+    return stats_clock();
+}
+
+unsigned long long stats_stop(struct stats_histogram *histogram,
+        unsigned long long start)
+{
+    unsigned long long now;
+
+    if (!start || !stats_enabled)
+        return 0;
+
+    /* The clock was set back */
+    now = stats_clock();
+    if (now < start)
+        return 0;
+
+    stats_record(histogram, now - start);
+
+    return now - start;
+}
+
+void stats_record(struct stats_histogram *histogram, unsigned long long usec)
+{
+    if (!stats_enabled)
+        return;
+
+    if (!histogram->registered)
+        stats_register_histogram(histogram);
+
+    if (histogram->count == 0 || usec < histogram->min)
+        histogram->min = usec;
+    if (usec > histogram->max)
+        histogram->max = usec;
+
+    histogram->count++;
+    histogram->sum += usec;
+    histogram->buckets[stats_bucket(usec)]++;
+}
+
+void stats_report(void (*print) (const char *line, void *context),
+        void *context)
+{
+    struct stats_counter *counter;
+    struct stats_histogram *histogram;
+    unsigned long long usec = recorded_usec;
+    char line[256];
+
+    if (stats_enabled)
+        usec += stats_clock() - enabled_at;
+
+    snprintf(line, sizeof (line), "Statistics, %s for %.1f seconds\n",
+            stats_enabled ? "recording" : "recorded", usec / 1e6);
+    print(line, context);
+
+    if (!counters && !histograms) {
+        print("Nothing was recorded.\n", context);
+        return;
+    }
+
+    if (counters) {
+        print("\n", context);
+        snprintf(line, sizeof (line), "%-36s %14s %12s\n", "Counter",
+                "Total", "Per second");
+        print(line, context);
+    }
+
+    for (counter = counters; counter; counter = counter->next) {
+        snprintf(line, sizeof (line), "%-36s %14llu %12.1f\n", counter->name,
+                counter->value, usec ? counter->value * 1e6 / usec : 0.0);
+        print(line, context);
+    }
+
+    if (histograms) {
+        print("\n", context);
+        snprintf(line, sizeof (line), "%-36s %8s %9s %9s %9s %9s %9s\n",
+                "Time (microseconds)", "Count", "Mean", "p50", "p90",
+                "p99", "Max");
+        print(line, context);
+    }
+
+    for (histogram = histograms; histogram; histogram = histogram->next) {
+        if (histogram->count == 0) {
+            snprintf(line, sizeof (line), "%-36s %8d\n", histogram->name, 0);
+            print(line, context);
+            continue;
+        }
+
+        snprintf(line, sizeof (line),
+                "%-36s %8llu %9llu %9llu %9llu %9llu %9llu\n",
+                histogram->name, histogram->count,
+                histogram->sum / histogram->count,
+                stats_percentile(histogram, 50),
+                stats_percentile(histogram, 90),
+                stats_percentile(histogram, 99), histogram->max);
+        print(line, context);
+    }
+}
+
+/* stats_print_file: Writes a line of the report to a file. */
+static void stats_print_file(const char *line, void *context)
+{
+    fputs(line, (FILE *) context);
+}
+
+int stats_write(const char *path)
+{
+    FILE *file = fopen(path, "w");
+
+    if (!file)
+        return -1;
+
+    stats_report(stats_print_file, file);
+
+    return fclose(file) == 0 ? 0 : -1;
+}
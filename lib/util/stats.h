@@ -0,0 +1,152 @@
+#ifndef __STATS_H__
+#define __STATS_H__
+
+/*******************************************************************************
+ *
+ * This is the statistics unit. It counts what goes through the hot paths of
+ * cgdb and tgdb, and how long they take, so that a slow session can be
+ * looked into from inside of it.
+ *
+ * A counter or histogram is a static variable where it's used, made with
+ * STATS_COUNTER or STATS_HISTOGRAM. It's added to the report the first time
+ * something is recorded in it.
+ *
+ * Nothing is recorded until stats_enable is called. Until then, each place
+ * that records only reads stats_enabled, the clock isn't looked at.
+ *
+ * Everything here is meant to be called from the main thread only.
+ ******************************************************************************/
+
+/* The buckets of a histogram. Values below 8 get a bucket each, the ones
+ * above are split 8 ways for each power of two, so a bucket is never more
+ * than an eighth wider than the values in it. */
+#define STATS_SUB_BUCKETS 8
+#define STATS_BUCKETS (62 * STATS_SUB_BUCKETS)
+
+/* A running count, of bytes or of events */
+struct stats_counter {
+    const char *name;
+    unsigned long long value;
+
+    /* The next one in the report, once it's registered */
+    struct stats_counter *next;
+    int registered;
+};
+
+/* The times something took, in microseconds */
+struct stats_histogram {
+    const char *name;
+    unsigned long long count;
+    unsigned long long sum;
+    unsigned long long min;
+    unsigned long long max;
+    unsigned long long buckets[STATS_BUCKETS];
+
+    /* The next one in the report, once it's registered */
+    struct stats_histogram *next;
+    int registered;
+};
+
+#define STATS_COUNTER(name) { name, 0, NULL, 0 }
+#define STATS_HISTOGRAM(name) { name, 0, 0, 0, 0, { 0 }, NULL, 0 }
+
+/* Set while statistics are being recorded. Read it, don't set it. */
+extern int stats_enabled;
+
+/* STATS_ADD: Adds n to counter, if statistics are being recorded. */
+#define STATS_ADD(counter, n) \
+    do { if (stats_enabled) stats_add(counter, n); } while (0)
+
+/* stats_enable:
+ * -------------
+ *
+ *  Starts or stops recording. What was recorded is kept either way.
+ *
+ *  enable - 1 to start recording, 0 to stop.
+ */
+void stats_enable(int enable);
+
+/* stats_reset:
+ * ------------
+ *
+ *  Forgets everything that was recorded so far.
+ */
+void stats_reset(void);
+
+/* stats_add:
+ * ----------
+ *
+ *  Adds to a counter. STATS_ADD is cheaper when recording is off.
+ *
+ *  counter - The counter.
+ *  n       - What to add to it.
+ */
+void stats_add(struct stats_counter *counter, unsigned long long n);
+
+/* stats_start:
+ * ------------
+ *
+ *  Starts timing something.
+ *
+ *  Returns the time now, in microseconds, or 0 if statistics aren't
+ *  being recorded.
+ */
+unsigned long long stats_start(void);
+
+/* stats_clock:
+ * ------------
+ *
+ *  Returns the time now, in microseconds, whether statistics are being
+ *  recorded or not. Unlike the rest, it can be called from any thread, to
+ *  time something that's recorded later by the main thread.
+ */
+unsigned long long stats_clock(void);
+
+/* stats_stop:
+ * -----------
+ *
+ *  Records how long something took, since stats_start.
+ *
+ *  histogram - Where it's recorded.
+ *  start     - What stats_start returned. Nothing is recorded if it's 0.
+ *
+ *  Returns the time it took, in microseconds, or 0 if nothing was recorded.
+ */
+unsigned long long stats_stop(struct stats_histogram *histogram,
+        unsigned long long start);
+
+/* stats_record:
+ * -------------
+ *
+ *  Records a time measured some other way.
+ *
+ *  histogram - Where it's recorded.
+ *  usec      - The time, in microseconds.
+ */
+void stats_record(struct stats_histogram *histogram, unsigned long long usec);
+
+/* stats_report:
+ * -------------
+ *
+ *  Formats what was recorded, a line at a time. The counters come first,
+ *  then the histograms with their mean, percentiles and the longest time,
+ *  each sorted by name.
+ *
+ *  print   - Called for each line, with the newline at the end.
+ *  context - Passed to print.
+ */
+void stats_report(void (*print) (const char *line, void *context),
+        void *context);
+
+/* stats_write:
+ * ------------
+ *
+ *  Writes the report to a file.
+ *
+ *  path - The file to write, it's replaced.
+ *
+ *  Returns 0 on success, or -1 if the file couldn't be written.
+ */
+int stats_write(const char *path);
+
+#endif /* __STATS_H__ */
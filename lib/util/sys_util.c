@@ -14,12 +14,295 @@
 #include <errno.h>
 #endif /* HAVE_ERRNO_H */
 
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
+#define SYS_UTIL_C
 #include "sys_util.h"
 
+/* The allocations the wrappers made */
+static unsigned long long alloc_count;
+
+#ifdef CGDB_MEMSTATS
+
+/* The bytes counted under one name */
+struct mem_tag {
+    const char *name;
+    long long live;
+    long long peak;
+    unsigned long long allocs;
+    unsigned long long frees;
+};
+
+/* A block that was handed out, ptr is NULL if the slot is empty */
+struct mem_block {
+    void *ptr;
+    size_t size;
+    struct mem_tag *tag;
+};
+
+/* The names are looked up by their address, which __FILE__ keeps the same
+ * in a file. There are no more names than files, if the table does fill
+ * up the rest are counted under the last one. */
+#define MEM_TAGS 512
+
+static struct mem_tag mem_tags[MEM_TAGS];
+static int mem_tags_used;
+
+/* The blocks, a hash table kept no more than half full */
+static struct mem_block *mem_blocks;
+static size_t mem_blocks_size;
+static size_t mem_blocks_used;
+
+static long long mem_live, mem_peak;
+
+/* The wrappers are called from the loader's threads as well */
+static pthread_mutex_t mem_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+#define MEM_SLOT(ptr, size) \
+    ((size_t) (((unsigned long long) (size_t) (ptr) >> 4) * \
+            11400714819323198485ull) & ((size) - 1))
+
+static struct mem_tag *mem_tag_lookup(const char *name)
+{
+    size_t slot = MEM_SLOT(name, MEM_TAGS);
+
+    while (mem_tags[slot].name && mem_tags[slot].name != name)
+        slot = (slot + 1) & (MEM_TAGS - 1);
+
+    if (!mem_tags[slot].name) {
+        if (mem_tags_used == MEM_TAGS - 1)
+            return &mem_tags[(slot + MEM_TAGS - 1) & (MEM_TAGS - 1)];
+        mem_tags[slot].name = name;
+        mem_tags_used++;
+    }
+
+    return &mem_tags[slot];
+}
+
+static struct mem_block *mem_block_slot(void *ptr)
+{
+    size_t slot = MEM_SLOT(ptr, mem_blocks_size);
+
+    while (mem_blocks[slot].ptr && mem_blocks[slot].ptr != ptr)
+        slot = (slot + 1) & (mem_blocks_size - 1);
+
+    return &mem_blocks[slot];
+}
+
+static void mem_untrack(void *ptr)
+{
+    struct mem_block *block;
+    size_t slot, empty, home;
+
+    if (!ptr || !mem_blocks)
+        return;
+
+    block = mem_block_slot(ptr);
+    if (!block->ptr)
+        return;
+
+    block->tag->live -= block->size;
+    block->tag->frees++;
+    mem_live -= block->size;
+
+    /* The blocks after it that belong before it move back a slot */
+    empty = block - mem_blocks;
+    block->ptr = NULL;
+    mem_blocks_used--;
+
+    for (slot = (empty + 1) & (mem_blocks_size - 1); mem_blocks[slot].ptr;
+            slot = (slot + 1) & (mem_blocks_size - 1)) {
+        home = MEM_SLOT(mem_blocks[slot].ptr, mem_blocks_size);
+        if (((slot - home) & (mem_blocks_size - 1)) >=
+                ((slot - empty) & (mem_blocks_size - 1))) {
+            mem_blocks[empty] = mem_blocks[slot];
+            mem_blocks[slot].ptr = NULL;
+            empty = slot;
+        }
+    }
+}
+
+static void mem_track(void *ptr, size_t size, const char *name)
+{
+    struct mem_block *old = mem_blocks, *block;
+    size_t old_size = mem_blocks_size, i;
+    struct mem_tag *tag;
+
+    /* A block that was freed without the wrapper has its address reused */
+    mem_untrack(ptr);
+
+    if (mem_blocks_used * 2 >= mem_blocks_size) {
+        mem_blocks_size = old_size ? old_size * 2 : 4096;
+        mem_blocks = calloc(mem_blocks_size, sizeof (struct mem_block));
+        if (!mem_blocks)
+            exit(-1);
+
+        for (i = 0; i < old_size; i++)
+            if (old[i].ptr)
+                *mem_block_slot(old[i].ptr) = old[i];
+        free(old);
+    }
+
+    tag = mem_tag_lookup(name);
+    tag->live += size;
+    tag->allocs++;
+    if (tag->live > tag->peak)
+        tag->peak = tag->live;
+
+    mem_live += size;
+    if (mem_live > mem_peak)
+        mem_peak = mem_live;
+
+    block = mem_block_slot(ptr);
+    block->ptr = ptr;
+    block->size = size;
+    block->tag = tag;
+    mem_blocks_used++;
+}
+
+static void *mem_tagged(void *ptr, size_t size, const char *name)
+{
+    if (!ptr)
+        exit(-1);
+
+    pthread_mutex_lock(&mem_mutex);
+    alloc_count++;
+    mem_track(ptr, size, name);
+    pthread_mutex_unlock(&mem_mutex);
+
+    return ptr;
+}
+
+void *cgdb_calloc_tagged(size_t nmemb, size_t size, const char *tag)
+{
+    return mem_tagged(calloc(nmemb, size), nmemb * size, tag);
+}
+
+void *cgdb_malloc_tagged(size_t size, const char *tag)
+{
+    return mem_tagged(malloc(size), size, tag);
+}
+
+void *cgdb_realloc_tagged(void *ptr, size_t size, const char *tag)
+{
+    pthread_mutex_lock(&mem_mutex);
+    mem_untrack(ptr);
+    pthread_mutex_unlock(&mem_mutex);
+
+    return mem_tagged(realloc(ptr, size), size, tag);
+}
+
+char *cgdb_strdup_tagged(const char *s, const char *tag)
+{
+    return mem_tagged(strdup(s), strlen(s) + 1, tag);
+}
+
+void cgdb_free(void *ptr)
+{
+    pthread_mutex_lock(&mem_mutex);
+    mem_untrack(ptr);
+    pthread_mutex_unlock(&mem_mutex);
+
+    free(ptr);
+}
+
+/* The name a tag is reported under, the file without its directory */
+static const char *mem_tag_name(const char *name)
+{
+    const char *slash = strrchr(name, '/');
+
+    return slash ? slash + 1 : name;
+}
+
+static int mem_tag_compare(const void *a, const void *b)
+{
+    const struct mem_tag *left = a, *right = b;
+
+    if (left->live != right->live)
+        return left->live > right->live ? -1 : 1;
+
+    return strcmp(left->name, right->name);
+}
+
+int cgdb_mem_report(void (*print) (const char *line, void *context),
+        void *context)
+{
+    struct mem_tag tags[MEM_TAGS];
+    long long live, peak;
+    char line[256];
+    int count = 0, i, j;
+
+    /* The same file can be named by more than one address */
+    pthread_mutex_lock(&mem_mutex);
+    for (i = 0; i < MEM_TAGS; i++) {
+        if (!mem_tags[i].name)
+            continue;
+
+        for (j = 0; j < count; j++)
+            if (strcmp(tags[j].name, mem_tag_name(mem_tags[i].name)) == 0)
+                break;
+
+        if (j == count) {
+            tags[count] = mem_tags[i];
+            tags[count++].name = mem_tag_name(mem_tags[i].name);
+        } else {
+            tags[j].live += mem_tags[i].live;
+            tags[j].peak += mem_tags[i].peak;
+            tags[j].allocs += mem_tags[i].allocs;
+            tags[j].frees += mem_tags[i].frees;
+        }
+    }
+    live = mem_live;
+    peak = mem_peak;
+    pthread_mutex_unlock(&mem_mutex);
+
+    qsort(tags, count, sizeof (struct mem_tag), mem_tag_compare);
+
+    snprintf(line, sizeof (line), "Memory, %lld bytes live, %lld at the peak\n",
+            live, peak);
+    print(line, context);
+
+    print("\n", context);
+    snprintf(line, sizeof (line), "%-28s %12s %12s %12s %12s\n", "File",
+            "Live", "Peak", "Allocs", "Frees");
+    print(line, context);
+
+    for (i = 0; i < count; i++) {
+        snprintf(line, sizeof (line), "%-28s %12lld %12lld %12llu %12llu\n",
+                tags[i].name, tags[i].live, tags[i].peak, tags[i].allocs,
+                tags[i].frees);
+        print(line, context);
+    }
+
+    return 0;
+}
+
+#else
+
+int cgdb_mem_report(void (*print) (const char *line, void *context),
+        void *context)
+{
+    return -1;
+}
+
+#endif /* CGDB_MEMSTATS */
+
+unsigned long long cgdb_alloc_count(void)
+{
+    return alloc_count;
+}
+
 void *cgdb_calloc(size_t nmemb, size_t size)
 {
     void *t = calloc(nmemb, size);
 
+    alloc_count++;
     if (t)
         return t;
 
@@ -30,6 +313,7 @@ void *cgdb_malloc(size_t size)
 {
     void *t = malloc(size);
 
+    alloc_count++;
     if (t)
         return t;
 
@@ -40,6 +324,7 @@ void *cgdb_realloc(void *ptr, size_t size)
 {
     void *t = realloc(ptr, size);
 
+    alloc_count++;
     if (t)
         return t;
 
@@ -50,6 +335,7 @@ char *cgdb_strdup(const char *s)
 {
     char *t = strdup(s);
 
+    alloc_count++;
     if (t)
         return t;
 
@@ -19,4 +19,66 @@ void *cgdb_realloc(void *ptr, size_t size);
 char *cgdb_strdup(const char *s);
 int cgdb_close(int fd);
 
+/* Memory accounting:
+ * ------------------
+ *
+ *  Built with --enable-memstats, each of the wrappers above counts the bytes
+ *  it hands out under the name of the file that asked for them, so the live
+ *  bytes, the peak and the number of allocations of each part of cgdb can
+ *  be reported while it runs. A file can set MEM_TAG before it includes this
+ *  header, to count its memory under some other name.
+ *
+ *  free is wrapped as well, in the files that include this header, so the
+ *  bytes are counted as freed. Memory freed some other way, like through a
+ *  pointer to free, is counted as freed once its address is handed out
+ *  again.
+ *
+ *  Without --enable-memstats the wrappers are the plain ones and nothing is
+ *  counted.
+ */
+#ifdef CGDB_MEMSTATS
+
+#ifndef MEM_TAG
+#define MEM_TAG __FILE__
+#endif
+
+void *cgdb_calloc_tagged(size_t nmemb, size_t size, const char *tag);
+void *cgdb_malloc_tagged(size_t size, const char *tag);
+void *cgdb_realloc_tagged(void *ptr, size_t size, const char *tag);
+char *cgdb_strdup_tagged(const char *s, const char *tag);
+void cgdb_free(void *ptr);
+
+/* sys_util.c defines the plain wrappers, which count nothing */
+#ifndef SYS_UTIL_C
+#define cgdb_calloc(nmemb, size) cgdb_calloc_tagged(nmemb, size, MEM_TAG)
+#define cgdb_malloc(size) cgdb_malloc_tagged(size, MEM_TAG)
+#define cgdb_realloc(ptr, size) cgdb_realloc_tagged(ptr, size, MEM_TAG)
+#define cgdb_strdup(s) cgdb_strdup_tagged(s, MEM_TAG)
+#define free(ptr) cgdb_free(ptr)
+#endif /* SYS_UTIL_C */
+
+#endif /* CGDB_MEMSTATS */
+
+/* cgdb_mem_report: Reports the memory counted for each part of cgdb.
+ * ----------------
+ *
+ *  The files are listed by their live bytes, the most first.
+ *
+ *  print:    Called with each line of the report
+ *  context:  Passed to print
+ *
+ * Return Value: 0 on success, -1 if cgdb was built without memory
+ *               accounting.
+ */
+int cgdb_mem_report(void (*print) (const char *line, void *context),
+        void *context);
+
+/* cgdb_alloc_count: The number of allocations the wrappers made so far.
+ * -----------------
+ *
+ *  A realloc is counted as one. It's counted without a lock, so it's only
+ *  exact in a program with one thread, like the benchmarks.
+ */
+unsigned long long cgdb_alloc_count(void);
+
 #endif
@@ -0,0 +1,235 @@
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#if HAVE_STDIO_H
+#include <stdio.h>
+#endif /* HAVE_STDIO_H */
+
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#include "tracer.h"
+#include "stats.h"
+
+/* The longest detail kept with an event, the rest is cut off */
+#define TRACER_DETAIL 48
+
+struct tracer_event {
+    const char *name;
+    unsigned long long ts;      /* When it started, in microseconds */
+    unsigned long long dur;     /* How long it took, for a span */
+    char phase;                 /* 'X' for a span, 'i' for a moment */
+    char lane;
+    char detail[TRACER_DETAIL];
+};
+
+int tracer_enabled = 0;
+
+/* The ring of events. head is where the next one goes, and count is how
+ * many there are, up to TRACER_EVENTS. */
+static struct tracer_event *events;
+static int head, count;
+
+/* tracer_add: Returns the event to fill in, the oldest one if it's full. */
+static struct tracer_event *tracer_add(void)
+{
+    struct tracer_event *event = &events[head];
+
+    head = (head + 1) % TRACER_EVENTS;
+    if (count < TRACER_EVENTS)
+        count++;
+
+    return event;
+}
+
+/* tracer_set_detail: Copies detail into the event, without newlines. */
+static void tracer_set_detail(struct tracer_event *event, const char *detail)
+{
+    size_t length = detail ? strcspn(detail, "\r\n") : 0;
+
+    /* It's cut short between characters, so the JSON is still UTF-8 */
+    if (length >= TRACER_DETAIL) {
+        length = TRACER_DETAIL - 1;
+        while (length > 0 && (detail[length] & 0xC0) == 0x80)
+            length--;
+    }
+
+    if (length > 0)
+        memcpy(event->detail, detail, length);
+    event->detail[length] = '\0';
+}
+
+/* tracer_print_string: Writes s to file as a JSON string. */
+static void tracer_print_string(FILE *file, const char *s)
+{
+    putc('"', file);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            fprintf(file, "\\%c", *s);
+        else if ((unsigned char) *s < 0x20)
+            fprintf(file, "\\u%04x", (unsigned char) *s);
+        else
+            putc(*s, file);
+    }
+    putc('"', file);
+}
+
+/* tracer_print_event: Writes an event to file, after a comma.
+ *
+ *  phase - 'X' for a span, 'i' for a moment, or 'b' and 'e' for the
+ *          beginning and end of an async span.
+ *  ts    - The time, since the oldest event.
+ *  id    - The id of an async span.
+ */
+static void tracer_print_event(FILE *file, struct tracer_event *event,
+        char phase, unsigned long long ts, int id)
+{
+    fprintf(file, ",\n{\"name\": ");
+    tracer_print_string(file, event->name);
+    fprintf(file, ", \"ph\": \"%c\", \"pid\": 1, \"tid\": %d, "
+            "\"ts\": %llu", phase, event->lane + 1, ts);
+
+    if (phase == 'X')
+        fprintf(file, ", \"dur\": %llu", event->dur);
+    else if (phase == 'i')
+        fprintf(file, ", \"s\": \"t\"");
+    else
+        fprintf(file, ", \"cat\": \"%s\", \"id\": %d", event->name, id);
+
+    if (event->detail[0] && phase != 'e') {
+        fprintf(file, ", \"args\": {\"detail\": ");
+        tracer_print_string(file, event->detail);
+        putc('}', file);
+    }
+
+    putc('}', file);
+}
+
+int tracer_enable(int enable)
+{
+    if (enable && !events) {
+        events = malloc(TRACER_EVENTS * sizeof (struct tracer_event));
+        if (!events)
+            return -1;
+    }
+
+    if (enable && !tracer_enabled)
+        head = count = 0;
+
+    tracer_enabled = enable ? 1 : 0;
+
+    return 0;
+}
+
+unsigned long long tracer_begin(void)
+{
+    if (!tracer_enabled)
+        return 0;
+
+    return stats_clock();
+}
+
+void tracer_end(const char *name, unsigned long long start)
+{
+    unsigned long long now;
+
+    if (!start || !tracer_enabled)
+        return;
+
+    /* The clock was set back */
+    now = stats_clock();
+    if (now < start)
+        return;
+
+    tracer_span(name, TRACER_LANE_MAIN, start, now - start, NULL);
+}
+
+void tracer_span(const char *name, enum tracer_lane lane,
+        unsigned long long start, unsigned long long usec,
+        const char *detail)
+{
+    struct tracer_event *event;
+
+    if (!tracer_enabled)
+        return;
+
+    event = tracer_add();
+    event->name = name;
+    event->ts = start;
+    event->dur = usec;
+    event->phase = 'X';
+    event->lane = lane;
+    tracer_set_detail(event, detail);
+}
+
+void tracer_instant(const char *name, const char *detail)
+{
+    struct tracer_event *event;
+
+    if (!tracer_enabled)
+        return;
+
+    event = tracer_add();
+    event->name = name;
+    event->ts = stats_clock();
+    event->dur = 0;
+    event->phase = 'i';
+    event->lane = TRACER_LANE_MAIN;
+    tracer_set_detail(event, detail);
+}
+
+int tracer_count(void)
+{
+    return count;
+}
+
+int tracer_write(const char *path)
+{
+    static const char *lanes[] = { "cgdb", "highlight" };
+    unsigned long long first = 0;
+    struct tracer_event *event;
+    FILE *file;
+    int i;
+
+    file = fopen(path, "w");
+    if (!file)
+        return -1;
+
+    /* The times start at the oldest event kept */
+    for (i = 0; i < count; i++) {
+        event = &events[(head - count + i + TRACER_EVENTS) % TRACER_EVENTS];
+        if (i == 0 || event->ts < first)
+            first = event->ts;
+    }
+
+    fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+
+    for (i = 0; i < (int) (sizeof (lanes) / sizeof (lanes[0])); i++)
+        fprintf(file, "%s{\"name\": \"thread_name\", \"ph\": \"M\", "
+                "\"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+                i ? ",\n" : "", i + 1, lanes[i]);
+
+    for (i = 0; i < count; i++) {
+        event = &events[(head - count + i + TRACER_EVENTS) % TRACER_EVENTS];
+
+        /* The workers highlight files at the same time, spans that
+         * overlap without nesting are only shown right as async ones */
+        if (event->lane == TRACER_LANE_HIGHLIGHT) {
+            tracer_print_event(file, event, 'b', event->ts - first, i);
+            tracer_print_event(file, event, 'e',
+                    event->ts - first + event->dur, i);
+        } else
+            tracer_print_event(file, event, event->phase, event->ts - first,
+                    -1);
+    }
+
+    fprintf(file, "\n]}\n");
+
+    return fclose(file) == 0 ? 0 : -1;
+}
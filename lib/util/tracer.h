@@ -0,0 +1,112 @@
+#ifndef __TRACER_H__
+#define __TRACER_H__
+
+/*******************************************************************************
+ *
+ * This is the tracing unit. It keeps a timeline of what cgdb and tgdb did,
+ * the spans of time spent in each part and the moments something happened,
+ * so that a stutter can be looked at afterwards, span by span.
+ *
+ * The timeline is a ring of the last TRACER_EVENTS events, the older ones
+ * are written over. tracer_write exports it as Chrome trace event JSON,
+ * which chrome://tracing and Perfetto (ui.perfetto.dev) load.
+ *
+ * Nothing is kept until tracer_enable is called. Until then, each place
+ * that traces only reads tracer_enabled, the clock isn't looked at.
+ *
+ * Everything here is meant to be called from the main thread only. Work
+ * done in another thread is timed there with stats_clock, and traced by
+ * the main thread with tracer_span once it's done.
+ ******************************************************************************/
+
+/* The number of events kept */
+#define TRACER_EVENTS 65536
+
+/* The lanes the spans are shown in, one for each thread */
+enum tracer_lane {
+    TRACER_LANE_MAIN,
+    TRACER_LANE_HIGHLIGHT
+};
+
+/* Set while the timeline is being kept. Read it, don't set it. */
+extern int tracer_enabled;
+
+/* tracer_enable:
+ * --------------
+ *
+ *  Starts or stops keeping the timeline. Starting it forgets the events
+ *  kept before.
+ *
+ *  enable - 1 to start, 0 to stop.
+ *
+ *  Returns 0 on success, or -1 if there's no memory for the events.
+ */
+int tracer_enable(int enable);
+
+/* tracer_begin:
+ * -------------
+ *
+ *  Starts a span.
+ *
+ *  Returns the time now, in microseconds, or 0 if the timeline isn't
+ *  being kept.
+ */
+unsigned long long tracer_begin(void);
+
+/* tracer_end:
+ * -----------
+ *
+ *  Ends a span of the main thread.
+ *
+ *  name  - What the span was spent on. It isn't copied, it has to be a
+ *          string constant.
+ *  start - What tracer_begin returned. Nothing is kept if it's 0.
+ */
+void tracer_end(const char *name, unsigned long long start);
+
+/* tracer_span:
+ * ------------
+ *
+ *  Keeps a span timed some other way.
+ *
+ *  name   - What the span was spent on, a string constant.
+ *  lane   - The thread it was spent in.
+ *  start  - When it started, from stats_clock.
+ *  usec   - How long it took, in microseconds.
+ *  detail - What it was spent on, or NULL. It's copied, and cut short
+ *           if it's long.
+ */
+void tracer_span(const char *name, enum tracer_lane lane,
+        unsigned long long start, unsigned long long usec,
+        const char *detail);
+
+/* tracer_instant:
+ * ---------------
+ *
+ *  Keeps a moment something happened in the main thread.
+ *
+ *  name   - What happened, a string constant.
+ *  detail - More about it, or NULL. It's copied, and cut short if it's
+ *           long.
+ */
+void tracer_instant(const char *name, const char *detail);
+
+/* tracer_count:
+ * -------------
+ *
+ *  Returns the number of events kept.
+ */
+int tracer_count(void);
+
+/* tracer_write:
+ * -------------
+ *
+ *  Writes the timeline to a file, as Chrome trace event JSON.
+ *
+ *  path - The file to write, it's replaced.
+ *
+ *  Returns 0 on success, or -1 if the file couldn't be written.
+ */
+int tracer_write(const char *path);
+
+#endif /* __TRACER_H__ */
@@ -0,0 +1,212 @@
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif /* HAVE_CONFIG_H */
+
+#define _XOPEN_SOURCE 700       /* wcwidth() */
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif /* HAVE_STRING_H */
+
+#if HAVE_WCHAR_H
+#include <wchar.h>
+#endif /* HAVE_WCHAR_H */
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "utf8.h"
+
+/* The character a byte that isn't valid UTF-8 is shown as */
+#define UTF8_REPLACEMENT 0xFFFD
+
+/* The bit that's set in each byte of a word that isn't ASCII */
+#define UTF8_HIGH_BITS ((unsigned long) -1 / 0xFF * 0x80)
+
+int utf8_ascii_span(const char *s, int length)
+{
+    int i = 0;
+
+    /* A block with a byte that isn't ASCII is left for the loop at the end
+     * to find the byte in */
+#if defined(__AVX2__)
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) (s + i));
+
+        if (_mm256_movemask_epi8(block))
+            break;
+    }
+#endif
+
+#if defined(__SSE2__)
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (s + i));
+
+        if (_mm_movemask_epi8(block))
+            break;
+    }
+#else
+    for (; i + (int) sizeof (unsigned long) <= length;
+            i += sizeof (unsigned long)) {
+        unsigned long word;
+
+        memcpy(&word, s + i, sizeof (word));
+        if (word & UTF8_HIGH_BITS)
+            break;
+    }
+#endif
+
+    while (i < length && !(s[i] & 0x80))
+        i++;
+
+    return i;
+}
+
+int utf8_decode(const char *s, int length, unsigned int *cp)
+{
+    const unsigned char *u = (const unsigned char *) s;
+    unsigned int c = u[0], min;
+    int count, i;
+
+    if (c < 0x80) {
+        *cp = c;
+        return 1;
+    }
+
+    if ((c & 0xE0) == 0xC0) {
+        count = 2;
+        c &= 0x1F;
+        min = 0x80;
+    } else if ((c & 0xF0) == 0xE0) {
+        count = 3;
+        c &= 0x0F;
+        min = 0x800;
+    } else if ((c & 0xF8) == 0xF0) {
+        count = 4;
+        c &= 0x07;
+        min = 0x10000;
+    } else {
+        *cp = UTF8_REPLACEMENT;
+        return 1;
+    }
+
+    if (count > length) {
+        *cp = UTF8_REPLACEMENT;
+        return 1;
+    }
+
+    for (i = 1; i < count; i++) {
+        if ((u[i] & 0xC0) != 0x80) {
+            *cp = UTF8_REPLACEMENT;
+            return 1;
+        }
+        c = (c << 6) | (u[i] & 0x3F);
+    }
+
+    /* Overlong forms, surrogates and what's past the last character */
+    if (c < min || (c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF) {
+        *cp = UTF8_REPLACEMENT;
+        return 1;
+    }
+
+    *cp = c;
+    return count;
+}
+
+int utf8_char_width(unsigned int cp)
+{
+#if HAVE_WCHAR_H
+    int width = wcwidth((wchar_t) cp);
+
+    /* Control characters and ones the locale doesn't know */
+    if (width < 0)
+        return 1;
+
+    return width;
+#else
+    return 1;
+#endif
+}
+
+int utf8_next(const char *s, int length, int *i)
+{
+    unsigned int cp;
+
+    if (!(s[*i] & 0x80)) {
+        (*i)++;
+        return 1;
+    }
+
+    *i += utf8_decode(s + *i, length - *i, &cp);
+
+    return utf8_char_width(cp);
+}
+
+int utf8_prev(const char *s, int i)
+{
+    int start = i - 1;
+    unsigned int cp;
+
+    if (start < 0)
+        return 0;
+
+    /* Back over the continuation bytes, a character has at most 3 */
+    while (start > 0 && i - start < 4 && (s[start] & 0xC0) == 0x80)
+        start--;
+
+    /* Stray continuation bytes are each a character of their own */
+    if (start + utf8_decode(s + start, i - start, &cp) != i)
+        return i - 1;
+
+    return start;
+}
+
+int utf8_columns(const char *s, int length)
+{
+    int columns = 0, i = 0, ascii;
+
+    while (i < length) {
+        ascii = utf8_ascii_span(s + i, length - i);
+        columns += ascii;
+        i += ascii;
+
+        /* The characters that aren't ASCII, up to the next one that is */
+        while (i < length && (s[i] & 0x80))
+            columns += utf8_next(s, length, &i);
+    }
+
+    return columns;
+}
+
+int utf8_column_bytes(const char *s, int length, int columns, int *used)
+{
+    int count = 0, i = 0, ascii, next, width;
+
+    while (i < length && count <= columns) {
+        ascii = utf8_ascii_span(s + i, length - i);
+        if (ascii > columns - count)
+            ascii = columns - count;
+        count += ascii;
+        i += ascii;
+
+        if (i >= length || !(s[i] & 0x80))
+            break;
+
+        /* A combining character goes with the one before it, even when
+         * there's no room left */
+        next = i;
+        width = utf8_next(s, length, &next);
+        if (count + width > columns)
+            break;
+        count += width;
+        i = next;
+    }
+
+    if (used)
+        *used = count;
+
+    return i;
+}
@@ -0,0 +1,100 @@
+#ifndef __UTF8_H__
+#define __UTF8_H__
+
+/*******************************************************************************
+ *
+ * This is the UTF-8 unit. It finds where the characters of UTF-8 text are,
+ * and how many columns of the terminal they take up, so that text that isn't
+ * ASCII is drawn at the right place.
+ *
+ * Most of the text cgdb draws is ASCII, a byte to a column. The functions
+ * here check for it a block at a time, with SSE2 or AVX2 when the compiler
+ * targets them and a word at a time otherwise, and only decode the bytes
+ * that aren't ASCII.
+ *
+ * The width of a character comes from wcwidth, so it depends on LC_CTYPE.
+ * A byte that doesn't start a valid character is taken to be one character,
+ * a column wide.
+ ******************************************************************************/
+
+/* utf8_ascii_span:
+ * ----------------
+ *
+ *  Finds the ASCII bytes at the start of some text.
+ *
+ *  s      - The text.
+ *  length - Its length, in bytes.
+ *
+ *  Returns the number of bytes before the first one that isn't ASCII, or
+ *  length if they all are.
+ */
+int utf8_ascii_span(const char *s, int length);
+
+/* utf8_decode:
+ * ------------
+ *
+ *  Decodes the character at the start of some text.
+ *
+ *  s      - The text.
+ *  length - Its length, in bytes, at least 1.
+ *  cp     - Set to the character, or U+FFFD if the bytes aren't valid UTF-8.
+ *
+ *  Returns the number of bytes the character takes up, 1 if they aren't
+ *  valid.
+ */
+int utf8_decode(const char *s, int length, unsigned int *cp);
+
+/* utf8_char_width:
+ * ----------------
+ *
+ *  Returns the number of columns a character takes up, 0 for a combining
+ *  character, 2 for a wide one and 1 for the rest.
+ */
+int utf8_char_width(unsigned int cp);
+
+/* utf8_next:
+ * ----------
+ *
+ *  Steps over the character at an index of some text.
+ *
+ *  s      - The text.
+ *  length - Its length, in bytes.
+ *  i      - The index, it's moved past the character.
+ *
+ *  Returns the number of columns the character takes up.
+ */
+int utf8_next(const char *s, int length, int *i);
+
+/* utf8_prev:
+ * ----------
+ *
+ *  Returns the index of the character before index i of s, or 0.
+ */
+int utf8_prev(const char *s, int i);
+
+/* utf8_columns:
+ * -------------
+ *
+ *  Returns the number of columns some text takes up.
+ *
+ *  s      - The text.
+ *  length - Its length, in bytes.
+ */
+int utf8_columns(const char *s, int length);
+
+/* utf8_column_bytes:
+ * ------------------
+ *
+ *  Finds how much of some text fits in a number of columns. A character is
+ *  never split, and a wide one that would only half fit is left out.
+ *
+ *  s       - The text.
+ *  length  - Its length, in bytes.
+ *  columns - The number of columns.
+ *  used    - If not NULL, set to the columns the bytes take up.
+ *
+ *  Returns the number of bytes that fit.
+ */
+int utf8_column_bytes(const char *s, int length, int columns, int *used);
+
+#endif /* __UTF8_H__ */
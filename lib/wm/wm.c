@@ -42,18 +42,18 @@ window_manager *wm_create(wm_window *main_window, wm_window *cli)
     wm->main_window = main_window;
     wm->focused_window = main_window;
     getmaxyx(stdscr, y, x);
-    cwindow = derwin(stdscr, y - 1, x, 0, 0);
+    cwindow = derwin(stdscr, cli ? y - 1 : y, x, 0, 0);
     wm_window_set_context(main_window, wm, NULL, cwindow);
     wm_window_layout_event(main_window);
 
     wm->cli = (wm_window *) cli;
-    cwindow = derwin(stdscr, 1, x, y-1, 0);
-    wm_window_set_context(wm->cli, wm, NULL, cwindow);
-    wm_window_layout_event(wm->cli);
+    if (cli) {
+        cwindow = derwin(stdscr, 1, x, y-1, 0);
+        wm_window_set_context(wm->cli, wm, NULL, cwindow);
+        wm_window_layout_event(wm->cli);
+    }
     wm->cli_mode = 0;
 
-    wm_redraw(wm);
-
     return wm;
 }
 
@@ -70,15 +70,63 @@ int wm_destroy(window_manager *wm)
 
 int wm_input(window_manager *wm, int *data, size_t len)
 {
-    wm_window *target = wm->cli_mode ? wm->cli : wm->focused_window;
+    wm_window *target = wm->cli_mode && wm->cli ? wm->cli
+                                                : wm->focused_window;
     return target->input(target, data, len);
 }
 
+/* Redraws the damaged windows in the given window. */
+static void wm_redraw_damaged(wm_window *window)
+{
+    wm_splitter *splitter;
+    int i;
+
+    if (window->damaged) {
+        wm_window_redraw(window);
+        return;
+    }
+
+    if (window->is_splitter) {
+        splitter = (wm_splitter *) window;
+        for (i = 0; i < splitter->num_children; ++i) {
+            wm_redraw_damaged(splitter->children[i]);
+        }
+    }
+}
+
 int wm_redraw(window_manager *wm)
 {
-    wm_window_redraw(wm->main_window);
-    wm_window_redraw(wm->cli);
-    refresh();
+    wm_window *target = wm->cli_mode && wm->cli ? wm->cli
+                                                : wm->focused_window;
+
+    wm_redraw_damaged(wm->main_window);
+    if (wm->cli) {
+        wm_redraw_damaged(wm->cli);
+    }
+
+    /* The cursor is left wherever the focused window wants it */
+    if (target && wm_window_is_visible(target)) {
+        target->place_cursor(target);
+    }
+
+    doupdate();
+    return 0;
+}
+
+int wm_layout(window_manager *wm)
+{
+    int y, x;
+
+    getmaxyx(stdscr, y, x);
+    wresize(wm->main_window->cwindow, wm->cli ? y - 1 : y, x);
+    wm_window_layout_event(wm->main_window);
+
+    if (wm->cli) {
+        wresize(wm->cli->cwindow, 1, x);
+        mvwin(wm->cli->cwindow, y - 1, 0);
+        wm_window_layout_event(wm->cli);
+    }
+
     return 0;
 }
 
@@ -107,7 +155,7 @@ int wm_resize(window_manager *wm, wm_window *window, wm_orientation dir,
                                   (wm_window *) splitter, dir, size);
     }
 
-    return wm_redraw(wm);
+    return 0;
 }
 
 int wm_split(window_manager *wm, wm_window *window, wm_orientation orientation)
@@ -120,8 +168,7 @@ int wm_split(window_manager *wm, wm_window *window, wm_orientation orientation)
     /* If already inside a splitter, hand off to wm_splitter_split(). */
     if (orig->parent && orig->parent->is_splitter) {
         splitter = (wm_splitter *) orig->parent;
-        wm_splitter_split(splitter, orig, window, orientation);
-        return wm_window_redraw((wm_window *) splitter);
+        return wm_splitter_split(splitter, orig, window, orientation);
     }
 
     /* This is the top-level window and it's not a splitter yet. */
@@ -131,7 +178,7 @@ int wm_split(window_manager *wm, wm_window *window, wm_orientation orientation)
     wm_splitter_split(splitter, orig, window, orientation);
     wm->main_window = (wm_window *) splitter;
 
-    return wm_window_redraw((wm_window *) splitter);
+    return 0;
 }
 
 int wm_close(window_manager *wm, wm_window *window)
@@ -150,7 +197,7 @@ int wm_close(window_manager *wm, wm_window *window)
         return -1;
     }
 
-    return wm_redraw(wm);
+    return 0;
 }
 
 int wm_new_main(window_manager *wm, wm_window *window)
@@ -163,10 +210,12 @@ int wm_new_main(window_manager *wm, wm_window *window)
     }
     getmaxyx(stdscr, maxy, maxx);
     wm_window_set_context(window, wm, NULL,
-                          derwin(stdscr, maxy - 1, maxx, 0, 0));
+                          derwin(stdscr, wm->cli ? maxy - 1 : maxy, maxx,
+                                 0, 0));
     wm_focus(wm, window);
     wm_window_layout_event(window);
-    wm_redraw(wm);
+
+    return 0;
 }
 
 void wm_cli_mode(window_manager *wm, int value)
@@ -177,6 +226,15 @@ void wm_cli_mode(window_manager *wm, int value)
 void wm_focus(window_manager *wm, wm_window *window)
 {
     /* Consider checking that the window is in our hierarchy. */
+    if (wm->focused_window == window) {
+        return;
+    }
+
+    /* The status bars of both show which one has focus */
+    if (wm->focused_window) {
+        wm_window_damage(wm->focused_window);
+    }
+    wm_window_damage(window);
     wm->focused_window = window;
 }
 
@@ -205,8 +263,8 @@ int wm_move_focus(window_manager *wm, wm_direction dir, wm_position cursor_pos)
     if (to_focus == NULL) {
         return -1;
     }
-    wm->focused_window = to_focus;
-    return wm_redraw(wm);
+    wm_focus(wm, to_focus);
+    return 0;
 }
 
 wm_optval wm_option_get(wm_option option)
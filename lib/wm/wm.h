@@ -24,6 +24,10 @@
  * is transparent to the confined window, which can do input and drawing
  * without knowledge of actual screen coordinates or whether it is seen by the
  * user at all.
+ *
+ * Nothing is drawn when windows are arranged.  The windows whose contents or
+ * geometry changed are only marked as damaged, with wm_window_damage, and
+ * wm_redraw draws just those, updating the terminal once.
  */
 
 /**
@@ -42,9 +46,9 @@ typedef struct window_manager_s window_manager;
  * splitting occurs.  The window manager now owns this pointer.
  *
  * @param cli
- * The command line widget that will live at the bottom of the screen.  The
- * window manager is currently hard-coded to expect this to exist, so you must
- * always provide one.  The window manager now owns this pointer.
+ * The command line widget that will live at the bottom of the screen, or NULL
+ * to give the whole screen to the main window.  The window manager now owns
+ * this pointer.
  *
  * @return
  * A new window manager is returned, or NULL on error.
@@ -78,8 +82,9 @@ int wm_destroy(window_manager *wm);
 int wm_input(window_manager *wm, int *data, size_t len);
 
 /**
- * Redraw all visible windows (because the display was damaged for some reason,
- * or maybe the user hit C-l).
+ * Redraw the damaged windows, leave the cursor where the focused window
+ * places it, and update the terminal.  To redraw everything (maybe the user
+ * hit C-l), damage the main window first.
  *
  * @param wm
  * The window manager.
@@ -89,11 +94,23 @@ int wm_input(window_manager *wm, int *data, size_t len);
  */
 int wm_redraw(window_manager *wm);
 
+/**
+ * Lay the windows out again, after the terminal was resized.  Every window
+ * is damaged.
+ *
+ * @param wm
+ * The window manager.
+ *
+ * @return
+ * Zero on success, non-zero on failure.
+ */
+int wm_layout(window_manager *wm);
+
 /**
  * Resize the given window in the given direction.  Other windows will be
  * pushed as necessary to accomodate the new space.
  *
- * The screen will be redrawn after the window is resized.
+ * The windows that moved are damaged, call wm_redraw to draw them.
  *
  * @param wm
  * The window manager.
@@ -47,12 +47,13 @@ static int test_redraw(wm_window *window)
         }
     }
     wattroff(window->cwindow, COLOR_PAIR(widget->color));
-    wrefresh(window->cwindow);
+    wnoutrefresh(window->cwindow);
+    return 0;
 }
 
 static int test_layout(wm_window *window)
 {
-    return test_redraw(window);
+    return 0;
 }
 
 static char *test_status_text(wm_window *window, size_t max_length)
@@ -95,12 +96,13 @@ static int test_cli_redraw(wm_window *window)
             mvwprintw(window->cwindow, 0, i, ".");
         }
     }
+    wnoutrefresh(window->cwindow);
     return 0;
 }
 
 static int test_cli_layout(wm_window *window)
 {
-    return test_cli_redraw(window);
+    return 0;
 }
 
 static test_cli *test_cli_create()
@@ -162,67 +164,83 @@ int main(int argc, char *argv[])
                 assert(!wm_split(wm, (wm_window *) widgets[i], WM_VERTICAL));
                 break;
         }
+        wm_redraw(wm);
         usleep(delay);
     }
 
     wm_move_focus(wm, WM_LEFT, pos);
+    wm_redraw(wm);
     usleep(delay);
     wm_move_focus(wm, WM_UP, pos);
+    wm_redraw(wm);
     usleep(delay);
     wm_move_focus(wm, WM_UP, pos);
+    wm_redraw(wm);
     usleep(delay);
     pos.left = ((wm_window *) widgets[3])->left;
     wm_move_focus(wm, WM_DOWN, pos);
+    wm_redraw(wm);
     usleep(delay);
     wm_move_focus(wm, WM_DOWN, pos);
+    wm_redraw(wm);
     usleep(delay);
     wm_move_focus(wm, WM_DOWN, pos);
+    wm_redraw(wm);
     usleep(delay);
 
     for (i = 1; i <= 4; ++i) {
         assert(!wm_resize(wm, (wm_window *) widgets[3], WM_HORIZONTAL,
                 widgets[3]->window.real_height - i));
+        wm_redraw(wm);
         usleep(delay);
     }
 
     for (i = 1; i <= 4; ++i) {
         assert(!wm_resize(wm, (wm_window *) widgets[3], WM_HORIZONTAL,
                 widgets[3]->window.real_height + i));
+        wm_redraw(wm);
         usleep(delay);
     }
     for (i = 1; i <= 3; ++i) {
         assert(!wm_resize(wm, (wm_window *) widgets[2], WM_VERTICAL,
                 widgets[2]->window.real_width - 1));
+        wm_redraw(wm);
         usleep(delay);
     }
     for (i = 1; i <= 3; ++i) {
         assert(!wm_resize(wm, (wm_window *) widgets[2], WM_VERTICAL,
                 widgets[2]->window.real_width + 2));
+        wm_redraw(wm);
         usleep(delay);
     }
     for (i = 1; i <= 3; ++i) {
         assert(!wm_resize(wm, (wm_window *) widgets[2], WM_HORIZONTAL,
                 widgets[2]->window.real_height - i));
+        wm_redraw(wm);
         usleep(delay);
     }
     for (i = 1; i <= 60; ++i) {
         assert(!wm_resize(wm, (wm_window *) widgets[0], WM_HORIZONTAL,
                 widgets[0]->window.real_height + 1));
+        wm_redraw(wm);
         usleep(delay/10);
     }
     for (i = 1; i <= 20; ++i) {
         assert(!wm_resize(wm, (wm_window *) widgets[1], WM_HORIZONTAL,
                 widgets[1]->window.real_height + 1));
+        wm_redraw(wm);
         usleep(delay/10);
     }
     for (i = 1; i <= 60; ++i) {
         assert(!wm_resize(wm, (wm_window *) widgets[2], WM_HORIZONTAL,
                 widgets[2]->window.real_height + 1));
+        wm_redraw(wm);
         usleep(delay/10);
     }
     wm_dump(wm, "wm.out");
     for (i = 4; i >= 1; --i) {
         assert(!wm_close(wm, (wm_window *) widgets[i]));
+        wm_redraw(wm);
         usleep(delay);
     }
     wm_dump(wm, "wm.out");
@@ -265,8 +265,8 @@ wm_splitter_split(wm_splitter *splitter, wm_window *window,
         splitter->children = realloc(splitter->children,
             sizeof(wm_window *) * splitter->array_length);
     }
-    for (i = pos; i < splitter->num_children; ++i) {
-        splitter->children[i+1] = splitter->children[i];
+    for (i = splitter->num_children; i > pos; --i) {
+        splitter->children[i] = splitter->children[i-1];
     }
     splitter->children[pos] = obj;
     splitter->num_children++;
@@ -373,25 +373,30 @@ wm_splitter_layout(wm_window *window)
                 break;
             }
         }
-        /* Note: Special case: initially created windows are 1 x 1. */
-        if (child->real_height == 1 && child->real_width == 1) {
+        /* Note: Special case: initially created windows are 1 x 1, and
+         * haven't been laid out yet. */
+        if (child->real_height <= 1 && child->real_width <= 1) {
             redistribute = 1;
             break;
         }
     }
+    /* There are no proportions to keep if every window was squeezed out */
+    if (prev_dimension == 0) {
+        redistribute = 1;
+    }
     if (redistribute) {
         /* Distribute windows equally */
         if (splitter->orientation == WM_HORIZONTAL) {
             for (i = 0; i < splitter->num_children; i++) {
                 new_sizes[i] = window->real_height / splitter->num_children;
             }
-            sum = window->real_height;
         } else {
             for (i = 0; i < splitter->num_children; i++) {
                 new_sizes[i] = real_width / splitter->num_children;
             }
-            sum = real_width;
         }
+        /* The remainder goes to the last window */
+        sum = new_sizes[0] * splitter->num_children;
     } else {
         /* Distribute windows according to previous proportions. */
         sum = 0;
@@ -436,20 +441,18 @@ wm_splitter_layout(wm_window *window)
                                      window->real_height, my_dimension);
             position += my_dimension + 1;
         }
-        /* Notify */
-        wm_window_layout_event(child);
     }
 
     free(new_sizes);
     free(proportions);
-    return wm_splitter_redraw(window);
+    return 0;
 }
 
 static int
 wm_splitter_redraw(wm_window *window)
 {
     wm_splitter *splitter = (wm_splitter *) window;
-    int i, j;
+    int i;
     int num_children = splitter->num_children;
 
     /* Clear the window - mainly useful for testing purposes, to make
@@ -459,31 +462,24 @@ wm_splitter_redraw(wm_window *window)
      * children cannot draw beneath the vsplit itself (it's outside of the
      * child window.) The child will overwrite the rest of this. */
     if (splitter->orientation == WM_VERTICAL) {
-        wattron(window->cwindow, WA_REVERSE);
-        for (i = 0; i < window->real_width; ++i) {
-            mvwprintw(window->cwindow, window->real_height-1, i, " ");
+        mvwhline(window->cwindow, window->real_height - 1, 0,
+                 ' ' | WA_REVERSE, window->real_width);
+        /* Draw a vertical separator for vsplits */
+        for (i = 0; i < num_children - 1; ++i) {
+            int left = splitter->children[i]->left +
+                       splitter->children[i]->real_width - window->left;
+            /* TODO: Configurable color of separator */
+            mvwvline(window->cwindow, 0, left, '|' | WA_REVERSE,
+                     window->height - 1);
         }
-        wattroff(window->cwindow, WA_REVERSE);
     }
-    wrefresh(window->cwindow);
+    /* The splitter goes on the screen first, the children over it */
+    wnoutrefresh(window->cwindow);
+
     /* Render the child windows */
     for (i = 0; i < num_children; ++i) {
         wm_window_redraw(splitter->children[i]);
-        /* Draw a vertical separator for vsplits */
-        if (splitter->orientation == WM_VERTICAL && i < num_children-1) {
-            int left = splitter->children[i]->left +
-                       splitter->children[i]->real_width;
-            /* TODO: Configurable color of separator */
-            wattron(window->cwindow, WA_REVERSE);
-            for (j = 0; j < window->height-1; ++j) {
-                mvwprintw(window->cwindow, j, left, "|");
-            }
-            wattroff(window->cwindow, WA_REVERSE);
-            /* Not sure why this is needed, curses sucks */
-            wrefresh(window->cwindow);
-        }
     }
-    wrefresh(window->cwindow);
 
     return 0;
 }
@@ -556,6 +552,18 @@ static int
 wm_splitter_place_window(wm_window *window, int top, int left,
                          int height, int width)
 {
+    /* A window squeezed to nothing keeps its curses window, which can't be
+     * empty, and isn't drawn until it gets room again. */
+    if (height <= 0 || width <= 0) {
+        window->top = top;
+        window->left = left;
+        window->real_height = height > 0 ? height : 0;
+        window->real_width = width > 0 ? width : 0;
+        window->height = window->width = 0;
+        window->damaged = 1;
+        return window->layout(window);
+    }
+
     /* Note: Assumes resizes are always smaller or bigger, not (smaller height
      * larger width). Curses window operations will fail if the window tries
      * to grow or move into a space that is out of bounds, so order is
@@ -565,7 +573,7 @@ wm_splitter_place_window(wm_window *window, int top, int left,
     wresize(window->cwindow, height, width);
     mvwin(window->cwindow, top, left);
 
-    wm_window_layout_event(window);
+    return wm_window_layout_event(window);
 }
 
 static wm_window *
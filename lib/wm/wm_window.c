@@ -23,6 +23,7 @@ static int hook_input(wm_window *window, int *data, size_t len);
 static int hook_redraw(wm_window *window);
 static char *hook_status_text(wm_window *window, size_t max_length);
 static void hook_minimum_size(wm_window *window, int *height, int *width);
+static void hook_place_cursor(wm_window *window);
 
 int
 wm_window_init(wm_window *window)
@@ -34,6 +35,7 @@ wm_window_init(wm_window *window)
     window->redraw = hook_redraw;
     window->status_text = hook_status_text;
     window->minimum_size = hook_minimum_size;
+    window->place_cursor = hook_place_cursor;
     wm_window_show_status_bar(window, 1);
 
     return 0;
@@ -65,6 +67,8 @@ wm_window_set_context(wm_window *window, window_manager *wm,
     }
     assert(cwindow != NULL);
     window->cwindow = cwindow;
+
+    return 0;
 }
 
 int
@@ -77,36 +81,54 @@ wm_window_layout_event(wm_window *window)
     if (window->show_status_bar) {
         window->height--;
     }
+    window->damaged = 1;
     window->layout(window);
 
     return 0;
 }
 
+void
+wm_window_damage(wm_window *window)
+{
+    window->damaged = 1;
+}
+
+int
+wm_window_is_visible(wm_window *window)
+{
+    return window->real_height > 0 && window->real_width > 0;
+}
+
 int
 wm_window_redraw(wm_window *window)
 {
     int i;
+
+    window->damaged = 0;
+    if (!wm_window_is_visible(window)) {
+        return 0;
+    }
+
     if (window->show_status_bar) {
         char *status = window->status_text(window, window->width);
         size_t status_len = status ? strlen(status) : 0;
-        char fill = wm_is_focused(window->wm, window) ? '^' : ' ';
-        char text[2] = { 0 };
-        wattron(window->cwindow, WA_REVERSE);
-        for (i = 0; i < window->width; ++i) {
+        chtype fill = wm_is_focused(window->wm, window) ? '^' : ' ';
+
+        /* The fill is laid down in one run, then the status over it */
+        mvwhline(window->cwindow, window->height, 0, fill | WA_REVERSE,
+                 window->width);
+        for (i = 0; i < status_len && i < window->width; ++i) {
             /* TODO: Allow spaces in status that don't get filled */
-            if (i < status_len && status[i] != ' ') {
-                text[0] = status[i];
-            } else {
-                text[0] = fill;
+            if (status[i] != ' ') {
+                mvwaddch(window->cwindow, window->height, i,
+                         (unsigned char) status[i] | WA_REVERSE);
             }
-            mvwprintw(window->cwindow, window->height, i, text);
         }
-        wattroff(window->cwindow, WA_REVERSE);
         free(status);
+        wnoutrefresh(window->cwindow);
     }
-    window->redraw(window);
 
-    return 0;
+    return window->redraw(window);
 }
 
 void
@@ -133,13 +155,13 @@ wm_window_dump(wm_window *window, FILE *out, int indent)
         for (i = 0; i < indent; ++i) {
             fprintf(out, " ");
         }
-        fprintf(out, "+ Split: %s ", splitter->orientation ==
-                WM_HORIZONTAL ? "Horizontal" : "Vertical", splitter);
+        fprintf(out, "+ Split: %s %p ", splitter->orientation ==
+                WM_HORIZONTAL ? "Horizontal" : "Vertical", (void *) splitter);
     } else {
         for (i = 0; i < indent; ++i) {
             fprintf(out, " ");
         }
-        fprintf(out, "- Window ", window);
+        fprintf(out, "- Window %p ", (void *) window);
     }
     fprintf(out, "(us: +%d+%d %dx%d, curses: +%d+%d %dx%d)\n",
             window->top, window->left, window->real_height, window->real_width,
@@ -196,3 +218,9 @@ hook_minimum_size(wm_window *window, int *height, int *width)
         *height += 1;
     }
 }
+
+static void
+hook_place_cursor(wm_window *window)
+{
+    wnoutrefresh(window->cwindow);
+}
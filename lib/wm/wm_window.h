@@ -63,7 +63,12 @@ typedef struct window_manager_s window_manager;
  *    'layout' hook.
  *    a. Window dimension variables are set (top, left, height, width).
  *    b. Your widget should update its state as necessary.
- *    c. Your widget should redraw() itself.
+ *    c. The window is damaged, so the next wm_redraw will redraw() it.
+ *
+ * Windows are only drawn by wm_redraw, and only the ones that are damaged.
+ * When the contents of your widget change, call wm_window_damage() and
+ * then wm_redraw(). Draw with wnoutrefresh, wm_redraw puts the whole frame
+ * on the screen with a single doupdate.
  */
 struct wm_window_s {
 
@@ -110,6 +115,12 @@ struct wm_window_s {
     /** True if this window is an instance of a splitter. */
     int is_splitter;
 
+    /**
+     * True if the window has to be redrawn. It's set when the window is
+     * laid out or damaged, and cleared when it's redrawn.
+     */
+    int damaged;
+
     /** Flag to indicate that a status bar should be drawn. (Default true). */
     int show_status_bar;
 
@@ -161,8 +172,9 @@ struct wm_window_s {
 
     /**
      * Redraw the widget.  This method will be called whenever the window
-     * needs to be redrawn, your implementation should assume the entire
-     * contents need to be re-rendered.
+     * is damaged, your implementation should assume the entire contents
+     * need to be re-rendered.  Use wnoutrefresh rather than wrefresh, the
+     * screen is updated once all the damaged windows are drawn.
      *
      * @param window
      * The window receiving the redraw request.
@@ -202,6 +214,18 @@ struct wm_window_s {
      * Output parameter, set to the minimum width for this widget.
      */
     void (*minimum_size)(wm_window *window, int *height, int *width);
+
+    /**
+     * Put the cursor where it belongs in the window.  This is the last thing
+     * wm_redraw does for the focused window, whether it was redrawn or not.
+     *
+     * The default implementation calls wnoutrefresh on the curses window,
+     * which leaves the cursor where the widget last moved it.
+     *
+     * @param window
+     * The focused window.
+     */
+    void (*place_cursor)(wm_window *window);
 };
 
 /**
@@ -272,7 +296,29 @@ int wm_window_set_context(wm_window *window, window_manager *wm,
 int wm_window_layout_event(wm_window *window);
 
 /**
- * Notify the specified window that it should be re-rendered.
+ * Mark the window as needing to be redrawn, the next wm_redraw will do it.
+ * Damaging a splitter damages all the windows in it.
+ *
+ * @param window
+ * The window whose contents changed.
+ */
+void wm_window_damage(wm_window *window);
+
+/**
+ * Check if the window has any room on the screen.  A window can be squeezed
+ * down to nothing by its neighbors, it isn't drawn until it gets room again.
+ *
+ * @param window
+ * The window to check.
+ *
+ * @return
+ * 1 if the window can be seen, 0 otherwise.
+ */
+int wm_window_is_visible(wm_window *window);
+
+/**
+ * Re-render the specified window now, whether it's damaged or not.  It's
+ * copied to the curses virtual screen, call doupdate to show it.
  *
  * @param window
  * The window to redraw.